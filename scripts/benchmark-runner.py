@@ -14,10 +14,14 @@
 # limitations under the License.
 
 import argparse
+import datetime
 import json
+import math
 import os
 import pathlib
+import platform
 import re
+import socket
 import subprocess
 import sys
 import tempfile
@@ -27,6 +31,16 @@ from collections import defaultdict
 
 _OUTPUT_NUM_COLS = 100
 
+# Written next to the benchmark results by "run". Not a benchmark result.
+_RUN_INFO_FILE = "run_info.json"
+
+# Default binary directories of the benchmark suites, relative to the build
+# directory.
+_SUITES = {
+    "basic": ("velox", "benchmarks", "basic"),
+    "exec": ("velox", "exec", "benchmarks"),
+}
+
 
 # Cosmetic helper functions.
 # GitHub Actions does not provide a tty but can still display colors
@@ -73,6 +87,87 @@ def fmt_runtime(time_ns):
         return "{:.2f}ms".format(time_usec / 1000)
 
 
+def _betacf(a, b, x):
+    """Continued fraction of the incomplete beta function (modified Lentz)."""
+    tiny = 1e-300
+    qab = a + b
+    qap = a + 1.0
+    qam = a - 1.0
+    c = 1.0
+    d = 1.0 - qab * x / qap
+    d = tiny if abs(d) < tiny else d
+    d = 1.0 / d
+    h = d
+    for m in range(1, 201):
+        m2 = 2 * m
+        aa = m * (b - m) * x / ((qam + m2) * (a + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        h *= d * c
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2))
+        d = 1.0 + aa * d
+        d = tiny if abs(d) < tiny else d
+        c = 1.0 + aa / c
+        c = tiny if abs(c) < tiny else c
+        d = 1.0 / d
+        delta = d * c
+        h *= delta
+        if abs(delta - 1.0) < 1e-12:
+            break
+    return h
+
+
+def _betai(a, b, x):
+    """Regularized incomplete beta function I_x(a, b)."""
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    front = math.exp(
+        math.lgamma(a + b)
+        - math.lgamma(a)
+        - math.lgamma(b)
+        + a * math.log(x)
+        + b * math.log(1.0 - x)
+    )
+    if x < (a + 1.0) / (a + b + 2.0):
+        return front * _betacf(a, b, x) / a
+    return 1.0 - front * _betacf(b, a, 1.0 - x) / b
+
+
+def welch_t_test(baseline, contender):
+    """Two-sided p-value of Welch's t-test on two lists of samples."""
+    n1 = len(baseline)
+    n2 = len(contender)
+    if n1 < 2 or n2 < 2:
+        return None
+    mean1 = sum(baseline) / n1
+    mean2 = sum(contender) / n2
+    var1 = sum((x - mean1) ** 2 for x in baseline) / (n1 - 1)
+    var2 = sum((x - mean2) ** 2 for x in contender) / (n2 - 1)
+    se2 = var1 / n1 + var2 / n2
+    if se2 == 0:
+        return 1.0 if mean1 == mean2 else 0.0
+    t = (mean1 - mean2) / math.sqrt(se2)
+    df = se2**2 / (
+        (var1 / n1) ** 2 / (n1 - 1) + (var2 / n2) ** 2 / (n2 - 1)
+    )
+    return _betai(df / 2.0, 0.5, df / (df + t * t))
+
+
+def relative_delta(baseline_result, target_result):
+    """Positive means speedup; negative means regression."""
+    if baseline_result == 0 or target_result == 0:
+        return 0
+    elif baseline_result > target_result:
+        return 1 - (target_result / baseline_result)
+    else:
+        return (1 - (baseline_result / target_result)) * -1
+
+
 def get_retry_name(args, file_name):
     """
     Extract the subdir name between the base path and file name, and use that
@@ -121,12 +216,7 @@ def compare_file(args, target_data, baseline_data):
             baseline_result = baseline_map[handle][retry]
 
             # Calculate delta between baseline and target results.
-            if baseline_result == 0 or target_result == 0:
-                delta = 0
-            elif baseline_result > target_result:
-                delta = 1 - (target_result / baseline_result)
-            else:
-                delta = (1 - (baseline_result / target_result)) * -1
+            delta = relative_delta(baseline_result, target_result)
 
             # Set status message based on the delta and number of retries.
             if not is_last:
@@ -166,6 +256,92 @@ def compare_file(args, target_data, baseline_data):
     return passes, faster, failures
 
 
+def compare_file_samples(args, target_data, baseline_data):
+    """
+    Compares benchmarks with repeated runs. Each file holds one sample of
+    each benchmark. A benchmark fails if its mean time changed by more than
+    the threshold and Welch's t-test finds the change significant.
+    """
+
+    def collect_samples(input_map):
+        output_map = defaultdict(list)
+        for data in input_map.values():
+            for row in data:
+                if row[1] == "-":
+                    continue
+                output_map[(row[0], row[1])].append(row[2])
+        return output_map
+
+    baseline_map = collect_samples(baseline_data)
+    target_map = collect_samples(target_data)
+
+    passes = []
+    faster = []
+    failures = []
+
+    for handle, target_samples in target_map.items():
+        baseline_samples = baseline_map.get(handle)
+        if not baseline_samples:
+            print("No baseline found. Skipping '{}'".format(handle))
+            continue
+        baseline_mean = sum(baseline_samples) / len(baseline_samples)
+        target_mean = sum(target_samples) / len(target_samples)
+        delta = relative_delta(baseline_mean, target_mean)
+        p_value = welch_t_test(baseline_samples, target_samples)
+        significant = p_value is None or p_value < args.alpha
+
+        if abs(delta) > args.threshold and significant:
+            if delta > 0:
+                status = color_green("🗲 Pass")
+                passes.append((handle[0], handle[1], delta))
+                faster.append((handle[0], handle[1], delta))
+            else:
+                status = color_red("✗ Fail")
+                failures.append((handle[0], handle[1], delta))
+        else:
+            status = color_green("✓ Pass")
+            passes.append((handle[0], handle[1], delta))
+
+        suffix = "({} vs {}) {:+.2f}% p={}".format(
+            fmt_runtime(baseline_mean),
+            fmt_runtime(target_mean),
+            delta * 100,
+            "n/a" if p_value is None else "{:.3f}".format(p_value),
+        )
+        bm_handle = get_benchmark_handle(*handle)
+        spacing = " " * max(
+            1, _OUTPUT_NUM_COLS - (len(status) + len(bm_handle) + len(suffix) - 4)
+        )
+        print("    {}: {}{}{}".format(status, bm_handle, spacing, suffix))
+
+    return passes, faster, failures
+
+
+def read_run_info(path: pathlib.Path):
+    run_info = path / _RUN_INFO_FILE
+    if not run_info.is_file():
+        return None
+    with open(run_info) as f:
+        return json.load(f)
+
+
+def check_run_info(baseline_path, contender_path):
+    """Warns if the results come from different kinds of machines."""
+    baseline = read_run_info(pathlib.Path(baseline_path))
+    contender = read_run_info(pathlib.Path(contender_path))
+    if not baseline or not contender:
+        return
+    for key in ["cpu_model", "num_cpus", "memory_bytes", "machine"]:
+        if baseline.get(key) != contender.get(key):
+            print(
+                color_yellow(
+                    "WARNING: '{}' differs: baseline '{}', contender '{}'".format(
+                        key, baseline.get(key), contender.get(key)
+                    )
+                )
+            )
+
+
 def find_json_files(path: pathlib.Path, recursive=False):
     """Finds json files in a given directory. Supports recursive searchs."""
     pattern = "*.json"
@@ -173,6 +349,8 @@ def find_json_files(path: pathlib.Path, recursive=False):
     json_files = defaultdict(list)
 
     for path in files:
+        if path.name == _RUN_INFO_FILE:
+            continue
         json_files[path.name] += [path.resolve()]
     return json_files
 
@@ -194,10 +372,17 @@ def compare(args):
     )
     print("=> Values are reported as percentage normalized to the largest values:")
     print("=>    (positive means speedup; negative means regression).")
+    if args.samples:
+        print(
+            "=> Subdirectories are repeated runs. Changes must also be significant "
+            "at p < {}.".format(args.alpha)
+        )
+    check_run_info(args.baseline_path, args.contender_path)
 
     # Read file lists from both directories.
-    baseline_map = find_json_files(pathlib.Path(args.baseline_path), args.recursive)
-    target_map = find_json_files(pathlib.Path(args.contender_path), args.recursive)
+    recursive = args.recursive or args.samples
+    baseline_map = find_json_files(pathlib.Path(args.baseline_path), recursive)
+    target_map = find_json_files(pathlib.Path(args.contender_path), recursive)
 
     all_passes = []
     all_faster = []
@@ -220,7 +405,8 @@ def compare(args):
         target_data = read_json_files(contender_path)
         baseline_data = read_json_files(baseline_map[file_name])
 
-        passes, faster, failures = compare_file(args, target_data, baseline_data)
+        compare_func = compare_file_samples if args.samples else compare_file
+        passes, faster, failures = compare_func(args, target_data, baseline_data)
         all_passes += passes
         all_faster += faster
         all_failures += failures
@@ -273,9 +459,9 @@ def _find_binaries(binary_path: pathlib.Path):
     return binaries
 
 
-def _default_binary_path():
+def _default_binary_path(suite="basic"):
     repo_root = pathlib.Path(__file__).parent.parent.absolute()
-    return repo_root.joinpath("_build", "release", "velox", "benchmarks", "basic")
+    return repo_root.joinpath("_build", "release", *_SUITES[suite])
 
 
 def _normalize_path(binary_path: str) -> pathlib.Path:
@@ -285,8 +471,52 @@ def _normalize_path(binary_path: str) -> pathlib.Path:
     return path
 
 
+def _read_first_match(path, pattern):
+    try:
+        with open(path) as f:
+            for line in f:
+                match = re.match(pattern, line)
+                if match:
+                    return match.group(1).strip()
+    except OSError:
+        pass
+    return None
+
+
+def write_run_info(output_dir, suite):
+    """Records the machine and the source version of the results."""
+    memory_kb = _read_first_match("/proc/meminfo", r"MemTotal:\s+(\d+) kB")
+    try:
+        sha = subprocess.run(
+            ["git", "rev-parse", "HEAD"],
+            cwd=pathlib.Path(__file__).parent,
+            capture_output=True,
+            text=True,
+            check=True,
+        ).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        sha = None
+    run_info = {
+        "suite": suite,
+        "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "host": socket.gethostname(),
+        "machine": platform.machine(),
+        "system": platform.platform(),
+        "cpu_model": _read_first_match("/proc/cpuinfo", r"model name\s*:(.*)")
+        or platform.processor(),
+        "num_cpus": os.cpu_count(),
+        "memory_bytes": int(memory_kb) * 1024 if memory_kb else None,
+        "git_sha": sha,
+    }
+    output_dir_path = pathlib.Path(output_dir)
+    output_dir_path.mkdir(parents=True, exist_ok=True)
+    with open(output_dir_path / _RUN_INFO_FILE, "w") as f:
+        json.dump(run_info, f, indent=4)
+
+
 def run_all_benchmarks(
     output_dir,
+    suite="basic",
     binary_path=None,
     binary_filter=None,
     bm_filter=None,
@@ -297,7 +527,7 @@ def run_all_benchmarks(
     if binary_path:
         binary_path = _normalize_path(binary_path)
     else:
-        binary_path = _default_binary_path()
+        binary_path = _default_binary_path(suite)
 
     binaries = _find_binaries(binary_path)
     output_dir_path = pathlib.Path(output_dir)
@@ -400,8 +630,10 @@ def upload_results(args):
 
 def run(args):
     output_dir = args.output_path or tempfile.mkdtemp()
+    write_run_info(output_dir, args.suite)
     kwargs = {
         "output_dir": output_dir,
+        "suite": args.suite,
         "binary_path": args.binary_path,
         "binary_filter": args.binary_filter,
         "bm_filter": args.bm_filter,
@@ -426,6 +658,12 @@ def run(args):
             kwargs["bm_filter"] = gen_bm_filter(bm_list)
             run_all_benchmarks(**kwargs)
 
+    # Repeated runs are samples for "compare --samples".
+    elif args.repetitions > 1:
+        for i in range(args.repetitions):
+            kwargs["output_dir"] = os.path.join(output_dir, "rep-{}".format(i))
+            run_all_benchmarks(**kwargs)
+
     # Otherwise, run all benchmarks we can find.
     else:
         run_all_benchmarks(**kwargs)
@@ -440,11 +678,26 @@ def parse_args():
     # Arguments for the "run" subparser.
     parser_run = subparsers.add_parser("run", help="Run benchmarks and dump results.")
     parser_run.set_defaults(func=run)
+    parser_run.add_argument(
+        "--suite",
+        default="basic",
+        choices=sorted(_SUITES.keys()),
+        help="Benchmark suite whose release build directory is the default "
+        "--binary_path. 'basic' is velox/benchmarks/basic and 'exec' is "
+        "velox/exec/benchmarks.",
+    )
     parser_run.add_argument(
         "--binary_path",
         default=None,
         help="Directory where benchmark binaries are stored. "
-        "Defaults to release build directory.",
+        "Defaults to release build directory of --suite.",
+    )
+    parser_run.add_argument(
+        "--repetitions",
+        default=1,
+        type=int,
+        help="Number of times to run each binary. Each run writes to its own "
+        "rep-<n> subdirectory of --output_path, to compare with --samples.",
     )
     parser_run.add_argument(
         "--output_path",
@@ -528,6 +781,21 @@ def parse_args():
         help="Looks for json files recursively, understanding subdirs as "
         "retries and printing the output accordingly.",
     )
+    parser_compare.add_argument(
+        "--samples",
+        default=False,
+        action="store_true",
+        help="Looks for json files recursively, understanding subdirs as "
+        "repeated runs (see run --repetitions). A benchmark fails only if its "
+        "mean time exceeds the threshold and Welch's t-test finds the change "
+        "significant at --alpha.",
+    )
+    parser_compare.add_argument(
+        "--alpha",
+        type=float,
+        default=0.05,
+        help="Significance level for --samples. Default 0.05.",
+    )
     parser_compare.add_argument(
         "--do_not_fail",
         default=False,
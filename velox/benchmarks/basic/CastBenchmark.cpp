@@ -38,6 +38,10 @@ int main(int argc, char** argv) {
       vectorSize, [](auto /*row*/) { return "$"; });
   auto validDoubleStringInput = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto row) { return fmt::format("{}.12345678910", row); });
+  auto validBigintInput =
+      vectorMaker.flatVector<std::string>(vectorSize, [](auto row) {
+        return std::to_string(row * 7'919'000'003LL);
+      });
   auto validNaNInput = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto /*row*/) { return "NaN"; });
   auto validInfinityInput = vectorMaker.flatVector<std::string>(
@@ -111,6 +115,13 @@ int main(int argc, char** argv) {
           "tryexpr_cast_invalid_input", "try(cast (invalid_date as timestamp))")
       .addExpression("cast_valid", "cast(valid_date as timestamp)");
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar_as_bigint",
+          vectorMaker.rowVector({"valid"}, {validBigintInput}))
+      .addExpression("cast_valid", "cast(valid as bigint)")
+      .addExpression("try_cast_valid", "try_cast(valid as bigint)");
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast_timestamp_as_varchar",
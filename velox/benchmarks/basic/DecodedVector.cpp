@@ -43,7 +43,12 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     constantVector_ = fuzzer.fuzzConstant(BIGINT());
     dictionaryVector_ = fuzzer.fuzzDictionary(fuzzer.fuzzFlat(BIGINT()));
 
-    // Generate nested dictionary vector.
+    // Generate nested dictionary vectors.
+    dictionary3NestedVector_ = fuzzer.fuzzFlat(BIGINT());
+    for (size_t i = 0; i < 3; ++i) {
+      dictionary3NestedVector_ =
+          fuzzer.fuzzDictionary(dictionary3NestedVector_);
+    }
     dictionaryNestedVector_ = fuzzer.fuzzFlat(BIGINT());
     for (size_t i = 0; i < 5; ++i) {
       dictionaryNestedVector_ = fuzzer.fuzzDictionary(dictionaryNestedVector_);
@@ -89,6 +94,15 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     return vectorSize_;
   }
 
+  // Runs over a decoded nested dictionary vector, with 3 layers of indirection.
+  size_t decodedRunDict3Nested() {
+    folly::BenchmarkSuspender suspender;
+    DecodedVector decodedVector(*dictionary3NestedVector_, rows_);
+    suspender.dismiss();
+    decodedRun(decodedVector);
+    return vectorSize_;
+  }
+
   // Runs over a decoded nested dictionary vector, with 5 layers of indirection.
   size_t decodedRunDict5Nested() {
     folly::BenchmarkSuspender suspender;
@@ -113,6 +127,11 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     DecodedVector decodedVector(*dictionaryVector_, rows_);
   }
 
+  // Measure time to decode a 3-way nested dictionary vector.
+  void decodeDictionary3Nested() {
+    DecodedVector decodedVector(*dictionary3NestedVector_, rows_);
+  }
+
   // Measure time to decode a 5-way nested dictionary vector.
   void decodeDictionary5Nested() {
     DecodedVector decodedVector(*dictionaryNestedVector_, rows_);
@@ -132,6 +151,7 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
   VectorPtr flatVector_;
   VectorPtr constantVector_;
   VectorPtr dictionaryVector_;
+  VectorPtr dictionary3NestedVector_;
   VectorPtr dictionaryNestedVector_;
 
   SelectivityVector rows_;
@@ -162,6 +182,10 @@ BENCHMARK(scanDecodedDict) {
   run([&] { benchmark->decodedRunDict(); });
 }
 
+BENCHMARK(scanDecodedDict3Nested) {
+  run([&] { benchmark->decodedRunDict3Nested(); });
+}
+
 BENCHMARK(scanDecodedDict5Nested) {
   run([&] { benchmark->decodedRunDict5Nested(); });
 }
@@ -181,6 +205,10 @@ BENCHMARK(decodeDictionary) {
   run([&] { benchmark->decodeDictionary(); });
 }
 
+BENCHMARK(decodeDictionary3Nested) {
+  run([&] { benchmark->decodeDictionary3Nested(); });
+}
+
 BENCHMARK(decodeDictionary5Nested) {
   run([&] { benchmark->decodeDictionary5Nested(); });
 }
@@ -42,6 +42,28 @@ int main(int argc, char** argv) {
       .addExpression("", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
       .disableTesting();
 
+  std::vector<std::string> dateTimes;
+  dateTimes.reserve(options.vectorSize);
+  for (auto i = 0; i < options.vectorSize; ++i) {
+    dateTimes.push_back(fmt::format(
+        "{}-{:02}-{:02} {:02}:{:02}:{:02}",
+        1970 + i % 100,
+        1 + i % 12,
+        1 + i % 28,
+        i % 24,
+        i % 60,
+        (i * 7) % 60));
+  }
+
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "Benchmark parse_datetime",
+          vectorMaker.rowVector({vectorMaker.flatVector(dateTimes)}))
+      .addExpression(
+          "parse_datetime", "parse_datetime(c0, 'yyyy-MM-dd HH:mm:ss')")
+      .addExpression("date_parse", "date_parse(c0, '%Y-%m-%d %H:%i:%s')")
+      .disableTesting();
+
   benchmarkBuilder.registerBenchmarks();
   folly::runBenchmarks();
   return 0;
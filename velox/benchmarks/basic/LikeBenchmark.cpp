@@ -115,7 +115,21 @@ int main(int argc, char** argv) {
   benchmarkBuilder
       .addBenchmarkSet(
           "generic", vectorMaker.rowVector({"col0"}, {substringInput}))
-      .addExpression("generic", R"(like(col0, '%a%b%c'))");
+      .addExpression("generic", R"(like(col0, '%a%b%c'))")
+      .addExpression("generic_rare_literal", R"(like(col0, '%a%bq%c'))");
+
+  // ORs of patterns on the same column are evaluated by a single
+  // $internal$like_any or $internal$regexp_like_any call.
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "multi_pattern", vectorMaker.rowVector({"col0"}, {substringInput}))
+      .addExpression(
+          "like_any",
+          "like(col0, '%a%b%c') or like(col0, '%q_r%s') or "
+          "like(col0, 'x%z')")
+      .addExpression(
+          "regexp_like_any",
+          R"(regexp_like(col0, 'a.b.c') or regexp_like(col0, 'q+r'))");
 
   benchmarkBuilder.registerBenchmarks();
   benchmarkBuilder.testBenchmarks();
@@ -19,6 +19,7 @@
 
 #include <gflags/gflags.h>
 
+#include "velox/vector/DecodedVector.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 DECLARE_bool(velox_enable_memory_usage_track_in_default_memory_pool);
@@ -106,6 +107,73 @@ DEFINE_BENCHMARKS(array)
 DEFINE_BENCHMARKS(map)
 DEFINE_BENCHMARKS(row)
 
+// Returns the indices of 'pct' percent of the rows of 'vec', evenly spread,
+// as a filter with that selectivity would produce.
+BufferPtr selectedIndices(const BaseVector& vec, int32_t pct) {
+  const auto step = 100 / pct;
+  const auto numSelected = vec.size() / step;
+  auto indices = allocateIndices(numSelected, vec.pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < numSelected; ++i) {
+    rawIndices[i] = i * step;
+  }
+  return indices;
+}
+
+int64_t sumDecoded(const BaseVector& vec) {
+  SelectivityVector rows(vec.size());
+  DecodedVector decoded(vec, rows);
+  int64_t sum = 0;
+  for (auto i = 0; i < vec.size(); ++i) {
+    if (!decoded.isNullAt(i)) {
+      sum += decoded.valueAt<int64_t>(i);
+    }
+  }
+  return sum;
+}
+
+// Wraps the selected rows of a flat vector in a dictionary and reads them,
+// as a FilterProject output is read downstream.
+int runFilterDictionary(int32_t pct) {
+  folly::BenchmarkSuspender suspender;
+  auto indices = selectedIndices(*data->flatVector, pct);
+  const auto numSelected = indices->size() / sizeof(vector_size_t);
+  suspender.dismiss();
+  auto wrapped = BaseVector::wrapInDictionary(
+      nullptr, indices, numSelected, data->flatVector);
+  folly::doNotOptimizeAway(sumDecoded(*wrapped));
+  return numSelected;
+}
+
+// Copies the selected rows of a flat vector into a new flat vector and reads
+// them.
+int runFilterFlatten(int32_t pct) {
+  folly::BenchmarkSuspender suspender;
+  auto indices = selectedIndices(*data->flatVector, pct);
+  const auto numSelected = indices->size() / sizeof(vector_size_t);
+  suspender.dismiss();
+  auto flat =
+      BaseVector::create(BIGINT(), numSelected, data->flatVector->pool());
+  flat->copy(
+      data->flatVector.get(),
+      SelectivityVector(numSelected),
+      indices->as<vector_size_t>());
+  folly::doNotOptimizeAway(sumDecoded(*flat));
+  return numSelected;
+}
+
+#define DEFINE_FILTER_BENCHMARKS(pct)                 \
+  BENCHMARK_MULTI(filterDictionary##pct##Pct) {       \
+    return runFilterDictionary(pct);                  \
+  }                                                   \
+  BENCHMARK_RELATIVE_MULTI(filterFlatten##pct##Pct) { \
+    return runFilterFlatten(pct);                     \
+  }
+
+DEFINE_FILTER_BENCHMARKS(1)
+DEFINE_FILTER_BENCHMARKS(10)
+DEFINE_FILTER_BENCHMARKS(50)
+
 } // namespace
 } // namespace facebook::velox
 
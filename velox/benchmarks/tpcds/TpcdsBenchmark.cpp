@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/benchmarks/tpcds/TpcdsBenchmark.h"
+
+#include <folly/Benchmark.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/dwio/common/Options.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/Split.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+static bool notEmpty(const char* /*flagName*/, const std::string& value) {
+  return !value.empty();
+}
+
+static bool validateDataFormat(const char* flagname, const std::string& value) {
+  if ((value.compare("parquet") == 0) || (value.compare("dwrf") == 0)) {
+    return true;
+  }
+  std::cout << fmt::format(
+                   "Invalid value for --{}: {}. "
+                   "Allowed values are [\"parquet\", \"dwrf\"]",
+                   flagname,
+                   value)
+            << std::endl;
+  return false;
+}
+
+void ensureTaskCompletion(exec::Task* task) {
+  // ASSERT_TRUE requires a function with return type void.
+  ASSERT_TRUE(waitForTaskCompletion(task));
+}
+
+void printResults(const std::vector<RowVectorPtr>& results, std::ostream& out) {
+  out << "Results:" << std::endl;
+  bool printType = true;
+  for (const auto& vector : results) {
+    // Print RowType only once.
+    if (printType) {
+      out << vector->type()->asRow().toString() << std::endl;
+      printType = false;
+    }
+    for (vector_size_t i = 0; i < vector->size(); ++i) {
+      out << vector->toString(i) << std::endl;
+    }
+  }
+}
+} // namespace
+
+DEFINE_string(
+    data_path,
+    "",
+    "Root path of TPC-DS data. Data layout must follow Hive-style "
+    "partitioning. Example layout for '-data_path=/data/tpcds10'\n"
+    "       /data/tpcds10/call_center\n"
+    "       /data/tpcds10/catalog_returns\n"
+    "       ...\n"
+    "       /data/tpcds10/store_sales\n"
+    "       /data/tpcds10/web_site\n"
+    "If the above are directories, they contain the data files for "
+    "each table. If they are files, they contain a file system path for each "
+    "data file, one per line. This allows running against cloud storage or "
+    "HDFS");
+
+DEFINE_int32(
+    run_query_verbose,
+    -1,
+    "Run a given query and print execution statistics");
+
+DEFINE_bool(
+    include_custom_stats,
+    false,
+    "Include custom statistics along with execution statistics");
+DEFINE_bool(include_results, false, "Include results in the output");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_string(data_format, "parquet", "Data format");
+DEFINE_int32(num_splits_per_file, 10, "Number of splits per file");
+DEFINE_int32(
+    cache_gb,
+    0,
+    "GB of process memory for cache and query. If "
+    "non-0, uses mmap to allocator and in-process data cache.");
+DEFINE_int32(num_repeats, 1, "Number of times to run each query");
+DEFINE_int32(num_io_threads, 8, "Threads for speculative IO");
+
+DEFINE_validator(data_path, &notEmpty);
+DEFINE_validator(data_format, &validateDataFormat);
+
+DEFINE_int64(
+    max_coalesced_bytes,
+    128 << 20,
+    "Maximum size of single coalesced IO");
+
+DEFINE_int32(
+    max_coalesced_distance_bytes,
+    512 << 10,
+    "Maximum distance in bytes in which coalesce will combine requests");
+
+DEFINE_int32(
+    parquet_prefetch_rowgroups,
+    1,
+    "Number of next row groups to "
+    "prefetch. 1 means prefetch the next row group before decoding "
+    "the current one");
+
+DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
+
+std::shared_ptr<TpcdsQueryBuilder> queryBuilder;
+
+class TpcdsBenchmark {
+ public:
+  void initialize() {
+    if (FLAGS_cache_gb) {
+      memory::MemoryManagerOptions options;
+      int64_t memoryBytes = FLAGS_cache_gb * (1LL << 30);
+      options.useMmapAllocator = true;
+      options.allocatorCapacity = memoryBytes;
+      options.useMmapArena = true;
+      options.mmapArenaCapacityRatio = 1;
+      memory::MemoryManager::testingSetInstance(options);
+      cache_ = cache::AsyncDataCache::create(
+          memory::memoryManager()->allocator());
+      cache::AsyncDataCache::setInstance(cache_.get());
+    } else {
+      memory::MemoryManager::testingSetInstance({});
+    }
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    window::prestosql::registerAllWindowFunctions();
+    parse::registerTypeResolver();
+    filesystems::registerLocalFileSystem();
+
+    ioExecutor_ =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+
+    auto configurationValues = std::unordered_map<std::string, std::string>();
+    configurationValues[connector::hive::HiveConfig::kMaxCoalescedBytes] =
+        std::to_string(FLAGS_max_coalesced_bytes);
+    configurationValues
+        [connector::hive::HiveConfig::kMaxCoalescedDistanceBytes] =
+            std::to_string(FLAGS_max_coalesced_distance_bytes);
+    configurationValues[connector::hive::HiveConfig::kPrefetchRowGroups] =
+        std::to_string(FLAGS_parquet_prefetch_rowgroups);
+    auto properties =
+        std::make_shared<const core::MemConfig>(configurationValues);
+
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(kHiveConnectorId, properties, ioExecutor_.get());
+    connector::registerConnector(hiveConnector);
+  }
+
+  void shutdown() {
+    if (cache_) {
+      cache_->shutdown();
+    }
+  }
+
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
+      const TpcdsPlan& tpcdsPlan) {
+    int32_t repeat = 0;
+    try {
+      for (;;) {
+        CursorParameters params;
+        params.maxDrivers = FLAGS_num_drivers;
+        params.planNode = tpcdsPlan.plan;
+        params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
+            std::to_string(FLAGS_split_preload_per_driver);
+        const int numSplitsPerFile = FLAGS_num_splits_per_file;
+
+        bool noMoreSplits = false;
+        auto addSplits = [&](exec::Task* task) {
+          if (!noMoreSplits) {
+            for (const auto& entry : tpcdsPlan.dataFiles) {
+              for (const auto& path : entry.second) {
+                auto const splits =
+                    HiveConnectorTestBase::makeHiveConnectorSplits(
+                        path, numSplitsPerFile, tpcdsPlan.dataFileFormat);
+                for (const auto& split : splits) {
+                  task->addSplit(entry.first, exec::Split(split));
+                }
+              }
+              task->noMoreSplits(entry.first);
+            }
+          }
+          noMoreSplits = true;
+        };
+        auto result = readCursor(params, addSplits);
+        ensureTaskCompletion(result.first->task().get());
+        if (++repeat >= FLAGS_num_repeats) {
+          return result;
+        }
+      }
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Query terminated with: " << e.what();
+      return {nullptr, std::vector<RowVectorPtr>()};
+    }
+  }
+
+  void runMain(std::ostream& out) {
+    if (FLAGS_run_query_verbose == -1) {
+      // Each supported query is a benchmark named after its number.
+      for (auto queryId : TpcdsQueryBuilder::getQueryIds()) {
+        folly::addBenchmark(
+            __FILE__, fmt::format("q{}", queryId), [this, queryId]() {
+              run(queryBuilder->getQueryPlan(queryId));
+              return 1;
+            });
+      }
+      folly::runBenchmarks();
+      return;
+    }
+    const auto queryPlan = queryBuilder->getQueryPlan(FLAGS_run_query_verbose);
+    auto [cursor, actualResults] = run(queryPlan);
+    if (!cursor) {
+      LOG(ERROR) << "Query terminated with error. Exiting";
+      exit(1);
+    }
+    auto task = cursor->task();
+    ensureTaskCompletion(task.get());
+    if (FLAGS_include_results) {
+      printResults(actualResults, out);
+      out << std::endl;
+    }
+    const auto stats = task->taskStats();
+    out << fmt::format(
+               "Execution time: {}",
+               succinctMillis(
+                   stats.executionEndTimeMs - stats.executionStartTimeMs))
+        << std::endl;
+    out << fmt::format(
+               "Splits total: {}, finished: {}",
+               stats.numTotalSplits,
+               stats.numFinishedSplits)
+        << std::endl;
+    out << printPlanWithStats(
+               *queryPlan.plan, stats, FLAGS_include_custom_stats)
+        << std::endl;
+  }
+
+ private:
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+};
+
+TpcdsBenchmark benchmark;
+
+void tpcdsBenchmarkMain() {
+  benchmark.initialize();
+  queryBuilder =
+      std::make_shared<TpcdsQueryBuilder>(toFileFormat(FLAGS_data_format));
+  queryBuilder->initialize(FLAGS_data_path);
+  benchmark.runMain(std::cout);
+  benchmark.shutdown();
+  queryBuilder.reset();
+}
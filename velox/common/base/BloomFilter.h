@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 // BloomFilter filter with groups of 64 bits, of which 4 are set. The hash
@@ -30,6 +31,11 @@ namespace facebook::velox {
 // expected entry, we get ~2% false positives. 'hashInput' determines
 // if the value added or checked needs to be hashed. If this is false,
 // we assume that the input is already a 64 bit hash number.
+//
+// Each insert or probe touches a single word, so a probe costs at most one
+// cache miss. The batch insert and mayContain compute the masks and word
+// indices of a batch of hashes with SIMD and the batch probe gathers the
+// words of the batch.
 template <typename Allocator = std::allocator<uint64_t>>
 class BloomFilter {
  public:
@@ -61,6 +67,53 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Adds the 'size' hashes at 'hashes'.
+  void insert(const uint64_t* hashes, int32_t size) {
+    constexpr int32_t kBatchSize = xsimd::batch<uint64_t>::size;
+    uint64_t masks[kBatchSize];
+    uint64_t indices[kBatchSize];
+    int32_t i = 0;
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      const auto batch = xsimd::load_unaligned(hashes + i);
+      bloomMask(batch).store_unaligned(masks);
+      bloomIndex(bits_.size(), batch).store_unaligned(indices);
+      // Lanes may hit the same word, so the words are updated one at a time.
+      for (auto lane = 0; lane < kBatchSize; ++lane) {
+        bits_[indices[lane]] |= masks[lane];
+      }
+    }
+    for (; i < size; ++i) {
+      insert(hashes[i]);
+    }
+  }
+
+  // Returns the lanes of 'hashes' that may have been inserted.
+  xsimd::batch_bool<int64_t> mayContain(xsimd::batch<uint64_t> hashes) const {
+    const auto mask = simd::reinterpretBatch<int64_t>(bloomMask(hashes));
+    const auto words = simd::gather(
+        reinterpret_cast<const int64_t*>(bits_.data()),
+        simd::reinterpretBatch<int64_t>(bloomIndex(bits_.size(), hashes)));
+    return (words & mask) == mask;
+  }
+
+  // Sets bit i of 'result' if the hash at 'hashes[i]' may have been
+  // inserted and clears it otherwise, for the first 'size' hashes.
+  void mayContain(const uint64_t* hashes, int32_t size, uint64_t* result)
+      const {
+    constexpr int32_t kBatchSize = xsimd::batch<uint64_t>::size;
+    int32_t i = 0;
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      const auto passed =
+          simd::toBitMask(mayContain(xsimd::load_unaligned(hashes + i)));
+      for (auto lane = 0; lane < kBatchSize; ++lane) {
+        bits::setBit(result, i + lane, (passed >> lane) & 1);
+      }
+    }
+    for (; i < size; ++i) {
+      bits::setBit(result, i, mayContain(hashes[i]));
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -113,6 +166,23 @@ class BloomFilter {
     return ((hashCode >> 24) & (bloomSize - 1));
   }
 
+  // Same as above for a batch of hash codes.
+  inline static xsimd::batch<uint64_t> bloomMask(
+      xsimd::batch<uint64_t> hashCodes) {
+    const xsimd::batch<uint64_t> one(1);
+    const xsimd::batch<uint64_t> bitMask(63);
+    return (one << (hashCodes & bitMask)) |
+        (one << ((hashCodes >> 6) & bitMask)) |
+        (one << ((hashCodes >> 12) & bitMask)) |
+        (one << ((hashCodes >> 18) & bitMask));
+  }
+
+  inline static xsimd::batch<uint64_t> bloomIndex(
+      uint32_t bloomSize,
+      xsimd::batch<uint64_t> hashCodes) {
+    return (hashCodes >> 24) & xsimd::batch<uint64_t>(bloomSize - 1);
+  }
+
   inline static void
   set(uint64_t* bloom, int32_t bloomSize, uint64_t hashCode) {
     auto mask = bloomMask(hashCode);
@@ -131,4 +201,82 @@ class BloomFilter {
   std::vector<uint64_t, Allocator> bits_;
 };
 
+// Split block Bloom filter as used by Parquet and Impala. The filter is an
+// array of blocks of 8 32-bit words. A hash selects a block with its upper 32
+// bits and sets one bit in each word of the block, chosen by multiplying its
+// lower 32 bits with a salt per word. A probe reads one 32 byte block. The
+// functions operate on a bitset owned by the caller, so that the filter can
+// be probed in place, e.g. over a buffer read from a file.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kWordsPerBlock = 8;
+  static constexpr int32_t kBytesPerBlock = kWordsPerBlock * sizeof(uint32_t);
+
+  // Sets the bits for 'hash' in the 'numBlocks' blocks at 'blocks'.
+  static void insert(uint32_t* blocks, uint32_t numBlocks, uint64_t hash) {
+    auto* block = blocks + blockIndex(numBlocks, hash) * kWordsPerBlock;
+    const xsimd::batch<uint32_t> key(static_cast<uint32_t>(hash));
+    for (auto i = 0; i < kWordsPerBlock; i += kBatchSize) {
+      const auto words = xsimd::load_unaligned(block + i);
+      (words | blockMask(key, i)).store_unaligned(block + i);
+    }
+  }
+
+  // Returns false if 'hash' was not inserted in the 'numBlocks' blocks at
+  // 'blocks'.
+  static bool
+  mayContain(const uint32_t* blocks, uint32_t numBlocks, uint64_t hash) {
+    const auto* block = blocks + blockIndex(numBlocks, hash) * kWordsPerBlock;
+    const xsimd::batch<uint32_t> key(static_cast<uint32_t>(hash));
+    for (auto i = 0; i < kWordsPerBlock; i += kBatchSize) {
+      const auto words = xsimd::load_unaligned(block + i);
+      const auto tested = words & blockMask(key, i);
+      if (xsimd::any(tested == xsimd::batch<uint32_t>(0))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Sets bit i of 'result' if the hash at 'hashes[i]' may have been
+  // inserted and clears it otherwise, for the first 'size' hashes.
+  static void mayContain(
+      const uint32_t* blocks,
+      uint32_t numBlocks,
+      const uint64_t* hashes,
+      int32_t size,
+      uint64_t* result) {
+    for (auto i = 0; i < size; ++i) {
+      bits::setBit(result, i, mayContain(blocks, numBlocks, hashes[i]));
+    }
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = xsimd::batch<uint32_t>::size;
+  static_assert(kWordsPerBlock % kBatchSize == 0);
+
+  static constexpr uint32_t kSalts[kWordsPerBlock] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+
+  static uint32_t blockIndex(uint32_t numBlocks, uint64_t hash) {
+    return ((hash >> 32) * numBlocks) >> 32;
+  }
+
+  // Returns the bits to set or test in words [i, i + kBatchSize) of a block
+  // for 'key'.
+  static xsimd::batch<uint32_t> blockMask(
+      xsimd::batch<uint32_t> key,
+      int32_t i) {
+    const auto salts = xsimd::load_unaligned(kSalts + i);
+    return xsimd::batch<uint32_t>(1) << ((key * salts) >> 27);
+  }
+};
+
 } // namespace facebook::velox
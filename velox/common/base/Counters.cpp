@@ -347,6 +347,17 @@ void registerVeloxMetrics() {
       kMetricArbitratorSlowGlobalArbitrationCount,
       facebook::velox::StatType::COUNT);
 
+  // The number of background reclaims started by the arbitrator as its free
+  // capacity fell below the low watermark.
+  DEFINE_METRIC(
+      kMetricArbitratorBackgroundReclaimCount,
+      facebook::velox::StatType::COUNT);
+
+  // The sum of the memory capacity freed by the background reclaims.
+  DEFINE_METRIC(
+      kMetricArbitratorBackgroundReclaimedBytes,
+      facebook::velox::StatType::SUM);
+
   // The distribution of the amount of time an arbitration operation stays in
   // arbitration queues and waits the arbitration r/w locks in range of [0,
   // 600s] with 20 buckets. It is configured to report the latency at P50, P90,
@@ -82,6 +82,12 @@ constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationCount{
 constexpr folly::StringPiece kMetricArbitratorSlowGlobalArbitrationCount{
     "velox.arbitrator_slow_global_arbitration_count"};
 
+constexpr folly::StringPiece kMetricArbitratorBackgroundReclaimCount{
+    "velox.arbitrator_background_reclaim_count"};
+
+constexpr folly::StringPiece kMetricArbitratorBackgroundReclaimedBytes{
+    "velox.arbitrator_background_reclaimed_bytes"};
+
 constexpr folly::StringPiece kMetricArbitratorAbortedCount{
     "velox.arbitrator_aborted_count"};
 
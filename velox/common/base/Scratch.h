@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <type_traits>
+#include <vector>
+
 #include "velox/common/base/RawVector.h"
 
 /// A utility for reusable scoped temporary scratch areas.
@@ -160,4 +163,105 @@ class ScratchPtr {
   char padding_[inlineSize == 0 ? 0 : simd::kPadding];
 };
 
+/// A bump allocator for transient arrays that live until the end of a batch,
+/// e.g. the per-input pointer arrays of an expression kernel. allocate()
+/// carves ranges out of large chunks and rewind() frees everything allocated
+/// after a mark() in one step. The chunks are kept for reuse, so that once
+/// warm, a batch does not call malloc.
+class ScratchArena {
+ public:
+  /// A position in the arena. Allocations made after the mark are freed by
+  /// rewinding to it.
+  struct Mark {
+    int32_t chunk{0};
+    int64_t offset{0};
+  };
+
+  explicit ScratchArena(int64_t chunkSize = 64 << 10)
+      : chunkSize_(chunkSize) {}
+
+  ScratchArena(const ScratchArena& other) = delete;
+  void operator=(const ScratchArena& other) = delete;
+
+  ~ScratchArena() {
+    trim();
+  }
+
+  /// Returns 'bytes' of uninitialized memory aligned to 'alignment', which
+  /// must be a power of two. The memory is valid until rewinding to a mark
+  /// made before the call.
+  void* allocate(int64_t bytes, int32_t alignment = alignof(max_align_t)) {
+    VELOX_DCHECK_EQ(alignment & (alignment - 1), 0);
+    for (;;) {
+      if (current_ == static_cast<int32_t>(chunks_.size())) {
+        const auto size = std::max(chunkSize_, bytes + alignment);
+        chunks_.push_back({reinterpret_cast<char*>(::malloc(size)), size});
+        retainedSize_ += size;
+      }
+      const auto& chunk = chunks_[current_];
+      const auto base = reinterpret_cast<uintptr_t>(chunk.data);
+      const int64_t begin =
+          ((base + offset_ + alignment - 1) & ~(alignment - 1ULL)) - base;
+      if (begin + bytes <= chunk.size) {
+        offset_ = begin + bytes;
+        return chunk.data + begin;
+      }
+      ++current_;
+      offset_ = 0;
+    }
+  }
+
+  /// Returns uninitialized space for 'size' elements of T.
+  template <typename T>
+  T* allocate(int64_t size) {
+    static_assert(std::is_trivially_destructible_v<T>);
+    return reinterpret_cast<T*>(allocate(size * sizeof(T), alignof(T)));
+  }
+
+  Mark mark() const {
+    return {current_, offset_};
+  }
+
+  /// Frees the allocations made after 'mark'.
+  void rewind(Mark mark) {
+    VELOX_DCHECK_LE(mark.chunk, current_);
+    current_ = mark.chunk;
+    offset_ = mark.offset;
+  }
+
+  /// Frees all allocations. Keeps the chunks.
+  void reset() {
+    rewind({});
+  }
+
+  /// Frees all allocations and returns the chunks to the system.
+  void trim() {
+    for (auto& chunk : chunks_) {
+      ::free(chunk.data);
+    }
+    chunks_.clear();
+    current_ = 0;
+    offset_ = 0;
+    retainedSize_ = 0;
+  }
+
+  /// The total size of the chunks held.
+  int64_t retainedSize() const {
+    return retainedSize_;
+  }
+
+ private:
+  struct Chunk {
+    char* data;
+    int64_t size;
+  };
+
+  const int64_t chunkSize_;
+  std::vector<Chunk> chunks_;
+  // The chunk being allocated from and the first free byte in it.
+  int32_t current_{0};
+  int64_t offset_{0};
+  int64_t retainedSize_{0};
+};
+
 } // namespace facebook::velox
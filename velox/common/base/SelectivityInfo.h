@@ -17,7 +17,10 @@
 #pragma once
 
 #include <folly/chrono/Hardware.h>
+#include <algorithm>
 #include <cstdint>
+#include <mutex>
+#include <vector>
 
 namespace facebook {
 namespace velox {
@@ -47,6 +50,21 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  /// Adds the counters of 'other' to 'this'.
+  void add(const SelectivityInfo& other) {
+    numIn_ += other.numIn_;
+    numOut_ += other.numOut_;
+    timeClocks_ += other.timeClocks_;
+  }
+
+  /// Halves the counters so that earlier measurements weigh less than later
+  /// ones.
+  void decay() {
+    numIn_ /= 2;
+    numOut_ /= 2;
+    timeClocks_ /= 2;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -76,5 +94,65 @@ class SelectivityTimer {
   uint64_t* const totalClocks_;
 };
 
+/// Selectivity of the inputs of a filter, shared by all the threads that
+/// evaluate the filter, e.g. the drivers of a pipeline. The statistics decay
+/// every 'decayRows' rows so that the order of the inputs follows changes of
+/// selectivity and cost between parts of the data, e.g. between splits of
+/// time-partitioned data.
+class SharedSelectivity {
+ public:
+  static constexpr uint64_t kDefaultDecayRows = 100'000;
+
+  explicit SharedSelectivity(
+      size_t numInputs,
+      uint64_t decayRows = kDefaultDecayRows)
+      : decayRows_(decayRows), stats_(numInputs) {}
+
+  size_t numInputs() const {
+    return stats_.size();
+  }
+
+  /// Adds 'deltas' measured by a thread over 'numRows' rows and resets them.
+  /// Sets 'stats' to the merged statistics and 'order' to the input indices
+  /// sorted by increasing time to drop a row.
+  void update(
+      std::vector<SelectivityInfo>& deltas,
+      uint64_t numRows,
+      std::vector<SelectivityInfo>& stats,
+      std::vector<int32_t>& order) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      for (auto i = 0; i < stats_.size(); ++i) {
+        stats_[i].add(deltas[i]);
+      }
+      numRowsSinceDecay_ += numRows;
+      if (numRowsSinceDecay_ >= decayRows_) {
+        for (auto& info : stats_) {
+          info.decay();
+        }
+        numRowsSinceDecay_ = 0;
+      }
+      stats = stats_;
+    }
+    std::fill(deltas.begin(), deltas.end(), SelectivityInfo());
+
+    for (auto i = 1; i < order.size(); ++i) {
+      if (!(stats[order[i]] < stats[order[i - 1]])) {
+        continue;
+      }
+      std::sort(order.begin(), order.end(), [&](auto left, auto right) {
+        return stats[left] < stats[right];
+      });
+      break;
+    }
+  }
+
+ private:
+  const uint64_t decayRows_;
+  std::mutex mutex_;
+  std::vector<SelectivityInfo> stats_;
+  uint64_t numRowsSinceDecay_{0};
+};
+
 } // namespace velox
 } // namespace facebook
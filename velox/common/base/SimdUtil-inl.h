@@ -1436,4 +1436,51 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+inline size_t findSubstring(
+    const char* text,
+    size_t size,
+    const char* pattern,
+    size_t patternSize,
+    const A&) {
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr size_t kBatch = Batch::size;
+  if (patternSize == 0) {
+    return 0;
+  }
+  if (patternSize > size) {
+    return std::string_view::npos;
+  }
+
+  // Offsets up to 'lastOffset' can start a match.
+  const size_t lastOffset = size - patternSize;
+  const auto first = xsimd::broadcast<uint8_t, A>(pattern[0]);
+  const auto last = xsimd::broadcast<uint8_t, A>(pattern[patternSize - 1]);
+  auto bytes = reinterpret_cast<const uint8_t*>(text);
+  size_t offset = 0;
+  for (; offset + kBatch <= lastOffset + 1; offset += kBatch) {
+    const auto firstMatches = Batch::load_unaligned(bytes + offset) == first;
+    const auto lastMatches =
+        Batch::load_unaligned(bytes + offset + patternSize - 1) == last;
+    uint32_t candidates = toBitMask(firstMatches & lastMatches);
+    while (candidates) {
+      const auto candidate = offset + __builtin_ctz(candidates);
+      if (patternSize <= 2 ||
+          std::memcmp(text + candidate + 1, pattern + 1, patternSize - 2) ==
+              0) {
+        return candidate;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  for (; offset <= lastOffset; ++offset) {
+    if (text[offset] == pattern[0] &&
+        text[offset + patternSize - 1] == pattern[patternSize - 1] &&
+        std::memcmp(text + offset, pattern, patternSize) == 0) {
+      return offset;
+    }
+  }
+  return std::string_view::npos;
+}
+
 } // namespace facebook::velox::simd
@@ -17,6 +17,9 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string_view>
+
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
@@ -497,6 +500,19 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the offset of the first occurrence of 'pattern' of 'patternSize'
+// bytes in 'text' of 'size' bytes, or std::string_view::npos if there is
+// none. Compares the first and last byte of 'pattern' at a full batch of
+// offsets at a time and verifies the remaining bytes only at offsets where
+// both match. Does not read past the end of 'text' or 'pattern'.
+template <typename A = xsimd::default_arch>
+inline size_t findSubstring(
+    const char* text,
+    size_t size,
+    const char* pattern,
+    size_t patternSize,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
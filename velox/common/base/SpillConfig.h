@@ -101,6 +101,12 @@ struct SpillConfig {
   /// Executor for spilling. If nullptr spilling writes on the Driver's thread.
   folly::Executor* executor; // Not owned.
 
+  /// Executor for writing serialized spill data to files while the next
+  /// buffer is serialized. Separate from 'executor' since the spill tasks on
+  /// 'executor' wait for these writes. If nullptr the serializing thread
+  /// writes.
+  folly::Executor* writeExecutor{nullptr}; // Not owned.
+
   /// The minimal spillable memory reservation in percentage of the current
   /// memory usage.
   int32_t minSpillableReservationPct;
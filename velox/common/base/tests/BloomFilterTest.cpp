@@ -90,3 +90,71 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, batch) {
+  constexpr int32_t kSize = 1'003;
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < kSize; ++i) {
+    hashes.push_back(folly::hasher<int32_t>()(i));
+  }
+  BloomFilter bloom;
+  bloom.reset(kSize);
+  bloom.insert(hashes.data(), hashes.size());
+
+  BloomFilter expected;
+  expected.reset(kSize);
+  for (auto hash : hashes) {
+    expected.insert(hash);
+  }
+  std::string data;
+  data.resize(bloom.serializedSize());
+  bloom.serialize(data.data());
+  std::string expectedData;
+  expectedData.resize(expected.serializedSize());
+  expected.serialize(expectedData.data());
+  EXPECT_EQ(expectedData, data);
+
+  // Probe inserted and other hashes.
+  std::vector<uint64_t> probes;
+  for (auto i = 0; i < 2 * kSize; ++i) {
+    probes.push_back(folly::hasher<int32_t>()(i * 7));
+  }
+  std::vector<uint64_t> result(bits::nwords(probes.size()), ~0UL);
+  bloom.mayContain(probes.data(), probes.size(), result.data());
+  for (auto i = 0; i < probes.size(); ++i) {
+    EXPECT_EQ(bloom.mayContain(probes[i]), bits::isBitSet(result.data(), i))
+        << i;
+  }
+}
+
+TEST_F(BloomFilterTest, splitBlock) {
+  constexpr int32_t kSize = 1'000;
+  constexpr uint32_t kNumBlocks = 64;
+  std::vector<uint32_t> blocks(
+      kNumBlocks * SplitBlockBloomFilter::kWordsPerBlock);
+  for (auto i = 0; i < kSize; ++i) {
+    SplitBlockBloomFilter::insert(
+        blocks.data(), kNumBlocks, folly::hasher<int32_t>()(i));
+  }
+
+  std::vector<uint64_t> probes;
+  for (auto i = 0; i < 2 * kSize; ++i) {
+    probes.push_back(folly::hasher<int32_t>()(i));
+  }
+  std::vector<uint64_t> result(bits::nwords(probes.size()));
+  SplitBlockBloomFilter::mayContain(
+      blocks.data(), kNumBlocks, probes.data(), probes.size(), result.data());
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < probes.size(); ++i) {
+    const bool mayContain = SplitBlockBloomFilter::mayContain(
+        blocks.data(), kNumBlocks, probes[i]);
+    EXPECT_EQ(mayContain, bits::isBitSet(result.data(), i));
+    if (i < kSize) {
+      EXPECT_TRUE(mayContain);
+    } else {
+      numFalsePositives += mayContain;
+    }
+  }
+  // 16 bits per value.
+  EXPECT_GT(2, 100 * numFalsePositives / kSize);
+}
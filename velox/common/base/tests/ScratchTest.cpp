@@ -72,3 +72,40 @@ TEST(ScratchTest, large) {
   }
   EXPECT_EQ(0, scratch.retainedSize());
 }
+
+TEST(ScratchTest, arena) {
+  ScratchArena arena(1000);
+  EXPECT_EQ(0, arena.retainedSize());
+  auto* ints = arena.allocate<int32_t>(100);
+  std::fill(ints, ints + 100, 1);
+  EXPECT_EQ(1000, arena.retainedSize());
+  const auto mark = arena.mark();
+  auto* chars = arena.allocate<char>(3);
+  auto* longs = arena.allocate<int64_t>(10);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(longs) % alignof(int64_t));
+  EXPECT_LE(chars + 3, reinterpret_cast<char*>(longs));
+  auto* aligned = arena.allocate(10, 64);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(aligned) % 64);
+
+  // Does not fit in the first chunk.
+  auto* more = arena.allocate<int32_t>(200);
+  std::fill(more, more + 200, 2);
+  EXPECT_EQ(2000, arena.retainedSize());
+  // Larger than a chunk.
+  arena.allocate<char>(5000);
+  EXPECT_LT(7000, arena.retainedSize());
+
+  // Rewinding reuses the space after the mark and keeps the chunks.
+  const auto retained = arena.retainedSize();
+  arena.rewind(mark);
+  EXPECT_EQ(chars, arena.allocate<char>(3));
+  EXPECT_EQ(1, ints[99]);
+  arena.reset();
+  EXPECT_EQ(ints, arena.allocate<int32_t>(100));
+  arena.allocate<int32_t>(200);
+  arena.allocate<char>(5000);
+  EXPECT_EQ(retained, arena.retainedSize());
+
+  arena.trim();
+  EXPECT_EQ(0, arena.retainedSize());
+}
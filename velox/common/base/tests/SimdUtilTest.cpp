@@ -453,6 +453,34 @@ TEST_F(SimdUtilTest, memEqualUnsafe) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, findSubstring) {
+  auto find = [](std::string_view text, std::string_view pattern) {
+    return simd::findSubstring(
+        text.data(), text.size(), pattern.data(), pattern.size());
+  };
+
+  // Compare with std::string_view::find for matches inside full batches, in
+  // the scalar tail and across the boundary between the two.
+  std::string text(100, 'a');
+  for (auto position : {0, 5, 31, 32, 33, 63, 64, 90, 97}) {
+    for (std::string pattern : {"b", "bc", "bcd", "bxxxxxxxxxd"}) {
+      auto copy = text;
+      if (position + pattern.size() > copy.size()) {
+        continue;
+      }
+      copy.replace(position, pattern.size(), pattern);
+      EXPECT_EQ(find(copy, pattern), position) << pattern << " " << position;
+      EXPECT_EQ(find(copy, pattern), std::string_view(copy).find(pattern));
+    }
+  }
+
+  // First and last bytes match but the middle does not.
+  EXPECT_EQ(find(std::string(40, 'a') + "bxd" + "bcd", "bcd"), 43);
+  EXPECT_EQ(find("abc", ""), 0);
+  EXPECT_EQ(find("abc", "abcd"), std::string_view::npos);
+  EXPECT_EQ(find(std::string(200, 'a'), "ab"), std::string_view::npos);
+}
+
 TEST_F(SimdUtilTest, memcpyTime) {
   constexpr int64_t kMaxMove = 128;
   constexpr int64_t kSize = (128 << 20) + kMaxMove;
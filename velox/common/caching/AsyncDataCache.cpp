@@ -24,6 +24,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/process/TraceSpan.h"
 
 #define VELOX_CACHE_ERROR(errorMessage)                             \
   _VELOX_THROW(                                                     \
@@ -190,6 +191,7 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += foundEntry->size();
+          protectLocked(foundEntry);
         }
         ++foundEntry->numPins_;
         CachePin pin;
@@ -229,6 +231,7 @@ CachePin CacheShard::findOrCreate(
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
+    cachedBytes_ += size;
     entryToInit->isFirstUse_ = true;
   }
   return initEntry(key, entryToInit);
@@ -240,6 +243,7 @@ void CacheShard::makeEvictable(RawFileCacheKey key) {
   if (it == entryMap_.end()) {
     return;
   }
+  unprotectLocked(it->second);
   it->second->makeEvictable();
 }
 
@@ -298,6 +302,13 @@ bool CoalescedLoad::loadOrFuture(
   }
 
   // Outside of 'mutex_'.
+  process::ScopedThreadDebugInfo scopedInfo(
+      process::GetThreadDebugInfo() == nullptr ? &debugInfo_ : nullptr);
+  process::TraceSpan span("CoalescedLoad");
+  if (span.isSampled()) {
+    span.addAttribute("bytes", std::to_string(size()));
+    span.addAttribute("prefetch", wait == nullptr ? "true" : "false");
+  }
   try {
     const auto pins = loadData(/*prefetch=*/wait == nullptr);
     for (const auto& pin : pins) {
@@ -340,6 +351,7 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
 }
 
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  unprotectLocked(entry);
   if (entry->key_.fileNum.hasValue()) {
     const auto it = entryMap_.find(
         RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
@@ -362,9 +374,37 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   }
   entry->tinyData_.clear();
   entry->tinyData_.shrink_to_fit();
+  cachedBytes_ -= entry->size_;
   entry->size_ = 0;
 }
 
+void CacheShard::protectLocked(AsyncDataCacheEntry* entry) {
+  if (!entry->isProtected_) {
+    entry->isProtected_ = true;
+    protectedBytes_ += entry->size_;
+  }
+}
+
+void CacheShard::unprotectLocked(AsyncDataCacheEntry* entry) {
+  if (entry->isProtected_) {
+    entry->isProtected_ = false;
+    protectedBytes_ -= entry->size_;
+  }
+}
+
+bool CacheShard::retainLocked(AsyncDataCacheEntry* entry, bool mayDemote) {
+  if (entry->isMetadata()) {
+    return true;
+  }
+  if (!entry->isProtected_) {
+    return false;
+  }
+  if (mayDemote && protectedBytes_ * 100 > cachedBytes_ * kMaxProtectedPct) {
+    unprotectLocked(entry);
+  }
+  return true;
+}
+
 uint64_t CacheShard::evict(
     uint64_t bytesToFree,
     bool evictAllUnpinned,
@@ -387,7 +427,16 @@ uint64_t CacheShard::evict(
     int32_t numChecked = 0;
     auto entryIndex = (clockHand_ % size);
     auto iter = entries_.begin() + entryIndex;
-    while (++counter <= size) {
+    // The first round over 'entries_' evicts probation entries over the
+    // threshold and the second the remaining probation entries. These are
+    // made only if some protected entries or metadata were retained. The last
+    // round evicts any entry over the threshold.
+    bool retainedAny = false;
+    while (++counter <= 3 * size) {
+      const int32_t round = (counter - 1) / size;
+      if (round > 0 && !retainedAny) {
+        break;
+      }
       if (++iter == entries_.end()) {
         iter = entries_.begin();
         entryIndex = 0;
@@ -412,10 +461,24 @@ uint64_t CacheShard::evict(
         eventCounter_ = 0;
       }
 
+      if (candidate->numPins_ != 0) {
+        continue;
+      }
       int32_t score = 0;
-      if (candidate->numPins_ == 0 &&
-          (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+      bool evictCandidate =
+          !candidate->key_.fileNum.hasValue() || evictAllUnpinned;
+      if (!evictCandidate) {
+        score = candidate->score(now);
+        const bool overThreshold = score >= evictionThreshold_;
+        if (round == 2) {
+          evictCandidate = overThreshold;
+        } else if (retainLocked(candidate, overThreshold)) {
+          retainedAny = true;
+        } else {
+          evictCandidate = overThreshold || round == 1;
+        }
+      }
+      if (evictCandidate) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -434,6 +497,8 @@ uint64_t CacheShard::evict(
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
+        unprotectLocked(candidate);
+        cachedBytes_ -= candidate->size_;
         candidate->size_ = 0;
 
         removeEntryLocked(candidate);
@@ -547,6 +612,16 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.allocClocks += allocClocks_;
 }
 
+void CacheShard::addFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (entry && entry->key_.fileNum.hasValue() && !entry->isExclusive()) {
+      fileBytes[entry->key_.fileNum.id()] += entry->size();
+    }
+  }
+}
+
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   std::lock_guard<std::mutex> l(mutex_);
   // Do not add entries to a write batch more than maxWriteRatio_. If SSD save
@@ -947,6 +1022,56 @@ CacheStats AsyncDataCache::refreshStats() const {
   return stats;
 }
 
+std::vector<CachedFileBytes> AsyncDataCache::cachedFiles(
+    int32_t maxFiles) const {
+  folly::F14FastMap<uint64_t, uint64_t> memoryBytes;
+  for (auto& shard : shards_) {
+    shard->addFileBytes(memoryBytes);
+  }
+  folly::F14FastMap<uint64_t, uint64_t> ssdBytes;
+  if (ssdCache_ != nullptr) {
+    ssdCache_->addFileBytes(ssdBytes);
+  }
+
+  std::vector<std::pair<uint64_t, CachedFileBytes>> files;
+  files.reserve(memoryBytes.size() + ssdBytes.size());
+  folly::F14FastMap<uint64_t, int32_t> fileIndex;
+  const auto addBytes = [&](uint64_t fileNum) -> CachedFileBytes& {
+    auto [it, inserted] = fileIndex.try_emplace(fileNum, files.size());
+    if (inserted) {
+      files.emplace_back(fileNum, CachedFileBytes{});
+    }
+    return files[it->second].second;
+  };
+  for (const auto& [fileNum, bytes] : memoryBytes) {
+    addBytes(fileNum).memoryBytes += bytes;
+  }
+  for (const auto& [fileNum, bytes] : ssdBytes) {
+    addBytes(fileNum).ssdBytes += bytes;
+  }
+
+  const auto numFiles =
+      std::min<size_t>(std::max<int32_t>(maxFiles, 0), files.size());
+  std::partial_sort(
+      files.begin(),
+      files.begin() + numFiles,
+      files.end(),
+      [](const auto& left, const auto& right) {
+        return left.second.totalBytes() > right.second.totalBytes();
+      });
+  std::vector<CachedFileBytes> result;
+  result.reserve(numFiles);
+  for (size_t i = 0; i < numFiles; ++i) {
+    auto& file = files[i].second;
+    // The file may have left the cache after the bytes were collected.
+    file.fileName = fileIds().string(files[i].first);
+    if (!file.fileName.empty()) {
+      result.push_back(std::move(file));
+    }
+  }
+  return result;
+}
+
 void AsyncDataCache::testingClear() {
   for (auto& shard : shards_) {
     memory::Allocation unused;
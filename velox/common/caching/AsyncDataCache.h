@@ -33,6 +33,7 @@
 #include "velox/common/file/File.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/common/process/ThreadDebugInfo.h"
 
 namespace facebook::velox::cache {
 
@@ -43,6 +44,7 @@ namespace facebook::velox::cache {
 
 class AsyncDataCache;
 class CacheShard;
+class RemoteCache;
 class SsdCache;
 struct SsdCacheStats;
 class SsdFile;
@@ -253,6 +255,17 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  /// True if 'this' has no tracking id, i.e. is file metadata like a footer
+  /// rather than a column stream.
+  bool isMetadata() const {
+    return trackingId_.empty();
+  }
+
+  /// True if 'this' has been hit after its first use. See CacheShard::evict().
+  bool isProtected() const {
+    return isProtected_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -311,6 +324,10 @@ class AsyncDataCacheEntry {
   // hit.
   bool isPrefetch_{false};
 
+  // True if 'this' is in the protected tier of 'shard_'. Set on the first
+  // cache hit. Requires owning shard_->mutex_.
+  bool isProtected_{false};
+
   // Sets after first use of a prefetched entry. Cleared by
   // getAndClearFirstUseFlag(). Does not require synchronization since used for
   // statistics only.
@@ -429,7 +446,12 @@ class CoalescedLoad {
   CoalescedLoad(std::vector<RawFileCacheKey> keys, std::vector<int32_t> sizes)
       : state_(State::kPlanned),
         keys_(std::move(keys)),
-        sizes_(std::move(sizes)) {}
+        sizes_(std::move(sizes)) {
+    if (auto* info = process::GetThreadDebugInfo()) {
+      debugInfo_.queryId_ = info->queryId_;
+      debugInfo_.taskId_ = info->taskId_;
+    }
+  }
 
   virtual ~CoalescedLoad();
 
@@ -479,6 +501,10 @@ class CoalescedLoad {
 
   std::vector<RawFileCacheKey> keys_;
   std::vector<int32_t> sizes_;
+
+  // The query and task that planned 'this'. Set as the thread's debug info
+  // when the load runs on a thread without one, e.g. for prefetch.
+  process::ThreadDebugInfo debugInfo_;
 };
 
 /// Struct for CacheShard stats. Stats from all shards are added into
@@ -547,6 +573,18 @@ struct CacheStats {
   std::string toString() const;
 };
 
+/// Bytes of a file resident in memory and SSD cache. The file is identified by
+/// name since file numbers are local to the process.
+struct CachedFileBytes {
+  std::string fileName;
+  uint64_t memoryBytes{0};
+  uint64_t ssdBytes{0};
+
+  uint64_t totalBytes() const {
+    return memoryBytes + ssdBytes;
+  }
+};
+
 /// Collection of cache entries whose key hashes to the same shard of
 /// the hash number space.  The cache population is divided into shards
 /// to decrease contention on the mutex for the key to entry mapping
@@ -582,6 +620,12 @@ class CacheShard {
 
   /// Removes 'bytesToFree' worth of entries or as many entries as are not
   /// pinned. This favors first removing older and less frequently used entries.
+  /// Entries are in a probation tier until their first cache hit, after which
+  /// they are protected. Protected entries and metadata are evicted only after
+  /// all unpinned probation entries, so that a large scan does not flush the
+  /// data other queries reuse. Protected entries beyond kMaxProtectedPct of
+  /// the shard are demoted back to probation when they score above the
+  /// eviction threshold.
   /// If 'evictAllUnpinned' is true, anything that is not pinned is evicted at
   /// first sight. This is for out of memory emergencies. If 'pagesToAcquire' is
   /// set, up to this amount is added to 'allocation'. A smaller amount can be
@@ -602,6 +646,9 @@ class CacheShard {
   /// Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  /// Adds the bytes of the loaded entries of each file number to 'fileBytes'.
+  void addFileBytes(folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   /// Appends a batch of non-saved SSD savable entries in 'this' to
   /// 'pins'. This may have to be called several times since this keeps
   /// limits on the batch to write at one time. The savable entries
@@ -626,9 +673,23 @@ class CacheShard {
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
+  // Maximum percentage of the shard's bytes in protected entries.
+  static constexpr int32_t kMaxProtectedPct = 80;
 
   void calibrateThreshold();
 
+  // Moves 'entry' to the protected tier.
+  void protectLocked(AsyncDataCacheEntry* entry);
+
+  // Moves 'entry' back to the probation tier.
+  void unprotectLocked(AsyncDataCacheEntry* entry);
+
+  // True if unpinned 'entry' is protected or metadata, so that evict() takes
+  // it only after the probation entries. If 'mayDemote' is true and the
+  // protected tier is over its limit, moves 'entry' to probation for later
+  // eviction.
+  bool retainLocked(AsyncDataCacheEntry* entry, bool mayDemote);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -662,6 +723,10 @@ class CacheShard {
   uint32_t eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
+  // Sum of the sizes of the entries in 'entries_'.
+  uint64_t cachedBytes_{0};
+  // Sum of the sizes of the protected entries.
+  uint64_t protectedBytes_{0};
   // Cumulative count of cache hits.
   uint64_t numHit_{0};
   // Cumulative Sum of bytes in cache hits.
@@ -784,6 +849,12 @@ class AsyncDataCache : public memory::Cache {
   /// SSD cache if used.
   virtual CacheStats refreshStats() const;
 
+  /// Returns the at most 'maxFiles' files with the most bytes in memory and SSD
+  /// cache, largest first. A compact summary of the cache contents for
+  /// scheduling splits to the workers that have their data, e.g. for soft
+  /// affinity. Costs about as much as refreshStats().
+  std::vector<CachedFileBytes> cachedFiles(int32_t maxFiles) const;
+
   /// If 'details' is true, returns the stats of the backing memory allocator
   /// and ssd cache. Otherwise, only returns the cache stats.
   std::string toString(bool details = true) const;
@@ -802,6 +873,17 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Sets the tier consulted for entries that miss RAM and SSD. Not
+  /// thread-safe. Set before the cache is used for reading.
+  void setRemoteCache(std::shared_ptr<RemoteCache> remoteCache) {
+    remoteCache_ = std::move(remoteCache);
+  }
+
+  /// Returns the remote tier or nullptr if there is none.
+  RemoteCache* remoteCache() const {
+    return remoteCache_.get();
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -882,6 +964,7 @@ class AsyncDataCache : public memory::Cache {
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  std::shared_ptr<RemoteCache> remoteCache_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
@@ -22,30 +22,54 @@ namespace facebook::velox::cache {
 
 std::unique_ptr<CacheTTLController> CacheTTLController::instance_ = nullptr;
 
+void CacheTTLController::FileInfos::add(
+    uint64_t fileNum,
+    int64_t openTimeSec) {
+  files.insert_or_assign(fileNum, RawFileInfo{openTimeSec, false});
+  openTimeBuckets[openTimeSec / kOpenTimeBucketSecs].insert(fileNum);
+}
+
+void CacheTTLController::FileInfos::removeFromBucket(
+    uint64_t fileNum,
+    int64_t openTimeSec) {
+  auto it = openTimeBuckets.find(openTimeSec / kOpenTimeBucketSecs);
+  VELOX_CHECK(it != openTimeBuckets.end());
+  it->second.erase(fileNum);
+  if (it->second.empty()) {
+    openTimeBuckets.erase(it);
+  }
+}
+
 bool CacheTTLController::addOpenFileInfo(
     uint64_t fileNum,
     int64_t openTimeSec) {
-  auto lockedFileMap = fileInfoMap_.wlock();
-  auto it = lockedFileMap->find(fileNum);
-  if (it == lockedFileMap->end() || it->second.removeInProgress) {
-    lockedFileMap->insert_or_assign(fileNum, RawFileInfo{openTimeSec, false});
+  auto lockedFileInfos = fileInfos_.wlock();
+  auto it = lockedFileInfos->files.find(fileNum);
+  if (it == lockedFileInfos->files.end()) {
+    lockedFileInfos->add(fileNum, openTimeSec);
+    return true;
+  }
+  if (it->second.removeInProgress) {
+    lockedFileInfos->removeFromBucket(fileNum, it->second.openTimeSec);
+    lockedFileInfos->add(fileNum, openTimeSec);
     return true;
   }
   return false;
 }
 
 CacheAgeStats CacheTTLController::getCacheAgeStats() const {
-  auto lockedFileMap = fileInfoMap_.rlock();
+  auto lockedFileInfos = fileInfos_.rlock();
 
-  if (lockedFileMap->empty()) {
+  if (lockedFileInfos->files.empty()) {
     return CacheAgeStats{.maxAgeSecs = 0};
   }
 
   // Use the oldest file open time to calculate the max possible age of cache
-  // entries loaded from the files.
+  // entries loaded from the files. The oldest file is in the first bucket.
   int64_t minOpenTime = std::numeric_limits<int64_t>::max();
-  for (auto it = lockedFileMap->cbegin(); it != lockedFileMap->cend(); it++) {
-    minOpenTime = std::min<int64_t>(minOpenTime, it->second.openTimeSec);
+  for (auto fileNum : lockedFileInfos->openTimeBuckets.begin()->second) {
+    minOpenTime = std::min<int64_t>(
+        minOpenTime, lockedFileInfos->files.at(fileNum).openTimeSec);
   }
 
   int64_t maxAge = getCurrentTimeSec() - minOpenTime;
@@ -78,15 +102,24 @@ void CacheTTLController::applyTTL(int64_t ttlSecs) {
 
 folly::F14FastSet<uint64_t> CacheTTLController::getAndMarkAgedOutFiles(
     int64_t maxOpenTimeSecs) {
-  auto lockedFileMap = fileInfoMap_.wlock();
+  auto lockedFileInfos = fileInfos_.wlock();
 
   folly::F14FastSet<uint64_t> fileNums;
 
-  for (auto it = lockedFileMap->begin(); it != lockedFileMap->end(); it++) {
-    if (it->second.removeInProgress ||
-        it->second.openTimeSec < maxOpenTimeSecs) {
-      fileNums.insert(it->first);
-      it->second.removeInProgress = true;
+  // Visit the buckets in open time order up to the first bucket that starts
+  // at or after 'maxOpenTimeSecs'.
+  for (const auto& [bucket, bucketFileNums] :
+       lockedFileInfos->openTimeBuckets) {
+    if (bucket * kOpenTimeBucketSecs >= maxOpenTimeSecs) {
+      break;
+    }
+    for (auto fileNum : bucketFileNums) {
+      auto& fileInfo = lockedFileInfos->files.at(fileNum);
+      if (fileInfo.removeInProgress ||
+          fileInfo.openTimeSec < maxOpenTimeSecs) {
+        fileNums.insert(fileNum);
+        fileInfo.removeInProgress = true;
+      }
     }
   }
 
@@ -95,9 +128,9 @@ folly::F14FastSet<uint64_t> CacheTTLController::getAndMarkAgedOutFiles(
 
 void CacheTTLController::cleanUp(
     const folly::F14FastSet<uint64_t>& filesToRetain) {
-  fileInfoMap_.withWLock([&](auto& fileMap) {
-    auto it = fileMap.begin();
-    while (it != fileMap.end()) {
+  fileInfos_.withWLock([&](auto& fileInfos) {
+    auto it = fileInfos.files.begin();
+    while (it != fileInfos.files.end()) {
       if (!it->second.removeInProgress) {
         it++;
         continue;
@@ -107,14 +140,15 @@ void CacheTTLController::cleanUp(
         it++;
         continue;
       }
-      it = fileMap.erase(it);
+      fileInfos.removeFromBucket(it->first, it->second.openTimeSec);
+      it = fileInfos.files.erase(it);
     }
   });
 }
 
 void CacheTTLController::reset() {
-  fileInfoMap_.withWLock([](auto& fileMap) {
-    for (auto& [_, fileInfo] : fileMap) {
+  fileInfos_.withWLock([](auto& fileInfos) {
+    for (auto& [_, fileInfo] : fileInfos.files) {
       fileInfo.removeInProgress = false;
     }
   });
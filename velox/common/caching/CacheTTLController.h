@@ -17,6 +17,8 @@
 
 #include "velox/common/time/Timer.h"
 
+#include <map>
+
 #include "folly/Synchronized.h"
 #include "folly/container/F14Map.h"
 #include "folly/container/F14Set.h"
@@ -94,10 +96,27 @@ class CacheTTLController {
 
   void reset();
 
+  /// Width of the open time buckets of 'FileInfos::openTimeBuckets'.
+  static constexpr int64_t kOpenTimeBucketSecs = 60;
+
+  struct FileInfos {
+    /// A Map of fileNum to RawFileInfo.
+    folly::F14FastMap<uint64_t, RawFileInfo> files;
+
+    /// The fileNums of 'files' by open time, in buckets of
+    /// kOpenTimeBucketSecs, so that applyTTL() and getCacheAgeStats() visit
+    /// only the oldest files instead of all of them.
+    std::map<int64_t, folly::F14FastSet<uint64_t>> openTimeBuckets;
+
+    void add(uint64_t fileNum, int64_t openTimeSec);
+
+    /// Removes 'fileNum' from the bucket of 'openTimeSec'.
+    void removeFromBucket(uint64_t fileNum, int64_t openTimeSec);
+  };
+
   AsyncDataCache& cache_;
 
-  /// A Map of fileNum to RawFileInfo.
-  folly::Synchronized<folly::F14FastMap<uint64_t, RawFileInfo>> fileInfoMap_;
+  folly::Synchronized<FileInfos> fileInfos_;
 };
 
 } // namespace facebook::velox::cache
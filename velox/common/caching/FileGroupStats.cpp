@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::cache {
+
+void FileGroupStats::recordReference(
+    uint64_t fileId,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  if (trackingId.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& group = groups_[groupId];
+  group.referencedFiles.insert(fileId);
+  auto& column = group.columns[trackingId];
+  column.referencedBytes += bytes;
+  column.sampleBytes += bytes;
+  ++column.numSamples;
+}
+
+void FileGroupStats::recordRead(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  if (trackingId.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  groups_[groupId].columns[trackingId].readBytes += bytes;
+}
+
+void FileGroupStats::recordFile(
+    uint64_t fileId,
+    uint64_t groupId,
+    int32_t numStripes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& group = groups_[groupId];
+  auto& stripes = group.fileStripes[fileId];
+  group.numStripes += numStripes - stripes;
+  stripes = numStripes;
+}
+
+bool FileGroupStats::shouldSaveToSsd(uint64_t groupId, TrackingId trackingId)
+    const {
+  if (trackingId.empty()) {
+    return true;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (maxRejectedScore_ < 0) {
+    return true;
+  }
+  auto groupIt = groups_.find(groupId);
+  if (groupIt == groups_.end()) {
+    return false;
+  }
+  auto columnIt = groupIt->second.columns.find(trackingId);
+  if (columnIt == groupIt->second.columns.end()) {
+    return false;
+  }
+  return columnIt->second.saveToSsd ||
+      score(groupIt->second, columnIt->second) > maxRejectedScore_;
+}
+
+// static
+double FileGroupStats::score(
+    const GroupStats& group,
+    const ColumnGroupStats& column) {
+  const auto bytes = group.columnBytes(column);
+  return bytes == 0 ? 0 : column.readBytes / bytes;
+}
+
+std::vector<FileGroupStats::Candidate> FileGroupStats::candidatesLocked() {
+  std::vector<Candidate> candidates;
+  for (auto& [groupId, group] : groups_) {
+    for (auto& [trackingId, column] : group.columns) {
+      const auto bytes = group.columnBytes(column);
+      if (column.readBytes == 0 || bytes == 0) {
+        continue;
+      }
+      candidates.push_back({column.readBytes / bytes, bytes, &column});
+    }
+  }
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const Candidate& left, const Candidate& right) {
+        return left.score > right.score;
+      });
+  return candidates;
+}
+
+void FileGroupStats::updateSsdFilter(uint64_t ssdSize, int32_t decayPct) {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& [groupId, group] : groups_) {
+    for (auto& [trackingId, column] : group.columns) {
+      column.saveToSsd = false;
+    }
+  }
+  maxRejectedScore_ = -1;
+  double admittedBytes = 0;
+  for (auto& candidate : candidatesLocked()) {
+    if (admittedBytes + candidate.bytes > ssdSize) {
+      maxRejectedScore_ = candidate.score;
+      break;
+    }
+    admittedBytes += candidate.bytes;
+    candidate.column->saveToSsd = true;
+  }
+
+  // Discounts old accesses and drops the columns and groups that are no
+  // longer accessed.
+  const double decay = (100 - decayPct) / 100.0;
+  for (auto groupIt = groups_.begin(); groupIt != groups_.end();) {
+    auto& columns = groupIt->second.columns;
+    for (auto columnIt = columns.begin(); columnIt != columns.end();) {
+      auto& column = columnIt->second;
+      column.referencedBytes *= decay;
+      column.readBytes *= decay;
+      if (column.referencedBytes < 1 && column.readBytes < 1) {
+        columnIt = columns.erase(columnIt);
+      } else {
+        ++columnIt;
+      }
+    }
+    if (columns.empty()) {
+      groupIt = groups_.erase(groupIt);
+    } else {
+      ++groupIt;
+    }
+  }
+}
+
+std::string FileGroupStats::toString(uint64_t cacheBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto candidates = candidatesLocked();
+  int32_t numColumns = 0;
+  for (const auto& [groupId, group] : groups_) {
+    numColumns += group.columns.size();
+  }
+  double workingSetBytes = 0;
+  double readBytes = 0;
+  double cacheableBytes = 0;
+  bool full = false;
+  for (const auto& candidate : candidates) {
+    workingSetBytes += candidate.bytes;
+    readBytes += candidate.column->readBytes;
+    if (!full && cacheableBytes + candidate.bytes <= cacheBytes) {
+      cacheableBytes += candidate.bytes;
+    } else {
+      full = true;
+    }
+  }
+  const int32_t cacheablePct = workingSetBytes == 0
+      ? 100
+      : static_cast<int32_t>(100 * cacheableBytes / workingSetBytes);
+  return fmt::format(
+      "{} groups {} columns, working set {} read {}, {}% fits in {}",
+      groups_.size(),
+      numColumns,
+      succinctBytes(static_cast<uint64_t>(workingSetBytes)),
+      succinctBytes(static_cast<uint64_t>(readBytes)),
+      cacheablePct,
+      succinctBytes(cacheBytes));
+}
+
+} // namespace facebook::velox::cache
@@ -16,48 +16,114 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
+#include <mutex>
+
 #include "velox/common/caching/ScanTracker.h"
 
 namespace facebook::velox::cache {
 
-// Dummy implementation of SsdCache admission stats.
+/// Access statistics for a column, i.e. TrackingId, within a file group, e.g.
+/// partition.
+struct ColumnGroupStats {
+  /// Bytes referenced and read. Decayed by updateSsdFilter().
+  double referencedBytes{0};
+  double readBytes{0};
+
+  /// Bytes and count of references. Not decayed. Gives the average size of
+  /// the column in a stripe.
+  uint64_t sampleBytes{0};
+  uint64_t numSamples{0};
+
+  /// True if the column was selected for SSD in the last updateSsdFilter().
+  bool saveToSsd{false};
+
+  /// Returns the average size of the column in a stripe.
+  double stripeBytes() const {
+    return numSamples == 0 ? 0 : static_cast<double>(sampleBytes) / numSamples;
+  }
+};
+
+/// Access statistics for a file group.
+struct GroupStats {
+  /// Number of stripes of the files of the group seen in recordFile().
+  folly::F14FastMap<uint64_t, int32_t> fileStripes;
+  int64_t numStripes{0};
+
+  /// Files seen in references. Used for sizing if recordFile() is not called.
+  folly::F14FastSet<uint64_t> referencedFiles;
+
+  folly::F14FastMap<TrackingId, ColumnGroupStats> columns;
+
+  /// Returns the estimated size of the column in all files of the group.
+  double columnBytes(const ColumnGroupStats& column) const {
+    const auto stripes = std::max<int64_t>(
+        numStripes, static_cast<int64_t>(referencedFiles.size()));
+    return column.stripeBytes() * std::max<int64_t>(stripes, 1);
+  }
+};
+
+/// Aggregates ScanTracker statistics by file group and column and selects the
+/// data to write to SSD. The score of a column in a group is the decayed bytes
+/// read divided by its estimated size, i.e. how many times its data is read.
+/// updateSsdFilter() admits the highest scoring columns of groups until their
+/// total size reaches the SSD capacity. Columns first seen after an update are
+/// admitted if they score above the first column that did not fit. Until the
+/// first update, everything is admitted. Thread-safe.
 class FileGroupStats {
  public:
+  /// Discount of old accesses at each updateSsdFilter() by default.
+  static constexpr int32_t kDefaultDecayPct = 10;
+
   // Records ScanTracker::recordReference at group level
   void recordReference(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
   // Records ScanTracker::recordRead at group level
   void recordRead(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
   // Records the existence of a distinct file inside 'groupId'
-  void recordFile(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      int32_t /*numStripes*/) {}
+  void recordFile(uint64_t fileId, uint64_t groupId, int32_t numStripes);
 
   // Returns true if groupId, trackingId qualify the data to be cached to SSD.
-  bool shouldSaveToSsd(uint64_t /*groupId*/, TrackingId /*trackingId*/) const {
-    return true;
-  }
+  bool shouldSaveToSsd(uint64_t groupId, TrackingId trackingId) const;
 
   // Updates the SSD selection criteria. 'ssdsize' is the capacity,
   // 'decayPct' gives by how much old accesses are discounted.
-  void updateSsdFilter(uint64_t /*ssdSize*/, int32_t /*decayPct*/ = 0) {}
+  void updateSsdFilter(uint64_t ssdSize, int32_t decayPct = kDefaultDecayPct);
 
   // Recalculates the best groups and makes a human readable
   // summary. 'cacheBytes' is used to compute what fraction of the tracked
   // working set can be cached in 'cacheBytes'.
-  std::string toString(uint64_t /*cacheBytes*/) {
-    return "<dummy FileGroupStats>";
-  }
+  std::string toString(uint64_t cacheBytes);
+
+ private:
+  struct Candidate {
+    double score;
+    double bytes;
+    ColumnGroupStats* column;
+  };
+
+  static double score(const GroupStats& group, const ColumnGroupStats& column);
+
+  // Returns the columns with data read, highest score first.
+  std::vector<Candidate> candidatesLocked();
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<uint64_t, GroupStats> groups_;
+
+  // Score of the first column that did not fit in the last
+  // updateSsdFilter(). -1 if all fit.
+  double maxRejectedScore_{-1};
 };
 
 } // namespace facebook::velox::cache
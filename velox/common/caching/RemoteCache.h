@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// A cache tier between the local SSD cache and storage, e.g. a cache service
+/// shared by the workers of a cluster or a disaggregated NVMe pool. Consulted
+/// for the entries that miss both RAM and SSD. The data found here or read
+/// from storage is kept in RAM and written to SSD as for any other miss.
+///
+/// Entries are identified by the file number and offset of their
+/// RawFileCacheKey. Implementations translate file numbers with fileIds() to a
+/// key that is stable across processes. Implementations must be thread-safe.
+class RemoteCache {
+ public:
+  virtual ~RemoteCache() = default;
+
+  /// Fills the entries of 'pins' found in the remote cache. The pins are
+  /// exclusive, not yet loaded and sorted by file and offset, so that
+  /// neighbouring entries can be fetched in one request. Returns a flag per
+  /// pin, true if the entry was filled. An entry not filled is read from
+  /// storage by the caller. May throw, in which case the caller reads all
+  /// entries from storage.
+  virtual std::vector<bool> load(folly::Range<const CachePin*> pins) = 0;
+
+  /// Offers the loaded entries of 'pins', which were read from storage, to
+  /// the remote cache. The entries are released after return, so the data
+  /// must be copied before returning. Implementations may drop any entry.
+  virtual void store(folly::Range<const CachePin*> pins) = 0;
+
+  virtual std::string toString() const = 0;
+};
+
+} // namespace facebook::velox::cache
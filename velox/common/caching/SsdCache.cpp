@@ -16,6 +16,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
@@ -59,6 +60,11 @@ SsdCache::SsdCache(const Config& config)
   const uint64_t sizeQuantum = numShards_ * SsdFile::kRegionSize;
   const int32_t fileMaxRegions =
       bits::roundUp(config.maxBytes, sizeQuantum) / sizeQuantum;
+  // The shards recover from their checkpoints and logs in parallel on
+  // 'executor_'. A shard not yet started by the executor is opened on this
+  // thread.
+  std::vector<std::shared_ptr<AsyncSource<SsdFile>>> openFiles;
+  openFiles.reserve(numShards_);
   for (auto i = 0; i < numShards_; ++i) {
     const auto fileConfig = SsdFile::Config(
         fmt::format("{}{}", filePrefix_, i),
@@ -69,7 +75,19 @@ SsdCache::SsdCache(const Config& config)
         config.checksumEnabled,
         checksumReadVerificationEnabled,
         executor_);
-    files_.push_back(std::make_unique<SsdFile>(fileConfig));
+    openFiles.push_back(std::make_shared<AsyncSource<SsdFile>>(
+        [fileConfig]() { return std::make_unique<SsdFile>(fileConfig); }));
+    executor_->add([source = openFiles.back()]() { source->prepare(); });
+  }
+  try {
+    for (auto& openFile : openFiles) {
+      files_.push_back(openFile->move());
+    }
+  } catch (const std::exception&) {
+    for (auto& openFile : openFiles) {
+      openFile->close();
+    }
+    throw;
   }
 }
 
@@ -175,6 +193,13 @@ SsdCacheStats SsdCache::stats() const {
   return stats;
 }
 
+void SsdCache::addFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  for (auto& file : files_) {
+    file->addFileBytes(fileBytes);
+  }
+}
+
 std::string SsdCache::toString() const {
   const auto data = stats();
   const uint64_t capacity = maxBytes();
@@ -130,6 +130,9 @@ class SsdCache {
   /// Returns stats aggregated from all shards.
   SsdCacheStats stats() const;
 
+  /// Adds the bytes cached for each file number in all shards to 'fileBytes'.
+  void addFileBytes(folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   FileGroupStats& groupStats() const {
     return *groupStats_;
   }
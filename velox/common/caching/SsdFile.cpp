@@ -24,6 +24,7 @@
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/process/TraceSpan.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -175,6 +176,8 @@ SsdFile::SsdFile(const Config& config)
   regionSizes_.resize(maxRegions_, 0);
   erasedRegionSizes_.resize(maxRegions_, 0);
   regionPins_.resize(maxRegions_, 0);
+  regionEntries_.resize(maxRegions_);
+  regionFiles_.resize(maxRegions_);
   if (checkpointEnabled()) {
     initializeCheckpoint();
   }
@@ -280,6 +283,15 @@ void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
   process::TraceContext trace("SsdFile::read");
+  process::TraceSpan span("SsdFile::read");
+  if (span.isSampled()) {
+    uint64_t bytes = 0;
+    for (const auto& buffer : buffers) {
+      bytes += buffer.size();
+    }
+    span.addAttribute("bytes", std::to_string(bytes));
+    span.addAttribute("shard", std::to_string(shardId_));
+  }
   readFile_->preadv(offset, buffers);
 }
 
@@ -355,18 +367,16 @@ bool SsdFile::growOrEvictLocked() {
 }
 
 void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
-  std::unordered_set<int32_t> regionSet{regions.begin(), regions.end()};
-  // Remove all 'entries_' where the dependent points one of 'regionIndices'.
-  auto it = entries_.begin();
-  while (it != entries_.end()) {
-    const auto region = regionIndex(it->second.offset());
-    if (regionSet.count(region) != 0) {
-      it = entries_.erase(it);
-    } else {
-      ++it;
-    }
-  }
   for (const auto region : regions) {
+    for (const auto& key : regionEntries_[region]) {
+      const auto it = entries_.find(key);
+      // The entry may have been erased or rewritten to another region.
+      if (it != entries_.end() && regionIndex(it->second.offset()) == region) {
+        entries_.erase(it);
+      }
+    }
+    regionEntries_[region].clear();
+    regionFiles_[region].clear();
     // While the region is being filled, it may get score from hits. When it is
     // full, it will get a score boost to be a little ahead of the best.
     tracker_.regionCleared(region);
@@ -375,6 +385,22 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
   }
 }
 
+void SsdFile::addEntryLocked(FileCacheKey key, const SsdRun& run) {
+  const auto region = regionIndex(run.offset());
+  const auto fileNum = key.fileNum.id();
+  regionEntries_[region].push_back(RawFileCacheKey{fileNum, key.offset});
+  regionFiles_[region].insert(fileNum);
+  entries_[std::move(key)] = run;
+}
+
+void SsdFile::clearEntriesLocked() {
+  entries_.clear();
+  for (auto region = 0; region < maxRegions_; ++region) {
+    regionEntries_[region].clear();
+    regionFiles_[region].clear();
+  }
+}
+
 void SsdFile::write(std::vector<CachePin>& pins) {
   process::TraceContext trace("SsdFile::write");
   // Sorts the pins by their file/offset. In this way what is adjacent in
@@ -437,6 +463,7 @@ void SsdFile::write(std::vector<CachePin>& pins) {
 
     {
       std::lock_guard<std::shared_mutex> l(mutex_);
+      std::string logRecords;
       for (auto i = writeIndex; i < writeIndex + numWrittenEntries; ++i) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
@@ -448,15 +475,20 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        const SsdRun run(offset, size, checksum);
+        if (checkpointEnabled()) {
+          appendEntryRecordLocked(key, run, logRecords);
+        }
+        addEntryLocked(std::move(key), run);
         if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, run);
         }
         offset += size;
         ++stats_.entriesWritten;
         stats_.bytesWritten += size;
         bytesAfterCheckpoint_ += size;
       }
+      logEntriesLocked(logRecords);
     }
     writeIndex += numWrittenEntries;
   }
@@ -522,6 +554,14 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+void SsdFile::addFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    fileBytes[key.fileNum.id()] += run.size();
+  }
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // semantics.
@@ -558,7 +598,7 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
 
 void SsdFile::testingClear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
-  entries_.clear();
+  clearEntriesLocked();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
   writableRegions_.resize(numRegions_);
@@ -579,6 +619,22 @@ void SsdFile::testingDeleteFile() {
   }
 }
 
+namespace {
+// Returns true if 'regionFiles' and 'files' have a file in common.
+bool hasAnyFile(
+    const folly::F14FastSet<uint64_t>& regionFiles,
+    const folly::F14FastSet<uint64_t>& files) {
+  const auto& smaller = regionFiles.size() < files.size() ? regionFiles : files;
+  const auto& larger = regionFiles.size() < files.size() ? files : regionFiles;
+  for (auto fileNum : smaller) {
+    if (larger.count(fileNum) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 bool SsdFile::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -591,32 +647,42 @@ bool SsdFile::removeFileEntries(
 
   std::lock_guard<std::shared_mutex> l(mutex_);
 
+  // Only the entries of the regions with data of 'filesToRemove' are visited.
   int64_t entriesAgedOut = 0;
-  auto it = entries_.begin();
-  while (it != entries_.end()) {
-    const FileCacheKey& cacheKey = it->first;
-    const SsdRun& ssdRun = it->second;
-
-    if (!cacheKey.fileNum.hasValue()) {
-      ++it;
+  for (auto region = 0; region < numRegions_; ++region) {
+    if (!hasAnyFile(regionFiles_[region], filesToRemove)) {
       continue;
     }
-    if (filesToRemove.count(cacheKey.fileNum.id()) == 0) {
-      ++it;
-      continue;
+    const bool pinned = regionPins_[region] > 0;
+    bool erased = false;
+    for (const auto& key : regionEntries_[region]) {
+      if (filesToRemove.count(key.fileNum) == 0) {
+        continue;
+      }
+      const auto it = entries_.find(key);
+      if (it == entries_.end() || regionIndex(it->second.offset()) != region) {
+        continue;
+      }
+      if (pinned) {
+        filesRetained.insert(key.fileNum);
+        continue;
+      }
+      ++entriesAgedOut;
+      erasedRegionSizes_[region] += it->second.size();
+      entries_.erase(it);
+      erased = true;
     }
-
-    auto region = regionIndex(ssdRun.offset());
-    if (regionPins_[region] > 0) {
-      filesRetained.insert(cacheKey.fileNum.id());
-      ++it;
-      continue;
+    if (erased &&
+        erasedRegionSizes_[region] <=
+            regionSizes_[region] * kMaxErasedSizePct / 100) {
+      // The region is not freed below but is now worth less than its reads
+      // suggest.
+      tracker_.regionEntriesErased(
+          region,
+          1.0 -
+              static_cast<double>(erasedRegionSizes_[region]) /
+                  regionSizes_[region]);
     }
-
-    ++entriesAgedOut;
-    erasedRegionSizes_[region] += ssdRun.size();
-
-    it = entries_.erase(it);
   }
 
   std::vector<int32_t> toFree;
@@ -680,6 +746,7 @@ void SsdFile::deleteCheckpoint(bool keepLog) {
       evictLogFd_ = -1;
     }
   }
+  loggedFileNums_.clear();
 
   checkpointDeleted_ = true;
   const auto logPath = getEvictLogFilePath();
@@ -717,6 +784,38 @@ inline const char* asChar(const T* ptr) {
 }
 } // namespace
 
+void SsdFile::appendEntryRecordLocked(
+    const FileCacheKey& key,
+    const SsdRun& run,
+    std::string& records) {
+  const auto append = [&](const auto& value) {
+    records.append(asChar(&value), sizeof(value));
+  };
+  const uint64_t fileNum = key.fileNum.id();
+  if (loggedFileNums_.insert(fileNum).second) {
+    const auto name = fileIds().string(fileNum);
+    append(kLogFileNameMarker);
+    append(fileNum);
+    append(static_cast<int32_t>(name.size()));
+    records.append(name);
+  }
+  append(kLogEntryMarker);
+  append(fileNum);
+  append(key.offset);
+  append(run.fileBits());
+  append(run.checksum());
+}
+
+void SsdFile::logEntriesLocked(const std::string& records) {
+  if (records.empty() || !checkpointEnabled()) {
+    return;
+  }
+  const auto rc = ::write(evictLogFd_, records.data(), records.size());
+  if (rc != records.size()) {
+    checkpointError(rc, "Failed to log entries");
+  }
+}
+
 void SsdFile::checkpoint(bool force) {
   process::TraceContext trace("SsdFile::checkpoint");
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -834,7 +933,9 @@ void SsdFile::checkpoint(bool force) {
     // completes so that we never recover from an old checkpoint file without
     // log evictions. The latter might lead to data consistent issue.
     checkRc(::ftruncate(evictLogFd_, 0), "Truncate of event log");
+    checkRc(::lseek(evictLogFd_, 0, SEEK_SET), "Seek of event log");
     checkRc(::fsync(evictLogFd_), "Sync of evict log");
+    loggedFileNums_.clear();
   } catch (const std::exception& e) {
     try {
       checkpointError(-1, e.what());
@@ -885,7 +986,7 @@ void SsdFile::initializeCheckpoint() {
     try {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
-      entries_.clear();
+      clearEntriesLocked();
       deleteCheckpoint(true);
     } catch (const std::exception&) {
     }
@@ -962,6 +1063,18 @@ T readNumber(std::ifstream& stream) {
   stream.read(asChar(&data), sizeof(T));
   return data;
 }
+
+// Reads a T at 'position' of 'log' and advances 'position'. Returns false if
+// 'log' ends before the T.
+template <typename T>
+bool readLogNumber(const std::string& log, size_t& position, T& data) {
+  if (position + sizeof(T) > log.size()) {
+    return false;
+  }
+  memcpy(&data, log.data() + position, sizeof(T));
+  position += sizeof(T);
+  return true;
+}
 } // namespace
 
 void SsdFile::readCheckpoint(std::ifstream& state) {
@@ -997,14 +1110,6 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     idMap[id] = std::move(lease);
   }
 
-  const auto logSize = ::lseek(evictLogFd_, 0, SEEK_END);
-  std::vector<uint32_t> evicted(logSize / sizeof(uint32_t));
-  const auto rc = ::pread(evictLogFd_, evicted.data(), logSize, 0);
-  VELOX_CHECK_EQ(logSize, rc, "Failed to read eviction log");
-  std::unordered_set<uint32_t> evictedMap;
-  for (auto region : evicted) {
-    evictedMap.insert(region);
-  }
   for (;;) {
     const auto fileNum = readNumber<uint64_t>(state);
     if (fileNum == kCheckpointEndMarker) {
@@ -1016,25 +1121,19 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     if (checkpoinHasChecksum) {
       checksum = readNumber<uint32_t>(state);
     }
-    const auto run = SsdRun(fileBits, checksum);
-    // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
-      // The file may have a different id on restore.
-      auto it = idMap.find(fileNum);
-      VELOX_CHECK(it != idMap.end());
-      FileCacheKey key{it->second, offset};
-      entries_[std::move(key)] = run;
-    }
+    // The file may have a different id on restore.
+    auto it = idMap.find(fileNum);
+    VELOX_CHECK(it != idMap.end());
+    FileCacheKey key{it->second, offset};
+    addEntryLocked(std::move(key), SsdRun(fileBits, checksum));
   }
   ++stats_.checkpointsRead;
-  // The state is successfully read. Install the access frequency scores and
-  // evicted regions.
+  // Brings the checkpointed state up to date with the evictions and writes
+  // logged after the checkpoint. Only the regions evicted or partially written
+  // since the checkpoint are writable.
+  writableRegions_ = replayLog();
+  // The state is successfully read. Install the access frequency scores.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
-  // Set the writable regions by deduplicated evicted regions.
-  writableRegions_.clear();
-  for (auto region : evictedMap) {
-    writableRegions_.push_back(region);
-  }
   tracker_.setRegionScores(scores);
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
       "Starting shard {} from checkpoint with {} entries, {} regions with {} free, with checksum write {}, read verification {}.",
@@ -1046,4 +1145,93 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       checksumReadVerificationEnabled_ ? "enabled" : "disabled");
 }
 
+std::vector<int32_t> SsdFile::replayLog() {
+  const auto logSize = ::lseek(evictLogFd_, 0, SEEK_END);
+  std::string log(logSize, '\0');
+  const auto rc = ::pread(evictLogFd_, log.data(), logSize, 0);
+  VELOX_CHECK_EQ(logSize, rc, "Failed to read eviction log");
+
+  std::vector<int32_t> writableRegions;
+  const auto makeWritable = [&](int32_t region) {
+    if (std::find(writableRegions.begin(), writableRegions.end(), region) ==
+        writableRegions.end()) {
+      writableRegions.push_back(region);
+    }
+  };
+  // File numbers in entry records refer to the file name records of the log,
+  // which may be from a different process than the checkpoint.
+  std::unordered_map<uint64_t, StringIdLease> idMap;
+  int32_t numEntries = 0;
+  size_t position = 0;
+  // End of the last complete record. A crash may leave a partial record.
+  size_t validSize = 0;
+  for (;;) {
+    uint32_t marker;
+    if (!readLogNumber(log, position, marker)) {
+      break;
+    }
+    if (marker == kLogFileNameMarker) {
+      uint64_t fileNum;
+      int32_t length;
+      if (!readLogNumber(log, position, fileNum) ||
+          !readLogNumber(log, position, length) ||
+          position + length > log.size()) {
+        break;
+      }
+      idMap[fileNum] = StringIdLease(
+          fileIds(), std::string_view(log.data() + position, length));
+      position += length;
+    } else if (marker == kLogEntryMarker) {
+      uint64_t fileNum;
+      uint64_t offset;
+      uint64_t fileBits;
+      uint32_t checksum;
+      if (!readLogNumber(log, position, fileNum) ||
+          !readLogNumber(log, position, offset) ||
+          !readLogNumber(log, position, fileBits) ||
+          !readLogNumber(log, position, checksum)) {
+        break;
+      }
+      auto it = idMap.find(fileNum);
+      VELOX_CHECK(it != idMap.end(), "Log entry without file name");
+      const SsdRun run(fileBits, checksum);
+      const auto region = regionIndex(run.offset());
+      VELOX_CHECK_LT(region, maxRegions_);
+      if (region >= numRegions_) {
+        // The file grew after the checkpoint.
+        numRegions_ = region + 1;
+        makeWritable(region);
+      }
+      const uint32_t end = run.offset() - region * kRegionSize + run.size();
+      regionSizes_[region] = std::max(regionSizes_[region], end);
+      addEntryLocked(FileCacheKey{it->second, offset}, run);
+      ++numEntries;
+    } else {
+      VELOX_CHECK_LT(
+          marker,
+          static_cast<uint32_t>(maxRegions_),
+          "Bad record in eviction log");
+      const auto region = static_cast<int32_t>(marker);
+      clearRegionEntriesLocked({region});
+      makeWritable(region);
+    }
+    validSize = position;
+  }
+  if (validSize < log.size()) {
+    VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+        "Dropping {} bytes of incomplete record at end of log of shard {}",
+        log.size() - validSize,
+        shardId_);
+    VELOX_CHECK_EQ(::ftruncate(evictLogFd_, validSize), 0);
+  }
+  ::lseek(evictLogFd_, validSize, SEEK_SET);
+  VELOX_CHECK_LE(numRegions_ * kRegionSize, fileSize_);
+  VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
+      "Replayed {} entries and {} writable regions from log of shard {}",
+      numEntries,
+      writableRegions.size(),
+      shardId_);
+  return writableRegions;
+}
+
 } // namespace facebook::velox::cache
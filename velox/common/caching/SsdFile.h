@@ -339,6 +339,9 @@ class SsdFile {
   /// Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  /// Adds the bytes of the entries of each file number to 'fileBytes'.
+  void addFileBytes(folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   /// Remove cached entries of files in the fileNum set 'filesToRemove'. If
   /// successful, return true, and 'filesRetained' contains entries that should
   /// not be removed, ex., from pinned regions. Otherwise, return false and
@@ -389,7 +392,7 @@ class SsdFile {
     return writableRegions_.size();
   }
 
-  const folly::F14FastMap<FileCacheKey, SsdRun>& testingEntries() {
+  const auto& testingEntries() {
     return entries_;
   }
 
@@ -407,6 +410,13 @@ class SsdFile {
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
   // Magic number at end of completed checkpoint file.
   static constexpr int64_t kCheckpointEndMarker = 0xcbedf11e;
+  // Magic numbers starting the records of the log that are not evicted region
+  // indices. A file name record is followed by the file number, name length
+  // and name. An entry record is followed by the file number, file offset, SSD
+  // offset and size bits and checksum of an entry written after the last
+  // checkpoint.
+  static constexpr uint32_t kLogFileNameMarker = 0xfffffffe;
+  static constexpr uint32_t kLogEntryMarker = 0xffffffff;
 
   static constexpr int kMaxErasedSizePct = 50;
 
@@ -434,6 +444,13 @@ class SsdFile {
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
 
+  // Sets 'entries_[key]' to 'run' and adds 'key' to the index of the region
+  // of 'run'.
+  void addEntryLocked(FileCacheKey key, const SsdRun& run);
+
+  // Clears 'entries_' and the per-region index of the entries.
+  void clearEntriesLocked();
+
   // Clears one or more  regions for accommodating new entries. The regions are
   // added to 'writableRegions_'. Returns true if regions could be cleared.
   bool growOrEvictLocked();
@@ -469,6 +486,23 @@ class SsdFile {
   // existing checkpoint.
   void logEviction(const std::vector<int32_t>& regions);
 
+  // Appends the log record for an entry at 'key' written to 'run' to
+  // 'records', preceded by a file name record if the file number is not yet
+  // in the log. Caller must hold 'mutex_'.
+  void appendEntryRecordLocked(
+      const FileCacheKey& key,
+      const SsdRun& run,
+      std::string& records);
+
+  // Logs entry 'records' so that the entries written after the last
+  // checkpoint are recovered on restart. Caller must hold 'mutex_'.
+  void logEntriesLocked(const std::string& records);
+
+  // Applies the eviction and entry records of the log written after the
+  // checkpoint, in order. Truncates the log after the last complete record.
+  // Returns the regions that are writable after the replay.
+  std::vector<int32_t> replayLog();
+
   // Computes the checksum of data in cache 'entry'.
   uint32_t checksumEntry(const AsyncDataCacheEntry& entry) const;
 
@@ -543,8 +577,51 @@ class SsdFile {
   // Pin count for each region.
   std::vector<int32_t> regionPins_;
 
+  // Hash and equality of 'entries_' that also accept a RawFileCacheKey, so
+  // that entries are looked up from 'regionEntries_' without taking a lease
+  // on the file number.
+  struct EntryKeyHasher {
+    using is_transparent = void;
+
+    size_t operator()(const FileCacheKey& key) const {
+      return std::hash<FileCacheKey>()(key);
+    }
+
+    size_t operator()(const RawFileCacheKey& key) const {
+      return std::hash<RawFileCacheKey>()(key);
+    }
+  };
+
+  struct EntryKeyEqual {
+    using is_transparent = void;
+
+    static uint64_t fileNum(const FileCacheKey& key) {
+      return key.fileNum.id();
+    }
+
+    static uint64_t fileNum(const RawFileCacheKey& key) {
+      return key.fileNum;
+    }
+
+    template <typename Left, typename Right>
+    bool operator()(const Left& left, const Right& right) const {
+      return left.offset == right.offset && fileNum(left) == fileNum(right);
+    }
+  };
+
   // Map of file number and offset to location in file.
-  folly::F14FastMap<FileCacheKey, SsdRun> entries_;
+  folly::F14FastMap<FileCacheKey, SsdRun, EntryKeyHasher, EntryKeyEqual>
+      entries_;
+
+  // The keys of the entries written to each region since the region was last
+  // cleared. May include keys that were since erased or rewritten to another
+  // region. Used to find the entries of a region without a scan of
+  // 'entries_'.
+  std::vector<std::vector<RawFileCacheKey>> regionEntries_;
+
+  // The file numbers of 'regionEntries_' of each region. Lets TTL removal skip
+  // the regions without entries of the files to remove.
+  std::vector<folly::F14FastSet<uint64_t>> regionFiles_;
 
   // File descriptor. 0 (stdin) means file not open.
   int32_t fd_{0};
@@ -568,9 +645,12 @@ class SsdFile {
   // Count of bytes written after last checkpoint.
   std::atomic<uint64_t> bytesAfterCheckpoint_{0};
 
-  // fd for logging evictions.
+  // fd for logging evictions and entries written after the last checkpoint.
   int32_t evictLogFd_{-1};
 
+  // File numbers with a file name record in the log since the last checkpoint.
+  folly::F14FastSet<uint64_t> loggedFileNums_;
+
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
 };
@@ -41,6 +41,14 @@ class SsdFileTracker {
     regionScores_[region] = 0;
   }
 
+  /// Scales the score of 'region' after some of its entries were erased,
+  /// e.g. for being past their TTL. 'liveFraction' is the fraction of the
+  /// bytes of the region that still belong to entries. This makes regions
+  /// with mostly expired data the first candidates for eviction.
+  void regionEntriesErased(int32_t region, double liveFraction) {
+    regionScores_[region] = regionScores_[region] * liveFraction;
+  }
+
   // Marks that a region has been filled and transits from writable to
   // evictable. Set its score to be at least the best score + a small margin so
   // that it gets time to live. Otherwise, it has had the least time to get hits
@@ -974,7 +974,7 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
       "[size 256: 0(0MB) allocated 0 mapped]\n"
       "]\n"
       "SSD: Ssd cache IO: Write 0B read 0B Size 512.00MB Occupied 0B 0K entries.\n"
-      "GroupStats: <dummy FileGroupStats>";
+      "GroupStats: 0 groups 0 columns, working set 0B read 0B, 100% fits in 512.00MB";
   ASSERT_EQ(cache_->toString(), expectedDetailedCacheOutput);
   ASSERT_EQ(cache_->toString(true), expectedDetailedCacheOutput);
   const std::string expectedShortCacheOutput =
@@ -1295,6 +1295,42 @@ DEBUG_ONLY_TEST_P(AsyncDataCacheTest, shrinkWithSsdWrite) {
   ASSERT_EQ(stats.numEmptyEntries, numEntries);
 }
 
+TEST_P(AsyncDataCacheTest, scanResistantEviction) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr int32_t kSize = 64 << 10;
+  initializeCache(kRamBytes);
+  StringIdLease file(fileIds(), std::string_view("scanResistantEviction"));
+  // Loads the entry at 'offset' if not cached. 'id' is empty for metadata.
+  auto load = [&](uint64_t offset, TrackingId id) {
+    auto pin = cache_->findOrCreate({file.id(), offset}, kSize, nullptr);
+    ASSERT_FALSE(pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setTrackingId(id);
+      pin.entry()->setExclusiveToShared(false);
+    }
+  };
+  const uint64_t hotOffset = 0;
+  const uint64_t metadataOffset = kSize;
+  load(hotOffset, TrackingId(1));
+  load(hotOffset, TrackingId(1));
+  load(metadataOffset, TrackingId());
+  {
+    auto pin = cache_->findOrCreate({file.id(), hotOffset}, kSize, nullptr);
+    ASSERT_TRUE(pin.entry()->isProtected());
+    ASSERT_FALSE(pin.entry()->isMetadata());
+  }
+
+  // A scan of 4x the cache size evicts its own entries and keeps the reused
+  // entry and the metadata.
+  for (uint64_t offset = 2 * kSize; offset < 4 * kRamBytes; offset += kSize) {
+    load(offset, TrackingId(2));
+  }
+  ASSERT_TRUE(cache_->exists({file.id(), hotOffset}));
+  ASSERT_TRUE(cache_->exists({file.id(), metadataOffset}));
+  ASSERT_FALSE(cache_->exists({file.id(), 2 * kSize}));
+  ASSERT_GT(cache_->refreshStats().numEvict, 0);
+}
+
 DEBUG_ONLY_TEST_P(AsyncDataCacheTest, ttl) {
   constexpr uint64_t kRamBytes = 32 << 20;
   constexpr uint64_t kSsdBytes = 128UL << 20;
@@ -1329,6 +1365,40 @@ DEBUG_ONLY_TEST_P(AsyncDataCacheTest, ttl) {
   EXPECT_EQ(statsTtl.ssdStats->entriesAgedOut, statsT1.ssdStats->entriesCached);
 }
 
+TEST_P(AsyncDataCacheTest, cachedFiles) {
+  constexpr uint64_t kRamBytes = 1UL << 30;
+  initializeCache(kRamBytes, 0, 0);
+  std::vector<StringIdLease> files;
+  std::vector<CachePin> pins;
+  // File i has i + 1 entries of 4KB.
+  for (auto i = 0; i < 3; ++i) {
+    files.emplace_back(fileIds(), fmt::format("cachedFiles{}", i));
+    for (auto j = 0; j <= i; ++j) {
+      pins.push_back(cache_->findOrCreate(
+          RawFileCacheKey{files.back().id(), j * 4096UL}, 4096, nullptr));
+      pins.back().entry()->setExclusiveToShared();
+    }
+  }
+  // Entries being loaded are not counted.
+  auto loadingPin = cache_->findOrCreate(
+      RawFileCacheKey{files[0].id(), 1UL << 20}, 4096, nullptr);
+  ASSERT_TRUE(loadingPin.entry()->isExclusive());
+
+  auto cachedFiles = cache_->cachedFiles(10);
+  ASSERT_EQ(cachedFiles.size(), 3);
+  for (auto i = 0; i < 3; ++i) {
+    SCOPED_TRACE(fmt::format("file {}", i));
+    ASSERT_EQ(cachedFiles[i].fileName, fmt::format("cachedFiles{}", 2 - i));
+    ASSERT_EQ(cachedFiles[i].memoryBytes, (3 - i) * 4096);
+    ASSERT_EQ(cachedFiles[i].ssdBytes, 0);
+  }
+
+  cachedFiles = cache_->cachedFiles(1);
+  ASSERT_EQ(cachedFiles.size(), 1);
+  ASSERT_EQ(cachedFiles[0].fileName, "cachedFiles2");
+  ASSERT_TRUE(cache_->cachedFiles(0).empty());
+}
+
 TEST_P(AsyncDataCacheTest, makeEvictable) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -61,4 +61,26 @@ TEST_F(CacheTTLControllerTest, getCacheAgeStats) {
       CacheTTLController::getInstance()->getCacheAgeStats().maxAgeSecs,
       current - fileOpenTime);
 }
+
+TEST_F(CacheTTLControllerTest, applyTTL) {
+  CacheTTLController::testingClear();
+  auto* controller = CacheTTLController::create(*cache_);
+
+  const int64_t now = getCurrentTimeSec();
+  for (auto i = 0; i < 100; ++i) {
+    controller->addOpenFileInfo(i, now - i * 30);
+  }
+  EXPECT_GE(controller->getCacheAgeStats().maxAgeSecs, 99 * 30);
+
+  // Removes the files opened more than 1000 seconds ago, i.e. 34 to 99.
+  controller->applyTTL(1'000);
+  const auto maxAgeSecs = controller->getCacheAgeStats().maxAgeSecs;
+  EXPECT_GE(maxAgeSecs, 33 * 30);
+  EXPECT_LT(maxAgeSecs, 34 * 30);
+
+  // Removed files can be added again, the others are still there.
+  EXPECT_TRUE(controller->addOpenFileInfo(99));
+  EXPECT_FALSE(controller->addOpenFileInfo(33));
+  EXPECT_LT(controller->getCacheAgeStats().maxAgeSecs, 34 * 30);
+}
 } // namespace facebook::velox::cache
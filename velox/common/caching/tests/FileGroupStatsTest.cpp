@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+namespace {
+// Simulates 'numScans' scans of column 'id' of the 10 files of 'groupId' with
+// 1MB per file.
+void scan(
+    FileGroupStats& stats,
+    uint64_t groupId,
+    TrackingId id,
+    int32_t numScans) {
+  constexpr int32_t kBytes = 1 << 20;
+  for (auto scan = 0; scan < numScans; ++scan) {
+    for (uint64_t file = 0; file < 10; ++file) {
+      const auto fileId = groupId * 100 + file;
+      stats.recordFile(fileId, groupId, 1);
+      stats.recordReference(fileId, groupId, id, kBytes);
+      stats.recordRead(fileId, groupId, id, kBytes);
+    }
+  }
+}
+} // namespace
+
+TEST(FileGroupStatsTest, admission) {
+  FileGroupStats stats;
+  const TrackingId hot(1);
+  const TrackingId cold(2);
+  // Everything is admitted before the first update.
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, hot));
+
+  // Groups 1 and 2 are read 10 times, group 3 once. Each is 10MB.
+  scan(stats, 1, hot, 10);
+  scan(stats, 2, hot, 10);
+  scan(stats, 3, cold, 1);
+
+  // All fits.
+  stats.updateSsdFilter(100 << 20, 0);
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, hot));
+  EXPECT_TRUE(stats.shouldSaveToSsd(3, cold));
+  EXPECT_TRUE(stats.shouldSaveToSsd(4, hot));
+
+  // Only the hot groups fit.
+  stats.updateSsdFilter(25 << 20, 0);
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, hot));
+  EXPECT_TRUE(stats.shouldSaveToSsd(2, hot));
+  EXPECT_FALSE(stats.shouldSaveToSsd(3, cold));
+  EXPECT_FALSE(stats.shouldSaveToSsd(4, hot));
+  // Data not tracked by column is always admitted.
+  EXPECT_TRUE(stats.shouldSaveToSsd(3, TrackingId()));
+
+  // Group 3 becomes hotter than the others.
+  scan(stats, 3, cold, 20);
+  EXPECT_TRUE(stats.shouldSaveToSsd(3, cold));
+  stats.updateSsdFilter(15 << 20, 0);
+  EXPECT_TRUE(stats.shouldSaveToSsd(3, cold));
+  EXPECT_FALSE(stats.shouldSaveToSsd(1, hot));
+
+  EXPECT_EQ(
+      stats.toString(15 << 20),
+      "3 groups 3 columns, working set 30.00MB read 410.00MB, "
+      "33% fits in 15.00MB");
+}
+
+TEST(FileGroupStatsTest, decay) {
+  FileGroupStats stats;
+  scan(stats, 1, TrackingId(1), 1);
+  EXPECT_EQ(
+      stats.toString(1 << 30),
+      "1 groups 1 columns, working set 10.00MB read 10.00MB, "
+      "100% fits in 1.00GB");
+  // Accesses decay until the group is dropped.
+  for (auto i = 0; i < 30; ++i) {
+    stats.updateSsdFilter(1 << 30, 50);
+  }
+  EXPECT_EQ(
+      stats.toString(1 << 30),
+      "0 groups 0 columns, working set 0B read 0B, 100% fits in 1.00GB");
+}
@@ -21,6 +21,7 @@
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include <fcntl.h>
+#include <filesystem>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -468,6 +469,61 @@ TEST_F(SsdFileTest, checkpoint) {
   EXPECT_EQ(numEntriesFound, 0);
 }
 
+TEST_F(SsdFileTest, recoverFromLog) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  // Only the forced checkpoint is made.
+  const uint64_t checkpointIntervalBytes = 2 * kSsdSize;
+  const auto fileNameAlt = StringIdLease(fileIds(), "fileInStorageAlt");
+  initializeCache(kSsdSize, checkpointIntervalBytes);
+
+  std::vector<TestEntry> allEntries;
+  const auto writeEntries = [&](uint64_t fileId, uint64_t startOffset) {
+    auto pins = makePins(fileId, startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+  };
+  for (auto i = 0; i < 4; ++i) {
+    writeEntries(fileName_.id(), i * SsdFile::kRegionSize);
+  }
+  ssdFile_->checkpoint(true);
+  // The entries written after the checkpoint are only in the log.
+  for (auto i = 4; i < 8; ++i) {
+    writeEntries(fileNameAlt.id(), i * SsdFile::kRegionSize);
+  }
+
+  // Simulates a crash in the middle of logging an entry record.
+  const auto logPath = ssdFile_->getEvictLogFilePath();
+  const auto logSize = std::filesystem::file_size(logPath);
+  const auto fd = ::open(logPath.c_str(), O_WRONLY | O_APPEND);
+  ASSERT_GE(fd, 0);
+  const uint32_t partialRecord[] = {0xffffffff, 1};
+  ASSERT_EQ(::write(fd, partialRecord, sizeof(partialRecord)), 8);
+  ::close(fd);
+
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  EXPECT_EQ(checkEntries(allEntries), allEntries.size());
+  // The incomplete record is dropped.
+  EXPECT_EQ(std::filesystem::file_size(logPath), logSize);
+
+  // New writes after recovery go after the recovered entries and are also
+  // recovered.
+  for (auto i = 8; i < 10; ++i) {
+    writeEntries(fileName_.id(), i * SsdFile::kRegionSize);
+  }
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  EXPECT_EQ(checkEntries(allEntries), allEntries.size());
+
+  // A checkpoint truncates the log and keeps all the entries.
+  ssdFile_->checkpoint(true);
+  EXPECT_EQ(std::filesystem::file_size(logPath), 0);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  EXPECT_EQ(checkEntries(allEntries), allEntries.size());
+}
+
 TEST_F(SsdFileTest, fileCorruption) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
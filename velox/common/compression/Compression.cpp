@@ -19,9 +19,46 @@
 
 #include <folly/Conv.h>
 
+#include <array>
+#include <atomic>
+
 namespace facebook::velox::common {
 
+namespace {
+constexpr int64_t kNumCompressionKinds = CompressionKind_GZIP + 1;
+
+bool isKnownKind(CompressionKind kind) {
+  return kind >= 0 && kind < kNumCompressionKinds;
+}
+
+// Atomic function pointers so that compressionKindToCodec() does not lock.
+std::array<std::atomic<CodecFactory>, kNumCompressionKinds>& codecFactories() {
+  static std::array<std::atomic<CodecFactory>, kNumCompressionKinds>
+      factories{};
+  return factories;
+}
+} // namespace
+
+void registerCodecFactory(CompressionKind kind, CodecFactory factory) {
+  VELOX_CHECK_NOT_NULL(factory);
+  VELOX_CHECK(
+      isKnownKind(kind),
+      "Unknown compression kind {}",
+      compressionKindToString(kind));
+  codecFactories()[kind].store(factory);
+}
+
+bool unregisterCodecFactory(CompressionKind kind) {
+  return isKnownKind(kind) &&
+      codecFactories()[kind].exchange(nullptr) != nullptr;
+}
+
 std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind) {
+  if (isKnownKind(kind)) {
+    if (auto factory = codecFactories()[kind].load(std::memory_order_acquire)) {
+      return factory();
+    }
+  }
   switch (static_cast<int32_t>(kind)) {
     case CompressionKind_NONE:
       return getCodec(folly::io::CodecType::NO_COMPRESSION);
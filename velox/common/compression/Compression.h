@@ -33,8 +33,24 @@ enum CompressionKind {
   CompressionKind_MAX = INT64_MAX
 };
 
+/// Returns the codec registered for 'kind' with registerCodecFactory() or the
+/// folly codec for 'kind' if none is registered.
 std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind);
 
+using CodecFactory = std::unique_ptr<folly::io::Codec> (*)();
+
+/// Makes compressionKindToCodec() return codecs made by 'factory' for
+/// 'kind', e.g. codecs that offload compression to an accelerator such as
+/// Intel QAT or IAA. The codecs must produce and accept the same format as
+/// the software codec for 'kind' since data may be written and read by
+/// different processes. Replaces a factory registered before for 'kind'.
+/// Should be called at startup, before any codec for 'kind' is made, so that
+/// all data of a process is compressed by the same codec.
+void registerCodecFactory(CompressionKind kind, CodecFactory factory);
+
+/// Removes the factory registered for 'kind'. Returns false if there is none.
+bool unregisterCodecFactory(CompressionKind kind);
+
 CompressionKind codecTypeToCompressionKind(folly::io::CodecType type);
 
 /**
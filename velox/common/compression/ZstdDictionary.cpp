@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdDictionary.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <algorithm>
+
+#include <zdict.h>
+#include <zstd.h>
+
+namespace facebook::velox::common {
+namespace {
+// The contexts are reused by all dictionaries compressing or decompressing on
+// the thread since creating one allocates its whole working memory.
+ZSTD_CCtx* threadCompressionContext() {
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{
+      ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  VELOX_CHECK_NOT_NULL(context);
+  return context.get();
+}
+
+ZSTD_DCtx* threadDecompressionContext() {
+  thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{
+      ZSTD_createDCtx(), &ZSTD_freeDCtx};
+  VELOX_CHECK_NOT_NULL(context);
+  return context.get();
+}
+} // namespace
+
+ZstdDictionary::ZstdDictionary(std::string data, int32_t compressionLevel)
+    : data_(std::move(data)),
+      cdict_(ZSTD_createCDict(data_.data(), data_.size(), compressionLevel)),
+      ddict_(ZSTD_createDDict(data_.data(), data_.size())) {
+  VELOX_CHECK(
+      cdict_ != nullptr && ddict_ != nullptr,
+      "Failed to create ZSTD dictionary of {} bytes",
+      data_.size());
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(cdict_);
+  ZSTD_freeDDict(ddict_);
+}
+
+// static
+std::shared_ptr<const ZstdDictionary> ZstdDictionary::train(
+    const std::vector<std::string_view>& samples,
+    size_t maxSize,
+    int32_t compressionLevel) {
+  std::string buffer;
+  std::vector<size_t> sampleSizes;
+  sampleSizes.reserve(samples.size());
+  for (const auto& sample : samples) {
+    buffer.append(sample);
+    sampleSizes.push_back(sample.size());
+  }
+  std::string dictionary(maxSize, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      dictionary.data(),
+      maxSize,
+      buffer.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    // ZSTD takes any bytes without the dictionary header as raw content to
+    // match against, which still helps compressing similar data.
+    buffer.resize(std::min(buffer.size(), maxSize));
+    return std::make_shared<const ZstdDictionary>(
+        std::move(buffer), compressionLevel);
+  }
+  dictionary.resize(size);
+  return std::make_shared<const ZstdDictionary>(
+      std::move(dictionary), compressionLevel);
+}
+
+// static
+size_t ZstdDictionary::compressBound(size_t size) {
+  return ZSTD_compressBound(size);
+}
+
+size_t ZstdDictionary::compress(
+    std::string_view input,
+    char* output,
+    size_t outputSize) const {
+  const auto size = ZSTD_compress_usingCDict(
+      threadCompressionContext(),
+      output,
+      outputSize,
+      input.data(),
+      input.size(),
+      cdict_);
+  VELOX_CHECK(
+      !ZSTD_isError(size),
+      "ZSTD compression failed: {}",
+      ZSTD_getErrorName(size));
+  return size;
+}
+
+void ZstdDictionary::decompress(
+    std::string_view input,
+    char* output,
+    size_t outputSize) const {
+  const auto size = ZSTD_decompress_usingDDict(
+      threadDecompressionContext(),
+      output,
+      outputSize,
+      input.data(),
+      input.size(),
+      ddict_);
+  VELOX_CHECK(
+      !ZSTD_isError(size),
+      "ZSTD decompression failed: {}",
+      ZSTD_getErrorName(size));
+  VELOX_CHECK_EQ(size, outputSize, "Unexpected ZSTD decompressed size");
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace facebook::velox::common {
+
+/// A ZSTD dictionary trained on samples of the data to compress, e.g. the
+/// first pages of a spill file. Small blocks compress much better with a
+/// dictionary since each block does not need to rebuild the history from
+/// scratch. The dictionary must be kept with the compressed data, e.g. in
+/// the spill file info, since the same dictionary is needed to decompress.
+/// Thread-safe once constructed.
+class ZstdDictionary {
+ public:
+  /// Makes a dictionary from 'data', as returned by data() of the dictionary
+  /// used for compression. 'compressionLevel' is used for compression only.
+  ZstdDictionary(std::string data, int32_t compressionLevel);
+
+  ~ZstdDictionary();
+
+  /// Trains a dictionary of at most 'maxSize' bytes on 'samples'. If the
+  /// samples are too few or too small to train on, the first 'maxSize' bytes
+  /// of the samples are used as a raw content dictionary instead.
+  static std::shared_ptr<const ZstdDictionary> train(
+      const std::vector<std::string_view>& samples,
+      size_t maxSize,
+      int32_t compressionLevel);
+
+  /// The bytes to store with the compressed data.
+  const std::string& data() const {
+    return data_;
+  }
+
+  /// Returns the maximum compressed size of 'size' input bytes.
+  static size_t compressBound(size_t size);
+
+  /// Compresses 'input' into 'output' of 'outputSize' bytes and returns the
+  /// compressed size. 'outputSize' must be at least compressBound() of the
+  /// input size.
+  size_t compress(std::string_view input, char* output, size_t outputSize)
+      const;
+
+  /// Decompresses 'input' into 'output', which must be the exact size of the
+  /// uncompressed data.
+  void decompress(std::string_view input, char* output, size_t outputSize)
+      const;
+
+ private:
+  const std::string data_;
+  ZSTD_CDict_s* const cdict_;
+  ZSTD_DDict_s* const ddict_;
+};
+
+} // namespace facebook::velox::common
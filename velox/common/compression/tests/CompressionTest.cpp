@@ -19,6 +19,7 @@
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 
 namespace facebook::velox::common {
 
@@ -48,6 +49,51 @@ TEST_F(CompressionTest, compressionKindToCodec) {
       facebook::velox::VeloxException);
 }
 
+namespace {
+int32_t numCodecsCreated = 0;
+
+std::unique_ptr<folly::io::Codec> makeLz4Codec() {
+  ++numCodecsCreated;
+  return folly::io::getCodec(folly::io::CodecType::LZ4);
+}
+
+std::unique_ptr<folly::io::Codec> makeNoCompressionCodec() {
+  ++numCodecsCreated;
+  return folly::io::getCodec(folly::io::CodecType::NO_COMPRESSION);
+}
+} // namespace
+
+TEST_F(CompressionTest, registerCodecFactory) {
+  numCodecsCreated = 0;
+  registerCodecFactory(CompressionKind_LZO, makeLz4Codec);
+  ASSERT_EQ(
+      folly::io::CodecType::LZ4,
+      compressionKindToCodec(CompressionKind_LZO)->type());
+  ASSERT_EQ(1, numCodecsCreated);
+
+  // The registered codec replaces the folly codec.
+  registerCodecFactory(CompressionKind_ZSTD, makeNoCompressionCodec);
+  ASSERT_EQ(
+      folly::io::CodecType::NO_COMPRESSION,
+      compressionKindToCodec(CompressionKind_ZSTD)->type());
+  ASSERT_EQ(2, numCodecsCreated);
+
+  ASSERT_TRUE(unregisterCodecFactory(CompressionKind_LZO));
+  ASSERT_TRUE(unregisterCodecFactory(CompressionKind_ZSTD));
+  ASSERT_FALSE(unregisterCodecFactory(CompressionKind_ZSTD));
+  ASSERT_EQ(
+      folly::io::CodecType::ZSTD,
+      compressionKindToCodec(CompressionKind_ZSTD)->type());
+  EXPECT_THROW(
+      compressionKindToCodec(CompressionKind_LZO),
+      facebook::velox::VeloxException);
+  ASSERT_EQ(2, numCodecsCreated);
+
+  EXPECT_THROW(
+      registerCodecFactory(CompressionKind_MAX, makeLz4Codec),
+      facebook::velox::VeloxException);
+}
+
 TEST_F(CompressionTest, stringToCompressionKind) {
   EXPECT_EQ(stringToCompressionKind("none"), CompressionKind_NONE);
   EXPECT_EQ(stringToCompressionKind("zlib"), CompressionKind_ZLIB);
@@ -59,4 +105,55 @@ TEST_F(CompressionTest, stringToCompressionKind) {
   VELOX_ASSERT_THROW(
       stringToCompressionKind("bz2"), "Not support compression kind bz2");
 }
+
+TEST_F(CompressionTest, zstdDictionary) {
+  auto makeRecord = [](int32_t i) {
+    return fmt::format(
+        "{{\"id\": {}, \"name\": \"customer_{}\", \"nation\": \"nation_{}\", "
+        "\"segment\": \"{}\"}}",
+        i,
+        i * 7,
+        i % 25,
+        i % 3 == 0 ? "BUILDING" : "AUTOMOBILE");
+  };
+  std::vector<std::string> samples;
+  for (auto i = 0; i < 1'000; ++i) {
+    samples.push_back(makeRecord(i));
+  }
+  std::vector<std::string_view> sampleViews(samples.begin(), samples.end());
+  auto dictionary = ZstdDictionary::train(sampleViews, 4096, 3);
+  ASSERT_LE(dictionary->data().size(), 4096);
+
+  // A small block compresses better with the dictionary than alone.
+  const auto block = makeRecord(5'000) + makeRecord(5'001);
+  const auto plainSize = compressionKindToCodec(CompressionKind_ZSTD)
+                             ->compress(folly::IOBuf::wrapBuffer(
+                                 block.data(), block.size()))
+                             ->computeChainDataLength();
+
+  // A dictionary made from the stored bytes decompresses the block.
+  const ZstdDictionary copy(dictionary->data(), 3);
+  std::string compressed(ZstdDictionary::compressBound(block.size()), '\0');
+  const auto compressedSize =
+      dictionary->compress(block, compressed.data(), compressed.size());
+  ASSERT_LT(compressedSize, plainSize);
+  std::string decompressed(block.size(), '\0');
+  copy.decompress(
+      std::string_view(compressed.data(), compressedSize),
+      decompressed.data(),
+      decompressed.size());
+  ASSERT_EQ(block, decompressed);
+
+  // Too few samples to train on fall back to a raw content dictionary.
+  auto rawDictionary =
+      ZstdDictionary::train({sampleViews[0], sampleViews[1]}, 4096, 3);
+  ASSERT_EQ(samples[0] + samples[1], rawDictionary->data());
+  const auto rawSize =
+      rawDictionary->compress(block, compressed.data(), compressed.size());
+  rawDictionary->decompress(
+      std::string_view(compressed.data(), rawSize),
+      decompressed.data(),
+      decompressed.size());
+  ASSERT_EQ(block, decompressed);
+}
 } // namespace facebook::velox::common
@@ -18,7 +18,9 @@
 #include <folly/Portability.h>
 #include <folly/container/Foreach.h>
 #include <folly/io/Cursor.h>
+#include <folly/lang/Bits.h>
 #include <stdint.h>
+#include <cstring>
 
 namespace facebook::velox::encoding {
 
@@ -180,6 +182,65 @@ void Base64::encodeUrl(const char* data, size_t len, char* output) {
   encodeImpl(folly::StringPiece(data, len), kBase64UrlCharset, true, output);
 }
 
+namespace {
+
+// The two characters encoding each 12-bit value, so that a block of 3 input
+// bytes is encoded with 2 table lookups instead of 4.
+using PairTable = std::array<char, 2 * 4096>;
+
+constexpr PairTable makePairTable(const Base64::Charset& charset) {
+  PairTable pairs{};
+  for (int i = 0; i < 4096; ++i) {
+    pairs[2 * i] = charset[i >> 6];
+    pairs[2 * i + 1] = charset[i & 0x3f];
+  }
+  return pairs;
+}
+
+constexpr PairTable kBase64PairTable = makePairTable(kBase64Charset);
+constexpr PairTable kBase64UrlPairTable = makePairTable(kBase64UrlCharset);
+
+const PairTable& pairTable(const Base64::Charset& charset) {
+  if (&charset == &kBase64UrlCharset) {
+    return kBase64UrlPairTable;
+  }
+  DCHECK(&charset == &kBase64Charset);
+  return kBase64PairTable;
+}
+
+inline void writePair(const PairTable& pairs, uint32_t index, char* out) {
+  std::memcpy(out, pairs.data() + 2 * index, 2);
+}
+
+// Encodes the full 3 byte blocks of 'data' into 'out' and returns the number
+// of bytes encoded. While at least 8 bytes are left, loads 8 bytes at a time
+// and encodes the first 6 of them as four 12-bit values.
+size_t encodeBlocks(
+    const char* data,
+    size_t size,
+    const PairTable& pairs,
+    char* out) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 6, out += 8) {
+    const auto word =
+        folly::Endian::big(folly::loadUnaligned<uint64_t>(data + i));
+    writePair(pairs, word >> 52, out);
+    writePair(pairs, (word >> 40) & 0xfff, out + 2);
+    writePair(pairs, (word >> 28) & 0xfff, out + 4);
+    writePair(pairs, (word >> 16) & 0xfff, out + 6);
+  }
+  for (; i + kBinaryBlockByteSize <= size;
+       i += kBinaryBlockByteSize, out += kEncodedBlockByteSize) {
+    const uint32_t block = uint8_t(data[i]) << 16 |
+        uint8_t(data[i + 1]) << 8 | uint8_t(data[i + 2]);
+    writePair(pairs, block >> 12, out);
+    writePair(pairs, block & 0xfff, out + 2);
+  }
+  return i;
+}
+
+} // namespace
+
 template <class T>
 /* static */ void Base64::encodeImpl(
     const T& data,
@@ -194,6 +255,14 @@ template <class T>
   auto wp = out;
   auto it = data.begin();
 
+  if constexpr (std::is_same_v<T, folly::StringPiece>) {
+    const auto numEncoded =
+        encodeBlocks(data.data(), len, pairTable(charset), wp);
+    it += numEncoded;
+    wp += numEncoded / kBinaryBlockByteSize * kEncodedBlockByteSize;
+    len -= numEncoded;
+  }
+
   // For each group of 3 bytes (24 bits) in the input, split that into
   // 4 groups of 6 bits and encode that using the supplied charset lookup
   for (; len > 2; len -= 3) {
@@ -393,6 +462,26 @@ size_t Base64::decodeImpl(
         "output string is too small.");
   }
 
+  // Handle groups of 8 characters while more than 8 are left. Invalid
+  // characters map to values of at least 0x40, so that one check of the OR of
+  // the 8 values validates the group.
+  for (; src_len > 8; src_len -= 8, src += 8, dst += 6) {
+    uint64_t group = 0;
+    uint8_t allBits = 0;
+    for (auto i = 0; i < 8; ++i) {
+      const auto value = reverse_lookup[static_cast<uint8_t>(src[i])];
+      allBits |= value;
+      group = (group << 6) | value;
+    }
+    if (allBits >= 0x40) {
+      throw Base64Exception(
+          "Base64::decode() - invalid input string: invalid characters");
+    }
+    // The 48 decoded bits are written as 6 big-endian bytes.
+    group = folly::Endian::big(group << 16);
+    std::memcpy(dst, &group, 6);
+  }
+
   // Handle full groups of 4 characters
   for (; src_len > 4; src_len -= 4, src += 4, dst += 3) {
     // Each character of the 4 encode 6 bits of the original, grab each with
@@ -86,4 +86,43 @@ TEST_F(Base64Test, calculateDecodedSizeProperSize) {
   EXPECT_EQ(14, encoded_size);
 }
 
+TEST_F(Base64Test, roundTrip) {
+  // Covers the 8 character groups of decoding and the 6 byte groups of
+  // encoding followed by each length of tail.
+  std::string data;
+  for (auto size = 0; size < 100; ++size) {
+    data.resize(size);
+    for (auto i = 0; i < size; ++i) {
+      data[i] = static_cast<char>(i * 37 + size);
+    }
+    const auto encoded = Base64::encode(folly::StringPiece(data));
+    EXPECT_EQ(Base64::calculateEncodedSize(size), encoded.size());
+    EXPECT_EQ(data, Base64::decode(folly::StringPiece(encoded)));
+
+    std::string withPrefix = "prefix";
+    Base64::encodeAppend(folly::StringPiece(data), withPrefix);
+    EXPECT_EQ("prefix" + encoded, withPrefix);
+
+    const auto urlEncoded = Base64::encodeUrl(folly::StringPiece(data));
+    EXPECT_EQ(data, Base64::decodeUrl(folly::StringPiece(urlEncoded)));
+  }
+
+  EXPECT_EQ(
+      "QWJjZGVmZ2hpamtsbW5vcHFyc3R1dnd4eXo=",
+      Base64::encode(folly::StringPiece("Abcdefghijklmnopqrstuvwxyz")));
+  EXPECT_EQ(
+      "Abcdefghijklmnopqrstuvwxyz",
+      Base64::decode(
+          folly::StringPiece("QWJjZGVmZ2hpamtsbW5vcHFyc3R1dnd4eXo=")));
+}
+
+TEST_F(Base64Test, invalidCharacter) {
+  const std::string encoded = Base64::encode(std::string(60, 'x'));
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    auto invalid = encoded;
+    invalid[i] = '*';
+    EXPECT_THROW(Base64::decode(folly::StringPiece(invalid)), Base64Exception);
+  }
+}
+
 } // namespace facebook::velox::encoding
@@ -228,13 +228,19 @@ class InMemoryWriteFile final : public WriteFile {
 /// Current implementation for the local version is quite simple (e.g. no
 /// internal arenaing), as local disk writes are expected to be cheap. Local
 /// files match against any filepath starting with '/'.
+///
+/// If 'executor' is set, preadvAsync() runs the read on 'executor' and
+/// hasPreadvAsync() is true. The caller must keep the file and the buffers
+/// alive until the returned future completes.
 class LocalReadFile final : public ReadFile {
  public:
-  explicit LocalReadFile(std::string_view path);
+  explicit LocalReadFile(
+      std::string_view path,
+      folly::Executor* executor = nullptr);
 
   /// TODO: deprecate this after creating local file all through velox fs
   /// interface.
-  explicit LocalReadFile(int32_t fd);
+  explicit LocalReadFile(int32_t fd, folly::Executor* executor = nullptr);
 
   ~LocalReadFile();
 
@@ -247,6 +253,14 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override;
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
+  }
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -264,9 +278,15 @@ class LocalReadFile final : public ReadFile {
     return 10 << 20;
   }
 
+  /// Returns the file descriptor, e.g. for mapping the file.
+  int32_t fd() const {
+    return fd_;
+  }
+
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
+  folly::Executor* const executor_;
   std::string path_;
   int32_t fd_;
   long size_;
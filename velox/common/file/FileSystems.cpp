@@ -68,8 +68,10 @@ folly::once_flag localFSInstantiationFlag;
 // Implement Local FileSystem.
 class LocalFileSystem : public FileSystem {
  public:
-  explicit LocalFileSystem(std::shared_ptr<const Config> config)
-      : FileSystem(config) {}
+  LocalFileSystem(
+      std::shared_ptr<const Config> config,
+      folly::Executor* executor)
+      : FileSystem(config), executor_(executor) {}
 
   ~LocalFileSystem() override {}
 
@@ -87,7 +89,7 @@ class LocalFileSystem : public FileSystem {
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
       const FileOptions& /*unused*/) override {
-    return std::make_unique<LocalReadFile>(extractPath(path));
+    return std::make_unique<LocalReadFile>(extractPath(path), executor_);
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -184,23 +186,28 @@ class LocalFileSystem : public FileSystem {
 
   static std::function<std::shared_ptr<
       FileSystem>(std::shared_ptr<const Config>, std::string_view)>
-  fileSystemGenerator() {
-    return [](std::shared_ptr<const Config> properties,
-              std::string_view filePath) {
+  fileSystemGenerator(folly::Executor* executor) {
+    return [executor](
+               std::shared_ptr<const Config> properties,
+               std::string_view filePath) {
       // One instance of Local FileSystem is sufficient.
       // Initialize on first access and reuse after that.
       static std::shared_ptr<FileSystem> lfs;
-      folly::call_once(localFSInstantiationFlag, [&properties]() {
-        lfs = std::make_shared<LocalFileSystem>(properties);
+      folly::call_once(localFSInstantiationFlag, [&properties, executor]() {
+        lfs = std::make_shared<LocalFileSystem>(properties, executor);
       });
       return lfs;
     };
   }
+
+ private:
+  folly::Executor* const executor_;
 };
 } // namespace
 
-void registerLocalFileSystem() {
+void registerLocalFileSystem(folly::Executor* executor) {
   registerFileSystem(
-      LocalFileSystem::schemeMatcher(), LocalFileSystem::fileSystemGenerator());
+      LocalFileSystem::schemeMatcher(),
+      LocalFileSystem::fileSystemGenerator(executor));
 }
 } // namespace facebook::velox::filesystems
@@ -22,6 +22,10 @@
 #include <memory>
 #include <string_view>
 
+namespace folly {
+class Executor;
+} // namespace folly
+
 namespace facebook::velox {
 class Config;
 class ReadFile;
@@ -119,7 +123,9 @@ void registerFileSystem(
         std::shared_ptr<const Config>,
         std::string_view)> fileSystemGenerator);
 
-/// Register the local filesystem.
-void registerLocalFileSystem();
+/// Register the local filesystem. If 'executor' is set, files opened for read
+/// support asynchronous preadvAsync() on 'executor'. Only the first
+/// registration takes effect.
+void registerLocalFileSystem(folly::Executor* executor = nullptr);
 
 } // namespace facebook::velox::filesystems
@@ -15,6 +15,7 @@
  */
 
 #include <fcntl.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
@@ -129,6 +130,31 @@ TEST(InMemoryFile, preadv) {
   EXPECT_EQ(expected, values);
 }
 
+TEST(LocalFile, preadvAsync) {
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  {
+    LocalWriteFile writeFile(filename, false, false);
+    writeData(&writeFile);
+    writeFile.close();
+  }
+  ASSERT_FALSE(LocalReadFile(filename).hasPreadvAsync());
+
+  folly::CPUThreadPoolExecutor executor(2);
+  LocalReadFile readFile(filename, &executor);
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+  readData(&readFile);
+  char head[10];
+  char tail[5];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, kOneMB),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(readFile.preadvAsync(0, buffers).get(), 15 + kOneMB);
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ddddd");
+}
+
 class LocalFileTest : public ::testing::TestWithParam<bool> {
  protected:
   LocalFileTest() : useFaultyFs_(GetParam()) {}
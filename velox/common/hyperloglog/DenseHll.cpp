@@ -15,6 +15,8 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <array>
+#include <cmath>
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
@@ -205,13 +207,18 @@ struct DenseHllView {
 int64_t cardinalityImpl(const DenseHllView& hll) {
   auto numBuckets = 1 << hll.indexBitLength;
 
-  int32_t baselineCount = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    if (hll.getDelta(i) == 0) {
-      baselineCount++;
-    }
+  // Counts the buckets per delta in one pass over the packed deltas instead
+  // of unpacking and looking up overflows bucket by bucket. The loop has no
+  // dependencies between bytes and is unrolled by the compiler.
+  std::array<int32_t, kMaxDelta + 1> deltaCounts{};
+  const auto* deltas = reinterpret_cast<const uint8_t*>(hll.deltas);
+  for (auto i = 0; i < numBuckets / 2; ++i) {
+    ++deltaCounts[deltas[i] & kBucketMask];
+    ++deltaCounts[deltas[i] >> kBitsPerBucket];
   }
 
+  const int32_t baselineCount = deltaCounts[0];
+
   // If baseline is zero, then baselineCount is the number of buckets with value
   // 0.
   if ((hll.baseline == 0) &&
@@ -219,10 +226,21 @@ int64_t cardinalityImpl(const DenseHllView& hll) {
     return std::round(linearCounting(baselineCount, numBuckets));
   }
 
-  double sum = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    int value = hll.getValue(i);
-    sum += 1.0 / (1L << value);
+  // Buckets with the max delta and an overflow have a value above
+  // baseline + kMaxDelta. The terms are powers of 2, so the sum does not
+  // depend on the order of the buckets.
+  double overflowSum = 0;
+  for (auto i = 0; i < hll.overflows; ++i) {
+    if (hll.getDelta(hll.overflowBuckets[i]) == kMaxDelta) {
+      --deltaCounts[kMaxDelta];
+      overflowSum += std::ldexp(
+          1.0, -(hll.baseline + kMaxDelta + hll.overflowValues[i]));
+    }
+  }
+
+  double sum = overflowSum;
+  for (auto delta = 0; delta <= kMaxDelta; ++delta) {
+    sum += deltaCounts[delta] * std::ldexp(1.0, -(hll.baseline + delta));
   }
 
   double estimate = (alpha(hll.indexBitLength) * numBuckets * numBuckets) / sum;
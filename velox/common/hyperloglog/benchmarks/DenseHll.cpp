@@ -30,12 +30,14 @@ uint64_t hashOne(T value) {
   return XXH64(&value, sizeof(value), 0);
 }
 
-// A benchmark for DenseHll::mergeWith(serialized) API.
+// A benchmark for DenseHll::mergeWith(serialized) and
+// DenseHll::cardinality(serialized) APIs.
 //
-// Measures the time it takes to merge 2 serialized digests using different
-// values for hash bits. Larger values of hash bits corresponds to larger
-// digests that are more accurate, but slower to merge. The default number of
-// hash bits is 11, while in practice 16 is common.
+// Measures the time it takes to merge 2 serialized digests and to estimate the
+// cardinality of a serialized digest using different values for hash bits.
+// Larger values of hash bits corresponds to larger digests that are more
+// accurate, but slower to merge. The default number of hash bits is 11, while
+// in practice 16 is common.
 class DenseHllBenchmark {
  public:
   explicit DenseHllBenchmark(memory::MemoryPool* pool) : pool_(pool) {
@@ -58,6 +60,14 @@ class DenseHllBenchmark {
     }
   }
 
+  void runCardinality(int hashBits) {
+    int64_t sum = 0;
+    for (const auto& serialized : serializedHlls_.at(hashBits)) {
+      sum += common::hll::DenseHll::cardinality(serialized.data());
+    }
+    folly::doNotOptimizeAway(sum);
+  }
+
  private:
   std::string makeSerializedHll(int hashBits, int32_t step) {
     HashStringAllocator allocator(pool_);
@@ -100,6 +110,18 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK(cardinalitySerialized11) {
+  benchmark->runCardinality(11);
+}
+
+BENCHMARK(cardinalitySerialized12) {
+  benchmark->runCardinality(12);
+}
+
+BENCHMARK(cardinalitySerialized16) {
+  benchmark->runCardinality(16);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
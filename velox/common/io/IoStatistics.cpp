@@ -15,6 +15,7 @@
  */
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <atomic>
 #include <utility>
 
@@ -100,6 +101,56 @@ IoStatistics::operationStats() const {
   return operationStats_;
 }
 
+namespace {
+// Number of storage reads needed for coalesceDistance().
+constexpr double kMinStorageReads = 16;
+// Number of storage reads after which the sums are halved.
+constexpr double kMaxStorageReads = 1'000;
+} // namespace
+
+void IoStatistics::recordStorageRead(uint64_t bytes, uint64_t usecs) {
+  std::lock_guard<std::mutex> l(storageReadsMutex_);
+  auto& sums = storageReads_;
+  if (sums.count >= kMaxStorageReads) {
+    sums.count /= 2;
+    sums.bytes /= 2;
+    sums.usecs /= 2;
+    sums.bytesSquared /= 2;
+    sums.bytesUsecs /= 2;
+  }
+  const double x = bytes;
+  const double y = usecs;
+  ++sums.count;
+  sums.bytes += x;
+  sums.usecs += y;
+  sums.bytesSquared += x * x;
+  sums.bytesUsecs += x * y;
+}
+
+int32_t IoStatistics::coalesceDistance(int32_t defaultDistance) const {
+  std::lock_guard<std::mutex> l(storageReadsMutex_);
+  const auto& sums = storageReads_;
+  if (sums.count < kMinStorageReads) {
+    return defaultDistance;
+  }
+  const double meanBytes = sums.bytes / sums.count;
+  const double meanUsecs = sums.usecs / sums.count;
+  const double bytesVariance =
+      sums.bytesSquared / sums.count - meanBytes * meanBytes;
+  // Reads of about the same size do not separate latency from transfer time.
+  if (bytesVariance <= 0.01 * meanBytes * meanBytes) {
+    return defaultDistance;
+  }
+  const double usecsPerByte =
+      (sums.bytesUsecs / sums.count - meanBytes * meanUsecs) / bytesVariance;
+  const double latencyUsecs = meanUsecs - usecsPerByte * meanBytes;
+  if (usecsPerByte <= 0 || latencyUsecs <= 0) {
+    return defaultDistance;
+  }
+  return std::clamp<double>(
+      latencyUsecs / usecsPerByte, kMinCoalesceDistance, kMaxCoalesceDistance);
+}
+
 void IoStatistics::merge(const IoStatistics& other) {
   rawBytesRead_ += other.rawBytesRead_;
   rawBytesWritten_ += other.rawBytesWritten_;
@@ -110,7 +161,21 @@ void IoStatistics::merge(const IoStatistics& other) {
   read_.merge(other.read_);
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
+  remoteCacheRead_.merge(other.remoteCacheRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  StorageReadSums otherStorageReads;
+  {
+    std::lock_guard<std::mutex> l(other.storageReadsMutex_);
+    otherStorageReads = other.storageReads_;
+  }
+  {
+    std::lock_guard<std::mutex> l(storageReadsMutex_);
+    storageReads_.count += otherStorageReads.count;
+    storageReads_.bytes += otherStorageReads.bytes;
+    storageReads_.usecs += otherStorageReads.usecs;
+    storageReads_.bytesSquared += otherStorageReads.bytesSquared;
+    storageReads_.bytesUsecs += otherStorageReads.bytesUsecs;
+  }
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
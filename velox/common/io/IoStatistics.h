@@ -91,6 +91,10 @@ class IoCounter {
 
 class IoStatistics {
  public:
+  /// Bounds of coalesceDistance().
+  static constexpr int32_t kMinCoalesceDistance = 8 << 10; // 8K
+  static constexpr int32_t kMaxCoalesceDistance = 16 << 20; // 16M
+
   uint64_t rawBytesRead() const;
   uint64_t rawOverreadBytes() const;
   uint64_t rawBytesWritten() const;
@@ -117,6 +121,10 @@ class IoStatistics {
     return ssdRead_;
   }
 
+  IoCounter& remoteCacheRead() {
+    return remoteCacheRead_;
+  }
+
   IoCounter& ramHit() {
     return ramHit_;
   }
@@ -139,6 +147,16 @@ class IoStatistics {
 
   std::unordered_map<std::string, OperationCounters> operationStats() const;
 
+  /// Records a read of 'bytes' from storage in one request that took 'usecs'.
+  void recordStorageRead(uint64_t bytes, uint64_t usecs);
+
+  /// Returns the gap in bytes between two reads below which reading through
+  /// the gap takes less time than making a separate request. This is the
+  /// latency of a request times the throughput, fitted to the recorded
+  /// storage reads. Returns 'defaultDistance' until the reads are enough to
+  /// tell the latency from the transfer time.
+  int32_t coalesceDistance(int32_t defaultDistance) const;
+
   void merge(const IoStatistics& other);
 
   folly::dynamic getOperationStatsSnapshot() const;
@@ -164,12 +182,29 @@ class IoStatistics {
   // reads.
   IoCounter ssdRead_;
 
+  // Read from a remote cache tier after missing RAM and SSD.
+  IoCounter remoteCacheRead_;
+
   // Time spent by a query processing thread waiting for synchronously issued IO
   // or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
+
+  // Sums for the least squares fit of the time of a storage read to its size.
+  // Halved when 'count' reaches a limit, so that the fit follows changes in
+  // the storage.
+  struct StorageReadSums {
+    double count{0};
+    double bytes{0};
+    double usecs{0};
+    double bytesSquared{0};
+    double bytesUsecs{0};
+  };
+
+  StorageReadSums storageReads_;
+  mutable std::mutex storageReadsMutex_;
 };
 
 } // namespace facebook::velox::io
@@ -98,6 +98,14 @@ class ReaderOptions {
     return *this;
   }
 
+  /// Sets whether the coalesce distance is estimated from the latency and
+  /// throughput of the storage reads recorded in the IoStatistics of the
+  /// input. The maximum coalesce distance is used until there are enough reads.
+  ReaderOptions& setAdaptiveCoalesce(bool adaptive) {
+    adaptiveCoalesce_ = adaptive;
+    return *this;
+  }
+
   /// Modifies the maximum load coalesce bytes.
   ReaderOptions& setMaxCoalesceBytes(int64_t bytes) {
     maxCoalesceBytes_ = bytes;
@@ -110,6 +118,13 @@ class ReaderOptions {
     return *this;
   }
 
+  /// Modifies the number of compressed pages of each column to decompress
+  /// ahead of use on the executor of the input. 0 disables read-ahead.
+  ReaderOptions& setPageReadAhead(int32_t numPages) {
+    pageReadAhead_ = numPages;
+    return *this;
+  }
+
   /// Gets the memory allocator.
   velox::memory::MemoryPool& memoryPool() const {
     return *memoryPool_;
@@ -131,6 +146,10 @@ class ReaderOptions {
     return maxCoalesceDistance_;
   }
 
+  bool adaptiveCoalesce() const {
+    return adaptiveCoalesce_;
+  }
+
   int64_t maxCoalesceBytes() const {
     return maxCoalesceBytes_;
   }
@@ -139,6 +158,10 @@ class ReaderOptions {
     return prefetchRowGroups_;
   }
 
+  int32_t pageReadAhead() const {
+    return pageReadAhead_;
+  }
+
   bool noCacheRetention() const {
     return noCacheRetention_;
   }
@@ -153,8 +176,10 @@ class ReaderOptions {
   PrefetchMode prefetchMode_;
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
+  bool adaptiveCoalesce_{false};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  int32_t pageReadAhead_{0};
   bool noCacheRetention_{false};
 };
 } // namespace facebook::velox::io
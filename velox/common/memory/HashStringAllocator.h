@@ -321,6 +321,14 @@ class HashStringAllocator : public StreamArena {
     return minFree;
   }
 
+  /// Returns the percentage of the memory reserved for blocks that is free. A
+  /// high value after many frees means that the live blocks are scattered
+  /// over mostly free memory.
+  int32_t fragmentationPct() const {
+    const int64_t reservedBytes = state_.pool().allocatedBytes();
+    return reservedBytes == 0 ? 0 : state_.freeBytes() * 100 / reservedBytes;
+  }
+
   /// Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() override;
 
@@ -52,6 +52,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.hugePageSizeClassPages = options.hugePageSizeClassPages;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -73,6 +74,12 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
        .memoryPoolTransferCapacity = options.memoryPoolTransferCapacity,
        .memoryReclaimWaitMs = options.memoryReclaimWaitMs,
        .globalArbitrationEnabled = options.globalArbitrationEnabled,
+       .protectedPriority = options.arbitratorProtectedPriority,
+       .protectedPoolReservedCapacity = options.protectedPoolReservedCapacity,
+       .backgroundReclaimLowWatermarkPct =
+           options.arbitratorBackgroundReclaimLowWatermarkPct,
+       .backgroundReclaimHighWatermarkPct =
+           options.arbitratorBackgroundReclaimHighWatermarkPct,
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
        .checkUsageLeak = options.checkUsageLeak});
 }
@@ -100,6 +107,7 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      threadLocalReservationBytes_(options.threadLocalReservationBytes),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -120,7 +128,9 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .trackUsage = options.trackDefaultUsage,
               .debugEnabled = options.debugEnabled,
               .coreOnAllocationFailureEnabled =
-                  options.coreOnAllocationFailureEnabled})},
+                  options.coreOnAllocationFailureEnabled,
+              .threadLocalReservationBytes =
+                  options.threadLocalReservationBytes})},
       spillPool_{addLeafPool("__sys_spilling__")},
       sharedLeafPools_(createSharedLeafMemoryPools(*sysRoot_)) {
   VELOX_CHECK_NOT_NULL(allocator_);
@@ -227,6 +237,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.threadLocalReservationBytes = threadLocalReservationBytes_;
 
   std::unique_lock guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
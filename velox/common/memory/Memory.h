@@ -81,6 +81,12 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// If not zero, thread-safe leaf memory pools serve the allocations of up to
+  /// this many bytes from per-thread reservation caches to avoid contention on
+  /// the pool. Each thread may hold up to twice this many bytes of unused
+  /// reservation per pool. See MemoryPool::Options.
+  uint64_t threadLocalReservationBytes{0};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -124,6 +130,12 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t maxMallocBytes{3072};
 
+  /// If not zero, the size classes of at least this many pages are backed by
+  /// transparent huge pages where the kernel can.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  int32_t hugePageSizeClassPages{0};
+
   /// The memory allocations with size smaller than this threshold check the
   /// capacity with local sharded counter to reduce the lock contention on the
   /// global allocation counter. The sharded local counters reserve/release
@@ -184,6 +196,23 @@ struct MemoryManagerOptions {
   /// memory pools.
   bool globalArbitrationEnabled{false};
 
+  /// Query memory pools with a priority of at least this value are never
+  /// aborted by the memory arbitrator to free up memory for other queries.
+  int32_t arbitratorProtectedPriority{std::numeric_limits<int32_t>::max()};
+
+  /// The minimal memory capacity kept by a protected query memory pool when
+  /// the memory arbitrator reclaims memory from it for other queries.
+  uint64_t protectedPoolReservedCapacity{0};
+
+  /// If not zero, the memory arbitrator reclaims used memory by spilling in
+  /// the background when its free capacity falls below this percentage of its
+  /// capacity.
+  uint32_t arbitratorBackgroundReclaimLowWatermarkPct{0};
+
+  /// The percentage of the memory arbitrator capacity to make free by a
+  /// background reclaim.
+  uint32_t arbitratorBackgroundReclaimHighWatermarkPct{0};
+
   /// Provided by the query system to validate the state after a memory pool
   /// enters arbitration if not null. For instance, Prestissimo provides
   /// callback to check if a memory arbitration request is issued from a driver
@@ -318,6 +347,7 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const uint64_t threadLocalReservationBytes_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
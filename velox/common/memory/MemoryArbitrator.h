@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <limits>
 #include <vector>
 
 #include "velox/common/base/Exceptions.h"
@@ -79,6 +80,25 @@ class MemoryArbitrator {
     /// memory pools.
     bool globalArbitrationEnabled{false};
 
+    /// Query memory pools with a priority of at least 'protectedPriority' are
+    /// never aborted to free up memory for other queries. See
+    /// MemoryPool::priority().
+    int32_t protectedPriority{std::numeric_limits<int32_t>::max()};
+
+    /// The minimal memory capacity kept by a protected query memory pool when
+    /// memory is reclaimed from it for other queries. Applies in addition to
+    /// 'memoryPoolReservedCapacity'.
+    uint64_t protectedPoolReservedCapacity{0};
+
+    /// If not zero, the arbitrator starts to reclaim used memory by spilling in
+    /// the background when its free capacity falls below this percentage of
+    /// its capacity, so that memory is freed ahead of the memory requests.
+    uint32_t backgroundReclaimLowWatermarkPct{0};
+
+    /// The percentage of the arbitrator capacity to make free by a background
+    /// reclaim. Must be at least 'backgroundReclaimLowWatermarkPct'.
+    uint32_t backgroundReclaimHighWatermarkPct{0};
+
     /// Provided by the query system to validate the state after a memory pool
     /// enters arbitration if not null. For instance, Prestissimo provides
     /// callback to check if a memory arbitration request is issued from a
@@ -263,9 +283,18 @@ class MemoryArbitrator {
         memoryPoolTransferCapacity_(config.memoryPoolTransferCapacity),
         memoryReclaimWaitMs_(config.memoryReclaimWaitMs),
         globalArbitrationEnabled_(config.globalArbitrationEnabled),
+        protectedPriority_(config.protectedPriority),
+        protectedPoolReservedCapacity_(config.protectedPoolReservedCapacity),
+        backgroundReclaimLowWatermarkPct_(
+            config.backgroundReclaimLowWatermarkPct),
+        backgroundReclaimHighWatermarkPct_(
+            config.backgroundReclaimHighWatermarkPct),
         arbitrationStateCheckCb_(config.arbitrationStateCheckCb),
         checkUsageLeak_(config.checkUsageLeak) {
     VELOX_CHECK_LE(reservedCapacity_, capacity_);
+    VELOX_CHECK_LE(
+        backgroundReclaimLowWatermarkPct_, backgroundReclaimHighWatermarkPct_);
+    VELOX_CHECK_LE(backgroundReclaimHighWatermarkPct_, 100);
   }
 
   /// Helper utilities used by the memory arbitrator implementations to call
@@ -281,6 +310,10 @@ class MemoryArbitrator {
   const uint64_t memoryPoolTransferCapacity_;
   const uint64_t memoryReclaimWaitMs_;
   const bool globalArbitrationEnabled_;
+  const int32_t protectedPriority_;
+  const uint64_t protectedPoolReservedCapacity_;
+  const uint32_t backgroundReclaimLowWatermarkPct_;
+  const uint32_t backgroundReclaimHighWatermarkPct_;
   const MemoryArbitrationStateCheckCB arbitrationStateCheckCb_;
   const bool checkUsageLeak_;
 };
@@ -19,6 +19,8 @@
 #include <signal.h>
 #include <set>
 
+#include <folly/ThreadLocal.h>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
@@ -222,7 +224,8 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      threadLocalReservationBytes_(options.threadLocalReservationBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -407,6 +410,87 @@ size_t MemoryPool::preferredSize(size_t size) {
   return lower * 2;
 }
 
+// Caches reservation of a leaf memory pool per thread. A thread reserves
+// from the pool in chunks of 'chunkBytes' and serves its small allocations from
+// the chunk. A free adds the bytes to the cache of the freeing thread, which
+// returns the excess to the pool when it holds more than two chunks.
+class MemoryPoolImpl::ThreadReservations {
+ public:
+  ThreadReservations(MemoryPoolImpl* pool, uint64_t chunkBytes)
+      : pool_(pool),
+        chunkBytes_(chunkBytes),
+        caches_([pool]() { return new Cache(pool); }) {}
+
+  // Takes 'size' bytes from the cache of the calling thread. Returns false if
+  // 'size' is too large or the pool can't reserve a new chunk, in which case
+  // the caller reserves 'size' from the pool.
+  bool reserve(uint64_t size) {
+    if (size > chunkBytes_) {
+      return false;
+    }
+    auto& cache = *caches_;
+    if (cache.bytes < size) {
+      try {
+        pool_->reserveThreadSafe(chunkBytes_);
+      } catch (const std::exception&) {
+        return false;
+      }
+      cache.bytes += chunkBytes_;
+    }
+    cache.bytes -= size;
+    return true;
+  }
+
+  // Returns 'size' bytes to the cache of the calling thread. Returns false if
+  // 'size' is too large, in which case the caller releases 'size' to the pool.
+  bool release(uint64_t size) {
+    if (size > chunkBytes_) {
+      return false;
+    }
+    auto& cache = *caches_;
+    cache.bytes += size;
+    if (cache.bytes > 2 * chunkBytes_) {
+      const auto excess = cache.bytes - chunkBytes_;
+      cache.bytes = chunkBytes_;
+      pool_->releaseThreadSafe(excess, false);
+    }
+    return true;
+  }
+
+  // Returns the bytes cached by all threads to the pool.
+  void flush() {
+    uint64_t bytes = 0;
+    for (auto& cache : caches_.accessAllThreads()) {
+      bytes += cache.bytes;
+      cache.bytes = 0;
+    }
+    if (bytes > 0) {
+      pool_->releaseThreadSafe(bytes, false);
+    }
+  }
+
+ private:
+  struct Tag {};
+
+  struct Cache {
+    explicit Cache(MemoryPoolImpl* _pool) : pool(_pool) {}
+
+    // Returns the bytes of an exiting thread to the pool.
+    ~Cache() {
+      if (bytes > 0) {
+        pool->releaseThreadSafe(bytes, false);
+      }
+    }
+
+    MemoryPoolImpl* const pool;
+    uint64_t bytes{0};
+  };
+
+  MemoryPoolImpl* const pool_;
+  const uint64_t chunkBytes_;
+  folly::ThreadLocal<Cache, Tag> caches_;
+};
+
 MemoryPoolImpl::MemoryPoolImpl(
     MemoryManager* memoryManager,
     const std::string& name,
@@ -431,9 +515,17 @@ MemoryPoolImpl::MemoryPoolImpl(
       isRoot() || (destructionCb_ == nullptr && growCapacityCb_ == nullptr),
       "Only root memory pool allows to set destruction and capacity grow callbacks: {}",
       name_);
+  if (isLeaf() && threadSafe_ && trackUsage_ &&
+      threadLocalReservationBytes_ > 0) {
+    threadReservations_ = std::make_unique<ThreadReservations>(
+        this, threadLocalReservationBytes_);
+  }
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
+  if (threadReservations_ != nullptr) {
+    threadReservations_->flush();
+  }
   DEBUG_LEAK_CHECK();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
@@ -739,7 +831,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .threadLocalReservationBytes = threadLocalReservationBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -767,7 +860,10 @@ bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
 void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
   if (FOLLY_LIKELY(trackUsage_)) {
     if (FOLLY_LIKELY(threadSafe_)) {
-      reserveThreadSafe(size, reserveOnly);
+      if (threadReservations_ == nullptr || reserveOnly ||
+          !threadReservations_->reserve(size)) {
+        reserveThreadSafe(size, reserveOnly);
+      }
     } else {
       reserveNonThreadSafe(size, reserveOnly);
     }
@@ -898,7 +994,10 @@ void MemoryPoolImpl::release() {
 void MemoryPoolImpl::release(uint64_t size, bool releaseOnly) {
   if (FOLLY_LIKELY(trackUsage_)) {
     if (FOLLY_LIKELY(threadSafe_)) {
-      releaseThreadSafe(size, releaseOnly);
+      if (threadReservations_ == nullptr || releaseOnly ||
+          !threadReservations_->release(size)) {
+        releaseThreadSafe(size, releaseOnly);
+      }
     } else {
       releaseNonThreadSafe(size, releaseOnly);
     }
@@ -157,6 +157,14 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If not zero, a thread-safe leaf memory pool serves the allocations of
+    /// up to this many bytes from per-thread reservation caches. A thread
+    /// reserves from the pool in chunks of this size and returns whole chunks
+    /// when it caches more than two, so most small allocations and frees skip
+    /// the pool mutex. The cached bytes count as used. Applies to the whole
+    /// memory pool tree like 'trackUsage'.
+    uint64_t threadLocalReservationBytes{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -414,6 +422,35 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Returns true if this memory pool has been aborted.
   virtual bool aborted() const;
 
+  /// Returns the priority of the query owning this root memory pool. The
+  /// memory arbitrator reclaims memory from and aborts the lower priority
+  /// queries first. The default is 0.
+  int32_t priority() const {
+    return priority_;
+  }
+
+  /// Sets the priority of this root memory pool.
+  void setPriority(int32_t priority) {
+    VELOX_CHECK(isRoot(), "Only root memory pool has a priority");
+    priority_ = priority;
+  }
+
+  /// Adds 'deltaBytes' to the forecast peak memory usage of the query owning
+  /// this memory pool. The operators publish their expected peak usage so
+  /// that the memory arbitrator can grow the query capacity in fewer and
+  /// larger steps, and knows the queries which are going to spill. Use
+  /// MemoryForecast to publish and withdraw the forecast of an operator.
+  void updateMemoryForecast(int64_t deltaBytes) {
+    root()->memoryForecast_ += deltaBytes;
+  }
+
+  /// Returns the forecast peak memory usage of the query owning this root
+  /// memory pool.
+  uint64_t memoryForecast() const {
+    VELOX_CHECK(isRoot(), "Only root memory pool has a memory forecast");
+    return std::max<int64_t>(0, memoryForecast_);
+  }
+
   /// The memory pool's execution stats.
   struct Stats {
     /// The current memory usage.
@@ -541,6 +578,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const uint64_t threadLocalReservationBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -551,6 +589,14 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Saves the aborted error exception which is only set if 'aborted_' is true.
   std::exception_ptr abortError_{nullptr};
 
+  /// The query priority used by the memory arbitrator. Only set for a root
+  /// memory pool.
+  std::atomic<int32_t> priority_{0};
+
+  /// The sum of the forecasts published through the pools of the query. Only
+  /// set for a root memory pool.
+  std::atomic<int64_t> memoryForecast_{0};
+
   mutable folly::SharedMutex poolMutex_;
   std::unordered_map<std::string, std::weak_ptr<MemoryPool>> children_;
 
@@ -1067,6 +1113,41 @@ class MemoryPoolImpl : public MemoryPool {
 
   // Map from address to 'AllocationRecord'.
   std::unordered_map<uint64_t, AllocationRecord> debugAllocRecords_;
+
+  // Per-thread reservation caches for small allocations. Set for thread-safe
+  // leaf pools with usage tracking if 'threadLocalReservationBytes_' is not
+  // zero.
+  class ThreadReservations;
+  std::unique_ptr<ThreadReservations> threadReservations_;
+};
+
+/// The forecast peak memory usage of an operator, published to the root
+/// memory pool of its query. The forecast is withdrawn on destruction.
+class MemoryForecast {
+ public:
+  explicit MemoryForecast(MemoryPool* pool) : pool_(pool) {}
+
+  MemoryForecast(const MemoryForecast&) = delete;
+  MemoryForecast& operator=(const MemoryForecast&) = delete;
+
+  ~MemoryForecast() {
+    set(0);
+  }
+
+  /// Replaces the published forecast with 'bytes'.
+  void set(uint64_t bytes) {
+    pool_->updateMemoryForecast(
+        static_cast<int64_t>(bytes) - static_cast<int64_t>(bytes_));
+    bytes_ = bytes;
+  }
+
+  uint64_t bytes() const {
+    return bytes_;
+  }
+
+ private:
+  MemoryPool* const pool_;
+  uint64_t bytes_{0};
 };
 
 /// An Allocator backed by a memory pool for STL containers.
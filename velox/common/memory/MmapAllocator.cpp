@@ -37,7 +37,11 @@ MmapAllocator::MmapAllocator(const Options& options)
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size,
+        size,
+        options.hugePageSizeClassPages > 0 &&
+            size >= options.hugePageSizeClassPages));
   }
 
   if (useMmapArena_) {
@@ -509,10 +513,14 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool useHugePages)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
+      useHugePages_(useHugePages),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
       mappedFreeLookup_((capacity_ / kPagesPerLookupBit / 64) + kSimdTail),
@@ -538,6 +546,14 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+#ifdef linux
+  // Pages are backed on first touch. The advice makes the kernel back aligned
+  // 2MB ranges with huge pages where it can. Failure only costs performance.
+  if (useHugePages_ && ::madvise(address_, byteSize_, MADV_HUGEPAGE) != 0) {
+    VELOX_MEM_LOG(WARNING) << "madvise hugepage for sizeClass " << unitSize_
+                           << " errno=" << folly::errnoStr(errno);
+  }
+#endif
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -605,6 +621,9 @@ std::string MmapAllocator::SizeClass::toString() const {
     auto mb = (AllocationTraits::pageBytes(count * unitSize_)) >> 20;
     out << "[size " << unitSize_ << ": " << count << "(" << mb
         << "MB) allocated " << mappedCount << " mapped";
+    if (useHugePages_) {
+      out << " huge pages";
+    }
     if (mappedFreeCount != numMappedFreePages_) {
       out << "Mismatched count of mapped free pages "
           << ". Actual= " << mappedFreeCount
@@ -80,6 +80,14 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If not zero, the address ranges of the size classes of at least this
+    /// many pages are advised to be backed by transparent huge pages. This
+    /// cuts TLB misses for large allocations, e.g. hash tables and row
+    /// containers. Class pages smaller than a huge page may split huge pages
+    /// when advised away, so this works best with size classes of at least
+    /// AllocationTraits::numPagesInHugePage() pages. 0 means disabled.
+    int32_t hugePageSizeClassPages = 0;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -168,7 +176,9 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'useHugePages' is true, the address range is advised to be backed
+    // by transparent huge pages.
+    SizeClass(size_t capacity, MachinePageCount unitSize, bool useHugePages);
 
     ~SizeClass();
 
@@ -176,6 +186,10 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    bool useHugePages() const {
+      return useHugePages_;
+    }
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -276,6 +290,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size in bytes of the address range.
     const size_t byteSize_;
 
+    // True if the address range is advised to use transparent huge pages.
+    const bool useHugePages_;
+
     // Number of meaningful words in 'pageAllocated_'/'pageMapped'. The arrays
     // themselves are padded with extra zeros for SIMD access.
     const int32_t pageBitmapSize_;
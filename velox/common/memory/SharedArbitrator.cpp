@@ -78,6 +78,8 @@ void sortCandidatesByReclaimableFreeCapacity(
       &candidates);
 }
 
+// Sorts the candidates by priority and then by reclaimable used capacity so
+// that the lower priority queries are spilled first.
 void sortCandidatesByReclaimableUsedCapacity(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -85,6 +87,13 @@ void sortCandidatesByReclaimableUsedCapacity(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
+        // Spill the queries which are forecast to spill anyway first.
+        if (lhs.expectsSpill != rhs.expectsSpill) {
+          return lhs.expectsSpill;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -93,6 +102,8 @@ void sortCandidatesByReclaimableUsedCapacity(
       &candidates);
 }
 
+// Sorts the candidates by priority and then by usage so that the lower
+// priority queries are aborted first.
 void sortCandidatesByUsage(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -100,66 +111,92 @@ void sortCandidatesByUsage(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reservedBytes > rhs.reservedBytes;
       });
 }
 
-// Finds the candidate with the largest capacity. For 'requestor', the
-// capacity for comparison including its current capacity and the capacity to
-// grow.
-const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
+// Finds the candidate with the lowest priority and among these the one with
+// the largest capacity. For 'requestor', the capacity for comparison including
+// its current capacity and the capacity to grow. The candidates other than
+// 'requestor' with a priority of at least 'protectedPriority' are skipped.
+// Returns nullptr if there is no such candidate.
+const SharedArbitrator::Candidate* findCandidateWithLargestCapacity(
     MemoryPool* requestor,
     uint64_t targetBytes,
+    int32_t protectedPriority,
     const std::vector<SharedArbitrator::Candidate>& candidates) {
-  VELOX_CHECK(!candidates.empty());
-  int32_t candidateIdx{-1};
+  const SharedArbitrator::Candidate* victim{nullptr};
   int64_t maxCapacity{-1};
-  for (int32_t i = 0; i < candidates.size(); ++i) {
-    const bool isCandidate = candidates[i].pool == requestor;
+  for (const auto& candidate : candidates) {
+    const bool isCandidate = candidate.pool == requestor;
+    if (!isCandidate && candidate.priority >= protectedPriority) {
+      continue;
+    }
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
-        candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+        candidate.pool->capacity() + (isCandidate ? targetBytes : 0);
+    if (victim == nullptr || candidate.priority < victim->priority) {
+      victim = &candidate;
       maxCapacity = capacity;
       continue;
     }
-    if (capacity < maxCapacity) {
+    if (candidate.priority > victim->priority || capacity < maxCapacity) {
       continue;
     }
     if (capacity > maxCapacity) {
-      candidateIdx = i;
+      victim = &candidate;
       maxCapacity = capacity;
       continue;
     }
     // With the same amount of capacity, we prefer to kill the requestor itself
     // without affecting the other query.
     if (isCandidate) {
-      candidateIdx = i;
+      victim = &candidate;
     }
   }
-  VELOX_CHECK_NE(candidateIdx, -1);
-  return candidates[candidateIdx];
+  return victim;
 }
 } // namespace
 
 SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
     : MemoryArbitrator(config),
       freeReservedCapacity_(reservedCapacity_),
-      freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
+      freeNonReservedCapacity_(capacity_ - freeReservedCapacity_),
+      backgroundReclaimLowWatermark_(
+          capacity_ * backgroundReclaimLowWatermarkPct_ / 100),
+      backgroundReclaimHighWatermark_(
+          capacity_ * backgroundReclaimHighWatermarkPct_ / 100) {
   VELOX_CHECK_EQ(kind_, config.kind);
+  if (backgroundReclaimLowWatermark_ > 0) {
+    backgroundReclaimThread_ =
+        std::thread([this]() { backgroundReclaimLoop(); });
+  }
 }
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{}] PRIORITY[{}] EXPECTS_SPILL[{}] RECLAIMABLE_BYTES[{}] "
+      "FREE_BYTES[{}]]",
       pool->root()->name(),
+      priority,
+      expectsSpill,
       succinctBytes(reclaimableBytes),
       succinctBytes(freeBytes));
 }
 
 SharedArbitrator::~SharedArbitrator() {
+  if (backgroundReclaimThread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      stopBackgroundReclaim_ = true;
+    }
+    backgroundReclaimCv_.notify_one();
+    backgroundReclaimThread_.join();
+  }
   if (freeNonReservedCapacity_ + freeReservedCapacity_ != capacity_) {
     const std::string errMsg = fmt::format(
         "Unexpected free capacity leak in arbitrator: freeNonReservedCapacity_[{}] + freeReservedCapacity_[{}] != capacity_[{}])\\n{}",
@@ -186,6 +223,8 @@ void SharedArbitrator::getCandidateStats(
         {freeCapacityOnly ? 0 : reclaimableUsedCapacity(*pool, selfCandidate),
          reclaimableFreeCapacity(*pool, selfCandidate),
          pool->reservedBytes(),
+         pool->priority(),
+         expectsSpill(*pool),
          pool.get()});
   }
 }
@@ -211,7 +250,10 @@ int64_t SharedArbitrator::maxReclaimableCapacity(
   if (isSelfReclaim || (pool.reservedBytes() == 0 && pool.peakBytes() != 0)) {
     return pool.capacity();
   }
-  return std::max<int64_t>(0, pool.capacity() - memoryPoolReservedCapacity_);
+  const uint64_t reservedCapacity = isProtected(pool)
+      ? std::max(memoryPoolReservedCapacity_, protectedPoolReservedCapacity_)
+      : memoryPoolReservedCapacity_;
+  return std::max<int64_t>(0, pool.capacity() - reservedCapacity);
 }
 
 int64_t SharedArbitrator::reclaimableFreeCapacity(
@@ -236,6 +278,15 @@ int64_t SharedArbitrator::minGrowCapacity(const MemoryPool& pool) const {
           pool.capacity());
 }
 
+uint64_t SharedArbitrator::forecastGrowCapacity(const MemoryPool& pool) const {
+  const auto forecastBytes = pool.memoryForecast();
+  if (forecastBytes <= pool.capacity()) {
+    return 0;
+  }
+  return std::min<uint64_t>(
+      forecastBytes - pool.capacity(), maxGrowCapacity(pool));
+}
+
 uint64_t SharedArbitrator::growCapacity(
     MemoryPool* pool,
     uint64_t targetBytes) {
@@ -345,10 +396,19 @@ uint64_t SharedArbitrator::testingNumRequests() const {
   return numRequests_;
 }
 
+std::map<int32_t, uint64_t> SharedArbitrator::waitTimeUsByPriority() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return waitTimeUsByPriority_;
+}
+
 bool SharedArbitrator::growCapacity(
     MemoryPool* pool,
     const std::vector<std::shared_ptr<MemoryPool>>& candidatePools,
     uint64_t targetBytes) {
+  // NOTE: the background reclaim is checked after the arbitration completes
+  // and 'scopedArbitration' is destroyed.
+  auto backgroundReclaimGuard = folly::makeGuard(
+      [&]() { maybeStartBackgroundReclaim(candidatePools); });
   ArbitrationOperation op(pool, targetBytes, candidatePools);
   ScopedArbitration scopedArbitration(this, &op);
 
@@ -365,6 +425,68 @@ bool SharedArbitrator::growCapacity(
   return runGlobalArbitration(&op);
 }
 
+void SharedArbitrator::maybeStartBackgroundReclaim(
+    const std::vector<std::shared_ptr<MemoryPool>>& candidatePools) {
+  if (backgroundReclaimLowWatermark_ == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (freeNonReservedCapacity_ + freeReservedCapacity_ >=
+        backgroundReclaimLowWatermark_) {
+      return;
+    }
+    backgroundReclaimPools_.clear();
+    for (const auto& pool : candidatePools) {
+      backgroundReclaimPools_.push_back(pool);
+    }
+  }
+  backgroundReclaimCv_.notify_one();
+}
+
+void SharedArbitrator::backgroundReclaimLoop() {
+  for (;;) {
+    std::vector<std::weak_ptr<MemoryPool>> candidatePools;
+    {
+      std::unique_lock<std::mutex> l(mutex_);
+      backgroundReclaimCv_.wait(l, [&]() {
+        return stopBackgroundReclaim_ || !backgroundReclaimPools_.empty();
+      });
+      if (stopBackgroundReclaim_) {
+        return;
+      }
+      candidatePools.swap(backgroundReclaimPools_);
+    }
+    backgroundReclaim(candidatePools);
+  }
+}
+
+void SharedArbitrator::backgroundReclaim(
+    const std::vector<std::weak_ptr<MemoryPool>>& candidatePools) {
+  // NOTE: the pools are released outside of 'mutex_' as the destruction of a
+  // root pool returns its capacity to the arbitrator.
+  std::vector<std::shared_ptr<MemoryPool>> pools;
+  pools.reserve(candidatePools.size());
+  for (const auto& candidatePool : candidatePools) {
+    if (auto pool = candidatePool.lock()) {
+      pools.push_back(std::move(pool));
+    }
+  }
+  uint64_t freeCapacity;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    freeCapacity = freeNonReservedCapacity_ + freeReservedCapacity_;
+  }
+  if (pools.empty() || freeCapacity >= backgroundReclaimHighWatermark_) {
+    return;
+  }
+  RECORD_METRIC_VALUE(kMetricArbitratorBackgroundReclaimCount);
+  const uint64_t reclaimedBytes = shrinkCapacity(
+      pools, backgroundReclaimHighWatermark_ - freeCapacity, true, false);
+  RECORD_METRIC_VALUE(
+      kMetricArbitratorBackgroundReclaimedBytes, reclaimedBytes);
+}
+
 bool SharedArbitrator::runLocalArbitration(
     ArbitrationOperation* op,
     bool& needGlobalArbitration) {
@@ -492,9 +614,14 @@ void SharedArbitrator::getGrowTargets(
     ArbitrationOperation* op,
     uint64_t& maxGrowTarget,
     uint64_t& minGrowTarget) {
+  // Grows up to the forecast peak usage at once to save the arbitration
+  // rounds of the later growths.
   maxGrowTarget = std::min(
       maxGrowCapacity(*op->requestRoot),
-      std::max(memoryPoolTransferCapacity_, op->targetBytes));
+      std::max(
+          {memoryPoolTransferCapacity_,
+           op->targetBytes,
+           forecastGrowCapacity(*op->requestRoot)}));
   minGrowTarget = minGrowCapacity(*op->requestRoot);
 }
 
@@ -542,9 +669,15 @@ bool SharedArbitrator::ensureCapacity(ArbitrationOperation* op) {
 }
 
 bool SharedArbitrator::handleOOM(ArbitrationOperation* op) {
-  MemoryPool* victim = findCandidateWithLargestCapacity(
-                           op->requestRoot, op->targetBytes, op->candidates)
-                           .pool;
+  const auto* candidate = findCandidateWithLargestCapacity(
+      op->requestRoot, op->targetBytes, protectedPriority_, op->candidates);
+  if (candidate == nullptr) {
+    VELOX_MEM_LOG(ERROR)
+        << "No victim memory pool to abort for requestor "
+        << op->requestRoot->name() << " as all the others are protected";
+    return false;
+  }
+  MemoryPool* victim = candidate->pool;
   if (op->requestRoot == victim) {
     VELOX_MEM_LOG(ERROR)
         << "Requestor memory pool " << op->requestRoot->name()
@@ -685,8 +818,10 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
   uint64_t reclaimedBytes{0};
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(reclaimedBytes, reclaimTargetBytes);
+    // NOTE: the candidates are sorted by priority first, so a higher priority
+    // candidate might still have reclaimable bytes.
     if (candidate.reclaimableBytes == 0) {
-      break;
+      continue;
     }
     reclaimedBytes +=
         reclaim(candidate.pool, reclaimTargetBytes - reclaimedBytes, false);
@@ -706,9 +841,14 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesByAbort(
   uint64_t freedBytes{0};
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(freedBytes, reclaimTargetBytes);
-    if (candidate.pool->capacity() == 0) {
+    // NOTE: the candidates are sorted by priority first, so all the remaining
+    // candidates are protected.
+    if (candidate.priority >= protectedPriority_) {
       break;
     }
+    if (candidate.pool->capacity() == 0) {
+      continue;
+    }
     try {
       VELOX_MEM_POOL_ABORTED(fmt::format(
           "Memory pool aborted to reclaim used memory, current usage {}, "
@@ -865,7 +1005,8 @@ SharedArbitrator::ScopedArbitration::ScopedArbitration(
     : operation_(operation),
       arbitrator_(arbitrator),
       arbitrationCtx_(operation->requestPool),
-      startTime_(std::chrono::steady_clock::now()) {
+      startTime_(std::chrono::steady_clock::now()),
+      span_("SharedArbitrator::arbitration") {
   VELOX_CHECK_NOT_NULL(arbitrator_);
   VELOX_CHECK_NOT_NULL(operation_);
   operation_->enterArbitration();
@@ -914,10 +1055,22 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
   arbitrator_->arbitrationTimeUs_ += arbitrationTimeUs;
 
   const uint64_t waitTimeUs = operation_->waitTimeUs();
+  if (span_.isSampled()) {
+    span_.addAttribute("targetBytes", std::to_string(operation_->targetBytes));
+    span_.addAttribute("waitTimeUs", std::to_string(waitTimeUs));
+    if (operation_->requestPool != nullptr) {
+      span_.addAttribute("pool", operation_->requestPool->name());
+    }
+  }
   if (waitTimeUs != 0) {
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricArbitratorWaitTimeMs, waitTimeUs / 1'000);
     arbitrator_->waitTimeUs_ += waitTimeUs;
+    if (operation_->requestRoot != nullptr) {
+      std::lock_guard<std::mutex> l(arbitrator_->mutex_);
+      arbitrator_->waitTimeUsByPriority_[operation_->requestRoot->priority()] +=
+          waitTimeUs;
+    }
   }
 }
 
@@ -16,12 +16,17 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <map>
+#include <thread>
+
 #include "velox/common/memory/MemoryArbitrator.h"
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/TraceSpan.h"
 
 namespace facebook::velox::memory {
 
@@ -69,6 +74,10 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     int64_t reclaimableBytes{0};
     int64_t freeBytes{0};
     int64_t reservedBytes{0};
+    int32_t priority{0};
+    // True if the forecast peak usage of the pool does not fit in its
+    // capacity limits, so it is going to spill anyway.
+    bool expectsSpill{false};
     MemoryPool* pool;
 
     std::string toString() const;
@@ -79,6 +88,10 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   uint64_t testingNumRequests() const;
 
+  /// Returns the accumulated arbitration wait time in microseconds of the
+  /// requests from the query memory pools keyed by the pool priority.
+  std::map<int32_t, uint64_t> waitTimeUsByPriority() const;
+
   /// Enables/disables global arbitration accordingly.
   void testingSetGlobalArbitration(bool enableGlobalArbitration) {
     *const_cast<bool*>(&globalArbitrationEnabled_) = enableGlobalArbitration;
@@ -161,6 +174,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     SharedArbitrator* const arbitrator_;
     const ScopedMemoryArbitrationContext arbitrationCtx_;
     const std::chrono::steady_clock::time_point startTime_;
+    // Covers the arbitration including the wait for other arbitrations of
+    // the same query.
+    process::TraceSpan span_;
   };
 
   // The arbitration running queue for arbitration requests from the same query
@@ -318,6 +334,20 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void incrementGlobalArbitrationCount();
   void incrementLocalArbitrationCount();
 
+  // Wakes up 'backgroundReclaimThread_' to reclaim from 'candidatePools' if
+  // the free capacity has fallen below the low watermark.
+  void maybeStartBackgroundReclaim(
+      const std::vector<std::shared_ptr<MemoryPool>>& candidatePools);
+
+  // The loop run by 'backgroundReclaimThread_' until the arbitrator destructs.
+  void backgroundReclaimLoop();
+
+  // Spills from 'candidatePools' until the free capacity reaches the high
+  // watermark. The candidates are spilled in the same order as by a global
+  // arbitration.
+  void backgroundReclaim(
+      const std::vector<std::weak_ptr<MemoryPool>>& candidatePools);
+
   std::string toStringLocked() const;
 
   Stats statsLocked() const;
@@ -347,6 +377,22 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // the reserved capacity as specified by 'memoryPoolReservedCapacity_'.
   int64_t minGrowCapacity(const MemoryPool& pool) const;
 
+  // Returns the capacity to grow for 'pool' to reach its forecast peak usage.
+  uint64_t forecastGrowCapacity(const MemoryPool& pool) const;
+
+  // Returns true if the forecast peak usage of 'pool' exceeds its max
+  // capacity or the arbitrator capacity.
+  bool expectsSpill(const MemoryPool& pool) const {
+    return pool.memoryForecast() >
+        std::min<uint64_t>(pool.maxCapacity(), capacity_);
+  }
+
+  // Returns true if 'pool' is protected from being aborted for other queries
+  // by its priority.
+  bool isProtected(const MemoryPool& pool) const {
+    return pool.priority() >= protectedPriority_;
+  }
+
   // Returns true if 'pool' is under memory arbitration.
   bool isUnderArbitration(MemoryPool* pool) const;
   bool isUnderArbitrationLocked(MemoryPool* pool) const;
@@ -376,6 +422,23 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   tsan_atomic<uint64_t> numAborted_{0};
   std::atomic_uint64_t numFailures_{0};
   std::atomic_uint64_t waitTimeUs_{0};
+  // The arbitration wait time in microseconds keyed by the priority of the
+  // request pools. Guarded by 'mutex_'.
+  std::map<int32_t, uint64_t> waitTimeUsByPriority_;
+
+  // The free capacity below which a background reclaim starts and the free
+  // capacity it reclaims up to. Zero if background reclaim is disabled.
+  const uint64_t backgroundReclaimLowWatermark_;
+  const uint64_t backgroundReclaimHighWatermark_;
+  // Signaled by maybeStartBackgroundReclaim() with 'mutex_'.
+  std::condition_variable backgroundReclaimCv_;
+  // The pools to reclaim from by the next background reclaim. Not empty if a
+  // background reclaim is requested. Guarded by 'mutex_'.
+  std::vector<std::weak_ptr<MemoryPool>> backgroundReclaimPools_;
+  // Set on destruction to stop 'backgroundReclaimThread_'. Guarded by
+  // 'mutex_'.
+  bool stopBackgroundReclaim_{false};
+  std::thread backgroundReclaimThread_;
   tsan_atomic<uint64_t> arbitrationTimeUs_{0};
   tsan_atomic<uint64_t> reclaimedFreeBytes_{0};
   tsan_atomic<uint64_t> reclaimedUsedBytes_{0};
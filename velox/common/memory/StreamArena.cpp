@@ -18,7 +18,71 @@
 
 namespace facebook::velox {
 
-StreamArena::StreamArena(memory::MemoryPool* pool) : pool_(pool) {}
+bool StreamArenaRecycler::get(
+    memory::MachinePageCount numPages,
+    memory::Allocation& allocation) {
+  VELOX_CHECK(allocation.empty());
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto i = 0; i < allocations_.size(); ++i) {
+    if (allocations_[i].numPages() < numPages) {
+      continue;
+    }
+    retainedBytes_ -= allocations_[i].byteSize();
+    allocation = std::move(allocations_[i]);
+    if (i + 1 < allocations_.size()) {
+      allocations_[i] = std::move(allocations_.back());
+    }
+    allocations_.pop_back();
+    return true;
+  }
+  return false;
+}
+
+void StreamArenaRecycler::release(memory::Allocation&& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  VELOX_CHECK_EQ(allocation.pool(), pool_);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (retainedBytes_ + allocation.byteSize() <= maxBytes_) {
+      retainedBytes_ += allocation.byteSize();
+      allocations_.push_back(std::move(allocation));
+      return;
+    }
+  }
+  pool_->freeNonContiguous(allocation);
+}
+
+uint64_t StreamArenaRecycler::clear() {
+  std::vector<memory::Allocation> allocations;
+  uint64_t freedBytes{0};
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    allocations.swap(allocations_);
+    freedBytes = retainedBytes_;
+    retainedBytes_ = 0;
+  }
+  for (auto& allocation : allocations) {
+    pool_->freeNonContiguous(allocation);
+  }
+  return freedBytes;
+}
+
+StreamArena::StreamArena(
+    memory::MemoryPool* pool,
+    StreamArenaRecycler* recycler)
+    : pool_(pool), recycler_(recycler) {
+  if (recycler_ != nullptr) {
+    VELOX_CHECK_EQ(recycler_->pool(), pool_);
+  }
+}
+
+void StreamArena::allocateNonContiguous(memory::MachinePageCount numPages) {
+  if (recycler_ == nullptr || !recycler_->get(numPages, allocation_)) {
+    pool_->allocateNonContiguous(numPages, allocation_);
+  }
+}
 
 void StreamArena::newRange(
     int32_t bytes,
@@ -46,8 +110,7 @@ void StreamArena::newRange(
       allocations_.push_back(
           std::make_unique<memory::Allocation>(std::move(allocation_)));
     }
-    pool_->allocateNonContiguous(
-        std::max(allocationQuantum_, numPages), allocation_);
+    allocateNonContiguous(std::max(allocationQuantum_, numPages));
     currentRun_ = 0;
     currentOffset_ = 0;
     size_ += allocation_.byteSize();
@@ -77,6 +140,12 @@ void StreamArena::newTinyRange(
   range->size = bytes;
 }
 void StreamArena::clear() {
+  if (recycler_ != nullptr) {
+    for (auto& allocation : allocations_) {
+      recycler_->release(std::move(*allocation));
+    }
+    recycler_->release(std::move(allocation_));
+  }
   allocations_.clear();
   pool_->freeNonContiguous(allocation_);
   currentRun_ = 0;
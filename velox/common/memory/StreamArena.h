@@ -20,13 +20,63 @@ namespace facebook::velox {
 
 struct ByteRange;
 
+/// A bounded pool of the non-contiguous allocations released by the
+/// StreamArenas on one memory pool, e.g. the destinations of a
+/// PartitionedOutput, which serialize and release one page after another.
+/// The arenas take their allocations from here before going to the memory
+/// pool, which saves the allocator calls per page. Thread-safe.
+class StreamArenaRecycler {
+ public:
+  /// Keeps up to 'maxBytes' of allocations from 'pool'.
+  StreamArenaRecycler(memory::MemoryPool* pool, uint64_t maxBytes)
+      : pool_(pool), maxBytes_(maxBytes) {}
+
+  ~StreamArenaRecycler() {
+    clear();
+  }
+
+  /// Moves a kept allocation of at least 'numPages' into 'allocation'.
+  /// Returns false if there is none.
+  bool get(memory::MachinePageCount numPages, memory::Allocation& allocation);
+
+  /// Keeps 'allocation' for reuse if within the limit. Frees it otherwise.
+  void release(memory::Allocation&& allocation);
+
+  /// Frees all kept allocations, e.g. on memory arbitration. Returns the
+  /// freed bytes.
+  uint64_t clear();
+
+  /// The bytes of the kept allocations.
+  uint64_t retainedBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return retainedBytes_;
+  }
+
+  memory::MemoryPool* pool() const {
+    return pool_;
+  }
+
+ private:
+  memory::MemoryPool* const pool_;
+  const uint64_t maxBytes_;
+
+  mutable std::mutex mutex_;
+  std::vector<memory::Allocation> allocations_;
+  uint64_t retainedBytes_{0};
+};
+
 /// An abstract class that holds memory for serialized vector content. A single
 /// repartitioning target is one use case: The bytes held are released as a unit
 /// when the destination acknowledges receipt. Another use case is a hash table
 /// partition that holds complex types as serialized rows.
 class StreamArena {
  public:
-  explicit StreamArena(memory::MemoryPool* pool);
+  /// If 'recycler' is set, the non-contiguous allocations are taken from and
+  /// released to 'recycler' instead of 'pool'. 'recycler' must be for 'pool'
+  /// and outlive 'this'.
+  explicit StreamArena(
+      memory::MemoryPool* pool,
+      StreamArenaRecycler* recycler = nullptr);
 
   virtual ~StreamArena() = default;
 
@@ -67,7 +117,11 @@ class StreamArena {
   virtual void clear();
 
  private:
+  // Sets 'allocation_' to at least 'numPages'.
+  void allocateNonContiguous(memory::MachinePageCount numPages);
+
   memory::MemoryPool* const pool_;
+  StreamArenaRecycler* const recycler_;
   const memory::MachinePageCount allocationQuantum_{2};
 
   // All non-contiguous allocations.
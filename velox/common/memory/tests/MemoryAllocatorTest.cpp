@@ -474,6 +474,38 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, hugePageSizeClasses) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.largestSizeClass = AllocationTraits::numPagesInHugePage();
+  options.hugePageSizeClassPages = 128;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  const auto& sizes = mmapAllocator->sizeClasses();
+  ASSERT_EQ(sizes.back(), AllocationTraits::numPagesInHugePage());
+  // The classes of 128, 256 and 512 pages use huge pages.
+  const auto description = mmapAllocator->toString();
+  size_t numHugePageClasses = 0;
+  for (auto pos = description.find("huge pages"); pos != std::string::npos;
+       pos = description.find("huge pages", pos + 1)) {
+    ++numHugePageClasses;
+  }
+  ASSERT_EQ(numHugePageClasses, 3);
+
+  // Allocations from the huge page classes are usable and freed as usual.
+  Allocation allocation;
+  ASSERT_TRUE(mmapAllocator->allocateNonContiguous(
+      2 * AllocationTraits::numPagesInHugePage(), allocation));
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    auto run = allocation.runAt(i);
+    ::memset(run.data(), 1, run.numBytes());
+  }
+  mmapAllocator->freeNonContiguous(allocation);
+  ASSERT_EQ(mmapAllocator->numAllocated(), 0);
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
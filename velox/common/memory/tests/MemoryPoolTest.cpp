@@ -2570,6 +2570,72 @@ TEST(MemoryPoolTest, visitChildren) {
   });
 }
 
+TEST(MemoryPoolTest, threadLocalReservation) {
+  constexpr uint64_t kChunkBytes = 64 * KB;
+  MemoryManagerOptions options;
+  options.allocatorCapacity = kMaxMemory;
+  options.threadLocalReservationBytes = kChunkBytes;
+  MemoryManager manager{options};
+  auto root = manager.addRootPool("root");
+  auto pool = root->addLeafChild("leaf");
+  auto* impl = static_cast<MemoryPoolImpl*>(pool.get());
+
+  // A small allocation takes a whole chunk for the thread.
+  void* small = pool->allocate(1 * KB);
+  ASSERT_EQ(pool->usedBytes(), kChunkBytes);
+  // Allocations up to the chunk size come from the chunk.
+  void* other = pool->allocate(8 * KB);
+  ASSERT_EQ(pool->usedBytes(), kChunkBytes);
+  // Large allocations bypass the cache.
+  void* large = pool->allocate(2 * MB);
+  ASSERT_EQ(pool->usedBytes(), kChunkBytes + 2 * MB);
+  pool->free(large, 2 * MB);
+  ASSERT_EQ(pool->usedBytes(), kChunkBytes);
+  const auto numAllocs = impl->stats().numAllocs;
+
+  // Small allocations and frees from many threads.
+  constexpr int32_t kNumThreads = 16;
+  std::vector<std::thread> threads;
+  std::vector<std::vector<void*>> buffers(kNumThreads);
+  for (int32_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (int32_t j = 0; j < 1'000; ++j) {
+        buffers[i].push_back(pool->allocate(256));
+        if (j % 2 == 1) {
+          pool->free(buffers[i].back(), 256);
+          buffers[i].pop_back();
+        }
+      }
+      for (auto* buffer : buffers[i]) {
+        pool->free(buffer, 256);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(impl->stats().numAllocs, numAllocs + kNumThreads * 1'000);
+
+  // Exited threads return their caches to the pool.
+  ASSERT_EQ(pool->usedBytes(), kChunkBytes);
+  ASSERT_EQ(root->usedBytes(), pool->usedBytes());
+
+  // The child pools inherit the option.
+  auto child = root->addAggregateChild("aggregate")->addLeafChild("child");
+  void* childBuffer = child->allocate(1 * KB);
+  ASSERT_EQ(child->usedBytes(), kChunkBytes);
+  child->free(childBuffer, 1 * KB);
+
+  pool->free(small, 1 * KB);
+  pool->free(other, 8 * KB);
+  // The calling thread keeps its cache until the pool is destroyed, which
+  // returns the reservation of all threads.
+  ASSERT_EQ(pool->usedBytes(), kChunkBytes);
+  pool.reset();
+  child.reset();
+  ASSERT_EQ(root->usedBytes(), 0);
+}
+
 TEST(MemoryPoolTest, debugMode) {
   FLAGS_velox_memory_pool_debug_enabled = true;
   constexpr int64_t kMaxMemory = 10 * GB;
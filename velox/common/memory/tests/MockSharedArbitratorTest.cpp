@@ -426,7 +426,10 @@ class MockSharedArbitrationTest : public testing::Test {
       uint64_t memoryPoolReserveCapacity = kMemoryPoolReservedCapacity,
       uint64_t memoryPoolTransferCapacity = kMemoryPoolTransferCapacity,
       std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr,
-      bool globalArtbitrationEnabled = true) {
+      bool globalArtbitrationEnabled = true,
+      int32_t protectedPriority = std::numeric_limits<int32_t>::max(),
+      uint32_t backgroundReclaimLowWatermarkPct = 0,
+      uint32_t backgroundReclaimHighWatermarkPct = 0) {
     MemoryManagerOptions options;
     options.allocatorCapacity = memoryCapacity;
     options.arbitratorReservedCapacity = reservedMemoryCapacity;
@@ -436,6 +439,11 @@ class MockSharedArbitrationTest : public testing::Test {
     options.memoryPoolReservedCapacity = memoryPoolReserveCapacity;
     options.memoryPoolTransferCapacity = memoryPoolTransferCapacity;
     options.globalArbitrationEnabled = globalArtbitrationEnabled;
+    options.arbitratorProtectedPriority = protectedPriority;
+    options.arbitratorBackgroundReclaimLowWatermarkPct =
+        backgroundReclaimLowWatermarkPct;
+    options.arbitratorBackgroundReclaimHighWatermarkPct =
+        backgroundReclaimHighWatermarkPct;
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
@@ -3195,6 +3203,127 @@ TEST_F(MockSharedArbitrationTest, arbitrationFailure) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, arbitrationByPriority) {
+  const int64_t maxCapacity = 128 * MB;
+  const int64_t minTransferCapacity = 1 * MB;
+  {
+    SCOPED_TRACE("lower priority aborted first");
+    setupMemory(maxCapacity, 0, 0, 0, minTransferCapacity);
+    std::shared_ptr<MockTask> requestorTask = addTask();
+    MockMemoryOperator* requestorOp = addMemoryOp(requestorTask, false);
+    requestorOp->allocate(16 * MB);
+    std::shared_ptr<MockTask> largeTask = addTask();
+    MockMemoryOperator* largeOp = addMemoryOp(largeTask, false);
+    largeOp->allocate(64 * MB);
+    std::shared_ptr<MockTask> lowPriorityTask = addTask();
+    lowPriorityTask->pool()->setPriority(-1);
+    MockMemoryOperator* lowPriorityOp = addMemoryOp(lowPriorityTask, false);
+    lowPriorityOp->allocate(48 * MB);
+
+    // The lower priority task is aborted instead of the one with the largest
+    // capacity.
+    requestorOp->allocate(16 * MB);
+    ASSERT_FALSE(requestorOp->pool()->aborted());
+    ASSERT_FALSE(largeOp->pool()->aborted());
+    ASSERT_TRUE(lowPriorityOp->pool()->aborted());
+    ASSERT_EQ(arbitrator_->stats().numAborted, 1);
+    clearTasks();
+  }
+
+  {
+    SCOPED_TRACE("protected priority");
+    setupMemory(maxCapacity, 0, 0, 0, minTransferCapacity, nullptr, true, 1);
+    std::shared_ptr<MockTask> requestorTask = addTask();
+    MockMemoryOperator* requestorOp = addMemoryOp(requestorTask, false);
+    requestorOp->allocate(32 * MB);
+    std::shared_ptr<MockTask> protectedTask = addTask();
+    protectedTask->pool()->setPriority(1);
+    MockMemoryOperator* protectedOp = addMemoryOp(protectedTask, false);
+    protectedOp->allocate(96 * MB);
+
+    VELOX_ASSERT_THROW(requestorOp->allocate(32 * MB), "");
+    ASSERT_FALSE(requestorOp->pool()->aborted());
+    ASSERT_FALSE(protectedOp->pool()->aborted());
+    ASSERT_EQ(arbitrator_->stats().numFailures, 1);
+    ASSERT_EQ(arbitrator_->stats().numAborted, 0);
+
+    // Only the unprotected pool is aborted to shrink the memory pools.
+    manager_->shrinkPools(maxCapacity, false, true);
+    ASSERT_TRUE(requestorOp->pool()->aborted());
+    ASSERT_FALSE(protectedOp->pool()->aborted());
+    ASSERT_EQ(protectedOp->capacity(), 96 * MB);
+    clearTasks();
+  }
+}
+
+TEST_F(MockSharedArbitrationTest, backgroundReclaim) {
+  const int64_t maxCapacity = 128 * MB;
+  const int64_t minTransferCapacity = 1 * MB;
+  setupMemory(
+      maxCapacity,
+      0,
+      0,
+      0,
+      minTransferCapacity,
+      nullptr,
+      true,
+      std::numeric_limits<int32_t>::max(),
+      25,
+      50);
+  std::shared_ptr<MockTask> lowPriorityTask = addTask();
+  lowPriorityTask->pool()->setPriority(-1);
+  MockMemoryOperator* lowPriorityOp = addMemoryOp(lowPriorityTask, true);
+  lowPriorityOp->allocate(64 * MB);
+  std::shared_ptr<MockTask> task = addTask();
+  MockMemoryOperator* op = addMemoryOp(task, true);
+  op->allocate(32 * MB);
+  // Above the low watermark.
+  ASSERT_EQ(arbitrator_->stats().freeCapacityBytes, 32 * MB);
+  ASSERT_EQ(lowPriorityOp->reclaimer()->stats().numReclaims, 0);
+
+  // Falls below the low watermark and the lower priority pool is spilled in
+  // the background until the free capacity reaches the high watermark.
+  op->allocate(16 * MB);
+  while (arbitrator_->stats().freeCapacityBytes < maxCapacity / 2) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  ASSERT_GT(lowPriorityOp->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(op->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(op->capacity(), 48 * MB);
+  ASSERT_FALSE(lowPriorityOp->pool()->aborted());
+  ASSERT_EQ(arbitrator_->stats().numAborted, 0);
+}
+
+TEST_F(MockSharedArbitrationTest, memoryForecast) {
+  const int64_t maxCapacity = 128 * MB;
+  const int64_t minTransferCapacity = 1 * MB;
+  setupMemory(maxCapacity, 0, 0, 0, minTransferCapacity);
+  std::shared_ptr<MockTask> task = addTask();
+  MockMemoryOperator* op = addMemoryOp(task, true);
+  {
+    MemoryForecast forecast(op->pool());
+    forecast.set(64 * MB);
+    ASSERT_EQ(task->pool()->memoryForecast(), 64 * MB);
+    forecast.set(32 * MB);
+    ASSERT_EQ(task->pool()->memoryForecast(), 32 * MB);
+
+    // The first growth takes the capacity up to the forecast so the later
+    // allocations do not need arbitration.
+    op->allocate(MB);
+    ASSERT_EQ(arbitrator_->stats().numRequests, 1);
+    ASSERT_EQ(op->capacity(), 32 * MB);
+    op->allocate(16 * MB);
+    ASSERT_EQ(arbitrator_->stats().numRequests, 1);
+    ASSERT_EQ(op->capacity(), 32 * MB);
+  }
+  // The forecast is withdrawn on destruction and the growth is back to the
+  // requested size.
+  ASSERT_EQ(task->pool()->memoryForecast(), 0);
+  op->allocate(16 * MB);
+  ASSERT_EQ(arbitrator_->stats().numRequests, 2);
+  ASSERT_LT(op->capacity(), 64 * MB);
+}
+
 TEST_F(MockSharedArbitrationTest, concurrentArbitrations) {
   const int numTasks = 10;
   const int numOpsPerTask = 5;
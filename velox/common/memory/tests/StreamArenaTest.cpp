@@ -159,3 +159,47 @@ TEST_F(StreamArenaTest, error) {
       arena->newRange(0, nullptr, &range),
       "StreamArena::newRange can't be zero length");
 }
+
+TEST_F(StreamArenaTest, recycle) {
+  const auto kRangeSize = 2 * AllocationTraits::kPageSize;
+  StreamArenaRecycler recycler(pool_.get(), 4 * kRangeSize);
+  ByteRange range;
+  uint8_t* buffer;
+  {
+    StreamArena arena(pool_.get(), &recycler);
+    arena.newRange(kRangeSize, nullptr, &range);
+    buffer = range.buffer;
+    arena.clear();
+    ASSERT_EQ(recycler.retainedBytes(), kRangeSize);
+    ASSERT_EQ(pool_->usedBytes(), kRangeSize);
+
+    // The next page reuses the released allocation.
+    arena.newRange(kRangeSize, nullptr, &range);
+    ASSERT_EQ(range.buffer, buffer);
+    ASSERT_EQ(recycler.retainedBytes(), 0);
+  }
+  // Destruction frees to the pool.
+  ASSERT_EQ(pool_->usedBytes(), 0);
+
+  // A larger range does not fit a kept allocation.
+  {
+    StreamArena arena(pool_.get(), &recycler);
+    arena.newRange(kRangeSize, nullptr, &range);
+    arena.clear();
+    arena.newRange(2 * kRangeSize, nullptr, &range);
+    ASSERT_EQ(recycler.retainedBytes(), kRangeSize);
+    arena.clear();
+    ASSERT_EQ(recycler.retainedBytes(), 3 * kRangeSize);
+  }
+
+  // Allocations above the limit are freed.
+  {
+    StreamArena arena(pool_.get(), &recycler);
+    arena.newRange(4 * kRangeSize, nullptr, &range);
+    arena.clear();
+    ASSERT_EQ(recycler.retainedBytes(), 3 * kRangeSize);
+  }
+  ASSERT_EQ(recycler.clear(), 3 * kRangeSize);
+  ASSERT_EQ(recycler.retainedBytes(), 0);
+  ASSERT_EQ(pool_->usedBytes(), 0);
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+
+namespace {
+
+#ifdef __linux__
+int openCounter(uint32_t type, uint64_t config, int groupFd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return syscall(
+      __NR_perf_event_open, &attr, /*pid*/ 0, /*cpu*/ -1, groupFd, 0);
+}
+
+uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+  return cache | (op << 8) | (result << 16);
+}
+
+// The counters of a thread, opened as one group led by the cycles counter so
+// that they are read together.
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    const uint32_t types[] = {
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HW_CACHE};
+    const uint64_t configs[] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        cacheConfig(
+            PERF_COUNT_HW_CACHE_DTLB,
+            PERF_COUNT_HW_CACHE_OP_READ,
+            PERF_COUNT_HW_CACHE_RESULT_MISS)};
+    for (auto i = 0; i < PerfCounterValues::kNumCounters; ++i) {
+      auto fd = openCounter(types[i], configs[i], leader());
+      if (fd < 0) {
+        if (i == 0) {
+          // No cycles counter, so no group.
+          return;
+        }
+        continue;
+      }
+      fds_[i] = fd;
+      positions_[i] = numOpen_++;
+    }
+  }
+
+  ~ThreadCounters() {
+    for (auto fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  bool read(PerfCounterValues& values) {
+    if (numOpen_ == 0) {
+      return false;
+    }
+    struct {
+      uint64_t numValues;
+      uint64_t values[PerfCounterValues::kNumCounters];
+    } group;
+    if (::read(leader(), &group, sizeof(group)) <
+        static_cast<ssize_t>(sizeof(uint64_t) * (1 + numOpen_))) {
+      return false;
+    }
+    for (auto i = 0; i < PerfCounterValues::kNumCounters; ++i) {
+      values.values[i] = fds_[i] >= 0 ? group.values[positions_[i]] : 0;
+    }
+    return true;
+  }
+
+  bool available(PerfCounterValues::Counter counter) const {
+    return fds_[counter] >= 0;
+  }
+
+ private:
+  int leader() const {
+    return fds_[0];
+  }
+
+  int fds_[PerfCounterValues::kNumCounters] = {-1, -1, -1, -1};
+
+  // Position of each open counter in the values of the group.
+  int32_t positions_[PerfCounterValues::kNumCounters]{};
+
+  int32_t numOpen_{0};
+};
+
+ThreadCounters& threadCounters() {
+  thread_local ThreadCounters counters;
+  return counters;
+}
+#endif
+
+} // namespace
+
+// static
+bool PerfCounters::read(PerfCounterValues& values) {
+#ifdef __linux__
+  return threadCounters().read(values);
+#else
+  return false;
+#endif
+}
+
+// static
+bool PerfCounters::available(PerfCounterValues::Counter counter) {
+#ifdef __linux__
+  return threadCounters().available(counter);
+#else
+  return false;
+#endif
+}
+
+} // namespace facebook::velox::process
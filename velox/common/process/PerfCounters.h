@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::velox::process {
+
+/// Hardware performance counters of a thread.
+struct PerfCounterValues {
+  enum Counter {
+    kCycles,
+    kInstructions,
+    kLlcMisses,
+    kDtlbMisses,
+    kNumCounters
+  };
+
+  uint64_t values[kNumCounters]{};
+
+  PerfCounterValues operator-(const PerfCounterValues& other) const {
+    PerfCounterValues result;
+    for (auto i = 0; i < kNumCounters; ++i) {
+      result.values[i] = values[i] - other.values[i];
+    }
+    return result;
+  }
+};
+
+/// Reads the user space cycles, instructions, last level cache misses and
+/// data TLB misses of the calling thread through perf_event_open. The
+/// counters are opened on the first read on each thread and stay open for
+/// the life of the thread.
+class PerfCounters {
+ public:
+  /// Sets 'values' to the counters of the calling thread. Returns false if
+  /// the counters are not available, e.g. because perf_event_paranoid does
+  /// not allow them or there is no PMU. A counter that is not supported when
+  /// the others are reads as 0 and is not in available().
+  static bool read(PerfCounterValues& values);
+
+  /// Returns true if 'counter' can be read on the calling thread.
+  static bool available(PerfCounterValues::Counter counter);
+};
+
+/// Reads the counters of the calling thread at construction and passes the
+/// difference to 'func' at destruction. Does nothing if the counters are
+/// not available.
+template <typename F>
+class DeltaPerfCounters {
+ public:
+  explicit DeltaPerfCounters(F&& func)
+      : isValid_(PerfCounters::read(start_)), func_(std::move(func)) {}
+
+  ~DeltaPerfCounters() {
+    PerfCounterValues end;
+    if (isValid_ && PerfCounters::read(end)) {
+      func_(end - start_);
+    }
+  }
+
+ private:
+  PerfCounterValues start_;
+  const bool isValid_;
+  F func_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/SamplingProfiler.h"
+#include "velox/common/process/StackTrace.h"
+#include "velox/common/process/ThreadDebugInfo.h"
+
+#include <fmt/format.h>
+#include <folly/experimental/symbolizer/StackTrace.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/time.h>
+
+namespace facebook::velox::process {
+
+namespace {
+
+constexpr int32_t kMaxFrames = 64;
+constexpr int32_t kIdSize = 64;
+constexpr int32_t kNumSlots = 4096;
+
+// Frames for the signal handler and the signal trampoline.
+constexpr int32_t kSkipFrames = 2;
+
+constexpr int8_t kEmpty = 0;
+constexpr int8_t kWriting = 1;
+constexpr int8_t kReady = 2;
+
+// A sample written by the signal handler and read by the aggregating thread.
+struct Sample {
+  std::atomic<int8_t> state{kEmpty};
+  char taskId[kIdSize];
+  char planNodeId[kIdSize];
+  char operatorType[kIdSize];
+  int32_t numFrames;
+  uintptr_t frames[kMaxFrames];
+};
+
+struct NodeProfile {
+  std::string operatorType;
+  uint64_t numSamples{0};
+  std::map<std::vector<uintptr_t>, uint64_t> stacks;
+};
+
+// Profile of a task keyed on plan node id.
+using TaskProfile = std::map<std::string, NodeProfile>;
+
+Sample* slots{nullptr};
+std::atomic<uint64_t> nextSlot{0};
+std::atomic<uint64_t> numUnattributedSamples{0};
+std::atomic<uint64_t> numDroppedSamples{0};
+
+std::mutex mutex;
+std::condition_variable stopCondition;
+bool running{false};
+std::thread aggregateThread;
+struct sigaction previousAction;
+std::map<std::string, TaskProfile> profiles;
+
+// Async signal safe copy of 'id' into a Sample.
+void copyId(const std::string* id, char* out) {
+  if (id == nullptr) {
+    out[0] = 0;
+    return;
+  }
+  auto size = std::min<size_t>(id->size(), kIdSize - 1);
+  memcpy(out, id->data(), size);
+  out[size] = 0;
+}
+
+void onSignal(int /*signal*/) {
+  auto* info = GetThreadDebugInfo();
+  auto* allSlots = slots;
+  if (info == nullptr || allSlots == nullptr) {
+    numUnattributedSamples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto& sample = allSlots[nextSlot.fetch_add(1) % kNumSlots];
+  auto expected = kEmpty;
+  if (!sample.state.compare_exchange_strong(expected, kWriting)) {
+    numDroppedSamples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  copyId(&info->taskId_, sample.taskId);
+  copyId(info->planNodeId_, sample.planNodeId);
+  copyId(info->operatorType_, sample.operatorType);
+  auto numFrames =
+      folly::symbolizer::getStackTraceSafe(sample.frames, kMaxFrames);
+  sample.numFrames = numFrames < 0 ? 0 : numFrames;
+  sample.state.store(kReady, std::memory_order_release);
+}
+
+// Moves the ready samples into 'profiles'. Called with 'mutex' held.
+void aggregateLocked() {
+  if (slots == nullptr) {
+    return;
+  }
+  for (auto i = 0; i < kNumSlots; ++i) {
+    auto& sample = slots[i];
+    if (sample.state.load(std::memory_order_acquire) != kReady) {
+      continue;
+    }
+    auto& node = profiles[sample.taskId][sample.planNodeId];
+    if (node.operatorType.empty()) {
+      node.operatorType = sample.operatorType;
+    }
+    ++node.numSamples;
+    // Outermost frame first.
+    std::vector<uintptr_t> stack;
+    for (auto frame = sample.numFrames - 1; frame >= kSkipFrames; --frame) {
+      stack.push_back(sample.frames[frame]);
+    }
+    ++node.stacks[stack];
+    sample.state.store(kEmpty, std::memory_order_release);
+  }
+}
+
+void aggregateLoop() {
+  std::unique_lock<std::mutex> l(mutex);
+  while (running) {
+    stopCondition.wait_for(l, std::chrono::milliseconds(100));
+    aggregateLocked();
+  }
+}
+
+void setTimer(int32_t intervalMicros) {
+  struct itimerval timer;
+  timer.it_interval.tv_sec = intervalMicros / 1'000'000;
+  timer.it_interval.tv_usec = intervalMicros % 1'000'000;
+  timer.it_value = timer.it_interval;
+  setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+std::string frameName(
+    uintptr_t address,
+    std::unordered_map<uintptr_t, std::string>& names) {
+  auto it = names.find(address);
+  if (it != names.end()) {
+    return it->second;
+  }
+  auto name = StackTrace::translateFrame(reinterpret_cast<void*>(address));
+  // ';' separates frames in folded stacks.
+  std::replace(name.begin(), name.end(), ';', ':');
+  names[address] = name;
+  return name;
+}
+
+void appendFoldedStacks(
+    const std::string& taskId,
+    const TaskProfile& profile,
+    std::unordered_map<uintptr_t, std::string>& names,
+    std::string& out) {
+  for (auto& [planNodeId, node] : profile) {
+    std::string prefix = taskId;
+    if (!planNodeId.empty()) {
+      prefix += fmt::format(";{} {}", planNodeId, node.operatorType);
+    }
+    for (auto& [stack, count] : node.stacks) {
+      out += prefix;
+      for (auto address : stack) {
+        out += ";";
+        out += frameName(address, names);
+      }
+      out += fmt::format(" {}\n", count);
+    }
+  }
+}
+
+} // namespace
+
+// static
+void SamplingProfiler::start(int32_t intervalMicros) {
+  CHECK_GT(intervalMicros, 0);
+  std::lock_guard<std::mutex> l(mutex);
+  if (running) {
+    return;
+  }
+  if (slots == nullptr) {
+    slots = new Sample[kNumSlots];
+  }
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = onSignal;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGPROF, &action, &previousAction);
+  running = true;
+  aggregateThread = std::thread(aggregateLoop);
+  setTimer(intervalMicros);
+  LOG(INFO) << "Started sampling profiler every " << intervalMicros
+            << "us of CPU";
+}
+
+// static
+void SamplingProfiler::stop() {
+  {
+    std::lock_guard<std::mutex> l(mutex);
+    if (!running) {
+      return;
+    }
+    setTimer(0);
+    running = false;
+    sigaction(SIGPROF, &previousAction, nullptr);
+  }
+  stopCondition.notify_all();
+  aggregateThread.join();
+  std::lock_guard<std::mutex> l(mutex);
+  // The handler may still be running on another thread for a signal that
+  // was raised before the timer stopped, so 'slots' is not freed.
+  aggregateLocked();
+}
+
+// static
+bool SamplingProfiler::isRunning() {
+  std::lock_guard<std::mutex> l(mutex);
+  return running;
+}
+
+// static
+void SamplingProfiler::clear() {
+  std::lock_guard<std::mutex> l(mutex);
+  aggregateLocked();
+  profiles.clear();
+  numUnattributedSamples = 0;
+  numDroppedSamples = 0;
+}
+
+// static
+std::unordered_map<std::string, uint64_t> SamplingProfiler::planNodeSamples(
+    const std::string& taskId) {
+  std::lock_guard<std::mutex> l(mutex);
+  aggregateLocked();
+  std::unordered_map<std::string, uint64_t> result;
+  auto it = profiles.find(taskId);
+  if (it == profiles.end()) {
+    return result;
+  }
+  for (auto& [planNodeId, node] : it->second) {
+    result[planNodeId] = node.numSamples;
+  }
+  return result;
+}
+
+// static
+std::string SamplingProfiler::foldedStacks(const std::string& taskId) {
+  std::lock_guard<std::mutex> l(mutex);
+  aggregateLocked();
+  std::unordered_map<uintptr_t, std::string> names;
+  std::string out;
+  for (auto& [id, profile] : profiles) {
+    if (taskId.empty() || id == taskId) {
+      appendFoldedStacks(id, profile, names, out);
+    }
+  }
+  return out;
+}
+
+// static
+uint64_t SamplingProfiler::numUnattributed() {
+  return numUnattributedSamples;
+}
+
+// static
+uint64_t SamplingProfiler::numDropped() {
+  return numDroppedSamples;
+}
+
+} // namespace facebook::velox::process
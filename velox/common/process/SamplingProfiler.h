@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::velox::process {
+
+/// In-process CPU sampling profiler. A SIGPROF timer interrupts the threads
+/// that use CPU. Each interrupt records the stack of the thread together with
+/// the query, task and Operator from its ThreadDebugInfo. Threads without a
+/// ThreadDebugInfo are only counted. A background thread aggregates the
+/// samples per task and plan node so that the cost of a sample is a stack
+/// walk and a copy into a preallocated ring buffer.
+///
+/// The results are folded stacks, one line per distinct stack with the frames
+/// from the outermost in, separated by ';' and followed by the sample count.
+/// This is the input format of common flame graph tools.
+class SamplingProfiler {
+ public:
+  /// Starts sampling every 'intervalMicros' of process CPU time. No-op if
+  /// already running.
+  static void start(int32_t intervalMicros = 10'000);
+
+  /// Stops sampling. The samples collected so far are kept until clear().
+  static void stop();
+
+  static bool isRunning();
+
+  /// Drops all aggregated samples.
+  static void clear();
+
+  /// Returns the number of samples of 'taskId' keyed on plan node id. Samples
+  /// taken outside of Operator calls of the task are under the empty id.
+  static std::unordered_map<std::string, uint64_t> planNodeSamples(
+      const std::string& taskId);
+
+  /// Returns the folded stacks of 'taskId', or of all tasks if 'taskId' is
+  /// empty. The first frame of each stack is the task id followed by the plan
+  /// node id and Operator type when known. Suitable for serving from an
+  /// HTTP endpoint of the embedding process.
+  static std::string foldedStacks(const std::string& taskId = "");
+
+  /// Returns the number of samples taken on threads without a
+  /// ThreadDebugInfo and the number dropped because the ring buffer was
+  /// full.
+  static uint64_t numUnattributed();
+  static uint64_t numDropped();
+};
+
+} // namespace facebook::velox::process
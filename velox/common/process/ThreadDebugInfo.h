@@ -28,6 +28,11 @@ struct ThreadDebugInfo {
   std::string taskId_;
   // Callback to invoke when the debug info is to be dumped. Can be empty.
   std::function<void()> callback_;
+  // Plan node id and type of the Operator the thread is running. Set by the
+  // Driver around each Operator call and read by SamplingProfiler. Null
+  // outside of Operator calls.
+  const std::string* planNodeId_{nullptr};
+  const std::string* operatorType_{nullptr};
 };
 
 // A RAII class to store thread local debug information.
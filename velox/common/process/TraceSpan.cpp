@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/TraceSpan.h"
+#include "velox/common/process/ThreadDebugInfo.h"
+
+#include <folly/Synchronized.h>
+#include <folly/hash/Hash.h>
+#include <folly/system/ThreadId.h>
+
+#include <algorithm>
+
+namespace facebook::velox::process {
+
+std::atomic<bool> TraceSpan::enabled_{false};
+
+namespace {
+// Queries whose id hashes below this out of kSampleScale are sampled.
+constexpr uint64_t kSampleScale = 1'000'000;
+
+struct ExporterState {
+  std::shared_ptr<SpanExporter> exporter;
+  uint64_t sampleThreshold{0};
+};
+
+folly::Synchronized<ExporterState>& exporterState() {
+  static folly::Synchronized<ExporterState> state;
+  return state;
+}
+
+bool isSampledLocked(const ExporterState& state, const std::string& queryId) {
+  if (state.exporter == nullptr || queryId.empty()) {
+    return false;
+  }
+  return folly::hash::fnv64(queryId) % kSampleScale < state.sampleThreshold;
+}
+} // namespace
+
+TraceSpan::TraceSpan(const char* name) {
+  if (enabled_.load(std::memory_order_relaxed)) {
+    start(name, currentQueryId());
+  }
+}
+
+TraceSpan::TraceSpan(const char* name, const std::string& queryId) {
+  if (enabled_.load(std::memory_order_relaxed)) {
+    start(name, queryId);
+  }
+}
+
+void TraceSpan::start(const char* name, const std::string& queryId) {
+  if (!isSampled(queryId)) {
+    return;
+  }
+  data_ = std::make_unique<SpanData>();
+  data_->queryId = queryId;
+  data_->name = name;
+  data_->startTime = std::chrono::system_clock::now();
+  start_ = std::chrono::steady_clock::now();
+}
+
+TraceSpan::~TraceSpan() {
+  if (data_ == nullptr) {
+    return;
+  }
+  data_->durationUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start_)
+                          .count();
+  data_->threadId = folly::getOSThreadID();
+  auto exporter = exporterState().rlock()->exporter;
+  if (exporter != nullptr) {
+    exporter->exportSpan(std::move(*data_));
+  }
+}
+
+void TraceSpan::addAttribute(std::string name, std::string value) {
+  if (data_ != nullptr) {
+    data_->attributes.emplace_back(std::move(name), std::move(value));
+  }
+}
+
+// static
+void TraceSpan::setExporter(
+    std::shared_ptr<SpanExporter> exporter,
+    double sampleRate) {
+  auto state = exporterState().wlock();
+  enabled_ = exporter != nullptr && sampleRate > 0;
+  state->exporter = std::move(exporter);
+  state->sampleThreshold =
+      static_cast<uint64_t>(std::clamp(sampleRate, 0.0, 1.0) * kSampleScale);
+}
+
+// static
+bool TraceSpan::isSampled(const std::string& queryId) {
+  if (!enabled_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  return isSampledLocked(*exporterState().rlock(), queryId);
+}
+
+// static
+std::string TraceSpan::currentQueryId() {
+  auto* info = GetThreadDebugInfo();
+  return info == nullptr ? std::string() : info->queryId_;
+}
+
+} // namespace facebook::velox::process
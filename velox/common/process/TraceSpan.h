@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// A finished span: a named, timed section of work done for a query.
+struct SpanData {
+  std::string queryId;
+  std::string name;
+  std::chrono::system_clock::time_point startTime;
+  uint64_t durationUs{0};
+  uint64_t threadId{0};
+  /// Name-value pairs describing the work, e.g. the number of bytes read.
+  std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+/// Receives the finished spans of the sampled queries. Implemented by the
+/// embedding application, e.g. to forward spans to an OpenTelemetry
+/// collector. exportSpan() is called on the thread that ends the span and
+/// may be called concurrently from many threads. It should not block.
+class SpanExporter {
+ public:
+  virtual ~SpanExporter() = default;
+
+  virtual void exportSpan(SpanData span) = 0;
+};
+
+/// Records a span from construction to destruction and passes it to the
+/// SpanExporter if the query is sampled. The query comes from the
+/// ThreadDebugInfo of the constructing thread unless given. When no exporter
+/// is set, a TraceSpan costs an atomic load.
+///
+/// NOTE: Like TraceContext, a TraceSpan is not shared between threads. It can
+/// be moved to a callback that ends it on another thread.
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name);
+
+  TraceSpan(const char* name, const std::string& queryId);
+
+  TraceSpan(TraceSpan&& other) noexcept = default;
+  TraceSpan& operator=(TraceSpan&& other) noexcept = default;
+
+  ~TraceSpan();
+
+  /// True if 'this' will be exported. Callers can check this before
+  /// computing attributes.
+  bool isSampled() const {
+    return data_ != nullptr;
+  }
+
+  /// Adds an attribute to the span. No-op if not sampled.
+  void addAttribute(std::string name, std::string value);
+
+  /// Sets the exporter and the fraction of queries in [0, 1] whose spans are
+  /// exported. Whether a query is sampled depends only on its id so that all
+  /// spans of a query are either exported or not. A null 'exporter'
+  /// disables the spans.
+  static void setExporter(
+      std::shared_ptr<SpanExporter> exporter,
+      double sampleRate = 1);
+
+  /// Returns true if spans of 'queryId' are exported.
+  static bool isSampled(const std::string& queryId);
+
+  /// Returns the query id of the calling thread's ThreadDebugInfo or an empty
+  /// string.
+  static std::string currentQueryId();
+
+ private:
+  void start(const char* name, const std::string& queryId);
+
+  static std::atomic<bool> enabled_;
+
+  std::unique_ptr<SpanData> data_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace facebook::velox::process
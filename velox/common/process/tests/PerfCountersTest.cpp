@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(PerfCountersTest, delta) {
+  PerfCounterValues values;
+  if (!PerfCounters::read(values)) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+  ASSERT_TRUE(PerfCounters::available(PerfCounterValues::kCycles));
+
+  PerfCounterValues delta;
+  int32_t numCalls = 0;
+  {
+    DeltaPerfCounters counters([&](const PerfCounterValues& values) {
+      delta = values;
+      ++numCalls;
+    });
+    std::vector<int64_t> data(1 << 20);
+    for (auto i = 0; i < data.size(); ++i) {
+      data[i] = i * 3;
+    }
+    int64_t sum = 0;
+    for (auto value : data) {
+      sum += value;
+    }
+    EXPECT_GT(sum, 0);
+  }
+  EXPECT_EQ(numCalls, 1);
+  EXPECT_GT(delta.values[PerfCounterValues::kCycles], 0);
+  if (PerfCounters::available(PerfCounterValues::kInstructions)) {
+    EXPECT_GT(delta.values[PerfCounterValues::kInstructions], 1 << 20);
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/SamplingProfiler.h"
+#include "velox/common/process/ThreadDebugInfo.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+namespace facebook::velox::process {
+namespace {
+
+// Uses CPU for 'millis' of wall time.
+int64_t spin(int32_t millis) {
+  auto end =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(millis);
+  int64_t sum = 0;
+  while (std::chrono::steady_clock::now() < end) {
+    for (auto i = 0; i < 10'000; ++i) {
+      sum += i * i;
+    }
+  }
+  return sum;
+}
+
+TEST(SamplingProfilerTest, attribution) {
+  SamplingProfiler::clear();
+  SamplingProfiler::start(1'000);
+  ASSERT_TRUE(SamplingProfiler::isRunning());
+  const std::string planNodeId = "3";
+  const std::string operatorType = "HashProbe";
+  ThreadDebugInfo info{"query", "task.0.0", nullptr};
+  int64_t sum = 0;
+  {
+    ScopedThreadDebugInfo scopedInfo(info);
+    sum += spin(200);
+    info.planNodeId_ = &planNodeId;
+    info.operatorType_ = &operatorType;
+    sum += spin(300);
+    info.planNodeId_ = nullptr;
+    info.operatorType_ = nullptr;
+  }
+  SamplingProfiler::stop();
+  ASSERT_FALSE(SamplingProfiler::isRunning());
+  EXPECT_NE(sum, 0);
+
+  auto samples = SamplingProfiler::planNodeSamples("task.0.0");
+  EXPECT_GT(samples["3"], 0);
+  EXPECT_GT(samples[""], 0);
+  EXPECT_TRUE(SamplingProfiler::planNodeSamples("other").empty());
+
+  auto stacks = SamplingProfiler::foldedStacks("task.0.0");
+  EXPECT_NE(stacks.find("task.0.0;3 HashProbe;"), std::string::npos);
+  EXPECT_EQ(stacks, SamplingProfiler::foldedStacks());
+
+  SamplingProfiler::clear();
+  EXPECT_TRUE(SamplingProfiler::planNodeSamples("task.0.0").empty());
+  EXPECT_TRUE(SamplingProfiler::foldedStacks().empty());
+}
+
+} // namespace
+} // namespace facebook::velox::process
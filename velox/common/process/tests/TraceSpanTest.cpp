@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/TraceSpan.h"
+#include "velox/common/process/ThreadDebugInfo.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+class TestExporter : public SpanExporter {
+ public:
+  void exportSpan(SpanData span) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    spans_.push_back(std::move(span));
+  }
+
+  std::vector<SpanData> spans() {
+    std::lock_guard<std::mutex> l(mutex_);
+    return spans_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<SpanData> spans_;
+};
+
+class TraceSpanTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    TraceSpan::setExporter(nullptr);
+  }
+};
+
+TEST_F(TraceSpanTest, exportSpans) {
+  {
+    TraceSpan span("noExporter", "q1");
+    EXPECT_FALSE(span.isSampled());
+  }
+  auto exporter = std::make_shared<TestExporter>();
+  TraceSpan::setExporter(exporter);
+  {
+    // No query on this thread.
+    TraceSpan span("noQuery");
+    EXPECT_FALSE(span.isSampled());
+  }
+  ThreadDebugInfo info{"q1", "t1", nullptr};
+  {
+    ScopedThreadDebugInfo scopedInfo(info);
+    TraceSpan span("read");
+    ASSERT_TRUE(span.isSampled());
+    span.addAttribute("bytes", "100");
+    // A moved span is exported once, by its last owner.
+    std::thread([moved = std::move(span)]() mutable {
+      moved.addAttribute("thread", "other");
+    }).join();
+  }
+  auto spans = exporter->spans();
+  ASSERT_EQ(spans.size(), 1);
+  EXPECT_EQ(spans[0].queryId, "q1");
+  EXPECT_EQ(spans[0].name, "read");
+  ASSERT_EQ(spans[0].attributes.size(), 2);
+  EXPECT_EQ(spans[0].attributes[0].first, "bytes");
+  EXPECT_EQ(spans[0].attributes[1].second, "other");
+}
+
+TEST_F(TraceSpanTest, sampling) {
+  auto exporter = std::make_shared<TestExporter>();
+  TraceSpan::setExporter(exporter, 0.25);
+  constexpr int32_t kNumQueries = 1'000;
+  int32_t numSampled = 0;
+  for (auto i = 0; i < kNumQueries; ++i) {
+    auto queryId = fmt::format("query_{}", i);
+    bool sampled = TraceSpan::isSampled(queryId);
+    // The decision is the same for every span of a query.
+    EXPECT_EQ(sampled, TraceSpan::isSampled(queryId));
+    TraceSpan span("span", queryId);
+    EXPECT_EQ(sampled, span.isSampled());
+    numSampled += sampled;
+  }
+  EXPECT_EQ(exporter->spans().size(), numSampled);
+  EXPECT_GT(numSampled, kNumQueries / 8);
+  EXPECT_LT(numSampled, kNumQueries / 2);
+
+  TraceSpan::setExporter(exporter, 0);
+  EXPECT_FALSE(TraceSpan::isSampled("query_1"));
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -61,6 +61,14 @@ struct ConnectorSplit {
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  /// Returns a key that identifies the data read for 'this', or std::nullopt
+  /// if the data may change between reads. Splits with the same key return
+  /// the same rows for the same table and column handles. Used for caching
+  /// query results.
+  virtual std::optional<std::string> cacheKey() const {
+    return std::nullopt;
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -405,10 +413,12 @@ class Connector {
   /// Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   /// tracker and different threads will share the same
   /// instance. 'loadQuantum' is the largest single IO for the query
-  /// being tracked.
+  /// being tracked. 'fileGroupStats', if set, aggregates the accesses of all
+  /// scans for SSD admission.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      cache::FileGroupStats* fileGroupStats = nullptr);
 
   virtual folly::Executor* executor() const {
     return nullptr;
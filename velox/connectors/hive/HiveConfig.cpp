@@ -65,6 +65,12 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* session) const {
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 100));
 }
 
+uint32_t HiveConfig::maxOpenFileWriters(const Config* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenFileWritersSession,
+      config_->get<uint32_t>(kMaxOpenFileWriters, 0));
+}
+
 bool HiveConfig::immutablePartitions() const {
   return config_->get<bool>(kImmutablePartitions, false);
 }
@@ -178,10 +184,22 @@ int32_t HiveConfig::maxCoalescedDistanceBytes() const {
   return config_->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+bool HiveConfig::isAdaptiveCoalesce() const {
+  return config_->get<bool>(kAdaptiveCoalesce, false);
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
 
+int32_t HiveConfig::decodingParallelismFactor() const {
+  return config_->get<int32_t>(kDecodingParallelismFactor, 0);
+}
+
+int32_t HiveConfig::pageReadAhead() const {
+  return config_->get<int32_t>(kPageReadAhead, 0);
+}
+
 int32_t HiveConfig::loadQuantum() const {
   return config_->get<int32_t>(kLoadQuantum, 8 << 20);
 }
@@ -194,6 +212,12 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+uint64_t HiveConfig::fileMetadataCacheSize() const {
+  return toCapacity(
+      config_->get<std::string>(kFileMetadataCacheSize, "0B"),
+      core::CapacityUnit::BYTE);
+}
+
 uint64_t HiveConfig::orcWriterMaxStripeSize(const Config* session) const {
   return toCapacity(
       session->get<std::string>(
@@ -260,6 +284,14 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+uint64_t HiveConfig::sortWriterMaxBufferedBytes(const Config* session) const {
+  return toCapacity(
+      session->get<std::string>(
+          kSortWriterMaxBufferedBytesSession,
+          config_->get<std::string>(kSortWriterMaxBufferedBytes, "0B")),
+      core::CapacityUnit::BYTE);
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 1UL << 20);
 }
@@ -272,6 +304,36 @@ bool HiveConfig::s3UseProxyFromEnv() const {
   return config_->get<bool>(kS3UseProxyFromEnv, false);
 }
 
+uint64_t HiveConfig::s3ReadPartSize() const {
+  return toCapacity(
+      config_->get<std::string>(kS3ReadPartSize, "8MB"),
+      core::CapacityUnit::BYTE);
+}
+
+int32_t HiveConfig::s3ReadParallelism() const {
+  return config_->get<int32_t>(kS3ReadParallelism, 0);
+}
+
+int32_t HiveConfig::s3UploadParallelism() const {
+  return config_->get<int32_t>(kS3UploadParallelism, 0);
+}
+
+bool HiveConfig::hdfsShortCircuitRead() const {
+  return config_->get<bool>(kHdfsShortCircuitRead, false);
+}
+
+std::string HiveConfig::hdfsDomainSocketPath() const {
+  return config_->get<std::string>(kHdfsDomainSocketPath, "");
+}
+
+int32_t HiveConfig::hdfsHedgedReadThreads() const {
+  return config_->get<int32_t>(kHdfsHedgedReadThreads, 0);
+}
+
+uint64_t HiveConfig::hdfsHedgedReadThresholdMs() const {
+  return config_->get<uint64_t>(kHdfsHedgedReadThresholdMs, 500);
+}
+
 uint8_t HiveConfig::parquetWriteTimestampUnit(const Config* session) const {
   const auto unit = session->get<uint8_t>(
       kParquetWriteTimestampUnitSession,
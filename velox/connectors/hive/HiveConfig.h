@@ -52,6 +52,14 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Maximum number of files a writer of a partitioned, non-bucketed table
+  /// keeps open. When a partition needs a writer and the limit is reached,
+  /// the least recently used file is closed and later rows of its partition
+  /// go to a new file. 0 means no limit.
+  static constexpr const char* kMaxOpenFileWriters = "max-open-file-writers";
+  static constexpr const char* kMaxOpenFileWritersSession =
+      "max_open_file_writers";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -145,9 +153,24 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// Estimate the coalesce distance from the latency and throughput of the
+  /// storage reads instead of using 'max-coalesced-distance-bytes'.
+  static constexpr const char* kAdaptiveCoalesce = "adaptive-coalesce";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
+  /// The number of threads, including the driver thread, for decoding the
+  /// columns without filters of a batch in parallel on the connector executor.
+  /// Values below 2 disable parallel decoding.
+  static constexpr const char* kDecodingParallelismFactor =
+      "decoding-parallelism-factor";
+
+  /// The number of compressed pages of each column that the Parquet reader
+  /// decompresses ahead of use on the executor of the file input. 0 disables
+  /// it.
+  static constexpr const char* kPageReadAhead = "page-read-ahead";
+
   /// The total size in bytes for a direct coalesce request. Up to 8MB load
   /// quantum size is supported when SSD cache is enabled.
   static constexpr const char* kLoadQuantum = "load-quantum";
@@ -159,6 +182,11 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Capacity of the process-wide cache of parsed file footers. 0 disables
+  /// the cache.
+  static constexpr const char* kFileMetadataCacheSize =
+      "file-metadata-cache-size";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -216,9 +244,52 @@ class HiveConfig {
   static constexpr const char* kSortWriterMaxOutputBytesSession =
       "sort_writer_max_output_bytes";
 
+  /// Maximum bytes of input the sort writer buffers before it spills them as
+  /// a sorted run. The runs are merged into the file on close. 0 means the
+  /// input is only spilled under memory arbitration.
+  static constexpr const char* kSortWriterMaxBufferedBytes =
+      "sort-writer-max-buffered-bytes";
+  static constexpr const char* kSortWriterMaxBufferedBytesSession =
+      "sort_writer_max_buffered_bytes";
+
   static constexpr const char* kS3UseProxyFromEnv =
       "hive.s3.use-proxy-from-env";
 
+  /// Reads from S3 larger than this are split into ranged GETs of this size
+  /// that are issued in parallel.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
+  /// The number of threads issuing the parts of large S3 reads. 0 reads each
+  /// range with a single GET.
+  static constexpr const char* kS3ReadParallelism =
+      "hive.s3.read-parallelism";
+
+  /// The number of threads uploading the parts of S3 writes. Each file also
+  /// keeps at most this many parts in flight. 0 uploads each part
+  /// synchronously from the writer's thread.
+  static constexpr const char* kS3UploadParallelism =
+      "hive.s3.upload-parallelism";
+
+  /// Reads HDFS blocks stored on the local datanode directly from its disks
+  /// instead of through the datanode.
+  static constexpr const char* kHdfsShortCircuitRead =
+      "hive.hdfs.short-circuit-read";
+
+  /// The domain socket shared with the local datanode for short-circuit
+  /// reads.
+  static constexpr const char* kHdfsDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
+  /// The number of threads issuing hedged HDFS reads. 0 disables hedged
+  /// reads.
+  static constexpr const char* kHdfsHedgedReadThreads =
+      "hive.hdfs.hedged-read-threads";
+
+  /// An HDFS read that takes longer than this many milliseconds is hedged by
+  /// a second read of the same range. The first to finish is used.
+  static constexpr const char* kHdfsHedgedReadThresholdMs =
+      "hive.hdfs.hedged-read-threshold-ms";
+
   /// Timestamp unit for Parquet write through Arrow bridge.
   static constexpr const char* kParquetWriteTimestampUnit =
       "hive.parquet.writer.timestamp-unit";
@@ -233,6 +304,8 @@ class HiveConfig {
 
   uint32_t maxPartitionsPerWriters(const Config* session) const;
 
+  uint32_t maxOpenFileWriters(const Config* session) const;
+
   bool immutablePartitions() const;
 
   bool s3UseVirtualAddressing() const;
@@ -285,14 +358,22 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes() const;
 
+  bool isAdaptiveCoalesce() const;
+
   int32_t prefetchRowGroups() const;
 
+  int32_t decodingParallelismFactor() const;
+
+  int32_t pageReadAhead() const;
+
   int32_t loadQuantum() const;
 
   int32_t numCacheFileHandles() const;
 
   bool isFileHandleCacheEnabled() const;
 
+  uint64_t fileMetadataCacheSize() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   uint64_t orcWriterMaxStripeSize(const Config* session) const;
@@ -311,12 +392,28 @@ class HiveConfig {
 
   uint64_t sortWriterMaxOutputBytes(const Config* session) const;
 
+  uint64_t sortWriterMaxBufferedBytes(const Config* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
 
   bool s3UseProxyFromEnv() const;
 
+  uint64_t s3ReadPartSize() const;
+
+  int32_t s3ReadParallelism() const;
+
+  int32_t s3UploadParallelism() const;
+
+  bool hdfsShortCircuitRead() const;
+
+  std::string hdfsDomainSocketPath() const;
+
+  int32_t hdfsHedgedReadThreads() const;
+
+  uint64_t hdfsHedgedReadThresholdMs() const;
+
   /// Returns the timestamp unit used when writing timestamps into Parquet
   /// through Arrow bridge. 0: second, 3: milli, 6: micro, 9: nano.
   uint8_t parquetWriteTimestampUnit(const Config* session) const;
@@ -21,6 +21,7 @@
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/dwrf/RegisterDwrfReader.h"
 #include "velox/dwio/dwrf/RegisterDwrfWriter.h"
 
@@ -76,6 +77,10 @@ HiveConnector::HiveConnector(
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with file handle cache disabled";
   }
+  if (const auto metadataCacheSize = hiveConfig_->fileMetadataCacheSize();
+      metadataCacheSize > 0) {
+    dwio::common::FileMetadataCache::init(metadataCacheSize);
+  }
 }
 
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <map>
 #include <optional>
 #include <unordered_map>
 #include "velox/connectors/Connector.h"
@@ -102,6 +103,39 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
     return fmt::format("Hive: {} {} - {}", filePath, start, length);
   }
 
+  /// A split reads an immutable version of its file if the modification time
+  /// of the file is known. Splits with bucket conversion or connector
+  /// specific split info are not cached.
+  std::optional<std::string> cacheKey() const override {
+    if (!properties.has_value() || !properties->modificationTime.has_value() ||
+        bucketConversion.has_value() || !customSplitInfo.empty() ||
+        extraFileInfo != nullptr) {
+      return std::nullopt;
+    }
+    auto key = fmt::format(
+        "{} {} {} {} {} {}",
+        filePath,
+        properties->modificationTime.value(),
+        start,
+        length,
+        dwio::common::toString(fileFormat),
+        tableBucketNumber.value_or(-1));
+    // The maps are unordered. Sorts their entries so that equal maps give the
+    // same key.
+    const std::map<std::string, std::optional<std::string>> sortedPartitionKeys(
+        partitionKeys.begin(), partitionKeys.end());
+    for (const auto& [name, value] : sortedPartitionKeys) {
+      key += fmt::format(" {}={}", name, value.value_or("<null>"));
+    }
+    for (const auto* map : {&infoColumns, &serdeParameters}) {
+      const std::map<std::string, std::string> sorted(map->begin(), map->end());
+      for (const auto& [name, value] : sorted) {
+        key += fmt::format(" {}={}", name, value);
+      }
+    }
+    return key;
+  }
+
   std::string getFileName() const {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
@@ -26,6 +26,7 @@
 #include "velox/dwio/common/Reader.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
+#include "velox/type/Conversions.h"
 #include "velox/type/TimestampConversion.h"
 
 namespace facebook::velox::connector::hive {
@@ -533,6 +534,7 @@ void configureReaderOptions(
   readerOptions.setLoadQuantum(hiveConfig->loadQuantum());
   readerOptions.setMaxCoalesceBytes(hiveConfig->maxCoalescedBytes());
   readerOptions.setMaxCoalesceDistance(hiveConfig->maxCoalescedDistanceBytes());
+  readerOptions.setAdaptiveCoalesce(hiveConfig->isAdaptiveCoalesce());
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   readerOptions.setUseColumnNamesForColumnMapping(
@@ -541,6 +543,7 @@ void configureReaderOptions(
   readerOptions.setFooterEstimatedSize(hiveConfig->footerEstimatedSize());
   readerOptions.setFilePreloadThreshold(hiveConfig->filePreloadThreshold());
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
+  readerOptions.setPageReadAhead(hiveConfig->pageReadAhead());
   readerOptions.setNoCacheRetention(
       hiveConfig->cacheNoRetention(sessionProperties));
   const auto& sessionTzName = connectorQueryCtx->sessionTimezone();
@@ -620,6 +623,39 @@ bool applyPartitionFilter(
   }
 }
 
+template <TypeKind kind>
+VectorPtr newConstantFromStringImpl(
+    const TypePtr& type,
+    const std::optional<std::string>& value,
+    vector_size_t size,
+    velox::memory::MemoryPool* pool) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if (!value.has_value()) {
+    return std::make_shared<ConstantVector<T>>(pool, size, true, type, T());
+  }
+
+  if (type->isDate()) {
+    auto days = DATE()->toDays((folly::StringPiece)value.value());
+    return std::make_shared<ConstantVector<int32_t>>(
+        pool, size, false, type, std::move(days));
+  }
+
+  if constexpr (std::is_same_v<T, StringView>) {
+    return std::make_shared<ConstantVector<StringView>>(
+        pool, size, false, type, StringView(value.value()));
+  } else {
+    auto copy = velox::util::Converter<kind>::tryCast(value.value())
+                    .thenOrThrow(folly::identity, [&](const Status& status) {
+                      VELOX_USER_FAIL("{}", status.message());
+                    });
+    if constexpr (kind == TypeKind::TIMESTAMP) {
+      copy.toGMT(Timestamp::defaultTimezone());
+    }
+    return std::make_shared<ConstantVector<T>>(
+        pool, size, false, type, std::move(copy));
+  }
+}
+
 } // namespace
 
 bool testFilters(
@@ -681,20 +717,32 @@ bool testFilters(
   return true;
 }
 
+VectorPtr newConstantFromString(
+    const TypePtr& type,
+    const std::optional<std::string>& value,
+    vector_size_t size,
+    memory::MemoryPool* pool) {
+  return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+      newConstantFromStringImpl, type->kind(), type, value, size, pool);
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
     folly::Executor* executor) {
-  if (connectorQueryCtx->cache()) {
+  if (auto* cache = connectorQueryCtx->cache()) {
+    auto* ssdCache = cache->ssdCache();
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid.id(),
-        connectorQueryCtx->cache(),
+        cache,
         Connector::getTracker(
-            connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+            connectorQueryCtx->scanId(),
+            readerOpts.loadQuantum(),
+            ssdCache ? &ssdCache->groupStats() : nullptr),
         fileHandle.groupId.id(),
         ioStats,
         executor,
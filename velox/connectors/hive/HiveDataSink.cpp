@@ -183,6 +183,57 @@ std::shared_ptr<memory::MemoryPool> createSortPool(
   return writerPool->addLeafChild(fmt::format("{}.sort", writerPool->name()));
 }
 
+template <typename T>
+void addMinMax(
+    folly::dynamic& column,
+    const std::optional<T>& min,
+    const std::optional<T>& max) {
+  if (min.has_value() && max.has_value()) {
+    column["min"] = min.value();
+    column["max"] = max.value();
+  }
+}
+
+// Returns the statistics of the data columns of a file for its partition
+// update. 'numRows' is the number of rows in the file.
+folly::dynamic columnStatisticsToJson(
+    const RowType& dataType,
+    const std::vector<std::unique_ptr<dwio::common::ColumnStatistics>>& stats,
+    int64_t numRows) {
+  auto columns = folly::dynamic::array();
+  for (auto i = 0; i < stats.size(); ++i) {
+    const auto& columnStats = *stats[i];
+    auto column = folly::dynamic::object("name", dataType.nameOf(i));
+    if (const auto numValues = columnStats.getNumberOfValues()) {
+      column["nullCount"] = numRows - static_cast<int64_t>(numValues.value());
+    }
+    if (const auto* integerStats =
+            dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+                &columnStats)) {
+      addMinMax(
+          column, integerStats->getMinimum(), integerStats->getMaximum());
+    } else if (
+        const auto* doubleStats =
+            dynamic_cast<const dwio::common::DoubleColumnStatistics*>(
+                &columnStats)) {
+      const auto min = doubleStats->getMinimum();
+      const auto max = doubleStats->getMaximum();
+      // JSON has no NaN or infinity.
+      if (min.has_value() && std::isfinite(min.value()) && max.has_value() &&
+          std::isfinite(max.value())) {
+        addMinMax(column, min, max);
+      }
+    } else if (
+        const auto* stringStats =
+            dynamic_cast<const dwio::common::StringColumnStatistics*>(
+                &columnStats)) {
+      addMinMax(column, stringStats->getMinimum(), stringStats->getMaximum());
+    }
+    columns.push_back(std::move(column));
+  }
+  return columns;
+}
+
 #define WRITER_NON_RECLAIMABLE_SECTION_GUARD(index)       \
   memory::NonReclaimableSectionGuard nonReclaimableGuard( \
       writerInfo_[(index)]->nonReclaimableSectionHolder.get())
@@ -366,6 +417,8 @@ HiveDataSink::HiveDataSink(
       updateMode_(getUpdateMode()),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      maxOpenFileWriters_(hiveConfig_->maxOpenFileWriters(
+          connectorQueryCtx->sessionProperties())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty()
@@ -459,7 +512,10 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 
   splitInputRowsAndEnsureWriters();
 
-  for (auto index = 0; index < writers_.size(); ++index) {
+  // Writing may append writers for new files of partitions whose files were
+  // closed. These have no rows of 'input'.
+  const auto numWriters = writers_.size();
+  for (auto index = 0; index < numWriters; ++index) {
     const vector_size_t partitionSize = partitionSizes_[index];
     if (partitionSize == 0) {
       continue;
@@ -473,6 +529,7 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 }
 
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
+  index = ensureOpenWriter(index);
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto dataInput = makeDataInput(dataChannels_, input);
 
@@ -535,6 +592,14 @@ DataSink::Stats HiveDataSink::stats() const {
 std::shared_ptr<memory::MemoryPool> HiveDataSink::createWriterPool(
     const HiveWriterId& writerId) {
   auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  if (writerIndexMap_.count(writerId) != 0) {
+    // A new file for a partition whose previous file was closed.
+    return connectorPool->addAggregateChild(fmt::format(
+        "{}.{}.{}",
+        connectorPool->name(),
+        writerId.toString(),
+        writerInfo_.size()));
+  }
   return connectorPool->addAggregateChild(
       fmt::format("{}.{}", connectorPool->name(), writerId.toString()));
 }
@@ -581,6 +646,7 @@ std::vector<std::string> HiveDataSink::close() {
   state_ = State::kClosed;
   closeInternal();
 
+  const auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
   std::vector<std::string> partitionUpdates;
   partitionUpdates.reserve(writerInfo_.size());
   for (int i = 0; i < writerInfo_.size(); ++i) {
@@ -599,7 +665,9 @@ std::vector<std::string> HiveDataSink::close() {
             folly::dynamic::object
               ("writeFileName", info->writerParameters.writeFileName())
               ("targetFileName", info->writerParameters.targetFileName())
-              ("fileSize", ioStats_.at(i)->rawBytesWritten())))
+              ("fileSize", ioStats_.at(i)->rawBytesWritten())
+              ("columnStatistics", columnStatisticsToJson(
+                *dataType, info->columnStatistics, info->numWrittenRows))))
           ("rowCount", info->numWrittenRows)
          // TODO(gaoge): track and send the fields when inMemoryDataSizeInBytes
          // and containsNumberedFileNames are needed at coordinator when file_renaming_enabled are turned on.
@@ -624,15 +692,19 @@ void HiveDataSink::closeInternal() {
   TestValue::adjust(
       "facebook::velox::connector::hive::HiveDataSink::closeInternal", this);
 
+  // Writers closed by closeLeastRecentlyUsedWriter() are null.
   if (state_ == State::kClosed) {
     for (int i = 0; i < writers_.size(); ++i) {
-      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
-      writers_[i]->close();
+      if (writers_[i] != nullptr) {
+        closeWriter(i);
+      }
     }
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
-      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
-      writers_[i]->abort();
+      if (writers_[i] != nullptr) {
+        WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
+        writers_[i]->abort();
+      }
     }
   }
 }
@@ -648,9 +720,9 @@ uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Check max open writers.
   VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+      writerIndexMap_.size(), maxOpenWriters_, "Exceeded open writer limit");
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
-  VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
+  VELOX_CHECK_LE(writerIndexMap_.size(), writerInfo_.size());
 
   std::optional<std::string> partitionName;
   if (isPartitioned()) {
@@ -661,8 +733,6 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Without explicitly setting flush policy, the default memory based flush
   // policy is used.
   auto writerParameters = getWriterParameters(partitionName, id.bucketId);
-  const auto writePath = fs::path(writerParameters.writeDirectory()) /
-      writerParameters.writeFileName();
   auto writerPool = createWriterPool(id);
   auto sinkPool = createSinkPool(writerPool);
   std::shared_ptr<memory::MemoryPool> sortPool{nullptr};
@@ -676,19 +746,44 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       std::move(sortPool)));
   ioStats_.emplace_back(std::make_shared<io::IoStatistics>());
   setMemoryReclaimers(writerInfo_.back().get(), ioStats_.back().get());
+  writerIds_.emplace_back(id);
+  writerLastUse_.emplace_back(0);
+  writers_.emplace_back(nullptr);
+  // Extends the buffer used for partition rows calculations.
+  partitionSizes_.emplace_back(0);
+  partitionRows_.emplace_back(nullptr);
+  rawPartitionRows_.emplace_back(nullptr);
+
+  const uint32_t index = writers_.size() - 1;
+  if (!limitOpenWriters()) {
+    openWriter(index);
+  }
+  writerIndexMap_[id] = index;
+  return index;
+}
+
+void HiveDataSink::openWriter(uint32_t index) {
+  VELOX_CHECK_NULL(writers_[index]);
+  if (limitOpenWriters() && numOpenWriters_ >= maxOpenFileWriters_) {
+    closeLeastRecentlyUsedWriter();
+  }
+  const auto& writerInfo = writerInfo_[index];
+  const auto& writerParameters = writerInfo->writerParameters;
+  const auto writePath = fs::path(writerParameters.writeDirectory()) /
+      writerParameters.writeFileName();
 
   dwio::common::WriterOptions options;
   const auto* connectorSessionProperties =
       connectorQueryCtx_->sessionProperties();
   options.schema = getNonPartitionTypes(dataChannels_, inputType_);
 
-  options.memoryPool = writerInfo_.back()->writerPool.get();
+  options.memoryPool = writerInfo->writerPool.get();
   options.compressionKind = insertTableHandle_->compressionKind();
   if (canReclaim()) {
     options.spillConfig = spillConfig_;
   }
   options.nonReclaimableSection =
-      writerInfo_.back()->nonReclaimableSectionHolder.get();
+      writerInfo->nonReclaimableSectionHolder.get();
   options.maxStripeSize = std::optional(
       hiveConfig_->orcWriterMaxStripeSize(connectorSessionProperties));
   options.maxDictionaryMemory = std::optional(
@@ -712,50 +807,82 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       compressionLevel.value_or(kDefaultZstdCompressionLevel);
 
   // Prevents the memory allocation during the writer creation.
-  WRITER_NON_RECLAIMABLE_SECTION_GUARD(writerInfo_.size() - 1);
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto writer = writerFactory_->createWriter(
       dwio::common::FileSink::create(
           writePath,
           {.bufferWrite = false,
            .connectorProperties = hiveConfig_->config(),
            .fileCreateConfig = hiveConfig_->writeFileCreateConfig(),
-           .pool = writerInfo_.back()->sinkPool.get(),
+           .pool = writerInfo->sinkPool.get(),
            .metricLogger = dwio::common::MetricsLog::voidLog(),
-           .stats = ioStats_.back().get()}),
+           .stats = ioStats_[index].get()}),
       options);
-  writer = maybeCreateBucketSortWriter(std::move(writer));
-  writers_.emplace_back(std::move(writer));
-  // Extends the buffer used for partition rows calculations.
-  partitionSizes_.emplace_back(0);
-  partitionRows_.emplace_back(nullptr);
-  rawPartitionRows_.emplace_back(nullptr);
+  writers_[index] = maybeCreateBucketSortWriter(index, std::move(writer));
+  ++numOpenWriters_;
+}
 
-  writerIndexMap_.emplace(id, writers_.size() - 1);
-  return writerIndexMap_[id];
+uint32_t HiveDataSink::ensureOpenWriter(uint32_t index) {
+  if (!limitOpenWriters()) {
+    return index;
+  }
+  if (writers_[index] == nullptr) {
+    if (writerLastUse_[index] != 0) {
+      // The file was closed. The partition continues in a new file.
+      index = appendWriter(writerIds_[index]);
+    }
+    openWriter(index);
+  }
+  writerLastUse_[index] = ++numWriterUses_;
+  return index;
+}
+
+void HiveDataSink::closeLeastRecentlyUsedWriter() {
+  std::optional<uint32_t> lruIndex;
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] != nullptr &&
+        (!lruIndex.has_value() ||
+         writerLastUse_[i] < writerLastUse_[lruIndex.value()])) {
+      lruIndex = i;
+    }
+  }
+  VELOX_CHECK(lruIndex.has_value());
+  closeWriter(lruIndex.value());
+  writers_[lruIndex.value()].reset();
+  --numOpenWriters_;
+}
+
+void HiveDataSink::closeWriter(uint32_t index) {
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+  writers_[index]->close();
+  writerInfo_[index]->columnStatistics = writers_[index]->columnStatistics();
 }
 
 std::unique_ptr<facebook::velox::dwio::common::Writer>
 HiveDataSink::maybeCreateBucketSortWriter(
+    uint32_t index,
     std::unique_ptr<facebook::velox::dwio::common::Writer> writer) {
   if (!sortWrite()) {
     return writer;
   }
-  auto* sortPool = writerInfo_.back()->sortPool.get();
+  auto* sortPool = writerInfo_[index]->sortPool.get();
   VELOX_CHECK_NOT_NULL(sortPool);
   auto sortBuffer = std::make_unique<exec::SortBuffer>(
       getNonPartitionTypes(dataChannels_, inputType_),
       sortColumnIndices_,
       sortCompareFlags_,
       sortPool,
-      writerInfo_.back()->nonReclaimableSectionHolder.get(),
+      writerInfo_[index]->nonReclaimableSectionHolder.get(),
       spillConfig_,
-      writerInfo_.back()->spillStats.get());
+      writerInfo_[index]->spillStats.get());
   return std::make_unique<dwio::common::SortingWriter>(
       std::move(writer),
       std::move(sortBuffer),
       hiveConfig_->sortWriterMaxOutputRows(
           connectorQueryCtx_->sessionProperties()),
       hiveConfig_->sortWriterMaxOutputBytes(
+          connectorQueryCtx_->sessionProperties()),
+      hiveConfig_->sortWriterMaxBufferedBytes(
           connectorQueryCtx_->sessionProperties()));
 }
 
@@ -369,6 +369,10 @@ struct HiveWriterInfo {
   const std::shared_ptr<memory::MemoryPool> sinkPool;
   const std::shared_ptr<memory::MemoryPool> sortPool;
   int64_t numWrittenRows = 0;
+  /// The statistics of the data columns of the file, set when the file writer
+  /// is closed. Empty if the file format does not collect them.
+  std::vector<std::unique_ptr<dwio::common::ColumnStatistics>>
+      columnStatistics;
 };
 
 /// Identifies a hive writer.
@@ -497,6 +501,13 @@ class HiveDataSink : public DataSink {
     return bucketCount_ != 0;
   }
 
+  // Returns true if the number of open file writers is bounded by
+  // 'maxOpenFileWriters_'. Bucketed tables need one file per bucket, so the
+  // limit only applies to partitioned, non-bucketed tables.
+  FOLLY_ALWAYS_INLINE bool limitOpenWriters() const {
+    return maxOpenFileWriters_ > 0 && isPartitioned() && !isBucketed();
+  }
+
   FOLLY_ALWAYS_INLINE bool isCommitRequired() const {
     return commitStrategy_ != CommitStrategy::kNoCommit;
   }
@@ -526,11 +537,30 @@ class HiveDataSink : public DataSink {
   uint32_t ensureWriter(const HiveWriterId& id);
 
   // Appends a new writer for the given 'id'. The function returns the index of
-  // the newly created writer in 'writers_'.
+  // the newly created writer in 'writers_'. If limitOpenWriters(), the file is
+  // opened on the first write to it.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Creates the file writer at 'index' in 'writers_'. Closes the least
+  // recently used file writer first if the open writer limit is reached.
+  void openWriter(uint32_t index);
+
+  // Returns the index of an open writer for the rows of the writer at 'index'.
+  // This is 'index' unless the writer there was closed by
+  // closeLeastRecentlyUsedWriter(), in which case a writer for a new file of
+  // the same partition is appended.
+  uint32_t ensureOpenWriter(uint32_t index);
+
+  // Closes the open file writer that was least recently written to.
+  void closeLeastRecentlyUsedWriter();
+
+  // Closes the file writer at 'index' in 'writers_' and keeps its column
+  // statistics in 'writerInfo_'.
+  void closeWriter(uint32_t index);
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
+      uint32_t index,
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
 
   HiveWriterParameters getWriterParameters(
@@ -565,6 +595,7 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const HiveWriterParameters::UpdateMode updateMode_;
   const uint32_t maxOpenWriters_;
+  const uint32_t maxOpenFileWriters_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -591,6 +622,14 @@ class HiveDataSink : public DataSink {
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
+  // The writer id of each writer. Several writers have the same id if the
+  // file of a partition was closed to bound the number of open writers.
+  std::vector<HiveWriterId> writerIds_;
+  // The value of 'numWriterUses_' at the last write to each writer. 0 if
+  // never written.
+  std::vector<uint64_t> writerLastUse_;
+  uint64_t numWriterUses_{0};
+  uint32_t numOpenWriters_{0};
 
   // Below are structures updated when processing current input. partitionIds_
   // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
@@ -124,6 +124,7 @@ HiveDataSource::HiveDataSource(
       columnNames[readColumnNames[i]] = i;
     }
     for (auto& input : remainingFilterExpr->distinctFields()) {
+      remainingFilterPartitionKeys_.push_back(input->field());
       auto it = columnNames.find(input->field());
       if (it != columnNames.end()) {
         multiReferencedFields_.push_back(it->second);
@@ -135,6 +136,12 @@ HiveDataSource::HiveDataSource(
       readColumnNames.push_back(input->field());
       readColumnTypes.push_back(input->type());
     }
+    for (const auto& name : remainingFilterPartitionKeys_) {
+      if (partitionKeys_.count(name) == 0) {
+        remainingFilterPartitionKeys_.clear();
+        break;
+      }
+    }
     remainingFilterSubfields = remainingFilterExpr->extractSubfields();
     if (VLOG_IS_ON(1)) {
       VLOG(1) << fmt::format(
@@ -260,9 +267,56 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   // Split reader subclasses may need to use the reader options in prepareSplit
   // so we initialize it beforehand.
   splitReader_->configureReaderOptions(randomSkip_);
+
+  // A remaining filter over partition keys only has the same result for all
+  // rows of the split. Evaluate it once and skip the split or the filter.
+  remainingFilterPassesSplit_ = false;
+  splitFilteredOut_ = false;
+  if (!remainingFilterPartitionKeys_.empty()) {
+    if (auto passes = testRemainingFilterOnPartitionKeys()) {
+      if (!passes.value()) {
+        ++runtimeStats_.skippedSplits;
+        runtimeStats_.skippedSplitBytes += split_->length;
+        splitFilteredOut_ = true;
+        return;
+      }
+      remainingFilterPassesSplit_ = true;
+    }
+  }
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_, rowIndexColumn_);
 }
 
+std::optional<bool> HiveDataSource::testRemainingFilterOnPartitionKeys() {
+  for (const auto& name : remainingFilterPartitionKeys_) {
+    if (split_->partitionKeys.count(name) == 0) {
+      return std::nullopt;
+    }
+  }
+  // The filter is evaluated on a row of the reader output type so that the
+  // field indices it resolves stay valid for the batches of the split.
+  std::vector<VectorPtr> children;
+  children.reserve(readerOutputType_->size());
+  for (auto i = 0; i < readerOutputType_->size(); ++i) {
+    const auto& name = readerOutputType_->nameOf(i);
+    const auto& type = readerOutputType_->childAt(i);
+    auto it = split_->partitionKeys.find(name);
+    if (partitionKeys_.count(name) == 0 ||
+        it == split_->partitionKeys.end()) {
+      children.push_back(BaseVector::createNullConstant(type, 1, pool_));
+    } else {
+      children.push_back(newConstantFromString(type, it->second, 1, pool_));
+    }
+  }
+  auto input = std::make_shared<RowVector>(
+      pool_, readerOutputType_, nullptr, 1, std::move(children));
+  SelectivityVector rows(1);
+  VectorPtr result;
+  expressionEvaluator_->evaluate(
+      remainingFilterExprSet_.get(), rows, *input, result);
+  DecodedVector decoded(*result, rows);
+  return !decoded.isNullAt(0) && decoded.valueAt<bool>(0);
+}
+
 vector_size_t HiveDataSource::applyBucketConversion(
     const RowVectorPtr& rowVector,
     BufferPtr& indices) {
@@ -274,7 +328,7 @@ vector_size_t HiveDataSource::applyBucketConversion(
   for (vector_size_t i = 0; i < rowVector->size(); ++i) {
     VELOX_CHECK_EQ((partitions_[i] - bucketToKeep) % partitionBucketCount, 0);
   }
-  if (remainingFilterExprSet_) {
+  if (needsRemainingFilter()) {
     for (vector_size_t i = 0; i < rowVector->size(); ++i) {
       if (partitions_[i] != bucketToKeep) {
         filterRows_.setValid(i, false);
@@ -310,7 +364,7 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   TestValue::adjust(
       "facebook::velox::connector::hive::HiveDataSource::next", this);
 
-  if (splitReader_->emptySplit()) {
+  if (splitFilteredOut_ || splitReader_->emptySplit()) {
     resetSplit();
     return nullptr;
   }
@@ -338,7 +392,8 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     // or it passes on all rows, leave this as null and let exec::wrap skip
     // wrapping the results.
     BufferPtr remainingIndices;
-    if (remainingFilterExprSet_) {
+    const bool applyRemainingFilter = needsRemainingFilter();
+    if (applyRemainingFilter) {
       if (numBucketConversion_ > 0) {
         filterRows_.resizeFill(rowVector->size());
       } else {
@@ -351,7 +406,7 @@ std::optional<RowVectorPtr> HiveDataSource::next(
         return getEmptyOutput();
       }
     }
-    if (remainingFilterExprSet_) {
+    if (applyRemainingFilter) {
       rowsRemaining = evaluateRemainingFilter(rowVector);
       VELOX_CHECK_LE(rowsRemaining, rowsScanned);
       if (rowsRemaining == 0) {
@@ -416,6 +471,11 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"localReadBytes",
         RuntimeCounter(
             ioStats_->ssdRead().sum(), RuntimeCounter::Unit::kBytes)},
+       {"numRemoteCacheRead",
+        RuntimeCounter(ioStats_->remoteCacheRead().count())},
+       {"remoteCacheReadBytes",
+        RuntimeCounter(
+            ioStats_->remoteCacheRead().sum(), RuntimeCounter::Unit::kBytes)},
        {"numRamRead", RuntimeCounter(ioStats_->ramHit().count())},
        {"ramReadBytes",
         RuntimeCounter(ioStats_->ramHit().sum(), RuntimeCounter::Unit::kBytes)},
@@ -456,6 +516,8 @@ void HiveDataSource::setFromDataSource(
   scanSpec_ = std::move(source->scanSpec_);
   splitReader_ = std::move(source->splitReader_);
   splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  splitFilteredOut_ = source->splitFilteredOut_;
+  remainingFilterPassesSplit_ = source->remainingFilterPassesSplit_;
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
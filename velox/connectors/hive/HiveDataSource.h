@@ -138,6 +138,15 @@ class HiveDataSource : public DataSource {
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Evaluates the remaining filter on the partition key values of split_.
+  // Returns std::nullopt if the split does not have a value for every
+  // partition key the filter uses.
+  std::optional<bool> testRemainingFilterOnPartitionKeys();
+
+  bool needsRemainingFilter() const {
+    return remainingFilterExprSet_ && !remainingFilterPassesSplit_;
+  }
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
@@ -170,6 +179,18 @@ class HiveDataSource : public DataSource {
   // columns need to be materialized eagerly to avoid missing values in output.
   std::vector<column_index_t> multiReferencedFields_;
 
+  // The columns of the remaining filter if all of them are partition keys.
+  // Empty otherwise.
+  std::vector<std::string> remainingFilterPartitionKeys_;
+
+  // True if the remaining filter passes all rows of the current split
+  // according to its partition key values.
+  bool remainingFilterPassesSplit_{false};
+
+  // True if the remaining filter fails all rows of the current split
+  // according to its partition key values. The split is then not read.
+  bool splitFilteredOut_{false};
+
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
   int64_t numBucketConversion_ = 0;
@@ -27,40 +27,6 @@
 #include "velox/type/TimestampConversion.h"
 
 namespace facebook::velox::connector::hive {
-namespace {
-template <TypeKind kind>
-VectorPtr newConstantFromString(
-    const TypePtr& type,
-    const std::optional<std::string>& value,
-    vector_size_t size,
-    velox::memory::MemoryPool* pool) {
-  using T = typename TypeTraits<kind>::NativeType;
-  if (!value.has_value()) {
-    return std::make_shared<ConstantVector<T>>(pool, size, true, type, T());
-  }
-
-  if (type->isDate()) {
-    auto days = DATE()->toDays((folly::StringPiece)value.value());
-    return std::make_shared<ConstantVector<int32_t>>(
-        pool, size, false, type, std::move(days));
-  }
-
-  if constexpr (std::is_same_v<T, StringView>) {
-    return std::make_shared<ConstantVector<StringView>>(
-        pool, size, false, type, StringView(value.value()));
-  } else {
-    auto copy = velox::util::Converter<kind>::tryCast(value.value())
-                    .thenOrThrow(folly::identity, [&](const Status& status) {
-                      VELOX_USER_FAIL("{}", status.message());
-                    });
-    if constexpr (kind == TypeKind::TIMESTAMP) {
-      copy.toGMT(Timestamp::defaultTimezone());
-    }
-    return std::make_shared<ConstantVector<T>>(
-        pool, size, false, type, std::move(copy));
-  }
-}
-} // namespace
 
 std::unique_ptr<SplitReader> SplitReader::create(
     const std::shared_ptr<hive::HiveConnectorSplit>& hiveSplit,
@@ -249,6 +215,16 @@ void SplitReader::createReader(
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+  // The readers of splits of the same file version share its parsed footer.
+  // Without a modification time, a rewritten file could not be told apart.
+  std::optional<dwio::common::FileMetadataKey> fileMetadataKey;
+  if (hiveSplit_->properties.has_value() &&
+      hiveSplit_->properties->modificationTime.has_value()) {
+    fileMetadataKey = dwio::common::FileMetadataKey{
+        fileHandleCachePtr->uuid.id(),
+        hiveSplit_->properties->modificationTime.value()};
+  }
+  baseReaderOpts_.setFileMetadataKey(fileMetadataKey);
   auto baseFileInput = createBufferedInput(
       *fileHandleCachePtr,
       baseReaderOpts_,
@@ -272,6 +248,14 @@ void SplitReader::createReader(
       std::move(metadataFilter),
       ROW(std::move(columnNames), std::move(columnTypes)),
       hiveSplit_);
+  if (executor_ && hiveConfig_->decodingParallelismFactor() > 1) {
+    // The executor is owned by the connector, which outlives the reader.
+    baseRowReaderOpts_.setDecodingExecutor(
+        std::shared_ptr<folly::Executor>(
+            std::shared_ptr<folly::Executor>(), executor_));
+    baseRowReaderOpts_.setDecodingParallelismFactor(
+        hiveConfig_->decodingParallelismFactor());
+  }
 }
 
 bool SplitReader::checkIfSplitIsEmpty(
@@ -354,13 +338,8 @@ std::vector<TypePtr> SplitReader::adaptColumns(
                iter != hiveSplit_->infoColumns.end()) {
       auto infoColumnType =
           readerOutputType_->childAt(readerOutputType_->getChildIdx(fieldName));
-      auto constant = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
-          newConstantFromString,
-          infoColumnType->kind(),
-          infoColumnType,
-          iter->second,
-          1,
-          connectorQueryCtx_->memoryPool());
+      auto constant = newConstantFromString(
+          infoColumnType, iter->second, 1, connectorQueryCtx_->memoryPool());
       childSpec->setConstantValue(constant);
     } else {
       auto fileTypeIdx = fileType->getChildIdxIfExists(fieldName);
@@ -406,13 +385,8 @@ void SplitReader::setPartitionValue(
       "ColumnHandle is missing for partition key {}",
       partitionKey);
   auto type = it->second->dataType();
-  auto constant = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
-      newConstantFromString,
-      type->kind(),
-      type,
-      value,
-      1,
-      connectorQueryCtx_->memoryPool());
+  auto constant =
+      newConstantFromString(type, value, 1, connectorQueryCtx_->memoryPool());
   spec->setConstantValue(constant);
 }
 
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    const RowTypePtr& deleteFileSchema,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId)
+    : deleteFileSchema_(deleteFileSchema),
+      pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile.content == FileContent::kEqualityDeletes);
+  VELOX_CHECK_GT(deleteFileSchema_->size(), 0);
+
+  if (deleteFile.recordCount == 0) {
+    return;
+  }
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < deleteFileSchema_->size(); ++i) {
+    scanSpec->addField(deleteFileSchema_->nameOf(i), i);
+  }
+
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx,
+      deleteFileSchema_,
+      deleteSplit);
+
+  auto deleteFileHandleCachePtr =
+      fileHandleFactory->generate(deleteFile.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      executor);
+
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts,
+      {},
+      scanSpec,
+      nullptr,
+      deleteFileSchema_,
+      deleteSplit);
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  // Each batch is kept, so a new output vector is used for every batch.
+  constexpr uint64_t kBatchSize = 10'000;
+  deletedKeys_.reserve(deleteFile.recordCount);
+  for (;;) {
+    VectorPtr output = BaseVector::create(deleteFileSchema_, 0, pool_);
+    if (deleteRowReader->next(kBatchSize, output) == 0) {
+      break;
+    }
+    if (output->size() == 0) {
+      continue;
+    }
+    output->loadedVector();
+    auto batch = std::static_pointer_cast<RowVector>(output);
+    for (auto row = 0; row < batch->size(); ++row) {
+      deletedKeys_.insert({batch.get(), row, batch->hashValueAt(row)});
+    }
+    deleteBatches_.push_back(std::move(batch));
+  }
+}
+
+void EqualityDeleteFileReader::markDeletedRows(
+    const RowVector& data,
+    uint64_t* deletedRows) const {
+  if (deletedKeys_.empty()) {
+    return;
+  }
+
+  const auto& dataType = data.type()->asRow();
+  std::vector<VectorPtr> keyColumns;
+  keyColumns.reserve(deleteFileSchema_->size());
+  for (const auto& name : deleteFileSchema_->names()) {
+    const auto channel = dataType.getChildIdxIfExists(name);
+    VELOX_CHECK(
+        channel.has_value(),
+        "Equality delete column is not read from the data file: {}",
+        name);
+    keyColumns.push_back(
+        BaseVector::loadedVectorShared(data.childAt(channel.value())));
+  }
+  const auto keys = std::make_shared<RowVector>(
+      pool_, deleteFileSchema_, nullptr, data.size(), std::move(keyColumns));
+
+  for (auto row = 0; row < keys->size(); ++row) {
+    if (deletedKeys_.contains({keys.get(), row, keys->hashValueAt(row)})) {
+      bits::setBit(deletedRows, row);
+    }
+  }
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
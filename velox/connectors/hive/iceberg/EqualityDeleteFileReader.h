@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// Reads an equality delete file. All rows of the file are read when the
+/// reader is created, and the values of the delete columns are kept in a hash
+/// set. A row of the base data file is deleted if its values in these columns
+/// match the values of a row in the delete file. Nulls match nulls.
+class EqualityDeleteFileReader {
+ public:
+  /// 'deleteFileSchema' has the names and types of the delete columns.
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      const RowTypePtr& deleteFileSchema,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Sets the bits in 'deletedRows' for the rows of 'data' that are deleted.
+  /// 'data' must have the delete columns.
+  void markDeletedRows(const RowVector& data, uint64_t* deletedRows) const;
+
+ private:
+  // A row of 'keys'.
+  struct Entry {
+    const RowVector* keys;
+    vector_size_t index;
+    uint64_t hash;
+  };
+
+  struct EntryHasher {
+    size_t operator()(const Entry& entry) const {
+      return entry.hash;
+    }
+  };
+
+  struct EntryComparer {
+    bool operator()(const Entry& left, const Entry& right) const {
+      return left.keys->equalValueAt(right.keys, left.index, right.index);
+    }
+  };
+
+  const RowTypePtr deleteFileSchema_;
+  memory::MemoryPool* const pool_;
+
+  // The batches read from the delete file. Referenced by 'deletedKeys_'.
+  std::vector<RowVectorPtr> deleteBatches_;
+
+  folly::F14FastSet<Entry, EntryHasher, EntryComparer> deletedKeys_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 
@@ -26,6 +27,12 @@ struct IcebergDeleteFile;
 struct HiveIcebergSplit : public connector::hive::HiveConnectorSplit {
   std::vector<IcebergDeleteFile> deleteFiles;
 
+  // The names of the top-level columns of the table schema by Iceberg field
+  // id. Field ids are not positions: a column keeps its id when columns are
+  // added, dropped, reordered or renamed. Used to find the columns of the
+  // equality field ids of equality delete files.
+  std::unordered_map<int32_t, std::string> columnNamesByFieldId;
+
   HiveIcebergSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include <algorithm>
+
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
@@ -54,6 +56,21 @@ void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats,
     const std::shared_ptr<HiveColumnHandle>& rowIndexColumn) {
+  std::shared_ptr<const HiveIcebergSplit> icebergSplit =
+      std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
+  const auto& deleteFiles = icebergSplit->deleteFiles;
+
+  // The delete columns must be in the ScanSpec when the reader is created.
+  std::vector<RowTypePtr> equalityDeleteSchemas;
+  for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.content == FileContent::kEqualityDeletes &&
+        deleteFile.recordCount > 0) {
+      equalityDeleteSchemas.push_back(
+          equalityDeleteSchema(deleteFile, *icebergSplit));
+    }
+  }
+  addEqualityDeleteColumns(equalityDeleteSchemas);
+
   createReader(std::move(metadataFilter), rowIndexColumn);
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
@@ -61,15 +78,15 @@ void IcebergSplitReader::prepareSplit(
     return;
   }
 
+  skipUnusedEqualityDeleteColumns(equalityDeleteSchemas);
   createRowReader();
 
-  std::shared_ptr<const HiveIcebergSplit> icebergSplit =
-      std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
   positionalDeleteFileReaders_.clear();
+  equalityDeleteFileReaders_.clear();
 
-  const auto& deleteFiles = icebergSplit->deleteFiles;
+  auto equalityDeleteSchema = equalityDeleteSchemas.begin();
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
@@ -86,12 +103,131 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
+    } else if (deleteFile.content == FileContent::kEqualityDeletes) {
+      if (deleteFile.recordCount > 0) {
+        equalityDeleteFileReaders_.push_back(
+            std::make_unique<EqualityDeleteFileReader>(
+                deleteFile,
+                *equalityDeleteSchema++,
+                fileHandleFactory_,
+                connectorQueryCtx_,
+                executor_,
+                hiveConfig_,
+                ioStats_,
+                hiveSplit_->connectorId));
+      }
     } else {
       VELOX_NYI();
     }
   }
 }
 
+RowTypePtr IcebergSplitReader::equalityDeleteSchema(
+    const IcebergDeleteFile& deleteFile,
+    const HiveIcebergSplit& split) const {
+  const auto& dataColumns = hiveTableHandle_->dataColumns();
+  VELOX_USER_CHECK_NOT_NULL(
+      dataColumns,
+      "Equality deletes require the data columns of the table: {}",
+      deleteFile.filePath);
+  VELOX_USER_CHECK(
+      !deleteFile.equalityFieldIds.empty(),
+      "Equality delete file has no equality field ids: {}",
+      deleteFile.filePath);
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto fieldId : deleteFile.equalityFieldIds) {
+    auto it = split.columnNamesByFieldId.find(fieldId);
+    VELOX_USER_CHECK(
+        it != split.columnNamesByFieldId.end(),
+        "Equality field id {} of delete file {} is not the field id of a "
+        "column of the table",
+        fieldId,
+        deleteFile.filePath);
+    const auto channel = dataColumns->getChildIdxIfExists(it->second);
+    VELOX_USER_CHECK(
+        channel.has_value(),
+        "Column {} with equality field id {} of delete file {} is not a data "
+        "column of the table",
+        it->second,
+        fieldId,
+        deleteFile.filePath);
+    names.push_back(it->second);
+    types.push_back(dataColumns->childAt(channel.value()));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+void IcebergSplitReader::addEqualityDeleteColumns(
+    const std::vector<RowTypePtr>& deleteSchemas) {
+  // The delete columns added by earlier splits of the data source are still
+  // in 'scanSpec_', which is shared by its splits.
+  const auto numOutput = readerOutputType_->size();
+  auto isHidden = [&](const common::ScanSpec& spec) {
+    return spec.projectOut() &&
+        spec.channel() != common::ScanSpec::kNoChannel &&
+        spec.channel() >= numOutput;
+  };
+  column_index_t numHidden = 0;
+  for (const auto& child : scanSpec_->children()) {
+    numHidden += isHidden(*child);
+  }
+  for (const auto& schema : deleteSchemas) {
+    for (const auto& name : schema->names()) {
+      if (readerOutputType_->containsChild(name)) {
+        continue;
+      }
+      const auto* child = scanSpec_->childByName(name);
+      if (child == nullptr || !isHidden(*child)) {
+        // A column that is only filtered on has a ScanSpec without a channel.
+        scanSpec_->addField(name, numOutput + numHidden++);
+      }
+    }
+  }
+  if (numHidden == 0) {
+    readOutputType_ = nullptr;
+    return;
+  }
+
+  auto names = readerOutputType_->names();
+  auto types = readerOutputType_->children();
+  names.resize(numOutput + numHidden);
+  types.resize(numOutput + numHidden);
+  for (const auto& child : scanSpec_->children()) {
+    if (isHidden(*child)) {
+      names[child->channel()] = child->fieldName();
+      types[child->channel()] =
+          hiveTableHandle_->dataColumns()->findChild(child->fieldName());
+    }
+  }
+  readOutputType_ = ROW(std::move(names), std::move(types));
+  readOutput_ = nullptr;
+}
+
+void IcebergSplitReader::skipUnusedEqualityDeleteColumns(
+    const std::vector<RowTypePtr>& deleteSchemas) {
+  if (!readOutputType_) {
+    return;
+  }
+  for (auto channel = readerOutputType_->size();
+       channel < readOutputType_->size();
+       ++channel) {
+    const auto& name = readOutputType_->nameOf(channel);
+    const bool used = std::any_of(
+        deleteSchemas.begin(), deleteSchemas.end(), [&](const auto& schema) {
+          return schema->containsChild(name);
+        });
+    auto* child = scanSpec_->childByName(name);
+    if (!used && !child->hasFilter()) {
+      // Not read. The reader fills the channel with nulls.
+      child->setConstantValue(BaseVector::createNullConstant(
+          readOutputType_->childAt(channel), 1, pool_));
+    }
+  }
+  scanSpec_->resetCachedValues(false);
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
@@ -118,10 +254,72 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
     mutation.deletedRows = deleteBitmap_->as<uint64_t>();
   }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+  if (!readOutputType_) {
+    auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+    baseReadOffset_ += rowsScanned;
+    if (!equalityDeleteFileReaders_.empty() && output->size() > 0) {
+      applyEqualityDeletes(output);
+    }
+    return rowsScanned;
+  }
+
+  if (!readOutput_) {
+    readOutput_ = BaseVector::create(readOutputType_, 0, pool_);
+  }
+  auto rowsScanned = baseRowReader_->next(size, readOutput_, &mutation);
   baseReadOffset_ += rowsScanned;
+  if (rowsScanned == 0) {
+    return 0;
+  }
+  if (!equalityDeleteFileReaders_.empty() && readOutput_->size() > 0) {
+    applyEqualityDeletes(readOutput_);
+  }
 
+  // Removes the delete columns that the scan does not output.
+  const auto* rowVector = readOutput_->asUnchecked<RowVector>();
+  std::vector<VectorPtr> children(
+      rowVector->children().begin(),
+      rowVector->children().begin() + readerOutputType_->size());
+  output = std::make_shared<RowVector>(
+      pool_,
+      readerOutputType_,
+      nullptr,
+      rowVector->size(),
+      std::move(children));
   return rowsScanned;
 }
 
+void IcebergSplitReader::applyEqualityDeletes(VectorPtr& output) {
+  const auto* rowVector = output->asUnchecked<RowVector>();
+  const auto numRows = rowVector->size();
+  equalityDeletedRows_.assign(bits::nwords(numRows), 0);
+  for (const auto& reader : equalityDeleteFileReaders_) {
+    reader->markDeletedRows(*rowVector, equalityDeletedRows_.data());
+  }
+
+  const auto numDeleted =
+      bits::countBits(equalityDeletedRows_.data(), 0, numRows);
+  if (numDeleted == 0) {
+    return;
+  }
+
+  const auto numRemaining = numRows - numDeleted;
+  auto indices = allocateIndices(numRemaining, pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t i = 0;
+  bits::forEachUnsetBit(
+      equalityDeletedRows_.data(), 0, numRows, [&](vector_size_t row) {
+        rawIndices[i++] = row;
+      });
+
+  std::vector<VectorPtr> children;
+  children.reserve(rowVector->childrenSize());
+  for (const auto& child : rowVector->children()) {
+    children.push_back(
+        BaseVector::wrapInDictionary(nullptr, indices, numRemaining, child));
+  }
+  output = std::make_shared<RowVector>(
+      pool_, rowVector->type(), nullptr, numRemaining, std::move(children));
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -18,11 +18,13 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
 
 struct IcebergDeleteFile;
+struct HiveIcebergSplit;
 
 class IcebergSplitReader : public SplitReader {
  public:
@@ -49,6 +51,27 @@ class IcebergSplitReader : public SplitReader {
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
  private:
+  // Returns the names and types of the delete columns of an equality delete
+  // file. The equality field ids are resolved with the field ids of the
+  // table columns in 'split'.
+  RowTypePtr equalityDeleteSchema(
+      const IcebergDeleteFile& deleteFile,
+      const HiveIcebergSplit& split) const;
+
+  // Adds the columns of 'deleteSchemas' that the scan does not output to
+  // 'scanSpec_', to be read into channels after the ones of
+  // 'readerOutputType_', and sets 'readOutputType_'. Must be called before
+  // the reader is created.
+  void addEqualityDeleteColumns(const std::vector<RowTypePtr>& deleteSchemas);
+
+  // Stops reading the delete columns added by earlier splits that no delete
+  // file of this split needs. Called after the reader is created.
+  void skipUnusedEqualityDeleteColumns(
+      const std::vector<RowTypePtr>& deleteSchemas);
+
+  // Removes the rows of 'output' deleted by the equality delete files.
+  void applyEqualityDeletes(VectorPtr& output);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -59,5 +82,17 @@ class IcebergSplitReader : public SplitReader {
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
   BufferPtr deleteBitmap_;
+
+  std::vector<std::unique_ptr<EqualityDeleteFileReader>>
+      equalityDeleteFileReaders_;
+  // Bits for the rows of a batch that are deleted by equality deletes.
+  std::vector<uint64_t> equalityDeletedRows_;
+
+  // 'readerOutputType_' followed by the delete columns that the scan does not
+  // output, or nullptr if there are no such columns. The batches are read
+  // with this type and the delete columns are removed after the deletes are
+  // applied.
+  RowTypePtr readOutputType_;
+  VectorPtr readOutput_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
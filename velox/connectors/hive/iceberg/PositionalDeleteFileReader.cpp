@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
+#include <folly/Conv.h>
+
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
@@ -56,8 +58,14 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     return;
   }
 
-  // TODO: check if the lowerbounds and upperbounds in deleteFile overlap with
-  //  this batch. If not, no need to proceed.
+  // Skips the delete file without opening it if its bounds show that it has
+  // no deletes for this split.
+  if (!mayHaveDeletes()) {
+    ++runtimeStats.skippedSplits;
+    runtimeStats.skippedSplitBytes += deleteFile_.fileSizeInBytes;
+    endOfFile_ = true;
+    return;
+  }
 
   // Create the ScanSpec for this delete file
   auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
@@ -200,6 +208,30 @@ void PositionalDeleteFileReader::readDeletePositions(
   }
 }
 
+bool PositionalDeleteFileReader::mayHaveDeletes() const {
+  const auto pathLower = deleteFile_.lowerBounds.find(filePathColumn_->id);
+  if (pathLower != deleteFile_.lowerBounds.end() &&
+      baseFilePath_ < pathLower->second) {
+    return false;
+  }
+  const auto pathUpper = deleteFile_.upperBounds.find(filePathColumn_->id);
+  if (pathUpper != deleteFile_.upperBounds.end() &&
+      baseFilePath_ > pathUpper->second) {
+    return false;
+  }
+
+  // The deleted positions are all before the first row of the split.
+  const auto posUpper = deleteFile_.upperBounds.find(posColumn_->id);
+  if (posUpper != deleteFile_.upperBounds.end()) {
+    const auto maxPosition = folly::tryTo<int64_t>(posUpper->second);
+    if (maxPosition.hasValue() &&
+        maxPosition.value() < static_cast<int64_t>(splitOffset_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool PositionalDeleteFileReader::endOfFile() {
   return endOfFile_;
 }
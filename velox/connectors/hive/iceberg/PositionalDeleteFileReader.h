@@ -55,6 +55,10 @@ class PositionalDeleteFileReader {
   bool endOfFile();
 
  private:
+  // Returns false if the lower and upper bounds of the delete file show that
+  // it has no deletes for the rows of this split.
+  bool mayHaveDeletes() const;
+
   void updateDeleteBitmap(
       VectorPtr deletePositionsVector,
       uint64_t baseReadOffset,
@@ -14,12 +14,14 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -92,6 +94,104 @@ class HiveIcebergTest : public HiveConnectorTestBase {
         makeNotInList(deleteRowsVec) + ")";
   }
 
+  /// Deletes the rows where c0 is in 'deletedValues' with an equality delete
+  /// file.
+  void assertEqualityDeletes(const std::vector<int64_t>& deletedValues) {
+    auto dataFilePaths = writeDataFile(1, rowCount);
+
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(
+        deleteFilePath->getPath(),
+        makeRowVector({"c0"}, {makeFlatVector<int64_t>(deletedValues)}));
+    const auto path = deleteFilePath->getPath();
+    IcebergDeleteFile deleteFile(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        deletedValues.size(),
+        testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+        {1});
+
+    auto plan = PlanBuilder(pool_.get())
+                    .tableScan(rowType_, {}, "", rowType_)
+                    .planNode();
+    HiveConnectorTestBase::assertQuery(
+        plan,
+        {makeIcebergSplit(
+            dataFilePaths[0]->getPath(), {deleteFile}, {{1, "c0"}})},
+        getQuery({deletedValues}),
+        0);
+  }
+
+  /// Writes 'numFiles' data files of 'rowCount' rows of 'wideRowType_', with
+  /// c0 numbering the rows of all files, c1 = c0 % 10 and c2 = c0 % 7.
+  std::vector<std::shared_ptr<TempFilePath>> writeWideDataFiles(
+      int32_t numFiles) {
+    std::vector<RowVectorPtr> dataVectors;
+    std::vector<std::shared_ptr<TempFilePath>> dataFilePaths;
+    for (auto i = 0; i < numFiles; ++i) {
+      const int64_t firstRow = i * rowCount;
+      dataVectors.push_back(makeRowVector(
+          wideRowType_->names(),
+          {makeFlatVector<int64_t>(
+               rowCount, [&](auto row) { return firstRow + row; }),
+           makeFlatVector<int64_t>(
+               rowCount, [&](auto row) { return (firstRow + row) % 10; }),
+           makeFlatVector<int64_t>(
+               rowCount, [&](auto row) { return (firstRow + row) % 7; })}));
+      dataFilePaths.push_back(TempFilePath::create());
+      writeToFile(dataFilePaths.back()->getPath(), dataVectors.back());
+    }
+    createDuckDbTable(dataVectors);
+    return dataFilePaths;
+  }
+
+  /// Writes 'keys' to 'deleteFilePath' and returns an equality delete file
+  /// for it with 'fieldIds' as the equality field ids.
+  IcebergDeleteFile writeEqualityDeleteFile(
+      const std::string& deleteFilePath,
+      const RowVectorPtr& keys,
+      const std::vector<int32_t>& fieldIds) {
+    writeToFile(deleteFilePath, keys);
+    auto file = filesystems::getFileSystem(deleteFilePath, nullptr)
+                    ->openFileForRead(deleteFilePath);
+    return IcebergDeleteFile(
+        FileContent::kEqualityDeletes,
+        deleteFilePath,
+        fileFomat_,
+        keys->size(),
+        file->size(),
+        fieldIds);
+  }
+
+  /// Verifies that a positional delete file with deletes only for another
+  /// data file is skipped based on its file path bounds, without being
+  /// opened.
+  void assertPositionalDeleteFileSkipped() {
+    auto dataFilePaths = writeDataFile(1, rowCount);
+    const auto dataFilePath = dataFilePaths[0]->getPath();
+    const auto otherFilePath = dataFilePath + "_other";
+
+    IcebergDeleteFile deleteFile(
+        FileContent::kPositionalDeletes,
+        dataFilePath + "_deletes_not_written",
+        fileFomat_,
+        100,
+        1'000,
+        {},
+        {{pathColumn_->id, otherFilePath}},
+        {{pathColumn_->id, otherFilePath}});
+
+    auto task = HiveConnectorTestBase::assertQuery(
+        tableScanNode(),
+        {makeIcebergSplit(dataFilePath, {deleteFile})},
+        "SELECT * FROM tmp",
+        0);
+    const auto& stats =
+        task->taskStats().pipelineStats[0].operatorStats[0].runtimeStats;
+    ASSERT_EQ(stats.at("skippedSplits").sum, 1);
+  }
+
   const static int rowCount = 20000;
 
  private:
@@ -148,7 +248,8 @@ class HiveIcebergTest : public HiveConnectorTestBase {
 
   std::shared_ptr<ConnectorSplit> makeIcebergSplit(
       const std::string& dataFilePath,
-      const std::vector<IcebergDeleteFile>& deleteFiles = {}) {
+      const std::vector<IcebergDeleteFile>& deleteFiles = {},
+      std::unordered_map<int32_t, std::string> columnNamesByFieldId = {}) {
     std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
     std::unordered_map<std::string, std::string> customSplitInfo;
     customSplitInfo["table_format"] = "hive-iceberg";
@@ -157,7 +258,7 @@ class HiveIcebergTest : public HiveConnectorTestBase {
                     ->openFileForRead(dataFilePath);
     const int64_t fileSize = file->size();
 
-    return std::make_shared<HiveIcebergSplit>(
+    auto split = std::make_shared<HiveIcebergSplit>(
         kHiveConnectorId,
         dataFilePath,
         fileFomat_,
@@ -168,6 +269,8 @@ class HiveIcebergTest : public HiveConnectorTestBase {
         customSplitInfo,
         nullptr,
         deleteFiles);
+    split->columnNamesByFieldId = std::move(columnNamesByFieldId);
+    return split;
   }
 
   std::vector<RowVectorPtr> makeVectors(int32_t count, int32_t rowsPerVector) {
@@ -281,6 +384,14 @@ class HiveIcebergTest : public HiveConnectorTestBase {
 
   dwio::common::FileFormat fileFomat_{dwio::common::FileFormat::DWRF};
   RowTypePtr rowType_{ROW({"c0"}, {BIGINT()})};
+  RowTypePtr wideRowType_{
+      ROW({"c0", "c1", "c2"}, {BIGINT(), BIGINT(), BIGINT()})};
+  // Field ids of the columns of 'wideRowType_'. They are not the positions
+  // of the columns, as after columns are dropped and reordered.
+  std::unordered_map<int32_t, std::string> wideFieldIds_{
+      {3, "c0"},
+      {1, "c1"},
+      {8, "c2"}};
   std::shared_ptr<IcebergMetadataColumn> pathColumn_ =
       IcebergMetadataColumn::icebergDeleteFilePathColumn();
   std::shared_ptr<IcebergMetadataColumn> posColumn_ =
@@ -338,6 +449,151 @@ TEST_F(HiveIcebergTest, baseFileMultiplePositionalDeletes) {
   assertPositionalDeletes({{0}, {9999}, {10000}, {19999}});
 }
 
+TEST_F(HiveIcebergTest, positionalDeleteFileSkipped) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  assertPositionalDeleteFileSkipped();
+}
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  assertEqualityDeletes({0, 1, 2, 3});
+  // Values in both batches of 10000 rows, and a value not in the data.
+  assertEqualityDeletes({0, 9999, 10000, 19999, 50000});
+  assertEqualityDeletes(makeRandomDeleteRows(rowCount));
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesByFieldId) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  auto dataFilePaths = writeWideDataFiles(1);
+  auto deleteFilePath = TempFilePath::create();
+  // Field id 1 is c1, not the first column.
+  auto deleteFile = writeEqualityDeleteFile(
+      deleteFilePath->getPath(),
+      makeRowVector({"c1"}, {makeFlatVector<int64_t>({1, 3})}),
+      {1});
+
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(wideRowType_, {}, "", wideRowType_)
+                  .planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      {makeIcebergSplit(
+          dataFilePaths[0]->getPath(), {deleteFile}, wideFieldIds_)},
+      "SELECT * FROM tmp WHERE c1 NOT IN (1, 3)",
+      0);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesKeyNotProjected) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  auto dataFilePaths = writeWideDataFiles(1);
+  auto deleteFilePath = TempFilePath::create();
+  auto deleteFile = writeEqualityDeleteFile(
+      deleteFilePath->getPath(),
+      makeRowVector({"c2"}, {makeFlatVector<int64_t>({0, 6})}),
+      {8});
+
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(ROW({"c0"}, {BIGINT()}), {}, "", wideRowType_)
+                  .planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      {makeIcebergSplit(
+          dataFilePaths[0]->getPath(), {deleteFile}, wideFieldIds_)},
+      "SELECT c0 FROM tmp WHERE c2 NOT IN (0, 6)",
+      0);
+
+  // The key is only used by the remaining filter.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(ROW({"c0"}, {BIGINT()}), {}, "c2 > 2", wideRowType_)
+             .planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      {makeIcebergSplit(
+          dataFilePaths[0]->getPath(), {deleteFile}, wideFieldIds_)},
+      "SELECT c0 FROM tmp WHERE c2 > 2 AND c2 NOT IN (0, 6)",
+      0);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesMultiColumnKey) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  auto dataFilePaths = writeWideDataFiles(1);
+  auto deleteFilePath = TempFilePath::create();
+  auto deleteFile = writeEqualityDeleteFile(
+      deleteFilePath->getPath(),
+      makeRowVector(
+          {"c1", "c2"},
+          {makeFlatVector<int64_t>({1, 2, 9, 4}),
+           makeFlatVector<int64_t>({1, 5, 0, 100})}),
+      {1, 8});
+
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(ROW({"c0"}, {BIGINT()}), {}, "", wideRowType_)
+                  .planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      {makeIcebergSplit(
+          dataFilePaths[0]->getPath(), {deleteFile}, wideFieldIds_)},
+      "SELECT c0 FROM tmp WHERE NOT ((c1 = 1 AND c2 = 1) OR "
+      "(c1 = 2 AND c2 = 5) OR (c1 = 9 AND c2 = 0))",
+      0);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesMultipleSplits) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  // The splits have deletes on different columns that are not projected, and
+  // one split has none.
+  const int64_t numRows = rowCount;
+  auto dataFilePaths = writeWideDataFiles(3);
+  auto c1DeleteFilePath = TempFilePath::create();
+  auto c1DeleteFile = writeEqualityDeleteFile(
+      c1DeleteFilePath->getPath(),
+      makeRowVector({"c1"}, {makeFlatVector<int64_t>({1})}),
+      {1});
+  auto c2DeleteFilePath = TempFilePath::create();
+  auto c2DeleteFile = writeEqualityDeleteFile(
+      c2DeleteFilePath->getPath(),
+      makeRowVector({"c2"}, {makeFlatVector<int64_t>({3})}),
+      {8});
+
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(ROW({"c0"}, {BIGINT()}), {}, "", wideRowType_)
+                  .planNode();
+  HiveConnectorTestBase::assertQuery(
+      plan,
+      {makeIcebergSplit(
+           dataFilePaths[0]->getPath(), {c1DeleteFile}, wideFieldIds_),
+       makeIcebergSplit(dataFilePaths[1]->getPath(), {}, wideFieldIds_),
+       makeIcebergSplit(
+           dataFilePaths[2]->getPath(), {c2DeleteFile}, wideFieldIds_)},
+      fmt::format(
+          "SELECT c0 FROM tmp WHERE NOT (c0 < {} AND c1 = 1) AND "
+          "NOT (c0 >= {} AND c2 = 3)",
+          numRows,
+          2 * numRows),
+      0);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletesUnknownFieldId) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  auto dataFilePaths = writeWideDataFiles(1);
+  auto deleteFilePath = TempFilePath::create();
+  auto deleteFile = writeEqualityDeleteFile(
+      deleteFilePath->getPath(),
+      makeRowVector({"c1"}, {makeFlatVector<int64_t>({1})}),
+      {5});
+
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(wideRowType_, {}, "", wideRowType_)
+                  .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .split(makeIcebergSplit(
+              dataFilePaths[0]->getPath(), {deleteFile}, wideFieldIds_))
+          .copyResults(pool()),
+      "Equality field id 5 of delete file");
+}
+
 TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
   folly::SingletonVault::singleton()->registrationComplete();
   constexpr int32_t splitCount = 50;
@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <hdfs/hdfs.h>
 #include <mutex>
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/core/Config.h"
@@ -25,11 +27,20 @@ std::string_view HdfsFileSystem::kScheme("hdfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
+    connector::hive::HiveConfig hiveConfig(
+        std::make_shared<core::MemConfig>(config->values()));
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    if (hiveConfig.hdfsShortCircuitRead()) {
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+      const auto socketPath = hiveConfig.hdfsDomainSocketPath();
+      if (!socketPath.empty()) {
+        hdfsBuilderConfSetStr(
+            builder, "dfs.domain.socket.path", socketPath.c_str());
+      }
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     hdfsFreeBuilder(builder);
     VELOX_CHECK_NOT_NULL(
@@ -37,9 +48,24 @@ class HdfsFileSystem::Impl {
         "Unable to connect to HDFS: {}, got error: {}.",
         endpoint.identity(),
         hdfsGetLastError())
+
+    const auto hedgedReadThreads = hiveConfig.hdfsHedgedReadThreads();
+    VELOX_USER_CHECK_GE(
+        hedgedReadThreads,
+        0,
+        "Invalid configuration: 'hive.hdfs.hedged-read-threads' value {} is "
+        "< 0.",
+        hedgedReadThreads);
+    if (hedgedReadThreads > 0) {
+      hedgedReadExecutor_ =
+          std::make_unique<folly::IOThreadPoolExecutor>(hedgedReadThreads);
+      hedgedReadThresholdMs_ = hiveConfig.hdfsHedgedReadThresholdMs();
+    }
   }
 
   ~Impl() {
+    // Joins the reads in progress before the client goes away.
+    hedgedReadExecutor_.reset();
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = hdfsDisconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -52,8 +78,19 @@ class HdfsFileSystem::Impl {
     return hdfsClient_;
   }
 
+  // Returns the executor for hedged reads, nullptr if reads are not hedged.
+  folly::Executor* hedgedReadExecutor() const {
+    return hedgedReadExecutor_.get();
+  }
+
+  uint64_t hedgedReadThresholdMs() const {
+    return hedgedReadThresholdMs_;
+  }
+
  private:
   hdfsFS hdfsClient_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> hedgedReadExecutor_;
+  uint64_t hedgedReadThresholdMs_{0};
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -77,7 +114,11 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(),
+      path,
+      impl_->hedgedReadExecutor(),
+      impl_->hedgedReadThresholdMs());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
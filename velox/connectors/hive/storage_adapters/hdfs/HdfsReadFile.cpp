@@ -15,13 +15,48 @@
  */
 
 #include "HdfsReadFile.h"
+#include <folly/futures/Future.h>
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include "velox/common/base/RuntimeMetrics.h"
 
 namespace facebook::velox {
 
-HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
-    : hdfsClient_(hdfs), filePath_(path) {
+namespace {
+
+// Reads 'length' bytes at 'offset' of 'path' into 'pos' through the calling
+// thread's handle in 'files'.
+void readRange(
+    hdfsFS client,
+    const std::string& path,
+    folly::ThreadLocal<HdfsFile>& files,
+    uint64_t offset,
+    uint64_t length,
+    char* pos) {
+  if (!files->handle_) {
+    files->open(client, path);
+  }
+  files->seek(offset);
+  uint64_t totalBytesRead = 0;
+  while (totalBytesRead < length) {
+    auto bytesRead = files->read(pos, length - totalBytesRead);
+    totalBytesRead += bytesRead;
+    pos += bytesRead;
+  }
+}
+
+} // namespace
+
+HdfsReadFile::HdfsReadFile(
+    hdfsFS hdfs,
+    const std::string_view path,
+    folly::Executor* hedgedReadExecutor,
+    uint64_t hedgedReadThresholdMs)
+    : hdfsClient_(hdfs),
+      filePath_(path),
+      file_(std::make_shared<folly::ThreadLocal<HdfsFile>>()),
+      hedgedReadExecutor_(hedgedReadExecutor),
+      hedgedReadThresholdMs_(hedgedReadThresholdMs) {
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
   if (fileInfo_ == nullptr) {
     auto error = hdfsGetLastError();
@@ -44,16 +79,38 @@ HdfsReadFile::~HdfsReadFile() {
 void HdfsReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   checkFileReadParameters(offset, length);
-  if (!file_->handle_) {
-    file_->open(hdfsClient_, filePath_);
+  if (hedgedReadExecutor_ != nullptr) {
+    hedgedRead(offset, length, pos);
+    return;
   }
-  file_->seek(offset);
-  uint64_t totalBytesRead = 0;
-  while (totalBytesRead < length) {
-    auto bytesRead = file_->read(pos, length - totalBytesRead);
-    totalBytesRead += bytesRead;
-    pos += bytesRead;
+  readRange(hdfsClient_, filePath_, *file_, offset, length, pos);
+}
+
+void HdfsReadFile::hedgedRead(uint64_t offset, uint64_t length, char* pos)
+    const {
+  // A read that loses the race may finish after this returns, so each read
+  // fills its own buffer and uses a handle of its executor thread.
+  auto read = [client = hdfsClient_,
+               path = filePath_,
+               files = file_,
+               offset,
+               length]() {
+    std::string buffer(length, 0);
+    readRange(client, path, *files, offset, length, buffer.data());
+    return buffer;
+  };
+  std::vector<folly::Future<std::string>> reads;
+  reads.push_back(folly::via(hedgedReadExecutor_, read));
+  reads.back().wait(std::chrono::milliseconds(hedgedReadThresholdMs_));
+  if (!reads.back().isReady()) {
+    // The second read opens its own stream, which libhdfs3 may serve from
+    // another replica.
+    reads.push_back(folly::via(hedgedReadExecutor_, read));
+    addThreadLocalRuntimeStat("hdfsHedgedReads", RuntimeCounter(1));
   }
+  auto buffer =
+      folly::collectAnyWithoutException(std::move(reads)).get().second;
+  std::memcpy(pos, buffer.data(), length);
 }
 
 std::string_view
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
 #include <hdfs/hdfs.h>
 #include "velox/common/file/File.h"
 
@@ -60,7 +61,14 @@ struct HdfsFile {
  */
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  /// If 'hedgedReadExecutor' is set, reads run on it and a read that takes
+  /// longer than 'hedgedReadThresholdMs' is hedged by a second read of the
+  /// same range. The first to finish is returned.
+  explicit HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      folly::Executor* hedgedReadExecutor = nullptr,
+      uint64_t hedgedReadThresholdMs = 0);
   ~HdfsReadFile() override;
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -84,12 +92,17 @@ class HdfsReadFile final : public ReadFile {
 
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
+  void hedgedRead(uint64_t offset, uint64_t length, char* pos) const;
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
   hdfsFS hdfsClient_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
-  folly::ThreadLocal<HdfsFile> file_;
+  // Shared with the hedged reads, which may finish after this file is
+  // destroyed.
+  std::shared_ptr<folly::ThreadLocal<HdfsFile>> file_;
+  folly::Executor* const hedgedReadExecutor_;
+  const uint64_t hedgedReadThresholdMs_;
 };
 
 } // namespace facebook::velox
@@ -15,6 +15,7 @@
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include <boost/format.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock-matchers.h>
 #include <hdfs/hdfs.h>
 #include <atomic>
@@ -177,6 +178,17 @@ TEST_F(HdfsFileSystemTest, read) {
   readData(&readFile);
 }
 
+TEST_F(HdfsFileSystemTest, hedgedRead) {
+  struct hdfsBuilder* builder = hdfsNewBuilder();
+  hdfsBuilderSetNameNode(builder, localhost.c_str());
+  hdfsBuilderSetNameNodePort(builder, 7878);
+  auto hdfs = hdfsBuilderConnect(builder);
+  folly::CPUThreadPoolExecutor executor(2);
+  // With a threshold of 0 most reads are hedged.
+  HdfsReadFile readFile(hdfs, destinationPath, &executor, 0);
+  readData(&readFile);
+}
+
 TEST_F(HdfsFileSystemTest, viaFileSystem) {
   auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
   auto hdfsFileSystem =
@@ -24,7 +24,10 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -74,8 +77,14 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
 
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  // If 'executor' is set, reads larger than 'partSize' are split into ranged
+  // GETs of 'partSize' that run in parallel on 'executor'.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor = nullptr,
+      uint64_t partSize = 0)
+      : client_(client), executor_(executor), partSize_(partSize) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -169,6 +178,38 @@ class S3ReadFile final : public ReadFile {
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    if (executor_ == nullptr || partSize_ == 0 || length <= partSize_) {
+      getRange(offset, length, position);
+      return;
+    }
+    // A single GET stream is limited to about 100MB/s. The parts after the
+    // first are read on 'executor_' and the first on this thread.
+    std::vector<folly::SemiFuture<folly::Unit>> parts;
+    for (uint64_t partOffset = partSize_; partOffset < length;
+         partOffset += partSize_) {
+      const auto partLength = std::min(partSize_, length - partOffset);
+      auto part = [this, partOffset, partLength, offset, position]() {
+        getRange(offset + partOffset, partLength, position + partOffset);
+      };
+      parts.push_back(folly::via(executor_, std::move(part)).semi());
+    }
+    std::exception_ptr error;
+    try {
+      getRange(offset, partSize_, position);
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+    // The parts write into 'position', so wait for all before returning.
+    auto results = folly::collectAll(std::move(parts)).get();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    for (auto& result : results) {
+      result.throwUnlessValue();
+    }
+  }
+
+  void getRange(uint64_t offset, uint64_t length, char* position) const {
     // Read the desired range of bytes.
     Aws::S3::Model::GetObjectRequest request;
     Aws::S3::Model::GetObjectResult result;
@@ -185,6 +226,8 @@ class S3ReadFile final : public ReadFile {
   }
 
   Aws::S3::S3Client* client_;
+  folly::Executor* const executor_;
+  const uint64_t partSize_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -222,8 +265,13 @@ class S3WriteFile::Impl {
   explicit Impl(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      folly::Executor* executor,
+      int32_t maxInFlightParts)
+      : client_(client),
+        pool_(pool),
+        executor_(executor),
+        maxInFlightParts_(std::max<int32_t>(1, maxInFlightParts)) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
     getBucketAndKeyFromS3Path(path, bucket_, key_);
@@ -273,6 +321,14 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The pending uploads reference 'this'. Errors are dropped since the file
+    // is not completed without close().
+    for (auto& pending : pendingParts_) {
+      pending.wait();
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
@@ -298,7 +354,7 @@ class S3WriteFile::Impl {
     if (closed()) {
       return;
     }
-    uploadPart({currentPart_->data(), currentPart_->size()}, true);
+    flushCurrentPart(true);
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
     {
@@ -352,11 +408,18 @@ class S3WriteFile::Impl {
     // Fill-up the remaining currentPart_.
     auto remainingBufferSize = currentPart_->capacity() - currentPart_->size();
     currentPart_->unsafeAppend(dataPtr, remainingBufferSize);
-    uploadPart({currentPart_->data(), currentPart_->size()});
+    flushCurrentPart();
     dataPtr += remainingBufferSize;
     dataSize -= remainingBufferSize;
     while (dataSize > kPartUploadSize) {
-      uploadPart({dataPtr, kPartUploadSize});
+      if (executor_) {
+        // An asynchronous upload outlives 'data', so it gets a copy.
+        currentPart_->unsafeAppend(dataPtr, kPartUploadSize);
+        flushCurrentPart();
+      } else {
+        uploadState_.completedParts.push_back(uploadPart(
+            {dataPtr, kPartUploadSize}, ++uploadState_.partNumber));
+      }
       dataPtr += kPartUploadSize;
       dataSize -= kPartUploadSize;
     }
@@ -364,35 +427,72 @@ class S3WriteFile::Impl {
     currentPart_->unsafeAppend(0, dataPtr, dataSize);
   }
 
-  void uploadPart(const std::string_view part, bool isLast = false) {
+  // Uploads the content of currentPart_. With an executor, the buffer is
+  // handed to an asynchronous upload and currentPart_ gets a new one from
+  // 'pool_'. The last part is uploaded inline while the pending ones finish.
+  void flushCurrentPart(bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
-    VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
-    {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
-
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      uploadState_.completedParts.push_back(std::move(part));
+    VELOX_CHECK(isLast || currentPart_->size() == kPartUploadSize);
+    const auto partNumber = ++uploadState_.partNumber;
+    if (executor_ && !isLast) {
+      waitForPendingParts(maxInFlightParts_ - 1);
+      std::shared_ptr<dwio::common::DataBuffer<char>> buffer =
+          std::move(currentPart_);
+      currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+      currentPart_->reserve(kPartUploadSize);
+      pendingParts_.push_back(
+          folly::via(executor_, [this, buffer, partNumber]() {
+            return uploadPart({buffer->data(), buffer->size()}, partNumber);
+          }).semi());
+      return;
+    }
+    auto completedPart =
+        uploadPart({currentPart_->data(), currentPart_->size()}, partNumber);
+    waitForPendingParts(0);
+    uploadState_.completedParts.push_back(std::move(completedPart));
+  }
+
+  // Waits for the oldest pending uploads until at most 'maxPending' remain.
+  // The parts complete in submission order, so completedParts stays sorted by
+  // part number.
+  void waitForPendingParts(size_t maxPending) {
+    while (pendingParts_.size() > maxPending) {
+      auto pending = std::move(pendingParts_.front());
+      pendingParts_.pop_front();
+      uploadState_.completedParts.push_back(std::move(pending).get());
     }
   }
 
+  // Uploads 'part' as part 'partNumber' and returns its ETag. May run on
+  // 'executor_', so it only reads immutable members.
+  Aws::S3::Model::CompletedPart uploadPart(
+      const std::string_view part,
+      int64_t partNumber) const {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(part.size());
+    request.SetBody(
+        std::make_shared<StringViewStream>(part.data(), part.size()));
+    auto outcome = client_->UploadPart(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
+    // Return ETag and part number for this uploaded part.
+    // This will be needed for upload completion in Close().
+    auto result = outcome.GetResult();
+    Aws::S3::Model::CompletedPart completedPart;
+    completedPart.SetPartNumber(partNumber);
+    completedPart.SetETag(result.GetETag());
+    return completedPart;
+  }
+
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  folly::Executor* const executor_;
+  const int32_t maxInFlightParts_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
+  std::deque<folly::SemiFuture<Aws::S3::Model::CompletedPart>> pendingParts_;
   std::string bucket_;
   std::string key_;
   size_t fileSize_ = -1;
@@ -401,8 +501,11 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     const std::string& path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    folly::Executor* executor,
+    int32_t maxInFlightParts) {
+  impl_ = std::make_shared<Impl>(
+      path, client, pool, executor, maxInFlightParts);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -575,10 +678,34 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         hiveConfig_->s3UseVirtualAddressing());
+
+    const auto readParallelism = hiveConfig_->s3ReadParallelism();
+    VELOX_USER_CHECK_GE(
+        readParallelism,
+        0,
+        "Invalid configuration: 'hive.s3.read-parallelism' value {} is < 0.",
+        readParallelism);
+    if (readParallelism > 0) {
+      readExecutor_ =
+          std::make_unique<folly::IOThreadPoolExecutor>(readParallelism);
+    }
+    const auto uploadParallelism = hiveConfig_->s3UploadParallelism();
+    VELOX_USER_CHECK_GE(
+        uploadParallelism,
+        0,
+        "Invalid configuration: 'hive.s3.upload-parallelism' value {} is < 0.",
+        uploadParallelism);
+    if (uploadParallelism > 0) {
+      uploadExecutor_ =
+          std::make_unique<folly::IOThreadPoolExecutor>(uploadParallelism);
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    // Joins the reads and uploads in progress before the client goes away.
+    readExecutor_.reset();
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -709,9 +836,31 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Returns the executor for the parts of large reads, nullptr if reads are
+  // not split.
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
+  uint64_t readPartSize() const {
+    return hiveConfig_->s3ReadPartSize();
+  }
+
+  // Returns the executor for asynchronous part uploads, nullptr if parts are
+  // uploaded from the writer's thread.
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  int32_t uploadParallelism() const {
+    return hiveConfig_->s3UploadParallelism();
+  }
+
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> readExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -727,7 +876,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file, impl_->s3Client(), impl_->readExecutor(), impl_->readPartSize());
   s3file->initialize(options);
   return s3file;
 }
@@ -736,8 +886,12 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(file, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      file,
+      impl_->s3Client(),
+      options.pool,
+      impl_->uploadExecutor(),
+      impl_->uploadParallelism());
   return s3file;
 }
 
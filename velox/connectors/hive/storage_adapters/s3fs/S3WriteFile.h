@@ -19,6 +19,10 @@
 #include "velox/common/file/File.h"
 #include "velox/common/memory/MemoryPool.h"
 
+namespace folly {
+class Executor;
+}
+
 namespace Aws::S3 {
 class S3Client;
 }
@@ -42,15 +46,18 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// If an executor is given, parts are uploaded asynchronously on it with at
+/// most 'maxInFlightParts' uploads pending. Each pending part holds its own
+/// buffer from 'pool'. Otherwise UploadPart is synchronous during append.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr,
+      int32_t maxInFlightParts = 0);
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
@@ -59,13 +66,13 @@ class S3WriteFile : public WriteFile {
   /// No-op. Append handles the flush.
   void flush() override;
 
-  /// Close the file. Any cleanup (disk flush, etc.) will be done here.
+  /// Close the file. Waits for the pending parts and completes the upload.
   void close() override;
 
   /// Current file size, i.e. the sum of all previous Appends.
   uint64_t size() const override;
 
-  /// Return the number of parts uploaded so far.
+  /// Return the number of parts uploaded or submitted for upload so far.
   int numPartsUploaded() const;
 
  protected:
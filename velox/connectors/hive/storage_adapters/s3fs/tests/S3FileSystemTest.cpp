@@ -60,6 +60,24 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, writeAndReadInParallelParts) {
+  const char* bucketName = "parts";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // The 1MB reads are split into 16 parts read by 4 threads.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-part-size", "64kB"}, {"hive.s3.read-parallelism", "4"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  readData(readFile.get());
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
@@ -254,6 +272,43 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, writeFileWithParallelUpload) {
+  const auto bucketName = "paralleluploads";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+
+  auto hiveConfig =
+      minioServer_->hiveConfig({{"hive.s3.upload-parallelism", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto writeFile =
+      s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // 4 appends of 11'000'000 bytes, each filled with its index, give 44MB or 4
+  // full 10MiB parts submitted before close() and a last one.
+  constexpr int32_t kChunkSize = 11'000'000;
+  std::string chunk(kChunkSize, 0);
+  for (int i = 0; i < 4; ++i) {
+    std::fill(chunk.begin(), chunk.end(), 'a' + i);
+    writeFile->append(chunk);
+  }
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 4);
+  EXPECT_EQ(writeFile->size(), 4 * kChunkSize);
+  writeFile->close();
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 5);
+
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->size(), 4 * kChunkSize);
+  for (int i = 0; i < 4; ++i) {
+    const auto offset = static_cast<uint64_t>(i) * kChunkSize;
+    ASSERT_EQ(readFile->pread(offset, 10), std::string(10, 'a' + i));
+    ASSERT_EQ(
+        readFile->pread(offset + kChunkSize - 10, 10),
+        std::string(10, 'a' + i));
+  }
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
@@ -30,6 +30,7 @@ TEST(HiveConfigTest, defaultConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kError);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(emptySession.get()), 100);
+  ASSERT_EQ(hiveConfig.maxOpenFileWriters(emptySession.get()), 0);
   ASSERT_EQ(hiveConfig.immutablePartitions(), false);
   ASSERT_EQ(hiveConfig.s3UseVirtualAddressing(), true);
   ASSERT_EQ(hiveConfig.s3GetLogLevel(), "FATAL");
@@ -40,6 +41,13 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(hiveConfig.s3SecretKey(), std::nullopt);
   ASSERT_EQ(hiveConfig.s3IAMRole(), std::nullopt);
   ASSERT_EQ(hiveConfig.s3IAMRoleSessionName(), "velox-session");
+  ASSERT_EQ(hiveConfig.s3ReadPartSize(), 8 << 20);
+  ASSERT_EQ(hiveConfig.s3ReadParallelism(), 0);
+  ASSERT_EQ(hiveConfig.s3UploadParallelism(), 0);
+  ASSERT_EQ(hiveConfig.hdfsShortCircuitRead(), false);
+  ASSERT_EQ(hiveConfig.hdfsDomainSocketPath(), "");
+  ASSERT_EQ(hiveConfig.hdfsHedgedReadThreads(), 0);
+  ASSERT_EQ(hiveConfig.hdfsHedgedReadThresholdMs(), 500);
   ASSERT_EQ(hiveConfig.gcsEndpoint(), "");
   ASSERT_EQ(hiveConfig.gcsScheme(), "https");
   ASSERT_EQ(hiveConfig.gcsCredentials(), "");
@@ -49,8 +57,12 @@ TEST(HiveConfigTest, defaultConfig) {
 
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_EQ(hiveConfig.isAdaptiveCoalesce(), false);
+  ASSERT_EQ(hiveConfig.decodingParallelismFactor(), 0);
+  ASSERT_EQ(hiveConfig.pageReadAhead(), 0);
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig.isFileHandleCacheEnabled(), true);
+  ASSERT_EQ(hiveConfig.fileMetadataCacheSize(), 0);
   ASSERT_EQ(
       hiveConfig.orcWriterMaxStripeSize(emptySession.get()),
       64L * 1024L * 1024L);
@@ -60,6 +72,7 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(emptySession.get()), 1024);
   ASSERT_EQ(
       hiveConfig.sortWriterMaxOutputBytes(emptySession.get()), 10UL << 20);
+  ASSERT_EQ(hiveConfig.sortWriterMaxBufferedBytes(emptySession.get()), 0);
   ASSERT_EQ(hiveConfig.isPartitionPathAsLowerCase(emptySession.get()), true);
   ASSERT_EQ(hiveConfig.orcWriterMinCompressionSize(emptySession.get()), 1024);
   ASSERT_EQ(
@@ -83,6 +96,13 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kS3AwsSecretKey, "hello"},
       {HiveConfig::kS3IamRole, "hello"},
       {HiveConfig::kS3IamRoleSessionName, "velox"},
+      {HiveConfig::kS3ReadPartSize, "16MB"},
+      {HiveConfig::kS3ReadParallelism, "8"},
+      {HiveConfig::kS3UploadParallelism, "4"},
+      {HiveConfig::kHdfsShortCircuitRead, "true"},
+      {HiveConfig::kHdfsDomainSocketPath, "/var/run/dn_socket"},
+      {HiveConfig::kHdfsHedgedReadThreads, "4"},
+      {HiveConfig::kHdfsHedgedReadThresholdMs, "100"},
       {HiveConfig::kGCSEndpoint, "hey"},
       {HiveConfig::kGCSScheme, "http"},
       {HiveConfig::kGCSCredentials, "hey"},
@@ -90,12 +110,17 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kFileColumnNamesReadAsLowerCase, "true"},
       {HiveConfig::kMaxCoalescedBytes, "100"},
       {HiveConfig::kMaxCoalescedDistanceBytes, "100"},
+      {HiveConfig::kAdaptiveCoalesce, "true"},
+      {HiveConfig::kDecodingParallelismFactor, "4"},
+      {HiveConfig::kPageReadAhead, "3"},
       {HiveConfig::kNumCacheFileHandles, "100"},
       {HiveConfig::kEnableFileHandleCache, "false"},
+      {HiveConfig::kFileMetadataCacheSize, "64MB"},
       {HiveConfig::kOrcWriterMaxStripeSize, "100MB"},
       {HiveConfig::kOrcWriterMaxDictionaryMemory, "100MB"},
       {HiveConfig::kSortWriterMaxOutputRows, "100"},
       {HiveConfig::kSortWriterMaxOutputBytes, "100MB"},
+      {HiveConfig::kSortWriterMaxBufferedBytes, "1GB"},
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristics, "false"},
       {HiveConfig::kOrcWriterMinCompressionSize, "512"},
       {HiveConfig::kOrcWriterCompressionLevel, "1"},
@@ -116,6 +141,13 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_EQ(hiveConfig.s3AccessKey(), std::optional("hello"));
   ASSERT_EQ(hiveConfig.s3SecretKey(), std::optional("hello"));
   ASSERT_EQ(hiveConfig.s3IAMRole(), std::optional("hello"));
+  ASSERT_EQ(hiveConfig.s3ReadPartSize(), 16 << 20);
+  ASSERT_EQ(hiveConfig.s3ReadParallelism(), 8);
+  ASSERT_EQ(hiveConfig.s3UploadParallelism(), 4);
+  ASSERT_EQ(hiveConfig.hdfsShortCircuitRead(), true);
+  ASSERT_EQ(hiveConfig.hdfsDomainSocketPath(), "/var/run/dn_socket");
+  ASSERT_EQ(hiveConfig.hdfsHedgedReadThreads(), 4);
+  ASSERT_EQ(hiveConfig.hdfsHedgedReadThresholdMs(), 100);
   ASSERT_EQ(hiveConfig.s3IAMRoleSessionName(), "velox");
   ASSERT_EQ(hiveConfig.gcsEndpoint(), "hey");
   ASSERT_EQ(hiveConfig.gcsScheme(), "http");
@@ -125,8 +157,12 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig.isFileColumnNamesReadAsLowerCase(emptySession.get()), true);
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(), 100);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(), 100);
+  ASSERT_EQ(hiveConfig.isAdaptiveCoalesce(), true);
+  ASSERT_EQ(hiveConfig.decodingParallelismFactor(), 4);
+  ASSERT_EQ(hiveConfig.pageReadAhead(), 3);
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 100);
   ASSERT_EQ(hiveConfig.isFileHandleCacheEnabled(), false);
+  ASSERT_EQ(hiveConfig.fileMetadataCacheSize(), 64 << 20);
   ASSERT_EQ(
       hiveConfig.orcWriterMaxStripeSize(emptySession.get()),
       100L * 1024L * 1024L);
@@ -136,6 +172,8 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(emptySession.get()), 100);
   ASSERT_EQ(
       hiveConfig.sortWriterMaxOutputBytes(emptySession.get()), 100UL << 20);
+  ASSERT_EQ(
+      hiveConfig.sortWriterMaxBufferedBytes(emptySession.get()), 1UL << 30);
   ASSERT_EQ(hiveConfig.orcWriterMinCompressionSize(emptySession.get()), 512);
   ASSERT_EQ(hiveConfig.orcWriterCompressionLevel(emptySession.get()), 1);
   ASSERT_EQ(
@@ -154,18 +192,21 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kOrcWriterMaxDictionaryMemorySession, "22MB"},
       {HiveConfig::kSortWriterMaxOutputRowsSession, "20"},
       {HiveConfig::kSortWriterMaxOutputBytesSession, "20MB"},
+      {HiveConfig::kSortWriterMaxBufferedBytesSession, "200MB"},
       {HiveConfig::kPartitionPathAsLowerCaseSession, "false"},
       {HiveConfig::kIgnoreMissingFilesSession, "true"},
       {HiveConfig::kOrcWriterMinCompressionSizeSession, "512"},
       {HiveConfig::kOrcWriterCompressionLevelSession, "1"},
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristicsSession, "false"},
-      {HiveConfig::kCacheNoRetentionSession, "true"}};
+      {HiveConfig::kCacheNoRetentionSession, "true"},
+      {HiveConfig::kMaxOpenFileWritersSession, "8"}};
   const auto session = std::make_unique<MemConfig>(sessionOverride);
   ASSERT_EQ(
       hiveConfig.insertExistingPartitionsBehavior(session.get()),
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kOverwrite);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(session.get()), 100);
+  ASSERT_EQ(hiveConfig.maxOpenFileWriters(session.get()), 8);
   ASSERT_EQ(hiveConfig.immutablePartitions(), false);
   ASSERT_EQ(hiveConfig.s3UseVirtualAddressing(), true);
   ASSERT_EQ(hiveConfig.s3GetLogLevel(), "FATAL");
@@ -193,6 +234,7 @@ TEST(HiveConfigTest, overrideSession) {
       22L * 1024L * 1024L);
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(session.get()), 20);
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputBytes(session.get()), 20UL << 20);
+  ASSERT_EQ(hiveConfig.sortWriterMaxBufferedBytes(session.get()), 200UL << 20);
   ASSERT_EQ(hiveConfig.isPartitionPathAsLowerCase(session.get()), false);
   ASSERT_EQ(hiveConfig.ignoreMissingFiles(session.get()), true);
   ASSERT_EQ(
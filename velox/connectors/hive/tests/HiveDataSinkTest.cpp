@@ -18,6 +18,7 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -513,6 +514,75 @@ TEST_F(HiveDataSinkTest, basic) {
   verifyWrittenData(outputDirectory->getPath());
 }
 
+TEST_F(HiveDataSinkTest, columnStatistics) {
+  const auto outputDirectory = TempDirectoryPath::create();
+  auto dataSink = createDataSink(rowType_, outputDirectory->getPath());
+  const int numBatches = 4;
+  auto vectors = createVectors(500, numBatches);
+  for (auto& vector : vectors) {
+    vector->childAt(0) = makeFlatVector<int64_t>(
+        vector->size(), [](auto row) { return row; }, nullEvery(10, 1));
+    dataSink->appendData(vector);
+  }
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), 1);
+
+  const auto update = folly::parseJson(partitions[0]);
+  const auto& columns = update["fileWriteInfos"][0]["columnStatistics"];
+  ASSERT_EQ(columns.size(), rowType_->size());
+  for (auto i = 0; i < rowType_->size(); ++i) {
+    ASSERT_EQ(columns[i]["name"].asString(), rowType_->nameOf(i));
+  }
+  ASSERT_EQ(columns[0]["nullCount"].asInt(), 50 * numBatches);
+  ASSERT_EQ(columns[0]["min"].asInt(), 0);
+  ASSERT_EQ(columns[0]["max"].asInt(), 499);
+}
+
+TEST_F(HiveDataSinkTest, maxOpenFileWriters) {
+  constexpr int32_t kNumPartitions = 5;
+  const int numBatches = 4;
+  auto vectors = createVectors(500, numBatches);
+  // Every batch has rows of all partitions.
+  for (auto& vector : vectors) {
+    vector->childAt(1) = makeFlatVector<int32_t>(
+        vector->size(), [](auto row) { return row % kNumPartitions; });
+  }
+
+  for (const uint32_t maxOpenFileWriters : {0, 2}) {
+    SCOPED_TRACE(fmt::format("maxOpenFileWriters: {}", maxOpenFileWriters));
+    connectorSessionProperties_ = std::make_shared<core::MemConfig>(
+        std::unordered_map<std::string, std::string>{
+            {HiveConfig::kMaxOpenFileWritersSession,
+             std::to_string(maxOpenFileWriters)}});
+    setupMemoryPools();
+
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {"c1"});
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    const auto partitions = dataSink->close();
+
+    // With 2 open files for 5 partitions, each batch writes every partition
+    // to a new file.
+    const auto numFiles = maxOpenFileWriters == 0
+        ? kNumPartitions
+        : kNumPartitions * numBatches;
+    ASSERT_EQ(partitions.size(), numFiles);
+    ASSERT_EQ(dataSink->stats().numWrittenFiles, numFiles);
+    ASSERT_EQ(listFiles(outputDirectory->getPath()).size(), numFiles);
+    int64_t numRows = 0;
+    for (const auto& partition : partitions) {
+      numRows += folly::parseJson(partition)["rowCount"].asInt();
+    }
+    ASSERT_EQ(numRows, 500 * numBatches);
+  }
+}
+
 TEST_F(HiveDataSinkTest, basicBucket) {
   const auto outputDirectory = TempDirectoryPath::create();
 
@@ -52,6 +52,29 @@ RowVectorPtr getTpchData(
 
 } // namespace
 
+TpchDataCache::TpchDataCache(uint64_t maxBytes)
+    : pool_(memory::memoryManager()->addLeafPool("tpchDataCache")),
+      cache_(maxBytes) {}
+
+RowVectorPtr TpchDataCache::get(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* data = cache_.get(key);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  auto copy = *data;
+  cache_.release(key);
+  return copy;
+}
+
+void TpchDataCache::put(const std::string& key, const RowVectorPtr& data) {
+  auto value = std::make_unique<RowVectorPtr>(data);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, value.get(), key.size() + data->retainedSize())) {
+    value.release();
+  }
+}
+
 std::string TpchTableHandle::toString() const {
   return fmt::format(
       "table: {}, scale factor: {}", toTableName(table_), scaleFactor_);
@@ -63,8 +86,9 @@ TpchDataSource::TpchDataSource(
     const std::unordered_map<
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-    velox::memory::MemoryPool* pool)
-    : pool_(pool) {
+    velox::memory::MemoryPool* pool,
+    TpchDataCache* cache)
+    : pool_(pool), cache_(cache) {
   auto tpchTableHandle =
       std::dynamic_pointer_cast<TpchTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -143,8 +167,7 @@ std::optional<RowVectorPtr> TpchDataSource::next(
       currentSplit_, "No split to process. Call addSplit() first.");
 
   size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = getData(maxRows);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
@@ -162,6 +185,28 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   return projectOutputColumns(outputVector);
 }
 
+RowVectorPtr TpchDataSource::getData(size_t maxRows) {
+  if (cache_ == nullptr) {
+    return getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  }
+  const auto key = fmt::format(
+      "{}:{}:{}:{}",
+      toTableName(tpchTable_),
+      scaleFactor_,
+      splitOffset_,
+      maxRows);
+  if (auto data = cache_->get(key)) {
+    ++numCacheHits_;
+    return data;
+  }
+  auto data = getTpchData(
+      tpchTable_, maxRows, splitOffset_, scaleFactor_, cache_->pool());
+  if (data != nullptr) {
+    cache_->put(key, data);
+  }
+  return data;
+}
+
 VELOX_REGISTER_CONNECTOR_FACTORY(std::make_shared<TpchConnectorFactory>())
 
 } // namespace facebook::velox::connector::tpch
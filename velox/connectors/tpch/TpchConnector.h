@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/tpch/TpchConnectorSplit.h"
 #include "velox/tpch/gen/TpchGen.h"
@@ -67,6 +68,30 @@ class TpchTableHandle : public ConnectorTableHandle {
   double scaleFactor_;
 };
 
+// Keeps generated batches for reuse by later scans of the same table, scale
+// factor and rows, so that repeated benchmark queries over large scale factors
+// are not bound by dbgen. Batches are allocated from a pool owned by the
+// cache, so they outlive the queries that generated them. Thread-safe.
+class TpchDataCache {
+ public:
+  explicit TpchDataCache(uint64_t maxBytes);
+
+  // Returns the batch for 'key' or nullptr if not cached.
+  RowVectorPtr get(const std::string& key);
+
+  void put(const std::string& key, const RowVectorPtr& data);
+
+  // The pool to generate batches in before put().
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+ private:
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  std::mutex mutex_;
+  SimpleLRUCache<std::string, RowVectorPtr> cache_;
+};
+
 class TpchDataSource : public DataSource {
  public:
   TpchDataSource(
@@ -75,7 +100,8 @@ class TpchDataSource : public DataSource {
       const std::unordered_map<
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      TpchDataCache* cache = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -97,13 +123,19 @@ class TpchDataSource : public DataSource {
   }
 
   std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
-    // TODO: Which stats do we want to expose here?
-    return {};
+    if (cache_ == nullptr) {
+      return {};
+    }
+    return {{"numCacheHits", RuntimeCounter(numCacheHits_)}};
   }
 
  private:
   RowVectorPtr projectOutputColumns(RowVectorPtr vector);
 
+  // Returns the batch of at most 'maxRows' rows at 'splitOffset_', from
+  // 'cache_' if possible.
+  RowVectorPtr getData(size_t maxRows);
+
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
   size_t tpchTableRowCount_{0};
@@ -124,15 +156,30 @@ class TpchDataSource : public DataSource {
   size_t completedBytes_{0};
 
   memory::MemoryPool* pool_;
+
+  // Cache of generated batches shared by the data sources of the connector.
+  // nullptr if caching is disabled.
+  TpchDataCache* const cache_;
+  int64_t numCacheHits_{0};
 };
 
 class TpchConnector final : public Connector {
  public:
+  // Bytes of generated batches to keep for reuse by later queries. Caching is
+  // disabled if 0.
+  static constexpr const char* kDataCacheBytes = "data-cache-bytes";
+
   TpchConnector(
       const std::string& id,
       std::shared_ptr<const Config> config,
       folly::Executor* /*executor*/)
-      : Connector(id) {}
+      : Connector(id) {
+    const auto cacheBytes =
+        config ? config->get<uint64_t>(kDataCacheBytes, 0) : 0;
+    if (cacheBytes > 0) {
+      cache_ = std::make_unique<TpchDataCache>(cacheBytes);
+    }
+  }
 
   std::unique_ptr<DataSource> createDataSource(
       const std::shared_ptr<const RowType>& outputType,
@@ -145,7 +192,8 @@ class TpchConnector final : public Connector {
         outputType,
         tableHandle,
         columnHandles,
-        connectorQueryCtx->memoryPool());
+        connectorQueryCtx->memoryPool(),
+        cache_.get());
   }
 
   std::unique_ptr<DataSink> createDataSink(
@@ -156,6 +204,9 @@ class TpchConnector final : public Connector {
       CommitStrategy /*commitStrategy*/) override final {
     VELOX_NYI("TpchConnector does not support data sink.");
   }
+
+ private:
+  std::unique_ptr<TpchDataCache> cache_;
 };
 
 class TpchConnectorFactory : public ConnectorFactory {
@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -286,6 +287,43 @@ TEST_F(TpchConnectorTest, orderDateCount) {
   EXPECT_EQ(9, orderDate->size());
 }
 
+TEST_F(TpchConnectorTest, dataCache) {
+  connector::unregisterConnector(kTpchConnectorId);
+  connector::registerConnector(
+      connector::getConnectorFactory(
+          connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+          ->newConnector(
+              kTpchConnectorId,
+              std::make_shared<core::MemConfig>(
+                  std::unordered_map<std::string, std::string>{
+                      {TpchConnector::kDataCacheBytes, "100000000"}})));
+
+  core::PlanNodeId scanId;
+  auto plan = PlanBuilder()
+                  .tpchTableScan(
+                      Table::TBL_CUSTOMER, {"c_custkey", "c_name"}, 0.01)
+                  .capturePlanNodeId(scanId)
+                  .planNode();
+  auto numCacheHits = [&](const std::shared_ptr<exec::Task>& task) {
+    auto stats = exec::toPlanStats(task->taskStats()).at(scanId).customStats;
+    auto it = stats.find("numCacheHits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+
+  std::shared_ptr<exec::Task> task;
+  auto expected = exec::test::AssertQueryBuilder(plan)
+                      .split(makeTpchSplit())
+                      .copyResults(pool(), task);
+  EXPECT_EQ(numCacheHits(task), 0);
+
+  // The second scan reads the batches generated by the first.
+  auto result = exec::test::AssertQueryBuilder(plan)
+                    .split(makeTpchSplit())
+                    .copyResults(pool(), task);
+  EXPECT_GT(numCacheHits(task), 0);
+  test::assertEqualVectors(expected, result);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -216,4 +216,32 @@ TypedExprPtr CastTypedExpr::create(const folly::dynamic& obj, void* context) {
       std::move(type), std::move(inputs), obj["nullOnFailure"].asBool());
 }
 
+// static
+TypedExprPtr TypedExprs::withInputs(
+    const TypedExprPtr& expr,
+    std::vector<TypedExprPtr>&& inputs) {
+  if (auto call = dynamic_cast<const CallTypedExpr*>(expr.get())) {
+    return std::make_shared<CallTypedExpr>(
+        expr->type(), std::move(inputs), call->name());
+  }
+  if (auto cast = dynamic_cast<const CastTypedExpr*>(expr.get())) {
+    return std::make_shared<CastTypedExpr>(
+        expr->type(), inputs, cast->nullOnFailure());
+  }
+  if (auto access = dynamic_cast<const FieldAccessTypedExpr*>(expr.get())) {
+    return std::make_shared<FieldAccessTypedExpr>(
+        expr->type(), inputs[0], access->name());
+  }
+  if (auto dereference =
+          dynamic_cast<const DereferenceTypedExpr*>(expr.get())) {
+    return std::make_shared<DereferenceTypedExpr>(
+        expr->type(), inputs[0], dereference->index());
+  }
+  if (dynamic_cast<const ConcatTypedExpr*>(expr.get())) {
+    return std::make_shared<ConcatTypedExpr>(
+        expr->type()->asRow().names(), inputs);
+  }
+  return nullptr;
+}
+
 } // namespace facebook::velox::core
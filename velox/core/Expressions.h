@@ -685,5 +685,12 @@ class TypedExprs {
   static LambdaTypedExprPtr asLambda(const TypedExprPtr& expr) {
     return std::dynamic_pointer_cast<const LambdaTypedExpr>(expr);
   }
+
+  /// Returns a copy of 'expr' with 'inputs' instead of the inputs of 'expr'.
+  /// Supports calls, casts, field accesses, dereferences and concats. Returns
+  /// null for other expressions.
+  static TypedExprPtr withInputs(
+      const TypedExprPtr& expr,
+      std::vector<TypedExprPtr>&& inputs);
 };
 } // namespace facebook::velox::core
@@ -224,13 +224,6 @@ void addSortingKeys(
 } // namespace
 
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: Add spilling for aggregations over distinct inputs.
-  // https://github.com/facebookincubator/velox/issues/7454
-  for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
-      return false;
-    }
-  }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
   return (isFinal() || isSingle()) && preGroupedKeys().empty() &&
@@ -1663,8 +1656,38 @@ PlanNodePtr RowNumberNode::create(const folly::dynamic& obj, void* context) {
       source);
 }
 
+// static
+const char* TopNRowNumberNode::rankFunctionName(RankFunction function) {
+  switch (function) {
+    case RankFunction::kRowNumber:
+      return "row_number";
+    case RankFunction::kRank:
+      return "rank";
+    case RankFunction::kDenseRank:
+      return "dense_rank";
+    default:
+      VELOX_UNREACHABLE(
+          "Unknown rank function: {}", static_cast<int>(function));
+  }
+}
+
+// static
+TopNRowNumberNode::RankFunction TopNRowNumberNode::rankFunctionFromName(
+    std::string_view name) {
+  if (name == "row_number") {
+    return RankFunction::kRowNumber;
+  } else if (name == "rank") {
+    return RankFunction::kRank;
+  } else if (name == "dense_rank") {
+    return RankFunction::kDenseRank;
+  } else {
+    VELOX_USER_FAIL("Unknown rank function: {}", name);
+  }
+}
+
 TopNRowNumberNode::TopNRowNumberNode(
     PlanNodeId id,
+    RankFunction function,
     std::vector<FieldAccessTypedExprPtr> partitionKeys,
     std::vector<FieldAccessTypedExprPtr> sortingKeys,
     std::vector<SortOrder> sortingOrders,
@@ -1672,6 +1695,7 @@ TopNRowNumberNode::TopNRowNumberNode(
     int32_t limit,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
+      function_{function},
       partitionKeys_{std::move(partitionKeys)},
       sortingKeys_{std::move(sortingKeys)},
       sortingOrders_{std::move(sortingOrders)},
@@ -1709,6 +1733,10 @@ TopNRowNumberNode::TopNRowNumberNode(
 }
 
 void TopNRowNumberNode::addDetails(std::stringstream& stream) const {
+  if (function_ != RankFunction::kRowNumber) {
+    stream << rankFunctionName(function_) << " ";
+  }
+
   if (!partitionKeys_.empty()) {
     stream << "partition by (";
     addFields(stream, partitionKeys_);
@@ -1724,6 +1752,7 @@ void TopNRowNumberNode::addDetails(std::stringstream& stream) const {
 
 folly::dynamic TopNRowNumberNode::serialize() const {
   auto obj = PlanNode::serialize();
+  obj["function"] = rankFunctionName(function_);
   obj["partitionKeys"] = ISerializable::serialize(partitionKeys_);
   obj["sortingKeys"] = ISerializable::serialize(sortingKeys_);
   obj["sortingOrders"] = serializeSortingOrders(sortingOrders_);
@@ -1749,8 +1778,15 @@ PlanNodePtr TopNRowNumberNode::create(
     rowNumberColumnName = obj["rowNumberColumnName"].asString();
   }
 
+  // Plans serialized before rank and dense_rank support have no 'function'.
+  auto function = RankFunction::kRowNumber;
+  if (obj.count("function")) {
+    function = rankFunctionFromName(obj["function"].asString());
+  }
+
   return std::make_shared<TopNRowNumberNode>(
       deserializePlanNodeId(obj),
+      function,
       partitionKeys,
       sortingKeys,
       sortingOrders,
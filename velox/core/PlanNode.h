@@ -1701,6 +1701,13 @@ class NestedLoopJoinNode : public PlanNode {
     return "NestedLoopJoin";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // NOTE: the spilled build side vectors can't represent a build side without
+    // columns.
+    return sources_[1]->outputType()->size() > 0 &&
+        queryConfig.joinSpillEnabled();
+  }
+
   const TypedExprPtr& joinCondition() const {
     return joinCondition_;
   }
@@ -1825,6 +1832,10 @@ class TopNNode : public PlanNode {
     return "TopN";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.topNSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -2133,9 +2144,11 @@ class WindowNode : public PlanNode {
 
   bool canSpill(const QueryConfig& queryConfig) const override {
     // No partitioning keys means the whole input is one big partition. In this
-    // case, spilling is not helpful because we need to have a full partition in
-    // memory to produce results.
-    return !partitionKeys_.empty() && !inputsSorted_ &&
+    // case, spilling the sorted input is not helpful because we need to have a
+    // full partition in memory to produce results. Sorted input is spilled one
+    // partition at a time and the spilled partitions are read back as they are
+    // processed, which helps with large partitions.
+    return (!partitionKeys_.empty() || inputsSorted_) &&
         queryConfig.windowSpillEnabled();
   }
 
@@ -2286,6 +2299,10 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -2308,18 +2325,32 @@ class MarkDistinctNode : public PlanNode {
 /// 'rowNumberColumnName' BIGINT column.
 class TopNRowNumberNode : public PlanNode {
  public:
+  /// The ranking window function computed by the node.
+  enum class RankFunction {
+    kRowNumber,
+    kRank,
+    kDenseRank,
+  };
+
+  static const char* rankFunctionName(RankFunction function);
+
+  static RankFunction rankFunctionFromName(std::string_view name);
+
+  /// @param function Ranking function to compute. Rows with equal sorting keys
+  /// get the same rank or dense rank, hence may all be returned.
   /// @param partitionKeys Partitioning keys. May be empty.
   /// @param sortingKeys Sorting keys. May not be empty and may not intersect
   /// with 'partitionKeys'.
   /// @param sortingOrders Sorting orders, one per sorting key.
   /// @param rowNumberColumnName Optional name of the column containing row
-  /// numbers. If not specified, the output doesn't include 'row number' column.
-  /// This is used when computing partial results.
-  /// @param limit Per-partition limit. The number of
-  /// rows produced by this node will not exceed this value for any given
-  /// partition. Extra rows will be dropped.
+  /// numbers or ranks. If not specified, the output doesn't include the
+  /// 'row number' column. This is used when computing partial results.
+  /// @param limit Per-partition limit. Rows with row number, rank or dense rank
+  /// above this value are dropped. For rank and dense_rank, the number of rows
+  /// produced for a partition may exceed 'limit' when there are ties.
   TopNRowNumberNode(
       PlanNodeId id,
+      RankFunction function,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
       std::vector<FieldAccessTypedExprPtr> sortingKeys,
       std::vector<SortOrder> sortingOrders,
@@ -2355,6 +2386,10 @@ class TopNRowNumberNode : public PlanNode {
     return sortingOrders_;
   }
 
+  RankFunction rankFunction() const {
+    return function_;
+  }
+
   int32_t limit() const {
     return limit_;
   }
@@ -2374,6 +2409,8 @@ class TopNRowNumberNode : public PlanNode {
  private:
   void addDetails(std::stringstream& stream) const override;
 
+  const RankFunction function_;
+
   const std::vector<FieldAccessTypedExprPtr> partitionKeys_;
 
   const std::vector<FieldAccessTypedExprPtr> sortingKeys_;
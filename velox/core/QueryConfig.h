@@ -73,6 +73,11 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// Priority of the query memory pool in memory arbitration. Lower priority
+  /// queries are reclaimed from and aborted first. See
+  /// memory::MemoryPool::priority().
+  static constexpr const char* kQueryMemoryPriority = "query_memory_priority";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -101,11 +106,60 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to evaluate trees of arithmetic and comparison functions on
+  /// fixed-width numeric values in a single pass with fused kernels instead
+  /// of function by function. False by default.
+  static constexpr const char* kExprFuseKernels = "expression.fuse_kernels";
+
+  /// Whether to evaluate deterministic subtrees of lambda bodies that do not
+  /// depend on the lambda parameters once per top-level row instead of once
+  /// per array or map element. False by default.
+  static constexpr const char* kExprHoistLambdaInvariants =
+      "expression.hoist_lambda_invariants";
+
+  /// Whether to evaluate deterministic functions over a flat string input once
+  /// per distinct input value when a batch has few distinct values. False by
+  /// default.
+  static constexpr const char* kExprCacheDistinctInputs =
+      "expression.cache_distinct_inputs";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to read the hardware performance counters of the driver thread
+  /// around getOutput(), addInput() and noMoreInput() of each operator and
+  /// report them as runtime stats. False by default. Needs perf_event_open
+  /// to be allowed for the process, otherwise nothing is reported.
+  static constexpr const char* kOperatorTrackHardwareCounters =
+      "track_operator_hardware_counters";
+
+  /// The interval in milliseconds at which the drivers sample the memory
+  /// usage of their operators into OperatorStats::memoryTimeline. 0 disables
+  /// the sampling.
+  static constexpr const char* kMemoryTimelineSampleIntervalMs =
+      "memory_timeline_sample_interval_ms";
+
+  /// The max number of memory usage samples kept per operator. The oldest
+  /// samples are dropped first.
+  static constexpr const char* kMemoryTimelineMaxSamples =
+      "memory_timeline_max_samples";
+
+  /// The id of a plan node whose operators save their input batches and the
+  /// plan node under operator_capture_dir for offline replay. Empty, the
+  /// default, disables the capture.
+  static constexpr const char* kOperatorCaptureNodeId =
+      "operator_capture_node_id";
+
+  /// The directory for the files of operator_capture_node_id.
+  static constexpr const char* kOperatorCaptureDir = "operator_capture_dir";
+
+  /// The max number of input batches saved per driver by
+  /// operator_capture_node_id.
+  static constexpr const char* kOperatorCaptureMaxBatches =
+      "operator_capture_max_batches";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -120,39 +174,150 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// If true, a hash partitioning LocalPartition reorders the rows of each
+  /// input by partition into one flat copy and sends each consumer a slice of
+  /// it, instead of wrapping the input in a dictionary per partition.
+  static constexpr const char* kLocalPartitionFlatOutput =
+      "local_partition_flat_output";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// If true, the exchange client sizes each data request by the
+  /// bandwidth-delay product measured for its source on top of the bytes the
+  /// source reported as ready. The pages produced while the request is in
+  /// flight then come with its response instead of taking another round trip.
+  static constexpr const char* kExchangeBdpRequestSizing =
+      "exchange.bdp_request_sizing";
+
   /// Maximum size in bytes to accumulate among all sources of the merge
   /// exchange. Enforced approximately, not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
+  /// If true, each source of a merge exchange decodes the pages it receives
+  /// on the query executor instead of the driver thread, so that the merge
+  /// only compares and copies rows while the next pages are decoded.
+  static constexpr const char* kMergeExchangeParallelDecode =
+      "merge_exchange.parallel_decode";
+
+  /// The number of batches each source of a merge, i.e. LocalMerge or
+  /// MergeExchange, fetches ahead of the batch being merged. The batches are
+  /// fetched without blocking, so that a source that is slow to produce
+  /// doesn't stall the merge once it has produced them.
+  static constexpr const char* kMergeSourceReadAheadBatches =
+      "merge.source_read_ahead_batches";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
   static constexpr const char* kMaxExtendedPartialAggregationMemory =
       "max_extended_partial_aggregation_memory";
 
+  /// If non-zero, a partial aggregation starts with a cache-resident hash
+  /// table of at most this many bytes, which is flushed when full instead of
+  /// growing to 'max_partial_aggregation_memory'.
+  static constexpr const char* kPartialAggregationCacheTableMemory =
+      "partial_aggregation_cache_table_memory";
+
+  /// Min percentage of input rows which hit an existing group of the
+  /// cache-resident partial aggregation table to keep using it. If the hit rate
+  /// of a flushed table is below this, the partial aggregation switches to the
+  /// regular table sized by 'max_partial_aggregation_memory'.
+  static constexpr const char* kPartialAggregationCacheTableMinHitPct =
+      "partial_aggregation_cache_table_min_hit_pct";
+
   static constexpr const char* kAbandonPartialAggregationMinRows =
       "abandon_partial_aggregation_min_rows";
 
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If true, the drivers of a final aggregation which is not preceded by a
+  /// local exchange merge their grouping sets with each other after all their
+  /// input is consumed. Each driver produces the groups from a disjoint subset
+  /// of the key hash space.
+  static constexpr const char* kFinalAggregationMergeAcrossDrivers =
+      "final_aggregation_merge_across_drivers";
+
+  /// If true, the drivers of an OrderBy agree on splitter keys sampled from
+  /// their sorted rows once all their input is consumed. Each driver then
+  /// merges and produces one key range from the sorted rows of all the
+  /// drivers, so that the output of driver i is the i-th ordered range.
+  static constexpr const char* kOrderByRangePartitionAcrossDrivers =
+      "order_by_range_partition_across_drivers";
+
+  /// If true, the drivers of a Window that sorts its input merge their sorted
+  /// rows once all their input is consumed, so that each window partition is
+  /// complete, and split the partitions between them. This lets a Window run
+  /// on multiple drivers without a LocalPartition on the partition keys.
+  static constexpr const char* kWindowPartitionAcrossDrivers =
+      "window_partition_across_drivers";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
   static constexpr const char* kAbandonPartialTopNRowNumberMinPct =
       "abandon_partial_topn_row_number_min_pct";
 
+  /// Compacts the variable width data of the rows kept by TopNRowNumber once
+  /// the replaced rows left at least this percentage of it free. 0 disables
+  /// the compaction.
+  static constexpr const char* kCompactVariableWidthDataPct =
+      "compact_variable_width_data_pct";
+
+  /// Dictionary encodes the string columns of the build side vectors kept in
+  /// memory by NestedLoopJoinBuild if at most this percentage of the values
+  /// of a column are distinct. 0 disables the encoding.
+  static constexpr const char* kNestedLoopJoinBuildDictionaryStringsPct =
+      "nested_loop_join_build_dictionary_strings_pct";
+
+  /// If a filter passes at most this percentage of the rows of an input of
+  /// at least 1000 rows, FilterProject copies the passing rows into flat
+  /// vectors instead of wrapping the input in dictionaries, so that the input
+  /// buffers are freed early. 0 disables the copy.
+  static constexpr const char* kFilterFlattenSelectivityPct =
+      "filter_flatten_selectivity_pct";
+
+  /// If less than this percentage of the string buffers of a vector held by
+  /// Values is referenced, the referenced strings are copied into one dense
+  /// buffer and the other buffers are released. 0 disables the compaction.
+  static constexpr const char* kMinLiveStringBufferPct =
+      "min_live_string_buffer_pct";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// If true and the task has a spill directory, a full partitioned output
+  /// buffer writes the pages its consumers have not fetched yet to local
+  /// files instead of blocking the producers. The pages are read back when
+  /// fetched. Lets the producers keep running when one consumer is slow.
+  static constexpr const char* kOutputBufferSpillEnabled =
+      "output_buffer_spill_enabled";
+
+  /// Name of the vector serde, registered with registerNamedVectorSerde(),
+  /// used to serialize the pages of PartitionedOutput and to deserialize them
+  /// in Exchange and MergeExchange. The producer and consumer tasks must use
+  /// the same serde. Empty uses the default serde.
+  static constexpr const char* kShuffleSerde = "shuffle_serde";
+
+  /// If true, PartitionedOutput keeps constant and dictionary encoded columns
+  /// as RLE and DICTIONARY columns in the pages it serializes with the Presto
+  /// serde instead of flattening them.
+  static constexpr const char* kShufflePreserveEncodings =
+      "shuffle_preserve_encodings";
+
+  /// If true and shuffle compression is enabled, PartitionedOutput compresses
+  /// its pages only after its output buffer was full, i.e. when the consumers
+  /// or the network do not keep up. It then compresses about
+  /// kMaxPartitionedOutputBufferSize bytes of pages before checking again.
+  static constexpr const char* kShuffleAdaptiveCompression =
+      "shuffle_adaptive_compression";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -178,6 +343,14 @@ class QueryConfig {
   static constexpr const char* kTableScanGetOutputTimeLimitMs =
       "table_scan_getoutput_time_limit_ms";
 
+  /// If true, TableScan sizes each batch it reads by the larger of the row
+  /// size estimated by the data source for the split and the row size of the
+  /// previous batch, so that batches of wide rows stay near
+  /// kPreferredOutputBatchBytes. If false, only the estimate for the split is
+  /// used.
+  static constexpr const char* kTableScanAdaptiveBatchSize =
+      "table_scan_adaptive_batch_size";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
@@ -216,6 +389,13 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
+  /// TopN spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kTopNSpillEnabled = "topn_spill_enabled";
+
   /// The max row numbers to fill and spill for each spill run. This is used to
   /// cap the memory used for spilling. If it is zero, then there is no limit
   /// and spilling might run out of memory.
@@ -317,11 +497,33 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The maximum number of bytes of probe input a hash probe operator buffers
+  /// while its hash table is being built, so that the probe side scan runs
+  /// concurrently with the build. The buffered input is probed once the table
+  /// is ready. 0 disables buffering. Does not apply if spilling is enabled.
+  static constexpr const char* kHashProbePrebuildBufferBytes =
+      "hash_probe_prebuild_buffer_bytes";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// If true, the hash join build stores the fixed width non-key columns in
+  /// columnar chunks outside of the hash table rows. The keys stay in the
+  /// rows for probing. Makes extracting the build side columns for large
+  /// join results read memory sequentially when the rows are listed in
+  /// insertion order, e.g. for the unmatched rows of a right join.
+  static constexpr const char* kHashJoinColumnarDependents =
+      "hash_join_columnar_dependents";
+
+  /// The maximum number of distinct join keys for which the hash join builds
+  /// Bloom filters over the keys to push down as dynamic filters. These are
+  /// used for keys with too many distinct values for an exact IN-list filter.
+  /// Each filter takes about 2 bytes per distinct key. 0 disables these.
+  static constexpr const char* kMaxJoinBloomFilterNumDistinct =
+      "max_join_bloom_filter_num_distinct";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -349,17 +551,57 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// If true, the number of splits a table scan preloads is the number its
+  /// drivers read in the time it takes to open a split, measured across all
+  /// drivers of the scan, at most kMaxSplitPreloadPerDriver per driver. No
+  /// new preloads start while the query is above 80% of its memory limit.
+  static constexpr const char* kAdaptiveSplitPreload =
+      "adaptive_split_preload";
+
+  /// If true, table scans look up the output of each split in the process
+  /// wide exec::FragmentResultCache and add the output of splits that miss.
+  /// Applies to splits whose data can not change, e.g. Hive splits with a file
+  /// modification time. Dynamic filters are not pushed into such scans.
+  static constexpr const char* kFragmentResultCacheEnabled =
+      "fragment_result_cache_enabled";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// The weight of a Task's drivers when sharing the CPU with the drivers of
+  /// other Tasks. Applies if the query executor is an exec::DriverExecutor.
+  /// A Task with weight 2 gets twice the CPU time of a Task with weight 1
+  /// when both have drivers waiting to run. Should be used with
+  /// kDriverCpuTimeSliceLimitMs so that drivers yield the CPU.
+  static constexpr const char* kCpuShareWeight = "cpu_share_weight";
+
+  /// If true, a Task parks drivers of a pipeline whose drivers block waiting
+  /// for their consumers, e.g. a full LocalExchange queue or output buffer,
+  /// and resumes them when a consumer waits for input or another driver of
+  /// the pipeline finishes. Drivers are parked when they yield, so this
+  /// takes effect only with kDriverCpuTimeSliceLimitMs.
+  static constexpr const char* kAdaptiveDriverConcurrency =
+      "adaptive_driver_concurrency";
+
+  /// If true, a driver whose operator returns a blocking future that is
+  /// already fulfilled continues on thread instead of going back to the
+  /// executor queue. Saves the enqueue and the wait behind other drivers when
+  /// the awaited I/O or peer completes before the operator reports blocked.
+  /// Yields and memory arbitration always go through the executor.
+  static constexpr const char* kDriverInlineResume = "driver_inline_resume";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
   }
 
+  int32_t queryMemoryPriority() const {
+    return get<int32_t>(kQueryMemoryPriority, 0);
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -370,6 +612,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxExtendedPartialAggregationMemory, kDefault);
   }
 
+  uint64_t partialAggregationCacheTableMemoryUsage() const {
+    return get<uint64_t>(kPartialAggregationCacheTableMemory, 0);
+  }
+
+  int32_t partialAggregationCacheTableMinHitPct() const {
+    return get<int32_t>(kPartialAggregationCacheTableMinHitPct, 50);
+  }
+
   int32_t abandonPartialAggregationMinRows() const {
     return get<int32_t>(kAbandonPartialAggregationMinRows, 100'000);
   }
@@ -378,6 +628,18 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  bool finalAggregationMergeAcrossDrivers() const {
+    return get<bool>(kFinalAggregationMergeAcrossDrivers, false);
+  }
+
+  bool orderByRangePartitionAcrossDrivers() const {
+    return get<bool>(kOrderByRangePartitionAcrossDrivers, false);
+  }
+
+  bool windowPartitionAcrossDrivers() const {
+    return get<bool>(kWindowPartitionAcrossDrivers, false);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -386,6 +648,22 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinPct, 80);
   }
 
+  int32_t compactVariableWidthDataPct() const {
+    return get<int32_t>(kCompactVariableWidthDataPct, 0);
+  }
+
+  int32_t nestedLoopJoinBuildDictionaryStringsPct() const {
+    return get<int32_t>(kNestedLoopJoinBuildDictionaryStringsPct, 0);
+  }
+
+  int32_t filterFlattenSelectivityPct() const {
+    return get<int32_t>(kFilterFlattenSelectivityPct, 0);
+  }
+
+  int32_t minLiveStringBufferPct() const {
+    return get<int32_t>(kMinLiveStringBufferPct, 0);
+  }
+
   uint64_t maxSpillRunRows() const {
     static constexpr uint64_t kDefault = 12UL << 20;
     return get<uint64_t>(kMaxSpillRunRows, kDefault);
@@ -417,21 +695,53 @@ class QueryConfig {
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  bool outputBufferSpillEnabled() const {
+    return get<bool>(kOutputBufferSpillEnabled, false);
+  }
+
+  std::string shuffleSerde() const {
+    return get<std::string>(kShuffleSerde, "");
+  }
+
+  bool shufflePreserveEncodings() const {
+    return get<bool>(kShufflePreserveEncodings, false);
+  }
+
+  bool shuffleAdaptiveCompression() const {
+    return get<bool>(kShuffleAdaptiveCompression, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  bool localPartitionFlatOutput() const {
+    return get<bool>(kLocalPartitionFlatOutput, false);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  bool exchangeBdpRequestSizing() const {
+    return get<bool>(kExchangeBdpRequestSizing, false);
+  }
+
   uint64_t maxMergeExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 128UL << 20;
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
   }
 
+  bool mergeExchangeParallelDecode() const {
+    return get<bool>(kMergeExchangeParallelDecode, false);
+  }
+
+  uint32_t mergeSourceReadAheadBatches() const {
+    return get<uint32_t>(kMergeSourceReadAheadBatches, 1);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -449,6 +759,10 @@ class QueryConfig {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
 
+  bool tableScanAdaptiveBatchSize() const {
+    return get<bool>(kTableScanAdaptiveBatchSize, false);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
@@ -534,6 +848,18 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for MarkDistinct operator. Must also
+  /// check the spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
+  /// Returns true if spilling is enabled for TopN operator. Must also check the
+  /// spillEnabled()!
+  bool topNSpillEnabled() const {
+    return get<bool>(kTopNSpillEnabled, true);
+  }
+
   int32_t maxSpillLevel() const {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
@@ -658,10 +984,46 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFuseKernels() const {
+    return get<bool>(kExprFuseKernels, false);
+  }
+
+  bool exprHoistLambdaInvariants() const {
+    return get<bool>(kExprHoistLambdaInvariants, false);
+  }
+
+  bool exprCacheDistinctInputs() const {
+    return get<bool>(kExprCacheDistinctInputs, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackHardwareCounters() const {
+    return get<bool>(kOperatorTrackHardwareCounters, false);
+  }
+
+  uint64_t memoryTimelineSampleIntervalMs() const {
+    return get<uint64_t>(kMemoryTimelineSampleIntervalMs, 0);
+  }
+
+  uint32_t memoryTimelineMaxSamples() const {
+    return get<uint32_t>(kMemoryTimelineMaxSamples, 1'000);
+  }
+
+  std::string operatorCaptureNodeId() const {
+    return get<std::string>(kOperatorCaptureNodeId, "");
+  }
+
+  std::string operatorCaptureDir() const {
+    return get<std::string>(kOperatorCaptureDir, "");
+  }
+
+  uint32_t operatorCaptureMaxBatches() const {
+    return get<uint32_t>(kOperatorCaptureMaxBatches, 100);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -675,10 +1037,22 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  uint64_t hashProbePrebuildBufferBytes() const {
+    return get<uint64_t>(kHashProbePrebuildBufferBytes, 0);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  bool hashJoinColumnarDependents() const {
+    return get<bool>(kHashJoinColumnarDependents, false);
+  }
+
+  uint64_t maxJoinBloomFilterNumDistinct() const {
+    return get<uint64_t>(kMaxJoinBloomFilterNumDistinct, 4 << 20);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -707,10 +1081,30 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  bool adaptiveSplitPreload() const {
+    return get<bool>(kAdaptiveSplitPreload, false);
+  }
+
+  bool fragmentResultCacheEnabled() const {
+    return get<bool>(kFragmentResultCacheEnabled, false);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  int32_t cpuShareWeight() const {
+    return get<int32_t>(kCpuShareWeight, 1);
+  }
+
+  bool adaptiveDriverConcurrency() const {
+    return get<bool>(kAdaptiveDriverConcurrency, false);
+  }
+
+  bool driverInlineResume() const {
+    return get<bool>(kDriverInlineResume, false);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -26,7 +26,8 @@ namespace facebook::velox::core {
     cache::AsyncDataCache* cache,
     std::shared_ptr<memory::MemoryPool> pool,
     folly::Executor* spillExecutor,
-    const std::string& queryId) {
+    const std::string& queryId,
+    folly::Executor* spillWriteExecutor) {
   std::shared_ptr<QueryCtx> queryCtx(new QueryCtx(
       executor,
       std::move(queryConfig),
@@ -34,7 +35,8 @@ namespace facebook::velox::core {
       cache,
       std::move(pool),
       spillExecutor,
-      queryId));
+      queryId,
+      spillWriteExecutor));
   queryCtx->maybeSetReclaimer();
   return queryCtx;
 }
@@ -47,10 +49,12 @@ QueryCtx::QueryCtx(
     cache::AsyncDataCache* cache,
     std::shared_ptr<memory::MemoryPool> pool,
     folly::Executor* spillExecutor,
-    const std::string& queryId)
+    const std::string& queryId,
+    folly::Executor* spillWriteExecutor)
     : queryId_(queryId),
       executor_(executor),
       spillExecutor_(spillExecutor),
+      spillWriteExecutor_(spillWriteExecutor),
       cache_(cache),
       connectorSessionProperties_(connectorSessionProperties),
       pool_(std::move(pool)),
@@ -84,6 +88,18 @@ void QueryCtx::updateSpilledBytesAndCheckLimit(uint64_t bytes) {
   }
 }
 
+std::shared_ptr<SharedSelectivity> QueryCtx::sharedSelectivity(
+    const std::string& key,
+    size_t numInputs) {
+  std::lock_guard<std::mutex> l(selectivityMutex_);
+  auto& selectivity = sharedSelectivity_[key];
+  if (selectivity == nullptr) {
+    selectivity = std::make_shared<SharedSelectivity>(numInputs);
+  }
+  VELOX_CHECK_EQ(selectivity->numInputs(), numInputs);
+  return selectivity;
+}
+
 std::unique_ptr<memory::MemoryReclaimer> QueryCtx::MemoryReclaimer::create(
     QueryCtx* queryCtx,
     memory::MemoryPool* pool) {
@@ -18,6 +18,8 @@
 
 #include <folly/Executor.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/Scratch.h"
+#include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/core/QueryConfig.h"
@@ -47,7 +49,8 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
       cache::AsyncDataCache* cache = cache::AsyncDataCache::getInstance(),
       std::shared_ptr<memory::MemoryPool> pool = nullptr,
       folly::Executor* spillExecutor = nullptr,
-      const std::string& queryId = "");
+      const std::string& queryId = "",
+      folly::Executor* spillWriteExecutor = nullptr);
 
   static std::string generatePoolName(const std::string& queryId);
 
@@ -100,6 +103,13 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
     return spillExecutor_;
   }
 
+  /// Executor for writing spill files behind serialization. Sized separately
+  /// from spillExecutor() since spill tasks wait for these writes. If nullptr
+  /// the spilling thread writes. See common::SpillConfig::writeExecutor.
+  folly::Executor* spillWriteExecutor() const {
+    return spillWriteExecutor_;
+  }
+
   const std::string& queryId() const {
     return queryId_;
   }
@@ -113,6 +123,13 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Returns the selectivity statistics of the filter identified by 'key',
+  /// shared by all the drivers of the query that evaluate it. Creates them
+  /// for a filter with 'numInputs' inputs on first use.
+  std::shared_ptr<SharedSelectivity> sharedSelectivity(
+      const std::string& key,
+      size_t numInputs);
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -140,7 +157,8 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
       cache::AsyncDataCache* cache = cache::AsyncDataCache::getInstance(),
       std::shared_ptr<memory::MemoryPool> pool = nullptr,
       folly::Executor* spillExecutor = nullptr,
-      const std::string& queryId = "");
+      const std::string& queryId = "",
+      folly::Executor* spillWriteExecutor = nullptr);
 
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
@@ -185,6 +203,10 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
       pool_ = memory::memoryManager()->addRootPool(
           QueryCtx::generatePoolName(queryId), memory::kMaxMemory);
     }
+    const auto priority = queryConfig_.queryMemoryPriority();
+    if (priority != 0 && pool_->isRoot()) {
+      pool_->setPriority(priority);
+    }
   }
 
   // Setup the memory reclaimer for arbitration if user provided memory pool
@@ -199,6 +221,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   const std::string queryId_;
   folly::Executor* const executor_{nullptr};
   folly::Executor* const spillExecutor_{nullptr};
+  folly::Executor* const spillWriteExecutor_{nullptr};
   cache::AsyncDataCache* const cache_;
 
   std::unordered_map<std::string, std::shared_ptr<Config>>
@@ -207,6 +230,10 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
 
+  std::mutex selectivityMutex_;
+  std::unordered_map<std::string, std::shared_ptr<SharedSelectivity>>
+      sharedSelectivity_;
+
   mutable std::mutex mutex_;
   // Indicates if this query is under memory arbitration or not.
   bool underArbitration_{false};
@@ -328,6 +355,26 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// Arena for transient arrays of expression evaluation. Allocations are
+  /// freed together when the outermost EvalCtx on this thread is destroyed,
+  /// i.e. at the end of each batch.
+  ScratchArena& scratchArena() {
+    return scratchArena_;
+  }
+
+  /// Called by EvalCtx on construction and destruction. Resets
+  /// 'scratchArena_' when the last EvalCtx goes away.
+  void beginEval() {
+    ++numEvals_;
+  }
+
+  void endEval() {
+    VELOX_DCHECK_GT(numEvals_, 0);
+    if (--numEvals_ == 0) {
+      scratchArena_.reset();
+    }
+  }
+
  private:
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
@@ -340,6 +387,9 @@ class ExecCtx {
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
   std::unique_ptr<VectorPool> vectorPool_;
+  ScratchArena scratchArena_;
+  // Number of live EvalCtxs using 'this'.
+  int32_t numEvals_{0};
 };
 
 } // namespace facebook::velox::core
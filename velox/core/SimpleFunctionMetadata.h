@@ -17,6 +17,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <folly/Likely.h>
+#include <folly/Range.h>
 #include <optional>
 
 #include "velox/common/base/Exceptions.h"
@@ -664,6 +665,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call()/callNullable()/callNullFree() method is
@@ -683,6 +685,7 @@ class UDFHolder {
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - void callBatch(folly::Range<TOut*> result, const TIn* inputs...)
   // - void initialize(...)
 
   // call():
@@ -799,6 +802,17 @@ class UDFHolder {
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch(): Computes the results for a contiguous range of rows where
+  // all inputs are flat and not null. Only used for functions with
+  // fixed-width primitive inputs and results. Must produce the same results as
+  // call() for all rows and must not fail.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      folly::Range<exec_return_type*>,
+      const exec_arg_type<TArgs>*...>::value;
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -948,6 +962,17 @@ class UDFHolder {
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<exec_return_type*> result,
+      const typename exec_resolver<TArgs>::in_type*... args) {
+    if constexpr (udf_has_callBatch) {
+      instance_.callBatch(result, args...);
+    } else {
+      VELOX_UNREACHABLE(
+          "callBatch should never be called if the UDF does not implement callBatch.");
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status callNullFree(
       exec_return_type& out,
       bool& notNull,
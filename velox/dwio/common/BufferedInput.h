@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/io/Options.h"
 #include "velox/common/memory/AllocationPool.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/StreamIdentifier.h"
@@ -149,6 +150,16 @@ class BufferedInput {
   virtual uint64_t nextFetchSize() const;
 
  protected:
+  // Returns the maximum gap between coalesced storage reads. If adaptive
+  // coalescing is on, this is estimated from the storage reads in 'ioStats'.
+  static int32_t coalesceDistance(
+      const io::ReaderOptions& options,
+      const IoStatistics* ioStats) {
+    return options.adaptiveCoalesce() && ioStats != nullptr
+        ? ioStats->coalesceDistance(options.maxCoalesceDistance())
+        : options.maxCoalesceDistance();
+  }
+
   const std::shared_ptr<ReadFileInputStream> input_;
   memory::MemoryPool* const pool_;
 
@@ -16,6 +16,7 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/caching/RemoteCache.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -242,7 +243,7 @@ void CacheInputStream::loadSync(const Region& region) {
     // missed, fall back to remote fetching.
     entry->setGroupId(groupId_);
     entry->setTrackingId(trackingId_);
-    if (loadFromSsd(region, *entry)) {
+    if (loadFromSsd(region, *entry) || loadFromRemoteCache(region, *entry)) {
       return;
     }
     const auto ranges = makeRanges(entry, region.length);
@@ -252,8 +253,10 @@ void CacheInputStream::loadSync(const Region& region) {
       input_->read(ranges, region.offset, LogType::FILE);
     }
     ioStats_->read().increment(region.length);
+    ioStats_->recordStorageRead(region.length, storageReadUs);
     ioStats_->queryThreadIoLatency().increment(storageReadUs);
     ioStats_->incTotalScanTime(storageReadUs * 1'000);
+    storeToRemoteCache();
     entry->setExclusiveToShared(!noCacheRetention_);
   } while (pin_.empty());
 }
@@ -324,6 +327,45 @@ bool CacheInputStream::loadFromSsd(
   return true;
 }
 
+bool CacheInputStream::loadFromRemoteCache(
+    const Region& region,
+    cache::AsyncDataCacheEntry& entry) {
+  auto* remoteCache = cache_->remoteCache();
+  if (remoteCache == nullptr) {
+    return false;
+  }
+  uint64_t loadUs{0};
+  try {
+    MicrosecondTimer timer(&loadUs);
+    const auto found = remoteCache->load(
+        folly::Range<const cache::CachePin*>(&pin_, 1));
+    if (found.empty() || !found[0]) {
+      return false;
+    }
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to load " << entry.toString() << " from "
+                 << remoteCache->toString() << ": " << e.what();
+    return false;
+  }
+  ioStats_->remoteCacheRead().increment(region.length);
+  ioStats_->queryThreadIoLatency().increment(loadUs);
+  entry.setExclusiveToShared(!noCacheRetention_);
+  return true;
+}
+
+void CacheInputStream::storeToRemoteCache() {
+  auto* remoteCache = cache_->remoteCache();
+  if (remoteCache == nullptr || noCacheRetention_) {
+    return;
+  }
+  try {
+    remoteCache->store(folly::Range<const cache::CachePin*>(&pin_, 1));
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to store " << pin_.checkedEntry()->toString()
+                 << " to " << remoteCache->toString() << ": " << e.what();
+  }
+}
+
 std::string CacheInputStream::ssdFileName() const {
   auto ssdCache = cache_->ssdCache();
   if (!ssdCache) {
@@ -114,6 +114,16 @@ class CacheInputStream : public SeekableInputStream {
       const velox::common::Region& region,
       cache::AsyncDataCacheEntry& entry);
 
+  // Returns true if there is a remote cache and 'entry' is present there and
+  // successfully loaded.
+  bool loadFromRemoteCache(
+      const velox::common::Region& region,
+      cache::AsyncDataCacheEntry& entry);
+
+  // Offers the entry of 'pin_', just read from storage, to the remote cache
+  // if there is one.
+  void storeToRemoteCache();
+
   // Invoked to clear the cache pin of the accessed cache entry and mark it as
   // immediate evictable if 'noCacheRetention_' flag is set.
   void clearCachePin();
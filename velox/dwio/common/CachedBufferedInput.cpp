@@ -15,8 +15,10 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/common/caching/RemoteCache.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -217,7 +219,8 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   const bool isSsd = !requests[0]->ssdPin.empty();
-  const int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  const int32_t maxDistance =
+      isSsd ? 20000 : coalesceDistance(options_, ioStats_.get());
   std::sort(
       requests.begin(),
       requests.end(),
@@ -350,6 +353,13 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
     }
   }
 
+  // Sets the group and tracking id of the new entry for the request at
+  // 'index'. These decide SSD admission and metadata retention.
+  void setIds(int32_t index, cache::AsyncDataCacheEntry& entry) {
+    entry.setGroupId(groupId_);
+    entry.setTrackingId(requests_[index].trackingId);
+  }
+
   static std::vector<RawFileCacheKey> makeKeys(
       std::vector<CacheRequest*>& requests) {
     std::vector<RawFileCacheKey> keys;
@@ -396,7 +406,8 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
-        [&](int32_t /*index*/, CachePin pin) {
+        [&](int32_t index, CachePin pin) {
+          setIds(index, *pin.checkedEntry());
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
@@ -405,6 +416,67 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     if (pins.empty()) {
       return pins;
     }
+    auto* remoteCache = cache_.remoteCache();
+    if (remoteCache == nullptr) {
+      readFromStorage(pins, prefetch);
+      return pins;
+    }
+    auto storagePins = loadFromRemoteCache(*remoteCache, pins, prefetch);
+    if (storagePins.empty()) {
+      return pins;
+    }
+    readFromStorage(storagePins, prefetch);
+    try {
+      remoteCache->store(folly::range(storagePins));
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to store to " << remoteCache->toString() << ": "
+                   << e.what();
+    }
+    for (auto& pin : storagePins) {
+      pins.push_back(std::move(pin));
+    }
+    return pins;
+  }
+
+ private:
+  // Fills the entries of 'pins' found in 'remoteCache' and leaves these in
+  // 'pins'. Returns the pins that are still to be read from storage, in
+  // offset order.
+  std::vector<CachePin> loadFromRemoteCache(
+      cache::RemoteCache& remoteCache,
+      std::vector<CachePin>& pins,
+      bool prefetch) {
+    std::vector<bool> found;
+    try {
+      found = remoteCache.load(folly::range(pins));
+      VELOX_CHECK_EQ(found.size(), pins.size());
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to load from " << remoteCache.toString() << ": "
+                   << e.what();
+      return std::exchange(pins, {});
+    }
+    std::vector<CachePin> loaded;
+    std::vector<CachePin> missing;
+    uint64_t loadedBytes = 0;
+    for (int32_t i = 0; i < pins.size(); ++i) {
+      if (found[i]) {
+        loadedBytes += pins[i].entry()->size();
+        loaded.push_back(std::move(pins[i]));
+      } else {
+        missing.push_back(std::move(pins[i]));
+      }
+    }
+    pins = std::move(loaded);
+    if (ioStats_ != nullptr && loadedBytes > 0) {
+      ioStats_->remoteCacheRead().increment(loadedBytes);
+      if (prefetch) {
+        ioStats_->prefetch().increment(loadedBytes);
+      }
+    }
+    return missing;
+  }
+
+  void readFromStorage(std::vector<CachePin>& pins, bool prefetch) {
     auto stats = cache::readPins(
         pins,
         maxCoalesceDistance_,
@@ -415,10 +487,20 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t usecs = 0;
+          {
+            MicrosecondTimer timer(&usecs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          if (ioStats_ != nullptr) {
+            uint64_t bytes = 0;
+            for (const auto& buffer : buffers) {
+              bytes += buffer.size();
+            }
+            ioStats_->recordStorageRead(bytes, usecs);
+          }
         });
     updateStats(stats, prefetch, false);
-    return pins;
   }
 
   std::shared_ptr<ReadFileInputStream> input_;
@@ -442,6 +524,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
         keys_,
         [&](int32_t index) { return sizes_[index]; },
         [&](int32_t index, CachePin pin) {
+          setIds(index, *pin.checkedEntry());
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
@@ -477,7 +560,7 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        coalesceDistance(options_, ioStats_.get()));
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
@@ -78,6 +78,11 @@ void ColumnLoader::loadInternal(
     effectiveRows = RowSet(selectedRows);
   }
 
+  if (!hook && !loaded_) {
+    // Feeds the choice between lazy and eager loading of the field.
+    fieldReader_->scanSpec()->addLoadedLazyBatch();
+    loaded_ = true;
+  }
   structReader_->advanceFieldReader(fieldReader_, offset);
   fieldReader_->scanSpec()->setValueHook(hook);
   fieldReader_->read(offset, effectiveRows, incomingNulls);
@@ -44,6 +44,9 @@ class ColumnLoader : public velox::VectorLoader {
   // these differ, 'structReader' has been advanced since the creation
   // of 'this' and 'this' is no longer loadable.
   const uint64_t version_;
+  // True after the first load without a ValueHook. A LazyVector may be
+  // loaded more than once for different rows.
+  bool loaded_{false};
 };
 
 } // namespace facebook::velox::dwio::common
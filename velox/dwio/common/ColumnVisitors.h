@@ -1611,6 +1611,10 @@ class StringColumnReadWithVisitorHelper {
         readHelper<velox::common::NegatedBytesValues, kIsDense>(
             filter, extractValues, std::forward<F>(readWithVisitor));
         break;
+      case velox::common::FilterKind::kBytesValuesUsingBloomFilter:
+        readHelper<velox::common::BytesValuesUsingBloomFilter, kIsDense>(
+            filter, extractValues, std::forward<F>(readWithVisitor));
+        break;
       default:
         readHelper<velox::common::Filter, kIsDense>(
             filter, extractValues, std::forward<F>(readWithVisitor));
@@ -127,7 +127,7 @@ void DirectBufferedInput::makeLoads(
     // eligible to prefetch. This will be loaded by itself on first use.
     return;
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  const int32_t maxDistance = coalesceDistance(options_, ioStats_.get());
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
@@ -282,6 +282,7 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
   }
 
   ioStats_->read().increment(size + overread);
+  ioStats_->recordStorageRead(size + overread, usecs);
   ioStats_->incRawBytesRead(size);
   ioStats_->incTotalScanTime(usecs * 1'000);
   ioStats_->queryThreadIoLatency().increment(usecs);
@@ -153,6 +153,7 @@ void DirectInputStream::loadSync() {
     input_->read(ranges, loadedRegion_.offset, LogType::FILE);
   }
   ioStats_->read().increment(loadedRegion_.length);
+  ioStats_->recordStorageRead(loadedRegion_.length, usecs);
   ioStats_->queryThreadIoLatency().increment(usecs);
   ioStats_->incTotalScanTime(usecs * 1'000);
 }
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::dwio::common {
+
+std::unique_ptr<CachedFileMetadata> FileMetadataGenerator::operator()(
+    const FileMetadataKey& key,
+    const FileMetadataLoader* loader) {
+  VELOX_CHECK_NOT_NULL(loader);
+  auto entry = std::make_unique<CachedFileMetadata>();
+  entry->fileId = StringIdLease(fileIds(), key.fileId);
+  entry->metadata = (*loader)();
+  VELOX_CHECK_NOT_NULL(entry->metadata);
+  return entry;
+}
+
+FileMetadataCache::FileMetadataCache(uint64_t maxBytes)
+    : factory_(
+          std::make_unique<SimpleLRUCache<
+              FileMetadataKey,
+              CachedFileMetadata,
+              std::equal_to<FileMetadataKey>,
+              FileMetadataKeyHash>>(maxBytes),
+          std::make_unique<FileMetadataGenerator>()) {}
+
+// static
+void FileMetadataCache::init(uint64_t maxBytes) {
+  std::unique_lock guard{instanceLock()};
+  auto& instance = instanceRef();
+  if (instance == nullptr) {
+    instance =
+        std::unique_ptr<FileMetadataCache>(new FileMetadataCache(maxBytes));
+  }
+}
+
+// static
+FileMetadataCache* FileMetadataCache::instance() {
+  std::shared_lock guard{instanceLock()};
+  return instanceRef().get();
+}
+
+// static
+std::shared_ptr<const FileMetadata> FileMetadataCache::getOrLoad(
+    const std::optional<FileMetadataKey>& key,
+    const FileMetadataLoader& loader) {
+  auto* cache = key.has_value() ? instance() : nullptr;
+  if (cache == nullptr) {
+    return loader();
+  }
+  return cache->get(key.value(), loader);
+}
+
+std::shared_ptr<const FileMetadata> FileMetadataCache::get(
+    const FileMetadataKey& key,
+    const FileMetadataLoader& loader) {
+  // The entry is unpinned when 'cached' goes out of scope. The caller keeps
+  // the metadata alive after eviction.
+  auto cached = factory_.generate(key, &loader);
+  return cached->metadata;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/SharedMutex.h>
+#include <folly/hash/Hash.h>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "velox/common/caching/CachedFactory.h"
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/common/caching/StringIdMap.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Parsed file level metadata, e.g. a file footer. Immutable once made, so
+/// that the readers of all splits of a file in all queries can share it.
+class FileMetadata {
+ public:
+  virtual ~FileMetadata() = default;
+
+  /// Approximate memory held by 'this'. Counts against the cache capacity.
+  virtual uint64_t estimatedBytes() const = 0;
+};
+
+/// Identifies a version of a file. 'fileId' is the number of the file name in
+/// fileIds(). The modification time tells apart files rewritten under the
+/// same name.
+struct FileMetadataKey {
+  uint64_t fileId;
+  int64_t modificationTime;
+
+  bool operator==(const FileMetadataKey& other) const {
+    return fileId == other.fileId && modificationTime == other.modificationTime;
+  }
+};
+
+struct FileMetadataKeyHash {
+  size_t operator()(const FileMetadataKey& key) const {
+    return folly::hash::hash_combine(key.fileId, key.modificationTime);
+  }
+};
+
+struct CachedFileMetadata {
+  // Keeps the file id of the key from being given to another file while the
+  // entry is cached.
+  StringIdLease fileId;
+  std::shared_ptr<const FileMetadata> metadata;
+};
+
+struct CachedFileMetadataSizer {
+  uint64_t operator()(const CachedFileMetadata& entry) const {
+    return entry.metadata->estimatedBytes();
+  }
+};
+
+/// Reads and parses the metadata of a file on a cache miss.
+using FileMetadataLoader = std::function<std::shared_ptr<const FileMetadata>()>;
+
+class FileMetadataGenerator {
+ public:
+  std::unique_ptr<CachedFileMetadata> operator()(
+      const FileMetadataKey& key,
+      const FileMetadataLoader* loader);
+};
+
+/// Process-wide cache of parsed file metadata, so that the splits of a file
+/// and the queries over it do not each read and deserialize the footer.
+/// Thread-safe. Concurrent lookups of the same missing key run the loader
+/// once.
+class FileMetadataCache {
+ public:
+  /// Creates the process-wide instance holding up to 'maxBytes' of metadata.
+  /// Does nothing if the instance exists.
+  static void init(uint64_t maxBytes);
+
+  /// Returns the process-wide instance or nullptr if init() was not called.
+  static FileMetadataCache* instance();
+
+  /// Returns the metadata of 'key' from the process-wide instance if there is
+  /// one and 'key' is set. Otherwise or if not cached, returns the result of
+  /// 'loader'.
+  static std::shared_ptr<const FileMetadata> getOrLoad(
+      const std::optional<FileMetadataKey>& key,
+      const FileMetadataLoader& loader);
+
+  std::shared_ptr<const FileMetadata> get(
+      const FileMetadataKey& key,
+      const FileMetadataLoader& loader);
+
+  SimpleLRUCacheStats stats() {
+    return factory_.cacheStats();
+  }
+
+  SimpleLRUCacheStats clear() {
+    return factory_.clearCache();
+  }
+
+  static void testingReset() {
+    std::unique_lock guard{instanceLock()};
+    instanceRef().reset();
+  }
+
+ private:
+  explicit FileMetadataCache(uint64_t maxBytes);
+
+  static folly::SharedMutex& instanceLock() {
+    static folly::SharedMutex mu;
+    return mu;
+  }
+
+  static std::unique_ptr<FileMetadataCache>& instanceRef() {
+    static std::unique_ptr<FileMetadataCache> instance;
+    return instance;
+  }
+
+  CachedFactory<
+      FileMetadataKey,
+      CachedFileMetadata,
+      FileMetadataGenerator,
+      FileMetadataLoader,
+      CachedFileMetadataSizer,
+      std::equal_to<FileMetadataKey>,
+      FileMetadataKeyHash>
+      factory_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -27,6 +27,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/ColumnSelector.h"
 #include "velox/dwio/common/ErrorTolerance.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/common/FlushPolicy.h"
 #include "velox/dwio/common/InputStream.h"
@@ -610,6 +611,16 @@ class ReaderOptions : public io::ReaderOptions {
     scanSpec_ = std::move(scanSpec);
   }
 
+  /// Identifies the version of the file for sharing its parsed metadata
+  /// through FileMetadataCache. If not set, each reader parses the metadata.
+  const std::optional<FileMetadataKey>& fileMetadataKey() const {
+    return fileMetadataKey_;
+  }
+
+  void setFileMetadataKey(std::optional<FileMetadataKey> key) {
+    fileMetadataKey_ = key;
+  }
+
  private:
   uint64_t tailLocation_;
   FileFormat fileFormat_;
@@ -624,6 +635,7 @@ class ReaderOptions : public io::ReaderOptions {
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
   const date::time_zone* sessionTimezone_{nullptr};
+  std::optional<FileMetadataKey> fileMetadataKey_;
 };
 
 struct WriterOptions {
@@ -640,6 +652,9 @@ struct WriterOptions {
   std::optional<uint8_t> parquetWriteTimestampUnit;
   std::optional<uint8_t> zlibCompressionLevel;
   std::optional<uint8_t> zstdCompressionLevel;
+  // Executor for encoding columns in parallel. Only used by the Parquet
+  // writer.
+  std::shared_ptr<folly::Executor> encodingExecutor;
 };
 
 } // namespace facebook::velox::dwio::common
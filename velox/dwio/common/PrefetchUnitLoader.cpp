@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+
+#include <map>
+#include <numeric>
+
+#include <folly/futures/Future.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+#include "velox/dwio/common/UnitLoaderTools.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class PrefetchUnitLoader : public UnitLoader {
+ public:
+  PrefetchUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      uint32_t firstUnit,
+      std::shared_ptr<folly::Executor> executor,
+      uint32_t unitsAhead,
+      uint64_t maxBytesAhead,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback)
+      : loadUnits_{std::move(loadUnits)},
+        executor_{std::move(executor)},
+        unitsAhead_{unitsAhead},
+        maxBytesAhead_{maxBytesAhead},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)} {
+    VELOX_CHECK_NOT_NULL(executor_);
+    // Starts loading the first units to read before the reader asks for them.
+    prefetch(firstUnit);
+  }
+
+  ~PrefetchUnitLoader() override {
+    // The loads in flight refer to 'loadUnits_'.
+    for (auto& entry : loads_) {
+      entry.second.wait();
+    }
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+
+    for (auto it = loads_.begin(); it != loads_.end();) {
+      if (it->first < unit || it->first > unit + unitsAhead_) {
+        it = release(it);
+      } else {
+        ++it;
+      }
+    }
+    schedule(unit);
+    prefetch(unit + 1);
+
+    auto it = loads_.find(unit);
+    if (!it->second.isReady()) {
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      it->second.wait();
+    }
+    if (it->second.hasException()) {
+      auto exception = it->second.result().exception();
+      bytesAhead_ -= loadUnits_[unit]->getIoSize();
+      loads_.erase(it);
+      exception.throw_exception();
+    }
+    return *loadUnits_[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+ private:
+  using LoadMap = std::map<uint32_t, folly::Future<folly::Unit>>;
+
+  // Starts loading 'unit' on 'executor_' if it is not loaded or loading.
+  void schedule(uint32_t unit) {
+    if (loads_.count(unit)) {
+      return;
+    }
+    auto* loadUnit = loadUnits_[unit].get();
+    bytesAhead_ += loadUnit->getIoSize();
+    loads_.emplace(
+        unit,
+        folly::via(executor_.get(), [loadUnit]() { loadUnit->load(); }));
+  }
+
+  // Schedules the units from 'unit' to the end of the prefetch window of the
+  // unit before it, as long as these fit in 'maxBytesAhead_'.
+  void prefetch(uint32_t unit) {
+    const auto end = std::min<uint64_t>(
+        static_cast<uint64_t>(unit) + unitsAhead_, loadUnits_.size());
+    for (auto next = unit; next < end; ++next) {
+      if (loads_.count(next)) {
+        continue;
+      }
+      if (bytesAhead_ + loadUnits_[next]->getIoSize() > maxBytesAhead_) {
+        break;
+      }
+      schedule(next);
+    }
+  }
+
+  // Waits for the load of 'it' to finish and unloads its unit.
+  LoadMap::iterator release(LoadMap::iterator it) {
+    it->second.wait();
+    auto& loadUnit = *loadUnits_[it->first];
+    if (!it->second.hasException()) {
+      loadUnit.unload();
+    }
+    bytesAhead_ -= loadUnit.getIoSize();
+    return loads_.erase(it);
+  }
+
+  std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  const std::shared_ptr<folly::Executor> executor_;
+  const uint32_t unitsAhead_;
+  const uint64_t maxBytesAhead_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  // The loads of the units that are loaded or loading, by unit.
+  LoadMap loads_;
+  // Sum of the IO sizes of the units in 'loads_'.
+  uint64_t bytesAhead_{0};
+};
+
+} // namespace
+
+std::unique_ptr<UnitLoader> PrefetchUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  std::vector<uint64_t> rowsPerUnit;
+  rowsPerUnit.reserve(loadUnits.size());
+  for (const auto& unit : loadUnits) {
+    rowsPerUnit.push_back(unit->getNumRows());
+  }
+  const auto totalRows =
+      std::accumulate(rowsPerUnit.cbegin(), rowsPerUnit.cend(), 0UL);
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  const auto firstUnit =
+      unit_loader_tools::howMuchToSkip(
+          rowsToSkip, rowsPerUnit.cbegin(), rowsPerUnit.cend())
+          .first;
+  return std::make_unique<PrefetchUnitLoader>(
+      std::move(loadUnits),
+      firstUnit,
+      executor_,
+      unitsAhead_,
+      maxBytesAhead_,
+      blockedOnIoCallback_);
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+// Creates unit loaders that load the next 'unitsAhead' units on 'executor'
+// while the reader works on the current one. Units are scheduled in order
+// until the total IO size of the loaded and loading units would exceed
+// 'maxBytesAhead'. The requested unit is always loaded. Units before the
+// requested one or past its prefetch window are unloaded when the next unit
+// is requested. 'blockedOnIoCallback' gets the time the reader waited for a
+// unit to load.
+class PrefetchUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  PrefetchUnitLoaderFactory(
+      std::shared_ptr<folly::Executor> executor,
+      uint32_t unitsAhead,
+      uint64_t maxBytesAhead,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback)
+      : executor_{std::move(executor)},
+        unitsAhead_{unitsAhead},
+        maxBytesAhead_{maxBytesAhead},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)} {}
+  ~PrefetchUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  const std::shared_ptr<folly::Executor> executor_;
+  const uint32_t unitsAhead_;
+  const uint64_t maxBytesAhead_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -57,6 +57,17 @@ uint64_t ScanSpec::newRead() {
   return numReads_++;
 }
 
+void ScanSpec::updateEagerLoad() {
+  if (numLazyBatches_ >= kLoadRatioWindow) {
+    eagerLoadMode_ =
+        numLoadedLazyBatches_ >= numLazyBatches_ * kEagerLoadRatio;
+    numLazyBatches_ /= 2;
+    numLoadedLazyBatches_ /= 2;
+  }
+  eagerLoad_ = eagerLoadMode_ &&
+      ++numEagerLoadModeBatches_ % kLazySampleInterval != 0;
+}
+
 void ScanSpec::reorder() {
   if (children_.empty()) {
     return;
@@ -130,7 +141,7 @@ bool ScanSpec::hasFilter() const {
 }
 
 void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
-  // moves the filters and filter order from 'other'.
+  // moves the filters, filter order and load ratios from 'other'.
   for (auto& child : children_) {
     auto it = other.childByFieldName_.find(child->fieldName_);
     if (it == other.childByFieldName_.end()) {
@@ -144,6 +155,10 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
       // received.
       child->filter_ = std::move(otherChild->filter_);
       child->selectivity_ = otherChild->selectivity_;
+      child->numLazyBatches_ = otherChild->numLazyBatches_;
+      child->numLoadedLazyBatches_ = otherChild->numLoadedLazyBatches_;
+      child->eagerLoadMode_ = otherChild->eagerLoadMode_;
+      child->numEagerLoadModeBatches_ = otherChild->numEagerLoadModeBatches_;
     }
   }
 }
@@ -214,6 +214,38 @@ class ScanSpec {
     return selectivity_;
   }
 
+  // True if the values of this top level field are read together with the
+  // filtered fields in the current batch instead of being returned as a
+  // LazyVector. Set by updateEagerLoad().
+  bool eagerLoad() const {
+    return eagerLoad_;
+  }
+
+  // Called by the reader of the containing struct at the start of each batch
+  // in which this field would be returned as a LazyVector. Switches to eager
+  // loading when at least kEagerLoadRatio of the recent LazyVectors of this
+  // field were loaded and back to lazy loading when the ratio drops below
+  // it. While loading eagerly, one batch in kLazySampleInterval still gets
+  // a LazyVector so that the ratio keeps being measured.
+  void updateEagerLoad();
+
+  // Records that a LazyVector was made for this field.
+  void addLazyBatch() {
+    ++numLazyBatches_;
+  }
+
+  // Records that a LazyVector of this field was loaded other than into a
+  // ValueHook. Pushdown into a ValueHook does not favor eager loading.
+  void addLoadedLazyBatch() {
+    ++numLoadedLazyBatches_;
+  }
+
+  // Number of LazyVectors after which the load ratio is evaluated. The
+  // counts are then halved so that recent batches weigh more.
+  static constexpr int32_t kLoadRatioWindow = 8;
+  static constexpr double kEagerLoadRatio = 0.75;
+  static constexpr int32_t kLazySampleInterval = 8;
+
   ValueHook* valueHook() const {
     return valueHook_;
   }
@@ -377,6 +409,17 @@ class ScanSpec {
       metadataFilters_;
 
   SelectivityInfo selectivity_;
+
+  // Number of recent batches with a LazyVector for this field and how many
+  // of these were loaded. See updateEagerLoad().
+  int32_t numLazyBatches_ = 0;
+  int32_t numLoadedLazyBatches_ = 0;
+  // True if the recent load ratio favors eager loading.
+  bool eagerLoadMode_ = false;
+  // Number of batches in eager load mode, used for sampling lazy batches.
+  int64_t numEagerLoadModeBatches_ = 0;
+  bool eagerLoad_ = false;
+
   // Sort children by filtering efficiency.
   bool enableFilterReorder_ = true;
 
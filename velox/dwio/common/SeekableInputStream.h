@@ -59,6 +59,14 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
 
   virtual bool SkipInt64(int64_t count) = 0;
 
+  // Returns a buffer holding the bytes returned by the last Next(). The
+  // stream does not overwrite the buffer while the caller holds a reference,
+  // so values can point into it. Returns nullptr if the stream does not own
+  // the bytes or reuses their memory.
+  virtual BufferPtr lastBuffer() const {
+    return nullptr;
+  }
+
   bool Skip(int32_t count) final override {
     return SkipInt64(count);
   }
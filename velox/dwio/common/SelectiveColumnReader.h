@@ -15,6 +15,9 @@
  */
 
 #pragma once
+
+#include <folly/Executor.h>
+
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/process/ProcessBase.h"
@@ -500,6 +503,16 @@ class SelectiveColumnReader {
     VELOX_UNREACHABLE("Only struct reader supports this method");
   }
 
+  // Sets an executor for decoding the top level columns without filters of a
+  // batch in parallel. Up to 'parallelismFactor' threads including the
+  // calling thread are used. Columns decoded in parallel are not returned as
+  // LazyVectors.
+  virtual void setDecodingExecutor(
+      folly::Executor* /*executor*/,
+      size_t /*parallelismFactor*/) {
+    VELOX_UNREACHABLE("Only struct reader supports this method");
+  }
+
  protected:
   template <typename T>
   void
@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -168,6 +169,7 @@ void SelectiveStructColumnReaderBase::read(
 
   auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
+  parallelChildren_.clear();
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
     VELOX_TRACE_HISTORY_PUSH("read %s", childSpec->fieldName().c_str());
@@ -176,12 +178,23 @@ void SelectiveStructColumnReaderBase::read(
     }
     auto fieldIndex = childSpec->subscript();
     auto reader = children_.at(fieldIndex);
-    if (reader->isTopLevel() && childSpec->projectOut() &&
-        !childSpec->hasFilter() && !childSpec->extractValues()) {
-      // Will make a LazyVector.
-      continue;
+    const bool lazyCandidate = reader->isTopLevel() &&
+        childSpec->projectOut() && !childSpec->hasFilter() &&
+        !childSpec->extractValues() && !parallelDecoding();
+    if (lazyCandidate) {
+      childSpec->updateEagerLoad();
+      if (!childSpec->eagerLoad()) {
+        // Will make a LazyVector.
+        continue;
+      }
     }
     advanceFieldReader(reader, offset);
+    if (reader->isTopLevel() && !childSpec->hasFilter() &&
+        (parallelDecoding() || lazyCandidate)) {
+      // Read after all filters are applied, see below.
+      parallelChildren_.push_back(reader);
+      continue;
+    }
     if (childSpec->hasFilter()) {
       {
         SelectivityTimer timer(childSpec->selectivity(), activeRows.size());
@@ -203,6 +216,20 @@ void SelectiveStructColumnReaderBase::read(
     }
   }
 
+  if (!parallelChildren_.empty() && !activeRows.empty()) {
+    // The children without filters are independent of each other and are
+    // decoded for the rows passing all filters, on separate threads if
+    // parallelDecoding().
+    ParallelFor(
+        decodingExecutor_,
+        0,
+        parallelChildren_.size(),
+        decodingParallelismFactor_)
+        .execute([&](size_t i) {
+          parallelChildren_[i]->read(offset, activeRows, structNulls);
+        });
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -393,7 +420,8 @@ void SelectiveStructColumnReaderBase::getValues(
       continue;
     }
     if (childSpec->extractValues() || childSpec->hasFilter() ||
-        !children_[index]->isTopLevel()) {
+        !children_[index]->isTopLevel() || parallelDecoding() ||
+        childSpec->eagerLoad()) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
@@ -404,6 +432,7 @@ void SelectiveStructColumnReaderBase::getValues(
       }
       lazyPrepared = true;
     }
+    childSpec->addLazyBatch();
     auto loader =
         std::make_unique<ColumnLoader>(this, children_[index], numReads_);
     if (childResult && childResult->isLazy() && childResult.unique()) {
@@ -102,6 +102,12 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     fillMutatedOutputRows_ = value;
   }
 
+  void setDecodingExecutor(folly::Executor* executor, size_t parallelismFactor)
+      final {
+    decodingExecutor_ = executor;
+    decodingParallelismFactor_ = parallelismFactor;
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -137,6 +143,12 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   void fillOutputRowsFromMutation(vector_size_t size);
 
+  // True if the top level children without filters are decoded in parallel
+  // instead of being returned as LazyVectors.
+  bool parallelDecoding() const {
+    return decodingExecutor_ != nullptr && decodingParallelismFactor_ > 1;
+  }
+
   std::vector<SelectiveColumnReader*> children_;
 
   // Sequence number of output batch. Checked against ColumnLoaders
@@ -156,6 +168,18 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   bool fillMutatedOutputRows_ = false;
 
+  // Executor and number of threads for decoding the top level children
+  // without filters in parallel after the filters are applied. Not used if
+  // 'decodingParallelismFactor_' is below 2.
+  folly::Executor* decodingExecutor_{nullptr};
+  size_t decodingParallelismFactor_{0};
+
+  // Children read by ParallelFor after the filters in read(). These are the
+  // top level children without filters if parallelDecoding() and otherwise
+  // the ones whose ScanSpec selects eager loading. Member to avoid
+  // reallocation.
+  std::vector<SelectiveColumnReader*> parallelChildren_;
+
   // Context information obtained from ExceptionContext. Stored here
   // so that LazyVector readers under this can add this to their
   // ExceptionContext. Allows contextualizing reader errors to split
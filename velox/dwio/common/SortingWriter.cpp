@@ -22,10 +22,12 @@ SortingWriter::SortingWriter(
     std::unique_ptr<Writer> writer,
     std::unique_ptr<exec::SortBuffer> sortBuffer,
     uint32_t maxOutputRowsConfig,
-    uint64_t maxOutputBytesConfig)
+    uint64_t maxOutputBytesConfig,
+    uint64_t maxBufferedBytesConfig)
     : outputWriter_(std::move(writer)),
       maxOutputRowsConfig_(maxOutputRowsConfig),
       maxOutputBytesConfig_(maxOutputBytesConfig),
+      maxBufferedBytesConfig_(maxBufferedBytesConfig),
       sortPool_(sortBuffer->pool()),
       canReclaim_(sortBuffer->canSpill()),
       sortBuffer_(std::move(sortBuffer)) {
@@ -44,6 +46,16 @@ SortingWriter::~SortingWriter() {
 void SortingWriter::write(const VectorPtr& data) {
   checkRunning();
   sortBuffer_->addInput(data);
+  maybeSpillInput();
+}
+
+void SortingWriter::maybeSpillInput() {
+  if (maxBufferedBytesConfig_ == 0 || !canReclaim_ ||
+      sortPool_->usedBytes() < maxBufferedBytesConfig_) {
+    return;
+  }
+  sortBuffer_->spill();
+  sortPool_->release();
 }
 
 void SortingWriter::flush() {
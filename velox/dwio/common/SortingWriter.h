@@ -23,13 +23,19 @@
 namespace facebook::velox::dwio::common {
 
 /// Sorting Writer object is used to write sorted data into a single file.
+///
+/// If 'maxBufferedBytesConfig' is not 0 and 'sortBuffer' can spill, the
+/// buffered input is spilled as a sorted run whenever it reaches that size.
+/// The runs are merged into the output writer on close, so memory stays
+/// bounded for large files.
 class SortingWriter : public Writer {
  public:
   SortingWriter(
       std::unique_ptr<Writer> writer,
       std::unique_ptr<exec::SortBuffer> sortBuffer,
       uint32_t maxOutputRowsConfig,
-      uint64_t maxOutputBytesConfig);
+      uint64_t maxOutputBytesConfig,
+      uint64_t maxBufferedBytesConfig = 0);
 
   ~SortingWriter() override;
 
@@ -43,6 +49,11 @@ class SortingWriter : public Writer {
 
   void abort() override;
 
+  std::vector<std::unique_ptr<ColumnStatistics>> columnStatistics()
+      const override {
+    return outputWriter_->columnStatistics();
+  }
+
  private:
   class MemoryReclaimer : public exec::MemoryReclaimer {
    public:
@@ -75,9 +86,14 @@ class SortingWriter : public Writer {
 
   uint32_t outputBatchRows();
 
+  // Spills the buffered input as a sorted run if it exceeds
+  // 'maxBufferedBytesConfig_'.
+  void maybeSpillInput();
+
   const std::unique_ptr<Writer> outputWriter_;
   const uint32_t maxOutputRowsConfig_;
   const uint64_t maxOutputBytesConfig_;
+  const uint64_t maxBufferedBytesConfig_;
   memory::MemoryPool* const sortPool_;
   const bool canReclaim_;
 
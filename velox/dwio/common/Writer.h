@@ -20,7 +20,9 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <vector>
 
+#include "velox/dwio/common/Statistics.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::dwio::common {
@@ -74,6 +76,15 @@ class Writer {
    */
   virtual void abort() = 0;
 
+  /// Returns the file level statistics of the top level columns, in schema
+  /// order. They are collected while encoding, so no pass over the written
+  /// data is needed. Valid after close(). Empty if the format does not
+  /// collect statistics.
+  virtual std::vector<std::unique_ptr<ColumnStatistics>> columnStatistics()
+      const {
+    return {};
+  }
+
  protected:
   bool isRunning() const;
 
@@ -547,6 +547,7 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
     *size = static_cast<int32_t>(availSize);
     outputBufferPtr_ = inputBufferPtr_ + availSize;
     outputBufferLength_ = 0;
+    outputBufferReturned_ = false;
   } else {
     DWIO_ENSURE_EQ(
         state_,
@@ -562,7 +563,8 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
     zstream_.next_in =
         reinterpret_cast<Bytef*>(const_cast<char*>(inputBufferPtr_));
     zstream_.avail_in = folly::to<uInt>(availSize);
-    outputBufferPtr_ = outputBuffer_->data();
+    outputBufferPtr_ = outputBuffer_->asMutable<char>();
+    outputBufferReturned_ = true;
     zstream_.next_out =
         reinterpret_cast<Bytef*>(const_cast<char*>(outputBufferPtr_));
     zstream_.avail_out = folly::to<uInt>(blockSize_);
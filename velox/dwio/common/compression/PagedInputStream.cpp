@@ -19,9 +19,9 @@
 namespace facebook::velox::dwio::common::compression {
 
 void PagedInputStream::prepareOutputBuffer(uint64_t uncompressedLength) {
-  if (!outputBuffer_ || uncompressedLength > outputBuffer_->capacity()) {
-    outputBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
-        pool_, uncompressedLength);
+  if (!outputBuffer_ || !outputBuffer_->unique() ||
+      uncompressedLength > outputBuffer_->capacity()) {
+    outputBuffer_ = AlignedBuffer::allocate<char>(uncompressedLength, &pool_);
   }
 }
 
@@ -150,6 +150,7 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   const char* input = nullptr;
   // if no decompression or decryption is needed, simply adjust the output
   // pointer. Otherwise, make sure we have continuous block
+  outputBufferReturned_ = false;
   if (original) {
     if (data) {
       *data = inputBufferPtr_;
@@ -186,16 +187,15 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
       outputBufferPtr_ = nullptr;
     } else {
       prepareOutputBuffer(decompressedLength);
+      auto* output = outputBuffer_->asMutable<char>();
       outputBufferLength_ = decompressor_->decompress(
-          input,
-          remainingLength_,
-          outputBuffer_->data(),
-          outputBuffer_->capacity());
+          input, remainingLength_, output, outputBuffer_->capacity());
       if (data) {
-        *data = outputBuffer_->data();
+        *data = output;
       }
       *size = static_cast<int32_t>(outputBufferLength_);
-      outputBufferPtr_ = outputBuffer_->data() + outputBufferLength_;
+      outputBufferPtr_ = output + outputBufferLength_;
+      outputBufferReturned_ = true;
     }
     // release decryption buffer
     decryptionBuffer_ = nullptr;
@@ -56,6 +56,10 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   // NOTE: This always returns true.
   bool SkipInt64(int64_t count) override;
 
+  BufferPtr lastBuffer() const override {
+    return outputBufferReturned_ ? outputBuffer_ : nullptr;
+  }
+
   google::protobuf::int64 ByteCount() const override {
     return bytesReturned_ + pendingSkip_;
   }
@@ -135,8 +139,12 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   // decompression/decryption algorithm to work on contiguous block
   dwio::common::DataBuffer<char> inputBuffer_;
 
-  // uncompressed output
-  std::unique_ptr<dwio::common::DataBuffer<char>> outputBuffer_{nullptr};
+  // uncompressed output. Replaced instead of overwritten if a caller holds a
+  // reference from lastBuffer().
+  BufferPtr outputBuffer_{nullptr};
+
+  // True if the last Next() returned bytes from 'outputBuffer_'.
+  bool outputBufferReturned_{false};
 
   // unencrypted output
   std::unique_ptr<folly::IOBuf> decryptionBuffer_{nullptr};
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+class TestMetadata : public FileMetadata {
+ public:
+  TestMetadata(int32_t value, uint64_t bytes) : value_(value), bytes_(bytes) {}
+
+  int32_t value() const {
+    return value_;
+  }
+
+  uint64_t estimatedBytes() const override {
+    return bytes_;
+  }
+
+ private:
+  const int32_t value_;
+  const uint64_t bytes_;
+};
+
+class FileMetadataCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    FileMetadataCache::testingReset();
+  }
+
+  void TearDown() override {
+    FileMetadataCache::testingReset();
+  }
+
+  // Returns the value of the metadata for 'key' and counts loads in
+  // 'numLoads_'.
+  int32_t get(const std::optional<FileMetadataKey>& key, int32_t value) {
+    auto metadata = FileMetadataCache::getOrLoad(key, [&]() {
+      ++numLoads_;
+      return std::make_shared<TestMetadata>(value, 100);
+    });
+    return dynamic_cast<const TestMetadata&>(*metadata).value();
+  }
+
+  int32_t numLoads_{0};
+};
+
+TEST_F(FileMetadataCacheTest, basic) {
+  StringIdLease file(fileIds(), "file");
+  StringIdLease otherFile(fileIds(), "otherFile");
+  const FileMetadataKey key{file.id(), 1};
+
+  // Without an instance every lookup loads.
+  ASSERT_EQ(FileMetadataCache::instance(), nullptr);
+  ASSERT_EQ(get(key, 1), 1);
+  ASSERT_EQ(get(key, 2), 2);
+  ASSERT_EQ(numLoads_, 2);
+
+  FileMetadataCache::init(1'000);
+  auto* cache = FileMetadataCache::instance();
+  ASSERT_NE(cache, nullptr);
+  // A second init keeps the instance.
+  FileMetadataCache::init(10);
+  ASSERT_EQ(FileMetadataCache::instance(), cache);
+
+  numLoads_ = 0;
+  ASSERT_EQ(get(key, 1), 1);
+  ASSERT_EQ(get(key, 2), 1);
+  ASSERT_EQ(numLoads_, 1);
+
+  // A new modification time or file is a different entry.
+  ASSERT_EQ(get(FileMetadataKey{file.id(), 2}, 3), 3);
+  ASSERT_EQ(get(FileMetadataKey{otherFile.id(), 1}, 4), 4);
+  ASSERT_EQ(numLoads_, 3);
+
+  // Without a key the metadata is not cached.
+  ASSERT_EQ(get(std::nullopt, 5), 5);
+  ASSERT_EQ(numLoads_, 4);
+  ASSERT_EQ(cache->stats().numElements, 3);
+  ASSERT_EQ(cache->stats().curSize, 300);
+
+  // The cache keeps the file id after the last lease outside it is gone.
+  const auto fileId = file.id();
+  file = StringIdLease();
+  ASSERT_EQ(fileIds().string(fileId), "file");
+
+  cache->clear();
+  ASSERT_EQ(cache->stats().numElements, 0);
+  ASSERT_EQ(get(FileMetadataKey{otherFile.id(), 1}, 6), 6);
+  ASSERT_EQ(numLoads_, 5);
+}
+
+TEST_F(FileMetadataCacheTest, eviction) {
+  StringIdLease file(fileIds(), "file");
+  FileMetadataCache::init(250);
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_EQ(get(FileMetadataKey{file.id(), i}, i), i);
+  }
+  ASSERT_EQ(FileMetadataCache::instance()->stats().numElements, 2);
+  // The oldest entry is evicted and reloaded.
+  ASSERT_EQ(get(FileMetadataKey{file.id(), 0}, 10), 10);
+  ASSERT_EQ(get(FileMetadataKey{file.id(), 2}, 20), 2);
+  ASSERT_EQ(numLoads_, 4);
+}
+
+TEST_F(FileMetadataCacheTest, loadError) {
+  StringIdLease file(fileIds(), "file");
+  FileMetadataCache::init(1'000);
+  const FileMetadataKey key{file.id(), 1};
+  ASSERT_THROW(
+      FileMetadataCache::getOrLoad(
+          key,
+          []() -> std::shared_ptr<const FileMetadata> {
+            throw std::runtime_error("corrupt footer");
+          }),
+      std::runtime_error);
+  ASSERT_EQ(get(key, 1), 1);
+  ASSERT_EQ(numLoads_, 1);
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
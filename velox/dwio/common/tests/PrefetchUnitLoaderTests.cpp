@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using namespace ::testing;
+using facebook::velox::dwio::common::LoadUnit;
+using facebook::velox::dwio::common::PrefetchUnitLoaderFactory;
+using facebook::velox::dwio::common::test::getUnitsLoadedWithFalse;
+using facebook::velox::dwio::common::test::LoadUnitMock;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+namespace {
+
+// Runs the loads on the calling thread so that the prefetched units are
+// loaded as soon as they are scheduled.
+class InlineExecutor : public folly::Executor {
+ public:
+  void add(folly::Func func) override {
+    func();
+  }
+};
+
+std::shared_ptr<folly::Executor> inlineExecutor() {
+  return std::make_shared<InlineExecutor>();
+}
+
+} // namespace
+
+TEST(PrefetchUnitLoaderTests, LoadsAheadWithReader) {
+  size_t blockedOnIoCount = 0;
+  PrefetchUnitLoaderFactory factory(
+      inlineExecutor(), 1, 1'000, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30}, {100, 100, 100}, factory, 0};
+  // The first unit is loaded before the reader asks for it.
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(7)); // Unit: 0, rows: 3-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(14)); // Unit: 1, rows: 0-13, unload(0), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 1, rows: 14-19
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  // All units were loaded before they were needed.
+  EXPECT_EQ(blockedOnIoCount, 0);
+}
+
+TEST(PrefetchUnitLoaderTests, LimitsBytesAhead) {
+  PrefetchUnitLoaderFactory factory(inlineExecutor(), 2, 250, nullptr);
+  ReaderMock readerMock{{10, 20, 30, 40}, {100, 100, 100, 100}, factory, 0};
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({true, true, false, false}));
+
+  // Unit 2 would exceed the budget while 0 and 1 are loaded.
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, rows: 0-9
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({true, true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, unload(0), load(2)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, unload(1), load(3)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, false, true, true}));
+}
+
+TEST(PrefetchUnitLoaderTests, LoadsUnitOverBudget) {
+  PrefetchUnitLoaderFactory factory(inlineExecutor(), 1, 50, nullptr);
+  ReaderMock readerMock{{10, 20}, {100, 100}, factory, 0};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false}));
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, rows: 0-9, load(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, unload(0), load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true}));
+}
+
+TEST(PrefetchUnitLoaderTests, CanSeek) {
+  PrefetchUnitLoaderFactory factory(inlineExecutor(), 1, 1'000, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+
+  EXPECT_NO_THROW(readerMock.seek(30););
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 2, rows: 0-2, unload(0), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  EXPECT_NO_THROW(readerMock.seek(5););
+
+  EXPECT_TRUE(readerMock.read(5)); // Unit: 0, rows: 5-9, unload(2), load(0, 1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_NO_THROW(readerMock.seek(10););
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 1, rows: 0-2, unload(0), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+}
+
+TEST(PrefetchUnitLoaderTests, InitialSkip) {
+  PrefetchUnitLoaderFactory factory(inlineExecutor(), 1, 1'000, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 15};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+
+  EXPECT_TRUE(readerMock.read(5)); // Unit: 1, rows: 5-9, load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_THAT(
+      [&]() { ReaderMock{{10, 20, 30}, {0, 0, 0}, factory, 61}; },
+      Throws<facebook::velox::VeloxRuntimeError>(Property(
+          &facebook::velox::VeloxRuntimeError::message,
+          HasSubstr("Can only skip up to the past-the-end row of the file."))));
+}
+
+TEST(PrefetchUnitLoaderTests, UnitOutOfRange) {
+  PrefetchUnitLoaderFactory factory(inlineExecutor(), 1, 1'000, nullptr);
+  std::vector<std::atomic_bool> unitsLoaded(getUnitsLoadedWithFalse(1));
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  units.push_back(std::make_unique<LoadUnitMock>(10, 0, unitsLoaded, 0));
+
+  auto unitLoader = factory.create(std::move(units), 0);
+  unitLoader->getLoadedUnit(0);
+  unitLoader->getLoadedUnit(0);
+  EXPECT_THAT(
+      [&]() { unitLoader->getLoadedUnit(1); },
+      Throws<facebook::velox::VeloxRuntimeError>(Property(
+          &facebook::velox::VeloxRuntimeError::message,
+          HasSubstr("Unit out of range"))));
+}
+
+TEST(PrefetchUnitLoaderTests, LoadsOnExecutor) {
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  PrefetchUnitLoaderFactory factory(executor, 3, 1'000, nullptr);
+  std::vector<uint64_t> rowsPerUnit(20, 10);
+  std::vector<uint64_t> ioSizes(20, 100);
+  ReaderMock readerMock{rowsPerUnit, ioSizes, factory, 0};
+  for (auto i = 0; i < 20; ++i) {
+    EXPECT_TRUE(readerMock.read(10));
+    EXPECT_TRUE(readerMock.unitsLoaded()[i]);
+  }
+  EXPECT_FALSE(readerMock.read(10));
+}
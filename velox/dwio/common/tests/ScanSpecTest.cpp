@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ScanSpec.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::common {
+namespace {
+
+// Runs 'numBatches' batches of a field read by a struct reader. Each lazy
+// batch is loaded if 'load' is true. Returns the number of eager batches.
+int32_t runBatches(ScanSpec& spec, int32_t numBatches, bool load) {
+  int32_t numEager = 0;
+  for (auto i = 0; i < numBatches; ++i) {
+    spec.updateEagerLoad();
+    if (spec.eagerLoad()) {
+      ++numEager;
+      continue;
+    }
+    spec.addLazyBatch();
+    if (load) {
+      spec.addLoadedLazyBatch();
+    }
+  }
+  return numEager;
+}
+
+TEST(ScanSpecTest, eagerLoad) {
+  ScanSpec spec("c0");
+  EXPECT_EQ(0, runBatches(spec, ScanSpec::kLoadRatioWindow, true));
+
+  // All lazy batches were loaded, so the following batches are eager except
+  // for the sampled ones.
+  EXPECT_EQ(
+      ScanSpec::kLazySampleInterval - 1,
+      runBatches(spec, ScanSpec::kLazySampleInterval, true));
+  EXPECT_EQ(
+      2 * (ScanSpec::kLazySampleInterval - 1),
+      runBatches(spec, 2 * ScanSpec::kLazySampleInterval, true));
+
+  // The sampled lazy batches stop being loaded. The ratio drops below
+  // kEagerLoadRatio after 5 samples and all batches are lazy again.
+  EXPECT_EQ(
+      5 * (ScanSpec::kLazySampleInterval - 1),
+      runBatches(spec, 5 * ScanSpec::kLazySampleInterval, false));
+  EXPECT_EQ(0, runBatches(spec, ScanSpec::kLoadRatioWindow, false));
+
+  // A field that is loaded in some batches only stays lazy.
+  ScanSpec sometimes("c1");
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_EQ(0, runBatches(sometimes, 2, true));
+    EXPECT_EQ(0, runBatches(sometimes, 2, false));
+  }
+}
+
+TEST(ScanSpecTest, moveAdaptationFrom) {
+  ScanSpec first("<root>");
+  first.addField("c0", 0);
+  runBatches(*first.childByName("c0"), ScanSpec::kLoadRatioWindow, true);
+
+  // The next split continues with the load ratio of the previous one.
+  ScanSpec second("<root>");
+  second.addField("c0", 0);
+  second.moveAdaptationFrom(first);
+  second.childByName("c0")->updateEagerLoad();
+  EXPECT_TRUE(second.childByName("c0")->eagerLoad());
+}
+
+} // namespace
+} // namespace facebook::velox::common
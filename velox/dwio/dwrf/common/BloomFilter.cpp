@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <cstring>
+
+#include <folly/lang/Bits.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+
+constexpr uint64_t kC1 = 0x87c37b91114253d5UL;
+constexpr uint64_t kC2 = 0x4cf5ad432745937fUL;
+constexpr uint64_t kSeed = 104729;
+
+inline uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t mixKey(uint64_t key) {
+  return rotateLeft(key * kC1, 31) * kC2;
+}
+
+inline uint64_t fmix64(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdUL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53UL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Right shift that keeps the sign like '>>' on a Java long.
+inline uint64_t shiftRightSigned(uint64_t value, int32_t shift) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) >> shift);
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(int32_t numHashFunctions, std::vector<uint64_t> bitset)
+    : numHashFunctions_{numHashFunctions}, bitset_{std::move(bitset)} {
+  VELOX_CHECK_GT(numHashFunctions_, 0);
+  VELOX_CHECK(!bitset_.empty());
+}
+
+// static
+std::unique_ptr<BloomFilter> BloomFilter::create(
+    const proto::BloomFilter& proto) {
+  std::vector<uint64_t> bitset;
+  if (proto.has_utf8bitset()) {
+    const auto& bytes = proto.utf8bitset();
+    bitset.resize(bytes.size() / sizeof(uint64_t));
+    std::memcpy(bitset.data(), bytes.data(), bitset.size() * sizeof(uint64_t));
+    for (auto& word : bitset) {
+      word = folly::Endian::little(word);
+    }
+  } else {
+    bitset.assign(proto.bitset().begin(), proto.bitset().end());
+  }
+  if (bitset.empty() || proto.numhashfunctions() == 0) {
+    return nullptr;
+  }
+  return std::make_unique<BloomFilter>(
+      proto.numhashfunctions(), std::move(bitset));
+}
+
+template <typename Func>
+bool BloomFilter::forEachBit(uint64_t hash, Func func) const {
+  const auto hash1 = static_cast<int32_t>(hash);
+  const auto hash2 = static_cast<int32_t>(hash >> 32);
+  const auto numBits = bitset_.size() * 64;
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    // 32 bit arithmetic that wraps around like in the writer.
+    auto combined = static_cast<int32_t>(
+        static_cast<uint32_t>(hash1) +
+        static_cast<uint32_t>(i) * static_cast<uint32_t>(hash2));
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    if (!func(static_cast<uint64_t>(combined) % numBits)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BloomFilter::addHash(uint64_t hash) {
+  forEachBit(hash, [&](uint64_t bit) {
+    bitset_[bit / 64] |= 1UL << (bit % 64);
+    return true;
+  });
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  return forEachBit(hash, [&](uint64_t bit) {
+    return (bitset_[bit / 64] & (1UL << (bit % 64))) != 0;
+  });
+}
+
+// static
+uint64_t BloomFilter::hash(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key = key ^ shiftRightSigned(key, 24);
+  key = (key + (key << 3)) + (key << 8);
+  key = key ^ shiftRightSigned(key, 14);
+  key = (key + (key << 2)) + (key << 4);
+  key = key ^ shiftRightSigned(key, 28);
+  key = key + (key << 31);
+  return key;
+}
+
+// static
+uint64_t BloomFilter::hash(std::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const auto length = value.size();
+  uint64_t hash = kSeed;
+  const auto numBlocks = length / 8;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    uint64_t key;
+    std::memcpy(&key, data + i * 8, sizeof(key));
+    hash ^= mixKey(folly::Endian::little(key));
+    hash = rotateLeft(hash, 27) * 5 + 0x52dce729;
+  }
+  const auto tail = numBlocks * 8;
+  if (tail < length) {
+    uint64_t key = 0;
+    for (auto i = length; i > tail; --i) {
+      key = (key << 8) | data[i - 1];
+    }
+    hash ^= mixKey(key);
+  }
+  hash ^= length;
+  return fmix64(hash);
+}
+
+} // namespace facebook::velox::dwrf
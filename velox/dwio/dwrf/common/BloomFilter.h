@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+// Bloom filter of a row group in the BLOOM_FILTER_UTF8 streams of ORC files.
+// Integers are hashed with Thomas Wang's 64 bit integer hash and strings with
+// the 64 bit variant of Murmur3 used by ORC.
+class BloomFilter {
+ public:
+  BloomFilter(int32_t numHashFunctions, std::vector<uint64_t> bitset);
+
+  // Makes a filter from 'proto'. The bits are taken from 'utf8bitset' if set
+  // and from 'bitset' otherwise. Returns nullptr if 'proto' has no bits or
+  // hash functions.
+  static std::unique_ptr<BloomFilter> create(const proto::BloomFilter& proto);
+
+  // Sets the bits for 'hash'.
+  void addHash(uint64_t hash);
+
+  // Returns false if no value with 'hash' was added.
+  bool testHash(uint64_t hash) const;
+
+  const std::vector<uint64_t>& bitset() const {
+    return bitset_;
+  }
+
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(std::string_view value);
+
+ private:
+  // Calls 'func' with the index of each bit for 'hash' until it returns false.
+  template <typename Func>
+  bool forEachBit(uint64_t hash, Func func) const;
+
+  const int32_t numHashFunctions_;
+  std::vector<uint64_t> bitset_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -68,6 +68,12 @@ enum StreamKind {
   StreamKind_IN_MAP = 11
 };
 
+// ORC stripe footers are read with the DWRF protos, so ORC streams have the
+// DWRF kind with the same number. The ORC kinds after ROW_INDEX differ from
+// the DWRF ones.
+constexpr StreamKind StreamKindOrc_BLOOM_FILTER_UTF8 =
+    StreamKind_STRIDE_DICTIONARY;
+
 inline bool isIndexStream(StreamKind kind) {
   return kind == StreamKind::StreamKind_ROW_INDEX ||
       kind == StreamKind::StreamKind_BLOOM_FILTER_UTF8;
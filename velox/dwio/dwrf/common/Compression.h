@@ -58,18 +58,20 @@ inline CompressionOptions getDwrfOrcCompressionOptions(
  * @param bufferHolder Buffer holder that handles buffer allocation and
  * collection
  * @param config The compression options to use
+ * @param compressionLevel If set, overrides the zlib or zstd level in config
  */
 inline std::unique_ptr<dwio::common::BufferedOutputStream> createCompressor(
     common::CompressionKind kind,
     CompressionBufferPool& bufferPool,
     dwio::common::DataBufferHolder& bufferHolder,
     const Config& config,
-    const dwio::common::encryption::Encrypter* encrypter = nullptr) {
+    const dwio::common::encryption::Encrypter* encrypter = nullptr,
+    std::optional<int32_t> compressionLevel = std::nullopt) {
   CompressionOptions dwrfOrcCompressionOptions = getDwrfOrcCompressionOptions(
       kind,
       config.get(Config::COMPRESSION_THRESHOLD),
-      config.get(Config::ZLIB_COMPRESSION_LEVEL),
-      config.get(Config::ZSTD_COMPRESSION_LEVEL));
+      compressionLevel.value_or(config.get(Config::ZLIB_COMPRESSION_LEVEL)),
+      compressionLevel.value_or(config.get(Config::ZSTD_COMPRESSION_LEVEL)));
   auto compressor = createCompressor(kind, dwrfOrcCompressionOptions);
   if (!compressor) {
     if (!encrypter && kind == common::CompressionKind::CompressionKind_NONE) {
@@ -37,6 +37,38 @@ Config::Entry<int32_t> Config::ZSTD_COMPRESSION_LEVEL(
     "hive.exec.orc.compress.zstd.level",
     7);
 
+Config::Entry<const std::map<uint32_t, int32_t>> Config::COMPRESSION_LEVEL_COLS(
+    "orc.compress.level.cols",
+    {},
+    [](const std::map<uint32_t, int32_t>& val) {
+      std::vector<std::string> pairs;
+      pairs.reserve(val.size());
+      for (const auto& [column, level] : val) {
+        pairs.push_back(fmt::format("{}:{}", column, level));
+      }
+      return folly::join(",", pairs);
+    },
+    [](const std::string& /* key */, const std::string& val) {
+      std::map<uint32_t, int32_t> result;
+      std::vector<folly::StringPiece> pieces;
+      folly::split(',', val, pieces, true);
+      for (const auto& p : pieces) {
+        const auto& pair = folly::trimWhitespace(p);
+        if (pair.empty()) {
+          continue;
+        }
+        folly::StringPiece column;
+        folly::StringPiece level;
+        VELOX_USER_CHECK(
+            folly::split(':', pair, column, level),
+            "Invalid column compression level: {}",
+            pair);
+        result[folly::to<uint32_t>(folly::trimWhitespace(column))] =
+            folly::to<int32_t>(folly::trimWhitespace(level));
+      }
+      return result;
+    });
+
 Config::Entry<uint64_t> Config::COMPRESSION_BLOCK_SIZE{
     "hive.exec.orc.compress.size",
     256 * 1024};
@@ -75,6 +107,10 @@ Config::Entry<uint32_t> Config::DICTIONARY_ENCODING_INTERVAL{
     "hive.exec.orc.encoding.interval",
     30};
 
+Config::Entry<uint32_t> Config::DICTIONARY_EARLY_EVALUATION_ROWS{
+    "orc.dictionary.early.evaluation.rows",
+    0};
+
 Config::Entry<bool> Config::USE_VINTS{"hive.exec.orc.use.vints", true};
 
 Config::Entry<float> Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD{
@@ -33,6 +33,11 @@ class Config : public common::ConfigBase<Config> {
   static Entry<common::CompressionKind> COMPRESSION;
   static Entry<int32_t> ZLIB_COMPRESSION_LEVEL;
   static Entry<int32_t> ZSTD_COMPRESSION_LEVEL;
+  /// Compression levels of top level columns, given as comma separated
+  /// 'column:level' pairs. Overrides the zlib or zstd level of the streams of
+  /// these columns. The file has a single codec, so levels are all that can
+  /// vary by column.
+  static Entry<const std::map<uint32_t, int32_t>> COMPRESSION_LEVEL_COLS;
   static Entry<uint64_t> COMPRESSION_BLOCK_SIZE;
   static Entry<uint64_t> COMPRESSION_BLOCK_SIZE_MIN;
   static Entry<float> COMPRESSION_BLOCK_SIZE_EXTEND_RATIO;
@@ -43,6 +48,9 @@ class Config : public common::ConfigBase<Config> {
   static Entry<StripeCacheMode> STRIPE_CACHE_MODE;
   static Entry<uint32_t> STRIPE_CACHE_SIZE;
   static Entry<uint32_t> DICTIONARY_ENCODING_INTERVAL;
+  /// Number of rows of the first stripe after which inefficient dictionary
+  /// encodings are abandoned instead of waiting for a flush. 0 disables.
+  static Entry<uint32_t> DICTIONARY_EARLY_EVALUATION_ROWS;
   static Entry<bool> USE_VINTS;
   static Entry<float> DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD;
   static Entry<float> DICTIONARY_STRING_KEY_SIZE_THRESHOLD;
@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <folly/lang/Bits.h>
+
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -62,6 +65,10 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     skipPending();
+    if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
 
@@ -100,6 +107,106 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
+             !hasFilter &&
+            !hasHook >
+                (nulls,
+                 rowsAsRange,
+                 *innerVector,
+                 *outerVector,
+                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                 tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          this->template skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        this->template skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Decodes the values at 'nonNullRows' into the values of 'visitor' and
+  // passes them to its filter and hook in one run.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto values = visitor.rawValues(numRows);
+    auto filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    bulkReadRows<Visitor::dense>(rows, numRows, values);
+    visitor.template processRun<hasFilter, hasHook, scatter>(
+        values, numRows, scatterRows, filterHits, values, numValues);
+    visitor.setNumValues(hasFilter ? numValues : numAllRows);
+  }
+
+  // Reads the values at 'rows' into 'result'. 'rows' are relative to the
+  // next unread value and are 0 to 'numRows - 1' if 'dense'. 64 bit values
+  // of dense rows are decoded in place, others go through a small buffer.
+  template <bool dense, typename T>
+  void bulkReadRows(const int32_t* rows, int32_t numRows, T* result) {
+    if constexpr (dense && std::is_same_v<T, int64_t>) {
+      doNext(result, numRows, nullptr);
+    } else {
+      constexpr int32_t kBatchSize = 64;
+      int64_t buffer[kBatchSize];
+      const int32_t lastRow = dense ? numRows - 1 : rows[numRows - 1];
+      int32_t position = 0;
+      int32_t i = 0;
+      while (i < numRows) {
+        const int32_t firstRow = dense ? i : rows[i];
+        if (firstRow > position) {
+          this->template skip<false>(firstRow - position, 0, nullptr);
+        }
+        const int32_t numRead =
+            std::min<int32_t>(kBatchSize, lastRow - firstRow + 1);
+        doNext(buffer, numRead, nullptr);
+        position = firstRow + numRead;
+        for (; i < numRows && (dense ? i : rows[i]) < position; ++i) {
+          result[i] = buffer[(dense ? i : rows[i]) - firstRow];
+        }
+      }
+    }
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap = static_cast<uint64_t>(unpackedPatch[patchIdx]) >> patchBitSize;
@@ -159,9 +266,14 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
-
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
+    const uint64_t end = offset + len;
+    for (uint64_t i = offset; i < end; i++) {
+      if (bitsLeft == 0) {
+        ret += unpackLongs(data, i, end, fb, nulls);
+        if (i == end) {
+          break;
+        }
+      }
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
         continue;
@@ -189,6 +301,47 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Unpacks the values of 'fb' bits from position 'i' to 'end' that start at
+  // a byte boundary in the buffer with a big endian word load per value. Stops
+  // before a value whose word would extend past the buffer and leaves the
+  // partially read byte in 'curByte'. Returns the number of values read and
+  // advances 'i' past them and the nulls between them.
+  uint64_t unpackLongs(
+      int64_t* data,
+      uint64_t& i,
+      uint64_t end,
+      uint64_t fb,
+      const uint64_t* nulls) {
+    auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+    const auto* start = reinterpret_cast<const uint8_t*>(bufferStart);
+    const uint64_t available =
+        dwio::common::IntDecoder<isSigned>::bufferEnd - bufferStart;
+    uint64_t bitOffset = 0;
+    uint64_t ret = 0;
+    for (; i < end; ++i) {
+      if (nulls && bits::isBitNull(nulls, i)) {
+        continue;
+      }
+      const auto byte = bitOffset / 8;
+      if (byte + sizeof(uint64_t) > available) {
+        break;
+      }
+      // 'fb' is at most 56 or else 64 at a byte boundary, so the value is
+      // always within the word.
+      const auto word =
+          folly::Endian::big(folly::loadUnaligned<uint64_t>(start + byte));
+      data[i] = static_cast<int64_t>((word << (bitOffset % 8)) >> (64 - fb));
+      bitOffset += fb;
+      ++ret;
+    }
+    bufferStart += bitOffset / 8;
+    if (bitOffset % 8) {
+      curByte = static_cast<unsigned char>(*bufferStart++);
+      bitsLeft = 8 - bitOffset % 8;
+    }
+    return ret;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
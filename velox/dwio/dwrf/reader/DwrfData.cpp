@@ -17,14 +17,84 @@
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+// Returns the ORC Bloom filter hashes of the values passing 'filter' if
+// 'filter' passes a finite set of non-null integers or strings on a column of
+// 'type'. Returns std::nullopt otherwise.
+std::optional<std::vector<uint64_t>> bloomFilterHashes(
+    const common::Filter& filter,
+    const Type& type) {
+  if (filter.testNull() || type.isDecimal()) {
+    return std::nullopt;
+  }
+  std::vector<uint64_t> hashes;
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT: {
+      std::vector<int64_t> values;
+      switch (filter.kind()) {
+        case common::FilterKind::kBigintRange: {
+          auto* range = filter.as<common::BigintRange>();
+          if (!range->isSingleValue()) {
+            return std::nullopt;
+          }
+          values.push_back(range->lower());
+          break;
+        }
+        case common::FilterKind::kBigintValuesUsingHashTable:
+          values = filter.as<common::BigintValuesUsingHashTable>()->values();
+          break;
+        case common::FilterKind::kBigintValuesUsingBitmask:
+          values = filter.as<common::BigintValuesUsingBitmask>()->values();
+          break;
+        default:
+          return std::nullopt;
+      }
+      for (auto value : values) {
+        hashes.push_back(BloomFilter::hash(value));
+      }
+      return hashes;
+    }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      switch (filter.kind()) {
+        case common::FilterKind::kBytesRange: {
+          auto* range = filter.as<common::BytesRange>();
+          if (!range->isSingleValue()) {
+            return std::nullopt;
+          }
+          hashes.push_back(BloomFilter::hash(std::string_view(range->lower())));
+          return hashes;
+        }
+        case common::FilterKind::kBytesValues:
+          for (const auto& value :
+               filter.as<common::BytesValues>()->values()) {
+            hashes.push_back(BloomFilter::hash(std::string_view(value)));
+          }
+          return hashes;
+        default:
+          return std::nullopt;
+      }
+    default:
+      return std::nullopt;
+  }
+}
+
+} // namespace
+
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    bool readBloomFilter)
     : memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
@@ -47,6 +117,19 @@ DwrfData::DwrfData(
       encodingKey.forKind(proto::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+
+  // Unlike the index, Bloom filters are only read for the filters known when
+  // the reader is made, as they are much larger.
+  if (readBloomFilter && stripe.format() == DwrfFormat::kOrc) {
+    bloomFilterStream_ = stripe.getStream(
+        DwrfStreamIdentifier(
+            encodingKey.node(),
+            encodingKey.sequence(),
+            0,
+            StreamKindOrc_BLOOM_FILTER_UTF8),
+        streamLabels.label(),
+        false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -141,17 +224,24 @@ void DwrfData::filterRowGroups(
     uint64_t rowGroupSize,
     const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
-  if (!index_ && !indexStream_) {
+  auto filter = scanSpec.filter();
+  // The struct readers ask every column. Columns that cannot drop a row
+  // group leave their index unparsed until a seek needs it.
+  if ((!index_ && !indexStream_) ||
+      (!filter && scanSpec.numMetadataFilters() == 0)) {
     return;
   }
   ensureRowGroupIndex();
-  auto filter = scanSpec.filter();
   auto dwrfContext = reinterpret_cast<const StatsContext*>(&writerContext);
   result.totalCount = std::max(result.totalCount, index_->entry_size());
   auto nwords = bits::nwords(result.totalCount);
   if (result.filterResult.size() < nwords) {
     result.filterResult.resize(nwords);
   }
+  std::optional<std::vector<uint64_t>> hashes;
+  if (filter && (bloomFilterStream_ || bloomFilterIndex_)) {
+    hashes = bloomFilterHashes(*filter, *fileType_->type());
+  }
   auto metadataFiltersStartIndex = result.metadataFilterResults.size();
   for (int i = 0; i < scanSpec.numMetadataFilters(); ++i) {
     result.metadataFilterResults.emplace_back(
@@ -168,6 +258,12 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (hashes.has_value() && !testBloomFilter(i, hashes.value())) {
+      VLOG(1) << "Drop stride " << i << " by Bloom filter on "
+              << scanSpec.toString();
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
       if (!testFilter(
@@ -184,4 +280,23 @@ void DwrfData::filterRowGroups(
   }
 }
 
+bool DwrfData::testBloomFilter(
+    uint32_t index,
+    const std::vector<uint64_t>& hashes) {
+  if (bloomFilterStream_) {
+    bloomFilterIndex_ = ProtoUtils::readProto<proto::BloomFilterIndex>(
+        std::move(bloomFilterStream_));
+  }
+  if (index >= static_cast<uint32_t>(bloomFilterIndex_->bloomfilter_size())) {
+    return true;
+  }
+  auto bloomFilter = BloomFilter::create(bloomFilterIndex_->bloomfilter(index));
+  if (!bloomFilter) {
+    return true;
+  }
+  return std::any_of(hashes.begin(), hashes.end(), [&](uint64_t hash) {
+    return bloomFilter->testHash(hash);
+  });
+}
+
 } // namespace facebook::velox::dwrf
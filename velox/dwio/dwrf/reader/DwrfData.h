@@ -36,7 +36,8 @@ class DwrfData : public dwio::common::FormatData {
       std::shared_ptr<const dwio::common::TypeWithId> fileType,
       StripeStreams& stripe,
       const StreamLabels& streamLabels,
-      FlatMapContext flatMapContext);
+      FlatMapContext flatMapContext,
+      bool readBloomFilter = false);
 
   void readNulls(
       vector_size_t numValues,
@@ -93,6 +94,10 @@ class DwrfData : public dwio::common::FormatData {
   }
 
  private:
+  // Returns false if the Bloom filter of row group 'index' shows that no
+  // value with a hash in 'hashes' is in the row group.
+  bool testBloomFilter(uint32_t index, const std::vector<uint64_t>& hashes);
+
   static std::vector<uint64_t> toPositionsInner(
       const proto::RowIndexEntry& entry) {
     return std::vector<uint64_t>(
@@ -105,6 +110,10 @@ class DwrfData : public dwio::common::FormatData {
   std::unique_ptr<ByteRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  // Bloom filters of the row groups. Only read for ORC files and columns
+  // with a filter when the reader is made.
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  std::unique_ptr<proto::BloomFilterIndex> bloomFilterIndex_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
@@ -132,9 +141,13 @@ class DwrfParams : public dwio::common::FormatParams {
 
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
-      const common::ScanSpec& /*scanSpec*/) override {
+      const common::ScanSpec& scanSpec) override {
     return std::make_unique<DwrfData>(
-        type, stripeStreams_, streamLabels_, flatMapContext_);
+        type,
+        stripeStreams_,
+        streamLabels_,
+        flatMapContext_,
+        scanSpec.filter() != nullptr);
   }
 
   StripeStreams& stripeStreams() {
@@ -26,6 +26,7 @@ namespace facebook::velox::dwrf {
 
 using dwio::common::ColumnStatistics;
 using dwio::common::FileFormat;
+using dwio::common::FileMetadata;
 using dwio::common::LogType;
 using dwio::common::Statistics;
 using dwio::common::encryption::DecrypterFactory;
@@ -97,7 +98,8 @@ ReaderBase::ReaderBase(
     FileFormat fileFormat,
     bool fileColumnNamesReadAsLowerCase,
     std::shared_ptr<random::RandomSkipTracker> randomSkip,
-    std::shared_ptr<velox::common::ScanSpec> scanSpec)
+    std::shared_ptr<velox::common::ScanSpec> scanSpec,
+    std::optional<dwio::common::FileMetadataKey> fileMetadataKey)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
@@ -115,11 +117,82 @@ ReaderBase::ReaderBase(
   const auto preloadFile = fileLength_ <= filePreloadThreshold_;
   const uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, footerEstimatedSize_);
-  if (input_->supportSyncLoad()) {
-    input_->enqueue({fileLength_ - readSize, readSize, "footer"});
-    input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
+  bool tailLoaded = false;
+  auto loadTail = [&]() {
+    if (!tailLoaded && input_->supportSyncLoad()) {
+      input_->enqueue({fileLength_ - readSize, readSize, "footer"});
+      input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
+    }
+    tailLoaded = true;
+  };
+  // A small file is loaded whole even if its metadata is cached.
+  if (preloadFile) {
+    loadTail();
   }
+  auto metadata = dwio::common::FileMetadataCache::getOrLoad(
+      fileMetadataKey, [&]() -> std::shared_ptr<const FileMetadata> {
+        loadTail();
+        return readFileMetadata(
+            fileFormat, readSize, fileColumnNamesReadAsLowerCase);
+      });
+  fileMetadata_ = std::dynamic_pointer_cast<const DwrfFileMetadata>(metadata);
+  VELOX_CHECK_NOT_NULL(fileMetadata_, "Cached file metadata is not DWRF");
+  postScript_ = fileMetadata_->postScript;
+  psLength_ = fileMetadata_->psLength;
+  footer_ = std::make_unique<FooterWrapper>(*fileMetadata_->footer);
+  schema_ = fileMetadata_->lowerCaseNames == fileColumnNamesReadAsLowerCase
+      ? fileMetadata_->schema
+      : std::dynamic_pointer_cast<const RowType>(
+            convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
+
+  const uint64_t footerSize = postScript_->footerLength();
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
+
+  // load stripe index/footer cache
+  if (cacheSize > 0) {
+    VELOX_CHECK_EQ(format(), DwrfFormat::kDwrf);
+    const uint64_t cacheOffset = fileLength_ - tailSize;
+    if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(cacheOffset, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      auto cacheBuffer =
+          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      input_->read(cacheOffset, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    const auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes > 0) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
 
+std::shared_ptr<const DwrfFileMetadata> ReaderBase::readFileMetadata(
+    FileFormat fileFormat,
+    uint64_t readSize,
+    bool fileColumnNamesReadAsLowerCase) {
+  auto metadata = std::make_shared<DwrfFileMetadata>();
+  metadata->arena = std::make_unique<google::protobuf::Arena>();
   // TODO: read footer from spectrum
   {
     const void* buf;
@@ -138,11 +211,11 @@ ReaderBase::ReaderBase(
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   }
 
   const uint64_t footerSize = postScript_->footerLength();
@@ -174,59 +247,27 @@ ReaderBase::ReaderBase(
   auto footerStream = input_->read(
       fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+    auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(
+        metadata->arena.get());
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    metadata->footer = std::make_unique<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+        metadata->arena.get());
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    metadata->footer = std::make_unique<FooterWrapper>(footer);
   }
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    VELOX_CHECK_EQ(format(), DwrfFormat::kDwrf);
-    const uint64_t cacheOffset = fileLength_ - tailSize;
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(cacheOffset, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
-      input_->read(cacheOffset, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
-  }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    const auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes > 0) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  metadata->postScript = postScript_;
+  metadata->psLength = psLength_;
+  metadata->lowerCaseNames = fileColumnNamesReadAsLowerCase;
+  metadata->schema = std::dynamic_pointer_cast<const RowType>(
+      convertType(*metadata->footer, 0, fileColumnNamesReadAsLowerCase));
+  VELOX_CHECK_NOT_NULL(metadata->schema, "invalid schema");
+  return metadata;
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
@@ -32,6 +32,23 @@ namespace facebook::velox::dwrf {
 
 class ReaderBase;
 
+/// The parsed tail of a DWRF or ORC file. Shared by the readers of the file
+/// through dwio::common::FileMetadataCache.
+struct DwrfFileMetadata : public dwio::common::FileMetadata {
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::shared_ptr<const PostScript> postScript;
+  // Wraps a footer allocated in 'arena'.
+  std::unique_ptr<FooterWrapper> footer;
+  uint64_t psLength{0};
+  // The file schema and whether its names were converted to lower case.
+  RowTypePtr schema;
+  bool lowerCaseNames{false};
+
+  uint64_t estimatedBytes() const override {
+    return sizeof(*this) + arena->SpaceUsed();
+  }
+};
+
 class FooterStatisticsImpl : public dwio::common::Statistics {
  private:
   std::vector<std::unique_ptr<dwio::common::ColumnStatistics>> colStats_;
@@ -73,7 +90,9 @@ class ReaderBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       bool fileColumnNamesReadAsLowerCase = false,
       std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr,
-      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr);
+      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr,
+      std::optional<dwio::common::FileMetadataKey> fileMetadataKey =
+          std::nullopt);
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -247,9 +266,18 @@ class ReaderBase {
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
+  // Reads and parses the post script and footer. 'readSize' bytes at the end
+  // of the file are already loaded.
+  std::shared_ptr<const DwrfFileMetadata> readFileMetadata(
+      dwio::common::FileFormat fileFormat,
+      uint64_t readSize,
+      bool fileColumnNamesReadAsLowerCase);
+
   memory::MemoryPool& pool_;
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
+  // Keeps the possibly shared post script and footer alive.
+  std::shared_ptr<const DwrfFileMetadata> fileMetadata_;
+  std::shared_ptr<const PostScript> postScript_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
@@ -43,6 +43,20 @@ SelectiveStringDirectColumnReader::SelectiveStringDirectColumnReader(
       encodingKey.forKind(proto::Stream_Kind_DATA),
       params.streamLabels().label(),
       true);
+  mayUseStreamBuffer_ = true;
+}
+
+bool SelectiveStringDirectColumnReader::pinStreamBuffer(
+    const char* data,
+    int32_t length) {
+  auto buffer = blobStream_->lastBuffer();
+  if (!buffer || data < buffer->as<char>() ||
+      data + length > buffer->as<char>() + buffer->size()) {
+    return false;
+  }
+  streamBuffer_ = buffer.get();
+  stringBuffers_.push_back(std::move(buffer));
+  return true;
 }
 
 uint64_t SelectiveStringDirectColumnReader::skip(uint64_t numValues) {
@@ -71,6 +85,13 @@ void SelectiveStringDirectColumnReader::extractCrossBuffers(
     auto size = lengths[i];
     auto value = readValue(size);
     current += size + gap;
+    if (size > StringView::kInlineSize &&
+        referenceStreamBuffer(value.data(), size)) {
+      auto index = scatter ? outerNonNullRows_[rowIndex + i] : numValues_++;
+      reinterpret_cast<StringView*>(rawValues_)[index] =
+          StringView(value.data(), size);
+      continue;
+    }
     if (!scatter) {
       addValue(value);
     } else {
@@ -284,6 +305,11 @@ inline bool SelectiveStringDirectColumnReader::try8Consecutive(
           reinterpret_cast<char*>(result + resultIndex + 1) + length) = 0;
       continue;
     }
+    if (referenceStreamBuffer(data, length)) {
+      *reinterpret_cast<const char**>(result + resultIndex + 2) = data;
+      data += length;
+      continue;
+    }
     if (!rawStringBuffer_ || rawUsed + length > rawStringSize_) {
       // Slow path if no space in raw strings
       return false;
@@ -51,6 +51,7 @@ class SelectiveStringDirectColumnReader
     rawStringBuffer_ = nullptr;
     rawStringSize_ = 0;
     rawStringUsed_ = 0;
+    streamBuffer_ = nullptr;
     getFlatValues<StringView, StringView>(rows, result, requestedType());
   }
 
@@ -60,6 +61,19 @@ class SelectiveStringDirectColumnReader
 
   folly::StringPiece readValue(int32_t length);
 
+  // Returns true if the 'length' bytes at 'data' can be referenced by the
+  // result instead of copied, i.e. they are in a buffer of 'blobStream_' that
+  // is kept alive by 'stringBuffers_'.
+  bool referenceStreamBuffer(const char* data, int32_t length) {
+    if (streamBuffer_ && data >= streamBuffer_->as<char>() &&
+        data + length <= streamBuffer_->as<char>() + streamBuffer_->size()) {
+      return true;
+    }
+    return mayUseStreamBuffer_ && pinStreamBuffer(data, length);
+  }
+
+  bool pinStreamBuffer(const char* data, int32_t length);
+
   template <bool hasNulls, typename Visitor>
   void decode(const uint64_t* nulls, Visitor visitor);
 
@@ -100,6 +114,8 @@ class SelectiveStringDirectColumnReader
   // Storage for a string straddling a buffer boundary. Needed for calling
   // the filter.
   std::string tempString_;
+  // The last buffer of 'blobStream_' added to 'stringBuffers_'.
+  const Buffer* streamBuffer_{nullptr};
 };
 
 } // namespace facebook::velox::dwrf
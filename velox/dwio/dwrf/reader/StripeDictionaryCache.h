@@ -51,6 +51,11 @@ class StripeDictionaryCache {
 
   BufferPtr getIntDictionary(const EncodingKey& ek);
 
+  // Returns true if a dictionary is registered for 'ek'.
+  bool hasIntDictionary(const EncodingKey& ek) const {
+    return intDictionaryFactories_.count(ek) > 0;
+  }
+
  private:
   // This is typically the reader's memory pool.
   memory::MemoryPool* pool_;
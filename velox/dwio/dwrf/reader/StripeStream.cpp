@@ -115,6 +115,15 @@ StripeStreamsBase::getIntDictionaryInitializerForNode(
   auto dictionarySize = getEncoding(localEk).dictionarysize();
   // Try fetching shared dictionary streams instead.
   if (!dataStream) {
+    localEk = EncodingKey(ek.node(), 0);
+    dictData = localEk.forKind(proto::Stream_Kind_DICTIONARY_DATA);
+    // The dictionary shared by the keys of a flat map is read once for all of
+    // them.
+    if (stripeDictionaryCache_->hasIntDictionary(localEk)) {
+      return [&dictCache = *stripeDictionaryCache_, localEk]() {
+        return dictCache.getIntDictionary(localEk);
+      };
+    }
     // Get the label of the top level column, since this dictionary is shared by
     // the entire column
     auto label = streamLabels.label();
@@ -123,8 +132,6 @@ StripeStreamsBase::getIntDictionaryInitializerForNode(
       // Ex: "/5/1759392083" -> "/5"
       label = label.substr(0, label.find('/', 1));
     }
-    localEk = EncodingKey(ek.node(), 0);
-    dictData = localEk.forKind(proto::Stream_Kind_DICTIONARY_DATA);
     dataStream = getStream(dictData, label, false);
   }
   bool dictVInts = getUseVInts(dictData);
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <gtest/gtest.h>
+
+#include <folly/lang/Bits.h>
+
+using namespace facebook::velox::dwrf;
+
+TEST(BloomFilterTest, addAndTest) {
+  BloomFilter bloomFilter(3, std::vector<uint64_t>(64));
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter.addHash(BloomFilter::hash(i * 7));
+    bloomFilter.addHash(BloomFilter::hash(std::to_string(i * 7)));
+  }
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(bloomFilter.testHash(BloomFilter::hash(i * 7)));
+    EXPECT_TRUE(
+        bloomFilter.testHash(BloomFilter::hash(std::to_string(i * 7))));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    numFalsePositives +=
+        bloomFilter.testHash(BloomFilter::hash(i * 7 + 1'000'000));
+    numFalsePositives += bloomFilter.testHash(
+        BloomFilter::hash(std::to_string(i * 7 + 1'000'000)));
+  }
+  EXPECT_LT(numFalsePositives, 200);
+}
+
+TEST(BloomFilterTest, stringHashUsesAllBytes) {
+  // Lengths around the 8 byte blocks of the hash.
+  std::string value = "abcdefghijklmnopq";
+  for (size_t size = 0; size < value.size(); ++size) {
+    const auto hash = BloomFilter::hash(std::string_view(value.data(), size));
+    for (size_t i = 0; i < size; ++i) {
+      auto other = value.substr(0, size);
+      other[i] = 'z';
+      EXPECT_NE(hash, BloomFilter::hash(std::string_view(other)));
+    }
+  }
+}
+
+TEST(BloomFilterTest, fromProto) {
+  BloomFilter bloomFilter(4, std::vector<uint64_t>(16));
+  for (int64_t i = 0; i < 20; ++i) {
+    bloomFilter.addHash(BloomFilter::hash(i));
+  }
+
+  proto::BloomFilter bitset;
+  bitset.set_numhashfunctions(4);
+  for (auto word : bloomFilter.bitset()) {
+    bitset.add_bitset(word);
+  }
+
+  proto::BloomFilter utf8;
+  utf8.set_numhashfunctions(4);
+  std::string bytes;
+  for (auto word : bloomFilter.bitset()) {
+    const auto little = folly::Endian::little(word);
+    bytes.append(reinterpret_cast<const char*>(&little), sizeof(little));
+  }
+  utf8.set_utf8bitset(bytes);
+
+  for (const auto* proto : {&bitset, &utf8}) {
+    auto copy = BloomFilter::create(*proto);
+    ASSERT_NE(copy, nullptr);
+    EXPECT_EQ(copy->bitset(), bloomFilter.bitset());
+    for (int64_t i = 0; i < 20; ++i) {
+      EXPECT_TRUE(copy->testHash(BloomFilter::hash(i)));
+    }
+  }
+
+  proto::BloomFilter empty;
+  empty.set_numhashfunctions(4);
+  EXPECT_EQ(BloomFilter::create(empty), nullptr);
+}
@@ -19,6 +19,7 @@
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/RemoteCache.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
@@ -29,6 +30,7 @@
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include <fcntl.h>
+#include <map>
 #include <gtest/gtest.h>
 
 using namespace facebook::velox;
@@ -40,6 +42,85 @@ using facebook::velox::common::Region;
 using memory::MemoryAllocator;
 using IoStatisticsPtr = std::shared_ptr<IoStatistics>;
 
+namespace {
+// In-memory RemoteCache that keeps a copy of each stored entry.
+class TestRemoteCache : public RemoteCache {
+ public:
+  std::vector<bool> load(folly::Range<const CachePin*> pins) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++numLoads_;
+    if (fail_) {
+      VELOX_FAIL("Remote cache unavailable");
+    }
+    std::vector<bool> found;
+    for (const auto& pin : pins) {
+      auto* entry = pin.checkedEntry();
+      auto it = entries_.find({entry->key().fileNum.id(), entry->offset()});
+      found.push_back(
+          it != entries_.end() && it->second.size() >= entry->size());
+      if (found.back()) {
+        copy(*entry, it->second.data(), true);
+      }
+    }
+    return found;
+  }
+
+  void store(folly::Range<const CachePin*> pins) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& pin : pins) {
+      auto* entry = pin.checkedEntry();
+      std::string data(entry->size(), 0);
+      copy(*entry, data.data(), false);
+      entries_[{entry->key().fileNum.id(), entry->offset()}] = std::move(data);
+    }
+  }
+
+  std::string toString() const override {
+    return "TestRemoteCache";
+  }
+
+  void setFail(bool fail) {
+    std::lock_guard<std::mutex> l(mutex_);
+    fail_ = fail;
+  }
+
+  int32_t numLoads() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numLoads_;
+  }
+
+  size_t numEntries() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  // Copies between 'entry' and 'data'. Fills 'entry' if 'toEntry' is true.
+  static void copy(AsyncDataCacheEntry& entry, char* data, bool toEntry) {
+    if (entry.tinyData() != nullptr) {
+      toEntry ? ::memcpy(entry.tinyData(), data, entry.size())
+              : ::memcpy(data, entry.tinyData(), entry.size());
+      return;
+    }
+    int64_t offset = 0;
+    for (auto i = 0; i < entry.data().numRuns() && offset < entry.size();
+         ++i) {
+      auto run = entry.data().runAt(i);
+      const auto bytes =
+          std::min<int64_t>(run.numBytes(), entry.size() - offset);
+      toEntry ? ::memcpy(run.data<char>(), data + offset, bytes)
+              : ::memcpy(data + offset, run.data<char>(), bytes);
+      offset += bytes;
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::map<std::pair<uint64_t, uint64_t>, std::string> entries_;
+  bool fail_{false};
+  int32_t numLoads_{0};
+};
+} // namespace
+
 class CacheTest : public ::testing::Test {
  protected:
   static constexpr int32_t kMaxStreams = 50;
@@ -869,6 +950,38 @@ TEST_F(CacheTest, loadQuotumTooLarge) {
       "Load quantum exceeded SSD cache entry size limit");
 }
 
+TEST_F(CacheTest, remoteCache) {
+  initializeCache(64 << 20);
+  auto remoteCache = std::make_shared<TestRemoteCache>();
+  cache_->setRemoteCache(remoteCache);
+  deterministic_ = true;
+
+  // Cold read. Misses RAM and the remote cache and fills both.
+  readLoop("testfile", 30, 70, 10, 10, 1, /*noCacheRetention=*/false, ioStats_);
+  ASSERT_GT(remoteCache->numLoads(), 0);
+  ASSERT_GT(remoteCache->numEntries(), 0);
+  ASSERT_GT(ioStats_->read().sum(), 0);
+  ASSERT_EQ(ioStats_->remoteCacheRead().sum(), 0);
+
+  // The same reads with an empty RAM cache are served by the remote cache.
+  // The verify hook checks the data of each entry.
+  cache_->testingClear();
+  auto remoteStats = std::make_shared<IoStatistics>();
+  readLoop(
+      "testfile", 30, 70, 10, 10, 1, /*noCacheRetention=*/false, remoteStats);
+  ASSERT_GT(remoteStats->remoteCacheRead().sum(), 0);
+  ASSERT_LT(remoteStats->read().sum(), ioStats_->read().sum());
+
+  // A failing remote cache falls back to storage.
+  cache_->testingClear();
+  remoteCache->setFail(true);
+  auto failStats = std::make_shared<IoStatistics>();
+  readLoop(
+      "testfile", 30, 70, 10, 10, 1, /*noCacheRetention=*/false, failStats);
+  ASSERT_EQ(failStats->remoteCacheRead().sum(), 0);
+  ASSERT_GT(failStats->read().sum(), 0);
+}
+
 TEST_F(CacheTest, ssdReadVerification) {
   constexpr int64_t kMemoryBytes = 32 << 20;
   constexpr int64_t kSsdBytes = 256 << 20;
@@ -26,6 +26,7 @@
 #include "velox/common/compression/Compression.h"
 
 #include <algorithm>
+#include <deque>
 
 using namespace ::testing;
 using namespace facebook::velox::common;
@@ -241,6 +242,54 @@ TEST_P(CompressionTest, compressRandomBytes) {
       memSink, kind_, block, testData, dataSize, *pool_, decrypter_);
 }
 
+TEST_P(CompressionTest, lastBuffer) {
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+
+  uint64_t block = 1024;
+  constexpr size_t dataSize = 64 * 1024;
+  std::vector<char> testData(dataSize);
+  generateRandomData(testData.data(), dataSize, true);
+  compressAndVerify(
+      kind_, memSink, block, *pool_, testData.data(), dataSize, encrypter_);
+
+  auto decompressStream = createDecompressor(
+      kind_,
+      std::make_unique<SeekableArrayInputStream>(
+          memSink.data(), memSink.size()),
+      block,
+      *pool_,
+      "Test Compression",
+      decrypter_);
+
+  // Holding the buffers must keep the returned ranges intact while the stream
+  // decompresses the next blocks.
+  std::vector<facebook::velox::BufferPtr> buffers;
+  std::vector<std::string_view> ranges;
+  std::deque<std::string> copies;
+  const char* data;
+  int32_t size;
+  while (decompressStream->Next(reinterpret_cast<const void**>(&data), &size)) {
+    if (auto buffer = decompressStream->lastBuffer()) {
+      ASSERT_GE(data, buffer->as<char>());
+      ASSERT_LE(data + size, buffer->as<char>() + buffer->size());
+      buffers.push_back(std::move(buffer));
+      ranges.emplace_back(data, size);
+    } else {
+      ranges.emplace_back(copies.emplace_back(data, size));
+    }
+  }
+  if (kind_ == CompressionKind_NONE) {
+    ASSERT_TRUE(buffers.empty());
+    return;
+  }
+  ASSERT_FALSE(buffers.empty());
+  std::string actual;
+  for (auto range : ranges) {
+    actual.append(range);
+  }
+  ASSERT_EQ(actual, std::string_view(testData.data(), dataSize));
+}
+
 void verifyProto(
     const MemorySink& memSink,
     CompressionKind kind,
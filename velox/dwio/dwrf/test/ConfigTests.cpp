@@ -66,6 +66,17 @@ TEST(ConfigTests, BoolConfig) {
   EXPECT_TRUE(config.get(Config::CREATE_INDEX));
 }
 
+TEST(ConfigTests, CompressionLevelCols) {
+  auto config = Config::fromMap({{"orc.compress.level.cols", "1:3, 2:19"}});
+  std::map<uint32_t, int32_t> expected{{1, 3}, {2, 19}};
+  EXPECT_EQ(config->get(Config::COMPRESSION_LEVEL_COLS), expected);
+  EXPECT_TRUE(Config::fromMap({})->get(Config::COMPRESSION_LEVEL_COLS).empty());
+  VELOX_ASSERT_THROW(
+      Config::fromMap({{"orc.compress.level.cols", "1"}})
+          ->get(Config::COMPRESSION_LEVEL_COLS),
+      "");
+}
+
 struct ConfigTestParams {
   std::string inputCols{""}; // input spec
   std::vector<uint32_t> expectedCols{}; // do we expect the spec to be valid
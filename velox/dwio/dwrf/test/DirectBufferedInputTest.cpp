@@ -186,3 +186,39 @@ TEST_F(DirectBufferedInputTest, basic) {
   // in one part.
   testLoads({{1000, 9000000}, {9010000, 1000000}}, 3);
 }
+
+TEST(IoStatisticsTest, coalesceDistance) {
+  constexpr int32_t kDefault = 512 << 10;
+  IoStatistics stats;
+  // Reads of 10ms latency at 100 bytes per microsecond. Reading 1MB takes as
+  // long as the latency of a request.
+  const auto readUs = [](uint64_t bytes) { return 10'000 + bytes / 100; };
+  for (auto i = 0; i < 15; ++i) {
+    const uint64_t bytes = (i + 1) << 20;
+    stats.recordStorageRead(bytes, readUs(bytes));
+  }
+  // Too few reads.
+  EXPECT_EQ(stats.coalesceDistance(kDefault), kDefault);
+  stats.recordStorageRead(16 << 20, readUs(16 << 20));
+  EXPECT_NEAR(stats.coalesceDistance(kDefault), 1'000'000, 1'000);
+
+  // A fast local storage is clamped to the minimum distance.
+  IoStatistics local;
+  for (auto i = 0; i < 100; ++i) {
+    const uint64_t bytes = (i + 1) << 16;
+    local.recordStorageRead(bytes, 2 + bytes / 2'000);
+  }
+  EXPECT_EQ(
+      local.coalesceDistance(kDefault), IoStatistics::kMinCoalesceDistance);
+
+  // Reads of the same size do not tell latency from transfer time.
+  IoStatistics sameSize;
+  for (auto i = 0; i < 100; ++i) {
+    sameSize.recordStorageRead(1 << 20, readUs(1 << 20));
+  }
+  EXPECT_EQ(sameSize.coalesceDistance(kDefault), kDefault);
+
+  // Merging combines the reads.
+  sameSize.merge(stats);
+  EXPECT_NEAR(sameSize.coalesceDistance(kDefault), 1'000'000, 10'000);
+}
@@ -948,6 +948,59 @@ TEST_F(E2EWriterTest, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTest, earlyDictionaryEvaluation) {
+  // The first 1'000 rows are distinct and the rest repeat a single value, so
+  // the dictionary is only inefficient when evaluated after the first rows.
+  constexpr vector_size_t kBatchSize = 1'000;
+  constexpr int32_t kNumBatches = 20;
+  auto type = ROW({"c0"}, {BIGINT()});
+  VectorMaker maker{leafPool_.get()};
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    batches.push_back(maker.rowVector({maker.flatVector<int64_t>(
+        kBatchSize, [&](auto row) { return i == 0 ? row : 0; })}));
+  }
+
+  auto encodingKind = [&](uint32_t earlyEvaluationRows) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(
+        dwrf::Config::DICTIONARY_EARLY_EVALUATION_ROWS, earlyEvaluationRows);
+    auto sink = std::make_unique<MemorySink>(
+        2 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    RowReaderOptions rowReaderOpts;
+    auto reader = createReader(*sinkPtr, readerOpts);
+    EXPECT_EQ(reader->getNumberOfStripes(), 1);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto dwrfRowReader = dynamic_cast<dwrf::DwrfRowReader*>(rowReader.get());
+    bool preload = true;
+    auto stripeMetadata = dwrfRowReader->fetchStripe(0, preload);
+    auto& footer = *stripeMetadata->footer;
+    for (auto i = 0; i < footer.encoding_size(); ++i) {
+      if (footer.encoding(i).node() == 1) {
+        return footer.encoding(i).kind();
+      }
+    }
+    VELOX_FAIL("No encoding for column c0");
+  };
+
+  EXPECT_EQ(encodingKind(0), dwrf::proto::ColumnEncoding_Kind_DICTIONARY);
+  EXPECT_EQ(encodingKind(kBatchSize), dwrf::proto::ColumnEncoding_Kind_DIRECT);
+}
+
 TEST_F(E2EWriterTest, OversizeRows) {
   auto pool = facebook::velox::memory::memoryManager()->addLeafPool();
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/hash/Hash.h>
+#include <folly/init/Init.h>
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+constexpr size_t kNumValues = 1'000'000;
+constexpr size_t kBatchSize = 1'024;
+
+// Encodes 'kNumValues' pseudo random values of 'width' bits as RLEv2 DIRECT
+// runs of 512 values. 'widthIndex' is the encoded width of 'width'.
+std::vector<char> encodeDirect(int32_t widthIndex, int32_t width) {
+  std::vector<char> bytes;
+  for (size_t start = 0; start < kNumValues; start += 512) {
+    const auto runLength = std::min<size_t>(512, kNumValues - start);
+    bytes.push_back((1 << 6) | (widthIndex << 1) | ((runLength - 1) >> 8));
+    bytes.push_back((runLength - 1) & 0xff);
+    uint64_t bitsUsed = 0;
+    for (auto i = start; i < start + runLength; ++i) {
+      auto value = folly::hash::twang_mix64(i);
+      if (width < 64) {
+        value &= (1UL << width) - 1;
+      }
+      for (int32_t bit = width - 1; bit >= 0; --bit) {
+        if (bitsUsed % 8 == 0) {
+          bytes.push_back(0);
+        }
+        bytes.back() |= ((value >> bit) & 1) << (7 - bitsUsed % 8);
+        ++bitsUsed;
+      }
+    }
+  }
+  return bytes;
+}
+
+void decodeDirect(uint32_t iters, int32_t widthIndex, int32_t width) {
+  std::vector<char> bytes;
+  BENCHMARK_SUSPEND {
+    bytes = encodeDirect(widthIndex, width);
+  }
+  auto pool = memory::memoryManager()->addLeafPool();
+  std::vector<int64_t> values(kBatchSize);
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto decoder = createRleDecoder<false>(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            bytes.data(), bytes.size()),
+        RleVersion_2,
+        *pool,
+        true,
+        dwio::common::INT_BYTE_SIZE);
+    for (size_t row = 0; row < kNumValues; row += kBatchSize) {
+      const auto numRows = std::min(kBatchSize, kNumValues - row);
+      decoder->next(values.data(), numRows, nullptr);
+    }
+    folly::doNotOptimizeAway(values);
+  }
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(decodeDirect, width1, 0, 1);
+BENCHMARK_NAMED_PARAM(decodeDirect, width7, 6, 7);
+BENCHMARK_NAMED_PARAM(decodeDirect, width8, 7, 8);
+BENCHMARK_NAMED_PARAM(decodeDirect, width13, 12, 13);
+BENCHMARK_NAMED_PARAM(decodeDirect, width16, 15, 16);
+BENCHMARK_NAMED_PARAM(decodeDirect, width24, 23, 24);
+BENCHMARK_NAMED_PARAM(decodeDirect, width32, 27, 32);
+BENCHMARK_NAMED_PARAM(decodeDirect, width48, 29, 48);
+BENCHMARK_NAMED_PARAM(decodeDirect, width64, 31, 64);
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  folly::runBenchmarks();
+  return 0;
+}
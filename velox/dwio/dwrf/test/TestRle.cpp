@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/hash/Hash.h>
 #include <gtest/gtest.h>
 
 #include "velox/common/base/Nulls.h"
@@ -673,6 +674,72 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+TEST_F(RLEv2Test, directAllBitWidths) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  const std::vector<uint32_t> widths = {1,  2,  3,  4,  5,  6,  7,  8,  9,
+                                        10, 11, 12, 13, 14, 15, 16, 17, 18,
+                                        19, 20, 21, 22, 23, 24, 26, 28, 30,
+                                        32, 40, 48, 56, 64};
+  const size_t count = 1'000;
+  // Every fourth value is null and takes no space in the stream.
+  std::vector<uint64_t> nulls(bits::nwords(count), bits::kNotNull64);
+  for (size_t i = 0; i < count; i += 4) {
+    bits::setNull(nulls.data(), i);
+  }
+  for (auto widthIndex = 0; widthIndex < widths.size(); ++widthIndex) {
+    const auto width = widths[widthIndex];
+    std::vector<uint64_t> encoded;
+    for (size_t i = 0; i < count; ++i) {
+      auto value = folly::hash::twang_mix64(i * 31 + width);
+      encoded.push_back(width == 64 ? value : value & ((1UL << width) - 1));
+    }
+    // Writes DIRECT runs of up to 512 values packed most significant bit
+    // first.
+    std::vector<unsigned char> bytes;
+    for (size_t start = 0; start < count; start += 512) {
+      const auto runLength = std::min<size_t>(512, count - start);
+      bytes.push_back(
+          (1 << 6) | (widthIndex << 1) | ((runLength - 1) >> 8));
+      bytes.push_back((runLength - 1) & 0xff);
+      uint64_t bitsUsed = 0;
+      for (auto i = start; i < start + runLength; ++i) {
+        for (int32_t bit = width - 1; bit >= 0; --bit) {
+          if (bitsUsed % 8 == 0) {
+            bytes.push_back(0);
+          }
+          bytes.back() |= ((encoded[i] >> bit) & 1) << (7 - bitsUsed % 8);
+          ++bitsUsed;
+        }
+      }
+    }
+
+    for (const uint64_t blockSize : {0, 13}) {
+      for (const bool withNulls : {false, true}) {
+        auto rle = createRleDecoder<true>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                bytes.data(), bytes.size(), blockSize),
+            RleVersion_2,
+            *pool,
+            true /* doesn't matter */,
+            dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+        const auto* rowNulls = withNulls ? nulls.data() : nullptr;
+        std::vector<int64_t> data(count);
+        rle->next(data.data(), count, rowNulls);
+        size_t next = 0;
+        for (size_t i = 0; i < count; ++i) {
+          if (rowNulls && bits::isBitNull(rowNulls, i)) {
+            continue;
+          }
+          const auto value = encoded[next++];
+          ASSERT_EQ(
+              data[i], static_cast<int64_t>((value >> 1) ^ -(value & 1)))
+              << "width " << width << " row " << i;
+        }
+      }
+    }
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
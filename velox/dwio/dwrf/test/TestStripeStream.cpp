@@ -722,8 +722,9 @@ TEST_F(StripeStreamTest, shareDictionary) {
       .WillOnce(Return(&sharedDictionaryEncoding2_21));
   char sharedDictBuffer[2048];
   size_t sharedDictBufferSize = writeRange(sharedDictBuffer, 100, 200);
+  // The shared dictionary is fetched once for all keys.
   EXPECT_CALL(ss, getStreamProxy(2, 0, proto::Stream_Kind_DICTIONARY_DATA, _))
-      .WillRepeatedly(InvokeWithoutArgs([&]() {
+      .WillOnce(InvokeWithoutArgs([&]() {
         return new SeekableArrayInputStream(
             sharedDictBuffer, sharedDictBufferSize);
       }));
@@ -18,7 +18,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "folly/Random.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
 
 using namespace ::testing;
 using namespace facebook::velox::dwio::common;
@@ -511,3 +513,33 @@ TEST_F(WriterSinkTest, SetModeOutOfOrder) {
   sink.addBuffer(*pool, data.data(), 10);
   ASSERT_EQ(sink.getChecksum()->getDigest(false), 977966233);
 }
+
+TEST_F(WriterSinkTest, flushOnExecutor) {
+  auto pool = memoryManager()->addLeafPool();
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(1);
+  std::string file;
+  WriteFileSink out{
+      std::make_unique<facebook::velox::InMemoryWriteFile>(&file), "test"};
+  Config config;
+  config.set(Config::CHECKSUM_ALGORITHM, proto::ChecksumAlgorithm::NULL_);
+  config.set(Config::STRIPE_CACHE_MODE, StripeCacheMode::NA);
+  WriterSink sink{out, *pool, config};
+  sink.init(*pool);
+
+  std::string expected{"ORC"};
+  for (auto i = 0; i < 10; ++i) {
+    sink.addBuffer(*pool, data.data(), data.size());
+    expected.append(data.data(), data.size());
+    sink.flush(executor.get());
+    ASSERT_EQ(sink.size(), expected.size());
+  }
+  sink.waitForPendingWrite();
+  ASSERT_EQ(out.size(), expected.size());
+  ASSERT_EQ(file, expected);
+
+  // A flush without an executor writes inline.
+  sink.addBuffer(*pool, data.data(), data.size());
+  expected.append(data.data(), data.size());
+  sink.flush();
+  ASSERT_EQ(file, expected);
+}
@@ -24,6 +24,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
+#include "velox/dwio/dwrf/common/Statistics.h"
 #include "velox/dwio/dwrf/utils/ProtoUtils.h"
 #include "velox/dwio/dwrf/writer/FlushPolicy.h"
 #include "velox/dwio/dwrf/writer/LayoutPlanner.h"
@@ -63,7 +64,8 @@ Writer::Writer(
     : writerBase_(std::make_unique<WriterBase>(std::move(sink))),
       schema_{dwio::common::TypeWithId::create(options.schema)},
       spillConfig_{options.spillConfig},
-      nonReclaimableSection_(options.nonReclaimableSection) {
+      nonReclaimableSection_(options.nonReclaimableSection),
+      flushExecutor_{options.flushExecutor} {
   VELOX_CHECK(
       spillConfig_ == nullptr || nonReclaimableSection_ != nullptr,
       "nonReclaimableSection_ must be set if writer memory reclaim is enabled");
@@ -84,6 +86,7 @@ Writer::Writer(
   writerBase_->initBuffers();
 
   context.buildPhysicalSizeAggregators(*schema_);
+  context.buildCompressionLevels(*schema_);
   if (options.flushPolicyFactory == nullptr) {
     flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
         context.stripeSizeFlushThreshold(),
@@ -203,6 +206,7 @@ void Writer::write(const VectorPtr& input) {
         input, common::Ranges::of(rowOffset, rowOffset + numRowsToWrite));
     rowOffset += numRowsToWrite;
     context.incRawSize(rawSize);
+    maybeEvaluateDictionariesEarly(context);
 
     if (context.indexEnabled() &&
         context.indexRowCount() >= context.indexStride()) {
@@ -211,6 +215,22 @@ void Writer::write(const VectorPtr& input) {
   }
 }
 
+void Writer::maybeEvaluateDictionariesEarly(const WriterContext& context) {
+  if (earlyDictionaryEvaluated_) {
+    return;
+  }
+  if (context.stripeIndex() > 0) {
+    earlyDictionaryEvaluated_ = true;
+    return;
+  }
+  const auto rows = context.getConfig(Config::DICTIONARY_EARLY_EVALUATION_ROWS);
+  if (rows == 0 || context.stripeRowCount() < rows) {
+    return;
+  }
+  earlyDictionaryEvaluated_ = true;
+  writer_->tryAbandonDictionaries(/*force=*/false);
+}
+
 bool Writer::canReclaim() const {
   return spillConfig_ != nullptr;
 }
@@ -659,7 +679,7 @@ void Writer::flushInternal(bool close) {
     }
 
     // flush to sink
-    sink.flush();
+    sink.flush(close ? nullptr : flushExecutor_.get());
   }
 
   if (close) {
@@ -708,6 +728,25 @@ void Writer::abort() {
   writerBase_->abort();
 }
 
+std::vector<std::unique_ptr<dwio::common::ColumnStatistics>>
+Writer::columnStatistics() const {
+  VELOX_CHECK_EQ(state(), State::kClosed, "Writer is not closed");
+  // The footer has the statistics of each node of the schema, indexed by
+  // node id.
+  const auto& footer = writerBase_->getFooter();
+  const StatsContext statsContext(
+      getContext().getConfig(Config::WRITER_VERSION));
+  std::vector<std::unique_ptr<dwio::common::ColumnStatistics>> stats;
+  stats.reserve(schema_->size());
+  for (uint32_t i = 0; i < schema_->size(); ++i) {
+    const auto id = schema_->childAt(i)->id();
+    VELOX_CHECK_LT(id, footer.statistics_size());
+    stats.push_back(buildColumnStatisticsFromProto(
+        ColumnStatisticsWrapper(&footer.statistics(id)), statsContext));
+  }
+  return stats;
+}
+
 std::unique_ptr<memory::MemoryReclaimer> Writer::MemoryReclaimer::create(
     Writer* writer) {
   return std::unique_ptr<memory::MemoryReclaimer>(
@@ -786,6 +825,8 @@ uint64_t Writer::MemoryReclaimer::reclaim(
           } else {
             if (usedBytes >= writer_->spillConfig_->writerFlushThresholdSize) {
               writer_->flushInternal(false);
+              // The stripe memory is only released once it is written out.
+              writer_->writerBase_->getSink().waitForPendingWrite();
             }
           }
         }
@@ -47,6 +47,10 @@ struct WriterOptions {
   std::shared_ptr<encryption::EncryptionSpecification> encryptionSpec;
   std::shared_ptr<dwio::common::encryption::EncrypterFactory> encrypterFactory;
   int64_t memoryBudget = std::numeric_limits<int64_t>::max();
+  /// If set, a flushed stripe is written to the file sink on this executor
+  /// while the writer encodes the next stripe. The file footer is always
+  /// written inline.
+  std::shared_ptr<folly::Executor> flushExecutor;
   std::function<std::unique_ptr<ColumnWriter>(
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
@@ -87,6 +91,9 @@ class Writer : public dwio::common::Writer {
 
   virtual void abort() override;
 
+  std::vector<std::unique_ptr<dwio::common::ColumnStatistics>>
+  columnStatistics() const override;
+
   void setLowMemoryMode();
 
   uint64_t flushTimeMemoryUsageEstimate(
@@ -197,6 +204,11 @@ class Writer : public dwio::common::Writer {
 
   void flushStripe(bool close);
 
+  // Abandons inefficient dictionary encodings once the first stripe has
+  // DICTIONARY_EARLY_EVALUATION_ROWS rows. The decision carries over to the
+  // later stripes.
+  void maybeEvaluateDictionariesEarly(const WriterContext& context);
+
   void createRowIndexEntry() {
     writer_->createIndexEntry();
     writerBase_->getContext().resetIndexRowCount();
@@ -211,6 +223,8 @@ class Writer : public dwio::common::Writer {
   std::unique_ptr<DWRFFlushPolicy> flushPolicy_;
   std::unique_ptr<LayoutPlanner> layoutPlanner_;
   std::unique_ptr<ColumnWriter> writer_;
+  const std::shared_ptr<folly::Executor> flushExecutor_;
+  bool earlyDictionaryEvaluated_{false};
 };
 
 class DwrfWriterFactory : public dwio::common::WriterFactory {
@@ -87,6 +87,11 @@ class WriterContext : public CompressionBufferPool {
         ? std::addressof(
               handler_->getEncryptionProvider(stream.encodingKey().node()))
         : nullptr;
+    auto level = nodeCompressionLevels_.find(stream.encodingKey().node());
+    if (level != nodeCompressionLevels_.end()) {
+      return createCompressor(
+          compression_, *this, holder, *config_, encrypter, level->second);
+    }
     return newStream(compression_, holder, encrypter);
   }
 
@@ -480,6 +485,22 @@ class WriterContext : public CompressionBufferPool {
     return flushTiming_;
   }
 
+  // Assigns the levels in COMPRESSION_LEVEL_COLS to all the nodes of the
+  // respective top level columns of 'schema'.
+  void buildCompressionLevels(const velox::dwio::common::TypeWithId& schema) {
+    for (const auto& [column, level] :
+         getConfig(Config::COMPRESSION_LEVEL_COLS)) {
+      VELOX_USER_CHECK_LT(
+          column,
+          schema.size(),
+          "Compression level set for non-existent column");
+      const auto& child = schema.childAt(column);
+      for (auto node = child->id(); node <= child->maxId(); ++node) {
+        nodeCompressionLevels_[node] = level;
+      }
+    }
+  }
+
   void buildPhysicalSizeAggregators(
       const velox::dwio::common::TypeWithId& type,
       PhysicalSizeAggregator* parent = nullptr) {
@@ -621,6 +642,8 @@ class WriterContext : public CompressionBufferPool {
   const uint32_t indexStride_;
   const common::CompressionKind compression_;
   const uint64_t compressionBlockSize_;
+  // Compression level overrides by node id.
+  folly::F14FastMap<uint32_t, int32_t> nodeCompressionLevels_;
   const bool shareFlatMapDictionaries_;
   const uint64_t stripeSizeFlushThreshold_;
   const uint64_t dictionarySizeFlushThreshold_;
@@ -59,6 +59,36 @@ void WriterSink::addBuffer(dwio::common::DataBuffer<char> buffer) {
   }
 }
 
+void WriterSink::flush(folly::Executor* executor) {
+  waitForPendingWrite();
+  if (executor == nullptr || buffers_.empty()) {
+    sink_->write(buffers_);
+    buffers_.clear();
+    size_ = 0;
+    return;
+  }
+  pendingSize_ = size();
+  pendingBuffers_ = std::move(buffers_);
+  buffers_.clear();
+  size_ = 0;
+  pendingWrite_ = folly::via(executor, [this]() {
+    sink_->write(pendingBuffers_);
+    pendingBuffers_.clear();
+  });
+}
+
+void WriterSink::waitForPendingWrite() {
+  if (!pendingWrite_.has_value()) {
+    return;
+  }
+  auto pendingWrite = std::move(pendingWrite_.value());
+  pendingWrite_.reset();
+  pendingWrite.wait();
+  // The buffers are not cleared if the write failed.
+  pendingBuffers_.clear();
+  pendingWrite.value();
+}
+
 void WriterSink::init(memory::MemoryPool& pool) {
   VELOX_CHECK(!initialized_);
   VELOX_CHECK(offsets_.empty());
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/Array.h>
+#include <folly/futures/Future.h>
 
 #include "velox/dwio/common/DataBufferHolder.h"
 #include "velox/dwio/dwrf/common/Checksum.h"
@@ -53,6 +55,11 @@ class WriterSink {
         exceedsLimit_{false} {}
 
   ~WriterSink() {
+    try {
+      waitForPendingWrite();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed background write in writer sink: " << e.what();
+    }
     if (!buffers_.empty() || size_ != 0) {
       LOG(WARNING) << "Unflushed data in writer sink: " << succinctBytes(size_)
                    << ", " << buffers_.size() << " buffers";
@@ -60,7 +67,8 @@ class WriterSink {
   }
 
   uint64_t size() const {
-    return sink_->size() + size_;
+    // The file sink must not be read while a background write updates it.
+    return (pendingWrite_.has_value() ? pendingSize_ : sink_->size()) + size_;
   }
 
   void init(memory::MemoryPool& pool);
@@ -81,11 +89,15 @@ class WriterSink {
     other.clear();
   }
 
-  void flush() {
-    sink_->write(buffers_);
-    buffers_.clear();
-    size_ = 0;
-  }
+  /// Writes the buffered data to the file sink. If 'executor' is not null,
+  /// the write runs on it and the caller can buffer the next stripe in the
+  /// meantime. At most one write is in flight, so the buffered data of at most
+  /// two stripes is held in memory.
+  void flush(folly::Executor* executor = nullptr);
+
+  /// Waits for the write started by the last flush on an executor, if any.
+  /// Rethrows its error.
+  void waitForPendingWrite();
 
   Checksum* getChecksum() {
     return checksum_.get();
@@ -182,6 +194,12 @@ class WriterSink {
   bool exceedsLimit_;
 
   std::vector<dwio::common::DataBuffer<char>> buffers_;
+
+  // The buffers being written on an executor and the file size once they are
+  // written.
+  std::vector<dwio::common::DataBuffer<char>> pendingBuffers_;
+  std::optional<folly::Future<folly::Unit>> pendingWrite_;
+  uint64_t pendingSize_{0};
 };
 
 } // namespace facebook::velox::dwrf
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Upper bound on the size of a serialized BloomFilterHeader.
+constexpr uint64_t kMaxHeaderSize = 64;
+
+// Bloom filters larger than this are not read.
+constexpr int32_t kMaxBloomFilterSize = 128 << 20;
+
+template <typename T>
+bool appendIntegerHashes(
+    const std::vector<int64_t>& values,
+    std::vector<uint64_t>& hashes) {
+  for (auto value : values) {
+    if (value < std::numeric_limits<T>::min() ||
+        value > std::numeric_limits<T>::max()) {
+      // The value may be stored with a different logical interpretation, e.g.
+      // as unsigned, so do not rule it out.
+      return false;
+    }
+    hashes.push_back(BloomFilter::hash(static_cast<T>(value)));
+  }
+  return true;
+}
+
+std::optional<std::vector<int64_t>> integerValues(
+    const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = filter.as<common::BigintRange>();
+      if (range->isSingleValue()) {
+        return std::vector<int64_t>{range->lower()};
+      }
+      return std::nullopt;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      return filter.as<common::BigintValuesUsingHashTable>()->values();
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return filter.as<common::BigintValuesUsingBitmask>()->values();
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<std::vector<uint64_t>> bytesHashes(const common::Filter& filter) {
+  std::vector<uint64_t> hashes;
+  switch (filter.kind()) {
+    case common::FilterKind::kBytesRange: {
+      auto* range = filter.as<common::BytesRange>();
+      if (!range->isSingleValue()) {
+        return std::nullopt;
+      }
+      hashes.push_back(BloomFilter::hash(std::string_view(range->lower())));
+      return hashes;
+    }
+    case common::FilterKind::kBytesValues: {
+      const auto& values = filter.as<common::BytesValues>()->values();
+      hashes.reserve(values.size());
+      for (const auto& value : values) {
+        hashes.push_back(BloomFilter::hash(std::string_view(value)));
+      }
+      return hashes;
+    }
+    default:
+      return std::nullopt;
+  }
+}
+
+// A Bloom filter to read and the values to look up in it.
+struct BloomFilterProbe {
+  // Index in the row group ids given to testBloomFilters().
+  int32_t rowGroupIndex;
+  // Offset of the BloomFilterHeader in the file.
+  uint64_t offset;
+  // Hashes of the values passing the filter on the column.
+  const std::vector<uint64_t>* hashes;
+  std::unique_ptr<dwio::common::SeekableInputStream> stream;
+  // Size of the bitset and offset of its first byte in the file. Set after
+  // the header is read. 'numBytes' is 0 if the Bloom filter is not usable.
+  int32_t numBytes{0};
+  uint64_t bitsetOffset{0};
+};
+
+// Reads the header of 'probe' from its stream and sets the location of the
+// bitset. Leaves 'numBytes' 0 if the Bloom filter is not supported.
+void readBloomFilterHeader(BloomFilterProbe& probe, uint64_t fileLength) {
+  const auto size = std::min(kMaxHeaderSize, fileLength - probe.offset);
+  char buffer[kMaxHeaderSize];
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      size, probe.stream.get(), buffer, bufferStart, bufferEnd);
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      buffer, static_cast<uint64_t>(size));
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const auto headerSize = header.read(&protocol);
+  probe.stream.reset();
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % BloomFilter::kBytesPerBlock != 0 ||
+      header.numBytes > kMaxBloomFilterSize ||
+      probe.offset + headerSize + header.numBytes > fileLength) {
+    return;
+  }
+  probe.numBytes = header.numBytes;
+  probe.bitsetOffset = probe.offset + headerSize;
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(int32_t numBytes) {
+  VELOX_CHECK_GT(numBytes, 0);
+  VELOX_CHECK_EQ(numBytes % kBytesPerBlock, 0);
+  bitset_.resize(numBytes / sizeof(uint32_t));
+}
+
+BloomFilter::BloomFilter(const char* data, int32_t numBytes)
+    : BloomFilter(numBytes) {
+  std::memcpy(bitset_.data(), data, numBytes);
+}
+
+void BloomFilter::insertHash(uint64_t hash) {
+  SplitBlockBloomFilter::insert(bitset_.data(), numBlocks(), hash);
+}
+
+bool BloomFilter::findHash(uint64_t hash) const {
+  return SplitBlockBloomFilter::mayContain(bitset_.data(), numBlocks(), hash);
+}
+
+// static
+uint64_t BloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+std::optional<std::vector<uint64_t>> bloomFilterHashes(
+    const common::Filter& filter,
+    thrift::Type::type physicalType) {
+  if (filter.testNull()) {
+    return std::nullopt;
+  }
+  switch (physicalType) {
+    case thrift::Type::INT32:
+    case thrift::Type::INT64: {
+      auto values = integerValues(filter);
+      if (!values.has_value()) {
+        return std::nullopt;
+      }
+      std::vector<uint64_t> hashes;
+      hashes.reserve(values->size());
+      const bool ok = physicalType == thrift::Type::INT32
+          ? appendIntegerHashes<int32_t>(*values, hashes)
+          : appendIntegerHashes<int64_t>(*values, hashes);
+      if (!ok) {
+        return std::nullopt;
+      }
+      return hashes;
+    }
+    case thrift::Type::BYTE_ARRAY:
+      return bytesHashes(filter);
+    default:
+      return std::nullopt;
+  }
+}
+
+std::vector<bool> testBloomFilters(
+    const thrift::FileMetaData& fileMetaData,
+    const ParquetTypeWithId& fileSchema,
+    const common::ScanSpec& scanSpec,
+    const std::vector<uint32_t>& rowGroupIds,
+    uint64_t fileLength,
+    dwio::common::BufferedInput& input) {
+  std::vector<bool> result(rowGroupIds.size(), true);
+
+  // Leaf columns with a filter that a Bloom filter can test, with the hashes
+  // of the values passing the filter.
+  std::vector<std::pair<uint32_t, std::vector<uint64_t>>> columns;
+  const auto& rowType = fileSchema.type()->asRow();
+  for (const auto& childSpec : scanSpec.children()) {
+    if (!childSpec->filter() || childSpec->isConstant()) {
+      continue;
+    }
+    auto childIndex = rowType.getChildIdxIfExists(childSpec->fieldName());
+    if (!childIndex.has_value()) {
+      continue;
+    }
+    const auto& child = fileSchema.parquetChildAt(childIndex.value());
+    if (!child.isLeaf() || !child.parquetType_.has_value() ||
+        !(child.type()->isPrimitiveType() && !child.type()->isDecimal())) {
+      continue;
+    }
+    auto hashes =
+        bloomFilterHashes(*childSpec->filter(), child.parquetType_.value());
+    if (hashes.has_value()) {
+      columns.emplace_back(child.column(), std::move(hashes.value()));
+    }
+  }
+  if (columns.empty()) {
+    return result;
+  }
+
+  std::vector<BloomFilterProbe> probes;
+  auto headerInput = input.clone();
+  for (auto i = 0; i < rowGroupIds.size(); ++i) {
+    const auto& rowGroup = fileMetaData.row_groups[rowGroupIds[i]];
+    for (const auto& [column, hashes] : columns) {
+      const auto& metadata = rowGroup.columns[column].meta_data;
+      if (!metadata.__isset.bloom_filter_offset ||
+          metadata.bloom_filter_offset <= 0 ||
+          metadata.bloom_filter_offset >= fileLength) {
+        continue;
+      }
+      BloomFilterProbe probe;
+      probe.rowGroupIndex = i;
+      probe.offset = metadata.bloom_filter_offset;
+      probe.hashes = &hashes;
+      probe.stream = headerInput->enqueue(
+          {probe.offset, std::min(kMaxHeaderSize, fileLength - probe.offset)});
+      probes.push_back(std::move(probe));
+    }
+  }
+  if (probes.empty()) {
+    return result;
+  }
+  headerInput->load(dwio::common::LogType::FOOTER);
+
+  auto bitsetInput = input.clone();
+  for (auto& probe : probes) {
+    readBloomFilterHeader(probe, fileLength);
+    if (probe.numBytes > 0) {
+      probe.stream = bitsetInput->enqueue(
+          {probe.bitsetOffset, static_cast<uint64_t>(probe.numBytes)});
+    }
+  }
+  bitsetInput->load(dwio::common::LogType::FOOTER);
+
+  std::vector<char> bitset;
+  for (auto& probe : probes) {
+    if (probe.numBytes == 0 || !result[probe.rowGroupIndex]) {
+      continue;
+    }
+    bitset.resize(probe.numBytes);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        probe.numBytes,
+        probe.stream.get(),
+        bitset.data(),
+        bufferStart,
+        bufferEnd);
+    BloomFilter bloomFilter(bitset.data(), probe.numBytes);
+    result[probe.rowGroupIndex] = std::any_of(
+        probe.hashes->begin(), probe.hashes->end(), [&](uint64_t hash) {
+          return bloomFilter.findHash(hash);
+        });
+  }
+  return result;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter as specified by Parquet
+/// (https://github.com/apache/parquet-format/blob/master/BloomFilter.md).
+/// Values are hashed with XXH64 of their plain encoding. The bitset is
+/// accessed with SplitBlockBloomFilter.
+class BloomFilter {
+ public:
+  /// Bytes in a block of 8 32-bit words.
+  static constexpr int32_t kBytesPerBlock =
+      SplitBlockBloomFilter::kBytesPerBlock;
+
+  /// Makes an empty filter of 'numBytes' bytes. 'numBytes' must be a positive
+  /// multiple of kBytesPerBlock.
+  explicit BloomFilter(int32_t numBytes);
+
+  /// Makes a filter over the serialized bitset at 'data'.
+  BloomFilter(const char* data, int32_t numBytes);
+
+  /// Sets the bits for 'hash'.
+  void insertHash(uint64_t hash);
+
+  /// Returns false if no value with 'hash' was inserted.
+  bool findHash(uint64_t hash) const;
+
+  /// Hashes of the plain encoding of a value of the given physical type.
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(std::string_view value);
+
+ private:
+  uint32_t numBlocks() const {
+    return bitset_.size() / SplitBlockBloomFilter::kWordsPerBlock;
+  }
+
+  std::vector<uint32_t> bitset_;
+};
+
+/// Returns the Bloom filter hashes of the values passing 'filter' if 'filter'
+/// passes a finite set of non-null values, e.g. equality and IN filters on
+/// integers and strings, of a column of 'physicalType'. Returns std::nullopt
+/// otherwise, in which case the filter cannot be tested with a Bloom filter.
+std::optional<std::vector<uint64_t>> bloomFilterHashes(
+    const common::Filter& filter,
+    thrift::Type::type physicalType);
+
+/// Tests the filters on top level columns of 'scanSpec' against the Bloom
+/// filters of the column chunks in the row groups 'rowGroupIds'. Returns a
+/// flag per entry of 'rowGroupIds', false if a Bloom filter shows that no row
+/// in the row group passes. The Bloom filters are read through a clone of
+/// 'input', loading all headers together and then all bitsets together.
+std::vector<bool> testBloomFilters(
+    const thrift::FileMetaData& fileMetaData,
+    const ParquetTypeWithId& fileSchema,
+    const common::ScanSpec& scanSpec,
+    const std::vector<uint32_t>& rowGroupIds,
+    uint64_t fileLength,
+    dwio::common::BufferedInput& input);
+
+} // namespace facebook::velox::parquet
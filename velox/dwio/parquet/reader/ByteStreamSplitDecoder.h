@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::parquet {
+
+namespace detail {
+
+// Interleaves 4 byte streams a batch of values at a time.
+template <typename A = xsimd::default_arch>
+int32_t
+byteStreamSplit4(const uint8_t* input, int32_t numValues, uint8_t* output) {
+  using Bytes = xsimd::batch<uint8_t, A>;
+  constexpr int32_t kSize = Bytes::size;
+  int32_t i = 0;
+  for (; i + kSize <= numValues; i += kSize) {
+    auto s0 = Bytes::load_unaligned(input + i);
+    auto s1 = Bytes::load_unaligned(input + numValues + i);
+    auto s2 = Bytes::load_unaligned(input + 2 * numValues + i);
+    auto s3 = Bytes::load_unaligned(input + 3 * numValues + i);
+    // Pairs of bytes 0, 1 and 2, 3 of each value.
+    auto low01 = simd::reinterpretBatch<uint16_t>(xsimd::zip_lo(s0, s1));
+    auto high01 = simd::reinterpretBatch<uint16_t>(xsimd::zip_hi(s0, s1));
+    auto low23 = simd::reinterpretBatch<uint16_t>(xsimd::zip_lo(s2, s3));
+    auto high23 = simd::reinterpretBatch<uint16_t>(xsimd::zip_hi(s2, s3));
+    auto* out = reinterpret_cast<uint16_t*>(output + i * 4);
+    constexpr int32_t kStep = kSize / sizeof(uint16_t);
+    xsimd::zip_lo(low01, low23).store_unaligned(out);
+    xsimd::zip_hi(low01, low23).store_unaligned(out + kStep);
+    xsimd::zip_lo(high01, high23).store_unaligned(out + 2 * kStep);
+    xsimd::zip_hi(high01, high23).store_unaligned(out + 3 * kStep);
+  }
+  return i;
+}
+
+// Interleaves 8 byte streams a batch of values at a time.
+template <typename A = xsimd::default_arch>
+int32_t
+byteStreamSplit8(const uint8_t* input, int32_t numValues, uint8_t* output) {
+  using Bytes = xsimd::batch<uint8_t, A>;
+  constexpr int32_t kSize = Bytes::size;
+  int32_t i = 0;
+  for (; i + kSize <= numValues; i += kSize) {
+    Bytes s[8];
+    for (auto k = 0; k < 8; ++k) {
+      s[k] = Bytes::load_unaligned(input + k * numValues + i);
+    }
+    // Pairs of bytes 2k, 2k + 1 for the first and second half of the values.
+    xsimd::batch<uint16_t, A> pairs[2][4];
+    for (auto k = 0; k < 4; ++k) {
+      pairs[0][k] = simd::reinterpretBatch<uint16_t>(
+          xsimd::zip_lo(s[2 * k], s[2 * k + 1]));
+      pairs[1][k] = simd::reinterpretBatch<uint16_t>(
+          xsimd::zip_hi(s[2 * k], s[2 * k + 1]));
+    }
+    auto* out = reinterpret_cast<uint32_t*>(output + i * 8);
+    constexpr int32_t kStep = kSize / sizeof(uint32_t);
+    for (auto half = 0; half < 2; ++half) {
+      // Bytes 0-3 and 4-7 of each value, for the two quarters of 'half'.
+      auto low0123 = simd::reinterpretBatch<uint32_t>(
+          xsimd::zip_lo(pairs[half][0], pairs[half][1]));
+      auto high0123 = simd::reinterpretBatch<uint32_t>(
+          xsimd::zip_hi(pairs[half][0], pairs[half][1]));
+      auto low4567 = simd::reinterpretBatch<uint32_t>(
+          xsimd::zip_lo(pairs[half][2], pairs[half][3]));
+      auto high4567 = simd::reinterpretBatch<uint32_t>(
+          xsimd::zip_hi(pairs[half][2], pairs[half][3]));
+      auto* halfOut = out + half * 4 * kStep;
+      xsimd::zip_lo(low0123, low4567).store_unaligned(halfOut);
+      xsimd::zip_hi(low0123, low4567).store_unaligned(halfOut + kStep);
+      xsimd::zip_lo(high0123, high4567).store_unaligned(halfOut + 2 * kStep);
+      xsimd::zip_hi(high0123, high4567).store_unaligned(halfOut + 3 * kStep);
+    }
+  }
+  return i;
+}
+
+} // namespace detail
+
+/// Decodes 'numValues' values of 'width' bytes in BYTE_STREAM_SPLIT encoding
+/// at 'input' into their PLAIN encoding at 'output'. Byte k of value i is at
+/// input[k * numValues + i]. Widths of 4 and 8 bytes are interleaved with
+/// SIMD.
+inline void decodeByteStreamSplit(
+    const char* input,
+    int32_t numValues,
+    int32_t width,
+    char* output) {
+  const auto* in = reinterpret_cast<const uint8_t*>(input);
+  auto* out = reinterpret_cast<uint8_t*>(output);
+  int32_t numDone = 0;
+  if (width == 4) {
+    numDone = detail::byteStreamSplit4(in, numValues, out);
+  } else if (width == 8) {
+    numDone = detail::byteStreamSplit8(in, numValues, out);
+  }
+  for (auto i = numDone; i < numValues; ++i) {
+    for (auto k = 0; k < width; ++k) {
+      out[i * width + k] = in[k * numValues + i];
+    }
+  }
+}
+
+} // namespace facebook::velox::parquet
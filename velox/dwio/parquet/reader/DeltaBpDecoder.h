@@ -18,6 +18,7 @@
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/BitPackDecoder.h"
 
 namespace facebook::velox::parquet {
 
@@ -43,6 +44,27 @@ class DeltaBpDecoder {
     }
   }
 
+  /// Returns the number of values in the page given by the header.
+  uint64_t numValues() const {
+    return totalValueCount_;
+  }
+
+  /// Reads the next 'numValues' values into 'values'.
+  template <typename T>
+  void readValues(uint64_t numValues, T* values) {
+    for (uint64_t i = 0; i < numValues; ++i) {
+      values[i] = readLong();
+    }
+  }
+
+  /// Returns the first byte after the encoded values. Valid after all
+  /// numValues() values have been read. Used for encodings that store other
+  /// data after DELTA_BINARY_PACKED lengths.
+  const char* dataEnd() const {
+    // Miniblocks are unpacked whole, including the padding of the last one.
+    return bufferStart_;
+  }
+
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     int32_t current = visitor.start();
@@ -157,6 +179,38 @@ class DeltaBpDecoder {
         "delta bit width larger than integer bit width");
     deltaBitWidth_ = bitWidth;
     valuesRemainingCurrentMiniBlock_ = valuesPerMiniBlock_;
+    unpackMiniBlock();
+  }
+
+  // Unpacks the deltas of the current miniblock into 'deltas_' and moves
+  // 'bufferStart_' to the next miniblock. Widths up to 32 bits use the SIMD
+  // kernels of dwio::common::unpack().
+  void unpackMiniBlock() {
+    deltas_.resize(valuesPerMiniBlock_);
+    if (deltaBitWidth_ == 0) {
+      std::fill(deltas_.begin(), deltas_.end(), 0);
+      return;
+    }
+    const auto numBytes = bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+    if (deltaBitWidth_ <= 32) {
+      narrowDeltas_.resize(valuesPerMiniBlock_);
+      auto* input = reinterpret_cast<const uint8_t*>(bufferStart_);
+      auto* output = narrowDeltas_.data();
+      dwio::common::unpack<uint32_t>(
+          input, numBytes, valuesPerMiniBlock_, deltaBitWidth_, output);
+      std::copy(narrowDeltas_.begin(), narrowDeltas_.end(), deltas_.begin());
+    } else {
+      for (uint64_t i = 0; i < valuesPerMiniBlock_; ++i) {
+        deltas_[i] = 0;
+        bits::copyBits(
+            reinterpret_cast<const uint64_t*>(bufferStart_),
+            i * deltaBitWidth_,
+            &deltas_[i],
+            0,
+            deltaBitWidth_);
+      }
+    }
+    bufferStart_ += numBytes;
   }
 
   int64_t readLong() {
@@ -184,26 +238,15 @@ class DeltaBpDecoder {
       }
     }
 
-    uint64_t consumedBits =
-        (valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_) *
-        deltaBitWidth_;
-    bits::copyBits(
-        reinterpret_cast<const uint64_t*>(bufferStart_),
-        consumedBits,
-        reinterpret_cast<uint64_t*>(&value),
-        0,
-        deltaBitWidth_);
+    const auto delta =
+        deltas_[valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_];
     // Addition between minDelta_, packed int and lastValue_ should be treated
     // as unsigned addition. Overflow is as expected.
-    value = static_cast<uint64_t>(minDelta_) + static_cast<uint64_t>(value) +
+    value = static_cast<uint64_t>(minDelta_) + delta +
         static_cast<uint64_t>(lastValue_);
     lastValue_ = value;
     valuesRemainingCurrentMiniBlock_--;
     totalValuesRemaining_--;
-
-    if (valuesRemainingCurrentMiniBlock_ == 0) {
-      bufferStart_ += bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
-    }
     return value;
   }
 
@@ -231,6 +274,11 @@ class DeltaBpDecoder {
   std::vector<uint8_t> deltaBitWidths_;
   uint64_t deltaBitWidth_;
 
+  // Unpacked deltas of the current miniblock.
+  std::vector<uint64_t> deltas_;
+  // Output of unpacking miniblocks of up to 32 bit deltas.
+  std::vector<uint32_t> narrowDeltas_;
+
   int64_t lastValue_;
 };
 
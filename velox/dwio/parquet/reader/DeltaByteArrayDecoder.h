@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+
+namespace facebook::velox::parquet {
+
+// Decodes DELTA_BYTE_ARRAY: the DELTA_BINARY_PACKED lengths of the prefixes
+// shared with the previous value, followed by the suffixes in
+// DELTA_LENGTH_BYTE_ARRAY encoding. All values of the page are reconstructed
+// into one buffer from 'pool' when the decoder is made, so that reads and
+// skips do not depend on the previous value.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(
+      const char* start,
+      const char* end,
+      memory::MemoryPool& pool) {
+    DeltaBpDecoder prefixDecoder(start);
+    const auto numValues = prefixDecoder.numValues();
+    auto prefixLengthsBuffer =
+        AlignedBuffer::allocate<int32_t>(numValues, &pool);
+    auto* prefixLengths = prefixLengthsBuffer->asMutable<int32_t>();
+    prefixDecoder.readValues(numValues, prefixLengths);
+    DeltaLengthByteArrayDecoder suffixes(prefixDecoder.dataEnd(), end, pool);
+    VELOX_CHECK_EQ(
+        suffixes.numValues(),
+        numValues,
+        "DELTA_BYTE_ARRAY prefix and suffix counts differ");
+
+    int64_t totalSize = 0;
+    for (uint64_t i = 0; i < numValues; ++i) {
+      totalSize += prefixLengths[i] + suffixes.valueAt(i).size();
+    }
+    values_ = AlignedBuffer::allocate<char>(totalSize, &pool);
+    offsets_ = AlignedBuffer::allocate<int64_t>(numValues + 1, &pool);
+    auto* values = values_->asMutable<char>();
+    auto* offsets = offsets_->asMutable<int64_t>();
+    offsets[0] = 0;
+    int64_t previousLength = 0;
+    for (uint64_t i = 0; i < numValues; ++i) {
+      const auto prefixLength = prefixLengths[i];
+      VELOX_CHECK(
+          prefixLength >= 0 && prefixLength <= previousLength,
+          "Invalid prefix length in DELTA_BYTE_ARRAY");
+      auto* value = values + offsets[i];
+      // The prefix is copied from the previous value, which ends at 'value'.
+      if (prefixLength > 0) {
+        std::memcpy(value, value - previousLength, prefixLength);
+      }
+      const auto suffix = suffixes.valueAt(i);
+      if (!suffix.empty()) {
+        std::memcpy(value + prefixLength, suffix.data(), suffix.size());
+      }
+      previousLength = prefixLength + suffix.size();
+      offsets[i + 1] = offsets[i] + previousLength;
+    }
+    rawValues_ = values;
+    rawOffsets_ = offsets;
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    index_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  folly::StringPiece readString() {
+    const auto begin = rawOffsets_[index_];
+    const auto end = rawOffsets_[++index_];
+    return folly::StringPiece(rawValues_ + begin, end - begin);
+  }
+
+  // The reconstructed values of the page, concatenated.
+  BufferPtr values_;
+  const char* rawValues_;
+
+  // Offset of each value in 'values_', followed by the total size.
+  BufferPtr offsets_;
+  const int64_t* rawOffsets_;
+
+  // Index of the next value to read.
+  int32_t index_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/buffer/Buffer.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+namespace facebook::velox::parquet {
+
+// Decodes DELTA_LENGTH_BYTE_ARRAY: the DELTA_BINARY_PACKED lengths of all
+// values followed by the concatenated value bytes. The lengths are decoded up
+// front into offsets allocated from 'pool' so that values are read and skipped
+// without parsing.
+class DeltaLengthByteArrayDecoder {
+ public:
+  DeltaLengthByteArrayDecoder(
+      const char* start,
+      const char* end,
+      memory::MemoryPool& pool) {
+    DeltaBpDecoder lengthDecoder(start);
+    numValues_ = lengthDecoder.numValues();
+    offsets_ = AlignedBuffer::allocate<int64_t>(numValues_ + 1, &pool);
+    auto* offsets = offsets_->asMutable<int64_t>();
+    offsets[0] = 0;
+    lengthDecoder.readValues(numValues_, offsets + 1);
+    for (uint64_t i = 1; i <= numValues_; ++i) {
+      VELOX_CHECK_GE(
+          offsets[i], 0, "Negative length in DELTA_LENGTH_BYTE_ARRAY");
+      offsets[i] += offsets[i - 1];
+    }
+    rawOffsets_ = offsets;
+    data_ = lengthDecoder.dataEnd();
+    VELOX_CHECK_LE(
+        rawOffsets_[numValues_],
+        end - data_,
+        "DELTA_LENGTH_BYTE_ARRAY values exceed the page");
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    index_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  // Returns the number of values in the page.
+  uint64_t numValues() const {
+    return numValues_;
+  }
+
+  // Returns the value at 'index' from the start of the page.
+  folly::StringPiece valueAt(int32_t index) const {
+    return folly::StringPiece(
+        data_ + rawOffsets_[index],
+        rawOffsets_[index + 1] - rawOffsets_[index]);
+  }
+
+ private:
+  folly::StringPiece readString() {
+    return valueAt(index_++);
+  }
+
+  // Start of the concatenated values.
+  const char* data_;
+
+  uint64_t numValues_;
+
+  // Offset of each value from 'data_', followed by the total size.
+  BufferPtr offsets_;
+  const int64_t* rawOffsets_;
+
+  // Index of the next value to read.
+  int32_t index_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -228,6 +228,60 @@ int64_t ColumnChunkMetaDataPtr::dictionaryPageOffset() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.dictionary_page_offset;
 }
 
+bool ColumnChunkMetaDataPtr::hasPageIndex() const {
+  const auto* chunk = thriftColumnChunkPtr(ptr_);
+  return chunk->__isset.column_index_offset &&
+      chunk->__isset.column_index_length &&
+      chunk->__isset.offset_index_offset && chunk->__isset.offset_index_length;
+}
+
+std::pair<int64_t, int32_t> ColumnChunkMetaDataPtr::columnIndexRegion() const {
+  VELOX_CHECK(hasPageIndex());
+  const auto* chunk = thriftColumnChunkPtr(ptr_);
+  return {chunk->column_index_offset, chunk->column_index_length};
+}
+
+std::pair<int64_t, int32_t> ColumnChunkMetaDataPtr::offsetIndexRegion() const {
+  VELOX_CHECK(hasPageIndex());
+  const auto* chunk = thriftColumnChunkPtr(ptr_);
+  return {chunk->offset_index_offset, chunk->offset_index_length};
+}
+
+namespace {
+bool isDictionaryDataEncoding(thrift::Encoding::type encoding) {
+  return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+      encoding == thrift::Encoding::RLE_DICTIONARY;
+}
+} // namespace
+
+bool ColumnChunkMetaDataPtr::isDictionaryEncoded() const {
+  if (!hasMetadata()) {
+    return false;
+  }
+  const auto& metadata = thriftColumnChunkPtr(ptr_)->meta_data;
+  if (metadata.__isset.encoding_stats) {
+    for (const auto& stats : metadata.encoding_stats) {
+      if ((stats.page_type == thrift::PageType::DATA_PAGE ||
+           stats.page_type == thrift::PageType::DATA_PAGE_V2) &&
+          stats.count > 0 && !isDictionaryDataEncoding(stats.encoding)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Without encoding stats, PLAIN may be used by the dictionary page or by
+  // data pages that fell back from dictionary encoding, so only accept
+  // dictionary and level encodings.
+  for (auto encoding : metadata.encodings) {
+    if (!isDictionaryDataEncoding(encoding) &&
+        encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return true;
+}
+
 common::CompressionKind ColumnChunkMetaDataPtr::compression() const {
   return thriftCodecToCompressionKind(
       thriftColumnChunkPtr(ptr_)->meta_data.codec);
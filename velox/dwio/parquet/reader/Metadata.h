@@ -21,6 +21,17 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Builds the statistics of a column of 'type' from thrift 'stats' that cover
+/// 'numRows' rows. Used for both ColumnChunk and page index statistics.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& stats,
+    const velox::Type& type,
+    uint64_t numRows);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -52,6 +63,22 @@ class ColumnChunkMetaDataPtr {
   /// Must check for its presence using hasDictionaryPageOffset().
   int64_t dictionaryPageOffset() const;
 
+  /// Check the presence of the page index, i.e. the locations of both the
+  /// ColumnIndex and the OffsetIndex of the ColumnChunk.
+  bool hasPageIndex() const;
+
+  /// The file offset and length of the serialized ColumnIndex.
+  /// Must check for its presence using hasPageIndex().
+  std::pair<int64_t, int32_t> columnIndexRegion() const;
+
+  /// The file offset and length of the serialized OffsetIndex.
+  /// Must check for its presence using hasPageIndex().
+  std::pair<int64_t, int32_t> offsetIndexRegion() const;
+
+  /// True if all data pages of the ColumnChunk are known to be dictionary
+  /// encoded, so that every value is an entry of the dictionary page.
+  bool isDictionaryEncoded() const;
+
   /// The compression.
   common::CompressionKind compression() const;
 
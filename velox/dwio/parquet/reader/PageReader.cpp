@@ -19,6 +19,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
 
@@ -31,11 +32,57 @@ namespace facebook::velox::parquet {
 using thrift::Encoding;
 using thrift::PageHeader;
 
+namespace {
+
+// Decompresses 'compressedSize' bytes at 'data' into 'uncompressedSize' bytes
+// in 'result'. Allocates or resizes 'result' as needed.
+void decompressPage(
+    common::CompressionKind codec,
+    const char* data,
+    uint32_t compressedSize,
+    uint32_t uncompressedSize,
+    const std::string& streamName,
+    memory::MemoryPool& pool,
+    BufferPtr& result) {
+  std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          data, compressedSize, 0);
+  auto streamDebugInfo = fmt::format("Page Reader: Stream {}", streamName);
+  std::unique_ptr<dwio::common::SeekableInputStream> decompressedStream =
+      dwio::common::compression::createDecompressor(
+          codec,
+          std::move(inputStream),
+          uncompressedSize,
+          pool,
+          getParquetDecompressionOptions(codec),
+          streamDebugInfo,
+          nullptr,
+          true,
+          compressedSize);
+
+  dwio::common::ensureCapacity<char>(result, uncompressedSize, &pool);
+  decompressedStream->readFully(result->asMutable<char>(), uncompressedSize);
+}
+
+} // namespace
+
+PageReader::~PageReader() {
+  closeCurrentReadAhead();
+  for (auto& page : readAhead_) {
+    if (page.decompressed) {
+      page.decompressed->close();
+    }
+  }
+}
+
 void PageReader::seekToPage(int64_t row) {
   defineDecoder_.reset();
   repeatDecoder_.reset();
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
+  if (row != kRepDefOnly && !pageFilterInfo_.firstRows.empty()) {
+    seekToIndexedPage(row);
+  }
   for (;;) {
     auto dataStart = pageStart_;
     if (chunkSize_ <= pageStart_) {
@@ -56,11 +103,7 @@ void PageReader::seekToPage(int64_t row) {
         break;
       case thrift::PageType::DICTIONARY_PAGE:
         if (row == kRepDefOnly) {
-          skipBytes(
-              pageHeader.compressed_page_size,
-              inputStream_.get(),
-              bufferStart_,
-              bufferEnd_);
+          skipPageData(pageHeader.compressed_page_size);
           continue;
         }
         prepareDictionary(pageHeader);
@@ -73,11 +116,135 @@ void PageReader::seekToPage(int64_t row) {
     }
     updateRowInfoAfterPageSkipped();
   }
+  if (readAheadExecutor_) {
+    fillReadAhead();
+  }
+}
+
+void PageReader::fillReadAhead() {
+  // With a filter on a dictionary encoded ColumnChunk, the data pages are
+  // not read if no dictionary entry passes, so wait until this is known.
+  if (isDictionaryEncoded_ && !dictionaryMayMatch_.value_or(false)) {
+    return;
+  }
+  auto offset = std::max(pageStart_, readAheadEnd_);
+  while (static_cast<int32_t>(readAhead_.size()) < maxReadAheadPages_ &&
+         readAheadBytes_ < kMaxReadAheadBytes && offset < chunkSize_) {
+    ReadAheadPage page;
+    uint64_t headerSize;
+    page.header = readHeader(headerSize);
+    page.pageStart = offset;
+    page.dataStart = offset + headerSize;
+    const auto& header = page.header;
+    const int32_t size = header.compressed_page_size;
+    page.data = AlignedBuffer::allocate<char>(size, &pool_);
+    dwio::common::readBytes(
+        size,
+        inputStream_.get(),
+        page.data->asMutable<char>(),
+        bufferStart_,
+        bufferEnd_);
+    page.memoryBytes = size;
+    offset = page.dataStart + size;
+
+    // The levels of a DATA_PAGE_V2 are not compressed and the data after them
+    // may not be compressed either.
+    int32_t levelsSize = 0;
+    bool isCompressed = false;
+    switch (header.type) {
+      case thrift::PageType::DATA_PAGE:
+      case thrift::PageType::DICTIONARY_PAGE:
+        isCompressed = true;
+        break;
+      case thrift::PageType::DATA_PAGE_V2: {
+        const auto& v2Header = header.data_page_header_v2;
+        levelsSize = v2Header.repetition_levels_byte_length +
+            v2Header.definition_levels_byte_length;
+        isCompressed = v2Header.__isset.is_compressed &&
+            v2Header.is_compressed && size > levelsSize;
+        break;
+      }
+      default:
+        break;
+    }
+    if (isCompressed) {
+      const uint32_t uncompressedSize =
+          header.uncompressed_page_size - levelsSize;
+      page.memoryBytes += uncompressedSize;
+      page.decompressed = std::make_shared<AsyncSource<BufferPtr>>(
+          [data = page.data,
+           levelsSize,
+           compressedSize = static_cast<uint32_t>(size - levelsSize),
+           uncompressedSize,
+           codec = codec_,
+           streamName = inputStream_->getName(),
+           pool = &pool_]() {
+            auto result = std::make_unique<BufferPtr>();
+            decompressPage(
+                codec,
+                data->as<char>() + levelsSize,
+                compressedSize,
+                uncompressedSize,
+                streamName,
+                *pool,
+                *result);
+            return result;
+          });
+      readAheadExecutor_->add(
+          [source = page.decompressed]() { source->prepare(); });
+    }
+    readAheadBytes_ += page.memoryBytes;
+    readAhead_.push_back(std::move(page));
+  }
+  readAheadEnd_ = offset;
+}
+
+void PageReader::closeCurrentReadAhead() {
+  if (currentReadAhead_.has_value() && currentReadAhead_->decompressed) {
+    currentReadAhead_->decompressed->close();
+  }
+  currentReadAhead_.reset();
+}
+
+void PageReader::seekToIndexedPage(int64_t row) {
+  const auto& firstRows = pageFilterInfo_.firstRows;
+  const auto& offsets = pageFilterInfo_.offsets;
+  // The dictionary page precedes the data pages and is read on the way.
+  if (pageStart_ < offsets[0]) {
+    return;
+  }
+  const int32_t page =
+      std::upper_bound(firstRows.begin(), firstRows.end(), row) -
+      firstRows.begin() - 1;
+  if (page < 0 || offsets[page] <= pageStart_) {
+    return;
+  }
+  dwio::common::skipBytes(
+      offsets[page] - pageStart_, inputStream_.get(), bufferStart_, bufferEnd_);
+  pageStart_ = offsets[page];
+  rowOfPage_ = firstRows[page];
+  numRowsInPage_ = 0;
 }
 
 PageHeader PageReader::readPageHeader() {
   TestValue::adjust(
       "facebook::velox::parquet::PageReader::readPageHeader", this);
+  closeCurrentReadAhead();
+  if (!readAhead_.empty()) {
+    currentReadAhead_ = std::move(readAhead_.front());
+    readAhead_.pop_front();
+    readAheadBytes_ -= currentReadAhead_->memoryBytes;
+    VELOX_CHECK_EQ(currentReadAhead_->pageStart, pageStart_);
+    pageDataStart_ = currentReadAhead_->dataStart;
+    return currentReadAhead_->header;
+  }
+  uint64_t headerSize;
+  auto pageHeader = readHeader(headerSize);
+  pageDataStart_ = pageStart_ + headerSize;
+  return pageHeader;
+}
+
+PageHeader PageReader::readHeader(uint64_t& headerSize) {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer;
     int32_t size;
@@ -92,13 +259,24 @@ PageHeader PageReader::readPageHeader() {
   apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
       transport);
   PageHeader pageHeader;
-  uint64_t readBytes;
-  readBytes = pageHeader.read(&protocol);
-
-  pageDataStart_ = pageStart_ + readBytes;
+  headerSize = pageHeader.read(&protocol);
   return pageHeader;
 }
 
+const char* PageReader::readPageData(int32_t size) {
+  if (currentReadAhead_.has_value()) {
+    return currentReadAhead_->data->as<char>();
+  }
+  return readBytes(size, pageBuffer_);
+}
+
+void PageReader::skipPageData(int32_t size) {
+  if (currentReadAhead_.has_value()) {
+    return;
+  }
+  dwio::common::skipBytes(size, inputStream_.get(), bufferStart_, bufferEnd_);
+}
+
 const char* PageReader::readBytes(int32_t size, BufferPtr& copy) {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer = nullptr;
@@ -127,28 +305,20 @@ const char* PageReader::decompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
-  std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
-      std::make_unique<dwio::common::SeekableArrayInputStream>(
-          pageData, compressedSize, 0);
-  auto streamDebugInfo =
-      fmt::format("Page Reader: Stream {}", inputStream_->getName());
-  std::unique_ptr<dwio::common::SeekableInputStream> decompressedStream =
-      dwio::common::compression::createDecompressor(
-          codec_,
-          std::move(inputStream),
-          uncompressedSize,
-          pool_,
-          getParquetDecompressionOptions(codec_),
-          streamDebugInfo,
-          nullptr,
-          true,
-          compressedSize);
-
-  dwio::common::ensureCapacity<char>(
-      decompressedData_, uncompressedSize, &pool_);
-  decompressedStream->readFully(
-      decompressedData_->asMutable<char>(), uncompressedSize);
-
+  if (currentReadAhead_.has_value() && currentReadAhead_->decompressed) {
+    auto decompressed = currentReadAhead_->decompressed->move();
+    VELOX_CHECK_NOT_NULL(decompressed);
+    decompressedData_ = std::move(*decompressed);
+    return decompressedData_->as<char>();
+  }
+  decompressPage(
+      codec_,
+      pageData,
+      compressedSize,
+      uncompressedSize,
+      inputStream_->getName(),
+      pool_,
+      decompressedData_);
   return decompressedData_->as<char>();
 }
 
@@ -202,15 +372,10 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
       numRowsInPage_ + rowOfPage_ <= row) {
-    dwio::common::skipBytes(
-        pageHeader.compressed_page_size,
-        inputStream_.get(),
-        bufferStart_,
-        bufferEnd_);
-
+    skipPageData(pageHeader.compressed_page_size);
     return;
   }
-  pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
+  pageData_ = readPageData(pageHeader.compressed_page_size);
   pageData_ = decompressData(
       pageData_,
       pageHeader.compressed_page_size,
@@ -258,11 +423,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
       numRowsInPage_ + rowOfPage_ <= row) {
-    skipBytes(
-        pageHeader.compressed_page_size,
-        inputStream_.get(),
-        bufferStart_,
-        bufferEnd_);
+    skipPageData(pageHeader.compressed_page_size);
     return;
   }
 
@@ -272,7 +433,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
       pageHeader.data_page_header_v2.repetition_levels_byte_length;
 
   auto bytes = pageHeader.compressed_page_size;
-  pageData_ = readBytes(bytes, pageBuffer_);
+  pageData_ = readPageData(bytes);
 
   if (repeatLength) {
     repeatDecoder_ = std::make_unique<::arrow::util::RleDecoder>(
@@ -322,7 +483,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       dictionaryEncoding_ == Encoding::PLAIN);
 
   if (codec_ != common::CompressionKind::CompressionKind_NONE) {
-    pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
+    pageData_ = readPageData(pageHeader.compressed_page_size);
     pageData_ = decompressData(
         pageData_,
         pageHeader.compressed_page_size,
@@ -468,6 +629,63 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   }
 }
 
+bool PageReader::dictionaryMayMatch(const common::Filter& filter) const {
+  if (filter.testNull()) {
+    // Nulls are not in the dictionary.
+    return true;
+  }
+  auto anyMatch = [&](auto test) {
+    for (auto i = 0; i < dictionary_.numValues; ++i) {
+      if (test(i)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  const auto& type = type_->type();
+  const auto parquetType = type_->parquetType_.value();
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+      if (parquetType != thrift::Type::INT32) {
+        return true;
+      }
+      return anyMatch([&](int32_t i) {
+        return filter.testInt64(dictionary_.values->as<int32_t>()[i]);
+      });
+    case TypeKind::BIGINT:
+      if (type->isDecimal() || parquetType != thrift::Type::INT64) {
+        return true;
+      }
+      return anyMatch([&](int32_t i) {
+        return filter.testInt64(dictionary_.values->as<int64_t>()[i]);
+      });
+    case TypeKind::REAL:
+      if (parquetType != thrift::Type::FLOAT) {
+        return true;
+      }
+      return anyMatch([&](int32_t i) {
+        return filter.testFloat(dictionary_.values->as<float>()[i]);
+      });
+    case TypeKind::DOUBLE:
+      if (parquetType != thrift::Type::DOUBLE) {
+        return true;
+      }
+      return anyMatch([&](int32_t i) {
+        return filter.testDouble(dictionary_.values->as<double>()[i]);
+      });
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return anyMatch([&](int32_t i) {
+        const auto& value = dictionary_.values->as<StringView>()[i];
+        return filter.testBytes(value.data(), value.size());
+      });
+    default:
+      return true;
+  }
+}
+
 void PageReader::makeFilterCache(dwio::common::ScanState& state) {
   VELOX_CHECK(
       !state.dictionary2.values, "Parquet supports only one dictionary");
@@ -607,6 +825,14 @@ int32_t PageReader::getLengthsAndNulls(
 
 void PageReader::makeDecoder() {
   auto parquetType = type_->parquetType_.value();
+  // Decoders of a previous page with a different encoding must not be used
+  // for skipping on this page.
+  directDecoder_.reset();
+  stringDecoder_.reset();
+  booleanDecoder_.reset();
+  deltaBpDecoder_.reset();
+  deltaLengthByteArrayDecoder_.reset();
+  deltaByteArrayDecoder_.reset();
   switch (encoding_) {
     case Encoding::RLE_DICTIONARY:
     case Encoding::PLAIN_DICTIONARY:
@@ -657,11 +883,72 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      VELOX_CHECK(
+          parquetType == thrift::Type::BYTE_ARRAY,
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_, pool_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY &&
+          !(parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY &&
+            type_->type()->isVarbinary())) {
+        VELOX_UNSUPPORTED(
+            "DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY and binary "
+            "FIXED_LEN_BYTE_ARRAY");
+      }
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_, pool_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      makeByteStreamSplitDecoder();
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::makeByteStreamSplitDecoder() {
+  auto parquetType = type_->parquetType_.value();
+  int32_t width;
+  switch (parquetType) {
+    case thrift::Type::INT32:
+    case thrift::Type::INT64:
+    case thrift::Type::FLOAT:
+    case thrift::Type::DOUBLE:
+      width = parquetTypeBytes(parquetType);
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      width = type_->typeLength_;
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "BYTE_STREAM_SPLIT decoder does not support Parquet type {}",
+          parquetType);
+  }
+  VELOX_CHECK_EQ(encodedDataSize_ % width, 0);
+  const auto size = encodedDataSize_;
+  if (!byteStreamSplitData_ ||
+      byteStreamSplitData_->capacity() < size + simd::kPadding) {
+    byteStreamSplitData_ =
+        AlignedBuffer::allocate<char>(size + simd::kPadding, &pool_);
+  }
+  auto* data = byteStreamSplitData_->asMutable<char>();
+  decodeByteStreamSplit(pageData_, size / width, width, data);
+  if (parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY &&
+      type_->type()->isVarbinary()) {
+    stringDecoder_ = std::make_unique<StringDecoder>(data, data + size, width);
+    return;
+  }
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(data, size),
+      false,
+      width,
+      parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY);
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -691,6 +978,10 @@ void PageReader::skip(int64_t numRows) {
     booleanDecoder_->skip(toSkip);
   } else if (deltaBpDecoder_) {
     deltaBpDecoder_->skip(toSkip);
+  } else if (deltaLengthByteArrayDecoder_) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (deltaByteArrayDecoder_) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else {
     VELOX_FAIL("No decoder to skip");
   }
@@ -789,6 +1080,42 @@ void PageReader::startVisit(folly::Range<const vector_size_t*> rows) {
   visitBase_ = firstUnvisited_;
 }
 
+void PageReader::skipRemainingVisitorRows() {
+  firstUnvisited_ = visitBase_ + visitorRows_[numVisitorRows_ - 1] + 1;
+  currentVisitorRow_ = numVisitorRows_;
+}
+
+bool PageReader::skipNonMatchingPages() {
+  const auto& firstRows = pageFilterInfo_.firstRows;
+  while (currentVisitorRow_ < numVisitorRows_) {
+    const auto row = visitBase_ + visitorRows_[currentVisitorRow_];
+    if (row < rowOfPage_ + numRowsInPage_) {
+      // The current page is already decoded.
+      return true;
+    }
+    const auto page =
+        std::upper_bound(firstRows.begin(), firstRows.end(), row) -
+        firstRows.begin() - 1;
+    if (page < 0 || pageFilterInfo_.mayMatch[page]) {
+      return true;
+    }
+    const int64_t firstRowOfNextPage =
+        page + 1 < static_cast<int64_t>(firstRows.size())
+        ? firstRows[page + 1]
+        : std::numeric_limits<int64_t>::max();
+    // None of the rows on 'page' pass the filter, so these produce no output.
+    const auto* end = visitorRows_ + numVisitorRows_;
+    const auto* next = std::lower_bound(
+        visitorRows_ + currentVisitorRow_,
+        end,
+        firstRowOfNextPage - visitBase_,
+        [](vector_size_t left, int64_t right) { return left < right; });
+    currentVisitorRow_ = next - visitorRows_;
+    firstUnvisited_ = visitBase_ + visitorRows_[currentVisitorRow_ - 1] + 1;
+  }
+  return false;
+}
+
 bool PageReader::rowsForPage(
     dwio::common::SelectiveColumnReader& reader,
     bool hasFilter,
@@ -798,6 +1125,16 @@ bool PageReader::rowsForPage(
   if (currentVisitorRow_ == numVisitorRows_) {
     return false;
   }
+  if (hasFilter && dictionaryMayMatch_.has_value() &&
+      !dictionaryMayMatch_.value()) {
+    // No value in the ColumnChunk passes the filter.
+    skipRemainingVisitorRows();
+    return false;
+  }
+  if (hasFilter && !pageFilterInfo_.firstRows.empty() &&
+      !skipNonMatchingPages()) {
+    return false;
+  }
   int32_t numToVisit;
   // Check if the first row to go to is in the current page. If not, seek to the
   // page that contains the row.
@@ -810,6 +1147,13 @@ bool PageReader::rowsForPage(
   }
   auto& scanState = reader.scanState();
   if (isDictionary()) {
+    if (hasFilter && isDictionaryEncoded_ && !dictionaryMayMatch_.has_value()) {
+      dictionaryMayMatch_ = dictionaryMayMatch(*reader.scanSpec()->filter());
+      if (!dictionaryMayMatch_.value()) {
+        skipRemainingVisitorRows();
+        return false;
+      }
+    }
     if (scanState.dictionary.values != dictionary_.values) {
       scanState.dictionary = dictionary_;
       if (hasFilter) {
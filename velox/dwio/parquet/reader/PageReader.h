@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/BitConcatenation.h"
 #include "velox/dwio/common/DirectDecoder.h"
@@ -23,14 +24,33 @@
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
 
 #include <arrow/util/rle_encoding.h>
+#include <folly/Executor.h>
+
+#include <deque>
 
 namespace facebook::velox::parquet {
 
+/// Locations of the data pages of a ColumnChunk and the result of testing the
+/// filter on the column against the statistics of each page. Built from the
+/// page index (ColumnIndex and OffsetIndex) of the ColumnChunk.
+struct PageFilterInfo {
+  /// Row number of the first row of each data page from start of ColumnChunk.
+  std::vector<int64_t> firstRows;
+
+  /// Offset of the header of each data page from start of ColumnChunk.
+  std::vector<int64_t> offsets;
+
+  /// True for pages where the filter may pass some rows.
+  std::vector<bool> mayMatch;
+};
+
 /// Manages access to pages inside a ColumnChunk. Interprets page headers and
 /// encodings and presents the combination of pages and encoded values as a
 /// continuous stream accessible via readWithVisitor().
@@ -73,9 +93,47 @@ class PageReader {
         nullConcatenation_(pool_),
         sessionTimezone_(sessionTimezone) {}
 
+  ~PageReader();
+
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
+  /// Sets the page locations and per-page filter results from the page index.
+  /// Reads with a filter then pass over rows on pages where the filter cannot
+  /// pass any row without reading these pages, and seeks go directly to the
+  /// page that contains the target row. Only applies to top level columns.
+  void setPageFilterInfo(PageFilterInfo info) {
+    VELOX_CHECK(isTopLevel_);
+    VELOX_CHECK_NULL(readAheadExecutor_);
+    VELOX_CHECK_EQ(info.firstRows.size(), info.offsets.size());
+    VELOX_CHECK_EQ(info.firstRows.size(), info.mayMatch.size());
+    pageFilterInfo_ = std::move(info);
+  }
+
+  /// Declares that all data pages of the ColumnChunk are dictionary encoded.
+  /// Reads with a filter then test the filter on the dictionary entries and
+  /// pass over all rows without decoding if no entry can pass. Only applies to
+  /// top level columns.
+  void setDictionaryEncoded() {
+    VELOX_CHECK(isTopLevel_);
+    isDictionaryEncoded_ = true;
+  }
+
+  /// Reads up to 'numPages' pages ahead of the current page and decompresses
+  /// them on 'executor' while the current page is decoded. The pages read
+  /// ahead are bounded by kMaxReadAheadBytes. Only applies to compressed top
+  /// level columns that do not skip pages by the page index, so this must be
+  /// called after setPageFilterInfo(). Does nothing if 'executor' is nullptr.
+  void setReadAhead(folly::Executor* executor, int32_t numPages) {
+    if (executor == nullptr || numPages <= 0 || !isTopLevel_ ||
+        codec_ == common::CompressionKind::CompressionKind_NONE ||
+        !pageFilterInfo_.firstRows.empty()) {
+      return;
+    }
+    readAheadExecutor_ = executor;
+    maxReadAheadPages_ = numPages;
+  }
+
   /// Decodes repdefs for 'numTopLevelRows'. Use getLengthsAndNulls()
   /// to access the lengths and nulls for the different nesting
   /// levels.
@@ -138,7 +196,8 @@ class PageReader {
   }
 
   // Parses the PageHeader at 'inputStream_', and move the bufferStart_ and
-  // bufferEnd_ to the corresponding positions.
+  // bufferEnd_ to the corresponding positions. Returns the header of the next
+  // page read ahead instead if there is one.
   thrift::PageHeader readPageHeader();
 
   const date::time_zone* sessionTimezone() const {
@@ -154,6 +213,31 @@ class PageReader {
   // consulted to determine number of leaf values.
   static constexpr int32_t kRowsUnknown = -1;
 
+  // Maximum bytes of compressed and decompressed data of the pages read ahead
+  // of the current page.
+  static constexpr int64_t kMaxReadAheadBytes = 8 << 20;
+
+  // A page whose header and data are read from 'inputStream_' ahead of use.
+  struct ReadAheadPage {
+    thrift::PageHeader header;
+
+    // Offset of the header and of the first byte after the header from start
+    // of ColumnChunk.
+    uint64_t pageStart;
+    uint64_t dataStart;
+
+    // Copy of the compressed page.
+    BufferPtr data;
+
+    // The decompressed page, or for DATA_PAGE_V2 the decompressed data after
+    // the levels, made on 'readAheadExecutor_'. nullptr if the page has
+    // nothing to decompress.
+    std::shared_ptr<AsyncSource<BufferPtr>> decompressed;
+
+    // Bytes of 'data' and of the decompressed page.
+    int64_t memoryBytes;
+  };
+
   // If the current page has nulls, returns a nulls bitmap owned by 'this'. This
   // is filled for 'numRows' bits.
   const uint64_t* readNulls(int32_t numRows, BufferPtr& buffer);
@@ -170,6 +254,10 @@ class PageReader {
   // 'pageData_' + 'encodedDataSize_'.
   void makedecoder();
 
+  // Decodes the BYTE_STREAM_SPLIT page at 'pageData_' into
+  // 'byteStreamSplitData_' and makes a decoder for the result.
+  void makeByteStreamSplitDecoder();
+
   // Reads and skips pages until finding a data page that contains
   // 'row'. Reads and sets 'rowOfPage_' and 'numRowsInPage_' and
   // initializes a decoder for the found page. row kRepDefOnly means
@@ -179,6 +267,33 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // Reads the pages after the last page read so far into 'readAhead_' and
+  // starts their decompression on 'readAheadExecutor_', up to
+  // 'maxReadAheadPages_' pages and kMaxReadAheadBytes.
+  void fillReadAhead();
+
+  // Closes the decompression of the current page if it came from
+  // 'readAhead_'.
+  void closeCurrentReadAhead();
+
+  // Moves the stream directly to the data page that contains 'row' using the
+  // page offsets in 'pageFilterInfo_'. Does nothing if the dictionary page has
+  // not been read yet or 'row' is on the next page.
+  void seekToIndexedPage(int64_t row);
+
+  // Advances 'currentVisitorRow_' past the rows to visit that are on pages
+  // after the current one where the filter cannot pass any row according to
+  // 'pageFilterInfo_'. Returns false if no rows to visit remain.
+  bool skipNonMatchingPages();
+
+  // Returns true if 'filter' passes some entry of the dictionary or may pass
+  // nulls, or if the dictionary cannot be tested for the type of 'this'.
+  // Stops at the first passing entry.
+  bool dictionaryMayMatch(const common::Filter& filter) const;
+
+  // Marks all rows given to startVisit() as visited without producing output.
+  void skipRemainingVisitorRows();
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -211,9 +326,22 @@ class PageReader {
   // straddles buffers. Allocates or resizes 'copy' as needed.
   const char* readBytes(int32_t size, BufferPtr& copy);
 
+  // Parses the PageHeader at 'inputStream_' and sets 'headerSize' to its size
+  // in bytes.
+  thrift::PageHeader readHeader(uint64_t& headerSize);
+
+  // Returns the 'size' bytes of data of the current page. These come from
+  // 'currentReadAhead_' if the page was read ahead.
+  const char* readPageData(int32_t size);
+
+  // Passes over the 'size' bytes of data of the current page.
+  void skipPageData(int32_t size);
+
   // Decompresses data starting at 'pageData_', consuming 'compressedsize' and
   // producing up to 'uncompressedSize' bytes. The start of the decoding
   // result is returned. an intermediate copy may be made in 'decompresseddata_'
+  // If the current page was read ahead, waits for its decompression on
+  // 'readAheadExecutor_' instead.
   const char* decompressData(
       const char* pageData,
       uint32_t compressedSize,
@@ -307,12 +435,22 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
       } else {
         nullsFromFastPath = false;
-        stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+          deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+        } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+          deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+        } else {
+          stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        }
       }
     } else {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -483,13 +621,51 @@ class PageReader {
 
   const date::time_zone* sessionTimezone_{nullptr};
 
+  // Page locations and filter results from the page index. Empty if the page
+  // index is not used.
+  PageFilterInfo pageFilterInfo_;
+
+  // True if all data pages are dictionary encoded. See setDictionaryEncoded().
+  bool isDictionaryEncoded_{false};
+
+  // Result of dictionaryMayMatch() for the filter of the reader and
+  // 'dictionary_'. Not set until the dictionary has been read and tested.
+  std::optional<bool> dictionaryMayMatch_;
+
   // Decoders. Only one will be set at a time.
   std::unique_ptr<dwio::common::DirectDecoder<true>> directDecoder_;
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
+
+  // PLAIN encoding of a BYTE_STREAM_SPLIT page, read by 'directDecoder_' or
+  // 'stringDecoder_'. Reused across pages.
+  BufferPtr byteStreamSplitData_;
   // Add decoders for other encodings here.
+
+  // Executor for decompressing the pages in 'readAhead_'. nullptr if pages are
+  // not read ahead.
+  folly::Executor* readAheadExecutor_{nullptr};
+
+  // Maximum number of pages in 'readAhead_'.
+  int32_t maxReadAheadPages_{0};
+
+  // Pages read ahead of the current page, in file order.
+  std::deque<ReadAheadPage> readAhead_;
+
+  // Sum of 'memoryBytes' of 'readAhead_'.
+  int64_t readAheadBytes_{0};
+
+  // Offset from start of ColumnChunk of the end of the last page in
+  // 'readAhead_'. 'inputStream_' is positioned here while pages are read
+  // ahead.
+  uint64_t readAheadEnd_{0};
+
+  // The current page if it came from 'readAhead_'.
+  std::optional<ReadAheadPage> currentReadAhead_;
 };
 
 FOLLY_ALWAYS_INLINE dwio::common::compression::CompressionOptions
@@ -17,14 +17,41 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
 
 namespace facebook::velox::parquet {
 
+namespace {
+
+// Deserializes a thrift object of type T from the next 'size' bytes of
+// 'stream'.
+template <typename T>
+T readThrift(dwio::common::SeekableInputStream& stream, int32_t size) {
+  std::vector<char> buffer(size);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      size, &stream, buffer.data(), bufferStart, bufferEnd);
+  auto transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(buffer.data(), size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
+    const common::ScanSpec& scanSpec) {
   return std::make_unique<ParquetData>(
-      type, metaData_, pool(), sessionTimezone_);
+      type, metaData_, scanSpec, pool(), sessionTimezone_, pageReadAhead_);
 }
 
 void ParquetData::filterRowGroups(
@@ -81,30 +108,118 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   return true;
 }
 
+uint64_t ParquetData::chunkReadOffset(ColumnChunkMetaDataPtr& chunk) {
+  if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    return chunk.dictionaryPageOffset();
+  }
+  return chunk.dataPageOffset();
+}
+
+bool ParquetData::usePageIndex(ColumnChunkMetaDataPtr& chunk) const {
+  // Pages can only be skipped by top level row numbers.
+  return scanSpec_.filter() && maxRepeat_ == 0 && maxDefine_ <= 1 &&
+      chunk.hasPageIndex();
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
   auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
   streams_.resize(fileMetaDataPtr_.numRowGroups());
+  columnIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+  offsetIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
   VELOX_CHECK(
       chunk.hasMetadata(),
       "ColumnMetaData does not exist for schema Id ",
       type_->column());
   ;
 
-  uint64_t chunkReadOffset = chunk.dataPageOffset();
-  if (chunk.hasDictionaryPageOffset() && chunk.dictionaryPageOffset() >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = chunk.dictionaryPageOffset();
-  }
-
   uint64_t readSize =
       (chunk.compression() == common::CompressionKind::CompressionKind_NONE)
       ? chunk.totalUncompressedSize()
       : chunk.totalCompressedSize();
 
   auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] = input.enqueue({chunkReadOffset(chunk), readSize}, &id);
+  executor_ = input.executor();
+
+  if (usePageIndex(chunk)) {
+    const auto [columnIndexOffset, columnIndexLength] =
+        chunk.columnIndexRegion();
+    const auto [offsetIndexOffset, offsetIndexLength] =
+        chunk.offsetIndexRegion();
+    columnIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(columnIndexOffset),
+         static_cast<uint64_t>(columnIndexLength)});
+    offsetIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(offsetIndexOffset),
+         static_cast<uint64_t>(offsetIndexLength)});
+  }
+}
+
+PageFilterInfo ParquetData::readPageFilterInfo(uint32_t index) {
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto chunk = rowGroup.columnChunk(type_->column());
+  const auto columnIndex = readThrift<thrift::ColumnIndex>(
+      *columnIndexStreams_[index], chunk.columnIndexRegion().second);
+  const auto offsetIndex = readThrift<thrift::OffsetIndex>(
+      *offsetIndexStreams_[index], chunk.offsetIndexRegion().second);
+  columnIndexStreams_[index].reset();
+  offsetIndexStreams_[index].reset();
+
+  PageFilterInfo info;
+  const auto& locations = offsetIndex.page_locations;
+  const auto numPages = locations.size();
+  const auto chunkStart = static_cast<int64_t>(chunkReadOffset(chunk));
+  if (numPages == 0 || columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages ||
+      (columnIndex.__isset.null_counts &&
+       columnIndex.null_counts.size() != numPages) ||
+      locations[0].first_row_index != 0 || locations[0].offset < chunkStart) {
+    return info;
+  }
+  for (size_t i = 1; i < numPages; ++i) {
+    if (locations[i].first_row_index <= locations[i - 1].first_row_index ||
+        locations[i].offset <= locations[i - 1].offset) {
+      return info;
+    }
+  }
+
+  auto* filter = scanSpec_.filter();
+  const auto& type = type_->type();
+  info.firstRows.reserve(numPages);
+  info.offsets.reserve(numPages);
+  info.mayMatch.reserve(numPages);
+  for (size_t i = 0; i < numPages; ++i) {
+    const auto& location = locations[i];
+    const int64_t numRowsInPage =
+        (i + 1 < numPages ? locations[i + 1].first_row_index
+                          : rowGroup.numRows()) -
+        location.first_row_index;
+    info.firstRows.push_back(location.first_row_index);
+    info.offsets.push_back(location.offset - chunkStart);
+    if (!filter) {
+      info.mayMatch.push_back(true);
+      continue;
+    }
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(numRowsInPage);
+    } else {
+      if (columnIndex.__isset.null_counts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, numRowsInPage);
+    info.mayMatch.push_back(
+        testFilter(filter, columnStats.get(), numRowsInPage, type));
+  }
+  return info;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -119,6 +234,20 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       metadata.compression(),
       metadata.totalCompressedSize(),
       sessionTimezone_);
+  // Rows can only be passed over by top level row numbers.
+  if (scanSpec_.filter() && maxRepeat_ == 0 && maxDefine_ <= 1 &&
+      metadata.isDictionaryEncoded()) {
+    reader_->setDictionaryEncoded();
+  }
+  if (index < columnIndexStreams_.size() && columnIndexStreams_[index]) {
+    auto pageFilterInfo = readPageFilterInfo(index);
+    if (!pageFilterInfo.firstRows.empty()) {
+      reader_->setPageFilterInfo(std::move(pageFilterInfo));
+    }
+  }
+  if (pageReadAhead_ > 0) {
+    reader_->setReadAhead(executor_, pageReadAhead_);
+  }
   return dwio::common::PositionProvider(empty);
 }
 
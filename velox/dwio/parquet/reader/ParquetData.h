@@ -36,10 +36,12 @@ class ParquetParams : public dwio::common::FormatParams {
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
       const FileMetaDataPtr metaData,
-      const date::time_zone* sessionTimezone)
+      const date::time_zone* sessionTimezone,
+      int32_t pageReadAhead = 0)
       : FormatParams(pool, stats),
         metaData_(metaData),
-        sessionTimezone_(sessionTimezone) {}
+        sessionTimezone_(sessionTimezone),
+        pageReadAhead_(pageReadAhead) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
@@ -47,6 +49,7 @@ class ParquetParams : public dwio::common::FormatParams {
  private:
   const FileMetaDataPtr metaData_;
   const date::time_zone* sessionTimezone_;
+  const int32_t pageReadAhead_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -55,15 +58,19 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
+      const common::ScanSpec& scanSpec,
       memory::MemoryPool& pool,
-      const date::time_zone* sessionTimezone)
+      const date::time_zone* sessionTimezone,
+      int32_t pageReadAhead = 0)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
+        scanSpec_(scanSpec),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1),
-        sessionTimezone_(sessionTimezone) {}
+        sessionTimezone_(sessionTimezone),
+        pageReadAhead_(pageReadAhead) {}
 
   /// Prepares to read data for 'index'th row group.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
@@ -197,18 +204,47 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  // Returns the offset in the file of the first page of 'chunk'.
+  static uint64_t chunkReadOffset(ColumnChunkMetaDataPtr& chunk);
+
+  // True if the page index of 'chunk' should be read to skip pages where the
+  // filter of the column cannot pass any row.
+  bool usePageIndex(ColumnChunkMetaDataPtr& chunk) const;
+
+  // Reads the page index enqueued for 'index'th row group and tests the
+  // filter of the column against the statistics of each page. Returns an
+  // empty PageFilterInfo if the page index is not usable.
+  PageFilterInfo readPageFilterInfo(uint32_t index);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
+  const common::ScanSpec& scanSpec_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Streams for the serialized ColumnIndex and OffsetIndex of this column in
+  // each of 'rowGroups_'. Only set for row groups where usePageIndex() is true.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams_;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
   const date::time_zone* sessionTimezone_;
+
+  // Number of pages to decompress ahead on 'executor_'. See
+  // PageReader::setReadAhead().
+  const int32_t pageReadAhead_;
+
+  // Executor of the BufferedInput the streams are enqueued on. nullptr if it
+  // has none.
+  folly::Executor* executor_{nullptr};
+
   std::unique_ptr<PageReader> reader_;
 
   // Nulls derived from leaf repdefs for non-leaf readers.
@@ -19,12 +19,37 @@
 #include <boost/algorithm/string.hpp>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
 
+// The parsed footer of a Parquet file. Shared by the readers of the file
+// through dwio::common::FileMetadataCache.
+class ParquetFileMetadata : public dwio::common::FileMetadata {
+ public:
+  ParquetFileMetadata(
+      std::unique_ptr<thrift::FileMetaData> fileMetaData,
+      uint64_t footerLength)
+      : fileMetaData_(std::move(fileMetaData)), footerLength_(footerLength) {}
+
+  const thrift::FileMetaData& fileMetaData() const {
+    return *fileMetaData_;
+  }
+
+  // The deserialized footer is assumed to take about twice its serialized
+  // size.
+  uint64_t estimatedBytes() const override {
+    return sizeof(*this) + sizeof(thrift::FileMetaData) + 2 * footerLength_;
+  }
+
+ private:
+  const std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  const uint64_t footerLength_;
+};
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -51,7 +76,7 @@ class ReaderBase {
   }
 
   FileMetaDataPtr fileMetaData() const {
-    return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_.get()));
+    return FileMetaDataPtr(reinterpret_cast<const void*>(fileMetaData_));
   }
 
   const std::shared_ptr<const RowType>& schema() const {
@@ -70,6 +95,10 @@ class ReaderBase {
     return options_.getSessionTimezone();
   }
 
+  int32_t pageReadAhead() const {
+    return options_.pageReadAhead();
+  }
+
   /// Ensures that streams are enqueued and loading for the row group at
   /// 'currentGroup'. May start loading one or more subsequent groups.
   void scheduleRowGroups(
@@ -88,9 +117,12 @@ class ReaderBase {
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
  private:
-  // Reads and parses file footer.
+  // Gets the parsed file footer from FileMetadataCache or reads it.
   void loadFileMetaData();
 
+  // Reads and parses file footer.
+  std::shared_ptr<const ParquetFileMetadata> readFileMetaData();
+
   void initializeSchema();
 
   std::unique_ptr<ParquetTypeWithId> getParquetColumnInfo(
@@ -115,7 +147,9 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Keeps the possibly shared footer alive.
+  std::shared_ptr<const ParquetFileMetadata> fileMetadata_;
+  const thrift::FileMetaData* fileMetaData_{nullptr};
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -143,6 +177,25 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  bool loaded = false;
+  auto metadata = dwio::common::FileMetadataCache::getOrLoad(
+      options_.fileMetadataKey(),
+      [&]() -> std::shared_ptr<const dwio::common::FileMetadata> {
+        loaded = true;
+        return readFileMetaData();
+      });
+  fileMetadata_ =
+      std::dynamic_pointer_cast<const ParquetFileMetadata>(metadata);
+  VELOX_CHECK_NOT_NULL(fileMetadata_, "Cached file metadata is not Parquet");
+  fileMetaData_ = &fileMetadata_->fileMetaData();
+  // A small file is loaded whole even if its footer is cached.
+  if (!loaded &&
+      fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_)) {
+    input_->loadCompleteFile();
+  }
+}
+
+std::shared_ptr<const ParquetFileMetadata> ReaderBase::readFileMetaData() {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -189,8 +242,10 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_unique<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  return std::make_shared<ParquetFileMetadata>(
+      std::move(fileMetaData), footerLength);
 }
 
 void ReaderBase::initializeSchema() {
@@ -764,7 +819,8 @@ class ParquetRowReader::Impl {
         pool_,
         columnReaderStats_,
         readerBase_->fileMetaData(),
-        readerBase->sessionTimezone());
+        readerBase->sessionTimezone(),
+        readerBase->pageReadAhead());
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -774,6 +830,12 @@ class ParquetRowReader::Impl {
         *options_.getScanSpec());
     columnReader_->setFillMutatedOutputRows(
         options_.getRowNumberColumnInfo().has_value());
+    columnReader_->setDecodingExecutor(
+        options_.getDecodingExecutor().get(),
+        options_.getDecodingParallelismFactor());
+    // Projected columns without filters are loaded lazily for the rows that
+    // pass all filters.
+    columnReader_->setIsTopLevel();
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
@@ -819,6 +881,32 @@ class ParquetRowReader::Impl {
       }
       rowNumber += rowGroups_[i].num_rows;
     }
+    filterRowGroupsByBloomFilters();
+  }
+
+  // Drops the row groups in 'rowGroupIds_' where a column chunk Bloom filter
+  // shows that no value passes the filter on the column.
+  void filterRowGroupsByBloomFilters() {
+    if (rowGroupIds_.empty()) {
+      return;
+    }
+    auto passed = testBloomFilters(
+        readerBase_->thriftFileMetaData(),
+        static_cast<const ParquetTypeWithId&>(*readerBase_->schemaWithId()),
+        *options_.getScanSpec(),
+        rowGroupIds_,
+        readerBase_->fileLength(),
+        readerBase_->bufferedInput());
+    int32_t numPassed = 0;
+    for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+      if (passed[i]) {
+        rowGroupIds_[numPassed] = rowGroupIds_[i];
+        firstRowOfRowGroup_[numPassed] = firstRowOfRowGroup_[i];
+        ++numPassed;
+      }
+    }
+    rowGroupIds_.resize(numPassed);
+    firstRowOfRowGroup_.resize(numPassed);
   }
 
   int64_t nextRowNumber() {
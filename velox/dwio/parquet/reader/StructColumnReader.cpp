@@ -151,6 +151,20 @@ void StructColumnReader::seekToRowGroup(uint32_t index) {
   }
 }
 
+void StructColumnReader::setIsTopLevel() {
+  isTopLevel_ = true;
+  if (formatData_->hasNulls()) {
+    return;
+  }
+  for (auto& child : children_) {
+    auto kind = child->fileType().type()->kind();
+    if (kind != TypeKind::ROW && kind != TypeKind::ARRAY &&
+        kind != TypeKind::MAP) {
+      child->setIsTopLevel();
+    }
+  }
+}
+
 void StructColumnReader::seekToEndOfPresetNulls() {
   auto numUnread = formatData_->as<ParquetData>().presetNullsLeft();
   for (auto i = 0; i < children_.size(); ++i) {
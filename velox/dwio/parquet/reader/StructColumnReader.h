@@ -42,6 +42,12 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   void seekToRowGroup(uint32_t index) override;
 
+  /// Marks 'this' and its primitive children as top level. The primitive
+  /// children of the root are then returned as LazyVectors that decode only
+  /// the rows that are accessed. Complex children stay eagerly read since
+  /// their nulls and lengths come from repdefs shared with their siblings.
+  void setIsTopLevel() override;
+
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
   /// the streams in a new input and loads.
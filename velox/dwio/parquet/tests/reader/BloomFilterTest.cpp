@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::common;
+using namespace facebook::velox::parquet;
+
+TEST(BloomFilterTest, hash) {
+  // XXH64 with seed 0 of the empty input.
+  EXPECT_EQ(BloomFilter::hash(std::string_view()), 0xEF46DB3751D8E999ULL);
+  // Integers hash their 4 or 8 byte little endian encoding.
+  EXPECT_NE(BloomFilter::hash(int32_t(1)), BloomFilter::hash(int64_t(1)));
+  int32_t value = 1;
+  EXPECT_EQ(
+      BloomFilter::hash(int32_t(1)),
+      BloomFilter::hash(std::string_view(
+          reinterpret_cast<const char*>(&value), sizeof(value))));
+}
+
+TEST(BloomFilterTest, insertAndFind) {
+  BloomFilter filter(1024);
+  for (int64_t i = 0; i < 100; ++i) {
+    filter.insertHash(BloomFilter::hash(i * 7));
+  }
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(filter.findHash(BloomFilter::hash(i * 7)));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    numFalsePositives += filter.findHash(BloomFilter::hash(i * 7 + 1));
+  }
+  // 100 values in 8192 bits have a false positive rate well under 1%.
+  EXPECT_LT(numFalsePositives, 20);
+
+  // A filter over an all zero bitset finds nothing.
+  std::vector<char> bytes(1024);
+  BloomFilter copy(bytes.data(), bytes.size());
+  EXPECT_FALSE(copy.findHash(BloomFilter::hash(int64_t(7))));
+}
+
+TEST(BloomFilterTest, filterHashes) {
+  auto hashes =
+      bloomFilterHashes(BigintRange(10, 10, false), thrift::Type::INT64);
+  ASSERT_TRUE(hashes.has_value());
+  EXPECT_EQ(*hashes, std::vector<uint64_t>{BloomFilter::hash(int64_t(10))});
+
+  hashes = bloomFilterHashes(BigintRange(10, 10, false), thrift::Type::INT32);
+  ASSERT_TRUE(hashes.has_value());
+  EXPECT_EQ(*hashes, std::vector<uint64_t>{BloomFilter::hash(int32_t(10))});
+
+  auto values = createBigintValues({1, 5, 1'000}, false);
+  hashes = bloomFilterHashes(*values, thrift::Type::INT32);
+  ASSERT_TRUE(hashes.has_value());
+  EXPECT_EQ(hashes->size(), 3);
+
+  // Ranges, values outside of the physical type and filters passing nulls
+  // cannot be tested.
+  EXPECT_FALSE(
+      bloomFilterHashes(BigintRange(10, 20, false), thrift::Type::INT64)
+          .has_value());
+  EXPECT_FALSE(
+      bloomFilterHashes(
+          BigintRange(1LL << 40, 1LL << 40, false), thrift::Type::INT32)
+          .has_value());
+  EXPECT_FALSE(
+      bloomFilterHashes(BigintRange(10, 10, true), thrift::Type::INT64)
+          .has_value());
+  EXPECT_FALSE(
+      bloomFilterHashes(BigintRange(10, 10, false), thrift::Type::DOUBLE)
+          .has_value());
+
+  hashes = bloomFilterHashes(
+      BytesValues({"apple", "pear"}, false), thrift::Type::BYTE_ARRAY);
+  ASSERT_TRUE(hashes.has_value());
+  EXPECT_EQ(hashes->size(), 2);
+
+  hashes = bloomFilterHashes(
+      BytesRange("kiwi", false, false, "kiwi", false, false, false),
+      thrift::Type::BYTE_ARRAY);
+  ASSERT_TRUE(hashes.has_value());
+  EXPECT_EQ(*hashes, std::vector<uint64_t>{BloomFilter::hash("kiwi")});
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+constexpr int32_t kValuesPerBlock = 128;
+constexpr int32_t kMiniBlocksPerBlock = 4;
+constexpr int32_t kValuesPerMiniBlock = kValuesPerBlock / kMiniBlocksPerBlock;
+
+// A DELTA_BINARY_PACKED page and the values it encodes.
+struct EncodedPage {
+  std::string data;
+  // Size of the encoding. 'data' has a word of padding after it.
+  size_t size;
+  std::vector<int64_t> values;
+};
+
+void putVarint(uint64_t value, std::string& out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+uint64_t mask(uint8_t bitWidth) {
+  return bitWidth == 64 ? ~0ULL : (1ULL << bitWidth) - 1;
+}
+
+void putZigZagVarint(int64_t value, std::string& out) {
+  putVarint(
+      (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63),
+      out);
+}
+
+// Encodes 'numValues' values with blocks of 4 miniblocks of 32 values. The
+// deltas of miniblock i take exactly bitWidths[i] bits after subtracting
+// the minimum delta of the block, with wrapping arithmetic as in the Parquet
+// format. 'bitWidths' has an entry for each miniblock that holds values.
+EncodedPage encodePage(
+    int32_t numValues,
+    const std::vector<uint8_t>& bitWidths,
+    std::mt19937_64& rng) {
+  VELOX_CHECK_GT(numValues, 0);
+  const int32_t numMiniBlocks =
+      (numValues - 1 + kValuesPerMiniBlock - 1) / kValuesPerMiniBlock;
+  VELOX_CHECK_EQ(numMiniBlocks, static_cast<int32_t>(bitWidths.size()));
+
+  EncodedPage page;
+  putVarint(kValuesPerBlock, page.data);
+  putVarint(kMiniBlocksPerBlock, page.data);
+  putVarint(numValues, page.data);
+  uint64_t value = rng();
+  putZigZagVarint(value, page.data);
+  page.values.push_back(value);
+
+  for (auto block = 0; block * kMiniBlocksPerBlock < numMiniBlocks; ++block) {
+    const int64_t minDelta = static_cast<int64_t>(rng() % 2'000) - 1'000;
+    putZigZagVarint(minDelta, page.data);
+    // The widths of the miniblocks after the last value are present but
+    // their data is not.
+    for (auto i = 0; i < kMiniBlocksPerBlock; ++i) {
+      const auto miniBlock = block * kMiniBlocksPerBlock + i;
+      page.data.push_back(
+          miniBlock < numMiniBlocks ? bitWidths[miniBlock] : 0);
+    }
+    for (auto i = 0; i < kMiniBlocksPerBlock; ++i) {
+      const auto miniBlock = block * kMiniBlocksPerBlock + i;
+      if (miniBlock >= numMiniBlocks) {
+        break;
+      }
+      const auto bitWidth = bitWidths[miniBlock];
+      const auto start = page.data.size();
+      page.data.resize(
+          start + bits::nbytes(bitWidth * kValuesPerMiniBlock), 0);
+      auto* packed = reinterpret_cast<uint8_t*>(page.data.data() + start);
+      for (auto j = 0; j < kValuesPerMiniBlock; ++j) {
+        // The last miniblock is padded with zeros.
+        uint64_t delta = 0;
+        if (page.values.size() < static_cast<size_t>(numValues)) {
+          delta = rng() & mask(bitWidth);
+          if (j == 0 && bitWidth > 0) {
+            // Makes the width of the miniblock exactly 'bitWidth'.
+            delta |= 1ULL << (bitWidth - 1);
+          }
+          value += minDelta + delta;
+          page.values.push_back(value);
+        }
+        for (auto bit = 0; bit < bitWidth; ++bit) {
+          if ((delta >> bit) & 1) {
+            const auto position = j * bitWidth + bit;
+            packed[position / 8] |= 1 << (position % 8);
+          }
+        }
+      }
+    }
+  }
+  page.size = page.data.size();
+  page.data.resize(page.size + sizeof(uint64_t), 0);
+  return page;
+}
+
+// Reads all values of 'page' in batches of 'batchSizes', repeated as
+// needed, and checks them and the end of the data.
+void readAndCheck(
+    const EncodedPage& page,
+    const std::vector<int32_t>& batchSizes) {
+  DeltaBpDecoder decoder(page.data.data());
+  ASSERT_EQ(page.values.size(), decoder.numValues());
+  std::vector<int64_t> values(page.values.size());
+  size_t numRead = 0;
+  for (auto i = 0; numRead < values.size(); ++i) {
+    const auto batchSize = std::min<size_t>(
+        batchSizes[i % batchSizes.size()], values.size() - numRead);
+    decoder.readValues(batchSize, values.data() + numRead);
+    numRead += batchSize;
+  }
+  ASSERT_EQ(page.values, values);
+  ASSERT_EQ(page.data.data() + page.size, decoder.dataEnd());
+}
+
+} // namespace
+
+TEST(DeltaBpDecoderTest, bitWidths) {
+  std::mt19937_64 rng(1);
+  for (uint8_t bitWidth = 0; bitWidth <= 64; ++bitWidth) {
+    SCOPED_TRACE(fmt::format("bitWidth {}", bitWidth));
+    // Full blocks.
+    readAndCheck(
+        encodePage(
+            1 + 2 * kValuesPerBlock, std::vector<uint8_t>(8, bitWidth), rng),
+        {1'000});
+    // The last miniblock is partly filled.
+    readAndCheck(
+        encodePage(1 + 100, std::vector<uint8_t>(4, bitWidth), rng), {1'000});
+  }
+}
+
+TEST(DeltaBpDecoderTest, mixedBitWidths) {
+  std::mt19937_64 rng(1);
+  const std::vector<uint8_t> bitWidths = {0, 5, 32, 33, 64, 17, 1, 8, 63, 31};
+  const auto page =
+      encodePage(1 + 9 * kValuesPerMiniBlock + 7, bitWidths, rng);
+  readAndCheck(page, {static_cast<int32_t>(page.values.size())});
+  // Batches that end inside miniblocks and span miniblocks and blocks.
+  readAndCheck(page, {1});
+  readAndCheck(page, {7, 13});
+  readAndCheck(page, {31, 33, 65});
+  readAndCheck(page, {kValuesPerBlock + 1});
+}
+
+TEST(DeltaBpDecoderTest, skip) {
+  std::mt19937_64 rng(1);
+  const std::vector<uint8_t> bitWidths = {3, 0, 40, 12, 64, 7};
+  const auto page =
+      encodePage(1 + 5 * kValuesPerMiniBlock + 20, bitWidths, rng);
+  DeltaBpDecoder decoder(page.data.data());
+  size_t position = 0;
+  std::vector<int64_t> values(20);
+  // Skips and reads that end inside miniblocks.
+  const std::vector<std::pair<int32_t, int32_t>> skipsAndReads = {
+      {5, 20}, {40, 3}, {0, 10}, {60, 17}, {1, 1}};
+  for (const auto& [numSkip, numRead] : skipsAndReads) {
+    decoder.skip(numSkip);
+    position += numSkip;
+    decoder.readValues(numRead, values.data());
+    for (auto i = 0; i < numRead; ++i) {
+      ASSERT_EQ(page.values[position + i], values[i]) << position + i;
+    }
+    position += numRead;
+  }
+}
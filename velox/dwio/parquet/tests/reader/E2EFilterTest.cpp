@@ -20,13 +20,42 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
+#include <numeric>
 
 using namespace facebook::velox;
 using namespace facebook::velox::common;
 using namespace facebook::velox::dwio::common;
 using namespace facebook::velox::parquet;
 
+namespace {
+
+// BufferedInput that provides an executor, like CachedBufferedInput, for
+// decompressing pages ahead.
+class ExecutorBufferedInput : public BufferedInput {
+ public:
+  ExecutorBufferedInput(
+      std::shared_ptr<ReadFileInputStream> input,
+      memory::MemoryPool& pool,
+      folly::Executor* executor)
+      : BufferedInput(input, pool), executor_(executor) {}
+
+  std::unique_ptr<BufferedInput> clone() const override {
+    return std::make_unique<ExecutorBufferedInput>(
+        getInputStream(), *pool_, executor_);
+  }
+
+  folly::Executor* executor() const override {
+    return executor_;
+  }
+
+ private:
+  folly::Executor* const executor_;
+};
+
+} // namespace
+
 using dwio::common::MemorySink;
 
 class E2EFilterTest : public E2EFilterTestBase, public test::VectorTestBase {
@@ -85,6 +114,16 @@ class E2EFilterTest : public E2EFilterTestBase, public test::VectorTestBase {
   std::unique_ptr<dwio::common::Reader> makeReader(
       const dwio::common::ReaderOptions& opts,
       std::unique_ptr<dwio::common::BufferedInput> input) override {
+    if (pageReadAheadExecutor_) {
+      auto readerOpts = opts;
+      readerOpts.setPageReadAhead(4);
+      return std::make_unique<ParquetReader>(
+          std::make_unique<ExecutorBufferedInput>(
+              input->getInputStream(),
+              opts.memoryPool(),
+              pageReadAheadExecutor_.get()),
+          readerOpts);
+    }
     return std::make_unique<ParquetReader>(std::move(input), opts);
   }
 
@@ -92,6 +131,8 @@ class E2EFilterTest : public E2EFilterTestBase, public test::VectorTestBase {
   facebook::velox::parquet::WriterOptions options_;
   uint64_t rowsInRowGroup_ = 10'000;
   int64_t bytesInRowGroup_ = 128 * 1'024 * 1'024;
+  // If set, readers decompress pages ahead on this executor.
+  std::shared_ptr<folly::Executor> pageReadAheadExecutor_;
 };
 
 TEST_F(E2EFilterTest, writerMagic) {
@@ -131,6 +172,29 @@ TEST_F(E2EFilterTest, integerDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 1024;
+  options_.writePageIndex = true;
+
+  testWithTypes(
+      "long_val:bigint,"
+      "int_val:int,"
+      "string_val:string",
+      [&]() {
+        // Ascending values give disjoint page ranges, so that filters on
+        // 'long_val' skip most pages.
+        for (auto i = 0; i < batchCount_; ++i) {
+          std::vector<int64_t> values(batchSize_);
+          std::iota(values.begin(), values.end(), i * batchSize_);
+          useSuppliedValues("long_val", i, values);
+        }
+      },
+      false,
+      {"long_val", "int_val", "string_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, integerDeltaBinaryPack) {
   options_.enableDictionary = false;
   options_.encoding =
@@ -213,6 +277,39 @@ TEST_F(E2EFilterTest, compression) {
   }
 }
 
+TEST_F(E2EFilterTest, pageReadAhead) {
+  pageReadAheadExecutor_ = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+  for (const auto compression :
+       {common::CompressionKind_SNAPPY,
+        common::CompressionKind_ZSTD,
+        common::CompressionKind_GZIP}) {
+    if (!facebook::velox::parquet::Writer::isCodecAvailable(compression)) {
+      continue;
+    }
+    options_.dataPageSize = 4 * 1024;
+    options_.compression = compression;
+
+    testWithTypes(
+        "long_val:bigint,"
+        "int_val:int,"
+        "string_val:string",
+        [&]() {
+          makeIntDistribution<int64_t>(
+              "long_val",
+              10, // min
+              100, // max
+              22, // repeats
+              19, // rareFrequency
+              -9999, // rareMin
+              10000000000, // rareMax
+              true); // keepNulls
+        },
+        false,
+        {"long_val", "int_val", "string_val"},
+        5);
+  }
+}
+
 TEST_F(E2EFilterTest, integerDictionary) {
   options_.dataPageSize = 4 * 1024;
 
@@ -256,6 +353,29 @@ TEST_F(E2EFilterTest, integerDictionary) {
       20);
 }
 
+TEST_F(E2EFilterTest, dictionaryNoMatch) {
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "long_val:bigint,"
+      "int_val:int,"
+      "string_val:string",
+      [&]() {
+        // Only even values, so that filters on odd values within the min and
+        // max of the row group match no dictionary entry.
+        for (auto i = 0; i < batchCount_; ++i) {
+          std::vector<int64_t> values(batchSize_);
+          for (auto j = 0; j < batchSize_; ++j) {
+            values[j] = (j % 50) * 2;
+          }
+          useSuppliedValues("long_val", i, values);
+        }
+      },
+      false,
+      {"long_val", "int_val", "string_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDoubleDirect) {
   options_.enableDictionary = false;
   options_.dataPageSize = 4 * 1024;
@@ -277,6 +397,22 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::BYTE_STREAM_SPLIT;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_null:float",
+      [&]() { makeAllNulls("float_null"); },
+      true,
+      {"float_val", "double_val", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -449,6 +585,42 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaLengthByteArray) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringUnique("string_val_2");
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, stringDeltaByteArray) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BYTE_ARRAY;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringDistribution("string_val_2", 170, false, true);
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
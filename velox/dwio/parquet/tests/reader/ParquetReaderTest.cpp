@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -646,8 +648,14 @@ TEST_F(ParquetReaderTest, parseIntDecimal) {
   rowReader->next(6, result);
   EXPECT_EQ(result->size(), 6ULL);
   auto decimals = result->as<RowVector>();
-  auto a = decimals->childAt(0)->asFlatVector<int64_t>()->rawValues();
-  auto b = decimals->childAt(1)->asFlatVector<int64_t>()->rawValues();
+  auto a = decimals->childAt(0)
+               ->loadedVector()
+               ->asFlatVector<int64_t>()
+               ->rawValues();
+  auto b = decimals->childAt(1)
+               ->loadedVector()
+               ->asFlatVector<int64_t>()
+               ->rawValues();
   for (int i = 0; i < 3; i++) {
     int index = 2 * i;
     EXPECT_EQ(a[index], expectValues[i]);
@@ -750,6 +758,97 @@ TEST_F(ParquetReaderTest, readSampleEqualFilter) {
       "sample.parquet", sampleSchema(), std::move(filters), expected);
 }
 
+TEST_F(ParquetReaderTest, lazyLoadNonFilterColumns) {
+  // Read sample.parquet with the int filter "a BETWEEN 16 AND 20". 'b' has no
+  // filter and is loaded lazily for the rows that are accessed.
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(sample, readerOpts);
+  auto scanSpec = makeScanSpec(sampleSchema());
+  scanSpec->childByName("a")->setFilter(exec::between(16, 20));
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  // The first row group has no passing rows.
+  VectorPtr result = BaseVector::create(sampleSchema(), 0, leafPool_.get());
+  do {
+    ASSERT_GT(rowReader->next(1'000, result), 0);
+  } while (result->size() == 0);
+  auto* rowVector = result->as<RowVector>();
+  ASSERT_EQ(rowVector->size(), 5);
+  EXPECT_FALSE(rowVector->childAt(0)->isLazy());
+  ASSERT_TRUE(rowVector->childAt(1)->isLazy());
+  auto* lazy = rowVector->childAt(1)->asUnchecked<LazyVector>();
+  EXPECT_FALSE(lazy->isLoaded());
+
+  // Only rows 1 and 3 of the result are decoded.
+  SelectivityVector rows(5, false);
+  rows.setValid(1, true);
+  rows.setValid(3, true);
+  rows.updateBounds();
+  LazyVector::ensureLoadedRows(rowVector->childAt(1), rows);
+  ASSERT_TRUE(lazy->isLoaded());
+  auto* values = lazy->loadedVector()->as<SimpleVector<double>>();
+  EXPECT_EQ(values->valueAt(1), 17);
+  EXPECT_EQ(values->valueAt(3), 19);
+}
+
+TEST_F(ParquetReaderTest, parallelDecoding) {
+  // Read sample.parquet with the int filter "a BETWEEN 5 AND 14" and decode
+  // 'b' on a decoding executor instead of loading it lazily.
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(sample, readerOpts);
+  auto scanSpec = makeScanSpec(sampleSchema());
+  scanSpec->childByName("a")->setFilter(exec::between(5, 14));
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(scanSpec);
+  rowReaderOpts.setDecodingExecutor(
+      std::make_shared<folly::CPUThreadPoolExecutor>(2));
+  rowReaderOpts.setDecodingParallelismFactor(2);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(sampleSchema(), 0, leafPool_.get());
+  ASSERT_EQ(rowReader->next(1'000, result), 10);
+  EXPECT_FALSE(result->as<RowVector>()->childAt(1)->isLazy());
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(10, [](auto row) { return row + 5; }),
+      makeFlatVector<double>(10, [](auto row) { return row + 5; }),
+  });
+  // The first 6 rows come from the first row group.
+  assertEqualVectorPart(expected, result, 0);
+  ASSERT_EQ(rowReader->next(1'000, result), 10);
+  EXPECT_FALSE(result->as<RowVector>()->childAt(1)->isLazy());
+  assertEqualVectorPart(expected, result, 6);
+}
+
+TEST_F(ParquetReaderTest, adaptiveEagerLoad) {
+  // Read sample.parquet one row at a time and load only 'b'. 'b' is read
+  // eagerly after ScanSpec::kLoadRatioWindow loaded LazyVectors, except for
+  // one sampled batch in ScanSpec::kLazySampleInterval. 'a' stays lazy.
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(sample, readerOpts);
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(sampleSchema(), 0, leafPool_.get());
+  for (auto i = 0; i < 20; ++i) {
+    ASSERT_EQ(rowReader->next(1, result), 1);
+    auto* rowVector = result->as<RowVector>();
+    EXPECT_TRUE(rowVector->childAt(0)->isLazy());
+    const bool lazy = i < ScanSpec::kLoadRatioWindow ||
+        (i - ScanSpec::kLoadRatioWindow + 1) % ScanSpec::kLazySampleInterval ==
+            0;
+    EXPECT_EQ(rowVector->childAt(1)->isLazy(), lazy) << i;
+    auto* values =
+        rowVector->childAt(1)->loadedVector()->as<SimpleVector<double>>();
+    EXPECT_EQ(values->valueAt(0), i + 1);
+  }
+}
+
 TEST_F(ParquetReaderTest, dateFilters) {
   // Read date.parquet with the date filter "date BETWEEN 5 AND 14".
   FilterMap filters;
@@ -1146,8 +1245,11 @@ TEST_F(ParquetReaderTest, readVarbinaryFromFLBA) {
   rowReader->next(1, result);
   EXPECT_EQ(
       expected,
-      result->as<RowVector>()->childAt(0)->asFlatVector<StringView>()->valueAt(
-          0));
+      result->as<RowVector>()
+          ->childAt(0)
+          ->loadedVector()
+          ->asFlatVector<StringView>()
+          ->valueAt(0));
 }
 
 TEST_F(ParquetReaderTest, testV2PageWithZeroMaxDefRep) {
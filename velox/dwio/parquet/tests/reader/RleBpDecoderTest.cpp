@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/common/BitPackDecoder.h"
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
 
 #include <arrow/util/rle_encoding.h> // @manual
 #include <gtest/gtest.h>
@@ -140,3 +141,71 @@ TEST(RleBpDecoderTest, DISABLED_allOnes) {
   RleBpDecoderTest<uint8_t> test;
   test.testDecodeSuppliedData(allOnesVector, 1);
 }
+
+namespace {
+
+// Encodes 'values' as one bit-packed run of 'bitWidth' bits per value. The
+// number of values must be a multiple of 8. The run is followed by a word of
+// padding for the wide loads of the decoder.
+template <typename T>
+std::vector<char> encodeBitPackedRun(
+    const std::vector<T>& values,
+    uint8_t bitWidth) {
+  VELOX_CHECK_EQ(values.size() % 8, 0);
+  std::vector<char> encoded;
+  uint64_t header = (values.size() / 8) << 1 | 1;
+  while (header >= 0x80) {
+    encoded.push_back(static_cast<char>(header | 0x80));
+    header >>= 7;
+  }
+  encoded.push_back(static_cast<char>(header));
+  const auto start = encoded.size();
+  encoded.resize(
+      start + bits::nbytes(values.size() * bitWidth) + sizeof(uint64_t));
+  auto* packed = reinterpret_cast<uint8_t*>(encoded.data() + start);
+  for (auto i = 0; i < values.size(); ++i) {
+    for (auto bit = 0; bit < bitWidth; ++bit) {
+      if ((static_cast<uint64_t>(values[i]) >> bit) & 1) {
+        const auto position = i * bitWidth + bit;
+        packed[position / 8] |= 1 << (position % 8);
+      }
+    }
+  }
+  return encoded;
+}
+
+// Decodes a bit-packed run in batches that are not multiples of 8, so that
+// values unpacked for one batch are buffered for the next.
+template <typename T>
+void testNextWithBufferedValues(uint8_t bitWidth) {
+  SCOPED_TRACE(fmt::format("bitWidth {}", bitWidth));
+  std::vector<T> values(64);
+  for (auto i = 0; i < values.size(); ++i) {
+    values[i] = (i * 0x9E3779B97F4A7C15ULL + 1) & bits::lowMask(bitWidth);
+  }
+  auto encoded = encodeBitPackedRun(values, bitWidth);
+  parquet::RleBpDecoder decoder(
+      encoded.data(), encoded.data() + encoded.size(), bitWidth);
+
+  std::vector<T> result(values.size());
+  T* output = result.data();
+  for (auto batchSize : {3, 3, 5, 13, 8, 1, 31}) {
+    decoder.next(output, batchSize);
+  }
+  ASSERT_EQ(result.data() + result.size(), output);
+  EXPECT_EQ(values, result);
+}
+
+} // namespace
+
+TEST(RleBpDecoderTest, nextWithBufferedValues) {
+  for (uint8_t bitWidth : {1, 7, 8}) {
+    testNextWithBufferedValues<uint8_t>(bitWidth);
+  }
+  for (uint8_t bitWidth : {3, 9, 16}) {
+    testNextWithBufferedValues<uint16_t>(bitWidth);
+  }
+  for (uint8_t bitWidth : {5, 17, 32}) {
+    testNextWithBufferedValues<uint32_t>(bitWidth);
+  }
+}
@@ -15,6 +15,7 @@
  */
 
 #include <arrow/type.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
@@ -136,6 +137,171 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, parallelEncoding) {
+  auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), DOUBLE()});
+  const int64_t kRows = 1'000;
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kRows, [&](auto row) { return i * kRows + row; }),
+        makeFlatVector<StringView>(
+            kRows,
+            [&](auto row) {
+              return StringView::makeInline(
+                  fmt::format("{}", (i * kRows + row) % 77));
+            }),
+        makeFlatVector<double>(
+            kRows, [&](auto row) { return (i * kRows + row) * 0.5; }),
+    }));
+  }
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.compression = CompressionKind::CompressionKind_SNAPPY;
+  writerOptions.encodingExecutor =
+      std::make_shared<folly::CPUThreadPoolExecutor>(3);
+  // Each batch fills a row group.
+  writerOptions.flushPolicyFactory = [&]() {
+    return std::make_unique<LambdaFlushPolicy>(
+        kRows, 1L << 30, []() { return false; });
+  };
+
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  for (const auto& batch : batches) {
+    writer->write(batch);
+  }
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), 4 * kRows);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 4);
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(4 * kRows, [](auto row) { return row; }),
+      makeFlatVector<StringView>(
+          4 * kRows,
+          [](auto row) {
+            return StringView::makeInline(fmt::format("{}", row % 77));
+          }),
+      makeFlatVector<double>(4 * kRows, [](auto row) { return row * 0.5; }),
+  });
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+}
+
+TEST_F(ParquetWriterTest, dictionaryVectors) {
+  auto schema = ROW({"c0", "c1", "c2"}, {VARCHAR(), VARCHAR(), VARCHAR()});
+  const vector_size_t kRows = 1'000;
+  const vector_size_t kDistinct = 20;
+  auto makeStrings = [&](const std::string& prefix) {
+    return makeFlatVector<std::string>(kDistinct, [&](auto row) {
+      return fmt::format("{}{}", prefix, row);
+    });
+  };
+  // 'c0' shares its dictionary across batches and is written as the Parquet
+  // dictionary. 'c1' has a new dictionary per batch and 'c2' is flat in the
+  // first batch, so both are flattened.
+  auto shared = makeStrings("shared_");
+  std::vector<RowVectorPtr> batches;
+  std::vector<VectorPtr> expected(3);
+  for (auto i = 0; i < 3; ++i) {
+    auto indices =
+        makeIndices(kRows, [&](auto row) { return (row * 7 + i) % kDistinct; });
+    auto nulls = makeNulls(kRows, [](auto row) { return row % 11 == 0; });
+    std::vector<VectorPtr> children = {
+        BaseVector::wrapInDictionary(nulls, indices, kRows, shared),
+        BaseVector::wrapInDictionary(
+            nullptr, indices, kRows, makeStrings(fmt::format("b{}_", i))),
+        i == 0 ? makeFlatVector<std::string>(
+                     kRows, [](auto row) { return fmt::format("f{}", row); })
+               : BaseVector::wrapInDictionary(nullptr, indices, kRows, shared),
+    };
+    batches.push_back(makeRowVector(children));
+    for (auto j = 0; j < children.size(); ++j) {
+      if (i == 0) {
+        expected[j] = BaseVector::copy(*children[j]);
+      } else {
+        expected[j]->append(children[j].get());
+      }
+    }
+  }
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  for (const auto& batch : batches) {
+    writer->write(batch);
+  }
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), 3 * kRows);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 1);
+  EXPECT_TRUE(reader->fileMetaData()
+                  .rowGroup(0)
+                  .columnChunk(0)
+                  .hasDictionaryPageOffset());
+
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(
+      schema, *rowReader, makeRowVector(expected), *leafPool_);
+}
+
+TEST_F(ParquetWriterTest, encodedRowInput) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  const vector_size_t kRows = 100;
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+       makeFlatVector<std::string>(
+           kRows, [](auto row) { return fmt::format("s{}", row % 7); })});
+  // The top-level input may be a dictionary or a constant over a row vector,
+  // e.g. the output of a filter or a cross join.
+  std::vector<VectorPtr> batches = {
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(kRows, [](auto row) { return kRows - 1 - row; }),
+          kRows,
+          data),
+      BaseVector::wrapInConstant(kRows, 3, data),
+  };
+  auto expected = BaseVector::create<RowVector>(schema, 0, pool());
+  for (const auto& batch : batches) {
+    expected->append(batch.get());
+  }
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  for (const auto& batch : batches) {
+    writer->write(batch);
+  }
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), 2 * kRows);
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
@@ -18,10 +18,13 @@
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
+#include <arrow/util/thread_pool.h>
+#include <folly/container/F14Set.h>
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::parquet {
 
@@ -94,6 +97,30 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
   int64_t bytesFlushed_ = 0;
 };
 
+// Runs the tasks of the Arrow writer on a folly::Executor.
+class ArrowExecutorAdapter : public ::arrow::internal::Executor {
+ public:
+  explicit ArrowExecutorAdapter(std::shared_ptr<folly::Executor> executor)
+      : executor_(std::move(executor)) {}
+
+  int GetCapacity() override {
+    return std::thread::hardware_concurrency();
+  }
+
+ protected:
+  ::arrow::Status SpawnReal(
+      ::arrow::internal::TaskHints /*hints*/,
+      ::arrow::internal::FnOnce<void()> task,
+      ::arrow::StopToken /*stopToken*/,
+      StopCallback&& /*stopCallback*/) override {
+    executor_->add([task = std::move(task)]() mutable { std::move(task)(); });
+    return ::arrow::Status::OK();
+  }
+
+ private:
+  const std::shared_ptr<folly::Executor> executor_;
+};
+
 struct ArrowContext {
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
@@ -102,6 +129,14 @@ struct ArrowContext {
   int64_t stagingBytes = 0;
   // columns, Arrays
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+  // columns, Velox dictionary vectors of the string columns whose first
+  // vector in the row group was a dictionary. These are exported on flush.
+  std::vector<std::vector<VectorPtr>> stagingDictionaries;
+  // True if string dictionary vectors are written as Parquet dictionaries.
+  bool stageDictionaries = false;
+  // Executor for encoding the column chunks of a row group in parallel.
+  // nullptr if the columns are encoded one after another.
+  std::unique_ptr<ArrowExecutorAdapter> encodingExecutor;
 };
 
 Compression::type getArrowParquetCompression(
@@ -144,6 +179,9 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
   properties = properties->enable_store_decimal_as_integer();
+  if (options.writePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   return properties->build();
 }
 
@@ -213,6 +251,125 @@ std::shared_ptr<::arrow::Field> updateFieldNameRecursive(
   }
 }
 
+// Returns true if 'vector' is a dictionary over flat non-null strings, which
+// may be written with its base as the Parquet dictionary.
+bool isStringDictionary(const VectorPtr& vector) {
+  if (vector->encoding() != VectorEncoding::Simple::DICTIONARY ||
+      (vector->typeKind() != TypeKind::VARCHAR &&
+       vector->typeKind() != TypeKind::VARBINARY)) {
+    return false;
+  }
+  const auto& base = vector->valueVector();
+  return base->isFlatEncoding() && !base->mayHaveNulls();
+}
+
+bool hasDistinctValues(const BaseVector& base) {
+  const auto* values = base.asUnchecked<FlatVector<StringView>>();
+  folly::F14FastSet<StringView> distinct;
+  distinct.reserve(values->size());
+  for (auto i = 0; i < values->size(); ++i) {
+    if (!distinct.insert(values->valueAt(i)).second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<::arrow::Array> exportArray(
+    const VectorPtr& vector,
+    const std::shared_ptr<::arrow::DataType>& type,
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
+  ArrowArray array;
+  exportToArrow(vector, array, pool, options);
+  PARQUET_ASSIGN_OR_THROW(auto result, ::arrow::ImportArray(&array, type));
+  return result;
+}
+
+// Exports the staged 'vectors' of a string column of 'type'. If these are
+// dictionaries over the same distinct strings, the strings are exported once
+// and the chunks are Arrow dictionary arrays over them with the Velox indices.
+// The column writer writes these as the dictionary page and the indices
+// without hashing or copying each row. Otherwise the vectors are flattened.
+std::shared_ptr<::arrow::ChunkedArray> exportDictionaries(
+    const std::vector<VectorPtr>& vectors,
+    const std::shared_ptr<::arrow::DataType>& type,
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
+  const auto& base = vectors[0]->valueVector();
+  const bool sharedBase = std::all_of(
+                              vectors.begin(),
+                              vectors.end(),
+                              [&](const auto& vector) {
+                                return vector->encoding() ==
+                                    VectorEncoding::Simple::DICTIONARY &&
+                                    vector->valueVector() == base;
+                              }) &&
+      hasDistinctValues(*base);
+  std::vector<std::shared_ptr<::arrow::Array>> arrays;
+  arrays.reserve(vectors.size());
+  if (!sharedBase) {
+    for (const auto& vector : vectors) {
+      arrays.push_back(exportArray(vector, type, pool, options));
+    }
+    return ::arrow::ChunkedArray::Make(std::move(arrays), type).ValueOrDie();
+  }
+
+  auto dictionary = exportArray(base, type, pool, options);
+  auto dictionaryType = ::arrow::dictionary(::arrow::int32(), type);
+  for (const auto& vector : vectors) {
+    auto indices = std::make_shared<FlatVector<vector_size_t>>(
+        pool,
+        INTEGER(),
+        vector->nulls(),
+        vector->size(),
+        vector->wrapInfo(),
+        std::vector<BufferPtr>{});
+    arrays.push_back(std::make_shared<::arrow::DictionaryArray>(
+        dictionaryType,
+        exportArray(indices, ::arrow::int32(), pool, options),
+        dictionary));
+  }
+  return ::arrow::ChunkedArray::Make(std::move(arrays), dictionaryType)
+      .ValueOrDie();
+}
+
+// Returns 'data' as a RowVector. A dictionary or constant encoded row is
+// turned into a RowVector of its base children wrapped in the same indices,
+// so that the encodings of the children, e.g. string dictionaries, are kept.
+// A null row makes all its columns null.
+RowVectorPtr toRowVector(const VectorPtr& data, memory::MemoryPool* pool) {
+  if (data->encoding() == VectorEncoding::Simple::ROW) {
+    return std::static_pointer_cast<RowVector>(data);
+  }
+  const auto size = data->size();
+  DecodedVector decoded(*data);
+  const auto* base = decoded.base()->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(base, "Expected a row vector: {}", data->toString());
+  auto indices = allocateIndices(size, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  BufferPtr nulls;
+  uint64_t* rawNulls = nullptr;
+  if (decoded.mayHaveNulls()) {
+    nulls = allocateNulls(size, pool);
+    rawNulls = nulls->asMutable<uint64_t>();
+  }
+  for (vector_size_t row = 0; row < size; ++row) {
+    rawIndices[row] = decoded.index(row);
+    if (rawNulls != nullptr && decoded.isNullAt(row)) {
+      bits::setNull(rawNulls, row);
+    }
+  }
+  std::vector<VectorPtr> children;
+  children.reserve(base->childrenSize());
+  for (const auto& child : base->children()) {
+    children.push_back(
+        BaseVector::wrapInDictionary(nulls, indices, size, child));
+  }
+  return std::make_shared<RowVector>(
+      pool, data->type(), nullptr, size, std::move(children));
+}
+
 } // namespace
 
 Writer::Writer(
@@ -239,6 +396,11 @@ Writer::Writer(
       static_cast<TimestampUnit>(options.parquetWriteTimestampUnit);
   arrowContext_->properties =
       getArrowParquetWriterOptions(options, flushPolicy_);
+  arrowContext_->stageDictionaries = options.enableDictionary;
+  if (options.encodingExecutor) {
+    arrowContext_->encodingExecutor =
+        std::make_unique<ArrowExecutorAdapter>(options.encodingExecutor);
+  }
   setMemoryReclaimers();
 }
 
@@ -257,7 +419,12 @@ Writer::Writer(
 void Writer::flush() {
   if (arrowContext_->stagingRows > 0) {
     if (!arrowContext_->writer) {
-      auto arrowProperties = ArrowWriterProperties::Builder().build();
+      ArrowWriterProperties::Builder builder;
+      if (arrowContext_->encodingExecutor) {
+        builder.set_use_threads(true)->set_executor(
+            arrowContext_->encodingExecutor.get());
+      }
+      auto arrowProperties = builder.build();
       PARQUET_ASSIGN_OR_THROW(
           arrowContext_->writer,
           FileWriter::Open(
@@ -269,21 +436,59 @@ void Writer::flush() {
     }
 
     auto fields = arrowContext_->schema->fields();
+    std::vector<std::shared_ptr<::arrow::Field>> tableFields;
     std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks;
     for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
       auto dataType = fields.at(colIdx)->type();
-      auto chunk =
-          ::arrow::ChunkedArray::Make(
-              std::move(arrowContext_->stagingChunks.at(colIdx)), dataType)
-              .ValueOrDie();
+      auto& dictionaries = arrowContext_->stagingDictionaries.at(colIdx);
+      std::shared_ptr<::arrow::ChunkedArray> chunk;
+      if (!dictionaries.empty()) {
+        chunk = exportDictionaries(
+            dictionaries, dataType, generalPool_.get(), options_);
+        dictionaries.clear();
+      } else {
+        chunk = ::arrow::ChunkedArray::Make(
+                    std::move(arrowContext_->stagingChunks.at(colIdx)),
+                    dataType)
+                    .ValueOrDie();
+      }
+      tableFields.push_back(fields.at(colIdx)->WithType(chunk->type()));
       chunks.push_back(chunk);
     }
     auto table = ::arrow::Table::Make(
-        arrowContext_->schema,
+        ::arrow::schema(tableFields),
         std::move(chunks),
         static_cast<int64_t>(arrowContext_->stagingRows));
-    PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
-        *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
+    if (arrowContext_->encodingExecutor) {
+      // Encodes the column chunks of each batch in parallel into buffers of a
+      // buffered row group. The previous row group is written out in column
+      // order when the new one starts and the last one when 'this' closes.
+      PARQUET_THROW_NOT_OK(arrowContext_->writer->NewBufferedRowGroup());
+      ::arrow::TableBatchReader batchReader(*table);
+      std::shared_ptr<::arrow::RecordBatch> batch;
+      for (;;) {
+        PARQUET_THROW_NOT_OK(batchReader.ReadNext(&batch));
+        if (!batch) {
+          break;
+        }
+        PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteRecordBatch(*batch));
+      }
+    } else {
+      // Writes the row groups column by column instead of by WriteTable(),
+      // which requires the table to have the file schema while dictionary
+      // columns have the Arrow dictionary type.
+      const auto rowsInRowGroup =
+          static_cast<int64_t>(flushPolicy_->rowsInRowGroup());
+      for (int64_t offset = 0; offset < table->num_rows();
+           offset += rowsInRowGroup) {
+        const auto size = std::min(rowsInRowGroup, table->num_rows() - offset);
+        PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(size));
+        for (int colIdx = 0; colIdx < table->num_columns(); colIdx++) {
+          PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteColumnChunk(
+              table->column(colIdx), offset, size));
+        }
+      }
+    }
     PARQUET_THROW_NOT_OK(stream_->Flush());
     for (auto& chunk : arrowContext_->stagingChunks) {
       chunk.clear();
@@ -313,9 +518,7 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
-  ArrowArray array;
   ArrowSchema schema;
-  exportToArrow(data, array, generalPool_.get(), options_);
   exportToArrow(data, schema, options_);
 
   // Convert the arrow schema to Schema and then update the column names based
@@ -330,28 +533,42 @@ void Writer::write(const VectorPtr& data) {
         arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
   }
 
-  PARQUET_ASSIGN_OR_THROW(
-      auto recordBatch,
-      ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
   if (!arrowContext_->schema) {
-    arrowContext_->schema = recordBatch->schema();
-    for (int colIdx = 0; colIdx < arrowContext_->schema->num_fields();
-         colIdx++) {
-      arrowContext_->stagingChunks.push_back(
-          std::vector<std::shared_ptr<::arrow::Array>>());
-    }
+    arrowContext_->schema = ::arrow::schema(newFields);
+    arrowContext_->stagingChunks.resize(childSize);
+    arrowContext_->stagingDictionaries.resize(childSize);
   }
 
-  auto bytes = data->estimateFlatSize();
-  auto numRows = data->size();
+  const auto input = toRowVector(data, generalPool_.get());
+  auto bytes = input->estimateFlatSize();
+  auto numRows = input->size();
   if (flushPolicy_->shouldFlush(getStripeProgress(
           arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
     flush();
   }
 
-  for (int colIdx = 0; colIdx < recordBatch->num_columns(); colIdx++) {
-    arrowContext_->stagingChunks.at(colIdx).push_back(
-        recordBatch->column(colIdx));
+  const auto& children = input->children();
+  for (int colIdx = 0; colIdx < childSize; colIdx++) {
+    auto child = children[colIdx];
+    if (child->size() > numRows) {
+      child = child->slice(0, numRows);
+    }
+    // A string column whose first vector in the row group is a dictionary
+    // stays a Velox vector until flush, where the dictionary is reused if it
+    // is the same for all vectors of the column.
+    auto& dictionaries = arrowContext_->stagingDictionaries.at(colIdx);
+    if (!dictionaries.empty() ||
+        (arrowContext_->stageDictionaries &&
+         arrowContext_->stagingChunks.at(colIdx).empty() &&
+         isStringDictionary(child))) {
+      dictionaries.push_back(child);
+      continue;
+    }
+    arrowContext_->stagingChunks.at(colIdx).push_back(exportArray(
+        child,
+        arrowContext_->schema->field(colIdx)->type(),
+        generalPool_.get(),
+        options_));
   }
   arrowContext_->stagingRows += numRows;
   arrowContext_->stagingBytes += bytes;
@@ -394,6 +611,7 @@ parquet::WriterOptions getParquetOptions(
     parquetOptions.parquetWriteTimestampUnit =
         options.parquetWriteTimestampUnit.value();
   }
+  parquetOptions.encodingExecutor = options.encodingExecutor;
   return parquetOptions;
 }
 
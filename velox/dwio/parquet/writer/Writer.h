@@ -105,6 +105,14 @@ struct WriterOptions {
       columnCompressionsMap;
   uint8_t parquetWriteTimestampUnit =
       static_cast<uint8_t>(TimestampUnit::kNano);
+  // Writes the page index (ColumnIndex and OffsetIndex) of each column chunk,
+  // which lets readers skip pages by their statistics.
+  bool writePageIndex = false;
+  // If set, the column chunks of a row group are encoded and compressed in
+  // parallel on this executor and written to the sink in column order once
+  // the row group is complete. The writer waits for the encoding, so this
+  // must not be the executor that runs the writer.
+  std::shared_ptr<folly::Executor> encodingExecutor;
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -472,10 +472,29 @@ using AggregateFunctionFactory = std::function<std::unique_ptr<Aggregate>(
     const TypePtr& resultType,
     const core::QueryConfig& config)>;
 
+/// Aggregates that the window function of an aggregate can compute over
+/// sliding frames from a monotonic deque of candidate rows instead of
+/// aggregating each frame.
+enum class SlidingFrameAggregate {
+  kNone,
+  /// min(x).
+  kMin,
+  /// max(x).
+  kMax,
+  /// min_by(x, y) that returns x of the first row with the smallest y.
+  kMinBy,
+  /// max_by(x, y) that returns x of the first row with the largest y.
+  kMaxBy,
+};
+
 struct AggregateFunctionMetadata {
   /// True if results of the aggregation depend on the order of inputs. For
   /// example, array_agg is order sensitive while count is not.
   bool orderSensitive{true};
+
+  /// Set if the aggregate computes the same results as the sliding frame
+  /// computation of this kind. Only set by the implementations that do.
+  SlidingFrameAggregate slidingFrameAggregate{SlidingFrameAggregate::kNone};
 };
 /// Register an aggregate function with the specified name and signatures. If
 /// registerCompanionFunctions is true, also register companion aggregate and
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+#include <deque>
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -25,10 +26,29 @@ namespace facebook::velox::exec {
 
 namespace {
 
+// Number of partition rows aggregated into a single leaf of the segment tree.
+constexpr vector_size_t kSegmentTreeLeafSize = 32;
+
+// Minimum average frame size in an output block for which the segment tree is
+// used. Smaller frames are cheaper to aggregate from raw input.
+constexpr vector_size_t kMinFrameSizeForSegmentTree = 2 * kSegmentTreeLeafSize;
+
+// Number of partition rows read at a time while building the segment tree.
+constexpr vector_size_t kSegmentTreeBuildBatchSize = 64 * kSegmentTreeLeafSize;
+
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Frames with a moving start, e.g. ROWS BETWEEN k PRECEDING AND CURRENT ROW,
+// cannot be aggregated incrementally. For fixed-size aggregates, these are
+// computed using a segment tree of intermediate results built over the
+// partition. Each leaf of the tree holds the accumulator of
+// kSegmentTreeLeafSize consecutive rows and each inner node combines the
+// accumulators of its 2 children. A frame is then aggregated from the raw
+// input of at most 2 * kSegmentTreeLeafSize rows at its edges plus at most 2
+// tree nodes per level, making the cost of a frame O(log n) instead of O(k).
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -67,6 +87,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
         config);
     aggregate_->setAllocator(stringAllocator_);
 
+    // The segment tree stores intermediate results and requires accumulators
+    // that do not own any memory outside of the group row.
+    if (aggregate_->isFixedSize() &&
+        !aggregate_->accumulatorUsesExternalMemory()) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+    }
+
     // Aggregate initialization.
     // Row layout is:
     //  - null flags - one bit per aggregate.
@@ -90,6 +117,10 @@ class AggregateWindowFunction : public exec::WindowFunction {
         exec::RowContainer::initializedMask(kAccumulatorFlagsOffset),
         /* needed for out of line allocations */ kRowSizeOffset);
     singleGroupRowSize_ += aggregate_->accumulatorFixedWidthSize();
+    // The segment tree allocates an array of group rows. Keep each row
+    // aligned.
+    singleGroupRowSize_ = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
 
     // Construct the single row in the MemoryPool.
     singleGroupRowBufferPtr_ =
@@ -116,6 +147,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTreeNodes_.reset();
+    segmentTreeLevelOffsets_.clear();
   }
 
   void apply(
@@ -163,6 +196,19 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+      if (segmentTreeNodes_ == nullptr) {
+        buildSegmentTree();
+      }
+      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
+      segmentTreeAggregation(
+          validRows,
+          frameMetadata.firstRow,
+          frameMetadata.lastRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -345,6 +391,204 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if frames of the output block should be aggregated using the
+  // segment tree. The tree pays off only if frames are large on average.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (intermediateType_ == nullptr ||
+        partition_->numRows() < kMinFrameSizeForSegmentTree) {
+      return false;
+    }
+
+    int64_t totalFrameSize = 0;
+    validRows.applyToSelected([&](auto i) {
+      totalFrameSize += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return totalFrameSize >=
+        kMinFrameSizeForSegmentTree * validRows.countSelected();
+  }
+
+  // Builds the segment tree over all rows of 'partition_'. The intermediate
+  // results of all the tree nodes are stored in 'segmentTreeNodes_' level by
+  // level, starting with the leaves. 'segmentTreeLevelOffsets_' has the offset
+  // of the first node of each level.
+  void buildSegmentTree() {
+    const auto numRows = partition_->numRows();
+    const auto numLeaves =
+        (numRows + kSegmentTreeLeafSize - 1) / kSegmentTreeLeafSize;
+
+    // Allocate one group row per leaf. Inner levels reuse the prefix of these.
+    auto groupsBuffer = AlignedBuffer::allocate<char>(
+        static_cast<uint64_t>(numLeaves) * singleGroupRowSize_, pool_);
+    std::vector<char*> groups(numLeaves);
+    std::vector<vector_size_t> groupIndices(numLeaves);
+    for (auto i = 0; i < numLeaves; ++i) {
+      groups[i] = groupsBuffer->asMutable<char>() + i * singleGroupRowSize_;
+      groupIndices[i] = i;
+    }
+    aggregate_->initializeNewGroups(groups.data(), groupIndices);
+
+    // Aggregate raw input into the leaves.
+    std::vector<char*> rowGroups(
+        std::max(numLeaves, kSegmentTreeBuildBatchSize));
+    SelectivityVector rows;
+    for (vector_size_t start = 0; start < numRows;
+         start += kSegmentTreeBuildBatchSize) {
+      const auto end = std::min(numRows, start + kSegmentTreeBuildBatchSize);
+      fillArgVectors(start, end - 1);
+      for (auto row = start; row < end; ++row) {
+        rowGroups[row - start] = groups[row / kSegmentTreeLeafSize];
+      }
+      rows.resizeFill(end - start, true);
+      aggregate_->addRawInput(rowGroups.data(), rows, argVectors_, false);
+    }
+
+    // Build the inner levels from the intermediate results of the level
+    // below until reaching the root.
+    std::vector<VectorPtr> levels;
+    auto numNodes = numLeaves;
+    for (;;) {
+      auto& level = levels.emplace_back(
+          BaseVector::create(intermediateType_, numNodes, pool_));
+      aggregate_->extractAccumulators(groups.data(), numNodes, &level);
+      aggregate_->destroy(folly::Range(groups.data(), numNodes));
+      if (numNodes == 1) {
+        break;
+      }
+
+      const auto numParents = (numNodes + 1) / 2;
+      aggregate_->initializeNewGroups(
+          groups.data(),
+          folly::Range<const vector_size_t*>(groupIndices.data(), numParents));
+      for (auto i = 0; i < numNodes; ++i) {
+        rowGroups[i] = groups[i / 2];
+      }
+      rows.resizeFill(numNodes, true);
+      aggregate_->addIntermediateResults(
+          rowGroups.data(), rows, {level}, false);
+      numNodes = numParents;
+    }
+
+    // Concatenate all levels into a single vector.
+    vector_size_t totalNodes = 0;
+    segmentTreeLevelOffsets_.clear();
+    for (const auto& level : levels) {
+      segmentTreeLevelOffsets_.push_back(totalNodes);
+      totalNodes += level->size();
+    }
+    segmentTreeNodes_ =
+        BaseVector::create(intermediateType_, totalNodes, pool_);
+    for (auto i = 0; i < levels.size(); ++i) {
+      segmentTreeNodes_->copy(
+          levels[i].get(), segmentTreeLevelOffsets_[i], 0, levels[i]->size());
+    }
+    segmentTreeIndices_ = allocateIndices(2 * levels.size(), pool_);
+  }
+
+  // Adds the raw input rows ['start', 'end') of 'argVectors_' to the single
+  // group accumulator.
+  void addRawRange(
+      SelectivityVector& rows,
+      vector_size_t start,
+      vector_size_t end) {
+    if (start >= end) {
+      return;
+    }
+    rows.clearAll();
+    rows.setValidRange(start, end, true);
+    rows.updateBounds();
+    aggregate_->addSingleGroupRawInput(
+        rawSingleGroupRow_, rows, argVectors_, false);
+  }
+
+  // Adds the intermediate results of the segment tree leaves ['startLeaf',
+  // 'endLeaf') to the single group accumulator. The tree nodes covering the
+  // range are combined in the order of the partition rows.
+  void addSegmentTreeRange(vector_size_t startLeaf, vector_size_t endLeaf) {
+    auto* rawIndices = segmentTreeIndices_->asMutable<vector_size_t>();
+    const auto maxNodes = segmentTreeIndices_->size() / sizeof(vector_size_t);
+    vector_size_t numLeftNodes = 0;
+    vector_size_t numRightNodes = 0;
+    auto left = startLeaf;
+    auto right = endLeaf;
+    for (auto level = 0; left < right; ++level) {
+      const auto levelOffset = segmentTreeLevelOffsets_[level];
+      if (left & 1) {
+        rawIndices[numLeftNodes++] = levelOffset + left++;
+      }
+      if (right & 1) {
+        rawIndices[maxNodes - ++numRightNodes] = levelOffset + --right;
+      }
+      left >>= 1;
+      right >>= 1;
+    }
+    // Right-side nodes were collected from right to left at the end of the
+    // buffer. Move them after the left-side nodes to keep the rows in order.
+    std::copy(
+        rawIndices + maxNodes - numRightNodes,
+        rawIndices + maxNodes,
+        rawIndices + numLeftNodes);
+    const auto numNodes = numLeftNodes + numRightNodes;
+    if (numNodes == 0) {
+      return;
+    }
+
+    auto nodes = BaseVector::wrapInDictionary(
+        nullptr, segmentTreeIndices_, numNodes, segmentTreeNodes_);
+    SelectivityVector nodeRows(numNodes);
+    aggregate_->addSingleGroupIntermediateResults(
+        rawSingleGroupRow_, nodeRows, {nodes}, false);
+  }
+
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    SelectivityVector rows;
+    rows.resize(maxFrame + 1 - minFrame);
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+
+    validRows.applyToSelected([&](auto i) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      const auto frameStart = frameStartsVector[i];
+      const auto frameEnd = frameEndsVector[i] + 1;
+      // Leaves fully covered by the frame.
+      const auto startLeaf =
+          (frameStart + kSegmentTreeLeafSize - 1) / kSegmentTreeLeafSize;
+      const auto endLeaf = frameEnd / kSegmentTreeLeafSize;
+      if (startLeaf >= endLeaf) {
+        addRawRange(rows, frameStart - minFrame, frameEnd - minFrame);
+      } else {
+        addRawRange(
+            rows,
+            frameStart - minFrame,
+            startLeaf * kSegmentTreeLeafSize - minFrame);
+        addSegmentTreeRange(startLeaf, endLeaf);
+        addRawRange(
+            rows,
+            endLeaf * kSegmentTreeLeafSize - minFrame,
+            frameEnd - minFrame);
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -389,12 +633,265 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
 
+  // Intermediate type of the aggregate. Null if the segment tree cannot be used
+  // for the aggregate.
+  TypePtr intermediateType_;
+
+  // Intermediate results of all the segment tree nodes of the current
+  // partition, level by level. Null if the tree hasn't been built yet.
+  VectorPtr segmentTreeNodes_;
+
+  // Offset in 'segmentTreeNodes_' of the first node of each tree level.
+  std::vector<vector_size_t> segmentTreeLevelOffsets_;
+
+  // Indices of the tree nodes covering a frame. Sized for the max number of
+  // nodes, i.e. 2 per level.
+  BufferPtr segmentTreeIndices_;
+
   // Stores default result value for empty frame aggregation. Window functions
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
 };
 
+// Computes min, max, min_by and max_by over frames whose start and end rows
+// are non-decreasing from one row to the next, e.g. ROWS BETWEEN k PRECEDING
+// AND k FOLLOWING or RANGE frames. Keeps a deque of the frame rows that can
+// still become the extreme value of a later frame: the comparison values of
+// these rows are strictly monotonic from the front to the back, so the front
+// is the result of the current frame. Each row is added and removed at most
+// once, making the cost per row amortized O(1) regardless of the frame size.
+// Blocks whose frames do not move monotonically are computed by the generic
+// AggregateWindowFunction.
+class SlidingMinMaxWindowFunction : public exec::WindowFunction {
+ public:
+  SlidingMinMaxWindowFunction(
+      bool isMax,
+      const std::vector<exec::WindowFunctionArg>& args,
+      const TypePtr& resultType,
+      velox::memory::MemoryPool* pool,
+      HashStringAllocator* stringAllocator,
+      std::unique_ptr<exec::WindowFunction> fallback)
+      : WindowFunction(resultType, pool, stringAllocator),
+        isMax_(isMax),
+        fallback_(std::move(fallback)) {
+    VELOX_CHECK(args.size() == 1 || args.size() == 2);
+    valueIndex_ = args[0].index.value();
+    valueVector_ = BaseVector::create(args[0].type, 0, pool_);
+    if (args.size() == 2) {
+      compareIndex_ = args[1].index.value();
+      compareVector_ = BaseVector::create(args[1].type, 0, pool_);
+    }
+    emptyResult_ = BaseVector::createNullConstant(resultType, 1, pool_);
+  }
+
+  /// Returns true if the sliding computation supports the aggregate of
+  /// 'kind' with 'args'. Sets 'isMax' accordingly.
+  static bool supports(
+      SlidingFrameAggregate kind,
+      const std::vector<exec::WindowFunctionArg>& args,
+      bool& isMax) {
+    size_t numArgs;
+    switch (kind) {
+      case SlidingFrameAggregate::kMin:
+      case SlidingFrameAggregate::kMax:
+        numArgs = 1;
+        break;
+      case SlidingFrameAggregate::kMinBy:
+      case SlidingFrameAggregate::kMaxBy:
+        numArgs = 2;
+        break;
+      default:
+        return false;
+    }
+    if (args.size() != numArgs) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (arg.constantValue || !arg.index.has_value()) {
+        return false;
+      }
+    }
+    // The values are compared using BaseVector::compare. Restrict to
+    // primitive types for which it matches the aggregate. Comparisons of
+    // floating point values in min_by and max_by are not NaN-aware.
+    const auto& compareType = args.back().type;
+    if (!compareType->isPrimitiveType() || !compareType->isOrderable() ||
+        compareType->kind() == TypeKind::UNKNOWN) {
+      return false;
+    }
+    if (numArgs == 2 &&
+        (compareType->kind() == TypeKind::REAL ||
+         compareType->kind() == TypeKind::DOUBLE)) {
+      return false;
+    }
+    isMax = kind == SlidingFrameAggregate::kMax ||
+        kind == SlidingFrameAggregate::kMaxBy;
+    return true;
+  }
+
+  void resetPartition(const exec::WindowPartition* partition) override {
+    partition_ = partition;
+    resetFrames();
+    fallback_->resetPartition(partition);
+  }
+
+  void apply(
+      const BufferPtr& peerGroupStarts,
+      const BufferPtr& peerGroupEnds,
+      const BufferPtr& frameStarts,
+      const BufferPtr& frameEnds,
+      const SelectivityVector& validRows,
+      vector_size_t resultOffset,
+      const VectorPtr& result) override {
+    if (!validRows.hasSelections()) {
+      setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+      return;
+    }
+
+    const auto* rawFrameStarts = frameStarts->as<vector_size_t>();
+    const auto* rawFrameEnds = frameEnds->as<vector_size_t>();
+    vector_size_t lastRow;
+    if (!slidingFrames(validRows, rawFrameStarts, rawFrameEnds, lastRow)) {
+      resetFrames();
+      fallback_->apply(
+          peerGroupStarts,
+          peerGroupEnds,
+          frameStarts,
+          frameEnds,
+          validRows,
+          resultOffset,
+          result);
+      return;
+    }
+
+    // Rows before the first frame start are not needed anymore.
+    const auto firstFrameStart = rawFrameStarts[validRows.begin()];
+    while (!rows_.empty() && rows_.front() < firstFrameStart) {
+      rows_.pop_front();
+    }
+    nextRow_ = std::max(nextRow_, firstFrameStart);
+    const auto firstRow = rows_.empty() ? nextRow_ : rows_.front();
+    fillVectors(firstRow, lastRow);
+
+    vector_size_t lastValidRow = 0;
+    validRows.applyToSelected([&](auto i) {
+      for (; nextRow_ <= rawFrameEnds[i]; ++nextRow_) {
+        addRow(nextRow_, firstRow);
+      }
+      while (!rows_.empty() && rows_.front() < rawFrameStarts[i]) {
+        rows_.pop_front();
+      }
+      if (rows_.empty()) {
+        result->setNull(resultOffset + i, true);
+      } else {
+        result->copy(
+            valueVector_.get(), resultOffset + i, rows_.front() - firstRow, 1);
+      }
+      lastValidRow = i;
+    });
+    lastFrameStart_ = rawFrameStarts[lastValidRow];
+    lastFrameEnd_ = rawFrameEnds[lastValidRow];
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
+ private:
+  void resetFrames() {
+    rows_.clear();
+    nextRow_ = 0;
+    lastFrameStart_ = 0;
+    lastFrameEnd_ = 0;
+  }
+
+  // Returns true if the frame starts and ends of 'validRows' are
+  // non-decreasing, also relative to the last frame of the previous block.
+  // Sets 'lastRow' to the max frame end if so.
+  bool slidingFrames(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t& lastRow) const {
+    auto prevFrameStart = lastFrameStart_;
+    auto prevFrameEnd = lastFrameEnd_;
+    bool sliding = true;
+    validRows.testSelected([&](auto i) {
+      sliding = rawFrameStarts[i] >= prevFrameStart &&
+          rawFrameEnds[i] >= prevFrameEnd;
+      prevFrameStart = rawFrameStarts[i];
+      prevFrameEnd = rawFrameEnds[i];
+      return sliding;
+    });
+    lastRow = prevFrameEnd;
+    return sliding;
+  }
+
+  // Reads the argument columns for partition rows ['firstRow', 'lastRow'].
+  void fillVectors(vector_size_t firstRow, vector_size_t lastRow) {
+    const auto numRows = lastRow + 1 - firstRow;
+    valueVector_->resize(numRows);
+    partition_->extractColumn(valueIndex_, firstRow, numRows, 0, valueVector_);
+    if (compareVector_ != nullptr) {
+      compareVector_->resize(numRows);
+      partition_->extractColumn(
+          compareIndex_, firstRow, numRows, 0, compareVector_);
+    }
+  }
+
+  // Adds partition 'row' to the back of the deque after removing the rows
+  // that it supersedes. The argument vectors start at partition row
+  // 'firstRow'. Rows with an equal comparison value are kept so that the
+  // first of them is returned, as in the aggregate.
+  void addRow(vector_size_t row, vector_size_t firstRow) {
+    const auto& compareVector =
+        compareVector_ != nullptr ? compareVector_ : valueVector_;
+    const auto index = row - firstRow;
+    if (compareVector->isNullAt(index)) {
+      return;
+    }
+    while (!rows_.empty()) {
+      const auto comparison = compareVector->compare(
+          compareVector.get(), rows_.back() - firstRow, index);
+      if (isMax_ ? comparison >= 0 : comparison <= 0) {
+        break;
+      }
+      rows_.pop_back();
+    }
+    rows_.push_back(row);
+  }
+
+  const bool isMax_;
+
+  // Computes the blocks with frames that are not sliding.
+  const std::unique_ptr<exec::WindowFunction> fallback_;
+
+  const exec::WindowPartition* partition_;
+
+  // Column of the result values and, for min_by and max_by, of the values to
+  // compare.
+  column_index_t valueIndex_;
+  std::optional<column_index_t> compareIndex_;
+
+  // Argument values of the frame rows needed for the current block.
+  VectorPtr valueVector_;
+  VectorPtr compareVector_;
+
+  // Partition rows in the current frame that are candidates for the result of
+  // this or a later frame, in increasing row order.
+  std::deque<vector_size_t> rows_;
+
+  // Next partition row to add to 'rows_'.
+  vector_size_t nextRow_{0};
+
+  // Frame bounds of the last row computed with 'rows_'.
+  vector_size_t lastFrameStart_{0};
+  vector_size_t lastFrameEnd_{0};
+
+  // Null result for empty frames.
+  VectorPtr emptyResult_;
+};
+
 } // namespace
 
 void registerAggregateWindowFunction(const std::string& name) {
@@ -418,7 +915,7 @@ void registerAggregateWindowFunction(const std::string& name) {
             HashStringAllocator* stringAllocator,
             const core::QueryConfig& config)
             -> std::unique_ptr<exec::WindowFunction> {
-          return std::make_unique<AggregateWindowFunction>(
+          auto aggregateFunction = std::make_unique<AggregateWindowFunction>(
               name,
               args,
               resultType,
@@ -426,6 +923,24 @@ void registerAggregateWindowFunction(const std::string& name) {
               pool,
               stringAllocator,
               config);
+          // The sliding computation is chosen by the registered
+          // implementation, not the name. E.g. Spark max_by returns the last
+          // of tied rows while the deque keeps the first.
+          const auto* entry = getAggregateFunctionEntry(name);
+          const auto kind = entry != nullptr
+              ? entry->metadata.slidingFrameAggregate
+              : SlidingFrameAggregate::kNone;
+          bool isMax;
+          if (SlidingMinMaxWindowFunction::supports(kind, args, isMax)) {
+            return std::make_unique<SlidingMinMaxWindowFunction>(
+                isMax,
+                args,
+                resultType,
+                pool,
+                stringAllocator,
+                std::move(aggregateFunction));
+          }
+          return aggregateFunction;
         });
   }
 }
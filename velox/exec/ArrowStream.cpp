@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "velox/exec/ArrowStream.h"
+
+#include <cerrno>
+
+#include "velox/exec/Task.h"
 #include "velox/vector/arrow/Bridge.h"
 
 namespace facebook::velox::exec {
@@ -87,4 +91,99 @@ void ArrowStream::close() {
   SourceOperator::close();
 }
 
+namespace {
+// The private data of an ArrowArrayStream exported by exportToArrowStream.
+class TaskArrowStream {
+ public:
+  TaskArrowStream(
+      std::shared_ptr<Task> task,
+      memory::MemoryPool* pool,
+      ArrowOptions options)
+      : task_(std::move(task)), pool_(pool), options_(options) {
+    options_.flattenDictionary = true;
+    options_.flattenConstant = true;
+  }
+
+  int getSchema(ArrowSchema& out) {
+    return call([&]() {
+      const auto& type = task_->planFragment().planNode->outputType();
+      exportToArrow(BaseVector::create(type, 0, pool_), out, options_);
+    });
+  }
+
+  int getNext(ArrowArray& out) {
+    return call([&]() {
+      for (;;) {
+        auto future = ContinueFuture::makeEmpty();
+        auto result = task_->next(&future);
+        if (result != nullptr) {
+          exportToArrow(result, out, pool_, options_);
+          return;
+        }
+        if (!future.valid()) {
+          // End of stream.
+          out.release = nullptr;
+          return;
+        }
+        future.wait();
+      }
+    });
+  }
+
+  const char* lastError() const {
+    return lastError_.empty() ? nullptr : lastError_.c_str();
+  }
+
+  static TaskArrowStream* from(ArrowArrayStream* stream) {
+    return static_cast<TaskArrowStream*>(stream->private_data);
+  }
+
+ private:
+  // Runs 'func' and returns 0 or, if 'func' throws, keeps the error message
+  // for get_last_error and returns EIO.
+  template <typename Func>
+  int call(Func func) {
+    try {
+      func();
+      lastError_.clear();
+      return 0;
+    } catch (const std::exception& e) {
+      lastError_ = e.what();
+      return EIO;
+    }
+  }
+
+  const std::shared_ptr<Task> task_;
+  memory::MemoryPool* const pool_;
+  ArrowOptions options_;
+  std::string lastError_;
+};
+} // namespace
+
+void exportToArrowStream(
+    std::shared_ptr<Task> task,
+    ArrowArrayStream& out,
+    memory::MemoryPool* pool,
+    ArrowOptions options) {
+  VELOX_CHECK_NOT_NULL(task);
+  out.get_schema = [](ArrowArrayStream* stream, ArrowSchema* schema) {
+    return TaskArrowStream::from(stream)->getSchema(*schema);
+  };
+  out.get_next = [](ArrowArrayStream* stream, ArrowArray* array) {
+    return TaskArrowStream::from(stream)->getNext(*array);
+  };
+  out.get_last_error = [](ArrowArrayStream* stream) {
+    return TaskArrowStream::from(stream)->lastError();
+  };
+  out.release = [](ArrowArrayStream* stream) {
+    if (stream->release == nullptr) {
+      return;
+    }
+    delete TaskArrowStream::from(stream);
+    stream->private_data = nullptr;
+    stream->release = nullptr;
+  };
+  out.private_data = new TaskArrowStream(std::move(task), pool, options);
+}
+
 } // namespace facebook::velox::exec
@@ -13,10 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#pragma once
+
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 
 #include "velox/vector/arrow/Abi.h"
+#include "velox/vector/arrow/Bridge.h"
 
 namespace facebook::velox::exec {
 
@@ -47,4 +50,21 @@ class ArrowStream : public SourceOperator {
   std::shared_ptr<ArrowArrayStream> arrowStream_;
 };
 
+class Task;
+
+/// Exports the output of 'task' as an Arrow C stream, the counterpart of the
+/// ArrowStream source. 'task' must be created in serial execution mode and
+/// have all its splits added. Each call of get_next on 'out' runs 'task' on
+/// the calling thread until it produces a batch, so the task does not get
+/// ahead of the consumer. The batches are exported with exportToArrow, which
+/// shares the buffers of the Velox vectors where the layouts match. Dictionary
+/// and constant encodings are flattened so that all batches match the schema.
+/// Allocations made by the export are from 'pool'. 'out' keeps 'task' alive
+/// until released.
+void exportToArrowStream(
+    std::shared_ptr<Task> task,
+    ArrowArrayStream& out,
+    memory::MemoryPool* pool,
+    ArrowOptions options = ArrowOptions{});
+
 } // namespace facebook::velox::exec
@@ -43,9 +43,9 @@ class TypedDistinctAggregations : public DistinctAggregations {
         sizeof(AccumulatorType),
         false, // usesExternalMemory
         1, // alignment
-        nullptr,
-        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
-          VELOX_UNREACHABLE();
+        ARRAY(inputType_),
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
         },
         [this](folly::Range<char**> groups) {
           for (auto* group : groups) {
@@ -89,6 +89,18 @@ class TypedDistinctAggregations : public DistinctAggregations {
     inputForAccumulator_.reset();
   }
 
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) override {
+    auto* arrayVector = input->as<ArrayVector>();
+    decodedInput_.decode(*arrayVector->elements());
+
+    auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+    RowSizeTracker<char, uint32_t> tracker(group[rowSizeOffset_], *allocator_);
+    accumulator->addValues(*arrayVector, index, decodedInput_, allocator_);
+  }
+
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
       override {
     SelectivityVector rows;
@@ -159,6 +171,41 @@ class TypedDistinctAggregations : public DistinctAggregations {
     decodedInput_.decode(*inputForAccumulator_, rows);
   }
 
+  // Writes the distinct values of each group into an ARRAY vector so that the
+  // sets can be spilled and merged back by addSingleGroupSpillInput.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    auto* arrayVector = result->as<ArrayVector>();
+    arrayVector->resize(groups.size());
+
+    auto* rawOffsets =
+        arrayVector->mutableOffsets(groups.size())->asMutable<vector_size_t>();
+    auto* rawSizes =
+        arrayVector->mutableSizes(groups.size())->asMutable<vector_size_t>();
+
+    vector_size_t offset = 0;
+    for (auto i = 0; i < groups.size(); ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      rawSizes[i] = accumulator->size();
+      rawOffsets[i] = offset;
+      offset += accumulator->size();
+    }
+
+    auto& elementsVector = arrayVector->elements();
+    elementsVector->resize(offset);
+
+    offset = 0;
+    for (auto* group : groups) {
+      auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+      if constexpr (std::is_same_v<T, ComplexType>) {
+        offset += accumulator->extractValues(*elementsVector, offset);
+      } else {
+        offset += accumulator->extractValues(
+            *(elementsVector->template as<FlatVector<T>>()), offset);
+      }
+    }
+  }
+
   static TypePtr makeInputTypeForAccumulator(
       const RowTypePtr& rowType,
       const std::vector<column_index_t>& inputs) {
@@ -86,6 +86,14 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the distinct values spilled for a group. 'input' is an ARRAY vector
+  /// produced by the accumulator's spill extract function and 'index' is the
+  /// row of the spilled group in it.
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
@@ -24,6 +24,7 @@
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/DriverExecutor.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Task.h"
 
@@ -168,7 +169,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
-  return common::SpillConfig(
+  common::SpillConfig spillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
       spillFilePrefix,
@@ -185,6 +186,8 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
       queryConfig.spillFileCreateConfig());
+  spillConfig.writeExecutor = task->queryCtx()->spillWriteExecutor();
+  return spillConfig;
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -280,8 +283,21 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* driverExecutor = dynamic_cast<DriverExecutor*>(executor)) {
+    // Prefers the worker that ran the driver last, which likely has the
+    // driver's state in cache. The drivers of a Task share the CPU with
+    // other Tasks by the weight of their group.
+    driverExecutor->addWithAffinity(
+        [driver, driverExecutor]() {
+          driver->lastWorker_ = driverExecutor->currentWorker();
+          Driver::run(driver);
+        },
+        driver->lastWorker_,
+        driver->task()->driverExecutorGroup(driverExecutor));
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -294,6 +310,27 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorHardwareCounters_ =
+      ctx_->queryConfig().operatorTrackHardwareCounters();
+  inlineResume_ = ctx_->queryConfig().driverInlineResume();
+  memoryTimelineMaxSamples_ = ctx_->queryConfig().memoryTimelineMaxSamples();
+  if (memoryTimelineMaxSamples_ > 0) {
+    memoryTimelineSampleIntervalMs_ =
+        ctx_->queryConfig().memoryTimelineSampleIntervalMs();
+  }
+}
+
+bool Driver::maybeResumeInline(Operator* op, ContinueFuture& future) {
+  if (!inlineResume_ || blockingReason_ == BlockingReason::kYield ||
+      !future.isReady() || future.hasException() ||
+      numInlineResumes_ >= kMaxInlineResumesPerRun) {
+    return false;
+  }
+  ++numInlineResumes_;
+  future = ContinueFuture::makeEmpty();
+  blockingReason_ = BlockingReason::kNotBlocked;
+  op->addRuntimeStat("inlineResumes", RuntimeCounter(1));
+  return true;
 }
 
 void Driver::initializeOperators() {
@@ -304,6 +341,13 @@ void Driver::initializeOperators() {
   for (auto& op : operators_) {
     op->initialize();
   }
+  if (!ctx_->queryConfig().operatorCaptureNodeId().empty()) {
+    // Created after DriverAdapters have replaced operators.
+    captures_.resize(operators_.size());
+    for (auto i = 0; i < operators_.size(); ++i) {
+      captures_[i] = OperatorCapture::create(*operators_[i], *ctx_);
+    }
+  }
 }
 
 void Driver::pushdownFilters(int operatorIndex) {
@@ -381,6 +425,27 @@ void Driver::enqueueInternal() {
   queueTimeStartUs_ = getCurrentTimeMicro();
 }
 
+namespace {
+// Records the Operator being called in the ThreadDebugInfo of its Driver so
+// that profiler samples can be attributed to it.
+class OperatorDebugInfoSetter {
+ public:
+  OperatorDebugInfoSetter(process::ThreadDebugInfo& info, const Operator* op)
+      : info_(info) {
+    info_.planNodeId_ = &op->planNodeId();
+    info_.operatorType_ = &op->operatorType();
+  }
+
+  ~OperatorDebugInfoSetter() {
+    info_.planNodeId_ = nullptr;
+    info_.operatorType_ = nullptr;
+  }
+
+ private:
+  process::ThreadDebugInfo& info_;
+};
+} // namespace
+
 // Call an Oprator method. record silenced throws, but not a query
 // terminating throw. Annotate exceptions with Operator info.
 #define CALL_OPERATOR(call, operatorPtr, operatorId, operatorMethod)       \
@@ -388,6 +453,8 @@ void Driver::enqueueInternal() {
     Operator::NonReclaimableSectionGuard nonReclaimableGuard(operatorPtr); \
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
+    OperatorDebugInfoSetter debugInfoSetter(                               \
+        ctx_->threadDebugInfo, operatorPtr);                               \
     opCallStatus_.start(operatorId, operatorMethod);                       \
     ExceptionContextSetter exceptionContext(                               \
         {addContextOnException, operatorPtr, true});                       \
@@ -428,6 +495,21 @@ size_t OpCallStatusRaw::callDuration() const {
       : fmt::format("null::{}", operatorMethod);
 }
 
+// static
+void Driver::addPerfCounterStats(
+    Operator& op,
+    const process::PerfCounterValues& delta) {
+  using Values = process::PerfCounterValues;
+  static const char* const kNames[Values::kNumCounters] = {
+      "hwCycles", "hwInstructions", "hwLlcMisses", "hwDtlbMisses"};
+  auto lockedStats = op.stats().wlock();
+  for (auto i = 0; i < Values::kNumCounters; ++i) {
+    if (process::PerfCounters::available(static_cast<Values::Counter>(i))) {
+      lockedStats->addRuntimeStat(kNames[i], RuntimeCounter(delta.values[i]));
+    }
+  }
+}
+
 CpuWallTiming Driver::processLazyTiming(
     Operator& op,
     const CpuWallTiming& timing) {
@@ -486,6 +568,20 @@ bool Driver::checkUnderArbitration(ContinueFuture* future) {
   return task()->queryCtx()->checkUnderArbitration(future);
 }
 
+void Driver::maybeSampleMemory() {
+  if (memoryTimelineSampleIntervalMs_ == 0) {
+    return;
+  }
+  const auto nowMs = getCurrentTimeMs();
+  if (nowMs < nextMemorySampleMs_) {
+    return;
+  }
+  nextMemorySampleMs_ = nowMs + memoryTimelineSampleIntervalMs_;
+  for (auto& op : operators_) {
+    op->recordMemorySample(nowMs, memoryTimelineMaxSamples_);
+  }
+}
+
 StopReason Driver::runInternal(
     std::shared_ptr<Driver>& self,
     std::shared_ptr<BlockingState>& blockingState,
@@ -547,8 +643,10 @@ StopReason Driver::runInternal(
 
     const int32_t numOperators = operators_.size();
     ContinueFuture future = ContinueFuture::makeEmpty();
+    numInlineResumes_ = 0;
 
     for (;;) {
+      maybeSampleMemory();
       for (int32_t i = numOperators - 1; i >= 0; --i) {
         stop = task()->shouldStop();
         if (stop != StopReason::kNone) {
@@ -556,14 +654,25 @@ StopReason Driver::runInternal(
           return stop;
         }
 
+        auto* op = operators_[i].get();
+
         if (FOLLY_UNLIKELY(shouldYield())) {
           recordYieldCount();
+          if (task()->maybeParkDriver(ctx_->pipelineId, &future)) {
+            // The pipeline produces faster than its consumers. Parks
+            // instead of going back to the run queue.
+            curOperatorId_ = i;
+            blockedOperatorId_ = i;
+            blockingReason_ = BlockingReason::kYield;
+            blockingState = std::make_shared<BlockingState>(
+                self, std::move(future), op, blockingReason_);
+            guard.notThrown();
+            return StopReason::kBlock;
+          }
           guard.notThrown();
           return StopReason::kYield;
         }
 
-        auto* op = operators_[i].get();
-
         // In case we are blocked, this index will point to the operator, whose
         // queuedTime we should update.
         curOperatorId_ = i;
@@ -592,8 +701,13 @@ StopReason Driver::runInternal(
             curOperatorId_,
             kOpMethodIsBlocked);
         if (blockingReason_ != BlockingReason::kNotBlocked) {
-          blockedOperatorId_ = curOperatorId_;
           checkIsBlockFutureValid(op, future);
+          if (maybeResumeInline(op, future)) {
+            // Runs the same operator again.
+            ++i;
+            continue;
+          }
+          blockedOperatorId_ = curOperatorId_;
           blockingState = std::make_shared<BlockingState>(
               self, std::move(future), op, blockingReason_);
           guard.notThrown();
@@ -609,8 +723,12 @@ StopReason Driver::runInternal(
               curOperatorId_ + 1,
               kOpMethodIsBlocked);
           if (blockingReason_ != BlockingReason::kNotBlocked) {
-            blockedOperatorId_ = curOperatorId_ + 1;
             checkIsBlockFutureValid(nextOp, future);
+            if (maybeResumeInline(nextOp, future)) {
+              ++i;
+              continue;
+            }
+            blockedOperatorId_ = curOperatorId_ + 1;
             blockingState = std::make_shared<BlockingState>(
                 self, std::move(future), nextOp, blockingReason_);
             guard.notThrown();
@@ -632,6 +750,7 @@ StopReason Driver::runInternal(
                     auto elapsedSelfTime = processLazyTiming(*op, elapsedTime);
                     op->stats().wlock()->getOutputTiming.add(elapsedSelfTime);
                   });
+              auto counters = createDeltaPerfCounters(op);
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
               CALL_OPERATOR(
@@ -665,6 +784,7 @@ StopReason Driver::runInternal(
                     nextOp->stats().wlock()->addInputTiming.add(
                         elapsedSelfTime);
                   });
+              auto counters = createDeltaPerfCounters(nextOp);
               {
                 auto lockedStats = nextOp->stats().wlock();
                 lockedStats->addInputVector(
@@ -673,6 +793,9 @@ StopReason Driver::runInternal(
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
+              if (!captures_.empty() && captures_[i + 1] != nullptr) {
+                captures_[i + 1]->addInput(intermediateResult);
+              }
 
               CALL_OPERATOR(
                   nextOp->addInput(intermediateResult),
@@ -702,8 +825,12 @@ StopReason Driver::runInternal(
                   curOperatorId_,
                   kOpMethodIsBlocked);
               if (blockingReason_ != BlockingReason::kNotBlocked) {
-                blockedOperatorId_ = curOperatorId_;
                 checkIsBlockFutureValid(op, future);
+                if (maybeResumeInline(op, future)) {
+                  ++i;
+                  continue;
+                }
+                blockedOperatorId_ = curOperatorId_;
                 blockingState = std::make_shared<BlockingState>(
                     self, std::move(future), op, blockingReason_);
                 guard.notThrown();
@@ -722,6 +849,7 @@ StopReason Driver::runInternal(
                           processLazyTiming(*op, elapsedTime);
                       op->stats().wlock()->finishTiming.add(elapsedSelfTime);
                     });
+                auto counters = createDeltaPerfCounters(op);
                 TestValue::adjust(
                     "facebook::velox::exec::Driver::runInternal::noMoreInput",
                     nextOp);
@@ -745,6 +873,7 @@ StopReason Driver::runInternal(
                   auto elapsedSelfTime = processLazyTiming(*op, elapsedTime);
                   op->stats().wlock()->getOutputTiming.add(elapsedSelfTime);
                 });
+            auto counters = createDeltaPerfCounters(op);
             CALL_OPERATOR(
                 result = op->getOutput(),
                 op,
@@ -840,6 +969,8 @@ void Driver::run(std::shared_ptr<Driver> self) {
 
   switch (reason) {
     case StopReason::kBlock:
+      self->task()->onDriverBlocked(
+          self->driverCtx()->pipelineId, self->blockingReason_);
       // Set the resume action outside the Task so that, if the
       // future is already realized we do not have a second thread
       // entering the same Driver.
@@ -1121,6 +1252,12 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kYield";
     case BlockingReason::kWaitForArbitration:
       return "kWaitForArbitration";
+    case BlockingReason::kWaitForAggregationMerge:
+      return "kWaitForAggregationMerge";
+    case BlockingReason::kWaitForSortRangePartition:
+      return "kWaitForSortRangePartition";
+    case BlockingReason::kWaitForWindowPartitions:
+      return "kWaitForWindowPartitions";
   }
   VELOX_UNREACHABLE();
   return "";
@@ -22,12 +22,14 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/OperatorCapture.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
@@ -214,6 +216,15 @@ enum class BlockingReason {
   /// Operator is blocked waiting for its associated query memory arbitration to
   /// finish.
   kWaitForArbitration,
+  /// Final aggregation operator is blocked waiting for its peers to consume
+  /// all their input before merging the grouping sets across drivers.
+  kWaitForAggregationMerge,
+  /// OrderBy operator is blocked waiting for its peers to sort all their input
+  /// before range partitioning the sorted rows across drivers.
+  kWaitForSortRangePartition,
+  /// Window operator is blocked waiting for its peers to sort all their input
+  /// before splitting the window partitions across drivers.
+  kWaitForWindowPartitions,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -396,6 +407,15 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// the memory arbiration finishes.
   bool checkUnderArbitration(ContinueFuture* future);
 
+  /// Returns true if 'op' reported blocked on 'future' but 'future' is already
+  /// fulfilled and the driver may continue on thread. Resets 'future' and
+  /// 'blockingReason_' in that case.
+  bool maybeResumeInline(Operator* op, ContinueFuture& future);
+
+  /// Samples the memory usage of the operators if the sampling interval has
+  /// passed since the last sample.
+  void maybeSampleMemory();
+
   void initializeOperatorStats(std::vector<OperatorStats>& stats);
 
   /// Close operators and add operator stats to the task.
@@ -501,6 +521,23 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  // If 'trackOperatorHardwareCounters_' is true, returns an object that
+  // adds the hardware counters of an operation of 'op' to its runtime stats
+  // upon destruction. Returns null otherwise.
+  auto createDeltaPerfCounters(Operator* op) {
+    auto func = [op](const process::PerfCounterValues& delta) {
+      addPerfCounterStats(*op, delta);
+    };
+    using Counters = process::DeltaPerfCounters<decltype(func)>;
+    return trackOperatorHardwareCounters_
+        ? std::make_unique<Counters>(std::move(func))
+        : nullptr;
+  }
+
+  static void addPerfCounterStats(
+      Operator& op,
+      const process::PerfCounterValues& delta);
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -525,6 +562,20 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   // Timer used to track down the time we are sitting in the driver queue.
   size_t queueTimeStartUs_{0};
+
+  // The worker of a DriverExecutor that ran 'this' last, -1 if none. Set by
+  // the thread running 'this' before 'this' can be enqueued again.
+  int32_t lastWorker_{-1};
+
+  // Bounds the inline resumes in one run so that an operator that keeps
+  // returning fulfilled futures without progress still goes off thread.
+  static constexpr int32_t kMaxInlineResumesPerRun = 64;
+
+  // True if a fulfilled blocking future resumes 'this' on thread. See
+  // QueryConfig::kDriverInlineResume.
+  bool inlineResume_{false};
+  int32_t numInlineResumes_{0};
+
   // Id (index in the vector) of the current operator to run (or the 1st one if
   // we haven't started yet). Used to determine which operator's queueTime we
   // should update.
@@ -537,6 +588,20 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool trackOperatorHardwareCounters_{false};
+
+  // Input captures of the operators of the plan node selected by the query
+  // config operator_capture_node_id, indexed like 'operators_'. Empty if the
+  // capture is off.
+  std::vector<std::unique_ptr<OperatorCapture>> captures_;
+
+  // The interval and the max number of the memory usage samples of the
+  // operators. Sampling is disabled if the interval is 0.
+  uint64_t memoryTimelineSampleIntervalMs_{0};
+  uint32_t memoryTimelineMaxSamples_{0};
+  // The time of the next memory usage sample in milliseconds since epoch.
+  uint64_t nextMemorySampleMs_{0};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverExecutor.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/process/ProcessBase.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+namespace {
+// The executor and worker index of the calling thread. Null and -1 on
+// threads that are not workers of a DriverExecutor.
+thread_local const DriverExecutor* currentExecutor{nullptr};
+thread_local int32_t currentWorkerIndex{-1};
+} // namespace
+
+std::string DriverExecutor::Stats::toString() const {
+  return fmt::format(
+      "runs {} steals {} queue time {} max {}",
+      numRuns,
+      numSteals,
+      succinctMicros(queueTimeUs),
+      succinctMicros(maxQueueTimeUs));
+}
+
+DriverExecutor::DriverExecutor(int32_t numThreads) {
+  VELOX_CHECK_GT(numThreads, 0);
+  queues_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  threads_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    threads_.emplace_back([this, i]() { run(i); });
+  }
+}
+
+DriverExecutor::~DriverExecutor() {
+  {
+    std::lock_guard<std::mutex> l(sleepMutex_);
+    stop_ = true;
+  }
+  wakeUp_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void DriverExecutor::add(folly::Func func) {
+  const auto worker = currentWorker();
+  enqueue(
+      std::move(func),
+      worker >= 0 ? worker : nextQueue_++ % queues_.size(),
+      nullptr);
+}
+
+void DriverExecutor::addWithAffinity(
+    folly::Func func,
+    int32_t worker,
+    std::shared_ptr<Group> group) {
+  if (worker < 0 || worker >= queues_.size()) {
+    const auto current = currentWorker();
+    worker = current >= 0 ? current : nextQueue_++ % queues_.size();
+  }
+  enqueue(std::move(func), worker, std::move(group));
+}
+
+std::shared_ptr<DriverExecutor::Group> DriverExecutor::makeGroup(
+    int32_t weight) {
+  VELOX_CHECK_GT(weight, 0);
+  return std::shared_ptr<Group>(new Group(weight, virtualTimeNanos_));
+}
+
+int32_t DriverExecutor::currentWorker() const {
+  return currentExecutor == this ? currentWorkerIndex : -1;
+}
+
+void DriverExecutor::enqueue(
+    folly::Func func,
+    int32_t worker,
+    std::shared_ptr<Group> group) {
+  {
+    auto& queue = *queues_[worker];
+    auto* groupPtr = group.get();
+    Item item{std::move(func), getCurrentTimeMicro(), std::move(group)};
+    std::lock_guard<std::mutex> l(queue.mutex);
+    auto it = std::find_if(
+        queue.groups.begin(), queue.groups.end(), [&](const auto& items) {
+          return items.group == groupPtr;
+        });
+    if (it == queue.groups.end()) {
+      queue.groups.push_back({groupPtr, {}});
+      it = queue.groups.end() - 1;
+    }
+    it->items.push_back(std::move(item));
+  }
+  ++numQueued_;
+  // A worker increments 'numSleeping_' before checking 'numQueued_' under
+  // 'sleepMutex_', so either it sees the new item or it is woken up here.
+  if (numSleeping_ > 0) {
+    std::lock_guard<std::mutex> l(sleepMutex_);
+    wakeUp_.notify_one();
+  }
+}
+
+// static
+bool DriverExecutor::takeFromQueue(Queue& queue, bool front, Item& item) {
+  std::lock_guard<std::mutex> l(queue.mutex);
+  if (queue.groups.empty()) {
+    return false;
+  }
+  // Work without a group comes first, then the group with the least virtual
+  // time.
+  auto best = queue.groups.begin();
+  for (auto it = queue.groups.begin(); it != queue.groups.end(); ++it) {
+    if (it->group == nullptr) {
+      best = it;
+      break;
+    }
+    if (it->group->virtualTimeNanos() < best->group->virtualTimeNanos()) {
+      best = it;
+    }
+  }
+  auto& items = best->items;
+  if (front) {
+    item = std::move(items.front());
+    items.pop_front();
+  } else {
+    item = std::move(items.back());
+    items.pop_back();
+  }
+  if (items.empty()) {
+    queue.groups.erase(best);
+  }
+  return true;
+}
+
+bool DriverExecutor::take(int32_t worker, Item& item) {
+  const auto numQueues = queues_.size();
+  for (auto i = 0; i < numQueues; ++i) {
+    // The owner runs its queue in order. A thief takes the most recently
+    // added item, which is the least likely to be taken by the owner soon.
+    if (!takeFromQueue(*queues_[(worker + i) % numQueues], i == 0, item)) {
+      continue;
+    }
+    if (i > 0) {
+      ++numSteals_;
+    }
+    if (item.group != nullptr) {
+      virtualTimeNanos_ = item.group->virtualTimeNanos();
+    }
+    --numQueued_;
+    return true;
+  }
+  return false;
+}
+
+void DriverExecutor::charge(Group& group, uint64_t cpuNanos) {
+  group.virtualTimeNanos_ += cpuNanos / group.weight_;
+}
+
+void DriverExecutor::run(int32_t worker) {
+  currentExecutor = this;
+  currentWorkerIndex = worker;
+  for (;;) {
+    Item item;
+    if (take(worker, item)) {
+      const auto queueTimeUs = getCurrentTimeMicro() - item.enqueueTimeUs;
+      ++numRuns_;
+      queueTimeUs_ += queueTimeUs;
+      auto maxQueueTimeUs = maxQueueTimeUs_.load();
+      while (queueTimeUs > maxQueueTimeUs &&
+             !maxQueueTimeUs_.compare_exchange_weak(
+                 maxQueueTimeUs, queueTimeUs)) {
+      }
+      const auto cpuNanos = process::threadCpuNanos();
+      try {
+        item.func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "DriverExecutor function threw: " << e.what();
+      }
+      if (item.group != nullptr) {
+        charge(*item.group, process::threadCpuNanos() - cpuNanos);
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> l(sleepMutex_);
+    ++numSleeping_;
+    wakeUp_.wait(l, [&]() { return stop_ || numQueued_ > 0; });
+    --numSleeping_;
+    if (stop_ && numQueued_ == 0) {
+      return;
+    }
+  }
+}
+
+DriverExecutor::Stats DriverExecutor::stats() const {
+  Stats stats;
+  stats.numRuns = numRuns_;
+  stats.numSteals = numSteals_;
+  stats.queueTimeUs = queueTimeUs_;
+  stats.maxQueueTimeUs = maxQueueTimeUs_;
+  return stats;
+}
+
+} // namespace facebook::velox::exec
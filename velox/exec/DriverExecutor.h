@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/lang/Align.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Executor for running Drivers with a run queue per worker thread instead of
+/// one queue shared by all threads. A worker takes work from its own queue
+/// first and steals from the other queues when its own is empty. Work added
+/// from a worker goes to that worker's queue. A Driver that is resumed is
+/// added to the queue of the worker that last ran it, so that it is likely to
+/// run on the same core with a warm cache. May be passed as the executor of a
+/// QueryCtx in place of a CPUThreadPoolExecutor.
+///
+/// Work may belong to a Group, e.g. the Drivers of a Task. Groups share the
+/// CPU in proportion to their weights: the CPU time of each run is charged
+/// to its group divided by the group's weight, and a worker runs the work of
+/// the group with the least charged time first. Work without a group runs
+/// before any group's work.
+class DriverExecutor : public folly::Executor {
+ public:
+  class Group {
+   public:
+    int32_t weight() const {
+      return weight_;
+    }
+
+    /// CPU time in nanoseconds charged to 'this', divided by 'weight_'.
+    uint64_t virtualTimeNanos() const {
+      return virtualTimeNanos_;
+    }
+
+   private:
+    Group(int32_t weight, uint64_t virtualTimeNanos)
+        : weight_(weight), virtualTimeNanos_(virtualTimeNanos) {}
+
+    const int32_t weight_;
+    std::atomic<uint64_t> virtualTimeNanos_;
+
+    friend class DriverExecutor;
+  };
+
+  struct Stats {
+    /// Number of functions run.
+    uint64_t numRuns{0};
+    /// Number of functions run by a worker other than the one whose queue
+    /// they were added to.
+    uint64_t numSteals{0};
+    /// Time in microseconds between adding and starting the functions.
+    uint64_t queueTimeUs{0};
+    uint64_t maxQueueTimeUs{0};
+
+    std::string toString() const;
+  };
+
+  /// Starts 'numThreads' worker threads.
+  explicit DriverExecutor(int32_t numThreads);
+
+  /// Runs the queued functions and joins the worker threads.
+  ~DriverExecutor() override;
+
+  /// Adds 'func' to the queue of the calling worker thread or, if not called
+  /// from a worker of 'this', to the queues in round robin order.
+  void add(folly::Func func) override;
+
+  /// Adds 'func' to the queue of 'worker'. Same as add() if 'worker' is not
+  /// the index of a worker thread of 'this'. The CPU time of 'func' is
+  /// charged to 'group' if set.
+  void addWithAffinity(
+      folly::Func func,
+      int32_t worker,
+      std::shared_ptr<Group> group = nullptr);
+
+  /// Returns a new group with 'weight'. The group starts at the virtual time
+  /// of the most recently run group, so that it does not get ahead of the
+  /// groups that ran before it was made.
+  std::shared_ptr<Group> makeGroup(int32_t weight);
+
+  /// Returns the index of the worker thread of 'this' the caller runs on, or
+  /// -1 if the caller does not run on a worker of 'this'.
+  int32_t currentWorker() const;
+
+  int32_t numThreads() const {
+    return threads_.size();
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Item {
+    folly::Func func;
+    uint64_t enqueueTimeUs;
+    std::shared_ptr<Group> group;
+  };
+
+  // The items of one group in a run queue.
+  struct GroupItems {
+    Group* group;
+    std::deque<Item> items;
+  };
+
+  // A run queue. Cache line aligned so that queues of different workers do
+  // not share a cache line.
+  struct alignas(folly::hardware_destructive_interference_size) Queue {
+    std::mutex mutex;
+    // The items by group. There are few groups per queue at a time, so the
+    // group to run next is found by a linear scan.
+    std::vector<GroupItems> groups;
+  };
+
+  void enqueue(folly::Func func, int32_t worker, std::shared_ptr<Group> group);
+
+  // Takes the first item of the queue of 'worker' or steals the last item of
+  // another queue. Takes the items of the group with the least virtual time
+  // first. Returns false if all queues are empty.
+  bool take(int32_t worker, Item& item);
+
+  // Takes an item of the group with the least virtual time in 'queue'.
+  // Returns false if 'queue' is empty.
+  static bool takeFromQueue(Queue& queue, bool front, Item& item);
+
+  // Charges 'cpuNanos' to 'group'.
+  void charge(Group& group, uint64_t cpuNanos);
+
+  void run(int32_t worker);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+
+  // Round robin counter for add() from outside of the workers.
+  std::atomic<uint32_t> nextQueue_{0};
+
+  // Number of items in all queues.
+  std::atomic<int64_t> numQueued_{0};
+  // Number of workers waiting for work on 'wakeUp_'.
+  std::atomic<int32_t> numSleeping_{0};
+  std::mutex sleepMutex_;
+  std::condition_variable wakeUp_;
+  bool stop_{false};
+
+  // The virtual time of the group whose work started last. New groups start
+  // here.
+  std::atomic<uint64_t> virtualTimeNanos_{0};
+
+  std::atomic<uint64_t> numRuns_{0};
+  std::atomic<uint64_t> numSteals_{0};
+  std::atomic<uint64_t> queueTimeUs_{0};
+  std::atomic<uint64_t> maxQueueTimeUs_{0};
+};
+
+} // namespace facebook::velox::exec
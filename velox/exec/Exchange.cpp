@@ -177,7 +177,7 @@ void Exchange::recordExchangeClientStats() {
 }
 
 VectorSerde* Exchange::getSerde() {
-  return getVectorSerde();
+  return serde_;
 }
 
 } // namespace facebook::velox::exec
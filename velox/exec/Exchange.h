@@ -51,6 +51,8 @@ class Exchange : public SourceOperator {
             operatorType),
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
+        serde_{getNamedOrDefaultVectorSerde(
+            driverCtx->queryConfig().shuffleSerde())},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
         exchangeClient_{std::move(exchangeClient)} {
     options_.compressionKind =
@@ -94,6 +96,9 @@ class Exchange : public SourceOperator {
 
   const uint64_t preferredOutputBatchBytes_;
 
+  // Deserializes the pages. Set by QueryConfig::kShuffleSerde.
+  VectorSerde* const serde_;
+
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
@@ -17,6 +17,8 @@
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/process/TraceSpan.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -110,6 +112,10 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  stats["creditWaitWallNanos"] =
+      RuntimeMetric(creditWaitUs_ * 1'000, RuntimeCounter::Unit::kNanos);
+  stats["bdpRequestedBytes"] =
+      RuntimeMetric(bdpRequestedBytes_, RuntimeCounter::Unit::kBytes);
 
   return stats;
 }
@@ -146,6 +152,11 @@ ExchangeClient::next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future) {
 void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   auto self = shared_from_this();
   for (auto& spec : requestSpecs) {
+    std::shared_ptr<process::TraceSpan> span;
+    if (process::TraceSpan::isSampled(queryId_)) {
+      span = std::make_shared<process::TraceSpan>(
+          "ExchangeClient::request", queryId_);
+    }
     auto future = folly::SemiFuture<ExchangeSource::Response>::makeEmpty();
     if (spec.maxBytes == 0) {
       future = spec.source->requestDataSizes(kRequestDataSizesMaxWait);
@@ -157,8 +168,16 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
         .via(executor_)
         .thenValue([self,
                     spec = std::move(spec),
-                    sendTimeMs = getCurrentTimeMs()](auto&& response) {
+                    span = std::move(span),
+                    sendTimeMs = getCurrentTimeMs(),
+                    sendTimeUs = getCurrentTimeMicro()](auto&& response) {
           const auto requestTimeMs = getCurrentTimeMs() - sendTimeMs;
+          const auto requestTimeUs = getCurrentTimeMicro() - sendTimeUs;
+          if (span != nullptr) {
+            span->addAttribute("maxBytes", std::to_string(spec.maxBytes));
+            span->addAttribute("bytes", std::to_string(response.bytes));
+            span->addAttribute("atEnd", response.atEnd ? "true" : "false");
+          }
           if (spec.maxBytes == 0) {
             RECORD_HISTOGRAM_METRIC_VALUE(
                 kMetricExchangeDataSizeTimeMs, requestTimeMs);
@@ -178,6 +197,10 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
             if (self->closed_) {
               return;
             }
+            if (spec.maxBytes > 0) {
+              self->updateFlowLocked(
+                  spec.source.get(), response.bytes, requestTimeUs);
+            }
             if (!response.atEnd) {
               if (!response.remainingBytes.empty()) {
                 for (auto bytes : response.remainingBytes) {
@@ -185,7 +208,8 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
                 }
                 self->producingSources_.push(
                     {std::move(spec.source),
-                     std::move(response.remainingBytes)});
+                     std::move(response.remainingBytes),
+                     getCurrentTimeMicro()});
               } else {
                 self->emptySources_.push(std::move(spec.source));
               }
@@ -240,9 +264,19 @@ ExchangeClient::pickSourcesToRequestLocked() {
       VELOX_CHECK_LT(availableSpace, 0);
       break;
     }
+    if (bdpRequestSizing_ && availableSpace > 0) {
+      auto it = flows_.find(source.get());
+      if (it != flows_.end()) {
+        const auto extraBytes =
+            std::min(availableSpace, it->second.creditBytes());
+        requestBytes += extraBytes;
+        availableSpace -= extraBytes;
+        bdpRequestedBytes_ += extraBytes;
+      }
+    }
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    popProducingSourceLocked();
     totalPendingBytes_ += requestBytes;
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
@@ -255,12 +289,37 @@ ExchangeClient::pickSourcesToRequestLocked() {
               << " bytes, exceeding capacity " << maxQueuedBytes_;
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
+    popProducingSourceLocked();
     totalPendingBytes_ += requestBytes;
   }
   return requestSpecs;
 }
 
+void ExchangeClient::popProducingSourceLocked() {
+  creditWaitUs_ +=
+      getCurrentTimeMicro() - producingSources_.front().queuedTimeUs;
+  producingSources_.pop();
+}
+
+void ExchangeClient::updateFlowLocked(
+    const ExchangeSource* source,
+    int64_t bytes,
+    uint64_t requestTimeUs) {
+  const auto nowUs = getCurrentTimeMicro();
+  auto& flow = flows_[source];
+  if (flow.lastResponseTimeUs == 0) {
+    flow.roundTripUs = requestTimeUs;
+  } else {
+    const double bytesPerUs = static_cast<double>(bytes) /
+        std::max<uint64_t>(1, nowUs - flow.lastResponseTimeUs);
+    flow.bytesPerUs = SourceFlow::kDecay * flow.bytesPerUs +
+        (1 - SourceFlow::kDecay) * bytesPerUs;
+    flow.roundTripUs = SourceFlow::kDecay * flow.roundTripUs +
+        (1 - SourceFlow::kDecay) * requestTimeUs;
+  }
+  flow.lastResponseTimeUs = nowUs;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/process/TraceSpan.h"
 #include "velox/exec/ExchangeQueue.h"
 #include "velox/exec/ExchangeSource.h"
 
@@ -34,10 +35,13 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
       int destination,
       int64_t maxQueuedBytes,
       memory::MemoryPool* pool,
-      folly::Executor* executor)
+      folly::Executor* executor,
+      bool bdpRequestSizing = false)
       : taskId_{std::move(taskId)},
+        queryId_{process::TraceSpan::currentQueryId()},
         destination_(destination),
         maxQueuedBytes_{maxQueuedBytes},
+        bdpRequestSizing_{bdpRequestSizing},
         pool_(pool),
         executor_(executor),
         queue_(std::make_shared<ExchangeQueue>()) {
@@ -109,16 +113,54 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   struct ProducingSource {
     std::shared_ptr<ExchangeSource> source;
     std::vector<int64_t> remainingBytes;
+    // Time when the source was queued in 'producingSources_'.
+    uint64_t queuedTimeUs;
+  };
+
+  // Data flow from one source, measured over its data requests.
+  struct SourceFlow {
+    // Weight of the previous estimate in the moving averages.
+    static constexpr double kDecay = 0.8;
+
+    // Moving average of the bytes received per microsecond between
+    // consecutive data responses.
+    double bytesPerUs{0};
+    // Moving average of the time from sending a data request to receiving
+    // its response.
+    double roundTripUs{0};
+    uint64_t lastResponseTimeUs{0};
+
+    // Bandwidth-delay product, i.e. the bytes the source produces while a
+    // request is in flight.
+    int64_t creditBytes() const {
+      return bytesPerUs * roundTripUs;
+    }
   };
 
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Removes the front of 'producingSources_' and adds its time in the queue
+  // to 'creditWaitUs_'.
+  void popProducingSourceLocked();
+
+  void updateFlowLocked(
+      const ExchangeSource* source,
+      int64_t bytes,
+      uint64_t requestTimeUs);
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
   const std::string taskId_;
+  // The query of the thread that created 'this'. Used for tracing the
+  // requests, which complete on 'executor_'.
+  const std::string queryId_;
   const int destination_;
   const int64_t maxQueuedBytes_;
+  // If true, a data request asks for the bandwidth-delay product of its
+  // source on top of the bytes the source reported, so that the pages
+  // produced while the request is in flight come with the response.
+  const bool bdpRequestSizing_;
   memory::MemoryPool* const pool_;
   folly::Executor* const executor_;
   const std::shared_ptr<ExchangeQueue> queue_;
@@ -135,6 +177,15 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::queue<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  folly::F14FastMap<const ExchangeSource*, SourceFlow> flows_;
+
+  // Total time the sources in 'producingSources_' waited for queue space.
+  uint64_t creditWaitUs_{0};
+
+  // Total bytes requested on top of the bytes reported by the sources. See
+  // 'bdpRequestSizing_'.
+  int64_t bdpRequestedBytes_{0};
 };
 
 } // namespace facebook::velox::exec
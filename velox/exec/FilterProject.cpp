@@ -15,6 +15,7 @@
  */
 #include "velox/exec/FilterProject.h"
 #include "velox/core/Expressions.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
 
@@ -53,7 +54,9 @@ FilterProject::FilterProject(
           "FilterProject"),
       hasFilter_(filter != nullptr),
       project_(project),
-      filter_(filter) {}
+      filter_(filter),
+      flattenSelectivityPct_(
+          driverCtx->queryConfig().filterFlattenSelectivityPct()) {}
 
 void FilterProject::initialize() {
   Operator::initialize();
@@ -166,12 +169,52 @@ RowVectorPtr FilterProject::getOutput() {
     results = project(*rows, evalCtx);
   }
 
+  if (!allRowsSelected && shouldFlatten(numOut)) {
+    return flattenOutput(numOut, filterEvalCtx_.selectedIndices, results);
+  }
+
   return fillOutput(
       numOut,
       allRowsSelected ? nullptr : filterEvalCtx_.selectedIndices,
       results);
 }
 
+bool FilterProject::shouldFlatten(vector_size_t numOut) const {
+  static constexpr vector_size_t kMinFlattenInputRows = 1'000;
+  const auto size = input_->size();
+  return flattenSelectivityPct_ > 0 && size >= kMinFlattenInputRows &&
+      int64_t{numOut} * 100 <= int64_t{size} * flattenSelectivityPct_;
+}
+
+RowVectorPtr FilterProject::flattenOutput(
+    vector_size_t numOut,
+    const BufferPtr& indices,
+    const std::vector<VectorPtr>& results) {
+  const SelectivityVector outputRows(numOut);
+  const auto* rawIndices = indices->as<vector_size_t>();
+  auto copy = [&](const VectorPtr& source) -> VectorPtr {
+    // A lazy vector stays wrapped so that only the passing rows are loaded.
+    if (isLazyNotLoaded(*source)) {
+      return wrapChild(numOut, indices, source);
+    }
+    auto flat = BaseVector::create(source->type(), numOut, pool());
+    flat->copy(source.get(), outputRows, rawIndices);
+    return flat;
+  };
+
+  std::vector<VectorPtr> children(outputType_->size());
+  for (const auto& projection : identityProjections_) {
+    children[projection.outputChannel] =
+        copy(input_->childAt(projection.inputChannel));
+  }
+  for (const auto& projection : resultProjections_) {
+    children[projection.outputChannel] =
+        copy(results[projection.inputChannel]);
+  }
+  return std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numOut, std::move(children));
+}
+
 std::vector<VectorPtr> FilterProject::project(
     const SelectivityVector& rows,
     EvalCtx& evalCtx) {
@@ -86,6 +86,17 @@ class FilterProject : public Operator {
   // updated.
   vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
 
+  // Returns true if the 'numOut' rows that passed the filter are copied into
+  // flat vectors instead of wrapping the input.
+  bool shouldFlatten(vector_size_t numOut) const;
+
+  // Returns the output with the 'numOut' rows at 'indices' copied from the
+  // input and 'results' into flat vectors.
+  RowVectorPtr flattenOutput(
+      vector_size_t numOut,
+      const BufferPtr& indices,
+      const std::vector<VectorPtr>& results);
+
   // Evaluate projections on the specified rows and return the results.
   // pre-condition: !isIdentityProjection_
   std::vector<VectorPtr> project(
@@ -106,6 +117,10 @@ class FilterProject : public Operator {
 
   FilterEvalCtx filterEvalCtx_;
 
+  // Maximum percentage of input rows passing the filter for flattening the
+  // output. 0 if disabled.
+  const int32_t flattenSelectivityPct_;
+
   vector_size_t numProcessedInputRows_{0};
 
   // Indices for fields/input columns that are both an identity projection and
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FragmentResultCache.h"
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+// static
+void FragmentResultCache::init(uint64_t maxBytes) {
+  std::unique_lock guard{instanceLock()};
+  auto& instance = instanceRef();
+  if (instance == nullptr) {
+    instance =
+        std::unique_ptr<FragmentResultCache>(new FragmentResultCache(maxBytes));
+  }
+}
+
+// static
+FragmentResultCache* FragmentResultCache::instance() {
+  std::shared_lock guard{instanceLock()};
+  return instanceRef().get();
+}
+
+std::shared_ptr<const FragmentResult> FragmentResultCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* result = cache_.get(key);
+  if (result == nullptr) {
+    return nullptr;
+  }
+  // The caller keeps the result alive after it is evicted, so the entry is
+  // unpinned right away.
+  auto copy = *result;
+  cache_.release(key);
+  return copy;
+}
+
+void FragmentResultCache::put(
+    const std::string& key,
+    std::shared_ptr<const FragmentResult> result) {
+  VELOX_CHECK_NOT_NULL(result);
+  const auto bytes = key.size() + result->bytes();
+  if (bytes > maxEntryBytes()) {
+    return;
+  }
+  using Value = std::shared_ptr<const FragmentResult>;
+  auto value = std::make_unique<Value>(std::move(result));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, value.get(), bytes)) {
+    value.release();
+  }
+}
+
+uint64_t FragmentResultCache::maxEntryBytes() const {
+  return cache_.maxSize() / 100 * kMaxEntryPct;
+}
+
+uint64_t FragmentResultCache::shrink(uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.free(bytes);
+}
+
+SimpleLRUCacheStats FragmentResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/SharedMutex.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+
+namespace facebook::velox::exec {
+
+/// The output of a plan fragment for one split, as pages in the format of the
+/// registered VectorSerde.
+struct FragmentResult {
+  std::vector<std::string> pages;
+
+  uint64_t bytes() const {
+    uint64_t bytes = 0;
+    for (const auto& page : pages) {
+      bytes += page.size();
+    }
+    return bytes;
+  }
+};
+
+/// Process-wide cache of the results of plan fragments over immutable data,
+/// e.g. the output of a TableScan with its pushed down filters for a split of
+/// a file version. Keys identify the fragment and the split. Lets repeated
+/// queries over the same data skip reading and filtering. Entries are evicted
+/// in LRU order when the cache is full. Thread-safe.
+class FragmentResultCache {
+ public:
+  /// Creates the process-wide instance holding up to 'maxBytes' of results.
+  /// Does nothing if the instance exists.
+  static void init(uint64_t maxBytes);
+
+  /// Returns the process-wide instance or nullptr if init() was not called.
+  static FragmentResultCache* instance();
+
+  /// Returns the result for 'key' or nullptr if not cached.
+  std::shared_ptr<const FragmentResult> get(const std::string& key);
+
+  /// Adds 'result' for 'key'. Does nothing if 'key' is cached or 'result' is
+  /// larger than maxEntryBytes().
+  void put(
+      const std::string& key,
+      std::shared_ptr<const FragmentResult> result);
+
+  /// The size of the largest result that is cached. Producers stop recording
+  /// a result past this size.
+  uint64_t maxEntryBytes() const;
+
+  /// Evicts entries until at least 'bytes' are freed or the cache is empty.
+  /// Returns the number of bytes freed.
+  uint64_t shrink(uint64_t bytes);
+
+  SimpleLRUCacheStats stats() const;
+
+  static void testingReset() {
+    std::unique_lock guard{instanceLock()};
+    instanceRef().reset();
+  }
+
+ private:
+  // An entry may take up to this percentage of the capacity.
+  static constexpr int32_t kMaxEntryPct = 10;
+
+  explicit FragmentResultCache(uint64_t maxBytes) : cache_(maxBytes) {}
+
+  static folly::SharedMutex& instanceLock() {
+    static folly::SharedMutex mu;
+    return mu;
+  }
+
+  static std::unique_ptr<FragmentResultCache>& instanceRef() {
+    static std::unique_ptr<FragmentResultCache> instance;
+    return instance;
+  }
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const FragmentResult>> cache_;
+};
+
+} // namespace facebook::velox::exec
@@ -71,6 +71,7 @@ GroupingSet::GroupingSet(
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
       pool_(*operatorCtx->pool()),
+      memoryForecast_(&pool_),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
   VELOX_CHECK(pool_.trackUsage());
@@ -193,6 +194,7 @@ void GroupingSet::noMoreInput() {
   if (remainingInput_) {
     addRemainingInput();
   }
+  memoryForecast_.set(0);
 
   // Spill the remaining in-memory state to disk if spilling has been triggered
   // on this grouping set. This is to simplify query OOM prevention when
@@ -751,6 +753,68 @@ bool GroupingSet::getOutput(
   return true;
 }
 
+bool GroupingSet::getIntermediateOutputForPartition(
+    uint32_t partition,
+    uint32_t numPartitions,
+    int32_t maxOutputRows,
+    RowContainerIterator& iterator,
+    memory::MemoryPool* pool,
+    RowVectorPtr& result) const {
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK(!isPartial_);
+  VELOX_CHECK(!isRawInput_);
+  VELOX_CHECK(!hasSpilled());
+  VELOX_CHECK_LT(partition, numPartitions);
+  if (table_ == nullptr) {
+    return false;
+  }
+
+  auto& rows = *table_->rows();
+  const auto numKeys = rows.keyTypes().size();
+  std::vector<char*> groups(maxOutputRows);
+  raw_vector<uint64_t> hashes(maxOutputRows);
+  int32_t numGroups;
+  while ((numGroups = rows.listRows(&iterator, maxOutputRows, groups.data())) >
+         0) {
+    // The hashes are computed from the key values, so the same key goes to the
+    // same partition no matter which hash mode each grouping set is in.
+    folly::Range<char**> groupRange(groups.data(), numGroups);
+    for (auto i = 0; i < numKeys; ++i) {
+      rows.hash(i, groupRange, i > 0, hashes.data());
+    }
+    int32_t numSelected = 0;
+    for (auto i = 0; i < numGroups; ++i) {
+      if (hashes[i] % numPartitions == partition) {
+        groups[numSelected++] = groups[i];
+      }
+    }
+    if (numSelected == 0) {
+      continue;
+    }
+
+    result->resize(numSelected);
+    for (auto i = 0; i < result->childrenSize(); ++i) {
+      result->childAt(i) = BaseVector::createNullConstant(
+          result->type()->childAt(i), numSelected, pool);
+    }
+    for (auto i = 0; i < numKeys; ++i) {
+      auto& keyVector = result->childAt(keyChannels_[i]);
+      keyVector = BaseVector::create(rows.keyTypes()[i], numSelected, pool);
+      rows.extractColumn(groups.data(), numSelected, i, keyVector);
+    }
+    for (const auto& aggregate : aggregates_) {
+      VELOX_CHECK_EQ(aggregate.inputs.size(), 1);
+      auto& aggregateVector = result->childAt(aggregate.inputs[0]);
+      aggregateVector =
+          BaseVector::create(aggregate.intermediateType, numSelected, pool);
+      aggregate.function->extractAccumulators(
+          groups.data(), numSelected, &aggregateVector);
+    }
+    return true;
+  }
+  return false;
+}
+
 void GroupingSet::extractGroups(
     folly::Range<char**> groups,
     const RowVectorPtr& result) {
@@ -825,6 +889,27 @@ uint64_t GroupingSet::allocatedBytes() const {
   return stringAllocator_.retainedSize() + rows_.allocatedBytes();
 }
 
+bool GroupingSet::getDistinctKeys(
+    int32_t maxOutputRows,
+    RowContainerIterator& iterator,
+    RowVectorPtr& result) {
+  VELOX_CHECK(isDistinct());
+  VELOX_CHECK(!hasSpilled());
+
+  if (table_ == nullptr) {
+    return false;
+  }
+
+  std::vector<char*> groups(maxOutputRows);
+  const auto numGroups = table_->rows()->listRows(
+      &iterator, maxOutputRows, RowContainer::kUnlimited, groups.data());
+  if (numGroups == 0) {
+    return false;
+  }
+  extractGroups(folly::Range<char**>(groups.data(), numGroups), result);
+  return true;
+}
+
 const HashLookup& GroupingSet::hashLookup() const {
   return *lookup_;
 }
@@ -857,6 +942,12 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
   }
 
   const auto currentUsage = pool_.usedBytes();
+  // Forecasts the peak usage from the observed bytes per input row, assuming
+  // at least as many input rows are still to come as have been seen.
+  // 'numInputRows_' includes 'input'.
+  const auto bytesPerRow = currentUsage /
+      std::max<uint64_t>(numInputRows_ - input->size(), 1);
+  memoryForecast_.set(2 * numInputRows_ * bytesPerRow);
   const auto minReservationBytes =
       currentUsage * spillConfig_->minSpillableReservationPct / 100;
   const auto availableReservationBytes = pool_.availableReservation();
@@ -1205,7 +1296,7 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
   }
   vector_size_t zero = 0;
   for (auto& aggregate : aggregates_) {
-    if (!aggregate.sortingKeys.empty()) {
+    if (!aggregate.sortingKeys.empty() || aggregate.distinct) {
       continue;
     }
     aggregate.function->initializeNewGroups(
@@ -1216,6 +1307,13 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
     sortedAggregations_->initializeNewGroups(
         &row, folly::Range<const vector_size_t*>(&zero, 1));
   }
+
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->initializeNewGroups(
+          &row, folly::Range<const vector_size_t*>(&zero, 1));
+    }
+  }
 }
 
 void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
@@ -1237,7 +1335,7 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
-    if (!aggregates_[i].sortingKeys.empty()) {
+    if (!aggregates_[i].sortingKeys.empty() || aggregates_[i].distinct) {
       continue;
     }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
@@ -1252,6 +1350,17 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
     sortedAggregations_->addSingleGroupSpillInput(
         row, vector, input.currentIndex());
   }
+
+  // Distinct aggregations spill their sets of unique inputs after the sorted
+  // aggregations, in the order of 'distinctAggregations_'.
+  auto channel = keyChannels_.size() + aggregates_.size() +
+      (sortedAggregations_ != nullptr ? 1 : 0);
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->addSingleGroupSpillInput(
+          row, input.current().childAt(channel++), input.currentIndex());
+    }
+  }
 }
 
 void GroupingSet::abandonPartialAggregation() {
@@ -74,6 +74,32 @@ class GroupingSet {
       RowContainerIterator& iterator,
       RowVectorPtr& result);
 
+  /// Used to merge the grouping sets of a final aggregation across drivers.
+  /// Extracts the next batch of at most 'maxOutputRows' groups whose grouping
+  /// keys hash to 'partition' out of 'numPartitions' into 'result'. 'result'
+  /// has the input type of this grouping set: the grouping keys and the
+  /// intermediate aggregation results are stored in their input channels, so
+  /// 'result' can be added to another grouping set of the same aggregation.
+  /// Returns false if there are no more groups to extract. 'result' is
+  /// allocated from 'pool'. Different partitions can be extracted by different
+  /// threads, each with its own 'iterator', but the calls must not overlap.
+  bool getIntermediateOutputForPartition(
+      uint32_t partition,
+      uint32_t numPartitions,
+      int32_t maxOutputRows,
+      RowContainerIterator& iterator,
+      memory::MemoryPool* pool,
+      RowVectorPtr& result) const;
+
+  /// Used by MarkDistinct to spill the distinct keys seen so far. Extracts the
+  /// next batch of at most 'maxOutputRows' distinct keys into 'result', which
+  /// has one column per grouping key. Returns false if there are no more keys
+  /// to extract.
+  bool getDistinctKeys(
+      int32_t maxOutputRows,
+      RowContainerIterator& iterator,
+      RowVectorPtr& result);
+
   uint64_t allocatedBytes() const;
 
   /// Resets the hash table inside the grouping set when partial aggregation
@@ -127,6 +153,12 @@ class GroupingSet {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Returns the percentage of the variable width data storage of the rows,
+  /// including the accumulators, that is free.
+  int32_t variableWidthFragmentationPct() const {
+    return table_ ? table_->rows()->variableWidthFragmentationPct() : 0;
+  }
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
@@ -362,6 +394,9 @@ class GroupingSet {
   // Pool of the OperatorCtx. Used for spilling.
   memory::MemoryPool& pool_;
 
+  // The forecast peak memory usage published to the query memory pool.
+  memory::MemoryForecast memoryForecast_;
+
   // True if partial aggregation has been given up as non-productive.
   bool abandonedPartialAggregation_{false};
 
@@ -20,6 +20,19 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns true if the drivers of 'node' can merge their grouping sets with
+// each other instead of relying on a local exchange to partition the input.
+bool canMergeAcrossDrivers(
+    const core::AggregationNode& node,
+    const core::QueryConfig& config) {
+  return config.finalAggregationMergeAcrossDrivers() &&
+      node.step() == core::AggregationNode::Step::kFinal &&
+      !node.groupingKeys().empty() && !node.aggregates().empty() &&
+      node.preGroupedKeys().empty() && !node.groupId().has_value();
+}
+} // namespace
+
 HashAggregation::HashAggregation(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -32,7 +45,9 @@ HashAggregation::HashAggregation(
           aggregationNode->step() == core::AggregationNode::Step::kPartial
               ? "PartialAggregation"
               : "Aggregation",
-          aggregationNode->canSpill(driverCtx->queryConfig())
+          aggregationNode->canSpill(driverCtx->queryConfig()) &&
+                  !canMergeAcrossDrivers(
+                      *aggregationNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       aggregationNode_(aggregationNode),
@@ -46,13 +61,39 @@ HashAggregation::HashAggregation(
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
+      partialAggregationCacheTableMemoryUsage_(
+          driverCtx->queryConfig().partialAggregationCacheTableMemoryUsage()),
+      partialAggregationCacheTableMinHitPct_(
+          driverCtx->queryConfig().partialAggregationCacheTableMinHitPct()) {
+  // The distinct aggregation outputs new groups as they arrive, so it doesn't
+  // benefit from a small table.
+  usePartialAggregationCacheTable_ = isPartialOutput_ && !isGlobal_ &&
+      !isDistinct_ && partialAggregationCacheTableMemoryUsage_ > 0 &&
+      partialAggregationCacheTableMemoryUsage_ <
+          maxPartialAggregationMemoryUsage_;
+}
 
 void HashAggregation::initialize() {
   Operator::initialize();
 
   VELOX_CHECK(pool()->trackUsage());
 
+  // A single driver has nothing to merge with.
+  mergeAcrossDrivers_ = canMergeAcrossDrivers(
+                            *aggregationNode_,
+                            operatorCtx_->driverCtx()->queryConfig()) &&
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver()) > 1;
+
+  groupingSet_ = createGroupingSet();
+
+  // The merge creates a new grouping set after all the input is consumed.
+  if (!mergeAcrossDrivers_) {
+    aggregationNode_.reset();
+  }
+}
+
+std::unique_ptr<GroupingSet> HashAggregation::createGroupingSet() {
   const auto& inputType = aggregationNode_->sources()[0]->outputType();
   auto hashers =
       createVectorHashers(inputType, aggregationNode_->groupingKeys());
@@ -94,7 +135,7 @@ void HashAggregation::initialize() {
     VELOX_CHECK(groupIdChannel.has_value());
   }
 
-  groupingSet_ = std::make_unique<GroupingSet>(
+  return std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
       std::move(preGroupedChannels),
@@ -108,8 +149,6 @@ void HashAggregation::initialize() {
       &nonReclaimableSection_,
       operatorCtx_.get(),
       &spillStats_);
-
-  aggregationNode_.reset();
 }
 
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
@@ -140,7 +179,10 @@ void HashAggregation::addInput(RowVectorPtr input) {
       abandonPartialAggregationEarly(groupingSet_->numDistinct());
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
-       groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
+       groupingSet_->isPartialFull(
+           usePartialAggregationCacheTable_
+               ? partialAggregationCacheTableMemoryUsage_
+               : maxPartialAggregationMemoryUsage_))) {
     partialFull_ = true;
   }
 
@@ -188,6 +230,8 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  runtimeStats[RowContainer::kVariableWidthFragmentationPct] =
+      RuntimeMetric(groupingSet_->variableWidthFragmentationPct());
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -219,7 +263,11 @@ void HashAggregation::resetPartialOutputIfNeed() {
   groupingSet_->resetTable();
   partialFull_ = false;
   if (!finished_) {
-    maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
+    if (usePartialAggregationCacheTable_) {
+      maybeDisablePartialAggregationCacheTable(aggregationPct);
+    } else {
+      maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
+    }
   }
   numOutputRows_ = 0;
   numInputRows_ = 0;
@@ -263,7 +311,29 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
           maxPartialAggregationMemoryUsage_, RuntimeCounter::Unit::kBytes));
 }
 
+void HashAggregation::maybeDisablePartialAggregationCacheTable(
+    double aggregationPct) {
+  VELOX_DCHECK(usePartialAggregationCacheTable_);
+  // Each output row is a group which missed the table on its first input row,
+  // so the rest of the input rows have hit an existing group.
+  const double hitPct = 100 - aggregationPct;
+  addRuntimeStat("partialAggregationCacheTableHitPct", RuntimeCounter(hitPct));
+  if (hitPct >= partialAggregationCacheTableMinHitPct_) {
+    return;
+  }
+  // The groups don't repeat often enough within the cache-resident table.
+  // Switch to the regular table which can hold more groups between flushes.
+  usePartialAggregationCacheTable_ = false;
+  addRuntimeStat("disabledPartialAggregationCacheTable", RuntimeCounter(1));
+}
+
 RowVectorPtr HashAggregation::getOutput() {
+  if (mergeFuture_.valid()) {
+    return nullptr;
+  }
+  if (mergeSources_ != nullptr) {
+    mergeAcrossDrivers();
+  }
   if (finished_) {
     input_ = nullptr;
     return nullptr;
@@ -385,6 +455,97 @@ void HashAggregation::noMoreInput() {
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
+  if (mergeAcrossDrivers_) {
+    startMergeAcrossDrivers();
+  }
+}
+
+void HashAggregation::startMergeAcrossDrivers() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &mergeFuture_,
+          promises,
+          peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not the last
+    // to finish) can continue from the barrier and merge their partitions.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  auto sources = std::make_shared<MergeSources>();
+  sources->reserve(peers.size() + 1);
+  const auto addSource = [&](HashAggregation* aggregation) {
+    VELOX_CHECK_NOT_NULL(aggregation->groupingSet_);
+    aggregation->mergePartition_ = sources->size();
+    aggregation->mergeSources_ = sources;
+    auto source = std::make_unique<MergeSource>();
+    source->groupingSet = std::move(aggregation->groupingSet_);
+    sources->push_back(std::move(source));
+  };
+  addSource(this);
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    addSource(aggregation);
+  }
+}
+
+void HashAggregation::mergeAcrossDrivers() {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK_NULL(groupingSet_);
+
+  groupingSet_ = createGroupingSet();
+  const auto& inputType = aggregationNode_->sources()[0]->outputType();
+  auto input = std::static_pointer_cast<RowVector>(
+      BaseVector::create(inputType, 0, pool()));
+  const auto maxInputRows = outputBatchRows(estimatedOutputRowSize_);
+  const auto numPartitions = mergeSources_->size();
+  // Start from a different source on each driver to spread the contention on
+  // the source mutexes.
+  for (auto i = 0; i < numPartitions; ++i) {
+    auto& source = *(*mergeSources_)[(mergePartition_ + i) % numPartitions];
+    RowContainerIterator iterator;
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> l(source.mutex);
+        if (!source.groupingSet->getIntermediateOutputForPartition(
+                mergePartition_,
+                numPartitions,
+                maxInputRows,
+                iterator,
+                pool(),
+                input)) {
+          break;
+        }
+      }
+      groupingSet_->addInput(input, false);
+    }
+  }
+  groupingSet_->noMoreInput();
+  addRuntimeStat("mergedAcrossDrivers", RuntimeCounter(numPartitions));
+
+  // The last driver to release the sources frees the grouping sets of all the
+  // drivers.
+  mergeSources_.reset();
+  aggregationNode_.reset();
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (!mergeFuture_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(mergeFuture_);
+  return BlockingReason::kWaitForAggregationMerge;
 }
 
 bool HashAggregation::isFinished() {
@@ -39,9 +39,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -51,6 +49,29 @@ class HashAggregation : public Operator {
   void close() override;
 
  private:
+  // The grouping set of one driver of a final aggregation which merges its
+  // groups across drivers. 'mutex' serializes the extraction of its groups by
+  // the peer drivers.
+  struct MergeSource {
+    std::unique_ptr<GroupingSet> groupingSet;
+    std::mutex mutex;
+  };
+
+  using MergeSources = std::vector<std::unique_ptr<MergeSource>>;
+
+  // Creates the grouping set from 'aggregationNode_'.
+  std::unique_ptr<GroupingSet> createGroupingSet();
+
+  // Invoked on no more input to wait for all the peer drivers to finish their
+  // input. The last driver to finish collects the grouping sets of all the
+  // drivers into 'mergeSources_' and assigns each driver its partition of the
+  // group key hash space.
+  void startMergeAcrossDrivers();
+
+  // Builds 'groupingSet_' from the groups of all the merge sources which fall
+  // into 'mergePartition_'.
+  void mergeAcrossDrivers();
+
   void updateRuntimeStats();
 
   void prepareOutput(vector_size_t size);
@@ -65,6 +86,11 @@ class HashAggregation : public Operator {
   // measure of the effectiveness of the partial aggregation.
   void maybeIncreasePartialAggregationMemoryUsage(double aggregationPct);
 
+  // Invoked on partial output flush of the cache-resident partial aggregation
+  // table to decide whether to keep using it. 'aggregationPct' is the same as
+  // for maybeIncreasePartialAggregationMemoryUsage().
+  void maybeDisablePartialAggregationCacheTable(double aggregationPct);
+
   // True if we have enough rows and not enough reduction, i.e. more than
   // 'abandonPartialAggregationMinRows_' rows and more than
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
@@ -88,8 +114,28 @@ class HashAggregation : public Operator {
   const int32_t abandonPartialAggregationMinPct_;
 
   int64_t maxPartialAggregationMemoryUsage_;
+  // Max memory usage of the cache-resident partial aggregation table.
+  const int64_t partialAggregationCacheTableMemoryUsage_;
+  // Min hit rate pct to keep using the cache-resident partial aggregation
+  // table.
+  const int32_t partialAggregationCacheTableMinHitPct_;
+  // True while the partial aggregation flushes its table each time it reaches
+  // 'partialAggregationCacheTableMemoryUsage_'.
+  bool usePartialAggregationCacheTable_{false};
   std::unique_ptr<GroupingSet> groupingSet_;
 
+  // True if this final aggregation merges its groups with the peer drivers
+  // once all their input is consumed. See
+  // QueryConfig::kFinalAggregationMergeAcrossDrivers.
+  bool mergeAcrossDrivers_{false};
+  // The grouping sets of all the drivers to merge. Set on all the drivers by
+  // the last driver to finish its input and reset after the merge.
+  std::shared_ptr<MergeSources> mergeSources_;
+  // The partition of the group key hash space merged by this driver.
+  uint32_t mergePartition_{0};
+  // Fulfilled when the last peer driver has finished its input.
+  ContinueFuture mergeFuture_{ContinueFuture::makeEmpty()};
+
   // Size of a single output row estimated using
   // 'groupingSet_->estimateRowSize()'. If spilling, this value is set to max
   // 'groupingSet_->estimateRowSize()' across all accumulated data set.
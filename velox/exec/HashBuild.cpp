@@ -72,6 +72,14 @@ HashBuild::HashBuild(
   VELOX_CHECK_NOT_NULL(joinBridge_);
 
   joinBridge_->addBuilder();
+  // The probe side of these join types only produces output for the matched
+  // build side rows of each table, so a skewed spill partition can be built
+  // and probed one block of spill files at a time.
+  if (spillEnabled() &&
+      (isInnerJoin(joinType_) || isRightJoin(joinType_) ||
+       isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_))) {
+    joinBridge_->allowSpillRestoreInBlocks();
+  }
 
   auto inputType = joinNode_->sources()[1]->outputType();
 
@@ -142,6 +150,8 @@ void HashBuild::setupTable() {
   for (int i = numKeys; i < tableType_->size(); ++i) {
     dependentTypes.emplace_back(tableType_->childAt(i));
   }
+  const bool columnarDependents =
+      operatorCtx_->driverCtx()->queryConfig().hashJoinColumnarDependents();
   if (joinNode_->isRightJoin() || joinNode_->isFullJoin() ||
       joinNode_->isRightSemiProjectJoin()) {
     // Do not ignore null keys.
@@ -153,7 +163,8 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        pool(),
+        columnarDependents);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -173,7 +184,8 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          columnarDependents);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -184,13 +196,16 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          columnarDependents);
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
-void HashBuild::setupSpiller(SpillPartition* spillPartition) {
+void HashBuild::setupSpiller(
+    SpillPartition* spillPartition,
+    bool isSpillBlock) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
 
@@ -216,6 +231,14 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
         config->readBufferSize, pool(), &spillStats_);
     startPartitionBit =
         spillPartition->id().partitionBitOffset() + config->numPartitionBits;
+    // Disable spilling if restoring a block of a skewed spill partition as
+    // spilling it again with more partition bits won't split the skewed join
+    // keys apart.
+    if (isSpillBlock) {
+      stats_.wlock()->addRuntimeStat("skewedSpillBlocks", RuntimeCounter(1));
+      exceededMaxSpillLevelLimit_ = true;
+      return;
+    }
     // Disable spilling if exceeding the max spill level and the query might run
     // out of memory if the restored partition still can't fit in memory.
     if (config->exceedSpillLevelLimit(startPartitionBit)) {
@@ -746,6 +769,17 @@ bool HashBuild::finishHashBuild() {
                                : nullptr,
         isInputFromSpill() ? spillConfig()->startPartitionBit
                            : BaseHashTable::kNoSpillInputStartPartitionBit);
+    // HashProbe pushes down dynamic filters only for these join types and
+    // only if there is no spilled data.
+    const bool mayPushdownFilters = spillPartitions.empty() &&
+        !isInputFromSpill() &&
+        (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+         isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_));
+    table_->buildBloomFilters(
+        mayPushdownFilters ? operatorCtx_->driverCtx()
+                                 ->queryConfig()
+                                 .maxJoinBloomFilterNumDistinct()
+                           : 0);
   }
   stats_.wlock()->addRuntimeStat(
       BaseHashTable::kBuildWallNanos,
@@ -876,7 +910,7 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
       keyChannels_.size());
 
   setupTable();
-  setupSpiller(spillInput.spillPartition.get());
+  setupSpiller(spillInput.spillPartition.get(), spillInput.isSpillBlock);
   stateCleared_ = false;
 
   // Start to process spill input.
@@ -931,6 +965,10 @@ void HashBuild::addRuntimeStats() {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  if (hashTableStats.numParallelBuildPartitions != 0) {
+    lockedStats->runtimeStats[BaseHashTable::kNumParallelBuildPartitions] =
+        RuntimeMetric(hashTableStats.numParallelBuildPartitions);
+  }
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
@@ -130,7 +130,11 @@ class HashBuild final : public Operator {
   // source. The function will need to setup a spill input reader to read input
   // from the spilled data for restoring. If the spilled data can't still fit
   // in memory, then we will recursively spill part(s) of its data on disk.
-  void setupSpiller(SpillPartition* spillPartition = nullptr);
+  // 'isSpillBlock' is true if 'spillPartition' is a shard of a block of spill
+  // files from a skewed spill partition, which is not spilled again.
+  void setupSpiller(
+      SpillPartition* spillPartition = nullptr,
+      bool isSpillBlock = false);
 
   // Invoked when either there is no more input from the build source or from
   // the spill input reader during the restoring.
@@ -33,6 +33,12 @@ void HashJoinBridge::addBuilder() {
   ++numBuilders_;
 }
 
+void HashJoinBridge::allowSpillRestoreInBlocks() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  restoreSpillInBlocks_ = true;
+}
+
 void HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
@@ -59,14 +65,29 @@ void HashJoinBridge::setHashTable(
     for (auto& partitionEntry : spillPartitionSet) {
       const auto id = partitionEntry.first;
       VELOX_CHECK_EQ(spillPartitionSets_.count(id), 0);
+      // If most of the restored spill partition data goes into a single child
+      // partition, then spilling it again won't help. Restore it in blocks of
+      // spill files instead when it comes up next.
+      if (restoreSpillInBlocks_ && restoringSpillPartitionId_.has_value() &&
+          restoringSpillPartitionBytes_ > 0 &&
+          partitionEntry.second->size() * 100 >=
+              restoringSpillPartitionBytes_ * kSkewedSpillPartitionPct) {
+        skewedSpillPartitionIds_.insert(id);
+      }
       spillPartitionSets_.emplace(id, std::move(partitionEntry.second));
     }
+    const bool hasMoreSpillBlocks = restoringSpillBlock_ &&
+        spillPartitionSets_.count(restoringSpillPartitionId_.value()) != 0;
     buildResult_ = HashBuildResult(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
         hasNullKeys);
+    buildResult_->isSpillBlock = restoringSpillBlock_;
+    buildResult_->hasMoreSpillBlocks = hasMoreSpillBlocks;
     restoringSpillPartitionId_.reset();
+    restoringSpillPartitionBytes_ = 0;
+    restoringSpillBlock_ = false;
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -99,6 +120,9 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
 
     buildResult_ = HashBuildResult{};
     restoringSpillPartitionId_.reset();
+    restoringSpillPartitionBytes_ = 0;
+    restoringSpillBlock_ = false;
+    skewedSpillPartitionIds_.clear();
     spillPartitions.swap(spillPartitionSets_);
     promises = std::move(promises_);
   }
@@ -142,11 +166,26 @@ bool HashJoinBridge::probeFinished() {
 
     if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
-      restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
-      restoringSpillShards_ =
-          spillPartitionSets_.begin()->second->split(numBuilders_);
+      auto it = spillPartitionSets_.begin();
+      restoringSpillPartitionId_ = it->first;
+      if (skewedSpillPartitionIds_.count(it->first) != 0) {
+        // Restore the next block of spill files from the skewed spill
+        // partition. The spill files are written by the HashBuild operators one
+        // memory reclaim at a time, so each block is expected to fit in memory.
+        restoringSpillBlock_ = true;
+        auto spillBlock = it->second->splitFiles(numBuilders_);
+        restoringSpillPartitionBytes_ = spillBlock->size();
+        restoringSpillShards_ = spillBlock->split(numBuilders_);
+        if (it->second->numFiles() == 0) {
+          skewedSpillPartitionIds_.erase(it->first);
+          spillPartitionSets_.erase(it);
+        }
+      } else {
+        restoringSpillPartitionBytes_ = it->second->size();
+        restoringSpillShards_ = it->second->split(numBuilders_);
+        spillPartitionSets_.erase(it);
+      }
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
-      spillPartitionSets_.erase(spillPartitionSets_.begin());
     }
     promises = std::move(promises_);
   }
@@ -182,7 +221,7 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   VELOX_CHECK(!restoringSpillShards_.empty());
   auto spillShard = std::move(restoringSpillShards_.back());
   restoringSpillShards_.pop_back();
-  return SpillInput(std::move(spillShard));
+  return SpillInput(std::move(spillShard), restoringSpillBlock_);
 }
 
 bool isLeftNullAwareJoinWithFilter(
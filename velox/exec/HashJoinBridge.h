@@ -39,6 +39,12 @@ class HashJoinBridge : public JoinBridge {
   /// HashBuild operators to parallelize the restoring operation.
   void addBuilder();
 
+  /// Invoked by HashBuild operator ctor to allow the bridge to restore a skewed
+  /// spill partition in blocks of spill files instead of spilling it again.
+  /// This only applies to the join types which don't need to track any probe
+  /// side state across the tables built from the same spill partition.
+  void allowSpillRestoreInBlocks();
+
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
@@ -78,6 +84,14 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    /// True if 'table' is built from a block of spill files of a skewed spill
+    /// partition. Such a table can't be spilled any further.
+    bool isSpillBlock{false};
+    /// True if 'table' is built from a block of spill files of a skewed spill
+    /// partition and there are more blocks left to restore. HashProbe can't
+    /// discard the spilled probe input of 'restoredPartitionId' in this case as
+    /// it needs to probe it against each block.
+    bool hasMoreSpillBlocks{false};
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -95,13 +109,17 @@ class HashJoinBridge : public JoinBridge {
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
-  /// data to restore.
+  /// data to restore. 'isSpillBlock' is true if the shard belongs to a block of
+  /// spill files of a skewed spill partition.
   struct SpillInput {
     explicit SpillInput(
-        std::unique_ptr<SpillPartition> spillPartition = nullptr)
-        : spillPartition(std::move(spillPartition)) {}
+        std::unique_ptr<SpillPartition> spillPartition = nullptr,
+        bool isSpillBlock = false)
+        : spillPartition(std::move(spillPartition)),
+          isSpillBlock(isSpillBlock) {}
 
     std::unique_ptr<SpillPartition> spillPartition;
+    bool isSpillBlock;
   };
 
   /// Invoked by HashBuild operator to get one of previously spilled partition
@@ -113,8 +131,18 @@ class HashJoinBridge : public JoinBridge {
   std::optional<SpillInput> spillInputOrFuture(ContinueFuture* future);
 
  private:
+  // A child spill partition is considered skewed if it holds at least this
+  // percentage of the bytes of its parent spill partition. Spilling such a
+  // partition again with more partition bits is unlikely to reduce its size
+  // as most of its rows are expected to share a few hot join keys.
+  static constexpr int32_t kSkewedSpillPartitionPct{90};
+
   uint32_t numBuilders_{0};
 
+  // If true, a skewed spill partition is restored in blocks of spill files
+  // instead of being spilled recursively.
+  bool restoreSpillInBlocks_{false};
+
   std::optional<HashBuildResult> buildResult_;
 
   // restoringSpillPartitionXxx member variables are populated by the
@@ -131,6 +159,19 @@ class HashJoinBridge : public JoinBridge {
   // of spill files and will be processed by one of the HashBuild operator.
   std::vector<std::unique_ptr<SpillPartition>> restoringSpillShards_;
 
+  // The total spilled bytes of the currently restoring spill partition.
+  uint64_t restoringSpillPartitionBytes_{0};
+
+  // True if the currently restoring spill shards are from a block of spill
+  // files of a skewed spill partition.
+  bool restoringSpillBlock_{false};
+
+  // The spill partitions in 'spillPartitionSets_' which are detected as skewed
+  // and will be restored in blocks of spill files, 'numBuilders_' files at a
+  // time. A skewed spill partition stays in 'spillPartitionSets_' until all
+  // its spill files have been restored.
+  SpillPartitionIdSet skewedSpillPartitionIds_;
+
   // The spill partitions remaining to restore. This set is populated using
   // information provided by the HashBuild operators if spilling is enabled.
   // This set can grow if HashBuild operator cannot load full partition in
@@ -21,9 +21,17 @@ HashPartitionFunction::HashPartitionFunction(
     int numPartitions,
     const RowTypePtr& inputType,
     const std::vector<column_index_t>& keyChannels,
-    const std::vector<VectorPtr>& constValues)
-    : numPartitions_{numPartitions} {
+    const std::vector<VectorPtr>& constValues,
+    int32_t skewSpread)
+    : numPartitions_{numPartitions},
+      skewSpread_{std::min(skewSpread, numPartitions)} {
+  VELOX_CHECK_GE(skewSpread, 1);
   init(inputType, keyChannels, constValues);
+  if (skewSpread_ > 1) {
+    // The space-saving counts overestimate by at most the sampled rows
+    // divided by the capacity.
+    hotKeys_.setCapacity(std::max(64, 4 * numPartitions_));
+  }
 }
 
 HashPartitionFunction::HashPartitionFunction(
@@ -87,15 +95,44 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     for (auto i = 0; i < size; ++i) {
       partitions[i] = hashes_[i] % numPartitions_;
     }
+    if (skewSpread_ > 1) {
+      spreadHotKeys(size, partitions);
+    }
   }
 
   return std::nullopt;
 }
 
+void HashPartitionFunction::spreadHotKeys(
+    vector_size_t size,
+    std::vector<uint32_t>& partitions) {
+  for (auto i = 0; i < size; i += kSkewSampleStride) {
+    hotKeys_.insert(hashes_[i]);
+    ++numSampledRows_;
+  }
+  hotHashes_.clear();
+  const auto* values = hotKeys_.values();
+  const auto* counts = hotKeys_.counts();
+  for (auto i = 0; i < hotKeys_.size(); ++i) {
+    if (counts[i] * numPartitions_ > numSampledRows_) {
+      hotHashes_.insert(values[i]);
+    }
+  }
+  if (hotHashes_.empty()) {
+    return;
+  }
+  for (auto i = 0; i < size; ++i) {
+    if (hotHashes_.contains(hashes_[i])) {
+      partitions[i] = (partitions[i] + nextSpread_) % numPartitions_;
+      nextSpread_ = (nextSpread_ + 1) % skewSpread_;
+    }
+  }
+}
+
 std::unique_ptr<core::PartitionFunction> HashPartitionFunctionSpec::create(
     int numPartitions) const {
   return std::make_unique<exec::HashPartitionFunction>(
-      numPartitions, inputType_, keyChannels_, constValues_);
+      numPartitions, inputType_, keyChannels_, constValues_, skewSpread_);
 }
 
 std::string HashPartitionFunctionSpec::toString() const {
@@ -113,6 +150,9 @@ std::string HashPartitionFunctionSpec::toString() const {
     }
   }
 
+  if (skewSpread_ > 1) {
+    return fmt::format("HASH({}) SKEW_SPREAD({})", keys.str(), skewSpread_);
+  }
   return fmt::format("HASH({})", keys.str());
 }
 
@@ -128,6 +168,7 @@ folly::dynamic HashPartitionFunctionSpec::serialize() const {
     constValues.emplace_back(value);
   }
   obj["constants"] = ISerializable::serialize(constValues);
+  obj["skewSpread"] = skewSpread_;
   return obj;
 }
 
@@ -148,6 +189,9 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
     constValues.emplace_back(value->toConstantVector(pool));
   }
   return std::make_shared<HashPartitionFunctionSpec>(
-      ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      constValues,
+      obj.getDefault("skewSpread", 1).asInt());
 }
 } // namespace facebook::velox::exec
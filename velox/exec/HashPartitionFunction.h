@@ -15,9 +15,11 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
 #include <velox/exec/HashBitRange.h>
 #include <velox/exec/VectorHasher.h>
 #include "velox/core/PlanNode.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -27,13 +29,22 @@ namespace facebook::velox::exec {
 /// numPartitions allows the keyChannels argument to be empty. If keyChannels is
 /// empty, then the resulting partition number of partition() will always be
 /// zero.
+///
+/// If 'skewSpread' is greater than 1, the function tracks the most frequent
+/// key hashes and sends the rows of a key that has more than a partition's
+/// fair share of the rows round-robin to 'skewSpread' consecutive partitions
+/// starting at the key's own. The rows of such a key then go to several
+/// partitions, so this is only valid if the consumers allow it, e.g. a
+/// partial aggregation or the probe side of a join whose build side is
+/// replicated.
 class HashPartitionFunction : public core::PartitionFunction {
  public:
   HashPartitionFunction(
       int numPartitions,
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
-      const std::vector<VectorPtr>& constValues = {});
+      const std::vector<VectorPtr>& constValues = {},
+      int32_t skewSpread = 1);
 
   HashPartitionFunction(
       const HashBitRange& hashBitRange,
@@ -52,15 +63,32 @@ class HashPartitionFunction : public core::PartitionFunction {
   }
 
  private:
+  // One in this many rows is added to 'hotKeys_'.
+  static constexpr int32_t kSkewSampleStride = 16;
+
   void init(
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
       const std::vector<VectorPtr>& constValues);
 
+  // Samples 'hashes_' into 'hotKeys_' and moves the first 'size' rows of hot
+  // keys in 'partitions' to the partitions their key is spread over.
+  void spreadHotKeys(vector_size_t size, std::vector<uint32_t>& partitions);
+
   const int numPartitions_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
+  const int32_t skewSpread_{1};
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
+  // Most frequent hashes in the rows sampled so far. Used if 'skewSpread_' >
+  // 1.
+  functions::ApproxMostFrequentStreamSummary<uint64_t> hotKeys_;
+  int64_t numSampledRows_{0};
+  // Hashes with more than a partition's fair share of the sampled rows.
+  folly::F14FastSet<uint64_t> hotHashes_;
+  // Offset of the partition the next hot key row goes to.
+  int32_t nextSpread_{0};
+
   // Reusable memory.
   SelectivityVector rows_;
   raw_vector<uint64_t> hashes_;
@@ -76,10 +104,12 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   HashPartitionFunctionSpec(
       RowTypePtr inputType,
       std::vector<column_index_t> keyChannels,
-      std::vector<VectorPtr> constValues = {})
+      std::vector<VectorPtr> constValues = {},
+      int32_t skewSpread = 1)
       : inputType_{std::move(inputType)},
         keyChannels_{std::move(keyChannels)},
-        constValues_{std::move(constValues)} {}
+        constValues_{std::move(constValues)},
+        skewSpread_{skewSpread} {}
 
   std::unique_ptr<core::PartitionFunction> create(
       int numPartitions) const override;
@@ -96,5 +126,7 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   const RowTypePtr inputType_;
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
+  // See HashPartitionFunction.
+  const int32_t skewSpread_;
 };
 } // namespace facebook::velox::exec
@@ -184,6 +184,11 @@ void HashProbe::initialize() {
   if (nullAware_) {
     filterTableResult_.resize(1);
   }
+
+  if (!spillEnabled()) {
+    maxPrebuildInputBytes_ =
+        operatorCtx_->driverCtx()->queryConfig().hashProbePrebuildBufferBytes();
+  }
 }
 
 void HashProbe::initializeFilter(
@@ -266,7 +271,8 @@ void HashProbe::maybeSetupInputSpiller(
 }
 
 void HashProbe::maybeSetupSpillInputReader(
-    const std::optional<SpillPartitionId>& restoredPartitionId) {
+    const std::optional<SpillPartitionId>& restoredPartitionId,
+    bool hasMoreSpillBlocks) {
   VELOX_CHECK_NULL(spillInputReader_);
   if (!restoredPartitionId.has_value()) {
     return;
@@ -276,8 +282,17 @@ void HashProbe::maybeSetupSpillInputReader(
   // the corresponding spilled probe partition on disk.
   auto iter = spillPartitionSet_.find(restoredPartitionId.value());
   VELOX_CHECK(iter != spillPartitionSet_.end());
+  VELOX_CHECK_EQ(iter->second->id(), restoredPartitionId.value());
+  if (hasMoreSpillBlocks) {
+    // Read from a copy of the spilled probe partition as we need to read it
+    // again to probe the table built from the next block of the skewed build
+    // side spill partition.
+    auto partition = std::make_unique<SpillPartition>(*iter->second);
+    spillInputReader_ = partition->createUnorderedReader(
+        spillConfig_->readBufferSize, pool(), &spillStats_);
+    return;
+  }
   auto partition = std::move(iter->second);
-  VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
   spillInputReader_ = partition->createUnorderedReader(
       spillConfig_->readBufferSize, pool(), &spillStats_);
   spillPartitionSet_.erase(iter);
@@ -311,9 +326,12 @@ void HashProbe::asyncWaitForHashTable() {
   table_ = std::move(hashBuildResult->table);
   VELOX_CHECK_NOT_NULL(table_);
 
-  maybeSetupSpillInputReader(hashBuildResult->restoredPartitionId);
+  maybeSetupSpillInputReader(
+      hashBuildResult->restoredPartitionId,
+      hashBuildResult->hasMoreSpillBlocks);
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
-  prepareTableSpill(hashBuildResult->restoredPartitionId);
+  prepareTableSpill(
+      hashBuildResult->restoredPartitionId, hashBuildResult->isSpillBlock);
 
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
@@ -331,8 +349,7 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -350,10 +367,22 @@ void HashProbe::asyncWaitForHashTable() {
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      // The hashers track the distinct key values only if the table is not in
+      // kHash mode. Fall back to the Bloom filter built over the key values if
+      // there is no exact filter.
+      std::unique_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(nullAllowed);
+      }
+      if (filter == nullptr && table_->bloomFilter(i) != nullptr) {
+        filter = table_->bloomFilter(i)->clone(nullAllowed);
+        hasApproximateDynamicFilters_ = true;
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
@@ -428,6 +457,37 @@ void HashProbe::addSpillInput() {
   addInput(std::move(input_));
 }
 
+void HashProbe::bufferPrebuildInput(RowVectorPtr input) {
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  const auto bytes = input->estimateFlatSize();
+  prebuildInputBytes_ += bytes;
+  prebuildInput_.emplace_back(std::move(input), bytes);
+  addRuntimeStat("prebuildInputBytes", RuntimeCounter(bytes));
+}
+
+void HashProbe::addPrebuildInput() {
+  if (input_ != nullptr) {
+    return;
+  }
+  if (!prebuildInput_.empty()) {
+    auto [input, bytes] = std::move(prebuildInput_.front());
+    prebuildInput_.pop_front();
+    prebuildInputBytes_ -= bytes;
+    probingPrebuildInput_ = true;
+    addInput(std::move(input));
+    probingPrebuildInput_ = false;
+    if (!prebuildInput_.empty()) {
+      return;
+    }
+  }
+  if (prebuildNoMoreInput_) {
+    prebuildNoMoreInput_ = false;
+    noMoreInputInternal();
+  }
+}
+
 void HashProbe::spillInput(RowVectorPtr& input) {
   VELOX_CHECK(needSpillInput());
 
@@ -501,6 +561,10 @@ BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
   switch (state_) {
     case ProbeOperatorState::kWaitForBuild:
       VELOX_CHECK_NULL(table_);
+      if (future_.valid() && future_.isReady()) {
+        // The build finished while 'this' was buffering probe input.
+        future_ = ContinueFuture::makeEmpty();
+      }
       if (!future_.valid()) {
         setRunning();
         asyncWaitForHashTable();
@@ -510,6 +574,8 @@ BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
       VELOX_CHECK_NOT_NULL(table_);
       if (spillInputReader_ != nullptr) {
         addSpillInput();
+      } else if (!prebuildInput_.empty() || prebuildNoMoreInput_) {
+        addPrebuildInput();
       }
       break;
     case ProbeOperatorState::kWaitForPeers:
@@ -527,6 +593,10 @@ BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
 
   if (future_.valid()) {
     VELOX_CHECK(!isRunning());
+    if (canBufferPrebuildInput()) {
+      // Keeps 'future_' to check for the table on the next call.
+      return BlockingReason::kNotBlocked;
+    }
     *future = std::move(future_);
   }
   return fromStateToBlockingReason(state_);
@@ -536,9 +606,11 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      !hasApproximateDynamicFilters_) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -566,6 +638,10 @@ void HashProbe::addInput(RowVectorPtr input) {
     VELOX_CHECK_NULL(input_);
     return;
   }
+  if (table_ == nullptr) {
+    bufferPrebuildInput(std::move(input));
+    return;
+  }
   input_ = std::move(input);
 
   // Reset passingInputRowsInitialized_ as input_ as changed.
@@ -577,7 +653,7 @@ void HashProbe::addInput(RowVectorPtr input) {
     noInput_ = false;
   }
 
-  if (canReplaceWithDynamicFilter_) {
+  if (canReplaceWithDynamicFilter_ && !probingPrebuildInput_) {
     replacedWithDynamicFilter_ = true;
     return;
   }
@@ -890,6 +966,10 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
   if (isFinished()) {
     return nullptr;
   }
+  if (table_ == nullptr && state_ == ProbeOperatorState::kWaitForBuild) {
+    // Buffering probe input while the hash table is being built.
+    return nullptr;
+  }
   checkRunning();
 
   if (!toSpillOutput) {
@@ -1467,11 +1547,22 @@ void HashProbe::ensureLoaded(column_index_t channel) {
 
 void HashProbe::noMoreInput() {
   Operator::noMoreInput();
+  if (table_ == nullptr && state_ == ProbeOperatorState::kWaitForBuild) {
+    // Finishes the input after the buffered input is probed.
+    prebuildNoMoreInput_ = true;
+    return;
+  }
+  // Called from asyncWaitForHashTable() if the join produces no output for
+  // the probe input.
+  prebuildInput_.clear();
+  prebuildInputBytes_ = 0;
+  prebuildNoMoreInput_ = false;
   noMoreInputInternal();
 }
 
 bool HashProbe::hasMoreInput() const {
-  return !noMoreInput_ || (spillInputReader_ != nullptr && !noMoreSpillInput_);
+  return !noMoreInput_ || !prebuildInput_.empty() || prebuildNoMoreInput_ ||
+      (spillInputReader_ != nullptr && !noMoreSpillInput_);
 }
 
 void HashProbe::noMoreInputInternal() {
@@ -1828,11 +1919,19 @@ std::unique_ptr<Spiller> HashProbe::spillTable(RowContainer* subTableRows) {
 }
 
 void HashProbe::prepareTableSpill(
-    const std::optional<SpillPartitionId>& restoredPartitionId) {
+    const std::optional<SpillPartitionId>& restoredPartitionId,
+    bool isSpillBlock) {
   if (!spillEnabled()) {
     return;
   }
 
+  // A table built from a block of a skewed spill partition can't be spilled
+  // again as the bridge restores the remaining blocks of the same partition.
+  if (isSpillBlock) {
+    exceededMaxSpillLevelLimit_ = true;
+    return;
+  }
+
   const auto* config = spillConfig();
   uint8_t startPartitionBit = config->startPartitionBit;
   if (restoredPartitionId.has_value()) {
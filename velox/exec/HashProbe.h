@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
@@ -40,6 +42,10 @@ class HashProbe : public Operator {
       return false;
     }
     if (table_) {
+      // The input buffered before the table was built is probed first.
+      return prebuildInput_.empty();
+    }
+    if (canBufferPrebuildInput()) {
       return true;
     }
     // NOTE: if we can't apply dynamic filtering, then we can start early to
@@ -190,14 +196,20 @@ class HashProbe : public Operator {
   void maybeSetupInputSpiller(const SpillPartitionIdSet& spillPartitionIds);
 
   // If 'restoredSpillPartitionId' is set, then setup 'spillInputReader_' to
-  // read probe inputs from spilled data on disk.
+  // read probe inputs from spilled data on disk. If 'hasMoreSpillBlocks' is
+  // true, then the spilled probe inputs are kept to probe against the tables
+  // built from the remaining blocks of the same skewed spill partition.
   void maybeSetupSpillInputReader(
-      const std::optional<SpillPartitionId>& restoredSpillPartitionId);
+      const std::optional<SpillPartitionId>& restoredSpillPartitionId,
+      bool hasMoreSpillBlocks);
 
   // Prepares the table spill by checking the spill level limit, setting spill
-  // partition bits and table spill type.
+  // partition bits and table spill type. The table spill is disabled if
+  // 'isSpillBlock' is true as the table is built from a block of a skewed
+  // spill partition.
   void prepareTableSpill(
-      const std::optional<SpillPartitionId>& restoredPartitionId);
+      const std::optional<SpillPartitionId>& restoredPartitionId,
+      bool isSpillBlock);
 
   bool spillEnabled() const;
 
@@ -236,6 +248,22 @@ class HashProbe : public Operator {
   // Invoked to read next batch of spilled probe inputs from disk to process.
   void addSpillInput();
 
+  // Returns true if the hash table is being built and there is room to buffer
+  // more probe input. See QueryConfig::kHashProbePrebuildBufferBytes.
+  bool canBufferPrebuildInput() const {
+    return table_ == nullptr && state_ == ProbeOperatorState::kWaitForBuild &&
+        prebuildInputBytes_ < maxPrebuildInputBytes_ && !noMoreInput_;
+  }
+
+  // Adds 'input' to 'prebuildInput_'. Loads lazy columns as the source
+  // operator may not be able to load them later.
+  void bufferPrebuildInput(RowVectorPtr input);
+
+  // Invoked after the hash table is built to probe the next batch of the input
+  // buffered before. Finishes the input if it is exhausted and noMoreInput()
+  // was received while buffering.
+  void addPrebuildInput();
+
   // Produces and spills outputs from operator which has pending input to
   // process in probe 'operators'.
   void spillOutput(const std::vector<HashProbe*>& operators);
@@ -317,6 +345,24 @@ class HashProbe : public Operator {
 
   ProbeOperatorState state_{ProbeOperatorState::kWaitForBuild};
 
+  // The maximum bytes of probe input to buffer while the hash table is being
+  // built. 0 if buffering is disabled.
+  uint64_t maxPrebuildInputBytes_{0};
+
+  // Probe input received while the hash table is being built, with its size
+  // in bytes.
+  std::deque<std::pair<RowVectorPtr, uint64_t>> prebuildInput_;
+  uint64_t prebuildInputBytes_{0};
+
+  // True if noMoreInput() was received while the hash table was being built.
+  // The input is finished after 'prebuildInput_' is probed.
+  bool prebuildNoMoreInput_{false};
+
+  // True while probing a batch of 'prebuildInput_'. The batch was produced
+  // before the dynamic filters were pushed down, so the join can not be
+  // replaced by the filters for it.
+  bool probingPrebuildInput_{false};
+
   // Used for synchronization with the hash probe operators of the same pipeline
   // to handle the last probe processing for certain types of join and notify
   // the hash build operators to build the next hash table from spilled data if
@@ -353,6 +399,10 @@ class HashProbe : public Operator {
   // down to the upstream operators.
   tsan_atomic<bool> hasGeneratedDynamicFilters_{false};
 
+  // True if some of the generated dynamic filters are Bloom filters which may
+  // pass probe rows without a match.
+  bool hasApproximateDynamicFilters_{false};
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
@@ -43,6 +43,127 @@ std::string BaseHashTable::modeString(HashMode mode) {
   }
 }
 
+namespace {
+// Calls 'func' with each row of 'rowContainers' which has a non-null value in
+// column 'column'.
+template <typename Func>
+void forEachNonNullRow(
+    const std::vector<RowContainer*>& rowContainers,
+    int32_t column,
+    Func func) {
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  for (auto* rowContainer : rowContainers) {
+    const auto rowColumn = rowContainer->columnAt(column);
+    RowContainerIterator iter;
+    int32_t numRows;
+    while ((numRows = rowContainer->listRows(&iter, kBatchSize, rows.data())) >
+           0) {
+      for (auto i = 0; i < numRows; ++i) {
+        if (!RowContainer::isNullAt(rows[i], rowColumn)) {
+          func(rows[i], rowColumn.offset());
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+std::unique_ptr<common::Filter> createBigintBloomFilter(
+    const std::vector<RowContainer*>& rowContainers,
+    int32_t column,
+    int32_t capacity) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(capacity);
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  forEachNonNullRow(
+      rowContainers, column, [&](const char* row, int32_t offset) {
+        const int64_t value = *reinterpret_cast<const T*>(row + offset);
+        min = std::min(min, value);
+        max = std::max(max, value);
+        bloomFilter->insert(
+            common::BigintValuesUsingBloomFilter::hashValue(value));
+      });
+  if (min > max) {
+    return nullptr;
+  }
+  return std::make_unique<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), false);
+}
+
+std::unique_ptr<common::Filter> createBytesBloomFilter(
+    const std::vector<RowContainer*>& rowContainers,
+    int32_t column,
+    int32_t capacity) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(capacity);
+  bool empty = true;
+  forEachNonNullRow(
+      rowContainers, column, [&](const char* row, int32_t offset) {
+        const auto& value = *reinterpret_cast<const StringView*>(row + offset);
+        bloomFilter->insert(common::BytesValuesUsingBloomFilter::hashValue(
+            std::string_view(value.data(), value.size())));
+        empty = false;
+      });
+  if (empty) {
+    return nullptr;
+  }
+  return std::make_unique<common::BytesValuesUsingBloomFilter>(
+      std::move(bloomFilter), false);
+}
+} // namespace
+
+void BaseHashTable::buildBloomFilters(uint64_t maxNumDistinct) {
+  bloomFilters_.clear();
+  const auto numKeys = numDistinct();
+  if (numKeys == 0 || numKeys > maxNumDistinct ||
+      numKeys > std::numeric_limits<int32_t>::max()) {
+    return;
+  }
+
+  const auto rowContainers = allRows();
+  bloomFilters_.resize(hashers_.size());
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    // An exact IN-list filter is available from the hasher unless its distinct
+    // values have overflowed or the hasher was not tracking them.
+    const bool hasValuesFilter =
+        hashMode() != HashMode::kHash && !hashers_[i]->distinctOverflow();
+    switch (hashers_[i]->typeKind()) {
+      case TypeKind::TINYINT:
+        if (!hasValuesFilter) {
+          bloomFilters_[i] =
+              createBigintBloomFilter<int8_t>(rowContainers, i, numKeys);
+        }
+        break;
+      case TypeKind::SMALLINT:
+        if (!hasValuesFilter) {
+          bloomFilters_[i] =
+              createBigintBloomFilter<int16_t>(rowContainers, i, numKeys);
+        }
+        break;
+      case TypeKind::INTEGER:
+        if (!hasValuesFilter) {
+          bloomFilters_[i] =
+              createBigintBloomFilter<int32_t>(rowContainers, i, numKeys);
+        }
+        break;
+      case TypeKind::BIGINT:
+        if (!hasValuesFilter) {
+          bloomFilters_[i] =
+              createBigintBloomFilter<int64_t>(rowContainers, i, numKeys);
+        }
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        bloomFilters_[i] = createBytesBloomFilter(rowContainers, i, numKeys);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
 template <bool ignoreNullKeys>
 HashTable<ignoreNullKeys>::HashTable(
     std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -53,7 +174,8 @@ HashTable<ignoreNullKeys>::HashTable(
     bool hasProbedFlag,
     uint32_t minTableSizeForParallelJoinBuild,
     memory::MemoryPool* pool,
-    const std::shared_ptr<velox::HashStringAllocator>& stringArena)
+    const std::shared_ptr<velox::HashStringAllocator>& stringArena,
+    bool columnarDependents)
     : BaseHashTable(std::move(hashers)),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
       isJoinBuild_(isJoinBuild) {
@@ -75,7 +197,8 @@ HashTable<ignoreNullKeys>::HashTable(
       hasProbedFlag,
       hashMode_ != HashMode::kHash,
       pool,
-      stringArena);
+      stringArena,
+      columnarDependents);
   nextOffset_ = rows_->nextOffset();
 }
 
@@ -99,6 +222,18 @@ class ProbeState {
     return row_;
   }
 
+  // Returns the row of the first tag hit loaded by firstProbe() or null if
+  // there is no tag hit in the first bucket.
+  char* hit() const {
+    return group_;
+  }
+
+  // Discards the current tag hit after the caller has found it doesn't match
+  // the probe key. A subsequent full probe continues from the next tag hit.
+  void clearHit() {
+    group_ = nullptr;
+  }
+
   // Use one instruction to make 16 copies of the tag being searched for
   template <typename Table>
   inline void preProbe(const Table& table, uint64_t hash, int32_t row) {
@@ -316,7 +451,7 @@ void HashTable<ignoreNullKeys>::storeRowPointer(
     uint64_t hash,
     char* row) {
   if (hashMode_ == HashMode::kArray) {
-    reinterpret_cast<char**>(table_)[index] = row;
+    arraySlot(index) = row;
     return;
   }
   const int64_t offset = bucketOffset(index);
@@ -419,6 +554,73 @@ namespace {
 // Group prefetch size for join build & probe.
 constexpr int32_t kPrefetchSize = 64;
 
+// Returns a bit mask with bit 'i' set if the value of type T at 'offset' in
+// 'candidates[i]' is equal to 'probeValue(i)'. The bits for null candidates
+// are undefined. 'numRows' is at most kPrefetchSize.
+template <typename T, typename ProbeValue>
+uint64_t compareKeyValues(
+    int32_t offset,
+    char* const* candidates,
+    int32_t numRows,
+    ProbeValue probeValue) {
+  using Batch = xsimd::batch<T>;
+  static_assert(kPrefetchSize % Batch::size == 0);
+  alignas(Batch::arch_type::alignment()) T tableValues[kPrefetchSize];
+  alignas(Batch::arch_type::alignment()) T probeValues[kPrefetchSize];
+  for (auto i = 0; i < numRows; ++i) {
+    tableValues[i] = candidates[i] == nullptr
+        ? T{}
+        : *reinterpret_cast<const T*>(candidates[i] + offset);
+    probeValues[i] = probeValue(i);
+  }
+  const auto numPadded = bits::roundUp(numRows, Batch::size);
+  std::fill(tableValues + numRows, tableValues + numPadded, T{});
+  std::fill(probeValues + numRows, probeValues + numPadded, T{});
+  uint64_t equal = 0;
+  for (auto i = 0; i < numRows; i += Batch::size) {
+    const uint32_t mask = simd::toBitMask(
+        Batch::load_aligned(tableValues + i) ==
+        Batch::load_aligned(probeValues + i));
+    equal |= static_cast<uint64_t>(mask) << i;
+  }
+  return equal;
+}
+
+// Compares key column 'key' of 'candidates' with the decoded probe keys of
+// 'rows'. See compareKeyValues() for the result.
+uint64_t compareKeyColumn(
+    VectorHasher& hasher,
+    int32_t offset,
+    const vector_size_t* rows,
+    char* const* candidates,
+    int32_t numRows) {
+  const auto& decoded = hasher.decodedVector();
+  switch (hasher.typeKind()) {
+    case TypeKind::TINYINT:
+      return compareKeyValues<int8_t>(
+          offset, candidates, numRows, [&](auto i) {
+            return decoded.valueAt<int8_t>(rows[i]);
+          });
+    case TypeKind::SMALLINT:
+      return compareKeyValues<int16_t>(
+          offset, candidates, numRows, [&](auto i) {
+            return decoded.valueAt<int16_t>(rows[i]);
+          });
+    case TypeKind::INTEGER:
+      return compareKeyValues<int32_t>(
+          offset, candidates, numRows, [&](auto i) {
+            return decoded.valueAt<int32_t>(rows[i]);
+          });
+    case TypeKind::BIGINT:
+      return compareKeyValues<int64_t>(
+          offset, candidates, numRows, [&](auto i) {
+            return decoded.valueAt<int64_t>(rows[i]);
+          });
+    default:
+      VELOX_UNREACHABLE("Unexpected key type: {}", hasher.typeKind());
+  }
+}
+
 // Normalized keys have non0-random bits. Bits need to be propagated
 // up to make a tag byte and down so that non-lowest bits of
 // normalized key affect the hash table index.
@@ -547,7 +749,7 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
   auto hashes = lookup.hashes.data();
   auto groups = lookup.hits.data();
   int32_t i = 0;
-  if (process::hasAvx2() && simd::isDense(rows, numProbes)) {
+  if (!sparseArray_ && process::hasAvx2() && simd::isDense(rows, numProbes)) {
     auto allZero = xsimd::broadcast<int64_t>(0);
     constexpr int32_t kWidth = xsimd::batch<int64_t>::size;
     auto start = rows[0];
@@ -579,12 +781,49 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
     auto row = rows[i];
     uint64_t index = hashes[row];
     VELOX_DCHECK_LT(index, capacity_);
-    char* group = table_[index];
+    char* group = arrayEntry(index);
     if (UNLIKELY(!group)) {
       group = insertEntry(lookup, index, row);
     }
     groups[row] = group; // NOLINT
   }
+  if (sparseArray_) {
+    checkSparseArrayDensity();
+  }
+}
+
+template <bool ignoreNullKeys>
+char* HashTable<ignoreNullKeys>::allocateSparseArrayPage() {
+  constexpr auto kPageBytes = kSparseArrayPageSize * sizeof(char*);
+  auto* page = reinterpret_cast<char*>(rows_->pool()->allocate(kPageBytes));
+  ::memset(page, 0, kPageBytes);
+  sparseArrayPages_.push_back(page);
+  return page;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::freeSparseArrayPages() {
+  for (auto* page : sparseArrayPages_) {
+    rows_->pool()->free(page, kSparseArrayPageSize * sizeof(char*));
+  }
+  sparseArrayPages_.clear();
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::checkSparseArrayDensity() {
+  // A page holds 32KB of pointers. Below one entry per 'kMaxSlotsPerEntry'
+  // slots, a hash table on the same value ids takes less memory.
+  constexpr uint64_t kMinPagesToCheck = 16;
+  constexpr uint64_t kMaxSlotsPerEntry = 4;
+  const uint64_t numPages = sparseArrayPages_.size();
+  if (numPages < kMinPagesToCheck ||
+      numDistinct_ * kMaxSlotsPerEntry >= numPages * kSparseArrayPageSize) {
+    return;
+  }
+  disableSparseArray_ = true;
+  // The value ids of the hashers stay the same and are hashed as normalized
+  // keys.
+  setHashMode(HashMode::kNormalizedKey, 0);
 }
 
 template <bool ignoreNullKeys>
@@ -599,6 +838,10 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
+  if (canBatchCompareKeys(lookup)) {
+    joinBatchCompareProbe(lookup);
+    return;
+  }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
@@ -676,32 +919,115 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
+  const int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
   ProbeState states[kPrefetchSize];
+  char* candidates[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + kPrefetchSize <= numProbes; probeIndex += kPrefetchSize) {
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      int32_t row = rows[probeIndex + i];
+  for (int32_t probeIndex = 0; probeIndex < numProbes;
+       probeIndex += kPrefetchSize) {
+    const int32_t numRows =
+        std::min<int32_t>(kPrefetchSize, numProbes - probeIndex);
+    const vector_size_t* batchRows = rows + probeIndex;
+    for (int32_t i = 0; i < numRows; ++i) {
+      const int32_t row = batchRows[i];
       states[i].preProbe(*this, hashes[row], row);
     }
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+    uint64_t matches = 0;
+    for (int32_t i = 0; i < numRows; ++i) {
       states[i].firstProbe(*this, kKeyOffset);
+      candidates[i] = states[i].hit();
+      matches |= static_cast<uint64_t>(candidates[i] != nullptr) << i;
+    }
+    if (matches != 0) {
+      matches &= compareKeyValues<normalized_key_t>(
+          kKeyOffset, candidates, numRows, [&](auto i) {
+            return keys[batchRows[i]];
+          });
+    }
+    for (int32_t i = 0; i < numRows; ++i) {
+      if (matches & (1ULL << i)) {
+        incrementHits();
+        hits[batchRows[i]] = candidates[i];
+        continue;
+      }
+      states[i].clearHit();
+      hits[batchRows[i]] = states[i].joinNormalizedKeyFullProbe(*this, keys);
     }
-    for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
+  }
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::canBatchCompareKeys(
+    const HashLookup& lookup) const {
+  // Null keys need the null flags compared as well, which we leave to the row
+  // by row probe.
+  if (!ignoreNullKeys || lookup.hashers.size() < 2) {
+    return false;
+  }
+  for (const auto& hasher : lookup.hashers) {
+    switch (hasher->typeKind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        break;
+      default:
+        return false;
     }
   }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    states[0].preProbe(*this, lookup.hashes[row], row);
-    states[0].firstProbe(*this, 0);
-    hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
+  return true;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::joinBatchCompareProbe(HashLookup& lookup) {
+  const int32_t numProbes = lookup.rows.size();
+  const int32_t numKeys = lookup.hashers.size();
+  const vector_size_t* rows = lookup.rows.data();
+  ProbeState states[kPrefetchSize];
+  char* candidates[kPrefetchSize];
+  const uint64_t* hashes = lookup.hashes.data();
+  char** hits = lookup.hits.data();
+  for (int32_t probeIndex = 0; probeIndex < numProbes;
+       probeIndex += kPrefetchSize) {
+    const int32_t numRows =
+        std::min<int32_t>(kPrefetchSize, numProbes - probeIndex);
+    const vector_size_t* batchRows = rows + probeIndex;
+    for (int32_t i = 0; i < numRows; ++i) {
+      const int32_t row = batchRows[i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    uint64_t matches = 0;
+    for (int32_t i = 0; i < numRows; ++i) {
+      states[i].firstProbe(*this, 0);
+      candidates[i] = states[i].hit();
+      matches |= static_cast<uint64_t>(candidates[i] != nullptr) << i;
+    }
+    // Compare one key column at a time for all the candidates which still
+    // match on the previous key columns.
+    for (int32_t key = 0; key < numKeys && matches != 0; ++key) {
+      matches &= compareKeyColumn(
+          *lookup.hashers[key],
+          rows_->columnAt(key).offset(),
+          batchRows,
+          candidates,
+          numRows);
+    }
+    for (int32_t i = 0; i < numRows; ++i) {
+      if (matches & (1ULL << i)) {
+        incrementHits();
+        hits[batchRows[i]] = candidates[i];
+        continue;
+      }
+      // The first tag hit doesn't match. Continue with the rest of the tag
+      // hits and buckets.
+      states[i].clearHit();
+      fullProbe<true>(lookup, states[i], false);
+    }
   }
 }
 
@@ -722,6 +1048,8 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   // cache line.
   const auto numPages =
       memory::AllocationTraits::numPages(size * tableSlotSize());
+  freeSparseArrayPages();
+  sparseArray_ = false;
   rows_->pool()->allocateContiguous(numPages, tableAllocation_);
   table_ = tableAllocation_.data<char*>();
   memset(table_, 0, capacity_ * sizeof(char*));
@@ -739,9 +1067,13 @@ void HashTable<ignoreNullKeys>::clear(bool freeTable) {
     rowContainer->clear();
   }
   if (table_) {
+    freeSparseArrayPages();
     if (!freeTable) {
-      // All modes have 8 bytes per slot.
-      ::memset(table_, 0, capacity_ * sizeof(char*));
+      // All modes have 8 bytes per slot. A sparse array clears its directory.
+      ::memset(
+          table_,
+          0,
+          (sparseArray_ ? numSparseArrayPages() : capacity_) * sizeof(char*));
     } else {
       rows_->pool()->freeContiguous(tableAllocation_);
       table_ = nullptr;
@@ -870,13 +1202,32 @@ bool HashTable<ignoreNullKeys>::canApplyParallelJoinBuild() const {
       minTableSizeForParallelJoinBuild_;
 }
 
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::numParallelJoinBuildPartitions() const {
+  const int32_t numTables = 1 + otherTables_.size();
+  const uint64_t tableBytes = sizeMask_ + 1;
+  int32_t numPartitions = numTables;
+  // Double the number of partitions while a partition exceeds the target size.
+  // Each partition must still have enough entries to be worth building
+  // separately and hold at least one bucket.
+  while (numPartitions * 2 <= std::numeric_limits<uint8_t>::max() &&
+         tableBytes / numPartitions > parallelJoinBuildPartitionBytes_ &&
+         capacity_ / (numPartitions * 2) > minTableSizeForParallelJoinBuild_ &&
+         tableBytes / (numPartitions * 2) >= kBucketSize) {
+    numPartitions *= 2;
+  }
+  return numPartitions;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   process::TraceContext trace("HashTable::parallelJoinBuild");
   TestValue::adjust(
       "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
   VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
-  const uint8_t numPartitions = 1 + otherTables_.size();
+  const uint8_t numTables = 1 + otherTables_.size();
+  const uint8_t numPartitions = numParallelJoinBuildPartitions();
+  VELOX_CHECK_EQ(numPartitions % numTables, 0);
   VELOX_CHECK_GT(
       capacity_ / numPartitions,
       minTableSizeForParallelJoinBuild_,
@@ -922,14 +1273,14 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   // This step can involve large memory allocations, so there is a chance of
   // OOMs here. Do it before any async work is started to reduce the chances of
   // concurrency issues.
-  rowPartitions.reserve(numPartitions);
-  for (auto i = 0; i < numPartitions; ++i) {
+  rowPartitions.reserve(numTables);
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = getTable(i);
     rowPartitions.push_back(table->rows()->createRowPartitions(*rows_->pool()));
   }
 
   // The parallel table partitioning step.
-  for (auto i = 0; i < numPartitions; ++i) {
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = getTable(i);
     partitionSteps.push_back(std::make_shared<AsyncSource<bool>>(
         [this, table, rawRowPartitions = rowPartitions[i].get()]() {
@@ -946,12 +1297,28 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
     std::rethrow_exception(error);
   }
 
-  // The parallel table building step.
+  // The parallel table building step. Thread i builds partitions i, i +
+  // numTables, i + 2 * numTables, etc. one at a time and uses the RowContainer
+  // of table i for linking duplicate rows.
   std::vector<std::vector<char*>> overflowPerPartition(numPartitions);
-  for (auto i = 0; i < numPartitions; ++i) {
+  for (auto i = 0; i < numTables; ++i) {
     buildSteps.push_back(std::make_shared<AsyncSource<bool>>(
-        [this, i, &overflowPerPartition, &rowPartitions]() {
-          buildJoinPartition(i, rowPartitions, overflowPerPartition[i]);
+        [this,
+         i,
+         numTables,
+         numPartitions,
+         getTable,
+         &overflowPerPartition,
+         &rowPartitions]() {
+          auto* rows = getTable(i)->rows();
+          for (auto partition = i; partition < numPartitions;
+               partition += numTables) {
+            buildJoinPartition(
+                partition,
+                rows,
+                rowPartitions,
+                overflowPerPartition[partition]);
+          }
           return std::make_unique<bool>(true);
         }));
     VELOX_CHECK(!buildSteps.empty());
@@ -970,37 +1337,40 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
         folly::Range<char**>(overflows.data(), overflows.size()),
         false,
         hashes);
-    auto table = i == 0 ? this : otherTables_[i - 1].get();
     insertForJoin(
-        table->rows(),
+        getTable(i % numTables)->rows(),
         overflows.data(),
         hashes.data(),
         overflows.size(),
         nullptr);
+  }
 
+  for (auto i = 0; i < numTables; ++i) {
+    auto* table = getTable(i);
     VELOX_CHECK_EQ(table->rows()->numRows(), table->numParallelBuildRows_);
   }
 }
 
 namespace {
 // Returns an index into 'buildPartitionBounds_' given an index into tags of the
-// HashTable.
+// HashTable. 'partitionSize' is the size of the table divided by the number of
+// partitions. The bounds are multiples of 'partitionSize' rounded up to bucket
+// size, so the partition computed from 'partitionSize' is off by at most one.
 int32_t findPartition(
     PartitionBoundIndexType index,
     const PartitionBoundIndexType* bounds,
-    int32_t numPartitions) {
-  // The partition bounds are padded to batch size.
-  constexpr int32_t kBatch = xsimd::batch<PartitionBoundIndexType>::size;
-  auto indexVector = xsimd::batch<PartitionBoundIndexType>::broadcast(index);
-  for (auto i = 1; i < numPartitions; i += kBatch) {
-    auto bits = simd::toBitMask(
-        indexVector <
-        xsimd::batch<PartitionBoundIndexType>::load_unaligned(bounds + i));
-    if (bits) {
-      return i + __builtin_ctz(bits) - 1;
-    }
-  }
-  VELOX_UNREACHABLE("Partition index out of range");
+    int32_t numPartitions,
+    PartitionBoundIndexType partitionSize) {
+  int32_t partition = std::min<PartitionBoundIndexType>(
+      numPartitions - 1, index / partitionSize);
+  while (index < bounds[partition]) {
+    --partition;
+  }
+  while (index >= bounds[partition + 1]) {
+    ++partition;
+  }
+  VELOX_DCHECK_LT(partition, numPartitions, "Partition index out of range");
+  return partition;
 }
 } // namespace
 
@@ -1012,19 +1382,17 @@ void HashTable<ignoreNullKeys>::partitionRows(
   raw_vector<char*> rows(kBatch);
   raw_vector<uint64_t> hashes(kBatch);
   raw_vector<uint8_t> partitions(kBatch);
+  const int32_t numPartitions = buildPartitionBounds_.size() - 1;
+  const PartitionBoundIndexType partitionSize =
+      (sizeMask_ + 1) / numPartitions;
   RowContainerIterator iter;
   while (auto numRows = subtable.rows_->listRows(
              &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
     hashRows(folly::Range<char**>(rows.data(), numRows), true, hashes);
-    VELOX_DCHECK_EQ(
-        0,
-        buildPartitionBounds_.capacity() %
-            xsimd::batch<PartitionBoundIndexType>::size,
-        "partition bounds must be padded to SIMD width");
     for (auto i = 0; i < numRows; ++i) {
       auto index = bucketOffset(hashes[i]);
       partitions[i] = findPartition(
-          index, buildPartitionBounds_.data(), buildPartitionBounds_.size());
+          index, buildPartitionBounds_.data(), numPartitions, partitionSize);
     }
     rowPartitions.appendPartitions(
         folly::Range<const uint8_t*>(partitions.data(), numRows));
@@ -1034,19 +1402,18 @@ void HashTable<ignoreNullKeys>::partitionRows(
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::buildJoinPartition(
     uint8_t partition,
+    RowContainer* rowContainer,
     const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
     std::vector<char*>& overflow) {
   constexpr int32_t kBatch = 1024;
   raw_vector<char*> rows(kBatch);
   raw_vector<uint64_t> hashes(kBatch);
-  const int32_t numPartitions = 1 + otherTables_.size();
+  const int32_t numTables = 1 + otherTables_.size();
   TableInsertPartitionInfo partitionInfo{
       buildPartitionBounds_[partition],
       buildPartitionBounds_[partition + 1],
       overflow};
-  auto rowContainer =
-      (partition == 0 ? this : otherTables_[partition - 1].get())->rows();
-  for (auto i = 0; i < numPartitions; ++i) {
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = i == 0 ? this : otherTables_[i - 1].get();
     RowContainerIterator iter;
     while (const auto numRows = table->rows_->listPartitionRows(
@@ -1085,8 +1452,9 @@ void HashTable<ignoreNullKeys>::insertForGroupBy(
     for (auto i = 0; i < numGroups; ++i) {
       auto index = hashes[i];
       VELOX_CHECK_LT(index, capacity_);
-      VELOX_CHECK_NULL(table_[index]);
-      table_[index] = groups[i];
+      auto& slot = arraySlot(index);
+      VELOX_CHECK_NULL(slot);
+      slot = groups[i];
     }
   } else {
     constexpr int32_t kPrefetchDistance = 10;
@@ -1130,6 +1498,7 @@ void HashTable<ignoreNullKeys>::insertForGroupBy(
 
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::arrayPushRow(char* row, int32_t index) {
+  VELOX_DCHECK(!sparseArray_);
   auto existing = table_[index];
   if (existing) {
     if (nextOffset_) {
@@ -1310,7 +1679,10 @@ void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
   VELOX_CHECK_NE(hashMode_, HashMode::kHash);
   TestValue::adjust("facebook::velox::exec::HashTable::setHashMode", &mode);
   if (mode == HashMode::kArray) {
-    const auto bytes = capacity_ * tableSlotSize();
+    freeSparseArrayPages();
+    // A sparse array allocates its directory here and its pages on insert.
+    const auto bytes =
+        (sparseArray_ ? numSparseArrayPages() : capacity_) * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
     rows_->pool()->allocateContiguous(numPages, tableAllocation_);
     table_ = tableAllocation_.data<char*>();
@@ -1472,6 +1844,7 @@ void HashTable<ignoreNullKeys>::decideHashMode(
     return;
   }
   disableRangeArrayHash_ |= disableRangeArrayHash;
+  sparseArray_ = false;
   if (numDistinct_ && !isJoinBuild_) {
     if (!analyze()) {
       setHashMode(HashMode::kHash, numNew);
@@ -1509,6 +1882,16 @@ void HashTable<ignoreNullKeys>::decideHashMode(
     setHashMode(HashMode::kArray, numNew);
     return;
   }
+  // A multi-key group by whose value ids exceed a flat array but fit in a
+  // sparse one. The key combinations are often much fewer than the product
+  // of the ranges, so that only a few pages get allocated.
+  if (!isJoinBuild_ && hashers_.size() > 1 && !disableRangeArrayHash_ &&
+      !disableSparseArray_ && bestWithReserve < kSparseArrayHashMaxSize) {
+    capacity_ = setHasherMode(hashers_, useRange, rangeSizes, distinctSizes);
+    sparseArray_ = true;
+    setHashMode(HashMode::kArray, numNew);
+    return;
+  }
   if (rangesWithReserve != VectorHasher::kRangeTooLarge) {
     std::fill(useRange.begin(), useRange.end(), true);
     setHasherMode(hashers_, useRange, rangeSizes, distinctSizes);
@@ -1580,7 +1963,17 @@ std::string HashTable<ignoreNullKeys>::toString() {
         << std::endl;
   }
 
-  if (hashMode_ == HashMode::kArray) {
+  if (hashMode_ == HashMode::kArray && sparseArray_) {
+    int64_t occupied = 0;
+    for (const auto* page : sparseArrayPages_) {
+      for (uint64_t i = 0; i < kSparseArrayPageSize; ++i) {
+        occupied += reinterpret_cast<char* const*>(page)[i] != nullptr;
+      }
+    }
+    out << "Sparse array pages: " << sparseArrayPages_.size()
+        << " of: " << numSparseArrayPages() << std::endl;
+    out << "Total slots used: " << occupied << std::endl;
+  } else if (hashMode_ == HashMode::kArray) {
     int64_t occupied = 0;
     if (table_ && tableAllocation_.data() && tableAllocation_.size()) {
       // 'size_' and 'table_' may not be set if initializing.
@@ -1986,7 +2379,7 @@ void HashTable<ignoreNullKeys>::eraseWithHashes(
   if (hashMode_ == HashMode::kArray) {
     for (auto i = 0; i < numRows; ++i) {
       DCHECK(hashes[i] < capacity_);
-      table_[hashes[i]] = nullptr;
+      arraySlot(hashes[i]) = nullptr;
     }
   } else {
     if (hashMode_ == HashMode::kNormalizedKey) {
@@ -103,6 +103,9 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Number of table partitions of the last parallel join build. 0 if the
+  /// table was not built in parallel.
+  int64_t numParallelBuildPartitions{0};
 };
 
 class BaseHashTable {
@@ -118,6 +121,14 @@ class BaseHashTable {
   /// 2M entries, i.e. 16MB is the largest array based hash table.
   static constexpr uint64_t kArrayHashMaxSize = 2L << 20;
 
+  /// The largest value id range of a group by in kArray mode with a sparse
+  /// array. The array is a directory of pages of kSparseArrayPageSize slots
+  /// that are allocated when the first key combination in their range is
+  /// inserted. This keeps multi-key group bys over small domains with few
+  /// populated combinations, e.g. (date, enum, enum), in kArray mode.
+  static constexpr uint64_t kSparseArrayHashMaxSize = 64L << 20;
+  static constexpr uint64_t kSparseArrayPageSize = 4096;
+
   /// Specifies the hash mode of a table.
   enum class HashMode { kHash, kArray, kNormalizedKey };
 
@@ -132,6 +143,8 @@ class BaseHashTable {
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
+  static inline const std::string kNumParallelBuildPartitions{
+      "hashtable.numParallelBuildPartitions"};
 
   /// Returns the string of the given 'mode'.
   static std::string modeString(HashMode mode);
@@ -344,6 +357,24 @@ class BaseHashTable {
   /// join use.
   virtual std::vector<RowContainer*> allRows() const = 0;
 
+  /// Builds a Bloom filter over the values of each integer or string join key
+  /// which has no exact filter from its VectorHasher. These are pushed down as
+  /// dynamic filters when the build side has too many distinct keys for an
+  /// IN-list. Builds nothing if the table has more than 'maxNumDistinct'
+  /// distinct keys. Invoked once the join table is built. Drops any filters
+  /// built before.
+  void buildBloomFilters(uint64_t maxNumDistinct);
+
+  /// Returns the Bloom filter over the values of the 'keyIndex'th key built by
+  /// buildBloomFilters(), or nullptr if there is none. The filter does not
+  /// allow nulls.
+  const common::Filter* bloomFilter(int32_t keyIndex) const {
+    if (keyIndex >= bloomFilters_.size()) {
+      return nullptr;
+    }
+    return bloomFilters_[keyIndex].get();
+  }
+
   /// Static functions for processing internals. Public because used in
   /// structs that define probe and insert algorithms.
 
@@ -408,6 +439,10 @@ class BaseHashTable {
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   std::unique_ptr<RowContainer> rows_;
 
+  // Bloom filters over the join key values, one per key. nullptr for keys
+  // without one. Set by buildBloomFilters().
+  std::vector<std::unique_ptr<common::Filter>> bloomFilters_;
+
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
 };
@@ -444,7 +479,8 @@ class HashTable : public BaseHashTable {
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
       memory::MemoryPool* pool,
-      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr);
+      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr,
+      bool columnarDependents = false);
 
   ~HashTable() override {
     if (otherTables_.size() > 0) {
@@ -453,6 +489,7 @@ class HashTable : public BaseHashTable {
         otherTables_[i]->rows()->clearNextRowVectors();
       }
     }
+    freeSparseArrayPages();
   }
 
   static std::unique_ptr<HashTable> createForAggregation(
@@ -479,7 +516,8 @@ class HashTable : public BaseHashTable {
       bool allowDuplicates,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool columnarDependents = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -488,7 +526,9 @@ class HashTable : public BaseHashTable {
         true, // isJoinBuild
         hasProbedFlag,
         minTableSizeForParallelJoinBuild,
-        pool);
+        pool,
+        nullptr, // stringArena
+        columnarDependents);
   }
 
   void groupProbe(HashLookup& lookup) override;
@@ -529,7 +569,7 @@ class HashTable : public BaseHashTable {
   int64_t allocatedBytes() const override {
     // For each row: sizeof(char*) per table entry + memory
     // allocated with MemoryAllocator for fixed-width rows and strings.
-    return sizeof(char*) * capacity_ + rows_->allocatedBytes();
+    return sizeof(char*) * numAllocatedSlots() + rows_->allocatedBytes();
   }
 
   HashStringAllocator* stringAllocator() override {
@@ -546,7 +586,13 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        static_cast<int64_t>(numAllocatedSlots()),
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        static_cast<int64_t>(
+            buildPartitionBounds_.empty() ? 0
+                                          : buildPartitionBounds_.size() - 1)};
   }
 
   bool hasDuplicateKeys() const override {
@@ -579,6 +625,13 @@ class HashTable : public BaseHashTable {
           kNoSpillInputStartPartitionBit) override;
 
   uint64_t hashTableSizeIncrease(int32_t numNewDistinct) const override {
+    if (sparseArray_) {
+      // Each new entry may allocate a page of the sparse array.
+      const auto numFreePages =
+          numSparseArrayPages() - sparseArrayPages_.size();
+      return std::min<uint64_t>(numNewDistinct, numFreePages) *
+          kSparseArrayPageSize * sizeof(char*);
+    }
     if (numDistinct_ + numNewDistinct > rehashSize()) {
       // If rehashed, the table adds size_ entries (i.e. doubles),
       // adding one pointer worth for each new position.  (16 tags, 16 6 byte
@@ -625,6 +678,14 @@ class HashTable : public BaseHashTable {
     return otherTables_;
   }
 
+  /// Default target max size in bytes of a partition of the table in parallel
+  /// join build. Approximates the size of L2 cache.
+  static constexpr uint64_t kParallelJoinBuildPartitionBytes = 1 << 20;
+
+  void testingSetParallelJoinBuildPartitionBytes(uint64_t bytes) {
+    parallelJoinBuildPartitionBytes_ = bytes;
+  }
+
  private:
   // Enables debug stats for collisions for debug build.
 #ifdef NDEBUG
@@ -706,6 +767,54 @@ class HashTable : public BaseHashTable {
 
   void arrayGroupProbe(HashLookup& lookup);
 
+  // Returns the entry at 'index' in kArray mode or nullptr if the page of a
+  // sparse array is not allocated.
+  char* arrayEntry(uint64_t index) const {
+    if (!sparseArray_) {
+      return table_[index];
+    }
+    const auto* page = reinterpret_cast<char* const*>(
+        table_[index / kSparseArrayPageSize]);
+    return page ? page[index % kSparseArrayPageSize] : nullptr;
+  }
+
+  // Returns the slot at 'index' in kArray mode. Allocates the page of a
+  // sparse array on first use.
+  char*& arraySlot(uint64_t index) {
+    if (!sparseArray_) {
+      return table_[index];
+    }
+    auto& page = table_[index / kSparseArrayPageSize];
+    if (UNLIKELY(page == nullptr)) {
+      page = allocateSparseArrayPage();
+    }
+    return reinterpret_cast<char**>(page)[index % kSparseArrayPageSize];
+  }
+
+  // Number of page pointers in the directory of a sparse array.
+  uint64_t numSparseArrayPages() const {
+    return bits::roundUp(capacity_, kSparseArrayPageSize) /
+        kSparseArrayPageSize;
+  }
+
+  // Number of table slots backed by memory. For a sparse array, these are
+  // the directory and the allocated pages, not 'capacity_'.
+  uint64_t numAllocatedSlots() const {
+    if (!sparseArray_) {
+      return capacity_;
+    }
+    return numSparseArrayPages() +
+        sparseArrayPages_.size() * kSparseArrayPageSize;
+  }
+
+  char* allocateSparseArrayPage();
+
+  void freeSparseArrayPages();
+
+  // Falls back to kNormalizedKey mode if the allocated pages of a sparse
+  // array have too few entries.
+  void checkSparseArrayDensity();
+
   void setHashMode(HashMode mode, int32_t numNew) override;
 
   // Fast path for join results when there are no duplicates in the table.
@@ -789,19 +898,30 @@ class HashTable : public BaseHashTable {
   bool canApplyParallelJoinBuild() const;
 
   // Builds a join table with '1 + otherTables_.size()' independent
-  // threads using 'executor_'. First all RowContainers get partition
-  // numbers assigned to each row. Next, all threads pick all rows
-  // assigned to their thread-specific partition and insert these. If
-  // a row would overflow past the end of its partition it is added to
-  // a set of overflow rows that are sequentially inserted after all
-  // else.
+  // threads using 'executor_'. The table is split into partitions, i.e.
+  // contiguous ranges of buckets. First all RowContainers get partition
+  // numbers assigned to each row. Next, each thread picks the partitions
+  // assigned to it and inserts their rows one partition at a time. Large
+  // tables get more partitions than threads so that the buckets of the
+  // partition being built stay cache resident, see
+  // numParallelJoinBuildPartitions(). If a row would overflow past the end of
+  // its partition it is added to a set of overflow rows that are sequentially
+  // inserted after all else.
   void parallelJoinBuild();
 
+  // Returns the number of partitions for parallel join build. This is a
+  // multiple of the number of tables, so that each thread builds the same
+  // number of partitions, and is chosen so that a partition takes no more than
+  // kParallelJoinBuildPartitionBytes.
+  int32_t numParallelJoinBuildPartitions() const;
+
   // Inserts the rows in 'partition' from this and 'otherTables' into 'this'.
-  // The rows that would have gone past the end of the partition are returned in
-  // 'overflow'.
+  // 'rows' is the RowContainer of the thread building the partition and is
+  // used to link rows with duplicate keys. The rows that would have gone past
+  // the end of the partition are returned in 'overflow'.
   void buildJoinPartition(
       uint8_t partition,
+      RowContainer* rows,
       const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
       std::vector<char*>& overflow);
 
@@ -841,6 +961,15 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Returns true if the keys of a kHash mode join probe can be compared a
+  // batch of probe rows at a time by joinBatchCompareProbe().
+  bool canBatchCompareKeys(const HashLookup& lookup) const;
+
+  // Probe in kHash mode which gathers the first tag hit for a batch of probe
+  // rows and compares the keys column by column with SIMD. Only the probe rows
+  // whose first hit doesn't match go through the row by row full probe.
+  void joinBatchCompareProbe(HashLookup& lookup);
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -999,6 +1128,10 @@ class HashTable : public BaseHashTable {
   // of cache line  size.
   raw_vector<PartitionBoundIndexType> buildPartitionBounds_;
 
+  // Target max size in bytes of a partition of the table in parallel join
+  // build. The buckets of a partition are expected to fit in L2 cache.
+  uint64_t parallelJoinBuildPartitionBytes_{kParallelJoinBuildPartitionBytes};
+
   // Executor for parallelizing hash join build. This may be the
   // executor for Drivers. If this executor is indefinitely taken by
   // other work, the thread of prepareJoinTable() will sequentially
@@ -1011,6 +1144,16 @@ class HashTable : public BaseHashTable {
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
 
+  // True if 'table_' is the directory of a sparse array in kArray mode.
+  bool sparseArray_{false};
+
+  // Set after a sparse array turned out too sparse. A group by then uses
+  // kNormalizedKey instead.
+  bool disableSparseArray_{false};
+
+  // The allocated pages of a sparse array.
+  std::vector<char*> sparseArrayPages_;
+
   friend class ProbeState;
   friend test::HashTableTestHelper<ignoreNullKeys>;
 };
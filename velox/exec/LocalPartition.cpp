@@ -29,27 +29,38 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_ += added; bufferedBytes_ < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasPromises_ = true;
+  if (bufferedBytes_ < maxBufferSize_) {
+    // A consumer made room since the increase.
+    hasPromises_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
+  if (bufferedBytes_ -= removed; bufferedBytes_ >= maxBufferSize_) {
+    return {};
+  }
+  if (!hasPromises_) {
+    return {};
+  }
+
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
     if (bufferedBytes_ < maxBufferSize_) {
       promises = std::move(promises_);
+      promises_.clear();
+      hasPromises_ = false;
     }
   }
   return promises;
@@ -81,18 +92,15 @@ BlockingReason LocalExchangeQueue::enqueue(
   auto inputBytes = input->estimateFlatSize();
 
   std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
   bool isClosed = queue_.withWLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
-    consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
+    queue.push({std::move(input), inputBytes});
+    if (!consumerPromises_.empty()) {
+      consumerPromises.push_back(std::move(consumerPromises_.back()));
+      consumerPromises_.pop_back();
     }
-
     return false;
   });
 
@@ -102,7 +110,10 @@ BlockingReason LocalExchangeQueue::enqueue(
 
   notify(consumerPromises);
 
-  if (blockedOnConsumer) {
+  // The size is updated outside of the queue lock. A consumer may take the
+  // input and decrease the size first, which only makes the size briefly
+  // smaller than it is.
+  if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
     return BlockingReason::kWaitForConsumer;
   }
 
@@ -125,7 +136,7 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
+  int64_t dataBytes = 0;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -139,20 +150,19 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
+    std::tie(*data, dataBytes) = std::move(queue.front());
     queue.pop();
-
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
-
     return BlockingReason::kNotBlocked;
   });
-  notify(memoryPromises);
+  if (dataBytes > 0) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(dataBytes);
+    notify(memoryPromises);
+  }
   return blockingReason;
 }
 
 bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+    const std::queue<Entry>& queue) const {
   if (closed_) {
     return true;
   }
@@ -171,20 +181,18 @@ bool LocalExchangeQueue::isFinished() {
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
+  int64_t freedBytes = 0;
   queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += queue.front().second;
       queue.pop();
     }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
-
     consumerPromises = std::move(consumerPromises_);
     closed_ = true;
   });
+  if (freedBytes) {
+    memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
+  }
   notify(consumerPromises);
   notify(memoryPromises);
 }
@@ -248,6 +256,7 @@ LocalPartition::LocalPartition(
       queues_{
           ctx->task->getLocalExchangeQueues(ctx->splitGroupId, planNode->id())},
       numPartitions_{queues_.size()},
+      flatOutput_{ctx->queryConfig().localPartitionFlatOutput()},
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
@@ -307,28 +316,34 @@ void LocalPartition::addInput(RowVectorPtr input) {
   }
 
   if (numPartitions_ == 1) {
-    ContinueFuture future;
-    auto blockingReason = queues_[0]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(0, std::move(input));
     return;
   }
 
   const auto singlePartition =
       partitionFunction_->partition(*input, partitions_);
   if (singlePartition.has_value()) {
-    ContinueFuture future;
-    auto blockingReason =
-        queues_[singlePartition.value()]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(singlePartition.value(), std::move(input));
     return;
   }
 
+  if (flatOutput_) {
+    enqueueSlices(input);
+  } else {
+    enqueueDictionaries(input);
+  }
+}
+
+void LocalPartition::enqueue(int32_t partition, RowVectorPtr data) {
+  ContinueFuture future;
+  auto reason = queues_[partition]->enqueue(std::move(data), &future);
+  if (reason != BlockingReason::kNotBlocked) {
+    blockingReasons_.push_back(reason);
+    futures_.push_back(std::move(future));
+  }
+}
+
+void LocalPartition::enqueueDictionaries(const RowVectorPtr& input) {
   const auto numInput = input->size();
   std::vector<vector_size_t> maxIndex(numPartitions_, 0);
   for (auto i = 0; i < numInput; ++i) {
@@ -350,15 +365,44 @@ void LocalPartition::addInput(RowVectorPtr input) {
       // Do not enqueue empty partitions.
       continue;
     }
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
-
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
+    enqueue(
+        i, wrapChildren(input, partitionSize, std::move(indexBuffers[i])));
+  }
+}
+
+void LocalPartition::enqueueSlices(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  // Counting sort of the rows by partition. 'offsets[i]' is the first row of
+  // partition 'i' in the reordered copy.
+  std::vector<vector_size_t> offsets(numPartitions_ + 1, 0);
+  for (auto i = 0; i < numInput; ++i) {
+    ++offsets[partitions_[i] + 1];
+  }
+  for (auto i = 1; i <= numPartitions_; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  auto sourceRows = allocateIndices(numInput, pool());
+  auto* rawSourceRows = sourceRows->asMutable<vector_size_t>();
+  std::vector<vector_size_t> nextRows(offsets.begin(), offsets.end() - 1);
+  for (auto i = 0; i < numInput; ++i) {
+    rawSourceRows[nextRows[partitions_[i]]++] = i;
+  }
+
+  // One gather per column for the whole input. The slices share the buffers
+  // of the copy.
+  auto reordered = BaseVector::create(input->type(), numInput, pool());
+  SelectivityVector allRows(numInput);
+  reordered->copy(input.get(), allRows, rawSourceRows);
+
+  for (auto i = 0; i < numPartitions_; i++) {
+    const auto partitionSize = offsets[i + 1] - offsets[i];
+    if (partitionSize == 0) {
+      continue;
     }
+    enqueue(
+        i,
+        std::static_pointer_cast<RowVector>(
+            reordered->slice(offsets[i], partitionSize)));
   }
 }
 
@@ -21,7 +21,9 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. Shared by all producers and consumers of a local
+/// exchange, so the size is updated without a lock while it stays below the
+/// limit and there are no blocked producers.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -38,8 +40,12 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True while 'promises_' may be non-empty. Set under 'mutex_' before
+  // checking 'bufferedBytes_', so that either a blocking producer sees the
+  // decreased size or the consumer that decreased it sees the flag.
+  std::atomic<bool> hasPromises_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -89,14 +95,19 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // A vector and its size in bytes as added to 'memoryManager_'.
+  using Entry = std::pair<RowVectorPtr, int64_t>;
+
+  bool isFinishedLocked(const std::queue<Entry>& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<std::queue<Entry>> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
-  // and pendingProducers_ is zero.
+  // and pendingProducers_ is zero. Each enqueue wakes up one consumer since
+  // only one can take the new data. All are woken up when no more data will
+  // come.
   std::vector<ContinuePromise> consumerPromises_;
   int pendingProducers_{0};
   bool noMoreProducers_{false};
@@ -172,8 +183,19 @@ class LocalPartition : public Operator {
   bool isFinished() override;
 
  private:
+  void enqueue(int32_t partition, RowVectorPtr data);
+
+  // Wraps the rows of each partition of 'input' in a dictionary.
+  void enqueueDictionaries(const RowVectorPtr& input);
+
+  // Copies 'input' with the rows ordered by partition and enqueues a slice
+  // of the copy for each partition.
+  void enqueueSlices(const RowVectorPtr& input);
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
+  // See QueryConfig::localPartitionFlatOutput().
+  const bool flatOutput_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
 
   std::vector<BlockingReason> blockingReasons_;
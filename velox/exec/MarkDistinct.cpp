@@ -16,9 +16,12 @@
 
 #include "velox/exec/MarkDistinct.h"
 #include "velox/common/base/Range.h"
+#include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/vector/FlatVector.h"
 
 #include <algorithm>
+#include <numeric>
 #include <utility>
 
 namespace facebook::velox::exec {
@@ -32,20 +35,31 @@ MarkDistinct::MarkDistinct(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "MarkDistinct") {
-  const auto& inputType = planNode->sources()[0]->outputType();
-
+          "MarkDistinct",
+          planNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      inputType_(planNode->sources()[0]->outputType()) {
   // Set all input columns as identity projection.
-  for (auto i = 0; i < inputType->size(); ++i) {
+  for (auto i = 0; i < inputType_->size(); ++i) {
     identityProjections_.emplace_back(i, i);
   }
 
   // We will use result[0] for distinct mask output.
-  resultProjections_.emplace_back(0, inputType->size());
+  resultProjections_.emplace_back(0, inputType_->size());
+
+  std::vector<std::string> keyNames;
+  std::vector<TypePtr> keyTypes;
+  for (const auto& key : planNode->distinctKeys()) {
+    keyChannels_.push_back(exprToChannel(key.get(), inputType_));
+    keyNames.push_back(key->name());
+    keyTypes.push_back(key->type());
+  }
+  keysType_ = ROW(std::move(keyNames), std::move(keyTypes));
 
   groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
+      inputType_,
+      createVectorHashers(inputType_, planNode->distinctKeys()),
       operatorCtx_.get(),
       &nonReclaimableSection_);
 
@@ -53,17 +67,20 @@ MarkDistinct::MarkDistinct(
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  ensureInputFits(input);
 
-  input_ = std::move(input);
+  if (hasSpilled()) {
+    spillByPartition(*inputSpiller_, *spillHashFunction_, input, pool());
+    return;
+  }
+
+  markDistinct(std::move(input));
 }
 
-RowVectorPtr MarkDistinct::getOutput() {
-  if (isFinished() || !input_) {
-    return nullptr;
-  }
+void MarkDistinct::markDistinct(RowVectorPtr input) {
+  groupingSet_->addInput(input, false /*mayPushdown*/);
 
-  auto outputSize = input_->size();
+  const auto outputSize = input->size();
   // Re-use memory for the ID vector if possible.
   VectorPtr& result = results_[0];
   if (result && result.unique()) {
@@ -82,7 +99,36 @@ RowVectorPtr MarkDistinct::getOutput() {
   for (const auto i : groupingSet_->hashLookup().newGroups) {
     bits::setBit(resultBits, i, true);
   }
-  auto output = fillOutput(outputSize, nullptr);
+
+  input_ = std::move(input);
+}
+
+void MarkDistinct::noMoreInput() {
+  Operator::noMoreInput();
+
+  if (hasSpilled()) {
+    inputSpiller_->finishSpill(spillInputPartitionSet_);
+    removeEmptyPartitions(spillInputPartitionSet_);
+    restoreNextSpillPartition();
+  }
+}
+
+RowVectorPtr MarkDistinct::getOutput() {
+  if (input_ == nullptr) {
+    if (spillInputReader_ == nullptr) {
+      return nullptr;
+    }
+
+    RowVectorPtr spilledInput;
+    if (!spillInputReader_->nextBatch(spilledInput)) {
+      spillInputReader_ = nullptr;
+      restoreNextSpillPartition();
+      return nullptr;
+    }
+    markDistinct(std::move(spilledInput));
+  }
+
+  auto output = fillOutput(input_->size(), nullptr);
 
   // Drop reference to input_ to make it singly-referenced at the producer and
   // allow for memory reuse.
@@ -92,6 +138,158 @@ RowVectorPtr MarkDistinct::getOutput() {
 }
 
 bool MarkDistinct::isFinished() {
-  return noMoreInput_ && !input_;
+  return noMoreInput_ && !input_ && spillInputReader_ == nullptr;
+}
+
+void MarkDistinct::ensureInputFits(const RowVectorPtr& input) {
+  if (!spillEnabled() || hasSpilled()) {
+    return;
+  }
+
+  const auto numDistinct = groupingSet_->numDistinct();
+  if (numDistinct == 0) {
+    // Table is empty. Nothing to spill.
+    return;
+  }
+
+  // Test-only spill path.
+  if (testingTriggerSpill(pool()->name())) {
+    Operator::ReclaimableSectionGuard guard(this);
+    memory::testingRunArbitration(pool());
+    return;
+  }
+
+  const auto currentUsage = pool()->usedBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig_->minSpillableReservationPct / 100;
+  if (pool()->availableReservation() >= minReservationBytes) {
+    return;
+  }
+
+  // Check if we can increase reservation. The increment is the largest of twice
+  // the estimated increment from this input and
+  // 'spillableReservationGrowthPct_' of the current memory usage.
+  const auto bytesPerRow = groupingSet_->allocatedBytes() / numDistinct;
+  const auto targetIncrementBytes = std::max<int64_t>(
+      bytesPerRow * input->size() * 2,
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  {
+    Operator::ReclaimableSectionGuard guard(this);
+    if (pool()->maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
+               << " for memory pool " << pool()->name()
+               << ", usage: " << succinctBytes(pool()->usedBytes())
+               << ", reservation: " << succinctBytes(pool()->reservedBytes());
+}
+
+void MarkDistinct::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (noMoreInput_) {
+    LOG(WARNING) << "Can't reclaim from mark distinct operator which has "
+                 << "received all the input, memory usage: "
+                 << succinctBytes(pool()->usedBytes())
+                 << ", reservation: " << succinctBytes(pool()->reservedBytes());
+    return;
+  }
+
+  if (hasSpilled() || groupingSet_->numDistinct() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  spill();
+}
+
+void MarkDistinct::spill() {
+  VELOX_CHECK(spillEnabled());
+  VELOX_CHECK(!hasSpilled());
+
+  const auto& spillConfig = spillConfig_.value();
+  const HashBitRange spillPartitionBits(
+      spillConfig.startPartitionBit,
+      spillConfig.startPartitionBit + spillConfig.numPartitionBits);
+  SpillPartitionNumSet spillPartitions;
+  for (auto i = 0; i < spillPartitionBits.numPartitions(); ++i) {
+    spillPartitions.insert(i);
+  }
+
+  auto keysSpiller = std::make_unique<Spiller>(
+      Spiller::Type::kPartitionedInput,
+      keysType_,
+      spillPartitionBits,
+      &spillConfig,
+      &spillStats_);
+  keysSpiller->setPartitionsSpilled(spillPartitions);
+
+  std::vector<column_index_t> keysChannels(keysType_->size());
+  std::iota(keysChannels.begin(), keysChannels.end(), 0);
+  HashPartitionFunction keysHashFunction(
+      spillPartitionBits, keysType_, keysChannels);
+
+  auto* spillPool = memory::spillMemoryPool();
+  RowContainerIterator iterator;
+  for (;;) {
+    auto keys = BaseVector::create<RowVector>(keysType_, 0, spillPool);
+    if (!groupingSet_->getDistinctKeys(outputBatchRows(), iterator, keys)) {
+      break;
+    }
+    spillByPartition(*keysSpiller, keysHashFunction, keys, spillPool);
+  }
+  keysSpiller->finishSpill(spillKeysPartitionSet_);
+
+  groupingSet_->resetTable();
+  pool()->release();
+
+  inputSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kPartitionedInput,
+      inputType_,
+      spillPartitionBits,
+      &spillConfig,
+      &spillStats_);
+  inputSpiller_->setPartitionsSpilled(spillPartitions);
+  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      inputSpiller_->hashBits(), inputType_, keyChannels_);
+}
+
+void MarkDistinct::restoreNextSpillPartition() {
+  if (spillInputPartitionSet_.empty()) {
+    return;
+  }
+
+  groupingSet_->resetTable();
+
+  auto it = spillInputPartitionSet_.begin();
+  auto keysIt = spillKeysPartitionSet_.find(it->first);
+  if (keysIt != spillKeysPartitionSet_.end()) {
+    auto keysReader = keysIt->second->createUnorderedReader(
+        spillConfig_->readBufferSize, pool(), &spillStats_);
+
+    RowVectorPtr keys;
+    while (keysReader->nextBatch(keys)) {
+      // 'keys' contains the distinct keys only. Transform 'keys' to match
+      // 'inputType_' so it can be added to 'groupingSet_'. Move the key
+      // columns and leave other columns unset.
+      std::vector<VectorPtr> columns(inputType_->size());
+      for (auto i = 0; i < keyChannels_.size(); ++i) {
+        columns[keyChannels_[i]] = keys->childAt(i);
+      }
+      auto input = std::make_shared<RowVector>(
+          pool(), inputType_, nullptr, keys->size(), std::move(columns));
+      groupingSet_->addInput(input, false /*mayPushdown*/);
+    }
+    spillKeysPartitionSet_.erase(keysIt);
+  }
+
+  spillInputReader_ = it->second->createUnorderedReader(
+      spillConfig_->readBufferSize, pool(), &spillStats_);
+  spillInputPartitionSet_.erase(it);
 }
 } // namespace facebook::velox::exec
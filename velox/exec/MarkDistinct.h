@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -28,8 +29,10 @@ class MarkDistinct : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
+  /// The rows of the spilled partitions are output after all the in-memory
+  /// rows, so the input order is only preserved if spilling is disabled.
   bool preservesOrder() const override {
-    return true;
+    return !spillEnabled();
   }
 
   bool needsInput() const override {
@@ -38,6 +41,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +51,58 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  /// Spills the distinct keys and all subsequent input by partition. Spilling
+  /// is only supported while receiving input. Once all input is received,
+  /// including while restoring the spilled partitions, this is a no-op.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  bool hasSpilled() const {
+    return inputSpiller_ != nullptr;
+  }
+
+  // Adds 'input' to 'groupingSet_', sets the distinct markers of its rows in
+  // 'results_' and holds it in 'input_' for output.
+  void markDistinct(RowVectorPtr input);
+
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills the distinct keys in 'groupingSet_' by hash partition, clears the
+  // hash table and sets up 'inputSpiller_' to spill all the subsequent input.
+  void spill();
+
+  // Loads the spilled keys of the next spilled input partition into
+  // 'groupingSet_' and sets 'spillInputReader_' to read its spilled input.
+  // No-op if there are no more spilled partitions.
+  void restoreNextSpillPartition();
+
+  const RowTypePtr inputType_;
+
+  // Channels of the distinct keys in the input.
+  std::vector<column_index_t> keyChannels_;
+
+  // Type of the spilled distinct keys.
+  RowTypePtr keysType_;
+
   std::unique_ptr<GroupingSet> groupingSet_;
+
+  // Spilled distinct keys seen before spilling was triggered.
+  SpillPartitionSet spillKeysPartitionSet_;
+
+  // Spiller for input received after spilling has been triggered.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Used to calculate the spill partition numbers of the inputs.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Used to restore the spilled input of the partition being restored.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
 };
 } // namespace facebook::velox::exec
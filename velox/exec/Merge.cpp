@@ -37,7 +37,9 @@ Merge::Merge(
           operatorId,
           planNodeId,
           operatorType),
-      outputBatchSize_{outputBatchRows()} {
+      outputBatchSize_{outputBatchRows()},
+      readAheadBatches_{
+          driverCtx->queryConfig().mergeSourceReadAheadBatches()} {
   auto numKeys = sortingKeys.size();
   sortingKeys_.reserve(numKeys);
   for (int i = 0; i < numKeys; ++i) {
@@ -60,7 +62,7 @@ void Merge::initializeTreeOfLosers() {
   sourceCursors.reserve(sources_.size());
   for (auto& source : sources_) {
     sourceCursors.push_back(std::make_unique<SourceStream>(
-        source.get(), sortingKeys_, outputBatchSize_));
+        source.get(), sortingKeys_, outputBatchSize_, readAheadBatches_));
   }
 
   // Save the pointers to cursors before moving these into the TreeOfLosers.
@@ -105,6 +107,11 @@ BlockingReason Merge::isBlocked(ContinueFuture* future) {
     return BlockingReason::kWaitForProducer;
   }
 
+  // Collect the batches the sources produced meanwhile, so that the merge
+  // doesn't wait for them when it runs out of the current batches.
+  for (auto& cursor : streams_) {
+    cursor->readAhead();
+  }
   return BlockingReason::kNotBlocked;
 }
 
@@ -140,7 +147,7 @@ RowVectorPtr Merge::getOutput() {
   }
 
   for (;;) {
-    auto stream = treeOfLosers_->next();
+    auto [stream, runnerUp] = treeOfLosers_->nextWithRunnerUp();
 
     if (!stream) {
       finished_ = true;
@@ -154,16 +161,20 @@ RowVectorPtr Merge::getOutput() {
       return std::move(output_);
     }
 
-    if (stream->setOutputRow(outputSize_)) {
+    // Take the consecutive rows of the winning stream which sort before the
+    // runner-up at once.
+    const auto numRows =
+        stream->numRunRows(runnerUp, outputBatchSize_ - outputSize_);
+    if (stream->setOutputRows(outputSize_, numRows)) {
       // The stream is at end of input batch. Need to copy out the rows before
       // fetching next batch in 'pop'.
       stream->copyToOutput(output_);
     }
 
-    ++outputSize_;
+    outputSize_ += numRows;
 
     // Advance the stream.
-    stream->pop(sourceBlockingFutures_);
+    stream->pop(numRows, sourceBlockingFutures_);
 
     if (outputSize_ == outputBatchSize_) {
       // Copy out data from all sources.
@@ -188,26 +199,46 @@ void Merge::close() {
 }
 
 bool SourceStream::operator<(const MergeStream& other) const {
-  const auto& otherCursor = static_cast<const SourceStream&>(other);
+  return compareAt(currentSourceRow_, static_cast<const SourceStream&>(other)) <
+      0;
+}
+
+int32_t SourceStream::compareAt(vector_size_t row, const SourceStream& other)
+    const {
   for (auto i = 0; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
     if (auto result = keyColumns_[i]
                           ->compare(
-                              otherCursor.keyColumns_[i],
-                              currentSourceRow_,
-                              otherCursor.currentSourceRow_,
+                              other.keyColumns_[i],
+                              row,
+                              other.currentSourceRow_,
                               compareFlags)
                           .value()) {
-      return result < 0;
+      return result;
     }
   }
-  return false;
+  return 0;
+}
+
+vector_size_t SourceStream::numRunRows(
+    const SourceStream* other,
+    vector_size_t maxRows) const {
+  const auto numRows = std::min(maxRows, data_->size() - currentSourceRow_);
+  if (other == nullptr) {
+    return numRows;
+  }
+  return mergeRunLength(numRows, [&](int32_t row) {
+    return compareAt(currentSourceRow_ + row, *other) <= 0;
+  });
 }
 
-bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
-  ++currentSourceRow_;
+bool SourceStream::pop(
+    vector_size_t numRows,
+    std::vector<ContinueFuture>& futures) {
+  VELOX_DCHECK_LE(currentSourceRow_ + numRows, data_->size());
+  currentSourceRow_ += numRows;
   if (currentSourceRow_ == data_->size()) {
     // Make sure all current data has been copied out.
     VELOX_CHECK(!outputRows_.hasSelections());
@@ -243,28 +274,68 @@ void SourceStream::copyToOutput(RowVectorPtr& output) {
 }
 
 bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
-  ContinueFuture future;
-  auto reason = source_->next(data_, &future);
-  if (reason != BlockingReason::kNotBlocked) {
-    needData_ = true;
-    futures.emplace_back(std::move(future));
-    return true;
+  if (readAheadBuffer_.empty() && !sourceAtEnd_) {
+    if (readAheadFuture_.valid() && !readAheadFuture_.isReady()) {
+      needData_ = true;
+      futures.emplace_back(std::move(readAheadFuture_));
+      return true;
+    }
+    if (!fetchFromSource()) {
+      needData_ = true;
+      futures.emplace_back(std::move(readAheadFuture_));
+      return true;
+    }
   }
 
-  atEnd_ = !data_ || data_->size() == 0;
   needData_ = false;
   currentSourceRow_ = 0;
+  if (readAheadBuffer_.empty()) {
+    atEnd_ = true;
+    data_ = nullptr;
+    return false;
+  }
+
+  data_ = std::move(readAheadBuffer_.front());
+  readAheadBuffer_.pop_front();
+  keyColumns_.clear();
+  for (const auto& key : sortingKeys_) {
+    keyColumns_.push_back(data_->childAt(key.first).get());
+  }
+  readAhead();
+  return false;
+}
 
-  if (!atEnd_) {
-    for (auto& child : data_->children()) {
-      child = BaseVector::loadedVectorShared(child);
+void SourceStream::readAhead() {
+  while (readAheadBuffer_.size() < readAheadBatches_ && !sourceAtEnd_) {
+    if (readAheadFuture_.valid() && !readAheadFuture_.isReady()) {
+      return;
     }
-    keyColumns_.clear();
-    for (const auto& key : sortingKeys_) {
-      keyColumns_.push_back(data_->childAt(key.first).get());
+    if (!fetchFromSource()) {
+      return;
     }
   }
-  return false;
+}
+
+bool SourceStream::fetchFromSource() {
+  readAheadFuture_ = ContinueFuture::makeEmpty();
+  RowVectorPtr data;
+  ContinueFuture future;
+  auto reason = source_->next(data, &future);
+  if (reason != BlockingReason::kNotBlocked) {
+    readAheadFuture_ = std::move(future);
+    return false;
+  }
+
+  if (!data || data->size() == 0) {
+    sourceAtEnd_ = true;
+    return true;
+  }
+
+  for (auto& child : data->children()) {
+    child = BaseVector::loadedVectorShared(child);
+  }
+  readAheadBuffer_.push_back(std::move(data));
+  return true;
 }
 
 LocalMerge::LocalMerge(
@@ -304,7 +375,9 @@ MergeExchange::MergeExchange(
           mergeExchangeNode->sortingKeys(),
           mergeExchangeNode->sortingOrders(),
           mergeExchangeNode->id(),
-          "MergeExchange") {}
+          "MergeExchange"),
+      serde_(getNamedOrDefaultVectorSerde(
+          driverCtx->queryConfig().shuffleSerde())) {}
 
 BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   if (operatorCtx_->driverCtx()->driverId != 0) {
@@ -350,7 +423,10 @@ BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
                 operatorCtx_->task()->destination(),
                 maxQueuedBytesPerSource,
                 pool,
-                operatorCtx_->task()->queryCtx()->executor()));
+                operatorCtx_->task()->queryCtx()->executor(),
+                operatorCtx_->driverCtx()
+                    ->queryConfig()
+                    .mergeExchangeParallelDecode()));
           }
         }
         // TODO Delay this call until all input data has been processed.
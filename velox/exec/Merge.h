@@ -25,7 +25,9 @@ class SourceStream;
 
 // Merge operator Implementation: This implementation uses priority queue
 // to perform a k-way merge of its inputs. It stops merging if any one of
-// its inputs is blocked.
+// its inputs is blocked. Each input fetches up to
+// QueryConfig::kMergeSourceReadAheadBatches batches ahead without blocking to
+// hide the latency of slow sources.
 class Merge : public SourceOperator {
  public:
   Merge(
@@ -61,6 +63,9 @@ class Merge : public SourceOperator {
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
+  /// Number of batches each stream fetches ahead from its source.
+  const uint32_t readAheadBatches_;
+
   std::vector<std::pair<column_index_t, CompareFlags>> sortingKeys_;
 
   /// A list of cursors over batches of ordered source data. One per source.
@@ -87,9 +92,11 @@ class SourceStream final : public MergeStream {
   SourceStream(
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
-      uint32_t outputBatchSize)
+      uint32_t outputBatchSize,
+      uint32_t readAheadBatches = 0)
       : source_{source},
         sortingKeys_{sortingKeys},
+        readAheadBatches_{readAheadBatches},
         outputRows_(outputBatchSize, false),
         sourceRows_(outputBatchSize) {
     keyColumns_.reserve(sortingKeys.size());
@@ -112,20 +119,29 @@ class SourceStream final : public MergeStream {
   /// 'other'.
   bool operator<(const MergeStream& other) const override;
 
-  /// Advances to the next row. Returns true and appends a future to 'futures'
-  /// if runs out of rows in the current batch and needs to wait for the
-  /// source to produce the next batch. The return flag has the meaning of
+  /// Returns the number of consecutive rows from the current row in the
+  /// current batch which sort before or equal to the current row of 'other',
+  /// but no more than 'maxRows'. If 'other' is null, returns the number of
+  /// remaining rows in the current batch capped at 'maxRows'. 'other' must be
+  /// the runner-up returned by TreeOfLosers::nextWithRunnerUp() for 'this'.
+  vector_size_t numRunRows(const SourceStream* other, vector_size_t maxRows)
+      const;
+
+  /// Advances by 'numRows' rows. Returns true and appends a future to
+  /// 'futures' if runs out of rows in the current batch and needs to wait for
+  /// the source to produce the next batch. The return flag has the meaning of
   /// 'is-blocked'.
-  bool pop(std::vector<ContinueFuture>& futures);
-
-  /// Records the output row number for the current row. Returns true if
-  /// current row is the last row in the current batch, in which case the
-  /// caller must call 'copyToOutput' before calling pop(). The caller must
-  /// call 'setOutputRow' before calling 'pop'. The output rows must
-  /// monotonically increase in between calls to 'copyToOutput'.
-  bool setOutputRow(vector_size_t row) {
-    outputRows_.setValid(row, true);
-    return currentSourceRow_ == data_->size() - 1;
+  bool pop(vector_size_t numRows, std::vector<ContinueFuture>& futures);
+
+  /// Records the output row numbers starting at 'row' for 'numRows' rows from
+  /// the current row. Returns true if these include the last row in the
+  /// current batch, in which case the caller must call 'copyToOutput' before
+  /// calling pop(). The caller must call 'setOutputRows' before calling 'pop'.
+  /// The output rows must monotonically increase in between calls to
+  /// 'copyToOutput'.
+  bool setOutputRows(vector_size_t row, vector_size_t numRows) {
+    outputRows_.setValidRange(row, row + numRows, true);
+    return currentSourceRow_ + numRows == data_->size();
   }
 
   /// Called if either current row is the last row in the current batch or the
@@ -133,13 +149,37 @@ class SourceStream final : public MergeStream {
   /// output batch.
   void copyToOutput(RowVectorPtr& output);
 
+  /// Fetches the batches the source has ready, up to the read-ahead limit,
+  /// without blocking.
+  void readAhead();
+
  private:
+  // Compares the source row 'row' with the current row of 'other'.
+  int32_t compareAt(vector_size_t row, const SourceStream& other) const;
+
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Fetches the next batch from the source into 'readAheadBuffer_'. Returns
+  // false if the source is blocked, in which case 'readAheadFuture_' is set.
+  bool fetchFromSource();
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
 
+  /// Maximum number of batches in 'readAheadBatches_'.
+  const uint32_t readAheadBatches_;
+
+  /// Batches fetched from the source ahead of 'data_'.
+  std::deque<RowVectorPtr> readAheadBuffer_;
+
+  /// Fulfilled when the source has the next batch after a fetch found it
+  /// blocked. The source is not asked again until then.
+  ContinueFuture readAheadFuture_{ContinueFuture::makeEmpty()};
+
+  /// True if the source has returned its last batch.
+  bool sourceAtEnd_{false};
+
   /// Ordered source rows.
   RowVectorPtr data_;
 
@@ -191,10 +231,17 @@ class MergeExchange : public Merge {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MergeExchangeNode>& orderByNode);
 
+  /// Deserializes the pages of the sources. Set by
+  /// QueryConfig::kShuffleSerde.
+  VectorSerde* serde() const {
+    return serde_;
+  }
+
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
  private:
+  VectorSerde* const serde_;
   bool noMoreSplits_ = false;
   // Task Ids from all the splits we took to process so far.
   std::vector<std::string> remoteSourceTaskIds_;
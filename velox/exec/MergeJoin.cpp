@@ -24,9 +24,90 @@ namespace {
 bool supportsMergeJoin(std::shared_ptr<const core::MergeJoinNode> joinNode) {
   return joinNode->isInnerJoin() || joinNode->isLeftJoin() ||
       joinNode->isLeftSemiFilterJoin() || joinNode->isRightSemiFilterJoin() ||
-      joinNode->isAntiJoin() || joinNode->isRightJoin();
+      joinNode->isAntiJoin() || joinNode->isRightJoin() ||
+      joinNode->isFullJoin();
+}
+
+vector_size_t firstNonNull(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys,
+    vector_size_t start = 0) {
+  for (auto i = start; i < rowVector->size(); ++i) {
+    bool hasNull = false;
+    for (auto key : keys) {
+      if (rowVector->childAt(key)->isNullAt(i)) {
+        hasNull = true;
+        break;
+      }
+    }
+    if (!hasNull) {
+      return i;
+    }
+  }
+
+  return rowVector->size();
+}
+
+bool keysMayHaveNulls(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys) {
+  for (auto key : keys) {
+    if (rowVector->childAt(key)->mayHaveNulls()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the first row at or after 'start' for which 'isBefore' is false.
+// 'isBefore' must be true for a prefix of the rows of 'rowVector' and false
+// for the rest, which holds for comparisons of sorted keys without nulls. In
+// that case probes rows at exponentially growing distances and then binary
+// searches the last step, so that a run of n rows takes O(log(n))
+// comparisons instead of n. Checks the rows one by one if the keys may have
+// nulls.
+template <typename F>
+vector_size_t findFirstNotBefore(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys,
+    vector_size_t start,
+    F isBefore) {
+  const auto end = rowVector->size();
+  if (keysMayHaveNulls(rowVector, keys)) {
+    while (start < end && isBefore(start)) {
+      ++start;
+    }
+    return start;
+  }
+  if (start >= end || !isBefore(start)) {
+    return start;
+  }
+  // 'isBefore' is true at 'low' and false at 'high' or 'high' is 'end'.
+  vector_size_t low = start;
+  vector_size_t high;
+  for (vector_size_t step = 1;; step *= 2) {
+    high = low + step;
+    if (high >= end) {
+      high = end;
+      break;
+    }
+    if (!isBefore(high)) {
+      break;
+    }
+    low = high;
+  }
+  while (high - low > 1) {
+    const auto middle = low + (high - low) / 2;
+    if (isBefore(middle)) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return high;
 }
 } // namespace
+
 MergeJoin::MergeJoin(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -45,6 +126,9 @@ MergeJoin::MergeJoin(
       supportsMergeJoin(joinNode_),
       "The join type is not supported by merge join: ",
       joinTypeName(joinNode_->joinType()));
+  VELOX_USER_CHECK(
+      !joinNode_->isFullJoin() || joinNode_->filter() == nullptr,
+      "Full outer merge join with a filter is not supported yet");
 }
 
 void MergeJoin::initialize() {
@@ -189,6 +273,23 @@ BlockingReason MergeJoin::isBlocked(ContinueFuture* future) {
   return BlockingReason::kNotBlocked;
 }
 
+vector_size_t MergeJoin::firstRightRow(vector_size_t start) const {
+  if (isFullJoin(joinType_)) {
+    // Full join emits right-side rows with null keys as misses.
+    return start;
+  }
+  return firstNonNull(rightInput_, rightKeys_, start);
+}
+
+bool MergeJoin::leftKeyHasNull() const {
+  for (auto key : leftKeys_) {
+    if (input_->childAt(key)->isNullAt(index_)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool MergeJoin::needsInput() const {
   if (isRightJoin(joinType_)) {
     return (input_ == nullptr || rightInput_ == nullptr);
@@ -237,11 +338,9 @@ bool MergeJoin::findEndOfMatch(
 
   auto numInput = input->size();
 
-  vector_size_t endIndex = 0;
-  while (endIndex < numInput &&
-         compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
-    ++endIndex;
-  }
+  const auto endIndex = findFirstNotBefore(input, keys, 0, [&](auto row) {
+    return compare(keys, input, row, keys, prevInput, prevIndex) == 0;
+  });
 
   if (endIndex == numInput) {
     // Inputs are kept past getting a new batch of inputs. LazyVectors
@@ -279,7 +378,9 @@ void copyRow(
 void MergeJoin::addOutputRowForLeftJoin(
     const RowVectorPtr& left,
     vector_size_t leftIndex) {
-  VELOX_USER_CHECK(isLeftJoin(joinType_) || isAntiJoin(joinType_));
+  VELOX_USER_CHECK(
+      isLeftJoin(joinType_) || isAntiJoin(joinType_) ||
+      isFullJoin(joinType_));
   rawLeftIndices_[outputSize_] = leftIndex;
 
   for (const auto& projection : rightProjections_) {
@@ -298,8 +399,14 @@ void MergeJoin::addOutputRowForLeftJoin(
 void MergeJoin::addOutputRowForRightJoin(
     const RowVectorPtr& right,
     vector_size_t rightIndex) {
-  VELOX_USER_CHECK(isRightJoin(joinType_));
-  rawRightIndices_[outputSize_] = rightIndex;
+  VELOX_USER_CHECK(isRightJoin(joinType_) || isFullJoin(joinType_));
+  // In a full join, the right side projections may have been flattened by
+  // preceding matches that spanned more than one right-side vector.
+  if (!isRightFlattened_) {
+    rawRightIndices_[outputSize_] = rightIndex;
+  } else {
+    copyRow(right, rightIndex, output_, outputSize_, rightProjections_);
+  }
 
   for (const auto& projection : leftProjections_) {
     const auto& target = output_->childAt(projection.outputChannel);
@@ -580,28 +687,6 @@ bool MergeJoin::addToOutput() {
   return outputSize_ == outputBatchSize_;
 }
 
-namespace {
-vector_size_t firstNonNull(
-    const RowVectorPtr& rowVector,
-    const std::vector<column_index_t>& keys,
-    vector_size_t start = 0) {
-  for (auto i = start; i < rowVector->size(); ++i) {
-    bool hasNull = false;
-    for (auto key : keys) {
-      if (rowVector->childAt(key)->isNullAt(i)) {
-        hasNull = true;
-        break;
-      }
-    }
-    if (!hasNull) {
-      return i;
-    }
-  }
-
-  return rowVector->size();
-}
-} // namespace
-
 RowVectorPtr MergeJoin::filterOutputForAntiJoin(const RowVectorPtr& output) {
   auto numRows = output->size();
   const auto& filterRows = joinTracker_->matchingRows(numRows);
@@ -674,7 +759,7 @@ RowVectorPtr MergeJoin::getOutput() {
         }
 
         if (rightInput_) {
-          rightIndex_ = firstNonNull(rightInput_, rightKeys_);
+          rightIndex_ = firstRightRow(0);
           if (rightIndex_ == rightInput_->size()) {
             // Ran out of rows on the right side.
             rightInput_ = nullptr;
@@ -733,8 +818,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         return nullptr;
       }
       if (rightMatch_->inputs.back() == rightInput_) {
-        rightIndex_ =
-            firstNonNull(rightInput_, rightKeys_, rightMatch_->endIndex);
+        rightIndex_ = firstRightRow(rightMatch_->endIndex);
         if (rightIndex_ == rightInput_->size()) {
           rightInput_ = nullptr;
         }
@@ -759,6 +843,10 @@ RowVectorPtr MergeJoin::doGetOutput() {
   }
 
   if (!input_ || !rightInput_) {
+    if (isFullJoin(joinType_)) {
+      return drainFullJoin();
+    }
+
     if (isLeftJoin(joinType_) || isAntiJoin(joinType_)) {
       if (input_ && noMoreRightInput_) {
         // If output_ is currently wrapping a different buffer, return it
@@ -835,7 +923,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
   for (;;) {
     // Catch up input_ with rightInput_.
     while (compareResult < 0) {
-      if (isLeftJoin(joinType_) || isAntiJoin(joinType_)) {
+      if (isLeftJoin(joinType_) || isAntiJoin(joinType_) ||
+          isFullJoin(joinType_)) {
         // If output_ is currently wrapping a different buffer, return it
         // first.
         if (prepareOutput(input_, nullptr)) {
@@ -848,6 +937,19 @@ RowVectorPtr MergeJoin::doGetOutput() {
         }
         addOutputRowForLeftJoin(input_, index_);
         ++index_;
+      } else if (!keysMayHaveNulls(input_, leftKeys_)) {
+        // Skips the rows with keys below the right side row at once. There
+        // may be many when matches are sparse.
+        index_ = findFirstNotBefore(
+            input_, leftKeys_, index_ + 1, [&](auto row) {
+              return compare(
+                         leftKeys_,
+                         input_,
+                         row,
+                         rightKeys_,
+                         rightInput_,
+                         rightIndex_) < 0;
+            });
       } else {
         index_ = firstNonNull(input_, leftKeys_, index_ + 1);
       }
@@ -862,7 +964,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     // Catch up rightInput_ with input_.
     while (compareResult > 0) {
-      if (isRightJoin(joinType_)) {
+      if (isRightJoin(joinType_) || isFullJoin(joinType_)) {
         // If output_ is currently wrapping a different buffer, return it
         // first.
         if (prepareOutput(nullptr, rightInput_)) {
@@ -876,6 +978,17 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
         addOutputRowForRightJoin(rightInput_, rightIndex_);
         ++rightIndex_;
+      } else if (!keysMayHaveNulls(rightInput_, rightKeys_)) {
+        rightIndex_ = findFirstNotBefore(
+            rightInput_, rightKeys_, rightIndex_ + 1, [&](auto row) {
+              return compare(
+                         leftKeys_,
+                         input_,
+                         index_,
+                         rightKeys_,
+                         rightInput_,
+                         row) > 0;
+            });
       } else {
         rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
       }
@@ -888,13 +1001,20 @@ RowVectorPtr MergeJoin::doGetOutput() {
       compareResult = compare();
     }
 
+    if (compareResult == 0 && isFullJoin(joinType_) && leftKeyHasNull()) {
+      // Null keys never match. Emit the left-side row as a miss. Right-side
+      // rows with null keys are emitted once the left side moves past them.
+      compareResult = -1;
+      continue;
+    }
+
     if (compareResult == 0) {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
-      vector_size_t endIndex = index_ + 1;
-      while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
-        ++endIndex;
-      }
+      const auto endIndex = findFirstNotBefore(
+          input_, leftKeys_, index_ + 1, [&](auto row) {
+            return compareLeft(row) == 0;
+          });
 
       if (endIndex == input_->size()) {
         // Matches continue in subsequent input. Load all lazies.
@@ -903,11 +1023,10 @@ RowVectorPtr MergeJoin::doGetOutput() {
       leftMatch_ = Match{
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
-      vector_size_t endRightIndex = rightIndex_ + 1;
-      while (endRightIndex < rightInput_->size() &&
-             compareRight(endRightIndex) == 0) {
-        ++endRightIndex;
-      }
+      const auto endRightIndex = findFirstNotBefore(
+          rightInput_, rightKeys_, rightIndex_ + 1, [&](auto row) {
+            return compareRight(row) == 0;
+          });
 
       rightMatch_ = Match{
           {rightInput_},
@@ -930,7 +1049,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
       }
 
       index_ = endIndex;
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, endRightIndex);
+      rightIndex_ = firstRightRow(endRightIndex);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -951,6 +1070,56 @@ RowVectorPtr MergeJoin::doGetOutput() {
   VELOX_UNREACHABLE();
 }
 
+RowVectorPtr MergeJoin::drainFullJoin() {
+  if (input_ && noMoreRightInput_) {
+    // If output_ is currently wrapping a different buffer, return it first.
+    if (prepareOutput(input_, nullptr)) {
+      output_->resize(outputSize_);
+      return std::move(output_);
+    }
+    while (true) {
+      if (outputSize_ == outputBatchSize_) {
+        return std::move(output_);
+      }
+      addOutputRowForLeftJoin(input_, index_);
+
+      ++index_;
+      if (index_ == input_->size()) {
+        // Ran out of rows on the left side.
+        input_ = nullptr;
+        return nullptr;
+      }
+    }
+  }
+
+  if (rightInput_ && noMoreInput_) {
+    // If output_ is currently wrapping a different buffer, return it first.
+    if (prepareOutput(nullptr, rightInput_)) {
+      output_->resize(outputSize_);
+      return std::move(output_);
+    }
+    while (true) {
+      if (outputSize_ == outputBatchSize_) {
+        return std::move(output_);
+      }
+      addOutputRowForRightJoin(rightInput_, rightIndex_);
+
+      ++rightIndex_;
+      if (rightIndex_ == rightInput_->size()) {
+        // Ran out of rows on the right side.
+        rightInput_ = nullptr;
+        return nullptr;
+      }
+    }
+  }
+
+  if (noMoreInput_ && noMoreRightInput_ && output_) {
+    output_->resize(outputSize_);
+    return std::move(output_);
+  }
+  return nullptr;
+}
+
 RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
   const auto numRows = output->size();
 
@@ -1075,6 +1244,12 @@ bool MergeJoin::isFinished() {
     // complete.
     return noMoreInput_ && noMoreRightInput_ && rightInput_ == nullptr;
   }
+  if (isFullJoin(joinType_)) {
+    // Unmatched rows from both sides may still be buffered in 'output_' after
+    // both inputs are exhausted.
+    return noMoreInput_ && noMoreRightInput_ && input_ == nullptr &&
+        rightInput_ == nullptr && output_ == nullptr;
+  }
   return noMoreInput_ && input_ == nullptr;
 }
 
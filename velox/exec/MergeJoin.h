@@ -32,6 +32,10 @@ namespace facebook::velox::exec {
 /// output for a particular key match is produced, the respective batches are
 /// discarded.
 ///
+/// Full outer join is streamed as well: unmatched rows from either side are
+/// emitted as soon as the merge moves past them, so memory usage doesn't depend
+/// on the size of the inputs.
+///
 /// Output is produced outputBatchSize_ rows at a time.
 ///
 /// The merge join operator generally returns dictionaries which are wrapped
@@ -162,6 +166,19 @@ class MergeJoin : public Operator {
     }
   };
 
+  // Returns the first row on the right side at or after 'start' to compare
+  // with the left side. Rows with null keys can't match and are skipped,
+  // except for full join which needs to emit them as misses.
+  vector_size_t firstRightRow(vector_size_t start) const;
+
+  // Returns true if any of the join keys of the index_ row on the left is null.
+  bool leftKeyHasNull() const;
+
+  // Produces output for full join once either side ran out of input: emits
+  // unmatched rows remaining on the other side and flushes 'output_' once both
+  // sides are exhausted.
+  RowVectorPtr drainFullJoin();
+
   /// Given a partial set of rows with matching keys (match) finds all rows from
   /// the start of the 'input' batch that also have matching keys. Updates
   /// 'match' to include the newly identified rows. Returns true if found the
@@ -217,7 +234,7 @@ class MergeJoin : public Operator {
 
   /// Adds one row of output for a right-side row with no left-side match.
   /// Copies values from the 'rightIndex' row of 'right' and fills in nulls
-  /// for columns that correspond to the right side.
+  /// for columns that correspond to the left side.
   void addOutputRowForRightJoin(
       const RowVectorPtr& right,
       vector_size_t rightIndex);
@@ -17,6 +17,10 @@
 #include "velox/exec/MergeSource.h"
 
 #include <boost/circular_buffer.hpp>
+
+#include <condition_variable>
+#include <deque>
+
 #include "velox/exec/Merge.h"
 #include "velox/vector/VectorStream.h"
 
@@ -122,8 +126,11 @@ class MergeExchangeSource : public MergeSource {
       int destination,
       int64_t maxQueuedBytes,
       memory::MemoryPool* pool,
-      folly::Executor* executor)
+      folly::Executor* executor,
+      bool parallelDecode)
       : mergeExchange_(mergeExchange),
+        pool_(pool),
+        executor_(parallelDecode ? executor : nullptr),
         client_(std::make_shared<ExchangeClient>(
             mergeExchange->taskId(),
             destination,
@@ -134,7 +141,14 @@ class MergeExchangeSource : public MergeSource {
     client_->noMoreRemoteTasks();
   }
 
+  ~MergeExchangeSource() override {
+    waitForDecode();
+  }
+
   BlockingReason next(RowVectorPtr& data, ContinueFuture* future) override {
+    if (executor_ != nullptr) {
+      return nextDecoded(data, future);
+    }
     data.reset();
 
     if (atEnd_ && !currentPage_) {
@@ -163,7 +177,9 @@ class MergeExchangeSource : public MergeSource {
           &inputStream_.value(),
           mergeExchange_->pool(),
           mergeExchange_->outputType(),
-          &data);
+          &data,
+          nullptr,
+          mergeExchange_->serde());
 
       auto lockedStats = mergeExchange_->stats().wlock();
       lockedStats->addInputVector(data->estimateFlatSize(), data->size());
@@ -182,6 +198,7 @@ class MergeExchangeSource : public MergeSource {
   }
 
   void close() override {
+    waitForDecode();
     if (client_) {
       client_->close();
       client_ = nullptr;
@@ -189,10 +206,134 @@ class MergeExchangeSource : public MergeSource {
   }
 
  private:
+  // Returns the next vector decoded on 'executor_'. Takes the next page
+  // from the exchange client on the driver thread and hands it to
+  // 'executor_', which decodes the whole page while the merge works on the
+  // vectors of the previous page.
+  BlockingReason nextDecoded(RowVectorPtr& data, ContinueFuture* future) {
+    data.reset();
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (decodeError_) {
+        std::rethrow_exception(decodeError_);
+      }
+      if (!decoded_.empty()) {
+        data = std::move(decoded_.front());
+        decoded_.pop_front();
+      } else if (decoding_) {
+        decodePromises_.emplace_back("MergeExchangeSource::nextDecoded");
+        *future = decodePromises_.back().getSemiFuture();
+        return BlockingReason::kWaitForProducer;
+      }
+    }
+    if (data != nullptr) {
+      // Starts decoding the next page, if any has arrived, while the merge
+      // consumes 'data'.
+      if (!atEnd_) {
+        ContinueFuture ignored;
+        maybeStartDecode(&ignored);
+      }
+      return BlockingReason::kNotBlocked;
+    }
+    if (atEnd_) {
+      return BlockingReason::kNotBlocked;
+    }
+    if (!maybeStartDecode(future)) {
+      return atEnd_ ? BlockingReason::kNotBlocked
+                    : BlockingReason::kWaitForProducer;
+    }
+    return nextDecoded(data, future);
+  }
+
+  // Takes the next page from the exchange client and schedules its
+  // decoding unless decoded vectors or a page being decoded are pending.
+  // Returns false and sets 'future' if nothing is pending and there is no
+  // page.
+  bool maybeStartDecode(ContinueFuture* future) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (decoding_ || !decoded_.empty()) {
+        return true;
+      }
+    }
+    auto pages = client_->next(1, &atEnd_, future);
+    VELOX_CHECK_LE(pages.size(), 1);
+    if (pages.empty()) {
+      return false;
+    }
+    mergeExchange_->stats().wlock()->rawInputBytes += pages[0]->size();
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      decoding_ = true;
+    }
+    executor_->add([this, page = std::shared_ptr<SerializedPage>(
+                              std::move(pages[0]))]() { decode(*page); });
+    return true;
+  }
+
+  // Runs on 'executor_'. Decodes all vectors of 'page' into 'pool_'.
+  void decode(SerializedPage& page) {
+    std::deque<RowVectorPtr> vectors;
+    std::exception_ptr error;
+    try {
+      auto inputStream = page.prepareStreamForDeserialize();
+      while (!inputStream.atEnd()) {
+        RowVectorPtr data;
+        VectorStreamGroup::read(
+            &inputStream,
+            pool_,
+            mergeExchange_->outputType(),
+            &data,
+            nullptr,
+            mergeExchange_->serde());
+        auto lockedStats = mergeExchange_->stats().wlock();
+        lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+        lockedStats->rawInputPositions += data->size();
+        vectors.push_back(std::move(data));
+      }
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+
+    std::vector<ContinuePromise> promises;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      for (auto& vector : vectors) {
+        decoded_.push_back(std::move(vector));
+      }
+      decodeError_ = error;
+      decoding_ = false;
+      promises = std::move(decodePromises_);
+      decodeDone_.notify_all();
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  }
+
+  // Waits for the decoding in progress, if any, so that it does not outlive
+  // 'this' or the operator.
+  void waitForDecode() {
+    std::unique_lock<std::mutex> l(mutex_);
+    decodeDone_.wait(l, [&]() { return !decoding_; });
+  }
+
   MergeExchange* const mergeExchange_;
+  memory::MemoryPool* const pool_;
+  // Set if pages are decoded in parallel with the merge.
+  folly::Executor* const executor_;
   std::shared_ptr<ExchangeClient> client_;
   std::optional<ByteInputStream> inputStream_;
   std::unique_ptr<SerializedPage> currentPage_;
+
+  // Serializes access to the decoding state below between the driver thread
+  // and 'executor_'.
+  std::mutex mutex_;
+  std::condition_variable decodeDone_;
+  bool decoding_{false};
+  std::deque<RowVectorPtr> decoded_;
+  std::exception_ptr decodeError_;
+  std::vector<ContinuePromise> decodePromises_;
   bool atEnd_ = false;
 
   BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future) override {
@@ -214,9 +355,16 @@ std::shared_ptr<MergeSource> MergeSource::createMergeExchangeSource(
     int destination,
     int64_t maxQueuedBytes,
     memory::MemoryPool* pool,
-    folly::Executor* executor) {
+    folly::Executor* executor,
+    bool parallelDecode) {
   return std::make_shared<MergeExchangeSource>(
-      mergeExchange, taskId, destination, maxQueuedBytes, pool, executor);
+      mergeExchange,
+      taskId,
+      destination,
+      maxQueuedBytes,
+      pool,
+      executor,
+      parallelDecode);
 }
 
 namespace {
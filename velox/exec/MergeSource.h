@@ -45,7 +45,8 @@ class MergeSource {
       int destination,
       int64_t maxQueuedBytes,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      bool parallelDecode = false);
 };
 
 /// Coordinates data transfer between single producer and single consumer. Used
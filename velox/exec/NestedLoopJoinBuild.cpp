@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/Task.h"
+#include "velox/vector/VectorMap.h"
 
 namespace facebook::velox::exec {
 
@@ -29,6 +31,26 @@ void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
   notify(std::move(promises));
 }
 
+void NestedLoopJoinBridge::setSpilledData(
+    std::unique_ptr<SpillPartition> spillPartition) {
+  VELOX_CHECK_NOT_NULL(spillPartition);
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!buildVectors_.has_value(), "setData must be called only once");
+    buildVectors_ = std::vector<RowVectorPtr>{};
+    spillPartition_ = std::move(spillPartition);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+std::shared_ptr<const SpillPartition> NestedLoopJoinBridge::spillPartition() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(buildVectors_.has_value());
+  return spillPartition_;
+}
+
 std::optional<std::vector<RowVectorPtr>> NestedLoopJoinBridge::dataOrFuture(
     ContinueFuture* future) {
   std::lock_guard<std::mutex> l(mutex_);
@@ -50,16 +72,85 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      buildType_(joinNode->sources()[1]->outputType()),
+      dictionaryStringsPct_(
+          driverCtx->queryConfig().nestedLoopJoinBuildDictionaryStringsPct()) {
+}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
-  if (input->size() > 0) {
-    // Load lazy vectors before storing.
-    for (auto& child : input->children()) {
-      child->loadedVector();
+  if (input->size() == 0) {
+    return;
+  }
+  // Load lazy vectors before storing.
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  if (spiller_ != nullptr) {
+    spiller_->spill(0, input);
+    return;
+  }
+  if (dictionaryStringsPct_ > 0) {
+    std::vector<VectorPtr> children = input->children();
+    for (auto& child : children) {
+      child = dictionaryEncodeStrings(child, dictionaryStringsPct_, pool());
     }
-    dataVectors_.emplace_back(std::move(input));
+    input = std::make_shared<RowVector>(
+        pool(), input->type(), input->nulls(), input->size(), children);
+  }
+  dataVectorsBytes_ += input->retainedSize();
+  dataVectors_.emplace_back(std::move(input));
+
+  // Test-only spill path.
+  if (canSpill() && testingTriggerSpill(pool()->name())) {
+    Operator::ReclaimableSectionGuard guard(this);
+    memory::testingRunArbitration(pool());
+  }
+}
+
+bool NestedLoopJoinBuild::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim()) {
+    return false;
+  }
+  if (!noMoreInput_) {
+    reclaimableBytes = dataVectorsBytes_;
+  }
+  return true;
+}
+
+void NestedLoopJoinBuild::reclaim(
+    uint64_t /*unused*/,
+    memory::MemoryReclaimer::Stats& /*unused*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  // NOTE: the build side data is handed over to the last build driver on no
+  // more input, so it is only reclaimable before that.
+  if (noMoreInput_ || dataVectors_.empty()) {
+    return;
   }
+  spill();
+}
+
+void NestedLoopJoinBuild::spill() {
+  VELOX_CHECK(canSpill());
+  if (spiller_ == nullptr) {
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kNestedLoopJoinBuild,
+        buildType_,
+        &spillConfig_.value(),
+        &spillStats_);
+  }
+  for (const auto& vector : dataVectors_) {
+    spiller_->spill(0, vector);
+  }
+  dataVectors_.clear();
+  dataVectorsBytes_ = 0;
+  pool()->release();
 }
 
 BlockingReason NestedLoopJoinBuild::isBlocked(ContinueFuture* future) {
@@ -84,6 +175,7 @@ void NestedLoopJoinBuild::noMoreInput() {
     return;
   }
 
+  std::unique_ptr<SpillPartition> spillPartition;
   {
     auto promisesGuard = folly::makeGuard([&]() {
       // Realize the promises so that the other Drivers (which were not
@@ -94,21 +186,49 @@ void NestedLoopJoinBuild::noMoreInput() {
       }
     });
 
+    std::vector<NestedLoopJoinBuild*> builds;
+    builds.reserve(peers.size());
+    bool spilled = spiller_ != nullptr;
     for (auto& peer : peers) {
       auto op = peer->findOperator(planNodeId());
       auto* build = dynamic_cast<NestedLoopJoinBuild*>(op);
       VELOX_CHECK_NOT_NULL(build);
-      dataVectors_.insert(
-          dataVectors_.begin(),
-          build->dataVectors_.begin(),
-          build->dataVectors_.end());
+      builds.push_back(build);
+      spilled |= build->spiller_ != nullptr;
+    }
+
+    if (!spilled) {
+      for (auto* build : builds) {
+        dataVectors_.insert(
+            dataVectors_.begin(),
+            build->dataVectors_.begin(),
+            build->dataVectors_.end());
+      }
+    } else {
+      // Spill the build vectors still in memory too, so that the probe side
+      // only needs to keep one block of the build side data in memory.
+      builds.push_back(this);
+      SpillPartitionSet spillPartitionSet;
+      for (auto* build : builds) {
+        if (!build->dataVectors_.empty()) {
+          build->spill();
+        }
+        if (build->spiller_ != nullptr) {
+          build->spiller_->finishSpill(spillPartitionSet);
+        }
+      }
+      VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+      spillPartition = std::move(spillPartitionSet.begin()->second);
     }
   }
 
-  operatorCtx_->task()
-      ->getNestedLoopJoinBridge(
-          operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-      ->setData(std::move(dataVectors_));
+  auto bridge = operatorCtx_->task()->getNestedLoopJoinBridge(
+      operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  if (spillPartition != nullptr) {
+    bridge->setSpilledData(std::move(spillPartition));
+  } else {
+    bridge->setData(std::move(dataVectors_));
+  }
 }
 
 bool NestedLoopJoinBuild::isFinished() {
@@ -17,6 +17,7 @@
 
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -24,10 +25,20 @@ class NestedLoopJoinBridge : public JoinBridge {
  public:
   void setData(std::vector<RowVectorPtr> buildVectors);
 
+  /// Sets the build side data when it has spilled. All the build side vectors
+  /// are in 'spillPartition' and the probe side reads them back one block at a
+  /// time.
+  void setSpilledData(std::unique_ptr<SpillPartition> spillPartition);
+
   std::optional<std::vector<RowVectorPtr>> dataOrFuture(ContinueFuture* future);
 
+  /// Returns the spilled build side data, or null if the build side hasn't
+  /// spilled. Must be called after dataOrFuture() has returned the build data.
+  std::shared_ptr<const SpillPartition> spillPartition();
+
  private:
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  std::shared_ptr<const SpillPartition> spillPartition_;
 };
 
 class NestedLoopJoinBuild : public Operator {
@@ -53,13 +64,36 @@ class NestedLoopJoinBuild : public Operator {
 
   bool isFinished() override;
 
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   void close() override {
     dataVectors_.clear();
+    spiller_.reset();
     Operator::close();
   }
 
  private:
+  // Spills 'dataVectors_' to free up their memory. Once spilled, the new
+  // inputs are spilled as they arrive.
+  void spill();
+
+  const RowTypePtr buildType_;
+
+  // Maximum percentage of distinct values for dictionary encoding the string
+  // columns of the build side. 0 if disabled.
+  const int32_t dictionaryStringsPct_;
+
   std::vector<RowVectorPtr> dataVectors_;
+  // The retained byte size of 'dataVectors_'. The vectors are allocated from
+  // the memory pools of the upstream operators, so this is how much memory is
+  // freed by spilling them.
+  uint64_t dataVectorsBytes_{0};
+
+  // Set after the first spill of the build side data.
+  std::unique_ptr<Spiller> spiller_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
   // Drivers must be completed before making data available for the probe side.
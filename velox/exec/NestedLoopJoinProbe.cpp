@@ -117,6 +117,9 @@ void NestedLoopJoinProbe::close() {
     joinCondition_->clear();
   }
   buildVectors_.reset();
+  buildSpillReader_.reset();
+  spilledBuildVector_.reset();
+  buildSpillPartition_.reset();
   Operator::close();
 }
 
@@ -135,6 +138,9 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
+  if (buildSpillPartition_ != nullptr) {
+    restartBuildSpillRead();
+  }
 }
 
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
@@ -149,12 +155,12 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
 
       while (output == nullptr && !hasProbedAllBuildData()) {
         output = getMismatchedOutput(
-            buildVectors_.value()[buildIndex_],
+            buildVector(),
             buildMatched_[buildIndex_],
             buildOutMapping_,
             buildProjections_,
             identityProjections_);
-        ++buildIndex_;
+        advanceBuildVector();
       }
       if (hasProbedAllBuildData()) {
         setState(ProbeOperatorState::kFinish);
@@ -276,6 +282,8 @@ void NestedLoopJoinProbe::finishProbeInput() {
   VELOX_CHECK_NOT_NULL(input_);
   input_.reset();
   buildIndex_ = 0;
+  buildSpillReader_.reset();
+  spilledBuildVector_.reset();
   if (!noMoreInput_) {
     return;
   }
@@ -317,9 +325,16 @@ void NestedLoopJoinProbe::beginBuildMismatch() {
     auto* op = peer->findOperator(planNodeId());
     auto* probe = dynamic_cast<NestedLoopJoinProbe*>(op);
     VELOX_CHECK_NOT_NULL(probe);
-    for (auto i = 0; i < buildMatched_.size(); ++i) {
+    probeSideEmpty_ &= probe->probeSideEmpty_;
+    // NOTE: if the build side has spilled, a probe operator without input
+    // hasn't read the spilled build side blocks and its 'buildMatched_' is
+    // empty.
+    if (buildMatched_.empty()) {
+      buildMatched_ = probe->buildMatched_;
+      continue;
+    }
+    for (auto i = 0; i < probe->buildMatched_.size(); ++i) {
       buildMatched_[i].select(probe->buildMatched_[i]);
-      probeSideEmpty_ &= probe->probeSideEmpty_;
     }
   }
   peers.clear();
@@ -329,33 +344,71 @@ void NestedLoopJoinProbe::beginBuildMismatch() {
   for (auto& promise : promises) {
     promise.setValue();
   }
+  if (buildSpillPartition_ != nullptr) {
+    restartBuildSpillRead();
+  }
 }
 
 bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   VELOX_CHECK(!buildVectors_.has_value());
 
-  auto buildData =
-      operatorCtx_->task()
-          ->getNestedLoopJoinBridge(
-              operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-          ->dataOrFuture(future);
+  auto bridge = operatorCtx_->task()->getNestedLoopJoinBridge(
+      operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  auto buildData = bridge->dataOrFuture(future);
   if (!buildData.has_value()) {
     return false;
   }
 
   buildVectors_ = std::move(buildData);
-  if (buildVectors_->empty()) {
+  buildSpillPartition_ = bridge->spillPartition();
+  if (buildVectors_->empty() && buildSpillPartition_ == nullptr) {
     buildSideEmpty_ = true;
   }
   return true;
 }
 
+void NestedLoopJoinProbe::advanceBuildVector() {
+  ++buildIndex_;
+  if (buildSpillPartition_ != nullptr) {
+    readNextSpilledBuildVector();
+  }
+}
+
+void NestedLoopJoinProbe::restartBuildSpillRead() {
+  VELOX_CHECK_NOT_NULL(buildSpillPartition_);
+  VELOX_CHECK_EQ(buildIndex_, 0);
+  // Read from a copy of the spilled build side data as it is read again for
+  // the next probe input.
+  SpillPartition spillPartition(*buildSpillPartition_);
+  buildSpillReader_ = spillPartition.createUnorderedReader(
+      operatorCtx_->driverCtx()->queryConfig().spillReadBufferSize(),
+      pool(),
+      &spillStats_);
+  readNextSpilledBuildVector();
+}
+
+void NestedLoopJoinProbe::readNextSpilledBuildVector() {
+  VELOX_CHECK_NOT_NULL(buildSpillReader_);
+  // NOTE: read into a new vector as the previous one might still be referenced
+  // by the output.
+  spilledBuildVector_ = nullptr;
+  if (!buildSpillReader_->nextBatch(spilledBuildVector_)) {
+    spilledBuildVector_ = nullptr;
+    buildSpillReader_.reset();
+    return;
+  }
+  if (needsBuildMismatch(joinType_) && buildMatched_.size() == buildIndex_) {
+    buildMatched_.emplace_back();
+    buildMatched_.back().resizeFill(spilledBuildVector_->size(), false);
+  }
+}
+
 vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   VELOX_CHECK_NOT_NULL(input_);
   VELOX_CHECK(!hasProbedAllBuildData());
 
   const auto inputSize = input_->size();
-  auto numBuildRows = buildVectors_.value()[buildIndex_]->size();
+  auto numBuildRows = buildVector()->size();
   vector_size_t numProbeRows;
   if (numBuildRows > outputBatchSize_) {
     numProbeRows = 1;
@@ -374,7 +427,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
   VELOX_CHECK_GT(probeCnt, 0);
   VELOX_CHECK(!hasProbedAllBuildData());
 
-  const auto buildSize = buildVectors_.value()[buildIndex_]->size();
+  const auto buildSize = buildVector()->size();
   const auto numOutputRows = probeCnt * buildSize;
   const bool probeCntChanged = (probeCnt != numPrevProbedRows_);
   numPrevProbedRows_ = probeCnt;
@@ -408,7 +461,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
       probeIndices_);
   projectChildren(
       projectedChildren,
-      buildVectors_.value()[buildIndex_],
+      buildVector(),
       buildProjections,
       numOutputRows,
       buildIndices_);
@@ -425,9 +478,8 @@ bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
   probeRow_ = 0;
   numPrevProbedRows_ = 0;
   do {
-    ++buildIndex_;
-  } while (!hasProbedAllBuildData() &&
-           !buildVectors_.value()[buildIndex_]->size());
+    advanceBuildVector();
+  } while (!hasProbedAllBuildData() && !buildVector()->size());
   return hasProbedAllBuildData();
 }
 
@@ -499,7 +551,7 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       probeOutMapping_);
   projectChildren(
       projectedChildren,
-      buildVectors_.value()[buildIndex_],
+      buildVector(),
       buildProjections_,
       numOutputRows,
       buildOutMapping_);
@@ -87,9 +87,33 @@ class NestedLoopJoinProbe : public Operator {
   bool advanceProbeRows(vector_size_t probeCnt);
 
   bool hasProbedAllBuildData() const {
+    if (buildSpillPartition_ != nullptr) {
+      return spilledBuildVector_ == nullptr;
+    }
     return (buildIndex_ == buildVectors_.value().size());
   }
 
+  // Returns the build side vector at 'buildIndex_'.
+  const RowVectorPtr& buildVector() const {
+    if (buildSpillPartition_ != nullptr) {
+      return spilledBuildVector_;
+    }
+    return buildVectors_.value()[buildIndex_];
+  }
+
+  // Advances 'buildIndex_' to the next build side vector.
+  void advanceBuildVector();
+
+  // Starts to read the spilled build side data from its first block. Invoked
+  // for each probe input and for the build side mismatch output if the build
+  // side has spilled.
+  void restartBuildSpillRead();
+
+  // Reads the next block of the spilled build side data into
+  // 'spilledBuildVector_'. Sets 'spilledBuildVector_' to null if all the
+  // blocks have been read.
+  void readNextSpilledBuildVector();
+
   // Wraps rows of 'data' that are not selected in 'matched' and projects
   // to the output according to 'projections'. 'nullProjections' is used to
   // create null column vectors in output for outer join. 'unmatchedMapping' is
@@ -153,6 +177,12 @@ class NestedLoopJoinProbe : public Operator {
 
   // Build side state
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  // Set if the build side has spilled. 'buildVectors_' is empty then, and the
+  // build side vectors are read back one block at a time into
+  // 'spilledBuildVector_'.
+  std::shared_ptr<const SpillPartition> buildSpillPartition_;
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> buildSpillReader_;
+  RowVectorPtr spilledBuildVector_;
   bool buildSideEmpty_{false};
   // Index into buildData_ for the build side vector to process on next call to
   // getOutput().
@@ -160,7 +190,8 @@ class NestedLoopJoinProbe : public Operator {
   std::vector<IdentityProjection> buildProjections_;
   BufferPtr buildIndices_;
 
-  // Represents whether probe build rows have been matched.
+  // Represents whether probe build rows have been matched. If the build side
+  // has spilled, this is filled as the spilled build side blocks are read.
   std::vector<SelectivityVector> buildMatched_;
   std::vector<IdentityProjection> filterBuildProjections_;
   BufferPtr buildOutMapping_;
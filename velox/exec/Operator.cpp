@@ -291,6 +291,22 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+void Operator::recordMemorySample(uint64_t timeMs, uint32_t maxSamples) {
+  const auto* pool = this->pool();
+  MemoryTimelineSample sample{
+      timeMs,
+      operatorCtx_->driverCtx()->driverId,
+      pool->usedBytes(),
+      pool->reservedBytes()};
+  auto lockedStats = stats_.wlock();
+  auto& timeline = lockedStats->memoryTimeline;
+  VELOX_DCHECK_GT(maxSamples, 0);
+  if (timeline.size() >= maxSamples) {
+    timeline.erase(timeline.begin());
+  }
+  timeline.push_back(sample);
+}
+
 void Operator::recordSpillStats() {
   const auto lockedSpillStats = spillStats_.wlock();
   auto lockedStats = stats_.wlock();
@@ -488,6 +504,10 @@ void OperatorStats::add(const OperatorStats& other) {
   backgroundTiming.add(other.backgroundTiming);
 
   memoryStats.add(other.memoryStats);
+  memoryTimeline.insert(
+      memoryTimeline.end(),
+      other.memoryTimeline.begin(),
+      other.memoryTimeline.end());
 
   for (const auto& [name, stats] : other.runtimeStats) {
     if (UNLIKELY(runtimeStats.count(name) == 0)) {
@@ -531,6 +551,7 @@ void OperatorStats::clear() {
   backgroundTiming.clear();
 
   memoryStats.clear();
+  memoryTimeline.clear();
 
   runtimeStats.clear();
 
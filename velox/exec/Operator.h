@@ -102,6 +102,16 @@ struct DynamicFilterStats {
   }
 };
 
+/// A sample of the memory usage of the memory pool of an operator.
+struct MemoryTimelineSample {
+  /// The time of the sample in milliseconds since epoch.
+  uint64_t timeMs{0};
+  /// The driver running the operator.
+  uint32_t driverId{0};
+  int64_t usedBytes{0};
+  int64_t reservedBytes{0};
+};
+
 struct OperatorStats {
   /// Initial ordinal position in the operator's pipeline.
   int32_t operatorId = 0;
@@ -156,6 +166,11 @@ struct OperatorStats {
 
   MemoryStats memoryStats;
 
+  /// The memory usage samples taken every
+  /// QueryConfig::memoryTimelineSampleIntervalMs(). Ordered by time for each
+  /// driver.
+  std::vector<MemoryTimelineSample> memoryTimeline;
+
   // Total bytes in memory for spilling
   uint64_t spilledInputBytes{0};
 
@@ -497,6 +512,10 @@ class Operator : public BaseRuntimeStatWriter {
 
   void recordBlockingTime(uint64_t start, BlockingReason reason);
 
+  /// Appends a sample of the memory usage of 'this' at 'timeMs' to the stats.
+  /// Drops the oldest sample if there are 'maxSamples' already.
+  void recordMemorySample(uint64_t timeMs, uint32_t maxSamples);
+
   virtual std::string toString() const;
 
   /// Used in debug ednpoints.
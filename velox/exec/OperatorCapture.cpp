@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/OperatorCapture.h"
+
+#include <folly/json.h>
+#include <fstream>
+
+#include "velox/common/base/Fs.h"
+#include "velox/exec/Driver.h"
+#include "velox/exec/Operator.h"
+#include "velox/exec/Task.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+constexpr const char* kVectorExtension = ".vector";
+
+// The build operators of joins get their input from the second source of the
+// join node.
+int32_t sourceIndex(const Operator& op) {
+  static const std::string kBuild = "Build";
+  const auto& type = op.operatorType();
+  const bool isBuild = type.size() > kBuild.size() &&
+      type.compare(type.size() - kBuild.size(), kBuild.size(), kBuild) == 0;
+  return isBuild ? 1 : 0;
+}
+
+// Writes the plan node with 'planNodeId' of 'task' to 'directory'. Each
+// pipeline of the node writes to its own file which is then renamed, so
+// that readers never see a partial file.
+void writePlan(
+    const Task& task,
+    const core::PlanNodeId& planNodeId,
+    int32_t pipelineId,
+    const std::string& directory) {
+  const auto* node = core::PlanNode::findFirstNode(
+      task.planFragment().planNode.get(),
+      [&](const core::PlanNode* node) { return node->id() == planNodeId; });
+  VELOX_CHECK_NOT_NULL(node, "Plan node not found: {}", planNodeId);
+  const auto path =
+      fmt::format("{}/{}", directory, OperatorCapture::kPlanFileName);
+  const auto tempPath = fmt::format("{}.{}", path, pipelineId);
+  {
+    std::ofstream out(tempPath);
+    out << folly::toPrettyJson(node->serialize());
+    VELOX_CHECK(out.good(), "Failed to write {}", tempPath);
+  }
+  fs::rename(tempPath, path);
+}
+
+std::string readFile(const std::string& path) {
+  std::ifstream in(path);
+  VELOX_USER_CHECK(in.good(), "Failed to open {}", path);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+} // namespace
+
+// static
+std::unique_ptr<OperatorCapture> OperatorCapture::create(
+    const Operator& op,
+    const DriverCtx& driverCtx) {
+  const auto& config = driverCtx.queryConfig();
+  if (config.operatorCaptureNodeId() != op.planNodeId()) {
+    return nullptr;
+  }
+  VELOX_USER_CHECK(
+      !config.operatorCaptureDir().empty(),
+      "{} must be set to capture operator input",
+      core::QueryConfig::kOperatorCaptureDir);
+  const auto directory = fmt::format(
+      "{}/{}/{}",
+      config.operatorCaptureDir(),
+      driverCtx.task->taskId(),
+      op.planNodeId());
+  fs::create_directories(directory);
+  if (driverCtx.driverId == 0) {
+    writePlan(
+        *driverCtx.task, op.planNodeId(), driverCtx.pipelineId, directory);
+  }
+  return std::unique_ptr<OperatorCapture>(new OperatorCapture(
+      directory,
+      fmt::format(
+          "{}_{}_{}",
+          sourceIndex(op),
+          driverCtx.pipelineId,
+          driverCtx.driverId),
+      config.operatorCaptureMaxBatches()));
+}
+
+void OperatorCapture::addInput(const RowVectorPtr& input) {
+  if (numBatches_ >= maxBatches_) {
+    return;
+  }
+  // The batches are replayed without the scan that produces the lazy
+  // vectors.
+  input->loadedVector();
+  const auto path = fmt::format(
+      "{}/{}_{:06}{}", directory_, filePrefix_, numBatches_, kVectorExtension);
+  saveVectorToFile(input.get(), path.c_str());
+  ++numBatches_;
+}
+
+// static
+core::PlanNodePtr OperatorCapture::replayPlan(
+    const std::string& directory,
+    memory::MemoryPool* pool) {
+  auto plan = folly::parseJson(
+      readFile(fmt::format("{}/{}", directory, kPlanFileName)));
+
+  // File names of the batches of each source, in capture order within each
+  // driver.
+  std::map<int32_t, std::vector<std::string>> sourceFiles;
+  for (const auto& entry : fs::directory_iterator(directory)) {
+    if (entry.path().extension() != kVectorExtension) {
+      continue;
+    }
+    const auto name = entry.path().filename().string();
+    sourceFiles[std::stoi(name.substr(0, name.find('_')))].push_back(
+        entry.path().string());
+  }
+
+  VELOX_USER_CHECK(
+      plan.count("sources") > 0, "Captured plan node has no sources");
+  auto& sources = plan["sources"];
+  for (auto i = 0; i < sources.size(); ++i) {
+    auto it = sourceFiles.find(i);
+    VELOX_USER_CHECK(
+        it != sourceFiles.end(),
+        "No captured input for source {} in {}",
+        i,
+        directory);
+    std::sort(it->second.begin(), it->second.end());
+    std::vector<RowVectorPtr> batches;
+    for (const auto& path : it->second) {
+      batches.push_back(std::dynamic_pointer_cast<RowVector>(
+          restoreVectorFromFile(path.c_str(), pool)));
+    }
+    sources[i] = core::ValuesNode(
+                     fmt::format("replay_source_{}", i), std::move(batches))
+                     .serialize();
+  }
+  return ISerializable::deserialize<core::PlanNode>(plan, pool);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+class Operator;
+struct DriverCtx;
+
+/// Records the plan node and the input batches of the operators of one plan
+/// node of a query so that the operators can be replayed offline on the
+/// same data, e.g. in a benchmark. Enabled by the query config
+/// operator_capture_node_id.
+///
+/// The files of a task are in <operator_capture_dir>/<task id>/<plan node
+/// id>/:
+///   plan.json - the serialized plan node, including its sources.
+///   <source>_<pipeline>_<driver>_<sequence>.vector - an input batch saved
+///   with VectorSaver. 'source' is the index of the plan node source the
+///   batch comes from: 1 for the build side of a join, 0 otherwise.
+class OperatorCapture {
+ public:
+  /// Returns the capture for the input of 'op' in the driver of 'driverCtx'
+  /// or nullptr if the query config does not select the plan node of 'op'.
+  static std::unique_ptr<OperatorCapture> create(
+      const Operator& op,
+      const DriverCtx& driverCtx);
+
+  /// Saves 'input' unless operator_capture_max_batches batches were already
+  /// saved. Lazy vectors are loaded first.
+  void addInput(const RowVectorPtr& input);
+
+  /// Returns a plan that replays the batches captured in 'directory', a
+  /// <task id>/<plan node id> directory. The sources of the captured plan
+  /// node are replaced by non-parallelizable ValuesNodes with the batches
+  /// of each source. Each source must have at least one batch. Needs the
+  /// SerDe of plan nodes, types and expressions to be registered.
+  static core::PlanNodePtr replayPlan(
+      const std::string& directory,
+      memory::MemoryPool* pool);
+
+  static constexpr const char* kPlanFileName = "plan.json";
+
+ private:
+  OperatorCapture(
+      std::string directory,
+      std::string filePrefix,
+      uint32_t maxBatches)
+      : directory_(std::move(directory)),
+        filePrefix_(std::move(filePrefix)),
+        maxBatches_(maxBatches) {}
+
+  const std::string directory_;
+  const std::string filePrefix_;
+  const uint32_t maxBatches_;
+  uint32_t numBatches_{0};
+};
+
+} // namespace facebook::velox::exec
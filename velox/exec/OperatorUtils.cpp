@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/vector/ConstantVector.h"
@@ -400,6 +401,50 @@ folly::Range<vector_size_t*> initializeRowNumberMapping(
   return folly::Range(mapping->asMutable<vector_size_t>(), size);
 }
 
+void spillByPartition(
+    Spiller& spiller,
+    HashPartitionFunction& hashFunction,
+    const RowVectorPtr& input,
+    memory::MemoryPool* pool) {
+  const auto numInput = input->size();
+
+  std::vector<uint32_t> spillPartitions(numInput);
+  const auto singlePartition = hashFunction.partition(*input, spillPartitions);
+
+  const auto numPartitions = hashFunction.numPartitions();
+
+  std::vector<BufferPtr> partitionIndices(numPartitions);
+  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
+
+  for (auto i = 0; i < numPartitions; ++i) {
+    partitionIndices[i] = allocateIndices(numInput, pool);
+    rawPartitionIndices[i] = partitionIndices[i]->asMutable<vector_size_t>();
+  }
+
+  std::vector<vector_size_t> numSpillInputs(numPartitions, 0);
+
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = singlePartition.has_value() ? singlePartition.value()
+                                                       : spillPartitions[row];
+    rawPartitionIndices[partition][numSpillInputs[partition]++] = row;
+  }
+
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  for (int32_t partition = 0; partition < numSpillInputs.size(); ++partition) {
+    const auto numInputs = numSpillInputs[partition];
+    if (numInputs == 0) {
+      continue;
+    }
+
+    spiller.spill(
+        partition, wrap(numInputs, partitionIndices[partition], input));
+  }
+}
+
 void projectChildren(
     std::vector<VectorPtr>& projectedChildren,
     const RowVectorPtr& src,
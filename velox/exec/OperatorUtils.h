@@ -20,6 +20,7 @@
 
 namespace facebook::velox::exec {
 
+class HashPartitionFunction;
 class VectorHasher;
 
 // Deselects rows from 'rows' where any of the vectors managed by the 'hashers'
@@ -134,6 +135,15 @@ folly::Range<vector_size_t*> initializeRowNumberMapping(
     vector_size_t size,
     memory::MemoryPool* pool);
 
+/// Spills the rows of 'input' to the partitions of 'spiller' computed by
+/// 'hashFunction'. Loads the lazy vectors of 'input' first. 'pool' is used to
+/// allocate the row indices of the partitions.
+void spillByPartition(
+    Spiller& spiller,
+    HashPartitionFunction& hashFunction,
+    const RowVectorPtr& input,
+    memory::MemoryPool* pool);
+
 /// Projects children of 'src' row vector according to 'projections'. Optionally
 /// takes a 'mapping' and 'size' that represent the indices and size,
 /// respectively, of a dictionary wrapping that should be applied to the
@@ -16,6 +16,7 @@
 #include "velox/exec/OrderBy.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
+#include "velox/exec/TreeOfLosers.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
@@ -28,6 +29,38 @@ CompareFlags fromSortOrderToCompareFlags(const core::SortOrder& sortOrder) {
       false,
       CompareFlags::NullHandlingMode::kNullAsValue};
 }
+
+// The number of key samples taken per key range to pick the splitters when
+// range partitioning the sorted rows across drivers.
+constexpr size_t kNumSamplesPerRange = 64;
+
+// A sorted run of rows from one sort buffer to merge with the runs of the same
+// key range from the other drivers.
+class SortedRowStream : public MergeStream {
+ public:
+  SortedRowStream(const SortBuffer* sortBuffer, folly::Range<char* const*> rows)
+      : sortBuffer_(sortBuffer), rows_(rows) {}
+
+  bool hasData() const override {
+    return !rows_.empty();
+  }
+
+  bool operator<(const MergeStream& other) const override {
+    return sortBuffer_->compareRows(
+               rows_.front(),
+               static_cast<const SortedRowStream&>(other).rows_.front()) < 0;
+  }
+
+  char* pop() {
+    auto* row = rows_.front();
+    rows_.advance(1);
+    return row;
+  }
+
+ private:
+  const SortBuffer* const sortBuffer_;
+  folly::Range<char* const*> rows_;
+};
 } // namespace
 
 OrderBy::OrderBy(
@@ -40,7 +73,9 @@ OrderBy::OrderBy(
           operatorId,
           orderByNode->id(),
           "OrderBy",
-          orderByNode->canSpill(driverCtx->queryConfig())
+          orderByNode->canSpill(driverCtx->queryConfig()) &&
+                  !driverCtx->queryConfig()
+                       .orderByRangePartitionAcrossDrivers()
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt) {
   maxOutputRows_ = outputBatchRows(std::nullopt);
@@ -69,6 +104,17 @@ OrderBy::OrderBy(
       &spillStats_);
 }
 
+void OrderBy::initialize() {
+  Operator::initialize();
+
+  // A single driver has nothing to partition with.
+  rangePartition_ = operatorCtx_->driverCtx()
+                        ->queryConfig()
+                        .orderByRangePartitionAcrossDrivers() &&
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver()) > 1;
+  range_ = operatorCtx_->driverCtx()->driverId;
+}
+
 void OrderBy::addInput(RowVectorPtr input) {
   sortBuffer_->addInput(input);
 }
@@ -91,13 +137,180 @@ void OrderBy::noMoreInput() {
   Operator::noMoreInput();
   sortBuffer_->noMoreInput();
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
+  if (rangePartition_) {
+    startRangePartition();
+  }
+}
+
+void OrderBy::startRangePartition() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &rangeFuture_,
+          promises,
+          peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not the last
+    // to finish) can continue from the barrier and merge their ranges.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  const auto numRanges = peers.size() + 1;
+  auto sources = std::make_shared<RangeSources>();
+  sources->sortBuffers.resize(numRanges);
+  const auto addSource = [&](OrderBy* orderBy) {
+    VELOX_CHECK_NOT_NULL(orderBy->sortBuffer_);
+    VELOX_CHECK_LT(orderBy->range_, numRanges);
+    VELOX_CHECK_NULL(sources->sortBuffers[orderBy->range_]);
+    orderBy->rangeSources_ = sources;
+    sources->sortBuffers[orderBy->range_] = std::move(orderBy->sortBuffer_);
+  };
+  addSource(this);
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    addSource(orderBy);
+  }
+
+  // Sample the sorted rows of all the drivers at the same stride so that each
+  // sample stands for about the same number of rows.
+  size_t numRows = 0;
+  for (const auto& sortBuffer : sources->sortBuffers) {
+    numRows += sortBuffer->sortedRows().size();
+  }
+  const auto stride =
+      std::max<size_t>(1, numRows / (kNumSamplesPerRange * numRanges));
+  std::vector<char*> samples;
+  samples.reserve(numRows / stride + numRanges);
+  for (const auto& sortBuffer : sources->sortBuffers) {
+    const auto& rows = sortBuffer->sortedRows();
+    for (auto i = stride / 2; i < rows.size(); i += stride) {
+      samples.push_back(rows[i]);
+    }
+  }
+  // All the sort buffers have the same row layout, so any of them can compare
+  // the rows of the others.
+  const auto& comparator = *sources->sortBuffers[0];
+  std::sort(
+      samples.begin(),
+      samples.end(),
+      [&](const char* left, const char* right) {
+        return comparator.compareRows(left, right) < 0;
+      });
+
+  // Splitter 'j' is the lowest key of range 'j + 1'.
+  std::vector<const char*> splitters;
+  if (!samples.empty()) {
+    splitters.reserve(numRanges - 1);
+    for (auto range = 1; range < numRanges; ++range) {
+      splitters.push_back(samples[range * samples.size() / numRanges]);
+    }
+  }
+
+  sources->rangeBounds.resize(numRanges);
+  for (auto i = 0; i < numRanges; ++i) {
+    const auto& rows = sources->sortBuffers[i]->sortedRows();
+    auto& bounds = sources->rangeBounds[i];
+    bounds.reserve(numRanges + 1);
+    bounds.push_back(0);
+    for (const auto* splitter : splitters) {
+      bounds.push_back(
+          std::lower_bound(
+              rows.begin() + bounds.back(),
+              rows.end(),
+              splitter,
+              [&](const char* row, const char* key) {
+                return comparator.compareRows(row, key) < 0;
+              }) -
+          rows.begin());
+    }
+    bounds.resize(numRanges + 1, rows.size());
+  }
+}
+
+void OrderBy::mergeRange() {
+  VELOX_CHECK(!rangeMerged_);
+  rangeMerged_ = true;
+
+  const auto& sources = *rangeSources_;
+  std::vector<std::unique_ptr<SortedRowStream>> streams;
+  size_t numRows = 0;
+  for (auto i = 0; i < sources.sortBuffers.size(); ++i) {
+    const auto& rows = sources.sortBuffers[i]->sortedRows();
+    const auto begin = sources.rangeBounds[i][range_];
+    const auto end = sources.rangeBounds[i][range_ + 1];
+    if (begin == end) {
+      continue;
+    }
+    streams.push_back(std::make_unique<SortedRowStream>(
+        sources.sortBuffers[i].get(),
+        folly::Range<char* const*>(rows.data() + begin, rows.data() + end)));
+    numRows += end - begin;
+  }
+  addRuntimeStat(
+      "rangePartitionedAcrossDrivers",
+      RuntimeCounter(sources.sortBuffers.size()));
+  if (streams.empty()) {
+    return;
+  }
+
+  rangeRows_.reserve(numRows);
+  TreeOfLosers<SortedRowStream> merger(std::move(streams));
+  while (auto* stream = merger.next()) {
+    rangeRows_.push_back(stream->pop());
+  }
+}
+
+RowVectorPtr OrderBy::getRangeOutput() {
+  if (!rangeMerged_) {
+    mergeRange();
+  }
+
+  if (numRangeOutputRows_ == rangeRows_.size()) {
+    finished_ = true;
+    rangeRows_.clear();
+    // The last driver to release the range sources frees the sort buffers of
+    // all the drivers.
+    rangeSources_.reset();
+    return nullptr;
+  }
+
+  const auto numRows = std::min<vector_size_t>(
+      rangeRows_.size() - numRangeOutputRows_, maxOutputRows_);
+  auto output = BaseVector::create<RowVector>(outputType_, numRows, pool());
+  rangeSources_->sortBuffers[0]->extractRows(
+      folly::Range<char* const*>(
+          rangeRows_.data() + numRangeOutputRows_, numRows),
+      output);
+  numRangeOutputRows_ += numRows;
+  return output;
+}
+
+BlockingReason OrderBy::isBlocked(ContinueFuture* future) {
+  if (!rangeFuture_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(rangeFuture_);
+  return BlockingReason::kWaitForSortRangePartition;
 }
 
 RowVectorPtr OrderBy::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_ || !noMoreInput_ || rangeFuture_.valid()) {
     return nullptr;
   }
 
+  if (rangePartition_) {
+    return getRangeOutput();
+  }
+
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputRows_);
   finished_ = (output == nullptr);
   return output;
@@ -106,5 +319,7 @@ RowVectorPtr OrderBy::getOutput() {
 void OrderBy::close() {
   Operator::close();
   sortBuffer_.reset();
+  rangeRows_.clear();
+  rangeSources_.reset();
 }
 } // namespace facebook::velox::exec
@@ -28,7 +28,10 @@ namespace facebook::velox::exec {
 /// it blocks the pipeline. Once all inputs are available, it sorts pointers
 /// to the rows using the RowContainer's compare() function. And finally it
 /// constructs and returns the sorted output RowVector using the data in the
-/// RowContainer.
+/// RowContainer. If QueryConfig::kOrderByRangePartitionAcrossDrivers is set,
+/// the drivers split the sorted rows of all the drivers into key ranges and
+/// each driver merges and returns one range, so the drivers produce disjoint
+/// ordered streams in parallel.
 /// Limitations:
 /// * It memcopies twice: 1) input to RowContainer and 2) RowContainer to
 /// output.
@@ -47,11 +50,11 @@ class OrderBy : public Operator {
 
   void noMoreInput() override;
 
+  void initialize() override;
+
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
     return finished_;
@@ -63,8 +66,50 @@ class OrderBy : public Operator {
   void close() override;
 
  private:
+  // The sorted rows of all the drivers and the boundaries of their key ranges.
+  // Set up by the last driver to finish its input and read-only afterwards.
+  struct RangeSources {
+    std::vector<std::unique_ptr<SortBuffer>> sortBuffers;
+    // 'rangeBounds[i][j]' is the index of the first sorted row of
+    // 'sortBuffers[i]' in key range 'j'. 'rangeBounds[i][numRanges]' is the
+    // number of rows in 'sortBuffers[i]'.
+    std::vector<std::vector<vector_size_t>> rangeBounds;
+  };
+
+  // Invoked on no more input to wait for all the peer drivers to sort their
+  // input. The last driver to finish picks the splitter keys, collects the
+  // sort buffers of all the drivers into 'rangeSources_' and computes the key
+  // range boundaries of each sort buffer.
+  void startRangePartition();
+
+  // Merges the rows of key range 'range_' from all the range sources into
+  // 'rangeRows_'.
+  void mergeRange();
+
+  // Returns the next batch of 'rangeRows_' or nullptr if all have been
+  // returned.
+  RowVectorPtr getRangeOutput();
+
   std::unique_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
   uint32_t maxOutputRows_;
+
+  // True if the drivers of this OrderBy range partition their sorted rows
+  // with each other. See QueryConfig::kOrderByRangePartitionAcrossDrivers.
+  bool rangePartition_{false};
+  // The key range produced by this driver. This is the driver id so that the
+  // outputs of the drivers in driver id order are globally sorted.
+  uint32_t range_{0};
+  // The sort buffers of all the drivers. Set on all the drivers by the last
+  // driver to finish its input and reset once this driver has produced its
+  // range.
+  std::shared_ptr<RangeSources> rangeSources_;
+  // The sorted rows of 'range_' from all the sort buffers in 'rangeSources_'.
+  std::vector<char*> rangeRows_;
+  // The number of rows in 'rangeRows_' that have been returned.
+  vector_size_t numRangeOutputRows_{0};
+  bool rangeMerged_{false};
+  // Fulfilled when the last peer driver has finished its input.
+  ContinueFuture rangeFuture_{ContinueFuture::makeEmpty()};
 };
 } // namespace facebook::velox::exec
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/Task.h"
 
@@ -80,6 +81,24 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
+std::vector<std::shared_ptr<SerializedPage>> BroadcastBuffer::release(
+    int64_t sequence) {
+  std::vector<std::shared_ptr<SerializedPage>> released;
+  while (firstSequence_ < sequence && !pages_.empty()) {
+    released.push_back(std::move(pages_.front()));
+    pages_.pop_front();
+    ++firstSequence_;
+  }
+  return released;
+}
+
+std::string BroadcastBuffer::toString() const {
+  return fmt::format(
+      "[BROADCAST_BUFFER FIRST SEQUENCE[{}] PAGES[{}]]",
+      firstSequence_,
+      pages_.size());
+}
+
 void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
@@ -119,14 +138,17 @@ DestinationBuffer::Data DestinationBuffer::getData(
     loadData(arbitraryBuffer, maxBytes);
   }
 
-  if (sequence - sequence_ >= data_.size()) {
-    if (sequence - sequence_ > data_.size()) {
+  if (sequence - sequence_ >= numPages()) {
+    if (sequence - sequence_ > numPages()) {
       VLOG(1) << this << " Out of order get: " << sequence << " over "
               << sequence_ << " Setting second notify " << notifySequence_
               << " / " << sequence;
     }
     if (maxBytes == 0) {
       std::vector<int64_t> remainingBytes;
+      for (const auto& page : spilledPages_) {
+        remainingBytes.push_back(page.size);
+      }
       if (arbitraryBuffer) {
         arbitraryBuffer->getAvailablePageSizes(remainingBytes);
       }
@@ -136,7 +158,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
     }
     notify_ = std::move(notify);
     aliveCheck_ = std::move(activeCheck);
-    if (sequence - sequence_ > data_.size()) {
+    if (sequence - sequence_ > numPages()) {
       notifySequence_ = std::min(notifySequence_, sequence);
     } else {
       notifySequence_ = sequence;
@@ -149,31 +171,37 @@ DestinationBuffer::Data DestinationBuffer::getData(
   uint64_t resultBytes = 0;
   auto i = sequence - sequence_;
   if (maxBytes > 0) {
-    for (; i < data_.size(); ++i) {
+    for (; i < numPages(); ++i) {
       // nullptr is used as end marker
-      if (data_[i] == nullptr) {
-        VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
+      if (pageAt(i) == nullptr) {
+        VELOX_CHECK_EQ(i, numPages() - 1, "null marker found in the middle");
         data.push_back(nullptr);
         break;
       }
-      data.push_back(data_[i]->getIOBuf());
-      resultBytes += data_[i]->size();
+      data.push_back(pageAt(i)->getIOBuf());
+      resultBytes += pageAt(i)->size();
       if (resultBytes >= maxBytes) {
         ++i;
         break;
       }
     }
   }
+  sentSequence_ = std::max(sentSequence_, sequence_ + i);
   bool atEnd = false;
   std::vector<int64_t> remainingBytes;
-  remainingBytes.reserve(data_.size() - i);
-  for (; i < data_.size(); ++i) {
-    if (data_[i] == nullptr) {
-      VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
+  remainingBytes.reserve(numPages() - i);
+  for (; i < numPages(); ++i) {
+    if (pageAt(i) == nullptr) {
+      VELOX_CHECK_EQ(i, numPages() - 1, "null marker found in the middle");
       atEnd = true;
       break;
     }
-    remainingBytes.push_back(data_[i]->size());
+    remainingBytes.push_back(pageAt(i)->size());
+  }
+  if (!atEnd) {
+    for (const auto& page : spilledPages_) {
+      remainingBytes.push_back(page.size);
+    }
   }
   if (!atEnd && arbitraryBuffer) {
     arbitraryBuffer->getAvailablePageSizes(remainingBytes);
@@ -184,18 +212,168 @@ DestinationBuffer::Data DestinationBuffer::getData(
   return {std::move(data), std::move(remainingBytes), true};
 }
 
+DestinationBuffer::~DestinationBuffer() {
+  removeSpillFile();
+}
+
+DestinationBuffer::DestinationBuffer(BroadcastBuffer* broadcastBuffer)
+    : broadcastBuffer_(broadcastBuffer) {
+  if (broadcastBuffer_ == nullptr) {
+    return;
+  }
+  VELOX_CHECK_EQ(
+      broadcastBuffer_->firstSequence(),
+      0,
+      "Broadcast pages are released before all destinations are added");
+  for (auto i = 0; i < numPages(); ++i) {
+    if (pageAt(i) != nullptr) {
+      stats_.recordEnqueue(*pageAt(i));
+    }
+  }
+}
+
+int64_t DestinationBuffer::numPages() const {
+  if (broadcastBuffer_ != nullptr) {
+    return broadcastBuffer_->endSequence() - sequence_;
+  }
+  return data_.size();
+}
+
+const std::shared_ptr<SerializedPage>& DestinationBuffer::pageAt(
+    int64_t index) const {
+  if (broadcastBuffer_ != nullptr) {
+    return broadcastBuffer_->pageAt(sequence_ + index);
+  }
+  return data_[index];
+}
+
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
+  if (broadcastBuffer_ != nullptr) {
+    // The page is in 'broadcastBuffer_' already.
+    if (data != nullptr) {
+      stats_.recordEnqueue(*data);
+    }
+    return;
+  }
   // Drop duplicate end markers.
-  if (data == nullptr && !data_.empty() && data_.back() == nullptr) {
+  if (data == nullptr &&
+      (spilledAtEnd_ || (!data_.empty() && data_.back() == nullptr))) {
     return;
   }
 
   if (data != nullptr) {
     stats_.recordEnqueue(*data);
   }
+  if (!spilledPages_.empty()) {
+    if (data == nullptr) {
+      spilledAtEnd_ = true;
+    } else {
+      spilledPages_.push_back(writeSpilledPage(*data));
+    }
+    return;
+  }
   data_.push_back(std::move(data));
 }
 
+int64_t DestinationBuffer::spillableBytes() const {
+  int64_t bytes = 0;
+  for (auto i = std::max<int64_t>(0, sentSequence_ - sequence_);
+       i < data_.size();
+       ++i) {
+    if (data_[i] != nullptr) {
+      bytes += data_[i]->size();
+    }
+  }
+  return bytes;
+}
+
+std::pair<int32_t, int64_t> DestinationBuffer::spill(
+    const std::string& spillPath) {
+  if (spillableBytes() == 0) {
+    return {0, 0};
+  }
+  const int64_t firstUnsent = std::max<int64_t>(0, sentSequence_ - sequence_);
+  if (spillFile_ == nullptr) {
+    spillPath_ = spillPath;
+    spillFile_ = filesystems::getFileSystem(spillPath_, nullptr)
+                     ->openFileForWrite(spillPath_);
+  }
+  int32_t numPages = 0;
+  int64_t bytes = 0;
+  // The spilled pages go before the ones spilled earlier, which follow
+  // 'data_'.
+  for (int64_t i = data_.size() - 1; i >= firstUnsent; --i) {
+    if (data_[i] == nullptr) {
+      spilledAtEnd_ = true;
+      continue;
+    }
+    spilledPages_.push_front(writeSpilledPage(*data_[i]));
+    ++numPages;
+    bytes += data_[i]->size();
+  }
+  data_.resize(firstUnsent);
+  return {numPages, bytes};
+}
+
+std::pair<int32_t, int64_t> DestinationBuffer::unspill(
+    int64_t sequence,
+    uint64_t maxBytes) {
+  if (spilledPages_.empty() || sequence - sequence_ < data_.size()) {
+    return {0, 0};
+  }
+  spillFile_->flush();
+  auto readFile = filesystems::getFileSystem(spillPath_, nullptr)
+                      ->openFileForRead(spillPath_);
+  int32_t numPages = 0;
+  int64_t bytes = 0;
+  while (!spilledPages_.empty() && (bytes == 0 || bytes < maxBytes)) {
+    const auto& page = spilledPages_.front();
+    auto iobuf = folly::IOBuf::create(page.size);
+    readFile->pread(page.offset, page.size, iobuf->writableData());
+    iobuf->append(page.size);
+    data_.push_back(std::make_shared<SerializedPage>(
+        std::move(iobuf), nullptr, page.numRows));
+    ++numPages;
+    bytes += page.size;
+    spilledPages_.pop_front();
+  }
+  if (spilledPages_.empty() && spilledAtEnd_) {
+    data_.push_back(nullptr);
+    spilledAtEnd_ = false;
+  }
+  return {numPages, bytes};
+}
+
+DestinationBuffer::SpilledPage DestinationBuffer::writeSpilledPage(
+    const SerializedPage& page) {
+  SpilledPage spilled{
+      spillFile_->size(),
+      static_cast<int64_t>(page.size()),
+      page.numRows().value()};
+  auto iobuf = page.getIOBuf();
+  for (const auto& range : *iobuf) {
+    spillFile_->append(std::string_view(
+        reinterpret_cast<const char*>(range.data()), range.size()));
+  }
+  stats_.bytesSpilled += spilled.size;
+  ++stats_.pagesSpilled;
+  return spilled;
+}
+
+void DestinationBuffer::removeSpillFile() {
+  if (spillFile_ == nullptr) {
+    return;
+  }
+  spillFile_->close();
+  spillFile_.reset();
+  try {
+    filesystems::getFileSystem(spillPath_, nullptr)->remove(spillPath_);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to remove output buffer spill file " << spillPath_
+                 << ": " << e.what();
+  }
+}
+
 DataAvailable DestinationBuffer::getAndClearNotify() {
   if (notify_ == nullptr) {
     VELOX_CHECK_NULL(aliveCheck_);
@@ -220,7 +398,11 @@ void DestinationBuffer::clearNotify() {
 
 void DestinationBuffer::finish() {
   VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
-  VELOX_CHECK(data_.empty(), "data must be fetched before finish");
+  VELOX_CHECK(
+      broadcastBuffer_ != nullptr || data_.empty(),
+      "data must be fetched before finish");
+  VELOX_CHECK(
+      spilledPages_.empty(), "spilled data must be fetched before finish");
   stats_.finished = true;
 }
 
@@ -266,7 +448,20 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
   }
 
   VELOX_CHECK_LE(
-      numDeleted, data_.size(), "Ack received for a not yet produced item");
+      numDeleted, numPages(), "Ack received for a not yet produced item");
+  if (broadcastBuffer_ != nullptr) {
+    // The pages are freed from 'broadcastBuffer_' once acknowledged by all
+    // destinations.
+    for (auto i = 0; i < numDeleted; ++i) {
+      if (pageAt(i) == nullptr) {
+        break;
+      }
+      stats_.recordAcknowledge(*pageAt(i));
+    }
+    sequence_ += numDeleted;
+    sentSequence_ = std::max(sentSequence_, sequence_);
+    return {};
+  }
   std::vector<std::shared_ptr<SerializedPage>> freed;
   for (auto i = 0; i < numDeleted; ++i) {
     if (data_[i] == nullptr) {
@@ -278,11 +473,21 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
   }
   data_.erase(data_.begin(), data_.begin() + numDeleted);
   sequence_ += numDeleted;
+  sentSequence_ = std::max(sentSequence_, sequence_);
   return freed;
 }
 
 std::vector<std::shared_ptr<SerializedPage>>
 DestinationBuffer::deleteResults() {
+  if (broadcastBuffer_ != nullptr) {
+    for (auto i = 0; i < numPages(); ++i) {
+      if (pageAt(i) != nullptr) {
+        stats_.recordDelete(*pageAt(i));
+      }
+    }
+    sequence_ += numPages();
+    return {};
+  }
   std::vector<std::shared_ptr<SerializedPage>> freed;
   for (auto i = 0; i < data_.size(); ++i) {
     if (data_[i] == nullptr) {
@@ -293,6 +498,17 @@ DestinationBuffer::deleteResults() {
     freed.push_back(std::move(data_[i]));
   }
   data_.clear();
+  for (const auto& page : spilledPages_) {
+    stats_.bytesBuffered -= page.size;
+    stats_.rowsBuffered -= page.numRows;
+    --stats_.pagesBuffered;
+    stats_.bytesSent += page.size;
+    stats_.rowsSent += page.numRows;
+    ++stats_.pagesSent;
+  }
+  spilledPages_.clear();
+  spilledAtEnd_ = false;
+  removeSpillFile();
   return freed;
 }
 
@@ -302,8 +518,12 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 
 std::string DestinationBuffer::toString() {
   std::stringstream out;
-  out << "[available: " << data_.size() << ", " << "sequence: " << sequence_
-      << ", " << (notify_ ? "notify registered, " : "") << this << "]";
+  out << "[available: " << numPages() << ", " << "sequence: " << sequence_
+      << ", " << (notify_ ? "notify registered, " : "");
+  if (!spilledPages_.empty()) {
+    out << "spilled: " << spilledPages_.size() << ", ";
+  }
+  out << this << "]";
   return out.str();
 }
 
@@ -332,12 +552,19 @@ OutputBuffer::OutputBuffer(
       kind_(kind),
       maxSize_(task_->queryCtx()->queryConfig().maxOutputBufferSize()),
       continueSize_((maxSize_ * kContinuePct) / 100),
+      spillEnabled_(
+          kind_ == PartitionedOutputNode::Kind::kPartitioned &&
+          task_->queryCtx()->queryConfig().outputBufferSpillEnabled() &&
+          !task_->spillDirectory().empty()),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
-      numDrivers_(numDrivers) {
+      numDrivers_(numDrivers),
+      broadcastBuffer_(
+          isBroadcast() ? std::make_unique<BroadcastBuffer>() : nullptr) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
-    buffers_.push_back(std::make_unique<DestinationBuffer>());
+    buffers_.push_back(
+        std::make_unique<DestinationBuffer>(broadcastBuffer_.get()));
   }
   finishedBufferStats_.resize(numDestinations);
 }
@@ -350,6 +577,7 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
     return;
   }
 
+  std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
   bool isFinished;
   {
@@ -365,10 +593,11 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
 
     noMoreBuffers_ = true;
     isFinished = isFinishedLocked();
-    updateAfterAcknowledgeLocked(dataToBroadcast_, promises);
+    releaseBroadcastPagesLocked(freed);
+    updateAfterAcknowledgeLocked(freed, promises);
   }
 
-  releaseAfterAcknowledge(dataToBroadcast_, promises);
+  releaseAfterAcknowledge(freed, promises);
   if (isFinished) {
     task_->setAllOutputConsumed();
   }
@@ -394,20 +623,28 @@ void OutputBuffer::addOutputBuffersLocked(int numBuffers) {
   VELOX_CHECK(!isPartitioned());
   buffers_.reserve(numBuffers);
   for (int32_t i = buffers_.size(); i < numBuffers; ++i) {
-    auto buffer = std::make_unique<DestinationBuffer>();
-    if (isBroadcast()) {
-      for (const auto& data : dataToBroadcast_) {
-        buffer->enqueue(data);
-      }
-      if (atEnd_) {
-        buffer->enqueue(nullptr);
-      }
-    }
-    buffers_.emplace_back(std::move(buffer));
+    buffers_.emplace_back(
+        std::make_unique<DestinationBuffer>(broadcastBuffer_.get()));
   }
   finishedBufferStats_.resize(numBuffers);
 }
 
+void OutputBuffer::releaseBroadcastPagesLocked(
+    std::vector<std::shared_ptr<SerializedPage>>& freed) {
+  if (!isBroadcast() || !noMoreBuffers_) {
+    return;
+  }
+  auto sequence = broadcastBuffer_->endSequence();
+  for (const auto& buffer : buffers_) {
+    if (buffer != nullptr) {
+      sequence = std::min(sequence, buffer->sequence());
+    }
+  }
+  for (auto& page : broadcastBuffer_->release(sequence)) {
+    freed.push_back(std::move(page));
+  }
+}
+
 void OutputBuffer::updateStatsWithEnqueuedPageLocked(
     int64_t pageBytes,
     int64_t pageRows) {
@@ -432,6 +669,40 @@ void OutputBuffer::updateStatsWithFreedPagesLocked(
   VELOX_CHECK_GE(bufferedPages_, 0);
 }
 
+void OutputBuffer::updateStatsWithUnspilledPagesLocked(
+    int numPages,
+    int64_t pageBytes) {
+  updateTotalBufferedBytesMsLocked();
+
+  bufferedBytes_ += pageBytes;
+  bufferedPages_ += numPages;
+}
+
+void OutputBuffer::spillLocked() {
+  std::vector<std::pair<int64_t, int32_t>> candidates;
+  for (auto i = 0; i < buffers_.size(); ++i) {
+    if (buffers_[i] != nullptr) {
+      const auto bytes = buffers_[i]->spillableBytes();
+      if (bytes > 0) {
+        candidates.emplace_back(bytes, i);
+      }
+    }
+  }
+  // Spills the destinations with the most unsent bytes first.
+  std::sort(candidates.begin(), candidates.end(), std::greater<>());
+  for (const auto& [bytes, destination] : candidates) {
+    if (bufferedBytes_ < continueSize_) {
+      break;
+    }
+    const auto [numPages, spilledBytes] = buffers_[destination]->spill(
+        fmt::format(
+            "{}/output_buffer_{}",
+            task_->getOrCreateSpillDirectory(),
+            destination));
+    updateStatsWithFreedPagesLocked(numPages, spilledBytes);
+  }
+}
+
 void OutputBuffer::updateTotalBufferedBytesMsLocked() {
   const auto nowMs = getCurrentTimeMs();
   if (bufferedBytes_ > 0) {
@@ -474,6 +745,10 @@ bool OutputBuffer::enqueue(
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
 
+    if (bufferedBytes_ >= maxSize_ && spillEnabled_) {
+      spillLocked();
+    }
+
     if (bufferedBytes_ >= maxSize_ && future) {
       promises_.emplace_back("OutputBuffer::enqueue");
       *future = promises_.back().getSemiFuture();
@@ -496,19 +771,19 @@ void OutputBuffer::enqueueBroadcastOutputLocked(
   VELOX_CHECK_NULL(arbitraryBuffer_);
   VELOX_DCHECK(dataAvailableCbs.empty());
 
+  if (noMoreBuffers_ && isFinishedLocked()) {
+    // All destinations are deleted. The page is dropped.
+    updateStatsWithFreedPagesLocked(1, data->size());
+    return;
+  }
   std::shared_ptr<SerializedPage> sharedData(data.release());
+  broadcastBuffer_->enqueue(sharedData);
   for (auto& buffer : buffers_) {
     if (buffer != nullptr) {
       buffer->enqueue(sharedData);
       dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
     }
   }
-
-  // NOTE: we don't need to add new buffer to 'dataToBroadcast_' if there is no
-  // more output buffers.
-  if (!noMoreBuffers_) {
-    dataToBroadcast_.emplace_back(sharedData);
-  }
 }
 
 void OutputBuffer::enqueueArbitraryOutputLocked(
@@ -548,6 +823,13 @@ void OutputBuffer::enqueuePartitionedOutputLocked(
   VELOX_CHECK_LT(destination, buffers_.size());
   auto* buffer = buffers_[destination].get();
   if (buffer != nullptr) {
+    if (buffer->hasSpilledPages()) {
+      // Goes to the spill file after the pages spilled before it.
+      const auto bytes = data->size();
+      buffer->enqueue(std::move(data));
+      updateStatsWithFreedPagesLocked(1, bytes);
+      return;
+    }
     buffer->enqueue(std::move(data));
     dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
   } else {
@@ -591,6 +873,9 @@ void OutputBuffer::checkIfDone(bool oneDriverFinished) {
         }
       }
     } else {
+      if (isBroadcast()) {
+        broadcastBuffer_->noMoreData();
+      }
       for (auto& buffer : buffers_) {
         if (buffer != nullptr) {
           buffer->enqueue(nullptr);
@@ -638,6 +923,7 @@ void OutputBuffer::acknowledge(int destination, int64_t sequence) {
       return;
     }
     freed = buffer->acknowledge(sequence, false);
+    releaseBroadcastPagesLocked(freed);
     updateAfterAcknowledgeLocked(freed, promises);
   }
   releaseAfterAcknowledge(freed, promises);
@@ -688,6 +974,7 @@ bool OutputBuffer::deleteResults(int destination) {
     buffers_[destination] = nullptr;
     ++numFinalAcknowledges_;
     isFinished = isFinishedLocked();
+    releaseBroadcastPagesLocked(freed);
     updateAfterAcknowledgeLocked(freed, promises);
   }
 
@@ -725,7 +1012,14 @@ void OutputBuffer::getData(
     auto* buffer = buffers_[destination].get();
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
+      releaseBroadcastPagesLocked(freed);
       updateAfterAcknowledgeLocked(freed, promises);
+      if (maxBytes > 0) {
+        const auto [numPages, bytes] = buffer->unspill(sequence, maxBytes);
+        if (numPages > 0) {
+          updateStatsWithUnspilledPagesLocked(numPages, bytes);
+        }
+      }
       data = buffer->getData(
           maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
     } else {
@@ -772,6 +1066,9 @@ std::string OutputBuffer::toStringLocked() const {
   if (isArbitrary()) {
     out << arbitraryBuffer_->toString();
   }
+  if (isBroadcast()) {
+    out << broadcastBuffer_->toString();
+  }
   out << "]" << std::endl;
   return out.str();
 }
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/file/File.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
 
@@ -90,6 +91,51 @@ class ArbitraryBuffer {
   std::deque<std::shared_ptr<SerializedPage>> pages_;
 };
 
+/// The pages of broadcast output. Each page is stored once and shared by all
+/// destinations, each of which keeps its own position in the pages. A page is
+/// released once all destinations have acknowledged it.
+///
+/// NOTE: this class is not thread-safe.
+class BroadcastBuffer {
+ public:
+  void enqueue(std::shared_ptr<SerializedPage> page) {
+    VELOX_CHECK_NOT_NULL(page, "Unexpected null page");
+    pages_.push_back(std::move(page));
+  }
+
+  /// Appends a null page as end marker. Duplicate calls are ignored.
+  void noMoreData() {
+    if (pages_.empty() || pages_.back() != nullptr) {
+      pages_.push_back(nullptr);
+    }
+  }
+
+  /// The sequence number of the first page not yet released.
+  int64_t firstSequence() const {
+    return firstSequence_;
+  }
+
+  /// The sequence number after the last page.
+  int64_t endSequence() const {
+    return firstSequence_ + pages_.size();
+  }
+
+  const std::shared_ptr<SerializedPage>& pageAt(int64_t sequence) const {
+    VELOX_DCHECK_GE(sequence, firstSequence_);
+    VELOX_DCHECK_LT(sequence, endSequence());
+    return pages_[sequence - firstSequence_];
+  }
+
+  /// Removes the pages before 'sequence' and returns them.
+  std::vector<std::shared_ptr<SerializedPage>> release(int64_t sequence);
+
+  std::string toString() const;
+
+ private:
+  std::deque<std::shared_ptr<SerializedPage>> pages_;
+  int64_t firstSequence_{0};
+};
+
 class DestinationBuffer {
  public:
   /// The data transferred by the destination buffer has two phases:
@@ -115,10 +161,49 @@ class DestinationBuffer {
     int64_t bytesSent{0};
     int64_t rowsSent{0};
     int64_t pagesSent{0};
+
+    /// Number of bytes / pages written to the spill file. A page spilled and
+    /// read back counts once.
+    int64_t bytesSpilled{0};
+    int64_t pagesSpilled{0};
   };
 
+  /// If 'broadcastBuffer' is set, 'this' reads the pages from it instead of
+  /// holding its own.
+  explicit DestinationBuffer(BroadcastBuffer* broadcastBuffer = nullptr);
+
+  ~DestinationBuffer();
+
+  /// The sequence number of the first page not acknowledged.
+  int64_t sequence() const {
+    return sequence_;
+  }
+
+  /// Appends 'data' to the pages in memory, or to the spill file if there
+  /// are spilled pages, so that the pages stay in sequence order.
   void enqueue(std::shared_ptr<SerializedPage> data);
 
+  /// Returns the bytes of the pages in memory that getData() has not
+  /// returned yet. These can be spilled.
+  int64_t spillableBytes() const;
+
+  /// Moves the pages in memory that getData() has not returned yet to the
+  /// spill file at 'spillPath'. The spill file is created on first use and
+  /// 'spillPath' is ignored after. Returns the number and bytes of the
+  /// spilled pages.
+  std::pair<int32_t, int64_t> spill(const std::string& spillPath);
+
+  /// Returns true if pages were enqueued to the spill file since it was last
+  /// emptied by unspill().
+  bool hasSpilledPages() const {
+    return !spilledPages_.empty();
+  }
+
+  /// Reads spilled pages with at least 'maxBytes' back into memory if the
+  /// pages in memory end before 'sequence'. Returns the number and bytes of
+  /// the pages read.
+  std::pair<int32_t, int64_t> unspill(int64_t sequence, uint64_t maxBytes);
+
   /// Invoked to load data with up to 'notifyMaxBytes_' bytes from arbitrary
   /// 'buffer' if there is pending fetch from this destination in which case
   /// 'notify_' is not null. Otherwise, it does nothing. This only used by
@@ -185,11 +270,40 @@ class DestinationBuffer {
   std::string toString();
 
  private:
+  // A page in 'spillFile_'.
+  struct SpilledPage {
+    uint64_t offset;
+    int64_t size;
+    int64_t numRows;
+  };
+
   void clearNotify();
 
+  // Returns the number of pages from 'sequence_' on, including the end
+  // marker.
+  int64_t numPages() const;
+
+  // Returns the page at 'index' counted from 'sequence_'.
+  const std::shared_ptr<SerializedPage>& pageAt(int64_t index) const;
+
+  // Appends 'page' to 'spillFile_' and returns its location.
+  SpilledPage writeSpilledPage(const SerializedPage& page);
+
+  void removeSpillFile();
+
+  // Shared pages of broadcast output. If set, 'data_' is not used.
+  BroadcastBuffer* const broadcastBuffer_;
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
+  // The sequence number after the last page returned by getData().
+  int64_t sentSequence_{0};
+  // The pages after 'data_' in sequence order.
+  std::deque<SpilledPage> spilledPages_;
+  // True if the end marker follows 'spilledPages_'.
+  bool spilledAtEnd_{false};
+  std::string spillPath_;
+  std::unique_ptr<WriteFile> spillFile_;
   DataAvailableCallback notify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
   // The sequence number of the first item to pass to 'notify'.
@@ -333,6 +447,12 @@ class OutputBuffer {
 
   void updateStatsWithFreedPagesLocked(int numPages, int64_t pageBytes);
 
+  void updateStatsWithUnspilledPagesLocked(int numPages, int64_t pageBytes);
+
+  // Spills the unsent pages of the destinations with the most of them until
+  // 'bufferedBytes_' is below 'continueSize_'.
+  void spillLocked();
+
   void updateTotalBufferedBytesMsLocked();
 
   int64_t getAverageBufferTimeMsLocked() const;
@@ -348,10 +468,15 @@ class OutputBuffer {
       const std::vector<std::shared_ptr<SerializedPage>>& freed,
       std::vector<ContinuePromise>& promises);
 
-  /// Given an updated total number of broadcast buffers, add any missing ones
-  /// and enqueue data that has been produced so far (e.g. dataToBroadcast_).
+  /// Given an updated total number of broadcast buffers, add any missing ones.
+  /// They start at the first page of 'broadcastBuffer_'.
   void addOutputBuffersLocked(int numBuffers);
 
+  // Releases the broadcast pages acknowledged by all destinations into
+  // 'freed'. Pages are kept until there are no more destinations to add.
+  void releaseBroadcastPagesLocked(
+      std::vector<std::shared_ptr<SerializedPage>>& freed);
+
   void enqueueBroadcastOutputLocked(
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
@@ -387,6 +512,10 @@ class OutputBuffer {
   // When 'totalSize_' goes below 'continueSize_', blocked producers are
   // resumed.
   const uint64_t continueSize_;
+  // If true, a full buffer spills the unsent pages of partitioned output to
+  // the task's spill directory instead of blocking the producers. See
+  // QueryConfig::kOutputBufferSpillEnabled.
+  const bool spillEnabled_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
 
   // Total number of drivers expected to produce results. This number will
@@ -398,10 +527,10 @@ class OutputBuffer {
   // applies for non-partitioned output buffer type.
   bool noMoreBuffers_{false};
 
-  // While noMoreBuffers_ is false, stores the enqueued data to
-  // broadcast to destinations that have not yet been initialized. Cleared
-  // after receiving no-more-broadcast-buffers signal.
-  std::vector<std::shared_ptr<SerializedPage>> dataToBroadcast_;
+  // The pages of broadcast output, shared by all destinations. Keeps all
+  // pages while noMoreBuffers_ is false, so that destinations added later
+  // get them too.
+  const std::unique_ptr<BroadcastBuffer> broadcastBuffer_;
 
   std::mutex mutex_;
   // Actual data size in 'buffers_'.
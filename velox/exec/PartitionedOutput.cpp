@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+
+#include <numeric>
+
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 
@@ -52,16 +55,14 @@ BlockingReason Destination::advance(
 
   // Serialize
   if (!current_) {
-    current_ = std::make_unique<VectorStreamGroup>(pool_);
+    current_ = std::make_unique<VectorStreamGroup>(pool_, serde_, recycler_);
     auto rowType = asRowType(output->type());
-    serializer::presto::PrestoVectorSerde::PrestoOptions options;
-    options.compressionKind =
-        OutputBufferManager::getInstance().lock()->compressionKind();
-    options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
-    current_->createStreamTree(rowType, rowsInCurrent_, &options);
+    current_->createStreamTree(rowType, rowsInCurrent_, &serdeOptions_);
   }
   current_->append(
-      output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
+      output,
+      folly::Range(rows_.data() + firstRow, rowIdx_ - firstRow),
+      scratch);
   // Update output state variable.
   if (rowIdx_ == rows_.size()) {
     *atEnd = true;
@@ -152,10 +153,15 @@ PartitionedOutput::PartitionedOutput(
       // out of the partitioned output buffer manager such as in Prestissimo,
       // the http server holds the buffers while sending the data response.
       bufferReleaseFn_([task = operatorCtx_->task()]() {}),
+      serde_(getNamedOrDefaultVectorSerde(ctx->queryConfig().shuffleSerde())),
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      preserveEncodings_(ctx->queryConfig().shufflePreserveEncodings()),
+      adaptiveCompression_(ctx->queryConfig().shuffleAdaptiveCompression()),
+      bytesSinceBlocked_(maxBufferedBytes_),
+      recycler_(pool(), maxBufferedBytes_) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -192,12 +198,39 @@ void PartitionedOutput::initializeInput(RowVectorPtr input) {
   }
 }
 
+serializer::presto::PrestoVectorSerde::PrestoOptions
+PartitionedOutput::serdeOptions() {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.compressionKind =
+      OutputBufferManager::getInstance().lock()->compressionKind();
+  options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+  options.preserveEncodings = preserveEncodings_;
+  if (adaptiveCompression_) {
+    // A full output buffer means that the consumers or the network do not
+    // keep up. Compresses the next buffer's worth of pages after that and
+    // saves the CPU otherwise.
+    options.shouldCompress = [this]() {
+      return bytesSinceBlocked_ < maxBufferedBytes_;
+    };
+  }
+  return options;
+}
+
 void PartitionedOutput::initializeDestinations() {
   if (destinations_.empty()) {
     auto taskId = operatorCtx_->taskId();
+    const auto options = serdeOptions();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          serde_,
+          options,
+          &recycler_,
+          eagerFlush_,
+          [&](uint64_t bytes, uint64_t rows) {
+            bytesSinceBlocked_ += bytes;
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
           }));
@@ -223,7 +256,7 @@ void PartitionedOutput::estimateRowSizes() {
   raw_vector<vector_size_t> storage;
   auto numbers = iota(numInput, storage);
   for (int i = 0; i < output_->childrenSize(); ++i) {
-    VectorStreamGroup::estimateSerializedSize(
+    serde_->estimateSerializedSize(
         output_->childAt(i).get(),
         folly::Range(numbers, numInput),
         sizePointers_.data(),
@@ -240,49 +273,68 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
 
   estimateRowSizes();
 
-  for (auto& destination : destinations_) {
-    destination->beginBatch();
+  partitionRows();
+
+  for (auto i = 0; i < numDestinations_; ++i) {
+    destinations_[i]->beginBatch(folly::Range(
+        partitionedRows_.data() + partitionOffsets_[i],
+        partitionOffsets_[i + 1] - partitionOffsets_[i]));
   }
+}
 
-  auto numInput = input_->size();
+void PartitionedOutput::partitionRows() {
+  const auto numInput = input_->size();
+  partitionOffsets_.assign(numDestinations_ + 1, 0);
   if (numDestinations_ == 1) {
-    destinations_[0]->addRows(IndexRange{0, numInput});
-  } else {
-    auto singlePartition = partitionFunction_->partition(*input_, partitions_);
-    if (replicateNullsAndAny_) {
-      collectNullRows();
-
-      vector_size_t start = 0;
-      if (!replicatedAny_) {
-        for (auto& destination : destinations_) {
-          destination->addRow(0);
-        }
-        replicatedAny_ = true;
-        // Make sure not to replicate first row twice.
-        start = 1;
-      }
-      for (auto i = start; i < numInput; ++i) {
-        if (nullRows_.isValid(i)) {
-          for (auto& destination : destinations_) {
-            destination->addRow(i);
-          }
-        } else {
-          if (singlePartition.has_value()) {
-            destinations_[singlePartition.value()]->addRow(i);
-          } else {
-            destinations_[partitions_[i]]->addRow(i);
-          }
-        }
-      }
+    partitionedRows_.resize(numInput);
+    std::iota(partitionedRows_.begin(), partitionedRows_.end(), 0);
+    partitionOffsets_[1] = numInput;
+    return;
+  }
+
+  const auto singlePartition =
+      partitionFunction_->partition(*input_, partitions_);
+  // The first row is replicated to all destinations once per operator.
+  bool replicateFirst = false;
+  if (replicateNullsAndAny_) {
+    collectNullRows();
+    replicateFirst = !replicatedAny_ && numInput > 0;
+    replicatedAny_ |= replicateFirst;
+  }
+  const auto isReplicated = [&](vector_size_t row) {
+    return replicateNullsAndAny_ &&
+        ((row == 0 && replicateFirst) || nullRows_.isValid(row));
+  };
+  const auto partitionOf = [&](vector_size_t row) {
+    return singlePartition.has_value() ? singlePartition.value()
+                                       : partitions_[row];
+  };
+
+  // Counting sort. Counts the rows per destination, then places each row at
+  // the next free position of its destination. This keeps the rows of a
+  // destination contiguous and in input order, so that each destination
+  // serializes them in one append per page.
+  vector_size_t numReplicated = 0;
+  for (auto row = 0; row < numInput; ++row) {
+    if (isReplicated(row)) {
+      ++numReplicated;
     } else {
-      if (singlePartition.has_value()) {
-        destinations_[singlePartition.value()]->addRows(
-            IndexRange{0, numInput});
-      } else {
-        for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
-        }
+      ++partitionOffsets_[partitionOf(row) + 1];
+    }
+  }
+  for (auto i = 0; i < numDestinations_; ++i) {
+    partitionOffsets_[i + 1] += partitionOffsets_[i] + numReplicated;
+  }
+  partitionedRows_.resize(partitionOffsets_[numDestinations_]);
+  std::vector<vector_size_t> nextOffsets(
+      partitionOffsets_.begin(), partitionOffsets_.end() - 1);
+  for (auto row = 0; row < numInput; ++row) {
+    if (isReplicated(row)) {
+      for (auto& offset : nextOffsets) {
+        partitionedRows_[offset++] = row;
       }
+    } else {
+      partitionedRows_[nextOffsets[partitionOf(row)]++] = row;
     }
   }
 }
@@ -349,6 +401,9 @@ RowVectorPtr PartitionedOutput::getOutput() {
           &future_,
           scratch_);
       if (blockingReason_ != BlockingReason::kNotBlocked) {
+        if (blockingReason_ == BlockingReason::kWaitForConsumer) {
+          bytesSinceBlocked_ = 0;
+        }
         blockedDestination = destination.get();
         workLeft = false;
         // We stop on first blocked. Adding data to unflushed targets
@@ -401,4 +456,10 @@ bool PartitionedOutput::isFinished() {
   return finished_;
 }
 
+void PartitionedOutput::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  recycler_.clear();
+}
+
 } // namespace facebook::velox::exec
@@ -18,6 +18,7 @@
 #include <folly/Random.h>
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
@@ -31,32 +32,31 @@ class Destination {
       const std::string& taskId,
       int destination,
       memory::MemoryPool* pool,
+      VectorSerde* serde,
+      const serializer::presto::PrestoVectorSerde::PrestoOptions&
+          serdeOptions,
+      StreamArenaRecycler* recycler,
       bool eagerFlush,
       std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
+        serde_(serde),
+        serdeOptions_(serdeOptions),
+        recycler_(recycler),
         eagerFlush_(eagerFlush),
         recordEnqueued_(std::move(recordEnqueued)) {
     setTargetSizePct();
   }
 
-  // Resets the destination before starting a new batch.
-  void beginBatch() {
-    rows_.clear();
+  // Resets the destination before starting a new batch. 'rows' are the rows
+  // of the batch for this destination. They must stay valid until advance()
+  // reports the end of the batch.
+  void beginBatch(folly::Range<const vector_size_t*> rows) {
+    rows_ = rows;
     rowIdx_ = 0;
   }
 
-  void addRow(vector_size_t row) {
-    rows_.push_back(row);
-  }
-
-  void addRows(const IndexRange& rows) {
-    for (auto i = 0; i < rows.size; ++i) {
-      rows_.push_back(rows.begin + i);
-    }
-  }
-
   // Serializes row from 'output' till either 'maxBytes' have been serialized or
   BlockingReason advance(
       uint64_t maxBytes,
@@ -105,6 +105,11 @@ class Destination {
   const std::string taskId_;
   const int destination_;
   memory::MemoryPool* const pool_;
+  VectorSerde* const serde_;
+  const serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions_;
+  // Shared by the destinations of the operator to reuse the serialization
+  // memory of the flushed pages.
+  StreamArenaRecycler* const recycler_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
 
@@ -112,7 +117,7 @@ class Destination {
   uint64_t bytesInCurrent_{0};
   // Number of rows serialized in 'current_'
   vector_size_t rowsInCurrent_{0};
-  raw_vector<vector_size_t> rows_;
+  folly::Range<const vector_size_t*> rows_;
 
   // First index of 'rows_' that is not appended to 'current_'.
   vector_size_t rowIdx_{0};
@@ -183,8 +188,22 @@ class PartitionedOutput : public Operator {
 
   void close() override {
     destinations_.clear();
+    recycler_.clear();
+  }
+
+  /// The memory kept for reuse by the destinations is reclaimable.
+  bool canReclaim() const override {
+    return recycler_.retainedBytes() > 0;
+  }
+
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override {
+    reclaimableBytes = recycler_.retainedBytes();
+    return reclaimableBytes > 0;
   }
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   static void testingSetMinCompressionRatio(float ratio) {
     minCompressionRatio_ = ratio;
   }
@@ -202,6 +221,12 @@ class PartitionedOutput : public Operator {
 
   void estimateRowSizes();
 
+  /// Returns the options the destinations serialize their pages with.
+  serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions();
+
+  /// Sorts the rows of 'input_' by destination into 'partitionedRows_'.
+  void partitionRows();
+
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
@@ -217,8 +242,20 @@ class PartitionedOutput : public Operator {
   const std::vector<column_index_t> outputChannels_;
   const std::weak_ptr<exec::OutputBufferManager> bufferManager_;
   const std::function<void()> bufferReleaseFn_;
+  // Serializes the pages. Set by QueryConfig::kShuffleSerde.
+  VectorSerde* const serde_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
+  // See QueryConfig::kShuffleAdaptiveCompression.
+  const bool adaptiveCompression_;
+  // Bytes enqueued since the operator was last blocked by a full output
+  // buffer. With 'adaptiveCompression_', pages are compressed while this is
+  // below 'maxBufferedBytes_'.
+  int64_t bytesSinceBlocked_;
+  // Keeps the serialization memory of flushed pages for reuse by
+  // 'destinations_'. Bounded by 'maxBufferedBytes_'.
+  StreamArenaRecycler recycler_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -233,6 +270,11 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // The rows of the current batch sorted by destination. The rows of
+  // destination i start at 'partitionOffsets_[i]'. Referenced by the
+  // destinations until the batch is serialized.
+  raw_vector<vector_size_t> partitionedRows_;
+  std::vector<vector_size_t> partitionOffsets_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
@@ -55,6 +55,10 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
 
   peakMemoryBytes += stats.memoryStats.peakTotalMemoryReservation;
   numMemoryAllocations += stats.memoryStats.numMemoryAllocations;
+  memoryTimeline.insert(
+      memoryTimeline.end(),
+      stats.memoryTimeline.begin(),
+      stats.memoryTimeline.end());
 
   physicalWrittenBytes += stats.physicalWrittenBytes;
 
@@ -249,4 +253,38 @@ std::string printPlanWithStats(
         }
       });
 }
+
+std::string printMemoryTimeline(const TaskStats& taskStats) {
+  struct Entry {
+    const OperatorStats* op;
+    const MemoryTimelineSample* sample;
+  };
+  std::vector<Entry> entries;
+  for (const auto& pipelineStats : taskStats.pipelineStats) {
+    for (const auto& opStats : pipelineStats.operatorStats) {
+      for (const auto& sample : opStats.memoryTimeline) {
+        entries.push_back({&opStats, &sample});
+      }
+    }
+  }
+  if (entries.empty()) {
+    return "";
+  }
+  std::stable_sort(
+      entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.sample->timeMs < rhs.sample->timeMs;
+      });
+
+  std::stringstream out;
+  const auto startMs = entries.front().sample->timeMs;
+  for (const auto& entry : entries) {
+    out << "+" << entry.sample->timeMs - startMs << "ms "
+        << entry.op->planNodeId << " " << entry.op->operatorType << " driver "
+        << entry.sample->driverId
+        << " used: " << succinctBytes(entry.sample->usedBytes)
+        << " reserved: " << succinctBytes(entry.sample->reservedBytes)
+        << std::endl;
+  }
+  return out.str();
+}
 } // namespace facebook::velox::exec
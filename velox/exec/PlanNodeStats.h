@@ -95,6 +95,10 @@ struct PlanNodeStats {
 
   uint64_t numMemoryAllocations{0};
 
+  /// The memory usage samples of all corresponding operators. Ordered by time
+  /// for each operator instance.
+  std::vector<MemoryTimelineSample> memoryTimeline;
+
   uint64_t physicalWrittenBytes{0};
 
   /// Operator-specific counters.
@@ -156,4 +160,10 @@ std::string printPlanWithStats(
     const core::PlanNode& plan,
     const TaskStats& taskStats,
     bool includeCustomStats = false);
+
+/// Returns the memory usage samples of the operators of 'taskStats' ordered
+/// by time, one per line with the time relative to the first sample, plan
+/// node id, operator type, driver id, used and reserved bytes. Empty if the
+/// sampling is disabled by QueryConfig::memoryTimelineSampleIntervalMs().
+std::string printMemoryTimeline(const TaskStats& taskStats);
 } // namespace facebook::velox::exec
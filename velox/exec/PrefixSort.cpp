@@ -43,6 +43,26 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+FOLLY_ALWAYS_INLINE void encodeStringRowColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix) {
+  std::optional<StringView> value;
+  std::string storage;
+  if (RowContainer::isNullAt(row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = std::nullopt;
+  } else {
+    value = HashStringAllocator::contiguousString(
+        *reinterpret_cast<StringView*>(row + rowColumn.offset()), storage);
+  }
+  prefixSortLayout.encoders[index].encode(
+      value,
+      prefix + prefixSortLayout.prefixOffsets[index],
+      prefixSortLayout.encodedSizes[index]);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -72,6 +92,12 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY: {
+      encodeStringRowColumn(prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -115,33 +141,45 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    uint32_t maxStringPrefixLength) {
   uint32_t normalizedKeySize = 0;
   uint32_t numNormalizedKeys = 0;
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
+  std::vector<uint32_t> encodedSizes;
   std::vector<PrefixSortEncoder> encoders;
+  bool lastKeyIsString = false;
 
   // Calculate encoders and prefix-offsets, and stop the loop if a key that
-  // cannot be normalized is encountered.
+  // cannot be normalized is encountered. A string key is the last normalized
+  // key as its prefix doesn't decide the order of the rows on ties.
   for (auto i = 0; i < numKeys; ++i) {
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
     }
-    std::optional<uint32_t> encodedSize =
-        PrefixSortEncoder::encodedSize(types[i]->kind());
+    std::optional<uint32_t> encodedSize = PrefixSortEncoder::encodedSize(
+        types[i]->kind(), maxStringPrefixLength);
     if (encodedSize.has_value()) {
       prefixOffsets.push_back(normalizedKeySize);
+      encodedSizes.push_back(encodedSize.value());
       encoders.push_back(
           {compareFlags[i].ascending, compareFlags[i].nullsFirst});
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
+      if (types[i]->kind() == TypeKind::VARCHAR ||
+          types[i]->kind() == TypeKind::VARBINARY) {
+        lastKeyIsString = true;
+        break;
+      }
     } else {
       break;
     }
   }
   auto padding = alignmentPadding(normalizedKeySize, kAlignment);
   normalizedKeySize += padding;
+  const uint32_t compareStartIndex =
+      lastKeyIsString ? numNormalizedKeys - 1 : numNormalizedKeys;
   return PrefixSortLayout{
       normalizedKeySize + sizeof(char*),
       normalizedKeySize,
@@ -149,8 +187,10 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numKeys,
       compareFlags,
       numNormalizedKeys == 0,
-      numNormalizedKeys < numKeys,
+      compareStartIndex < numKeys,
+      compareStartIndex,
       std::move(prefixOffsets),
+      std::move(encodedSizes),
       std::move(encoders),
       padding};
 }
@@ -170,7 +210,7 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   // If prefixes are equal, compare the left sort keys with rowContainer.
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
+  for (auto i = sortLayout_.compareStartIndex; i < sortLayout_.numKeys; ++i) {
     result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
@@ -42,8 +42,13 @@ FOLLY_ALWAYS_INLINE void stdSort(
 }; // namespace detail
 
 struct PrefixSortConfig {
-  PrefixSortConfig(uint32_t maxNormalizedKeySize, uint32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
+  PrefixSortConfig(
+      uint32_t maxNormalizedKeySize,
+      uint32_t threshold = 130,
+      uint32_t maxStringPrefixLength = 16)
+      : maxNormalizedKeySize(maxNormalizedKeySize),
+        threshold(threshold),
+        maxStringPrefixLength(maxStringPrefixLength) {}
 
   /// Max number of bytes can store normalized keys in prefix-sort buffer per
   /// entry.
@@ -53,17 +58,23 @@ struct PrefixSortConfig {
   /// The threshold is set to 100 according to the benchmark test results by
   /// default.
   const int64_t threshold;
+
+  /// Number of leading bytes of a VARCHAR or VARBINARY key stored in the
+  /// prefix. Rows with equal string prefixes are compared with the
+  /// RowContainer. String keys are not normalized if it is 0.
+  const uint32_t maxStringPrefixLength;
 };
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
-/// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 1. normalized keys. A VARCHAR or VARBINARY key is normalized as its leading
+/// bytes plus a tie-break flag, see PrefixSortEncoder. It is the last
+/// normalized key, as the keys after it can't be ordered by their prefixes if
+/// the string prefixes tie.
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
-  /// normalizedKeySize_ + 8 (non-normalized-ptr) + 8(row address).
+  /// normalizedKeySize_ + 8(row address).
   const uint64_t entrySize;
 
   /// If a sort key supports normalization and can be added to the prefix
@@ -82,13 +93,23 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys == 0', a little faster.
   const bool noNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether the prefixes may tie for rows with different sort keys, i.e. the
+  /// sort keys contains non-normalized key or a string key normalized by its
+  /// prefix.
   const bool hasNonNormalizedKey;
 
+  /// The index of the first sort key compared with the RowContainer when the
+  /// prefixes tie. This is the string key if the last normalized key is a
+  /// string, otherwise the first non-normalized key.
+  const uint32_t compareStartIndex;
+
   /// Offsets of normalized keys, used to find write locations when
   /// extracting columns
   const std::vector<uint32_t> prefixOffsets;
 
+  /// Encoded sizes of normalized keys.
+  const std::vector<uint32_t> encodedSizes;
+
   /// The encoders for normalized keys.
   const std::vector<prefixsort::PrefixSortEncoder> encoders;
 
@@ -99,7 +120,8 @@ struct PrefixSortLayout {
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      uint32_t maxStringPrefixLength = 0);
 };
 
 class PrefixSort {
@@ -122,11 +144,9 @@ class PrefixSort {
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
   /// compare value.
-  /// For keys can part-normalized(Varchar, Row etc.), we will store the
-  /// normalized part and points to raw data in prefix, and custom the points
-  /// compare. The compare strategy will be defined in PrefixSortLayout as
-  /// follow-up, we treat this part as non-normalized until we implement all
-  /// fixed width types.
+  /// For keys can part-normalized(Varchar, Varbinary), we store the leading
+  /// bytes and a tie-break flag in prefix, and only compare the rows with
+  /// RowContainer`s compare method when the prefixes are equal.
   /// For complex types, e.g. ROW that can be converted to scalar types will be
   /// supported.
   /// 4. Extract the original row address ptr from prefixes (previously stored
@@ -146,7 +166,10 @@ class PrefixSort {
     }
     VELOX_DCHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        rowContainer->keyTypes(),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with inline std-sort.
     if (sortLayout.noNormalizedKeys) {
@@ -39,6 +39,11 @@ static int32_t typeKindSize(TypeKind kind) {
   return VELOX_DYNAMIC_TYPE_DISPATCH(kindSize, kind);
 }
 
+// Types whose values can be stored in columnar chunks outside of the rows.
+bool isColumnarType(const Type& type) {
+  return type.isFixedWidth() && type.kind() != TypeKind::UNKNOWN;
+}
+
 #if defined(__has_feature)
 #if __has_feature(thread_sanitizer)
 __attribute__((__no_sanitize__("thread")))
@@ -140,13 +145,15 @@ RowContainer::RowContainer(
     bool hasProbedFlag,
     bool hasNormalizedKeys,
     memory::MemoryPool* pool,
-    std::shared_ptr<HashStringAllocator> stringAllocator)
+    std::shared_ptr<HashStringAllocator> stringAllocator,
+    bool columnarDependents)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       isJoinBuild_(isJoinBuild),
       accumulators_(accumulators),
       hasNormalizedKeys_(hasNormalizedKeys),
       rows_(pool),
+      columnarData_(pool),
       stringAllocator_(
           stringAllocator ? stringAllocator
                           : std::make_shared<HashStringAllocator>(pool)) {
@@ -171,6 +178,12 @@ RowContainer::RowContainer(
   // build side, the pointer to the next row with the same key is after the
   // optional row size.
   //
+  // With 'columnarDependents', the values of fixed width dependent fields are
+  // not in the row but in chunks of 'kColumnarChunkRows' rows allocated from
+  // 'columnarData_'. Their null flags stay in the row. A uint64_t reference
+  // to the chunk and the position of the row in it follows the dependent
+  // fields that remain in the row.
+  //
   // In most cases, rows are prefixed with a normalized_key_t at index
   // -1, 8 bytes below the pointer. This space is reserved for a 64
   // bit unique digest of the keys for speeding up comparison. This
@@ -242,10 +255,31 @@ RowContainer::RowContainer(
     offsets_.push_back(offset);
     offset += accumulator.fixedWidthSize();
   }
+  // Offset of the values of each dependent in a columnar chunk or
+  // RowColumn::kNotColumnar.
+  std::vector<int32_t> columnarOffsets;
   for (auto& type : dependentTypes) {
+    if (columnarDependents && isColumnarType(*type)) {
+      columnarOffsets.push_back(columnarRowSize_ * kColumnarChunkRows);
+      columnarRowSize_ += typeKindSize(type->kind());
+      // Set to the offset of the columnar reference below.
+      offsets_.push_back(0);
+      continue;
+    }
+    columnarOffsets.push_back(RowColumn::kNotColumnar);
     offsets_.push_back(offset);
     offset += typeKindSize(type->kind());
   }
+  if (columnarRowSize_ > 0) {
+    columnarReferenceOffset_ = offset;
+    offset += sizeof(uint64_t);
+    const auto firstDependent = offsets_.size() - columnarOffsets.size();
+    for (auto i = 0; i < columnarOffsets.size(); ++i) {
+      if (columnarOffsets[i] != RowColumn::kNotColumnar) {
+        offsets_[firstDependent + i] = columnarReferenceOffset_;
+      }
+    }
+  }
   if (isVariableWidth) {
     rowSizeOffset_ = offset;
     offset += sizeof(uint32_t);
@@ -268,11 +302,14 @@ RowContainer::RowContainer(
       : 0;
   normalizedKeySize_ = originalNormalizedKeySize_;
   size_t nullOffsetsPos = 0;
+  const int32_t firstDependent = keyTypes_.size() + accumulators.size();
   for (auto i = 0; i < offsets_.size(); ++i) {
     rowColumns_.emplace_back(
         offsets_[i],
         (nullableKeys_ || i >= keyTypes_.size()) ? nullOffsets_[nullOffsetsPos]
-                                                 : RowColumn::kNotNullOffset);
+                                                 : RowColumn::kNotNullOffset,
+        i >= firstDependent ? columnarOffsets[i - firstDependent]
+                            : RowColumn::kNotColumnar);
 
     // offsets_ contains the offsets for keys, then accumulators, then dependent
     // columns.  This captures the case where i is the index of an accumulator.
@@ -305,10 +342,26 @@ char* RowContainer::newRow() {
     if (normalizedKeySize_) {
       ++numRowsWithNormalizedKey_;
     }
+    // Rows from the free list keep their columnar position.
+    if (columnarReferenceOffset_) {
+      setColumnarReference(row);
+    }
   }
   return initializeRow(row, false /* reuse */);
 }
 
+void RowContainer::setColumnarReference(char* row) {
+  if (columnarChunk_ == nullptr ||
+      numColumnarChunkRows_ == kColumnarChunkRows) {
+    columnarChunk_ =
+        columnarData_.allocateFixed(columnarRowSize_ * kColumnarChunkRows, 16);
+    numColumnarChunkRows_ = 0;
+  }
+  valueAt<uint64_t>(row, columnarReferenceOffset_) =
+      reinterpret_cast<uint64_t>(columnarChunk_) |
+      static_cast<uint64_t>(numColumnarChunkRows_++) << kColumnarPointerBits;
+}
+
 char* RowContainer::initializeRow(char* row, bool reuse) {
   if (reuse) {
     auto rows = folly::Range<char**>(&row, 1);
@@ -318,7 +371,13 @@ char* RowContainer::initializeRow(char* row, bool reuse) {
   } else if (rowSizeOffset_ != 0) {
     // zero out string views so that clear() will not hit uninited data. The
     // fastest way is to set the whole row to 0.
+    const auto columnarReference = columnarReferenceOffset_
+        ? valueAt<uint64_t>(row, columnarReferenceOffset_)
+        : 0;
     ::memset(row, 0, fixedRowSize_);
+    if (columnarReferenceOffset_) {
+      valueAt<uint64_t>(row, columnarReferenceOffset_) = columnarReference;
+    }
   }
   if (!nullOffsets_.empty()) {
     ::memcpy(
@@ -521,6 +580,14 @@ void RowContainer::store(
         isKey,
         row,
         offsets_[column]);
+  } else if (rowColumns_[column].isColumnar()) {
+    VELOX_DYNAMIC_TYPE_DISPATCH(
+        storeColumnar,
+        typeKinds_[column],
+        decoded,
+        index,
+        row,
+        rowColumns_[column]);
   } else {
     VELOX_DCHECK(isKey || accumulators_.empty());
     auto rowColumn = rowColumns_[column];
@@ -639,6 +706,8 @@ int32_t RowContainer::storeVariableSizeAt(
 void RowContainer::extractSerializedRows(
     folly::Range<char**> rows,
     const VectorPtr& result) {
+  VELOX_CHECK_EQ(
+      columnarRowSize_, 0, "Serialized rows need all values in the row");
   // The format of the extracted row is: null bytes followed by keys and
   // dependent columns. Fixed-width columns are serialized into fixed number of
   // bytes (see typeKindSize). Variable-width columns are serialized as 4 bytes
@@ -711,6 +780,8 @@ void RowContainer::storeSerializedRow(
     const FlatVector<StringView>& vector,
     vector_size_t index,
     char* row) {
+  VELOX_CHECK_EQ(
+      columnarRowSize_, 0, "Serialized rows need all values in the row");
   VELOX_CHECK(!vector.isNullAt(index));
   auto serialized = vector.valueAt(index);
   size_t offset = 0;
@@ -780,9 +851,12 @@ int32_t RowContainer::compareStringAsc(
     StringView left,
     const DecodedVector& decoded,
     vector_size_t index) {
+  const auto right = decoded.valueAt<StringView>(index);
+  if (auto result = left.compareInline(right)) {
+    return *result;
+  }
   std::string storage;
-  return HashStringAllocator::contiguousString(left, storage)
-      .compare(decoded.valueAt<StringView>(index));
+  return HashStringAllocator::contiguousString(left, storage).compare(right);
 }
 
 // static
@@ -799,6 +873,9 @@ int RowContainer::compareComplexType(
 }
 
 int32_t RowContainer::compareStringAsc(StringView left, StringView right) {
+  if (auto result = left.compareInline(right)) {
+    return *result;
+  }
   std::string leftStorage;
   std::string rightStorage;
   return HashStringAllocator::contiguousString(left, leftStorage)
@@ -880,6 +957,7 @@ void RowContainer::hash(
     return;
   }
 
+  VELOX_DCHECK(!rowColumns_[column].isColumnar());
   bool nullable = column >= keyTypes_.size() || nullableKeys_;
   VELOX_DYNAMIC_TYPE_DISPATCH(
       hashTyped,
@@ -904,6 +982,9 @@ void RowContainer::clear() {
     }
   }
   rows_.clear();
+  columnarData_.clear();
+  columnarChunk_ = nullptr;
+  numColumnarChunkRows_ = 0;
   if (!sharedStringAllocator) {
     if (checkFree_) {
       stringAllocator_->checkEmpty();
@@ -917,6 +998,50 @@ void RowContainer::clear() {
   firstFreeRow_ = nullptr;
 }
 
+int64_t RowContainer::compactVariableWidthData() {
+  // Accumulators and next row vectors keep pointers into the arena that can't
+  // be updated here.
+  if (!stringAllocator_.unique() || !accumulators_.empty() ||
+      usesExternalMemory_ || nextOffset_ != 0) {
+    return 0;
+  }
+  std::vector<column_index_t> columns;
+  for (auto i = 0; i < types_.size(); ++i) {
+    if (!types_[i]->isFixedWidth()) {
+      columns.push_back(i);
+    }
+  }
+  if (columns.empty()) {
+    return 0;
+  }
+
+  const auto oldRetainedSize = stringAllocator_->retainedSize();
+  const auto oldAllocator = std::exchange(
+      stringAllocator_, std::make_shared<HashStringAllocator>(pool()));
+  constexpr int32_t kBatch = 1000;
+  std::vector<char*> rows(kBatch);
+  std::string buffer;
+  RowContainerIterator iter;
+  while (auto numRows = listRows(&iter, kBatch, rows.data())) {
+    for (auto i = 0; i < numRows; ++i) {
+      char* row = rows[i];
+      // The row size is recounted from the copies in the new arena.
+      variableRowSize(row) = 0;
+      RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
+      for (const auto column : columns) {
+        if (isNullAt(row, rowColumns_[column])) {
+          continue;
+        }
+        buffer.resize(4 + variableSizeAt(row, column));
+        extractVariableSizeAt(row, column, buffer.data());
+        storeVariableSizeAt(buffer.data(), row, column);
+      }
+    }
+  }
+  return std::max<int64_t>(
+      0, oldRetainedSize - stringAllocator_->retainedSize());
+}
+
 void RowContainer::clearNextRowVectors() {
   if (hasDuplicateRows_) {
     constexpr int32_t kBatch = 1000;
@@ -979,6 +1104,7 @@ std::optional<int64_t> RowContainer::estimateRowSize() const {
   }
   int64_t freeBytes = rows_.freeBytes() + fixedRowSize_ * numFreeRows_;
   int64_t usedSize = rows_.allocatedBytes() - freeBytes +
+      columnarData_.allocatedBytes() - columnarData_.freeBytes() +
       stringAllocator_->retainedSize() - stringAllocator_->freeSpace();
   int64_t rowSize = usedSize / numRows_;
   VELOX_CHECK_GT(
@@ -995,7 +1121,8 @@ int64_t RowContainer::sizeIncrement(
   int32_t needRows = std::max<int64_t>(0, numRows - numFreeRows_);
   int64_t needBytes =
       std::max<int64_t>(0, variableLengthBytes - stringAllocator_->freeSpace());
-  return bits::roundUp(needRows * fixedRowSize_, kAllocUnit) +
+  return bits::roundUp(
+             needRows * (fixedRowSize_ + columnarRowSize_), kAllocUnit) +
       bits::roundUp(needBytes, kAllocUnit);
 }
 
@@ -1216,9 +1343,9 @@ RowComparator::RowComparator(
   }
 }
 
-bool RowComparator::operator()(const char* lhs, const char* rhs) {
+int32_t RowComparator::compare(const char* lhs, const char* rhs) {
   if (lhs == rhs) {
-    return false;
+    return 0;
   }
   for (auto& key : keyInfo_) {
     if (auto result = rowContainer_->compare(
@@ -1226,13 +1353,13 @@ bool RowComparator::operator()(const char* lhs, const char* rhs) {
             rhs,
             key.first,
             {key.second.isNullsFirst(), key.second.isAscending(), false})) {
-      return result < 0;
+      return result;
     }
   }
-  return false;
+  return 0;
 }
 
-bool RowComparator::operator()(
+int32_t RowComparator::compare(
     const std::vector<DecodedVector>& decodedVectors,
     vector_size_t index,
     const char* rhs) {
@@ -1243,9 +1370,9 @@ bool RowComparator::operator()(
             decodedVectors[key.first],
             index,
             {key.second.isNullsFirst(), key.second.isAscending(), false})) {
-      return result > 0;
+      return -result;
     }
   }
-  return false;
+  return 0;
 }
 } // namespace facebook::velox::exec
@@ -134,13 +134,33 @@ class RowColumn {
   /// Used as null offset for a non-null column.
   static constexpr int32_t kNotNullOffset = -1;
 
-  RowColumn(int32_t offset, int32_t nullOffset)
-      : packedOffsets_(PackOffsets(offset, nullOffset)) {}
+  /// Used as columnar offset for a column stored inside the row.
+  static constexpr int32_t kNotColumnar = -1;
 
+  RowColumn(
+      int32_t offset,
+      int32_t nullOffset,
+      int32_t columnarOffset = kNotColumnar)
+      : packedOffsets_(PackOffsets(offset, nullOffset)),
+        columnarOffset_(columnarOffset) {}
+
+  /// Offset of the value in the row. For a columnar column, offset of the
+  /// reference to the columnar chunk of the row.
   int32_t offset() const {
     return packedOffsets_ >> 32;
   }
 
+  /// True if the values of the column are stored in columnar chunks outside
+  /// of the rows. The null flags are always in the row.
+  bool isColumnar() const {
+    return columnarOffset_ != kNotColumnar;
+  }
+
+  /// Offset of the values of the column from the start of a columnar chunk.
+  int32_t columnarOffset() const {
+    return columnarOffset_;
+  }
+
   int32_t nullByte() const {
     return static_cast<uint32_t>(packedOffsets_) >> 8;
   }
@@ -176,6 +196,7 @@ class RowColumn {
   }
 
   const uint64_t packedOffsets_;
+  const int32_t columnarOffset_;
 };
 
 /// Collection of rows for aggregation, hash join, order by.
@@ -230,6 +251,12 @@ class RowContainer {
   /// 'stringAllocator' allows sharing the variable length data arena with
   /// another RowContainer. This is needed for spilling where the same
   /// aggregates are used for reading one container and merging into another.
+  /// 'columnarDependents' stores the values of fixed width dependent columns
+  /// in chunks of kColumnarChunkRows values per column outside of the rows,
+  /// so that extracting these columns for rows in insertion order reads
+  /// memory sequentially. The rows keep the keys, the null flags and a
+  /// reference to their position in a chunk. Only extraction and 'store'
+  /// support columnar columns, which is enough for a hash join build side.
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -240,7 +267,11 @@ class RowContainer {
       bool hasProbedFlag,
       bool hasNormalizedKey,
       memory::MemoryPool* pool,
-      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr);
+      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr,
+      bool columnarDependents = false);
+
+  /// Number of rows per chunk of columnar dependent values.
+  static constexpr int32_t kColumnarChunkRows = 1024;
 
   /// Allocates a new row and initializes possible aggregates to null.
   char* newRow();
@@ -267,6 +298,12 @@ class RowContainer {
     return fixedRowSize_;
   }
 
+  /// Bytes of columnar dependent values per row. 0 if all dependents are
+  /// stored in the rows.
+  int32_t columnarRowSize() const {
+    return columnarRowSize_;
+  }
+
   /// Adds 'rows' to the free rows list and frees any associated variable length
   /// data.
   void eraseRows(folly::Range<char**> rows);
@@ -657,7 +694,8 @@ class RowContainer {
       uint64_t* result);
 
   uint64_t allocatedBytes() const {
-    return rows_.allocatedBytes() + stringAllocator_->retainedSize();
+    return rows_.allocatedBytes() + columnarData_.allocatedBytes() +
+        stringAllocator_->retainedSize();
   }
 
   /// Returns the number of fixed size rows that can be allocated without
@@ -669,6 +707,24 @@ class RowContainer {
         stringAllocator_->freeSpace());
   }
 
+  /// Returns the percentage of the storage for out-of-line variable length
+  /// data that is free, e.g. after rows were erased.
+  int32_t variableWidthFragmentationPct() const {
+    return stringAllocator_->fragmentationPct();
+  }
+
+  /// Moves the out-of-line strings and complex type values of all rows to a
+  /// new arena and frees the old one, so that the memory of the free blocks
+  /// between the live values is returned to the pool. Both arenas are held
+  /// while copying. Does nothing if the arena is shared or has other users
+  /// than the row columns, i.e. accumulators or next row vectors. Returns the
+  /// number of bytes released.
+  int64_t compactVariableWidthData();
+
+  /// Name of the runtime stat for variableWidthFragmentationPct().
+  static inline const std::string kVariableWidthFragmentationPct{
+      "variableWidthFragmentationPct"};
+
   /// Returns the average size of rows in bytes stored in this container.
   std::optional<int64_t> estimateRowSize() const;
 
@@ -774,6 +830,9 @@ class RowContainer {
   // Offset of the pointer to the next free row on a free row.
   static constexpr int32_t kNextFreeOffset = 0;
 
+  // Number of low bits of a columnar reference that hold the chunk address.
+  static constexpr uint8_t kColumnarPointerBits = 48;
+
   template <typename T>
   static inline T valueAt(const char* group, int32_t offset) {
     return *reinterpret_cast<const T*>(group + offset);
@@ -784,6 +843,22 @@ class RowContainer {
     return *reinterpret_cast<T*>(group + offset);
   }
 
+  // Returns the address of the value of the columnar 'column' of 'row'.
+  // 'width' is the size of a value. The reference in the row has the
+  // address of the chunk in the low bits and the position of the row in
+  // the chunk in the high bits.
+  static inline const char*
+  columnarValueAt(const char* row, RowColumn column, int32_t width) {
+    const auto reference = valueAt<uint64_t>(row, column.offset());
+    return reinterpret_cast<const char*>(
+               reference & bits::lowMask(kColumnarPointerBits)) +
+        column.columnarOffset() + (reference >> kColumnarPointerBits) * width;
+  }
+
+  // Assigns the next free position in the current columnar chunk to 'row'.
+  // Starts a new chunk if the current one is full.
+  void setColumnarReference(char* row);
+
   /// Returns the size of a string or complex types value stored in the
   /// specified row and column.
   int32_t variableSizeAt(const char* row, column_index_t column);
@@ -842,6 +917,11 @@ class RowContainer {
     }
     using T = typename KindToFlatVector<Kind>::HashRowType;
     auto* flatResult = result->as<FlatVector<T>>();
+    if (column.isColumnar()) {
+      extractColumnarValues<useRowNumbers, T>(
+          rows, rowNumbers, numRows, column, resultOffset, flatResult);
+      return;
+    }
     auto nullMask = column.nullMask();
     auto offset = column.offset();
     if (!nullMask) {
@@ -894,6 +974,24 @@ class RowContainer {
     }
   }
 
+  template <TypeKind Kind>
+  inline void storeColumnar(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* row,
+      RowColumn column) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    // The chunks and the values of each column in a chunk are 16 byte
+    // aligned, so that the values can be accessed directly.
+    auto* value = const_cast<char*>(columnarValueAt(row, column, sizeof(T)));
+    if (decoded.isNullAt(index)) {
+      row[column.nullByte()] |= column.nullMask();
+      *reinterpret_cast<T*>(value) = T();
+      return;
+    }
+    *reinterpret_cast<T*>(value) = decoded.valueAt<T>(index);
+  }
+
   template <TypeKind Kind>
   inline void storeNoNulls(
       const DecodedVector& decoded,
@@ -983,6 +1081,42 @@ class RowContainer {
     }
   }
 
+  // Copies the values of the columnar 'column' of 'rows' into 'result'. The
+  // values of consecutive rows in insertion order are adjacent in memory.
+  template <bool useRowNumbers, typename T>
+  static void extractColumnarValues(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      RowColumn column,
+      int32_t resultOffset,
+      FlatVector<T>* result) {
+    auto maxRows = numRows + resultOffset;
+    VELOX_DCHECK_LE(maxRows, result->size());
+
+    BufferPtr& nullBuffer = result->mutableNulls(maxRows);
+    auto nulls = nullBuffer->asMutable<uint64_t>();
+    BufferPtr valuesBuffer = result->mutableValues(maxRows);
+    auto values = valuesBuffer->asMutableRange<T>();
+    for (int32_t i = 0; i < numRows; ++i) {
+      const char* row;
+      if constexpr (useRowNumbers) {
+        auto rowNumber = rowNumbers[i];
+        row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
+      } else {
+        row = rows[i];
+      }
+      auto resultIndex = resultOffset + i;
+      if (row == nullptr || isNullAt(row, column)) {
+        bits::setNull(nulls, resultIndex, true);
+      } else {
+        bits::setNull(nulls, resultIndex, false);
+        values[resultIndex] =
+            valueAt<T>(columnarValueAt(row, column, sizeof(T)), 0);
+      }
+    }
+  }
+
   static ByteInputStream prepareRead(const char* row, int32_t offset);
 
   template <TypeKind Kind>
@@ -1023,8 +1157,12 @@ class RowContainer {
       return compareComplexType(row, offset, decoded, index) == 0;
     }
     if constexpr (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
-      return compareStringAsc(
-                 valueAt<StringView>(row, offset), decoded, index) == 0;
+      const auto left = valueAt<StringView>(row, offset);
+      if (auto result =
+              left.compareInline(decoded.valueAt<StringView>(index))) {
+        return *result == 0;
+      }
+      return compareStringAsc(left, decoded, index) == 0;
     }
 
     using T = typename KindToFlatVector<Kind>::HashRowType;
@@ -1296,6 +1434,17 @@ class RowContainer {
   uint64_t numFreeRows_ = 0;
 
   memory::AllocationPool rows_;
+  // Chunks of columnar dependent values. Each chunk has kColumnarChunkRows
+  // values of each columnar column, one column after the other.
+  memory::AllocationPool columnarData_;
+  // Offset of the reference to the columnar values of the row. 0 if there
+  // are no columnar columns.
+  int32_t columnarReferenceOffset_ = 0;
+  int32_t columnarRowSize_ = 0;
+  // Chunk that receives the values of new rows and the number of rows
+  // assigned to it.
+  char* columnarChunk_ = nullptr;
+  int32_t numColumnarChunkRows_ = 0;
   std::shared_ptr<HashStringAllocator> stringAllocator_;
 
   int alignment_ = 1;
@@ -1569,10 +1718,25 @@ class RowComparator {
       RowContainer* rowContainer);
 
   /// Returns true if lhs < rhs, false otherwise.
-  bool operator()(const char* lhs, const char* rhs);
+  bool operator()(const char* lhs, const char* rhs) {
+    return compare(lhs, rhs) < 0;
+  }
 
   /// Returns true if decodeVectors[index] < rhs, false otherwise.
   bool operator()(
+      const std::vector<DecodedVector>& decodedVectors,
+      vector_size_t index,
+      const char* rhs) {
+    return compare(decodedVectors, index, rhs) < 0;
+  }
+
+  /// Returns a negative value if lhs < rhs, 0 if the sorting keys of the rows
+  /// are equal and a positive value otherwise.
+  int32_t compare(const char* lhs, const char* rhs);
+
+  /// Compares decodedVectors[index] with rhs. Returns a negative value, 0 or a
+  /// positive value if the former is less than, equal to or greater than rhs.
+  int32_t compare(
       const std::vector<DecodedVector>& decodedVectors,
       vector_size_t index,
       const char* rhs);
@@ -19,6 +19,44 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+
+bool isStringKind(TypeKind kind) {
+  return kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+}
+
+// Copies the keys of 'rows' of 'input' to the rows of 'keys' starting at
+// 'offset'. Strings are copied into the buffers of 'keys' so that 'keys'
+// does not hold on to the string buffers of every input batch.
+void copyKeys(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const RowVector& input,
+    const std::vector<vector_size_t>& rows,
+    vector_size_t offset,
+    RowVector& keys) {
+  for (auto i = 0; i < hashers.size(); ++i) {
+    const auto* source = input.childAt(hashers[i]->channel())->loadedVector();
+    auto* target = keys.childAt(i).get();
+    if (isStringKind(hashers[i]->typeKind())) {
+      DecodedVector decoded(*source);
+      auto* flat = target->asFlatVector<StringView>();
+      for (auto j = 0; j < rows.size(); ++j) {
+        if (decoded.isNullAt(rows[j])) {
+          flat->setNull(offset + j, true);
+        } else {
+          flat->set(offset + j, decoded.valueAt<StringView>(rows[j]));
+        }
+      }
+    } else {
+      for (auto j = 0; j < rows.size(); ++j) {
+        target->copy(source, offset + j, rows[j], 1);
+      }
+    }
+  }
+}
+
+} // namespace
+
 RowNumber::RowNumber(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -33,27 +71,28 @@ RowNumber::RowNumber(
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       limit_{rowNumberNode->limit()},
-      generateRowNumber_{rowNumberNode->generateRowNumber()} {
+      generateRowNumber_{rowNumberNode->generateRowNumber()},
+      partitionKeys_{rowNumberNode->partitionKeys()} {
   const auto& inputType = rowNumberNode->sources()[0]->outputType();
-  const auto& keys = rowNumberNode->partitionKeys();
-  const auto numKeys = keys.size();
-
-  if (numKeys > 0) {
-    table_ = std::make_unique<HashTable<false>>(
-        createVectorHashers(inputType, keys),
-        std::vector<Accumulator>{},
-        std::vector<TypePtr>{BIGINT()},
-        false, // allowDuplicates
-        false, // isJoinBuild
-        false, // hasProbedFlag
-        0, // minTableSizeForParallelJoinBuild
-        pool());
-    lookup_ = std::make_unique<HashLookup>(table_->hashers());
 
-    const auto numRowsColumn = table_->rows()->columnAt(numKeys);
-    numRowsOffset_ = numRowsColumn.offset();
-
-    inputType_ = rowNumberNode->sources()[0]->outputType();
+  if (!partitionKeys_.empty()) {
+    inputType_ = inputType;
+    arrayMode_ = !spillEnabled();
+    for (const auto& key : partitionKeys_) {
+      arrayMode_ &=
+          VectorHasher::typeKindSupportsValueIds(key->type()->kind());
+    }
+    if (arrayMode_) {
+      arrayHashers_ = createVectorHashers(inputType_, partitionKeys_);
+      std::vector<TypePtr> keyTypes;
+      for (const auto& hasher : arrayHashers_) {
+        keyTypes.push_back(hasher->type());
+      }
+      arrayKeys_ = BaseVector::create<RowVector>(
+          ROW(std::move(keyTypes)), 0, pool());
+    } else {
+      createHashTable();
+    }
   }
 
   identityProjections_.reserve(inputType->size());
@@ -71,9 +110,175 @@ RowNumber::RowNumber(
   }
 }
 
+void RowNumber::createHashTable() {
+  table_ = std::make_unique<HashTable<false>>(
+      createVectorHashers(inputType_, partitionKeys_),
+      std::vector<Accumulator>{},
+      std::vector<TypePtr>{BIGINT()},
+      false, // allowDuplicates
+      false, // isJoinBuild
+      false, // hasProbedFlag
+      0, // minTableSizeForParallelJoinBuild
+      pool());
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
+
+  const auto numRowsColumn = table_->rows()->columnAt(partitionKeys_.size());
+  numRowsOffset_ = numRowsColumn.offset();
+}
+
+void RowNumber::addPartitions(
+    const RowVectorPtr& keys,
+    const int64_t* counts,
+    int8_t startPartitionBit) {
+  // Transform 'keys' to match 'inputType_' so it can be added to the
+  // 'table_'. Move partition-by columns and leave other columns unset.
+  std::vector<VectorPtr> columns(inputType_->size());
+
+  const auto& hashers = table_->hashers();
+  for (auto i = 0; i < hashers.size(); ++i) {
+    columns[hashers[i]->channel()] = keys->childAt(i);
+  }
+
+  auto input = std::make_shared<RowVector>(
+      pool(), inputType_, nullptr, keys->size(), std::move(columns));
+
+  const auto numInput = input->size();
+  SelectivityVector rows(numInput);
+  table_->prepareForGroupProbe(*lookup_, input, rows, false, startPartitionBit);
+  table_->groupProbe(*lookup_);
+
+  for (auto i = 0; i < numInput; ++i) {
+    setNumRows(lookup_->hits[i], counts[i]);
+  }
+}
+
+bool RowNumber::assignArrayPartitions(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  arrayRows_.resize(numInput);
+  arrayRows_.setAll();
+  arrayPartitions_.resize(numInput);
+
+  bool rehash = false;
+  for (auto& hasher : arrayHashers_) {
+    hasher->decode(
+        *input->childAt(hasher->channel())->loadedVector(), arrayRows_);
+    if (!hasher->computeValueIds(arrayRows_, arrayPartitions_)) {
+      rehash = true;
+    }
+  }
+  // The index is allocated on first use also when no rehash is needed, e.g.
+  // for boolean keys or a first batch whose keys are all null.
+  if ((rehash || arrayIndex_ == nullptr) &&
+      !rehashArrayPartitions(numInput)) {
+    return false;
+  }
+
+  // Replace the value ids with partition numbers, numbering new partitions
+  // in order of appearance.
+  auto* index = arrayIndex_->asMutable<int32_t>();
+  const auto numPartitions = arrayCounts_.size();
+  std::vector<vector_size_t> newPartitionRows;
+  for (auto i = 0; i < numInput; ++i) {
+    auto& partition = index[arrayPartitions_[i]];
+    if (partition == 0) {
+      newPartitionRows.push_back(i);
+      partition = numPartitions + newPartitionRows.size();
+    }
+    arrayPartitions_[i] = partition - 1;
+  }
+
+  if (!newPartitionRows.empty()) {
+    const auto newNumPartitions = numPartitions + newPartitionRows.size();
+    arrayCounts_.resize(newNumPartitions, 0);
+    if (arrayKeys_->size() < newNumPartitions) {
+      arrayKeys_->resize(std::max<vector_size_t>(
+          newNumPartitions, 2 * arrayKeys_->size()));
+    }
+    copyKeys(
+        arrayHashers_, *input, newPartitionRows, numPartitions, *arrayKeys_);
+  }
+  return true;
+}
+
+bool RowNumber::rehashArrayPartitions(vector_size_t numInput) {
+  // Leave room for 50% more values like a group by hash table. Use ranges
+  // unless the distinct values take less space. Booleans are always ranges.
+  constexpr int32_t kReservePct = 50;
+  std::vector<bool> useRange(arrayHashers_.size());
+  uint64_t size = 1;
+  for (auto i = 0; i < arrayHashers_.size(); ++i) {
+    uint64_t asRange;
+    uint64_t asDistincts;
+    arrayHashers_[i]->cardinality(kReservePct, asRange, asDistincts);
+    useRange[i] = asRange <= asDistincts;
+    const auto hasherSize = std::min(asRange, asDistincts);
+    if (hasherSize == VectorHasher::kRangeTooLarge ||
+        __builtin_mul_overflow(size, hasherSize, &size) ||
+        size > BaseHashTable::kArrayHashMaxSize) {
+      return false;
+    }
+  }
+
+  uint64_t multiplier = 1;
+  for (auto i = 0; i < arrayHashers_.size(); ++i) {
+    multiplier = useRange[i]
+        ? arrayHashers_[i]->enableValueRange(multiplier, kReservePct)
+        : arrayHashers_[i]->enableValueIds(multiplier, kReservePct);
+    VELOX_CHECK_NE(multiplier, VectorHasher::kRangeTooLarge);
+  }
+
+  // The hashers still have the input decoded.
+  SelectivityVector rows(numInput);
+  for (auto& hasher : arrayHashers_) {
+    VELOX_CHECK(hasher->computeValueIds(rows, arrayPartitions_));
+  }
+
+  arrayIndex_ = AlignedBuffer::allocate<int32_t>(multiplier, pool(), 0);
+  const auto numPartitions = arrayCounts_.size();
+  if (numPartitions == 0) {
+    return true;
+  }
+  SelectivityVector partitionRows(numPartitions);
+  raw_vector<uint64_t> valueIds(numPartitions);
+  for (auto i = 0; i < arrayHashers_.size(); ++i) {
+    arrayHashers_[i]->decode(*arrayKeys_->childAt(i), partitionRows);
+    VELOX_CHECK(arrayHashers_[i]->computeValueIds(partitionRows, valueIds));
+  }
+  auto* index = arrayIndex_->asMutable<int32_t>();
+  for (auto i = 0; i < numPartitions; ++i) {
+    index[valueIds[i]] = i + 1;
+  }
+  return true;
+}
+
+void RowNumber::switchToHashTable() {
+  createHashTable();
+  if (!arrayCounts_.empty()) {
+    arrayKeys_->resize(arrayCounts_.size());
+    addPartitions(
+        arrayKeys_,
+        arrayCounts_.data(),
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+  }
+
+  arrayMode_ = false;
+  arrayHashers_.clear();
+  arrayIndex_.reset();
+  arrayKeys_.reset();
+  arrayCounts_ = {};
+}
+
 void RowNumber::addInput(RowVectorPtr input) {
   const auto numInput = input->size();
 
+  if (arrayMode_) {
+    if (assignArrayPartitions(input)) {
+      input_ = std::move(input);
+      return;
+    }
+    switchToHashTable();
+  }
+
   if (table_) {
     ensureInputFits(input);
 
@@ -151,31 +356,10 @@ void RowNumber::restoreNextSpillPartition() {
 
     RowVectorPtr data;
     while (spillHashTableReader_->nextBatch(data)) {
-      // 'data' contains partition-by keys and count. Transform 'data' to match
-      // 'inputType_' so it can be added to the 'table_'. Move partition-by
-      // columns and leave other columns unset.
-      std::vector<VectorPtr> columns(inputType_->size());
-
-      const auto& hashers = table_->hashers();
-      for (auto i = 0; i < hashers.size(); ++i) {
-        columns[hashers[i]->channel()] = data->childAt(i);
-      }
-
-      auto input = std::make_shared<RowVector>(
-          pool(), inputType_, nullptr, data->size(), std::move(columns));
-
-      const auto numInput = input->size();
-      SelectivityVector rows(numInput);
-      table_->prepareForGroupProbe(
-          *lookup_, input, rows, false, spillConfig_->startPartitionBit);
-      table_->groupProbe(*lookup_);
-
+      // 'data' contains partition-by keys and count.
       auto* counts = data->children().back()->as<FlatVector<int64_t>>();
-
-      for (auto i = 0; i < numInput; ++i) {
-        auto* partition = lookup_->hits[i];
-        setNumRows(partition, counts->valueAt(i));
-      }
+      addPartitions(
+          data, counts->rawValues(), spillConfig_->startPartitionBit);
     }
   }
 
@@ -282,7 +466,7 @@ RowVectorPtr RowNumber::getOutput() {
     }
   }
 
-  if (!table_) {
+  if (!table_ && !arrayMode_) {
     // No partition keys.
     return getOutputForSinglePartition();
   }
@@ -304,8 +488,8 @@ RowVectorPtr RowNumber::getOutput() {
   }
 
   for (auto i = 0; i < numInput; ++i) {
-    auto* partition = lookup_->hits[i];
-    const auto rowNumber = numRows(partition) + 1;
+    auto& count = partitionCount(i);
+    const auto rowNumber = count + 1;
 
     if (limit_) {
       if (rowNumber > limit_) {
@@ -318,7 +502,7 @@ RowVectorPtr RowNumber::getOutput() {
     if (generateRowNumber_) {
       rowNumbers->set(i, rowNumber);
     }
-    setNumRows(partition, rowNumber);
+    count = rowNumber;
   }
 
   RowVectorPtr output;
@@ -438,9 +622,8 @@ void RowNumber::setupInputSpiller(
 
   const auto& spillConfig = spillConfig_.value();
 
-  // TODO Replace Spiller::Type::kHashJoinProbe.
   inputSpiller_ = std::make_unique<Spiller>(
-      Spiller::Type::kHashJoinProbe,
+      Spiller::Type::kPartitionedInput,
       inputType_,
       spillPartitionBits_,
       &spillConfig,
@@ -475,44 +658,7 @@ void RowNumber::spill() {
 void RowNumber::spillInput(
     const RowVectorPtr& input,
     memory::MemoryPool* pool) {
-  const auto numInput = input->size();
-
-  std::vector<uint32_t> spillPartitions(numInput);
-  const auto singlePartition =
-      spillHashFunction_->partition(*input, spillPartitions);
-
-  const auto numPartitions = spillHashFunction_->numPartitions();
-
-  std::vector<BufferPtr> partitionIndices(numPartitions);
-  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
-
-  for (auto i = 0; i < numPartitions; ++i) {
-    partitionIndices[i] = allocateIndices(numInput, pool);
-    rawPartitionIndices[i] = partitionIndices[i]->asMutable<vector_size_t>();
-  }
-
-  std::vector<vector_size_t> numSpillInputs(numPartitions, 0);
-
-  for (auto row = 0; row < numInput; ++row) {
-    const auto partition = singlePartition.has_value() ? singlePartition.value()
-                                                       : spillPartitions[row];
-    rawPartitionIndices[partition][numSpillInputs[partition]++] = row;
-  }
-
-  // Ensure vector are lazy loaded before spilling.
-  for (auto i = 0; i < input->childrenSize(); ++i) {
-    input->childAt(i)->loadedVector();
-  }
-
-  for (int32_t partition = 0; partition < numSpillInputs.size(); ++partition) {
-    const auto numInputs = numSpillInputs[partition];
-    if (numInputs == 0) {
-      continue;
-    }
-
-    inputSpiller_->spill(
-        partition, wrap(numInputs, partitionIndices[partition], input));
-  }
+  spillByPartition(*inputSpiller_, *spillHashFunction_, input, pool);
 }
 
 void RowNumber::recursiveSpillInput() {
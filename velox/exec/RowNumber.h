@@ -74,6 +74,38 @@ class RowNumber : public Operator {
 
   void setNumRows(char* partition, int64_t numRows);
 
+  // Returns the number of rows seen so far in the partition of row 'row' of
+  // 'input_'.
+  int64_t& partitionCount(vector_size_t row) {
+    if (arrayMode_) {
+      return arrayCounts_[arrayPartitions_[row]];
+    }
+    return *reinterpret_cast<int64_t*>(lookup_->hits[row] + numRowsOffset_);
+  }
+
+  void createHashTable();
+
+  // Adds the partitions with keys in the leading columns of 'keys' and row
+  // counts in 'counts' to 'table_'.
+  void addPartitions(
+      const RowVectorPtr& keys,
+      const int64_t* counts,
+      int8_t startPartitionBit);
+
+  // Sets 'arrayPartitions_' to the partition number of each row of 'input'
+  // in array mode. Returns false if the value ids of the keys seen so far no
+  // longer fit into an array.
+  bool assignArrayPartitions(const RowVectorPtr& input);
+
+  // Chooses range or distinct value ids for each of 'arrayHashers_' after
+  // 'arrayHashers_' failed to map a key, and rebuilds 'arrayIndex_' for the
+  // existing partitions. Returns false if the ids do not fit into an array.
+  // 'numInput' is the number of rows of the input the hashers decoded last.
+  bool rehashArrayPartitions(vector_size_t numInput);
+
+  // Leaves array mode and moves the partitions into 'table_'.
+  void switchToHashTable();
+
   RowVectorPtr getOutputForSinglePartition();
 
   FlatVector<int64_t>& getOrCreateRowNumberVector(vector_size_t size);
@@ -98,12 +130,37 @@ class RowNumber : public Operator {
   const std::optional<int32_t> limit_;
   const bool generateRowNumber_;
 
+  const std::vector<core::FieldAccessTypedExprPtr> partitionKeys_;
+
   // Hash table to store number of rows seen so far per partition. Not used if
-  // there are no partitioning keys.
+  // there are no partitioning keys or in array mode.
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
   int32_t numRowsOffset_;
 
+  // True if the partitions are numbered using the value ids of
+  // 'arrayHashers_' instead of being kept in 'table_'. Used when spilling is
+  // disabled, since spilling needs the rows of 'table_', and all the keys
+  // map to value ids. Switches to 'table_' once the value ids of the keys
+  // seen so far exceed BaseHashTable::kArrayHashMaxSize.
+  bool arrayMode_{false};
+  std::vector<std::unique_ptr<VectorHasher>> arrayHashers_;
+
+  // Partition number + 1 for each value id, 0 for the ids not seen yet.
+  BufferPtr arrayIndex_;
+
+  // The keys of each partition, indexed by partition number. Used to
+  // rebuild 'arrayIndex_' when the value ids change.
+  RowVectorPtr arrayKeys_;
+
+  // The number of rows seen so far in each partition.
+  std::vector<int64_t> arrayCounts_;
+
+  // The partition number of each row of 'input_'.
+  raw_vector<uint64_t> arrayPartitions_;
+
+  SelectivityVector arrayRows_;
+
   // Total number of input rows. Used when there are no partitioning keys and
   // therefore no hash table.
   int64_t numTotalInput_{0};
@@ -16,6 +16,9 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+
+#include <array>
+
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/AddressableNonNullValueList.h"
 #include "velox/exec/Strings.h"
@@ -27,15 +30,27 @@ namespace facebook::velox::aggregate::prestosql {
 
 namespace detail {
 
-/// Maintains a set of unique values. Non-null values are stored in F14FastSet.
-/// A separate flag tracks presence of the null value.
+/// Maintains a set of unique values. Non-null values are stored in an inline
+/// array while there are at most kMaxInline of them, then in F14FastMap. Most
+/// groups of set_agg and similar aggregations have few distinct values, which
+/// then take no memory outside of the accumulator. A separate flag tracks
+/// presence of the null value.
 template <
     typename T,
     typename Hash = std::hash<T>,
     typename EqualTo = std::equal_to<T>>
 struct SetAccumulator {
+  /// The number of values stored inline, so that they take about 64 bytes.
+  static constexpr int32_t kMaxInline =
+      std::max<int32_t>(1, 64 / sizeof(std::pair<T, int32_t>));
+
   std::optional<vector_size_t> nullIndex;
 
+  /// The first kMaxInline unique values and their positions. Used while
+  /// 'uniqueValues' is empty.
+  std::array<std::pair<T, int32_t>, kMaxInline> inlineValues;
+  int32_t numInline{0};
+
   folly::F14FastMap<
       T,
       int32_t,
@@ -56,19 +71,68 @@ struct SetAccumulator {
             AlignedStlAllocator<std::pair<const T, vector_size_t>, 16>(
                 allocator)} {}
 
+  /// Returns the number of unique non-null values.
+  size_t numValues() const {
+    return uniqueValues.empty() ? numInline : uniqueValues.size();
+  }
+
+  bool contains(const T& value) const {
+    if (!uniqueValues.empty()) {
+      return uniqueValues.contains(value);
+    }
+    const auto& equalTo = uniqueValues.key_eq();
+    for (auto i = 0; i < numInline; ++i) {
+      if (equalTo(inlineValues[i].first, value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Adds non-null 'value' at 'position' in the output. Returns false if the
+  /// value was added before.
+  bool insert(const T& value, int32_t position) {
+    if (uniqueValues.empty()) {
+      if (contains(value)) {
+        return false;
+      }
+      if (numInline < kMaxInline) {
+        inlineValues[numInline++] = {value, position};
+        return true;
+      }
+      for (auto i = 0; i < numInline; ++i) {
+        uniqueValues.insert(inlineValues[i]);
+      }
+    }
+    return uniqueValues.insert({value, position}).second;
+  }
+
+  /// Calls 'func(value, position)' for each unique non-null value.
+  template <typename Func>
+  void forEachValue(Func func) const {
+    if (uniqueValues.empty()) {
+      for (auto i = 0; i < numInline; ++i) {
+        func(inlineValues[i].first, inlineValues[i].second);
+      }
+    } else {
+      for (const auto& [value, position] : uniqueValues) {
+        func(value, position);
+      }
+    }
+  }
+
   /// Adds value if new. No-op if the value was added before.
   void addValue(
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* /*allocator*/) {
-    const auto cnt = uniqueValues.size();
+    const auto cnt = numValues();
     if (decoded.isNullAt(index)) {
       if (!nullIndex.has_value()) {
         nullIndex = cnt;
       }
     } else {
-      uniqueValues.insert(
-          {decoded.valueAt<T>(index), nullIndex.has_value() ? cnt + 1 : cnt});
+      insert(decoded.valueAt<T>(index), nullIndex.has_value() ? cnt + 1 : cnt);
     }
   }
 
@@ -93,9 +157,9 @@ struct SetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* /*allocator*/) {
-    const auto cnt = uniqueValues.size();
+    const auto cnt = numValues();
     if (!decoded.isNullAt(index)) {
-      uniqueValues.insert({decoded.valueAt<T>(index), cnt});
+      insert(decoded.valueAt<T>(index), cnt);
     }
   }
 
@@ -116,22 +180,21 @@ struct SetAccumulator {
 
   /// Returns number of unique values including null.
   size_t size() const {
-    return uniqueValues.size() + (nullIndex.has_value() ? 1 : 0);
+    return numValues() + (nullIndex.has_value() ? 1 : 0);
   }
 
   /// Copies the unique values and null into the specified vector starting at
   /// the specified offset.
   vector_size_t extractValues(FlatVector<T>& values, vector_size_t offset) {
-    for (auto value : uniqueValues) {
-      values.set(offset + value.second, value.first);
-    }
+    forEachValue([&](const T& value, int32_t position) {
+      values.set(offset + position, value);
+    });
 
     if (nullIndex.has_value()) {
       values.setNull(offset + nullIndex.value(), true);
     }
 
-    return nullIndex.has_value() ? uniqueValues.size() + 1
-                                 : uniqueValues.size();
+    return size();
   }
 
   void free(HashStringAllocator& allocator) {
@@ -155,7 +218,7 @@ struct StringViewSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
+    const auto cnt = base.numValues();
     if (decoded.isNullAt(index)) {
       if (!base.nullIndex.has_value()) {
         base.nullIndex = cnt;
@@ -163,13 +226,12 @@ struct StringViewSetAccumulator {
     } else {
       auto value = decoded.valueAt<StringView>(index);
       if (!value.isInline()) {
-        if (base.uniqueValues.contains(value)) {
+        if (base.contains(value)) {
           return;
         }
         value = strings.append(value, *allocator);
       }
-      base.uniqueValues.insert(
-          {value, base.nullIndex.has_value() ? cnt + 1 : cnt});
+      base.insert(value, base.nullIndex.has_value() ? cnt + 1 : cnt);
     }
   }
 
@@ -191,16 +253,16 @@ struct StringViewSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
+    const auto cnt = base.numValues();
     if (!decoded.isNullAt(index)) {
       auto value = decoded.valueAt<StringView>(index);
       if (!value.isInline()) {
-        if (base.uniqueValues.contains(value)) {
+        if (base.contains(value)) {
           return;
         }
         value = strings.append(value, *allocator);
       }
-      base.uniqueValues.insert({value, cnt});
+      base.insert(value, cnt);
     }
   }
 
@@ -257,7 +319,7 @@ struct ComplexTypeSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
+    const auto cnt = base.numValues();
     if (decoded.isNullAt(index)) {
       if (!base.nullIndex.has_value()) {
         base.nullIndex = cnt;
@@ -265,9 +327,7 @@ struct ComplexTypeSetAccumulator {
     } else {
       auto entry = values.append(decoded, index, allocator);
 
-      if (!base.uniqueValues
-               .insert({entry, base.nullIndex.has_value() ? cnt + 1 : cnt})
-               .second) {
+      if (!base.insert(entry, base.nullIndex.has_value() ? cnt + 1 : cnt)) {
         values.removeLast(entry);
       }
     }
@@ -291,11 +351,11 @@ struct ComplexTypeSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
+    const auto cnt = base.numValues();
     if (!decoded.isNullAt(index)) {
       auto entry = values.append(decoded, index, allocator);
 
-      if (!base.uniqueValues.insert({entry, cnt}).second) {
+      if (!base.insert(entry, cnt)) {
         values.removeLast(entry);
       }
     }
@@ -320,16 +380,15 @@ struct ComplexTypeSetAccumulator {
   }
 
   vector_size_t extractValues(BaseVector& values, vector_size_t offset) {
-    for (const auto& position : base.uniqueValues) {
-      AddressableNonNullValueList::read(
-          position.first, values, offset + position.second);
-    }
+    base.forEachValue([&](const auto& entry, int32_t position) {
+      AddressableNonNullValueList::read(entry, values, offset + position);
+    });
 
     if (base.nullIndex.has_value()) {
       values.setNull(offset + base.nullIndex.value(), true);
     }
 
-    return base.uniqueValues.size() + (base.nullIndex.has_value() ? 1 : 0);
+    return base.size();
   }
 
   void free(HashStringAllocator& allocator) {
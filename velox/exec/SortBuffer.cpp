@@ -32,7 +32,8 @@ SortBuffer::SortBuffer(
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       spillConfig_(spillConfig),
-      spillStats_(spillStats) {
+      spillStats_(spillStats),
+      memoryForecast_(pool) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -116,14 +117,7 @@ void SortBuffer::noMoreInput() {
         sortedRows_.begin(),
         sortedRows_.end(),
         [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
+          return compareRows(leftRow, rightRow) < 0;
         });
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
@@ -137,6 +131,7 @@ void SortBuffer::noMoreInput() {
 
   // Releases the unused memory reservation after procesing input.
   pool_->release();
+  memoryForecast_.set(0);
 }
 
 RowVectorPtr SortBuffer::getOutput(uint32_t maxOutputRows) {
@@ -176,6 +171,36 @@ std::optional<uint64_t> SortBuffer::estimateOutputRowSize() const {
   return estimatedOutputRowSize_;
 }
 
+const std::vector<char*>& SortBuffer::sortedRows() const {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_EQ(sortedRows_.size(), numInputRows_);
+  return sortedRows_;
+}
+
+int32_t SortBuffer::compareRows(const char* left, const char* right) const {
+  for (vector_size_t index = 0; index < sortCompareFlags_.size(); ++index) {
+    if (auto result =
+            data_->compare(left, right, index, sortCompareFlags_[index])) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+void SortBuffer::extractRows(
+    folly::Range<char* const*> rows,
+    const RowVectorPtr& result) const {
+  VELOX_CHECK_EQ(rows.size(), result->size());
+  for (const auto& columnProjection : columnMap_) {
+    RowContainer::extractColumn(
+        rows.data(),
+        rows.size(),
+        data_->columnAt(columnProjection.inputChannel),
+        result->childAt(columnProjection.outputChannel));
+  }
+}
+
 void SortBuffer::ensureInputFits(const VectorPtr& input) {
   // Check if spilling is enabled or not.
   if (spillConfig_ == nullptr) {
@@ -200,6 +225,10 @@ void SortBuffer::ensureInputFits(const VectorPtr& input) {
   }
 
   const auto currentMemoryUsage = pool_->usedBytes();
+  // Forecasts the peak usage from the observed bytes per input row, assuming
+  // at least as many input rows are still to come as have been seen.
+  const auto bytesPerRow = currentMemoryUsage / numInputRows_;
+  memoryForecast_.set(2 * (numInputRows_ + input->size()) * bytesPerRow);
   const auto minReservationBytes =
       currentMemoryUsage * spillConfig_->minSpillableReservationPct / 100;
   const auto availableReservationBytes = pool_->availableReservation();
@@ -312,11 +341,6 @@ void SortBuffer::prepareOutput(uint32_t maxOutputRows) {
     child->resize(batchSize);
   }
 
-  if (spiller_ != nullptr) {
-    spillSources_.resize(maxOutputRows);
-    spillSourceRows_.resize(maxOutputRows);
-  }
-
   VELOX_CHECK_GT(output_->size(), 0);
   VELOX_DCHECK_LE(output_->size(), maxOutputRows);
   VELOX_CHECK_LE(output_->size() + numOutputRows_, numInputRows_);
@@ -338,43 +362,28 @@ void SortBuffer::getOutputWithSpill() {
   VELOX_CHECK_NOT_NULL(spillMerger_);
   VELOX_DCHECK_EQ(sortedRows_.size(), 0);
 
-  int32_t outputRow = 0;
-  int32_t outputSize = 0;
-  bool isEndOfBatch = false;
-  while (outputRow + outputSize < output_->size()) {
-    SpillMergeStream* stream = spillMerger_->next();
+  // Copy out the consecutive rows of the winning stream which sort before the
+  // runner-up as one range.
+  vector_size_t outputRow = 0;
+  while (outputRow < output_->size()) {
+    auto [stream, runnerUp] = spillMerger_->nextWithRunnerUp();
     VELOX_CHECK_NOT_NULL(stream);
 
-    spillSources_[outputSize] = &stream->current();
-    spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
-    ++outputSize;
-    if (FOLLY_UNLIKELY(isEndOfBatch)) {
-      // The stream is at end of input batch. Need to copy out the rows before
-      // fetching next batch in 'pop'.
-      gatherCopy(
-          output_.get(),
-          outputRow,
-          outputSize,
-          spillSources_,
-          spillSourceRows_,
-          columnMap_);
-      outputRow += outputSize;
-      outputSize = 0;
+    const auto numRows =
+        stream->numRunRows(runnerUp, output_->size() - outputRow);
+    const BaseVector::CopyRange range{
+        stream->currentIndex(), outputRow, numRows};
+    for (const auto& columnProjection : columnMap_) {
+      output_->childAt(columnProjection.outputChannel)
+          ->copyRanges(
+              stream->current().childAt(columnProjection.inputChannel).get(),
+              folly::Range(&range, 1));
     }
+    outputRow += numRows;
     // Advance the stream.
-    stream->pop();
-  }
-  VELOX_CHECK_EQ(outputRow + outputSize, output_->size());
-
-  if (FOLLY_LIKELY(outputSize != 0)) {
-    gatherCopy(
-        output_.get(),
-        outputRow,
-        outputSize,
-        spillSources_,
-        spillSourceRows_,
-        columnMap_);
+    stream->pop(numRows);
   }
+  VELOX_CHECK_EQ(outputRow, output_->size());
 
   numOutputRows_ += output_->size();
 }
@@ -64,6 +64,22 @@ class SortBuffer {
 
   std::optional<uint64_t> estimateOutputRowSize() const;
 
+  /// Returns the rows in sorted order. Must be called after noMoreInput() on a
+  /// sort buffer that has not spilled.
+  const std::vector<char*>& sortedRows() const;
+
+  /// Compares the sort keys of 'left' and 'right'. Returns 0 for equal, < 0 for
+  /// left < right and > 0 otherwise. The rows may come from another sort
+  /// buffer with the same input type and sort keys as it has the same row
+  /// layout.
+  int32_t compareRows(const char* left, const char* right) const;
+
+  /// Copies 'rows' into 'result' which has the input type of this sort buffer.
+  /// The rows may come from another sort buffer with the same input type and
+  /// sort keys.
+  void extractRows(folly::Range<char* const*> rows, const RowVectorPtr& result)
+      const;
+
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
@@ -89,6 +105,8 @@ class SortBuffer {
   tsan_atomic<bool>* const nonReclaimableSection_;
   const common::SpillConfig* const spillConfig_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
+  // The forecast peak memory usage published to the query memory pool.
+  memory::MemoryForecast memoryForecast_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -109,9 +127,6 @@ class SortBuffer {
   std::unique_ptr<Spiller> spiller_;
   // Used to merge the sorted runs from in-memory rows and spilled rows on disk.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerger_;
-  // Records the source rows to copy to 'output_' in order.
-  std::vector<const RowVector*> spillSources_;
-  std::vector<vector_size_t> spillSourceRows_;
 
   // Reusable output vector.
   RowVectorPtr output_;
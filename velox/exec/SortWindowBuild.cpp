@@ -16,6 +16,7 @@
 
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/TreeOfLosers.h"
 
 namespace facebook::velox::exec {
 
@@ -37,6 +38,34 @@ std::vector<CompareFlags> makeSpillCompareFlags(
 
   return compareFlags;
 }
+
+// The sorted rows of one build to merge with the sorted rows of the builds of
+// the other drivers.
+template <typename Less>
+class SortedRowStream : public MergeStream {
+ public:
+  SortedRowStream(const Less& less, folly::Range<char**> rows)
+      : less_(less), rows_(rows) {}
+
+  bool hasData() const override {
+    return !rows_.empty();
+  }
+
+  bool operator<(const MergeStream& other) const override {
+    const auto& otherRows = static_cast<const SortedRowStream&>(other).rows_;
+    return less_(rows_.front(), otherRows.front());
+  }
+
+  char* pop() {
+    auto* row = rows_.front();
+    rows_.advance(1);
+    return row;
+  }
+
+ private:
+  const Less& less_;
+  folly::Range<char**> rows_;
+};
 } // namespace
 
 SortWindowBuild::SortWindowBuild(
@@ -320,6 +349,96 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
       data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
 }
 
+void SortWindowBuild::mergePeers(
+    std::vector<std::unique_ptr<SortWindowBuild>> peers) {
+  VELOX_CHECK(!spilled());
+  VELOX_CHECK_EQ(currentPartition_, -1);
+
+  const auto less = [this](const char* lhs, const char* rhs) {
+    return compareRowsWithKeys(lhs, rhs, allKeyInfo_);
+  };
+  using Stream = SortedRowStream<decltype(less)>;
+  std::vector<std::unique_ptr<Stream>> streams;
+  auto numRows = numRows_;
+  if (!sortedRows_.empty()) {
+    streams.push_back(std::make_unique<Stream>(
+        less, folly::Range(sortedRows_.data(), sortedRows_.size())));
+  }
+  for (auto& peer : peers) {
+    VELOX_CHECK(!peer->spilled());
+    numRows += peer->numRows_;
+    if (!peer->sortedRows_.empty()) {
+      streams.push_back(std::make_unique<Stream>(
+          less,
+          folly::Range(peer->sortedRows_.data(), peer->sortedRows_.size())));
+    }
+  }
+
+  std::vector<char*> sortedRows;
+  sortedRows.reserve(numRows);
+  if (!streams.empty()) {
+    TreeOfLosers<Stream> merger(std::move(streams));
+    while (auto* stream = merger.next()) {
+      sortedRows.push_back(stream->pop());
+    }
+  }
+  VELOX_CHECK_EQ(sortedRows.size(), numRows);
+
+  sortedRows_ = std::move(sortedRows);
+  numRows_ = numRows;
+  for (auto& peer : peers) {
+    peer->sortedRows_.clear();
+    peer->partitionStartRows_.clear();
+    peers_.push_back(std::move(peer));
+  }
+  partitionStartRows_.clear();
+  if (numRows_ > 0) {
+    computePartitionStartRows();
+  }
+}
+
+std::vector<vector_size_t> SortWindowBuild::splitPartitions(
+    uint32_t numRanges) const {
+  VELOX_CHECK_GT(numRanges, 0);
+  const vector_size_t numPartitions =
+      partitionStartRows_.empty() ? 0 : partitionStartRows_.size() - 1;
+  std::vector<vector_size_t> rangeStarts;
+  rangeStarts.reserve(numRanges + 1);
+  rangeStarts.push_back(0);
+  for (auto range = 1; range < numRanges; ++range) {
+    // The range starts with the first partition at or after its share of the
+    // rows.
+    const int64_t firstRow = int64_t{numRows_} * range / numRanges;
+    rangeStarts.push_back(
+        std::lower_bound(
+            partitionStartRows_.begin() + rangeStarts.back(),
+            partitionStartRows_.begin() + numPartitions,
+            firstRow) -
+        partitionStartRows_.begin());
+  }
+  rangeStarts.push_back(numPartitions);
+  return rangeStarts;
+}
+
+vector_size_t SortWindowBuild::numPartitionRows(
+    vector_size_t begin,
+    vector_size_t end) const {
+  if (begin == end) {
+    return 0;
+  }
+  return partitionStartRows_[end] - partitionStartRows_[begin];
+}
+
+std::unique_ptr<WindowPartition> SortWindowBuild::partitionAt(
+    vector_size_t index) {
+  VELOX_CHECK_LT(index + 1, partitionStartRows_.size());
+  auto partition = folly::Range(
+      sortedRows_.data() + partitionStartRows_[index],
+      partitionStartRows_[index + 1] - partitionStartRows_[index]);
+  return std::make_unique<WindowPartition>(
+      data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
+}
+
 bool SortWindowBuild::hasNextPartition() {
   if (merge_ != nullptr) {
     loadNextPartitionFromSpill();
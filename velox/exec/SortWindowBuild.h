@@ -55,6 +55,31 @@ class SortWindowBuild : public WindowBuild {
 
   std::unique_ptr<WindowPartition> nextPartition() override;
 
+  /// Merges the sorted rows of 'peers', the builds of the other drivers of the
+  /// same Window, with the rows of this build so that each window partition
+  /// holds the rows of all the drivers. Takes ownership of 'peers' to keep
+  /// their rows alive. All the builds must have received noMoreInput() and
+  /// must not have spilled. The builds share the row layout, so the rows of
+  /// all of them are read through 'data_'.
+  void mergePeers(std::vector<std::unique_ptr<SortWindowBuild>> peers);
+
+  /// Splits the window partitions into 'numRanges' contiguous ranges with
+  /// about the same number of rows. Returns the first partition of each range
+  /// followed by the number of partitions.
+  std::vector<vector_size_t> splitPartitions(uint32_t numRanges) const;
+
+  /// Returns the number of rows in partitions [begin, end).
+  vector_size_t numPartitionRows(vector_size_t begin, vector_size_t end) const;
+
+  /// Returns the 'index'th window partition. Unlike nextPartition(), this
+  /// doesn't change the state of the build, so that the drivers sharing the
+  /// build can read their partitions concurrently.
+  std::unique_ptr<WindowPartition> partitionAt(vector_size_t index);
+
+  bool spilled() const {
+    return spiller_ != nullptr;
+  }
+
  private:
   void ensureInputFits(const RowVectorPtr& input);
 
@@ -114,6 +139,10 @@ class SortWindowBuild : public WindowBuild {
 
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
+
+  // The builds of the other drivers whose rows are merged into 'sortedRows_'.
+  // See mergePeers().
+  std::vector<std::unique_ptr<SortWindowBuild>> peers_;
 };
 
 } // namespace facebook::velox::exec
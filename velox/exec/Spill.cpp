@@ -23,24 +23,107 @@
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
+namespace {
+// Max number of bytes of the normalized key prefix of a spilled row.
+constexpr uint32_t kMaxSpillPrefixSize = 64;
+
+// Number of leading bytes of a string sort key stored in the prefix.
+constexpr uint32_t kSpillPrefixStringLength = 16;
+
+// Encodes 'numRows' values of 'vector' into the prefixes starting at
+// 'prefixes', which are 'prefixSize' bytes apart.
+template <typename T>
+void encodePrefixColumn(
+    const BaseVector& vector,
+    vector_size_t numRows,
+    const prefixsort::PrefixSortEncoder& encoder,
+    uint32_t prefixSize,
+    char* prefixes) {
+  DecodedVector decoded(vector);
+  for (auto row = 0; row < numRows; ++row) {
+    encoder.encode(
+        decoded.isNullAt(row) ? std::nullopt
+                              : std::optional<T>(decoded.valueAt<T>(row)),
+        prefixes + row * prefixSize);
+  }
+}
+
+void encodeStringPrefixColumn(
+    const BaseVector& vector,
+    vector_size_t numRows,
+    const prefixsort::PrefixSortEncoder& encoder,
+    uint32_t encodedSize,
+    uint32_t prefixSize,
+    char* prefixes) {
+  DecodedVector decoded(vector);
+  for (auto row = 0; row < numRows; ++row) {
+    encoder.encode(
+        decoded.isNullAt(row)
+            ? std::nullopt
+            : std::optional<StringView>(decoded.valueAt<StringView>(row)),
+        prefixes + row * prefixSize,
+        encodedSize);
+  }
+}
+} // namespace
+
 void SpillMergeStream::pop() {
   if (++index_ >= size_) {
     setNextBatch();
   }
 }
 
+void SpillMergeStream::pop(vector_size_t numRows) {
+  VELOX_DCHECK_LE(index_ + numRows, size_);
+  index_ += numRows;
+  if (index_ >= size_) {
+    setNextBatch();
+  }
+}
+
 int32_t SpillMergeStream::compare(const MergeStream& other) const {
-  auto& otherStream = static_cast<const SpillMergeStream&>(other);
-  auto& children = rowVector_->children();
-  auto& otherChildren = otherStream.current().children();
+  return compareAt(index_, static_cast<const SpillMergeStream&>(other));
+}
+
+vector_size_t SpillMergeStream::numRunRows(
+    const SpillMergeStream* other,
+    vector_size_t maxRows) const {
+  VELOX_DCHECK(hasData());
+  const auto numRows = std::min(maxRows, size_ - index_);
+  if (other == nullptr) {
+    return numRows;
+  }
+  return mergeRunLength(numRows, [&](int32_t row) {
+    return compareAt(index_ + row, *other) <= 0;
+  });
+}
+
+int32_t SpillMergeStream::compareAt(
+    vector_size_t index,
+    const SpillMergeStream& other) const {
   int32_t key = 0;
+  // The streams of a merge have the same row type and sort keys, hence the
+  // same prefix layout.
+  if (prefixSize_ != 0 && other.prefixSize_ != 0) {
+    const auto result =
+        memcmp(prefixAt(index), other.prefixAt(other.index_), prefixSize_);
+    if (result != 0) {
+      return result;
+    }
+    if (compareStartKey_ == numSortKeys()) {
+      return 0;
+    }
+    key = compareStartKey_;
+  }
+  auto& children = rowVector_->children();
+  auto& otherChildren = other.current().children();
   if (sortCompareFlags().empty()) {
     do {
       auto result = children[key]
                         ->compare(
                             otherChildren[key].get(),
-                            index_,
-                            otherStream.index_,
+                            index,
+                            other.index_,
                             CompareFlags())
                         .value();
       if (result != 0) {
@@ -52,8 +135,8 @@ int32_t SpillMergeStream::compare(const MergeStream& other) const {
       auto result = children[key]
                         ->compare(
                             otherChildren[key].get(),
-                            index_,
-                            otherStream.index_,
+                            index,
+                            other.index_,
                             sortCompareFlags()[key])
                         .value();
       if (result != 0) {
@@ -76,7 +159,8 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* writeExecutor)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -89,6 +173,7 @@ SpillState::SpillState(
       fileCreateConfig_(fileCreateConfig),
       pool_(pool),
       stats_(stats),
+      writeExecutor_(writeExecutor),
       partitionWriters_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(uint32_t partition) {
@@ -132,7 +217,8 @@ uint64_t SpillState::appendToPartition(
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        writeExecutor_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -230,6 +316,19 @@ std::vector<std::unique_ptr<SpillPartition>> SpillPartition::split(
   return shards;
 }
 
+std::unique_ptr<SpillPartition> SpillPartition::splitFiles(int numFiles) {
+  VELOX_CHECK_GT(numFiles, 0);
+  numFiles = std::min<int>(numFiles, files_.size());
+  SpillFiles files;
+  files.reserve(numFiles);
+  for (int i = 0; i < numFiles; ++i) {
+    size_ -= files_[i].size;
+    files.push_back(std::move(files_[i]));
+  }
+  files_.erase(files_.begin(), files_.begin() + numFiles);
+  return std::make_unique<SpillPartition>(id_, std::move(files));
+}
+
 std::string SpillPartition::toString() const {
   return fmt::format(
       "SPILLED PARTITION[ID:{} FILES:{} SIZE:{}]",
@@ -255,6 +354,87 @@ SpillPartition::createUnorderedReader(
       std::move(streams));
 }
 
+void SpillMergeStream::initializePrefix() {
+  prefixInitialized_ = true;
+  const auto& rowType = rowVector_->type()->asRow();
+  const auto& compareFlags = sortCompareFlags();
+  int32_t key = 0;
+  for (; key < numSortKeys(); ++key) {
+    const auto flags =
+        compareFlags.empty() ? CompareFlags() : compareFlags[key];
+    if (flags.nullHandlingMode !=
+        CompareFlags::NullHandlingMode::kNullAsValue) {
+      break;
+    }
+    const auto kind = rowType.childAt(key)->kind();
+    const auto encodedSize = prefixsort::PrefixSortEncoder::encodedSize(
+        kind, kSpillPrefixStringLength);
+    if (!encodedSize.has_value() ||
+        prefixSize_ + encodedSize.value() > kMaxSpillPrefixSize) {
+      break;
+    }
+    prefixOffsets_.push_back(prefixSize_);
+    prefixEncodedSizes_.push_back(encodedSize.value());
+    prefixEncoders_.push_back({flags.ascending, flags.nullsFirst});
+    prefixSize_ += encodedSize.value();
+    if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+      break;
+    }
+  }
+  compareStartKey_ = key;
+}
+
+void SpillMergeStream::encodePrefixes() {
+  if (!prefixInitialized_) {
+    initializePrefix();
+  }
+  if (prefixSize_ == 0) {
+    return;
+  }
+  prefixes_.resize(size_ * prefixSize_);
+  for (auto key = 0; key < prefixEncoders_.size(); ++key) {
+    const auto& keyVector = *rowVector_->childAt(key);
+    const auto& encoder = prefixEncoders_[key];
+    char* const prefixes = prefixes_.data() + prefixOffsets_[key];
+    switch (keyVector.typeKind()) {
+      case TypeKind::INTEGER:
+        encodePrefixColumn<int32_t>(
+            keyVector, size_, encoder, prefixSize_, prefixes);
+        break;
+      case TypeKind::BIGINT:
+        encodePrefixColumn<int64_t>(
+            keyVector, size_, encoder, prefixSize_, prefixes);
+        break;
+      case TypeKind::REAL:
+        encodePrefixColumn<float>(
+            keyVector, size_, encoder, prefixSize_, prefixes);
+        break;
+      case TypeKind::DOUBLE:
+        encodePrefixColumn<double>(
+            keyVector, size_, encoder, prefixSize_, prefixes);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodePrefixColumn<Timestamp>(
+            keyVector, size_, encoder, prefixSize_, prefixes);
+        break;
+      case TypeKind::VARCHAR:
+        [[fallthrough]];
+      case TypeKind::VARBINARY:
+        encodeStringPrefixColumn(
+            keyVector,
+            size_,
+            encoder,
+            prefixEncodedSizes_[key],
+            prefixSize_,
+            prefixes);
+        break;
+      default:
+        VELOX_UNREACHABLE(
+            "Unsupported prefix key type: {}", keyVector.type()->toString());
+    }
+  }
+}
+
 std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
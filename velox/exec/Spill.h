@@ -27,6 +27,7 @@
 #include "velox/exec/SpillFile.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/UnorderedStreamReader.h"
+#include "velox/exec/prefixsort/PrefixSortEncoder.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorStream.h"
@@ -53,6 +54,21 @@ class SpillMergeStream : public MergeStream {
 
   void pop();
 
+  /// Advances past 'numRows' rows of the current batch and loads the next batch
+  /// if the current one is used up. 'numRows' must not exceed the number of
+  /// remaining rows in the current batch.
+  void pop(vector_size_t numRows);
+
+  /// Returns the number of consecutive rows from the current one in the
+  /// current batch which sort before or equal to the current row of 'other',
+  /// but no more than 'maxRows'. If 'other' is null, returns the number of
+  /// remaining rows in the current batch capped at 'maxRows'. 'this' must be
+  /// the stream returned by the merge and 'other' the runner-up as returned
+  /// by TreeOfLosers::nextWithRunnerUp(), so that the current row always
+  /// counts.
+  vector_size_t numRunRows(const SpillMergeStream* other, vector_size_t maxRows)
+      const;
+
   const RowVector& current() const {
     return *rowVector_;
   }
@@ -75,6 +91,10 @@ class SpillMergeStream : public MergeStream {
   }
 
  protected:
+  // Compares the row at 'index' of the current batch with the current row of
+  // 'other'.
+  int32_t compareAt(vector_size_t index, const SpillMergeStream& other) const;
+
   virtual int32_t numSortKeys() const = 0;
 
   virtual const std::vector<CompareFlags>& sortCompareFlags() const = 0;
@@ -82,6 +102,7 @@ class SpillMergeStream : public MergeStream {
   virtual void nextBatch() = 0;
 
   // loads the next 'rowVector' and sets 'decoded_' if this is initialized.
+  // Encodes the normalized key prefixes of the new batch.
   void setNextBatch() {
     nextBatch();
     if (!decoded_.empty()) {
@@ -90,6 +111,9 @@ class SpillMergeStream : public MergeStream {
         decoded_[i].decode(*rowVector_->childAt(i), rows_);
       }
     }
+    if (size_ > 0) {
+      encodePrefixes();
+    }
   }
 
   void ensureDecodedValid(int32_t index) {
@@ -125,6 +149,39 @@ class SpillMergeStream : public MergeStream {
 
   // Covers all rows inn 'rowVector_' Set if 'decoded_' is non-empty.
   SelectivityVector rows_;
+
+ private:
+  // Sets up the normalized key prefix layout from the types and compare flags
+  // of the sort keys. The prefix covers the leading sort keys supported by
+  // PrefixSortEncoder. A string key is the last one in the prefix as its
+  // prefix doesn't decide the order of the rows on ties.
+  void initializePrefix();
+
+  // Encodes the normalized key prefixes of all rows in 'rowVector_'.
+  void encodePrefixes();
+
+  const char* prefixAt(vector_size_t index) const {
+    return prefixes_.data() + index * prefixSize_;
+  }
+
+  bool prefixInitialized_{false};
+
+  // Number of bytes of the normalized key prefix per row. 0 if the first sort
+  // key can't be normalized.
+  uint32_t prefixSize_{0};
+
+  // The first sort key compared by value when the prefixes of two rows tie.
+  // Equals numSortKeys() if equal prefixes imply equal sort keys.
+  int32_t compareStartKey_{0};
+
+  std::vector<prefixsort::PrefixSortEncoder> prefixEncoders_;
+
+  // Offsets and encoded sizes of the normalized keys in a prefix.
+  std::vector<uint32_t> prefixOffsets_;
+  std::vector<uint32_t> prefixEncodedSizes_;
+
+  // The prefixes of the rows in 'rowVector_', 'prefixSize_' bytes each.
+  std::vector<char> prefixes_;
 };
 
 // A source of spilled RowVectors coming from a file.
@@ -134,7 +191,7 @@ class FileSpillMergeStream : public SpillMergeStream {
       std::unique_ptr<SpillReadFile> spillFile) {
     auto spillStream = std::unique_ptr<SpillMergeStream>(
         new FileSpillMergeStream(std::move(spillFile)));
-    static_cast<FileSpillMergeStream*>(spillStream.get())->nextBatch();
+    static_cast<FileSpillMergeStream*>(spillStream.get())->setNextBatch();
     return spillStream;
   }
 
@@ -277,6 +334,10 @@ class SpillPartition {
     return files_.size();
   }
 
+  const SpillFiles& files() const {
+    return files_;
+  }
+
   /// Returns the total file byte size of this spilled partition.
   uint64_t size() const {
     return size_;
@@ -288,6 +349,13 @@ class SpillPartition {
   /// NOTE: the split spill partition shards will have the same id as this.
   std::vector<std::unique_ptr<SpillPartition>> split(int numShards);
 
+  /// Invoked to move up to the first 'numFiles' spill files of this spill
+  /// partition into a new one. This is used to restore a large spill partition
+  /// a few files at a time.
+  ///
+  /// NOTE: the returned spill partition has the same id as this.
+  std::unique_ptr<SpillPartition> splitFiles(int numFiles);
+
   /// Invoked to create an unordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file system
@@ -345,7 +413,8 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* writeExecutor = nullptr);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -442,6 +511,7 @@ class SpillState {
   const std::string fileCreateConfig_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
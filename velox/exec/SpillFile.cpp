@@ -15,9 +15,18 @@
  */
 
 #include "velox/exec/SpillFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include <folly/String.h>
+
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 
+DECLARE_bool(velox_spill_read_mmap);
+DECLARE_bool(velox_spill_zstd_dictionary);
+
 namespace facebook::velox::exec {
 namespace {
 // Spilling currently uses the default PrestoSerializer which by default
@@ -26,6 +35,38 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// Bytes of uncompressed pages buffered to train the dictionary of a spill
+// file on, split into samples of 'kDictionarySampleSize'.
+constexpr uint64_t kDictionarySampleBytes = 1 << 20;
+constexpr size_t kDictionarySampleSize = 4 << 10;
+constexpr size_t kMaxDictionarySize = 64 << 10;
+// Favors speed as spill data is read back once.
+constexpr int32_t kDictionaryCompressionLevel = 1;
+// A page compressed with a dictionary is prefixed by its uncompressed and
+// compressed sizes.
+constexpr size_t kDictionaryPageHeaderSize = 2 * sizeof(int32_t);
+
+// Maps 'size' bytes of 'file' for read if FLAGS_velox_spill_read_mmap is set
+// and 'file' is on the local file system. Returns nullptr if not mapped.
+char* mapSpillFile(const ReadFile& file, uint64_t size) {
+  if (!FLAGS_velox_spill_read_mmap || size == 0) {
+    return nullptr;
+  }
+  const auto* localFile = dynamic_cast<const LocalReadFile*>(&file);
+  if (localFile == nullptr) {
+    return nullptr;
+  }
+  void* data =
+      ::mmap(nullptr, size, PROT_READ, MAP_SHARED, localFile->fd(), 0);
+  if (data == MAP_FAILED) {
+    LOG(WARNING) << "Failed to map spill file " << file.getName() << ": "
+                 << folly::errnoStr(errno);
+    return nullptr;
+  }
+  ::madvise(data, size, MADV_SEQUENTIAL);
+  return reinterpret_cast<char*>(data);
+}
 } // namespace
 
 SpillInputStream::SpillInputStream(
@@ -37,12 +78,17 @@ SpillInputStream::SpillInputStream(
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize - AlignedBuffer::kPaddedSize)),
       pool_(pool),
-      readaEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()),
+      mappedData_(mapSpillFile(*file_, fileSize_)),
+      readaEnabled_(
+          (mappedData_ == nullptr) && (bufferSize_ < fileSize_) &&
+          file_->hasPreadvAsync()),
       stats_(stats) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(
       bufferSize, AlignedBuffer::kPaddedSize, "Buffer size is too small");
-  buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
+  if (mappedData_ == nullptr) {
+    buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
+  }
   if (readaEnabled_) {
     buffers_.push_back(AlignedBuffer::allocate<char>(bufferSize_, pool_));
   }
@@ -50,6 +96,15 @@ SpillInputStream::SpillInputStream(
 }
 
 SpillInputStream::~SpillInputStream() {
+  if (mappedData_ != nullptr) {
+    ::munmap(mappedData_, fileSize_);
+    ::posix_fadvise(
+        static_cast<const LocalReadFile*>(file_.get())->fd(),
+        0,
+        0,
+        POSIX_FADV_DONTNEED);
+    return;
+  }
   if (!readaWait_.valid()) {
     return;
   }
@@ -62,6 +117,10 @@ SpillInputStream::~SpillInputStream() {
 }
 
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
+  if (mappedData_ != nullptr) {
+    nextMapped();
+    return;
+  }
   int32_t readBytes{0};
   uint64_t readTimeUs{0};
   if (readaWait_.valid()) {
@@ -90,6 +149,24 @@ void SpillInputStream::next(bool /*throwIfPastEnd*/) {
   maybeIssueReadahead();
 }
 
+void SpillInputStream::nextMapped() {
+  const int32_t readBytes = readSize();
+  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+  if (offset_ > 0) {
+    // The data of the previous window has been deserialized, so its pages are
+    // not needed in the page cache any more.
+    const auto consumedBytes = std::min(offset_, bufferSize_);
+    ::posix_fadvise(
+        static_cast<const LocalReadFile*>(file_.get())->fd(),
+        offset_ - consumedBytes,
+        consumedBytes,
+        POSIX_FADV_DONTNEED);
+  }
+  setRange({reinterpret_cast<uint8_t*>(mappedData_ + offset_), readBytes, 0});
+  updateSpillStats(readBytes, 0);
+  offset_ += readBytes;
+}
+
 uint64_t SpillInputStream::readSize() const {
   return std::min(fileSize_ - offset_, bufferSize_);
 }
@@ -172,26 +249,40 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* writeExecutor)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
+      useDictionary_(
+          FLAGS_velox_spill_zstd_dictionary &&
+          compressionKind_ == common::CompressionKind_ZSTD),
       pathPrefix_(pathPrefix),
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      writeExecutor_(writeExecutor) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
+SpillWriter::~SpillWriter() {
+  if (pendingWrite_.has_value()) {
+    // The file and buffer are referenced by the write, so it must complete
+    // before they are freed. Errors were reported by the caller already.
+    std::move(*pendingWrite_).wait();
+  }
+}
+
 SpillWriteFile* SpillWriter::ensureFile() {
-  if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
+  if ((currentFile_ != nullptr) &&
+      (currentFile_->size() + sampleBytes_ > targetFileSize_)) {
     closeFile();
   }
   if (currentFile_ == nullptr) {
@@ -207,6 +298,18 @@ void SpillWriter::closeFile() {
   if (currentFile_ == nullptr) {
     return;
   }
+  if (!samplePages_.empty()) {
+    // The file ended before there were enough samples to train on.
+    waitForPendingWrite();
+    uint64_t flushTimeUs{0};
+    std::unique_ptr<folly::IOBuf> pages;
+    {
+      MicrosecondTimer timer(&flushTimeUs);
+      pages = trainDictionary();
+    }
+    writeToFile(currentFile_.get(), std::move(pages), flushTimeUs);
+  }
+  waitForPendingWrite();
   currentFile_->finish();
   updateSpilledFileStats(currentFile_->size());
   finishedFiles_.push_back(SpillFileInfo{
@@ -216,7 +319,8 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .compressionDictionary = std::move(dictionary_)});
   currentFile_.reset();
 }
 
@@ -229,9 +333,6 @@ uint64_t SpillWriter::flush() {
     return 0;
   }
 
-  auto* file = ensureFile();
-  VELOX_CHECK_NOT_NULL(file);
-
   IOBufOutputStream out(
       *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
   uint64_t flushTimeUs{0};
@@ -240,10 +341,53 @@ uint64_t SpillWriter::flush() {
     batch_->flush(&out);
   }
   batch_.reset();
+  auto iobuf = out.getIOBuf();
+
+  // The previous write overlapped with serializing 'iobuf'. It must complete
+  // before the next write so that the file size is known and the writes stay
+  // in order.
+  waitForPendingWrite();
+  auto* file = ensureFile();
+  VELOX_CHECK_NOT_NULL(file);
+
+  if (useDictionary_) {
+    MicrosecondTimer timer(&flushTimeUs);
+    iobuf = compressWithDictionary(std::move(iobuf));
+  }
+  if (iobuf == nullptr) {
+    // Buffered as a sample to train the dictionary of 'file' on.
+    return 0;
+  }
+  return writeToFile(file, std::move(iobuf), flushTimeUs);
+}
+
+uint64_t SpillWriter::writeToFile(
+    SpillWriteFile* file,
+    std::unique_ptr<folly::IOBuf> iobuf,
+    uint64_t flushTimeUs) {
+  if (writeExecutor_ != nullptr) {
+    const auto writtenBytes = iobuf->computeChainDataLength();
+    auto [promise, future] = folly::makePromiseContract<WriteResult>();
+    writeExecutor_->add([file,
+                         flushTimeUs,
+                         iobuf = std::move(iobuf),
+                         promise = std::move(promise)]() mutable {
+      promise.setWith([&]() {
+        WriteResult result;
+        result.flushTimeUs = flushTimeUs;
+        {
+          MicrosecondTimer timer(&result.writeTimeUs);
+          result.writtenBytes = file->write(std::move(iobuf));
+        }
+        return result;
+      });
+    });
+    pendingWrite_ = std::move(future);
+    return writtenBytes;
+  }
 
   uint64_t writeTimeUs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     MicrosecondTimer timer(&writeTimeUs);
     writtenBytes = file->write(std::move(iobuf));
@@ -253,6 +397,76 @@ uint64_t SpillWriter::flush() {
   return writtenBytes;
 }
 
+std::unique_ptr<folly::IOBuf> SpillWriter::compressWithDictionary(
+    std::unique_ptr<folly::IOBuf> page) {
+  if (dictionary_ != nullptr) {
+    return compressPage(*page);
+  }
+  sampleBytes_ += page->computeChainDataLength();
+  samplePages_.push_back(std::move(page));
+  if (sampleBytes_ < kDictionarySampleBytes) {
+    return nullptr;
+  }
+  return trainDictionary();
+}
+
+std::unique_ptr<folly::IOBuf> SpillWriter::trainDictionary() {
+  VELOX_CHECK_NULL(dictionary_);
+  VELOX_CHECK(!samplePages_.empty());
+  // Training needs many samples, so the pages are split into chunks.
+  std::vector<std::string_view> samples;
+  for (auto& page : samplePages_) {
+    const auto data = page->coalesce();
+    for (size_t offset = 0; offset < data.size();
+         offset += kDictionarySampleSize) {
+      samples.emplace_back(
+          reinterpret_cast<const char*>(data.data()) + offset,
+          std::min(kDictionarySampleSize, data.size() - offset));
+    }
+  }
+  dictionary_ = common::ZstdDictionary::train(
+      samples, kMaxDictionarySize, kDictionaryCompressionLevel);
+
+  std::unique_ptr<folly::IOBuf> pages;
+  for (auto& page : samplePages_) {
+    auto compressed = compressPage(*page);
+    if (pages == nullptr) {
+      pages = std::move(compressed);
+    } else {
+      pages->prependChain(std::move(compressed));
+    }
+  }
+  samplePages_.clear();
+  sampleBytes_ = 0;
+  return pages;
+}
+
+std::unique_ptr<folly::IOBuf> SpillWriter::compressPage(folly::IOBuf& page) {
+  const auto data = page.coalesce();
+  const auto bound = common::ZstdDictionary::compressBound(data.size());
+  auto compressed = folly::IOBuf::create(kDictionaryPageHeaderSize + bound);
+  auto* header = reinterpret_cast<int32_t*>(compressed->writableData());
+  const auto compressedSize = dictionary_->compress(
+      std::string_view(reinterpret_cast<const char*>(data.data()), data.size()),
+      reinterpret_cast<char*>(header) + kDictionaryPageHeaderSize,
+      bound);
+  header[0] = data.size();
+  header[1] = compressedSize;
+  compressed->append(kDictionaryPageHeaderSize + compressedSize);
+  return compressed;
+}
+
+void SpillWriter::waitForPendingWrite() {
+  if (!pendingWrite_.has_value()) {
+    return;
+  }
+  auto future = std::move(*pendingWrite_);
+  pendingWrite_.reset();
+  const auto result = std::move(future).get();
+  updateWriteStats(result.writtenBytes, result.flushTimeUs, result.writeTimeUs);
+  updateAndCheckSpillLimitCb_(result.writtenBytes);
+}
+
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
@@ -263,7 +477,9 @@ uint64_t SpillWriter::write(
     MicrosecondTimer timer(&timeUs);
     if (batch_ == nullptr) {
       serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+          kDefaultUseLosslessTimestamp,
+          useDictionary_ ? common::CompressionKind_NONE : compressionKind_,
+          true /*nullsFirst*/};
       batch_ = std::make_unique<VectorStreamGroup>(pool_);
       batch_->createStreamTree(
           std::static_pointer_cast<const RowType>(rows->type()),
@@ -363,6 +579,7 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.compressionDictionary,
       pool,
       stats));
 }
@@ -376,6 +593,7 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    std::shared_ptr<const common::ZstdDictionary> compressionDictionary,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats)
     : id_(id),
@@ -385,9 +603,11 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
+      compressionDictionary_(std::move(compressionDictionary)),
       readOptions_{
           kDefaultUseLosslessTimestamp,
-          compressionKind_,
+          compressionDictionary_ == nullptr ? compressionKind_
+                                            : common::CompressionKind_NONE,
           /*nullsFirst=*/true},
       pool_(pool),
       stats_(stats) {
@@ -405,12 +625,34 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
   uint64_t timeUs{0};
   {
     MicrosecondTimer timer{&timeUs};
-    VectorStreamGroup::read(
-        input_.get(), pool_, type_, &rowVector, &readOptions_);
+    if (compressionDictionary_ != nullptr) {
+      const auto pageSize = readDictionaryPage();
+      ByteInputStream page(
+          {ByteRange{pageBuffer_->asMutable<uint8_t>(), pageSize, 0}});
+      VectorStreamGroup::read(&page, pool_, type_, &rowVector, &readOptions_);
+    } else {
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, &rowVector, &readOptions_);
+    }
   }
   stats_->wlock()->spillDeserializationTimeUs += timeUs;
   common::updateGlobalSpillDeserializationTimeUs(timeUs);
 
   return true;
 }
+
+int32_t SpillReadFile::readDictionaryPage() {
+  const auto uncompressedSize = input_->read<int32_t>();
+  const auto compressedSize = input_->read<int32_t>();
+  char* compressed;
+  BaseVector::ensureBuffer<char, char>(
+      compressedSize, pool_, &compressedBuffer_, &compressed);
+  char* page;
+  BaseVector::ensureBuffer<char, char>(
+      uncompressedSize, pool_, &pageBuffer_, &page);
+  input_->readBytes(reinterpret_cast<uint8_t*>(compressed), compressedSize);
+  compressionDictionary_->decompress(
+      std::string_view(compressed, compressedSize), page, uncompressedSize);
+  return uncompressedSize;
+}
 } // namespace facebook::velox::exec
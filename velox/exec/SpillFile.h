@@ -17,10 +17,12 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+#include <folly/futures/Future.h>
 
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/TreeOfLosers.h"
@@ -89,6 +91,10 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// The dictionary the pages of the file are compressed with if written
+  /// with FLAGS_velox_spill_zstd_dictionary. The pages are then framed by
+  /// SpillWriter instead of compressed by the serializer.
+  std::shared_ptr<const common::ZstdDictionary> compressionDictionary;
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -109,6 +115,12 @@ class SpillWriter {
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
+  ///
+  /// If 'writeExecutor' is set, a serialized buffer is written to the file on
+  /// 'writeExecutor' while the caller serializes the next one. At most one
+  /// write per writer is in flight, so that the writes to a file stay in
+  /// order and the memory held by pending writes is bounded by
+  /// 'writeBufferSize'.
   SpillWriter(
       const RowTypePtr& type,
       const uint32_t numSortKeys,
@@ -120,7 +132,11 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr);
+
+  /// Waits for the write in flight, if any.
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -156,15 +172,47 @@ class SpillWriter {
   // the function creates a new one. If the current open spill file exceeds the
   // target file size limit, then it first closes the current one and then
   // creates a new one. 'currentFile_' points to the current open spill file.
+  // The pages buffered to train its dictionary count towards its size.
   SpillWriteFile* ensureFile();
 
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
+  // The outcome of a write on 'writeExecutor_'.
+  struct WriteResult {
+    uint64_t writtenBytes{0};
+    uint64_t flushTimeUs{0};
+    uint64_t writeTimeUs{0};
+  };
+
   // Writes data from 'batch_' to the current output file. Returns the actual
   // written size.
   uint64_t flush();
 
+  // Writes 'iobuf' to 'file' on 'writeExecutor_' if set, otherwise inline.
+  // Returns the written size.
+  uint64_t writeToFile(
+      SpillWriteFile* file,
+      std::unique_ptr<folly::IOBuf> iobuf,
+      uint64_t flushTimeUs);
+
+  // Returns 'page' compressed with the dictionary of the current file. Until
+  // the dictionary is trained, buffers 'page' as a sample and returns
+  // nullptr, or all the buffered pages once there are enough samples.
+  std::unique_ptr<folly::IOBuf> compressWithDictionary(
+      std::unique_ptr<folly::IOBuf> page);
+
+  // Trains 'dictionary_' on 'samplePages_' and returns them compressed.
+  std::unique_ptr<folly::IOBuf> trainDictionary();
+
+  // Returns 'page' compressed with 'dictionary_', prefixed by its
+  // uncompressed and compressed sizes.
+  std::unique_ptr<folly::IOBuf> compressPage(folly::IOBuf& page);
+
+  // Waits for the write in flight, if any, and updates the write stats with
+  // its outcome. Throws if the write failed.
+  void waitForPendingWrite();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -181,6 +229,9 @@ class SpillWriter {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  // True if the pages are compressed with a ZSTD dictionary trained per file
+  // instead of by the serializer.
+  const bool useDictionary_;
   const std::string pathPrefix_;
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
@@ -191,11 +242,20 @@ class SpillWriter {
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
 
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // The write to 'currentFile_' in flight on 'writeExecutor_'.
+  std::optional<folly::SemiFuture<WriteResult>> pendingWrite_;
+  // The dictionary of 'currentFile_'. Null until trained.
+  std::shared_ptr<const common::ZstdDictionary> dictionary_;
+  // Uncompressed pages of 'currentFile_' buffered as samples to train
+  // 'dictionary_' on.
+  std::vector<std::unique_ptr<folly::IOBuf>> samplePages_;
+  uint64_t sampleBytes_{0};
   SpillFiles finishedFiles_;
 };
 
@@ -206,7 +266,9 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
+  /// Reads from 'input' using 'buffer' for buffering reads. If
+  /// FLAGS_velox_spill_read_mmap is set and 'file' is local, the file is
+  /// mapped instead and read in windows of 'bufferSize' without copying.
   SpillInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
@@ -225,6 +287,10 @@ class SpillInputStream : public ByteInputStream {
 
   void next(bool throwIfPastEnd) override;
 
+  // Sets the range to the next window of the mapped file and hands the page
+  // cache of the consumed windows back to the kernel.
+  void nextMapped();
+
   // Issues readahead if underlying fs supports async mode read.
   //
   // TODO: we might consider to use AsyncSource to support read-ahead on
@@ -259,6 +325,8 @@ class SpillInputStream : public ByteInputStream {
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
+  // The mapped file if read through mmap, otherwise nullptr.
+  char* const mappedData_;
   const bool readaEnabled_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
@@ -319,9 +387,14 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      std::shared_ptr<const common::ZstdDictionary> compressionDictionary,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats);
 
+  // Reads the next page compressed with 'compressionDictionary_' into
+  // 'pageBuffer_' and returns its size.
+  int32_t readDictionaryPage();
+
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
   const uint32_t id_;
@@ -333,10 +406,15 @@ class SpillReadFile {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  const std::shared_ptr<const common::ZstdDictionary> compressionDictionary_;
   const serializer::presto::PrestoVectorSerde::PrestoOptions readOptions_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
   std::unique_ptr<SpillInputStream> input_;
+  // The compressed and the uncompressed page if 'compressionDictionary_' is
+  // set. Reused across pages.
+  BufferPtr compressedBuffer_;
+  BufferPtr pageBuffer_;
 };
 } // namespace facebook::velox::exec
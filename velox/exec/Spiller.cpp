@@ -17,6 +17,7 @@
 #include "velox/exec/Spiller.h"
 #include <folly/ScopeGuard.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/process/TraceSpan.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
@@ -58,6 +59,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeExecutor,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -93,6 +95,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeExecutor,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
@@ -124,6 +127,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeExecutor,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
@@ -156,10 +160,10 @@ Spiller::Spiller(
           spillConfig->executor,
           0,
           spillConfig->fileCreateConfig,
+          spillConfig->writeExecutor,
           spillStats) {
-  VELOX_CHECK_EQ(
-      type_,
-      Type::kHashJoinProbe,
+  VELOX_CHECK(
+      type_ == Type::kHashJoinProbe || type_ == Type::kPartitionedInput,
       "Unexpected spiller type: {}",
       typeName(type_));
 }
@@ -189,6 +193,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeExecutor,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
   VELOX_CHECK(isHashJoinTableSpillType(rowType_, joinType));
@@ -218,10 +223,44 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->writeExecutor,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kRowNumber);
 }
 
+Spiller::Spiller(
+    Type type,
+    RowTypePtr rowType,
+    const common::SpillConfig* spillConfig,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : Spiller(
+          type,
+          nullptr,
+          std::move(rowType),
+          HashBitRange{},
+          0,
+          {},
+          false,
+          spillConfig->getSpillDirPathCb,
+          spillConfig->updateAndCheckSpillLimitCb,
+          spillConfig->fileNamePrefix,
+          spillConfig->maxFileSize,
+          spillConfig->writeBufferSize,
+          spillConfig->compressionKind,
+          spillConfig->executor,
+          0,
+          spillConfig->fileCreateConfig,
+          spillConfig->writeExecutor,
+          spillStats) {
+  VELOX_CHECK_EQ(
+      type_,
+      Type::kNestedLoopJoinBuild,
+      "Unexpected spiller type: {}",
+      typeName(type_));
+  VELOX_CHECK_EQ(state_.maxPartitions(), 1);
+  state_.setPartitionSpilled(0);
+}
+
 Spiller::Spiller(
     Type type,
     RowContainer* container,
@@ -239,6 +278,7 @@ Spiller::Spiller(
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
+    folly::Executor* writeExecutor,
     folly::Synchronized<common::SpillStats>* spillStats)
     : type_(type),
       container_(container),
@@ -260,11 +300,15 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          writeExecutor) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
-  VELOX_CHECK_EQ(container_ == nullptr, type_ == Type::kHashJoinProbe);
+  VELOX_CHECK_EQ(
+      container_ == nullptr,
+      type_ == Type::kHashJoinProbe || type_ == Type::kPartitionedInput ||
+          type_ == Type::kNestedLoopJoinBuild);
   spillRuns_.reserve(state_.maxPartitions());
   for (int i = 0; i < state_.maxPartitions(); ++i) {
     spillRuns_.emplace_back(*memory::spillMemoryPool());
@@ -305,6 +349,7 @@ int64_t Spiller::extractSpillVector(
     RowVectorPtr& spillVector,
     size_t& nextBatchIndex) {
   VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NE(type_, Type::kPartitionedInput);
 
   auto limit = std::min<size_t>(rows.size() - nextBatchIndex, maxRows);
   VELOX_CHECK(!rows.empty());
@@ -342,7 +387,7 @@ class RowContainerSpillMergeStream : public SpillMergeStream {
         rows_(std::move(rows)),
         spiller_(spiller) {
     if (!rows_.empty()) {
-      nextBatch();
+      setNextBatch();
     }
   }
 
@@ -433,6 +478,7 @@ void Spiller::ensureSorted(SpillRun& run) {
 
 std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
   VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NE(type_, Type::kPartitionedInput);
   // Target size of a single vector of spilled content. One of
   // these will be materialized at a time for each stream of the
   // merge.
@@ -464,6 +510,7 @@ std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
 }
 
 void Spiller::runSpill(bool lastRun) {
+  process::TraceSpan span("Spiller::runSpill");
   ++spillStats_->wlock()->spillRuns;
   VELOX_CHECK(type_ != Spiller::Type::kOrderByOutput || lastRun);
 
@@ -499,11 +546,13 @@ void Spiller::runSpill(bool lastRun) {
   for (auto& write : writes) {
     results.push_back(write->move());
   }
+  uint64_t totalWritten = 0;
   for (auto& result : results) {
     if (result->error != nullptr) {
       std::rethrow_exception(result->error);
     }
     const auto numWritten = result->rowsWritten;
+    totalWritten += numWritten;
     auto partition = result->partition;
     auto& run = spillRuns_[partition];
     VELOX_CHECK_EQ(numWritten, run.rows.size());
@@ -514,6 +563,12 @@ void Spiller::runSpill(bool lastRun) {
     }
   }
 
+  if (span.isSampled()) {
+    span.addAttribute("type", typeName(type_));
+    span.addAttribute("partitions", std::to_string(writes.size()));
+    span.addAttribute("rows", std::to_string(totalWritten));
+  }
+
   // For aggregation output / orderby output spiller, we expect only one spill
   // call to spill all the rows starting from the specified row offset.
   if (lastRun &&
@@ -538,7 +593,8 @@ void Spiller::updateSpillSortTime(uint64_t timeUs) {
 bool Spiller::needSort() const {
   return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild &&
       type_ != Type::kRowNumber && type_ != Type::kAggregateOutput &&
-      type_ != Type::kOrderByOutput;
+      type_ != Type::kOrderByOutput && type_ != Type::kNestedLoopJoinBuild &&
+      type_ != Type::kPartitionedInput;
 }
 
 void Spiller::spill() {
@@ -553,7 +609,9 @@ void Spiller::spill(const RowContainerIterator& startRowIter) {
 void Spiller::spill(const RowContainerIterator* startRowIter) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NE(type_, Type::kPartitionedInput);
   VELOX_CHECK_NE(type_, Type::kOrderByOutput);
+  VELOX_CHECK_NE(type_, Type::kNestedLoopJoinBuild);
 
   markAllPartitionsSpilled();
 
@@ -601,7 +659,8 @@ void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK(
       type_ == Type::kHashJoinProbe || type_ == Type::kHashJoinBuild ||
-          type_ == Type::kRowNumber,
+          type_ == Type::kRowNumber || type_ == Type::kNestedLoopJoinBuild ||
+          type_ == Type::kPartitionedInput,
       "Unexpected spiller type: {}",
       typeName(type_));
   if (FOLLY_UNLIKELY(!state_.isPartitionSpilled(partition))) {
@@ -736,6 +795,10 @@ std::string Spiller::typeName(Type type) {
       return "AGGREGATE_OUTPUT";
     case Type::kRowNumber:
       return "ROW_NUMBER";
+    case Type::kNestedLoopJoinBuild:
+      return "NESTED_LOOP_JOIN_BUILD";
+    case Type::kPartitionedInput:
+      return "PARTITIONED_INPUT";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
   }
@@ -41,8 +41,13 @@ class Spiller {
     kOrderByOutput = 5,
     // Used for row number.
     kRowNumber = 6,
+    // Used for nested loop join build.
+    kNestedLoopJoinBuild = 7,
+    // Used for spilling the input vectors of operators which partition their
+    // state by hash, e.g. row number and mark distinct.
+    kPartitionedInput = 8,
     // Number of spiller types.
-    kNumTypes = 7,
+    kNumTypes = 9,
   };
 
   static std::string typeName(Type);
@@ -81,7 +86,7 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
-  /// type == Type::kHashJoinProbe
+  /// type == Type::kHashJoinProbe || type == Type::kPartitionedInput
   Spiller(
       Type type,
       RowTypePtr rowType,
@@ -108,6 +113,16 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
+  /// type == Type::kNestedLoopJoinBuild
+  ///
+  /// NOTE: the spiller has a single partition which starts spilling on
+  /// construction.
+  Spiller(
+      Type type,
+      RowTypePtr rowType,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
   Type type() const {
     return type_;
   }
@@ -131,7 +146,7 @@ class Spiller {
 
   /// Append 'spillVector' into the spill file of given 'partition'. It is now
   /// only used by the spilling operator which doesn't need data sort, such as
-  /// hash join build and hash join probe.
+  /// hash join build, hash join probe and nested loop join build.
   ///
   /// NOTE: the spilling operator should first mark 'partition' as spilling and
   /// spill any data buffered in row container before call this.
@@ -181,10 +196,10 @@ class Spiller {
 
   /// Invokes to set a set of 'partitions' as spilling.
   void setPartitionsSpilled(const SpillPartitionNumSet& partitions) {
-    VELOX_CHECK_EQ(
-        type_,
-        Spiller::Type::kHashJoinProbe,
-        "Unexpected spiller type: ",
+    VELOX_CHECK(
+        type_ == Spiller::Type::kHashJoinProbe ||
+            type_ == Spiller::Type::kPartitionedInput,
+        "Unexpected spiller type: {}",
         typeName(type_));
     for (const auto& partition : partitions) {
       state_.setPartitionSpilled(partition);
@@ -218,6 +233,7 @@ class Spiller {
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
+      folly::Executor* writeExecutor,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
@@ -321,8 +337,8 @@ class Spiller {
   void updateSpillSortTime(uint64_t timeUs);
 
   const Type type_;
-  // NOTE: for hash join probe type, there is no associated row container for
-  // the spiller.
+  // NOTE: for hash join probe and nested loop join build types, there is no
+  // associated row container for the spiller.
   RowContainer* const container_{nullptr};
   folly::Executor* const executor_;
   const HashBitRange bits_;
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/StreamingAggregation.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox::exec {
 
@@ -112,6 +113,67 @@ bool equalKeys(
 
   return true;
 }
+
+// Sets the bits in 'changes' for the rows after the first of the 'size'
+// 'values' that differ from the previous row. Compares a SIMD register of
+// rows at a time.
+template <typename T>
+void setValueChanges(const T* values, vector_size_t size, uint64_t* changes) {
+  using Batch = xsimd::batch<T>;
+  static_assert(Batch::size <= 32);
+  vector_size_t row = 1;
+  for (; row + Batch::size <= size; row += Batch::size) {
+    const uint64_t mask = static_cast<uint32_t>(simd::toBitMask(
+        Batch::load_unaligned(values + row) !=
+        Batch::load_unaligned(values + row - 1)));
+    if (mask == 0) {
+      continue;
+    }
+    const auto shift = row % 64;
+    changes[row / 64] |= mask << shift;
+    if (shift + Batch::size > 64) {
+      changes[row / 64 + 1] |= mask >> (64 - shift);
+    }
+  }
+  for (; row < size; ++row) {
+    if (values[row] != values[row - 1]) {
+      bits::setBit(changes, row);
+    }
+  }
+}
+
+// Sets the bits in 'changes' for the first 'size' rows of 'vector' that
+// differ from the previous row if 'vector' is a flat vector of integers
+// without nulls. Returns false and leaves 'changes' unchanged otherwise.
+bool setKeyChanges(
+    const BaseVector& vector,
+    vector_size_t size,
+    uint64_t* changes) {
+  if (vector.encoding() != VectorEncoding::Simple::FLAT ||
+      vector.mayHaveNulls()) {
+    return false;
+  }
+  switch (vector.typeKind()) {
+    case TypeKind::TINYINT:
+      setValueChanges(
+          vector.asFlatVector<int8_t>()->rawValues(), size, changes);
+      return true;
+    case TypeKind::SMALLINT:
+      setValueChanges(
+          vector.asFlatVector<int16_t>()->rawValues(), size, changes);
+      return true;
+    case TypeKind::INTEGER:
+      setValueChanges(
+          vector.asFlatVector<int32_t>()->rawValues(), size, changes);
+      return true;
+    case TypeKind::BIGINT:
+      setValueChanges(
+          vector.asFlatVector<int64_t>()->rawValues(), size, changes);
+      return true;
+    default:
+      return false;
+  }
+}
 } // namespace
 
 char* StreamingAggregation::startNewGroup(vector_size_t index) {
@@ -178,42 +240,58 @@ RowVectorPtr StreamingAggregation::createOutput(size_t numGroups) {
   return output;
 }
 
-void StreamingAggregation::assignGroups() {
-  auto numInput = input_->size();
-
-  inputGroups_.resize(numInput);
-
-  // Look for the end of the last group.
-  vector_size_t index = 0;
-  if (prevInput_) {
-    auto prevIndex = prevInput_->size() - 1;
-    auto* prevGroup = groups_[numGroups_ - 1];
-    for (; index < numInput; ++index) {
-      if (equalKeys(groupingKeys_, prevInput_, prevIndex, input_, index)) {
-        inputGroups_[index] = prevGroup;
-      } else {
-        break;
+void StreamingAggregation::findGroupStarts() {
+  const auto numInput = input_->size();
+  groupStarts_.assign(bits::nwords(numInput), 0);
+  for (auto key : groupingKeys_) {
+    const auto& vector = input_->childAt(key);
+    if (setKeyChanges(*vector, numInput, groupStarts_.data())) {
+      continue;
+    }
+    for (auto i = 1; i < numInput; ++i) {
+      if (!bits::isBitSet(groupStarts_.data(), i) &&
+          !vector->equalValueAt(vector.get(), i, i - 1)) {
+        bits::setBit(groupStarts_.data(), i);
       }
     }
   }
+}
 
-  if (index < numInput) {
-    for (auto i = 0; i < groupingKeys_.size(); ++i) {
-      decodedKeys_[i].decode(*input_->childAt(groupingKeys_[i]), inputRows_);
-    }
+void StreamingAggregation::assignGroups() {
+  const auto numInput = input_->size();
 
-    auto* newGroup = startNewGroup(index);
-    inputGroups_[index] = newGroup;
+  inputGroups_.resize(numInput);
+  findGroupStarts();
+
+  // The first rows continue the last group if their keys match the last row
+  // of the previous input.
+  const bool continuesLastGroup = prevInput_ != nullptr &&
+      equalKeys(
+          groupingKeys_, prevInput_, prevInput_->size() - 1, input_, 0);
+
+  bool keysDecoded = false;
+  vector_size_t start = 0;
+  while (start < numInput) {
+    auto end = bits::findFirstBit(groupStarts_.data(), start + 1, numInput);
+    if (end < 0) {
+      end = numInput;
+    }
 
-    for (auto i = index + 1; i < numInput; ++i) {
-      if (equalKeys(groupingKeys_, input_, index, input_, i)) {
-        inputGroups_[i] = inputGroups_[index];
-      } else {
-        newGroup = startNewGroup(i);
-        inputGroups_[i] = newGroup;
-        index = i;
+    char* group;
+    if (start == 0 && continuesLastGroup) {
+      group = groups_[numGroups_ - 1];
+    } else {
+      if (!keysDecoded) {
+        for (auto i = 0; i < groupingKeys_.size(); ++i) {
+          decodedKeys_[i].decode(
+              *input_->childAt(groupingKeys_[i]), inputRows_);
+        }
+        keysDecoded = true;
       }
+      group = startNewGroup(start);
     }
+    std::fill(inputGroups_.begin() + start, inputGroups_.begin() + end, group);
+    start = end;
   }
 }
 
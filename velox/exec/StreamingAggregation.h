@@ -70,6 +70,10 @@ class StreamingAggregation : public Operator {
   // assignments in inputGroups_.
   void assignGroups();
 
+  // Sets the bits in groupStarts_ for the input rows after the first whose
+  // grouping keys differ from the previous row.
+  void findGroupStarts();
+
   // Add input data to accumulators.
   void evaluateAggregates();
 
@@ -117,6 +121,9 @@ class StreamingAggregation : public Operator {
   // Pointers to groups for all input rows.
   std::vector<char*> inputGroups_;
 
+  // Bits for the input rows that start a group within the input.
+  std::vector<uint64_t> groupStarts_;
+
   // A subset of input rows to evaluate the aggregate function on. Rows
   // where aggregation mask is false are excluded.
   SelectivityVector inputRows_;
@@ -22,16 +22,72 @@ StreamingWindowBuild::StreamingWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
-    tsan_atomic<bool>* nonReclaimableSection)
-    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection) {}
+    tsan_atomic<bool>* nonReclaimableSection,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection),
+      spillStats_(spillStats) {}
 
 void StreamingWindowBuild::buildNextPartition() {
+  if (spiller_ != nullptr) {
+    // Spills the rest of the partition so that all its rows are read from the
+    // spill files.
+    spiller_->spill(inputRows_);
+    numSpilledRows_ += inputRows_.size();
+    data_->eraseRows(
+        folly::Range<char**>(inputRows_.data(), inputRows_.size()));
+    inputRows_.clear();
+
+    SpillPartitionSet spillPartitionSet;
+    spiller_->finishSpill(spillPartitionSet);
+    VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+    spilledPartitions_.emplace(
+        partitionStartRows_.size(),
+        SpilledPartition{
+            spillPartitionSet.begin()->second->files(), numSpilledRows_});
+    spiller_.reset();
+    numSpilledRows_ = 0;
+  }
+
   partitionStartRows_.push_back(sortedRows_.size());
   sortedRows_.insert(sortedRows_.end(), inputRows_.begin(), inputRows_.end());
   inputRows_.clear();
 }
 
+void StreamingWindowBuild::spill() {
+  // Only the partition being received is spilled. The rows of the partitions
+  // before it are referenced by the WindowPartitions of the Window operator.
+  if (spiller_ == nullptr) {
+    if (inputRows_.size() < 2) {
+      return;
+    }
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderByOutput,
+        data_.get(),
+        inputType_,
+        spillConfig_,
+        spillStats_);
+  }
+  spillInputRows();
+}
+
+void StreamingWindowBuild::spillInputRows() {
+  if (inputRows_.size() < 2) {
+    return;
+  }
+  std::vector<char*> rows(inputRows_.begin(), inputRows_.end() - 1);
+  spiller_->spill(rows);
+  numSpilledRows_ += rows.size();
+  // The erased rows are reused by the next input rows of the partition.
+  data_->eraseRows(folly::Range<char**>(rows.data(), rows.size()));
+  inputRows_.erase(inputRows_.begin(), inputRows_.end() - 1);
+}
+
 void StreamingWindowBuild::addInput(RowVectorPtr input) {
+  // Test-only spill path.
+  if (spillConfig_ != nullptr && testingTriggerSpill(data_->pool()->name())) {
+    spill();
+  }
+
   for (auto i = 0; i < inputChannels_.size(); ++i) {
     decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
   }
@@ -51,6 +107,12 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
     inputRows_.push_back(newRow);
     previousRow_ = newRow;
   }
+
+  if (spiller_ != nullptr) {
+    // Once the partition being received has spilled, all its rows are read
+    // from the spill files. So there is no need to hold them in memory.
+    spillInputRows();
+  }
 }
 
 void StreamingWindowBuild::noMoreInput() {
@@ -70,6 +132,13 @@ std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
       partitionStartRows_.size() - 2,
       "All window partitions consumed");
 
+  auto spilledPartition = spilledPartitions_.find(currentPartition_);
+  if (spilledPartition != spilledPartitions_.end()) {
+    VELOX_CHECK_EQ(
+        partitionStartRows_[currentPartition_],
+        partitionStartRows_[currentPartition_ + 1]);
+  }
+
   // Erase previous partition.
   if (currentPartition_ > 0) {
     auto numPreviousPartitionRows = partitionStartRows_[currentPartition_];
@@ -83,6 +152,20 @@ std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
     }
   }
 
+  if (spilledPartition != spilledPartitions_.end()) {
+    auto [files, numRows] = std::move(spilledPartition->second);
+    spilledPartitions_.erase(spilledPartition);
+    return std::make_unique<WindowPartition>(
+        data_.get(),
+        std::move(files),
+        numRows,
+        inversedInputChannels_,
+        sortKeyInfo_,
+        spillConfig_->readBufferSize,
+        data_->pool(),
+        spillStats_);
+  }
+
   auto partitionSize = partitionStartRows_[currentPartition_ + 1] -
       partitionStartRows_[currentPartition_];
   auto partition = folly::Range(
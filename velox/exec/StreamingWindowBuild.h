@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/Spiller.h"
 #include "velox/exec/WindowBuild.h"
 
 namespace facebook::velox::exec {
@@ -24,22 +25,29 @@ namespace facebook::velox::exec {
 /// {partition keys + order by keys}. The logic identifies partition changes
 /// when receiving input rows and splits out WindowPartitions for the Window
 /// operator to process.
+///
+/// spill() spills the rows of the partition being received. The rest of that
+/// partition is spilled as it arrives and the Window operator reads the rows
+/// back as it processes the partition. This bounds the memory of a partition
+/// that doesn't fit in memory by the rows its frames access.
 class StreamingWindowBuild : public WindowBuild {
  public:
   StreamingWindowBuild(
       const std::shared_ptr<const core::WindowNode>& windowNode,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
-      tsan_atomic<bool>* nonReclaimableSection);
+      tsan_atomic<bool>* nonReclaimableSection,
+      folly::Synchronized<common::SpillStats>* spillStats);
 
   void addInput(RowVectorPtr input) override;
 
-  void spill() override {
-    VELOX_UNREACHABLE();
-  }
+  void spill() override;
 
   std::optional<common::SpillStats> spilledStats() const override {
-    return std::nullopt;
+    if (spiller_ == nullptr) {
+      return std::nullopt;
+    }
+    return spiller_->stats();
   }
 
   void noMoreInput() override;
@@ -56,8 +64,18 @@ class StreamingWindowBuild : public WindowBuild {
   }
 
  private:
+  // A partition whose rows are all in spill files.
+  struct SpilledPartition {
+    SpillFiles files;
+    vector_size_t numRows;
+  };
+
   void buildNextPartition();
 
+  // Spills all the rows of 'inputRows_' but the last one, which is kept to
+  // detect the end of the partition.
+  void spillInputRows();
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // Rows are erased from data_ when they are output from the
   // Window operator.
@@ -77,6 +95,20 @@ class StreamingWindowBuild : public WindowBuild {
   // Current partition being output. Used to construct WindowPartitions
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
+
+  folly::Synchronized<common::SpillStats>* const spillStats_;
+
+  // Spills the partition being received once spill() is called. Reset when
+  // the partition ends.
+  std::unique_ptr<Spiller> spiller_;
+
+  // The number of rows of the partition being received that 'spiller_' has
+  // spilled.
+  vector_size_t numSpilledRows_{0};
+
+  // The spilled partitions by partition index. A spilled partition has no rows
+  // in 'sortedRows_'.
+  std::map<vector_size_t, SpilledPartition> spilledPartitions_;
 };
 
 } // namespace facebook::velox::exec
@@ -14,10 +14,16 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+
+#include <folly/json.h>
+
+#include <sstream>
+
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
+#include "velox/vector/VectorStream.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -44,11 +50,89 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      adaptiveSplitPreload_(driverCtx_->queryConfig().adaptiveSplitPreload()),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
+      adaptiveBatchSize_(
+          driverCtx_->queryConfig().tableScanAdaptiveBatchSize()),
       getOutputTimeLimitMs_(
           driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
+  resultCacheKeyPrefix_ = makeResultCacheKeyPrefix(*tableScanNode);
+}
+
+std::string TableScan::makeResultCacheKeyPrefix(
+    const core::TableScanNode& tableScanNode) const {
+  if (!driverCtx_->queryConfig().fragmentResultCacheEnabled() ||
+      FragmentResultCache::instance() == nullptr ||
+      !isRegisteredVectorSerde()) {
+    return "";
+  }
+  folly::dynamic serialized;
+  try {
+    serialized = tableScanNode.serialize();
+  } catch (const VeloxException&) {
+    // The handles of the connector are not serializable.
+    return "";
+  }
+  // The plan node id differs between queries over the same data. The keys of
+  // the serialized objects are sorted so that equal nodes give equal strings.
+  serialized.erase("id");
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return folly::json::serialize(serialized, opts);
+}
+
+bool TableScan::lookupResult(const connector::ConnectorSplit& split) {
+  const auto splitKey = split.cacheKey();
+  if (!splitKey.has_value()) {
+    return false;
+  }
+  auto* cache = FragmentResultCache::instance();
+  auto key = fmt::format("{}\n{}", resultCacheKeyPrefix_, splitKey.value());
+  cachedResult_ = cache->get(key);
+  if (cachedResult_ != nullptr) {
+    nextCachedPage_ = 0;
+    addRuntimeStat("resultCacheHits", RuntimeCounter(1));
+    return true;
+  }
+  addRuntimeStat("resultCacheMisses", RuntimeCounter(1));
+  recordedKey_ = std::move(key);
+  recordedResult_ = std::make_shared<FragmentResult>();
+  recordedBytes_ = 0;
+  return false;
+}
+
+RowVectorPtr TableScan::nextCachedPage() {
+  if (nextCachedPage_ >= cachedResult_->pages.size()) {
+    return nullptr;
+  }
+  const auto& page = cachedResult_->pages[nextCachedPage_++];
+  ByteInputStream input({ByteRange{
+      reinterpret_cast<uint8_t*>(const_cast<char*>(page.data())),
+      static_cast<int32_t>(page.size()),
+      0}});
+  RowVectorPtr result;
+  VectorStreamGroup::read(&input, pool(), outputType_, &result);
+  stats_.wlock()->addInputVector(result->estimateFlatSize(), result->size());
+  return result;
+}
+
+void TableScan::recordResult(const RowVectorPtr& data) {
+  for (auto& child : data->children()) {
+    child->loadedVector();
+  }
+  VectorStreamGroup group(pool());
+  group.createStreamTree(outputType_, data->size());
+  group.append(data);
+  std::ostringstream out;
+  OStreamOutputStream stream(&out);
+  group.flush(&stream);
+  recordedResult_->pages.push_back(out.str());
+  recordedBytes_ += recordedResult_->pages.back().size();
+  if (recordedBytes_ > FragmentResultCache::instance()->maxEntryBytes()) {
+    recordedResult_ = nullptr;
+  }
 }
 
 folly::dynamic TableScan::toJson() const {
@@ -148,6 +232,16 @@ RowVectorPtr TableScan::getOutput() {
           connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (!resultCacheKeyPrefix_.empty() && lookupResult(*connectorSplit)) {
+        if (connectorSplit->dataSource != nullptr) {
+          // The preloaded data source is not needed.
+          connectorSplit->dataSource->close();
+        }
+        ++stats_.wlock()->numSplits;
+        // Returns the cached output below.
+        continue;
+      }
+
       if (dataSource_ == nullptr) {
         curStatus_ = "getOutput: creating dataSource_";
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
@@ -179,9 +273,15 @@ RowVectorPtr TableScan::getOutput() {
         // The AsyncSource returns a unique_ptr to a shared_ptr. The unique_ptr
         // will be nullptr if there was a cancellation.
         numReadyPreloadedSplits_ += connectorSplit->dataSource->hasValue();
-        auto preparedDataSource = connectorSplit->dataSource->move();
-        stats_.wlock()->getOutputTiming.add(
-            connectorSplit->dataSource->prepareTiming());
+        uint64_t waitUs{0};
+        std::unique_ptr<connector::DataSource> preparedDataSource;
+        {
+          MicrosecondTimer timer(&waitUs);
+          preparedDataSource = connectorSplit->dataSource->move();
+        }
+        const auto& prepareTiming = connectorSplit->dataSource->prepareTiming();
+        stats_.wlock()->getOutputTiming.add(prepareTiming);
+        splitOpenUs_ = prepareTiming.wallNanos / 1'000 + waitUs;
         if (!preparedDataSource) {
           // There must be a cancellation.
           VELOX_CHECK(operatorCtx_->task()->isCancelled());
@@ -195,6 +295,7 @@ RowVectorPtr TableScan::getOutput() {
           MicrosecondTimer timer(&addSplitTimeUs);
           dataSource_->addSplit(connectorSplit);
         }
+        splitOpenUs_ = addSplitTimeUs;
         stats_.wlock()->addRuntimeStat(
             "dataSourceAddSplitWallNanos",
             RuntimeCounter(
@@ -202,13 +303,24 @@ RowVectorPtr TableScan::getOutput() {
       }
       curStatus_ = "getOutput: updating stats_.numSplits";
       ++stats_.wlock()->numSplits;
+      splitStartUs_ = getCurrentTimeMicro();
 
       curStatus_ = "getOutput: dataSource_->estimatedRowSize";
-      const auto estimatedRowSize = dataSource_->estimatedRowSize();
+      splitRowSize_ = dataSource_->estimatedRowSize();
       readBatchSize_ =
-          estimatedRowSize == connector::DataSource::kUnknownRowSize
+          splitRowSize_ == connector::DataSource::kUnknownRowSize
           ? outputBatchRows()
-          : outputBatchRows(estimatedRowSize);
+          : outputBatchRows(splitRowSize_);
+    }
+
+    if (cachedResult_ != nullptr) {
+      if (auto page = nextCachedPage()) {
+        return page;
+      }
+      cachedResult_ = nullptr;
+      driverCtx_->task->splitFinished(true, currentSplitWeight_);
+      needNewSplit_ = true;
+      continue;
     }
 
     // Check for  cancellation since scans that filter everything out will not
@@ -240,6 +352,7 @@ RowVectorPtr TableScan::getOutput() {
 
     curStatus_ = "getOutput: checkPreload";
     checkPreload();
+    RowVectorPtr output;
     {
       curStatus_ = "getOutput: updating stats_.dataSourceReadWallNanos";
       auto lockedStats = stats_.wlock();
@@ -258,18 +371,39 @@ RowVectorPtr TableScan::getOutput() {
       RowVectorPtr data = std::move(dataOptional).value();
       if (data != nullptr) {
         if (data->size() > 0) {
-          lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+          const auto flatSize = data->estimateFlatSize();
+          lockedStats->addInputVector(flatSize, data->size());
+          if (adaptiveBatchSize_) {
+            // Rows wider than the estimate for the split make the next batch
+            // smaller. The estimate is from file statistics and is an average
+            // over the file, so it misses runs of wide rows.
+            const uint64_t rowSize = std::max<int64_t>(
+                {static_cast<int64_t>(flatSize / data->size()),
+                 splitRowSize_,
+                 1});
+            readBatchSize_ = outputBatchRows(rowSize);
+          }
           constexpr int kMaxSelectiveBatchSizeMultiplier = 4;
           maxFilteringRatio_ = std::max(
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
-          return data;
+          output = std::move(data);
+        } else {
+          continue;
         }
-        continue;
       }
     }
 
+    if (output != nullptr) {
+      // Serializes the output for the cache after releasing the stats lock.
+      if (recordedResult_ != nullptr) {
+        curStatus_ = "getOutput: recordResult";
+        recordResult(output);
+      }
+      return output;
+    }
+
     {
       curStatus_ = "getOutput: updating stats_.preloadedSplits";
       auto lockedStats = stats_.wlock();
@@ -285,6 +419,16 @@ RowVectorPtr TableScan::getOutput() {
       }
     }
 
+    if (recordedResult_ != nullptr) {
+      FragmentResultCache::instance()->put(
+          recordedKey_, std::move(recordedResult_));
+    }
+
+    if (adaptiveSplitPreload_) {
+      driverCtx_->task->recordSplitTiming(
+          planNodeId(), splitOpenUs_, getCurrentTimeMicro() - splitStartUs_);
+    }
+
     curStatus_ = "getOutput: task->splitFinished";
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
     needNewSplit_ = true;
@@ -339,13 +483,20 @@ void TableScan::checkPreload() {
     return;
   }
   if (dataSource_->allPrefetchIssued()) {
-    maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-        maxSplitPreloadPerDriver_;
+    const auto numDrivers = driverCtx_->task->numDrivers(driverCtx_->driver);
+    maxPreloadedSplits_ = numDrivers * maxSplitPreloadPerDriver_;
+    if (adaptiveSplitPreload_) {
+      maxPreloadedSplits_ = preloadMemoryAvailable()
+          ? driverCtx_->task->splitPreloadTarget(
+                planNodeId(), numDrivers, maxPreloadedSplits_)
+          : 0;
+    }
     if (!splitPreloader_) {
       splitPreloader_ =
           [executor,
            this](const std::shared_ptr<connector::ConnectorSplit>& split) {
             preload(split);
+            preloadedSplits_.push_back(split);
 
             executor->add([connectorSplit = split]() mutable {
               connectorSplit->dataSource->prepare();
@@ -356,10 +507,41 @@ void TableScan::checkPreload() {
   }
 }
 
+bool TableScan::preloadMemoryAvailable() const {
+  // Preloaded splits hold file metadata and prefetched data. Stops starting
+  // new preloads when the query is close to its memory limit.
+  constexpr int32_t kMaxPreloadMemoryPct = 80;
+  const auto* root = pool()->root();
+  return root->reservedBytes() <
+      root->maxCapacity() / 100 * kMaxPreloadMemoryPct;
+}
+
 bool TableScan::isFinished() {
   return noMoreSplits_;
 }
 
+void TableScan::close() {
+  if (!noMoreSplits_) {
+    closePreloadedSplits();
+  }
+  preloadedSplits_.clear();
+  Operator::close();
+}
+
+void TableScan::closePreloadedSplits() {
+  if (preloadedSplits_.empty() ||
+      driverCtx_->task->numDrivers(driverCtx_->driver) > 1) {
+    return;
+  }
+  for (auto& weakSplit : preloadedSplits_) {
+    auto split = weakSplit.lock();
+    if (split != nullptr && split->dataSource != nullptr) {
+      // Does nothing if the preload has been read.
+      split->dataSource->close();
+    }
+  }
+}
+
 void TableScan::addDynamicFilter(
     const core::PlanNodeId& producer,
     column_index_t outputChannel,
@@ -367,7 +549,11 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  // A producer may tighten its filter on a channel over time, e.g. TopN.
+  auto [it, inserted] = dynamicFilters_.emplace(outputChannel, filter);
+  if (!inserted) {
+    it->second = it->second->mergeWith(filter.get());
+  }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
 
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/core/PlanNode.h"
+#include "velox/exec/FragmentResultCache.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -42,7 +43,8 @@ class TableScan : public SourceOperator {
   bool isFinished() override;
 
   bool canAddDynamicFilter() const override {
-    return connector_->canAddDynamicFilter();
+    // The cached output of a split is not filtered by dynamic filters.
+    return resultCacheKeyPrefix_.empty() && connector_->canAddDynamicFilter();
   }
 
   void addDynamicFilter(
@@ -50,6 +52,8 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  void close() override;
+
  private:
   // Checks if this table scan operator needs to yield before processing the
   // next split.
@@ -64,12 +68,39 @@ class TableScan : public SourceOperator {
   // of the Task's split queue for 'this' when getting splits.
   void checkPreload();
 
+  // Returns false if the query uses too much memory to start preloading more
+  // splits.
+  bool preloadMemoryAvailable() const;
+
   // Sets 'split->dataSource' to be an AsyncSource that makes a DataSource to
   // read 'split'. This source will be prepared in the background on the
   // executor of the connector. If the DataSource is needed before prepare is
   // done, it will be made when needed.
   void preload(const std::shared_ptr<connector::ConnectorSplit>& split);
 
+  // Drops the preloads started by 'this' that have not been read. Called when
+  // the driver finishes before the splits do, e.g. after a downstream Limit
+  // has all its rows. Only the single driver of a pipeline does this since
+  // with more drivers the splits may still be read by the others.
+  void closePreloadedSplits();
+
+  // Returns the prefix of the FragmentResultCache keys of the splits of
+  // 'tableScanNode', or an empty string if the output of 'this' is not cached.
+  std::string makeResultCacheKeyPrefix(
+      const core::TableScanNode& tableScanNode) const;
+
+  // Looks up the output of 'split' in the FragmentResultCache and sets
+  // 'cachedResult_' if found. Otherwise starts recording the output of 'split'
+  // if it can be cached. Returns true if found.
+  bool lookupResult(const connector::ConnectorSplit& split);
+
+  // Returns the next page of 'cachedResult_' or nullptr at its end.
+  RowVectorPtr nextCachedPage();
+
+  // Adds 'data' to the recorded output of the current split. Stops recording
+  // if the output gets too large to cache.
+  void recordResult(const RowVectorPtr& data);
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
@@ -92,6 +123,28 @@ class TableScan : public SourceOperator {
 
   const int32_t maxSplitPreloadPerDriver_{0};
 
+  // If true, the number of splits to preload follows the split open and read
+  // times of all drivers of the scan and the memory of the query.
+  const bool adaptiveSplitPreload_;
+
+  // Wall time to open the current split and the time its reading started.
+  uint64_t splitOpenUs_{0};
+  uint64_t splitStartUs_{0};
+
+  // Prefix of the FragmentResultCache keys of the splits of 'this'. Empty if
+  // the output of 'this' is not cached.
+  std::string resultCacheKeyPrefix_;
+
+  // The cached output of the current split and the index of its next page.
+  std::shared_ptr<const FragmentResult> cachedResult_;
+  size_t nextCachedPage_{0};
+
+  // The cache key and output of the current split while its output is being
+  // recorded for the cache.
+  std::string recordedKey_;
+  std::shared_ptr<FragmentResult> recordedResult_;
+  uint64_t recordedBytes_{0};
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -99,6 +152,9 @@ class TableScan : public SourceOperator {
   std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>
       splitPreloader_{nullptr};
 
+  // The splits whose preload was started by 'this'.
+  std::vector<std::weak_ptr<connector::ConnectorSplit>> preloadedSplits_;
+
   // Count of splits that started background preload.
   int32_t numPreloadedSplits_{0};
 
@@ -108,6 +164,13 @@ class TableScan : public SourceOperator {
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
 
+  // If true, 'readBatchSize_' is updated after each batch from the size of
+  // its rows.
+  const bool adaptiveBatchSize_;
+
+  // The row size estimated by the data source for the current split.
+  int64_t splitRowSize_{connector::DataSource::kUnknownRowSize};
+
   // Exits getOutput() method after this many milliseconds. Zero means 'no
   // limit'.
   size_t getOutputTimeLimitMs_{0};
@@ -16,6 +16,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 #include "velox/common/base/Counters.h"
@@ -296,6 +298,9 @@ Task::Task(
       mode_(mode),
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(std::move(onError)),
+      adaptiveDriverConcurrency_(
+          mode_ == Task::ExecutionMode::kParallel &&
+          queryCtx_->queryConfig().adaptiveDriverConcurrency()),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
       bufferManager_(OutputBufferManager::getInstance()) {
   // NOTE: the executor must not be folly::InlineLikeExecutor for parallel
@@ -424,6 +429,15 @@ uint64_t Task::driverCpuTimeSliceLimitMs() const {
       : queryCtx_->queryConfig().driverCpuTimeSliceLimitMs();
 }
 
+const std::shared_ptr<DriverExecutor::Group>& Task::driverExecutorGroup(
+    DriverExecutor* executor) {
+  std::call_once(driverExecutorGroupOnce_, [&]() {
+    driverExecutorGroup_ =
+        executor->makeGroup(queryCtx_->queryConfig().cpuShareWeight());
+  });
+  return driverExecutorGroup_;
+}
+
 void Task::initTaskPool() {
   VELOX_CHECK_NULL(pool_);
   pool_ = queryCtx_->pool()->addAggregateChild(
@@ -1096,6 +1110,7 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   bool foundDriver = false;
   bool allFinished = true;
   EventCompletionNotifier stateChangeNotifier;
+  std::vector<ContinuePromise> unparkPromises;
   {
     std::lock_guard<std::timed_mutex> taskLock(self->mutex_);
     for (auto& driverPtr : self->drivers_) {
@@ -1115,6 +1130,15 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
         ++splitGroupState.numFinishedOutputDrivers;
       }
 
+      // Replaces the finished driver with a parked one of the same pipeline.
+      if (pipelineId < self->pipelineConcurrency_.size()) {
+        auto& parked = self->pipelineConcurrency_[pipelineId].parkedPromises;
+        if (!parked.empty()) {
+          unparkPromises.push_back(std::move(parked.back()));
+          parked.pop_back();
+        }
+      }
+
       // Release the driver, note that after this 'driver' is invalid.
       driverPtr = nullptr;
       self->driverClosedLocked();
@@ -1145,6 +1169,9 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
     }
   }
   stateChangeNotifier.notify();
+  for (auto& promise : unparkPromises) {
+    promise.setValue();
+  }
 
   if (!foundDriver) {
     LOG(WARNING) << "Trying to remove a Driver twice from its Task";
@@ -1155,6 +1182,100 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   }
 }
 
+bool Task::maybeParkDriver(uint32_t pipelineId, ContinueFuture* future) {
+  if (!adaptiveDriverConcurrency_) {
+    return false;
+  }
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  if (!isRunningLocked() || pipelineId >= pipelineConcurrency_.size()) {
+    return false;
+  }
+  auto& concurrency = pipelineConcurrency_[pipelineId];
+  if (concurrency.numConsumerBlocks == 0) {
+    return false;
+  }
+  size_t numDrivers = 0;
+  for (const auto& driver : drivers_) {
+    if (driver != nullptr && driver->driverCtx()->pipelineId == pipelineId) {
+      ++numDrivers;
+    }
+  }
+  if (concurrency.parkedPromises.size() + 1 >= numDrivers) {
+    return false;
+  }
+  concurrency.numConsumerBlocks = 0;
+  concurrency.parkedPromises.emplace_back(
+      fmt::format("Task::maybeParkDriver {}", pipelineId));
+  *future = concurrency.parkedPromises.back().getSemiFuture();
+  return true;
+}
+
+void Task::onDriverBlocked(uint32_t pipelineId, BlockingReason reason) {
+  if (!adaptiveDriverConcurrency_) {
+    return;
+  }
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::timed_mutex> l(mutex_);
+    if (reason == BlockingReason::kWaitForConsumer) {
+      if (pipelineConcurrency_.size() <= pipelineId) {
+        pipelineConcurrency_.resize(pipelineId + 1);
+      }
+      ++pipelineConcurrency_[pipelineId].numConsumerBlocks;
+      return;
+    }
+    if (reason != BlockingReason::kWaitForProducer) {
+      return;
+    }
+    // A consumer waits for input. Unparks a driver of a pipeline that was
+    // parked for producing faster than its consumers.
+    for (auto& concurrency : pipelineConcurrency_) {
+      if (!concurrency.parkedPromises.empty()) {
+        promises.push_back(std::move(concurrency.parkedPromises.back()));
+        concurrency.parkedPromises.pop_back();
+        break;
+      }
+    }
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+void Task::recordSplitTiming(
+    const core::PlanNodeId& planNodeId,
+    uint64_t openUs,
+    uint64_t readUs) {
+  // Weight of the latest split in the moving averages.
+  constexpr double kNewWeight = 0.2;
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
+  if (splitsState.splitReadUs == 0) {
+    splitsState.splitOpenUs = openUs;
+    splitsState.splitReadUs = std::max<uint64_t>(1, readUs);
+    return;
+  }
+  splitsState.splitOpenUs =
+      kNewWeight * openUs + (1 - kNewWeight) * splitsState.splitOpenUs;
+  splitsState.splitReadUs =
+      kNewWeight * readUs + (1 - kNewWeight) * splitsState.splitReadUs;
+}
+
+int32_t Task::splitPreloadTarget(
+    const core::PlanNodeId& planNodeId,
+    int32_t numDrivers,
+    int32_t maxSplits) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  const auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
+  if (splitsState.splitReadUs == 0) {
+    return maxSplits;
+  }
+  const auto target = static_cast<int32_t>(std::ceil(
+      numDrivers * splitsState.splitOpenUs /
+      std::max(1.0, splitsState.splitReadUs)));
+  return std::clamp(target, 1, maxSplits);
+}
+
 void Task::ensureSplitGroupsAreBeingProcessedLocked() {
   // Only try creating more drivers if we are running.
   if (not isRunningLocked() or (numDriversPerSplitGroup_ == 0)) {
@@ -1950,6 +2071,11 @@ ContinueFuture Task::terminate(TaskState terminalState) {
       splitGroupStates.push_back(std::move(splitGroupState.second));
     }
 
+    // Resume the parked drivers so that they see the termination.
+    for (auto& concurrency : pipelineConcurrency_) {
+      movePromisesOut(concurrency.parkedPromises, splitPromises);
+    }
+
     // Collect all outstanding split promises from all splits state structures.
     for (auto& pair : splitsStates_) {
       auto& splitState = pair.second;
@@ -2750,7 +2876,8 @@ void Task::createExchangeClientLocked(
       destination_,
       queryCtx()->queryConfig().maxExchangeBufferSize(),
       addExchangeClientPool(planNodeId, pipelineId),
-      queryCtx()->executor());
+      queryCtx()->executor(),
+      queryCtx()->queryConfig().exchangeBdpRequestSizing());
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
@@ -17,6 +17,7 @@
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/DriverExecutor.h"
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
@@ -124,11 +125,22 @@ class Task : public std::enable_shared_from_this<Task> {
   /// disabled) when task is under serial mode.
   uint64_t driverCpuTimeSliceLimitMs() const;
 
+  /// Returns the group in which the drivers of 'this' share the CPU of
+  /// 'executor' with other Tasks. Made on first use with the weight from
+  /// the query config.
+  const std::shared_ptr<DriverExecutor::Group>& driverExecutorGroup(
+      DriverExecutor* executor);
+
   /// Returns QueryCtx specified in the constructor.
   const std::shared_ptr<core::QueryCtx>& queryCtx() const {
     return queryCtx_;
   }
 
+  /// Returns the plan fragment specified in the constructor.
+  const core::PlanFragment& planFragment() const {
+    return planFragment_;
+  }
+
   /// Returns MemoryPool used to allocate memory during execution. This instance
   /// is a child of the MemoryPool passed in the constructor.
   memory::MemoryPool* pool() const {
@@ -629,6 +641,37 @@ class Task : public std::enable_shared_from_this<Task> {
     return mutex_;
   }
 
+  /// Called by a Driver of 'pipelineId' that is about to yield the thread.
+  /// If adaptive driver concurrency is enabled and the drivers of the
+  /// pipeline have been blocked waiting for their consumers since the last
+  /// park, returns true and sets 'future'. The driver then parks until
+  /// 'future' is realized instead of going back to the run queue. At least
+  /// one driver of a pipeline stays unparked.
+  bool maybeParkDriver(uint32_t pipelineId, ContinueFuture* future);
+
+  /// Called by a Driver of 'pipelineId' that went off thread blocked for
+  /// 'reason'. If adaptive driver concurrency is enabled, counts the blocks
+  /// for output space of the pipeline and unparks a driver when a consumer
+  /// waits for input.
+  void onDriverBlocked(uint32_t pipelineId, BlockingReason reason);
+
+  /// Records that a driver of the table scan 'planNodeId' took 'openUs' to
+  /// open a split and 'readUs' to read it.
+  void recordSplitTiming(
+      const core::PlanNodeId& planNodeId,
+      uint64_t openUs,
+      uint64_t readUs);
+
+  /// Returns the number of queued splits of the table scan 'planNodeId' to
+  /// preload, so that the splits are opened by the time the 'numDrivers'
+  /// drivers of the scan need them. By Little's law this is the number of
+  /// splits the drivers read in the time it takes to open one. At most
+  /// 'maxSplits'. Returns 'maxSplits' before the first split is read.
+  int32_t splitPreloadTarget(
+      const core::PlanNodeId& planNodeId,
+      int32_t numDrivers,
+      int32_t maxSplits);
+
   /// Returns the number of concurrent drivers in the pipeline of 'driver'.
   int32_t numDrivers(Driver* driver) {
     return driverFactories_[driver->driverCtx()->pipelineId]->numDrivers;
@@ -997,6 +1040,10 @@ class Task : public std::enable_shared_from_this<Task> {
   const int destination_;
   const std::shared_ptr<core::QueryCtx> queryCtx_;
 
+  // The group of the drivers in the DriverExecutor of 'queryCtx_', if any.
+  std::once_flag driverExecutorGroupOnce_;
+  std::shared_ptr<DriverExecutor::Group> driverExecutorGroup_;
+
   // The execution mode of the task. It is enforced that a task can only be
   // executed in a single mode throughout its lifetime
   const ExecutionMode mode_;
@@ -1049,6 +1096,21 @@ class Task : public std::enable_shared_from_this<Task> {
 
   std::vector<std::unique_ptr<DriverFactory>> driverFactories_;
   std::vector<std::shared_ptr<Driver>> drivers_;
+
+  // The state of adaptive driver concurrency of a pipeline.
+  struct PipelineConcurrency {
+    // Number of times drivers of the pipeline blocked waiting for their
+    // consumers since the last park.
+    uint32_t numConsumerBlocks{0};
+    // Resumes the parked drivers of the pipeline.
+    std::vector<ContinuePromise> parkedPromises;
+  };
+
+  // True if drivers may be parked to follow the throughput of their
+  // consumers. Set from the query config.
+  const bool adaptiveDriverConcurrency_;
+  // Indexed by pipeline id. Guarded by 'mutex_'.
+  std::vector<PipelineConcurrency> pipelineConcurrency_;
   // When Drivers are closed by the Task, there is a chance that race and/or
   // bugs can cause such Drivers to be held forever, in turn holding a pointer
   // to the Task making it a zombie Tasks. This vector is used to keep track of
@@ -73,6 +73,12 @@ struct SplitsState {
   /// Map split group id -> split store.
   std::unordered_map<uint32_t, SplitsStore> groupSplitsStores;
 
+  /// Moving averages of the wall time in microseconds to open a split of a
+  /// table scan and to read it after opening. Shared by all drivers of the
+  /// scan to size the split preload window. 0 before the first split.
+  double splitOpenUs{0};
+  double splitReadUs{0};
+
   /// We need these due to having promises in the structure.
   SplitsState() = default;
   SplitsState(SplitsState const&) = delete;
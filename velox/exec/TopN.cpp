@@ -15,11 +15,110 @@
  */
 #include <folly/container/F14Map.h>
 
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/TopN.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+std::vector<column_index_t> sortingKeyChannels(
+    const std::shared_ptr<const core::TopNNode>& topNNode) {
+  std::vector<column_index_t> channels;
+  channels.reserve(topNNode->sortingKeys().size());
+  for (const auto& key : topNNode->sortingKeys()) {
+    channels.emplace_back(exprToChannel(key.get(), topNNode->outputType()));
+  }
+  return channels;
+}
+
+std::vector<CompareFlags> makeCompareFlags(
+    const std::vector<core::SortOrder>& sortingOrders) {
+  std::vector<CompareFlags> compareFlags;
+  compareFlags.reserve(sortingOrders.size());
+  for (const auto& order : sortingOrders) {
+    compareFlags.push_back(
+        {order.isNullsFirst(),
+         order.isAscending(),
+         false,
+         CompareFlags::NullHandlingMode::kNullAsValue});
+  }
+  return compareFlags;
+}
+
+// Maps the columns of the row container, which stores the sorting keys first,
+// to the input columns.
+std::vector<IdentityProjection> makeColumnMap(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& sortingKeyChannels) {
+  std::vector<IdentityProjection> columnMap;
+  columnMap.reserve(inputType->size());
+  std::vector<bool> isSortingKey(inputType->size());
+  for (column_index_t i = 0; i < sortingKeyChannels.size(); ++i) {
+    columnMap.emplace_back(i, sortingKeyChannels[i]);
+    isSortingKey[sortingKeyChannels[i]] = true;
+  }
+  for (column_index_t i = 0; i < inputType->size(); ++i) {
+    if (!isSortingKey[i]) {
+      columnMap.emplace_back(columnMap.size(), i);
+    }
+  }
+  return columnMap;
+}
+
+// Returns a filter passing the values that sort before or equal to 'boundary'
+// with 'flags'. Nulls pass if they sort first.
+std::unique_ptr<common::Filter> makeBoundaryFilter(
+    int64_t boundary,
+    const CompareFlags& flags) {
+  if (flags.ascending) {
+    return std::make_unique<common::BigintRange>(
+        std::numeric_limits<int64_t>::min(), boundary, flags.nullsFirst);
+  }
+  return std::make_unique<common::BigintRange>(
+      boundary, std::numeric_limits<int64_t>::max(), flags.nullsFirst);
+}
+
+std::unique_ptr<common::Filter> makeBoundaryFilter(
+    const Timestamp& boundary,
+    const CompareFlags& flags) {
+  if (flags.ascending) {
+    return std::make_unique<common::TimestampRange>(
+        std::numeric_limits<Timestamp>::min(), boundary, flags.nullsFirst);
+  }
+  return std::make_unique<common::TimestampRange>(
+      boundary, std::numeric_limits<Timestamp>::max(), flags.nullsFirst);
+}
+
+bool supportsBoundaryFilter(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDecimal();
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+RowTypePtr makeSpillType(
+    const RowTypePtr& inputType,
+    const std::vector<IdentityProjection>& columnMap) {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  names.reserve(columnMap.size());
+  types.reserve(columnMap.size());
+  for (const auto& projection : columnMap) {
+    names.push_back(inputType->nameOf(projection.outputChannel));
+    types.push_back(inputType->childAt(projection.outputChannel));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -29,44 +128,59 @@ TopN::TopN(
           topNNode->outputType(),
           operatorId,
           topNNode->id(),
-          "TopN"),
+          "TopN",
+          topNNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       count_(topNNode->count()),
-      data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
+      sortingKeyColumns_(sortingKeyChannels(topNNode)),
+      sortCompareFlags_(makeCompareFlags(topNNode->sortingOrders())),
+      columnMap_(makeColumnMap(outputType_, sortingKeyColumns_)),
+      spillType_(makeSpillType(outputType_, columnMap_)),
+      data_(std::make_unique<RowContainer>(
+          std::vector<TypePtr>(
+              spillType_->children().begin(),
+              spillType_->children().begin() + sortingKeyColumns_.size()),
+          std::vector<TypePtr>(
+              spillType_->children().begin() + sortingKeyColumns_.size(),
+              spillType_->children().end()),
+          pool())),
       comparator_(
-          outputType_,
+          spillType_,
           topNNode->sortingKeys(),
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {
-  const auto numColumns{outputType_->children().size()};
-  const auto numSortingKeys{topNNode->sortingKeys().size()};
-  sortingKeyColumns_.reserve(numSortingKeys);
-  std::vector<bool> isSortingKey(numColumns);
-  for (const auto& key : topNNode->sortingKeys()) {
-    sortingKeyColumns_.emplace_back(exprToChannel(key.get(), outputType_));
-    isSortingKey[sortingKeyColumns_.back()] = true;
-  }
-  if (numColumns > numSortingKeys) {
-    nonKeyColumns_.reserve(numColumns - numSortingKeys);
-    for (column_index_t i = 0; i < numColumns; ++i) {
-      if (!isSortingKey[i]) {
-        nonKeyColumns_.emplace_back(i);
-      }
-    }
+      decodedVectors_(spillType_->size()) {}
+
+void TopN::initialize() {
+  Operator::initialize();
+  const auto channel = sortingKeyColumns_[0];
+  if (supportsBoundaryFilter(*outputType_->childAt(channel)) &&
+      !operatorCtx_->driverCtx()
+           ->driver->canPushdownFilters(this, {channel})
+           .empty()) {
+    boundaryFilterChannel_ = channel;
   }
 }
 
 void TopN::addInput(RowVectorPtr input) {
-  for (const auto col : sortingKeyColumns_) {
-    decodedVectors_[col].decode(*input->childAt(col));
+  ensureInputFits(input);
+
+  const auto numSortingKeys = sortingKeyColumns_.size();
+  for (column_index_t i = 0; i < numSortingKeys; ++i) {
+    decodedVectors_[i].decode(*input->childAt(columnMap_[i].outputChannel));
   }
 
-  const bool hasNonKeyColumn{!nonKeyColumns_.empty()};
+  const bool hasNonKeyColumn{columnMap_.size() > numSortingKeys};
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
   for (auto row = 0; row < input->size(); ++row) {
+    if (boundary_ != nullptr && !isBelowBoundary(input, row)) {
+      continue;
+    }
+
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -82,35 +196,231 @@ void TopN::addInput(RowVectorPtr input) {
     }
 
     data_->initializeFields(newRow);
-    for (const auto col : sortingKeyColumns_) {
-      data_->store(decodedVectors_[col], row, newRow, col);
+    for (column_index_t i = 0; i < numSortingKeys; ++i) {
+      data_->store(decodedVectors_[i], row, newRow, i);
     }
 
     topRows_.push(newRow);
     if (hasNonKeyColumn) {
       passedRows[newRow] = row;
     }
+    if (boundaryFilterChannel_.has_value() && topRows_.size() == count_) {
+      boundaryChanged_ = true;
+    }
+  }
+  if (boundaryChanged_) {
+    addBoundaryFilter();
   }
 
   if (hasNonKeyColumn && !passedRows.empty()) {
-    for (const auto col : nonKeyColumns_) {
-      decodedVectors_[col].decode(*input->childAt(col));
+    for (column_index_t i = numSortingKeys; i < columnMap_.size(); ++i) {
+      decodedVectors_[i].decode(*input->childAt(columnMap_[i].outputChannel));
       for (const auto [dataRow, inputRow] : passedRows) {
         data_->store(
-            decodedVectors_[col],
+            decodedVectors_[i],
             inputRow,
             reinterpret_cast<char*>(dataRow),
-            col);
+            i);
       }
     }
   }
 }
 
+void TopN::addBoundaryFilter() {
+  boundaryChanged_ = false;
+  const char* row = topRows_.top();
+  const auto column = data_->columnAt(0);
+  if (RowContainer::isNullAt(row, column)) {
+    return;
+  }
+  const auto& flags = sortCompareFlags_[0];
+  std::unique_ptr<common::Filter> filter;
+  switch (spillType_->childAt(0)->kind()) {
+    case TypeKind::TINYINT:
+      filter = makeBoundaryFilter(
+          RowContainer::valueAt<int8_t>(row, column.offset()), flags);
+      break;
+    case TypeKind::SMALLINT:
+      filter = makeBoundaryFilter(
+          RowContainer::valueAt<int16_t>(row, column.offset()), flags);
+      break;
+    case TypeKind::INTEGER:
+      filter = makeBoundaryFilter(
+          RowContainer::valueAt<int32_t>(row, column.offset()), flags);
+      break;
+    case TypeKind::BIGINT:
+      filter = makeBoundaryFilter(
+          RowContainer::valueAt<int64_t>(row, column.offset()), flags);
+      break;
+    case TypeKind::TIMESTAMP:
+      filter = makeBoundaryFilter(
+          RowContainer::valueAt<Timestamp>(row, column.offset()), flags);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  dynamicFilters_[boundaryFilterChannel_.value()] = std::move(filter);
+}
+
+bool TopN::isBelowBoundary(const RowVectorPtr& input, vector_size_t row)
+    const {
+  for (column_index_t i = 0; i < sortingKeyColumns_.size(); ++i) {
+    const auto result = input->childAt(sortingKeyColumns_[i])
+                            ->compare(
+                                boundary_->childAt(i).get(),
+                                row,
+                                0,
+                                sortCompareFlags_[i])
+                            .value();
+    if (result != 0) {
+      return result < 0;
+    }
+  }
+  return false;
+}
+
+void TopN::ensureInputFits(const RowVectorPtr& input) {
+  if (!spillEnabled()) {
+    // Spilling is disabled.
+    return;
+  }
+
+  const auto numRows = data_->numRows();
+  if (numRows == 0) {
+    // 'data_' is empty. Nothing to spill.
+    return;
+  }
+
+  // Test-only spill path.
+  if (testingTriggerSpill(pool()->name())) {
+    Operator::ReclaimableSectionGuard guard(this);
+    memory::testingRunArbitration(pool());
+    return;
+  }
+
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const auto outOfLineBytesPerRow = outOfLineBytes / numRows;
+  // Once the heap is full, a new row reuses the memory of the row it replaces
+  // except for its variable width data.
+  const auto numNewRows = std::min<int64_t>(
+      input->size(), std::max<int64_t>(0, count_ - topRows_.size()));
+
+  const auto currentUsage = pool()->usedBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig_->minSpillableReservationPct / 100;
+  const auto availableReservationBytes = pool()->availableReservation();
+  const auto incrementBytes = data_->sizeIncrement(
+      numNewRows, outOfLineBytesPerRow * input->size());
+
+  // First to check if we have sufficient minimal memory reservation.
+  if (availableReservationBytes >= minReservationBytes) {
+    if (freeRows > numNewRows &&
+        (outOfLineBytes == 0 ||
+         outOfLineFreeBytes >= outOfLineBytesPerRow * input->size())) {
+      // Enough free rows for input rows and enough variable length free space.
+      return;
+    }
+  }
+
+  // Check if we can increase reservation. The increment is the largest of twice
+  // the maximum increment from this input and 'spillableReservationGrowthPct_'
+  // of the current memory usage.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  {
+    Operator::ReclaimableSectionGuard guard(this);
+    if (pool()->maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
+               << " for memory pool " << pool()->name()
+               << ", usage: " << succinctBytes(pool()->usedBytes())
+               << ", reservation: " << succinctBytes(pool()->reservedBytes());
+}
+
+void TopN::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (noMoreInput_) {
+    LOG(WARNING) << "Can't reclaim from topN operator which has received all "
+                 << "the input, memory usage: "
+                 << succinctBytes(pool()->usedBytes())
+                 << ", reservation: " << succinctBytes(pool()->reservedBytes());
+    return;
+  }
+
+  if (data_->numRows() == 0) {
+    // Nothing to spill.
+    return;
+  }
+  spill();
+
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void TopN::spill() {
+  VELOX_CHECK(spillEnabled());
+  VELOX_CHECK_GT(data_->numRows(), 0);
+
+  if (spiller_ == nullptr) {
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderByInput,
+        data_.get(),
+        spillType_,
+        sortingKeyColumns_.size(),
+        sortCompareFlags_,
+        &spillConfig_.value(),
+        &spillStats_);
+  }
+
+  const auto rowSize = data_->estimateRowSize();
+  if (rowSize.has_value() &&
+      rowSize.value() > estimatedOutputRowSize_.value_or(0)) {
+    estimatedOutputRowSize_ = rowSize;
+  }
+  // The top of a full heap is the N-th row of this run. As the later input rows
+  // are only kept if they sort before it, this is at least as tight as any
+  // previous boundary.
+  if (topRows_.size() == count_) {
+    updateBoundary(topRows_.top());
+  }
+
+  spiller_->spill();
+  topRows_ = decltype(topRows_)(comparator_);
+  data_->clear();
+}
+
+void TopN::updateBoundary(const char* row) {
+  const auto numSortingKeys = sortingKeyColumns_.size();
+  boundary_ = BaseVector::create<RowVector>(
+      ROW(std::vector<TypePtr>(
+          spillType_->children().begin(),
+          spillType_->children().begin() + numSortingKeys)),
+      1,
+      pool());
+  for (column_index_t i = 0; i < numSortingKeys; ++i) {
+    data_->extractColumn(&row, 1, i, boundary_->childAt(i));
+  }
+}
+
 RowVectorPtr TopN::getOutput() {
   if (finished_ || !noMoreInput_) {
     return nullptr;
   }
 
+  if (spillMerger_ != nullptr) {
+    return getOutputFromSpill();
+  }
+
   const auto numRowsToReturn = std::min<vector_size_t>(
       outputBatchSize_, rows_.size() - numRowsReturned_);
   VELOX_CHECK_GT(numRowsToReturn, 0);
@@ -118,20 +428,81 @@ RowVectorPtr TopN::getOutput() {
   auto result = BaseVector::create<RowVector>(
       outputType_, numRowsToReturn, operatorCtx_->pool());
 
-  for (auto i = 0; i < outputType_->size(); ++i) {
+  for (const auto& columnProjection : columnMap_) {
     data_->extractColumn(
         rows_.data() + numRowsReturned_,
         numRowsToReturn,
-        i,
-        result->childAt(i));
+        columnProjection.inputChannel,
+        result->childAt(columnProjection.outputChannel));
   }
   numRowsReturned_ += numRowsToReturn;
   finished_ = (numRowsReturned_ == rows_.size());
   return result;
 }
 
+RowVectorPtr TopN::getOutputFromSpill() {
+  const auto maxOutputRows = std::min<vector_size_t>(
+      outputBatchSize_, count_ - numRowsReturned_);
+  VELOX_CHECK_GT(maxOutputRows, 0);
+
+  auto result = BaseVector::create<RowVector>(
+      outputType_, maxOutputRows, operatorCtx_->pool());
+
+  // Copy out the consecutive rows of the winning stream which sort before the
+  // runner-up as one range.
+  vector_size_t outputRow = 0;
+  while (outputRow < maxOutputRows) {
+    auto [stream, runnerUp] = spillMerger_->nextWithRunnerUp();
+    if (stream == nullptr) {
+      break;
+    }
+
+    const auto numRows =
+        stream->numRunRows(runnerUp, maxOutputRows - outputRow);
+    const BaseVector::CopyRange range{
+        stream->currentIndex(), outputRow, numRows};
+    for (const auto& columnProjection : columnMap_) {
+      result->childAt(columnProjection.outputChannel)
+          ->copyRanges(
+              stream->current().childAt(columnProjection.inputChannel).get(),
+              folly::Range(&range, 1));
+    }
+    outputRow += numRows;
+    // Advance the stream.
+    stream->pop(numRows);
+  }
+
+  numRowsReturned_ += outputRow;
+  // Stop reading the spilled runs as soon as 'count_' rows are returned.
+  if (outputRow < maxOutputRows || numRowsReturned_ == count_) {
+    finished_ = true;
+    spillMerger_.reset();
+  }
+  if (outputRow == 0) {
+    return nullptr;
+  }
+  result->resize(outputRow);
+  return result;
+}
+
 void TopN::noMoreInput() {
   Operator::noMoreInput();
+  if (spiller_ != nullptr) {
+    // Spill the remaining rows so that all the rows are merged from the
+    // spilled sorted runs.
+    if (data_->numRows() > 0) {
+      spill();
+    }
+    SpillPartitionSet spillPartitionSet;
+    spiller_->finishSpill(spillPartitionSet);
+    VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+    spillMerger_ = spillPartitionSet.begin()->second->createOrderedReader(
+        spillConfig_->readBufferSize, pool(), &spillStats_);
+    outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
+    pool()->release();
+    return;
+  }
+
   if (topRows_.empty()) {
     finished_ = true;
     return;
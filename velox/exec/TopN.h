@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -27,6 +28,8 @@ class TopN : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::TopNNode>& topNNode);
 
+  void initialize() override;
+
   bool needsInput() const override {
     return !noMoreInput_;
   }
@@ -43,14 +46,57 @@ class TopN : public Operator {
 
   bool isFinished() override;
 
+  /// Spills the current top rows as a sorted run. Spilling is only supported
+  /// while receiving input. Once all input is received, the output holds at
+  /// most 'count_' rows in memory, and this is a no-op.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Ensures there is sufficient memory reserved to process 'input'.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills the current top rows as a sorted run and clears 'data_'. If the
+  // heap is full, its top becomes the new 'boundary_'.
+  void spill();
+
+  // Copies the sorting keys of 'row' into 'boundary_'.
+  void updateBoundary(const char* row);
+
+  // Returns true if 'row' of 'input' sorts before 'boundary_'.
+  bool isBelowBoundary(const RowVectorPtr& input, vector_size_t row) const;
+
+  // Adds a dynamic filter on the first sorting key that passes the values
+  // which sort before or equal to the key of the N-th row. The source can then
+  // skip the rows, row groups and splits which cannot enter the top rows.
+  void addBoundaryFilter();
+
+  RowVectorPtr getOutputFromSpill();
+
   const int32_t count_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
 
-  std::vector<column_index_t> sortingKeyColumns_;
-  std::vector<column_index_t> nonKeyColumns_;
+  // The input channels of the sorting keys.
+  const std::vector<column_index_t> sortingKeyColumns_;
+  const std::vector<CompareFlags> sortCompareFlags_;
+  // The column projection map between 'data_' and the input as 'data_' stores
+  // the sorting keys first, followed by the other columns, so that the rows
+  // can be spilled as sorted runs.
+  const std::vector<IdentityProjection> columnMap_;
+  // The data type of the rows stored in 'data_' and spilled on disk.
+  const RowTypePtr spillType_;
+
+  // The input channel of the first sorting key if a filter on it can be pushed
+  // down to the source.
+  std::optional<column_index_t> boundaryFilterChannel_;
+  // True if the N-th row changed since the last boundary filter was added.
+  bool boundaryChanged_{false};
 
   // As the inputs are added to TopN operator, we use topRows_ (a priority
   // queue) to keep track of the pointers to rows stored in the
@@ -66,7 +112,17 @@ class TopN : public Operator {
   std::priority_queue<char*, std::vector<char*>, RowComparator> topRows_;
   std::vector<char*> rows_;
 
+  // Decoded input columns in the column order of 'data_'.
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  std::unique_ptr<Spiller> spiller_;
+  // The sorting keys of the N-th row of the most recent spilled run which was
+  // full. The spilled runs already hold 'count_' rows which sort before or
+  // equal to it, so only the input rows which sort before it are kept.
+  RowVectorPtr boundary_;
+  std::optional<uint64_t> estimatedOutputRowSize_;
+  // Used to merge the spilled sorted runs on output.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerger_;
 };
 } // namespace facebook::velox::exec
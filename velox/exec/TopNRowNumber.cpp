@@ -114,6 +114,7 @@ TopNRowNumber::TopNRowNumber(
           node->canSpill(driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
+      rankFunction_{node->rankFunction()},
       limit_{node->limit()},
       generateRowNumber_{node->generateRowNumber()},
       numPartitionKeys_{node->partitionKeys().size()},
@@ -128,6 +129,8 @@ TopNRowNumber::TopNRowNumber(
           driverCtx->queryConfig().abandonPartialTopNRowNumberMinRows()),
       abandonPartialMinPct_(
           driverCtx->queryConfig().abandonPartialTopNRowNumberMinPct()),
+      compactVariableWidthDataPct_(
+          driverCtx->queryConfig().compactVariableWidthDataPct()),
       data_(std::make_unique<RowContainer>(
           slice(inputType_->children(), 0, spillCompareFlags_.size()),
           slice(
@@ -223,6 +226,28 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
       processInputRow(i, *singlePartition_);
     }
   }
+  maybeCompactVariableWidthData();
+}
+
+void TopNRowNumber::maybeCompactVariableWidthData() {
+  // Compacting a small arena does not pay for the copy.
+  static constexpr int64_t kMinCompactionBytes = 1 << 20;
+  if (abandonedPartial_ || compactVariableWidthDataPct_ == 0 ||
+      data_->stringAllocator().retainedSize() < kMinCompactionBytes) {
+    return;
+  }
+  const auto fragmentationPct = data_->variableWidthFragmentationPct();
+  addRuntimeStat(
+      RowContainer::kVariableWidthFragmentationPct,
+      RuntimeCounter(fragmentationPct));
+  if (fragmentationPct < compactVariableWidthDataPct_) {
+    return;
+  }
+  const auto releasedBytes = data_->compactVariableWidthData();
+  addRuntimeStat("variableWidthCompactions", RuntimeCounter(1));
+  addRuntimeStat(
+      "variableWidthCompactedBytes",
+      RuntimeCounter(releasedBytes, RuntimeCounter::Unit::kBytes));
 }
 
 bool TopNRowNumber::abandonPartialEarly() const {
@@ -247,6 +272,11 @@ void TopNRowNumber::initializeNewPartitions() {
 }
 
 void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
+  if (rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber) {
+    processInputRowWithTies(index, partition);
+    return;
+  }
+
   auto& topRows = partition.rows;
 
   char* newRow = nullptr;
@@ -267,11 +297,116 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     newRow = data_->initializeRow(topRow, true /* reuse */);
   }
 
+  addRow(index, newRow, partition);
+}
+
+void TopNRowNumber::processInputRowWithTies(
+    vector_size_t index,
+    TopRows& partition) {
+  const bool denseRank = rankFunction_ ==
+      core::TopNRowNumberNode::RankFunction::kDenseRank;
+  auto& topRows = partition.rows;
+
+  if (topRows.empty()) {
+    partition.numDistinct = 1;
+    addRow(index, data_->newRow(), partition);
+    return;
+  }
+
+  const auto result =
+      comparator_.compare(decodedVectors_, index, topRows.top());
+  if (result == 0) {
+    // Ties with the top rows, hence has the same rank.
+    addRow(index, data_->newRow(), partition);
+    return;
+  }
+
+  if (result > 0) {
+    // Sorts after all the rows of the partition. Its rank is one above the
+    // number of rows, its dense rank one above the number of distinct values.
+    if (denseRank) {
+      if (partition.numDistinct >= limit_) {
+        return;
+      }
+      ++partition.numDistinct;
+    } else if (topRows.size() >= limit_) {
+      return;
+    }
+    addRow(index, data_->newRow(), partition);
+    return;
+  }
+
+  // Sorts before the top rows, whose rank goes up by one. Drop the top rows if
+  // it exceeds the limit. The rank of the other rows stays within the limit.
+  if (denseRank) {
+    if (!hasPeer(index, partition)) {
+      if (partition.numDistinct >= limit_) {
+        popTopRows(partition);
+        data_->eraseRows(
+            folly::Range<char**>(tiedRows_.data(), tiedRows_.size()));
+      } else {
+        ++partition.numDistinct;
+      }
+    }
+  } else if (topRows.size() >= limit_) {
+    popTopRows(partition);
+    // With the new row, the rank of the top rows is 'topRows.size() + 2'.
+    if (topRows.size() + 1 >= limit_) {
+      data_->eraseRows(
+          folly::Range<char**>(tiedRows_.data(), tiedRows_.size()));
+    } else {
+      for (auto* row : tiedRows_) {
+        topRows.push(row);
+      }
+    }
+  }
+  addRow(index, data_->newRow(), partition);
+}
+
+void TopNRowNumber::addRow(
+    vector_size_t index,
+    char* row,
+    TopRows& partition) {
   for (auto col = 0; col < decodedVectors_.size(); ++col) {
-    data_->store(decodedVectors_[col], index, newRow, col);
+    data_->store(decodedVectors_[col], index, row, col);
+  }
+
+  partition.rows.push(row);
+}
+
+bool TopNRowNumber::hasPeer(vector_size_t index, const TopRows& partition) {
+  const auto& rows = partition.rows.c;
+  return std::any_of(rows.begin(), rows.end(), [&](const char* row) {
+    return comparator_.compare(decodedVectors_, index, row) == 0;
+  });
+}
+
+void TopNRowNumber::popTopRows(TopRows& partition) {
+  auto& topRows = partition.rows;
+  tiedRows_.clear();
+  tiedRows_.push_back(topRows.top());
+  topRows.pop();
+  while (!topRows.empty() &&
+         comparator_.compare(topRows.top(), tiedRows_.front()) == 0) {
+    tiedRows_.push_back(topRows.top());
+    topRows.pop();
   }
+}
 
-  topRows.push(newRow);
+int64_t TopNRowNumber::computeRank(
+    int64_t previousRank,
+    int64_t rowNumber,
+    bool isPeer) const {
+  switch (rankFunction_) {
+    case core::TopNRowNumberNode::RankFunction::kRowNumber:
+      return rowNumber;
+    case core::TopNRowNumberNode::RankFunction::kRank:
+      return isPeer ? previousRank : rowNumber;
+    case core::TopNRowNumberNode::RankFunction::kDenseRank:
+      return isPeer ? previousRank : previousRank + 1;
+    default:
+      VELOX_UNREACHABLE();
+  }
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -357,21 +492,32 @@ TopNRowNumber::TopRows& TopNRowNumber::currentPartition() {
   return partitionAt(partitions_[currentPartition_.value()]);
 }
 
+void TopNRowNumber::loadPartitionRows(TopRows& partition) {
+  auto& rows = partition.rows;
+  partitionRows_.resize(rows.size());
+  for (auto i = partitionRows_.size(); i > 0; --i) {
+    partitionRows_[i - 1] = rows.top();
+    rows.pop();
+  }
+  nextPartitionRow_ = 0;
+  lastRank_ = 0;
+}
+
 void TopNRowNumber::appendPartitionRows(
-    TopRows& partition,
-    vector_size_t start,
-    vector_size_t size,
+    vector_size_t numRows,
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
-  // Append 'size' partition rows in reverse order starting from 'start' row.
-  auto rowNumber = partition.rows.size() - start;
-  for (auto i = 0; i < size; ++i) {
-    const auto index = outputOffset + size - i - 1;
+  const bool hasTies =
+      rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber;
+  for (auto i = 0; i < numRows; ++i, ++nextPartitionRow_) {
+    auto* row = partitionRows_[nextPartitionRow_];
     if (rowNumbers) {
-      rowNumbers->set(index, rowNumber--);
+      const bool isPeer = hasTies && nextPartitionRow_ > 0 &&
+          comparator_.compare(partitionRows_[nextPartitionRow_ - 1], row) == 0;
+      lastRank_ = computeRank(lastRank_, nextPartitionRow_ + 1, isPeer);
+      rowNumbers->set(outputOffset + i, lastRank_);
     }
-    outputRows_[index] = partition.rows.top();
-    partition.rows.pop();
+    outputRows_[outputOffset + i] = row;
   }
 }
 
@@ -429,37 +575,20 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   }
 
   vector_size_t offset = 0;
-  if (remainingRowsInPartition_ > 0) {
-    auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
-    auto numRows =
-        std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
-    appendPartitionRows(partition, start, numRows, offset, rowNumbers);
-    offset += numRows;
-    remainingRowsInPartition_ -= numRows;
-  }
-
   while (offset < outputBatchSize_) {
-    auto* partition = nextPartition();
-    if (!partition) {
-      break;
-    }
-
-    auto numRows = partition->rows.size();
-    if (offset + numRows > outputBatchSize_) {
-      remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
-
-      // Add a subset of partition rows.
-      numRows -= remainingRowsInPartition_;
-      appendPartitionRows(*partition, 0, numRows, offset, rowNumbers);
-      offset += numRows;
-      break;
+    if (nextPartitionRow_ == partitionRows_.size()) {
+      auto* partition = nextPartition();
+      if (!partition) {
+        break;
+      }
+      loadPartitionRows(*partition);
     }
 
-    // Add all partition rows.
-    appendPartitionRows(*partition, 0, numRows, offset, rowNumbers);
+    // Add the remaining partition rows or a subset of them that fits.
+    const auto numRows = std::min<vector_size_t>(
+        outputBatchSize_ - offset, partitionRows_.size() - nextPartitionRow_);
+    appendPartitionRows(numRows, offset, rowNumbers);
     offset += numRows;
-    remainingRowsInPartition_ = 0;
   }
 
   if (offset == 0) {
@@ -484,41 +613,50 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   return output;
 }
 
-bool TopNRowNumber::isNewPartition(
+bool TopNRowNumber::equalColumns(
     const RowVectorPtr& output,
     vector_size_t index,
-    SpillMergeStream* next) {
+    SpillMergeStream* next,
+    column_index_t start,
+    column_index_t end) {
   VELOX_CHECK_GT(index, 0);
 
-  for (auto i = 0; i < numPartitionKeys_; ++i) {
+  for (auto i = start; i < end; ++i) {
     if (!output->childAt(inputChannels_[i])
              ->equalValueAt(
                  next->current().childAt(i).get(),
                  index - 1,
                  next->currentIndex())) {
-      return true;
+      return false;
     }
   }
-  return false;
+  return true;
 }
 
 void TopNRowNumber::setupNextOutput(
     const RowVectorPtr& output,
-    int32_t rowNumber) {
-  nextRowNumber_ = rowNumber;
+    vector_size_t rowNumber,
+    int64_t rank) {
+  nextRowNumber_ = 0;
+  nextRank_ = 1;
 
   auto lookAhead = merge_->next();
   if (lookAhead == nullptr) {
-    nextRowNumber_ = 0;
     return;
   }
 
   if (isNewPartition(output, output->size(), lookAhead)) {
-    nextRowNumber_ = 0;
     return;
   }
 
-  if (nextRowNumber_ < limit_) {
+  const auto nextRank = computeRank(
+      rank,
+      rowNumber + 1,
+      rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber &&
+          isPeer(output, output->size(), lookAhead));
+  if (nextRank <= limit_) {
+    nextRowNumber_ = rowNumber;
+    nextRank_ = nextRank;
     return;
   }
 
@@ -527,14 +665,12 @@ void TopNRowNumber::setupNextOutput(
 
   while (auto next = merge_->next()) {
     if (isNewPartition(output, output->size(), next)) {
-      nextRowNumber_ = 0;
       return;
     }
     next->pop();
   }
 
   // This partition is the last partition.
-  nextRowNumber_ = 0;
 }
 
 RowVectorPtr TopNRowNumber::getOutputFromSpill() {
@@ -544,8 +680,9 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
   // All rows from the same partition will appear together.
   // We'll identify partition boundaries by comparing partition keys of the
   // current row with the previous row. When new partition starts, we'll reset
-  // row number to zero. Once row number reaches the 'limit_', we'll start
-  // dropping rows until the next partition starts.
+  // row number to zero. For rank and dense_rank, the rank only goes up if the
+  // sorting keys differ from the previous row. Once the rank exceeds the
+  // 'limit_', we'll start dropping rows until the next partition starts.
   // We'll emit output every time we accumulate 'outputBatchSize_' rows.
 
   auto output =
@@ -558,21 +695,32 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
   // Index of the next row to append to output.
   vector_size_t index = 0;
 
-  // Row number of the next row in the current partition.
+  // Number of preceding rows in the current partition and the rank of the next
+  // row.
   vector_size_t rowNumber = nextRowNumber_;
-  VELOX_CHECK_LT(rowNumber, limit_);
+  int64_t rank = nextRank_;
+  VELOX_CHECK_LE(rank, limit_);
+  const bool hasTies =
+      rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber;
   for (;;) {
     auto next = merge_->next();
     if (next == nullptr) {
       break;
     }
 
-    // Check if this row comes from a new partition.
-    if (index > 0 && isNewPartition(output, index, next)) {
-      rowNumber = 0;
+    // Check if this row comes from a new partition. The rank of the first row
+    // in the batch is set by setupNextOutput().
+    if (index > 0) {
+      if (isNewPartition(output, index, next)) {
+        rowNumber = 0;
+        rank = 1;
+      } else {
+        rank = computeRank(
+            rank, rowNumber + 1, hasTies && isPeer(output, index, next));
+      }
     }
 
-    if (rowNumber < limit_) {
+    if (rank <= limit_) {
       for (auto i = 0; i < inputChannels_.size(); ++i) {
         output->childAt(inputChannels_[i])
             ->copy(
@@ -582,8 +730,7 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
                 1);
       }
       if (rowNumbers) {
-        // Row numbers start with 1.
-        rowNumbers->set(index, rowNumber + 1);
+        rowNumbers->set(index, rank);
       }
       ++index;
     } else {
@@ -597,7 +744,7 @@ RowVectorPtr TopNRowNumber::getOutputFromSpill() {
       // Check if next row is from a new partition. Reset 'nextRowNumber_' if
       // so. Check if next row is from the current partition, but we have
       // reached the 'limit_'. Skip to the start of the next partition if so.
-      setupNextOutput(output, rowNumber);
+      setupNextOutput(output, rowNumber, rank);
 
       return output;
     }
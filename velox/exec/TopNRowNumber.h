@@ -21,19 +21,20 @@
 namespace facebook::velox::exec {
 
 /// Partitions the input using specified partitioning keys, sorts rows within
-/// partitions using specified sorting keys, assigns row numbers and returns up
-/// to specified number of rows per partition.
+/// partitions using specified sorting keys, assigns row numbers, ranks or dense
+/// ranks and returns the rows whose number or rank doesn't exceed the limit.
 ///
 /// It is allowed to not specify partitioning keys. In this case the whole input
 /// is treated as a single partition.
 ///
 /// At least one sorting key must be specified.
 ///
-/// The limit (maximum number of rows to return per partition) must be greater
-/// than zero.
+/// The limit (maximum row number or rank to return per partition) must be
+/// greater than zero. For rank and dense_rank, all the rows that tie on the
+/// sorting keys are kept, so a partition may return more rows than the limit.
 ///
-/// This is an optimized version of a Window operator with a single row_number
-/// window function followed by a row_number <= N filter.
+/// This is an optimized version of a Window operator with a single row_number,
+/// rank or dense_rank window function followed by a <= N filter.
 class TopNRowNumber : public Operator {
  public:
   TopNRowNumber(
@@ -69,7 +70,7 @@ class TopNRowNumber : public Operator {
       override;
 
  private:
-  // A priority queue to keep track of top 'limit' rows for a given partition.
+  // A priority queue to keep track of top rows for a given partition.
   struct TopRows {
     struct Compare {
       RowComparator& comparator;
@@ -79,11 +80,27 @@ class TopNRowNumber : public Operator {
       }
     };
 
-    std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
-        rows;
+    // Exposes the rows of the queue to look up the ties of a new row.
+    struct Queue : public std::priority_queue<
+                       char*,
+                       std::vector<char*, StlAllocator<char*>>,
+                       Compare> {
+      using Base = std::priority_queue<
+          char*,
+          std::vector<char*, StlAllocator<char*>>,
+          Compare>;
+      using Base::Base;
+      using Base::c;
+    };
+
+    Queue rows;
+
+    // Number of distinct sorting key values in 'rows', i.e. the dense rank of
+    // the top row. Maintained only for dense_rank.
+    int32_t numDistinct{0};
 
     TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+        : rows{Compare{comparator}, StlAllocator<char*>(allocator)} {}
   };
 
   void initializeNewPartitions();
@@ -95,6 +112,27 @@ class TopNRowNumber : public Operator {
   // Adds input row to a partition or discards the row.
   void processInputRow(vector_size_t index, TopRows& partition);
 
+  // processInputRow() for rank and dense_rank. Keeps all the rows whose rank
+  // doesn't exceed 'limit_', including the ties.
+  void processInputRowWithTies(vector_size_t index, TopRows& partition);
+
+  // Stores input row 'index' into 'row' and adds it to 'partition'.
+  void addRow(vector_size_t index, char* row, TopRows& partition);
+
+  // Returns true if the input row 'index' has the same sorting keys as one of
+  // the rows of 'partition'.
+  bool hasPeer(vector_size_t index, const TopRows& partition);
+
+  // Removes the top row and all its ties from 'partition' and puts them in
+  // 'tiedRows_'.
+  void popTopRows(TopRows& partition);
+
+  // Returns the row number, rank or dense rank of a row given its 1-based
+  // position in the partition, the rank of the previous row and whether the
+  // two rows are peers, i.e. have the same sorting keys.
+  int64_t computeRank(int64_t previousRank, int64_t rowNumber, bool isPeer)
+      const;
+
   // Returns next partition to add to output or nullptr if there are no
   // partitions left.
   TopRows* nextPartition();
@@ -102,12 +140,13 @@ class TopNRowNumber : public Operator {
   // Returns partition that was partially added to the previous output batch.
   TopRows& currentPartition();
 
-  // Appends partition rows to outputRows_ and optionally populates row
-  // numbers.
+  // Moves the rows of 'partition' into 'partitionRows_' in sorting order.
+  void loadPartitionRows(TopRows& partition);
+
+  // Appends the next 'numRows' rows of 'partitionRows_' to outputRows_ and
+  // optionally populates row numbers or ranks.
   void appendPartitionRows(
-      TopRows& partition,
-      vector_size_t start,
-      vector_size_t size,
+      vector_size_t numRows,
       vector_size_t outputOffset,
       FlatVector<int64_t>* rowNumbers);
 
@@ -126,22 +165,47 @@ class TopNRowNumber : public Operator {
 
   RowVectorPtr getOutputFromMemory();
 
+  // Returns true if columns [start, end) of 'next' row are equal to the ones
+  // of index-1 row of output.
+  bool equalColumns(
+      const RowVectorPtr& output,
+      vector_size_t index,
+      SpillMergeStream* next,
+      column_index_t start,
+      column_index_t end);
+
   // Returns true if 'next' row belongs to a different partition then index-1
   // row of output.
   bool isNewPartition(
       const RowVectorPtr& output,
       vector_size_t index,
-      SpillMergeStream* next);
+      SpillMergeStream* next) {
+    return !equalColumns(output, index, next, 0, numPartitionKeys_);
+  }
+
+  // Returns true if 'next' row has the same sorting keys as index-1 row of
+  // output.
+  bool isPeer(
+      const RowVectorPtr& output,
+      vector_size_t index,
+      SpillMergeStream* next) {
+    return equalColumns(
+        output, index, next, numPartitionKeys_, spillCompareFlags_.size());
+  }
 
-  // Sets nextRowNumber_ to rowNumber. Checks if next row in 'merge_' belongs to
-  // a different partition than last row in 'output' and if so updates
-  // nextRowNumber_ to 0. Also, checks current partition reached the limit on
-  // number of rows and if so advances 'merge_' to the first row on the next
-  // partition and sets nextRowNumber_ to 0.
+  // Sets nextRowNumber_ to rowNumber and nextRank_ to the rank of next row in
+  // 'merge_' given 'rank' of the last row in 'output'. Checks if next row
+  // belongs to a different partition than last row in 'output' and if so
+  // resets nextRowNumber_ to 0 and nextRank_ to 1. Also, checks if next row
+  // exceeds the limit and if so advances 'merge_' to the first row on the next
+  // partition and resets nextRowNumber_ and nextRank_.
   //
   // @post 'merge_->next()' is either at end or points to a row that should be
-  // included in the next output batch using 'nextRowNumber_'.
-  void setupNextOutput(const RowVectorPtr& output, int32_t rowNumber);
+  // included in the next output batch using 'nextRowNumber_' and 'nextRank_'.
+  void setupNextOutput(
+      const RowVectorPtr& output,
+      vector_size_t rowNumber,
+      int64_t rank);
 
   // Called in noMoreInput() and spill().
   void updateEstimatedOutputRowSize();
@@ -150,6 +214,11 @@ class TopNRowNumber : public Operator {
   // cardinality sufficiently. Returns false if spilling was triggered earlier.
   bool abandonPartialEarly() const;
 
+  // Compacts the variable width data of 'data_' if the rows replaced in the
+  // partitions left more than 'compactVariableWidthDataPct_' of it free.
+  void maybeCompactVariableWidthData();
+
+  const core::TopNRowNumberNode::RankFunction rankFunction_;
   const int32_t limit_;
   const bool generateRowNumber_;
   const size_t numPartitionKeys_;
@@ -169,6 +238,7 @@ class TopNRowNumber : public Operator {
 
   const vector_size_t abandonPartialMinRows_;
   const int32_t abandonPartialMinPct_;
+  const int32_t compactVariableWidthDataPct_;
 
   // True if this operator runs a 'partial' stage without sufficient reduction
   // in cardinality. In this case, it becomes a pass-through.
@@ -199,6 +269,9 @@ class TopNRowNumber : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
 
+  // Rows removed from a partition by popTopRows(). Reused across calls.
+  std::vector<char*> tiedRows_;
+
   bool finished_{false};
 
   // Size of a single output row estimated using 'data_->estimateRowSize()'.
@@ -218,7 +291,16 @@ class TopNRowNumber : public Operator {
   std::vector<char*> partitions_{kPartitionBatchSize};
   size_t numPartitions_{0};
   std::optional<int32_t> currentPartition_;
-  vector_size_t remainingRowsInPartition_{0};
+
+  // Rows of the partition being added to the output, in sorting order.
+  std::vector<char*> partitionRows_;
+
+  // Index of the next row in 'partitionRows_' to add to the output.
+  vector_size_t nextPartitionRow_{0};
+
+  // Row number or rank of the last row added to the output from
+  // 'partitionRows_'.
+  int64_t lastRank_{0};
 
   // Spiller for contents of the 'data_'.
   std::unique_ptr<Spiller> spiller_;
@@ -226,7 +308,11 @@ class TopNRowNumber : public Operator {
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
-  // Row number for the first row in the next output batch.
-  int32_t nextRowNumber_{0};
+  // Number of preceding rows in the partition of the first row in the next
+  // output batch.
+  vector_size_t nextRowNumber_{0};
+
+  // Row number or rank of the first row in the next output batch.
+  int64_t nextRank_{1};
 };
 } // namespace facebook::velox::exec
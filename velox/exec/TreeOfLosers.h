@@ -54,6 +54,41 @@ class MergeStream {
   }
 };
 
+/// Returns the length of the run of consecutive elements at the head of a
+/// stream which can be consumed at once. 'isInRun(i)' tells whether the i-th
+/// element is in the run. It must hold for element 0 and, once false, stay
+/// false for all the later elements. The result is at most 'maxLength'. Probes
+/// the elements at exponentially growing offsets before a binary search, so
+/// that a short run takes only a couple of comparisons.
+template <typename IsInRun>
+int32_t mergeRunLength(int32_t maxLength, IsInRun isInRun) {
+  VELOX_DCHECK_GT(maxLength, 0);
+  // The elements before 'low' are in the run and the elements from 'high' on
+  // are not.
+  int32_t low = 1;
+  int32_t high = maxLength;
+  int64_t step = 1;
+  while (low < high) {
+    const auto probe =
+        static_cast<int32_t>(std::min<int64_t>(low + step - 1, high - 1));
+    if (!isInRun(probe)) {
+      high = probe;
+      break;
+    }
+    low = probe + 1;
+    step *= 2;
+  }
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    if (isInRun(middle)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
 /// Implements a tree of losers algorithm for merging ordered streams. The
 /// TreeOfLosers owns one or more instances of Stream. At each call of next(),
 /// it returns the Stream that has the lowest value as first value from the set
@@ -123,6 +158,34 @@ class TreeOfLosers {
     return lastIndex_ == kEmpty ? nullptr : streams_[lastIndex_].get();
   }
 
+  /// Returns the stream with the lowest first element like next() and the
+  /// stream with the lowest first element among all the other streams, or
+  /// nullptr if all the other streams are at end. The caller may pop off all
+  /// the leading elements of the first stream which are not greater than the
+  /// first element of the second one before calling this again. This lets
+  /// the caller consume a run of rows from one stream at once, which pays off
+  /// when merging a few streams with long runs such as spilled sorted runs.
+  std::pair<Stream*, Stream*> nextWithRunnerUp() {
+    auto* stream = next();
+    if (stream == nullptr || values_.empty()) {
+      return {stream, nullptr};
+    }
+    // The runner-up has lost against the winner on the way up, so it is the
+    // lowest of the losers on the path from the winner to the root.
+    TIndex runnerUp = kEmpty;
+    for (auto node = parent(firstStream_ + lastIndex_);; node = parent(node)) {
+      const auto loser = values_[node];
+      if (loser != kEmpty &&
+          (runnerUp == kEmpty || *streams_[loser] < *streams_[runnerUp])) {
+        runnerUp = loser;
+      }
+      if (node == 0) {
+        break;
+      }
+    }
+    return {stream, runnerUp == kEmpty ? nullptr : streams_[runnerUp].get()};
+  }
+
   /// Returns the stream with the lowest first element and a flag that is true
   /// if there is another equal value to come from some other stream. The
   /// streams should have ordered unique values when using this function. This
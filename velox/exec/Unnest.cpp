@@ -110,57 +110,76 @@ RowVectorPtr Unnest::getOutput() {
     return nullptr;
   }
 
-  const auto size = input_->size();
-  const auto maxOutputSize = outputBatchRows();
-
-  // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
-  vector_size_t numElements = 0;
-  for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
-
-    if (numElements >= maxOutputSize) {
-      break;
-    }
-  }
-
-  if (numElements == 0) {
+  const auto range = nextRowRange(outputBatchRows());
+  if (range.numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextElement_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
-
-  nextInputRow_ += numInput;
+  auto output = generateOutput(range);
 
-  if (nextInputRow_ >= size) {
+  if (nextInputRow_ >= input_->size()) {
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextElement_ = 0;
   }
 
   return output;
 }
 
+Unnest::RowRange Unnest::nextRowRange(vector_size_t maxOutputSize) {
+  // Fill the batch up to 'maxOutputSize' elements. The elements of a large
+  // array or map may continue in the next batch.
+  const auto size = input_->size();
+  RowRange range{nextInputRow_, 0, nextElement_, 0, 0};
+  for (auto row = nextInputRow_; row < size; ++row) {
+    const auto begin = row == nextInputRow_ ? nextElement_ : 0;
+    const auto numRowElements = std::min<vector_size_t>(
+        rawMaxSizes_[row] - begin, maxOutputSize - range.numElements);
+    range.numElements += numRowElements;
+    range.lastRowEnd = begin + numRowElements;
+    ++range.size;
+
+    if (range.lastRowEnd < rawMaxSizes_[row]) {
+      nextInputRow_ = row;
+      nextElement_ = range.lastRowEnd;
+      return range;
+    }
+    if (range.numElements >= maxOutputSize) {
+      break;
+    }
+  }
+  nextInputRow_ = range.start + range.size;
+  nextElement_ = 0;
+  return range;
+}
+
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements,
+    const RowRange& range,
     std::vector<VectorPtr>& outputs) {
+  const auto numElements = range.numElements;
+  if (range.size == 1) {
+    // All elements come from one row. Repeat its values as constants.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          numElements, range.start, input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    for (auto i = begin; i < end; ++i) {
       rawRepeatedIndices[index++] = row;
     }
-  }
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
@@ -174,83 +193,96 @@ void Unnest::generateRepeatedColumns(
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
+    const RowRange& range) {
+  const auto numElements = range.numElements;
+  auto& currentDecoded = unnestDecoded_[channel];
+  auto* currentSizes = rawSizes_[channel];
+  auto* currentOffsets = rawOffsets_[channel];
+  auto* currentIndices = rawIndices_[channel];
+
+  // The elements are a slice of the base vector if the arrays (or maps) of
+  // consecutive rows are adjacent in it and none of them needs padding.
+  bool contiguous = true;
+  std::optional<vector_size_t> baseOffset;
+  vector_size_t nextOffset = 0;
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    if (!contiguous || begin == end) {
+      return;
+    }
+    if (currentDecoded.isNullAt(row) ||
+        end > currentSizes[currentIndices[row]]) {
+      contiguous = false;
+      return;
+    }
+    const auto offset = currentOffsets[currentIndices[row]] + begin;
+    if (baseOffset.has_value() && offset != nextOffset) {
+      contiguous = false;
+      return;
+    }
+    if (!baseOffset.has_value()) {
+      baseOffset = offset;
+    }
+    nextOffset = offset + end - begin;
+  });
+  if (contiguous) {
+    return {nullptr, nullptr, true, baseOffset.value()};
+  }
+
   BufferPtr elementIndices = allocateIndices(numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
   auto nulls = allocateNulls(numElements, pool());
   auto rawNulls = nulls->asMutable<uint64_t>();
 
-  auto& currentDecoded = unnestDecoded_[channel];
-  auto* currentSizes = rawSizes_[channel];
-  auto* currentOffsets = rawOffsets_[channel];
-  auto* currentIndices = rawIndices_[channel];
-
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
-  bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
     if (!currentDecoded.isNullAt(row)) {
       const auto offset = currentOffsets[currentIndices[row]];
       const auto unnestSize = currentSizes[currentIndices[row]];
+      const auto elementsEnd = std::min(end, unnestSize);
 
-      if (index != offset || unnestSize < maxSize) {
-        identityMapping = false;
-      }
-
-      for (auto i = 0; i < unnestSize; i++) {
+      for (auto i = begin; i < elementsEnd; i++) {
         rawElementIndices[index++] = offset + i;
       }
 
-      for (auto i = unnestSize; i < maxSize; ++i) {
+      for (auto i = std::max(begin, elementsEnd); i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
-    } else if (maxSize > 0) {
-      identityMapping = false;
-
-      for (auto i = 0; i < maxSize; ++i) {
+    } else {
+      for (auto i = begin; i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
     }
-  }
-  return {elementIndices, nulls, identityMapping};
+  });
+  return {elementIndices, nulls, false, 0};
 }
 
-VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  auto ordinalityVector =
-      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
+VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
+  auto ordinalityVector = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), range.numElements, pool());
 
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto* rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto begin, auto end) {
+    std::iota(rawOrdinality, rawOrdinality + end - begin, begin + 1);
+    rawOrdinality += end - begin;
+  });
 
   return ordinalityVector;
 }
 
-RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
+RowVectorPtr Unnest::generateOutput(const RowRange& range) {
+  const auto numElements = range.numElements;
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+        generateEncodingForChannel(channel, range);
 
     auto& currentDecoded = unnestDecoded_[channel];
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
@@ -272,7 +304,7 @@ RowVectorPtr Unnest::generateOutput(
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range);
   }
 
   return std::make_shared<RowVector>(
@@ -282,8 +314,12 @@ RowVectorPtr Unnest::generateOutput(
 VectorPtr Unnest::UnnestChannelEncoding::wrap(
     const VectorPtr& base,
     vector_size_t wrapSize) const {
-  if (identityMapping) {
-    return base;
+  if (contiguous) {
+    // A zero-copy view of the elements.
+    if (baseOffset == 0 && wrapSize == base->size()) {
+      return base;
+    }
+    return base->slice(baseOffset, wrapSize);
   }
 
   const auto result =
@@ -39,28 +39,56 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
-  //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
-  // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  // The input rows and their elements that make up one output batch. The
+  // output of a single input row may span several batches, so the first and
+  // the last row of the range may contribute only part of their elements.
+  struct RowRange {
+    // First input row of the range.
+    vector_size_t start;
+    // Number of input rows in the range.
+    vector_size_t size;
+    // Elements of the first row before this one are in earlier batches.
+    vector_size_t firstRowStart;
+    // Elements of the last row from this one on are in later batches.
+    vector_size_t lastRowEnd;
+    // Number of output rows.
+    vector_size_t numElements;
+
+    // Calls 'func(row, begin, end)' for each row of the range, where
+    // [begin, end) are the positions of its elements in this batch, padding
+    // included.
+    template <typename TFunc>
+    void forEachRow(const vector_size_t* rawMaxSizes, TFunc func) const {
+      for (auto row = start; row < start + size; ++row) {
+        func(
+            row,
+            row == start ? firstRowStart : 0,
+            row == start + size - 1 ? lastRowEnd : rawMaxSizes[row]);
+      }
+    }
+  };
+
+  // Returns the next range of input rows whose elements fill up to
+  // 'maxOutputSize' output rows and advances 'nextInputRow_' and
+  // 'nextElement_' past it.
+  RowRange nextRowRange(vector_size_t maxOutputSize);
+
+  // Generate output for the input rows and elements of 'range'.
+  RowVectorPtr generateOutput(const RowRange& range);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements,
+      const RowRange& range,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
     BufferPtr indices;
     BufferPtr nulls;
-    bool identityMapping;
+    // True if the elements are a contiguous run of the base vector starting
+    // at 'baseOffset' without nulls added for padding.
+    bool contiguous;
+    vector_size_t baseOffset;
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
@@ -69,15 +97,10 @@ class Unnest : public Operator {
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+      const RowRange& range);
 
   // Invoked by generateOutput for the ordinality column.
-  VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+  VectorPtr generateOrdinalityVector(const RowRange& range);
 
   const bool withOrdinality_;
   std::vector<column_index_t> unnestChannels_;
@@ -93,5 +116,8 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // First element of 'nextInputRow_' that is not yet in an output batch.
+  vector_size_t nextElement_{0};
 };
 } // namespace facebook::velox::exec
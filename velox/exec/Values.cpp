@@ -31,6 +31,8 @@ Values::Values(
           values->id(),
           "Values"),
       valueNodes_(std::move(values)),
+      minLiveStringBufferPct_(
+          driverCtx->queryConfig().minLiveStringBufferPct()),
       roundsLeft_(valueNodes_->repeatTimes()) {}
 
 void Values::initialize() {
@@ -48,8 +50,12 @@ void Values::initialize() {
         // that this should only be enabled for testing.
         values_.emplace_back(std::static_pointer_cast<RowVector>(
             vector->copyPreserveEncodings()));
+        if (minLiveStringBufferPct_ > 0) {
+          BaseVector::compactStringBuffers(
+              *values_.back(), minLiveStringBufferPct_);
+        }
       } else {
-        values_.emplace_back(vector);
+        values_.emplace_back(maybeCompactStringBuffers(vector));
       }
     }
   }
@@ -57,6 +63,20 @@ void Values::initialize() {
   valueNodes_ = nullptr;
 }
 
+RowVectorPtr Values::maybeCompactStringBuffers(const RowVectorPtr& vector) {
+  if (minLiveStringBufferPct_ == 0) {
+    return vector;
+  }
+  // 'vector' is shared with the plan node, so the compaction runs on a copy
+  // that shares the string buffers and is kept only if it dropped some.
+  auto copy =
+      std::static_pointer_cast<RowVector>(vector->copyPreserveEncodings());
+  if (BaseVector::compactStringBuffers(*copy, minLiveStringBufferPct_) == 0) {
+    return vector;
+  }
+  return copy;
+}
+
 RowVectorPtr Values::getOutput() {
   TestValue::adjust("facebook::velox::exec::Values::getOutput", this);
   if (current_ >= values_.size()) {
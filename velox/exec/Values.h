@@ -57,7 +57,12 @@ class Values : public SourceOperator {
   }
 
  private:
+  // Returns 'vector' or a copy of it with compacted string buffers if less
+  // than 'minLiveStringBufferPct_' percent of its string buffers is used.
+  RowVectorPtr maybeCompactStringBuffers(const RowVectorPtr& vector);
+
   std::shared_ptr<const core::ValuesNode> valueNodes_;
+  const int32_t minLiveStringBufferPct_;
   std::vector<RowVectorPtr> values_;
   int32_t current_ = 0;
   size_t roundsLeft_ = 1;
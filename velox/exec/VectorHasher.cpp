@@ -101,6 +101,23 @@ void VectorHasher::hashValues(
       }
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
+  } else if (!decoded_.isIdentityMapping()) {
+    // Runs of rows over the same base row, e.g. from a SequenceVector or a
+    // dictionary over clustered data, are hashed once per run.
+    vector_size_t lastBaseIndex = -1;
+    uint64_t lastHash = 0;
+    rows.applyToSelected([&](vector_size_t row) {
+      if (decoded_.isNullAt(row)) {
+        result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
+        return;
+      }
+      const auto baseIndex = decoded_.index(row);
+      if (baseIndex != lastBaseIndex) {
+        lastHash = hashOne<Kind>(decoded_, row);
+        lastBaseIndex = baseIndex;
+      }
+      result[row] = mix ? bits::hashMix(result[row], lastHash) : lastHash;
+    });
   } else {
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
@@ -251,11 +268,39 @@ bool VectorHasher::makeValueIdsDecoded(
   bool success = true;
 
   if (rows.countSelected() <= decoded_.base()->size()) {
-    // Cache is not beneficial in this case and we don't use them.
+    // Cache is not beneficial in this case and we don't use them. Runs of
+    // rows over the same base row are looked up once per run.
     auto* nulls = decoded_.nulls(&rows);
+    vector_size_t lastBaseIndex = -1;
+    uint64_t lastId = 0;
     rows.applyToSelected([&](vector_size_t row) INLINE_LAMBDA {
-      makeValueIdForOneRow<T, mayHaveNulls>(
-          nulls, row, values, indices[row], result, success);
+      if constexpr (mayHaveNulls) {
+        if (bits::isBitNull(nulls, row)) {
+          if (multiplier_ == 1) {
+            result[row] = 0;
+          }
+          return;
+        }
+      }
+      const auto baseIndex = indices[row];
+      if (baseIndex != lastBaseIndex) {
+        lastBaseIndex = baseIndex;
+        T value = values[baseIndex];
+        if (!success) {
+          analyzeValue(value);
+          return;
+        }
+        lastId = valueId(value);
+        if (lastId == kUnmappable) {
+          success = false;
+          analyzeValue(value);
+          return;
+        }
+      }
+      if (success) {
+        result[row] =
+            multiplier_ == 1 ? lastId : result[row] + multiplier_ * lastId;
+      }
     });
     return success;
   }
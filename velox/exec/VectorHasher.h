@@ -244,6 +244,11 @@ class VectorHasher {
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
 
+  // Returns true if there were too many distinct values to keep track of.
+  bool distinctOverflow() const {
+    return distinctOverflow_;
+  }
+
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
@@ -31,10 +31,13 @@ Window::Window(
           operatorId,
           windowNode->id(),
           "Window",
-          windowNode->canSpill(driverCtx->queryConfig())
+          windowNode->canSpill(driverCtx->queryConfig()) &&
+                  (windowNode->inputsSorted() ||
+                   !driverCtx->queryConfig().windowPartitionAcrossDrivers())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       numInputColumns_(windowNode->inputType()->size()),
+      inputsSorted_(windowNode->inputsSorted()),
       windowNode_(windowNode),
       currentPartition_(nullptr),
       stringAllocator_(pool()) {
@@ -42,7 +45,11 @@ Window::Window(
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (windowNode->inputsSorted()) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        &spillStats_);
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
@@ -55,6 +62,14 @@ void Window::initialize() {
   createWindowFunctions();
   createPeerAndFrameBuffers();
   windowNode_.reset();
+
+  // Sorted input is already partitioned by the upstream operators and a single
+  // driver has nothing to share.
+  sharePartitions_ = !inputsSorted_ &&
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .windowPartitionAcrossDrivers() &&
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver()) > 1;
 }
 
 namespace {
@@ -240,6 +255,83 @@ void Window::createPeerAndFrameBuffers() {
 void Window::noMoreInput() {
   Operator::noMoreInput();
   windowBuild_->noMoreInput();
+  if (sharePartitions_) {
+    sharePartitions();
+  }
+}
+
+void Window::sharePartitions() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &partitionsFuture_,
+          promises,
+          peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not the last
+    // to finish) can continue from the barrier and output their partitions.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  const auto numDrivers = peers.size() + 1;
+  std::vector<Window*> windows(numDrivers, nullptr);
+  const auto addWindow = [&](Window* window) {
+    const auto driverId = window->operatorCtx_->driverCtx()->driverId;
+    VELOX_CHECK_LT(driverId, numDrivers);
+    VELOX_CHECK_NULL(windows[driverId]);
+    windows[driverId] = window;
+  };
+  addWindow(this);
+  for (auto& peer : peers) {
+    auto* window = dynamic_cast<Window*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(window);
+    addWindow(window);
+  }
+
+  // The window builds of all the drivers have the same row layout, so the
+  // merged build reads the rows of all of them.
+  std::shared_ptr<SortWindowBuild> build(
+      static_cast<SortWindowBuild*>(windowBuild_.release()));
+  std::vector<std::unique_ptr<SortWindowBuild>> peerBuilds;
+  peerBuilds.reserve(numDrivers - 1);
+  for (auto* window : windows) {
+    if (window != this) {
+      peerBuilds.emplace_back(
+          static_cast<SortWindowBuild*>(window->windowBuild_.release()));
+    }
+  }
+  build->mergePeers(std::move(peerBuilds));
+
+  // Each driver outputs a contiguous range of partitions with about the same
+  // number of rows.
+  const auto rangeStarts = build->splitPartitions(numDrivers);
+  for (auto i = 0; i < numDrivers; ++i) {
+    auto* window = windows[i];
+    window->sharedBuild_ = build;
+    window->nextSharedPartition_ = rangeStarts[i];
+    window->endSharedPartition_ = rangeStarts[i + 1];
+    window->numRows_ =
+        build->numPartitionRows(rangeStarts[i], rangeStarts[i + 1]);
+    window->addRuntimeStat(
+        "windowPartitionsAcrossDrivers",
+        RuntimeCounter(rangeStarts[i + 1] - rangeStarts[i]));
+  }
+}
+
+BlockingReason Window::isBlocked(ContinueFuture* future) {
+  if (!partitionsFuture_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(partitionsFuture_);
+  return BlockingReason::kWaitForWindowPartitions;
 }
 
 void Window::callResetPartition() {
@@ -247,8 +339,14 @@ void Window::callResetPartition() {
   peerStartRow_ = 0;
   peerEndRow_ = 0;
   currentPartition_ = nullptr;
-  if (windowBuild_->hasNextPartition()) {
+  if (sharedBuild_ != nullptr) {
+    if (nextSharedPartition_ < endSharedPartition_) {
+      currentPartition_ = sharedBuild_->partitionAt(nextSharedPartition_++);
+    }
+  } else if (windowBuild_->hasNextPartition()) {
     currentPartition_ = windowBuild_->nextPartition();
+  }
+  if (currentPartition_ != nullptr) {
     for (int i = 0; i < windowFunctions_.size(); i++) {
       windowFunctions_[i]->resetPartition(currentPartition_.get());
     }
@@ -543,6 +641,9 @@ void Window::callApplyForPartitionRows(
     vector_size_t endRow,
     vector_size_t resultOffset,
     const RowVectorPtr& result) {
+  // Frees the rows of a spilled partition that are not needed by the frames
+  // following the previous output block.
+  currentPartition_->evictSpilledRows();
   getInputColumns(startRow, endRow, resultOffset, result);
 
   computePeerAndFrameBuffers(startRow, endRow);
@@ -611,7 +712,7 @@ vector_size_t Window::callApplyLoop(
 }
 
 RowVectorPtr Window::getOutput() {
-  if (numRows_ == 0) {
+  if (numRows_ == 0 || partitionsFuture_.valid()) {
     return nullptr;
   }
 
@@ -23,6 +23,8 @@
 
 namespace facebook::velox::exec {
 
+class SortWindowBuild;
+
 /// This is a very simple in-Memory implementation of a Window Operator
 /// to compute window functions.
 ///
@@ -35,6 +37,11 @@ namespace facebook::velox::exec {
 ///
 /// We will revise this algorithm in the future using a HashTable based
 /// approach pending some profiling results.
+///
+/// If QueryConfig::kWindowPartitionAcrossDrivers is set and the input is not
+/// sorted, the last driver to finish its input merges the sorted rows of all
+/// the drivers and splits the window partitions between them, so that the
+/// drivers compute the window functions of different partitions in parallel.
 class Window : public Operator {
  public:
   Window(
@@ -56,12 +63,11 @@ class Window : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
-    return noMoreInput_ && numRows_ == numProcessedRows_;
+    return noMoreInput_ && !partitionsFuture_.valid() &&
+        numRows_ == numProcessedRows_;
   }
 
   void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
@@ -88,6 +94,11 @@ class Window : public Operator {
     const std::optional<FrameChannelArg> end;
   };
 
+  // Called by noMoreInput() of each driver in partition sharing mode. The last
+  // driver to finish its input merges the window builds of all the drivers
+  // into 'sharedBuild_' and assigns each driver a range of its partitions.
+  void sharePartitions();
+
   // Creates WindowFunction and frame objects for this operator.
   void createWindowFunctions();
 
@@ -155,10 +166,26 @@ class Window : public Operator {
 
   const vector_size_t numInputColumns_;
 
+  const bool inputsSorted_;
+
   // WindowBuild is used to store input rows and return WindowPartitions
   // for the processing.
   std::unique_ptr<WindowBuild> windowBuild_;
 
+  // True if the drivers of this Window split the partitions of their merged
+  // input with each other. See QueryConfig::kWindowPartitionAcrossDrivers.
+  bool sharePartitions_{false};
+  // Fulfilled when the last peer driver has merged the input of all the
+  // drivers.
+  ContinueFuture partitionsFuture_{ContinueFuture::makeEmpty()};
+  // The merged window build of all the drivers in partition sharing mode.
+  // Replaces 'windowBuild_' after the input of all the drivers is consumed.
+  std::shared_ptr<SortWindowBuild> sharedBuild_;
+  // The next partition of 'sharedBuild_' to output and the end of the range
+  // of partitions assigned to this driver.
+  vector_size_t nextSharedPartition_{0};
+  vector_size_t endSharedPartition_{0};
+
   // The cached window plan node used for window function initialization. It is
   // reset after the initialization.
   std::shared_ptr<const core::WindowNode> windowNode_;
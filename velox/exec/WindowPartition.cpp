@@ -24,6 +24,7 @@ WindowPartition::WindowPartition(
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
     : data_(data),
       partition_(rows),
+      numRows_(rows.size()),
       inputMapping_(inputMapping),
       sortKeyInfo_(sortKeyInfo) {
   for (int i = 0; i < inputMapping_.size(); i++) {
@@ -31,14 +32,157 @@ WindowPartition::WindowPartition(
   }
 }
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    SpillFiles spillFiles,
+    vector_size_t numRows,
+    const std::vector<column_index_t>& inputMapping,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo,
+    uint64_t readBufferSize,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : data_(data),
+      numRows_(numRows),
+      inputMapping_(inputMapping),
+      sortKeyInfo_(sortKeyInfo),
+      spillFiles_(std::move(spillFiles)),
+      readBufferSize_(readBufferSize),
+      pool_(pool),
+      spillStats_(spillStats),
+      minAccessedRow_(numRows) {
+  VELOX_CHECK(spilled());
+  for (int i = 0; i < inputMapping_.size(); i++) {
+    columns_.emplace_back(data_->columnAt(inputMapping_[i]));
+  }
+}
+
+WindowPartition::~WindowPartition() {
+  eraseSpilledRows(spilledRows_.size());
+}
+
+void WindowPartition::evictSpilledRows() {
+  if (!spilled()) {
+    return;
+  }
+  eraseSpilledRows(std::min<vector_size_t>(
+      std::max<vector_size_t>(minAccessedRow_ - firstSpilledRow_, 0),
+      spilledRows_.size()));
+  minAccessedRow_ = numRows_;
+}
+
+char* const* WindowPartition::spilledRowsAt(
+    vector_size_t begin,
+    vector_size_t end) const {
+  VELOX_CHECK_LE(end, numRows_);
+  if (begin >= end) {
+    return spilledRows_.data();
+  }
+  if (spillReader_ == nullptr || begin < firstSpilledRow_) {
+    restartSpillRead();
+  }
+  minAccessedRow_ = std::min(minAccessedRow_, begin);
+  if (end > firstSpilledRow_ + spilledRows_.size()) {
+    readSpilledRows(begin, end);
+  }
+  return spilledRows_.data() + (begin - firstSpilledRow_);
+}
+
+void WindowPartition::restartSpillRead() const {
+  eraseSpilledRows(spilledRows_.size());
+  firstSpilledRow_ = 0;
+  spillBatch_ = nullptr;
+  nextSpillBatchRow_ = 0;
+
+  std::vector<std::unique_ptr<BatchStream>> streams;
+  streams.reserve(spillFiles_.size());
+  for (const auto& fileInfo : spillFiles_) {
+    streams.push_back(FileSpillBatchStream::create(
+        SpillReadFile::create(fileInfo, readBufferSize_, pool_, spillStats_)));
+  }
+  spillReader_ =
+      std::make_unique<UnorderedStreamReader<BatchStream>>(std::move(streams));
+}
+
+void WindowPartition::readSpilledRows(vector_size_t begin, vector_size_t end)
+    const {
+  auto nextRow = firstSpilledRow_ + spilledRows_.size();
+  while (nextRow < end) {
+    if (spillBatch_ == nullptr || nextSpillBatchRow_ == spillBatch_->size()) {
+      VELOX_CHECK(
+          spillReader_->nextBatch(spillBatch_),
+          "Spilled window partition has fewer rows than {}",
+          numRows_);
+      decodedSpillBatch_.resize(spillBatch_->childrenSize());
+      for (auto i = 0; i < decodedSpillBatch_.size(); ++i) {
+        decodedSpillBatch_[i].decode(*spillBatch_->childAt(i));
+      }
+      nextSpillBatchRow_ = 0;
+    }
+
+    if (spilledRows_.empty() && nextRow < begin) {
+      // Skips the rows before 'begin' as the rows in memory must be
+      // consecutive.
+      const auto numSkipped = std::min<vector_size_t>(
+          begin - nextRow, spillBatch_->size() - nextSpillBatchRow_);
+      nextSpillBatchRow_ += numSkipped;
+      nextRow += numSkipped;
+      firstSpilledRow_ = nextRow;
+      continue;
+    }
+
+    auto* row = data_->newRow();
+    for (auto i = 0; i < decodedSpillBatch_.size(); ++i) {
+      data_->store(decodedSpillBatch_[i], nextSpillBatchRow_, row, i);
+    }
+    spilledRows_.push_back(row);
+    ++nextSpillBatchRow_;
+    ++nextRow;
+  }
+}
+
+void WindowPartition::eraseSpilledRows(vector_size_t numRows) const {
+  if (numRows == 0) {
+    return;
+  }
+  data_->eraseRows(folly::Range<char**>(spilledRows_.data(), numRows));
+  spilledRows_.erase(spilledRows_.begin(), spilledRows_.begin() + numRows);
+  firstSpilledRow_ += numRows;
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  if (!spilled()) {
+    RowContainer::extractColumn(
+        partition_.data(),
+        rowNumbers,
+        columns_[columnIndex],
+        resultOffset,
+        result);
+    return;
+  }
+
+  // Reads the rows between the lowest and the highest row numbers and maps
+  // the row numbers to them. Negative row numbers stand for null.
+  vector_size_t minRow = numRows_;
+  vector_size_t maxRow = -1;
+  for (auto row : rowNumbers) {
+    if (row >= 0) {
+      minRow = std::min(minRow, row);
+      maxRow = std::max(maxRow, row);
+    }
+  }
+  char* const* rows = rowsAt(minRow, maxRow + 1);
+  spilledRowNumbers_.resize(rowNumbers.size());
+  for (auto i = 0; i < rowNumbers.size(); ++i) {
+    spilledRowNumbers_[i] =
+        rowNumbers[i] >= 0 ? rowNumbers[i] - minRow : rowNumbers[i];
+  }
   RowContainer::extractColumn(
-      partition_.data(),
-      rowNumbers,
+      rows,
+      folly::Range(spilledRowNumbers_.data(), spilledRowNumbers_.size()),
       columns_[columnIndex],
       resultOffset,
       result);
@@ -51,7 +195,7 @@ void WindowPartition::extractColumn(
     vector_size_t resultOffset,
     const VectorPtr& result) const {
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      rowsAt(partitionOffset, partitionOffset + numRows),
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -64,7 +208,7 @@ void WindowPartition::extractNulls(
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      rowsAt(partitionOffset, partitionOffset + numRows),
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -158,11 +302,19 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
 
     if (i == 0 || i >= peerEnd) {
       // Compute peerStart and peerEnd rows for the first row of the partition
-      // or when past the previous peerGroup.
+      // or when past the previous peerGroup. The rows are sorted, so each row
+      // is compared with the previous one. This doesn't need the first row of
+      // a large peer group in memory while scanning a spilled partition.
       peerStart = i;
-      peerEnd = i;
+      peerEnd = i + 1;
+      if (sortKeyInfo_.empty()) {
+        peerEnd = lastPartitionRow + 1;
+      }
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        // Gets both rows from one call. Reading one row from the spill files
+        // may invalidate a row returned by an earlier call.
+        auto* rows = rowsAt(peerEnd - 1, peerEnd + 1);
+        if (peerCompare(rows[0], rows[1])) {
           break;
         }
         peerEnd++;
@@ -192,13 +344,43 @@ vector_size_t WindowPartition::searchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = rowAt(currentRow);
   vector_size_t begin = start;
   vector_size_t finish = end;
+  if (spilled()) {
+    // Avoids reading the spill files again if the bound is not before the
+    // rows in memory, and gallops forward from 'begin' so that only the rows
+    // up to about twice the distance to the bound are read.
+    if (begin < firstSpilledRow_) {
+      if (data_->compare(
+              rowAt(firstSpilledRow_),
+              current,
+              orderByColumn,
+              frameColumn,
+              flags) < 0) {
+        begin = firstSpilledRow_;
+      } else {
+        rowsAt(begin, currentRow + 1);
+        current = rowAt(currentRow);
+      }
+    }
+    for (vector_size_t step = 1; begin + step < finish; step *= 2) {
+      if (data_->compare(
+              rowAt(begin + step),
+              current,
+              orderByColumn,
+              frameColumn,
+              flags) >= 0) {
+        finish = begin + step;
+        break;
+      }
+      begin += step;
+    }
+  }
   while (finish - begin >= 2) {
     auto mid = (begin + finish) / 2;
     auto compareResult = data_->compare(
-        partition_[mid], current, orderByColumn, frameColumn, flags);
+        rowAt(mid), current, orderByColumn, frameColumn, flags);
 
     if (compareResult >= 0) {
       // Search in the first half of the column.
@@ -221,10 +403,10 @@ vector_size_t WindowPartition::linearSearchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = rowAt(currentRow);
   for (vector_size_t i = start; i < end; ++i) {
     auto compareResult = data_->compare(
-        partition_[i], current, orderByColumn, frameColumn, flags);
+        rowAt(i), current, orderByColumn, frameColumn, flags);
 
     // The bound value was found. Return if firstMatch required.
     // If the last match is required, then we need to find the first row that
@@ -271,7 +453,7 @@ void WindowPartition::updateKRangeFrameBounds(
   RowColumn orderByRowColumn = columns_[inputMapping_[orderByColumn]];
   for (auto i = 0; i < numRows; i++) {
     auto currentRow = startRow + i;
-    auto* partitionRow = partition_[currentRow];
+    auto* partitionRow = rowAt(currentRow);
 
     // The user is expected to set the frame column equal to NULL when the
     // ORDER BY value is NULL and not in any other case. Validate this
@@ -303,7 +485,7 @@ void WindowPartition::updateKRangeFrameBounds(
         end = currentRow + 1;
       } else {
         start = currentRow;
-        end = partition_.size();
+        end = numRows_;
       }
       rawFrameBounds[i] = searchFrameValue(
           firstMatch,
@@ -19,8 +19,8 @@
 #include "velox/vector/BaseVector.h"
 
 /// Simple WindowPartition that builds over the RowContainer used for storing
-/// the input rows in the Window Operator. This works completely in-memory.
-/// TODO: This implementation will be revised for Spill to disk semantics.
+/// the input rows in the Window Operator. The rows of a partition spilled by
+/// the WindowBuild are read back into the RowContainer as they are accessed.
 
 namespace facebook::velox::exec {
 class WindowPartition {
@@ -42,11 +42,42 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
+  /// Constructs a partition of 'numRows' rows that the WindowBuild has spilled
+  /// in partition order to 'spillFiles'. The rows are read back into 'data' as
+  /// they are accessed and erased by evictSpilledRows(). An access to a row
+  /// that has been erased reads 'spillFiles' again from the start.
+  /// 'readBufferSize', 'pool' and 'spillStats' are used to read the spill
+  /// files.
+  WindowPartition(
+      RowContainer* data,
+      SpillFiles spillFiles,
+      vector_size_t numRows,
+      const std::vector<column_index_t>& inputMapping,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo,
+      uint64_t readBufferSize,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
+  ~WindowPartition();
+
   /// Returns the number of rows in the current WindowPartition.
   vector_size_t numRows() const {
-    return partition_.size();
+    return numRows_;
+  }
+
+  /// Returns true if the rows of this partition are read from spill files.
+  bool spilled() const {
+    return !spillFiles_.empty();
   }
 
+  /// Erases the rows of a spilled partition before the lowest row accessed
+  /// since the previous call. The Window operator calls this before computing
+  /// each output block. When the frames move forward with the output, as with
+  /// bounded frames, the partition then holds about the rows of the frames of
+  /// one output block. No-op if the partition is not spilled.
+  void evictSpilledRows();
+
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
   /// array from the partition input data.
@@ -130,6 +161,33 @@ class WindowPartition {
  private:
   bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
 
+  // Returns the pointers to the rows [begin, end) of the partition. Reads the
+  // rows from the spill files if the partition is spilled. The returned array
+  // is valid until the next call, while the rows are valid until
+  // evictSpilledRows() or an access to a row before the rows in memory.
+  char* const* rowsAt(vector_size_t begin, vector_size_t end) const {
+    if (!spilled()) {
+      return partition_.data() + begin;
+    }
+    return spilledRowsAt(begin, end);
+  }
+
+  char* rowAt(vector_size_t row) const {
+    return *rowsAt(row, row + 1);
+  }
+
+  char* const* spilledRowsAt(vector_size_t begin, vector_size_t end) const;
+
+  // Reopens the spill files and erases all the rows read from them.
+  void restartSpillRead() const;
+
+  // Reads the spilled rows up to 'end'. Skips the rows before 'begin' if no
+  // rows are in memory.
+  void readSpilledRows(vector_size_t begin, vector_size_t end) const;
+
+  // Erases the first 'numRows' rows read from the spill files.
+  void eraseSpilledRows(vector_size_t numRows) const;
+
   // Searches for 'currentRow[frameColumn]' in 'orderByColumn' of rows between
   // 'start' and 'end' in the partition. 'firstMatch' specifies if first or last
   // row is matched.
@@ -172,6 +230,8 @@ class WindowPartition {
   // of WindowPartition.
   folly::Range<char**> partition_;
 
+  const vector_size_t numRows_;
+
   // Mapping from window input column -> index in data_. This is required
   // because the WindowBuild reorders data_ to place partition and sort keys
   // before other columns in data_. But the Window Operator and Function code
@@ -189,5 +249,28 @@ class WindowPartition {
   // corresponding indexes of their input arguments into this vector.
   // They will request for column vector values at the respective index.
   std::vector<exec::RowColumn> columns_;
+
+  // The spill files of a spilled partition in partition order. Empty if the
+  // partition is in memory.
+  const SpillFiles spillFiles_;
+  const uint64_t readBufferSize_{0};
+  memory::MemoryPool* const pool_{nullptr};
+  folly::Synchronized<common::SpillStats>* const spillStats_{nullptr};
+
+  // The state of reading a spilled partition. The rows are read on access by
+  // const methods.
+  mutable std::unique_ptr<UnorderedStreamReader<BatchStream>> spillReader_;
+  mutable RowVectorPtr spillBatch_;
+  mutable std::vector<DecodedVector> decodedSpillBatch_;
+  // The next row of 'spillBatch_' to read.
+  mutable vector_size_t nextSpillBatchRow_{0};
+  // The rows read from the spill files, starting at partition row
+  // 'firstSpilledRow_'.
+  mutable std::vector<char*> spilledRows_;
+  mutable vector_size_t firstSpilledRow_{0};
+  // The lowest partition row accessed since the last evictSpilledRows().
+  mutable vector_size_t minAccessedRow_{0};
+  // Maps the row numbers of extractColumn() to 'spilledRows_'.
+  mutable std::vector<vector_size_t> spilledRowNumbers_;
 };
 } // namespace facebook::velox::exec
@@ -105,11 +105,15 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  // Runs 'numLeaves' producer tasks, 'width' by default, that partition
+  // 'vectors' to 'width' consumer tasks.
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
-      Counters& counters) {
+      Counters& counters,
+      std::optional<int32_t> numLeaves = std::nullopt) {
+    const auto numLeafTasks = numLeaves.value_or(width);
     assert(!vectors.empty());
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
@@ -122,7 +126,7 @@ class ExchangeBenchmark : public VectorTestBase {
                         .planNode();
 
     auto startMicros = getCurrentTimeMicro();
-    for (int32_t counter = 0; counter < width; ++counter) {
+    for (int32_t counter = 0; counter < numLeafTasks; ++counter) {
       auto leafTaskId = makeTaskId(iteration, "leaf", counter);
       leafTaskIds.push_back(leafTaskId);
       auto leafTask = makeTask(leafTaskId, leafPlan, counter);
@@ -156,7 +160,8 @@ class ExchangeBenchmark : public VectorTestBase {
 
     auto expected =
         makeRowVector({makeFlatVector<int64_t>(1, [&](auto /*row*/) {
-          return vectors.size() * vectors[0]->size() * width * taskWidth;
+          return vectors.size() * vectors[0]->size() * numLeafTasks *
+              taskWidth;
         })});
 
     exec::test::AssertQueryBuilder(plan)
@@ -187,7 +192,7 @@ class ExchangeBenchmark : public VectorTestBase {
     }
 
     counters.bytes += bytes;
-    counters.rows += width * vectors.size() * vectors[0]->size();
+    counters.rows += numLeafTasks * vectors.size() * vectors[0]->size();
     counters.usec += elapsed;
     counters.repartitionNanos += repartitionNanos;
     counters.exchangeNanos += exchangeNanos;
@@ -357,6 +362,8 @@ void runBenchmarks() {
   Counters deep50Counters;
   Counters localFlat10kCounters;
   Counters struct1kCounters;
+  Counters flat10k100DestCounters;
+  Counters flat10k1000DestCounters;
 
   std::vector<std::string> flatNames = {"c0"};
   std::vector<TypePtr> flatTypes = {BIGINT()};
@@ -442,6 +449,18 @@ void runBenchmarks() {
     return 1;
   });
 
+  // One producer partitioning to many destinations, so that each destination
+  // gets few rows of each batch.
+  folly::addBenchmark(__FILE__, "exchangeFlat10k100Dest", [&]() {
+    bm->run(flat10k, 100, 1, flat10k100DestCounters, 1);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "exchangeFlat10k1000Dest", [&]() {
+    bm->run(flat10k, 1000, 1, flat10k1000DestCounters, 1);
+    return 1;
+  });
+
   folly::addBenchmark(__FILE__, "localFlat10k", [&]() {
     bm->runLocal(
         flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
@@ -453,7 +472,11 @@ void runBenchmarks() {
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
             << "deep50: " << deep50Counters.toString() << std::endl
-            << "struct1k: " << struct1kCounters.toString() << std::endl;
+            << "struct1k: " << struct1kCounters.toString() << std::endl
+            << "flat10k100Dest: " << flat10k100DestCounters.toString()
+            << std::endl
+            << "flat10k1000Dest: " << flat10k1000DestCounters.toString()
+            << std::endl;
 }
 
 } // namespace
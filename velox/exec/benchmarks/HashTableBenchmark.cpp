@@ -37,6 +37,11 @@ DEFINE_int32(custom_key_spacing, 1, "Spacing between key values");
 DEFINE_int32(custom_num_ways, 10, "Number of build threads");
 
 DEFINE_bool(profile, false, "Generate perf profiles and memory stats");
+DEFINE_int32(
+    huge_page_size_class_pages,
+    0,
+    "Back MmapAllocator size classes of at least this many pages with huge "
+    "pages. 0 means disabled");
 
 DECLARE_bool(velox_time_allocations);
 
@@ -364,7 +369,8 @@ class HashTableBenchmark : public VectorTestBase {
         return vectorMaker_->flatVector<int64_t>(
             size,
             [&](vector_size_t row) {
-              return params_.keySpacing * (sequence + row);
+              return static_cast<int64_t>(params_.keySpacing) *
+                  (sequence + row);
             },
             nullptr);
 
@@ -622,6 +628,7 @@ int main(int argc, char** argv) {
   options.allocatorCapacity = 10UL << 30;
   options.useMmapArena = true;
   options.mmapArenaCapacityRatio = 1;
+  options.hugePageSizeClassPages = FLAGS_huge_page_size_class_pages;
   memory::MemoryManager::initialize(options);
   if (FLAGS_profile) {
     auto allocator = memory::MemoryManager::getInstance()->allocator();
@@ -652,6 +659,29 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
       HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+
+  // Multi-column integer keys. The key spacing makes the key ranges too wide
+  // for normalized keys so that the table is in kHash mode and compares the
+  // keys column by column.
+  for (auto numKeys : {2, 4, 8}) {
+    std::vector<std::string> names;
+    for (auto i = 0; i < numKeys; ++i) {
+      names.push_back(fmt::format("k{}", i + 1));
+    }
+    const auto buildType =
+        ROW(std::move(names), std::vector<TypePtr>(numKeys, BIGINT()));
+    for (auto hitRate : {100, 5}) {
+      HashTableBenchmarkParams multiKeyParams(
+          fmt::format("{}4MKeys{}", hitRate == 100 ? "Hit" : "Miss", numKeys),
+          4000000,
+          hitRate,
+          1'000'000);
+      multiKeyParams.mode = BaseHashTable::HashMode::kHash;
+      multiKeyParams.buildType = buildType;
+      multiKeyParams.numKeys = numKeys;
+      params.push_back(std::move(multiKeyParams));
+    }
+  }
   if (FLAGS_custom_size != 0) {
     params.push_back(HashTableBenchmarkParams(
         "Custom",
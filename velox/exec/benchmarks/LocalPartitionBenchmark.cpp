@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int32(batch_size, 16, "Number of rows in each input batch");
+DEFINE_int32(num_batches, 2'000, "Number of input batches of each driver");
+
+/// Measures the throughput of local repartitioning with different numbers of
+/// drivers. Each driver produces many small batches that are hash
+/// partitioned to all the drivers of the consuming pipeline, so that the
+/// time is dominated by the LocalExchangeQueues and their shared memory
+/// accounting rather than by the operators around them.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+class LocalPartitionBenchmark : public VectorTestBase {
+ public:
+  LocalPartitionBenchmark() {
+    for (auto i = 0; i < FLAGS_num_batches; ++i) {
+      data_.push_back(makeRowVector({makeFlatVector<int64_t>(
+          FLAGS_batch_size,
+          [i](auto row) { return i * FLAGS_batch_size + row; })}));
+    }
+  }
+
+  void run(int32_t numDrivers) {
+    auto plan = exec::test::PlanBuilder()
+                    .values(data_, true)
+                    .localPartition({"c0"})
+                    .partialAggregation({}, {"count(1)"})
+                    .planNode();
+    exec::test::AssertQueryBuilder(plan)
+        .maxDrivers(numDrivers)
+        .copyResults(pool());
+  }
+
+ private:
+  std::vector<RowVectorPtr> data_;
+};
+
+std::unique_ptr<LocalPartitionBenchmark> bm;
+
+void localPartition(uint32_t iterations, int32_t numDrivers) {
+  for (auto i = 0; i < iterations; ++i) {
+    bm->run(numDrivers);
+  }
+}
+
+BENCHMARK_NAMED_PARAM(localPartition, 1_driver, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(localPartition, 4_drivers, 4);
+BENCHMARK_RELATIVE_NAMED_PARAM(localPartition, 16_drivers, 16);
+BENCHMARK_RELATIVE_NAMED_PARAM(localPartition, 64_drivers, 64);
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  aggregate::prestosql::registerAllAggregateFunctions();
+
+  bm = std::make_unique<LocalPartitionBenchmark>();
+  folly::runBenchmarks();
+  bm.reset();
+  return 0;
+}
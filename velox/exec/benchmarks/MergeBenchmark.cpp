@@ -28,6 +28,10 @@ using namespace facebook::velox::exec::test;
 TestData narrow;
 TestData medium;
 TestData wide;
+// Low fan-in merges with long runs of consecutive winners from the same stream
+// like the merge of spilled sorted runs.
+TestData longRuns;
+TestData shortRuns;
 
 BENCHMARK(narrowTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(narrow, false);
@@ -37,6 +41,10 @@ BENCHMARK_RELATIVE(narrowArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(narrow, false);
 }
 
+BENCHMARK_RELATIVE(narrowTreeBatched) {
+  MergeTestBase::testRuns<TreeOfLosers<TestingStream>>(narrow, false);
+}
+
 BENCHMARK(mediumTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(medium, false);
 }
@@ -53,6 +61,22 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK(longRunsTree) {
+  MergeTestBase::test<TreeOfLosers<TestingStream>>(longRuns, false);
+}
+
+BENCHMARK_RELATIVE(longRunsTreeBatched) {
+  MergeTestBase::testRuns<TreeOfLosers<TestingStream>>(longRuns, false);
+}
+
+BENCHMARK(shortRunsTree) {
+  MergeTestBase::test<TreeOfLosers<TestingStream>>(shortRuns, false);
+}
+
+BENCHMARK_RELATIVE(shortRunsTreeBatched) {
+  MergeTestBase::testRuns<TreeOfLosers<TestingStream>>(shortRuns, false);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -61,6 +85,8 @@ int main(int argc, char* argv[]) {
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
+  longRuns = test.makeTestData(100'000'000, 4, 1'000);
+  shortRuns = test.makeTestData(100'000'000, 4, 4);
   folly::runBenchmarks();
   return 0;
 }
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/OperatorCapture.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+
+DEFINE_string(
+    capture_dir,
+    "",
+    "A <task id>/<plan node id> directory written by a query with the "
+    "operator_capture_node_id and operator_capture_dir configs");
+
+/// Replays the input batches and the plan node captured from a query with
+/// the operator_capture_node_id config. The sources of the plan node are
+/// replaced by ValuesNodes with the captured batches, so that the benchmark
+/// measures the operators of the plan node on the data of the query, e.g. a
+/// HashAggregation or a HashProbe and its HashBuild.
+
+using namespace facebook::velox;
+
+namespace {
+
+std::shared_ptr<memory::MemoryPool> pool;
+core::PlanNodePtr plan;
+
+void replay(uint32_t iterations) {
+  for (auto i = 0; i < iterations; ++i) {
+    exec::test::AssertQueryBuilder(plan).copyResults(pool.get());
+  }
+}
+
+BENCHMARK(replay, n) {
+  replay(n);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  VELOX_USER_CHECK(!FLAGS_capture_dir.empty(), "--capture_dir is required");
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+  parse::registerTypeResolver();
+  Type::registerSerDe();
+  common::Filter::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  core::PlanNode::registerSerDe();
+  exec::registerPartitionFunctionSerDe();
+
+  pool = memory::memoryManager()->addLeafPool();
+  plan = exec::OperatorCapture::replayPlan(FLAGS_capture_dir, pool.get());
+  LOG(INFO) << "Replaying " << plan->toString(true, true);
+  folly::runBenchmarks();
+  plan.reset();
+  pool.reset();
+  return 0;
+}
@@ -32,8 +32,13 @@ class TestCase {
       const std::string& testName,
       size_t numRows,
       const RowTypePtr& rowType,
-      int numKeys)
-      : testName_(testName), numRows_(numRows), pool_(pool), rowType_(rowType) {
+      int numKeys,
+      const std::string& stringKeyPrefix = "")
+      : testName_(testName),
+        numRows_(numRows),
+        pool_(pool),
+        rowType_(rowType),
+        stringKeyPrefix_(stringKeyPrefix) {
     // Initialize a RowContainer that holds fuzzed rows to be sorted.
     std::vector<TypePtr> keyTypes;
     std::vector<TypePtr> dependentTypes;
@@ -105,6 +110,30 @@ class TestCase {
       }
       children.push_back(fuzzer.fuzz(rowType_->childAt(numKeys - 1)));
     }
+    // Prepend 'stringKeyPrefix_' to the string keys, e.g. to mock URLs that
+    // share the scheme and host.
+    if (!stringKeyPrefix_.empty()) {
+      for (auto i = 0; i < numKeys; ++i) {
+        if (!rowType_->childAt(i)->isVarchar()) {
+          continue;
+        }
+        DecodedVector decoded(*children[i]);
+        auto prefixed = BaseVector::create<FlatVector<StringView>>(
+            VARCHAR(), numRows, pool_);
+        for (auto row = 0; row < numRows; ++row) {
+          if (decoded.isNullAt(row)) {
+            prefixed->setNull(row, true);
+          } else {
+            prefixed->set(
+                row,
+                StringView(
+                    stringKeyPrefix_ +
+                    decoded.valueAt<StringView>(row).str()));
+          }
+        }
+        children[i] = std::move(prefixed);
+      }
+    }
     // Fuzz payload
     {
       for (auto i = numKeys; i < rowType_->size(); ++i) {
@@ -122,6 +151,7 @@ class TestCase {
   std::unique_ptr<RowContainer> data_;
   memory::MemoryPool* const pool_;
   const RowTypePtr rowType_;
+  const std::string stringKeyPrefix_;
   std::vector<CompareFlags> compareFlags_;
 };
 
@@ -167,9 +197,10 @@ class PrefixSortBenchmark {
       const RowTypePtr& rowType,
       int iterations,
       int numKeys,
-      bool testStdSort) {
-    auto testCase =
-        std::make_unique<TestCase>(pool_, testName, numRows, rowType, numKeys);
+      bool testStdSort,
+      const std::string& stringKeyPrefix) {
+    auto testCase = std::make_unique<TestCase>(
+        pool_, testName, numRows, rowType, numKeys, stringKeyPrefix);
     // Add benchmarks for std-sort and prefix-sort.
     {
       if (testStdSort) {
@@ -211,13 +242,20 @@ class PrefixSortBenchmark {
       const std::vector<RowTypePtr>& rowTypes,
       const std::vector<int>& numKeys,
       int32_t iterations,
-      bool testStdSort = true) {
+      bool testStdSort = true,
+      const std::string& stringKeyPrefix = "") {
     for (auto batchSize : batchSizes) {
       for (auto i = 0; i < rowTypes.size(); ++i) {
         const auto name = fmt::format(
             "{}_{}_{}_{}k", prefix, numKeys[i], keyName, batchSize / 1000.0);
         addBenchmark(
-            name, batchSize, rowTypes[i], iterations, numKeys[i], testStdSort);
+            name,
+            batchSize,
+            rowTypes[i],
+            iterations,
+            numKeys[i],
+            testStdSort,
+            stringKeyPrefix);
       }
     }
   }
@@ -298,6 +336,28 @@ class PrefixSortBenchmark {
         "no-payloads", "varchar", batchSizes, rowTypes, numKeys, iterations);
   }
 
+  // String keys that share a long common prefix, e.g. URLs of the same host,
+  // so that most string prefixes tie and are compared with the RowContainer.
+  void largeVarcharWithCommonPrefix() {
+    const auto iterations = 10;
+    const std::vector<vector_size_t> batchSizes = {
+        1'000, 10'000, 100'000, 1'000'000};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({VARCHAR()}),
+        ROW({VARCHAR(), BIGINT()}),
+    };
+    std::vector<int> numKeys = {1, 2};
+    benchmark(
+        "no-payloads",
+        "url",
+        batchSizes,
+        rowTypes,
+        numKeys,
+        iterations,
+        true,
+        "https://www.example.com/");
+  }
+
  private:
   std::vector<std::unique_ptr<TestCase>> testCases_;
   memory::MemoryPool* pool_;
@@ -318,6 +378,7 @@ int main(int argc, char** argv) {
   bm.largeBigintWithPayloads();
   bm.smallBigintWithPayload();
   bm.largeVarchar();
+  bm.largeVarcharWithCommonPrefix();
   folly::runBenchmarks();
 
   return 0;
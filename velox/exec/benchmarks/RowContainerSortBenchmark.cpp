@@ -73,10 +73,14 @@ std::vector<std::optional<StringView>> getDataFromFile() {
   auto rowReader = reader.createRowReader(rowReaderOpts);
   auto data = BaseVector::create(rowType, 50000, pool.get());
   rowReader->next(50000, data);
-  auto querySigCol =
-      data->as<RowVector>()->childAt(0)->asFlatVector<StringView>();
-  auto resSigCol =
-      data->as<RowVector>()->childAt(1)->asFlatVector<StringView>();
+  auto querySigCol = data->as<RowVector>()
+                         ->childAt(0)
+                         ->loadedVector()
+                         ->asFlatVector<StringView>();
+  auto resSigCol = data->as<RowVector>()
+                       ->childAt(1)
+                       ->loadedVector()
+                       ->asFlatVector<StringView>();
   std::vector<std::optional<StringView>> stdVector(querySigCol->size());
   for (int i = 0; i < querySigCol->size(); i++) {
     auto merge =
@@ -69,6 +69,34 @@ class SetAccumulatorBenchmark : public facebook::velox::test::VectorTestBase {
     folly::doNotOptimizeAway(result);
   }
 
+  // Adds 10M values to 1M accumulators, so that each gets 10 values. Small
+  // sets are the common case for set_agg with grouping keys.
+  void runSmallSets() {
+    using Accumulator = aggregate::prestosql::SetAccumulator<int64_t>;
+    constexpr int32_t kNumGroups = 1'000'000;
+
+    HashStringAllocator allocator(pool());
+    std::vector<Accumulator> accumulators;
+    accumulators.reserve(kNumGroups);
+    for (auto i = 0; i < kNumGroups; ++i) {
+      accumulators.emplace_back(BIGINT(), &allocator);
+    }
+
+    for (const auto& rowVector : rowVectors_) {
+      DecodedVector decoded(*rowVector->childAt("a"));
+      for (auto i = 0; i < rowVector->size(); ++i) {
+        accumulators[i % kNumGroups].addValue(decoded, i, &allocator);
+      }
+    }
+
+    size_t total = 0;
+    for (auto& accumulator : accumulators) {
+      total += accumulator.size();
+      accumulator.free(allocator);
+    }
+    folly::doNotOptimizeAway(total);
+  }
+
  private:
   template <typename T>
   void runPrimitive(const std::string& name) {
@@ -107,6 +135,10 @@ BENCHMARK(twoBigints) {
   bm->runTwoBigints();
 }
 
+BENCHMARK(smallSets) {
+  bm->runSmallSets();
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
 
@@ -34,7 +35,8 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, float, double, Timestamp). Strings are encoded by the overload
+  /// below.
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
@@ -53,6 +55,47 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encode the prefix of a string into 'encodedSize' bytes, which must be
+  /// at least 3.
+  /// 1. The first byte is the null byte, same as for the primitive types.
+  /// 2. The next 'encodedSize' - 2 bytes are the first bytes of the string,
+  ///    padded with '0' if the string is shorter. The bytes are inverted when
+  ///    descending order.
+  /// 3. The last byte is the tie-break flag: 0 if the whole string fits in
+  ///    the prefix, 1 if it was truncated, inverted when descending order.
+  ///    A string that fits the prefix is smaller than a truncated string with
+  ///    the same prefix, as it is a prefix of the latter.
+  /// Two strings with equal encodings may still differ, e.g. if both are
+  /// truncated, so the caller must compare them fully to break the tie.
+  FOLLY_ALWAYS_INLINE void encode(
+      std::optional<StringView> value,
+      char* dest,
+      uint32_t encodedSize) const {
+    VELOX_DCHECK_GE(encodedSize, 3);
+    const uint32_t prefixSize = encodedSize - 2;
+    if (!value.has_value()) {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, encodedSize - 1);
+      return;
+    }
+
+    dest[0] = nullsFirst_ ? 1 : 0;
+    const auto size = value->size();
+    const auto copySize = std::min<uint32_t>(size, prefixSize);
+    if (copySize > 0) {
+      simd::memcpy(dest + 1, value->data(), copySize);
+    }
+    if (copySize < prefixSize) {
+      simd::memset(dest + 1 + copySize, 0, prefixSize - copySize);
+    }
+    dest[encodedSize - 1] = size > prefixSize ? 1 : 0;
+    if (!ascending_) {
+      for (auto i = 1; i < encodedSize; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
   /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
   template <typename T>
@@ -68,8 +111,12 @@ class PrefixSortEncoder {
 
   /// @return For supported types, returns the encoded size, assume nullable.
   ///         For not supported types, returns 'std::nullopt'.
+  /// @param stringPrefixLength The number of bytes of a VARCHAR or VARBINARY
+  ///        value to store in the prefix. Strings are not supported if it is
+  ///        0.
   FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedSize(
-      TypeKind typeKind) {
+      TypeKind typeKind,
+      uint32_t stringPrefixLength = 0) {
     switch ((typeKind)) {
       case ::facebook::velox::TypeKind::INTEGER: {
         return 5;
@@ -86,6 +133,15 @@ class PrefixSortEncoder {
       case ::facebook::velox::TypeKind::TIMESTAMP: {
         return 17;
       }
+      case ::facebook::velox::TypeKind::VARCHAR:
+        [[fallthrough]];
+      case ::facebook::velox::TypeKind::VARBINARY: {
+        if (stringPrefixLength == 0) {
+          return std::nullopt;
+        }
+        // Null byte + prefix + tie-break flag.
+        return stringPrefixLength + 2;
+      }
       default:
         return std::nullopt;
     }
@@ -266,6 +266,115 @@ class PrefixEncoderTest : public testing::Test,
     test(descNullsLastEncoder_);
   };
 
+  void testEncodeString() {
+    // 6 bytes: null byte, 4 bytes prefix and tie-break flag.
+    constexpr uint32_t kEncodedSize = 6;
+    char encoded[kEncodedSize];
+
+    ascNullsFirstEncoder_.encode(
+        std::optional<StringView>("ab"), encoded, kEncodedSize);
+    const char expected[kEncodedSize] = {1, 'a', 'b', 0, 0, 0};
+    ASSERT_EQ(std::memcmp(encoded, expected, kEncodedSize), 0);
+
+    ascNullsLastEncoder_.encode(
+        std::optional<StringView>("abcdef"), encoded, kEncodedSize);
+    ASSERT_EQ(std::memcmp(encoded, "\0abcd\x01", kEncodedSize), 0);
+
+    descNullsFirstEncoder_.encode(
+        std::optional<StringView>("ab"), encoded, kEncodedSize);
+    ASSERT_EQ(encoded[0], 1);
+    ASSERT_EQ((uint8_t)encoded[1], (uint8_t)~'a');
+    ASSERT_EQ((uint8_t)encoded[2], (uint8_t)~'b');
+    ASSERT_EQ((uint8_t)encoded[3], 0xff);
+    ASSERT_EQ((uint8_t)encoded[4], 0xff);
+    ASSERT_EQ((uint8_t)encoded[5], 0xff);
+
+    ascNullsFirstEncoder_.encode(
+        std::optional<StringView>(), encoded, kEncodedSize);
+    ASSERT_EQ(std::memcmp(encoded, "\0\0\0\0\0\0", kEncodedSize), 0);
+    ascNullsLastEncoder_.encode(
+        std::optional<StringView>(), encoded, kEncodedSize);
+    ASSERT_EQ(std::memcmp(encoded, "\x01\0\0\0\0\0", kEncodedSize), 0);
+
+    // A string that fits the prefix is smaller than a truncated string with
+    // the same prefix.
+    char truncated[kEncodedSize];
+    ascNullsFirstEncoder_.encode(
+        std::optional<StringView>("abcd"), encoded, kEncodedSize);
+    ascNullsFirstEncoder_.encode(
+        std::optional<StringView>("abcde"), truncated, kEncodedSize);
+    ASSERT_LT(std::memcmp(encoded, truncated, kEncodedSize), 0);
+    descNullsFirstEncoder_.encode(
+        std::optional<StringView>("abcd"), encoded, kEncodedSize);
+    descNullsFirstEncoder_.encode(
+        std::optional<StringView>("abcde"), truncated, kEncodedSize);
+    ASSERT_GT(std::memcmp(encoded, truncated, kEncodedSize), 0);
+  }
+
+  void testFuzzString(const TypePtr& type) {
+    const int vectorSize = 1024;
+    // Encodes 8 bytes prefixes of strings up to 16 bytes, so that both the
+    // truncated and the not truncated strings are compared.
+    constexpr uint32_t kEncodedSize = 10;
+
+    auto compare = [](char* left, char* right) {
+      const auto result = std::memcmp(left, right, kEncodedSize);
+      return result < 0 ? -1 : (result > 0 ? 1 : 0);
+    };
+
+    auto test = [&](const PrefixSortEncoder& encoder) {
+      VectorFuzzer fuzzer(
+          {.vectorSize = vectorSize,
+           .nullRatio = 0.1,
+           .stringLength = 16,
+           .stringVariableLength = true},
+          pool());
+
+      CompareFlags compareFlag = {
+          encoder.isNullsFirst(),
+          encoder.isAscending(),
+          false,
+          CompareFlags::NullHandlingMode::kNullAsValue};
+      SCOPED_TRACE(compareFlag.toString());
+      const auto leftVector = std::dynamic_pointer_cast<FlatVector<StringView>>(
+          fuzzer.fuzzFlat(type, vectorSize));
+      const auto rightVector =
+          std::dynamic_pointer_cast<FlatVector<StringView>>(
+              fuzzer.fuzzFlat(type, vectorSize));
+
+      char leftEncoded[kEncodedSize];
+      char rightEncoded[kEncodedSize];
+
+      for (auto i = 0; i < vectorSize; ++i) {
+        const auto leftValue = leftVector->isNullAt(i)
+            ? std::nullopt
+            : std::optional<StringView>(leftVector->valueAt(i));
+        const auto rightValue = rightVector->isNullAt(i)
+            ? std::nullopt
+            : std::optional<StringView>(rightVector->valueAt(i));
+        encoder.encode(leftValue, leftEncoded, kEncodedSize);
+        encoder.encode(rightValue, rightEncoded, kEncodedSize);
+
+        // Equal prefixes are ties to break with a full compare, otherwise the
+        // prefixes must be in the order of the values.
+        const auto result = compare(leftEncoded, rightEncoded);
+        const auto expected =
+            leftVector->compare(rightVector.get(), i, i, compareFlag).value();
+        if (result != 0) {
+          ASSERT_EQ(result, expected < 0 ? -1 : 1);
+        }
+        if (expected == 0) {
+          ASSERT_EQ(result, 0);
+        }
+      }
+    };
+
+    test(ascNullsFirstEncoder_);
+    test(ascNullsLastEncoder_);
+    test(descNullsFirstEncoder_);
+    test(descNullsLastEncoder_);
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -327,6 +436,10 @@ TEST_F(PrefixEncoderTest, encode) {
   }
 }
 
+TEST_F(PrefixEncoderTest, encodeString) {
+  testEncodeString();
+}
+
 TEST_F(PrefixEncoderTest, compare) {
   testCompare<uint64_t>();
   testCompare<uint32_t>();
@@ -357,4 +470,12 @@ TEST_F(PrefixEncoderTest, fuzzyTimestamp) {
   testFuzz<TypeKind::TIMESTAMP>();
 }
 
+TEST_F(PrefixEncoderTest, fuzzyVarchar) {
+  testFuzzString(VARCHAR());
+}
+
+TEST_F(PrefixEncoderTest, fuzzyVarbinary) {
+  testFuzzString(VARBINARY());
+}
+
 } // namespace facebook::velox::exec::prefixsort::test
@@ -1004,6 +1004,75 @@ TEST_F(AggregationTest, largeValueRangeArray) {
   EXPECT_EQ(1, stats.at(finalAggId).inputVectors);
 }
 
+TEST_F(AggregationTest, partialAggregationSparseArray) {
+  // A (date, enum, enum) key whose value id ranges are too large for a flat
+  // array but fill only a few pages of a sparse one. The partial agg must
+  // count the allocated pages, not the whole range, against its memory limit.
+  // Otherwise it sees an oversize sparse range array and rehashes without
+  // value ranges.
+  constexpr int32_t kNumDates = 3'653;
+  const std::vector<std::pair<int64_t, int64_t>> pairs = {
+      {0, 0}, {3, 7}, {11, 2}, {24, 24}};
+  const auto numRows = kNumDates * pairs.size();
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows, [&](auto row) { return 18'000 + row % kNumDates; }),
+        makeFlatVector<int64_t>(
+            numRows, [&](auto row) { return pairs[row / kNumDates].first; }),
+        makeFlatVector<int64_t>(
+            numRows, [&](auto row) { return pairs[row / kNumDates].second; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  std::vector<BaseHashTable::HashMode> modes;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashTable::setHashMode",
+      std::function<void(void*)>([&](void* newMode) {
+        modes.push_back(*reinterpret_cast<BaseHashTable::HashMode*>(newMode));
+      }));
+  auto runQuery = [&](int64_t maxPartialMemory) {
+    core::PlanNodeId partialAggId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(
+                QueryConfig::kMaxPartialAggregationMemory,
+                std::to_string(maxPartialMemory))
+            .config(
+                QueryConfig::kMaxExtendedPartialAggregationMemory,
+                std::to_string(maxPartialMemory))
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0", "c1", "c2"}, {"count(1)"})
+                      .capturePlanNodeId(partialAggId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, c1, c2, count(1) FROM tmp GROUP BY c0, c1, c2");
+    return toPlanStats(task->taskStats()).at(partialAggId).customStats;
+  };
+
+  const auto unlimitedStats = runQuery(1LL << 30);
+  modes.clear();
+  // Well above the allocated pages and rows, well below the value id range.
+  const auto stats = runQuery(16 << 20);
+  ASSERT_EQ(0, stats.count("flushRowCount"));
+  ASSERT_EQ(
+      unlimitedStats.at(BaseHashTable::kNumRehashes).sum,
+      stats.at(BaseHashTable::kNumRehashes).sum);
+  ASSERT_LT(
+      stats.at(BaseHashTable::kCapacity).max,
+      BaseHashTable::kArrayHashMaxSize);
+#ifndef NDEBUG
+  ASSERT_FALSE(modes.empty());
+  for (auto mode : modes) {
+    ASSERT_EQ(BaseHashTable::HashMode::kArray, mode);
+  }
+#endif
+}
+
 TEST_F(AggregationTest, partialAggregationMemoryLimitIncrease) {
   constexpr int64_t kGB = 1 << 30;
   constexpr int64_t kB = 1 << 10;
@@ -1084,6 +1153,108 @@ TEST_F(AggregationTest, partialAggregationMemoryLimitIncrease) {
   }
 }
 
+TEST_F(AggregationTest, partialAggregationCacheTable) {
+  struct {
+    int32_t numDistinctPerBatch;
+    bool expectedCacheTableDisabled;
+
+    std::string debugString() const {
+      return fmt::format(
+          "numDistinctPerBatch: {}, expectedCacheTableDisabled: {}",
+          numDistinctPerBatch,
+          expectedCacheTableDisabled);
+    }
+  } testSettings[] = {{10, false}, {1'000, true}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    std::vector<RowVectorPtr> vectors;
+    for (int32_t i = 0; i < 10; ++i) {
+      vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+          1'000, [&](auto row) {
+            return i * 1'000 + row % testData.numDistinctPerBatch;
+          })}));
+    }
+    createDuckDbTable(vectors);
+
+    // Set an artificially low cache table limit to flush after each input.
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kPartialAggregationCacheTableMemory, "1")
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"count(1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+    ASSERT_LT(0, runtimeStats.at("flushTimes").sum);
+    ASSERT_LT(0, runtimeStats.at("partialAggregationCacheTableHitPct").count);
+    if (testData.expectedCacheTableDisabled) {
+      ASSERT_EQ(
+          1, runtimeStats.at("disabledPartialAggregationCacheTable").sum);
+      ASSERT_EQ(1, runtimeStats.at("partialAggregationCacheTableHitPct").count);
+    } else {
+      ASSERT_EQ(0, runtimeStats.count("disabledPartialAggregationCacheTable"));
+      ASSERT_LT(1, runtimeStats.at("partialAggregationCacheTableHitPct").count);
+    }
+  }
+}
+
+TEST_F(AggregationTest, finalAggregationMergeAcrossDrivers) {
+  constexpr int32_t kNumDrivers = 4;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 300; }),
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) {
+              return StringView::makeInline(std::to_string(row % 7));
+            }),
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return i + row; }),
+    }));
+  }
+  // Each driver of the parallelizable values node produces all the vectors.
+  std::vector<RowVectorPtr> duckDbVectors;
+  for (int32_t i = 0; i < kNumDrivers; ++i) {
+    duckDbVectors.insert(duckDbVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(duckDbVectors);
+
+  // Without a local exchange, each driver of the final aggregation only sees
+  // the partial groups of its own partial aggregation.
+  core::PlanNodeId aggNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors, true)
+                  .partialAggregation({"c0", "c1"}, {"sum(c2)", "avg(c2)"})
+                  .finalAggregation()
+                  .capturePlanNodeId(aggNodeId)
+                  .planNode();
+  auto results = AssertQueryBuilder(plan)
+                     .maxDrivers(kNumDrivers)
+                     .config(
+                         QueryConfig::kFinalAggregationMergeAcrossDrivers,
+                         "false")
+                     .copyResults(pool());
+  ASSERT_EQ(kNumDrivers * 1'000, results->size());
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .maxDrivers(kNumDrivers)
+          .config(QueryConfig::kFinalAggregationMergeAcrossDrivers, "true")
+          .assertResults(
+              "SELECT c0, c1, sum(c2), avg(c2) FROM tmp GROUP BY 1, 2");
+  const auto runtimeStats =
+      toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+  ASSERT_EQ(kNumDrivers, runtimeStats.at("mergedAcrossDrivers").count);
+  ASSERT_EQ(
+      kNumDrivers * kNumDrivers, runtimeStats.at("mergedAcrossDrivers").sum);
+}
+
 TEST_F(AggregationTest, partialAggregationMaybeReservationReleaseCheck) {
   auto vectors = {
       makeRowVector({makeFlatVector<int32_t>(
@@ -1325,6 +1496,92 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  // Cube. GroupId replicates the 11 * 17 pre-aggregated groups instead of
+  // the 1000 input rows.
+  core::PlanNodePtr aggregationNode;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .groupingSetsAggregation(
+                      {"k1", "k2"},
+                      {{"k1", "k2"}, {"k1"}, {"k2"}, {}},
+                      {"count(1) as count_1",
+                       "sum(a) as sum_a",
+                       "avg(a) as avg_a",
+                       "max(b) as max_b"})
+                  .capturePlanNode(aggregationNode)
+                  .project({"k1", "k2", "count_1", "sum_a", "avg_a", "max_b"})
+                  .planNode();
+
+  auto task = assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a), avg(a), max(b) FROM tmp "
+      "GROUP BY CUBE (k1, k2)");
+  const auto groupIdId = aggregationNode->sources()[0]->id();
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(11 * 17, planStats.at(groupIdId).inputRows);
+  ASSERT_EQ(4 * 11 * 17, planStats.at(groupIdId).outputRows);
+
+  // Rollup.
+  plan = PlanBuilder()
+             .values({data})
+             .groupingSetsAggregation(
+                 {"k1", "k2"},
+                 {{"k1", "k2"}, {"k1"}, {}},
+                 {"count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"})
+             .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+             .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
+
+  // Grouping keys with aliases of the same input column.
+  plan = PlanBuilder()
+             .values({data})
+             .groupingSetsAggregation(
+                 {"k1", "k1 as k1_copy"},
+                 {{"k1"}, {"k1_copy"}},
+                 {"sum(a) as sum_a"})
+             .project({"k1", "k1_copy", "sum_a"})
+             .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT k1, null, sum(a) FROM tmp GROUP BY k1 "
+      "UNION ALL "
+      "SELECT null, k1, sum(a) FROM tmp GROUP BY k1");
+
+  // A global grouping set over empty input produces one row.
+  plan = PlanBuilder()
+             .values({data})
+             .filter("a < 0")
+             .groupingSetsAggregation(
+                 {"k1", "k2"},
+                 {{"k1", "k2"}, {}},
+                 {"count(1) as count_1", "sum(a) as sum_a"})
+             .project({"k1", "k2", "count_1", "sum_a"})
+             .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a) FROM tmp WHERE a < 0 "
+      "GROUP BY GROUPING SETS ((k1, k2), ())");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1837,23 +2094,60 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
   auto spillDirectory = exec::test::TempDirectoryPath::create();
+
   core::PlanNodeId aggrNodeId;
+
+  auto testPlan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    SCOPED_TRACE(sql);
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .plan(plan)
+                    .assertResults(sql);
+
+    const auto& queryConfig = task->queryCtx()->queryConfig();
+    ASSERT_TRUE(queryConfig.spillEnabled());
+    ASSERT_TRUE(queryConfig.aggregationSpillEnabled());
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    checkSpillStats(stats, true);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  testPlan(plan, "SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .singleAggregation(
+                 {"c1"}, {"count(DISTINCT c6)", "sum(DISTINCT c2)", "max(c3)"})
+             .capturePlanNodeId(aggrNodeId)
+             .planNode();
+  testPlan(
+      plan,
+      "SELECT c1, count(DISTINCT c6), sum(DISTINCT c2), max(c3) "
+      "FROM tmp GROUP BY c1");
+
+  // Verify that spilling is not triggered if aggregation spilling is
+  // disabled.
   TestScopedSpillInjection scopedSpillInjection(100);
   auto task =
       AssertQueryBuilder(duckDbQueryRunner_)
           .spillDirectory(spillDirectory->getPath())
           .config(QueryConfig::kSpillEnabled, true)
-          .config(QueryConfig::kAggregationSpillEnabled, true)
+          .config(QueryConfig::kAggregationSpillEnabled, false)
           .plan(PlanBuilder()
                     .values(vectors)
                     .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
                     .capturePlanNodeId(aggrNodeId)
                     .planNode())
           .assertResults("SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
-  // Verify that spilling is not triggered.
-  const auto& queryConfig = task->queryCtx()->queryConfig();
-  ASSERT_TRUE(queryConfig.spillEnabled());
-  ASSERT_TRUE(queryConfig.aggregationSpillEnabled());
   ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
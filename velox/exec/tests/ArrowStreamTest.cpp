@@ -19,6 +19,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -232,3 +233,45 @@ TEST_F(ArrowStreamTest, error) {
       AssertQueryBuilder(plan).copyResults(pool_.get()),
       "Failed to call get_schema on ArrowStream: get_schema failed.");
 }
+
+TEST_F(ArrowStreamTest, exportTask) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000, [&](auto row) { return i * 1'000 + row; }, nullEvery(7)),
+         makeFlatVector<std::string>(1'000, [](auto row) {
+           return fmt::format("string value {}", row);
+         })}));
+  }
+  createDuckDbTable(vectors);
+
+  auto makeTask = [&](const std::string& filter) {
+    auto plan = PlanBuilder().values(vectors).filter(filter).planFragment();
+    return exec::Task::create(
+        "exportTask",
+        std::move(plan),
+        0,
+        core::QueryCtx::create(),
+        exec::Task::ExecutionMode::kSerial);
+  };
+
+  // The filter output is dictionary encoded and is flattened by the export.
+  // The exported stream is read back through an ArrowStream source.
+  ArrowArrayStream arrowStream;
+  exec::exportToArrowStream(makeTask("c0 % 3 = 0"), arrowStream, pool());
+  auto plan = std::make_shared<core::ArrowStreamNode>(
+      "0",
+      asRowType(vectors[0]->type()),
+      std::make_shared<ArrowArrayStream>(arrowStream));
+  assertQuery(plan, "SELECT * FROM tmp WHERE c0 % 3 = 0");
+
+  // Errors of the task are reported through get_last_error.
+  exec::exportToArrowStream(makeTask("c0 / 0 = 1"), arrowStream, pool());
+  ArrowArray arrowArray;
+  ASSERT_NE(arrowStream.get_next(&arrowStream, &arrowArray), 0);
+  const char* error = arrowStream.get_last_error(&arrowStream);
+  ASSERT_NE(error, nullptr);
+  ASSERT_NE(std::string(error).find("division by zero"), std::string::npos);
+  arrowStream.release(&arrowStream);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DriverExecutor.h"
+
+#include <future>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/ProcessBase.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+class DriverExecutorTest : public OperatorTestBase {};
+
+TEST_F(DriverExecutorTest, basic) {
+  constexpr int32_t kNumThreads = 4;
+  constexpr int32_t kNumFuncs = 1'000;
+  std::atomic<int32_t> numRuns{0};
+  std::atomic<int32_t> numBadWorkers{0};
+  DriverExecutor::Stats stats;
+  {
+    DriverExecutor executor(kNumThreads);
+    ASSERT_EQ(executor.numThreads(), kNumThreads);
+    ASSERT_EQ(executor.currentWorker(), -1);
+    for (auto i = 0; i < kNumFuncs; ++i) {
+      auto func = [&]() {
+        const auto worker = executor.currentWorker();
+        if (worker < 0 || worker >= kNumThreads) {
+          ++numBadWorkers;
+        }
+        ++numRuns;
+      };
+      if (i % 2 == 0) {
+        executor.add(func);
+      } else {
+        executor.addWithAffinity(func, i % (kNumThreads + 1));
+      }
+    }
+    // Functions added from a worker run on the same executor.
+    executor.add([&]() { executor.add([&]() { ++numRuns; }); });
+    while (numRuns < kNumFuncs + 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+    }
+    stats = executor.stats();
+  }
+  ASSERT_EQ(numRuns, kNumFuncs + 1);
+  ASSERT_EQ(numBadWorkers, 0);
+  ASSERT_GE(stats.numRuns, kNumFuncs + 1);
+  ASSERT_LE(stats.numSteals, stats.numRuns);
+  ASSERT_LE(stats.maxQueueTimeUs, stats.queueTimeUs);
+}
+
+TEST_F(DriverExecutorTest, groups) {
+  DriverExecutor executor(1);
+  auto light = executor.makeGroup(1);
+  auto heavy = executor.makeGroup(3);
+  ASSERT_EQ(heavy->weight(), 3);
+  VELOX_ASSERT_THROW(executor.makeGroup(0), "");
+
+  // Blocks the only worker until all functions are added.
+  std::promise<void> start;
+  auto started = start.get_future();
+  executor.add([&]() { started.wait(); });
+
+  constexpr int32_t kNumFuncs = 40;
+  std::mutex mutex;
+  std::vector<int32_t> order;
+  std::atomic<int32_t> numRuns{0};
+  auto makeFunc = [&](int32_t weight) {
+    return [&, weight]() {
+      // Uses about 1ms of CPU.
+      const auto end = process::threadCpuNanos() + 1'000'000;
+      while (process::threadCpuNanos() < end) {
+      }
+      {
+        std::lock_guard<std::mutex> l(mutex);
+        order.push_back(weight);
+      }
+      ++numRuns;
+    };
+  };
+  for (auto i = 0; i < kNumFuncs; ++i) {
+    executor.addWithAffinity(makeFunc(1), 0, light);
+    executor.addWithAffinity(makeFunc(3), 0, heavy);
+  }
+  start.set_value();
+  while (numRuns < 2 * kNumFuncs) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+  }
+
+  // The group with weight 3 gets about 3 times the CPU of the other while
+  // both have work.
+  const auto numHeavy = std::count(order.begin(), order.begin() + 20, 3);
+  ASSERT_GE(numHeavy, 12);
+  ASSERT_GT(heavy->virtualTimeNanos(), 0);
+  ASSERT_GT(light->virtualTimeNanos(), 0);
+}
+
+TEST_F(DriverExecutorTest, query) {
+  auto executor = std::make_shared<DriverExecutor>(4);
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    data.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 17; })}));
+  }
+  auto plan = PlanBuilder()
+                  .values(data, true)
+                  .partialAggregation({"c0"}, {"count(1)"})
+                  .localPartition({"c0"})
+                  .finalAggregation()
+                  .planNode();
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(17, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(
+           17, [](auto row) { return row < 14 ? 2'360 : 2'320; })});
+
+  AssertQueryBuilder(plan)
+      .queryCtx(core::QueryCtx::create(executor.get()))
+      .maxDrivers(4)
+      .assertResults(expected);
+  ASSERT_GT(executor->stats().numRuns, 0);
+}
+
+} // namespace facebook::velox::exec::test
@@ -786,6 +786,33 @@ class PauserNodeFactory : public Operator::PlanNodeTranslator {
 
 } // namespace
 
+TEST_F(DriverTest, adaptiveConcurrency) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 20; ++i) {
+    data.push_back(makeRowVector({makeFlatVector<int64_t>(
+        10'000, [i](auto row) { return i * 10'000 + row; })}));
+  }
+  // Producers compute a hash per row and feed a single consumer through a
+  // local gather, so that they block on the full local exchange queue and
+  // get parked when they yield.
+  auto plan = PlanBuilder()
+                  .values(data, true)
+                  .project({"c0", "xxhash64(to_utf8(cast(c0 as varchar)))"})
+                  .localPartition(std::vector<std::string>{})
+                  .singleAggregation({}, {"count(1)", "sum(c0)"})
+                  .planNode();
+  const int64_t numRows = 4 * 200'000;
+  const int64_t sum = 4 * (200'000LL * (200'000 - 1) / 2);
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(std::vector<int64_t>{numRows}),
+       makeFlatVector<int64_t>(std::vector<int64_t>{sum})});
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kAdaptiveDriverConcurrency, "true")
+      .config(core::QueryConfig::kDriverCpuTimeSliceLimitMs, "1")
+      .maxDrivers(4)
+      .assertResults(expected);
+}
+
 TEST_F(DriverTest, pauserNode) {
   constexpr int32_t kNumTasks = 20;
   constexpr int32_t kThreadsPerTask = 5;
@@ -1055,6 +1082,82 @@ class BlockedNoFutureNodeFactory : public Operator::PlanNodeTranslator {
     return 1;
   }
 };
+
+// Passes its input through and reports blocked on a fulfilled future after
+// each input, as an operator whose I/O completes before it is waited for.
+class ReadyFutureNode : public core::PlanNode {
+ public:
+  ReadyFutureNode(const core::PlanNodeId& id, const core::PlanNodePtr& input)
+      : PlanNode(id), sources_{input} {}
+
+  const RowTypePtr& outputType() const override {
+    return sources_[0]->outputType();
+  }
+
+  const std::vector<std::shared_ptr<const PlanNode>>& sources() const override {
+    return sources_;
+  }
+
+  std::string_view name() const override {
+    return "ReadyFuture";
+  }
+
+ private:
+  void addDetails(std::stringstream& /* stream */) const override {}
+  std::vector<core::PlanNodePtr> sources_;
+};
+
+class ReadyFutureOperator : public Operator {
+ public:
+  ReadyFutureOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const std::shared_ptr<const ReadyFutureNode>& node)
+      : Operator(ctx, node->outputType(), id, node->id(), "ReadyFuture") {}
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_;
+  }
+
+  void addInput(RowVectorPtr input) override {
+    input_ = std::move(input);
+    blocked_ = true;
+  }
+
+  RowVectorPtr getOutput() override {
+    return std::move(input_);
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (!blocked_) {
+      return BlockingReason::kNotBlocked;
+    }
+    blocked_ = false;
+    *future = folly::makeSemiFuture();
+    return BlockingReason::kWaitForConnector;
+  }
+
+ private:
+  bool blocked_{false};
+};
+
+class ReadyFutureNodeFactory : public Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<Operator> toOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const core::PlanNodePtr& node) override {
+    if (auto readyNode =
+            std::dynamic_pointer_cast<const ReadyFutureNode>(node)) {
+      return std::make_unique<ReadyFutureOperator>(ctx, id, readyNode);
+    }
+    return nullptr;
+  }
+};
 } // namespace
 
 // Use a node for which driver factory would throw on any driver beyond id 0.
@@ -1102,6 +1205,41 @@ TEST_F(DriverTest, blockedNoFuture) {
       "by isBlocked method.");
 }
 
+TEST_F(DriverTest, inlineResume) {
+  Operator::registerOperator(std::make_unique<ReadyFutureNodeFactory>());
+
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    data.push_back(makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}));
+  }
+  core::PlanNodeId readyNodeId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .addNode([](const core::PlanNodeId& id,
+                              const core::PlanNodePtr& input) {
+                    return std::make_shared<ReadyFutureNode>(id, input);
+                  })
+                  .capturePlanNodeId(readyNodeId)
+                  .planNode();
+
+  for (const bool inlineResume : {false, true}) {
+    SCOPED_TRACE(fmt::format("inlineResume {}", inlineResume));
+    auto task = AssertQueryBuilder(plan)
+                    .config(
+                        core::QueryConfig::kDriverInlineResume,
+                        inlineResume ? "true" : "false")
+                    .assertResults(data);
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& runtimeStats = planStats.at(readyNodeId).customStats;
+    if (inlineResume) {
+      // Each fulfilled future resumes the driver on thread.
+      ASSERT_EQ(runtimeStats.at("inlineResumes").sum, data.size());
+    } else {
+      ASSERT_EQ(runtimeStats.count("inlineResumes"), 0);
+    }
+  }
+}
+
 TEST_F(DriverTest, nonVeloxOperatorException) {
   Operator::registerOperator(
       std::make_unique<ThrowNodeFactory>(std::numeric_limits<uint32_t>::max()));
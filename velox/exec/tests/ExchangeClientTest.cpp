@@ -261,6 +261,8 @@ TEST_F(ExchangeClientTest, flowControl) {
   EXPECT_LE(stats.at("peakBytes").sum, page->size() * 4);
   EXPECT_EQ(30, stats.at("numReceivedPages").sum);
   EXPECT_EQ(page->size(), stats.at("averageReceivedPageBytes").sum);
+  // Some sources with data wait for the queue to drain.
+  EXPECT_LT(0, stats.at("creditWaitWallNanos").sum);
 
   for (auto& task : tasks) {
     task->requestCancel();
@@ -270,6 +272,40 @@ TEST_F(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+TEST_F(ExchangeClientTest, bdpRequestSizing) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  const auto taskId = "local://bdp";
+  auto task = makeTask(taskId);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+  auto client = std::make_shared<ExchangeClient>(
+      "bdp", 17, 1 << 20, pool(), executor(), true);
+  client->addRemoteTaskId(taskId);
+
+  // Each data response updates the flow estimate of the source. Once it has
+  // one, the data requests ask for more than the reported pages.
+  constexpr int32_t kNumPages = 10;
+  int64_t totalBytes = 0;
+  for (auto i = 0; i < kNumPages; ++i) {
+    totalBytes += enqueue(taskId, 17, data);
+    fetchPages(*client, 1);
+  }
+
+  const auto stats = client->stats();
+  EXPECT_EQ(kNumPages, stats.at("numReceivedPages").sum);
+  EXPECT_EQ(totalBytes / kNumPages, stats.at("averageReceivedPageBytes").sum);
+  EXPECT_LT(0, stats.at("bdpRequestedBytes").sum);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+
+  client->close();
+}
+
 TEST_F(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
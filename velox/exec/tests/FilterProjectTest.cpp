@@ -229,6 +229,40 @@ TEST_F(FilterProjectTest, filterProject) {
   assertQuery(plan, "SELECT c0, c1, c0 + c1 FROM tmp WHERE c1 % 10 > 0");
 }
 
+TEST_F(FilterProjectTest, flattenSelectiveOutput) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            2'000, [&](auto row) { return i * 2'000 + row; }, nullEvery(7)),
+        makeFlatVector<std::string>(
+            2'000,
+            [](auto row) { return fmt::format("string value {}", row); }),
+        makeArrayVector<int32_t>(
+            2'000,
+            [](auto row) { return row % 5; },
+            [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // Passes 5% and 50% of the rows. Only the first output is flattened.
+  for (const auto& filter : {"c0 % 20 = 0", "c0 % 2 = 0"}) {
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .filter(filter)
+                    .project({"c0", "c1", "c2", "c0 + 1"})
+                    .planNode();
+    for (const auto pct : {0, 10}) {
+      SCOPED_TRACE(fmt::format("{} pct: {}", filter, pct));
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kFilterFlattenSelectivityPct, pct)
+          .assertResults(fmt::format(
+              "SELECT c0, c1, c2, c0 + 1 FROM tmp WHERE {}", filter));
+    }
+  }
+}
+
 TEST_F(FilterProjectTest, dereference) {
   std::vector<RowVectorPtr> vectors;
   for (int32_t i = 0; i < 10; ++i) {
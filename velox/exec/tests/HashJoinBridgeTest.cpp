@@ -391,6 +391,109 @@ TEST_P(HashJoinBridgeTest, withSpill) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, skewedSpillPartition) {
+  auto buildFutures = createEmptyFutures(numBuilders_);
+  auto probeFutures = createEmptyFutures(numProbers_);
+
+  auto joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->allowSpillRestoreInBlocks();
+  joinBridge->start();
+  VELOX_ASSERT_THROW(joinBridge->allowSpillRestoreInBlocks(), "");
+
+  const auto setupSpillInputs = [&](bool expectedSpillBlock) {
+    int32_t numFiles{0};
+    std::optional<SpillPartitionId> partitionId;
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      auto inputOr = joinBridge->spillInputOrFuture(&buildFutures[i]);
+      EXPECT_TRUE(inputOr.has_value());
+      EXPECT_TRUE(inputOr.value().spillPartition != nullptr);
+      EXPECT_EQ(inputOr.value().isSpillBlock, expectedSpillBlock);
+      partitionId = inputOr.value().spillPartition->id();
+      numFiles += inputOr.value().spillPartition->numFiles();
+    }
+    return std::make_pair(partitionId.value(), numFiles);
+  };
+
+  // Spill two partitions from the initial build.
+  const SpillPartitionId skewedParentId(startPartitionBitOffset_, 0);
+  const SpillPartitionId otherId(startPartitionBitOffset_, 1);
+  SpillPartitionSet spillPartitionSet;
+  spillPartitionSet.emplace(
+      skewedParentId,
+      std::make_unique<SpillPartition>(
+          skewedParentId, makeFakeSpillFiles(numBuilders_)));
+  spillPartitionSet.emplace(
+      otherId,
+      std::make_unique<SpillPartition>(otherId, makeFakeSpillFiles(1)));
+  joinBridge->setHashTable(
+      createFakeHashTable(), std::move(spillPartitionSet), false);
+  auto tableOr = joinBridge->tableOrFuture(&probeFutures[0]);
+  ASSERT_TRUE(tableOr.has_value());
+  ASSERT_FALSE(tableOr.value().isSpillBlock);
+  ASSERT_FALSE(tableOr.value().hasMoreSpillBlocks);
+
+  // Restore the first partition which spills almost all its data into a
+  // single child partition again.
+  ASSERT_TRUE(joinBridge->probeFinished());
+  auto spillInputs = setupSpillInputs(false);
+  ASSERT_EQ(spillInputs.first, skewedParentId);
+  ASSERT_EQ(spillInputs.second, numBuilders_);
+
+  const SpillPartitionId skewedId(
+      startPartitionBitOffset_ + numPartitionBits_, 0);
+  const int32_t numSkewedFiles = 2 * numBuilders_ + 1;
+  spillPartitionSet.emplace(
+      skewedId,
+      std::make_unique<SpillPartition>(
+          skewedId, makeFakeSpillFiles(numSkewedFiles)));
+  joinBridge->setHashTable(
+      createFakeHashTable(), std::move(spillPartitionSet), false);
+  tableOr = joinBridge->tableOrFuture(&probeFutures[0]);
+  ASSERT_TRUE(tableOr.has_value());
+  ASSERT_EQ(tableOr.value().restoredPartitionId, skewedParentId);
+  ASSERT_FALSE(tableOr.value().isSpillBlock);
+
+  // The skewed child partition is restored in blocks of 'numBuilders_' spill
+  // files without spilling again.
+  int32_t numRestoredFiles{0};
+  for (int32_t block = 0; block < 3; ++block) {
+    SCOPED_TRACE(fmt::format("block: {}", block));
+    ASSERT_TRUE(joinBridge->probeFinished());
+    spillInputs = setupSpillInputs(true);
+    ASSERT_EQ(spillInputs.first, skewedId);
+    ASSERT_EQ(spillInputs.second, block < 2 ? numBuilders_ : 1);
+    numRestoredFiles += spillInputs.second;
+
+    joinBridge->setHashTable(createFakeHashTable(), {}, false);
+    tableOr = joinBridge->tableOrFuture(&probeFutures[0]);
+    ASSERT_TRUE(tableOr.has_value());
+    ASSERT_EQ(tableOr.value().restoredPartitionId, skewedId);
+    ASSERT_TRUE(tableOr.value().isSpillBlock);
+    ASSERT_EQ(tableOr.value().hasMoreSpillBlocks, block < 2);
+  }
+  ASSERT_EQ(numRestoredFiles, numSkewedFiles);
+
+  // The other spill partition is restored as usual.
+  ASSERT_TRUE(joinBridge->probeFinished());
+  spillInputs = setupSpillInputs(false);
+  ASSERT_EQ(spillInputs.first, otherId);
+  ASSERT_EQ(spillInputs.second, 1);
+  joinBridge->setHashTable(createFakeHashTable(), {}, false);
+  tableOr = joinBridge->tableOrFuture(&probeFutures[0]);
+  ASSERT_TRUE(tableOr.has_value());
+  ASSERT_FALSE(tableOr.value().isSpillBlock);
+
+  ASSERT_FALSE(joinBridge->probeFinished());
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    auto inputOr = joinBridge->spillInputOrFuture(&buildFutures[i]);
+    ASSERT_TRUE(inputOr.has_value());
+    ASSERT_TRUE(inputOr.value().spillPartition == nullptr);
+  }
+}
+
 TEST_P(HashJoinBridgeTest, multiThreading) {
   for (int32_t iter = 0; iter < 10; ++iter) {
     std::vector<std::thread> builderThreads;
@@ -2796,6 +2796,49 @@ TEST_P(MultiThreadedHashJoinTest, rightJoin) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, rightJoinWithColumnarDependents) {
+  std::vector<RowVectorPtr> probeVectors =
+      makeBatches(3, [&](int32_t /*unused*/) {
+        return makeRowVector({
+            makeFlatVector<int32_t>(
+                237, [](auto row) { return row % 21; }, nullEvery(13)),
+            makeFlatVector<int32_t>(237, [](auto row) { return row; }),
+        });
+      });
+  std::vector<RowVectorPtr> buildVectors = makeBatches(3, [&](int32_t batch) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            1'500, [](auto row) { return -3 + row % 37; }, nullEvery(11)),
+        makeFlatVector<int64_t>(
+            1'500,
+            [batch](auto row) { return batch * 10'000 + row; },
+            nullEvery(13)),
+        makeFlatVector<std::string>(
+            1'500,
+            [](auto row) { return fmt::format("value {}", row); },
+            nullEvery(17)),
+        makeFlatVector<double>(
+            1'500, [](auto row) { return row / 4.0; }, nullEvery(7)),
+    });
+  });
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"c0"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"u_c0"})
+      .buildVectors(std::move(buildVectors))
+      .buildProjections(
+          {"c0 AS u_c0", "c1 AS u_c1", "c2 AS u_c2", "c3 AS u_c3"})
+      .joinType(core::JoinType::kRight)
+      .joinOutputLayout({"c1", "u_c0", "u_c1", "u_c2", "u_c3"})
+      .config(core::QueryConfig::kHashJoinColumnarDependents, "true")
+      .referenceQuery(
+          "SELECT t.c1, u.c0, u.c1, u.c2, u.c3 FROM t RIGHT JOIN u "
+          "ON t.c0 = u.c0")
+      .run();
+}
+
 TEST_P(MultiThreadedHashJoinTest, rightJoinWithEmptyBuild) {
   const std::vector<bool> finishOnEmptys = {false, true};
   for (const auto finishOnEmpty : finishOnEmptys) {
@@ -4774,6 +4817,96 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, dynamicBloomFilters) {
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 333;
+  const int32_t numRowsBuild = 100;
+
+  // String keys get no exact filter from the build side hashers, so the join
+  // pushes down a Bloom filter over the build side keys.
+  std::vector<RowVectorPtr> probeVectors;
+  probeVectors.reserve(numSplits);
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<StringView>(
+            numRowsProbe,
+            [&](auto row) {
+              return StringView::makeInline(
+                  fmt::format("key-{}", row - i * 10));
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(
+            exec::Split(makeHiveConnectorSplit(file->getPath())));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  // 100 unique key values.
+  std::vector<RowVectorPtr> buildVectors;
+  for (int i = 0; i < 5; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u_c0"},
+        {makeFlatVector<StringView>(numRowsBuild / 5, [i](auto row) {
+          return StringView::makeInline(
+              fmt::format("key-{}", 35 + 2 * (row + i * numRowsBuild / 5)));
+        })}));
+  }
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .planNode();
+
+  for (const auto joinType :
+       {core::JoinType::kInner, core::JoinType::kLeftSemiFilter}) {
+    SCOPED_TRACE(fmt::format("joinType:{}", core::joinTypeName(joinType)));
+    core::PlanNodeId probeScanId;
+    auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(probeType)
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin({"c0"}, {"u_c0"}, buildSide, "", {"c1"}, joinType)
+                  .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(op))
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .referenceQuery(
+            "SELECT t.c1 FROM t WHERE t.c0 IN (SELECT u_c0 FROM u)")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+          if (hasSpill) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(0, getFiltersAccepted(task, 0).sum);
+            return;
+          }
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          // A Bloom filter may pass rows without a match, so the join must
+          // keep probing.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits);
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersStatsWithChainedJoins) {
   const int32_t numSplits = 10;
   const int32_t numProbeRows = 333;
@@ -5386,6 +5519,64 @@ DEBUG_ONLY_TEST_F(HashJoinTest, buildReservationReleaseCheck) {
   ASSERT_TRUE(waitForTaskAborted(task, 5'000'000));
 }
 
+DEBUG_ONLY_TEST_F(HashJoinTest, prebuildProbeInput) {
+  const auto buildVectors = makeVectors(buildType_, 10, 128);
+  const auto probeVectors = makeVectors(probeType_, 5, 128);
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kFull}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+
+    // Holds the build until the probe has buffered input, up to 5s.
+    std::atomic_bool probeBuffered{false};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::addInput",
+        std::function<void(Operator*)>([&](Operator* op) {
+          if (op->operatorType() == "HashProbe") {
+            probeBuffered = true;
+          }
+        }));
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::HashBuild::finishHashBuild",
+        std::function<void(Operator*)>([&](Operator* /*unused*/) {
+          for (auto i = 0; i < 5'000 && !probeBuffered; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+          }
+        }));
+
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId probeNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"t_k1"},
+                        {"u_k1"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "",
+                        concat(probeType_->names(), buildType_->names()),
+                        joinType)
+                    .capturePlanNodeId(probeNodeId)
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        core::QueryConfig::kHashProbePrebuildBufferBytes,
+                        "1048576")
+                    .assertResults(fmt::format(
+                        "SELECT * FROM t {} JOIN u ON t_k1 = u_k1",
+                        core::joinTypeName(joinType)));
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_GT(
+        planStats.at(probeNodeId).customStats.at("prebuildInputBytes").sum, 0);
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFilterOnPartitionKey) {
   vector_size_t size = 10;
   auto filePaths = makeFilePaths(1);
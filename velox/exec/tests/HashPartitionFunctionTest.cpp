@@ -157,6 +157,56 @@ TEST_F(HashPartitionFunctionTest, spec) {
     auto copy = HashPartitionFunctionSpec::deserialize(serialized, pool());
     ASSERT_EQ(hashSpec->toString(), copy->toString());
   }
+
+  // The test case with skew spread.
+  {
+    auto hashSpec = std::make_unique<exec::HashPartitionFunctionSpec>(
+        inputType,
+        std::vector<column_index_t>{0, 1},
+        std::vector<VectorPtr>{},
+        4);
+    ASSERT_EQ("HASH(c0, c1) SKEW_SPREAD(4)", hashSpec->toString());
+
+    auto serialized = hashSpec->serialize();
+    auto copy = HashPartitionFunctionSpec::deserialize(serialized, pool());
+    ASSERT_EQ(hashSpec->toString(), copy->toString());
+  }
+}
+
+TEST_F(HashPartitionFunctionTest, skewSpread) {
+  constexpr int32_t kNumRows = 10'000;
+  constexpr int32_t kNumPartitions = 8;
+  constexpr int32_t kSkewSpread = 4;
+  // Half of the rows have key 0, the others have distinct keys.
+  auto vector = makeRowVector({makeFlatVector<int64_t>(
+      kNumRows, [](auto row) { return row % 2 == 0 ? 0 : row; })});
+  auto rowType = asRowType(vector->type());
+
+  std::vector<uint32_t> partitions;
+  HashPartitionFunction function(kNumPartitions, rowType, {0});
+  function.partition(*vector, partitions);
+
+  std::vector<uint32_t> skewPartitions;
+  HashPartitionFunction skewFunction(
+      kNumPartitions, rowType, {0}, {}, kSkewSpread);
+  skewFunction.partition(*vector, skewPartitions);
+
+  // The rows of the hot key are spread evenly over 4 consecutive partitions
+  // starting at its own. The other rows keep their partition.
+  const auto hotPartition = partitions[0];
+  std::vector<int32_t> hotCounts(kNumPartitions);
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (i % 2 == 0) {
+      ++hotCounts[skewPartitions[i]];
+    } else {
+      ASSERT_EQ(partitions[i], skewPartitions[i]);
+    }
+  }
+  for (auto i = 0; i < kNumPartitions; ++i) {
+    const auto offset = (i + kNumPartitions - hotPartition) % kNumPartitions;
+    ASSERT_EQ(
+        hotCounts[i], offset < kSkewSpread ? kNumRows / 2 / kSkewSpread : 0);
+  }
 }
 
 TEST_F(HashPartitionFunctionTest, noKeyAndBitRange) {
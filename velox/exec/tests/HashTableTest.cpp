@@ -71,6 +71,14 @@ class HashTableTestHelper {
     table_->setHashMode(mode, numNew);
   }
 
+  bool isSparseArray() const {
+    return table_->sparseArray_;
+  }
+
+  size_t numSparseArrayPages() const {
+    return table_->sparseArrayPages_.size();
+  }
+
  private:
   explicit HashTableTestHelper(HashTable<ignoreNullKeys>* table)
       : table_(table) {
@@ -107,7 +115,9 @@ class HashTableTest : public testing::TestWithParam<bool>,
       int32_t size,
       int32_t numWays,
       TypePtr buildType,
-      int32_t numKeys) {
+      int32_t numKeys,
+      uint64_t parallelJoinBuildPartitionBytes =
+          HashTable<true>::kParallelJoinBuildPartitionBytes) {
     std::vector<TypePtr> dependentTypes;
     int32_t sequence = 0;
     isInTable_.resize(
@@ -155,6 +165,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
     const uint64_t estimatedTableSize =
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->usedBytes();
+    topTable_->testingSetParallelJoinBuildPartitionBytes(
+        parallelJoinBuildPartitionBytes);
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
     ASSERT_GE(
         estimatedTableSize,
@@ -611,6 +623,16 @@ TEST_P(HashTableTest, structKey) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 1);
 }
 
+// Multiple integer keys in kHash mode are compared a batch of probe rows at a
+// time.
+TEST_P(HashTableTest, int4SparseHash) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4"}, {BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 3, type, 4);
+}
+
 TEST_P(HashTableTest, mixed6Sparse) {
   auto type =
       ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
@@ -619,6 +641,18 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+// Tests parallel join build with more table partitions than threads.
+TEST_P(HashTableTest, cacheSizedBuildPartitions) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  testCycle(BaseHashTable::HashMode::kHash, 50000, 3, type, 2, 64 << 10);
+  if (executor_ != nullptr) {
+    const auto numPartitions = topTable_->stats().numParallelBuildPartitions;
+    ASSERT_GT(numPartitions, 3);
+    ASSERT_EQ(numPartitions % 3, 0);
+  }
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -768,6 +802,73 @@ TEST_P(HashTableTest, arrayProbeNormalizedKey) {
   ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kNormalizedKey);
 }
 
+TEST_P(HashTableTest, sparseArray) {
+  // A (date, enum, enum) key where a few enum pairs occur with every date.
+  // The product of the ranges is too large for a flat array but the
+  // populated combinations fill a few pages of a sparse array.
+  constexpr int32_t kNumDates = 3'653;
+  const std::vector<std::pair<int64_t, int64_t>> pairs = {
+      {0, 0}, {3, 7}, {11, 2}, {24, 24}};
+  const auto numRows = kNumDates * pairs.size();
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          numRows, [&](auto row) { return 18'000 + row % kNumDates; }),
+      makeFlatVector<int64_t>(
+          numRows, [&](auto row) { return pairs[row / kNumDates].first; }),
+      makeFlatVector<int64_t>(
+          numRows, [&](auto row) { return pairs[row / kNumDates].second; }),
+  });
+  auto table = createHashTableForAggregation(data->type(), 3);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  insertGroups(*data, *lookup, *table);
+  ASSERT_EQ(BaseHashTable::HashMode::kArray, table->hashMode());
+  auto helper = HashTableTestHelper<false>::create(table.get());
+  ASSERT_TRUE(helper.isSparseArray());
+  ASSERT_GT(table->capacity(), BaseHashTable::kArrayHashMaxSize);
+  ASSERT_LT(helper.numSparseArrayPages(), 16);
+  ASSERT_EQ(numRows, table->numDistinct());
+
+  // Probing the same keys again finds the same groups.
+  std::vector<char*> groups(lookup->hits.begin(), lookup->hits.end());
+  insertGroups(*data, *lookup, *table);
+  ASSERT_EQ(numRows, table->numDistinct());
+  for (auto i = 0; i < numRows; ++i) {
+    ASSERT_EQ(groups[i], lookup->hits[i]);
+  }
+  ASSERT_NO_THROW(table->toString());
+
+  table->clear();
+  ASSERT_EQ(0, helper.numSparseArrayPages());
+}
+
+TEST_P(HashTableTest, sparseArrayFallback) {
+  // Key combinations scattered over the whole range leave too few entries per
+  // page. The table switches to normalized keys on the same value ids.
+  constexpr int32_t kNumRows = 20'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return (row * 37) % 3'653; }),
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 25; }),
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return (row / 25) % 25; }),
+  });
+  auto table = createHashTableForAggregation(data->type(), 3);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  insertGroups(*data, *lookup, *table);
+  ASSERT_EQ(BaseHashTable::HashMode::kNormalizedKey, table->hashMode());
+  auto helper = HashTableTestHelper<false>::create(table.get());
+  ASSERT_FALSE(helper.isSparseArray());
+  ASSERT_EQ(0, helper.numSparseArrayPages());
+  const auto numDistinct = table->numDistinct();
+
+  std::vector<char*> groups(lookup->hits.begin(), lookup->hits.end());
+  insertGroups(*data, *lookup, *table);
+  ASSERT_EQ(numDistinct, table->numDistinct());
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(groups[i], lookup->hits[i]);
+  }
+}
+
 TEST_P(HashTableTest, regularHashingTableSize) {
   keySpacing_ = 1000;
   auto checkTableSize = [&](BaseHashTable::HashMode mode,
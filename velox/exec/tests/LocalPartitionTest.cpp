@@ -334,6 +334,47 @@ TEST_F(LocalPartitionTest, indicesBufferCapacity) {
   ASSERT_LE(capacity, 1.5 * numRows * sizeof(vector_size_t));
 }
 
+TEST_F(LocalPartitionTest, flatOutput) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 21; i++) {
+    vectors.emplace_back(makeRowVector(
+        {makeFlatVector<int32_t>(
+             100, [i](auto row) { return -71 + i * 10 + row; }),
+         makeFlatVector<std::string>(
+             100,
+             [](auto row) { return std::string(row % 20, 'x'); },
+             nullEvery(7))}));
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .localPartition({"c0"})
+                  .partialAggregation({"c0"}, {"max(c1)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kLocalPartitionFlatOutput, "true")
+      .maxDrivers(3)
+      .assertResults("SELECT c0, max(c1) FROM tmp GROUP BY 1");
+
+  // The consumers get flat slices of the reordered input.
+  CursorParameters params;
+  params.planNode =
+      PlanBuilder().values(vectors).localPartition({"c0"}).planNode();
+  params.queryConfigs[core::QueryConfig::kLocalPartitionFlatOutput] = "true";
+  params.maxDrivers = 2;
+  auto cursor = TaskCursor::create(params);
+  int numRows = 0;
+  while (cursor->moveNext()) {
+    auto* batch = cursor->current()->as<RowVector>();
+    ASSERT_EQ(batch->childrenSize(), 2);
+    ASSERT_EQ(batch->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+    ASSERT_EQ(batch->childAt(1)->encoding(), VectorEncoding::Simple::FLAT);
+    numRows += batch->size();
+  }
+  ASSERT_EQ(numRows, 2100);
+}
+
 TEST_F(LocalPartitionTest, blockingOnLocalExchangeQueue) {
   auto localExchangeBufferSize = "1024";
   auto baseVector = vectorMaker_.flatVector<int64_t>(
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -141,3 +143,56 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 8; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 37; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row + i * 1'000) % 501; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  struct {
+    uint32_t spillPartitionBits;
+
+    std::string debugString() const {
+      return fmt::format("SpillPartitionBits {}", spillPartitionBits);
+    }
+  } testSettings[] = {{2}, {3}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    const auto spillDirectory = exec::test::TempDirectoryPath::create();
+    exec::TestScopedSpillInjection scopedSpillInjection(100);
+
+    core::PlanNodeId markDistinctNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kMarkDistinctSpillEnabled, true)
+            .config(core::QueryConfig::kAggregationSpillEnabled, false)
+            .config(
+                core::QueryConfig::kSpillNumPartitionBits,
+                testData.spillPartitionBits)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .markDistinct("c1_distinct", {"c0", "c1"})
+                      .capturePlanNodeId(markDistinctNodeId)
+                      .singleAggregation(
+                          {"c0"}, {"sum(c1)", "count(c1)"}, {"c1_distinct"})
+                      .planNode())
+            .assertResults(
+                "SELECT c0, sum(distinct c1), count(distinct c1) FROM tmp "
+                "GROUP BY 1");
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& planStats = taskStats.at(markDistinctNodeId);
+    ASSERT_GT(planStats.spilledBytes, 0);
+    ASSERT_GT(planStats.spilledRows, 0);
+    ASSERT_GT(planStats.spilledFiles, 0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
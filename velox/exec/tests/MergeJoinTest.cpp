@@ -218,6 +218,37 @@ class MergeJoinTest : public HiveConnectorTestBase {
     // Test right join and left join with same result.
     auto expectedResult = AssertQueryBuilder(leftPlan).copyResults(pool_.get());
     AssertQueryBuilder(rightPlan).assertResults(expectedResult);
+
+    // Test FULL join.
+    planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto fullPlan = PlanBuilder(planNodeIdGenerator)
+                        .values(left)
+                        .mergeJoin(
+                            {"c0"},
+                            {"u_c0"},
+                            PlanBuilder(planNodeIdGenerator)
+                                .values(right)
+                                .project({"c1 as u_c1", "c0 as u_c0"})
+                                .planNode(),
+                            "",
+                            {"c0", "c1", "u_c1"},
+                            core::JoinType::kFull)
+                        .planNode();
+
+    // Use very small output batch size.
+    assertQuery(
+        makeCursorParameters(fullPlan, 16),
+        "SELECT t.c0, t.c1, u.c1 FROM t FULL OUTER JOIN u ON t.c0 = u.c0");
+
+    // Use regular output batch size.
+    assertQuery(
+        makeCursorParameters(fullPlan, 1024),
+        "SELECT t.c0, t.c1, u.c1 FROM t FULL OUTER JOIN u ON t.c0 = u.c0");
+
+    // Use very large output batch size.
+    assertQuery(
+        makeCursorParameters(fullPlan, 10'000),
+        "SELECT t.c0, t.c1, u.c1 FROM t FULL OUTER JOIN u ON t.c0 = u.c0");
   }
 };
 
@@ -241,6 +272,20 @@ TEST_F(MergeJoinTest, duplicateMatch) {
       [](auto row) { return row / 2; }, [](auto row) { return row / 3; });
 }
 
+TEST_F(MergeJoinTest, sparseMatch) {
+  // Long runs of non-matching rows on the left are skipped by galloping
+  // search.
+  testJoin<int64_t>(
+      [](auto row) { return row; }, [](auto row) { return row * 113; });
+  testJoin<int64_t>(
+      [](auto row) { return row * 113; }, [](auto row) { return row; });
+}
+
+TEST_F(MergeJoinTest, longDuplicateRuns) {
+  testJoin<int32_t>(
+      [](auto row) { return row / 100; }, [](auto row) { return row / 37; });
+}
+
 TEST_F(MergeJoinTest, allRowsMatch) {
   std::vector<VectorPtr> leftKeys = {
       makeFlatVector<int32_t>(2, [](auto /* row */) { return 5; }),
@@ -735,6 +780,90 @@ TEST_F(MergeJoinTest, nullKeys) {
              .planNode();
   AssertQueryBuilder(plan, duckDbQueryRunner_)
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
+
+  // Full join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kFull)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t FULL OUTER JOIN u ON t.t0 = u.u0");
+}
+
+TEST_F(MergeJoinTest, fullJoin) {
+  auto left = makeRowVector(
+      {"t0", "t1"},
+      {makeNullableFlatVector<int64_t>(
+           {std::nullopt, 1, 2, 2, 4, 7, 7, 9, 10}),
+       makeFlatVector<int32_t>({10, 11, 12, 13, 14, 15, 16, 17, 18})});
+
+  auto right = makeRowVector(
+      {"u0", "u1"},
+      {makeNullableFlatVector<int64_t>(
+           {std::nullopt, std::nullopt, 2, 3, 7, 7, 8, 11}),
+       makeFlatVector<int32_t>({20, 21, 22, 23, 24, 25, 26, 27})});
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({left})
+          .mergeJoin(
+              {"t0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+              "",
+              {"t0", "t1", "u0", "u1"},
+              core::JoinType::kFull)
+          .planNode();
+
+  for (auto batchSize : {1, 3, 1'024}) {
+    assertQuery(
+        makeCursorParameters(plan, batchSize),
+        "SELECT * FROM t FULL OUTER JOIN u ON t.t0 = u.u0");
+  }
+
+  // One side is empty.
+  auto emptyRight = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>({}), makeFlatVector<int32_t>({})});
+  createDuckDbTable("u", {emptyRight});
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator)
+                     .values({emptyRight})
+                     .planNode(),
+                 "",
+                 {"t0", "t1", "u0", "u1"},
+                 core::JoinType::kFull)
+             .planNode();
+  assertQuery(plan, "SELECT * FROM t FULL OUTER JOIN u ON t.t0 = u.u0");
+
+  // Filters are not supported yet.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "t1 > u1",
+                 {"t0", "t1", "u0", "u1"},
+                 core::JoinType::kFull)
+             .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool_.get()),
+      "Full outer merge join with a filter is not supported yet");
 }
 
 TEST_F(MergeJoinTest, antiJoinWithFilter) {
@@ -182,3 +182,38 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+TEST_F(MergeTest, readAhead) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            100, [&](auto row) { return row * 4 + i; }, nullEvery(7)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto readAheadBatches : {0, 1, 4}) {
+    SCOPED_TRACE(fmt::format("readAheadBatches: {}", readAheadBatches));
+    // Each source produces its input in batches of 10 rows.
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<std::shared_ptr<const core::PlanNode>> sources;
+    for (const auto& input : vectors) {
+      sources.push_back(PlanBuilder(planNodeIdGenerator)
+                            .values(split(input, 10))
+                            .orderBy({"c0"}, true)
+                            .planNode());
+    }
+    CursorParameters params;
+    params.planNode = PlanBuilder(planNodeIdGenerator)
+                          .localMerge({"c0"}, std::move(sources))
+                          .planNode();
+    params.queryCtx = core::QueryCtx::create(executor_.get());
+    params.queryCtx->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kPreferredOutputBatchRows, "10"},
+        {core::QueryConfig::kMergeSourceReadAheadBatches,
+         std::to_string(readAheadBatches)},
+    });
+    assertQueryOrdered(params, "SELECT * FROM tmp ORDER BY c0", {0});
+  }
+}
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/ScopeGuard.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
@@ -441,6 +442,46 @@ TEST_F(MultiFragmentTest, mergeExchange) {
   EXPECT_LT(0, mergeExchangeStats.rawInputBytes);
 }
 
+TEST_F(MultiFragmentTest, mergeExchangeParallelDecode) {
+  configSettings_[core::QueryConfig::kMergeExchangeParallelDecode] = "true";
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<Task>> tasks;
+  std::vector<std::string> leafTaskIds;
+  for (int i = 0; i < 3; ++i) {
+    auto data = makeVectors(10, 1'000);
+    vectors.insert(vectors.end(), data.begin(), data.end());
+    auto taskId = makeTaskId("leaf-", i);
+    leafTaskIds.push_back(taskId);
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .orderBy({"c0"}, false)
+                    .partitionedOutput({}, 1)
+                    .planNode();
+    auto task = makeTask(taskId, plan, tasks.size());
+    tasks.push_back(task);
+    task->start(1);
+  }
+  createDuckDbTable(vectors);
+
+  auto mergeTaskId = makeTaskId("merge-", 0);
+  auto mergePlan = PlanBuilder()
+                       .mergeExchange(rowType_, {"c0"})
+                       .partitionedOutput({}, 1)
+                       .planNode();
+  auto mergeTask = makeTask(mergeTaskId, mergePlan, 0);
+  tasks.push_back(mergeTask);
+  mergeTask->start(1);
+  addRemoteSplits(mergeTask, leafTaskIds);
+
+  auto plan = PlanBuilder().exchange(rowType_).planNode();
+  assertQueryOrdered(
+      plan, {mergeTaskId}, "SELECT * FROM tmp ORDER BY 1 NULLS LAST", {0});
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+}
+
 // Test reordering and dropping columns in PartitionedOutput operator.
 TEST_F(MultiFragmentTest, partitionedOutput) {
   setupSources(10, 1000);
@@ -2092,5 +2133,132 @@ TEST_F(MultiFragmentTest, compression) {
   test("local://t2", 0.0000001, true);
 }
 
+TEST_F(MultiFragmentTest, adaptiveCompression) {
+  bufferManager_->testingSetCompression(
+      common::CompressionKind::CompressionKind_LZ4);
+  auto guard = folly::makeGuard([&]() {
+    bufferManager_->testingSetCompression(
+        common::CompressionKind::CompressionKind_NONE);
+  });
+  configSettings_[core::QueryConfig::kShuffleAdaptiveCompression] = "true";
+
+  constexpr int32_t kNumRepeats = 1'000'000;
+  const auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+
+  const auto producerPlan = test::PlanBuilder()
+                                .values({data}, false, kNumRepeats)
+                                .partitionedOutput({}, 1)
+                                .planNode();
+
+  const auto plan = test::PlanBuilder()
+                        .exchange(asRowType(data->type()))
+                        .singleAggregation({}, {"sum(c0)"})
+                        .planNode();
+
+  const auto expected =
+      makeRowVector({makeFlatVector<int64_t>(std::vector<int64_t>{6000000})});
+
+  const auto test = [&](const std::string& producerTaskId,
+                        const std::string& maxOutputBufferSize,
+                        bool expectCompression) {
+    configSettings_[core::QueryConfig::kMaxOutputBufferSize] =
+        maxOutputBufferSize;
+    auto producerTask = makeTask(producerTaskId, producerPlan);
+    producerTask->start(1);
+    if (expectCompression) {
+      // Lets the producer fill its output buffer and block before the
+      // consumer starts.
+      while (bufferManager_->getUtilization(producerTaskId) < 1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    test::AssertQueryBuilder(plan)
+        .split(remoteSplit(producerTaskId))
+        .destination(0)
+        .assertResults(expected);
+
+    auto producerTaskStats = exec::toPlanStats(producerTask->taskStats());
+    const auto& producerStats = producerTaskStats.at("1");
+    if (expectCompression) {
+      EXPECT_LT(0, producerStats.customStats.at("compressionInputBytes").sum);
+    } else {
+      EXPECT_EQ(0, producerStats.customStats.at("compressionInputBytes").sum);
+      EXPECT_LT(0, producerStats.customStats.at("compressionSkippedBytes").sum);
+    }
+  };
+
+  // The output buffer never fills up, so no page is compressed.
+  test("local://t1", std::to_string(1UL << 30), false);
+  // The full output buffer turns compression on.
+  test("local://t2", std::to_string(1UL << 20), true);
+}
+
+// Counts the pages serialized and deserialized through it.
+class CountingVectorSerde : public serializer::presto::PrestoVectorSerde {
+ public:
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override {
+    ++numSerializers;
+    return PrestoVectorSerde::createIterativeSerializer(
+        type, numRows, streamArena, options);
+  }
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override {
+    ++numDeserialized;
+    PrestoVectorSerde::deserialize(source, pool, type, result, options);
+  }
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      vector_size_t resultOffset,
+      const Options* options) override {
+    ++numDeserialized;
+    PrestoVectorSerde::deserialize(
+        source, pool, type, result, resultOffset, options);
+  }
+
+  std::atomic_int32_t numSerializers{0};
+  std::atomic_int32_t numDeserialized{0};
+};
+
+TEST_F(MultiFragmentTest, shuffleSerde) {
+  const std::string kSerdeName = "counting";
+  auto serde = std::make_unique<CountingVectorSerde>();
+  auto* counting = serde.get();
+  registerNamedVectorSerde(kSerdeName, std::move(serde));
+  SCOPE_EXIT {
+    deregisterNamedVectorSerde(kSerdeName);
+  };
+  setupSources(5, 1'000);
+
+  configSettings_[core::QueryConfig::kShuffleSerde] = kSerdeName;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan =
+      PlanBuilder().values(vectors_).partitionedOutput({}, 1).planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  leafTask->start(1);
+
+  auto op = PlanBuilder().exchange(leafPlan->outputType()).planNode();
+  AssertQueryBuilder(op, duckDbQueryRunner_)
+      .split(remoteSplit(leafTaskId))
+      .config(core::QueryConfig::kShuffleSerde, kSerdeName)
+      .assertResults("SELECT * FROM tmp");
+  ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+  ASSERT_GT(counting->numSerializers, 0);
+  ASSERT_GT(counting->numDeserialized, 0);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -488,3 +489,96 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, dictionaryStrings) {
+  auto makeString = [](auto row) {
+    return fmt::format("a string that is not inlined {}", row % 7);
+  };
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {makeFlatVector<int32_t>(50, [](auto row) { return row; }),
+         makeFlatVector<std::string>(50, makeString)}));
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int32_t>(100, [](auto row) { return row; }),
+         makeFlatVector<std::string>(100, makeString, nullEvery(11))}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .nestedLoopJoin(
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "t1 = u1",
+                      {"t0", "u0", "u1"},
+                      core::JoinType::kInner)
+                  .planNode();
+  // Each build vector has 7 distinct strings and a null in 100 rows.
+  for (const auto pct : {0, 5, 10}) {
+    SCOPED_TRACE(fmt::format("pct: {}", pct));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kNestedLoopJoinBuildDictionaryStringsPct, pct)
+        .assertResults("SELECT t0, u0, u1 FROM t, u WHERE t1 = u1");
+  }
+}
+
+TEST_F(NestedLoopJoinTest, spill) {
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {probeKeyName_}, {sequence<int32_t>(100, i * 100)}));
+    buildVectors.push_back(makeRowVector(
+        {buildKeyName_}, {sequence<int32_t>(100, i * 150)}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : joinTypes_) {
+    for (const auto& joinCondition : {std::string("t0 < u0"), std::string()}) {
+      SCOPED_TRACE(fmt::format(
+          "joinType:{} joinCondition:{}",
+          joinTypeName(joinType),
+          joinCondition));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      core::PlanNodeId joinNodeId;
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(probeVectors)
+                      .localPartition({probeKeyName_})
+                      .nestedLoopJoin(
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(buildVectors)
+                              .localPartition({buildKeyName_})
+                              .planNode(),
+                          joinCondition,
+                          outputLayout_,
+                          joinType)
+                      .capturePlanNodeId(joinNodeId)
+                      .planNode();
+
+      const auto spillDirectory = TempDirectoryPath::create();
+      TestScopedSpillInjection scopedSpillInjection(100);
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .maxDrivers(4)
+              .spillDirectory(spillDirectory->getPath())
+              .config(core::QueryConfig::kSpillEnabled, true)
+              .config(core::QueryConfig::kJoinSpillEnabled, true)
+              .assertResults(fmt::format(
+                  "SELECT t0, u0 FROM t {} JOIN u ON {}",
+                  joinTypeName(joinType),
+                  joinCondition.empty() ? "true" : "t.t0 < u.u0"));
+      auto planStats = toPlanStats(task->taskStats());
+      ASSERT_GT(planStats.at(joinNodeId).spilledBytes, 0);
+      ASSERT_GT(planStats.at(joinNodeId).spilledFiles, 0);
+    }
+  }
+}
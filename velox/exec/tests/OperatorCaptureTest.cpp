@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/OperatorCapture.h"
+#include "velox/common/base/Fs.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class OperatorCaptureTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    Type::registerSerDe();
+    common::Filter::registerSerDe();
+    core::ITypedExpr::registerSerDe();
+    core::PlanNode::registerSerDe();
+    registerPartitionFunctionSerDe();
+  }
+
+  // Runs 'plan' capturing the input of 'nodeId' into 'directory' and returns
+  // the directory of the captured plan node.
+  std::string capture(
+      const core::PlanNodePtr& plan,
+      const core::PlanNodeId& nodeId,
+      const std::string& directory,
+      int32_t maxBatches = 100) {
+    AssertQueryBuilder(plan)
+        .config(core::QueryConfig::kOperatorCaptureNodeId, nodeId)
+        .config(core::QueryConfig::kOperatorCaptureDir, directory)
+        .config(core::QueryConfig::kOperatorCaptureMaxBatches, maxBatches)
+        .copyResults(pool());
+    std::vector<std::string> taskDirectories;
+    for (const auto& entry : fs::directory_iterator(directory)) {
+      taskDirectories.push_back(entry.path().string());
+    }
+    EXPECT_EQ(1, taskDirectories.size());
+    return fmt::format("{}/{}", taskDirectories[0], nodeId);
+  }
+
+  static int32_t countBatches(const std::string& directory) {
+    int32_t count = 0;
+    for (const auto& entry : fs::directory_iterator(directory)) {
+      count += entry.path().extension() == ".vector";
+    }
+    return count;
+  }
+};
+
+TEST_F(OperatorCaptureTest, aggregation) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 5; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row % 7; }),
+        makeFlatVector<int64_t>(100, [i](auto row) { return row + i; }),
+    }));
+  }
+  core::PlanNodeId aggregationId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .filter("c1 % 2 = 0")
+                  .singleAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                  .capturePlanNodeId(aggregationId)
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  auto directory = TempDirectoryPath::create();
+  auto nodeDirectory = capture(plan, aggregationId, directory->getPath());
+  EXPECT_EQ(5, countBatches(nodeDirectory));
+
+  auto replay = OperatorCapture::replayPlan(nodeDirectory, pool());
+  ASSERT_EQ(aggregationId, replay->id());
+  ASSERT_EQ(1, replay->sources().size());
+  ASSERT_NE(
+      nullptr,
+      dynamic_cast<const core::ValuesNode*>(replay->sources()[0].get()));
+  AssertQueryBuilder(replay).assertResults(expected);
+}
+
+TEST_F(OperatorCaptureTest, hashJoin) {
+  auto probe = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 50; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(20, [](auto row) { return row * 3; }),
+          makeFlatVector<int64_t>(20, [](auto row) { return -row; }),
+      });
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe, probe})
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build})
+                          .planNode(),
+                      "",
+                      {"c0", "c1", "u1"})
+                  .capturePlanNodeId(joinId)
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  auto directory = TempDirectoryPath::create();
+  auto nodeDirectory = capture(plan, joinId, directory->getPath());
+  // Two probe batches and one build batch.
+  EXPECT_EQ(3, countBatches(nodeDirectory));
+
+  auto replay = OperatorCapture::replayPlan(nodeDirectory, pool());
+  ASSERT_EQ(2, replay->sources().size());
+  AssertQueryBuilder(replay).assertResults(expected);
+}
+
+TEST_F(OperatorCaptureTest, maxBatches) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    data.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(10, [i](auto row) { return row + i; })}));
+  }
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .project({"c0 * 2 AS p0"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  auto directory = TempDirectoryPath::create();
+  auto nodeDirectory = capture(plan, projectId, directory->getPath(), 3);
+  EXPECT_EQ(3, countBatches(nodeDirectory));
+
+  auto replay = OperatorCapture::replayPlan(nodeDirectory, pool());
+  auto expected = AssertQueryBuilder(
+                      PlanBuilder()
+                          .values({data[0], data[1], data[2]})
+                          .project({"c0 * 2 AS p0"})
+                          .planNode())
+                      .copyResults(pool());
+  AssertQueryBuilder(replay).assertResults(expected);
+}
+
+TEST_F(OperatorCaptureTest, missingDirectory) {
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values({makeRowVector({makeFlatVector<int64_t>({1, 2})})})
+                  .project({"c0 + 1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kOperatorCaptureNodeId, projectId)
+          .copyResults(pool()),
+      "operator_capture_dir must be set to capture operator input");
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -16,6 +16,7 @@
 #include <re2/re2.h>
 
 #include <fmt/format.h>
+#include <folly/String.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
@@ -525,6 +526,68 @@ TEST_F(OrderByTest, spill) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(OrderByTest, rangePartitionAcrossDrivers) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000,
+            [&](auto row) { return (row * 7 + i * 13) % 1'009; },
+            nullEvery(17)),
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 11; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  struct {
+    std::vector<std::string> sortingKeys;
+    std::vector<uint32_t> sortingChannels;
+
+    std::string debugString() const {
+      return folly::join(", ", sortingKeys);
+    }
+  } testSettings[] = {
+      {{"c0 NULLS LAST"}, {0}},
+      {{"c0 DESC NULLS FIRST"}, {0}},
+      {{"c1", "c0 DESC NULLS LAST"}, {1, 0}}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId orderById;
+    CursorParameters params;
+    params.planNode = PlanBuilder(planNodeIdGenerator)
+                          .localMerge(
+                              testData.sortingKeys,
+                              {PlanBuilder(planNodeIdGenerator)
+                                   .values(vectors, true)
+                                   .orderBy(testData.sortingKeys, true)
+                                   .capturePlanNodeId(orderById)
+                                   .planNode()})
+                          .planNode();
+    params.maxDrivers = 4;
+    params.queryConfigs
+        [core::QueryConfig::kOrderByRangePartitionAcrossDrivers] = "true";
+    auto task = assertQueryOrdered(
+        params,
+        fmt::format(
+            "SELECT * FROM (SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+            "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp) "
+            "ORDER BY {}",
+            testData.debugString()),
+        testData.sortingChannels);
+
+    // Each of the 4 drivers merges one range from the sort buffers of all the
+    // drivers.
+    auto planStats = toPlanStats(task->taskStats()).at(orderById);
+    const auto& rangeStats =
+        planStats.customStats.at("rangePartitionedAcrossDrivers");
+    ASSERT_EQ(rangeStats.count, 4);
+    ASSERT_EQ(rangeStats.sum, 16);
+    ASSERT_EQ(planStats.outputRows, 4 * 5 * 1'000);
+  }
+}
+
 DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
@@ -17,9 +17,11 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -38,6 +40,7 @@ class OutputBufferManagerTest : public testing::Test {
 
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
+    filesystems::registerLocalFileSystem();
   }
 
   void SetUp() override {
@@ -809,6 +812,88 @@ TEST_F(OutputBufferManagerTest, basicPartitioned) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, spill) {
+  const std::string taskId = "t0";
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const auto spillDirectory = tempDirectory->getPath() + "/spill";
+  bufferManager_->removeTask(taskId);
+  auto planFragment = exec::test::PlanBuilder()
+                          .values({std::dynamic_pointer_cast<RowVector>(
+                              BatchMaker::createBatch(rowType_, 100, *pool_))})
+                          .planFragment();
+  // Every page makes the buffer full.
+  std::unordered_map<std::string, std::string> configSettings{
+      {core::QueryConfig::kMaxOutputBufferSize, "1"},
+      {core::QueryConfig::kOutputBufferSpillEnabled, "true"}};
+  auto task = Task::create(
+      taskId,
+      std::move(planFragment),
+      0,
+      core::QueryCtx::create(
+          executor_.get(), core::QueryConfig(std::move(configSettings))),
+      Task::ExecutionMode::kParallel);
+  task->setSpillDirectory(spillDirectory);
+  bufferManager_->initializeTask(
+      task, PartitionedOutputNode::Kind::kPartitioned, 2, 1);
+
+  // The producer is not blocked. The pages of both destinations are spilled.
+  std::vector<std::string> expectedPages;
+  for (auto i = 0; i < 4; ++i) {
+    auto page = makeSerializedPage(rowType_, 100);
+    expectedPages.push_back(page->getIOBuf()->moveToFbString().toStdString());
+    ContinueFuture future;
+    ASSERT_FALSE(
+        bufferManager_->enqueue(taskId, i / 3, std::move(page), &future));
+  }
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+  ASSERT_EQ(stats.buffersStats[0].pagesSpilled, 3);
+  ASSERT_EQ(stats.buffersStats[0].pagesBuffered, 3);
+  ASSERT_EQ(stats.buffersStats[1].pagesSpilled, 1);
+  noMoreData(taskId);
+
+  // Reads back the spilled pages in order as they are fetched.
+  const auto fetchPages = [&](int destination,
+                              int64_t sequence,
+                              uint64_t maxBytes) {
+    std::vector<std::unique_ptr<folly::IOBuf>> result;
+    EXPECT_TRUE(bufferManager_->getData(
+        taskId,
+        destination,
+        maxBytes,
+        sequence,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t /*sequence*/,
+            std::vector<int64_t> /*remainingBytes*/) {
+          result = std::move(pages);
+        }));
+    return result;
+  };
+  auto pages = fetchPages(0, 0, 1);
+  ASSERT_EQ(pages.size(), 1);
+  ASSERT_EQ(pages[0]->moveToFbString().toStdString(), expectedPages[0]);
+  ASSERT_GT(getStats(taskId).bufferedBytes, 0);
+
+  pages = fetchPages(0, 1, std::numeric_limits<uint64_t>::max());
+  ASSERT_EQ(pages.size(), 3);
+  ASSERT_EQ(pages[0]->moveToFbString().toStdString(), expectedPages[1]);
+  ASSERT_EQ(pages[1]->moveToFbString().toStdString(), expectedPages[2]);
+  ASSERT_EQ(pages[2], nullptr);
+  deleteResults(taskId, 0);
+
+  pages = fetchPages(1, 0, std::numeric_limits<uint64_t>::max());
+  ASSERT_EQ(pages.size(), 2);
+  ASSERT_EQ(pages[0]->moveToFbString().toStdString(), expectedPages[3]);
+  ASSERT_EQ(pages[1], nullptr);
+  deleteResults(taskId, 1);
+
+  // The spill files are removed with the destinations.
+  auto fileSystem = filesystems::getFileSystem(spillDirectory, nullptr);
+  ASSERT_TRUE(fileSystem->list(spillDirectory).empty());
+  bufferManager_->removeTask(taskId);
+  ASSERT_TRUE(task->isFinished());
+}
+
 TEST_F(OutputBufferManagerTest, basicBroadcast) {
   vector_size_t size = 100;
 
@@ -880,6 +965,50 @@ TEST_F(OutputBufferManagerTest, basicBroadcast) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, broadcastSharedPages) {
+  const std::string taskId = "t0";
+  auto task = initializeTask(
+      taskId, rowType_, PartitionedOutputNode::Kind::kBroadcast, 3, 1);
+  bufferManager_->updateOutputBuffers(taskId, 3, true);
+
+  uint64_t totalBytes = 0;
+  for (auto i = 0; i < 2; ++i) {
+    totalBytes += enqueue(taskId, 0, rowType_, 100);
+  }
+  // The pages are buffered once for all destinations.
+  auto stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedPages, 2);
+  ASSERT_EQ(stats.bufferedBytes, totalBytes);
+  for (const auto& bufferStats : stats.buffersStats) {
+    ASSERT_EQ(bufferStats.pagesBuffered, 2);
+  }
+
+  // The pages are freed when the slowest destination acknowledges them.
+  for (auto destination = 0; destination < 2; ++destination) {
+    fetch(taskId, destination, 0, 1'000'000'000, 2);
+    acknowledge(taskId, destination, 2);
+  }
+  stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedPages, 2);
+  ASSERT_EQ(stats.buffersStats[0].pagesSent, 2);
+  ASSERT_EQ(stats.buffersStats[2].pagesSent, 0);
+
+  fetchOneAndAck(taskId, 2, 0);
+  ASSERT_EQ(getStats(taskId).bufferedPages, 1);
+  fetchOneAndAck(taskId, 2, 1);
+  stats = getStats(taskId);
+  ASSERT_EQ(stats.bufferedPages, 0);
+  ASSERT_EQ(stats.bufferedBytes, 0);
+
+  noMoreData(taskId);
+  for (auto destination = 0; destination < 3; ++destination) {
+    fetchEndMarker(taskId, destination, 2);
+  }
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+  EXPECT_TRUE(task->isFinished());
+}
+
 TEST_F(OutputBufferManagerTest, basicArbitrary) {
   const vector_size_t size = 100;
   int numDestinations = 5;
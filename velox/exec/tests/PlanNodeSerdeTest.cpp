@@ -530,6 +530,14 @@ TEST_F(PlanNodeSerdeTest, topNRowNumber) {
              .topNRowNumber({"c0"}, {"c1", "c2"}, 10, false)
              .planNode();
   testSerde(plan);
+
+  for (const auto& function : {"rank", "dense_rank"}) {
+    plan = PlanBuilder()
+               .values({data_})
+               .topNRank(function, {"c0"}, {"c1", "c2"}, 10, true)
+               .planNode();
+    testSerde(plan);
+  }
 }
 
 TEST_F(PlanNodeSerdeTest, write) {
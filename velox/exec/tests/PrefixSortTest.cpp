@@ -217,6 +217,36 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefix) {
+  // Strings that tie on the 16 bytes prefix, are a prefix of each other or
+  // differ only by trailing zero bytes.
+  const auto strings = makeNullableFlatVector<std::string>(
+      {"http://www.example.com/b",
+       "http://www.example.com/a",
+       std::nullopt,
+       "http://www.example.com/",
+       "http://www.examp",
+       "http://www.exam",
+       std::string("http://www.exam\0", 16),
+       std::string("ab\0", 3),
+       "ab",
+       "",
+       "http://www.example.com/a",
+       "Customer#000000002",
+       "Customer#000000001",
+       "Customer#00000000"});
+  const auto numbers = makeNullableFlatVector<int64_t>(
+      {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 1, 12, 13, std::nullopt});
+
+  testPrefixSort({kAsc}, makeRowVector({strings}));
+  testPrefixSort({kDesc}, makeRowVector({strings}));
+  // The keys after a string key are compared with the RowContainer when the
+  // string prefixes tie.
+  testPrefixSort({kAsc, kDesc}, makeRowVector({strings, numbers}));
+  testPrefixSort({kDesc, kAsc}, makeRowVector({strings, numbers}));
+  testPrefixSort({kAsc, kAsc}, makeRowVector({numbers, strings}));
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -195,6 +195,7 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          numLocalRead        [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          numPrefetch         [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          numRamRead          [ ]* sum: 60, count: 1, min: 60, max: 60"},
+       {"          numRemoteCacheRead  [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          numStorageRead      [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          overreadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          prefetchBytes       [ ]* sum: .+, count: 1, min: .+, max: .+"},
@@ -203,6 +204,7 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          ramReadBytes        [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          readyPreloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
         true},
+       {"          remoteCacheReadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -278,6 +280,7 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"      runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"      variableWidthFragmentationPct\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"  -- TableScan\\[0\\]\\[table: hive_table\\] -> c0:BIGINT, c1:INTEGER, c2:SMALLINT, c3:REAL, c4:DOUBLE, c5:VARCHAR"},
          {"     Input: 10000 rows \\(.+\\), Output: 10000 rows \\(.+\\), Cpu time: .+, Blocked wall time: .+, Peak memory: .+, Memory allocations: .+, Threads: 1, Splits: 1"},
          {"        dataSourceAddSplitWallNanos[ ]* sum: .+, count: 1, min: .+, max: .+"},
@@ -289,6 +292,7 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        numLocalRead     [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        numPrefetch      [ ]* sum: .+, count: .+, min: .+, max: .+"},
          {"        numRamRead       [ ]* sum: 7, count: 1, min: 7, max: 7"},
+         {"        numRemoteCacheRead[ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        numStorageRead   [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        overreadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
 
@@ -298,6 +302,7 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        ramReadBytes     [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        readyPreloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
           true},
+         {"        remoteCacheReadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
          {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -309,3 +314,34 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        totalScanTime    [ ]* sum: .+, count: .+, min: .+, max: .+"}});
   }
 }
+
+TEST_F(PrintPlanWithStatsTest, memoryTimeline) {
+  RowTypePtr rowType{ROW({"c0", "c1"}, {BIGINT(), VARCHAR()})};
+  auto vectors = makeVectors(rowType, 10, 1'000);
+
+  core::PlanNodeId aggregationId;
+  auto op = PlanBuilder()
+                .values(vectors)
+                .singleAggregation({"c1"}, {"sum(c0)"})
+                .capturePlanNodeId(aggregationId)
+                .planNode();
+
+  // Sampling is off by default.
+  std::shared_ptr<exec::Task> task;
+  AssertQueryBuilder(op).copyResults(pool(), task);
+  ensureTaskCompletion(task.get());
+  ASSERT_TRUE(exec::printMemoryTimeline(task->taskStats()).empty());
+
+  AssertQueryBuilder(op)
+      .config(core::QueryConfig::kMemoryTimelineSampleIntervalMs, "1")
+      .config(core::QueryConfig::kMemoryTimelineMaxSamples, "2")
+      .copyResults(pool(), task);
+  ensureTaskCompletion(task.get());
+  auto planStats = exec::toPlanStats(task->taskStats());
+  const auto& timeline = planStats.at(aggregationId).memoryTimeline;
+  ASSERT_FALSE(timeline.empty());
+  ASSERT_LE(timeline.size(), 2);
+  const auto output = exec::printMemoryTimeline(task->taskStats());
+  ASSERT_NE(output.find(aggregationId), std::string::npos) << output;
+  ASSERT_NE(output.find("Aggregation"), std::string::npos) << output;
+}
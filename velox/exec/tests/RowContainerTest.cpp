@@ -1860,6 +1860,149 @@ TEST_F(RowContainerTest, extractSerializedRow) {
   }
 }
 
+TEST_F(RowContainerTest, compactVariableWidthData) {
+  constexpr vector_size_t kNumRows = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return std::string(100 + row % 50, 'a' + row % 26); },
+          nullEvery(7)),
+      makeArrayVector<int64_t>(
+          kNumRows,
+          [](auto row) { return row % 5; },
+          [](auto row) { return row; }),
+  });
+  RowContainer rowContainer{asRowType(data->type())->children(), pool()};
+  auto rows = store(rowContainer, data);
+
+  // Erases 3 out of 4 rows.
+  std::vector<char*> erasedRows;
+  std::vector<char*> keptRows;
+  for (auto i = 0; i < kNumRows; ++i) {
+    (i % 4 == 0 ? keptRows : erasedRows).push_back(rows[i]);
+  }
+  rowContainer.eraseRows(folly::Range(erasedRows.data(), erasedRows.size()));
+  ASSERT_GE(rowContainer.variableWidthFragmentationPct(), 50);
+  const auto retainedSize = rowContainer.stringAllocator().retainedSize();
+
+  ASSERT_GT(rowContainer.compactVariableWidthData(), 0);
+  ASSERT_LT(rowContainer.stringAllocator().retainedSize(), retainedSize);
+  ASSERT_LT(rowContainer.variableWidthFragmentationPct(), 50);
+  rowContainer.stringAllocator().checkConsistency();
+
+  auto copy =
+      BaseVector::create<RowVector>(data->type(), keptRows.size(), pool());
+  for (auto i = 0; i < copy->childrenSize(); ++i) {
+    rowContainer.extractColumn(
+        keptRows.data(), keptRows.size(), i, copy->childAt(i));
+  }
+  auto expected = BaseVector::wrapInDictionary(
+      nullptr,
+      makeIndices(keptRows.size(), [](auto row) { return row * 4; }),
+      keptRows.size(),
+      data);
+  assertEqualVectors(expected, copy);
+}
+
+TEST_F(RowContainerTest, columnarDependents) {
+  constexpr vector_size_t kNumRows = 3 * RowContainer::kColumnarChunkRows + 7;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(
+          kNumRows, [](auto row) { return row * 3; }, nullEvery(5)),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return std::string(20 + row % 10, 'a' + row % 26); },
+          nullEvery(7)),
+      makeFlatVector<bool>(
+          kNumRows, [](auto row) { return row % 3 == 0; }, nullEvery(11)),
+      makeFlatVector<Timestamp>(
+          kNumRows,
+          [](auto row) { return Timestamp(row, row * 1'000); },
+          nullEvery(13)),
+      makeFlatVector<int128_t>(
+          kNumRows,
+          [](auto row) { return HugeInt::build(row, row * 7); },
+          nullEvery(17)),
+  });
+  const auto& types = asRowType(data->type())->children();
+  RowContainer rowContainer(
+      {types[0]},
+      true, // nullableKeys
+      std::vector<Accumulator>{},
+      {types.begin() + 1, types.end()},
+      true, // hasNext
+      true, // isJoinBuild
+      true, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool(),
+      nullptr, // stringAllocator
+      true); // columnarDependents
+
+  // The key and the varchar stay in the row.
+  EXPECT_FALSE(rowContainer.columnAt(0).isColumnar());
+  EXPECT_TRUE(rowContainer.columnAt(1).isColumnar());
+  EXPECT_FALSE(rowContainer.columnAt(2).isColumnar());
+  EXPECT_TRUE(rowContainer.columnAt(3).isColumnar());
+  EXPECT_TRUE(rowContainer.columnAt(4).isColumnar());
+  EXPECT_TRUE(rowContainer.columnAt(5).isColumnar());
+  EXPECT_EQ(
+      sizeof(int32_t) + sizeof(bool) + sizeof(Timestamp) + sizeof(int128_t),
+      rowContainer.columnarRowSize());
+
+  auto rows = store(rowContainer, data);
+  auto copy = BaseVector::create<RowVector>(data->type(), kNumRows, pool());
+  for (auto i = 0; i < copy->childrenSize(); ++i) {
+    rowContainer.extractColumn(rows.data(), kNumRows, i, copy->childAt(i));
+  }
+  assertEqualVectors(data, copy);
+
+  // Rows reused from the free list keep their columnar position.
+  std::vector<char*> erasedRows;
+  for (auto i = 0; i < kNumRows; i += 2) {
+    erasedRows.push_back(rows[i]);
+  }
+  rowContainer.eraseRows(folly::Range(erasedRows.data(), erasedRows.size()));
+  auto reversed = makeRowVector({
+      makeFlatVector<int64_t>(erasedRows.size(), [](auto row) { return -row; }),
+      makeFlatVector<int32_t>(
+          erasedRows.size(), [](auto row) { return -row; }, nullEvery(3)),
+      makeNullableFlatVector<std::string>(
+          std::vector<std::optional<std::string>>(erasedRows.size())),
+      makeFlatVector<bool>(erasedRows.size(), [](auto) { return true; }),
+      makeFlatVector<Timestamp>(
+          erasedRows.size(), [](auto row) { return Timestamp(0, row); }),
+      makeFlatVector<int128_t>(
+          erasedRows.size(), [](auto row) { return -row; }),
+  });
+  auto reusedRows = store(rowContainer, reversed);
+  EXPECT_EQ(kNumRows, rowContainer.numRows());
+  copy = BaseVector::create<RowVector>(data->type(), reusedRows.size(), pool());
+  for (auto i = 0; i < copy->childrenSize(); ++i) {
+    rowContainer.extractColumn(
+        reusedRows.data(), reusedRows.size(), i, copy->childAt(i));
+  }
+  assertEqualVectors(reversed, copy);
+
+  // The rows that were not erased keep their values.
+  std::vector<char*> keptRows;
+  for (auto i = 1; i < kNumRows; i += 2) {
+    keptRows.push_back(rows[i]);
+  }
+  copy = BaseVector::create<RowVector>(data->type(), keptRows.size(), pool());
+  for (auto i = 0; i < copy->childrenSize(); ++i) {
+    rowContainer.extractColumn(
+        keptRows.data(), keptRows.size(), i, copy->childAt(i));
+  }
+  auto expected = BaseVector::wrapInDictionary(
+      nullptr,
+      makeIndices(keptRows.size(), [](auto row) { return row * 2 + 1; }),
+      keptRows.size(),
+      data);
+  assertEqualVectors(expected, copy);
+}
+
 DEBUG_ONLY_TEST_F(RowContainerTest, eraseAfterOomStoringString) {
   auto rowContainer = makeRowContainer({VARCHAR()}, {});
 
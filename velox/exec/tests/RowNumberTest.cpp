@@ -190,6 +190,110 @@ TEST_F(RowNumberTest, largeInput) {
   testLimit(5'000);
 }
 
+TEST_F(RowNumberTest, arrayMode) {
+  // Keys whose range and distinct values grow from batch to batch, so that
+  // the value ids change while partitions are being counted.
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 5; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [i](auto row) { return (row % (10 << i)) * (i + 1); }),
+        makeFlatVector<bool>(1'000, [](auto row) { return row % 3 == 0; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [i](auto row) {
+              return fmt::format("a long string key {}", (row + i) % 13);
+            }),
+        makeFlatVector<int64_t>(
+            1'000, [](auto row) { return row % 7; }, nullEvery(11)),
+        makeFlatVector<int64_t>(1'000, [i](auto /*row*/) { return i; }),
+    }));
+  }
+  createDuckDbTable(data);
+
+  auto testKeys = [&](const std::vector<std::string>& keys) {
+    SCOPED_TRACE(folly::join(", ", keys));
+    const auto partitionBy = folly::join(", ", keys);
+    auto plan = PlanBuilder().values(data).rowNumber(keys).planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT *, row_number() over (partition by {}) FROM tmp",
+            partitionBy));
+
+    plan = PlanBuilder().values(data).rowNumber(keys, 3).planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, row_number() over (partition by {}) "
+            "as rn FROM tmp) WHERE rn <= 3",
+            partitionBy));
+  };
+
+  testKeys({"c0"});
+  testKeys({"c1", "c3"});
+  testKeys({"c2", "c0"});
+  testKeys({"c0", "c1", "c2", "c3"});
+}
+
+TEST_F(RowNumberTest, arrayModeBooleanAndNullKeys) {
+  // The keys of the first batch need no rehash: c0 is boolean, c1 is all
+  // null and c2 is a null constant. The later batches have non-null keys.
+  std::vector<RowVectorPtr> data;
+  data.push_back(makeRowVector({
+      makeFlatVector<bool>(1'000, [](auto row) { return row % 3 == 0; }),
+      makeFlatVector<int64_t>(
+          1'000, [](auto /*row*/) { return 0; }, nullEvery(1)),
+      makeNullConstant(TypeKind::BIGINT, 1'000),
+  }));
+  for (auto i = 0; i < 3; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<bool>(
+            1'000, [](auto row) { return row % 2 == 0; }, nullEvery(7)),
+        makeFlatVector<int64_t>(1'000, [i](auto row) { return row % 5 + i; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 11; }),
+    }));
+  }
+  createDuckDbTable(data);
+
+  for (const auto& key : {"c0", "c1", "c2"}) {
+    SCOPED_TRACE(key);
+    auto plan = PlanBuilder().values(data).rowNumber({key}).planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT *, row_number() over (partition by {}) FROM tmp", key));
+  }
+}
+
+TEST_F(RowNumberTest, arrayModeToHashTable) {
+  // The keys of the first batches fit into an array. The last batch has too
+  // many distinct keys over too wide a range, so the partitions move to a
+  // hash table.
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 3; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+        makeFlatVector<int64_t>(1'000, [i](auto /*row*/) { return i; }),
+    }));
+  }
+  data.push_back(makeRowVector({
+      makeFlatVector<int64_t>(
+          200'000, [](auto row) { return (row % 150'000) * 1'000'003; }),
+      makeFlatVector<int64_t>(200'000, [](auto /*row*/) { return 3; }),
+  }));
+  createDuckDbTable(data);
+
+  auto plan = PlanBuilder().values(data).rowNumber({"c0"}).planNode();
+  assertQuery(plan, "SELECT *, row_number() over (partition by c0) FROM tmp");
+
+  plan = PlanBuilder().values(data).rowNumber({"c0"}, 5).planNode();
+  assertQuery(
+      plan,
+      "SELECT * FROM (SELECT *, row_number() over (partition by c0) as rn "
+      "FROM tmp) WHERE rn <= 5");
+}
+
 TEST_F(RowNumberTest, spill) {
   std::vector<RowVectorPtr> vectors = createVectors(8, rowType_, fuzzerOpts_);
   createDuckDbTable(vectors);
@@ -475,4 +475,69 @@ TEST_F(SortBufferTest, emptySpill) {
     ASSERT_TRUE(spillStats.rlock()->empty());
   }
 }
+
+TEST_F(SortBufferTest, spillWithNormalizedKeyPrefix) {
+  // Sorts by a string key whose values share a prefix longer than the
+  // normalized part, a descending nullable bigint key and a unique double key,
+  // so that the spill merge resolves ties of the prefixes by value.
+  const std::vector<column_index_t> sortColumnIndices{5, 0, 4};
+  const std::vector<CompareFlags> sortCompareFlags{
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue},
+      {false, false, false, CompareFlags::NullHandlingMode::kNullAsValue},
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue}};
+  const int32_t numBatches = 4;
+  const vector_size_t batchSize = 500;
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < numBatches; ++i) {
+    const auto offset = i * batchSize;
+    inputs.push_back(makeRowVector(
+        inputType_->names(),
+        {makeFlatVector<int64_t>(
+             batchSize,
+             [](auto row) { return row % 11; },
+             [](auto row) { return row % 13 == 0; }),
+         makeFlatVector<int32_t>(batchSize, [](auto row) { return row; }),
+         makeFlatVector<int16_t>(batchSize, [](auto row) { return row; }),
+         makeFlatVector<float>(batchSize, [](auto row) { return row; }),
+         makeFlatVector<double>(
+             batchSize, [&](auto row) { return offset + row; }),
+         makeFlatVector<std::string>(batchSize, [](auto row) {
+           return fmt::format("a string longer than the prefix {}", row % 7);
+         })}));
+  }
+
+  const auto sort = [&](bool spill) {
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto spillConfig = getSpillConfig(spillDirectory->getPath());
+    folly::Synchronized<common::SpillStats> spillStats;
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices,
+        sortCompareFlags,
+        pool_.get(),
+        &nonReclaimableSection_,
+        spill ? &spillConfig : nullptr,
+        &spillStats);
+    for (const auto& input : inputs) {
+      sortBuffer->addInput(input);
+      if (spill && input != inputs.back()) {
+        sortBuffer->spill();
+      }
+    }
+    sortBuffer->noMoreInput();
+    EXPECT_EQ(spillStats.rlock()->empty(), !spill);
+
+    auto result = BaseVector::create<RowVector>(
+        inputType_, numBatches * batchSize, pool_.get());
+    vector_size_t numRows = 0;
+    while (auto output = sortBuffer->getOutput(300)) {
+      result->copy(output.get(), numRows, 0, output->size());
+      numRows += output->size();
+    }
+    EXPECT_EQ(numRows, numBatches * batchSize);
+    return result;
+  };
+
+  assertEqualVectors(sort(false), sort(true));
+}
 } // namespace facebook::velox::functions::test
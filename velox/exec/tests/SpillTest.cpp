@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -28,6 +30,9 @@
 #include "velox/type/Timestamp.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
+DECLARE_bool(velox_spill_read_mmap);
+DECLARE_bool(velox_spill_zstd_dictionary);
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::filesystems;
@@ -167,7 +172,9 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
         writeBufferSize,
         compressionKind_,
         pool(),
-        &spillStats_);
+        &spillStats_,
+        "",
+        writeExecutor_);
     ASSERT_EQ(targetFileSize, state_->targetFileSize());
     ASSERT_EQ(numPartitions, state_->maxPartitions());
     ASSERT_EQ(spillStats_.rlock()->spilledPartitions, 0);
@@ -350,6 +357,12 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
     for (auto partition = 0; partition < state_->maxPartitions(); ++partition) {
       auto spillFiles = state_->finish(partition);
       ASSERT_EQ(state_->numFinishedFiles(partition), 0);
+      for (const auto& spillFile : spillFiles) {
+        ASSERT_EQ(
+            spillFile.compressionDictionary != nullptr,
+            FLAGS_velox_spill_zstd_dictionary &&
+                compressionKind_ == common::CompressionKind_ZSTD);
+      }
       auto spillPartition =
           SpillPartition(SpillPartitionId{0, partition}, std::move(spillFiles));
       auto merge =
@@ -439,6 +452,8 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
   std::string fileNamePrefix_;
   folly::Synchronized<common::SpillStats> spillStats_;
   std::unique_ptr<SpillState> state_;
+  // Passed to 'state_' for writing the spill files if set.
+  folly::Executor* writeExecutor_{nullptr};
   std::unordered_map<std::string, RuntimeMetric> runtimeStats_;
   std::unique_ptr<TestRuntimeStatWriter> statWriter_;
   common::UpdateAndCheckSpillLimitCB updateSpilledBytesCb_;
@@ -538,6 +553,38 @@ TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   spillStateTest(1, 2, 8, 8, {}, 8 * 2);
 }
 
+TEST_P(SpillTest, spillStateWithMmapRead) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_spill_read_mmap = true;
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  spillStateTest(1, 2, 8, 1, {CompareFlags{false, true}}, 8 * 2);
+}
+
+TEST_P(SpillTest, spillStateWithZstdDictionary) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_spill_zstd_dictionary = true;
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  spillStateTest(1, 2, 8, 1, {CompareFlags{false, true}}, 8 * 2);
+
+  folly::CPUThreadPoolExecutor executor(2);
+  writeExecutor_ = &executor;
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, false}}, 8);
+  state_.reset();
+  writeExecutor_ = nullptr;
+}
+
+TEST_P(SpillTest, spillStateWithWriteBehind) {
+  folly::CPUThreadPoolExecutor executor(2);
+  writeExecutor_ = &executor;
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  spillStateTest(1, 2, 8, 1, {CompareFlags{false, true}}, 8 * 2);
+  state_.reset();
+  writeExecutor_ = nullptr;
+}
+
 TEST_P(SpillTest, spillPartitionId) {
   SpillPartitionId partitionId1_2(1, 2);
   ASSERT_EQ(partitionId1_2.partitionBitOffset(), 1);
@@ -793,6 +840,27 @@ SpillFiles makeFakeSpillFiles(int32_t numFiles) {
 }
 } // namespace
 
+TEST(SpillTest, spillPartitionSplitFiles) {
+  const SpillPartitionId id(0, 0);
+  SpillPartition partition(id, makeFakeSpillFiles(5));
+  ASSERT_EQ(partition.size(), 5 * 1024);
+
+  auto block = partition.splitFiles(2);
+  ASSERT_EQ(block->id(), id);
+  ASSERT_EQ(block->numFiles(), 2);
+  ASSERT_EQ(block->size(), 2 * 1024);
+  ASSERT_EQ(partition.numFiles(), 3);
+  ASSERT_EQ(partition.size(), 3 * 1024);
+
+  block = partition.splitFiles(4);
+  ASSERT_EQ(block->numFiles(), 3);
+  ASSERT_EQ(block->size(), 3 * 1024);
+  ASSERT_EQ(partition.numFiles(), 0);
+  ASSERT_EQ(partition.size(), 0);
+
+  VELOX_ASSERT_THROW(partition.splitFiles(0), "");
+}
+
 TEST(SpillTest, removeEmptyPartitions) {
   SpillPartitionSet partitionSet;
   const int32_t partitionOffset = 8;
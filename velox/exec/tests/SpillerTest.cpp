@@ -85,6 +85,14 @@ struct TestParamsBuilder {
     const auto numSpillerTypes = static_cast<int8_t>(Spiller::Type::kNumTypes);
     for (int i = 0; i < numSpillerTypes; ++i) {
       const auto type = static_cast<Spiller::Type>(i);
+      // kNestedLoopJoinBuild spiller has no associated row container, and is
+      // covered by the nested loop join spilling tests. kPartitionedInput
+      // shares the kHashJoinProbe code path and is covered by the row number
+      // and mark distinct spilling tests.
+      if (type == Spiller::Type::kNestedLoopJoinBuild ||
+          type == Spiller::Type::kPartitionedInput) {
+        continue;
+      }
       if (typesToExclude.find(type) == typesToExclude.end()) {
         common::CompressionKind compressionKind =
             static_cast<common::CompressionKind>(numSpillerTypes % 6);
@@ -421,6 +421,35 @@ TEST_F(StreamingAggregationTest, uniqueKeys) {
   testAggregation(keys, 100);
 }
 
+TEST_F(StreamingAggregationTest, runsOfVaryingLength) {
+  // Runs of 1 to 40 rows so that group boundaries fall at every position of
+  // a SIMD register and runs cross input batches.
+  auto runOf = [](auto row) {
+    auto key = 0;
+    for (auto length = 1; row >= length; ++key) {
+      row -= length;
+      length = length % 40 + 1;
+    }
+    return key;
+  };
+  auto size = 600;
+  auto makeKeys = [&](auto type) {
+    using T = decltype(type);
+    std::vector<VectorPtr> keys;
+    for (auto i = 0; i < 3; ++i) {
+      keys.push_back(makeFlatVector<T>(size, [&, i](auto row) {
+        return static_cast<T>(runOf(i * size + row));
+      }));
+    }
+    return keys;
+  };
+
+  testAggregation(makeKeys(int8_t()), 1024);
+  testAggregation(makeKeys(int16_t()), 1024);
+  testAggregation(makeKeys(int32_t()), 100);
+  testAggregation(makeKeys(int64_t()), 100);
+}
+
 TEST_F(StreamingAggregationTest, partialStreaming) {
   auto size = 1'024;
 
@@ -409,6 +409,46 @@ TEST_F(TableScanTest, partitionKeyAlias) {
   assertQuery(op, split, "SELECT c0, '2021-12-02' FROM tmp");
 }
 
+TEST_F(TableScanTest, remainingFilterOnPartitionKeys) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())},
+      {"hr", partitionKey("hr", INTEGER())}};
+  auto outputType =
+      ROW({"c0", "ds", "hr"}, {BIGINT(), VARCHAR(), INTEGER()});
+  auto op = PlanBuilder()
+                .startTableScan()
+                .outputType(outputType)
+                .remainingFilter("ds = '2021-12-02' or hr > 10")
+                .assignments(assignments)
+                .endTableScan()
+                .planNode();
+
+  auto makeSplit = [](const std::string& path,
+                      const std::string& ds,
+                      const std::string& hr) {
+    return HiveConnectorSplitBuilder(path)
+        .partitionKey("ds", ds)
+        .partitionKey("hr", hr)
+        .build();
+  };
+  // The filter fails on the partition values of the last split, so it is
+  // skipped without opening its file, which does not exist.
+  auto task = OperatorTestBase::assertQuery(
+      op,
+      {makeSplit(filePath->getPath(), "2021-12-02", "1"),
+       makeSplit(filePath->getPath(), "2021-12-01", "12"),
+       makeSplit("/nonexistent/file", "2021-12-01", "3")},
+      "SELECT c0, '2021-12-02', 1 FROM tmp "
+      "UNION ALL SELECT c0, '2021-12-01', 12 FROM tmp");
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+}
+
 TEST_F(TableScanTest, columnPruning) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -1360,6 +1400,72 @@ TEST_F(TableScanTest, batchSize) {
 
 // Test that adding the same split with the same sequence id does not cause
 // double read and the 2nd split is ignored.
+TEST_F(TableScanTest, adaptiveBatchSize) {
+  // The first half of the rows is narrow and the second half is wide, so the
+  // average row size of the file underestimates the wide rows.
+  constexpr int32_t kNumRows = 10'000;
+  auto vector = makeRowVector({makeFlatVector<std::string>(
+      kNumRows, [](auto row) {
+        return std::string(row < kNumRows / 2 ? 10 : 10'000, 'x');
+      })});
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {vector});
+  createDuckDbTable({vector});
+
+  auto plan = PlanBuilder().tableScan(asRowType(vector->type())).planNode();
+  auto numOutputVectors = [&](bool adaptive) {
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .plan(plan)
+                    .splits(makeHiveConnectorSplits({filePath}))
+                    .config(QueryConfig::kPreferredOutputBatchBytes, "1000000")
+                    .config(
+                        QueryConfig::kTableScanAdaptiveBatchSize,
+                        adaptive ? "true" : "false")
+                    .assertResults("SELECT * FROM tmp");
+    return task->taskStats().pipelineStats[0].operatorStats[0].outputVectors;
+  };
+  // With the size of the previous batch, the batches of wide rows have about
+  // half as many rows.
+  EXPECT_GT(numOutputVectors(true), numOutputVectors(false));
+}
+
+TEST_F(TableScanTest, topNDynamicFilter) {
+  // Each file holds smaller values than the one before, so once the first
+  // file is read the TopN boundary filter skips the others.
+  constexpr int32_t kNumFiles = 5;
+  constexpr int32_t kRowsPerFile = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    const auto start = (kNumFiles - i) * kRowsPerFile;
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kRowsPerFile, [&](auto row) { return start - row; }),
+        makeFlatVector<int32_t>(kRowsPerFile, [](auto row) { return row; }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(vectors[0]->type()))
+                  .topN({"c0 DESC"}, 10, false)
+                  .planNode();
+  auto task = assertQuery(
+      plan, filePaths, "SELECT * FROM tmp ORDER BY c0 DESC LIMIT 10");
+  auto stats = getTableScanRuntimeStats(task);
+  EXPECT_GT(stats.at("dynamicFiltersAccepted").sum, 0);
+  EXPECT_GT(getSkippedSplitsStat(task), 0);
+
+  // Ascending order keeps the rows of the last file.
+  plan = PlanBuilder()
+             .tableScan(asRowType(vectors[0]->type()))
+             .topN({"c0"}, 10, false)
+             .planNode();
+  assertQuery(plan, filePaths, "SELECT * FROM tmp ORDER BY c0 LIMIT 10");
+}
+
 TEST_F(TableScanTest, sequentialSplitNoDoubleRead) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -1469,6 +1575,79 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, adaptiveSplitPreload) {
+  auto filePaths = makeFilePaths(100);
+  auto vectors = makeVectors(100, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto task = AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+                  .config(core::QueryConfig::kAdaptiveSplitPreload, "true")
+                  .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "4")
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .maxDrivers(2)
+                  .assertResults("SELECT * FROM tmp");
+  // The first splits are preloaded with the full window, the later ones with
+  // the window from the measured split open and read times.
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_GT(stats.at("preloadedSplits").sum, 1);
+}
+
+TEST_F(TableScanTest, fragmentResultCache) {
+  FragmentResultCache::testingReset();
+  FragmentResultCache::init(64 << 20);
+  auto filePaths = makeFilePaths(4);
+  auto vectors = makeVectors(4, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto makeSplits = [&](std::optional<int64_t> modificationTime) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(HiveConnectorSplitBuilder(filePath->getPath())
+                           .fileProperties({std::nullopt, modificationTime})
+                           .build());
+    }
+    return splits;
+  };
+  auto runQuery = [&](const core::PlanNodePtr& plan,
+                      std::optional<int64_t> modificationTime,
+                      const std::string& duckDbSql) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kFragmentResultCacheEnabled, "true")
+            .splits(makeSplits(modificationTime))
+            .assertResults(duckDbSql);
+    auto stats = getTableScanRuntimeStats(task);
+    return std::vector<int64_t>{
+        stats["resultCacheHits"].sum, stats["resultCacheMisses"].sum};
+  };
+
+  // Hits and misses per run. The first run adds the output of each split,
+  // the second reads it.
+  using Counts = std::vector<int64_t>;
+  const std::string sql = "SELECT * FROM tmp";
+  ASSERT_EQ(runQuery(tableScanNode(), 1, sql), Counts({0, 4}));
+  ASSERT_EQ(runQuery(tableScanNode(), 1, sql), Counts({4, 0}));
+  ASSERT_GT(FragmentResultCache::instance()->stats().curSize, 0);
+
+  // A new file version or a different scan does not match.
+  ASSERT_EQ(runQuery(tableScanNode(), 2, sql), Counts({0, 4}));
+  auto filterPlan = PlanBuilder().tableScan(rowType_, {"c0 > 0"}).planNode();
+  ASSERT_EQ(
+      runQuery(filterPlan, 1, "SELECT * FROM tmp WHERE c0 > 0"),
+      Counts({0, 4}));
+
+  // Splits without a modification time are not cached.
+  ASSERT_EQ(runQuery(tableScanNode(), std::nullopt, sql), Counts({0, 0}));
+
+  FragmentResultCache::testingReset();
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
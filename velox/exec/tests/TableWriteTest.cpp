@@ -3287,6 +3287,53 @@ TEST_P(BucketSortOnlyTableWriterTest, sortWriterSpill) {
   ASSERT_GT(stats.customStats[Operator::kSpillWriteTime].sum, 0);
 }
 
+TEST_P(BucketSortOnlyTableWriterTest, sortWriterMaxBufferedBytes) {
+  SCOPED_TRACE(testParam_.toString());
+
+  const auto vectors = makeVectors(5, 500);
+  createDuckDbTable(vectors);
+
+  auto outputDirectory = TempDirectoryPath::create();
+  auto op = createInsertPlan(
+      PlanBuilder().values(vectors),
+      rowType_,
+      outputDirectory->getPath(),
+      partitionedBy_,
+      bucketProperty_,
+      compressionKind_,
+      getNumWriters(),
+      connector::hive::LocationHandle::TableType::kNew,
+      commitStrategy_);
+
+  // Every input batch is spilled as a sorted run without memory arbitration.
+  const auto spillDirectory = TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(op, duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->getPath())
+          .config(
+              QueryConfig::kTaskWriterCount,
+              std::to_string(numTableWriterCount_))
+          .config(
+              QueryConfig::kTaskPartitionedWriterCount,
+              std::to_string(numPartitionedTableWriterCount_))
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(QueryConfig::kWriterSpillEnabled, "true")
+          .connectorSessionProperty(
+              kHiveConnectorId,
+              HiveConfig::kSortWriterMaxBufferedBytesSession,
+              "1B")
+          .assertResults(fmt::format("SELECT {}", 5 * 500));
+  if (partitionedBy_.size() > 0) {
+    rowType_ = getNonPartitionsColumns(partitionedBy_, rowType_);
+  }
+  verifyTableWriterOutput(outputDirectory->getPath(), rowType_);
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  auto& stats = taskStats.at(tableWriteNodeId_);
+  ASSERT_EQ(stats.spilledRows, 5 * 500);
+  ASSERT_GT(stats.customStats[Operator::kSpillRuns].sum, 0);
+}
+
 DEBUG_ONLY_TEST_P(BucketSortOnlyTableWriterTest, outputBatchRows) {
   struct {
     uint32_t maxOutputRows;
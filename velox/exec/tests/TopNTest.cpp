@@ -14,8 +14,12 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/testutil/TestValue.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -284,6 +288,117 @@ TEST_F(TopNTest, onlyKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+TEST_F(TopNTest, spill) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row * 17 + i * 31) % 5'003; }),
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (row + i) % 7; }, nullEvery(23)),
+        makeFlatVector<std::string>(
+            1'000,
+            [&](auto row) { return std::string(row % 40, 'a' + i % 26); }),
+    }));
+  }
+
+  for (const int32_t limit : {10, 2'500, 20'000}) {
+    SCOPED_TRACE(fmt::format("limit {}", limit));
+    core::PlanNodeId topNId;
+    const auto plan = PlanBuilder()
+                          .values(vectors)
+                          .topN({"c1 NULLS FIRST", "c0 DESC"}, limit, false)
+                          .capturePlanNodeId(topNId)
+                          .planNode();
+    const auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+    const auto spillDirectory = exec::test::TempDirectoryPath::create();
+    exec::TestScopedSpillInjection scopedSpillInjection(100);
+    std::shared_ptr<exec::Task> task;
+    const auto result = AssertQueryBuilder(plan)
+                            .spillDirectory(spillDirectory->getPath())
+                            .config(core::QueryConfig::kSpillEnabled, true)
+                            .config(core::QueryConfig::kTopNSpillEnabled, true)
+                            .copyResults(pool(), task);
+    assertEqualVectors(expected, result);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& planStats = taskStats.at(topNId);
+    ASSERT_GT(planStats.spilledBytes, 0);
+    ASSERT_GT(planStats.spilledRows, 0);
+    // Each spilled run holds at most 'limit' rows.
+    ASSERT_LE(planStats.spilledRows, limit * vectors.size());
+    ASSERT_EQ(planStats.spilledPartitions, 1);
+    ASSERT_EQ(planStats.outputRows, expected->size());
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
+DEBUG_ONLY_TEST_F(TopNTest, reclaimDuringOutputProcessing) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row * 13 + i * 7) % 3'001; }),
+        makeFlatVector<std::string>(
+            1'000, [&](auto row) { return std::string(row % 30, 'x'); }),
+    }));
+  }
+
+  core::PlanNodeId topNId;
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .topN({"c0 DESC"}, 2'000, false)
+                        .capturePlanNodeId(topNId)
+                        .planNode();
+  const auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  for (const bool spillInput : {false, true}) {
+    SCOPED_TRACE(fmt::format("spillInput {}", spillInput));
+    const auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+    std::atomic_bool reclaimed{false};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::getOutput",
+        std::function<void(exec::Operator*)>([&](exec::Operator* op) {
+          if (op->operatorType() != "TopN" || op->needsInput()) {
+            return;
+          }
+          if (reclaimed.exchange(true)) {
+            return;
+          }
+          ASSERT_TRUE(op->canReclaim());
+          const auto usedBytes = op->pool()->usedBytes();
+          memory::testingRunArbitration(op->pool(), 0);
+          // Reclaim is a no-op once all the input is received.
+          ASSERT_EQ(op->pool()->usedBytes(), usedBytes);
+        }));
+
+    std::unique_ptr<exec::TestScopedSpillInjection> scopedSpillInjection;
+    if (spillInput) {
+      scopedSpillInjection =
+          std::make_unique<exec::TestScopedSpillInjection>(100);
+    }
+    std::shared_ptr<exec::Task> task;
+    const auto result = AssertQueryBuilder(plan)
+                            .spillDirectory(spillDirectory->getPath())
+                            .config(core::QueryConfig::kSpillEnabled, true)
+                            .config(core::QueryConfig::kTopNSpillEnabled, true)
+                            .copyResults(pool(), task);
+    ASSERT_TRUE(reclaimed);
+    assertEqualVectors(expected, result);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& planStats = taskStats.at(topNId);
+    if (spillInput) {
+      ASSERT_GT(planStats.spilledBytes, 0);
+    } else {
+      ASSERT_EQ(planStats.spilledBytes, 0);
+    }
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 TEST_F(TopNTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b"},
@@ -0,0 +1,505 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+#include <folly/Random.h>
+#include <filesystem>
+#include <random>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+
+using namespace facebook::velox::exec::test;
+
+namespace facebook::velox::exec {
+
+namespace {
+
+constexpr int32_t kNumDimensionRows = 300;
+constexpr int32_t kNumFactRows = 20'000;
+// Every day from 1998-01-01 to 2002-12-31.
+constexpr int32_t kNumDates = 5 * 365 + 1;
+// Every minute of a day.
+constexpr int32_t kNumTimes = 24 * 60;
+
+const std::unordered_set<std::string> kFactTables = {
+    "store_sales",
+    "store_returns",
+    "catalog_sales",
+    "catalog_returns",
+    "web_sales",
+    "inventory"};
+
+// Integer columns that are not keys. Keys end in '_sk'.
+const std::unordered_set<std::string> kIntegerColumns = {
+    "ss_ticket_number", "ss_quantity", "sr_ticket_number", "sr_return_quantity",
+    "cs_order_number", "cs_quantity", "cr_order_number", "cr_return_quantity",
+    "ws_order_number", "ws_quantity", "inv_quantity_on_hand", "d_month_seq",
+    "d_week_seq", "d_quarter_seq", "d_year", "d_dow", "d_moy", "d_dom", "d_qoy",
+    "d_fy_year", "d_fy_quarter_seq", "d_fy_week_seq", "d_first_dom",
+    "d_last_dom", "d_same_day_ly", "d_same_day_lq", "t_time", "t_hour",
+    "t_minute", "t_second", "i_brand_id", "i_class_id", "i_category_id",
+    "i_manufact_id", "i_manager_id", "c_birth_day", "c_birth_month",
+    "c_birth_year", "cd_purchase_estimate", "cd_dep_count",
+    "cd_dep_employed_count", "cd_dep_college_count", "hd_dep_count",
+    "hd_vehicle_count", "ib_lower_bound", "ib_upper_bound",
+    "s_number_employees", "s_floor_space", "s_market_id", "s_division_id",
+    "s_company_id", "p_response_target", "w_warehouse_sq_ft", "web_mkt_id",
+    "web_company_id", "wp_char_count", "wp_link_count", "wp_image_count",
+    "wp_max_ad_count", "cc_employees", "cc_sq_ft", "cc_mkt_id", "cc_division",
+    "cc_company"};
+
+// Decimal columns of the dimension tables. The columns of the fact tables
+// that are neither keys nor integers are decimals.
+const std::unordered_set<std::string> kDecimalColumns = {
+    "i_current_price",
+    "i_wholesale_cost",
+    "ca_gmt_offset",
+    "s_gmt_offset",
+    "s_tax_precentage",
+    "p_cost",
+    "w_gmt_offset",
+    "web_gmt_offset",
+    "web_tax_percentage",
+    "cc_gmt_offset",
+    "cc_tax_percentage"};
+
+// Strings compared with in the plans, so that filters on strings pass some
+// rows.
+const std::vector<std::string> kStrings = {
+    "2 yr Degree",
+    "4 yr Degree",
+    "80348",
+    "85669",
+    "88274",
+    ">10000",
+    "Advanced Degree",
+    "Books",
+    "Bronx County",
+    "CA",
+    "Children",
+    "College",
+    "D",
+    "Electronics",
+    "Fairview",
+    "GA",
+    "Home",
+    "Jewelry",
+    "M",
+    "Men",
+    "Midway",
+    "Music",
+    "N",
+    "S",
+    "Sports",
+    "TN",
+    "TX",
+    "United States",
+    "Unknown",
+    "W",
+    "Williamson County",
+    "Women",
+    "accessories",
+    "amalgimporto #1",
+    "classical",
+    "ese",
+    "football",
+    "reason 28",
+    "self-help",
+    "shirts"};
+
+// The columns of a returns table that are copied from the sales it returns,
+// so that joins of sales and returns find matches.
+struct ReturnedColumns {
+  std::string salesTable;
+  std::vector<std::pair<std::string, std::string>> returnsAndSalesColumns;
+};
+
+const std::unordered_map<std::string, ReturnedColumns> kReturnTables = {
+    {"store_returns",
+     {"store_sales",
+      {{"sr_item_sk", "ss_item_sk"},
+       {"sr_ticket_number", "ss_ticket_number"},
+       {"sr_customer_sk", "ss_customer_sk"}}}},
+    {"catalog_returns",
+     {"catalog_sales",
+      {{"cr_item_sk", "cs_item_sk"}, {"cr_order_number", "cs_order_number"}}}}};
+
+// One return for this many sales.
+constexpr int32_t kSalesPerReturn = 4;
+
+bool endsWith(const std::string& name, folly::StringPiece suffix) {
+  return folly::StringPiece(name).endsWith(suffix);
+}
+
+// Returns the type that the plans expect for 'column' of 'table': integers
+// are BIGINT, decimals DOUBLE and dates VARCHAR since DWRF has no DATE.
+TypePtr columnType(const std::string& table, const std::string& column) {
+  if (endsWith(column, "_sk") || kIntegerColumns.count(column)) {
+    return BIGINT();
+  }
+  if (kDecimalColumns.count(column) || kFactTables.count(table)) {
+    return DOUBLE();
+  }
+  return VARCHAR();
+}
+
+struct Day {
+  int32_t year;
+  int32_t month;
+  int32_t dayOfMonth;
+  // 0 is Sunday.
+  int32_t dayOfWeek;
+};
+
+// Returns the days of date_dim, from 1998-01-01, a Thursday.
+std::vector<Day> makeDays() {
+  static const std::array<int32_t, 12> kDaysInMonth = {
+      31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  std::vector<Day> days;
+  Day day{1998, 1, 1, 4};
+  for (auto i = 0; i < kNumDates; ++i) {
+    days.push_back(day);
+    day.dayOfWeek = (day.dayOfWeek + 1) % 7;
+    const bool isLeap = day.year % 4 == 0;
+    const auto monthDays =
+        kDaysInMonth[day.month - 1] + (day.month == 2 && isLeap);
+    if (++day.dayOfMonth > monthDays) {
+      day.dayOfMonth = 1;
+      if (++day.month > 12) {
+        day.month = 1;
+        ++day.year;
+      }
+    }
+  }
+  return days;
+}
+
+std::string toDateString(const Day& day) {
+  return fmt::format("{}-{:02d}-{:02d}", day.year, day.month, day.dayOfMonth);
+}
+
+// Runs every TPC-DS plan of TpcdsQueryBuilder on small generated tables.
+// The data follows the key relationships of TPC-DS but not its value
+// distributions.
+class TpcdsQueryBuilderTest : public HiveConnectorTestBase {
+ protected:
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+
+    dataDirectory_ = TempDirectoryPath::create();
+    writeTables();
+    queryBuilder_ =
+        std::make_unique<TpcdsQueryBuilder>(dwio::common::FileFormat::DWRF);
+    queryBuilder_->initialize(dataDirectory_->getPath());
+  }
+
+  void TearDown() override {
+    queryBuilder_.reset();
+    HiveConnectorTestBase::TearDown();
+  }
+
+  // Writes all tables, the sales before their returns, and registers them
+  // with DuckDB.
+  void writeTables() {
+    const auto& tables = TpcdsQueryBuilder::getTableColumns();
+    for (const auto& [table, columns] : tables) {
+      if (!kReturnTables.count(table)) {
+        writeTable(table, columns);
+      }
+    }
+    for (const auto& [table, columns] : tables) {
+      if (kReturnTables.count(table)) {
+        writeTable(table, columns);
+      }
+    }
+  }
+
+  void writeTable(
+      const std::string& table,
+      const std::vector<std::string>& columns) {
+    const auto numRows = numTableRows(table);
+    std::vector<VectorPtr> children;
+    for (auto i = 0; i < columns.size(); ++i) {
+      children.push_back(makeColumn(table, columns[i], i == 0, numRows));
+    }
+    auto data = makeRowVector(columns, children);
+    tables_[table] = data;
+    createDuckDbTable(table, {data});
+
+    const auto directory =
+        fmt::format("{}/{}", dataDirectory_->getPath(), table);
+    std::filesystem::create_directory(directory);
+    writeToFile(fmt::format("{}/data", directory), data);
+  }
+
+  static vector_size_t numTableRows(const std::string& table) {
+    if (table == "date_dim") {
+      return kNumDates;
+    }
+    if (table == "time_dim") {
+      return kNumTimes;
+    }
+    if (kReturnTables.count(table)) {
+      return kNumFactRows / kSalesPerReturn;
+    }
+    return kFactTables.count(table) ? kNumFactRows : kNumDimensionRows;
+  }
+
+  // Makes 'column' of 'table'. 'isKey' is true for the first column, which
+  // is the key of a dimension table.
+  VectorPtr makeColumn(
+      const std::string& table,
+      const std::string& column,
+      bool isKey,
+      vector_size_t numRows) {
+    if (table == "date_dim") {
+      if (auto vector = makeDateColumn(column)) {
+        return vector;
+      }
+    }
+    if (table == "time_dim") {
+      if (auto vector = makeTimeColumn(column)) {
+        return vector;
+      }
+    }
+    if (auto it = kReturnTables.find(table); it != kReturnTables.end()) {
+      const auto& sales = tables_.at(it->second.salesTable);
+      for (const auto& [returnsColumn, salesColumn] :
+           it->second.returnsAndSalesColumns) {
+        if (column == returnsColumn) {
+          auto* values =
+              sales->childAt(sales->type()->asRow().getChildIdx(salesColumn))
+                  ->asFlatVector<int64_t>();
+          return makeFlatVector<int64_t>(
+              numRows,
+              [&](auto row) {
+                return values->valueAt(row * kSalesPerReturn);
+              },
+              [&](auto row) {
+                return values->isNullAt(row * kSalesPerReturn);
+              });
+        }
+      }
+    }
+
+    const auto type = columnType(table, column);
+    const bool isFact = kFactTables.count(table) > 0;
+    if (type->isBigint()) {
+      if (isKey && !isFact) {
+        return makeFlatVector<int64_t>(
+            numRows, [](auto row) { return row + 1; });
+      }
+      if (endsWith(column, "_sk")) {
+        const auto numKeys = numReferencedKeys(column);
+        return makeFlatVector<int64_t>(
+            numRows,
+            [&](auto /*row*/) {
+              return 1 + folly::Random::rand32(numKeys, rng_);
+            },
+            isFact ? nullEvery(37) : nullptr);
+      }
+      // Ids, e.g. i_manufact_id = 128, and ticket numbers have more
+      // distinct values than counts and quantities.
+      uint32_t numValues = 10;
+      if (endsWith(column, "_id")) {
+        numValues = 200;
+      } else if (endsWith(column, "_number")) {
+        numValues = kNumFactRows / 10;
+      }
+      return makeFlatVector<int64_t>(numRows, [&](auto /*row*/) {
+        return folly::Random::rand32(numValues, rng_);
+      });
+    }
+    if (type->isDouble()) {
+      return makeFlatVector<double>(numRows, [&](auto /*row*/) {
+        return folly::Random::rand32(10'000, rng_) / 100.0;
+      });
+    }
+    if (endsWith(column, "_date")) {
+      return makeFlatVector<std::string>(numRows, [&](auto /*row*/) {
+        return toDateString(days_[folly::Random::rand32(kNumDates, rng_)]);
+      });
+    }
+    return makeFlatVector<std::string>(numRows, [&](auto /*row*/) {
+      return kStrings[folly::Random::rand32(kStrings.size(), rng_)];
+    });
+  }
+
+  // Returns the number of rows of the table referenced by key 'column'.
+  static uint32_t numReferencedKeys(const std::string& column) {
+    if (endsWith(column, "date_sk")) {
+      return kNumDates;
+    }
+    if (endsWith(column, "time_sk")) {
+      return kNumTimes;
+    }
+    return kNumDimensionRows;
+  }
+
+  // Returns 'column' of date_dim or nullptr if it has random values.
+  VectorPtr makeDateColumn(const std::string& column) {
+    static const std::array<const char*, 7> kDayNames = {
+        "Sunday",
+        "Monday",
+        "Tuesday",
+        "Wednesday",
+        "Thursday",
+        "Friday",
+        "Saturday"};
+    auto makeInts = [&](std::function<int64_t(const Day&)> valueAt) {
+      return makeFlatVector<int64_t>(
+          kNumDates, [&](auto row) { return valueAt(days_[row]); });
+    };
+    if (column == "d_date_sk") {
+      return makeFlatVector<int64_t>(
+          kNumDates, [](auto row) { return row + 1; });
+    }
+    if (column == "d_date") {
+      return makeFlatVector<std::string>(
+          kNumDates, [&](auto row) { return toDateString(days_[row]); });
+    }
+    if (column == "d_year" || column == "d_fy_year") {
+      return makeInts([](const Day& day) { return day.year; });
+    }
+    if (column == "d_moy") {
+      return makeInts([](const Day& day) { return day.month; });
+    }
+    if (column == "d_dom") {
+      return makeInts([](const Day& day) { return day.dayOfMonth; });
+    }
+    if (column == "d_dow") {
+      return makeInts([](const Day& day) { return day.dayOfWeek; });
+    }
+    if (column == "d_qoy") {
+      return makeInts([](const Day& day) { return (day.month - 1) / 3 + 1; });
+    }
+    if (column == "d_month_seq") {
+      // January 2000 is month 1200.
+      return makeInts([](const Day& day) {
+        return (day.year - 1900) * 12 + day.month - 1;
+      });
+    }
+    if (column == "d_week_seq" || column == "d_fy_week_seq") {
+      return makeFlatVector<int64_t>(
+          kNumDates, [](auto row) { return 5'100 + (row + 4) / 7; });
+    }
+    if (column == "d_day_name") {
+      return makeFlatVector<std::string>(kNumDates, [&](auto row) {
+        return kDayNames[days_[row].dayOfWeek];
+      });
+    }
+    return nullptr;
+  }
+
+  // Returns 'column' of time_dim or nullptr if it has random values.
+  VectorPtr makeTimeColumn(const std::string& column) {
+    if (column == "t_time_sk") {
+      return makeFlatVector<int64_t>(
+          kNumTimes, [](auto row) { return row + 1; });
+    }
+    if (column == "t_time") {
+      return makeFlatVector<int64_t>(
+          kNumTimes, [](auto row) { return row * 60; });
+    }
+    if (column == "t_hour") {
+      return makeFlatVector<int64_t>(
+          kNumTimes, [](auto row) { return row / 60; });
+    }
+    if (column == "t_minute") {
+      return makeFlatVector<int64_t>(
+          kNumTimes, [](auto row) { return row % 60; });
+    }
+    return nullptr;
+  }
+
+  // Adds the splits of the data files of 'plan' to 'builder'.
+  static void addSplits(const TpcdsPlan& plan, AssertQueryBuilder& builder) {
+    for (const auto& [nodeId, paths] : plan.dataFiles) {
+      for (const auto& path : paths) {
+        builder.split(nodeId, makeHiveConnectorSplit(path));
+      }
+    }
+  }
+
+  void assertQuery(int queryId, const std::string& duckDbSql) {
+    SCOPED_TRACE(fmt::format("Q{}", queryId));
+    const auto plan = queryBuilder_->getQueryPlan(queryId);
+    AssertQueryBuilder builder(plan.plan, duckDbQueryRunner_);
+    builder.maxDrivers(kNumDrivers);
+    addSplits(plan, builder);
+    builder.assertResults(duckDbSql);
+  }
+
+  static constexpr int32_t kNumDrivers = 4;
+
+  std::mt19937 rng_{1};
+  const std::vector<Day> days_{makeDays()};
+  std::shared_ptr<TempDirectoryPath> dataDirectory_;
+  std::unordered_map<std::string, RowVectorPtr> tables_;
+  std::unique_ptr<TpcdsQueryBuilder> queryBuilder_;
+};
+
+TEST_F(TpcdsQueryBuilderTest, allQueries) {
+  for (auto queryId : TpcdsQueryBuilder::getQueryIds()) {
+    SCOPED_TRACE(fmt::format("Q{}", queryId));
+    const auto plan = queryBuilder_->getQueryPlan(queryId);
+    AssertQueryBuilder builder(plan.plan);
+    builder.maxDrivers(kNumDrivers);
+    addSplits(plan, builder);
+    builder.copyResults(pool());
+  }
+
+  VELOX_ASSERT_THROW(
+      queryBuilder_->getQueryPlan(1), "TPC-DS query 1 is not supported yet");
+}
+
+TEST_F(TpcdsQueryBuilderTest, q3) {
+  assertQuery(
+      3,
+      "SELECT d_year, i_brand_id, i_brand, sum(ss_ext_sales_price) "
+      "FROM date_dim, store_sales, item "
+      "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+      "  AND i_manufact_id = 128 AND d_moy = 11 "
+      "GROUP BY d_year, i_brand, i_brand_id");
+}
+
+TEST_F(TpcdsQueryBuilderTest, q55) {
+  assertQuery(
+      55,
+      "SELECT i_brand_id, i_brand, sum(ss_ext_sales_price) "
+      "FROM date_dim, store_sales, item "
+      "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+      "  AND i_manager_id = 28 AND d_moy = 11 AND d_year = 1999 "
+      "GROUP BY i_brand, i_brand_id");
+}
+
+TEST_F(TpcdsQueryBuilderTest, q96) {
+  assertQuery(
+      96,
+      "SELECT count(*) "
+      "FROM store_sales, household_demographics, time_dim, store "
+      "WHERE ss_sold_time_sk = t_time_sk AND ss_hdemo_sk = hd_demo_sk "
+      "  AND ss_store_sk = s_store_sk AND t_hour = 20 AND t_minute >= 30 "
+      "  AND hd_dep_count = 7 AND s_store_name = 'ese'");
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -28,6 +28,7 @@ class TreeOfLosersTest : public testing::Test, public MergeTestBase {
     TestData testData = makeTestData(numValues, numStreams);
     test<TreeOfLosers<TestingStream>>(testData, true);
     test<MergeArray<TestingStream>>(testData, true);
+    testRuns<TreeOfLosers<TestingStream>>(testData, true);
   }
 };
 
@@ -40,6 +41,54 @@ TEST_F(TreeOfLosersTest, merge) {
   testBoth(500, 1);
 }
 
+TEST_F(TreeOfLosersTest, nextWithRunnerUp) {
+  for (const auto& [numStreams, runLength] :
+       std::vector<std::pair<int32_t, int32_t>>{
+           {1, 10}, {2, 1}, {2, 1'000}, {3, 77}, {17, 5}, {64, 300}}) {
+    SCOPED_TRACE(
+        fmt::format("numStreams: {}, runLength: {}", numStreams, runLength));
+    auto testData = makeTestData(100'000, numStreams, runLength);
+    testRuns<TreeOfLosers<TestingStream>>(testData, true);
+  }
+
+  // The runner-up is the stream with the second lowest first value.
+  std::vector<std::unique_ptr<TestingStream>> streams;
+  streams.push_back(
+      std::make_unique<TestingStream>(std::vector<uint32_t>{9, 3, 2, 1}));
+  streams.push_back(std::make_unique<TestingStream>(std::vector<uint32_t>{8}));
+  streams.push_back(
+      std::make_unique<TestingStream>(std::vector<uint32_t>{7, 4}));
+  TreeOfLosers<TestingStream> merge(std::move(streams));
+  auto [stream, runnerUp] = merge.nextWithRunnerUp();
+  ASSERT_EQ(stream->current()->value(), 1);
+  ASSERT_EQ(runnerUp->current()->value(), 4);
+  ASSERT_EQ(stream->numRunRows(runnerUp, 10), 3);
+  ASSERT_EQ(stream->numRunRows(runnerUp, 2), 2);
+  stream->pop(3);
+
+  std::tie(stream, runnerUp) = merge.nextWithRunnerUp();
+  ASSERT_EQ(stream->current()->value(), 4);
+  ASSERT_EQ(runnerUp->current()->value(), 8);
+  stream->pop(1);
+
+  std::tie(stream, runnerUp) = merge.nextWithRunnerUp();
+  ASSERT_EQ(stream->current()->value(), 7);
+  ASSERT_EQ(runnerUp->current()->value(), 8);
+  stream->pop(1);
+
+  std::tie(stream, runnerUp) = merge.nextWithRunnerUp();
+  ASSERT_EQ(stream->current()->value(), 8);
+  ASSERT_EQ(runnerUp->current()->value(), 9);
+  stream->pop(1);
+
+  std::tie(stream, runnerUp) = merge.nextWithRunnerUp();
+  ASSERT_EQ(stream->current()->value(), 9);
+  ASSERT_EQ(runnerUp, nullptr);
+  ASSERT_EQ(stream->numRunRows(runnerUp, 10), 1);
+  stream->pop(1);
+  ASSERT_EQ(merge.nextWithRunnerUp().first, nullptr);
+}
+
 TEST_F(TreeOfLosersTest, nextWithEquals) {
   constexpr int32_t kNumStreams = 17;
   std::vector<std::vector<uint32_t>> streams(kNumStreams);
@@ -424,7 +424,7 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // Outputs of 17 rows split the arrays of some input rows between batches.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
@@ -432,10 +432,10 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(1 + 30'000 / 17, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // Outputs of 2 rows.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
@@ -443,7 +443,7 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(30'000 / 2, stats.at(unnestId).outputVectors);
   }
 
   // 100K rows per output allows to unnest all at once.
@@ -458,3 +458,64 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
 }
+
+TEST_F(UnnestTest, splitLargeArrays) {
+  // Arrays of 0, 100, ..., 900 elements with every 4th row null and the
+  // elements of every 3rd row starting one row later.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10, [](auto row) { return row; }),
+      makeArrayVector<int64_t>(
+          10,
+          [](auto row) { return row * 100; },
+          [](auto row, auto index) { return row * 1'000 + index; },
+          nullEvery(4)),
+      makeArrayVector<int64_t>(
+          10,
+          [](auto row) { return row % 3 == 0 ? row * 100 + 1 : row * 100; },
+          [](auto row, auto index) { return -index; }),
+  });
+
+  std::vector<int64_t> expectedC0;
+  std::vector<std::optional<int64_t>> expectedC1;
+  std::vector<int64_t> expectedC2;
+  std::vector<int64_t> expectedOrdinal;
+  for (auto row = 0; row < 10; ++row) {
+    const auto size = row % 3 == 0 ? row * 100 + 1 : row * 100;
+    for (auto i = 0; i < size; ++i) {
+      expectedC0.push_back(row);
+      if (row % 4 == 0 || i >= row * 100) {
+        expectedC1.push_back(std::nullopt);
+      } else {
+        expectedC1.push_back(row * 1'000 + i);
+      }
+      expectedC2.push_back(-i);
+      expectedOrdinal.push_back(i + 1);
+    }
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(expectedC0),
+      makeNullableFlatVector<int64_t>(expectedC1),
+      makeFlatVector<int64_t>(expectedC2),
+      makeFlatVector<int64_t>(expectedOrdinal),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+  for (const auto batchRows : {1, 7, 100, 333, 10'000}) {
+    SCOPED_TRACE(fmt::format("batchRows: {}", batchRows));
+    auto task = AssertQueryBuilder(plan)
+                    .config(
+                        core::QueryConfig::kPreferredOutputBatchRows,
+                        std::to_string(batchRows))
+                    .assertResults(expected);
+    auto stats = exec::toPlanStats(task->taskStats());
+    ASSERT_EQ(expected->size(), stats.at(unnestId).outputRows);
+    ASSERT_EQ(
+        (expected->size() + batchRows - 1) / batchRows,
+        stats.at(unnestId).outputVectors);
+  }
+}
@@ -115,4 +115,21 @@ TEST_F(ValuesTest, valuesWithRepeatAndParallelism) {
           {input_, input2_, input_, input2_, input_, input2_, input_, input2_});
 }
 
+TEST_F(ValuesTest, compactStringBuffers) {
+  // Each row of 'sliced' references the string buffers of the whole input.
+  auto data = makeRowVector({makeFlatVector<std::string>(
+      10'000, [](auto row) { return std::string(30, 'a' + row % 26); })});
+  auto sliced = std::static_pointer_cast<RowVector>(data->slice(0, 10));
+  auto plan = PlanBuilder().values({sliced}).planNode();
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kMinLiveStringBufferPct, "50")
+      .assertResults({sliced});
+
+  auto parallelPlan = PlanBuilder().values({sliced}, true).planNode();
+  AssertQueryBuilder(parallelPlan)
+      .config(core::QueryConfig::kMinLiveStringBufferPct, "50")
+      .maxDrivers(2)
+      .assertResults({sliced, sliced});
+}
+
 } // namespace facebook::velox::exec::test
@@ -364,6 +364,46 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+TEST_F(VectorHasherTest, runs) {
+  // Runs of 10 rows over a base that is larger than the selected rows, e.g.
+  // a dictionary over sorted data, and the same data as a SequenceVector.
+  auto base = makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  auto indices = makeIndices(100, [](auto row) { return row / 10 * 7; });
+  auto nulls = makeNulls(100, [](auto row) { return row / 10 == 3; });
+  auto dictionary = BaseVector::wrapInDictionary(nulls, indices, 100, base);
+
+  std::vector<std::optional<int64_t>> data;
+  for (auto i = 0; i < 100; ++i) {
+    data.push_back(dictionary->isNullAt(i)
+                       ? std::nullopt
+                       : std::optional<int64_t>(i / 10 * 7));
+  }
+  VectorPtr sequence = vectorMaker_.sequenceVector<int64_t>(data);
+
+  for (const auto& vector : {dictionary, sequence}) {
+    auto hasher = exec::VectorHasher::create(BIGINT(), 0);
+    raw_vector<uint64_t> hashes(100);
+    hasher->decode(*vector, allRows_);
+    hasher->hash(allRows_, false, hashes);
+    for (auto i = 0; i < 100; ++i) {
+      const auto expected = data[i].has_value()
+          ? folly::hasher<int64_t>()(data[i].value())
+          : exec::VectorHasher::kNullHash;
+      ASSERT_EQ(hashes[i], expected) << "at " << i;
+    }
+
+    raw_vector<uint64_t> ids(100);
+    ASSERT_FALSE(hasher->computeValueIds(allRows_, ids));
+    hasher->enableValueRange(1, 0);
+    hasher->decode(*vector, allRows_);
+    ASSERT_TRUE(hasher->computeValueIds(allRows_, ids));
+    for (auto i = 0; i < 100; ++i) {
+      ASSERT_EQ(ids[i], data[i].has_value() ? data[i].value() + 1 : 0)
+          << "at " << i;
+    }
+  }
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
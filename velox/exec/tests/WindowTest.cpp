@@ -79,6 +79,100 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, spillSortedInput) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key. The input is sorted by partition key and each
+          // partition spans several input batches.
+          makeFlatVector<int16_t>(size, [](auto row) { return row / 300; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 3; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "rank() over (partition by p order by s)",
+      "lag(d, 2) over (partition by p order by s)",
+      "sum(d) over (partition by p order by s "
+      "rows between 5 preceding and current row)",
+      "min(d) over (partition by p order by s)",
+  };
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .streamingWindow(functions)
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kWindowSpillEnabled, "true")
+          .spillDirectory(spillDirectory->getPath())
+          .assertResults(fmt::format(
+              "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at(windowId);
+
+  ASSERT_GT(stats.spilledBytes, 0);
+  ASSERT_GT(stats.spilledRows, 0);
+  ASSERT_GT(stats.spilledFiles, 0);
+}
+
+TEST_F(WindowTest, partitionAcrossDrivers) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 11; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row % 97; }),
+      });
+
+  createDuckDbTable({data});
+
+  // Each of the 4 drivers reads all the input, so each window partition has
+  // rows from all the drivers.
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 10), true)
+                  .window(
+                      {"rank() over (partition by p order by s)",
+                       "sum(d) over (partition by p order by s)"})
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .maxDrivers(4)
+          .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+          .config(core::QueryConfig::kWindowPartitionAcrossDrivers, "true")
+          .assertResults(
+              "SELECT *, rank() over (partition by p order by s), "
+              "sum(d) over (partition by p order by s) FROM "
+              "(SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+              "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp)");
+
+  auto planStats = toPlanStats(task->taskStats()).at(windowId);
+  const auto& partitionStats =
+      planStats.customStats.at("windowPartitionsAcrossDrivers");
+  ASSERT_EQ(partitionStats.count, 4);
+  ASSERT_EQ(partitionStats.sum, 11);
+  ASSERT_EQ(planStats.outputRows, 4 * size);
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -273,6 +273,11 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& fileProperties(FileProperties properties) {
+    properties_ = properties;
+    return *this;
+  }
+
   HiveConnectorSplitBuilder& connectorId(const std::string& connectorId) {
     connectorId_ = connectorId;
     return *this;
@@ -295,7 +300,7 @@ class HiveConnectorSplitBuilder {
         serdeParameters,
         splitWeight_,
         infoColumns_,
-        std::nullopt);
+        properties_);
   }
 
  private:
@@ -309,6 +314,7 @@ class HiveConnectorSplitBuilder {
   std::shared_ptr<std::string> extraFileInfo_ = {};
   std::unordered_map<std::string, std::string> serdeParameters_ = {};
   std::unordered_map<std::string, std::string> infoColumns_ = {};
+  std::optional<FileProperties> properties_;
   std::string connectorId_ = kHiveConnectorId;
   int64_t splitWeight_{0};
 };
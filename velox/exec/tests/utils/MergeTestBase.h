@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <limits>
 #include <optional>
 
 namespace facebook::velox::exec::test {
@@ -79,6 +80,25 @@ class TestingStream final : public MergeStream {
     currentValid_ = false;
   }
 
+  // Removes the first 'numRows' values.
+  void pop(int32_t numRows) {
+    numbers_.resize(numbers_.size() - numRows);
+    currentValid_ = false;
+  }
+
+  // Returns the number of leading values which are not greater than the first
+  // value of 'other', capped at 'maxRows'. All of them if 'other' is null.
+  int32_t numRunRows(const TestingStream* other, int32_t maxRows) const {
+    const auto numRows = std::min<int32_t>(maxRows, numbers_.size());
+    if (other == nullptr) {
+      return numRows;
+    }
+    const auto otherValue = other->current()->value();
+    return mergeRunLength(numRows, [&](int32_t row) {
+      return numbers_[numbers_.size() - 1 - row] <= otherValue;
+    });
+  }
+
   bool operator<(const MergeStream& other) const final {
     return current_.value() <
         static_cast<const TestingStream&>(other).current_.value();
@@ -146,6 +166,28 @@ class MergeTestBase {
     return data;
   }
 
+  // Makes 'numRuns' sorted streams totalling 'numValues' entries. The globally
+  // sorted values are dealt out to the streams in chunks of 'runLength'
+  // consecutive values, so that a stream wins 'runLength' times in a row.
+  TestData makeTestData(int32_t numValues, int32_t numRuns, int32_t runLength) {
+    TestData data;
+    data.data.reserve(numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      data.data.push_back(folly::Random::rand32(rng_));
+    }
+    std::sort(data.data.begin(), data.data.end());
+
+    std::vector<std::vector<uint32_t>> runs(numRuns);
+    for (auto i = 0; i < numValues; ++i) {
+      runs[(i / runLength) % numRuns].push_back(data.data[i]);
+    }
+    for (auto& run : runs) {
+      std::reverse(run.begin(), run.end());
+      data.sources.push_back(std::make_unique<TestingStream>(std::move(run)));
+    }
+    return data;
+  }
+
   // Reads the data in 'testData.runs' using the merging class MergeType. Checks
   // that the results match the globally sorted data in 'testData' if check is
   // true.
@@ -175,6 +217,39 @@ class MergeTestBase {
     }
   }
 
+  // Same as test() but consumes the runs of values from the winning stream
+  // which are not greater than the first value of the runner-up at once.
+  template <typename MergeType>
+  static void testRuns(const TestData& testData, bool check) {
+    std::vector<std::unique_ptr<TestingStream>> sources;
+    for (auto& source : testData.sources) {
+      sources.push_back(std::make_unique<TestingStream>(*source));
+    }
+    MergeType merge(std::move(sources));
+    size_t numValues = 0;
+    for (;;) {
+      auto [source, runnerUp] = merge.nextWithRunnerUp();
+      if (source == nullptr) {
+        break;
+      }
+      const auto numRows =
+          source->numRunRows(runnerUp, std::numeric_limits<int32_t>::max());
+      if (check) {
+        ASSERT_GT(numRows, 0);
+        for (auto i = 0; i < numRows; ++i) {
+          ASSERT_LT(numValues, testData.data.size());
+          ASSERT_EQ(source->current()->value(), testData.data[numValues++]);
+          source->pop();
+        }
+      } else {
+        source->pop(numRows);
+      }
+    }
+    if (check) {
+      ASSERT_EQ(numValues, testData.data.size());
+    }
+  }
+
  protected:
   folly::Random::DefaultGenerator rng_;
 };
@@ -589,20 +589,17 @@ class AggregateTypeResolver {
 
 } // namespace
 
-core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
+std::vector<core::AggregationNode::Aggregate> PlanBuilder::mergeAggregates(
     core::AggregationNode::Step step,
     const core::AggregationNode* partialAggNode) {
-  // Create intermediate or final aggregation using same grouping keys and same
+  // Merge the intermediate results of the partial aggregates using the same
   // aggregate function names.
   const auto& partialAggregates = partialAggNode->aggregates();
-  const auto& groupingKeys = partialAggNode->groupingKeys();
-
-  auto numAggregates = partialAggregates.size();
-  auto numGroupingKeys = groupingKeys.size();
+  const auto& aggregateNames = partialAggNode->aggregateNames();
 
   std::vector<core::AggregationNode::Aggregate> aggregates;
-  aggregates.reserve(numAggregates);
-  for (auto i = 0; i < numAggregates; i++) {
+  aggregates.reserve(partialAggregates.size());
+  for (auto i = 0; i < partialAggregates.size(); i++) {
     // Resolve final or intermediate aggregation result type using raw input
     // types for the partial aggregation.
     auto name = partialAggregates[i].call->name();
@@ -615,7 +612,7 @@ core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
 
     auto type =
         resolveAggregateType(name, step, aggregate.rawInputTypes, false);
-    std::vector<core::TypedExprPtr> inputs = {field(numGroupingKeys + i)};
+    std::vector<core::TypedExprPtr> inputs = {field(aggregateNames[i])};
 
     // Add lambda inputs.
     for (const auto& rawInput : rawInputs) {
@@ -628,14 +625,21 @@ core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
         std::make_shared<core::CallTypedExpr>(type, std::move(inputs), name);
     aggregates.emplace_back(aggregate);
   }
+  return aggregates;
+}
 
+core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
+    core::AggregationNode::Step step,
+    const core::AggregationNode* partialAggNode) {
+  // Create intermediate or final aggregation using same grouping keys and same
+  // aggregate function names.
   return std::make_shared<core::AggregationNode>(
       nextPlanNodeId(),
       step,
-      groupingKeys,
+      partialAggNode->groupingKeys(),
       partialAggNode->preGroupedKeys(),
       partialAggNode->aggregateNames(),
-      aggregates,
+      mergeAggregates(step, partialAggNode),
       partialAggNode->ignoreNullKeys(),
       planNode_);
 }
@@ -908,6 +912,75 @@ PlanBuilder& PlanBuilder::groupId(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    std::string groupIdName) {
+  // Aggregate the input on the union of the grouping keys first. Keys that
+  // are aliases of the same input column are grouped on once.
+  std::vector<std::string> inputKeys;
+  for (const auto& groupingKey : groupingKeys) {
+    auto untypedExpr = parse::parseExpr(groupingKey, options_);
+    const auto* fieldAccessExpr =
+        dynamic_cast<const core::FieldAccessExpr*>(untypedExpr.get());
+    VELOX_USER_CHECK(
+        fieldAccessExpr,
+        "Grouping key {} is not valid projection",
+        groupingKey);
+    const auto& inputField = fieldAccessExpr->getFieldName();
+    if (std::find(inputKeys.begin(), inputKeys.end(), inputField) ==
+        inputKeys.end()) {
+      inputKeys.push_back(inputField);
+    }
+  }
+  partialAggregation(inputKeys, aggregates);
+  const auto partialAggNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+
+  // Replicate the groups, not the input rows, once per grouping set.
+  groupId(
+      groupingKeys,
+      groupingSets,
+      partialAggNode->aggregateNames(),
+      std::move(groupIdName));
+  const auto groupIdNode =
+      std::dynamic_pointer_cast<const core::GroupIdNode>(planNode_);
+
+  // Roll the groups of each grouping set up from the pre-aggregated groups.
+  std::vector<core::FieldAccessTypedExprPtr> finalKeys;
+  for (const auto& keyInfo : groupIdNode->groupingKeyInfos()) {
+    finalKeys.push_back(field(keyInfo.output));
+  }
+  // GroupId is the last column of the GroupIdNode.
+  finalKeys.push_back(field(groupIdNode->outputType()->names().back()));
+
+  std::vector<vector_size_t> globalGroupingSets;
+  for (auto i = 0; i < groupingSets.size(); i++) {
+    if (groupingSets[i].empty()) {
+      globalGroupingSets.push_back(i);
+    }
+  }
+  std::optional<core::FieldAccessTypedExprPtr> groupIdField;
+  if (!globalGroupingSets.empty()) {
+    groupIdField = finalKeys.back();
+  }
+
+  const auto step = core::AggregationNode::Step::kFinal;
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      step,
+      finalKeys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      partialAggNode->aggregateNames(),
+      mergeAggregates(step, partialAggNode.get()),
+      globalGroupingSets,
+      groupIdField,
+      false,
+      planNode_);
+  return *this;
+}
+
 namespace {
 core::PlanNodePtr createLocalMergeNode(
     const core::PlanNodeId& id,
@@ -1788,15 +1861,26 @@ PlanBuilder& PlanBuilder::topNRowNumber(
     const std::vector<std::string>& sortingKeys,
     int32_t limit,
     bool generateRowNumber) {
+  return topNRank(
+      "row_number", partitionKeys, sortingKeys, limit, generateRowNumber);
+}
+
+PlanBuilder& PlanBuilder::topNRank(
+    std::string_view function,
+    const std::vector<std::string>& partitionKeys,
+    const std::vector<std::string>& sortingKeys,
+    int32_t limit,
+    bool generateRank) {
   VELOX_CHECK_NOT_NULL(planNode_, "TopNRowNumber cannot be the source node");
   auto [sortingFields, sortingOrders] =
       parseOrderByClauses(sortingKeys, planNode_->outputType(), pool_);
   std::optional<std::string> rowNumberColumnName;
-  if (generateRowNumber) {
-    rowNumberColumnName = "row_number";
+  if (generateRank) {
+    rowNumberColumnName = std::string(function);
   }
   planNode_ = std::make_shared<core::TopNRowNumberNode>(
       nextPlanNodeId(),
+      core::TopNRowNumberNode::rankFunctionFromName(function),
       fields(partitionKeys),
       sortingFields,
       sortingOrders,
@@ -644,6 +644,25 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Add a grouping sets aggregation that aggregates the input once on the
+  /// union of 'groupingKeys' and then replicates the resulting groups, not
+  /// the input rows, once per grouping set. Produces a partial
+  /// AggregationNode, a GroupIdNode over its output and a final
+  /// AggregationNode on the grouping keys and the group id. The output has
+  /// the grouping keys, the group id and the aggregates.
+  ///
+  /// Equivalent to groupId(groupingKeys, groupingSets, inputs) followed by
+  /// singleAggregation(keys + group id, aggregates) but costs one
+  /// aggregation of the input plus one per grouping set over the
+  /// pre-aggregated groups. For example, CUBE over 4 keys hashes each input
+  /// row once instead of 16 times. Masks and aggregates without
+  /// intermediate results are not supported.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      std::string groupIdName = "group_id");
+
   /// Add an ExpandNode using specified projections. See comments for
   /// ExpandNode class for description of this plan node.
   ///
@@ -947,6 +966,17 @@ class PlanBuilder {
       int32_t limit,
       bool generateRowNumber);
 
+  /// Add a TopNRowNumberNode to compute single ranking window function with a
+  /// limit applied to sorted partitions.
+  /// @param function One of 'row_number', 'rank' or 'dense_rank'. The output
+  /// column, if generated, is named after the function.
+  PlanBuilder& topNRank(
+      std::string_view function,
+      const std::vector<std::string>& partitionKeys,
+      const std::vector<std::string>& sortingKeys,
+      int32_t limit,
+      bool generateRank);
+
   /// Add a MarkDistinctNode to compute aggregate mask channel
   /// @param markerKey Name of output mask channel
   /// @param distinctKeys List of columns to be marked distinct.
@@ -1043,6 +1073,12 @@ class PlanBuilder {
       core::AggregationNode::Step step,
       const core::AggregationNode* partialAggNode);
 
+  // Returns the aggregates of 'step' that merge the intermediate results of
+  // the aggregates of 'partialAggNode'.
+  std::vector<core::AggregationNode::Aggregate> mergeAggregates(
+      core::AggregationNode::Step step,
+      const core::AggregationNode* partialAggNode);
+
   struct AggregatesAndNames {
     std::vector<core::AggregationNode::Aggregate> aggregates;
     std::vector<std::string> names;
@@ -0,0 +1,3278 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+#include <fstream>
+
+namespace facebook::velox::exec::test {
+
+namespace {
+
+// Projections of boolean columns that place the number of days in 'lag' in
+// the buckets of Q50, Q62 and Q99.
+std::vector<std::string> lagBuckets(
+    std::vector<std::string> columns,
+    const std::string& lag) {
+  columns.push_back(fmt::format("{} <= 30 AS is_30", lag));
+  columns.push_back(
+      fmt::format("{0} > 30 AND {0} <= 60 AS is_31_60", lag));
+  columns.push_back(
+      fmt::format("{0} > 60 AND {0} <= 90 AS is_61_90", lag));
+  columns.push_back(
+      fmt::format("{0} > 90 AND {0} <= 120 AS is_91_120", lag));
+  columns.push_back(fmt::format("{} > 120 AS is_over_120", lag));
+  return columns;
+}
+
+// Aggregates that count the rows in each bucket of lagBuckets().
+const std::vector<std::string> kLagCounts = {
+    "count_if(is_30) AS days_30",
+    "count_if(is_31_60) AS days_31_60",
+    "count_if(is_61_90) AS days_61_90",
+    "count_if(is_91_120) AS days_91_120",
+    "count_if(is_over_120) AS days_over_120"};
+
+const std::string kDemographicsFilter =
+    "cd_gender = 'M' AND cd_marital_status = 'S' "
+    "AND cd_education_status = 'College'";
+} // namespace
+
+void TpcdsQueryBuilder::readFileSchema(
+    const std::string& tableName,
+    const std::string& filePath,
+    const std::vector<std::string>& columns) {
+  dwio::common::ReaderOptions readerOptions{pool_.get()};
+  readerOptions.setFileFormat(format_);
+  auto uniqueReadFile =
+      filesystems::getFileSystem(filePath, nullptr)->openFileForRead(filePath);
+  std::shared_ptr<ReadFile> readFile;
+  readFile.reset(uniqueReadFile.release());
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      readFile, readerOptions.memoryPool());
+  std::unique_ptr<dwio::common::Reader> reader =
+      dwio::common::getReaderFactory(readerOptions.fileFormat())
+          ->createReader(std::move(input), readerOptions);
+  const auto fileType = reader->rowType();
+  const auto fileColumnNames = fileType->names();
+  // There can be extra columns in the file towards the end.
+  VELOX_CHECK_GE(fileColumnNames.size(), columns.size());
+  std::unordered_map<std::string, std::string> fileColumnNamesMap(
+      columns.size());
+  std::transform(
+      columns.begin(),
+      columns.end(),
+      fileColumnNames.begin(),
+      std::inserter(fileColumnNamesMap, fileColumnNamesMap.begin()),
+      [](std::string a, std::string b) { return std::make_pair(a, b); });
+  auto columnNames = columns;
+  auto types = fileType->children();
+  types.resize(columnNames.size());
+  tableMetadata_[tableName].type =
+      std::make_shared<RowType>(std::move(columnNames), std::move(types));
+  tableMetadata_[tableName].fileColumnNames = std::move(fileColumnNamesMap);
+}
+
+void TpcdsQueryBuilder::initialize(const std::string& dataPath) {
+  for (const auto& [tableName, columns] : kTables_) {
+    const fs::path tablePath{dataPath + "/" + tableName};
+    std::error_code error;
+    bool anyFound = false;
+    for (auto const& dirEntry : fs::directory_iterator{
+             tablePath, std::filesystem::directory_options(), error}) {
+      if (!dirEntry.is_regular_file()) {
+        continue;
+      }
+      // Ignore hidden files.
+      if (dirEntry.path().filename().c_str()[0] == '.') {
+        continue;
+      }
+      if (tableMetadata_[tableName].dataFiles.empty()) {
+        anyFound = true;
+        readFileSchema(tableName, dirEntry.path().string(), columns);
+      }
+      tableMetadata_[tableName].dataFiles.push_back(dirEntry.path());
+    }
+    if (!anyFound && error) {
+      std::ifstream file(tablePath);
+      std::string line;
+      while (std::getline(file, line)) {
+        if (tableMetadata_[tableName].dataFiles.empty()) {
+          readFileSchema(tableName, line, columns);
+        }
+        tableMetadata_[tableName].dataFiles.push_back(line);
+      }
+    }
+  }
+}
+
+const std::vector<int>& TpcdsQueryBuilder::getQueryIds() {
+  static const std::vector<int> kQueryIds = {
+      3,  6,  7,  12, 13, 15, 19, 20, 22, 26, 27, 29, 34,
+      36, 37, 42, 43, 46, 48, 50, 52, 53, 55, 62, 63, 65,
+      73, 79, 82, 84, 89, 90, 91, 93, 96, 98, 99};
+  return kQueryIds;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  TpcdsPlan plan;
+  switch (queryId) {
+    case 3:
+      plan = getQ3Plan();
+      break;
+    case 6:
+      plan = getQ6Plan();
+      break;
+    case 7:
+      plan = getQ7Plan();
+      break;
+    case 12:
+      plan = getQ12Plan();
+      break;
+    case 13:
+      plan = getQ13Plan();
+      break;
+    case 15:
+      plan = getQ15Plan();
+      break;
+    case 19:
+      plan = getQ19Plan();
+      break;
+    case 20:
+      plan = getQ20Plan();
+      break;
+    case 22:
+      plan = getQ22Plan();
+      break;
+    case 26:
+      plan = getQ26Plan();
+      break;
+    case 27:
+      plan = getQ27Plan();
+      break;
+    case 29:
+      plan = getQ29Plan();
+      break;
+    case 34:
+      plan = getQ34Plan();
+      break;
+    case 36:
+      plan = getQ36Plan();
+      break;
+    case 37:
+      plan = getQ37Plan();
+      break;
+    case 42:
+      plan = getQ42Plan();
+      break;
+    case 43:
+      plan = getQ43Plan();
+      break;
+    case 46:
+      plan = getQ46Plan();
+      break;
+    case 48:
+      plan = getQ48Plan();
+      break;
+    case 50:
+      plan = getQ50Plan();
+      break;
+    case 52:
+      plan = getQ52Plan();
+      break;
+    case 53:
+      plan = getQ53Plan();
+      break;
+    case 55:
+      plan = getQ55Plan();
+      break;
+    case 62:
+      plan = getQ62Plan();
+      break;
+    case 63:
+      plan = getQ63Plan();
+      break;
+    case 65:
+      plan = getQ65Plan();
+      break;
+    case 73:
+      plan = getQ73Plan();
+      break;
+    case 79:
+      plan = getQ79Plan();
+      break;
+    case 82:
+      plan = getQ82Plan();
+      break;
+    case 84:
+      plan = getQ84Plan();
+      break;
+    case 89:
+      plan = getQ89Plan();
+      break;
+    case 90:
+      plan = getQ90Plan();
+      break;
+    case 91:
+      plan = getQ91Plan();
+      break;
+    case 93:
+      plan = getQ93Plan();
+      break;
+    case 96:
+      plan = getQ96Plan();
+      break;
+    case 98:
+      plan = getQ98Plan();
+      break;
+    case 99:
+      plan = getQ99Plan();
+      break;
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+  plan.dataFileFormat = format_;
+  return plan;
+}
+
+PlanBuilder TpcdsQueryBuilder::scan(
+    const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+    TpcdsPlan& plan,
+    const std::string& tableName,
+    const std::vector<std::string>& columns,
+    const std::vector<std::string>& subfieldFilters,
+    const std::string& remainingFilter) const {
+  core::PlanNodeId scanId;
+  PlanBuilder builder(planNodeIdGenerator, pool_.get());
+  builder
+      .tableScan(
+          tableName,
+          getRowType(tableName, columns),
+          getFileColumnNames(tableName),
+          subfieldFilters,
+          remainingFilter)
+      .capturePlanNodeId(scanId);
+  plan.dataFiles[scanId] = getTableFilePaths(tableName);
+  return builder;
+}
+
+std::string TpcdsQueryBuilder::dateBetween(
+    const std::string& tableName,
+    const std::string& column,
+    const std::string& lowerBound,
+    const std::string& upperBound) const {
+  // DWRF does not support Date type and Varchar is used.
+  const bool isDwrf =
+      tableMetadata_.at(tableName).type->findChild(column)->isVarchar();
+  const auto* suffix = isDwrf ? "" : "::DATE";
+  return fmt::format(
+      "{} between '{}'{} and '{}'{}",
+      column,
+      lowerBound,
+      suffix,
+      upperBound,
+      suffix);
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ3Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   {"d_moy = 11"})
+                   .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"},
+                   {"i_manufact_id = 128"})
+                   .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"ss_sold_date_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand_id", "i_brand"},
+              {"sum(ss_ext_sales_price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"d_year", "sum_agg DESC", "i_brand_id"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ6Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  // The month of the query as a distinct d_month_seq.
+  auto month = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_month_seq", "d_year", "d_moy"},
+                   {"d_year = 2001", "d_moy = 1"})
+                   .partialAggregation({"d_month_seq"}, {})
+                   .localPartition(std::vector<std::string>{})
+                   .finalAggregation()
+                   .project({"d_month_seq AS month_seq"})
+                   .planNode();
+  auto dates =
+      scan(planNodeIdGenerator, plan, kDateDim, {"d_date_sk", "d_month_seq"})
+          .hashJoin({"d_month_seq"}, {"month_seq"}, month, "", {"d_date_sk"})
+          .planNode();
+  // The correlated average price of the category of an item.
+  auto categoryPrices =
+      scan(planNodeIdGenerator, plan, kItem, {"i_category", "i_current_price"})
+          .partialAggregation(
+              {"i_category"}, {"avg(i_current_price) AS avg_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project({"i_category AS avg_category", "avg_price"})
+          .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk", "i_category", "i_current_price"})
+                   .hashJoin(
+                       {"i_category"},
+                       {"avg_category"},
+                       categoryPrices,
+                       "i_current_price > 1.2 * avg_price",
+                       {"i_item_sk"})
+                   .planNode();
+  auto addresses = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomerAddress,
+                       {"ca_address_sk", "ca_state"})
+                       .planNode();
+  auto customers = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomer,
+                       {"c_customer_sk", "c_current_addr_sk"})
+                       .hashJoin(
+                           {"c_current_addr_sk"},
+                           {"ca_address_sk"},
+                           addresses,
+                           "",
+                           {"c_customer_sk", "ca_state"})
+                       .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_customer_sk"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk", "ss_customer_sk"})
+          .hashJoin(
+              {"ss_item_sk"}, {"i_item_sk"}, items, "", {"ss_customer_sk"})
+          .hashJoin(
+              {"ss_customer_sk"},
+              {"c_customer_sk"},
+              customers,
+              "",
+              {"ca_state"})
+          .partialAggregation({"ca_state"}, {"count(0) AS cnt"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .filter("cnt >= 10")
+          .topN({"cnt", "ca_state"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ7Plan() const {
+  return getPromotionAveragesPlan(kStoreSales, "ss_", "ss_cdemo_sk");
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ12Plan() const {
+  return getItemRevenueRatioPlan(kWebSales, "ws_", 100);
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ13Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto stores =
+      scan(planNodeIdGenerator, plan, kStore, {"s_store_sk"}).planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year"},
+                   {"d_year = 2001"})
+                   .planNode();
+  auto demographics =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kCustomerDemographics,
+          {"cd_demo_sk", "cd_marital_status", "cd_education_status"},
+          {"cd_marital_status in ('M', 'S', 'W')"})
+          .planNode();
+  auto households = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kHouseholdDemographics,
+                        {"hd_demo_sk", "hd_dep_count"},
+                        {"hd_dep_count in (1, 3)"})
+                        .planNode();
+  auto addresses = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomerAddress,
+                       {"ca_address_sk", "ca_country", "ca_state"},
+                       {"ca_country = 'United States'",
+                        "ca_state in ('TX', 'OH', 'OR', 'NM', 'KY', 'VA', "
+                        "'MS')"})
+                       .planNode();
+  const std::string demographicsFilter =
+      "(cd_marital_status = 'M' AND cd_education_status = 'Advanced Degree' "
+      "AND ss_sales_price BETWEEN 100.0 AND 150.0 AND hd_dep_count = 3) "
+      "OR (cd_marital_status = 'S' AND cd_education_status = 'College' "
+      "AND ss_sales_price BETWEEN 50.0 AND 100.0 AND hd_dep_count = 1) "
+      "OR (cd_marital_status = 'W' AND cd_education_status = '2 yr Degree' "
+      "AND ss_sales_price BETWEEN 150.0 AND 200.0 AND hd_dep_count = 1)";
+  const std::string addressFilter =
+      "(ca_state IN ('TX', 'OH') AND ss_net_profit BETWEEN 100.0 AND 200.0) "
+      "OR (ca_state IN ('OR', 'NM', 'KY') "
+      "AND ss_net_profit BETWEEN 150.0 AND 300.0) "
+      "OR (ca_state IN ('VA', 'TX', 'MS') "
+      "AND ss_net_profit BETWEEN 50.0 AND 250.0)";
+  const std::vector<std::string> measures = {
+      "ss_quantity",
+      "ss_sales_price",
+      "ss_ext_sales_price",
+      "ss_ext_wholesale_cost",
+      "ss_net_profit"};
+  auto withKeys = [&](std::vector<std::string> keys) {
+    keys.insert(keys.end(), measures.begin(), measures.end());
+    return keys;
+  };
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          withKeys(
+              {"ss_sold_date_sk",
+               "ss_store_sk",
+               "ss_cdemo_sk",
+               "ss_hdemo_sk",
+               "ss_addr_sk"}),
+          {"ss_sales_price between 50.0 and 200.0",
+           "ss_net_profit between 50.0 and 300.0"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              withKeys(
+                  {"ss_sold_date_sk",
+                   "ss_cdemo_sk",
+                   "ss_hdemo_sk",
+                   "ss_addr_sk"}))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              withKeys({"ss_cdemo_sk", "ss_hdemo_sk", "ss_addr_sk"}))
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              withKeys(
+                  {"ss_hdemo_sk",
+                   "ss_addr_sk",
+                   "cd_marital_status",
+                   "cd_education_status"}))
+          .hashJoin(
+              {"ss_hdemo_sk"},
+              {"hd_demo_sk"},
+              households,
+              demographicsFilter,
+              withKeys({"ss_addr_sk"}))
+          .hashJoin(
+              {"ss_addr_sk"},
+              {"ca_address_sk"},
+              addresses,
+              addressFilter,
+              measures)
+          .partialAggregation(
+              {},
+              {"avg(ss_quantity) AS avg_quantity",
+               "avg(ss_ext_sales_price) AS avg_ext_sales_price",
+               "avg(ss_ext_wholesale_cost) AS avg_ext_wholesale_cost",
+               "sum(ss_ext_wholesale_cost) AS sum_ext_wholesale_cost"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ15Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto addresses = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomerAddress,
+                       {"ca_address_sk", "ca_zip", "ca_state"})
+                       .planNode();
+  auto customers = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomer,
+                       {"c_customer_sk", "c_current_addr_sk"})
+                       .hashJoin(
+                           {"c_current_addr_sk"},
+                           {"ca_address_sk"},
+                           addresses,
+                           "",
+                           {"c_customer_sk", "ca_zip", "ca_state"})
+                       .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_qoy"},
+                   {"d_qoy = 2", "d_year = 2001"})
+                   .planNode();
+  const std::string customerFilter =
+      "substr(ca_zip, 1, 5) IN ('85669', '86197', '88274', '83405', '86475', "
+      "'85392', '85460', '80348', '81792') "
+      "OR ca_state IN ('CA', 'WA', 'GA') OR cs_sales_price > 500.0";
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kCatalogSales,
+          {"cs_sold_date_sk", "cs_bill_customer_sk", "cs_sales_price"})
+          .hashJoin(
+              {"cs_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"cs_bill_customer_sk", "cs_sales_price"})
+          .hashJoin(
+              {"cs_bill_customer_sk"},
+              {"c_customer_sk"},
+              customers,
+              customerFilter,
+              {"ca_zip", "cs_sales_price"})
+          .partialAggregation({"ca_zip"}, {"sum(cs_sales_price) AS sales"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"ca_zip"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ19Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   {"d_moy = 11", "d_year = 1998"})
+                   .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk",
+                    "i_brand_id",
+                    "i_brand",
+                    "i_manufact_id",
+                    "i_manufact",
+                    "i_manager_id"},
+                   {"i_manager_id = 8"})
+                   .planNode();
+  auto addresses = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomerAddress,
+                       {"ca_address_sk", "ca_zip"})
+                       .planNode();
+  auto customers = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomer,
+                       {"c_customer_sk", "c_current_addr_sk"})
+                       .hashJoin(
+                           {"c_current_addr_sk"},
+                           {"ca_address_sk"},
+                           addresses,
+                           "",
+                           {"c_customer_sk", "ca_zip"})
+                       .planNode();
+  auto stores =
+      scan(planNodeIdGenerator, plan, kStore, {"s_store_sk", "s_zip"})
+          .planNode();
+  const std::vector<std::string> itemColumns = {
+      "i_brand_id", "i_brand", "i_manufact_id", "i_manufact"};
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk",
+           "ss_item_sk",
+           "ss_customer_sk",
+           "ss_store_sk",
+           "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk",
+               "ss_customer_sk",
+               "ss_store_sk",
+               "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"ss_customer_sk",
+               "ss_store_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand",
+               "i_manufact_id",
+               "i_manufact"})
+          .hashJoin(
+              {"ss_customer_sk"},
+              {"c_customer_sk"},
+              customers,
+              "",
+              {"ss_store_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand",
+               "i_manufact_id",
+               "i_manufact",
+               "ca_zip"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "substr(ca_zip, 1, 5) <> substr(s_zip, 1, 5)",
+              {"ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand",
+               "i_manufact_id",
+               "i_manufact"})
+          .partialAggregation(
+              itemColumns, {"sum(ss_ext_sales_price) AS ext_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(
+              {"ext_price DESC",
+               "i_brand",
+               "i_brand_id",
+               "i_manufact_id",
+               "i_manufact"},
+              100,
+              false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ20Plan() const {
+  return getItemRevenueRatioPlan(kCatalogSales, "cs_", 100);
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ22Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_month_seq"},
+                   {"d_month_seq between 1200 and 1211"})
+                   .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk",
+                    "i_product_name",
+                    "i_brand",
+                    "i_class",
+                    "i_category"})
+                   .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kInventory,
+          {"inv_date_sk", "inv_item_sk", "inv_quantity_on_hand"})
+          .hashJoin(
+              {"inv_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"inv_item_sk", "inv_quantity_on_hand"})
+          .hashJoin(
+              {"inv_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_product_name",
+               "i_brand",
+               "i_class",
+               "i_category",
+               "inv_quantity_on_hand"})
+          // rollup(i_product_name, i_brand, i_class, i_category)
+          .groupId(
+              {"i_product_name", "i_brand", "i_class", "i_category"},
+              {{"i_product_name", "i_brand", "i_class", "i_category"},
+               {"i_product_name", "i_brand", "i_class"},
+               {"i_product_name", "i_brand"},
+               {"i_product_name"},
+               {}},
+              {"inv_quantity_on_hand"})
+          .partialAggregation(
+              {"i_product_name",
+               "i_brand",
+               "i_class",
+               "i_category",
+               "group_id"},
+              {"avg(inv_quantity_on_hand) AS qoh"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"i_product_name", "i_brand", "i_class", "i_category", "qoh"})
+          .topN(
+              {"qoh", "i_product_name", "i_brand", "i_class", "i_category"},
+              100,
+              false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ26Plan() const {
+  return getPromotionAveragesPlan(kCatalogSales, "cs_", "cs_bill_cdemo_sk");
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ27Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto demographics =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kCustomerDemographics,
+          {"cd_demo_sk",
+           "cd_gender",
+           "cd_marital_status",
+           "cd_education_status"},
+          {},
+          kDemographicsFilter)
+          .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year"},
+                   {"d_year = 2002"})
+                   .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk", "s_state"},
+                    {"s_state = 'TN'"})
+                    .planNode();
+  auto items =
+      scan(planNodeIdGenerator, plan, kItem, {"i_item_sk", "i_item_id"})
+          .planNode();
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+  auto withKeys = [&](std::vector<std::string> keys) {
+    keys.insert(keys.end(), measures.begin(), measures.end());
+    return keys;
+  };
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          withKeys(
+              {"ss_sold_date_sk", "ss_item_sk", "ss_cdemo_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              withKeys({"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              withKeys({"ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              withKeys({"ss_item_sk", "s_state"}))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              withKeys({"i_item_id", "s_state"}))
+          // rollup(i_item_id, s_state)
+          .groupId(
+              {"i_item_id", "s_state"},
+              {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+              measures)
+          .partialAggregation(
+              {"i_item_id", "s_state", "group_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"i_item_id",
+               "s_state",
+               "if(group_id = 0, 0, 1) AS g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .topN({"i_item_id", "s_state"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ29Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto soldDates = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kDateDim,
+                       {"d_date_sk", "d_year", "d_moy"},
+                       {"d_moy = 9", "d_year = 1999"})
+                       .planNode();
+  auto returnDates = scan(
+                         planNodeIdGenerator,
+                         plan,
+                         kDateDim,
+                         {"d_date_sk", "d_year", "d_moy"},
+                         {"d_moy between 9 and 12", "d_year = 1999"})
+                         .planNode();
+  auto catalogDates = scan(
+                          planNodeIdGenerator,
+                          plan,
+                          kDateDim,
+                          {"d_date_sk", "d_year"},
+                          {"d_year in (1999, 2000, 2001)"})
+                          .planNode();
+  auto returns = scan(
+                     planNodeIdGenerator,
+                     plan,
+                     kStoreReturns,
+                     {"sr_returned_date_sk",
+                      "sr_item_sk",
+                      "sr_customer_sk",
+                      "sr_ticket_number",
+                      "sr_return_quantity"})
+                     .hashJoin(
+                         {"sr_returned_date_sk"},
+                         {"d_date_sk"},
+                         returnDates,
+                         "",
+                         {"sr_item_sk",
+                          "sr_customer_sk",
+                          "sr_ticket_number",
+                          "sr_return_quantity"})
+                     .planNode();
+  auto catalogSales = scan(
+                          planNodeIdGenerator,
+                          plan,
+                          kCatalogSales,
+                          {"cs_sold_date_sk",
+                           "cs_bill_customer_sk",
+                           "cs_item_sk",
+                           "cs_quantity"})
+                          .hashJoin(
+                              {"cs_sold_date_sk"},
+                              {"d_date_sk"},
+                              catalogDates,
+                              "",
+                              {"cs_bill_customer_sk",
+                               "cs_item_sk",
+                               "cs_quantity"})
+                          .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk", "s_store_id", "s_store_name"})
+                    .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk", "i_item_id", "i_item_desc"})
+                   .planNode();
+  const std::vector<std::string> quantities = {
+      "ss_quantity", "sr_return_quantity", "cs_quantity"};
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk",
+           "ss_item_sk",
+           "ss_customer_sk",
+           "ss_store_sk",
+           "ss_ticket_number",
+           "ss_quantity"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              soldDates,
+              "",
+              {"ss_item_sk",
+               "ss_customer_sk",
+               "ss_store_sk",
+               "ss_ticket_number",
+               "ss_quantity"})
+          .hashJoin(
+              {"ss_customer_sk", "ss_item_sk", "ss_ticket_number"},
+              {"sr_customer_sk", "sr_item_sk", "sr_ticket_number"},
+              returns,
+              "",
+              {"ss_item_sk",
+               "ss_customer_sk",
+               "ss_store_sk",
+               "ss_quantity",
+               "sr_return_quantity"})
+          .hashJoin(
+              {"ss_customer_sk", "ss_item_sk"},
+              {"cs_bill_customer_sk", "cs_item_sk"},
+              catalogSales,
+              "",
+              {"ss_item_sk",
+               "ss_store_sk",
+               "ss_quantity",
+               "sr_return_quantity",
+               "cs_quantity"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_item_sk",
+               "s_store_id",
+               "s_store_name",
+               "ss_quantity",
+               "sr_return_quantity",
+               "cs_quantity"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_item_id",
+               "i_item_desc",
+               "s_store_id",
+               "s_store_name",
+               "ss_quantity",
+               "sr_return_quantity",
+               "cs_quantity"})
+          .partialAggregation(
+              {"i_item_id", "i_item_desc", "s_store_id", "s_store_name"},
+              {"sum(ss_quantity) AS store_sales_quantity",
+               "sum(sr_return_quantity) AS store_returns_quantity",
+               "sum(cs_quantity) AS catalog_sales_quantity"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(
+              {"i_item_id", "i_item_desc", "s_store_id", "s_store_name"},
+              100,
+              false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ34Plan() const {
+  return getTicketCountPlan(
+      "(d_dom between 1 and 3) OR (d_dom between 25 and 28)",
+      1.2,
+      "s_county = 'Williamson County'",
+      "cnt between 15 and 20",
+      {"c_last_name",
+       "c_first_name",
+       "c_salutation",
+       "c_preferred_cust_flag DESC",
+       "ss_ticket_number"});
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ36Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year"},
+                   {"d_year = 2001"})
+                   .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk", "s_state"},
+                    {"s_state = 'TN'"})
+                    .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk", "i_category", "i_class"})
+                   .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk",
+           "ss_item_sk",
+           "ss_store_sk",
+           "ss_ext_sales_price",
+           "ss_net_profit"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk",
+               "ss_store_sk",
+               "ss_ext_sales_price",
+               "ss_net_profit"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price", "ss_net_profit"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_category",
+               "i_class",
+               "ss_ext_sales_price",
+               "ss_net_profit"})
+          // rollup(i_category, i_class). The group id is the lochierarchy of
+          // the query.
+          .groupId(
+              {"i_category", "i_class"},
+              {{"i_category", "i_class"}, {"i_category"}, {}},
+              {"ss_ext_sales_price", "ss_net_profit"})
+          .partialAggregation(
+              {"i_category", "i_class", "group_id"},
+              {"sum(ss_net_profit) AS net_profit",
+               "sum(ss_ext_sales_price) AS ext_sales_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          // The classes of a category are ranked within the category. The
+          // categories and the total are ranked among themselves.
+          .project(
+              {"net_profit / ext_sales_price AS gross_margin",
+               "i_category",
+               "i_class",
+               "group_id AS lochierarchy",
+               "if(group_id = 0, i_category, '') AS parent"})
+          .window(
+              {"rank() over (partition by lochierarchy, parent "
+               "order by gross_margin) AS rank_within_parent"})
+          .topN(
+              {"lochierarchy DESC", "parent", "rank_within_parent"}, 100, false)
+          .project(
+              {"gross_margin",
+               "i_category",
+               "i_class",
+               "lochierarchy",
+               "rank_within_parent"})
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ37Plan() const {
+  return getInventoryItemsPlan(
+      kCatalogSales,
+      "cs_item_sk",
+      "i_current_price between 68.0 and 98.0",
+      "2000-02-01",
+      "2000-04-01",
+      "i_manufact_id in (677, 940, 694, 808)");
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ42Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   {"d_moy = 11", "d_year = 2000"})
+                   .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk", "i_category_id", "i_category", "i_manager_id"},
+                   {"i_manager_id = 1"})
+                   .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price", "d_year"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"d_year", "i_category_id", "i_category", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_category_id", "i_category"},
+              {"sum(ss_ext_sales_price) AS sales"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(
+              {"sales DESC", "d_year", "i_category_id", "i_category"},
+              100,
+              false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ43Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_day_name"},
+                   {"d_year = 2000"})
+                   .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk",
+                     "s_store_id",
+                     "s_store_name",
+                     "s_gmt_offset"},
+                    {},
+                    "s_gmt_offset = -5.0")
+                    .planNode();
+  const std::vector<std::pair<std::string, std::string>> days = {
+      {"Sunday", "sun"},
+      {"Monday", "mon"},
+      {"Tuesday", "tue"},
+      {"Wednesday", "wed"},
+      {"Thursday", "thu"},
+      {"Friday", "fri"},
+      {"Saturday", "sat"}};
+  std::vector<std::string> projections = {
+      "s_store_name", "s_store_id", "ss_sales_price"};
+  std::vector<std::string> aggregates;
+  std::vector<std::string> masks;
+  std::vector<std::string> orderBy = {"s_store_name", "s_store_id"};
+  for (const auto& [day, prefix] : days) {
+    // The sum of sales on each day is masked on the day name.
+    projections.push_back(
+        fmt::format("d_day_name = '{}' AS is_{}", day, prefix));
+    aggregates.push_back(
+        fmt::format("sum(ss_sales_price) AS {}_sales", prefix));
+    masks.push_back(fmt::format("is_{}", prefix));
+    orderBy.push_back(fmt::format("{}_sales", prefix));
+  }
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_store_sk", "ss_sales_price"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_store_sk", "ss_sales_price", "d_day_name"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"s_store_name", "s_store_id", "ss_sales_price", "d_day_name"})
+          .project(projections)
+          .partialAggregation({"s_store_name", "s_store_id"}, aggregates, masks)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(orderBy, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ46Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_dow"},
+                   {"d_dow in (6, 0)", "d_year in (1999, 2000, 2001)"})
+                   .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk", "s_city"},
+                    {"s_city in ('Fairview', 'Midway')"})
+                    .planNode();
+  auto households = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kHouseholdDemographics,
+                        {"hd_demo_sk", "hd_dep_count", "hd_vehicle_count"},
+                        {},
+                        "hd_dep_count = 4 OR hd_vehicle_count = 3")
+                        .planNode();
+  auto boughtAddresses = scan(
+                             planNodeIdGenerator,
+                             plan,
+                             kCustomerAddress,
+                             {"ca_address_sk", "ca_city"})
+                             .project(
+                                 {"ca_address_sk AS bought_addr_sk",
+                                  "ca_city AS bought_city"})
+                             .planNode();
+  auto currentAddresses = scan(
+                              planNodeIdGenerator,
+                              plan,
+                              kCustomerAddress,
+                              {"ca_address_sk", "ca_city"})
+                              .planNode();
+  auto customers = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomer,
+                       {"c_customer_sk",
+                        "c_current_addr_sk",
+                        "c_first_name",
+                        "c_last_name"})
+                       .hashJoin(
+                           {"c_current_addr_sk"},
+                           {"ca_address_sk"},
+                           currentAddresses,
+                           "",
+                           {"c_customer_sk",
+                            "c_first_name",
+                            "c_last_name",
+                            "ca_city"})
+                       .planNode();
+  const std::vector<std::string> measures = {"ss_coupon_amt", "ss_net_profit"};
+  auto withKeys = [&](std::vector<std::string> keys) {
+    keys.insert(keys.end(), measures.begin(), measures.end());
+    return keys;
+  };
+  const std::vector<std::string> groupingKeys = {
+      "ss_ticket_number", "ss_customer_sk", "ss_addr_sk", "bought_city"};
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          withKeys(
+              {"ss_sold_date_sk",
+               "ss_store_sk",
+               "ss_hdemo_sk",
+               "ss_addr_sk",
+               "ss_customer_sk",
+               "ss_ticket_number"}))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              withKeys(
+                  {"ss_store_sk",
+                   "ss_hdemo_sk",
+                   "ss_addr_sk",
+                   "ss_customer_sk",
+                   "ss_ticket_number"}))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              withKeys(
+                  {"ss_hdemo_sk",
+                   "ss_addr_sk",
+                   "ss_customer_sk",
+                   "ss_ticket_number"}))
+          .hashJoin(
+              {"ss_hdemo_sk"},
+              {"hd_demo_sk"},
+              households,
+              "",
+              withKeys({"ss_addr_sk", "ss_customer_sk", "ss_ticket_number"}))
+          .hashJoin(
+              {"ss_addr_sk"},
+              {"bought_addr_sk"},
+              boughtAddresses,
+              "",
+              withKeys(groupingKeys))
+          .partialAggregation(
+              groupingKeys,
+              {"sum(ss_coupon_amt) AS amt", "sum(ss_net_profit) AS profit"})
+          .localPartition(groupingKeys)
+          .finalAggregation()
+          .hashJoin(
+              {"ss_customer_sk"},
+              {"c_customer_sk"},
+              customers,
+              "ca_city <> bought_city",
+              {"c_last_name",
+               "c_first_name",
+               "ca_city",
+               "bought_city",
+               "ss_ticket_number",
+               "amt",
+               "profit"})
+          .localPartition(std::vector<std::string>{})
+          .topN(
+              {"c_last_name",
+               "c_first_name",
+               "ca_city",
+               "bought_city",
+               "ss_ticket_number"},
+              100,
+              false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ48Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto stores =
+      scan(planNodeIdGenerator, plan, kStore, {"s_store_sk"}).planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year"},
+                   {"d_year = 2000"})
+                   .planNode();
+  auto demographics =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kCustomerDemographics,
+          {"cd_demo_sk", "cd_marital_status", "cd_education_status"},
+          {"cd_marital_status in ('M', 'D', 'S')"})
+          .planNode();
+  auto addresses = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomerAddress,
+                       {"ca_address_sk", "ca_country", "ca_state"},
+                       {"ca_country = 'United States'",
+                        "ca_state in ('CO', 'OH', 'TX', 'OR', 'MN', 'KY', "
+                        "'VA', 'CA', 'MS')"})
+                       .planNode();
+  const std::string demographicsFilter =
+      "(cd_marital_status = 'M' AND cd_education_status = '4 yr Degree' "
+      "AND ss_sales_price BETWEEN 100.0 AND 150.0) "
+      "OR (cd_marital_status = 'D' AND cd_education_status = '2 yr Degree' "
+      "AND ss_sales_price BETWEEN 50.0 AND 100.0) "
+      "OR (cd_marital_status = 'S' AND cd_education_status = 'College' "
+      "AND ss_sales_price BETWEEN 150.0 AND 200.0)";
+  const std::string addressFilter =
+      "(ca_state IN ('CO', 'OH', 'TX') "
+      "AND ss_net_profit BETWEEN 0.0 AND 2000.0) "
+      "OR (ca_state IN ('OR', 'MN', 'KY') "
+      "AND ss_net_profit BETWEEN 150.0 AND 3000.0) "
+      "OR (ca_state IN ('VA', 'CA', 'MS') "
+      "AND ss_net_profit BETWEEN 50.0 AND 25000.0)";
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk",
+           "ss_store_sk",
+           "ss_cdemo_sk",
+           "ss_addr_sk",
+           "ss_quantity",
+           "ss_sales_price",
+           "ss_net_profit"},
+          {"ss_sales_price between 50.0 and 200.0",
+           "ss_net_profit between 0.0 and 25000.0"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_sold_date_sk",
+               "ss_cdemo_sk",
+               "ss_addr_sk",
+               "ss_quantity",
+               "ss_sales_price",
+               "ss_net_profit"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_cdemo_sk",
+               "ss_addr_sk",
+               "ss_quantity",
+               "ss_sales_price",
+               "ss_net_profit"})
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              demographicsFilter,
+              {"ss_addr_sk", "ss_quantity", "ss_net_profit"})
+          .hashJoin(
+              {"ss_addr_sk"},
+              {"ca_address_sk"},
+              addresses,
+              addressFilter,
+              {"ss_quantity"})
+          .partialAggregation({}, {"sum(ss_quantity) AS quantity"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ50Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto returnDates = scan(
+                         planNodeIdGenerator,
+                         plan,
+                         kDateDim,
+                         {"d_date_sk", "d_year", "d_moy"},
+                         {"d_year = 2001", "d_moy = 8"})
+                         .planNode();
+  auto soldDates =
+      scan(planNodeIdGenerator, plan, kDateDim, {"d_date_sk"}).planNode();
+  auto returns = scan(
+                     planNodeIdGenerator,
+                     plan,
+                     kStoreReturns,
+                     {"sr_returned_date_sk",
+                      "sr_item_sk",
+                      "sr_customer_sk",
+                      "sr_ticket_number"})
+                     .hashJoin(
+                         {"sr_returned_date_sk"},
+                         {"d_date_sk"},
+                         returnDates,
+                         "",
+                         {"sr_returned_date_sk",
+                          "sr_item_sk",
+                          "sr_customer_sk",
+                          "sr_ticket_number"})
+                     .planNode();
+  const std::vector<std::string> storeColumns = {
+      "s_store_name",
+      "s_company_id",
+      "s_street_number",
+      "s_street_name",
+      "s_street_type",
+      "s_suite_number",
+      "s_city",
+      "s_county",
+      "s_state",
+      "s_zip"};
+  std::vector<std::string> storeScanColumns = {"s_store_sk"};
+  storeScanColumns.insert(
+      storeScanColumns.end(), storeColumns.begin(), storeColumns.end());
+  auto stores =
+      scan(planNodeIdGenerator, plan, kStore, storeScanColumns).planNode();
+  auto storeOutput = storeColumns;
+  storeOutput.push_back("ss_sold_date_sk");
+  storeOutput.push_back("sr_returned_date_sk");
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk",
+           "ss_item_sk",
+           "ss_customer_sk",
+           "ss_store_sk",
+           "ss_ticket_number"})
+          .hashJoin(
+              {"ss_ticket_number", "ss_item_sk", "ss_customer_sk"},
+              {"sr_ticket_number", "sr_item_sk", "sr_customer_sk"},
+              returns,
+              "",
+              {"ss_sold_date_sk", "ss_store_sk", "sr_returned_date_sk"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              soldDates,
+              "",
+              {"ss_sold_date_sk", "ss_store_sk", "sr_returned_date_sk"})
+          .hashJoin({"ss_store_sk"}, {"s_store_sk"}, stores, "", storeOutput)
+          .project(
+              lagBuckets(storeColumns, "sr_returned_date_sk - ss_sold_date_sk"))
+          .partialAggregation(storeColumns, kLagCounts)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(storeColumns, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ52Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   {"d_moy = 11", "d_year = 2000"})
+                   .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk", "i_brand_id", "i_brand", "i_manager_id"},
+                   {"i_manager_id = 1"})
+                   .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price", "d_year"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand_id", "i_brand"},
+              {"sum(ss_ext_sales_price) AS ext_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"d_year", "ext_price DESC", "i_brand_id"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ53Plan() const {
+  return getPeriodicSalesPlan(
+      "i_manufact_id",
+      "d_qoy",
+      {"avg_sales", "sum_sales", "i_manufact_id"});
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ55Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   {"d_moy = 11", "d_year = 1999"})
+                   .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk", "i_brand_id", "i_brand", "i_manager_id"},
+                   {"i_manager_id = 28"})
+                   .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"i_brand_id", "i_brand"},
+              {"sum(ss_ext_sales_price) AS ext_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"ext_price DESC", "i_brand_id"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ62Plan() const {
+  return getShippingLagPlan(
+      kWebSales, "ws_", "ws_web_site_sk", kWebSite, "web_site_sk", "web_name");
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ63Plan() const {
+  return getPeriodicSalesPlan(
+      "i_manager_id", "d_moy", {"i_manager_id", "avg_sales", "sum_sales"});
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ65Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  // Revenue of each item in each store in the year. The query uses this
+  // twice.
+  auto storeItemRevenue = [&]() {
+    auto dates = scan(
+                     planNodeIdGenerator,
+                     plan,
+                     kDateDim,
+                     {"d_date_sk", "d_month_seq"},
+                     {"d_month_seq between 1176 and 1187"})
+                     .planNode();
+    return scan(
+               planNodeIdGenerator,
+               plan,
+               kStoreSales,
+               {"ss_sold_date_sk",
+                "ss_store_sk",
+                "ss_item_sk",
+                "ss_sales_price"})
+        .hashJoin(
+            {"ss_sold_date_sk"},
+            {"d_date_sk"},
+            dates,
+            "",
+            {"ss_store_sk", "ss_item_sk", "ss_sales_price"})
+        .partialAggregation(
+            {"ss_store_sk", "ss_item_sk"}, {"sum(ss_sales_price) AS revenue"})
+        .localPartition({"ss_store_sk", "ss_item_sk"})
+        .finalAggregation();
+  };
+  auto storeAverages =
+      storeItemRevenue()
+          .partialAggregation({"ss_store_sk"}, {"avg(revenue) AS ave"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project({"ss_store_sk AS avg_store_sk", "ave"})
+          .planNode();
+  auto stores =
+      scan(planNodeIdGenerator, plan, kStore, {"s_store_sk", "s_store_name"})
+          .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk",
+                    "i_item_desc",
+                    "i_current_price",
+                    "i_wholesale_cost",
+                    "i_brand"})
+                   .planNode();
+  plan.plan =
+      storeItemRevenue()
+          .hashJoin(
+              {"ss_store_sk"},
+              {"avg_store_sk"},
+              storeAverages,
+              "revenue <= 0.1 * ave",
+              {"ss_store_sk", "ss_item_sk", "revenue"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_item_sk", "revenue", "s_store_name"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"s_store_name",
+               "i_item_desc",
+               "revenue",
+               "i_current_price",
+               "i_wholesale_cost",
+               "i_brand"})
+          .localPartition(std::vector<std::string>{})
+          .topN({"s_store_name", "i_item_desc"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ73Plan() const {
+  return getTicketCountPlan(
+      "d_dom between 1 and 2",
+      1.0,
+      "s_county in ('Williamson County', 'Franklin Parish', 'Bronx County', "
+      "'Orange County')",
+      "cnt between 1 and 5",
+      {"cnt DESC", "c_last_name"});
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ79Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_dow"},
+                   {"d_dow = 1", "d_year in (1999, 2000, 2001)"})
+                   .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk", "s_city", "s_number_employees"},
+                    {"s_number_employees between 200 and 295"})
+                    .planNode();
+  auto households = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kHouseholdDemographics,
+                        {"hd_demo_sk", "hd_dep_count", "hd_vehicle_count"},
+                        {},
+                        "hd_dep_count = 6 OR hd_vehicle_count > 2")
+                        .planNode();
+  auto customers = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomer,
+                       {"c_customer_sk", "c_first_name", "c_last_name"})
+                       .planNode();
+  const std::vector<std::string> measures = {"ss_coupon_amt", "ss_net_profit"};
+  auto withKeys = [&](std::vector<std::string> keys) {
+    keys.insert(keys.end(), measures.begin(), measures.end());
+    return keys;
+  };
+  const std::vector<std::string> groupingKeys = {
+      "ss_ticket_number", "ss_customer_sk", "ss_addr_sk", "s_city"};
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          withKeys(
+              {"ss_sold_date_sk",
+               "ss_store_sk",
+               "ss_hdemo_sk",
+               "ss_addr_sk",
+               "ss_customer_sk",
+               "ss_ticket_number"}))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              withKeys(
+                  {"ss_store_sk",
+                   "ss_hdemo_sk",
+                   "ss_addr_sk",
+                   "ss_customer_sk",
+                   "ss_ticket_number"}))
+          .hashJoin(
+              {"ss_hdemo_sk"},
+              {"hd_demo_sk"},
+              households,
+              "",
+              withKeys(
+                  {"ss_store_sk",
+                   "ss_addr_sk",
+                   "ss_customer_sk",
+                   "ss_ticket_number"}))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              withKeys(groupingKeys))
+          .partialAggregation(
+              groupingKeys,
+              {"sum(ss_coupon_amt) AS amt", "sum(ss_net_profit) AS profit"})
+          .localPartition(groupingKeys)
+          .finalAggregation()
+          .hashJoin(
+              {"ss_customer_sk"},
+              {"c_customer_sk"},
+              customers,
+              "",
+              {"c_last_name",
+               "c_first_name",
+               "s_city",
+               "ss_ticket_number",
+               "amt",
+               "profit"})
+          .project(
+              {"c_last_name",
+               "c_first_name",
+               "substr(s_city, 1, 30) AS city",
+               "ss_ticket_number",
+               "amt",
+               "profit"})
+          .localPartition(std::vector<std::string>{})
+          .topN({"c_last_name", "c_first_name", "city", "profit"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ82Plan() const {
+  return getInventoryItemsPlan(
+      kStoreSales,
+      "ss_item_sk",
+      "i_current_price between 62.0 and 92.0",
+      "2000-05-25",
+      "2000-07-24",
+      "i_manufact_id in (129, 270, 821, 423)");
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ84Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto addresses = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomerAddress,
+                       {"ca_address_sk", "ca_city"},
+                       {"ca_city = 'Edgewood'"})
+                       .planNode();
+  auto incomeBands = scan(
+                         planNodeIdGenerator,
+                         plan,
+                         kIncomeBand,
+                         {"ib_income_band_sk",
+                          "ib_lower_bound",
+                          "ib_upper_bound"},
+                         {"ib_lower_bound >= 38128", "ib_upper_bound <= 88128"})
+                         .planNode();
+  auto households = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kHouseholdDemographics,
+                        {"hd_demo_sk", "hd_income_band_sk"})
+                        .hashJoin(
+                            {"hd_income_band_sk"},
+                            {"ib_income_band_sk"},
+                            incomeBands,
+                            "",
+                            {"hd_demo_sk"})
+                        .planNode();
+  auto customers = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomer,
+                       {"c_customer_id",
+                        "c_current_cdemo_sk",
+                        "c_current_hdemo_sk",
+                        "c_current_addr_sk",
+                        "c_first_name",
+                        "c_last_name"})
+                       .hashJoin(
+                           {"c_current_addr_sk"},
+                           {"ca_address_sk"},
+                           addresses,
+                           "",
+                           {"c_customer_id",
+                            "c_current_cdemo_sk",
+                            "c_current_hdemo_sk",
+                            "c_first_name",
+                            "c_last_name"})
+                       .hashJoin(
+                           {"c_current_hdemo_sk"},
+                           {"hd_demo_sk"},
+                           households,
+                           "",
+                           {"c_customer_id",
+                            "c_current_cdemo_sk",
+                            "c_first_name",
+                            "c_last_name"})
+                       .planNode();
+  // customer_demographics only connects sr_cdemo_sk to c_current_cdemo_sk on
+  // its key and is left out.
+  plan.plan =
+      scan(planNodeIdGenerator, plan, kStoreReturns, {"sr_cdemo_sk"})
+          .hashJoin(
+              {"sr_cdemo_sk"},
+              {"c_current_cdemo_sk"},
+              customers,
+              "",
+              {"c_customer_id", "c_first_name", "c_last_name"})
+          .project(
+              {"c_customer_id AS customer_id",
+               "concat(coalesce(c_last_name, ''), ', ', "
+               "coalesce(c_first_name, '')) AS customername"})
+          .localPartition(std::vector<std::string>{})
+          .topN({"customer_id"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ89Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto items =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kItem,
+          {"i_item_sk", "i_category", "i_class", "i_brand"},
+          {},
+          "(i_category IN ('Books', 'Electronics', 'Sports') "
+          "AND i_class IN ('computers', 'stereo', 'football')) "
+          "OR (i_category IN ('Men', 'Jewelry', 'Women') "
+          "AND i_class IN ('shirts', 'birdhouses', 'dresses'))")
+          .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   {"d_year = 1999"})
+                   .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk", "s_store_name", "s_company_name"})
+                    .planNode();
+  const std::vector<std::string> groupingKeys = {
+      "i_category",
+      "i_class",
+      "i_brand",
+      "s_store_name",
+      "s_company_name",
+      "d_moy"};
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk", "ss_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"ss_sold_date_sk",
+               "ss_store_sk",
+               "ss_sales_price",
+               "i_category",
+               "i_class",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_store_sk",
+               "ss_sales_price",
+               "i_category",
+               "i_class",
+               "i_brand",
+               "d_moy"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_sales_price",
+               "i_category",
+               "i_class",
+               "i_brand",
+               "s_store_name",
+               "s_company_name",
+               "d_moy"})
+          .partialAggregation(
+              groupingKeys, {"sum(ss_sales_price) AS sum_sales"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .window(
+              {"avg(sum_sales) over (partition by i_category, i_brand, "
+               "s_store_name, s_company_name) AS avg_monthly_sales"})
+          .filter(
+              "avg_monthly_sales <> 0 AND "
+              "abs(sum_sales - avg_monthly_sales) / avg_monthly_sales > 0.1")
+          .appendColumns({"sum_sales - avg_monthly_sales AS deviation"})
+          .topN({"deviation", "s_store_name"}, 100, false)
+          .project(
+              {"i_category",
+               "i_class",
+               "i_brand",
+               "s_store_name",
+               "s_company_name",
+               "d_moy",
+               "sum_sales",
+               "avg_monthly_sales"})
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ90Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  // Number of web sales to households with 6 dependents on pages of a size
+  // in the hours of 'hourFilter'.
+  auto countSales = [&](const std::string& hourFilter,
+                        const std::string& name) {
+    auto times = scan(
+                     planNodeIdGenerator,
+                     plan,
+                     kTimeDim,
+                     {"t_time_sk", "t_hour"},
+                     {hourFilter})
+                     .planNode();
+    auto households = scan(
+                          planNodeIdGenerator,
+                          plan,
+                          kHouseholdDemographics,
+                          {"hd_demo_sk", "hd_dep_count"},
+                          {"hd_dep_count = 6"})
+                          .planNode();
+    auto pages = scan(
+                     planNodeIdGenerator,
+                     plan,
+                     kWebPage,
+                     {"wp_web_page_sk", "wp_char_count"},
+                     {"wp_char_count between 5000 and 5200"})
+                     .planNode();
+    return scan(
+               planNodeIdGenerator,
+               plan,
+               kWebSales,
+               {"ws_sold_time_sk", "ws_ship_hdemo_sk", "ws_web_page_sk"})
+        .hashJoin(
+            {"ws_sold_time_sk"},
+            {"t_time_sk"},
+            times,
+            "",
+            {"ws_ship_hdemo_sk", "ws_web_page_sk"})
+        .hashJoin(
+            {"ws_ship_hdemo_sk"},
+            {"hd_demo_sk"},
+            households,
+            "",
+            {"ws_web_page_sk"})
+        .hashJoin(
+            {"ws_web_page_sk"},
+            {"wp_web_page_sk"},
+            pages,
+            "",
+            {"ws_web_page_sk"})
+        .partialAggregation({}, {fmt::format("count(0) AS {}", name)})
+        .localPartition(std::vector<std::string>{})
+        .finalAggregation();
+  };
+  auto pm = countSales("t_hour between 19 and 20", "pmc").planNode();
+  plan.plan = countSales("t_hour between 8 and 9", "amc")
+                  .nestedLoopJoin(pm, {"amc", "pmc"})
+                  .project(
+                      {"cast(amc AS double) / cast(pmc AS double) "
+                       "AS am_pm_ratio"})
+                  .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ91Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto callCenters = scan(
+                         planNodeIdGenerator,
+                         plan,
+                         kCallCenter,
+                         {"cc_call_center_sk",
+                          "cc_call_center_id",
+                          "cc_name",
+                          "cc_manager"})
+                         .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   {"d_year = 1998", "d_moy = 11"})
+                   .planNode();
+  auto addresses = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomerAddress,
+                       {"ca_address_sk", "ca_gmt_offset"},
+                       {},
+                       "ca_gmt_offset = -7.0")
+                       .planNode();
+  auto demographics =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kCustomerDemographics,
+          {"cd_demo_sk", "cd_marital_status", "cd_education_status"},
+          {},
+          "(cd_marital_status = 'M' AND cd_education_status = 'Unknown') "
+          "OR (cd_marital_status = 'W' "
+          "AND cd_education_status = 'Advanced Degree')")
+          .planNode();
+  auto households = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kHouseholdDemographics,
+                        {"hd_demo_sk", "hd_buy_potential"},
+                        {},
+                        "hd_buy_potential like 'Unknown%'")
+                        .planNode();
+  auto customers = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomer,
+                       {"c_customer_sk",
+                        "c_current_cdemo_sk",
+                        "c_current_hdemo_sk",
+                        "c_current_addr_sk"})
+                       .hashJoin(
+                           {"c_current_addr_sk"},
+                           {"ca_address_sk"},
+                           addresses,
+                           "",
+                           {"c_customer_sk",
+                            "c_current_cdemo_sk",
+                            "c_current_hdemo_sk"})
+                       .hashJoin(
+                           {"c_current_hdemo_sk"},
+                           {"hd_demo_sk"},
+                           households,
+                           "",
+                           {"c_customer_sk", "c_current_cdemo_sk"})
+                       .hashJoin(
+                           {"c_current_cdemo_sk"},
+                           {"cd_demo_sk"},
+                           demographics,
+                           "",
+                           {"c_customer_sk",
+                            "cd_marital_status",
+                            "cd_education_status"})
+                       .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kCatalogReturns,
+          {"cr_returned_date_sk",
+           "cr_returning_customer_sk",
+           "cr_call_center_sk",
+           "cr_net_loss"})
+          .hashJoin(
+              {"cr_returned_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"cr_returning_customer_sk", "cr_call_center_sk", "cr_net_loss"})
+          .hashJoin(
+              {"cr_returning_customer_sk"},
+              {"c_customer_sk"},
+              customers,
+              "",
+              {"cr_call_center_sk",
+               "cr_net_loss",
+               "cd_marital_status",
+               "cd_education_status"})
+          .hashJoin(
+              {"cr_call_center_sk"},
+              {"cc_call_center_sk"},
+              callCenters,
+              "",
+              {"cc_call_center_id",
+               "cc_name",
+               "cc_manager",
+               "cd_marital_status",
+               "cd_education_status",
+               "cr_net_loss"})
+          .partialAggregation(
+              {"cc_call_center_id",
+               "cc_name",
+               "cc_manager",
+               "cd_marital_status",
+               "cd_education_status"},
+              {"sum(cr_net_loss) AS returns_loss"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"cc_call_center_id AS call_center",
+               "cc_name AS call_center_name",
+               "cc_manager AS manager",
+               "returns_loss"})
+          .orderBy({"returns_loss DESC"}, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ93Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto reasons = scan(
+                     planNodeIdGenerator,
+                     plan,
+                     kReason,
+                     {"r_reason_sk", "r_reason_desc"},
+                     {"r_reason_desc = 'reason 28'"})
+                     .planNode();
+  auto returns =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreReturns,
+          {"sr_item_sk",
+           "sr_reason_sk",
+           "sr_ticket_number",
+           "sr_return_quantity"})
+          .hashJoin(
+              {"sr_reason_sk"},
+              {"r_reason_sk"},
+              reasons,
+              "",
+              {"sr_item_sk", "sr_ticket_number", "sr_return_quantity"})
+          .planNode();
+  // The filter on the reason of the return turns the left join of the query
+  // into an inner join.
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_item_sk",
+           "ss_customer_sk",
+           "ss_ticket_number",
+           "ss_quantity",
+           "ss_sales_price"})
+          .hashJoin(
+              {"ss_item_sk", "ss_ticket_number"},
+              {"sr_item_sk", "sr_ticket_number"},
+              returns,
+              "",
+              {"ss_customer_sk",
+               "ss_quantity",
+               "ss_sales_price",
+               "sr_return_quantity"})
+          .project(
+              {"ss_customer_sk",
+               "(ss_quantity - sr_return_quantity) * ss_sales_price "
+               "AS act_sales"})
+          .partialAggregation(
+              {"ss_customer_sk"}, {"sum(act_sales) AS sumsales"})
+          .localPartition({"ss_customer_sk"})
+          .finalAggregation()
+          .localPartition(std::vector<std::string>{})
+          .topN({"sumsales", "ss_customer_sk"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ96Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto times = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kTimeDim,
+                   {"t_time_sk", "t_hour", "t_minute"},
+                   {"t_hour = 20", "t_minute >= 30"})
+                   .planNode();
+  auto households = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kHouseholdDemographics,
+                        {"hd_demo_sk", "hd_dep_count"},
+                        {"hd_dep_count = 7"})
+                        .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk", "s_store_name"},
+                    {"s_store_name = 'ese'"})
+                    .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_time_sk", "ss_hdemo_sk", "ss_store_sk"})
+          .hashJoin(
+              {"ss_sold_time_sk"},
+              {"t_time_sk"},
+              times,
+              "",
+              {"ss_hdemo_sk", "ss_store_sk"})
+          .hashJoin(
+              {"ss_hdemo_sk"}, {"hd_demo_sk"}, households, "", {"ss_store_sk"})
+          .hashJoin(
+              {"ss_store_sk"}, {"s_store_sk"}, stores, "", {"ss_store_sk"})
+          .partialAggregation({}, {"count(0) AS cnt"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ98Plan() const {
+  return getItemRevenueRatioPlan(kStoreSales, "ss_", 0);
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ99Plan() const {
+  return getShippingLagPlan(
+      kCatalogSales,
+      "cs_",
+      "cs_call_center_sk",
+      kCallCenter,
+      "cc_call_center_sk",
+      "cc_name");
+}
+
+TpcdsPlan TpcdsQueryBuilder::getPromotionAveragesPlan(
+    const std::string& salesTable,
+    const std::string& prefix,
+    const std::string& cdemoColumn) const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto demographics =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kCustomerDemographics,
+          {"cd_demo_sk",
+           "cd_gender",
+           "cd_marital_status",
+           "cd_education_status"},
+          {},
+          kDemographicsFilter)
+          .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year"},
+                   {"d_year = 2000"})
+                   .planNode();
+  auto promotions = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kPromotion,
+                        {"p_promo_sk", "p_channel_email", "p_channel_event"},
+                        {},
+                        "p_channel_email = 'N' OR p_channel_event = 'N'")
+                        .planNode();
+  auto items =
+      scan(planNodeIdGenerator, plan, kItem, {"i_item_sk", "i_item_id"})
+          .planNode();
+  const auto soldDate = prefix + "sold_date_sk";
+  const auto item = prefix + "item_sk";
+  const auto promo = prefix + "promo_sk";
+  const std::vector<std::string> measures = {
+      prefix + "quantity",
+      prefix + "list_price",
+      prefix + "coupon_amt",
+      prefix + "sales_price"};
+  auto withKeys = [&](std::vector<std::string> keys) {
+    keys.insert(keys.end(), measures.begin(), measures.end());
+    return keys;
+  };
+  const std::vector<std::string> aggregates = {
+      fmt::format("avg({}) AS agg1", measures[0]),
+      fmt::format("avg({}) AS agg2", measures[1]),
+      fmt::format("avg({}) AS agg3", measures[2]),
+      fmt::format("avg({}) AS agg4", measures[3])};
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          salesTable,
+          withKeys({soldDate, item, cdemoColumn, promo}))
+          .hashJoin(
+              {cdemoColumn},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              withKeys({soldDate, item, promo}))
+          .hashJoin(
+              {soldDate}, {"d_date_sk"}, dates, "", withKeys({item, promo}))
+          .hashJoin({promo}, {"p_promo_sk"}, promotions, "", withKeys({item}))
+          .hashJoin({item}, {"i_item_sk"}, items, "", withKeys({"i_item_id"}))
+          .partialAggregation({"i_item_id"}, aggregates)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"i_item_id"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getItemRevenueRatioPlan(
+    const std::string& salesTable,
+    const std::string& prefix,
+    int32_t limit) const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  const std::vector<std::string> itemColumns = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+  std::vector<std::string> itemScanColumns = {"i_item_sk"};
+  itemScanColumns.insert(
+      itemScanColumns.end(), itemColumns.begin(), itemColumns.end());
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   itemScanColumns,
+                   {"i_category in ('Sports', 'Books', 'Home')"})
+                   .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_date"},
+                   {dateBetween(
+                       kDateDim, "d_date", "1999-02-22", "1999-03-24")})
+                   .planNode();
+  const auto soldDate = prefix + "sold_date_sk";
+  const auto item = prefix + "item_sk";
+  const auto price = prefix + "ext_sales_price";
+  auto itemOutput = itemColumns;
+  itemOutput.push_back(price);
+  auto ratioOutput = itemColumns;
+  ratioOutput.push_back("itemrevenue");
+  ratioOutput.push_back("itemrevenue * 100 / class_revenue AS revenueratio");
+  const std::vector<std::string> orderBy = {
+      "i_category", "i_class", "i_item_id", "i_item_desc", "revenueratio"};
+  auto builder =
+      scan(planNodeIdGenerator, plan, salesTable, {soldDate, item, price})
+          .hashJoin({soldDate}, {"d_date_sk"}, dates, "", {item, price})
+          .hashJoin({item}, {"i_item_sk"}, items, "", itemOutput)
+          .partialAggregation(
+              itemColumns, {fmt::format("sum({}) AS itemrevenue", price)})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .window(
+              {"sum(itemrevenue) over (partition by i_class) AS class_revenue"})
+          .project(ratioOutput);
+  if (limit > 0) {
+    builder.topN(orderBy, limit, false);
+  } else {
+    builder.orderBy(orderBy, false);
+  }
+  plan.plan = builder.planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getInventoryItemsPlan(
+    const std::string& salesTable,
+    const std::string& itemColumn,
+    const std::string& priceFilter,
+    const std::string& lowerDate,
+    const std::string& upperDate,
+    const std::string& manufactFilter) const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto items = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kItem,
+                   {"i_item_sk",
+                    "i_item_id",
+                    "i_item_desc",
+                    "i_current_price",
+                    "i_manufact_id"},
+                   {priceFilter, manufactFilter})
+                   .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_date"},
+                   {dateBetween(kDateDim, "d_date", lowerDate, upperDate)})
+                   .planNode();
+  // Items in stock in the date range.
+  auto stocked =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kInventory,
+          {"inv_date_sk", "inv_item_sk", "inv_quantity_on_hand"},
+          {"inv_quantity_on_hand between 100 and 500"})
+          .hashJoin({"inv_date_sk"}, {"d_date_sk"}, dates, "", {"inv_item_sk"})
+          .hashJoin(
+              {"inv_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_item_sk", "i_item_id", "i_item_desc", "i_current_price"})
+          .planNode();
+  const std::vector<std::string> itemColumns = {
+      "i_item_id", "i_item_desc", "i_current_price"};
+  plan.plan =
+      scan(planNodeIdGenerator, plan, salesTable, {itemColumn})
+          .hashJoin({itemColumn}, {"i_item_sk"}, stocked, "", itemColumns)
+          .partialAggregation(itemColumns, {})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"i_item_id"}, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getTicketCountPlan(
+    const std::string& domFilter,
+    double minVehicleRatio,
+    const std::string& countyFilter,
+    const std::string& countFilter,
+    const std::vector<std::string>& orderBy) const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_dom"},
+                   {"d_year in (1999, 2000, 2001)"},
+                   domFilter)
+                   .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    plan,
+                    kStore,
+                    {"s_store_sk", "s_county"},
+                    {countyFilter})
+                    .planNode();
+  auto households = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kHouseholdDemographics,
+                        {"hd_demo_sk",
+                         "hd_buy_potential",
+                         "hd_dep_count",
+                         "hd_vehicle_count"},
+                        {"hd_vehicle_count > 0"},
+                        fmt::format(
+                            "(hd_buy_potential = '>10000' "
+                            "OR hd_buy_potential = 'Unknown') "
+                            "AND cast(hd_dep_count AS double) / "
+                            "hd_vehicle_count > {}",
+                            minVehicleRatio))
+                        .planNode();
+  auto customers = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kCustomer,
+                       {"c_customer_sk",
+                        "c_salutation",
+                        "c_first_name",
+                        "c_last_name",
+                        "c_preferred_cust_flag"})
+                       .planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk",
+           "ss_store_sk",
+           "ss_hdemo_sk",
+           "ss_customer_sk",
+           "ss_ticket_number"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_store_sk",
+               "ss_hdemo_sk",
+               "ss_customer_sk",
+               "ss_ticket_number"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_hdemo_sk", "ss_customer_sk", "ss_ticket_number"})
+          .hashJoin(
+              {"ss_hdemo_sk"},
+              {"hd_demo_sk"},
+              households,
+              "",
+              {"ss_customer_sk", "ss_ticket_number"})
+          .partialAggregation(
+              {"ss_ticket_number", "ss_customer_sk"}, {"count(0) AS cnt"})
+          .localPartition({"ss_ticket_number", "ss_customer_sk"})
+          .finalAggregation()
+          .filter(countFilter)
+          .hashJoin(
+              {"ss_customer_sk"},
+              {"c_customer_sk"},
+              customers,
+              "",
+              {"c_last_name",
+               "c_first_name",
+               "c_salutation",
+               "c_preferred_cust_flag",
+               "ss_ticket_number",
+               "cnt"})
+          .localPartition(std::vector<std::string>{})
+          .orderBy(orderBy, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getPeriodicSalesPlan(
+    const std::string& groupColumn,
+    const std::string& periodColumn,
+    const std::vector<std::string>& orderBy) const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto items =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kItem,
+          {"i_item_sk", groupColumn, "i_category", "i_class", "i_brand"},
+          {},
+          "(i_category IN ('Books', 'Children', 'Electronics') "
+          "AND i_class IN ('personal', 'portable', 'reference', 'self-help') "
+          "AND i_brand IN ('scholaramalgamalg #14', 'scholaramalgamalg #7', "
+          "'exportiunivamalg #9', 'scholaramalgamalg #9')) "
+          "OR (i_category IN ('Women', 'Music', 'Men') "
+          "AND i_class IN ('accessories', 'classical', 'fragrances', 'pants') "
+          "AND i_brand IN ('amalgimporto #1', 'edu packscholar #1', "
+          "'exportiimporto #1', 'importoamalg #1'))")
+          .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_month_seq", periodColumn},
+                   {"d_month_seq between 1200 and 1211"})
+                   .planNode();
+  auto stores =
+      scan(planNodeIdGenerator, plan, kStore, {"s_store_sk"}).planNode();
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk", "ss_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"ss_sold_date_sk", "ss_store_sk", "ss_sales_price", groupColumn})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_store_sk", "ss_sales_price", groupColumn, periodColumn})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {groupColumn, periodColumn, "ss_sales_price"})
+          .partialAggregation(
+              {groupColumn, periodColumn},
+              {"sum(ss_sales_price) AS sum_sales"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .window({fmt::format(
+              "avg(sum_sales) over (partition by {}) AS avg_sales",
+              groupColumn)})
+          .filter(
+              "avg_sales > 0 AND abs(sum_sales - avg_sales) / avg_sales > 0.1")
+          .project({groupColumn, "sum_sales", "avg_sales"})
+          .topN(orderBy, 100, false)
+          .planNode();
+  return plan;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getShippingLagPlan(
+    const std::string& salesTable,
+    const std::string& prefix,
+    const std::string& siteColumn,
+    const std::string& siteTable,
+    const std::string& siteKey,
+    const std::string& siteName) const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan plan;
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   plan,
+                   kDateDim,
+                   {"d_date_sk", "d_month_seq"},
+                   {"d_month_seq between 1200 and 1211"})
+                   .planNode();
+  auto warehouses = scan(
+                        planNodeIdGenerator,
+                        plan,
+                        kWarehouse,
+                        {"w_warehouse_sk", "w_warehouse_name"})
+                        .planNode();
+  auto shipModes = scan(
+                       planNodeIdGenerator,
+                       plan,
+                       kShipMode,
+                       {"sm_ship_mode_sk", "sm_type"})
+                       .planNode();
+  auto sites =
+      scan(planNodeIdGenerator, plan, siteTable, {siteKey, siteName})
+          .planNode();
+  const auto shipDate = prefix + "ship_date_sk";
+  const auto soldDate = prefix + "sold_date_sk";
+  const auto warehouse = prefix + "warehouse_sk";
+  const auto shipMode = prefix + "ship_mode_sk";
+  const std::vector<std::string> groupingKeys = {
+      "warehouse_name", "sm_type", siteName};
+  plan.plan =
+      scan(
+          planNodeIdGenerator,
+          plan,
+          salesTable,
+          {shipDate, soldDate, warehouse, shipMode, siteColumn})
+          .hashJoin(
+              {shipDate},
+              {"d_date_sk"},
+              dates,
+              "",
+              {shipDate, soldDate, warehouse, shipMode, siteColumn})
+          .hashJoin(
+              {warehouse},
+              {"w_warehouse_sk"},
+              warehouses,
+              "",
+              {shipDate, soldDate, shipMode, siteColumn, "w_warehouse_name"})
+          .hashJoin(
+              {shipMode},
+              {"sm_ship_mode_sk"},
+              shipModes,
+              "",
+              {shipDate, soldDate, siteColumn, "w_warehouse_name", "sm_type"})
+          .hashJoin(
+              {siteColumn},
+              {siteKey},
+              sites,
+              "",
+              {shipDate, soldDate, "w_warehouse_name", "sm_type", siteName})
+          .project(
+              {"substr(w_warehouse_name, 1, 20) AS warehouse_name",
+               "sm_type",
+               siteName,
+               fmt::format("{} - {} AS lag", shipDate, soldDate)})
+          .project(lagBuckets(groupingKeys, "lag"))
+          .partialAggregation(groupingKeys, kLagCounts)
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(groupingKeys, 100, false)
+          .planNode();
+  return plan;
+}
+
+const std::unordered_map<std::string, std::vector<std::string>>
+    TpcdsQueryBuilder::kTables_ = {
+        {"store_sales",
+         {"ss_sold_date_sk",
+          "ss_sold_time_sk",
+          "ss_item_sk",
+          "ss_customer_sk",
+          "ss_cdemo_sk",
+          "ss_hdemo_sk",
+          "ss_addr_sk",
+          "ss_store_sk",
+          "ss_promo_sk",
+          "ss_ticket_number",
+          "ss_quantity",
+          "ss_wholesale_cost",
+          "ss_list_price",
+          "ss_sales_price",
+          "ss_ext_discount_amt",
+          "ss_ext_sales_price",
+          "ss_ext_wholesale_cost",
+          "ss_ext_list_price",
+          "ss_ext_tax",
+          "ss_coupon_amt",
+          "ss_net_paid",
+          "ss_net_paid_inc_tax",
+          "ss_net_profit"}},
+        {"store_returns",
+         {"sr_returned_date_sk",
+          "sr_return_time_sk",
+          "sr_item_sk",
+          "sr_customer_sk",
+          "sr_cdemo_sk",
+          "sr_hdemo_sk",
+          "sr_addr_sk",
+          "sr_store_sk",
+          "sr_reason_sk",
+          "sr_ticket_number",
+          "sr_return_quantity",
+          "sr_return_amt",
+          "sr_return_tax",
+          "sr_return_amt_inc_tax",
+          "sr_fee",
+          "sr_return_ship_cost",
+          "sr_refunded_cash",
+          "sr_reversed_charge",
+          "sr_store_credit",
+          "sr_net_loss"}},
+        {"catalog_sales",
+         {"cs_sold_date_sk",
+          "cs_sold_time_sk",
+          "cs_ship_date_sk",
+          "cs_bill_customer_sk",
+          "cs_bill_cdemo_sk",
+          "cs_bill_hdemo_sk",
+          "cs_bill_addr_sk",
+          "cs_ship_customer_sk",
+          "cs_ship_cdemo_sk",
+          "cs_ship_hdemo_sk",
+          "cs_ship_addr_sk",
+          "cs_call_center_sk",
+          "cs_catalog_page_sk",
+          "cs_ship_mode_sk",
+          "cs_warehouse_sk",
+          "cs_item_sk",
+          "cs_promo_sk",
+          "cs_order_number",
+          "cs_quantity",
+          "cs_wholesale_cost",
+          "cs_list_price",
+          "cs_sales_price",
+          "cs_ext_discount_amt",
+          "cs_ext_sales_price",
+          "cs_ext_wholesale_cost",
+          "cs_ext_list_price",
+          "cs_ext_tax",
+          "cs_coupon_amt",
+          "cs_ext_ship_cost",
+          "cs_net_paid",
+          "cs_net_paid_inc_tax",
+          "cs_net_paid_inc_ship",
+          "cs_net_paid_inc_ship_tax",
+          "cs_net_profit"}},
+        {"catalog_returns",
+         {"cr_returned_date_sk",
+          "cr_returned_time_sk",
+          "cr_item_sk",
+          "cr_refunded_customer_sk",
+          "cr_refunded_cdemo_sk",
+          "cr_refunded_hdemo_sk",
+          "cr_refunded_addr_sk",
+          "cr_returning_customer_sk",
+          "cr_returning_cdemo_sk",
+          "cr_returning_hdemo_sk",
+          "cr_returning_addr_sk",
+          "cr_call_center_sk",
+          "cr_catalog_page_sk",
+          "cr_ship_mode_sk",
+          "cr_warehouse_sk",
+          "cr_reason_sk",
+          "cr_order_number",
+          "cr_return_quantity",
+          "cr_return_amount",
+          "cr_return_tax",
+          "cr_return_amt_inc_tax",
+          "cr_fee",
+          "cr_return_ship_cost",
+          "cr_refunded_cash",
+          "cr_reversed_charge",
+          "cr_store_credit",
+          "cr_net_loss"}},
+        {"web_sales",
+         {"ws_sold_date_sk",
+          "ws_sold_time_sk",
+          "ws_ship_date_sk",
+          "ws_item_sk",
+          "ws_bill_customer_sk",
+          "ws_bill_cdemo_sk",
+          "ws_bill_hdemo_sk",
+          "ws_bill_addr_sk",
+          "ws_ship_customer_sk",
+          "ws_ship_cdemo_sk",
+          "ws_ship_hdemo_sk",
+          "ws_ship_addr_sk",
+          "ws_web_page_sk",
+          "ws_web_site_sk",
+          "ws_ship_mode_sk",
+          "ws_warehouse_sk",
+          "ws_promo_sk",
+          "ws_order_number",
+          "ws_quantity",
+          "ws_wholesale_cost",
+          "ws_list_price",
+          "ws_sales_price",
+          "ws_ext_discount_amt",
+          "ws_ext_sales_price",
+          "ws_ext_wholesale_cost",
+          "ws_ext_list_price",
+          "ws_ext_tax",
+          "ws_coupon_amt",
+          "ws_ext_ship_cost",
+          "ws_net_paid",
+          "ws_net_paid_inc_tax",
+          "ws_net_paid_inc_ship",
+          "ws_net_paid_inc_ship_tax",
+          "ws_net_profit"}},
+        {"inventory",
+         {"inv_date_sk",
+          "inv_item_sk",
+          "inv_warehouse_sk",
+          "inv_quantity_on_hand"}},
+        {"date_dim",
+         {"d_date_sk",
+          "d_date_id",
+          "d_date",
+          "d_month_seq",
+          "d_week_seq",
+          "d_quarter_seq",
+          "d_year",
+          "d_dow",
+          "d_moy",
+          "d_dom",
+          "d_qoy",
+          "d_fy_year",
+          "d_fy_quarter_seq",
+          "d_fy_week_seq",
+          "d_day_name",
+          "d_quarter_name",
+          "d_holiday",
+          "d_weekend",
+          "d_following_holiday",
+          "d_first_dom",
+          "d_last_dom",
+          "d_same_day_ly",
+          "d_same_day_lq",
+          "d_current_day",
+          "d_current_week",
+          "d_current_month",
+          "d_current_quarter",
+          "d_current_year"}},
+        {"time_dim",
+         {"t_time_sk",
+          "t_time_id",
+          "t_time",
+          "t_hour",
+          "t_minute",
+          "t_second",
+          "t_am_pm",
+          "t_shift",
+          "t_sub_shift",
+          "t_meal_time"}},
+        {"item",
+         {"i_item_sk",
+          "i_item_id",
+          "i_rec_start_date",
+          "i_rec_end_date",
+          "i_item_desc",
+          "i_current_price",
+          "i_wholesale_cost",
+          "i_brand_id",
+          "i_brand",
+          "i_class_id",
+          "i_class",
+          "i_category_id",
+          "i_category",
+          "i_manufact_id",
+          "i_manufact",
+          "i_size",
+          "i_formulation",
+          "i_color",
+          "i_units",
+          "i_container",
+          "i_manager_id",
+          "i_product_name"}},
+        {"customer",
+         {"c_customer_sk",
+          "c_customer_id",
+          "c_current_cdemo_sk",
+          "c_current_hdemo_sk",
+          "c_current_addr_sk",
+          "c_first_shipto_date_sk",
+          "c_first_sales_date_sk",
+          "c_salutation",
+          "c_first_name",
+          "c_last_name",
+          "c_preferred_cust_flag",
+          "c_birth_day",
+          "c_birth_month",
+          "c_birth_year",
+          "c_birth_country",
+          "c_login",
+          "c_email_address",
+          "c_last_review_date_sk"}},
+        {"customer_address",
+         {"ca_address_sk",
+          "ca_address_id",
+          "ca_street_number",
+          "ca_street_name",
+          "ca_street_type",
+          "ca_suite_number",
+          "ca_city",
+          "ca_county",
+          "ca_state",
+          "ca_zip",
+          "ca_country",
+          "ca_gmt_offset",
+          "ca_location_type"}},
+        {"customer_demographics",
+         {"cd_demo_sk",
+          "cd_gender",
+          "cd_marital_status",
+          "cd_education_status",
+          "cd_purchase_estimate",
+          "cd_credit_rating",
+          "cd_dep_count",
+          "cd_dep_employed_count",
+          "cd_dep_college_count"}},
+        {"household_demographics",
+         {"hd_demo_sk",
+          "hd_income_band_sk",
+          "hd_buy_potential",
+          "hd_dep_count",
+          "hd_vehicle_count"}},
+        {"income_band",
+         {"ib_income_band_sk", "ib_lower_bound", "ib_upper_bound"}},
+        {"store",
+         {"s_store_sk",
+          "s_store_id",
+          "s_rec_start_date",
+          "s_rec_end_date",
+          "s_closed_date_sk",
+          "s_store_name",
+          "s_number_employees",
+          "s_floor_space",
+          "s_hours",
+          "s_manager",
+          "s_market_id",
+          "s_geography_class",
+          "s_market_desc",
+          "s_market_manager",
+          "s_division_id",
+          "s_division_name",
+          "s_company_id",
+          "s_company_name",
+          "s_street_number",
+          "s_street_name",
+          "s_street_type",
+          "s_suite_number",
+          "s_city",
+          "s_county",
+          "s_state",
+          "s_zip",
+          "s_country",
+          "s_gmt_offset",
+          "s_tax_precentage"}},
+        {"promotion",
+         {"p_promo_sk",
+          "p_promo_id",
+          "p_start_date_sk",
+          "p_end_date_sk",
+          "p_item_sk",
+          "p_cost",
+          "p_response_target",
+          "p_promo_name",
+          "p_channel_dmail",
+          "p_channel_email",
+          "p_channel_catalog",
+          "p_channel_tv",
+          "p_channel_radio",
+          "p_channel_press",
+          "p_channel_event",
+          "p_channel_demo",
+          "p_channel_details",
+          "p_purpose",
+          "p_discount_active"}},
+        {"warehouse",
+         {"w_warehouse_sk",
+          "w_warehouse_id",
+          "w_warehouse_name",
+          "w_warehouse_sq_ft",
+          "w_street_number",
+          "w_street_name",
+          "w_street_type",
+          "w_suite_number",
+          "w_city",
+          "w_county",
+          "w_state",
+          "w_zip",
+          "w_country",
+          "w_gmt_offset"}},
+        {"ship_mode",
+         {"sm_ship_mode_sk",
+          "sm_ship_mode_id",
+          "sm_type",
+          "sm_code",
+          "sm_carrier",
+          "sm_contract"}},
+        {"web_site",
+         {"web_site_sk",
+          "web_site_id",
+          "web_rec_start_date",
+          "web_rec_end_date",
+          "web_name",
+          "web_open_date_sk",
+          "web_close_date_sk",
+          "web_class",
+          "web_manager",
+          "web_mkt_id",
+          "web_mkt_class",
+          "web_mkt_desc",
+          "web_market_manager",
+          "web_company_id",
+          "web_company_name",
+          "web_street_number",
+          "web_street_name",
+          "web_street_type",
+          "web_suite_number",
+          "web_city",
+          "web_county",
+          "web_state",
+          "web_zip",
+          "web_country",
+          "web_gmt_offset",
+          "web_tax_percentage"}},
+        {"web_page",
+         {"wp_web_page_sk",
+          "wp_web_page_id",
+          "wp_rec_start_date",
+          "wp_rec_end_date",
+          "wp_creation_date_sk",
+          "wp_access_date_sk",
+          "wp_autogen_flag",
+          "wp_customer_sk",
+          "wp_url",
+          "wp_type",
+          "wp_char_count",
+          "wp_link_count",
+          "wp_image_count",
+          "wp_max_ad_count"}},
+        {"call_center",
+         {"cc_call_center_sk",
+          "cc_call_center_id",
+          "cc_rec_start_date",
+          "cc_rec_end_date",
+          "cc_closed_date_sk",
+          "cc_open_date_sk",
+          "cc_name",
+          "cc_class",
+          "cc_employees",
+          "cc_sq_ft",
+          "cc_hours",
+          "cc_manager",
+          "cc_mkt_id",
+          "cc_mkt_class",
+          "cc_mkt_desc",
+          "cc_market_manager",
+          "cc_division",
+          "cc_division_name",
+          "cc_company",
+          "cc_company_name",
+          "cc_street_number",
+          "cc_street_name",
+          "cc_street_type",
+          "cc_suite_number",
+          "cc_city",
+          "cc_county",
+          "cc_state",
+          "cc_zip",
+          "cc_country",
+          "cc_gmt_offset",
+          "cc_tax_percentage"}},
+        {"reason", {"r_reason_sk", "r_reason_id", "r_reason_desc"}}};
+
+} // namespace facebook::velox::exec::test
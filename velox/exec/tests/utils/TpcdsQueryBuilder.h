@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// TPC-DS plans carry the same information as TPC-H plans.
+using TpcdsPlan = TpchPlan;
+
+/// Builds TPC-DS queries using TPC-DS data files located in the specified
+/// directory. The data layout is the same as for TpchQueryBuilder: one
+/// sub-directory or path-list file per table named after the table, e.g.
+/// data/store_sales, data/date_dim, data/item. The columns of each file must
+/// be in the order of the TPC-DS specification and are mapped to the standard
+/// names (example: ss_sold_date_sk) by position. Monetary columns are expected
+/// to be DOUBLE. DWRF files keep dates as VARCHAR.
+///
+/// The plans cover a subset of the TPC-DS queries that exercises star joins
+/// with many dimensions, rollups and window functions. Correlated subqueries
+/// are decorrelated into joins with aggregations as a cost based optimizer
+/// would. Each plan keeps the predicates, grouping and ordering of the query.
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(dwio::common::FileFormat format)
+      : format_(format) {}
+
+  /// Read each data file, initialize row types, and determine data paths for
+  /// each table.
+  /// @param dataPath path to the data files
+  void initialize(const std::string& dataPath);
+
+  /// Get the query plan for a given TPC-DS query number.
+  /// @param queryId TPC-DS query number
+  TpcdsPlan getQueryPlan(int queryId) const;
+
+  /// Returns the TPC-DS query numbers supported by getQueryPlan().
+  static const std::vector<int>& getQueryIds();
+
+  /// Returns the column names of each TPC-DS table by table name, in the
+  /// order of the columns in the data files.
+  static const std::unordered_map<std::string, std::vector<std::string>>&
+  getTableColumns() {
+    return kTables_;
+  }
+
+ private:
+  // Initializes the schema information for 'tableName' from sample file at
+  // 'filePath'.
+  void readFileSchema(
+      const std::string& tableName,
+      const std::string& filePath,
+      const std::vector<std::string>& columns);
+
+  // Returns a PlanBuilder that scans 'columns' of 'tableName' with
+  // 'subfieldFilters' and 'remainingFilter' and adds the data files of the
+  // table to 'plan' for the scan. Filtered columns must be in 'columns'.
+  PlanBuilder scan(
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+      TpcdsPlan& plan,
+      const std::string& tableName,
+      const std::vector<std::string>& columns,
+      const std::vector<std::string>& subfieldFilters = {},
+      const std::string& remainingFilter = "") const;
+
+  // Returns a filter on 'column' of 'tableName' for dates between
+  // 'lowerBound' and 'upperBound', e.g. '1999-02-22'.
+  std::string dateBetween(
+      const std::string& tableName,
+      const std::string& column,
+      const std::string& lowerBound,
+      const std::string& upperBound) const;
+
+  TpcdsPlan getQ3Plan() const;
+  TpcdsPlan getQ6Plan() const;
+  TpcdsPlan getQ7Plan() const;
+  TpcdsPlan getQ12Plan() const;
+  TpcdsPlan getQ13Plan() const;
+  TpcdsPlan getQ15Plan() const;
+  TpcdsPlan getQ19Plan() const;
+  TpcdsPlan getQ20Plan() const;
+  TpcdsPlan getQ22Plan() const;
+  TpcdsPlan getQ26Plan() const;
+  TpcdsPlan getQ27Plan() const;
+  TpcdsPlan getQ29Plan() const;
+  TpcdsPlan getQ34Plan() const;
+  TpcdsPlan getQ36Plan() const;
+  TpcdsPlan getQ37Plan() const;
+  TpcdsPlan getQ42Plan() const;
+  TpcdsPlan getQ43Plan() const;
+  TpcdsPlan getQ46Plan() const;
+  TpcdsPlan getQ48Plan() const;
+  TpcdsPlan getQ50Plan() const;
+  TpcdsPlan getQ52Plan() const;
+  TpcdsPlan getQ53Plan() const;
+  TpcdsPlan getQ55Plan() const;
+  TpcdsPlan getQ62Plan() const;
+  TpcdsPlan getQ63Plan() const;
+  TpcdsPlan getQ65Plan() const;
+  TpcdsPlan getQ73Plan() const;
+  TpcdsPlan getQ79Plan() const;
+  TpcdsPlan getQ82Plan() const;
+  TpcdsPlan getQ84Plan() const;
+  TpcdsPlan getQ89Plan() const;
+  TpcdsPlan getQ90Plan() const;
+  TpcdsPlan getQ91Plan() const;
+  TpcdsPlan getQ93Plan() const;
+  TpcdsPlan getQ96Plan() const;
+  TpcdsPlan getQ98Plan() const;
+  TpcdsPlan getQ99Plan() const;
+
+  // Q7 and Q26: average sales of items bought by a demographic with a
+  // promotion. 'prefix' is the column prefix of 'salesTable' and
+  // 'cdemoColumn' its customer demographics key.
+  TpcdsPlan getPromotionAveragesPlan(
+      const std::string& salesTable,
+      const std::string& prefix,
+      const std::string& cdemoColumn) const;
+
+  // Q12, Q20 and Q98: revenue of items of some categories in a month and its
+  // ratio to the revenue of the item class. 'prefix' is the column prefix of
+  // 'salesTable'. No limit if 'limit' is 0.
+  TpcdsPlan getItemRevenueRatioPlan(
+      const std::string& salesTable,
+      const std::string& prefix,
+      int32_t limit) const;
+
+  // Q37 and Q82: items in a price range with inventory in a date range that
+  // were sold in 'salesTable'.
+  TpcdsPlan getInventoryItemsPlan(
+      const std::string& salesTable,
+      const std::string& itemColumn,
+      const std::string& priceFilter,
+      const std::string& lowerDate,
+      const std::string& upperDate,
+      const std::string& manufactFilter) const;
+
+  // Q34 and Q73: customers with a number of items on a ticket in a range.
+  TpcdsPlan getTicketCountPlan(
+      const std::string& domFilter,
+      double minVehicleRatio,
+      const std::string& countyFilter,
+      const std::string& countFilter,
+      const std::vector<std::string>& orderBy) const;
+
+  // Q53 and Q63: groups of items whose sales in a period deviate more than
+  // 10% from the average over all periods.
+  TpcdsPlan getPeriodicSalesPlan(
+      const std::string& groupColumn,
+      const std::string& periodColumn,
+      const std::vector<std::string>& orderBy) const;
+
+  // Q62 and Q99: shipped orders by number of days between sale and shipment.
+  TpcdsPlan getShippingLagPlan(
+      const std::string& salesTable,
+      const std::string& prefix,
+      const std::string& siteColumn,
+      const std::string& siteTable,
+      const std::string& siteKey,
+      const std::string& siteName) const;
+
+  const std::vector<std::string>& getTableFilePaths(
+      const std::string& tableName) const {
+    return tableMetadata_.at(tableName).dataFiles;
+  }
+
+  std::shared_ptr<const RowType> getRowType(
+      const std::string& tableName,
+      const std::vector<std::string>& columnNames) const {
+    auto columnSelector = std::make_shared<dwio::common::ColumnSelector>(
+        tableMetadata_.at(tableName).type, columnNames);
+    return columnSelector->buildSelectedReordered();
+  }
+
+  const std::unordered_map<std::string, std::string>& getFileColumnNames(
+      const std::string& tableName) const {
+    return tableMetadata_.at(tableName).fileColumnNames;
+  }
+
+  std::unordered_map<std::string, TpchTableMetadata> tableMetadata_;
+  const dwio::common::FileFormat format_;
+  static const std::unordered_map<std::string, std::vector<std::string>>
+      kTables_;
+
+  static constexpr const char* kStoreSales = "store_sales";
+  static constexpr const char* kStoreReturns = "store_returns";
+  static constexpr const char* kCatalogSales = "catalog_sales";
+  static constexpr const char* kCatalogReturns = "catalog_returns";
+  static constexpr const char* kWebSales = "web_sales";
+  static constexpr const char* kInventory = "inventory";
+  static constexpr const char* kDateDim = "date_dim";
+  static constexpr const char* kTimeDim = "time_dim";
+  static constexpr const char* kItem = "item";
+  static constexpr const char* kCustomer = "customer";
+  static constexpr const char* kCustomerAddress = "customer_address";
+  static constexpr const char* kCustomerDemographics = "customer_demographics";
+  static constexpr const char* kHouseholdDemographics =
+      "household_demographics";
+  static constexpr const char* kIncomeBand = "income_band";
+  static constexpr const char* kStore = "store";
+  static constexpr const char* kPromotion = "promotion";
+  static constexpr const char* kWarehouse = "warehouse";
+  static constexpr const char* kShipMode = "ship_mode";
+  static constexpr const char* kWebSite = "web_site";
+  static constexpr const char* kWebPage = "web_page";
+  static constexpr const char* kCallCenter = "call_center";
+  static constexpr const char* kReason = "reason";
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+} // namespace facebook::velox::exec::test
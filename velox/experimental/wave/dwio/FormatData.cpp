@@ -49,11 +49,15 @@ void SplitStaging::transfer(WaveStream& waveStream, Stream& stream) {
   }
   deviceBuffer_ = waveStream.arena().allocate<char>(fill_);
   auto universal = deviceBuffer_->as<char>();
+  // The data is gathered into pinned memory and copied asynchronously, so
+  // that the transfer for one batch overlaps the decoding of the previous
+  // one. 'hostBuffer_' lives as long as 'this', which is after the copy.
+  hostBuffer_ = waveStream.hostArena().allocate<char>(fill_);
+  auto host = hostBuffer_->as<char>();
   for (auto i = 0; i < offsets_.size(); ++i) {
-    memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+    memcpy(host + offsets_[i], staging_[i].hostData, staging_[i].size);
   }
-  stream.prefetch(
-      getDevice(), deviceBuffer_->as<char>(), deviceBuffer_->size());
+  stream.hostToDeviceAsync(universal, host, fill_);
   for (auto& pair : patch_) {
     *reinterpret_cast<int64_t*>(pair.second) +=
         reinterpret_cast<int64_t>(universal) + offsets_[pair.first];
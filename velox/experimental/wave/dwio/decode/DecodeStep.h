@@ -93,11 +93,32 @@ enum class DecodeStep {
   kFlatMapNode,
   kRowCountNoFilter,
   kCountBits,
+  kRleBitpack,
+  kDeltaBinaryPacked,
   kUnsupported,
 };
 
 class ColumnReader;
 
+/// A run of Parquet RLE/bit-packed hybrid data. Filled in by the decode of
+/// the run headers.
+struct RleBitpackRun {
+  // Index of the first value of the run.
+  int32_t firstRow;
+  // The repeated value if 'isBitpacked' is false, otherwise the byte offset
+  // of the bit-packed values in the input.
+  uint32_t value;
+  bool isBitpacked;
+};
+
+/// A miniblock of Parquet DELTA_BINARY_PACKED data.
+struct DeltaMiniblock {
+  // Byte offset of the bit-packed deltas in the input.
+  int32_t offset;
+  int32_t bitWidth;
+  int64_t minDelta;
+};
+
 /// Describes a decoding loop's input and result disposition.
 struct alignas(16) GpuDecode {
   /// Constant in 'numRows' to signify the number comes from 'blockstatus'.
@@ -338,6 +359,51 @@ struct alignas(16) GpuDecode {
     // One int per warp (blockDim.x/32).
   };
 
+  struct RleBitpack {
+    // Parquet RLE/bit-packed hybrid data, e.g. definition levels or
+    // dictionary ids, without the length prefix of V1 data page levels.
+    const uint8_t* input;
+    // Byte size of the input data.
+    int32_t inputSize;
+    // Bit width of each value.
+    int32_t bitWidth;
+    // Number of values to decode.
+    int32_t numValues;
+    // Temporary storage for the runs. Should be allocated at least
+    // min(numValues, inputSize) large.
+    RleBitpackRun* runs;
+    // Type of the alphabet and result.
+    WaveTypeKind dataType;
+    // If not null, the values are indices into this dictionary alphabet.
+    const void* alphabet;
+    // If not null, contains the output position relative to result pointer.
+    const int32_t* scatter;
+    // If not null, the values are definition levels and a null flag is
+    // written here for each instead of 'result'. Values equal to 'maxLevel'
+    // are not null.
+    uint8_t* nulls;
+    int32_t maxLevel;
+    // Starting address of the result.
+    void* result;
+  };
+
+  struct DeltaBinaryPacked {
+    // Parquet DELTA_BINARY_PACKED data starting with its header.
+    const uint8_t* input;
+    // Byte size of the input data.
+    int32_t inputSize;
+    // Temporary storage for the miniblocks. Should be allocated at least
+    // 'maxMiniblocks' large.
+    DeltaMiniblock* miniblocks;
+    int32_t maxMiniblocks;
+    // INTEGER or BIGINT.
+    WaveTypeKind dataType;
+    // Starting address of the result.
+    void* result;
+    // The number of values in the result.
+    int32_t resultSize;
+  };
+
   struct CompactValues {
     // Selected row numbers from the source filtered column.
     int32_t* sourceRows;
@@ -363,6 +429,8 @@ struct alignas(16) GpuDecode {
     RowCountNoFilter rowCountNoFilter;
     CountBits countBits;
     CompactValues compact;
+    RleBitpack rleBitpack;
+    DeltaBinaryPacked deltaBinaryPacked;
   } data;
 
   /// Returns the amount of int aligned global memory per TB needed in 'temp'
@@ -509,6 +509,220 @@ __device__ void makeScatterIndices(GpuDecode::MakeScatterIndices& op) {
   }
 }
 
+// Returns 'width' bits starting at bit 'bit' of 'data'. 'width' is at most 64.
+__device__ inline uint64_t
+loadBits(const uint8_t* data, int64_t bit, int32_t width) {
+  if (width == 0) {
+    return 0;
+  }
+  auto* bytes = data + (bit >> 3);
+  int32_t shift = bit & 7;
+  int32_t numBytes = (shift + width + 7) / 8;
+  uint64_t word = 0;
+  for (auto i = 0; i < min(numBytes, 8); ++i) {
+    word |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+  }
+  uint64_t value = word >> shift;
+  if (numBytes > 8) {
+    value |= static_cast<uint64_t>(bytes[8]) << (64 - shift);
+  }
+  return width == 64 ? value : value & ((1UL << width) - 1);
+}
+
+__device__ inline int64_t zigzagDecode(uint64_t value) {
+  return (value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Writes the runs of 'op' to 'op.runs' and returns their number. The headers
+// are read by a single thread.
+__device__ inline int32_t scanRleBitpackRuns(GpuDecode::RleBitpack& op) {
+  auto* pos = reinterpret_cast<const char*>(op.input);
+  auto* end = pos + op.inputSize;
+  int32_t valueBytes = (op.bitWidth + 7) / 8;
+  int32_t row = 0;
+  int32_t numRuns = 0;
+  while (row < op.numValues && pos < end) {
+    auto header = readVarint32(&pos);
+    auto& run = op.runs[numRuns++];
+    run.firstRow = row;
+    if (header & 1) {
+      int32_t numGroups = header >> 1;
+      run.isBitpacked = true;
+      run.value = reinterpret_cast<const uint8_t*>(pos) - op.input;
+      pos += numGroups * op.bitWidth;
+      row += numGroups * 8;
+    } else {
+      uint32_t value = 0;
+      for (auto i = 0; i < valueBytes; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(*pos++))
+            << (i * 8);
+      }
+      run.isBitpacked = false;
+      run.value = value;
+      row += header >> 1;
+    }
+  }
+  return numRuns;
+}
+
+// Returns the index of the last run in 'runs' that starts at or before 'row'.
+__device__ inline int32_t
+findRun(const RleBitpackRun* runs, int32_t numRuns, int32_t row) {
+  int32_t lo = 0, hi = numRuns;
+  while (lo < hi) {
+    int32_t i = (lo + hi) / 2;
+    if (runs[i].firstRow <= row) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+  return lo - 1;
+}
+
+template <typename T>
+__device__ void decodeRleBitpack(GpuDecode::RleBitpack& op) {
+  __shared__ int32_t numRuns;
+  if (threadIdx.x == 0) {
+    numRuns = scanRleBitpackRuns(op);
+  }
+  __syncthreads();
+  auto* dict = reinterpret_cast<const T*>(op.alphabet);
+  auto* result = reinterpret_cast<T*>(op.result);
+  auto bitWidth = op.bitWidth;
+  for (int32_t i = threadIdx.x; i < op.numValues; i += blockDim.x) {
+    auto& run = op.runs[findRun(op.runs, numRuns, i)];
+    uint64_t value = run.isBitpacked
+        ? loadBits(
+              op.input + run.value,
+              static_cast<int64_t>(i - run.firstRow) * bitWidth,
+              bitWidth)
+        : run.value;
+    if (op.nulls) {
+      op.nulls[i] = value == op.maxLevel ? kNotNull : kNull;
+      continue;
+    }
+    auto row = op.scatter ? op.scatter[i] : i;
+    result[row] = dict ? dict[value] : static_cast<T>(value);
+  }
+  // 'numRuns' is rewritten by the next step.
+  __syncthreads();
+}
+
+__device__ inline void decodeRleBitpack(GpuDecode& plan) {
+  auto& op = plan.data.rleBitpack;
+  if (op.nulls) {
+    decodeRleBitpack<uint8_t>(op);
+    return;
+  }
+  switch (op.dataType) {
+    case WaveTypeKind::TINYINT:
+      decodeRleBitpack<uint8_t>(op);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeRleBitpack<uint16_t>(op);
+      break;
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      decodeRleBitpack<uint32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      decodeRleBitpack<uint64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for RleBitpack\n");
+        assert(false);
+      }
+  }
+}
+
+// Decodes Parquet DELTA_BINARY_PACKED data. One thread reads the block
+// headers, then the deltas are unpacked in parallel and added up with a block
+// wide scan. 'T' is unsigned so that the sums wrap around like the encoder's.
+template <int kBlockSize, typename T>
+__device__ void decodeDeltaBinaryPacked(GpuDecode::DeltaBinaryPacked& op) {
+  using BlockScan = cub::BlockScan<T, kBlockSize>;
+  extern __shared__ char smem[];
+  auto* scanStorage = reinterpret_cast<typename BlockScan::TempStorage*>(smem);
+  __shared__ int32_t numValues;
+  __shared__ int32_t valuesPerMiniblock;
+  __shared__ T firstValue;
+  if (threadIdx.x == 0) {
+    auto* pos = reinterpret_cast<const char*>(op.input);
+    int32_t blockSize = readVarint32(&pos);
+    int32_t miniblocksPerBlock = readVarint32(&pos);
+    numValues = readVarint32(&pos);
+    firstValue = zigzagDecode(readVarint64(&pos));
+    valuesPerMiniblock = blockSize / miniblocksPerBlock;
+    int32_t numMiniblocks = 0;
+    int32_t covered = 1;
+    while (covered < numValues && numMiniblocks < op.maxMiniblocks) {
+      int64_t minDelta = zigzagDecode(readVarint64(&pos));
+      auto* bitWidths = reinterpret_cast<const uint8_t*>(pos);
+      pos += miniblocksPerBlock;
+      for (auto i = 0; i < miniblocksPerBlock && covered < numValues &&
+           numMiniblocks < op.maxMiniblocks;
+           ++i) {
+        auto& miniblock = op.miniblocks[numMiniblocks++];
+        miniblock.offset = reinterpret_cast<const uint8_t*>(pos) - op.input;
+        miniblock.bitWidth = bitWidths[i];
+        miniblock.minDelta = minDelta;
+        pos += valuesPerMiniblock / 8 * bitWidths[i];
+        covered += valuesPerMiniblock;
+      }
+    }
+    numValues = min(numValues, covered);
+    op.resultSize = numValues;
+  }
+  __syncthreads();
+  auto* result = reinterpret_cast<T*>(op.result);
+  if (threadIdx.x == 0 && numValues > 0) {
+    result[0] = firstValue;
+  }
+  T carry = firstValue;
+  for (int32_t base = 0; base < numValues - 1; base += blockDim.x) {
+    int32_t i = base + threadIdx.x;
+    T delta = 0;
+    if (i < numValues - 1) {
+      auto& miniblock = op.miniblocks[i / valuesPerMiniblock];
+      delta = miniblock.minDelta +
+          loadBits(
+                  op.input + miniblock.offset,
+                  static_cast<int64_t>(i % valuesPerMiniblock) *
+                      miniblock.bitWidth,
+                  miniblock.bitWidth);
+    }
+    T sum, total;
+    BlockScan(*scanStorage).InclusiveSum(delta, sum, total);
+    __syncthreads();
+    if (i < numValues - 1) {
+      result[i + 1] = carry + sum;
+    }
+    carry += total;
+  }
+  __syncthreads();
+}
+
+template <int kBlockSize>
+__device__ void decodeDeltaBinaryPacked(GpuDecode& plan) {
+  auto& op = plan.data.deltaBinaryPacked;
+  switch (op.dataType) {
+    case WaveTypeKind::INTEGER:
+      decodeDeltaBinaryPacked<kBlockSize, uint32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+      decodeDeltaBinaryPacked<kBlockSize, uint64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for DeltaBinaryPacked\n");
+        assert(false);
+      }
+  }
+}
+
 template <typename T>
 inline __device__ T randomAccessDecode(const GpuDecode* op, int32_t idx) {
   switch (op->encoding) {
@@ -901,6 +1115,12 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRowCountNoFilter:
       detail::setRowCountNoFilter<kBlockSize>(op.data.rowCountNoFilter);
       break;
+    case DecodeStep::kRleBitpack:
+      detail::decodeRleBitpack(op);
+      break;
+    case DecodeStep::kDeltaBinaryPacked:
+      detail::decodeDeltaBinaryPacked<kBlockSize>(op);
+      break;
     default:
       if (threadIdx.x == 0) {
         printf("ERROR: Unsupported DecodeStep (with shared memory)\n");
@@ -917,6 +1137,7 @@ template <int32_t kBlockSize>
 int32_t sharedMemorySizeForDecode(DecodeStep step) {
   using Reduce32 = cub::BlockReduce<int32_t, kBlockSize>;
   using BlockScan32 = cub::BlockScan<int32_t, kBlockSize>;
+  using BlockScan64 = cub::BlockScan<uint64_t, kBlockSize>;
   switch (step) {
     case DecodeStep::kSelective32:
     case DecodeStep::kSelective64:
@@ -926,6 +1147,7 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kCountBits:
     case DecodeStep::kSparseBool:
     case DecodeStep::kRowCountNoFilter:
+    case DecodeStep::kRleBitpack:
       return 0;
       break;
 
@@ -938,6 +1160,8 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kMakeScatterIndices:
     case DecodeStep::kLengthToOffset:
       return sizeof(typename BlockScan32::TempStorage);
+    case DecodeStep::kDeltaBinaryPacked:
+      return sizeof(typename BlockScan64::TempStorage);
     default:
       assert(false); // Undefined.
       return 0;
@@ -128,6 +128,105 @@ void makeBitpackDict(
       reinterpret_cast<T*>(memory), dictBytes + bitBytes + scatterBytes);
 }
 
+void appendVarint(uint64_t value, std::string& out) {
+  char buffer[10];
+  char* pos = buffer;
+  writeVarint(value, &pos);
+  out.append(buffer, pos - buffer);
+}
+
+// Appends 'count' values, a multiple of 8, packed LSB first in 'bitWidth'
+// bits each.
+void appendBitpacked(
+    const uint64_t* values,
+    int32_t count,
+    int32_t bitWidth,
+    std::string& out) {
+  std::vector<uint8_t> bytes(count * bitWidth / 8);
+  for (auto i = 0; i < count; ++i) {
+    for (auto bit = 0; bit < bitWidth; ++bit) {
+      if ((values[i] >> bit) & 1) {
+        setBit(bytes.data(), i * bitWidth + bit);
+      }
+    }
+  }
+  out.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+// Encodes 'values' as Parquet RLE/bit-packed hybrid data. Runs of 8 or more
+// equal values are RLE, the rest are bit-packed in groups of 8.
+std::string encodeRleBitpack(
+    const std::vector<uint64_t>& values,
+    int32_t bitWidth) {
+  std::string out;
+  int32_t i = 0;
+  while (i < values.size()) {
+    int32_t end = i + 1;
+    while (end < values.size() && values[end] == values[i]) {
+      ++end;
+    }
+    if (end - i >= 8) {
+      appendVarint((end - i) << 1, out);
+      for (auto byte = 0; byte < (bitWidth + 7) / 8; ++byte) {
+        out.push_back(static_cast<char>(values[i] >> (byte * 8)));
+      }
+      i = end;
+      continue;
+    }
+    uint64_t group[8] = {};
+    for (auto j = 0; j < 8 && i + j < values.size(); ++j) {
+      group[j] = values[i + j];
+    }
+    appendVarint((1 << 1) | 1, out);
+    appendBitpacked(group, 8, bitWidth, out);
+    i += 8;
+  }
+  return out;
+}
+
+// Encodes 'values' as Parquet DELTA_BINARY_PACKED with blocks of 128 values
+// in 4 miniblocks.
+std::string encodeDeltaBinaryPacked(const std::vector<int64_t>& values) {
+  constexpr int32_t kBlockSize = 128;
+  constexpr int32_t kMiniblocks = 4;
+  constexpr int32_t kValuesPerMiniblock = kBlockSize / kMiniblocks;
+  auto zigzag = [](int64_t value) -> uint64_t {
+    return (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+  };
+  std::string out;
+  appendVarint(kBlockSize, out);
+  appendVarint(kMiniblocks, out);
+  appendVarint(values.size(), out);
+  appendVarint(zigzag(values[0]), out);
+  for (auto start = 1; start < values.size(); start += kBlockSize) {
+    auto count = std::min<int32_t>(kBlockSize, values.size() - start);
+    std::vector<int64_t> deltas(count);
+    for (auto i = 0; i < count; ++i) {
+      deltas[i] = static_cast<uint64_t>(values[start + i]) -
+          static_cast<uint64_t>(values[start + i - 1]);
+    }
+    auto minDelta = *std::min_element(deltas.begin(), deltas.end());
+    appendVarint(zigzag(minDelta), out);
+    std::vector<uint64_t> packed(kBlockSize, 0);
+    uint8_t bitWidths[kMiniblocks] = {};
+    for (auto i = 0; i < count; ++i) {
+      packed[i] = static_cast<uint64_t>(deltas[i]) - minDelta;
+      auto width = packed[i] ? 64 - __builtin_clzll(packed[i]) : 0;
+      auto& miniblockWidth = bitWidths[i / kValuesPerMiniblock];
+      miniblockWidth = std::max<uint8_t>(miniblockWidth, width);
+    }
+    out.append(reinterpret_cast<const char*>(bitWidths), kMiniblocks);
+    for (auto i = 0; i * kValuesPerMiniblock < count; ++i) {
+      appendBitpacked(
+          packed.data() + i * kValuesPerMiniblock,
+          kValuesPerMiniblock,
+          bitWidths[i],
+          out);
+    }
+  }
+  return out;
+}
+
 class GpuDecoderTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -581,6 +680,92 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  template <int kBlockSize>
+  void testRleBitpack(int32_t numValues, int32_t bitWidth) {
+    std::vector<uint64_t> values(numValues);
+    fillRandom(values.data(), numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      // Alternate runs of repeated values and random values.
+      values[i] = (i / 100) % 2 ? 1 : values[i] & ((1UL << bitWidth) - 1);
+    }
+    auto encoded = encodeRleBitpack(values, bitWidth);
+    auto input = allocate<uint8_t>(encoded.size());
+    memcpy(input.get(), encoded.data(), encoded.size());
+    auto runs = allocate<RleBitpackRun>(numValues);
+    auto alphabet = allocate<int64_t>(1 << bitWidth);
+    for (auto i = 0; i < 1 << bitWidth; ++i) {
+      alphabet[i] = i * 1000 - 7;
+    }
+    auto result = allocate<int64_t>(numValues);
+    auto nulls = allocate<uint8_t>(numValues);
+    auto ops = allocate<GpuDecode>(2);
+    for (auto i = 0; i < 2; ++i) {
+      ops[i].step = DecodeStep::kRleBitpack;
+      auto& op = ops[i].data.rleBitpack;
+      op.input = input.get();
+      op.inputSize = encoded.size();
+      op.bitWidth = bitWidth;
+      op.numValues = numValues;
+      op.runs = runs.get();
+      op.dataType = WaveTypeKind::BIGINT;
+      op.alphabet = alphabet.get();
+      op.scatter = nullptr;
+      op.nulls = nullptr;
+      op.maxLevel = 0;
+      op.result = result.get();
+    }
+    // The second op reads the same data as definition levels.
+    ops[1].data.rleBitpack.nulls = nulls.get();
+    ops[1].data.rleBitpack.maxLevel = 1;
+    testCase(
+        "",
+        [&] { decodeGlobal<kBlockSize>(ops.get(), 1); },
+        numValues * sizeof(int64_t),
+        3);
+    decodeGlobal<kBlockSize>(ops.get() + 1, 1);
+    CUDA_CHECK_FATAL(cudaGetLastError());
+    CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(result[i], alphabet[values[i]]) << i;
+      ASSERT_EQ(nulls[i], values[i] == 1 ? kNotNull : kNull) << i;
+    }
+  }
+
+  template <typename T, int kBlockSize>
+  void testDeltaBinaryPacked(int32_t numValues) {
+    std::vector<int64_t> values(numValues);
+    fillRandom(values.data(), numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      // Mostly small deltas with some large jumps.
+      values[i] = static_cast<T>(
+          i % 1000 == 0 ? values[i] : i * 3 + (values[i] & 0xff));
+    }
+    auto encoded = encodeDeltaBinaryPacked(values);
+    auto input = allocate<uint8_t>(encoded.size());
+    memcpy(input.get(), encoded.data(), encoded.size());
+    int32_t maxMiniblocks = numValues / 32 + 1;
+    auto miniblocks = allocate<DeltaMiniblock>(maxMiniblocks);
+    auto result = allocate<T>(numValues);
+    auto ops = allocate<GpuDecode>(1);
+    ops[0].step = DecodeStep::kDeltaBinaryPacked;
+    auto& op = ops[0].data.deltaBinaryPacked;
+    op.input = input.get();
+    op.inputSize = encoded.size();
+    op.miniblocks = miniblocks.get();
+    op.maxMiniblocks = maxMiniblocks;
+    op.dataType = WaveTypeTrait<T>::typeKind;
+    op.result = result.get();
+    testCase(
+        "",
+        [&] { decodeGlobal<kBlockSize>(ops.get(), 1); },
+        numValues * sizeof(T),
+        3);
+    ASSERT_EQ(op.resultSize, numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(result[i], static_cast<T>(values[i])) << i;
+    }
+  }
+
  private:
   std::unique_ptr<GpuArena> arena_;
 
@@ -632,6 +817,16 @@ TEST_F(GpuDecoderTest, countBits) {
   testCountBits(100000, 2048);
 }
 
+TEST_F(GpuDecoderTest, rleBitpack) {
+  testRleBitpack<256>(10'007, 1);
+  testRleBitpack<256>(100'003, 11);
+}
+
+TEST_F(GpuDecoderTest, deltaBinaryPacked) {
+  testDeltaBinaryPacked<int32_t, 256>(10'007);
+  testDeltaBinaryPacked<int64_t, 256>(100'003);
+}
+
 TEST_F(GpuDecoderTest, streamApi) {
   //  One call with few blocks, another with many, to cover inlined and out of
   //  line params.
@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoin.h"
+
+#include <numeric>
+
+#include "velox/exec/HashTable.h"
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+DEFINE_int64(
+    velox_wave_join_device_bytes,
+    256 << 20,
+    "Build side rows of a Wave hash join larger than this are kept in host "
+    "memory");
+
+namespace facebook::velox::wave {
+
+namespace {
+
+// Rows of the CPU hash table listed at a time.
+constexpr int32_t kListBatchSize = 1024;
+
+// GPU cache lines are 128 bytes divided in 4 separately loadable 32 byte
+// sectors.
+constexpr int32_t kBucketAlignment = 128;
+
+bool isKeyType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool isColumnType(const Type& type) {
+  return isKeyType(type) || type.kind() == TypeKind::REAL ||
+      type.kind() == TypeKind::DOUBLE;
+}
+
+hashjoin::JoinType toJoinType(core::JoinType joinType) {
+  switch (joinType) {
+    case core::JoinType::kInner:
+      return hashjoin::JoinType::kInner;
+    case core::JoinType::kLeft:
+      return hashjoin::JoinType::kLeft;
+    case core::JoinType::kLeftSemiFilter:
+      return hashjoin::JoinType::kLeftSemi;
+    default:
+      VELOX_UNSUPPORTED(
+          "Wave hash join does not support {}", core::joinTypeName(joinType));
+  }
+}
+
+// Widens row 'row' of 'width' byte values to 8 bytes, like the kernels do for
+// the probe side.
+int64_t widen(const void* values, int32_t width, vector_size_t row) {
+  switch (width) {
+    case 1:
+      return static_cast<const int8_t*>(values)[row];
+    case 2:
+      return static_cast<const int16_t*>(values)[row];
+    case 4:
+      return static_cast<const int32_t*>(values)[row];
+    default:
+      return static_cast<const int64_t*>(values)[row];
+  }
+}
+
+template <typename T>
+T* allocateArray(GpuArena& arena, size_t size, WaveBufferPtr& holder) {
+  return arena.allocate<T>(std::max<size_t>(size, 1), holder);
+}
+
+// Keeps the probe input and probe state alive until the result is gathered.
+struct JoinExecutable : public Executable {
+  HashJoin::ProbeBatch batch;
+};
+
+} // namespace
+
+HashJoin::HashJoin(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()),
+      joinType_(toJoinType(node.joinType())),
+      bridge_(state.driver().task()->getHashJoinBridgeLocked(
+          state.driver().driverCtx()->splitGroupId,
+          node.id())) {
+  VELOX_CHECK_NOT_NULL(bridge_);
+  auto& probeType = node.sources()[0]->outputType();
+  auto& buildType = node.sources()[1]->outputType();
+  const auto numKeys = node.leftKeys().size();
+
+  // The CPU hash table has the build keys first and then the other build side
+  // columns.
+  std::vector<column_index_t> tableColumns(buildType->size());
+  std::vector<bool> isKey(buildType->size());
+  for (auto i = 0; i < numKeys; ++i) {
+    probeKeyChannels_.push_back(
+        probeType->getChildIdx(node.leftKeys()[i]->name()));
+    auto channel = buildType->getChildIdx(node.rightKeys()[i]->name());
+    tableColumns[channel] = i;
+    isKey[channel] = true;
+  }
+  column_index_t column = numKeys;
+  for (auto i = 0; i < buildType->size(); ++i) {
+    if (!isKey[i]) {
+      tableColumns[i] = column++;
+    }
+  }
+
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto& name = outputType_->nameOf(i);
+    if (auto channel = probeType->getChildIdxIfExists(name)) {
+      probeOutputs_.emplace_back(channel.value(), i);
+      continue;
+    }
+    auto tableColumn = tableColumns[buildType->getChildIdx(name)];
+    if (tableColumn < numKeys) {
+      buildOutputs_.emplace_back(tableColumn, i);
+    } else {
+      buildOutputs_.emplace_back(numKeys + payloadColumns_.size(), i);
+      payloadColumns_.push_back(tableColumn);
+    }
+  }
+  VELOX_CHECK_LE(numKeys + payloadColumns_.size(), hashjoin::kMaxColumns);
+
+  keyWidths_ = allocateArray<int8_t>(
+      *arena_, numKeys, columnsHolder_.keyWidths);
+  for (auto i = 0; i < numKeys; ++i) {
+    keyWidths_[i] = node.leftKeys()[i]->type()->cppSizeInBytes();
+  }
+  probeWidths_ = allocateArray<int8_t>(
+      *arena_, probeOutputs_.size(), columnsHolder_.probeWidths);
+  for (auto i = 0; i < probeOutputs_.size(); ++i) {
+    probeWidths_[i] =
+        outputType_->childAt(probeOutputs_[i].second)->cppSizeInBytes();
+  }
+  buildWidths_ = allocateArray<int8_t>(
+      *arena_, buildOutputs_.size(), columnsHolder_.buildWidths);
+  buildColumns_ = allocateArray<int32_t>(
+      *arena_, buildOutputs_.size(), columnsHolder_.buildColumns);
+  for (auto i = 0; i < buildOutputs_.size(); ++i) {
+    buildWidths_[i] =
+        outputType_->childAt(buildOutputs_[i].second)->cppSizeInBytes();
+    buildColumns_[i] = buildOutputs_[i].first;
+  }
+}
+
+HashJoin::~HashJoin() {
+  if (!probing_.empty()) {
+    flushDone_.wait();
+  }
+  if (flushStream_) {
+    WaveStream::releaseStream(std::move(flushStream_));
+  }
+}
+
+// static
+bool HashJoin::isSupported(
+    const core::HashJoinNode& node,
+    const core::QueryConfig& config) {
+  if (!node.isInnerJoin() && !node.isLeftJoin() &&
+      !node.isLeftSemiFilterJoin()) {
+    return false;
+  }
+  // The build side is taken as is from the HashBuild, which must not spill.
+  if (node.filter() || node.isNullAware() ||
+      (config.spillEnabled() && config.joinSpillEnabled())) {
+    return false;
+  }
+  if (node.leftKeys().size() > hashjoin::kMaxKeys) {
+    return false;
+  }
+  for (auto& key : node.leftKeys()) {
+    if (!isKeyType(*key->type())) {
+      return false;
+    }
+  }
+  for (auto& type : node.outputType()->children()) {
+    if (!isColumnType(*type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+exec::BlockingReason HashJoin::isBlocked(ContinueFuture* future) {
+  if (table_) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  auto result = bridge_->tableOrFuture(future);
+  if (!result.has_value()) {
+    return exec::BlockingReason::kWaitForJoinBuild;
+  }
+  VELOX_CHECK(result->spillPartitionIds.empty());
+  VELOX_CHECK_NOT_NULL(result->table);
+  buildTable(*result->table);
+  return exec::BlockingReason::kNotBlocked;
+}
+
+void HashJoin::buildTable(exec::BaseHashTable& table) {
+  std::vector<char*> rows;
+  std::vector<char*> batch(kListBatchSize);
+  exec::BaseHashTable::RowsIterator iter;
+  while (auto numListed = table.listAllRows(
+             &iter,
+             batch.size(),
+             exec::RowContainer::kUnlimited,
+             batch.data())) {
+    rows.insert(rows.end(), batch.begin(), batch.begin() + numListed);
+  }
+
+  // Table columns in JoinRow order.
+  const int32_t numKeys = probeKeyChannels_.size();
+  std::vector<column_index_t> columns(numKeys);
+  std::iota(columns.begin(), columns.end(), 0);
+  columns.insert(columns.end(), payloadColumns_.begin(), payloadColumns_.end());
+  auto* container = table.rows();
+  std::vector<VectorPtr> values(columns.size());
+  std::vector<const void*> rawValues(columns.size());
+  std::vector<int32_t> widths(columns.size());
+  for (auto i = 0; i < columns.size(); ++i) {
+    auto& type = container->columnTypes()[columns[i]];
+    values[i] = BaseVector::create(type, rows.size(), driver_->pool());
+    exec::RowContainer::extractColumn(
+        rows.data(), rows.size(), container->columnAt(columns[i]), values[i]);
+    rawValues[i] = values[i]->values()->as<void>();
+    widths[i] = type->cppSizeInBytes();
+  }
+
+  const int32_t rowSize =
+      sizeof(hashjoin::JoinRow) + columns.size() * sizeof(int64_t);
+  const uint64_t rowBytes =
+      static_cast<uint64_t>(rowSize) * std::max<size_t>(rows.size(), 1);
+  if (rowBytes > FLAGS_velox_wave_join_device_bytes) {
+    // The kernels read the rows from pinned host memory over the bus.
+    hostArena_ = std::make_unique<GpuArena>(
+        GpuSlab::roundBytes(rowBytes), getHostAllocator(getDevice()));
+    tableHolder_.rows = hostArena_->allocateBytes(rowBytes);
+  } else {
+    tableHolder_.rows = arena_->allocateBytes(rowBytes);
+  }
+  auto* data = tableHolder_.rows->as<char>();
+  int32_t numRows = 0;
+  for (auto row = 0; row < rows.size(); ++row) {
+    auto* joinRow = reinterpret_cast<hashjoin::JoinRow*>(
+        data + static_cast<int64_t>(numRows) * rowSize);
+    auto* rowValues = reinterpret_cast<int64_t*>(joinRow + 1);
+    joinRow->next = nullptr;
+    joinRow->nulls = 0;
+    bool nullKey = false;
+    for (auto i = 0; i < columns.size(); ++i) {
+      if (values[i]->isNullAt(row)) {
+        if (i < numKeys) {
+          nullKey = true;
+          break;
+        }
+        joinRow->nulls |= 1ULL << i;
+        continue;
+      }
+      rowValues[i] = widen(rawValues[i], widths[i], row);
+    }
+    if (!nullKey) {
+      ++numRows;
+    }
+  }
+
+  // Sized for a load factor of at most 1/2 with 4 slots per bucket.
+  const int32_t numBuckets =
+      bits::nextPowerOfTwo(std::max<int32_t>(16, numRows / 2));
+  auto* hashTable =
+      arena_->allocate<GpuHashTableBase>(1, tableHolder_.hashTable);
+  new (hashTable) GpuHashTableBase();
+  tableHolder_.buckets = arena_->allocateBytes(
+      sizeof(GpuBucketMembers) * numBuckets + kBucketAlignment);
+  auto* buckets = reinterpret_cast<char*>(bits::roundUp(
+      reinterpret_cast<uint64_t>(tableHolder_.buckets->as<char>()),
+      kBucketAlignment));
+  memset(buckets, 0, sizeof(GpuBucketMembers) * numBuckets);
+  hashTable->buckets = reinterpret_cast<GpuBucket*>(buckets);
+  hashTable->sizeMask = numBuckets - 1;
+
+  table_ = arena_->allocate<hashjoin::JoinTable>(1, tableHolder_.table);
+  table_->hashTable = hashTable;
+  table_->numKeys = numKeys;
+  table_->numColumns = columns.size();
+  table_->rowSize = rowSize;
+  table_->numRows = numRows;
+  table_->rows = data;
+  if (numRows == 0) {
+    return;
+  }
+
+  const int32_t numBlocks = bits::roundUp(numRows, kBlockSize) / kBlockSize;
+  auto* probe = arena_->allocate<HashProbe>(1, tableHolder_.probe);
+  // The build never needs retries, so only the row counts are set.
+  new (probe) HashProbe();
+  probe->numRows =
+      arena_->allocate<int32_t>(numBlocks, tableHolder_.blockNumRows);
+  for (auto i = 0; i < numBlocks; ++i) {
+    probe->numRows[i] = std::min(kBlockSize, numRows - i * kBlockSize);
+  }
+  if (!flushStream_) {
+    flushStream_ = WaveStream::streamFromReserve();
+  }
+  hashjoin::build(*flushStream_, table_, probe, numBlocks);
+  flushStream_->wait();
+}
+
+void HashJoin::startProbe(WaveVectorPtr input) {
+  auto& batch = probing_.emplace_back();
+  batch.input = std::move(input);
+  const auto numRows = batch.input->size();
+  auto* probe = arena_->allocate<hashjoin::JoinProbe>(1, batch.probeHolder);
+  probe->table = table_;
+  probe->joinType = joinType_;
+  probe->numRows = numRows;
+  probe->keys = allocateArray<Operand>(
+      *arena_, probeKeyChannels_.size(), batch.keys);
+  for (auto i = 0; i < probeKeyChannels_.size(); ++i) {
+    batch.input->childAt(probeKeyChannels_[i]).toOperand(&probe->keys[i]);
+  }
+  probe->keyWidths = keyWidths_;
+  probe->hits = allocateArray<hashjoin::JoinRow*>(*arena_, numRows, batch.hits);
+  probe->counts = allocateArray<int32_t>(*arena_, numRows, batch.counts);
+  probe->offsets = allocateArray<int32_t>(*arena_, numRows, batch.offsets);
+  probe->numProbeColumns = probeOutputs_.size();
+  probe->probeColumns = allocateArray<Operand>(
+      *arena_, probeOutputs_.size(), batch.probeColumns);
+  for (auto i = 0; i < probeOutputs_.size(); ++i) {
+    batch.input->childAt(probeOutputs_[i].first)
+        .toOperand(&probe->probeColumns[i]);
+  }
+  // The results are set when the output is scheduled.
+  probe->probeResults = nullptr;
+  probe->probeWidths = probeWidths_;
+  probe->numBuildColumns = buildOutputs_.size();
+  probe->buildColumns = buildColumns_;
+  probe->buildResults = nullptr;
+  probe->buildWidths = buildWidths_;
+  batch.probe = probe;
+  hashjoin::probe(*flushStream_, probe, numRows);
+}
+
+void HashJoin::finishProbes() {
+  flushDone_.wait();
+  for (auto& batch : probing_) {
+    auto* probe = batch.probe;
+    int32_t numOutput = 0;
+    for (auto i = 0; i < probe->numRows; ++i) {
+      probe->offsets[i] = numOutput;
+      numOutput += probe->counts[i];
+    }
+    batch.numOutput = numOutput;
+    if (numOutput > 0) {
+      ready_.push_back(std::move(batch));
+    }
+  }
+  probing_.clear();
+}
+
+void HashJoin::flush(bool noMoreInput) {
+  if (noMoreInput) {
+    noMoreInput_ = true;
+  } else {
+    VELOX_CHECK(!noMoreInput_);
+  }
+  if (!probing_.empty()) {
+    if (!noMoreInput && !flushDone_.query()) {
+      return;
+    }
+    finishProbes();
+  }
+  if (buffered_.empty()) {
+    return;
+  }
+  VELOX_CHECK_NOT_NULL(table_, "Probe input before the build side is ready");
+  if (!flushStream_) {
+    flushStream_ = WaveStream::streamFromReserve();
+  }
+  for (auto& input : buffered_) {
+    startProbe(std::move(input));
+  }
+  buffered_.clear();
+  flushDone_.record(*flushStream_);
+}
+
+int32_t HashJoin::canAdvance(WaveStream& /*stream*/) {
+  if (!probing_.empty() && (noMoreInput_ || flushDone_.query())) {
+    finishProbes();
+  }
+  return ready_.empty() ? 0 : ready_.front().numOutput;
+}
+
+void HashJoin::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK(!ready_.empty());
+  auto joinExecutable = std::make_unique<JoinExecutable>();
+  joinExecutable->batch = std::move(ready_.front());
+  ready_.pop_front();
+  VELOX_CHECK_EQ(maxRows, joinExecutable->batch.numOutput);
+  auto* probe = joinExecutable->batch.probe;
+  std::unique_ptr<Executable> exec = std::move(joinExecutable);
+
+  const int32_t numColumns = outputType_->size();
+  auto numBlocks = bits::roundUp(maxRows, kBlockSize) / kBlockSize;
+  auto* rowStatus =
+      arena_->allocate<BlockStatus>(numBlocks, exec->deviceData.emplace_back());
+  bzero(rowStatus, numBlocks * sizeof(BlockStatus));
+  for (auto i = 0; i < numBlocks; ++i) {
+    rowStatus[i].numRows =
+        i == numBlocks - 1 ? maxRows - kBlockSize * i : kBlockSize;
+  }
+  exec->operands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->firstOutputOperandIdx = 0;
+  for (auto i = 0; i < numColumns; ++i) {
+    auto column = WaveVector::create(outputType_->childAt(i), *arena_);
+    column->resize(maxRows, true);
+    column->toOperand(&exec->operands[i]);
+    exec->output.push_back(std::move(column));
+  }
+  probe->probeResults = allocateArray<Operand>(
+      *arena_, probeOutputs_.size(), exec->deviceData.emplace_back());
+  for (auto i = 0; i < probeOutputs_.size(); ++i) {
+    probe->probeResults[i] = exec->operands[probeOutputs_[i].second];
+  }
+  probe->buildResults = allocateArray<Operand>(
+      *arena_, buildOutputs_.size(), exec->deviceData.emplace_back());
+  for (auto i = 0; i < buildOutputs_.size(); ++i) {
+    probe->buildResults[i] = exec->operands[buildOutputs_[i].second];
+  }
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        auto control = std::make_unique<LaunchControl>(id_, maxRows);
+        control->status = rowStatus;
+        waveStream.addLaunchControl(id_, std::move(control));
+        hashjoin::gather(*stream, probe, probe->numRows);
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+}
+
+vector_size_t HashJoin::outputSize(WaveStream& stream) const {
+  auto& control = stream.launchControls(id_);
+  VELOX_CHECK(!control.empty());
+  return control[0]->inputRows;
+}
+
+} // namespace facebook::velox::wave
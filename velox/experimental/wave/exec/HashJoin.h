@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/HashJoinBridge.h"
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Probe side of an inner, left or left semi hash join on fixed width keys.
+/// The build side is the table built by the HashBuild of the join. When that
+/// is ready, its rows are copied into a GpuHashTable, in host memory if they
+/// are larger than --velox_wave_join_device_bytes. The probe input is then
+/// joined on the device and the result stays on the device.
+class HashJoin : public WaveOperator {
+ public:
+  HashJoin(CompileState& state, const core::HashJoinNode& node);
+
+  ~HashJoin() override;
+
+  /// Returns true if 'node' can run on the device.
+  static bool isSupported(
+      const core::HashJoinNode& node,
+      const core::QueryConfig& config);
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && buffered_.empty() && probing_.empty() &&
+        ready_.empty();
+  }
+
+  vector_size_t outputSize(WaveStream& stream) const override;
+
+  std::string toString() const override {
+    return "HashJoin";
+  }
+
+  /// A batch of probe input and the device memory for probing it.
+  struct ProbeBatch {
+    WaveVectorPtr input;
+    hashjoin::JoinProbe* probe{nullptr};
+    int32_t numOutput{0};
+    WaveBufferPtr probeHolder;
+    WaveBufferPtr keys;
+    WaveBufferPtr probeColumns;
+    WaveBufferPtr hits;
+    WaveBufferPtr counts;
+    WaveBufferPtr offsets;
+  };
+
+ private:
+  // Copies the rows of 'table' to the device and builds 'table_'.
+  void buildTable(exec::BaseHashTable& table);
+
+  // Starts probing 'input' on 'flushStream_'.
+  void startProbe(WaveVectorPtr input);
+
+  // Waits for the probes in 'probing_', sets their result row numbers and
+  // moves the ones with results to 'ready_'.
+  void finishProbes();
+
+  GpuArena* arena_;
+
+  const hashjoin::JoinType joinType_;
+
+  std::shared_ptr<exec::HashJoinBridge> bridge_;
+
+  // Channels of the probe keys in the probe input.
+  std::vector<column_index_t> probeKeyChannels_;
+
+  // Columns of the CPU hash table that are copied to the JoinRows after the
+  // keys.
+  std::vector<column_index_t> payloadColumns_;
+
+  // Probe input channel and result channel for each probe side result.
+  std::vector<std::pair<column_index_t, column_index_t>> probeOutputs_;
+
+  // Column in the JoinRow and result channel for each build side result.
+  std::vector<std::pair<int32_t, column_index_t>> buildOutputs_;
+
+  // Device arrays referenced from each JoinProbe.
+  int8_t* keyWidths_;
+  int8_t* probeWidths_;
+  int8_t* buildWidths_;
+  int32_t* buildColumns_;
+  struct {
+    WaveBufferPtr keyWidths;
+    WaveBufferPtr probeWidths;
+    WaveBufferPtr buildWidths;
+    WaveBufferPtr buildColumns;
+  } columnsHolder_;
+
+  hashjoin::JoinTable* table_{nullptr};
+  struct {
+    WaveBufferPtr table;
+    WaveBufferPtr hashTable;
+    WaveBufferPtr buckets;
+    WaveBufferPtr rows;
+    WaveBufferPtr probe;
+    WaveBufferPtr blockNumRows;
+  } tableHolder_;
+
+  // Arena for JoinRows that do not fit on the device.
+  std::unique_ptr<GpuArena> hostArena_;
+
+  std::vector<WaveVectorPtr> buffered_;
+  std::deque<ProbeBatch> probing_;
+  std::deque<ProbeBatch> ready_;
+  std::unique_ptr<Stream> flushStream_;
+  Event flushDone_;
+
+  bool noMoreInput_ = false;
+};
+
+} // namespace facebook::velox::wave
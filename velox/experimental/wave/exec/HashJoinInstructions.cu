@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+
+#include "velox/experimental/wave/common/HashTable.cuh"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+namespace facebook::velox::wave::hashjoin {
+
+namespace {
+
+__device__ inline int64_t* rowValues(JoinRow* row) {
+  return reinterpret_cast<int64_t*>(row + 1);
+}
+
+__device__ inline JoinRow* rowAt(JoinTable* table, int32_t i) {
+  return reinterpret_cast<JoinRow*>(
+      table->rows + static_cast<int64_t>(i) * table->rowSize);
+}
+
+__device__ inline uint64_t hashKeys(const int64_t* keys, int32_t numKeys) {
+  uint64_t hash = 1;
+  for (auto i = 0; i < numKeys; ++i) {
+    hash = hashMix(hash, keys[i]);
+  }
+  return hash;
+}
+
+__device__ inline bool
+keysEqual(const int64_t* left, const int64_t* right, int32_t numKeys) {
+  for (auto i = 0; i < numKeys; ++i) {
+    if (left[i] != right[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Reads row 'i' of 'op' as a 'width' byte integer widened to 8 bytes. Floating
+// point values are read as their bits. Returns false if the value is null.
+__device__ inline bool
+loadValue(Operand* op, int32_t i, int8_t width, int64_t& result) {
+  if (op->indices && op->indices[0]) {
+    i = op->indices[0][i];
+  }
+  if (op->nulls && op->nulls[i] == kNull) {
+    return false;
+  }
+  switch (width) {
+    case 1:
+      result = reinterpret_cast<const int8_t*>(op->base)[i];
+      break;
+    case 2:
+      result = reinterpret_cast<const int16_t*>(op->base)[i];
+      break;
+    case 4:
+      result = reinterpret_cast<const int32_t*>(op->base)[i];
+      break;
+    default:
+      result = reinterpret_cast<const int64_t*>(op->base)[i];
+      break;
+  }
+  return true;
+}
+
+__device__ inline void
+storeValue(Operand* op, int32_t i, int8_t width, int64_t value) {
+  switch (width) {
+    case 1:
+      reinterpret_cast<int8_t*>(op->base)[i] = value;
+      break;
+    case 2:
+      reinterpret_cast<int16_t*>(op->base)[i] = value;
+      break;
+    case 4:
+      reinterpret_cast<int32_t*>(op->base)[i] = value;
+      break;
+    default:
+      reinterpret_cast<int64_t*>(op->base)[i] = value;
+      break;
+  }
+  if (op->nulls) {
+    op->nulls[i] = kNotNull;
+  }
+}
+
+/// Ops for GpuHashTable::updatingProbe that insert the rows of a JoinTable.
+/// The rows are written by the host, so nothing is allocated and there are no
+/// retries. A row with the key of an earlier row is linked behind it.
+class BuildOps {
+ public:
+  explicit __device__ BuildOps(JoinTable* table) : table_(table) {}
+
+  int32_t __device__ blockBase(HashProbe* probe) {
+    return probe->numRowsPerThread * blockDim.x * blockIdx.x;
+  }
+
+  int32_t __device__ numRowsInBlock(HashProbe* probe) {
+    return probe->numRows[blockIdx.x];
+  }
+
+  uint64_t __device__ hash(int32_t i, HashProbe* /*probe*/) {
+    return hashKeys(rowValues(rowAt(table_, i)), table_->numKeys);
+  }
+
+  bool __device__ compare(
+      GpuHashTable* /*table*/,
+      JoinRow* row,
+      int32_t i,
+      HashProbe* /*probe*/) {
+    return keysEqual(
+        rowValues(row), rowValues(rowAt(table_, i)), table_->numKeys);
+  }
+
+  ProbeState __device__ insert(
+      GpuHashTable* /*table*/,
+      int32_t /*partition*/,
+      GpuBucket* bucket,
+      uint32_t misses,
+      uint32_t oldTags,
+      uint32_t tagWord,
+      int32_t i,
+      HashProbe* /*probe*/,
+      JoinRow*& row) {
+    auto missShift = __ffs(misses) - 1;
+    if (!bucket->addNewTag(tagWord, oldTags, missShift)) {
+      // The row stays owned by 'table_', there is nothing to free.
+      row = nullptr;
+      return ProbeState::kRetry;
+    }
+    row = rowAt(table_, i);
+    bucket->store(missShift / 8, row);
+    return ProbeState::kDone;
+  }
+
+  JoinRow* __device__ getExclusive(
+      GpuHashTable* /*table*/,
+      GpuBucket* /*bucket*/,
+      JoinRow* row,
+      int32_t /*hitIdx*/,
+      int32_t /*warp*/) {
+    return row;
+  }
+
+  void __device__ writeDone(JoinRow* /*row*/) {}
+
+  ProbeState __device__ update(
+      GpuHashTable* /*table*/,
+      GpuBucket* /*bucket*/,
+      JoinRow* row,
+      int32_t i,
+      HashProbe* /*probe*/) {
+    auto* added = rowAt(table_, i);
+    if (added != row) {
+      // Other warps may add rows with the same key at the same time.
+      added->next = reinterpret_cast<JoinRow*>(atomicExch(
+          reinterpret_cast<unsigned long long*>(&row->next),
+          reinterpret_cast<unsigned long long>(added)));
+    }
+    return ProbeState::kDone;
+  }
+
+ private:
+  JoinTable* const table_;
+};
+
+/// Ops for GpuHashTable::readOnlyProbe that look up the probe rows of a
+/// JoinProbe. Each thread keeps the keys of the row it is probing.
+class ProbeOps {
+ public:
+  explicit __device__ ProbeOps(JoinProbe* probe) : probe_(probe) {}
+
+  int32_t __device__ blockBase(HashProbe* /*probe*/) {
+    return blockDim.x * blockIdx.x;
+  }
+
+  int32_t __device__ numRowsInBlock(HashProbe* probe) {
+    return min(
+        static_cast<int32_t>(blockDim.x), probe_->numRows - blockBase(probe));
+  }
+
+  uint64_t __device__ hash(int32_t i, HashProbe* /*probe*/) {
+    auto numKeys = probe_->table->numKeys;
+    hasNull_ = false;
+    for (auto k = 0; k < numKeys; ++k) {
+      if (!loadValue(
+              &probe_->keys[k], i, probe_->keyWidths[k], keys_[k])) {
+        hasNull_ = true;
+      }
+    }
+    return hashKeys(keys_, numKeys);
+  }
+
+  bool __device__ compare(
+      GpuHashTable* /*table*/,
+      JoinRow* row,
+      int32_t /*i*/,
+      HashProbe* /*probe*/) {
+    return !hasNull_ &&
+        keysEqual(rowValues(row), keys_, probe_->table->numKeys);
+  }
+
+  void __device__ hit(int32_t i, HashProbe* /*probe*/, JoinRow* row) {
+    probe_->hits[i] = row;
+    int32_t count = 1;
+    if (probe_->joinType != JoinType::kLeftSemi) {
+      for (auto* next = row->next; next; next = next->next) {
+        ++count;
+      }
+    }
+    probe_->counts[i] = count;
+  }
+
+  void __device__ miss(int32_t i, HashProbe* /*probe*/) {
+    probe_->hits[i] = nullptr;
+    probe_->counts[i] = probe_->joinType == JoinType::kLeft ? 1 : 0;
+  }
+
+ private:
+  JoinProbe* const probe_;
+  int64_t keys_[kMaxKeys];
+  bool hasNull_{false};
+};
+
+void __global__ __launch_bounds__(1024)
+    buildKernel(JoinTable* table, HashProbe* probe) {
+  reinterpret_cast<GpuHashTable*>(table->hashTable)
+      ->updatingProbe<JoinRow>(probe, BuildOps(table));
+}
+
+void __global__ __launch_bounds__(1024) probeKernel(JoinProbe* probe) {
+  // ProbeOps take their operands from 'probe', not from a HashProbe.
+  reinterpret_cast<GpuHashTable*>(probe->table->hashTable)
+      ->readOnlyProbe<JoinRow>(nullptr, ProbeOps(probe));
+}
+
+void __global__ __launch_bounds__(1024) gatherKernel(JoinProbe* probe) {
+  int32_t i = threadIdx.x + blockIdx.x * blockDim.x;
+  if (i >= probe->numRows) {
+    return;
+  }
+  auto count = probe->counts[i];
+  auto out = probe->offsets[i];
+  auto* row = probe->hits[i];
+  for (auto n = 0; n < count; ++n, ++out) {
+    for (auto c = 0; c < probe->numProbeColumns; ++c) {
+      auto* result = &probe->probeResults[c];
+      int64_t value;
+      if (loadValue(&probe->probeColumns[c], i, probe->probeWidths[c], value)) {
+        storeValue(result, out, probe->probeWidths[c], value);
+      } else {
+        result->nulls[out] = kNull;
+      }
+    }
+    for (auto c = 0; c < probe->numBuildColumns; ++c) {
+      auto* result = &probe->buildResults[c];
+      auto column = probe->buildColumns[c];
+      if (row && !(row->nulls & (1ULL << column))) {
+        storeValue(
+            result, out, probe->buildWidths[c], rowValues(row)[column]);
+      } else {
+        result->nulls[out] = kNull;
+      }
+    }
+    if (row) {
+      row = row->next;
+    }
+  }
+}
+
+int32_t numBlocks(int32_t numRows) {
+  return (numRows + kBlockSize - 1) / kBlockSize;
+}
+
+} // namespace
+
+void build(
+    Stream& stream,
+    JoinTable* table,
+    HashProbe* probe,
+    int32_t numBlocks) {
+  buildKernel<<<
+      numBlocks,
+      kBlockSize,
+      GpuHashTable::updatingProbeSharedSize(),
+      stream.stream()->stream>>>(table, probe);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void probe(Stream& stream, JoinProbe* probe, int32_t numRows) {
+  if (numRows == 0) {
+    return;
+  }
+  probeKernel<<<numBlocks(numRows), kBlockSize, 0, stream.stream()->stream>>>(
+      probe);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void gather(Stream& stream, JoinProbe* probe, int32_t numRows) {
+  if (numRows == 0) {
+    return;
+  }
+  gatherKernel<<<numBlocks(numRows), kBlockSize, 0, stream.stream()->stream>>>(
+      probe);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::hashjoin
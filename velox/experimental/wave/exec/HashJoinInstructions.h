@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/HashTable.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+namespace facebook::velox::wave::hashjoin {
+
+/// Maximum number of join keys.
+constexpr int32_t kMaxKeys = 4;
+
+/// Maximum number of keys and payload columns in a JoinRow.
+constexpr int32_t kMaxColumns = 64;
+
+/// Header of a build side row. It is followed by the keys and then the payload
+/// columns, each widened to 8 bytes. Rows with equal keys are chained through
+/// 'next' from the row that is in the hash table.
+struct JoinRow {
+  JoinRow* next;
+
+  // Bit i is set if column i is null. Rows with null keys are not added to
+  // the table.
+  uint64_t nulls;
+};
+
+/// The build side of a join. The rows are written on the host and added to
+/// 'hashTable' by build().
+struct JoinTable {
+  GpuHashTableBase* hashTable;
+  int32_t numKeys;
+  int32_t numColumns;
+  int32_t rowSize;
+  int32_t numRows;
+
+  // 'numRows' rows of 'rowSize' bytes. May be in host memory if the build
+  // side does not fit on the device.
+  char* rows;
+};
+
+enum class JoinType : uint8_t { kInner, kLeft, kLeftSemi };
+
+/// Operands for probing a JoinTable with one batch of probe rows.
+struct JoinProbe {
+  JoinTable* table;
+  JoinType joinType;
+  int32_t numRows;
+
+  // Probe side keys, one per key of 'table'. 'keyWidths' is the size in bytes
+  // of each.
+  Operand* keys;
+  int8_t* keyWidths;
+
+  // The first matching build row for each probe row or nullptr.
+  JoinRow** hits;
+
+  // The number of result rows for each probe row.
+  int32_t* counts;
+
+  // The first result row for each probe row. Filled in on the host from
+  // 'counts' before gather().
+  int32_t* offsets;
+
+  // Probe side columns copied to the result and the result for each.
+  int32_t numProbeColumns;
+  Operand* probeColumns;
+  Operand* probeResults;
+  int8_t* probeWidths;
+
+  // Index in the JoinRow of each build side result column, and the result
+  // for each.
+  int32_t numBuildColumns;
+  int32_t* buildColumns;
+  Operand* buildResults;
+  int8_t* buildWidths;
+};
+
+/// Adds the rows of 'table' to its hash table. 'probe' has the row counts of
+/// 'numBlocks' blocks of kBlockSize rows.
+void build(
+    Stream& stream,
+    JoinTable* table,
+    HashProbe* probe,
+    int32_t numBlocks);
+
+/// Sets 'hits' and 'counts' of the 'numRows' rows of 'probe'.
+void probe(Stream& stream, JoinProbe* probe, int32_t numRows);
+
+/// Writes the result rows of the 'numRows' rows of 'probe' starting at
+/// 'offsets'.
+void gather(Stream& stream, JoinProbe* probe, int32_t numRows);
+
+} // namespace facebook::velox::wave::hashjoin
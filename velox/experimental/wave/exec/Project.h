@@ -32,6 +32,16 @@ class Project : public WaveOperator {
 
   AbstractWrap* findWrap() const override;
 
+  /// Makes 'this' also produce the projections that follow its filter in
+  /// the same FilterProject. 'levels' replaces the levels of 'this' and
+  /// covers the programs of both the filter and the projections.
+  void fuseProjection(
+      RowTypePtr outputType,
+      std::vector<std::vector<ProgramPtr>> levels) {
+    outputType_ = std::move(outputType);
+    levels_ = std::move(levels);
+  }
+
   bool isStreaming() const override {
     return true;
   }
@@ -17,6 +17,7 @@
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashJoin.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/Values.h"
@@ -25,6 +26,10 @@
 #include "velox/expression/FieldReference.h"
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
+DEFINE_bool(
+    velox_wave_fuse_filter_project,
+    true,
+    "Run the filter and projections of a FilterProject in one kernel");
 
 namespace facebook::velox::wave {
 
@@ -86,6 +91,11 @@ AbstractOperand* CompileState::addIdentityProjections(AbstractOperand* source) {
       it != operandOperatorIndex_.end(),
       "The operand being projected through must b defined first");
   latest = it->second;
+  if (afterWrap_.count(source)) {
+    // Computed after the wrap of its own operator, so already has the
+    // cardinality of its result.
+    ++latest;
+  }
   result = source;
   for (auto i = latest; i < operators_.size(); ++i) {
     if (auto wrap = operators_[i]->findWrap()) {
@@ -170,6 +180,8 @@ void CompileState::addInstruction(
   Program* program;
   if (common && !many) {
     program = common;
+  } else if (!common && fuseInto_) {
+    program = fuseInto_;
   } else {
     program = newProgram();
   }
@@ -318,7 +330,9 @@ int32_t findOutputChannel(
   VELOX_FAIL("Expr without output channel");
 }
 
-void CompileState::addFilter(const Expr& expr, const RowTypePtr& outputType) {
+Program* CompileState::addFilter(
+    const Expr& expr,
+    const RowTypePtr& outputType) {
   int32_t numPrograms = allPrograms_.size();
   auto condition = addExpr(expr);
   auto indices = newOperand(INTEGER(), "indices");
@@ -333,6 +347,7 @@ void CompileState::addFilter(const Expr& expr, const RowTypePtr& outputType) {
   auto levels = makeLevels(numPrograms);
   operators_.push_back(std::make_unique<Project>(
       *this, outputType, std::vector<AbstractOperand*>{}, levels, wrap));
+  return program;
 }
 
 void CompileState::addFilterProject(
@@ -344,13 +359,25 @@ void CompileState::addFilterProject(
   auto data = filterProject->exprsAndProjection();
   auto& identityProjections = filterProject->identityProjections();
   int32_t firstProjection = 0;
+  int32_t numPrograms = allPrograms_.size();
+  bool fused = false;
   if (data.hasFilter) {
-    addFilter(*data.exprs->exprs()[0], outputType);
+    auto filterProgram = addFilter(*data.exprs->exprs()[0], outputType);
     firstProjection = 1;
     ++nodeIndex;
     outputType = driverFactory_.planNodes[nodeIndex]->outputType();
+    // The projections that do not depend on another open program go after
+    // the filter and wrap in the filter's program. They then see the
+    // filtered rows in the same kernel and the filter Project produces the
+    // result, so there is no second launch and no materialized input for
+    // one.
+    if (FLAGS_velox_wave_fuse_filter_project) {
+      fuseInto_ = filterProgram;
+      fused = true;
+    } else {
+      numPrograms = allPrograms_.size();
+    }
   }
-  int32_t numPrograms = allPrograms_.size();
   auto operands =
       addExprSet(*data.exprs, firstProjection, data.exprs->exprs().size());
   std::vector<std::pair<Value, AbstractOperand*>> pairs;
@@ -362,14 +389,23 @@ void CompileState::addFilterProject(
     if (program) {
       program->markOutput(operands[i]->id);
       definedIn_[operands[i]] = program;
+      if (fused) {
+        afterWrap_.insert(operands[i]);
+      }
     }
     Value value(subfield);
     definedBy_[value] = operands[i];
     pairs.push_back(std::make_pair(value, operands[i]));
   }
+  fuseInto_ = nullptr;
   auto levels = makeLevels(numPrograms);
-  operators_.push_back(
-      std::make_unique<Project>(*this, outputType, operands, levels));
+  if (fused) {
+    reinterpret_cast<Project*>(operators_.back().get())
+        ->fuseProjection(outputType, std::move(levels));
+  } else {
+    operators_.push_back(
+        std::make_unique<Project>(*this, outputType, operands, levels));
+  }
   for (auto& [value, operand] : pairs) {
     operators_.back()->defined(value, operand);
   }
@@ -438,6 +474,18 @@ bool CompileState::addOperator(
     operators_.push_back(
         std::make_unique<TableScan>(*this, operators_.size(), *scan));
     outputType = scan->outputType();
+  } else if (name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    if (!node ||
+        !HashJoin::isSupported(*node, driver_.driverCtx()->queryConfig())) {
+      return false;
+    }
+    if (!reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashJoin>(*this, *node));
+    outputType = node->outputType();
   } else {
     return false;
   }
@@ -485,13 +533,21 @@ bool CompileState::compile() {
       break;
     }
     ++nodeIndex;
+    // A blocking operator starts a new pipeline and defines all its output
+    // columns, so nothing is projected through it.
+    const bool projectsThrough = operators_.size() == previousNumOperators ||
+        operators_.back()->isStreaming();
+    if (!projectsThrough) {
+      identityProjected.clear();
+    }
     for (auto newIndex = previousNumOperators; newIndex < operators_.size();
          ++newIndex) {
       for (auto i = 0; i < outputType->size(); ++i) {
         auto& name = outputType->nameOf(i);
         Value value = Value(toSubfield(name));
         int32_t inputChannel;
-        if (isProjectedThrough(identity, i, inputChannel)) {
+        if (projectsThrough &&
+            isProjectedThrough(identity, i, inputChannel)) {
           continue;
         }
         auto operand = operators_[newIndex]->defines(value);
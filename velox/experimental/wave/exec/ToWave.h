@@ -82,7 +82,9 @@ class CompileState {
   bool
   addOperator(exec::Operator* op, int32_t& nodeIndex, RowTypePtr& outputType);
 
-  void addFilter(const exec::Expr& expr, const RowTypePtr& outputType);
+  // Adds a Project that filters on 'expr' and returns the program with the
+  // filter.
+  Program* addFilter(const exec::Expr& expr, const RowTypePtr& outputType);
 
   void addFilterProject(
       exec::Operator* op,
@@ -142,6 +144,15 @@ class CompileState {
   // The program being generated.
   std::shared_ptr<Program> currentProgram_;
 
+  // Program that gets instructions that do not depend on an open
+  // program. Set while adding the projections of a FilterProject to the
+  // program of its filter.
+  Program* fuseInto_{nullptr};
+
+  // Results of fused projections. These are produced after the wrap of
+  // the operator that defines them and are not wrapped by it.
+  folly::F14FastSet<AbstractOperand*> afterWrap_;
+
   // Boolean to select the instruction. Set for conditionl sections.
   AbstractOperand* predicate_{nullptr};
 
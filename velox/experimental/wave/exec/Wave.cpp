@@ -168,6 +168,22 @@ Stream* WaveStream::newStream() {
   return result;
 }
 
+void WaveStream::addCompletionCallback(std::function<void()> callback) {
+  if (streams_.empty()) {
+    callback();
+    return;
+  }
+  auto pending = std::make_shared<std::atomic<int32_t>>(streams_.size());
+  auto shared = std::make_shared<std::function<void()>>(std::move(callback));
+  for (auto& stream : streams_) {
+    stream->addCallback([pending, shared]() {
+      if (--*pending == 0) {
+        (*shared)();
+      }
+    });
+  }
+}
+
 // static
 void WaveStream::clearReusable() {
   streamsForReuse_.clear();
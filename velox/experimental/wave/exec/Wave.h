@@ -466,6 +466,11 @@ class WaveStream {
     return arena_;
   }
 
+  /// Pinned host memory, e.g. for staging transfers to the device.
+  GpuArena& hostArena() {
+    return hostArena_;
+  }
+
   /// Sets nullability of a source column. This is runtime, since may depend on
   /// the actual presence of nulls in the source, e.g. file. Nullability
   /// defaults to nullable.
@@ -563,6 +568,10 @@ class WaveStream {
   /// 'this'.
   Stream* newStream();
 
+  /// Calls 'callback' on a Cuda thread once the device work enqueued so far
+  /// on all streams of 'this' is complete. 'callback' must not call Cuda.
+  void addCompletionCallback(std::function<void()> callback);
+
   static std::unique_ptr<Stream> streamFromReserve();
   static void releaseStream(std::unique_ptr<Stream>&& stream);
 
@@ -18,6 +18,12 @@
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    wave_max_streams_per_pipeline,
+    2,
+    "Number of WaveStreams in flight per pipeline. With 2, the transfer of "
+    "one batch overlaps the processing of the previous one");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -58,8 +64,12 @@ WaveDriver::WaveDriver(
 RowVectorPtr WaveDriver::getOutput() {
   VLOG(1) << "Getting output";
   for (;;) {
-    startMore();
+    bool started = startMore();
+    if (blockingFuture_.valid()) {
+      return nullptr;
+    }
     bool running = false;
+    bool arrived = false;
     for (int i = pipelines_.size() - 1; i >= 0; --i) {
       if (pipelines_[i].streams.empty()) {
         continue;
@@ -73,6 +83,7 @@ RowVectorPtr WaveDriver::getOutput() {
           ++it;
           continue;
         }
+        arrived = true;
         stream->setState(WaveStream::State::kNotRunning);
         RowVectorPtr result;
         if (i + 1 < pipelines_.size()) {
@@ -107,7 +118,35 @@ RowVectorPtr WaveDriver::getOutput() {
       finished_ = true;
       return nullptr;
     }
+    if (!started && !arrived) {
+      waitForArrival();
+      return nullptr;
+    }
+  }
+}
+
+void WaveDriver::waitForArrival() {
+  struct Waiter {
+    std::atomic<bool> done{false};
+    ContinuePromise promise;
+  };
+  auto [promise, future] =
+      makeVeloxContinuePromiseContract("WaveDriver::waitForArrival");
+  auto waiter = std::make_shared<Waiter>();
+  waiter->promise = std::move(promise);
+  for (auto& pipeline : pipelines_) {
+    if (pipeline.streams.empty()) {
+      continue;
+    }
+    pipeline.streams.front()->addCompletionCallback([waiter]() {
+      if (!waiter->done.exchange(true)) {
+        waiter->promise.setValue();
+      }
+    });
   }
+  // The device is the producer of the pending results.
+  blockingReason_ = exec::BlockingReason::kWaitForProducer;
+  blockingFuture_ = std::move(future);
 }
 
 bool WaveDriver::streamAtEnd(WaveStream& stream) {
@@ -150,13 +189,21 @@ RowVectorPtr WaveDriver::makeResult(
   return result;
 }
 
-void WaveDriver::startMore() {
-  for (int i = 0; i < pipelines_.size(); ++i) {
-    auto& ops = pipelines_[i].operators;
-    blockingReason_ = ops[0]->isBlocked(&blockingFuture_);
+bool WaveDriver::startMore() {
+  // A blocked pipeline, e.g. a join waiting for its build side, holds back
+  // the pipelines that feed it.
+  for (auto& pipeline : pipelines_) {
+    blockingReason_ = pipeline.operators[0]->isBlocked(&blockingFuture_);
     if (blockingReason_ != exec::BlockingReason::kNotBlocked) {
-      return;
+      return false;
     }
+  }
+  for (int i = 0; i < pipelines_.size(); ++i) {
+    if (pipelines_[i].streams.size() >=
+        FLAGS_wave_max_streams_per_pipeline) {
+      continue;
+    }
+    auto& ops = pipelines_[i].operators;
     auto stream =
         std::make_unique<WaveStream>(*arena_, *hostArena_, &operands());
     stream->setState(WaveStream::State::kHost);
@@ -178,9 +225,10 @@ void WaveDriver::startMore() {
       }
       stream->setState(WaveStream::State::kNotRunning);
       pipelines_[i].streams.push_back(std::move(stream));
-      break;
+      return true;
     }
   }
+  return false;
 }
 
 LaunchControl* WaveDriver::inputControl(
@@ -102,8 +102,13 @@ class WaveDriver : public exec::SourceOperator {
       const OperandSet& lastSet);
 
   // Starts another WaveStream if the source operator indicates it has more data
-  // and there is space in the arena.
-  void startMore();
+  // and the pipeline has fewer than --wave_max_streams_per_pipeline streams in
+  // flight. Returns true if a stream was started.
+  bool startMore();
+
+  // Sets 'blockingFuture_' to be realized when the oldest stream of any
+  // pipeline has completed on the device.
+  void waitForArrival();
 
   void updateStats();
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <cuda_runtime.h> // @manual
+#include <gflags/gflags.h>
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -21,6 +22,8 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/experimental/wave/exec/ToWave.h"
 
+DECLARE_bool(velox_wave_fuse_filter_project);
+
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
@@ -133,3 +136,21 @@ TEST_F(FilterProjectTest, filterProject) {
       std::vector<std::string>{"c0", "c1", "c1 + c0 as s", "c2", "c3"},
       vectors);
 }
+
+TEST_F(FilterProjectTest, filterProjectUnfused) {
+  gflags::FlagSaver saver;
+  FLAGS_velox_wave_fuse_filter_project = false;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    makeNotNull(vector, 1000000000);
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  assertFilterProject(
+      "c0 < 400000000",
+      std::vector<std::string>{"c0", "c1", "c1 + c0 as s", "c2", "c3"},
+      vectors);
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+DECLARE_int64(velox_wave_join_device_bytes);
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+  }
+
+  // Joins probe side c0, c1 with build side u0, u1 on c0 = u0. Build keys 4
+  // and 8 have two rows each. Both sides have a null key.
+  core::PlanNodePtr makePlan(
+      core::JoinType joinType,
+      const std::vector<std::string>& outputLayout,
+      int32_t numBatches = 1) {
+    auto probe = makeRowVector({
+        makeNullableFlatVector<int64_t>(
+            {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, std::nullopt}),
+        makeFlatVector<int32_t>(11, [](auto row) { return row * 10; }),
+    });
+    auto build = makeRowVector(
+        {"u0", "u1"},
+        {
+            makeNullableFlatVector<int64_t>(
+                {0, 2, 4, 4, 6, 8, 8, std::nullopt}),
+            makeFlatVector<double>({0.0, 0.2, 0.4, 0.41, 0.6, 0.8, 0.81, 1.0}),
+        });
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values({probe}, false, numBatches)
+        .hashJoin(
+            {"c0"},
+            {"u0"},
+            PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+            "",
+            outputLayout,
+            joinType)
+        .planNode();
+  }
+
+  RowVectorPtr expectedInner(int32_t numBatches) {
+    std::vector<int64_t> c0;
+    std::vector<int32_t> c1;
+    std::vector<double> u1;
+    for (auto i = 0; i < numBatches; ++i) {
+      c0.insert(c0.end(), {0, 2, 4, 4, 6, 8, 8});
+      c1.insert(c1.end(), {0, 20, 40, 40, 60, 80, 80});
+      u1.insert(u1.end(), {0.0, 0.2, 0.4, 0.41, 0.6, 0.8, 0.81});
+    }
+    return makeRowVector(
+        {makeFlatVector(c0), makeFlatVector(c1), makeFlatVector(u1)});
+  }
+};
+
+TEST_F(HashJoinTest, inner) {
+  auto plan = makePlan(core::JoinType::kInner, {"c0", "c1", "u1"});
+  AssertQueryBuilder(plan).assertResults(expectedInner(1));
+}
+
+TEST_F(HashJoinTest, left) {
+  auto plan = makePlan(core::JoinType::kLeft, {"c1", "u0", "u1"});
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(
+          {0, 10, 20, 30, 40, 40, 50, 60, 70, 80, 80, 90, 100}),
+      makeNullableFlatVector<int64_t>(
+          {0,
+           std::nullopt,
+           2,
+           std::nullopt,
+           4,
+           4,
+           std::nullopt,
+           6,
+           std::nullopt,
+           8,
+           8,
+           std::nullopt,
+           std::nullopt}),
+      makeNullableFlatVector<double>(
+          {0.0,
+           std::nullopt,
+           0.2,
+           std::nullopt,
+           0.4,
+           0.41,
+           std::nullopt,
+           0.6,
+           std::nullopt,
+           0.8,
+           0.81,
+           std::nullopt,
+           std::nullopt}),
+  });
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(HashJoinTest, leftSemi) {
+  auto plan = makePlan(core::JoinType::kLeftSemiFilter, {"c0", "c1"});
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({0, 2, 4, 6, 8}),
+      makeFlatVector<int32_t>({0, 20, 40, 60, 80}),
+  });
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(HashJoinTest, buildInHostMemory) {
+  gflags::FlagSaver saver;
+  FLAGS_velox_wave_join_device_bytes = 0;
+  auto plan = makePlan(core::JoinType::kInner, {"c0", "c1", "u1"}, 3);
+  AssertQueryBuilder(plan).assertResults(expectedInner(3));
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -26,6 +26,8 @@
 #include "velox/experimental/wave/exec/tests/utils/WaveTestSplitReader.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
+DECLARE_int32(wave_max_streams_per_pipeline);
+
 using namespace facebook::velox;
 using namespace facebook::velox::core;
 using namespace facebook::velox::exec;
@@ -173,6 +175,20 @@ TEST_F(TableScanTest, basic) {
   ASSERT_TRUE(it != planStats.end());
 }
 
+TEST_F(TableScanTest, streamsInFlight) {
+  auto type = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto vectors = makeVectors(type, 10, 2'000);
+  auto splits = makeTable("test", vectors);
+  createDuckDbTable(vectors);
+  auto plan = tableScanNode(type);
+  gflags::FlagSaver saver;
+  for (auto numStreams : {1, 4}) {
+    SCOPED_TRACE(fmt::format("numStreams={}", numStreams));
+    FLAGS_wave_max_streams_per_pipeline = numStreams;
+    assertQuery(plan, splits, "SELECT * FROM tmp");
+  }
+}
+
 TEST_F(TableScanTest, filter) {
   auto type =
       ROW({"c0", "c1", "c2", "c3"}, {BIGINT(), BIGINT(), BIGINT(), BIGINT()});
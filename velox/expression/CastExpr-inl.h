@@ -16,12 +16,14 @@
 #pragma once
 
 #include <charconv>
+#include <cstring>
 
 #include "velox/common/base/CountBits.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/expression/StringWriter.h"
 #include "velox/external/date/tz.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/type/Type.h"
 #include "velox/vector/SelectivityVector.h"
 
@@ -256,6 +258,165 @@ Status toDecimalValue(
   }
   return status;
 }
+
+/// Parses exactly 8 ASCII digits starting at 's' into 'out' using SWAR
+/// arithmetic. Returns false if any of the 8 bytes is not a digit.
+inline bool parseEightDigits(const char* s, uint64_t& out) {
+  uint64_t chunk;
+  std::memcpy(&chunk, s, sizeof(chunk));
+  // Each byte must be in ['0', '9']: the high nibble is 3 and adding 6 to
+  // the low nibble does not carry into the high nibble.
+  if ((chunk & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL ||
+      ((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) !=
+          0x3030303030303030ULL) {
+    return false;
+  }
+  chunk -= 0x3030303030303030ULL;
+  chunk = (chunk * 10) + (chunk >> 8);
+  constexpr uint64_t kMask = 0x000000FF000000FFULL;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  out = (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32;
+  return true;
+}
+
+/// Parses 'size' ASCII digits starting at 's' into 'out'. 'size' must be at
+/// most 19 so the result cannot overflow. Returns false if a non-digit is
+/// found.
+inline bool parseDigits(const char* s, size_t size, uint64_t& out) {
+  uint64_t value = 0;
+  for (; size >= 8; s += 8, size -= 8) {
+    uint64_t chunk;
+    if (!parseEightDigits(s, chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + chunk;
+  }
+  for (; size > 0; ++s, --size) {
+    const uint8_t digit = static_cast<uint8_t>(*s) - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  out = value;
+  return true;
+}
+
+/// Fast path for casting canonical decimal integers, i.e. strings matching
+/// -?[0-9]{1,18}, to BIGINT. Every cast policy produces the same value for
+/// such strings, so the caller can skip the generic converter. Returns false
+/// for anything else, including values the caller must range check.
+inline bool tryParseCanonicalInteger(const StringView& s, int64_t& out) {
+  const char* data = s.data();
+  size_t size = s.size();
+  const bool negative = size > 0 && data[0] == '-';
+  if (negative) {
+    ++data;
+    --size;
+  }
+  uint64_t value;
+  if (size == 0 || size > 18 || !parseDigits(data, size, value)) {
+    return false;
+  }
+  out = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+  return true;
+}
+
+/// Fast path for casting plain decimal numbers, i.e. strings matching
+/// -?[0-9]+(\.[0-9]+)? with at most 15 digits in total, to DOUBLE. The digits
+/// fit exactly in the mantissa and the power of ten is exact, so a single
+/// division yields the correctly rounded result that the full parser would
+/// produce. Returns false for anything else.
+inline bool tryParseCanonicalDouble(const StringView& s, double& out) {
+  static constexpr double kPowersOfTen[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+      1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  const char* data = s.data();
+  size_t size = s.size();
+  const bool negative = size > 0 && data[0] == '-';
+  if (negative) {
+    ++data;
+    --size;
+  }
+  if (size == 0 || size > 16) {
+    return false;
+  }
+  const auto* dot = static_cast<const char*>(std::memchr(data, '.', size));
+  const size_t wholeSize = dot ? dot - data : size;
+  const size_t fractionSize = dot ? size - wholeSize - 1 : 0;
+  if (wholeSize == 0 || (dot && fractionSize == 0) ||
+      wholeSize + fractionSize > 15) {
+    return false;
+  }
+  uint64_t whole;
+  uint64_t fraction = 0;
+  if (!parseDigits(data, wholeSize, whole) ||
+      (dot && !parseDigits(dot + 1, fractionSize, fraction))) {
+    return false;
+  }
+  const auto mantissa = static_cast<double>(
+      whole * static_cast<uint64_t>(kPowersOfTen[fractionSize]) + fraction);
+  const double value = mantissa / kPowersOfTen[fractionSize];
+  out = negative ? -value : value;
+  return true;
+}
+
+/// Fast path for casting ISO dates of the exact form YYYY-MM-DD with a
+/// non-zero year to DATE. Returns false for anything else, including
+/// invalid calendar dates, which are left to the cast hooks to report.
+inline bool tryParseCanonicalDate(const StringView& s, int32_t& out) {
+  const char* data = s.data();
+  if (s.size() != 10 || data[4] != '-' || data[7] != '-') {
+    return false;
+  }
+  uint64_t year;
+  uint64_t month;
+  uint64_t day;
+  if (!parseDigits(data, 4, year) || !parseDigits(data + 5, 2, month) ||
+      !parseDigits(data + 8, 2, day) || year == 0) {
+    return false;
+  }
+  int64_t days;
+  if (!util::daysSinceEpochFromDate(year, month, day, days).ok()) {
+    return false;
+  }
+  out = days;
+  return true;
+}
+
+/// Returns true if 'ToKind' has a fast path for canonical strings in
+/// tryCastCanonicalString.
+template <TypeKind ToKind>
+constexpr bool hasCanonicalStringCast() {
+  return ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+      ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT ||
+      ToKind == TypeKind::DOUBLE;
+}
+
+/// Casts 's' to 'ToKind' if it is in the canonical form accepted by the fast
+/// paths above and the value fits the target type. Returns false otherwise,
+/// in which case the generic cast must be applied.
+template <TypeKind ToKind>
+bool tryCastCanonicalString(
+    const StringView& s,
+    typename TypeTraits<ToKind>::NativeType& out) {
+  using T = typename TypeTraits<ToKind>::NativeType;
+  if constexpr (ToKind == TypeKind::DOUBLE) {
+    return tryParseCanonicalDouble(s, out);
+  } else if constexpr (hasCanonicalStringCast<ToKind>()) {
+    int64_t value;
+    if (!tryParseCanonicalInteger(s, value) ||
+        value < std::numeric_limits<T>::min() ||
+        value > std::numeric_limits<T>::max()) {
+      return false;
+    }
+    out = static_cast<T>(value);
+    return true;
+  } else {
+    return false;
+  }
+}
 } // namespace detail
 
 template <typename Func>
@@ -715,23 +876,54 @@ void CastExpr::applyCastPrimitives(
   auto* resultFlatVector = result->as<FlatVector<To>>();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
+  // Flat VARCHAR inputs holding canonical numbers, e.g. '123' or '-1.5', are
+  // parsed directly. Any other row, including every row that would fail, goes
+  // through the per-policy kernel so results and errors are unchanged.
+  const StringView* rawStrings = nullptr;
+  if constexpr (
+      FromKind == TypeKind::VARCHAR &&
+      detail::hasCanonicalStringCast<ToKind>()) {
+    if (input.isFlatEncoding()) {
+      rawStrings = input.asUnchecked<FlatVector<StringView>>()->rawValues();
+    }
+  }
+  auto tryCastCanonical = [&](vector_size_t row) INLINE_LAMBDA {
+    if constexpr (
+        FromKind == TypeKind::VARCHAR &&
+        detail::hasCanonicalStringCast<ToKind>()) {
+      To value;
+      if (rawStrings != nullptr &&
+          detail::tryCastCanonicalString<ToKind>(rawStrings[row], value)) {
+        resultFlatVector->set(row, value);
+        return true;
+      }
+    }
+    return false;
+  };
+
   switch (hooks_->getPolicy()) {
     case LegacyCastPolicy:
       applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
-        applyCastKernel<ToKind, FromKind, util::LegacyCastPolicy>(
-            row, context, inputSimpleVector, resultFlatVector);
+        if (!tryCastCanonical(row)) {
+          applyCastKernel<ToKind, FromKind, util::LegacyCastPolicy>(
+              row, context, inputSimpleVector, resultFlatVector);
+        }
       });
       break;
     case PrestoCastPolicy:
       applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
-        applyCastKernel<ToKind, FromKind, util::PrestoCastPolicy>(
-            row, context, inputSimpleVector, resultFlatVector);
+        if (!tryCastCanonical(row)) {
+          applyCastKernel<ToKind, FromKind, util::PrestoCastPolicy>(
+              row, context, inputSimpleVector, resultFlatVector);
+        }
       });
       break;
     case SparkCastPolicy:
       applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
-        applyCastKernel<ToKind, FromKind, util::SparkCastPolicy>(
-            row, context, inputSimpleVector, resultFlatVector);
+        if (!tryCastCanonical(row)) {
+          applyCastKernel<ToKind, FromKind, util::SparkCastPolicy>(
+              row, context, inputSimpleVector, resultFlatVector);
+        }
       });
       break;
 
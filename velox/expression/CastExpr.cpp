@@ -224,7 +224,18 @@ VectorPtr CastExpr::castToDate(
   switch (fromType->kind()) {
     case TypeKind::VARCHAR: {
       auto* inputVector = input.as<SimpleVector<StringView>>();
+      // Canonical YYYY-MM-DD strings in flat inputs are converted directly.
+      // Everything else, including invalid dates, goes through the hooks.
+      const StringView* rawStrings = input.isFlatEncoding()
+          ? input.asUnchecked<FlatVector<StringView>>()->rawValues()
+          : nullptr;
       applyToSelectedNoThrowLocal(context, rows, castResult, [&](int row) {
+        int32_t days;
+        if (rawStrings != nullptr &&
+            detail::tryParseCanonicalDate(rawStrings[row], days)) {
+          resultFlatVector->set(row, days);
+          return;
+        }
         bool wrapException = true;
         try {
           const auto result =
@@ -123,6 +123,7 @@ void ConjunctExpr::evalSpecialForm(
   auto activeRows = activeRowsHolder.get();
   VELOX_DCHECK(activeRows != nullptr);
   int32_t numActive = activeRows->countSelected();
+  const auto numRows = numActive;
   for (int32_t i = 0; i < inputs_.size(); ++i) {
     VectorPtr inputResult;
     VectorRecycler inputResultRecycler(inputResult, context.vectorPool());
@@ -131,7 +132,7 @@ void ConjunctExpr::evalSpecialForm(
       context.swapErrors(errors);
     }
 
-    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
+    SelectivityTimer timer(pendingSelectivity_[inputOrder_[i]], numActive);
     if (evaluatesArgumentsOnNonIncreasingSelection()) {
       // Exclude loading rows that we know for sure will have a false result.
       for (auto* field : inputs_[inputOrder_[i]]->distinctFields()) {
@@ -158,7 +159,7 @@ void ConjunctExpr::evalSpecialForm(
       activeRows->updateBounds();
     }
     numActive = activeRows->countSelected();
-    selectivity_[inputOrder_[i]].addOutput(numActive);
+    pendingSelectivity_[inputOrder_[i]].addOutput(numActive);
 
     if (!numActive) {
       break;
@@ -174,28 +175,24 @@ void ConjunctExpr::evalSpecialForm(
     reorderEnabledChecked_ = true;
   }
   if (reorderEnabled_) {
-    maybeReorderInputs();
+    maybeReorderInputs(context, numRows);
+  } else {
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      selectivity_[i].add(pendingSelectivity_[i]);
+      pendingSelectivity_[i] = SelectivityInfo();
+    }
   }
 }
 
-void ConjunctExpr::maybeReorderInputs() {
-  bool reorder = false;
-  for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
-      reorder = true;
-      break;
-    }
-  }
-  if (reorder) {
-    std::sort(
-        inputOrder_.begin(),
-        inputOrder_.end(),
-        [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
-        });
+void ConjunctExpr::maybeReorderInputs(EvalCtx& context, uint64_t numRows) {
+  // Conjuncts are identified by their text, which is the same for all drivers
+  // of a pipeline.
+  if (sharedSelectivity_ == nullptr) {
+    sharedSelectivity_ = context.execCtx()->queryCtx()->sharedSelectivity(
+        toString(), inputs_.size());
   }
+  sharedSelectivity_->update(
+      pendingSelectivity_, numRows, selectivity_, inputOrder_);
 }
 
 namespace {
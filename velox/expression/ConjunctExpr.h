@@ -36,6 +36,7 @@ class ConjunctExpr : public SpecialForm {
             false /* trackCpuUsage */),
         isAnd_(isAnd) {
     selectivity_.resize(inputs_.size());
+    pendingSelectivity_.resize(inputs_.size());
     inputOrder_.resize(inputs_.size());
     std::iota(inputOrder_.begin(), inputOrder_.end(), 0);
 
@@ -74,7 +75,10 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
-  void maybeReorderInputs();
+  // Merges the selectivity measured by the last evaluation of 'numRows' rows
+  // with the selectivity measured by the other drivers evaluating 'this' and
+  // reorders the inputs by increasing time to drop a row.
+  void maybeReorderInputs(EvalCtx& context, uint64_t numRows);
 
   void updateResult(
       BaseVector* inputResult,
@@ -96,7 +100,15 @@ class ConjunctExpr : public SpecialForm {
   BufferPtr tempNulls_;
   bool reorderEnabledChecked_ = false;
   bool reorderEnabled_;
+  // Selectivity of the inputs by which they are ordered. If reordering is
+  // enabled, these decay over time and include the measurements of other
+  // drivers.
   std::vector<SelectivityInfo> selectivity_;
+  // Selectivity measured by the current evaluation.
+  std::vector<SelectivityInfo> pendingSelectivity_;
+  // Selectivity shared by all conjuncts of the query with the same inputs.
+  // Set on first reorder.
+  std::shared_ptr<SharedSelectivity> sharedSelectivity_;
   std::vector<int32_t> inputOrder_;
 
   friend class ConjunctCallToSpecialForm;
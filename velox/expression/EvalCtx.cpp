@@ -27,6 +27,7 @@ namespace facebook::velox::exec {
 
 EvalCtx::EvalCtx(core::ExecCtx* execCtx, ExprSet* exprSet, const RowVector* row)
     : execCtx_(execCtx),
+      evalScope_(execCtx),
       exprSet_(exprSet),
       row_(row),
       cacheEnabled_(execCtx->exprEvalCacheEnabled()),
@@ -54,6 +55,7 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx, ExprSet* exprSet, const RowVector* row)
 
 EvalCtx::EvalCtx(core::ExecCtx* execCtx)
     : execCtx_(execCtx),
+      evalScope_(execCtx),
       exprSet_(nullptr),
       row_(nullptr),
       cacheEnabled_(execCtx->exprEvalCacheEnabled()),
@@ -425,6 +425,14 @@ class EvalCtx {
     return execCtx_;
   }
 
+  /// Returns uninitialized space for 'size' elements of T. The space is
+  /// valid until the end of the batch, i.e. until the outermost EvalCtx on
+  /// this thread is destroyed.
+  template <typename T>
+  T* allocateScratch(int64_t size) {
+    return execCtx_->scratchArena().allocate<T>(size);
+  }
+
   ExprSet* exprSet() const {
     return exprSet_;
   }
@@ -534,7 +542,27 @@ class EvalCtx {
       EvalErrorsPtr& to,
       vector_size_t toIndex) const;
 
+  // Counts the EvalCtxs alive on an ExecCtx. A copy counts as another one.
+  class EvalScope {
+   public:
+    explicit EvalScope(core::ExecCtx* execCtx) : execCtx_(execCtx) {
+      execCtx_->beginEval();
+    }
+
+    EvalScope(const EvalScope& other) : EvalScope(other.execCtx_) {}
+
+    ~EvalScope() {
+      execCtx_->endEval();
+    }
+
+    void operator=(const EvalScope& other) = delete;
+
+   private:
+    core::ExecCtx* const execCtx_;
+  };
+
   core::ExecCtx* const execCtx_;
+  const EvalScope evalScope_;
   ExprSet* const exprSet_;
   const RowVector* row_;
   const bool cacheEnabled_;
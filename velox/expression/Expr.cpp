@@ -16,6 +16,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/container/F14Set.h>
 #include <fstream>
 
 #include "velox/common/base/Exceptions.h"
@@ -29,6 +30,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprCompiler.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/LambdaExpr.h"
 #include "velox/expression/PeeledEncoding.h"
 #include "velox/expression/ScopedVarSetter.h"
 #include "velox/expression/VectorFunction.h"
@@ -1432,7 +1434,11 @@ void Expr::evalAllImpl(
     }
   }
 
-  if (!tryPeelArgs ||
+  if (cacheDistinctInputs_ &&
+      applyFunctionToDistinctInputs(remainingRows.rows(), context, result)) {
+    // The function was applied once per distinct input.
+  } else if (
+      !tryPeelArgs ||
       !applyFunctionWithPeeling(remainingRows.rows(), context, result)) {
     applyFunction(remainingRows.rows(), context, result);
   }
@@ -1492,6 +1498,113 @@ bool Expr::applyFunctionWithPeeling(
   return true;
 }
 
+namespace {
+// Number of consecutive batches with too many distinct values after which
+// an expression stops looking for distinct inputs.
+constexpr int32_t kMaxDistinctInputCacheMisses = 3;
+
+// Batches with fewer rows are evaluated row by row.
+constexpr vector_size_t kMinDistinctInputCacheRows = 64;
+
+bool isStringKind(TypeKind kind) {
+  return kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+}
+} // namespace
+
+void Expr::enableDistinctInputCache() {
+  if (isSpecialForm() || vectorFunction_ == nullptr || !deterministic_) {
+    return;
+  }
+  for (const auto& input : inputs_) {
+    if (isStringKind(input->type()->kind())) {
+      cacheDistinctInputs_ = true;
+      return;
+    }
+  }
+}
+
+bool Expr::applyFunctionToDistinctInputs(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  const auto numRows = rows.countSelected();
+  if (numRows < kMinDistinctInputCacheRows) {
+    return false;
+  }
+
+  std::optional<column_index_t> stringInput;
+  for (auto i = 0; i < inputValues_.size(); ++i) {
+    const auto& input = inputValues_[i];
+    if (input->isConstantEncoding()) {
+      continue;
+    }
+    if (stringInput.has_value() || !input->isFlatEncoding() ||
+        !isStringKind(input->typeKind())) {
+      return false;
+    }
+    stringInput = i;
+  }
+  if (!stringInput.has_value()) {
+    return false;
+  }
+
+  // Maps each row to the first row with the same value. Nulls are one value.
+  const auto* strings =
+      inputValues_[stringInput.value()]->asUnchecked<FlatVector<StringView>>();
+  const size_t maxDistinct = numRows / 4;
+  auto indices = allocateIndices(rows.end(), context.pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  LocalSelectivityVector distinctRowsHolder(context, rows.end());
+  auto* distinctRows = distinctRowsHolder.get();
+  distinctRows->clearAll();
+  folly::F14FastMap<StringView, vector_size_t> firstRows;
+  std::optional<vector_size_t> firstNullRow;
+  const bool fewDistinct = rows.testSelected([&](auto row) {
+    vector_size_t firstRow;
+    if (strings->isNullAt(row)) {
+      if (!firstNullRow.has_value()) {
+        firstNullRow = row;
+      }
+      firstRow = firstNullRow.value();
+    } else {
+      firstRow =
+          firstRows.emplace(strings->valueAtFast(row), row).first->second;
+    }
+    rawIndices[row] = firstRow;
+    if (firstRow != row) {
+      return true;
+    }
+    distinctRows->setValid(row, true);
+    return firstRows.size() <= maxDistinct;
+  });
+
+  if (!fewDistinct) {
+    if (++numDistinctInputCacheMisses_ >= kMaxDistinctInputCacheMisses) {
+      cacheDistinctInputs_ = false;
+    }
+    return false;
+  }
+  numDistinctInputCacheMisses_ = 0;
+  distinctRows->updateBounds();
+
+  VectorPtr distinctResult;
+  applyFunction(*distinctRows, context, distinctResult);
+
+  // Rows with the same value as a failed row fail with the same error.
+  if (auto* errors = context.errors()) {
+    rows.applyToSelected([&](auto row) {
+      if (rawIndices[row] != row) {
+        errors->copyError(*errors, rawIndices[row], row);
+      }
+    });
+  }
+
+  auto wrappedResult = BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), rows.end(), std::move(distinctResult));
+  context.moveOrCopyResult(wrappedResult, rows, result);
+  return true;
+}
+
 void Expr::applyFunction(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1713,6 +1826,57 @@ common::Subfield extractSubfield(
   }
 }
 
+// True for functions of an array and a lambda over its elements whose result
+// depends on the elements only through the lambda, e.g. transform(a, x ->
+// x.price). The parts of the elements the lambda does not read are not needed.
+// Not true for e.g. filter(), which returns the elements themselves.
+bool readsElementsOnlyInLambda(const std::string& name) {
+  static const folly::F14FastSet<std::string> kNames = {
+      "transform", "any_match", "all_match", "none_match"};
+  const auto pos = name.rfind('.');
+  return kNames.count(
+             pos == std::string::npos ? name : name.substr(pos + 1)) > 0;
+}
+
+// Adds to 'subfields' the paths of 'array' read by 'lambda', e.g. a[*].price
+// for transform(a, x -> x.price). Returns false if 'array' is not a subfield
+// or 'lambda' does not take one element at a time.
+bool extractElementSubfields(
+    const Expr* array,
+    const LambdaExpr* lambda,
+    folly::F14FastMap<std::string, int32_t>* shadowedNames,
+    std::vector<common::Subfield>* subfields) {
+  const auto& functionType = lambda->type();
+  if (functionType->size() != 2 ||
+      !functionType->childAt(0)->equivalent(*array->type()->childAt(0))) {
+    return false;
+  }
+  auto arraySubfield = extractSubfield(array, *shadowedNames);
+  if (!arraySubfield.valid()) {
+    return false;
+  }
+  std::vector<common::Subfield> elementSubfields;
+  if (!lambda->extractParameterSubfields(
+          shadowedNames, subfields, &elementSubfields)) {
+    return false;
+  }
+  if (elementSubfields.empty()) {
+    // Only the sizes are used.
+    subfields->push_back(std::move(arraySubfield));
+    return true;
+  }
+  for (auto& elementSubfield : elementSubfields) {
+    auto subfield = arraySubfield.clone();
+    auto& path = subfield.path();
+    path.push_back(std::make_unique<common::Subfield::AllSubscripts>());
+    for (auto i = 1; i < elementSubfield.path().size(); ++i) {
+      path.push_back(std::move(elementSubfield.path()[i]));
+    }
+    subfields->push_back(std::move(subfield));
+  }
+  return true;
+}
+
 } // namespace
 
 void Expr::extractSubfieldsImpl(
@@ -1723,6 +1887,15 @@ void Expr::extractSubfieldsImpl(
     subfields->push_back(std::move(subfield));
     return;
   }
+  if (inputs_.size() == 2 && inputs_[0]->type()->isArray() &&
+      vectorFunction() && readsElementsOnlyInLambda(name())) {
+    if (auto* lambda = dynamic_cast<const LambdaExpr*>(inputs_[1].get());
+        lambda &&
+        extractElementSubfields(
+            inputs_[0].get(), lambda, shadowedNames, subfields)) {
+      return;
+    }
+  }
   for (auto& input : inputs_) {
     input->extractSubfieldsImpl(shadowedNames, subfields);
   }
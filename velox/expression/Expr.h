@@ -250,6 +250,11 @@ class Expr {
     sharedSubexprResults_.clear();
   }
 
+  /// Enables evaluating the function of 'this' once per distinct value of a
+  /// flat string input. No-op for special forms, non-deterministic functions
+  /// and functions without string inputs.
+  void enableDistinctInputCache();
+
   void clearMemo() {
     baseOfDictionaryRepeats_ = 0;
     baseOfDictionary_.reset();
@@ -452,6 +457,16 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Applies the function of 'this' to the first row of each distinct value of
+  // the only non-constant input if this is a flat string vector with few
+  // distinct values in 'rows'. Wraps the result in a dictionary that maps each
+  // row to the first row with the same value. Returns false if the inputs are
+  // not eligible or have too many distinct values.
+  bool applyFunctionToDistinctInputs(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   // Calls the function of 'this' on arguments in
   // 'inputValues_'. Handles cases of VectorFunction and SimpleFunction.
   void applyFunction(
@@ -602,6 +617,12 @@ class Expr {
 
   bool isMultiplyReferenced_ = false;
 
+  // True if applyFunctionToDistinctInputs() should be tried. Reset after
+  // kMaxDistinctInputCacheMisses consecutive batches with too many distinct
+  // values.
+  bool cacheDistinctInputs_ = false;
+  int32_t numDistinctInputCacheMisses_ = 0;
+
   std::vector<VectorPtr> inputValues_;
 
   struct SharedResults {
@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -162,6 +163,43 @@ ExprPtr getAlreadyCompiled(const ITypedExpr* expr, ExprDedupMap* visited) {
   return iter == visited->end() ? nullptr : iter->second;
 }
 
+// Returns 'expr' with swapped arguments if 'expr' is a call to a commutative
+// function with 2 arguments of the same type. Returns nullptr otherwise.
+TypedExprPtr swapCommutativeArguments(const TypedExprPtr& expr) {
+  static const std::unordered_set<std::string> kCommutative = {
+      "plus", "multiply", "eq", "neq"};
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (!call || call->inputs().size() != 2) {
+    return nullptr;
+  }
+  const auto& name = call->name();
+  const auto dot = name.rfind('.');
+  if (!kCommutative.count(
+          dot == std::string::npos ? name : name.substr(dot + 1))) {
+    return nullptr;
+  }
+  const auto& inputs = call->inputs();
+  if (*inputs[0]->type() != *inputs[1]->type() || *inputs[0] == *inputs[1]) {
+    return nullptr;
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      call->type(), std::vector<TypedExprPtr>{inputs[1], inputs[0]}, name);
+}
+
+// Returns the Expr compiled for 'expr' or for a semantically equal
+// expression, e.g. 'b + a' for 'a + b'. Returns nullptr if there is none.
+ExprPtr getAlreadyCompiledEquivalent(
+    const TypedExprPtr& expr,
+    ExprDedupMap* visited) {
+  if (auto compiled = getAlreadyCompiled(expr.get(), visited)) {
+    return compiled;
+  }
+  if (auto swapped = swapCommutativeArguments(expr)) {
+    return getAlreadyCompiled(swapped.get(), visited);
+  }
+  return nullptr;
+}
+
 ExprPtr compileExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -254,6 +292,74 @@ void captureFieldReference(
   }
 }
 
+// Returns the root Scope of 'scope'.
+Scope* rootScope(Scope* scope) {
+  while (scope->parent) {
+    scope = scope->parent;
+  }
+  return scope;
+}
+
+// Replaces the maximal subtrees of 'expr' that do not reference 'parameters'
+// with the references returned by 'hoist'. 'hoist' returns nullptr for
+// subtrees that should stay in place. Does not look into nested lambdas. Sets
+// 'isInvariant' if 'expr' itself does not reference 'parameters', in which
+// case the caller decides whether to hoist 'expr' as a whole.
+TypedExprPtr hoistInvariants(
+    const TypedExprPtr& expr,
+    const std::vector<std::string>& parameters,
+    const std::function<TypedExprPtr(const TypedExprPtr&)>& hoist,
+    bool& isInvariant) {
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::InputTypedExpr*>(expr.get())) {
+    isInvariant = false;
+    return expr;
+  }
+  if (auto access =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    if (access->isInputColumn()) {
+      isInvariant =
+          std::find(parameters.begin(), parameters.end(), access->name()) ==
+          parameters.end();
+      return expr;
+    }
+  }
+
+  const auto& inputs = expr->inputs();
+  std::vector<bool> invariantInputs(inputs.size());
+  std::vector<TypedExprPtr> newInputs;
+  newInputs.reserve(inputs.size());
+  bool changed = false;
+  isInvariant = true;
+  for (auto i = 0; i < inputs.size(); ++i) {
+    bool invariantInput;
+    newInputs.push_back(
+        hoistInvariants(inputs[i], parameters, hoist, invariantInput));
+    changed |= newInputs.back() != inputs[i];
+    invariantInputs[i] = invariantInput;
+    isInvariant &= invariantInput;
+  }
+  if (isInvariant) {
+    return expr;
+  }
+
+  for (auto i = 0; i < inputs.size(); ++i) {
+    if (invariantInputs[i]) {
+      if (auto reference = hoist(inputs[i])) {
+        newInputs[i] = std::move(reference);
+        changed = true;
+      }
+    }
+  }
+  if (!changed) {
+    return expr;
+  }
+  // Inputs of unsupported kinds of expressions are not hoisted. Subtrees
+  // hoisted below such an expression are then evaluated without being used.
+  auto copy = core::TypedExprs::withInputs(expr, std::move(newInputs));
+  return copy ? copy : expr;
+}
+
 std::shared_ptr<Expr> compileLambda(
     const core::LambdaTypedExpr* lambda,
     Scope* scope,
@@ -263,7 +369,8 @@ std::shared_ptr<Expr> compileLambda(
     bool enableConstantFolding) {
   auto signature = lambda->signature();
   auto parameterNames = signature->names();
-  Scope lambdaScope(std::move(parameterNames), scope, scope->exprSet);
+  Scope lambdaScope(
+      std::vector<std::string>(parameterNames), scope, scope->exprSet);
   auto body = compileExpression(
       lambda->body(),
       &lambdaScope,
@@ -289,6 +396,60 @@ std::shared_ptr<Expr> compileLambda(
         std::static_pointer_cast<FieldReference>(reference));
   }
 
+  // Subtrees that only depend on the captures are compiled in a separate top
+  // level Scope and evaluated over the captures.
+  std::vector<std::string> invariantNames;
+  std::vector<ExprPtr> invariants;
+  ExprPtr hoistedBody;
+  if (config.exprHoistLambdaInvariants() && !captureReferences.empty()) {
+    Scope invariantScope({}, nullptr, scope->exprSet);
+    auto hoist = [&](const TypedExprPtr& expr) -> TypedExprPtr {
+      if (!dynamic_cast<const core::CallTypedExpr*>(expr.get()) &&
+          !dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+        return nullptr;
+      }
+      auto invariant = compileExpression(
+          expr,
+          &invariantScope,
+          config,
+          pool,
+          flatteningCandidates,
+          enableConstantFolding);
+      if (!invariant->isDeterministic() || invariant->isConstant()) {
+        return nullptr;
+      }
+      invariantNames.push_back(fmt::format("__invariant{}", invariants.size()));
+      invariants.push_back(std::move(invariant));
+      return std::make_shared<core::FieldAccessTypedExpr>(
+          expr->type(), invariantNames.back());
+    };
+
+    bool isInvariant;
+    auto rewrittenBody =
+        hoistInvariants(lambda->body(), parameterNames, hoist, isInvariant);
+    if (isInvariant) {
+      if (auto reference = hoist(lambda->body())) {
+        rewrittenBody = std::move(reference);
+      }
+    }
+
+    if (!invariants.empty()) {
+      // The hoisted body may be referenced from the parent Scopes' dedup maps
+      // through captures of nested lambdas.
+      rootScope(scope)->rewrittenExpressions.push_back(rewrittenBody);
+      auto locals = parameterNames;
+      locals.insert(locals.end(), invariantNames.begin(), invariantNames.end());
+      Scope hoistedScope(std::move(locals), scope, scope->exprSet);
+      hoistedBody = compileExpression(
+          rewrittenBody,
+          &hoistedScope,
+          config,
+          pool,
+          flatteningCandidates,
+          enableConstantFolding);
+    }
+  }
+
   auto functionType = std::make_shared<FunctionType>(
       std::vector<TypePtr>(signature->children()), body->type());
   return std::make_shared<LambdaExpr>(
@@ -296,7 +457,10 @@ std::shared_ptr<Expr> compileLambda(
       std::move(signature),
       std::move(captureReferences),
       std::move(body),
-      config.exprTrackCpuUsage());
+      config.exprTrackCpuUsage(),
+      std::move(invariantNames),
+      std::move(invariants),
+      std::move(hoistedBody));
 }
 
 ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
@@ -363,7 +527,8 @@ ExprPtr compileRewrittenExpression(
     memory::MemoryPool* pool,
     const std::unordered_set<std::string>& flatteningCandidates,
     bool enableConstantFolding) {
-  ExprPtr alreadyCompiled = getAlreadyCompiled(expr.get(), &scope->visited);
+  ExprPtr alreadyCompiled =
+      getAlreadyCompiledEquivalent(expr, &scope->visited);
   if (alreadyCompiled) {
     if (!alreadyCompiled->isMultiplyReferenced()) {
       scope->exprSet->addToReset(alreadyCompiled);
@@ -508,7 +673,14 @@ ExprPtr compileRewrittenExpression(
     VELOX_UNSUPPORTED("Unknown typed expression");
   }
 
+  if (config.exprFuseKernels() && result->vectorFunction() != nullptr) {
+    result = FusedExpr::tryFuse(result);
+  }
+
   result->computeMetadata();
+  if (config.exprCacheDistinctInputs()) {
+    result->enableDistinctInputCache();
+  }
 
   // If the expression is constant folding it is redundant.
   auto folded = enableConstantFolding && !isConstantExpr
@@ -585,11 +757,22 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  // Keeps the re-written expressions alive while compiling since the map used
+  // to deduplicate compiled expressions is keyed on raw pointers.
+  auto rewrittenSources = sources;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto rewritten = rewrite(rewrittenSources);
+    if (!rewritten.empty()) {
+      VELOX_CHECK_EQ(rewritten.size(), rewrittenSources.size());
+      rewrittenSources = std::move(rewritten);
+    }
+  }
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(rewrittenSources);
 
-  for (auto& source : sources) {
+  for (auto& source : rewrittenSources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/EvictingCacheMap.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/type/Type.h"
+
+namespace facebook::velox::exec {
+
+/// A process-wide LRU cache of the results of resolving a function name and
+/// argument types to a function implementation. Resolution binds the argument
+/// types to each signature registered for the name, which is a noticeable part
+/// of compiling the expressions of short queries, and each driver of a query
+/// compiles its own copy of the same expressions. The owning registry looks up
+/// and fills the cache under its read lock and clears it under its write lock,
+/// so that no entry outlives a change of the registered functions.
+template <typename T>
+class FunctionResolutionCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 10'000;
+
+  explicit FunctionResolutionCache(size_t maxEntries = kDefaultMaxEntries)
+      : cache_(maxEntries) {}
+
+  /// Returns the value for 'name' and 'argTypes' or std::nullopt if there is
+  /// none.
+  std::optional<T> get(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes) const {
+    auto cache = cache_.wlock();
+    auto it = cache->find(Key{name, argTypes});
+    if (it == cache->end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  void put(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes,
+      T value) {
+    cache_.wlock()->set(Key{name, argTypes}, std::move(value));
+  }
+
+  void clear() {
+    cache_.wlock()->clear();
+  }
+
+  size_t size() const {
+    return cache_.rlock()->size();
+  }
+
+ private:
+  struct Key {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+
+    bool operator==(const Key& other) const {
+      if (name != other.name || argTypes.size() != other.argTypes.size()) {
+        return false;
+      }
+      for (auto i = 0; i < argTypes.size(); ++i) {
+        // Row field names matter since they may appear in the result type.
+        if (*argTypes[i] != *other.argTypes[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      auto hash = std::hash<std::string>{}(key.name);
+      for (const auto& type : key.argTypes) {
+        hash = folly::hash::hash_combine(hash, type->hashKind());
+      }
+      return hash;
+    }
+  };
+
+  mutable folly::Synchronized<folly::EvictingCacheMap<Key, T, KeyHasher>>
+      cache_;
+};
+
+} // namespace facebook::velox::exec
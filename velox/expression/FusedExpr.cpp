@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedExpr.h"
+
+#include <algorithm>
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+using Op = FusedKernel::Op;
+
+// Number of rows computed at a time. Keeps the intermediate results of a
+// batch in the L1 cache.
+constexpr vector_size_t kBatchSize = 256;
+
+// Max number of kernels kept in the process-wide cache.
+constexpr size_t kMaxCachedKernels = 10'000;
+
+using KernelCache = folly::Synchronized<
+    folly::F14FastMap<std::string, std::shared_ptr<const FusedKernel>>>;
+
+KernelCache& kernelCache() {
+  static KernelCache cache;
+  return cache;
+}
+
+// Returns the operation for a call to function 'name', ignoring the prefix
+// of the function name, if any.
+std::optional<Op> toOp(const std::string& name) {
+  static const folly::F14FastMap<std::string, Op> kOps = {
+      {"plus", Op::kPlus},
+      {"minus", Op::kMinus},
+      {"multiply", Op::kMultiply},
+      {"eq", Op::kEq},
+      {"neq", Op::kNeq},
+      {"lt", Op::kLt},
+      {"lte", Op::kLte},
+      {"gt", Op::kGt},
+      {"gte", Op::kGte},
+  };
+  const auto pos = name.rfind('.');
+  auto it =
+      kOps.find(pos == std::string::npos ? name : name.substr(pos + 1));
+  if (it == kOps.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+bool isFusableType(const TypePtr& type) {
+  static const std::vector<TypePtr> kTypes = {
+      TINYINT(), SMALLINT(), INTEGER(), BIGINT(), REAL(), DOUBLE()};
+  for (const auto& fusableType : kTypes) {
+    if (*type == *fusableType) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Collects the instructions, inputs and signature of a tree of fusable
+// calls. While building, operands of instructions refer to inputs with
+// non-negative values and to instruction 'i' with -(i + 1).
+class KernelBuilder {
+ public:
+  explicit KernelBuilder(TypePtr type) : type_(std::move(type)) {
+    signature_ = type_->toString() + ":";
+  }
+
+  // Adds the tree rooted at 'expr'. Returns the operand for the result of
+  // the tree or std::nullopt if the tree cannot be fused.
+  std::optional<int32_t> add(const ExprPtr& expr, bool isRoot) {
+    if (auto* fused = expr->as<FusedExpr>()) {
+      return add(fused->fallback(), isRoot);
+    }
+    if (auto op = callOp(expr, isRoot)) {
+      signature_ += expr->name() + "(";
+      auto left = add(expr->inputs()[0], false);
+      signature_ += ",";
+      auto right = left ? add(expr->inputs()[1], false) : std::nullopt;
+      signature_ += ")";
+      if (!left || !right) {
+        return std::nullopt;
+      }
+      instructions_.push_back({*op, *left, *right});
+      return -static_cast<int32_t>(instructions_.size());
+    }
+    if (!isRoot && *expr->type() == *type_ &&
+        (expr->is<ConstantExpr>() ||
+         (expr->is<FieldReference>() && expr->inputs().empty()))) {
+      auto it = std::find(inputs_.begin(), inputs_.end(), expr);
+      const int32_t index = it - inputs_.begin();
+      if (it == inputs_.end()) {
+        inputs_.push_back(expr);
+      }
+      signature_ += fmt::format("#{}", index);
+      return index;
+    }
+    return std::nullopt;
+  }
+
+  size_t numInstructions() const {
+    return instructions_.size();
+  }
+
+  const std::string& signature() const {
+    return signature_;
+  }
+
+  std::vector<ExprPtr> takeInputs() {
+    return std::move(inputs_);
+  }
+
+  std::shared_ptr<const FusedKernel> makeKernel() const {
+    const int32_t numInputs = inputs_.size();
+    auto toOperand = [&](int32_t operand) {
+      return operand >= 0 ? operand : numInputs - operand - 1;
+    };
+    std::vector<FusedKernel::Instruction> instructions;
+    instructions.reserve(instructions_.size());
+    for (const auto& instruction : instructions_) {
+      instructions.push_back(
+          {instruction.op,
+           toOperand(instruction.left),
+           toOperand(instruction.right)});
+    }
+    return std::make_shared<const FusedKernel>(
+        type_->kind(), numInputs, std::move(instructions));
+  }
+
+ private:
+  // Returns the operation of 'expr' if this is a deterministic call to a
+  // fusable function with default null behavior. Comparisons produce
+  // booleans and can only be the root of the tree.
+  std::optional<Op> callOp(const ExprPtr& expr, bool isRoot) const {
+    if (expr->vectorFunction() == nullptr || expr->inputs().size() != 2 ||
+        !expr->vectorFunctionMetadata().deterministic ||
+        !expr->vectorFunctionMetadata().defaultNullBehavior) {
+      return std::nullopt;
+    }
+    auto op = toOp(expr->name());
+    if (!op.has_value()) {
+      return std::nullopt;
+    }
+    const auto& resultType =
+        FusedKernel::isComparison(*op) ? BOOLEAN() : type_;
+    if (FusedKernel::isComparison(*op) && !isRoot) {
+      return std::nullopt;
+    }
+    if (*expr->type() != *resultType) {
+      return std::nullopt;
+    }
+    return op;
+  }
+
+  const TypePtr type_;
+  std::string signature_;
+  std::vector<ExprPtr> inputs_;
+  std::vector<FusedKernel::Instruction> instructions_;
+};
+
+template <typename T>
+bool applyArithmetic(
+    Op op,
+    const T* left,
+    const T* right,
+    T* result,
+    vector_size_t size) {
+  if constexpr (std::is_integral_v<T>) {
+    bool overflow = false;
+    switch (op) {
+      case Op::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_add_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      case Op::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_sub_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      case Op::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_mul_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    return !overflow;
+  } else {
+    switch (op) {
+      case Op::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] + right[i];
+        }
+        break;
+      case Op::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] - right[i];
+        }
+        break;
+      case Op::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] * right[i];
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    return true;
+  }
+}
+
+template <typename T, typename TCompare>
+void compareBatch(
+    const T* left,
+    const T* right,
+    vector_size_t offset,
+    vector_size_t size,
+    uint64_t* result,
+    TCompare compare) {
+  for (auto i = 0; i < size; ++i) {
+    bits::setBit(result, offset + i, compare(left[i], right[i]));
+  }
+}
+
+// Sets bits ['offset', 'offset' + 'size') of 'result' to the comparison of
+// 'left' and 'right'.
+template <typename T>
+void applyComparison(
+    Op op,
+    const T* left,
+    const T* right,
+    vector_size_t offset,
+    vector_size_t size,
+    uint64_t* result) {
+  switch (op) {
+    case Op::kEq:
+      compareBatch(left, right, offset, size, result, std::equal_to<T>());
+      break;
+    case Op::kNeq:
+      compareBatch(left, right, offset, size, result, std::not_equal_to<T>());
+      break;
+    case Op::kLt:
+      compareBatch(left, right, offset, size, result, std::less<T>());
+      break;
+    case Op::kLte:
+      compareBatch(left, right, offset, size, result, std::less_equal<T>());
+      break;
+    case Op::kGt:
+      compareBatch(left, right, offset, size, result, std::greater<T>());
+      break;
+    case Op::kGte:
+      compareBatch(
+          left, right, offset, size, result, std::greater_equal<T>());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace
+
+// static
+std::shared_ptr<const FusedKernel> FusedKernel::getOrCreate(
+    const std::string& signature,
+    const std::function<std::shared_ptr<const FusedKernel>()>& makeKernel) {
+  auto kernel = kernelCache().withRLock(
+      [&](const auto& cache) -> std::shared_ptr<const FusedKernel> {
+        auto it = cache.find(signature);
+        return it == cache.end() ? nullptr : it->second;
+      });
+  if (kernel != nullptr) {
+    return kernel;
+  }
+
+  kernel = makeKernel();
+  return kernelCache().withWLock([&](auto& cache) {
+    if (cache.size() >= kMaxCachedKernels) {
+      return kernel;
+    }
+    return cache.emplace(signature, kernel).first->second;
+  });
+}
+
+// static
+size_t FusedKernel::numCachedKernels() {
+  return kernelCache().rlock()->size();
+}
+
+FusedExpr::FusedExpr(
+    TypePtr type,
+    std::vector<ExprPtr>&& inputs,
+    std::shared_ptr<const FusedKernel> kernel,
+    ExprPtr fallback)
+    : SpecialForm(
+          std::move(type),
+          std::move(inputs),
+          kFused,
+          fallback->supportsFlatNoNullsFastPath(),
+          false /* trackCpuUsage */),
+      kernel_(std::move(kernel)),
+      fallback_(std::move(fallback)) {}
+
+// static
+ExprPtr FusedExpr::tryFuse(const ExprPtr& expr) {
+  if (expr->vectorFunction() == nullptr || expr->inputs().size() != 2) {
+    return expr;
+  }
+  auto op = toOp(expr->name());
+  if (!op.has_value()) {
+    return expr;
+  }
+  const auto& type = FusedKernel::isComparison(*op)
+      ? expr->inputs()[0]->type()
+      : expr->type();
+  if (!isFusableType(type)) {
+    return expr;
+  }
+
+  KernelBuilder builder(type);
+  if (!builder.add(expr, true).has_value() ||
+      builder.numInstructions() < 2) {
+    return expr;
+  }
+
+  auto kernel = FusedKernel::getOrCreate(
+      builder.signature(), [&]() { return builder.makeKernel(); });
+  expr->computeMetadata();
+  return std::make_shared<FusedExpr>(
+      expr->type(), builder.takeInputs(), std::move(kernel), expr);
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  evalImpl<false>(rows, context, result);
+}
+
+void FusedExpr::evalSpecialFormSimplified(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  evalImpl<true>(rows, context, result);
+}
+
+template <bool simplified>
+void FusedExpr::evalImpl(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  inputValues_.resize(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    if constexpr (simplified) {
+      inputs_[i]->evalSimplified(rows, context, inputValues_[i]);
+    } else {
+      inputs_[i]->eval(rows, context, inputValues_[i]);
+    }
+  }
+
+  bool done;
+  switch (kernel_->kind()) {
+    case TypeKind::TINYINT:
+      done = evalKernel<int8_t>(rows, context, result);
+      break;
+    case TypeKind::SMALLINT:
+      done = evalKernel<int16_t>(rows, context, result);
+      break;
+    case TypeKind::INTEGER:
+      done = evalKernel<int32_t>(rows, context, result);
+      break;
+    case TypeKind::BIGINT:
+      done = evalKernel<int64_t>(rows, context, result);
+      break;
+    case TypeKind::REAL:
+      done = evalKernel<float>(rows, context, result);
+      break;
+    case TypeKind::DOUBLE:
+      done = evalKernel<double>(rows, context, result);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  releaseInputValues(context);
+
+  if (!done) {
+    if constexpr (simplified) {
+      fallback_->evalSimplified(rows, context, result);
+    } else {
+      fallback_->eval(rows, context, result);
+    }
+  }
+}
+
+template <typename T>
+bool FusedExpr::evalKernel(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  const auto numInputs = kernel_->numInputs();
+  const auto& instructions = kernel_->instructions();
+  const auto numRegisters = numInputs + instructions.size();
+  const auto registersSize = numRegisters * kBatchSize * sizeof(T);
+  if (registers_ == nullptr || registers_->capacity() < registersSize) {
+    registers_ = AlignedBuffer::allocate<char>(registersSize, context.pool());
+  }
+  auto* rawRegisters = registers_->asMutable<T>();
+
+  // Raw values of the flat inputs. Constant inputs are broadcast to their
+  // register.
+  // The per-input arrays come from the batch scratch arena.
+  auto* rawInputs = context.allocateScratch<const T*>(numInputs);
+  std::fill_n(rawInputs, numInputs, nullptr);
+  auto* rawInputNulls = context.allocateScratch<const uint64_t*>(numInputs);
+  int32_t numInputNulls = 0;
+  for (auto i = 0; i < numInputs; ++i) {
+    const auto& input = inputValues_[i];
+    if (input->isConstantEncoding()) {
+      if (input->isNullAt(0)) {
+        setAllNulls(rows, context, result);
+        return true;
+      }
+      std::fill_n(
+          rawRegisters + i * kBatchSize,
+          kBatchSize,
+          input->asUnchecked<SimpleVector<T>>()->valueAt(0));
+    } else if (input->isFlatEncoding()) {
+      rawInputs[i] = input->asUnchecked<FlatVector<T>>()->rawValues();
+      if (input->rawNulls() != nullptr) {
+        rawInputNulls[numInputNulls++] = input->rawNulls();
+      }
+    } else {
+      return false;
+    }
+  }
+
+  VectorPtr localResult;
+  context.ensureWritable(rows, type(), localResult);
+  if (numInputNulls == 0) {
+    localResult->clearNulls(rows);
+  } else {
+    auto* rawNulls = localResult->mutableRawNulls();
+    bits::fillBits(rawNulls, rows.begin(), rows.end(), bits::kNotNull);
+    for (auto i = 0; i < numInputNulls; ++i) {
+      bits::andBits(rawNulls, rawInputNulls[i], rows.begin(), rows.end());
+    }
+  }
+
+  const bool isComparison =
+      FusedKernel::isComparison(instructions.back().op);
+  T* rawResult = isComparison
+      ? nullptr
+      : localResult->asUnchecked<FlatVector<T>>()->mutableRawValues();
+  uint64_t* rawResultBits = isComparison
+      ? localResult->asUnchecked<FlatVector<bool>>()
+            ->template mutableRawValues<uint64_t>()
+      : nullptr;
+
+  auto* operands = context.allocateScratch<const T*>(numRegisters);
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kBatchSize) {
+    const auto size = std::min(kBatchSize, rows.end() - begin);
+    for (auto i = 0; i < numInputs; ++i) {
+      operands[i] = rawInputs[i] != nullptr ? rawInputs[i] + begin
+                                            : rawRegisters + i * kBatchSize;
+    }
+    for (auto i = 0; i < instructions.size(); ++i) {
+      const auto& instruction = instructions[i];
+      const auto* left = operands[instruction.left];
+      const auto* right = operands[instruction.right];
+      if (FusedKernel::isComparison(instruction.op)) {
+        applyComparison(
+            instruction.op, left, right, begin, size, rawResultBits);
+        continue;
+      }
+      auto* output = i + 1 == instructions.size()
+          ? rawResult + begin
+          : rawRegisters + (numInputs + i) * kBatchSize;
+      if (!applyArithmetic(instruction.op, left, right, output, size)) {
+        // Let the functions report the overflow.
+        return false;
+      }
+      operands[numInputs + i] = output;
+    }
+  }
+
+  context.moveOrCopyResult(localResult, rows, result);
+  return true;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+const char* const kFused = "fused";
+
+/// A program that evaluates a tree of arithmetic and comparison functions
+/// over fixed-width values of a single type. The operands of an instruction
+/// are either inputs of the tree or results of previous instructions. The
+/// last instruction produces the result. Kernels only depend on the shape of
+/// the tree and are shared between all trees with the same signature.
+class FusedKernel {
+ public:
+  enum class Op : uint8_t {
+    kPlus,
+    kMinus,
+    kMultiply,
+    kEq,
+    kNeq,
+    kLt,
+    kLte,
+    kGt,
+    kGte,
+  };
+
+  struct Instruction {
+    Op op;
+
+    /// Operands. A value below the number of inputs is the index of an input.
+    /// Otherwise, it is the index of a previous instruction plus the number of
+    /// inputs.
+    int32_t left;
+    int32_t right;
+  };
+
+  FusedKernel(
+      TypeKind kind,
+      int32_t numInputs,
+      std::vector<Instruction> instructions)
+      : kind_(kind),
+        numInputs_(numInputs),
+        instructions_(std::move(instructions)) {}
+
+  /// Returns the kernel for 'signature' from the process-wide cache. Creates
+  /// the kernel using 'makeKernel' on a cache miss.
+  static std::shared_ptr<const FusedKernel> getOrCreate(
+      const std::string& signature,
+      const std::function<std::shared_ptr<const FusedKernel>()>& makeKernel);
+
+  /// Returns the number of kernels in the process-wide cache.
+  static size_t numCachedKernels();
+
+  static bool isComparison(Op op) {
+    return op >= Op::kEq;
+  }
+
+  /// Type of the inputs and of the results of arithmetic instructions.
+  TypeKind kind() const {
+    return kind_;
+  }
+
+  int32_t numInputs() const {
+    return numInputs_;
+  }
+
+  const std::vector<Instruction>& instructions() const {
+    return instructions_;
+  }
+
+ private:
+  const TypeKind kind_;
+  const int32_t numInputs_;
+  const std::vector<Instruction> instructions_;
+};
+
+/// Evaluates a tree of deterministic, null-propagating arithmetic and
+/// comparison functions in a single pass over flat or constant inputs.
+/// Intermediate results are kept in cache-resident buffers of a few hundred
+/// rows instead of being materialized as vectors between function calls.
+/// 'inputs' are the leaves of the tree, i.e. field references and constants.
+/// Falls back to evaluating the original tree 'fallback' for inputs with
+/// other encodings and on integer overflow, so that errors are reported as
+/// by the functions themselves.
+class FusedExpr : public SpecialForm {
+ public:
+  FusedExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& inputs,
+      std::shared_ptr<const FusedKernel> kernel,
+      ExprPtr fallback);
+
+  /// Returns a FusedExpr for the tree rooted at 'expr' if this is a call to
+  /// plus, minus, multiply, eq, neq, lt, lte, gt or gte over a tree of at
+  /// least 2 such calls on fixed-width numeric values. Returns 'expr'
+  /// otherwise.
+  static ExprPtr tryFuse(const ExprPtr& expr);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  void evalSpecialFormSimplified(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toString(bool recursive = true) const override {
+    return fallback_->toString(recursive);
+  }
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override {
+    return fallback_->toSql(complexConstants);
+  }
+
+  const FusedKernel& kernel() const {
+    return *kernel_;
+  }
+
+  /// The tree evaluated by this expression.
+  const ExprPtr& fallback() const {
+    return fallback_;
+  }
+
+ private:
+  void computePropagatesNulls() override {
+    propagatesNulls_ = true;
+  }
+
+  template <bool simplified>
+  void evalImpl(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  // Runs 'kernel_' on 'inputValues_'. Returns false if the inputs are not
+  // flat or constant or if the computation overflows.
+  template <typename T>
+  bool evalKernel(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  const std::shared_ptr<const FusedKernel> kernel_;
+  const ExprPtr fallback_;
+
+  // Buffers for the constant inputs and the intermediate results of one
+  // batch of rows. Reused between evaluations.
+  BufferPtr registers_;
+};
+
+} // namespace facebook::velox::exec
@@ -26,23 +26,44 @@ namespace {
 // Represents an interpreted lambda expression. 'signature' describes
 // the parameters passed by the caller. 'capture' is a row with a
 // leading nullptr for each element in 'signature' followed by the
-// vectors for the captures from the lambda's definition scope.
+// vectors for the captures from the lambda's definition scope and a trailing
+// nullptr for each of 'invariants'.
 class ExprCallable : public Callable {
  public:
   ExprCallable(
       RowTypePtr signature,
       RowVectorPtr capture,
       std::shared_ptr<Expr> body,
-      std::vector<std::shared_ptr<Expr>> sharedExprsToReset)
+      std::vector<std::shared_ptr<Expr>> sharedExprsToReset,
+      std::vector<ExprPtr> invariants,
+      ExprPtr hoistedBody,
+      std::vector<std::shared_ptr<Expr>> hoistedSharedExprsToReset)
       : signature_(std::move(signature)),
         capture_(std::move(capture)),
         body_(std::move(body)),
-        sharedExprsToReset_(std::move(sharedExprsToReset)) {}
+        sharedExprsToReset_(std::move(sharedExprsToReset)),
+        invariants_(std::move(invariants)),
+        hoistedBody_(std::move(hoistedBody)),
+        hoistedSharedExprsToReset_(std::move(hoistedSharedExprsToReset)) {}
 
   bool hasCapture() const override {
     return capture_->childrenSize() > signature_->size();
   }
 
+  /// Sets the captures for evaluating another batch.
+  void setCapture(RowVectorPtr capture) {
+    capture_ = std::move(capture);
+  }
+
+  /// Releases the vectors of the last evaluation. The callable can then be
+  /// reused after setCapture().
+  void releaseVectors() {
+    capture_.reset();
+    row_.reset();
+    rowWrapCapture_.reset();
+    invariantValues_.clear();
+  }
+
   void apply(
       const SelectivityVector& rows,
       const SelectivityVector* validRowsInReusedResult,
@@ -51,13 +72,15 @@ class ExprCallable : public Callable {
       const std::vector<VectorPtr>& args,
       const BufferPtr& elementToTopLevelRows,
       VectorPtr* result) override {
-    auto row = createRowVector(context, wrapCapture, args, rows.end());
+    auto& body = evalInvariants(rows, wrapCapture, context);
+    const auto& row = createRowVector(context, wrapCapture, args, rows.end());
     EvalCtx lambdaCtx = createLambdaCtx(context, row, validRowsInReusedResult);
     ScopedVarSetter throwOnError(
         lambdaCtx.mutableThrowOnError(), context->throwOnError());
-    resetSharedExprs();
-    body_->eval(rows, lambdaCtx, *result);
+    resetSharedExprs(body);
+    body->eval(rows, lambdaCtx, *result);
     transformErrorVector(lambdaCtx, context, rows, elementToTopLevelRows);
+    releaseArgs();
   }
 
   void applyNoThrow(
@@ -68,24 +91,71 @@ class ExprCallable : public Callable {
       const std::vector<VectorPtr>& args,
       EvalErrorsPtr& elementErrors,
       VectorPtr* result) override {
-    auto row = createRowVector(context, wrapCapture, args, rows.end());
+    auto& body = evalInvariants(rows, wrapCapture, context);
+    const auto& row = createRowVector(context, wrapCapture, args, rows.end());
     EvalCtx lambdaCtx = createLambdaCtx(context, row, validRowsInReusedResult);
     ScopedVarSetter throwOnError(lambdaCtx.mutableThrowOnError(), false);
-    resetSharedExprs();
-    body_->eval(rows, lambdaCtx, *result);
+    resetSharedExprs(body);
+    body->eval(rows, lambdaCtx, *result);
     lambdaCtx.swapErrors(elementErrors);
+    releaseArgs();
   }
 
  private:
-  void resetSharedExprs() {
-    for (auto& expr : sharedExprsToReset_) {
+  void resetSharedExprs(const ExprPtr& body) {
+    for (auto& expr :
+         body == body_ ? sharedExprsToReset_ : hoistedSharedExprsToReset_) {
+      expr->reset();
+    }
+  }
+
+  // Evaluates 'invariants_' over the top-level rows of 'rows' into
+  // 'invariantValues_'. Returns the body to evaluate: 'hoistedBody_' if all
+  // invariants were evaluated without errors, 'body_' otherwise.
+  const ExprPtr& evalInvariants(
+      const SelectivityVector& rows,
+      const BufferPtr& wrapCapture,
+      EvalCtx* context) {
+    invariantValues_.clear();
+    if (!hoistedBody_) {
+      return body_;
+    }
+
+    const SelectivityVector* topLevelRows = &rows;
+    LocalSelectivityVector topLevelRowsHolder(*context);
+    if (wrapCapture) {
+      auto* wrappedRows = topLevelRowsHolder.get(capture_->size(), false);
+      auto* rawWrapCapture = wrapCapture->as<vector_size_t>();
+      rows.applyToSelected([&](vector_size_t row) {
+        wrappedRows->setValid(rawWrapCapture[row], true);
+      });
+      wrappedRows->updateBounds();
+      topLevelRows = wrappedRows;
+    }
+    if (!topLevelRows->hasSelections()) {
+      return body_;
+    }
+
+    for (auto& expr : hoistedSharedExprsToReset_) {
       expr->reset();
     }
+    EvalCtx invariantCtx{
+        context->execCtx(), context->exprSet(), capture_.get()};
+    *invariantCtx.mutableThrowOnError() = false;
+    invariantValues_.resize(invariants_.size());
+    for (auto i = 0; i < invariants_.size(); ++i) {
+      invariants_[i]->eval(*topLevelRows, invariantCtx, invariantValues_[i]);
+    }
+    if (invariantCtx.errors() && invariantCtx.errors()->hasError()) {
+      invariantValues_.clear();
+      return body_;
+    }
+    return hoistedBody_;
   }
 
   EvalCtx createLambdaCtx(
       EvalCtx* context,
-      std::shared_ptr<RowVector>& row,
+      const std::shared_ptr<RowVector>& row,
       const SelectivityVector* validRowsInReusedResult) {
     EvalCtx lambdaCtx{context->execCtx(), context->exprSet(), row.get()};
     if (validRowsInReusedResult != nullptr) {
@@ -110,30 +180,72 @@ class ExprCallable : public Callable {
     }
   }
 
-  std::shared_ptr<RowVector> createRowVector(
+  VectorPtr wrapCaptured(
+      VectorPtr values,
+      const BufferPtr& wrapCapture,
+      vector_size_t size) {
+    VELOX_DCHECK(!isLazyNotLoaded(*values));
+    if (wrapCapture) {
+      return BaseVector::wrapInDictionary(
+          BufferPtr(nullptr), wrapCapture, size, std::move(values));
+    }
+    return values;
+  }
+
+  // Returns the row of 'args', captures and invariants to evaluate the body
+  // over. Reuses the row of the previous call if nothing references it
+  // anymore. Unless 'wrapCapture' changed, the wrapped captures are reused as
+  // well. This avoids allocations for callers that apply the same function
+  // repeatedly, e.g. reduce once per array position.
+  const std::shared_ptr<RowVector>& createRowVector(
       EvalCtx* context,
       const BufferPtr& wrapCapture,
       const std::vector<VectorPtr>& args,
       vector_size_t size) {
     VELOX_CHECK_EQ(signature_->size(), args.size())
-    std::vector<VectorPtr> allVectors = args;
-    for (auto index = args.size(); index < capture_->childrenSize(); ++index) {
-      auto values = capture_->childAt(index);
-      VELOX_DCHECK(!isLazyNotLoaded(*values));
-      if (wrapCapture) {
-        values = BaseVector::wrapInDictionary(
-            BufferPtr(nullptr), wrapCapture, size, values);
+    const auto numCaptured = capture_->childrenSize() - invariants_.size();
+    if (!row_ || row_.use_count() > 1 || row_->size() != size ||
+        rowWrapCapture_ != wrapCapture) {
+      std::vector<VectorPtr> allVectors(capture_->childrenSize());
+      for (auto index = args.size(); index < numCaptured; ++index) {
+        allVectors[index] =
+            wrapCaptured(capture_->childAt(index), wrapCapture, size);
       }
-      allVectors.push_back(values);
+      row_ = std::make_shared<RowVector>(
+          context->pool(),
+          capture_->type(),
+          BufferPtr(nullptr),
+          size,
+          std::move(allVectors));
+      rowWrapCapture_ = wrapCapture;
     }
 
-    auto row = std::make_shared<RowVector>(
-        context->pool(),
-        capture_->type(),
-        BufferPtr(nullptr),
-        size,
-        std::move(allVectors));
-    return row;
+    for (auto i = 0; i < args.size(); ++i) {
+      row_->childAt(i) = args[i];
+    }
+    for (auto i = 0; i < invariants_.size(); ++i) {
+      if (invariantValues_.empty()) {
+        // 'body_' does not reference the invariants.
+        row_->childAt(numCaptured + i) = BaseVector::createNullConstant(
+            invariants_[i]->type(), size, context->pool());
+      } else {
+        row_->childAt(numCaptured + i) =
+            wrapCaptured(invariantValues_[i], wrapCapture, size);
+      }
+    }
+    return row_;
+  }
+
+  // Drops the references to the arguments and invariants from the row of the
+  // last call so that callers can reuse these, e.g. the state of reduce.
+  void releaseArgs() {
+    const auto numCaptured = capture_->childrenSize() - invariants_.size();
+    for (auto i = 0; i < signature_->size(); ++i) {
+      row_->childAt(i) = nullptr;
+    }
+    for (auto i = numCaptured; i < capture_->childrenSize(); ++i) {
+      row_->childAt(i) = nullptr;
+    }
   }
 
   RowTypePtr signature_;
@@ -142,6 +254,17 @@ class ExprCallable : public Callable {
   // List of Shared Exprs that are decendants of 'body_' for which reset() needs
   // to be called before calling `body_->eval()`.
   std::vector<std::shared_ptr<Expr>> sharedExprsToReset_;
+  std::vector<ExprPtr> invariants_;
+  ExprPtr hoistedBody_;
+  // Same as 'sharedExprsToReset_' for 'hoistedBody_' and 'invariants_'.
+  std::vector<std::shared_ptr<Expr>> hoistedSharedExprsToReset_;
+  // Values of 'invariants_' for the last application. Empty if 'body_' is
+  // evaluated.
+  std::vector<VectorPtr> invariantValues_;
+  // The row built by the last call to createRowVector() and the 'wrapCapture'
+  // its captures are wrapped in.
+  std::shared_ptr<RowVector> row_;
+  BufferPtr rowWrapCapture_;
 };
 
 void extractSharedExpressions(
@@ -163,7 +286,10 @@ LambdaExpr::LambdaExpr(
     RowTypePtr&& signature,
     std::vector<std::shared_ptr<FieldReference>>&& capture,
     std::shared_ptr<Expr>&& body,
-    bool trackCpuUsage)
+    bool trackCpuUsage,
+    std::vector<std::string>&& invariantNames,
+    std::vector<ExprPtr>&& invariants,
+    ExprPtr&& hoistedBody)
     : SpecialForm(
           std::move(type),
           std::vector<std::shared_ptr<Expr>>(),
@@ -172,12 +298,28 @@ LambdaExpr::LambdaExpr(
           trackCpuUsage),
       signature_(std::move(signature)),
       body_(std::move(body)),
+      invariantNames_(std::move(invariantNames)),
+      invariants_(std::move(invariants)),
+      hoistedBody_(std::move(hoistedBody)),
       capture_(std::move(capture)) {
+  VELOX_CHECK_EQ(invariantNames_.size(), invariants_.size());
+  VELOX_CHECK_EQ(invariants_.empty(), hoistedBody_ == nullptr);
   std::unordered_set<ExprPtr> shared;
   extractSharedExpressions(body_, shared);
   for (auto& expr : shared) {
     sharedExprsToReset_.push_back(expr);
   }
+
+  if (hoistedBody_) {
+    shared.clear();
+    extractSharedExpressions(hoistedBody_, shared);
+    for (const auto& invariant : invariants_) {
+      extractSharedExpressions(invariant, shared);
+    }
+    for (auto& expr : shared) {
+      hoistedSharedExprsToReset_.push_back(expr);
+    }
+  }
 }
 
 void LambdaExpr::computeDistinctFields() {
@@ -252,8 +394,29 @@ void LambdaExpr::evalSpecialForm(
       rows.end(),
       values,
       0);
-  auto callable = std::make_shared<ExprCallable>(
-      signature_, capture, body_, sharedExprsToReset_);
+  // 'callable_' is only referenced by 'this' once the FunctionVectors of the
+  // previous evaluations are gone.
+  if (callable_ && callable_.use_count() == 1) {
+    std::static_pointer_cast<ExprCallable>(callable_)->setCapture(
+        std::move(capture));
+  } else {
+    callable_ = std::make_shared<ExprCallable>(
+        signature_,
+        std::move(capture),
+        body_,
+        sharedExprsToReset_,
+        invariants_,
+        hoistedBody_,
+        hoistedSharedExprsToReset_);
+  }
+  // The FunctionVector gets a handle that releases the vectors referenced by
+  // the callable when it goes away, so that these are not retained until the
+  // next evaluation.
+  auto* rawCallable = static_cast<ExprCallable*>(callable_.get());
+  std::shared_ptr<Callable> callable(
+      rawCallable, [owner = callable_](ExprCallable* released) {
+        released->releaseVectors();
+      });
   std::shared_ptr<FunctionVector> functions;
   if (!result) {
     functions = std::make_shared<FunctionVector>(context.pool(), type_);
@@ -268,7 +431,7 @@ void LambdaExpr::evalSpecialForm(
 void LambdaExpr::makeTypeWithCapture(EvalCtx& context) {
   // On first use, compose the type of parameters + capture and set
   // the indices of captures in the context row.
-  if (capture_.empty()) {
+  if (capture_.empty() && invariants_.empty()) {
     typeWithCapture_ = signature_;
   } else {
     auto& contextType = context.row()->type()->as<TypeKind::ROW>();
@@ -281,6 +444,10 @@ void LambdaExpr::makeTypeWithCapture(EvalCtx& context) {
       parameterNames.push_back(name);
       parameterTypes.push_back(contextType.childAt(channel));
     }
+    for (auto i = 0; i < invariants_.size(); ++i) {
+      parameterNames.push_back(invariantNames_[i]);
+      parameterTypes.push_back(invariants_[i]->type());
+    }
     typeWithCapture_ =
         ROW(std::move(parameterNames), std::move(parameterTypes));
   }
@@ -301,4 +468,30 @@ void LambdaExpr::extractSubfieldsImpl(
   }
 }
 
+bool LambdaExpr::extractParameterSubfields(
+    folly::F14FastMap<std::string, int32_t>* shadowedNames,
+    std::vector<common::Subfield>* subfields,
+    std::vector<common::Subfield>* parameterSubfields) const {
+  if (signature_->size() != 1) {
+    return false;
+  }
+  // The parameter shadows any outer name it coincides with, so paths rooted
+  // at it in the body refer to the parameter.
+  const auto& name = signature_->nameOf(0);
+  auto bodyShadowedNames = *shadowedNames;
+  bodyShadowedNames.erase(name);
+  std::vector<common::Subfield> bodySubfields;
+  body_->extractSubfieldsImpl(&bodyShadowedNames, &bodySubfields);
+  for (auto& subfield : bodySubfields) {
+    auto* root = dynamic_cast<const common::Subfield::NestedField*>(
+        subfield.path()[0].get());
+    if (root && root->name() == name) {
+      parameterSubfields->push_back(std::move(subfield));
+    } else {
+      subfields->push_back(std::move(subfield));
+    }
+  }
+  return true;
+}
+
 } // namespace facebook::velox::exec
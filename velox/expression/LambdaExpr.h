@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/expression/SpecialForm.h"
+#include "velox/vector/FunctionVector.h"
 
 namespace facebook::velox::exec {
 
@@ -26,6 +27,15 @@ namespace facebook::velox::exec {
 /// references to other columns in the input row vector which are required to
 /// evaluate the function. These references are called captures.
 /// eg. filter(array[1, 2, 3, 4], x -> x % 2 = 0)
+///
+/// Subtrees of the inner expression that do not depend on the lambda
+/// parameters may be hoisted into 'invariants'. These are evaluated over the
+/// captures once per top-level row and passed to 'hoistedBody', a copy of
+/// 'body' that references them as fields named by 'invariantNames'. 'body' is
+/// evaluated instead if an invariant fails for some row, so that errors are
+/// only reported for rows where they occur with per-element evaluation.
+/// eg. transform(a, x -> x + c0 * 2) evaluates c0 * 2 once per element of 'a'
+/// without hoisting and once per row of 'a' with hoisting.
 class LambdaExpr : public SpecialForm {
  public:
   LambdaExpr(
@@ -33,7 +43,10 @@ class LambdaExpr : public SpecialForm {
       RowTypePtr&& signature,
       std::vector<std::shared_ptr<FieldReference>>&& capture,
       std::shared_ptr<Expr>&& body,
-      bool trackCpuUsage);
+      bool trackCpuUsage,
+      std::vector<std::string>&& invariantNames = {},
+      std::vector<ExprPtr>&& invariants = {},
+      ExprPtr&& hoistedBody = nullptr);
 
   bool isConstant() const override {
     return false;
@@ -44,6 +57,16 @@ class LambdaExpr : public SpecialForm {
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
+  /// Adds the subfields read by the body to 'subfields', except for the ones
+  /// rooted at the only parameter, which go to 'parameterSubfields'. Used to
+  /// narrow the subfields of an array that a lambda reads from its elements.
+  /// Returns false without adding anything if there is not exactly one
+  /// parameter.
+  bool extractParameterSubfields(
+      folly::F14FastMap<std::string, int32_t>* shadowedNames,
+      std::vector<common::Subfield>* subfields,
+      std::vector<common::Subfield>* parameterSubfields) const;
+
   void evalSpecialForm(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -77,6 +100,21 @@ class LambdaExpr : public SpecialForm {
   // similar to how we operate in `ExprSet::eval()`.
   std::vector<ExprPtr> sharedExprsToReset_;
 
+  // Names of the fields through which 'hoistedBody_' references the values
+  // of 'invariants_'. Corresponds 1:1 to 'invariants_'.
+  const std::vector<std::string> invariantNames_;
+
+  // Subtrees of 'body_' that only depend on 'capture_'. Evaluated over the
+  // captures. Empty if nothing was hoisted.
+  const std::vector<ExprPtr> invariants_;
+
+  // 'body_' with 'invariants_' replaced by references to 'invariantNames_'.
+  // nullptr if nothing was hoisted.
+  const ExprPtr hoistedBody_;
+
+  // Same as 'sharedExprsToReset_' for 'hoistedBody_' and 'invariants_'.
+  std::vector<ExprPtr> hoistedSharedExprsToReset_;
+
   /// List of field references to columns in the input row vector.
   std::vector<std::shared_ptr<FieldReference>> capture_;
 
@@ -87,9 +125,14 @@ class LambdaExpr : public SpecialForm {
 
   /// A row type representing column types in the order starting with inner
   /// types of the array/map it operates on followed by types of the columns
-  /// that it captures (in the same order as that in capture_). This is used to
-  /// create an input row vector which is fed to the inner expression. Filled on
-  /// first use.
+  /// that it captures (in the same order as that in capture_) and the types of
+  /// invariants_. This is used to create an input row vector which is fed to
+  /// the inner expression. Filled on first use.
   RowTypePtr typeWithCapture_;
+
+  /// The callable produced by the last evaluation. Reused together with its
+  /// argument row if no FunctionVector references it anymore. The vectors it
+  /// references are released when the FunctionVector goes away.
+  std::shared_ptr<Callable> callable_;
 };
 } // namespace facebook::velox::exec
@@ -90,6 +90,30 @@ bool isDictionaryOverFlat(const BaseVector& wrapper) {
   return wrapper.encoding() == VectorEncoding::Simple::DICTIONARY &&
       wrapper.valueVector()->isFlatEncoding();
 }
+
+/// Returns true if dictionaries 'first' and 'other' map all 'rows' to the same
+/// base rows and add nulls for the same rows. Inputs wrapped separately after
+/// the same filter or reordering, e.g. the map and key columns produced by a
+/// reader, carry equal but distinct indices buffers.
+bool isSameWrapping(
+    const BaseVector& first,
+    const BaseVector& other,
+    const SelectivityVector& rows) {
+  if (first.size() < rows.end() || other.size() < rows.end()) {
+    return false;
+  }
+  const auto* firstIndices = first.wrapInfo()->as<vector_size_t>();
+  const auto* otherIndices = other.wrapInfo()->as<vector_size_t>();
+  const auto* firstNulls = first.rawNulls();
+  const auto* otherNulls = other.rawNulls();
+  return rows.testSelected([&](vector_size_t row) {
+    const bool isNull = firstNulls && bits::isBitNull(firstNulls, row);
+    if (isNull != (otherNulls && bits::isBitNull(otherNulls, row))) {
+      return false;
+    }
+    return isNull || firstIndices[row] == otherIndices[row];
+  });
+}
 } // namespace
 
 void PeeledEncoding::setDictionaryWrapping(
@@ -125,6 +149,7 @@ bool PeeledEncoding::peelInternal(
   do {
     peeled = true;
     BufferPtr firstIndices;
+    const BaseVector* firstWrapper = nullptr;
     maybePeeled.resize(numFields);
     for (int fieldIndex = 0; fieldIndex < numFields; fieldIndex++) {
       auto leaf = peeledVectors.empty() ? vectorsToPeel[fieldIndex]
@@ -165,7 +190,10 @@ bool PeeledEncoding::peelInternal(
         BufferPtr indices = leaf->wrapInfo();
         if (!firstIndices) {
           firstIndices = std::move(indices);
-        } else if (indices != firstIndices) {
+          firstWrapper = leaf.get();
+        } else if (
+            indices != firstIndices &&
+            (numLevels > 0 || !isSameWrapping(*firstWrapper, *leaf, rows))) {
           // different fields use different dictionaries
           peeled = false;
           break;
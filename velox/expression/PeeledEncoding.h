@@ -100,6 +100,12 @@ class LocalSelectivityVector;
 ///    Peeled Vectors: DictWithNulls(Flat1), Const1,
 ///                    DictWithNulls(Dict3(Flat2))
 ///    peel: DictNoNulls
+///
+/// 10. Outermost dictionaries with distinct but equal indices and nulls over
+///    the selected rows are peeled as if they were the same dictionary.
+///    Input Vectors: Dict1(Complex1), Dict1Copy(Flat1)
+///    Peeled Vectors: Complex1, Flat1
+///    peel: Dict1
 class PeeledEncoding {
  public:
   /// Factory method for constructing a PeeledEncoding object only if peeling
@@ -150,6 +150,32 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  /// True if the UDF provides callBatch() and the result and all arguments are
+  /// fixed-width primitive types other than boolean.
+  constexpr bool static batchIterationEligible() {
+    if constexpr (
+        !FUNC::udf_has_callBatch || !fastPathIteration ||
+        return_type_traits::typeKind == TypeKind::BOOLEAN) {
+      return false;
+    } else {
+      return batchIterationEligibleImpl(
+          std::make_index_sequence<FUNC::num_args>());
+    }
+  }
+
+  template <size_t... Is>
+  constexpr bool static batchIterationEligibleImpl(
+      std::index_sequence<Is...>) {
+    return ([&]() {
+      if constexpr (isVariadicType<arg_at<Is>>::value) {
+        return false;
+      } else {
+        return isArgFlatConstantFastPathEligible<Is> &&
+            SimpleTypeTrait<arg_at<Is>>::isFixedWidth;
+      }
+    }() && ...);
+  }
+
   /// When true, a fast path for each possible combination of encodings will be
   /// used for reading arguments when all arguments are flat or constant
   /// primitivies.
@@ -361,6 +387,20 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    // Compute all rows with a single callBatch() if the inputs are flat and
+    // null-free.
+    if constexpr (batchIterationEligible()) {
+      if (canApplyBatch(
+              rows, args, std::make_index_sequence<FUNC::num_args>())) {
+        applyBatch(
+            applyContext, args, std::make_index_sequence<FUNC::num_args>());
+        if (isResultReused) {
+          result = std::move(*reusableResult);
+        }
+        return;
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
     if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
@@ -468,6 +508,32 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Returns true if 'rows' is a contiguous range starting at row 0 and all
+  // arguments are flat vectors without nulls.
+  template <size_t... Is>
+  bool canApplyBatch(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    return rows.isAllSelected() &&
+        ((args[Is]->isFlatEncoding() && !args[Is]->mayHaveNulls()) && ...);
+  }
+
+  // Computes the results for all rows with a single call to callBatch(). Nulls
+  // of the result have already been cleared.
+  template <size_t... Is>
+  void applyBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    (*fn_).callBatch(
+        folly::Range<T*>(
+            applyContext.resultWriter.data_, applyContext.rows->end()),
+        args[Is]
+            ->template asUnchecked<FlatVector<exec_arg_at<Is>>>()
+            ->rawValues()...);
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
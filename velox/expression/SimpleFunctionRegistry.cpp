@@ -64,6 +64,7 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
 
     functions.emplace_back(
         std::make_unique<const FunctionEntry>(metadata, factory));
+    resolutions_.clear();
     return true;
   });
 }
@@ -151,6 +152,13 @@ SimpleFunctionRegistry::resolveFunction(
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
   registeredFunctions_.withRLock([&](const auto& map) {
+    if (auto resolved = resolutions_.get(name, argTypes)) {
+      if (resolved->has_value()) {
+        std::tie(selectedCandidate, selectedCandidateType) =
+            resolved->value();
+      }
+      return;
+    }
     if (const auto* signatureMap = getSignatureMap(name, map)) {
       for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
         SignatureBinder binder(candidateSignature, argTypes);
@@ -190,6 +198,12 @@ SimpleFunctionRegistry::resolveFunction(
         }
       }
     }
+
+    std::optional<std::pair<const FunctionEntry*, TypePtr>> resolved;
+    if (selectedCandidate) {
+      resolved = std::make_pair(selectedCandidate, selectedCandidateType);
+    }
+    resolutions_.put(name, argTypes, std::move(resolved));
   });
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/core/SimpleFunctionMetadata.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
 #include "velox/type/Type.h"
@@ -104,7 +105,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolutions_.clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -167,6 +171,13 @@ class SimpleFunctionRegistry {
       bool overwrite);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // The function entries and return types resolved for a name and argument
+  // types, std::nullopt if no function matches. Accessed under the lock of
+  // 'registeredFunctions_' since registration may free the entries.
+  mutable FunctionResolutionCache<
+      std::optional<std::pair<const FunctionEntry*, TypePtr>>>
+      resolutions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
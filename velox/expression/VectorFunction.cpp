@@ -17,6 +17,8 @@
 #include <unordered_map>
 #include "folly/Singleton.h"
 #include "folly/Synchronized.h"
+#include "folly/container/F14Map.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
@@ -55,6 +57,20 @@ std::vector<VectorFunctionArg> toVectorFunctionArgs(
 
   return args;
 }
+
+// The entry of a vector function whose signature binds to the argument types.
+struct ResolvedVectorFunction {
+  VectorFunctionFactory factory;
+  VectorFunctionMetadata metadata;
+};
+
+// Resolutions by sanitized name and argument types. std::nullopt if no
+// signature binds.
+FunctionResolutionCache<std::optional<ResolvedVectorFunction>>&
+resolvedVectorFunctions() {
+  static FunctionResolutionCache<std::optional<ResolvedVectorFunction>> cache;
+  return cache;
+}
 } // namespace
 
 VectorFunctionMap& vectorFunctionFactories() {
@@ -62,6 +78,11 @@ VectorFunctionMap& vectorFunctionFactories() {
   return factories;
 }
 
+void clearVectorFunctionResolutionCache() {
+  vectorFunctionFactories().withWLock(
+      [](auto& /*functions*/) { resolvedVectorFunctions().clear(); });
+}
+
 std::optional<std::vector<FunctionSignaturePtr>> getVectorFunctionSignatures(
     const std::string& name) {
   return applyToVectorFunctionEntry<std::vector<FunctionSignaturePtr>>(
@@ -123,25 +144,37 @@ getVectorFunctionWithMetadata(
     VELOX_CHECK_EQ(inputTypes.size(), constantInputs.size());
   }
 
-  return applyToVectorFunctionEntry<
-      std::pair<std::shared_ptr<VectorFunction>, VectorFunctionMetadata>>(
-      name,
-      [&](const auto& sanitizedName, const auto& entry)
-          -> std::optional<std::pair<
-              std::shared_ptr<VectorFunction>,
-              VectorFunctionMetadata>> {
-        for (const auto& signature : entry.signatures) {
+  const auto sanitizedName = sanitizeName(name);
+  auto function = vectorFunctionFactories().withRLock(
+      [&](auto& functions) -> std::optional<ResolvedVectorFunction> {
+        auto it = functions.find(sanitizedName);
+        if (it == functions.end()) {
+          return std::nullopt;
+        }
+        auto& cache = resolvedVectorFunctions();
+        if (auto resolved = cache.get(sanitizedName, inputTypes)) {
+          return std::move(resolved.value());
+        }
+        std::optional<ResolvedVectorFunction> resolved;
+        for (const auto& signature : it->second.signatures) {
           exec::SignatureBinder binder(*signature, inputTypes);
           if (binder.tryBind()) {
-            auto inputArgs = toVectorFunctionArgs(inputTypes, constantInputs);
-
-            return {
-                {entry.factory(sanitizedName, inputArgs, config),
-                 entry.metadata}};
+            resolved =
+                ResolvedVectorFunction{it->second.factory, it->second.metadata};
+            break;
           }
         }
-        return std::nullopt;
+        cache.put(sanitizedName, inputTypes, resolved);
+        return resolved;
       });
+
+  if (!function.has_value()) {
+    return std::nullopt;
+  }
+  auto inputArgs = toVectorFunctionArgs(inputTypes, constantInputs);
+  return {
+      {function->factory(sanitizedName, inputArgs, config),
+       function->metadata}};
 }
 
 /// Registers a new vector function. When overwrite = true, previous functions
@@ -160,6 +193,7 @@ bool registerStatefulVectorFunction(
       // Insert/overwrite.
       functionMap[sanitizedName] = {
           std::move(signatures), std::move(factory), std::move(metadata)};
+      resolvedVectorFunctions().clear();
     });
     return true;
   }
@@ -168,6 +202,7 @@ bool registerStatefulVectorFunction(
     auto [iterator, inserted] = functionMap.insert(
         {sanitizedName,
          {std::move(signatures), std::move(factory), std::move(metadata)}});
+    resolvedVectorFunctions().clear();
     return inserted;
   });
 }
@@ -197,4 +232,155 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::vector<ExpressionSetRewrite>& expressionSetRewrites() {
+  static std::vector<ExpressionSetRewrite> rewrites;
+  return rewrites;
+}
+
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite) {
+  expressionSetRewrites().emplace_back(rewrite);
+}
+
+namespace {
+
+struct ITypedExprHasher {
+  size_t operator()(const core::ITypedExpr* expr) const {
+    return expr->hash();
+  }
+};
+
+struct ITypedExprComparer {
+  bool operator()(const core::ITypedExpr* lhs, const core::ITypedExpr* rhs)
+      const {
+    return *lhs == *rhs;
+  }
+};
+
+// Distinct keys of the calls on one input and the call that fuses them.
+struct FusableCalls {
+  core::TypedExprPtr input;
+  std::vector<std::string> keys;
+  core::TypedExprPtr fused;
+};
+
+using FusableCallsMap = folly::F14FastMap<
+    const core::ITypedExpr*,
+    FusableCalls,
+    ITypedExprHasher,
+    ITypedExprComparer>;
+
+std::optional<std::string> fusableKey(
+    const core::TypedExprPtr& expr,
+    const FusableCallKey& callKey) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->inputs().empty()) {
+    return std::nullopt;
+  }
+  return callKey(*call);
+}
+
+void collectFusableCalls(
+    const core::TypedExprPtr& expr,
+    const FusableCallKey& callKey,
+    FusableCallsMap& calls) {
+  if (core::TypedExprs::isLambda(expr)) {
+    return;
+  }
+  if (auto key = fusableKey(expr, callKey)) {
+    const auto& input = expr->inputs()[0];
+    auto& entry = calls[input.get()];
+    if (entry.input == nullptr) {
+      entry.input = input;
+    }
+    if (std::find(entry.keys.begin(), entry.keys.end(), *key) ==
+        entry.keys.end()) {
+      entry.keys.push_back(std::move(*key));
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectFusableCalls(input, callKey, calls);
+  }
+}
+
+core::TypedExprPtr replaceFusableCalls(
+    const core::TypedExprPtr& expr,
+    const FusableCallKey& callKey,
+    const FusableCallsMap& calls) {
+  if (core::TypedExprs::isLambda(expr)) {
+    return expr;
+  }
+  if (auto key = fusableKey(expr, callKey)) {
+    auto it = calls.find(expr->inputs()[0].get());
+    if (it != calls.end() && it->second.fused != nullptr) {
+      const auto& keys = it->second.keys;
+      const auto index =
+          std::find(keys.begin(), keys.end(), *key) - keys.begin();
+      return std::make_shared<core::DereferenceTypedExpr>(
+          expr->type(), it->second.fused, index);
+    }
+  }
+
+  bool changed = false;
+  std::vector<core::TypedExprPtr> newInputs;
+  newInputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    newInputs.push_back(replaceFusableCalls(input, callKey, calls));
+    changed |= newInputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  auto copy = core::TypedExprs::withInputs(expr, std::move(newInputs));
+  return copy ? copy : expr;
+}
+
+} // namespace
+
+std::vector<core::TypedExprPtr> fuseCalls(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const FusableCallKey& callKey,
+    const FusedCallFactory& makeFusedCall) {
+  FusableCallsMap calls;
+  for (const auto& expr : exprs) {
+    collectFusableCalls(expr, callKey, calls);
+  }
+
+  bool fused = false;
+  for (auto& [_, entry] : calls) {
+    if (entry.keys.size() < 2) {
+      continue;
+    }
+    entry.fused = makeFusedCall(entry.input, entry.keys);
+    fused = true;
+  }
+  if (!fused) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(replaceFusableCalls(expr, callKey, calls));
+  }
+  return rewritten;
+}
+
+std::optional<std::string> constantString(const core::TypedExprPtr& expr) {
+  auto constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || constant->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    const auto& vector = constant->valueVector();
+    if (vector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    return vector->as<SimpleVector<StringView>>()->valueAt(0).str();
+  }
+  if (constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
 } // namespace facebook::velox::exec
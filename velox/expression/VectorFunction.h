@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
 #include <vector>
 #include "velox/core/Expressions.h"
 #include "velox/expression/EvalCtx.h"
@@ -241,6 +243,11 @@ using VectorFunctionMap =
 
 VectorFunctionMap& vectorFunctionFactories();
 
+// Clears the cache of the vector functions resolved by
+// getVectorFunctionWithMetadata(). The register functions clear it. Code that
+// changes vectorFunctionFactories() directly must call this afterwards.
+void clearVectorFunctionResolutionCache();
+
 // A template to simplify making VectorFunctionFactory for a function that has a
 // constructor that takes inputTypes and constantInputs
 //
@@ -285,6 +292,46 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all expressions of an ExprSet and returns equivalent
+/// expressions, e.g. with calls that share work across expressions combined.
+/// Returns an empty vector if re-write is not possible.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered ExprSet re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. ExprSet re-writes are
+/// applied in the order they were registered before the expressions are
+/// compiled. Each re-write sees the result of the previous one.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
+/// Returns the key of 'call' if it can be fused with other calls of the same
+/// kind on the same first input, e.g. the path of json_extract_scalar(c0,
+/// '$.a'). Returns std::nullopt if 'call' cannot be fused.
+using FusableCallKey =
+    std::function<std::optional<std::string>(const core::CallTypedExpr& call)>;
+
+/// Returns a call that computes the calls with 'keys' on 'input' at once. The
+/// call must return a ROW with one field per key, in the order of 'keys'.
+using FusedCallFactory = std::function<core::TypedExprPtr(
+    const core::TypedExprPtr& input,
+    const std::vector<std::string>& keys)>;
+
+/// Helper for ExprSet re-writes. Replaces calls 'callKey' returns a key for
+/// with a dereference of a single call made by 'makeFusedCall' for each input
+/// that has more than one distinct key. Calls are grouped by their first
+/// input. Doesn't look into lambdas. Returns an empty vector if no calls were
+/// fused.
+std::vector<core::TypedExprPtr> fuseCalls(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const FusableCallKey& callKey,
+    const FusedCallFactory& makeFusedCall);
+
+/// Returns the value of 'expr' if it is a non-null VARCHAR constant. Returns
+/// std::nullopt otherwise.
+std::optional<std::string> constantString(const core::TypedExprPtr& expr);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
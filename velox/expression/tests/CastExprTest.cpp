@@ -852,6 +852,47 @@ TEST_F(CastExprTest, date) {
       DATE());
 }
 
+TEST_F(CastExprTest, canonicalStrings) {
+  // Canonical strings take a fast path. Values that do not fit the target
+  // type, and strings in any other form, fall back to the generic cast.
+  testCast<std::string, int8_t>(
+      "tinyint", {"0", "-0", "127", "-128", "007"}, {0, 0, 127, -128, 7});
+  testTryCast<std::string, int8_t>(
+      "tinyint",
+      {"128", "-129", "1-"},
+      {std::nullopt, std::nullopt, std::nullopt});
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"123456789012345678",
+       "-123456789012345678",
+       "9223372036854775807",
+       "-9223372036854775808"},
+      {123456789012345678,
+       -123456789012345678,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min()});
+  testTryCast<std::string, int32_t>(
+      "integer", {"1234567890123", "2147483647"}, {std::nullopt, 2147483647});
+
+  testCast<std::string, double>(
+      "double",
+      {"0", "-1.5", "0.1", "123456.789", "999999999999999", "1e3"},
+      {0.0, -1.5, 0.1, 123456.789, 999999999999999.0, 1000.0});
+
+  testCast<std::string, int32_t>(
+      "date",
+      {"1970-01-01", "2020-02-29", "1969-12-27"},
+      {0, 18321, -5},
+      VARCHAR(),
+      DATE());
+  testTryCast<std::string, int32_t>(
+      "date",
+      {"2023-02-29", "2023-13-01", "2023-1x-01"},
+      {std::nullopt, std::nullopt, std::nullopt},
+      VARCHAR(),
+      DATE());
+}
+
 TEST_F(CastExprTest, invalidDate) {
   testInvalidCast<int8_t>(
       "date", {12}, "Cast from TINYINT to DATE is not supported", TINYINT());
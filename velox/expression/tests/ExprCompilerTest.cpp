@@ -17,6 +17,8 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FunctionResolutionCache.h"
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 #include "velox/parse/Expressions.h"
@@ -333,4 +335,64 @@ TEST_F(ExprCompilerTest, lambdaExpr) {
   ASSERT_EQ(distinctFields.size(), 2);
 }
 
+TEST_F(ExprCompilerTest, functionResolutionCache) {
+  FunctionResolutionCache<int32_t> cache(2);
+  cache.put("f", {BIGINT()}, 1);
+  cache.put("f", {ROW({"a"}, {BIGINT()})}, 2);
+  ASSERT_EQ(1, cache.get("f", {BIGINT()}).value());
+  ASSERT_EQ(2, cache.get("f", {ROW({"a"}, {BIGINT()})}).value());
+  // Row field names are part of the key.
+  ASSERT_FALSE(cache.get("f", {ROW({"b"}, {BIGINT()})}).has_value());
+  ASSERT_FALSE(cache.get("g", {BIGINT()}).has_value());
+
+  // The least recently used entry is evicted.
+  ASSERT_EQ(1, cache.get("f", {BIGINT()}).value());
+  cache.put("f", {VARCHAR()}, 3);
+  ASSERT_EQ(2, cache.size());
+  ASSERT_EQ(1, cache.get("f", {BIGINT()}).value());
+  ASSERT_EQ(3, cache.get("f", {VARCHAR()}).value());
+  ASSERT_FALSE(cache.get("f", {ROW({"a"}, {BIGINT()})}).has_value());
+
+  cache.clear();
+  ASSERT_EQ(0, cache.size());
+}
+
+TEST_F(ExprCompilerTest, reregisteredFunctionIsResolved) {
+  class TestFunction : public VectorFunction {
+   public:
+    void apply(
+        const SelectivityVector& /*rows*/,
+        std::vector<VectorPtr>& /*args*/,
+        const TypePtr& /*outputType*/,
+        EvalCtx& /*context*/,
+        VectorPtr& /*result*/) const override {}
+  };
+
+  const auto signatures = std::vector<FunctionSignaturePtr>{
+      FunctionSignatureBuilder()
+          .returnType("bigint")
+          .argumentType("bigint")
+          .build()};
+  const core::QueryConfig config({});
+  auto resolve = [&]() {
+    return getVectorFunction("resolution_cache_test", {BIGINT()}, {}, config);
+  };
+
+  auto first = std::make_unique<TestFunction>();
+  const auto* firstPtr = first.get();
+  registerVectorFunction(
+      "resolution_cache_test", signatures, std::move(first), {}, true);
+  ASSERT_EQ(firstPtr, resolve().get());
+  ASSERT_EQ(firstPtr, resolve().get());
+  ASSERT_EQ(
+      nullptr,
+      getVectorFunction("resolution_cache_test", {VARCHAR()}, {}, config));
+
+  auto second = std::make_unique<TestFunction>();
+  const auto* secondPtr = second.get();
+  registerVectorFunction(
+      "resolution_cache_test", signatures, std::move(second), {}, true);
+  ASSERT_EQ(secondPtr, resolve().get());
+}
+
 } // namespace facebook::velox::exec::test
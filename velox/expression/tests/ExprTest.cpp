@@ -37,6 +37,7 @@
 #include "velox/parse/Expressions.h"
 #include "velox/parse/ExpressionsParser.h"
 #include "velox/parse/TypeResolver.h"
+#include "velox/vector/FunctionVector.h"
 #include "velox/vector/SelectivityVector.h"
 #include "velox/vector/VectorSaver.h"
 #include "velox/vector/tests/TestingAlwaysThrowsFunction.h"
@@ -474,6 +475,47 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+// Verifies that conjuncts with the same text share their selectivity within a
+// query and that the selectivity decays.
+TEST_P(ParameterizedExprTest, reorderSharedSelectivity) {
+  constexpr int32_t kTestSize = 20'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; })});
+  const std::string expression = "if (c0 % 409 < 300 and c0 % 103 < 30, 1, 2)";
+  auto getCondition = [](const auto& exprSet) {
+    return std::dynamic_pointer_cast<exec::ConjunctExpr>(
+        exprSet->expr(0)->inputs()[0]);
+  };
+
+  auto exprSet = compileExpression(expression, asRowType(data->type()));
+  evaluate(exprSet.get(), data);
+
+  // A second instance of the expression, e.g. in another driver, starts with
+  // the selectivity measured by the first one.
+  auto otherExprSet = compileExpression(expression, asRowType(data->type()));
+  auto smallData = makeRowVector(
+      {makeFlatVector<int64_t>(10, [](auto row) { return row; })});
+  evaluate(otherExprSet.get(), smallData);
+  auto condition = getCondition(exprSet);
+  auto otherCondition = getCondition(otherExprSet);
+  uint64_t maxNumIn = 0;
+  for (auto i = 0; i < otherCondition->inputs().size(); ++i) {
+    maxNumIn = std::max(maxNumIn, otherCondition->selectivityAt(i).numIn());
+  }
+  ASSERT_GE(maxNumIn, static_cast<uint64_t>(kTestSize));
+
+  // Older measurements decay.
+  uint64_t numRows = kTestSize + 10;
+  while (numRows < 2 * SharedSelectivity::kDefaultDecayRows) {
+    evaluate(exprSet.get(), data);
+    numRows += kTestSize;
+  }
+  for (auto i = 0; i < condition->inputs().size(); ++i) {
+    EXPECT_LT(condition->selectivityAt(i).numIn(), numRows);
+  }
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -4316,6 +4358,241 @@ TEST_F(ExprTest, commonSubExpressionWithPeeling) {
   }
 }
 
+TEST_F(ExprTest, commutativeCommonSubExpression) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto exprSet =
+      compileMultiple({"c0 + c1", "c1 + c0", "c0 * c1 = c1 * c0"}, rowType);
+  ASSERT_EQ(exprSet->expr(0), exprSet->expr(1));
+  ASSERT_TRUE(exprSet->expr(0)->isMultiplyReferenced());
+  const auto& eq = exprSet->expr(2);
+  ASSERT_EQ(eq->inputs()[0], eq->inputs()[1]);
+
+  // Arguments of non-commutative functions are not swapped.
+  exprSet = compileMultiple({"c0 - c1", "c1 - c0"}, rowType);
+  ASSERT_NE(exprSet->expr(0), exprSet->expr(1));
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<int64_t>({10, 20, 30}),
+  });
+  auto results = evaluateMultiple({"c0 + c1", "c1 + c0"}, data);
+  assertEqualVectors(makeFlatVector<int64_t>({11, 22, 33}), results[0]);
+  assertEqualVectors(results[0], results[1]);
+}
+
+TEST_F(ExprTest, hoistLambdaInvariants) {
+  registerFunction<DefaultNullFunc, int64_t, int64_t, int64_t>(
+      {"default_null"});
+
+  auto queryCtx = core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(std::unordered_map<std::string, std::string>{
+          {core::QueryConfig::kExprHoistLambdaInvariants, "true"}}));
+  core::ExecCtx execCtx(pool_.get(), queryCtx.get());
+  auto evaluateHoisted = [&](const std::string& text,
+                             const RowVectorPtr& input) {
+    totalDefaultNullFunc = 0;
+    exec::ExprSet hoisted(
+        {parseExpression(text, asRowType(input->type()))}, &execCtx);
+    exec::EvalCtx context(&execCtx, &hoisted, input.get());
+    std::vector<VectorPtr> results(1);
+    hoisted.eval(SelectivityVector(input->size()), context, results);
+    return results[0];
+  };
+
+  auto data = makeRowVector({
+      makeArrayVector<int64_t>({{1, 2, 3}, {}, {4, 5}, {6}}),
+      makeFlatVector<int64_t>({10, 20, 30, 40}),
+      makeFlatVector<int64_t>({1, 0, 2, 5}),
+  });
+
+  // default_null(c1, 2) is evaluated once for each row with elements.
+  auto result =
+      evaluateHoisted("transform(c0, x -> x + default_null(c1, 2))", data);
+  assertEqualVectors(
+      makeArrayVector<int64_t>({{13, 14, 15}, {}, {36, 37}, {48}}), result);
+  EXPECT_EQ(totalDefaultNullFunc, 3);
+  totalDefaultNullFunc = 0;
+  assertEqualVectors(
+      evaluate("transform(c0, x -> x + default_null(c1, 2))", data), result);
+  EXPECT_EQ(totalDefaultNullFunc, 6);
+
+  // Invariants are not evaluated for rows without elements, so 10 / c2 does
+  // not fail for row 1.
+  result = evaluateHoisted("transform(c0, x -> x * (10 / c2))", data);
+  assertEqualVectors(
+      makeArrayVector<int64_t>({{10, 20, 30}, {}, {20, 25}, {12}}), result);
+
+  // A failing invariant falls back to per-element evaluation, which reports
+  // the error for the failing row only.
+  data = makeRowVector({
+      makeArrayVector<int64_t>({{1, 2, 3}, {}, {4, 5}, {6}}),
+      makeFlatVector<int64_t>({1, 0, 2, 0}),
+  });
+  VELOX_ASSERT_THROW(
+      evaluateHoisted("transform(c0, x -> x * (10 / c1))", data),
+      "division by zero");
+  result = evaluateHoisted("try(transform(c0, x -> x * (10 / c1)))", data);
+  using Elements = std::vector<std::optional<int64_t>>;
+  auto expected = makeNullableArrayVector<int64_t>(
+      {Elements{10, 20, 30}, Elements{}, Elements{20, 25}, std::nullopt});
+  assertEqualVectors(expected, result);
+
+  // Subexpressions that depend on the lambda parameters stay in place.
+  result = evaluateHoisted("transform(c0, x -> if(x > 3, x * c1, 0))", data);
+  assertEqualVectors(
+      makeArrayVector<int64_t>({{0, 0, 0}, {}, {8, 10}, {0}}), result);
+}
+
+TEST_F(ExprTest, lambdaCallableReuse) {
+  // Reduce applies the lambda once per array position. The row of arguments
+  // and captures is reused across positions and must not hold on to the
+  // state of the previous position.
+  auto data = makeRowVector({
+      makeArrayVector<int64_t>({{1, 2, 3}, {}, {4, 5}, {6, 7, 8, 9}}),
+      makeFlatVector<int64_t>({10, 20, 30, 40}),
+  });
+  auto result = evaluate(
+      "reduce(c0, c1, (s, x) -> s * 2 + x * c1, s -> s + c1)", data);
+  assertEqualVectors(makeFlatVector<int64_t>({200, 40, 540, 4'720}), result);
+
+  // The captures are released with the result of the lambda once the
+  // evaluation is done, although the ExprSet stays.
+  auto captured = makeFlatVector<int64_t>({1, 2, 3, 4});
+  auto input = makeRowVector({data->childAt(0), captured});
+  auto exprSet = compileExpression(
+      "transform(c0, x -> x + c1)", asRowType(input->type()));
+  result = evaluate(exprSet.get(), input);
+  assertEqualVectors(
+      makeArrayVector<int64_t>({{2, 3, 4}, {}, {7, 8}, {10, 11, 12, 13}}),
+      result);
+  input.reset();
+  ASSERT_EQ(1, captured.use_count());
+
+  // The callable is reused for the next batch only once no result of an
+  // earlier batch references it.
+  exec::ExprSet lambdaSet(
+      {parseExpression("x -> x * c0", ROW({"c0"}, {BIGINT()}), {BIGINT()})},
+      execCtx_.get());
+  auto evaluateLambda = [&](const RowVectorPtr& batch) {
+    exec::EvalCtx context(execCtx_.get(), &lambdaSet, batch.get());
+    std::vector<VectorPtr> results(1);
+    lambdaSet.eval(SelectivityVector(batch->size()), context, results);
+    return results[0];
+  };
+  auto callableOf = [](const VectorPtr& functions) {
+    SelectivityVector rows(functions->size());
+    return functions->asUnchecked<FunctionVector>()->iterator(&rows).next()
+        .callable;
+  };
+  auto arg = makeFlatVector<int64_t>({1, 2, 3});
+  auto applyLambda = [&](const VectorPtr& functions,
+                         const RowVectorPtr& batch) {
+    exec::EvalCtx context(execCtx_.get(), &lambdaSet, batch.get());
+    SelectivityVector rows(arg->size());
+    VectorPtr applied;
+    auto it = functions->asUnchecked<FunctionVector>()->iterator(&rows);
+    while (auto entry = it.next()) {
+      entry.callable->apply(
+          *entry.rows, nullptr, nullptr, &context, {arg}, nullptr, &applied);
+    }
+    return applied;
+  };
+  auto batch1 = makeRowVector({makeFlatVector<int64_t>({10, 20, 30})});
+  auto batch2 = makeRowVector({makeFlatVector<int64_t>({100, 200, 300})});
+
+  auto functions1 = evaluateLambda(batch1);
+  auto functions2 = evaluateLambda(batch2);
+  ASSERT_NE(callableOf(functions1), callableOf(functions2));
+  assertEqualVectors(
+      makeFlatVector<int64_t>({10, 40, 90}), applyLambda(functions1, batch1));
+  assertEqualVectors(
+      makeFlatVector<int64_t>({100, 400, 900}),
+      applyLambda(functions2, batch2));
+
+  auto* callable2 = callableOf(functions2);
+  functions1.reset();
+  functions2.reset();
+  auto functions3 = evaluateLambda(batch1);
+  ASSERT_EQ(callable2, callableOf(functions3));
+  assertEqualVectors(
+      makeFlatVector<int64_t>({10, 40, 90}), applyLambda(functions3, batch1));
+}
+
+int totalCountingLengthFunc = 0;
+template <typename T>
+struct CountingLengthFunc {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, const arg_type<Varchar>& input) {
+    totalCountingLengthFunc++;
+    VELOX_USER_CHECK(!input.empty(), "Empty input");
+    out = input.size();
+  }
+};
+
+TEST_F(ExprTest, cacheDistinctInputs) {
+  registerFunction<CountingLengthFunc, int64_t, Varchar>({"counting_length"});
+
+  auto queryCtx = core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(std::unordered_map<std::string, std::string>{
+          {core::QueryConfig::kExprCacheDistinctInputs, "true"}}));
+  core::ExecCtx execCtx(pool_.get(), queryCtx.get());
+  auto evaluateCached = [&](const std::string& text,
+                            const RowVectorPtr& input) {
+    totalCountingLengthFunc = 0;
+    exec::ExprSet exprSet(
+        {parseExpression(text, asRowType(input->type()))}, &execCtx);
+    exec::EvalCtx context(&execCtx, &exprSet, input.get());
+    std::vector<VectorPtr> results(1);
+    exprSet.eval(SelectivityVector(input->size()), context, results);
+    return results[0];
+  };
+
+  const vector_size_t size = 1'000;
+  auto host = [](auto row) {
+    return fmt::format("www.example-host-{}.com", row % 10);
+  };
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(size, host),
+      makeFlatVector<std::string>(
+          size, [](auto row) { return fmt::format("unique-{}", row); }),
+      makeFlatVector<std::string>(size, [&](auto row) {
+        return row % 10 == 0 ? std::string() : host(row);
+      }),
+  });
+
+  // Each of the 10 distinct values is computed once.
+  auto result = evaluateCached("counting_length(c0)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [&](auto row) { return host(row).size(); }),
+      result);
+  EXPECT_EQ(totalCountingLengthFunc, 10);
+
+  // Distinct values are not cached.
+  result = evaluateCached("counting_length(c1)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return fmt::format("unique-{}", row).size(); }),
+      result);
+  EXPECT_EQ(totalCountingLengthFunc, size);
+
+  // Errors are reported for all rows with a failing value.
+  VELOX_ASSERT_THROW(
+      evaluateCached("counting_length(c2)", data), "Empty input");
+  result = evaluateCached("try(counting_length(c2))", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size,
+          [&](auto row) { return host(row).size(); },
+          [](auto row) { return row % 10 == 0; }),
+      result);
+  EXPECT_EQ(totalCountingLengthFunc, 10);
+}
+
 TEST_P(ParameterizedExprTest, dictionaryOverLoadedLazy) {
   // This test verifies a corner case where peeling does not go past a loaded
   // lazy layer which caused wrong set of inputs being passed to shared
@@ -4503,13 +4780,21 @@ TEST_P(ParameterizedExprTest, extractSubfields) {
   validate("c0[1].c0c1['foo'] > 0", {"c0[1].c0c1[\"foo\"]"});
   validate("c0[1].c0c0[c1[1]] > 0", {"c0[1].c0c0", "c1[1]"});
   validate("element_at(c1, -1)", {"c1"});
-  validate("transform(c0, x -> x.c0c0[0] + c1[1])", {"c0", "c1[1]"});
-  validate("transform(c0, c1 -> c1.c0c0[0])", {"c0"});
+  validate(
+      "transform(c0, x -> x.c0c0[0] + c1[1])", {"c0[*].c0c0[0]", "c1[1]"});
+  validate("transform(c0, c1 -> c1.c0c0[0])", {"c0[*].c0c0[0]"});
+  validate(
+      "any_match(c0, x -> x.c0c1['foo'] > c3)",
+      {"c0[*].c0c1[\"foo\"]", "c3"});
+  validate("transform(c1, x -> 1)", {"c1"});
+  validate("transform(c2[1], x -> x + 1)", {"c2[1][*]"});
+  // filter() returns the elements, so all their fields are needed.
+  validate("filter(c0, x -> cardinality(x.c0c0) > 0)", {"c0"});
   validate("reduce(c1, 0, (c0, c3) -> c0 + c3, c2 -> c2)", {"c1"});
   validate("reduce(c1, 0, (c0, c3) -> c0 + c3, c2 -> c2) + c3", {"c1", "c3"});
   validate(
       "transform(c2, c0 -> reduce(c0, 0, (c0, c2) -> c0 + c2, c0 -> c0 + c1[1]) + c0[1])",
-      {"c1[1]", "c2"});
+      {"c1[1]", "c2[*]", "c2[*][1]"});
 }
 auto makeRow = [](const std::string& fieldName) {
   return fmt::format(
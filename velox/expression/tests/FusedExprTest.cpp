@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedExpr.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+namespace facebook::velox::exec {
+namespace {
+
+class FusedExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void SetUp() override {
+    FunctionBaseTest::SetUp();
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFuseKernels, "true"},
+    });
+  }
+
+  std::unique_ptr<ExprSet> compile(
+      const std::string& expression,
+      const RowTypePtr& rowType) {
+    return std::make_unique<ExprSet>(
+        std::vector<core::TypedExprPtr>{makeTypedExpr(expression, rowType)},
+        &execCtx_);
+  }
+
+  bool isFused(const std::string& expression, const RowTypePtr& rowType) {
+    return compile(expression, rowType)->expr(0)->is<FusedExpr>();
+  }
+};
+
+TEST_F(FusedExprTest, arithmetic) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 7 - 3; }, nullEvery(5)),
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 3; }),
+  });
+  auto rowType = asRowType(data->type());
+
+  ASSERT_TRUE(isFused("c0 * c1 + c2", rowType));
+  auto result = evaluate("c0 * c1 + c2", data);
+  auto expected = makeFlatVector<int64_t>(
+      size,
+      [](auto row) { return row * (row % 7 - 3) + row * 3; },
+      nullEvery(5));
+  assertEqualVectors(expected, result);
+
+  // Constants and repeated inputs.
+  ASSERT_TRUE(isFused("(c0 - 10) * c0 - c2 * 2", rowType));
+  result = evaluate("(c0 - 10) * c0 - c2 * 2", data);
+  expected = makeFlatVector<int64_t>(
+      size, [](auto row) { return (row - 10) * row - row * 6; });
+  assertEqualVectors(expected, result);
+
+  // Dictionary-encoded inputs.
+  auto indices = makeIndicesInReverse(size);
+  auto dictionaryData = makeRowVector({
+      wrapInDictionary(indices, size, data->childAt(0)),
+      wrapInDictionary(indices, size, data->childAt(1)),
+      data->childAt(2),
+  });
+  result = evaluate("c0 * c1 + c2", dictionaryData);
+  expected = makeFlatVector<int64_t>(
+      size,
+      [&](auto row) {
+        const auto index = size - 1 - row;
+        return index * (index % 7 - 3) + row * 3;
+      },
+      [&](auto row) { return (size - 1 - row) % 5 == 0; });
+  assertEqualVectors(expected, result);
+
+  // A single call is not fused.
+  ASSERT_FALSE(isFused("c0 + c1", rowType));
+
+  auto doubleData = makeRowVector({
+      makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+      makeFlatVector<double>(size, [](auto row) { return row % 3 - 1.5; }),
+  });
+  ASSERT_TRUE(isFused("c0 * c1 - c0", asRowType(doubleData->type())));
+  result = evaluate("c0 * c1 - c0", doubleData);
+  auto expectedDoubles = makeFlatVector<double>(size, [](auto row) {
+    return row * 0.5 * (row % 3 - 1.5) - row * 0.5;
+  });
+  assertEqualVectors(expectedDoubles, result);
+}
+
+TEST_F(FusedExprTest, comparison) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row % 11; }, nullEvery(7)),
+      makeFlatVector<int32_t>(size, [](auto row) { return size - row; }),
+  });
+  auto rowType = asRowType(data->type());
+
+  ASSERT_TRUE(isFused("c0 + c1 < c2 - c1", rowType));
+  auto result = evaluate("c0 + c1 < c2 - c1", data);
+  auto expected = makeFlatVector<bool>(
+      size,
+      [](auto row) { return row + row % 11 < size - row - row % 11; },
+      nullEvery(7));
+  assertEqualVectors(expected, result);
+
+  // Comparisons are only fused at the root.
+  ASSERT_FALSE(isFused("c0 + c1 < c2 and c0 > c1 * c2", rowType));
+  result = evaluate("c0 + c1 < c2 and c0 > c1 * c2", data);
+  expected = makeFlatVector<bool>(
+      size,
+      [](auto row) {
+        return row + row % 11 < size - row &&
+            row > (row % 11) * (size - row);
+      },
+      nullEvery(7));
+  assertEqualVectors(expected, result);
+}
+
+TEST_F(FusedExprTest, overflow) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, std::numeric_limits<int64_t>::max(), 3}),
+      makeFlatVector<int64_t>({2, 2, 2}),
+  });
+  ASSERT_TRUE(isFused("c0 * c1 + 1", asRowType(data->type())));
+
+  VELOX_ASSERT_THROW(evaluate("c0 * c1 + 1", data), "overflow");
+
+  auto result = evaluate("try(c0 * c1 + 1)", data);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({3, std::nullopt, 7}), result);
+}
+
+TEST_F(FusedExprTest, kernelCache) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto first = compile("c0 * 2 + c1", rowType);
+  auto second = compile("c0 * 3 + c1", rowType);
+  auto third = compile("c0 * (c1 + 2)", rowType);
+
+  const auto& firstKernel = first->expr(0)->as<FusedExpr>()->kernel();
+  const auto& secondKernel = second->expr(0)->as<FusedExpr>()->kernel();
+  const auto& thirdKernel = third->expr(0)->as<FusedExpr>()->kernel();
+  EXPECT_EQ(&firstKernel, &secondKernel);
+  EXPECT_NE(&firstKernel, &thirdKernel);
+  EXPECT_EQ(firstKernel.numInputs(), 3);
+  EXPECT_EQ(firstKernel.instructions().size(), 2);
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -443,6 +443,44 @@ TEST_P(PeeledEncodingBasicTests, intermidiateLazyLayer) {
   assertEqualVectors(peeledVectors[0], flat1, *translatedRows);
 }
 
+TEST_P(PeeledEncodingBasicTests, equalDictionaryIndices) {
+  LocalDecodedVector localDecodedVector(execCtx_);
+  const SelectivityVector& rows = GetParam().rows;
+  // 12. Distinct dictionaries with equal indices and nulls are peeled.
+  //    Input Vectors: Dict1(Complex1), Dict1Copy(Flat1)
+  //    Peeled Vectors: Complex1, Flat1
+  //    Peel: Dict1
+  auto complex = fuzzer->fuzzFlat(MAP(INTEGER(), BIGINT()));
+  DictionaryWrap dictCopy{
+      .indices = AlignedBuffer::copy(pool(), dictWrap1.indices),
+      .nulls = AlignedBuffer::copy(pool(), dictWrap1.nulls),
+      .size = dictWrap1.size};
+  auto input1 = wrapInDictionaryLayers(complex, {&dictWrap1});
+  auto input2 = wrapInDictionaryLayers(flat1, {&dictCopy});
+  std::vector<VectorPtr> peeledVectors;
+  auto peeledEncoding = PeeledEncoding::peel(
+      {input1, input2}, rows, localDecodedVector, true, peeledVectors);
+  ASSERT_NE(peeledEncoding, nullptr);
+  ASSERT_EQ(peeledVectors.size(), 2);
+  ASSERT_EQ(peeledEncoding->wrapEncoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(peeledVectors[0].get(), complex.get());
+  ASSERT_EQ(peeledVectors[1].get(), flat1.get());
+  assertEqualVectors(
+      input2, peeledEncoding->wrap(flat1->type(), pool(), flat1, rows), rows);
+
+  // A dictionary that differs in one selected row is not peeled.
+  auto* rawIndices = dictCopy.indices->asMutable<vector_size_t>();
+  rawIndices[rows.begin()] = (rawIndices[rows.begin()] + 1) % vectorSize_;
+  if (dictCopy.nulls) {
+    bits::clearNull(dictCopy.nulls->asMutable<uint64_t>(), rows.begin());
+  }
+  input2 = wrapInDictionaryLayers(flat1, {&dictCopy});
+  peeledVectors.clear();
+  peeledEncoding = PeeledEncoding::peel(
+      {input1, input2}, rows, localDecodedVector, true, peeledVectors);
+  ASSERT_EQ(peeledEncoding, nullptr);
+}
+
 TEST_F(PeeledEncodingTest, peelingFails) {
   VectorFuzzer::Options options;
   options.nullRatio = 0.3;
@@ -26,6 +26,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
 #include "velox/functions/Udf.h"
+#include "velox/functions/lib/SimdTransform.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/type/Type.h"
@@ -1145,6 +1146,80 @@ TEST_F(SimpleFunctionTest, callAscii) {
       "get_input_size(c0)", makeRowVector({asciiInput})));
 }
 
+template <typename T>
+struct BatchPlusFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static inline int32_t numCalls{0};
+  static inline int32_t numBatchCalls{0};
+
+  void call(int64_t& out, const int64_t& a, const int64_t& b) {
+    ++numCalls;
+    out = a + b;
+  }
+
+  void callBatch(
+      folly::Range<int64_t*> result,
+      const int64_t* a,
+      const int64_t* b) {
+    ++numBatchCalls;
+    functions::simdTransform(
+        result, [](auto x, auto y) { return x + y; }, a, b);
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  using Function = BatchPlusFunction<exec::VectorExec>;
+  registerFunction<BatchPlusFunction, int64_t, int64_t, int64_t>(
+      {"batch_plus"});
+  auto reset = []() {
+    Function::numCalls = 0;
+    Function::numBatchCalls = 0;
+  };
+
+  // Flat inputs without nulls are computed with a single callBatch().
+  const vector_size_t size = 1'003;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 3; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row; }, nullEvery(7)),
+  });
+  reset();
+  auto result = evaluate("batch_plus(c0, c1)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 4; }), result);
+  EXPECT_EQ(1, Function::numBatchCalls);
+  EXPECT_EQ(0, Function::numCalls);
+
+  // Inputs with nulls and constant inputs are computed row by row.
+  reset();
+  result = evaluate("batch_plus(c0, c2)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 2; }, nullEvery(7)),
+      result);
+  EXPECT_EQ(0, Function::numBatchCalls);
+  EXPECT_EQ(size - (size + 6) / 7, Function::numCalls);
+
+  reset();
+  result = evaluate("batch_plus(c0, 5)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row + 5; }), result);
+  EXPECT_EQ(0, Function::numBatchCalls);
+  EXPECT_EQ(size, Function::numCalls);
+
+  // A subset of rows is computed row by row.
+  reset();
+  result = evaluate("if(c0 % 2 = 0, batch_plus(c0, c1), c0)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row % 2 == 0 ? row * 4 : row; }),
+      result);
+  EXPECT_EQ(0, Function::numBatchCalls);
+  EXPECT_EQ((size + 1) / 2, Function::numCalls);
+}
+
 // Return false always.
 template <typename T>
 struct GenericOutputFunc {
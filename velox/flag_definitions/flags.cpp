@@ -100,3 +100,17 @@ DEFINE_bool(
     "exception. This is only used by test to control the test error output size");
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
+
+// Used in exec/SpillFile.cpp
+
+DEFINE_bool(
+    velox_spill_read_mmap,
+    false,
+    "If true, read the spill files on the local file system through mmap "
+    "instead of buffered reads");
+
+DEFINE_bool(
+    velox_spill_zstd_dictionary,
+    false,
+    "If true, the ZSTD compressed spill files are compressed page by page "
+    "with a ZSTD dictionary trained on the first pages of each file");
@@ -74,6 +74,7 @@ void clearFunctionRegistry() {
   exec::mutableSimpleFunctions().clearRegistry();
   exec::vectorFunctionFactories().withWLock(
       [](auto& functionMap) { functionMap.clear(); });
+  exec::clearVectorFunctionResolutionCache();
 }
 
 TypePtr resolveFunction(
@@ -198,6 +198,18 @@ int32_t padContent(
     char* maxResultEnd,
     char* result,
     const bool padFront = true) {
+  if (padFront && padding == '0' && (totalDigits == 1 || totalDigits == 2) &&
+      content >= 0 && content < 100) {
+    // Fast path for the common fields of up to 2 digits, e.g. month or hour.
+    if (content < 10 && totalDigits == 1) {
+      result[0] = char(content + '0');
+      return 1;
+    }
+    result[0] = char(content / 10 + '0');
+    result[1] = char(content % 10 + '0');
+    return 2;
+  }
+
   const bool isNegative = content < 0;
   const auto digitLength =
       isNegative ? countDigits(-(__int128_t)content) : countDigits(content);
@@ -501,31 +513,22 @@ int64_t parseHalfDayOfDay(const char* cur, const char* end, Date& date) {
   }
 }
 
-std::string formatFractionOfSecond(
+// Writes the fraction of second with 'minRepresentDigits' digits to 'result'.
+// Only milliseconds are kept, so digits after the third are zeros. Returns the
+// number of characters written.
+int32_t appendFractionOfSecond(
     uint16_t subseconds,
-    size_t minRepresentDigits) {
-  char toAdd[minRepresentDigits > 3 ? minRepresentDigits + 1 : 4];
-
-  if (subseconds < 10) {
-    toAdd[0] = '0';
-    toAdd[1] = '0';
-    toAdd[2] = char(subseconds + '0');
-  } else if (subseconds < 100) {
-    toAdd[2] = char(subseconds % 10 + '0');
-    toAdd[1] = char((subseconds / 10) % 10 + '0');
-    toAdd[0] = '0';
-  } else {
-    toAdd[2] = char(subseconds % 10 + '0');
-    toAdd[1] = char((subseconds / 10) % 10 + '0');
-    toAdd[0] = char((subseconds / 100) % 10 + '0');
-  }
-
+    size_t minRepresentDigits,
+    char* result) {
+  const char digits[3] = {
+      char((subseconds / 100) % 10 + '0'),
+      char((subseconds / 10) % 10 + '0'),
+      char(subseconds % 10 + '0')};
+  std::memcpy(result, digits, std::min<size_t>(minRepresentDigits, 3));
   if (minRepresentDigits > 3) {
-    memset(toAdd + 3, '0', minRepresentDigits - 3);
+    std::memset(result + 3, '0', minRepresentDigits - 3);
   }
-
-  toAdd[minRepresentDigits] = '\0';
-  return toAdd;
+  return minRepresentDigits;
 }
 
 int32_t appendTimezoneOffset(int64_t offset, char* result) {
@@ -1285,11 +1288,10 @@ int32_t DateTimeFormatter::format(
           break;
 
         case DateTimeFormatSpecifier::FRACTION_OF_SECOND: {
-          const auto& piece = formatFractionOfSecond(
+          result += appendFractionOfSecond(
               durationInTheDay.subseconds().count(),
-              token.pattern.minRepresentDigits);
-          std::memcpy(result, piece.data(), piece.length());
-          result += piece.length();
+              token.pattern.minRepresentDigits,
+              result);
         } break;
 
         case DateTimeFormatSpecifier::TIMEZONE: {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <queue>
 #include <type_traits>
@@ -307,6 +308,47 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  size_t i = 0;
+  if (n_ == 0) {
+    minValue_ = maxValue_ = values[0];
+    i = 1;
+  }
+  for (; i < values.size(); ++i) {
+    minValue_ = std::min(minValue_, values[i], C());
+    maxValue_ = std::max(maxValue_, values[i], C());
+  }
+
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  i = 0;
+  if (items_.size() < k_ && numLevels() == 1) {
+    const auto count = std::min<size_t>(k_ - items_.size(), values.size());
+    items_.insert(items_.end(), values.begin(), values.begin() + count);
+    levels_[1] += count;
+    i = count;
+  }
+  while (i < values.size()) {
+    // Compacts if level zero is full.
+    items_[insertPosition()] = values[i++];
+    // The free slots below level zero are filled in the order doInsert()
+    // would fill them.
+    const auto count = std::min<size_t>(levels_[0], values.size() - i);
+    levels_[0] -= count;
+    std::reverse_copy(
+        values.begin() + i,
+        values.begin() + i + count,
+        items_.begin() + levels_[0]);
+    i += count;
+  }
+  n_ += values.size();
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
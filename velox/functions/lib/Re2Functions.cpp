@@ -14,6 +14,11 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+
+#include <re2/set.h>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/core/Expressions.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -205,6 +210,40 @@ std::string likePatternToRe2(
   return regex;
 }
 
+// Returns the longest run of literal characters in LIKE 'pattern'. Every
+// string that matches 'pattern' contains this run. Returns an empty string if
+// there are no literal characters.
+std::string longestLikeLiteral(
+    std::string_view pattern,
+    std::optional<char> escapeChar) {
+  std::string longest;
+  std::string current;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    auto c = pattern[i];
+    if (c == escapeChar && i + 1 < pattern.size()) {
+      current.push_back(pattern[++i]);
+    } else if (c == '%' || c == '_') {
+      if (current.size() > longest.size()) {
+        longest = current;
+      }
+      current.clear();
+    } else {
+      current.push_back(c);
+    }
+  }
+  return current.size() > longest.size() ? current : longest;
+}
+
+// Returns true if 'input' contains 'literal'. Cheaper than a regular
+// expression match and used to skip it for rows that cannot match.
+FOLLY_ALWAYS_INLINE bool containsLiteral(
+    const StringView& input,
+    std::string_view literal) {
+  return simd::findSubstring(
+             input.data(), input.size(), literal.data(), literal.size()) !=
+      std::string_view::npos;
+}
+
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
@@ -645,9 +684,7 @@ bool matchSuffixPattern(
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return containsLiteral(input, fixedPattern);
 }
 
 // Return true if the input VARCHAR argument is all-ASCII for the specified
@@ -804,7 +841,8 @@ class OptimizedLike final : public exec::VectorFunction {
 // fast path that avoids compiling the regular expression.
 class LikeWithRe2 final : public exec::VectorFunction {
  public:
-  LikeWithRe2(StringView pattern, std::optional<char> escapeChar) {
+  LikeWithRe2(StringView pattern, std::optional<char> escapeChar)
+      : literal_(longestLikeLiteral(std::string_view(pattern), escapeChar)) {
     RE2::Options opt{RE2::Quiet};
     opt.set_dot_nl(true);
     re_.emplace(
@@ -842,15 +880,15 @@ class LikeWithRe2 final : public exec::VectorFunction {
     if (toSearch->isIdentityMapping()) {
       auto rawStrings = toSearch->data<StringView>();
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-        result.set(i, re2FullMatch(rawStrings[i], *re_));
+        result.set(i, match(rawStrings[i]));
       });
       return;
     }
 
     if (toSearch->isConstantMapping()) {
-      bool match = re2FullMatch(toSearch->valueAt<StringView>(0), *re_);
+      bool matchResult = match(toSearch->valueAt<StringView>(0));
       context.applyToSelectedNoThrow(
-          rows, [&](vector_size_t i) { result.set(i, match); });
+          rows, [&](vector_size_t i) { result.set(i, matchResult); });
       return;
     }
 
@@ -861,6 +899,12 @@ class LikeWithRe2 final : public exec::VectorFunction {
   }
 
  private:
+  bool match(const StringView& input) const {
+    return containsLiteral(input, literal_) && re2FullMatch(input, *re_);
+  }
+
+  // The longest literal in the pattern. Rows without it do not match.
+  const std::string literal_;
   std::optional<RE2> re_;
   bool validPattern_;
 };
@@ -1015,6 +1059,146 @@ class LikeGeneric final : public exec::VectorFunction {
       compiledRegularExpressions_;
 };
 
+// Returns true if 'input' matches LIKE pattern 'patternMetadata' of one of the
+// kinds that do not need a regular expression. 'patternMetadata' must not be
+// of kind kGeneric or kRelaxed*.
+template <bool isAscii>
+bool matchOptimizedLike(
+    const StringView& input,
+    const PatternMetadata& patternMetadata) {
+  switch (patternMetadata.patternKind()) {
+    case PatternKind::kExactlyN:
+      return OptimizedLike<PatternKind::kExactlyN>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kAtLeastN:
+      return OptimizedLike<PatternKind::kAtLeastN>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kFixed:
+      return OptimizedLike<PatternKind::kFixed>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kPrefix:
+      return OptimizedLike<PatternKind::kPrefix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kSuffix:
+      return OptimizedLike<PatternKind::kSuffix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kSubstring:
+      return OptimizedLike<PatternKind::kSubstring>::match<isAscii>(
+          input, patternMetadata);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Evaluates a disjunction of LIKE (or regexp_like) calls with constant
+// patterns on the same string. Patterns with a dedicated matcher are checked
+// first. The remaining patterns are compiled into a single RE2::Set that
+// matches all of them in one pass over the string. For LIKE, a row only goes
+// to the RE2::Set if it contains the longest literal of at least one of these
+// patterns.
+class Re2MatchAny final : public exec::VectorFunction {
+ public:
+  // Compiles LIKE 'patterns' without escape character if 'isLike' is true,
+  // otherwise compiles regular expressions for a partial match.
+  Re2MatchAny(const std::vector<StringView>& patterns, bool isLike) {
+    RE2::Options opt{RE2::Quiet};
+    opt.set_dot_nl(isLike);
+    set_ = std::make_unique<RE2::Set>(
+        opt, isLike ? RE2::ANCHOR_BOTH : RE2::UNANCHORED);
+    std::string error;
+    for (const auto& pattern : patterns) {
+      if (!isLike) {
+        VELOX_USER_CHECK_GE(
+            set_->Add(toStringPiece(pattern), &error),
+            0,
+            "invalid regular expression:{}",
+            error);
+        continue;
+      }
+
+      auto patternMetadata =
+          determinePatternKind(std::string_view(pattern), std::nullopt);
+      switch (patternMetadata.patternKind()) {
+        case PatternKind::kExactlyN:
+        case PatternKind::kAtLeastN:
+        case PatternKind::kFixed:
+        case PatternKind::kPrefix:
+        case PatternKind::kSuffix:
+        case PatternKind::kSubstring:
+          optimizedPatterns_.push_back(std::move(patternMetadata));
+          continue;
+        default:
+          break;
+      }
+
+      bool validPattern;
+      auto regex = likePatternToRe2(pattern, std::nullopt, validPattern);
+      VELOX_CHECK_GE(set_->Add(regex, &error), 0, "{}", error);
+      literals_.push_back(
+          longestLikeLiteral(std::string_view(pattern), std::nullopt));
+    }
+    // A pattern without literals may match any row.
+    filterByLiterals_ = isLike &&
+        std::none_of(literals_.begin(), literals_.end(), [](const auto& l) {
+                          return l.empty();
+                        });
+    if (optimizedPatterns_.size() == patterns.size()) {
+      set_.reset();
+    } else {
+      VELOX_USER_CHECK(
+          set_->Compile(), "Not enough memory to compile the patterns");
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    const bool isAscii =
+        optimizedPatterns_.empty() || isAsciiArg(rows, args[0]);
+    if (isAscii) {
+      context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+        result.set(i, match<true>(toSearch->valueAt<StringView>(i)));
+      });
+    } else {
+      context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+        result.set(i, match<false>(toSearch->valueAt<StringView>(i)));
+      });
+    }
+  }
+
+ private:
+  template <bool isAscii>
+  bool match(const StringView& input) const {
+    for (const auto& patternMetadata : optimizedPatterns_) {
+      if (matchOptimizedLike<isAscii>(input, patternMetadata)) {
+        return true;
+      }
+    }
+    if (set_ == nullptr) {
+      return false;
+    }
+    if (filterByLiterals_ &&
+        std::none_of(literals_.begin(), literals_.end(), [&](const auto& l) {
+          return containsLiteral(input, l);
+        })) {
+      return false;
+    }
+    return set_->Match(toStringPiece(input), nullptr);
+  }
+
+  std::vector<PatternMetadata> optimizedPatterns_;
+  // Patterns without a dedicated matcher. Null if there are none.
+  std::unique_ptr<RE2::Set> set_;
+  // The longest literal of each LIKE pattern in 'set_'.
+  std::vector<std::string> literals_;
+  bool filterByLiterals_;
+};
+
 void re2ExtractAll(
     exec::VectorWriter<Array<Varchar>>& resultWriter,
     const RE2& re,
@@ -2212,6 +2396,171 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures() {
   };
 }
 
+namespace {
+std::vector<StringView> constantPatterns(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs) {
+  VELOX_USER_CHECK_GE(
+      inputArgs.size(), 2, "{} requires at least 2 arguments", name);
+  std::vector<StringView> patterns;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto* pattern = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        pattern != nullptr && !pattern->isNullAt(0),
+        "{} requires constant non-null patterns",
+        name);
+    patterns.push_back(pattern->as<ConstantVector<StringView>>()->valueAt(0));
+  }
+  return patterns;
+}
+
+void flattenOr(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& disjuncts) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenOr(input, disjuncts);
+    }
+  } else {
+    disjuncts.push_back(expr);
+  }
+}
+
+// Returns the pattern of 'expr' if it is a call to 'name' with a constant,
+// non-null and valid pattern and no escape character.
+std::optional<std::string> constantPattern(
+    const core::TypedExprPtr& expr,
+    const std::string& name,
+    bool isRegex) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != name || call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (constant == nullptr || !constant->type()->isVarchar() ||
+      constant->hasValueVector() || constant->value().isNull()) {
+    return std::nullopt;
+  }
+  auto pattern = constant->value().value<TypeKind::VARCHAR>();
+  if (isRegex && !RE2(pattern, RE2::Quiet).ok()) {
+    // Leave invalid patterns to regexp_like to report.
+    return std::nullopt;
+  }
+  return pattern;
+}
+} // namespace
+
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  return std::make_shared<Re2MatchAny>(
+      constantPatterns(name, inputArgs), /*isLike=*/true);
+}
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  return std::make_shared<Re2MatchAny>(
+      constantPatterns(name, inputArgs), /*isLike=*/false);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> matchAnySignatures() {
+  // varchar, varchar... -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varchar")
+              .constantArgumentType("varchar")
+              .variableArity()
+              .build()};
+}
+
+core::TypedExprPtr rewriteMatchAnyCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != "or") {
+    return nullptr;
+  }
+
+  std::vector<core::TypedExprPtr> disjuncts;
+  flattenOr(expr, disjuncts);
+
+  struct Fusable {
+    std::string name;
+    std::string fusedName;
+    bool isRegex;
+  };
+  const Fusable kFusable[] = {
+      {prefix + "like", "$internal$like_any", false},
+      {prefix + "regexp_like", "$internal$regexp_like_any", true}};
+
+  // Disjuncts that test the same input against LIKE or regexp_like patterns.
+  struct Group {
+    const Fusable* fusable;
+    core::TypedExprPtr input;
+    std::vector<std::string> patterns;
+  };
+  std::vector<Group> groups;
+  std::vector<int32_t> groupIndices(disjuncts.size(), -1);
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    for (const auto& fusable : kFusable) {
+      auto pattern =
+          constantPattern(disjuncts[i], fusable.name, fusable.isRegex);
+      if (!pattern.has_value()) {
+        continue;
+      }
+      const auto& input = disjuncts[i]->inputs()[0];
+      auto it = std::find_if(groups.begin(), groups.end(), [&](auto& group) {
+        return group.fusable == &fusable && *group.input == *input;
+      });
+      if (it == groups.end()) {
+        it = groups.insert(groups.end(), Group{&fusable, input, {}});
+      }
+      it->patterns.push_back(std::move(*pattern));
+      groupIndices[i] = it - groups.begin();
+      break;
+    }
+  }
+  if (std::none_of(groups.begin(), groups.end(), [](const auto& group) {
+        return group.patterns.size() > 1;
+      })) {
+    return nullptr;
+  }
+
+  // Replaces the first disjunct of each group with the fused call and drops
+  // the others.
+  std::vector<core::TypedExprPtr> newDisjuncts;
+  std::vector<bool> fused(groups.size(), false);
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    const auto groupIndex = groupIndices[i];
+    if (groupIndex < 0 || groups[groupIndex].patterns.size() < 2) {
+      newDisjuncts.push_back(disjuncts[i]);
+      continue;
+    }
+    if (fused[groupIndex]) {
+      continue;
+    }
+    fused[groupIndex] = true;
+    const auto& group = groups[groupIndex];
+    std::vector<core::TypedExprPtr> inputs{group.input};
+    for (const auto& pattern : group.patterns) {
+      inputs.push_back(
+          std::make_shared<core::ConstantTypedExpr>(VARCHAR(), pattern));
+    }
+    newDisjuncts.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(), std::move(inputs), group.fusable->fusedName));
+  }
+  if (newDisjuncts.size() == 1) {
+    return newDisjuncts[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newDisjuncts), "or");
+}
+
 std::shared_ptr<exec::VectorFunction> makeRe2ExtractAll(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
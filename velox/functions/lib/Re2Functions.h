@@ -213,6 +213,39 @@ std::shared_ptr<exec::VectorFunction> makeLike(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures();
 
+/// $internal$like_any(string, pattern1, pattern2, ...) → bool
+/// $internal$regexp_like_any(string, pattern1, pattern2, ...) → bool
+///
+/// Returns whether 'string' matches any of the constant LIKE patterns (without
+/// escape character) or regular expressions. Matches all patterns that need a
+/// regular expression in a single pass using RE2::Set. Produced by
+/// rewriteMatchAnyCall.
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> matchAnySignatures();
+
+/// Rewrites an OR with two or more disjuncts of the form
+/// like(s, 'constant') on the same 's' into a single $internal$like_any call.
+/// Does the same for regexp_like. Other disjuncts are kept.
+///
+/// For example, rewrites
+///     like(s, '%a%b') OR s = 'x' OR like(s, 'c%d%')
+/// into
+///     $internal$like_any(s, '%a%b', 'c%d%') OR s = 'x'
+///
+/// Returns new expression or nullptr if rewrite is not possible.
+core::TypedExprPtr rewriteMatchAnyCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
 /// re2ExtractAll(string, pattern, group_id) → array<string>
 /// re2ExtractAll(string, pattern) → array<string>
 ///
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <xsimd/xsimd.hpp>
+
+#include <type_traits>
+
+namespace facebook::velox::functions {
+
+namespace detail {
+template <typename T>
+constexpr bool isSimdElementType() {
+  return std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+      sizeof(T) <= sizeof(int64_t);
+}
+} // namespace detail
+
+/// Sets result[i] = op(inputs[i]...) for all positions of 'result'. 'op' is a
+/// generic callable, e.g. [](auto a, auto b) { return a & b; }. If the inputs
+/// have the same type as the result, 'op' is called with xsimd batches of the
+/// inputs for all full batches and with scalars for the remaining positions.
+/// Otherwise, 'op' is called with scalars only. 'result' may be the same as one
+/// of the inputs. Simple functions use this to implement callBatch().
+template <typename TOut, typename Op, typename... TIn>
+void simdTransform(folly::Range<TOut*> result, Op op, const TIn*... inputs) {
+  const auto size = result.size();
+  size_t i = 0;
+  if constexpr (
+      detail::isSimdElementType<TOut>() && (std::is_same_v<TOut, TIn> && ...)) {
+    using Batch = xsimd::batch<TOut>;
+    for (; i + Batch::size <= size; i += Batch::size) {
+      Batch batch = op(Batch::load_unaligned(inputs + i)...);
+      batch.store_unaligned(result.data() + i);
+    }
+  }
+  for (; i < size; ++i) {
+    result[i] = op(inputs[i]...);
+  }
+}
+
+} // namespace facebook::velox::functions
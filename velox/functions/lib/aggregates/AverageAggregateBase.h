@@ -151,10 +151,30 @@ class AverageAggregateBase : public exec::Aggregate {
             groups[i], TAccumulator(decodedRaw_.valueAt<TInput>(i)));
       });
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
+      // Consecutive rows of the same group are accumulated in locals and the
+      // group is stored once per run.
       auto data = decodedRaw_.data<TInput>();
+      char* group = nullptr;
+      TAccumulator sum(0);
+      int64_t count = 0;
+      auto store = [&]() {
+        if (group != nullptr) {
+          accumulator(group)->sum = sum;
+          accumulator(group)->count =
+              checkedPlus<int64_t>(accumulator(group)->count, count);
+        }
+      };
       rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<false>(groups[i], data[i]);
+        if (groups[i] != group) {
+          store();
+          group = groups[i];
+          sum = accumulator(group)->sum;
+          count = 0;
+        }
+        sum += data[i];
+        ++count;
       });
+      store();
     } else {
       rows.applyToSelected([&](vector_size_t i) {
         updateNonNullValue(
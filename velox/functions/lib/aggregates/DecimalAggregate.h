@@ -137,11 +137,10 @@ class DecimalAggregate : public exec::Aggregate {
       });
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
+      WideDecimalSum sum;
+      rows.applyToSelected([&](vector_size_t i) { sum.add(data[i]); });
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      accumulator.overflow = sum.addTo(accumulator.sum);
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
@@ -149,13 +148,12 @@ class DecimalAggregate : public exec::Aggregate {
       accumulator.serialize(serialized);
       mergeAccumulators<false>(group, serialized);
     } else {
-      LongDecimalWithOverflowState accumulator;
+      WideDecimalSum sum;
       rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum,
-            decodedRaw_.valueAt<TInputType>(i),
-            accumulator.sum);
+        sum.add(decodedRaw_.valueAt<TInputType>(i));
       });
+      LongDecimalWithOverflowState accumulator;
+      accumulator.overflow = sum.addTo(accumulator.sum);
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
@@ -129,10 +129,10 @@ class SimpleNumericAggregate : public exec::Aggregate {
       });
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
-      rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<tableHasNulls, TData>(
-            groups[i], TData(data[i]), updateSingleValue);
-      });
+      updateGroupRuns<tableHasNulls, TData>(
+          groups, rows, updateSingleValue, [&](vector_size_t i) {
+            return TData(data[i]);
+          });
     } else {
       rows.applyToSelected([&](vector_size_t i) {
         updateNonNullValue<tableHasNulls, TData>(
@@ -171,24 +171,35 @@ class SimpleNumericAggregate : public exec::Aggregate {
         updateNonNullValue<true, TData>(group, initialValue, updateSingleValue);
       }
     } else if (decoded.mayHaveNulls()) {
+      // The accumulator is kept in a local and stored once at the end.
+      auto accumulator = *exec::Aggregate::value<TData>(group);
+      bool updated = false;
       rows.applyToSelected([&](vector_size_t i) {
         if (decoded.isNullAt(i)) {
           return;
         }
-        updateNonNullValue<true, TData>(
-            group, TData(decoded.valueAt<TValue>(i)), updateSingleValue);
+        updateSingleValue(accumulator, TData(decoded.valueAt<TValue>(i)));
+        updated = true;
       });
+      if (updated) {
+        exec::Aggregate::clearNull(group);
+        *exec::Aggregate::value<TData>(group) = accumulator;
+      }
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
+      // Without loads and stores of the group in the loop, the compiler can
+      // vectorize min, max and integer reductions over all selected rows.
+      auto accumulator = *exec::Aggregate::value<TData>(group);
       rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<true, TData>(
-            group, TData(data[i]), updateSingleValue);
+        updateSingleValue(accumulator, TData(data[i]));
       });
+      storeAccumulator<TData>(group, rows, accumulator);
     } else {
+      auto accumulator = *exec::Aggregate::value<TData>(group);
       rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<true, TData>(
-            group, TData(decoded.valueAt<TValue>(i)), updateSingleValue);
+        updateSingleValue(accumulator, TData(decoded.valueAt<TValue>(i)));
       });
+      storeAccumulator<TData>(group, rows, accumulator);
     }
   }
 
@@ -226,6 +237,54 @@ class SimpleNumericAggregate : public exec::Aggregate {
   }
 
  private:
+  // Stores 'accumulator' into 'group' if any row of 'rows' is selected.
+  template <typename TData>
+  void storeAccumulator(
+      char* group,
+      const SelectivityVector& rows,
+      TData accumulator) {
+    if (!rows.hasSelections()) {
+      return;
+    }
+    exec::Aggregate::clearNull(group);
+    *exec::Aggregate::value<TData>(group) = accumulator;
+  }
+
+  // Updates 'groups' for the selected rows. Consecutive rows of the same
+  // group, as in input clustered on the grouping keys, are accumulated in a
+  // local and the group is stored once per run.
+  template <
+      bool tableHasNulls,
+      typename TData,
+      typename UpdateSingleValue,
+      typename ValueAt>
+  void updateGroupRuns(
+      char** groups,
+      const SelectivityVector& rows,
+      UpdateSingleValue updateSingleValue,
+      ValueAt valueAt) {
+    char* group = nullptr;
+    TData accumulator{};
+    auto store = [&]() {
+      if (group == nullptr) {
+        return;
+      }
+      if constexpr (tableHasNulls) {
+        exec::Aggregate::clearNull(group);
+      }
+      *exec::Aggregate::value<TData>(group) = accumulator;
+    };
+    rows.applyToSelected([&](vector_size_t i) {
+      if (groups[i] != group) {
+        store();
+        group = groups[i];
+        accumulator = *exec::Aggregate::value<TData>(group);
+      }
+      updateSingleValue(accumulator, valueAt(i));
+    });
+    store();
+  }
+
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
   template <
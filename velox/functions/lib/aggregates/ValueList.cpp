@@ -109,12 +109,18 @@ ValueListReader::ValueListReader(ValueList& values)
       dataStream_{HashStringAllocator::prepareRead(values.dataBegin())},
       nullsStream_{HashStringAllocator::prepareRead(values.nullsBegin())} {}
 
-bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
+void ValueListReader::loadNulls() {
   if (pos_ == lastNullsStart_) {
     nulls_ = lastNulls_;
-  } else if (pos_ % 64 == 0) {
+  } else {
     nulls_ = nullsStream_.read<uint64_t>();
   }
+}
+
+bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
+  if (pos_ % 64 == 0) {
+    loadNulls();
+  }
 
   if (nulls_ & (1UL << (pos_ % 64))) {
     output.setNull(outputIndex, true);
@@ -125,4 +131,68 @@ bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
   pos_++;
   return pos_ < size_;
 }
+
+template <typename T>
+void ValueListReader::readFixedWidth(
+    FlatVector<T>& output,
+    vector_size_t outputIndex) {
+  // Maps positions in the list to positions in 'output'.
+  const auto delta = outputIndex - pos_;
+  auto* rawValues = output.mutableRawValues();
+  while (pos_ < size_) {
+    if (pos_ % 64 == 0) {
+      loadNulls();
+    }
+    const auto wordEnd = std::min<vector_size_t>(size_, pos_ - pos_ % 64 + 64);
+    const auto remainingNulls = nulls_ >> (pos_ % 64);
+    if (remainingNulls & 1) {
+      output.setNull(pos_ + delta, true);
+      ++pos_;
+      continue;
+    }
+    // Values are serialized back to back, so a run of non-null values is
+    // copied as is.
+    const auto numNonNull = remainingNulls == 0
+        ? wordEnd - pos_
+        : std::min<vector_size_t>(
+              wordEnd - pos_, __builtin_ctzll(remainingNulls));
+    dataStream_.readBytes(
+        reinterpret_cast<uint8_t*>(rawValues + pos_ + delta),
+        numNonNull * sizeof(T));
+    if (output.rawNulls() != nullptr) {
+      bits::fillBits(
+          output.mutableRawNulls(),
+          pos_ + delta,
+          pos_ + delta + numNonNull,
+          bits::kNotNull);
+    }
+    pos_ += numNonNull;
+  }
+}
+
+void ValueListReader::readAll(BaseVector& output, vector_size_t outputIndex) {
+  if (output.encoding() == VectorEncoding::Simple::FLAT) {
+    switch (output.typeKind()) {
+      case TypeKind::TINYINT:
+        return readFixedWidth(*output.asFlatVector<int8_t>(), outputIndex);
+      case TypeKind::SMALLINT:
+        return readFixedWidth(*output.asFlatVector<int16_t>(), outputIndex);
+      case TypeKind::INTEGER:
+        return readFixedWidth(*output.asFlatVector<int32_t>(), outputIndex);
+      case TypeKind::BIGINT:
+        return readFixedWidth(*output.asFlatVector<int64_t>(), outputIndex);
+      case TypeKind::HUGEINT:
+        return readFixedWidth(*output.asFlatVector<int128_t>(), outputIndex);
+      case TypeKind::REAL:
+        return readFixedWidth(*output.asFlatVector<float>(), outputIndex);
+      case TypeKind::DOUBLE:
+        return readFixedWidth(*output.asFlatVector<double>(), outputIndex);
+      default:
+        break;
+    }
+  }
+  for (auto i = outputIndex; pos_ < size_; ++i) {
+    next(output, i);
+  }
+}
 } // namespace facebook::velox::aggregate
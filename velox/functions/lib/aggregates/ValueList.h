@@ -123,7 +123,18 @@ class ValueListReader {
 
   bool next(BaseVector& output, vector_size_t outputIndex);
 
+  /// Reads all values not read yet into consecutive positions of 'output'
+  /// starting at 'outputIndex'. Flat vectors of fixed-width types other than
+  /// boolean get each run of non-null values with a single copy.
+  void readAll(BaseVector& output, vector_size_t outputIndex);
+
  private:
+  // Loads the null flags for the 64 values starting at 'pos_'.
+  void loadNulls();
+
+  template <typename T>
+  void readFixedWidth(FlatVector<T>& output, vector_size_t outputIndex);
+
   const vector_size_t size_;
   const vector_size_t lastNullsStart_;
   const uint64_t lastNulls_;
@@ -148,9 +159,7 @@ void copyValueListToArrayWriter(
   writer.reserve(size);
 
   ValueListReader reader(elements);
-  for (vector_size_t i = 0; i < size; ++i) {
-    reader.next(*writer.elementsVector(), writer.valuesOffset() + i);
-  }
+  reader.readAll(*writer.elementsVector(), writer.valuesOffset());
   writer.resize(size);
 }
 
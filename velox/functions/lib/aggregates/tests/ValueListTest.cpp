@@ -45,6 +45,26 @@ class ValueListTest : public functions::test::FunctionBaseTest {
     return result;
   }
 
+  // Reads with ValueListReader::readAll() after reading the first 'numNext'
+  // values with next().
+  VectorPtr readAll(
+      aggregate::ValueList& values,
+      const TypePtr& type,
+      vector_size_t size,
+      vector_size_t numNext) {
+    aggregate::ValueListReader reader(values);
+    auto result = BaseVector::create(type, size, pool());
+    for (auto i = 0; i < size; ++i) {
+      result->setNull(i, true);
+    }
+
+    for (auto i = 0; i < numNext; i++) {
+      reader.next(*result, i);
+    }
+    reader.readAll(*result, numNext);
+    return result;
+  }
+
   void testRoundTrip(const VectorPtr& data) {
     auto size = data->size();
 
@@ -60,6 +80,13 @@ class ValueListTest : public functions::test::FunctionBaseTest {
       auto result = read(values, data->type(), size);
 
       assertEqualVectors(data, result);
+
+      for (auto numNext : {0, 3, 64}) {
+        if (numNext <= size) {
+          result = readAll(values, data->type(), size, numNext);
+          assertEqualVectors(data, result);
+        }
+      }
     }
 
     // Use ValueList::appendRange.
@@ -20,6 +20,7 @@
 #include <string_view>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 #if (ENABLE_VECTORIZATION > 0) && !defined(_DEBUG) && !defined(DEBUG)
@@ -48,7 +49,19 @@ namespace stringCore {
 static bool isAscii(const char* str, size_t length);
 
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
+  using Batch = xsimd::batch<int8_t>;
+  size_t i = 0;
+  if (length >= Batch::size) {
+    // ORs the bytes together and tests the high bit once.
+    auto bytes = Batch::broadcast(0);
+    for (; i + Batch::size <= length; i += Batch::size) {
+      bytes |= Batch::load_unaligned(reinterpret_cast<const int8_t*>(str + i));
+    }
+    if (xsimd::any(bytes < Batch::broadcast(0))) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
     if (str[i] & 0x80) {
       return false;
     }
@@ -56,6 +69,84 @@ FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
   return true;
 }
 
+/// Returns a mask with a bit set for each of the bytes at 'str' that starts a
+/// UTF-8 character, i.e. that is not a continuation byte 10xxxxxx. The
+/// continuation bytes are the int8_t values below -64.
+FOLLY_ALWAYS_INLINE uint32_t characterStartMask(const char* str) {
+  using Batch = xsimd::batch<int8_t>;
+  static_assert(Batch::size <= 32);
+  return simd::toBitMask(
+      Batch::load_unaligned(reinterpret_cast<const int8_t*>(str)) >
+      Batch::broadcast(-65));
+}
+
+/// Returns the byte index of the 'n'th (0-based) byte at or after 'offset'
+/// that starts a UTF-8 character, or 'size' if there are not that many.
+/// Counts the characters of a SIMD register at a time. Sets 'numSkipped' to
+/// the number of character starts before the returned index, i.e. 'n' unless
+/// the string ends first.
+FOLLY_ALWAYS_INLINE size_t findCharacterStart(
+    const char* str,
+    size_t size,
+    size_t offset,
+    size_t n,
+    size_t& numSkipped) {
+  constexpr auto kBatchSize = xsimd::batch<int8_t>::size;
+  auto remaining = n;
+  auto i = offset;
+  for (; i + kBatchSize <= size; i += kBatchSize) {
+    auto starts = characterStartMask(str + i);
+    const size_t count = __builtin_popcount(starts);
+    if (count > remaining) {
+      for (; remaining > 0; --remaining) {
+        starts &= starts - 1;
+      }
+      numSkipped = n;
+      return i + __builtin_ctz(starts);
+    }
+    remaining -= count;
+  }
+  for (; i < size; ++i) {
+    if (!utf_cont(str[i])) {
+      if (remaining == 0) {
+        numSkipped = n;
+        return i;
+      }
+      --remaining;
+    }
+  }
+  numSkipped = n - remaining;
+  return size;
+}
+
+/// Calls 'func' with the index of each occurrence of 'byte' in the 'size'
+/// bytes at 'str', in increasing order, until 'func' returns false. Compares
+/// a SIMD register of bytes at a time.
+template <typename TFunc>
+FOLLY_ALWAYS_INLINE void
+forEachByte(const char* str, size_t size, char byte, TFunc func) {
+  using Batch = xsimd::batch<int8_t>;
+  static_assert(Batch::size <= 32);
+  const auto target = Batch::broadcast(byte);
+  size_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    uint32_t matches = simd::toBitMask(
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(str + i)) ==
+        target);
+    while (matches) {
+      if (!func(i + __builtin_ctz(matches))) {
+        return;
+      }
+      matches &= matches - 1;
+    }
+  }
+  for (; i < size; ++i) {
+    if (str[i] == byte && !func(i)) {
+      return;
+    }
+  }
+}
+
 /// Perform reverse for ascii string input
 FOLLY_ALWAYS_INLINE static void
 reverseAscii(char* output, const char* input, size_t length) {
@@ -68,6 +159,10 @@ reverseAscii(char* output, const char* input, size_t length) {
 /// Perform reverse for utf8 string input
 FOLLY_ALWAYS_INLINE static void
 reverseUnicode(char* output, const char* input, size_t length) {
+  if (isAscii(input, length)) {
+    reverseAscii(output, input, length);
+    return;
+  }
   auto inputIdx = 0;
   auto outputIdx = length;
   while (inputIdx < length) {
@@ -122,6 +217,11 @@ FOLLY_ALWAYS_INLINE size_t upperUnicode(
     size_t outputLength,
     const char* input,
     size_t inputLength) {
+  if (isAscii(input, inputLength)) {
+    // ASCII rows of a vector that is not all ASCII.
+    upperAscii(output, input, inputLength);
+    return inputLength;
+  }
   auto inputIdx = 0;
   auto outputIdx = 0;
 
@@ -162,6 +262,11 @@ FOLLY_ALWAYS_INLINE size_t lowerUnicode(
     size_t outputLength,
     const char* input,
     size_t inputLength) {
+  if (isAscii(input, inputLength)) {
+    // ASCII rows of a vector that is not all ASCII.
+    lowerAscii(output, input, inputLength);
+    return inputLength;
+  }
   auto inputIdx = 0;
   auto outputIdx = 0;
 
@@ -217,20 +322,20 @@ applyAppendersRecursive(TOutStr& output, Func appenderFunc, Funcs... funcs) {
  */
 FOLLY_ALWAYS_INLINE int64_t
 lengthUnicode(const char* inputBuffer, size_t bufferLength) {
-  // First address after the last byte in the buffer
-  auto buffEndAddress = inputBuffer + bufferLength;
-  auto currentChar = inputBuffer;
+  constexpr auto kBatchSize = xsimd::batch<int8_t>::size;
   int64_t size = 0;
-  while (currentChar < buffEndAddress) {
+  size_t i = 0;
+  for (; i + kBatchSize <= bufferLength; i += kBatchSize) {
+    size += __builtin_popcount(characterStartMask(inputBuffer + i));
+  }
+  for (; i < bufferLength; ++i) {
     // This function detects bytes that come after the first byte in a
     // multi-byte UTF-8 character (provided that the string is valid UTF-8). We
     // increment size only for the first byte so that we treat all bytes as part
     // of a single character.
-    if (!utf_cont(*currentChar)) {
+    if (!utf_cont(inputBuffer[i])) {
       size++;
     }
-
-    currentChar++;
   }
   return size;
 }
@@ -507,48 +612,23 @@ static inline std::pair<size_t, size_t> getByteRange(
     return std::make_pair(
         startCharPosition - 1, startCharPosition + length - 1);
   } else {
-    size_t startByteIndex = 0;
-    size_t nextCharOffset = 0;
-
-    // Skips any Unicode continuation bytes. These are bytes that appear after
-    // the first byte in a multi-byte Unicode character.  They do not count
-    // towards the position in or length of a string.
-    auto skipContBytes = [&]() {
-      while (nextCharOffset < strLength && utf_cont(str[nextCharOffset])) {
-        nextCharOffset++;
-      }
-    };
-
-    // Skip any invalid continuation bytes at the beginning of the string.
-    skipContBytes();
-
-    // Find startByteIndex
-    for (auto i = 0; nextCharOffset < strLength && i < startCharPosition - 1;
-         i++) {
-      nextCharOffset++;
-
-      skipContBytes();
-    }
-
-    startByteIndex = nextCharOffset;
-    size_t charCountInRange = 0;
-
-    // Find endByteIndex
-    for (auto i = 0; nextCharOffset < strLength && i < length; i++) {
-      nextCharOffset++;
-      charCountInRange++;
-
-      skipContBytes();
-    }
+    // Continuation bytes do not count towards the position in or length of a
+    // string. This skips invalid continuation bytes at the beginning of the
+    // string.
+    size_t numSkipped;
+    const auto startByteIndex = findCharacterStart(
+        str, strLength, 0, startCharPosition - 1, numSkipped);
+    const auto endByteIndex =
+        findCharacterStart(str, strLength, startByteIndex, length, numSkipped);
 
     VELOX_CHECK_EQ(
-        charCountInRange,
+        numSkipped,
         length,
         "The substring requested at {} of length {} exceeds the bounds of the string.",
         startCharPosition,
         length);
 
-    return std::make_pair(startByteIndex, nextCharOffset);
+    return std::make_pair(startByteIndex, endByteIndex);
   }
 }
 } // namespace stringCore
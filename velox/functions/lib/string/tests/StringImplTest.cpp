@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 #include <memory>
+#include <random>
 #include <vector>
 
 using namespace facebook::velox;
@@ -611,6 +612,61 @@ TEST_F(StringImplTest, getByteRange) {
   EXPECT_EQ(range.second, 3);
 }
 
+TEST_F(StringImplTest, longMixedStrings) {
+  // Strings longer than a SIMD register with ASCII and multi-byte characters
+  // and invalid bytes at different positions.
+  const std::vector<std::string> pieces = {
+      "a", "xyz", "\u00E9", "\u4E2D\u6587", "\U0001F600", "\xff", "\x80"};
+  std::mt19937 rng(1);
+  for (auto i = 0; i < 200; ++i) {
+    std::string input;
+    const auto numPieces = rng() % 60;
+    for (auto j = 0; j < numPieces; ++j) {
+      input += pieces[rng() % pieces.size()];
+    }
+    SCOPED_TRACE(input);
+
+    // The characters start at the bytes that are not continuation bytes.
+    std::vector<size_t> starts;
+    for (auto j = 0; j < input.size(); ++j) {
+      if ((static_cast<unsigned char>(input[j]) & 0xC0) != 0x80) {
+        starts.push_back(j);
+      }
+    }
+    ASSERT_EQ(starts.size(), length</*isAscii*/ false>(input));
+    ASSERT_EQ(
+        std::none_of(
+            input.begin(), input.end(), [](char c) { return c & 0x80; }),
+        isAscii(input.data(), input.size()));
+
+    for (auto start = 1; start <= starts.size(); ++start) {
+      const auto maxLength = starts.size() - start + 1;
+      for (auto length : {size_t(1), maxLength / 2 + 1, maxLength}) {
+        auto range =
+            getByteRange<false>(input.data(), input.size(), start, length);
+        ASSERT_EQ(starts[start - 1], range.first);
+        const auto end = start - 1 + length;
+        ASSERT_EQ(
+            end < starts.size() ? starts[end] : input.size(), range.second);
+      }
+    }
+  }
+
+  // ASCII strings take the ASCII path in the Unicode functions.
+  const std::string ascii = "The Quick Brown Fox Jumps Over The Lazy Dog 0123";
+  std::string output(ascii.size(), '\0');
+  ASSERT_EQ(
+      ascii.size(),
+      upperUnicode(output.data(), output.size(), ascii.data(), ascii.size()));
+  ASSERT_EQ("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123", output);
+  ASSERT_EQ(
+      ascii.size(),
+      lowerUnicode(output.data(), output.size(), ascii.data(), ascii.size()));
+  ASSERT_EQ("the quick brown fox jumps over the lazy dog 0123", output);
+  reverseUnicode(output.data(), ascii.data(), ascii.size());
+  ASSERT_EQ(std::string(ascii.rbegin(), ascii.rend()), output);
+}
+
 TEST_F(StringImplTest, pad) {
   auto runTest = [](const std::string& string,
                     const int64_t size,
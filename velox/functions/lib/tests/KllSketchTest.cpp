@@ -129,6 +129,29 @@ TEST_F(KllSketchTest, randomInput) {
   }
 }
 
+TEST_F(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  std::vector<double> values(N);
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  insertRandomData(0, N, kll, values.data());
+  // Inserting in batches of different sizes gives the same sketch as
+  // inserting one value at a time.
+  KllSketch<double> batched(kDefaultK, {}, 0);
+  batched.insert(folly::Range<const double*>(values.data(), 0));
+  for (int i = 0, size = 1; i < N; i += size, size = size * 3 % 1'000 + 1) {
+    batched.insert(
+        folly::Range(values.data() + i, std::min<int>(size, N - i)));
+  }
+  ASSERT_EQ(batched.totalCount(), N);
+  kll.finish();
+  batched.finish();
+  std::string expected(kll.serializedByteSize(), '\0');
+  kll.serialize(expected.data());
+  std::string actual(batched.serializedByteSize(), '\0');
+  batched.serialize(actual.data());
+  ASSERT_EQ(expected, actual);
+}
+
 TEST_F(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
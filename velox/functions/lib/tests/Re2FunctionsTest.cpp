@@ -57,6 +57,15 @@ class Re2FunctionsTest : public test::FunctionBaseTest {
     exec::registerStatefulVectorFunction(
         "re2_extract_all", re2ExtractAllSignatures(), makeRe2ExtractAll);
     exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
+    exec::registerStatefulVectorFunction(
+        "regexp_like", re2SearchSignatures(), makeRe2Search);
+    exec::registerStatefulVectorFunction(
+        "$internal$like_any", matchAnySignatures(), makeLikeAny);
+    exec::registerStatefulVectorFunction(
+        "$internal$regexp_like_any", matchAnySignatures(), makeRe2SearchAny);
+    exec::registerExpressionRewrite([](const auto& expr) {
+      return rewriteMatchAnyCall("", expr);
+    });
   }
 
  protected:
@@ -918,6 +927,48 @@ TEST_F(Re2FunctionsTest, likeSubstringPattern) {
       true);
 }
 
+TEST_F(Re2FunctionsTest, likeGenericWithLiteral) {
+  // The literal 'bc' is present but the pattern does not match.
+  testLike("xbcx", "%a%bc%", false);
+  testLike("abcx", "%a%bc_", true);
+  testLike("bca", "%a%bc%", false);
+  testLike("a\nbc", "a_%bc", true);
+  testLike("a.bc", "a#_%bc", '#', false);
+  testLike("a_xbc", "a#_%bc", '#', true);
+}
+
+TEST_F(Re2FunctionsTest, likeAny) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {"abcd", "xaybz", "hello world", std::nullopt, "", "a%b", "zzz"})});
+
+  auto test = [&](const std::string& expression,
+                  const std::vector<std::optional<bool>>& expected) {
+    SCOPED_TRACE(expression);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    ASSERT_NE(exprSet->toString().find("$internal$"), std::string::npos);
+    assertEqualVectors(
+        makeNullableFlatVector<bool>(expected), evaluate(*exprSet, data));
+  };
+
+  test(
+      "like(c0, '%a%b%') or like(c0, 'h_llo%') or like(c0, '%z')",
+      {true, true, true, std::nullopt, false, true, true});
+  test(
+      "like(c0, 'ab%') or c0 = 'zzz' or like(c0, '%y_z')",
+      {true, true, false, std::nullopt, false, false, true});
+  test(
+      "(like(c0, '%%') or like(c0, 'x%')) and c0 <> 'abcd'",
+      {false, true, true, std::nullopt, true, true, true});
+  test(
+      "regexp_like(c0, 'b.*d') or regexp_like(c0, '^x')",
+      {true, true, false, std::nullopt, false, false, false});
+
+  // Invalid regular expressions are not fused and still fail.
+  VELOX_ASSERT_THROW(
+      evaluate("regexp_like(c0, '(') or regexp_like(c0, 'a')", data),
+      "invalid regular expression");
+}
+
 TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
   // Test null pattern.
   ASSERT_TRUE(
@@ -30,6 +30,7 @@
 #include "velox/common/base/Doubles.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/functions/Macros.h"
+#include "velox/functions/lib/SimdTransform.h"
 #include "velox/functions/prestosql/ArithmeticImpl.h"
 
 namespace facebook::velox::functions {
@@ -53,6 +54,15 @@ struct PlusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = plus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<TInput*> result,
+      const TInput* a,
+      const TInput* b) {
+    simdTransform(
+        result, [](auto x, auto y) { return plus(x, y); }, a, b);
+  }
 };
 
 template <typename T>
@@ -62,6 +72,15 @@ struct MinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = minus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<TInput*> result,
+      const TInput* a,
+      const TInput* b) {
+    simdTransform(
+        result, [](auto x, auto y) { return minus(x, y); }, a, b);
+  }
 };
 
 template <typename T>
@@ -71,6 +90,15 @@ struct MultiplyFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = multiply(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<TInput*> result,
+      const TInput* a,
+      const TInput* b) {
+    simdTransform(
+        result, [](auto x, auto y) { return multiply(x, y); }, a, b);
+  }
 };
 
 // Multiply function for IntervalDayTime * Double and Double * IntervalDayTime.
@@ -25,10 +25,10 @@ namespace {
 
 template <typename T>
 struct ValueSet {
-  util::floating_point::HashSetNaNAware<T> values;
+  util::floating_point::AdaptiveSetNaNAware<T> values;
 
   bool insert(const T& value) {
-    return values.insert(value).second;
+    return values.insert(value);
   }
 
   void reset() {
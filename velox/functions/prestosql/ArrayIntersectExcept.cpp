@@ -22,10 +22,6 @@ namespace facebook::velox::functions {
 namespace {
 template <typename T>
 struct SetWithNull {
-  SetWithNull(vector_size_t initialSetSize = kInitialSetSize) {
-    set.reserve(initialSetSize);
-  }
-
   void reset() {
     set.clear();
     hasNull = false;
@@ -35,9 +31,10 @@ struct SetWithNull {
     return !hasNull && set.empty();
   }
 
-  util::floating_point::HashSetNaNAware<T> set;
+  // Most arrays have a few elements, which are found faster by a linear scan
+  // than by hashing.
+  util::floating_point::AdaptiveSetNaNAware<T> set;
   bool hasNull{false};
-  static constexpr vector_size_t kInitialSetSize{128};
 };
 
 // Generates a set based on the elements of an ArrayVector. Note that we take
@@ -198,13 +195,12 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
           // (check outputSet).
           bool addValue = false;
           if constexpr (isIntersect) {
-            addValue = rightSet.set.count(val) > 0;
+            addValue = rightSet.set.contains(val);
           } else {
-            addValue = rightSet.set.count(val) == 0;
+            addValue = !rightSet.set.contains(val);
           }
           if (addValue) {
-            auto it = outputSet.set.insert(val);
-            if (it.second) {
+            if (outputSet.set.insert(val)) {
               rawNewIndices[indicesCursor++] = i;
             }
           }
@@ -300,7 +296,7 @@ class ArraysOverlapFunction : public exec::VectorFunction {
           hasNull = true;
           continue;
         }
-        if (rightSet.set.count(decodedLeftElements->valueAt<T>(i)) > 0) {
+        if (rightSet.set.contains(decodedLeftElements->valueAt<T>(i))) {
           // Found an overlapping element. Add to result set.
           resultBoolVector->set(row, true);
           return;
@@ -16,6 +16,8 @@
 #pragma once
 
 #include "velox/functions/Macros.h"
+#include "velox/functions/lib/SimdTransform.h"
+
 namespace facebook::velox::functions {
 
 template <typename T>
@@ -25,6 +27,14 @@ struct BitwiseAndFunction {
     result = a & b;
     return true;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<int64_t*> result,
+      const TInput* a,
+      const TInput* b) {
+    simdTransform(result, [](auto x, auto y) { return x & y; }, a, b);
+  }
 };
 
 template <typename T>
@@ -57,6 +67,13 @@ struct BitwiseNotFunction {
     result = ~a;
     return true;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<int64_t*> result,
+      const TInput* a) {
+    simdTransform(result, [](auto x) { return ~x; }, a);
+  }
 };
 
 template <typename T>
@@ -66,6 +83,14 @@ struct BitwiseOrFunction {
     result = a | b;
     return true;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<int64_t*> result,
+      const TInput* a,
+      const TInput* b) {
+    simdTransform(result, [](auto x, auto y) { return x | y; }, a, b);
+  }
 };
 
 template <typename T>
@@ -75,6 +100,14 @@ struct BitwiseXorFunction {
     result = a ^ b;
     return true;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<int64_t*> result,
+      const TInput* a,
+      const TInput* b) {
+    simdTransform(result, [](auto x, auto y) { return x ^ y; }, a, b);
+  }
 };
 
 template <typename T>
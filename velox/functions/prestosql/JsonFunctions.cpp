@@ -13,7 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+
+#include "velox/core/Expressions.h"
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -181,6 +184,147 @@ class JsonParseFunction : public exec::VectorFunction {
   mutable std::string paddedInput_;
 };
 
+// $internal$json_extract_scalar(json, path1, path2, ...) -> row(varchar, ...)
+// Extracts all constant paths from each document with a single parse. The
+// i-th field of the result is json_extract_scalar(json, path_i). Produced by
+// rewriteJsonExtractScalarCalls.
+class JsonExtractScalarMultiFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarMultiFunction(
+      std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors)
+      : extractors_(std::move(extractors)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(args.size(), extractors_.size() + 1);
+    exec::LocalDecodedVector decodedJson(context, *args[0], rows);
+
+    std::vector<VectorPtr> children;
+    std::vector<FlatVector<StringView>*> flatChildren;
+    children.reserve(extractors_.size());
+    flatChildren.reserve(extractors_.size());
+    for (auto i = 0; i < extractors_.size(); ++i) {
+      children.push_back(
+          BaseVector::create(VARCHAR(), rows.end(), context.pool()));
+      flatChildren.push_back(children.back()->asFlatVector<StringView>());
+    }
+
+    size_t maxSize = 0;
+    rows.applyToSelected([&](auto row) {
+      const auto size = decodedJson->valueAt<StringView>(row).size();
+      maxSize = std::max<size_t>(maxSize, size);
+    });
+    paddedInput_.resize(maxSize + simdjson::SIMDJSON_PADDING);
+
+    std::optional<std::string> value;
+    rows.applyToSelected([&](auto row) {
+      const auto json = decodedJson->valueAt<StringView>(row);
+      memcpy(paddedInput_.data(), json.data(), json.size());
+      simdjson::padded_string_view paddedJson(
+          paddedInput_.data(), json.size(), paddedInput_.size());
+
+      auto jsonDoc = simdjsonParse(paddedJson);
+      bool reparse = false;
+      for (auto i = 0; i < extractors_.size(); ++i) {
+        if (reparse) {
+          // Do not rely on the document state after an error.
+          jsonDoc = simdjsonParse(paddedJson);
+          reparse = false;
+        } else if (i > 0 && jsonDoc.error() == simdjson::SUCCESS) {
+          // Rewinding reuses the structural index built by the first parse.
+          jsonDoc.value_unsafe().rewind();
+        }
+
+        if (jsonDoc.error() != simdjson::SUCCESS ||
+            extractScalar(jsonDoc.value_unsafe(), *extractors_[i], value) !=
+                simdjson::SUCCESS) {
+          flatChildren[i]->setNull(row, true);
+          reparse = jsonDoc.error() == simdjson::SUCCESS;
+        } else if (value.has_value()) {
+          flatChildren[i]->set(row, StringView(*value));
+        } else {
+          flatChildren[i]->setNull(row, true);
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // json, varchar... -> row(varchar, ...)
+    // The result has one field per path. The signature cannot express that, so
+    // the result type comes from the rewritten expression.
+    return {
+        exec::FunctionSignatureBuilder()
+            .returnType("row(varchar)")
+            .argumentType("json")
+            .argumentType("varchar")
+            .variableArity()
+            .build(),
+        exec::FunctionSignatureBuilder()
+            .returnType("row(varchar)")
+            .argumentType("varchar")
+            .argumentType("varchar")
+            .variableArity()
+            .build(),
+    };
+  }
+
+ private:
+  const std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors_;
+  // Padding is needed in case string view is inlined.
+  mutable std::string paddedInput_;
+};
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalarMulti(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors;
+  extractors.reserve(inputArgs.size() - 1);
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto& path = inputArgs[i].constantValue;
+    VELOX_USER_CHECK(
+        path != nullptr && !path->isNullAt(0),
+        "{} requires constant non-null paths",
+        name);
+    extractors.push_back(SIMDJsonExtractor::compile(
+        path->as<ConstantVector<StringView>>()->valueAt(0)));
+  }
+  return std::make_shared<JsonExtractScalarMultiFunction>(
+      std::move(extractors));
+}
+
+// Returns the path of 'call' if it is a json_extract_scalar call with a valid
+// constant path. Returns std::nullopt otherwise.
+std::optional<std::string> constantJsonPath(
+    const std::string& name,
+    const core::CallTypedExpr& call) {
+  if (call.name() != name || call.inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto path = exec::constantString(call.inputs()[1]);
+  if (!path.has_value()) {
+    return std::nullopt;
+  }
+
+  // Invalid paths are left to json_extract_scalar, which reports the error
+  // only for rows it is evaluated on.
+  try {
+    SIMDJsonExtractor::compile(path.value());
+  } catch (const VeloxUserError&) {
+    return std::nullopt;
+  }
+  return path;
+}
+
 } // namespace
 
 VELOX_DECLARE_VECTOR_FUNCTION(
@@ -197,4 +341,34 @@ VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
       return std::make_shared<JsonParseFunction>();
     });
 
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_json_extract_scalar_multi,
+    JsonExtractScalarMultiFunction::signatures(),
+    makeJsonExtractScalarMulti);
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  const auto name = prefix + "json_extract_scalar";
+  return exec::fuseCalls(
+      exprs,
+      [&](const core::CallTypedExpr& call) {
+        return constantJsonPath(name, call);
+      },
+      [](const core::TypedExprPtr& input,
+         const std::vector<std::string>& paths) {
+        std::vector<core::TypedExprPtr> inputs{input};
+        for (const auto& path : paths) {
+          inputs.push_back(std::make_shared<core::ConstantTypedExpr>(
+              VARCHAR(), variant(path)));
+        }
+        auto names = paths;
+        std::vector<TypePtr> types(paths.size(), VARCHAR());
+        return std::make_shared<core::CallTypedExpr>(
+            ROW(std::move(names), std::move(types)),
+            std::move(inputs),
+            "$internal$json_extract_scalar");
+      });
+}
+
 } // namespace facebook::velox::functions
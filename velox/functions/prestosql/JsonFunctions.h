@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/core/ITypedExpr.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
@@ -189,6 +190,51 @@ struct JsonArrayGetFunction {
   }
 };
 
+/// Extracts the scalar that 'extractor' points to in 'jsonDoc'. Sets 'result'
+/// to the value as a string, or to std::nullopt if the path does not match
+/// exactly one scalar. Returns an error if the JSON is malformed.
+inline simdjson::error_code extractScalar(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    std::optional<std::string>& result) {
+  bool resultPopulated = false;
+  result = std::nullopt;
+  auto consumer = [&result, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  return simdJsonExtract(jsonDoc, extractor, consumer);
+}
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -197,6 +243,17 @@ template <typename T>
 struct JsonExtractScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  // Compiles a constant path once instead of looking it up for each row.
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = SIMDJsonExtractor::compile(*jsonPath);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Json>& json,
@@ -205,47 +262,17 @@ struct JsonExtractScalarFunction {
   }
 
  private:
-  FOLLY_ALWAYS_INLINE bool callImpl(
+  FOLLY_ALWAYS_INLINE simdjson::error_code callImpl(
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
+    auto& extractor =
+        extractor_ ? *extractor_ : SIMDJsonExtractor::getInstance(jsonPath);
+    simdjson::padded_string paddedJson(json.data(), json.size());
+    SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
 
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
+    std::optional<std::string> resultStr;
+    SIMDJSON_TRY(extractScalar(jsonDoc, extractor, resultStr));
 
     if (resultStr.has_value()) {
       result.copy_from(*resultStr);
@@ -254,12 +281,24 @@ struct JsonExtractScalarFunction {
       return simdjson::NO_SUCH_FIELD;
     }
   }
+
+  std::shared_ptr<SIMDJsonExtractor> extractor_;
 };
 
 template <typename T>
 struct JsonExtractFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = SIMDJsonExtractor::compile(*jsonPath);
+    }
+  }
+
   bool call(
       out_type<Json>& result,
       const arg_type<Json>& json,
@@ -311,7 +350,8 @@ struct JsonExtractFunction {
       return simdjson::SUCCESS;
     };
 
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
+    auto& extractor =
+        extractor_ ? *extractor_ : SIMDJsonExtractor::getInstance(jsonPath);
     SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
 
     if (resultSize == 0) {
@@ -334,12 +374,24 @@ struct JsonExtractFunction {
     }
     return simdjson::SUCCESS;
   }
+
+  std::shared_ptr<SIMDJsonExtractor> extractor_;
 };
 
 template <typename T>
 struct JsonSizeFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = SIMDJsonExtractor::compile(*jsonPath);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       int64_t& result,
       const arg_type<Json>& json,
@@ -382,7 +434,8 @@ struct JsonSizeFunction {
       return simdjson::SUCCESS;
     };
 
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
+    auto& extractor =
+        extractor_ ? *extractor_ : SIMDJsonExtractor::getInstance(jsonPath);
     SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
 
     if (resultCount == 0) {
@@ -394,6 +447,27 @@ struct JsonSizeFunction {
 
     return simdjson::SUCCESS;
   }
+
+  std::shared_ptr<SIMDJsonExtractor> extractor_;
 };
 
+/// Fuses json_extract_scalar calls with constant paths on the same input into
+/// a single $internal$json_extract_scalar call that parses each document once
+/// and returns a ROW with one field per path. Each original call becomes a
+/// dereference of that ROW.
+///
+/// For example,
+///
+/// Rewrites
+///     json_extract_scalar(c0, '$.a'), json_extract_scalar(c0, '$.b')
+/// into
+///     $internal$json_extract_scalar(c0, '$.a', '$.b')[$.a],
+///     $internal$json_extract_scalar(c0, '$.a', '$.b')[$.b]
+///
+/// Doesn't look into lambdas. Returns an empty vector if no input is extracted
+/// from with more than one distinct path.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
 } // namespace facebook::velox::functions
@@ -24,7 +24,8 @@ template <typename TExec>
 struct MapTopNFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
 
-  template <typename It>
+  using It = typename arg_type<Map<Orderable<T1>, Orderable<T2>>>::Iterator;
+
   struct Compare {
     bool operator()(const It& l, const It& r) const {
       static const CompareFlags flags{
@@ -65,25 +66,20 @@ struct MapTopNFunction {
       return;
     }
 
-    using It = typename arg_type<Map<Orderable<T1>, Orderable<T2>>>::Iterator;
-
-    Compare<It> comparator;
-
-    std::priority_queue<It, std::vector<It>, Compare<It>> topEntries(
-        comparator);
-
+    // Selects the top entries in linear time and sorts only these. The
+    // buffer of iterators is reused across rows.
+    Compare comparator;
+    entries_.clear();
     for (auto it = inputMap.begin(); it != inputMap.end(); ++it) {
-      if (topEntries.size() < n) {
-        topEntries.push(it);
-      } else if (comparator(it, topEntries.top())) {
-        topEntries.pop();
-        topEntries.push(it);
-      }
+      entries_.push_back(it);
     }
+    std::nth_element(
+        entries_.begin(), entries_.begin() + n, entries_.end(), comparator);
+    std::sort(entries_.begin(), entries_.begin() + n, comparator);
 
-    while (!topEntries.empty()) {
-      auto it = topEntries.top();
-
+    // Writes the entries in the same order as before, lowest first.
+    for (auto i = n - 1; i >= 0; --i) {
+      const auto& it = entries_[i];
       if (!it->second.has_value()) {
         auto& keyWriter = out.add_null();
         keyWriter.copy_from(it->first);
@@ -92,10 +88,11 @@ struct MapTopNFunction {
         keyWriter.copy_from(it->first);
         valueWriter.copy_from(it->second.value());
       }
-
-      topEntries.pop();
     }
   }
+
+ private:
+  std::vector<It> entries_;
 };
 
 } // namespace facebook::velox::functions
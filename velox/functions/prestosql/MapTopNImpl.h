@@ -36,28 +36,30 @@ struct MapTopNImpl {
       return;
     }
 
+    // Selects the top entries in linear time and sorts only these. The
+    // buffer of iterators is reused across rows.
     Compare comparator;
-    std::priority_queue<It, std::vector<It>, Compare> topEntries(comparator);
-
+    entries_.clear();
     for (auto it = inputMap.begin(); it != inputMap.end(); ++it) {
-      if (topEntries.size() < n) {
-        topEntries.push(it);
-      } else if (comparator(it, topEntries.top())) {
-        topEntries.pop();
-        topEntries.push(it);
-      }
+      entries_.push_back(it);
     }
-    std::vector<It> result;
-    result.reserve(topEntries.size());
-    while (!topEntries.empty()) {
-      result.push_back(topEntries.top());
-      topEntries.pop();
+    const auto numTop = std::min<size_t>(n, entries_.size());
+    if (numTop < entries_.size()) {
+      std::nth_element(
+          entries_.begin(),
+          entries_.begin() + numTop,
+          entries_.end(),
+          comparator);
     }
-    // Reverse the order of the result to be in descending order.
-    for (int i = result.size() - 1; i >= 0; i--) {
-      out.push_back(result[i]->first);
+    std::sort(entries_.begin(), entries_.begin() + numTop, comparator);
+
+    for (size_t i = 0; i < numTop; ++i) {
+      out.push_back(entries_[i]->first);
     }
   }
+
+ private:
+  std::vector<It> entries_;
 };
 
 } // namespace facebook::velox::functions
@@ -19,6 +19,7 @@
 #include "velox/expression/StringWriter.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 
@@ -103,12 +104,34 @@ class SplitFunction : public exec::VectorFunction {
     DecodedVector* limits = noLimit ? nullptr : decodedArgs.at(2);
 
     BaseVector::ensureWritable(rows, ARRAY(VARCHAR()), context.pool(), result);
-    exec::VectorWriter<Array<Varchar>> resultWriter;
-    resultWriter.init(*result->as<ArrayVector>());
+    auto* arrayResult = result->as<ArrayVector>();
 
     // Optimization for the (flat, const, const) case.
-    if (strings->isIdentityMapping() and delims->isConstantMapping() and
-        (noLimit or limits->isConstantMapping())) {
+    const bool flatStrings = strings->isIdentityMapping() and
+        delims->isConstantMapping() and
+        (noLimit or limits->isConstantMapping());
+
+    // Single byte delimiters, e.g. in log lines, skip the VectorWriter and
+    // write the offsets, sizes and elements directly.
+    if (flatStrings and !delims->isNullAt(0) and
+        delims->valueAt<StringView>(0).size() == 1 and
+        (noLimit or (!limits->isNullAt(0) and limits->valueAt<I>(0) > 0))) {
+      applySingleByteDelimiter<I>(
+          rows,
+          strings->data<StringView>(),
+          delims->valueAt<StringView>(0).data()[0],
+          noLimit ? std::numeric_limits<I>::max() : limits->valueAt<I>(0),
+          *arrayResult);
+      arrayResult->elements()
+          ->as<FlatVector<StringView>>()
+          ->acquireSharedStringBuffers(strings->base());
+      return;
+    }
+
+    exec::VectorWriter<Array<Varchar>> resultWriter;
+    resultWriter.init(*arrayResult);
+
+    if (flatStrings) {
       const auto* rawStrings = strings->data<StringView>();
       const auto delim = delims->valueAt<StringView>(0);
 
@@ -142,8 +165,7 @@ class SplitFunction : public exec::VectorFunction {
 
     // Ensure that our result elements vector uses the same string buffer as
     // the input vector of strings.
-    result->as<ArrayVector>()
-        ->elements()
+    arrayResult->elements()
         ->as<FlatVector<StringView>>()
         ->acquireSharedStringBuffers(strings->base());
   }
@@ -185,6 +207,59 @@ class SplitFunction : public exec::VectorFunction {
     }
   }
 
+  /**
+   * Splits the selected rows of 'rawStrings' on 'delim' into at most 'limit'
+   * elements each. The delimiters are found a SIMD register at a time. The
+   * elements are appended to the elements of 'result' and refer to the input
+   * strings.
+   */
+  template <typename I>
+  void applySingleByteDelimiter(
+      const SelectivityVector& rows,
+      const StringView* rawStrings,
+      char delim,
+      I limit,
+      ArrayVector& result) const {
+    auto* elements = result.elements()->as<FlatVector<StringView>>();
+    auto* rawOffsets =
+        result.mutableOffsets(rows.end())->asMutable<vector_size_t>();
+    auto* rawSizes =
+        result.mutableSizes(rows.end())->asMutable<vector_size_t>();
+
+    vector_size_t numElements = elements->size();
+    vector_size_t capacity = numElements;
+    StringView* rawElements = nullptr;
+    auto addElement = [&](const char* data, size_t size) {
+      if (numElements == capacity) {
+        capacity = std::max<vector_size_t>(2 * capacity, 1'024);
+        elements->resize(capacity);
+        rawElements = elements->mutableRawValues();
+      }
+      rawElements[numElements++] = StringView(data, size);
+    };
+
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto& input = rawStrings[row];
+      const char* data = input.data();
+      const vector_size_t offset = numElements;
+      size_t elementStart = 0;
+      stringCore::forEachByte(data, input.size(), delim, [&](size_t index) {
+        // Leave room for the remainder of the string.
+        if (numElements - offset + 1 >= limit) {
+          return false;
+        }
+        addElement(data + elementStart, index - elementStart);
+        elementStart = index + 1;
+        return true;
+      });
+      addElement(data + elementStart, input.size() - elementStart);
+      rawOffsets[row] = offset;
+      rawSizes[row] = numElements - offset;
+      result.setNull(row, false);
+    });
+    elements->resize(numElements);
+  }
+
   /**
    * The inner most kernel of the vector operations for 'split'.
    */
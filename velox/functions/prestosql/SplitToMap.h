@@ -18,6 +18,7 @@
 #include "folly/container/F14Set.h"
 #include "velox/common/base/Status.h"
 #include "velox/functions/Udf.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 
@@ -97,16 +98,32 @@ struct SplitToMapFunction {
 
     folly::F14FastMap<std::string_view, std::string_view> keyValuePairs;
 
-    auto nextEntryPos = input.find(entryDelimiter, pos);
-    while (nextEntryPos != std::string::npos) {
-      VELOX_RETURN_NOT_OK(processEntry(
-          std::string_view(input.data() + pos, nextEntryPos - pos),
-          keyValueDelimiter,
-          onDuplicateKey,
-          keyValuePairs));
-
-      pos = nextEntryPos + 1;
-      nextEntryPos = input.find(entryDelimiter, pos);
+    if (entryDelimiter.size() == 1) {
+      // Finds the delimiters a SIMD register at a time.
+      Status status;
+      stringCore::forEachByte(
+          input.data(), input.size(), entryDelimiter[0], [&](size_t index) {
+            status = processEntry(
+                std::string_view(input.data() + pos, index - pos),
+                keyValueDelimiter,
+                onDuplicateKey,
+                keyValuePairs);
+            pos = index + 1;
+            return status.ok();
+          });
+      VELOX_RETURN_NOT_OK(status);
+    } else {
+      auto nextEntryPos = input.find(entryDelimiter, pos);
+      while (nextEntryPos != std::string::npos) {
+        VELOX_RETURN_NOT_OK(processEntry(
+            std::string_view(input.data() + pos, nextEntryPos - pos),
+            keyValueDelimiter,
+            onDuplicateKey,
+            keyValuePairs));
+
+        pos = nextEntryPos + 1;
+        nextEntryPos = input.find(entryDelimiter, pos);
+      }
     }
 
     // Entry delimiter can be the last character in the input. In this case
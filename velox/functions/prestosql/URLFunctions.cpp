@@ -15,43 +15,343 @@
  */
 
 #include "URLFunctions.h"
+#include <cstring>
 #include <optional>
+#include "velox/core/Expressions.h"
+#include "velox/expression/StringWriter.h"
+#include "velox/expression/VectorFunction.h"
 #include "velox/type/Type.h"
 
-namespace facebook::velox::functions::detail {
-
-std::optional<StringView> matchAuthorityAndPath(
-    StringView authorityAndPath,
-    boost::cmatch& authorityMatch,
-    int subGroup) {
-  boost::cmatch authAndPathMatch;
-  static const boost::regex kAuthorityAndPathRegex("//([^/]*)(/.*)?");
-  if (!boost::regex_match(
-          authorityAndPath.begin(),
-          authorityAndPath.end(),
-          authAndPathMatch,
-          kAuthorityAndPathRegex)) {
-    // Does not start with //, doesn't have authority.
+namespace facebook::velox::functions {
+
+namespace detail {
+
+namespace {
+
+// Matches (\[[^\]]*\]|[^\[:]*)(?::(\d*))? against [begin, end).
+std::optional<UrlHostAndPort> matchHostAndPort(
+    const char* begin,
+    const char* end) {
+  const char* hostEnd = begin;
+  if (begin < end && *begin == '[') {
+    hostEnd = std::find(begin + 1, end, ']');
+    if (hostEnd == end) {
+      return std::nullopt;
+    }
+    ++hostEnd;
+  } else {
+    while (hostEnd < end && *hostEnd != '[' && *hostEnd != ':') {
+      ++hostEnd;
+    }
+  }
+
+  UrlHostAndPort hostAndPort{StringView(begin, hostEnd - begin), std::nullopt};
+  if (hostEnd == end) {
+    return hostAndPort;
+  }
+  if (*hostEnd != ':') {
     return std::nullopt;
   }
+  for (const char* p = hostEnd + 1; p < end; ++p) {
+    if (*p < '0' || *p > '9') {
+      return std::nullopt;
+    }
+  }
+  hostAndPort.port = StringView(hostEnd + 1, end - hostEnd - 1);
+  return hostAndPort;
+}
 
-  static const boost::regex kAuthorityRegex(
-      "(?:([^@:]*)(?::([^@]*))?@)?" // username, password.
-      "(\\[[^\\]]*\\]|[^\\[:]*)" // host (IP-literal (e.g. '['+IPv6+']',
-      // dotted-IPv4, or named host).
-      "(?::(\\d*))?"); // port.
+} // namespace
 
-  const auto authority = authAndPathMatch[1];
-  if (!boost::regex_match(
-          authority.first, authority.second, authorityMatch, kAuthorityRegex)) {
-    return std::nullopt; // Invalid URI Authority.
+std::optional<UrlHostAndPort> parseAuthority(StringView authority) {
+  const char* begin = authority.data();
+  const char* end = begin + authority.size();
+  // The user info ends at the first '@'. If the rest is not a host and port,
+  // the regex backtracks to no user info.
+  const char* at = std::find(begin, end, '@');
+  if (at != end) {
+    if (auto hostAndPort = matchHostAndPort(at + 1, end)) {
+      return hostAndPort;
+    }
   }
+  return matchHostAndPort(begin, end);
+}
 
-  if (authorityMatch[subGroup].matched) {
-    return detail::submatch(authorityMatch, subGroup);
+std::optional<StringView> findQueryParameter(
+    StringView query,
+    StringView name) {
+  const char* begin = query.data();
+  const char* end = begin + query.size();
+  for (;;) {
+    const char* parameterEnd = std::find(begin, end, '&');
+    const char* equals = std::find(begin, parameterEnd, '=');
+    if (equals == parameterEnd ||
+        std::find(equals + 1, parameterEnd, '=') == parameterEnd) {
+      const StringView key(begin, equals - begin);
+      if (!key.empty() && key == name) {
+        return equals == parameterEnd
+            ? StringView()
+            : StringView(equals + 1, parameterEnd - equals - 1);
+      }
+    }
+    if (parameterEnd == end) {
+      return std::nullopt;
+    }
+    begin = parameterEnd + 1;
   }
+}
+
+} // namespace detail
+
+namespace {
 
+constexpr const char* kParameterPrefix = "parameter:";
+
+// A part of a URL extracted by $internal$url_extract.
+enum class UrlPart {
+  kProtocol,
+  kHost,
+  kPort,
+  kPath,
+  kQuery,
+  kFragment,
+  kParameter,
+};
+
+struct UrlExtraction {
+  UrlPart part;
+  // The parameter name for kParameter.
+  std::string parameter;
+};
+
+// Returns the extraction for 'name', e.g. 'host' or 'parameter:q', or
+// std::nullopt if 'name' is not a part.
+std::optional<UrlExtraction> toUrlExtraction(const std::string& name) {
+  static const folly::F14FastMap<std::string, UrlPart> kParts = {
+      {"protocol", UrlPart::kProtocol},
+      {"host", UrlPart::kHost},
+      {"port", UrlPart::kPort},
+      {"path", UrlPart::kPath},
+      {"query", UrlPart::kQuery},
+      {"fragment", UrlPart::kFragment},
+  };
+  auto it = kParts.find(name);
+  if (it != kParts.end()) {
+    return UrlExtraction{it->second, ""};
+  }
+  const std::string_view prefix(kParameterPrefix);
+  if (name.compare(0, prefix.size(), prefix) == 0) {
+    return UrlExtraction{UrlPart::kParameter, name.substr(prefix.size())};
+  }
   return std::nullopt;
 }
 
-} // namespace facebook::velox::functions::detail
+// Sets 'row' of 'vector' to 'value' with escapes decoded. Refers to 'value'
+// if it has nothing to decode.
+void setUnescaped(
+    FlatVector<StringView>& vector,
+    vector_size_t row,
+    StringView value) {
+  if (std::memchr(value.data(), '%', value.size()) == nullptr &&
+      std::memchr(value.data(), '+', value.size()) == nullptr) {
+    vector.setNoCopy(row, value);
+    return;
+  }
+  exec::StringWriter<> writer(&vector, row);
+  detail::urlUnescape(writer, value);
+  writer.finalize();
+}
+
+// $internal$url_extract(url, part1, part2, ...) -> row(...)
+// Splits each URL once and extracts all constant parts. A part is one of
+// 'protocol', 'host', 'port', 'path', 'query', 'fragment' or
+// 'parameter:<name>'. The i-th field of the result is the result of the
+// url_extract_* call for the i-th part. Produced by rewriteUrlExtractCalls.
+class UrlExtractMultiFunction : public exec::VectorFunction {
+ public:
+  explicit UrlExtractMultiFunction(std::vector<UrlExtraction> extractions)
+      : extractions_(std::move(extractions)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(args.size(), extractions_.size() + 1);
+    exec::LocalDecodedVector decodedUrls(context, *args[0], rows);
+
+    std::vector<VectorPtr> children;
+    children.reserve(extractions_.size());
+    for (auto i = 0; i < extractions_.size(); ++i) {
+      children.push_back(BaseVector::create(
+          outputType->childAt(i), rows.end(), context.pool()));
+    }
+    auto stringChild = [&](auto i) {
+      return children[i]->asFlatVector<StringView>();
+    };
+
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      const auto url = decodedUrls->valueAt<StringView>(row);
+      if (!detail::isValidURI(url)) {
+        for (auto& child : children) {
+          child->setNull(row, true);
+        }
+        return;
+      }
+
+      const auto components = detail::splitUrl(url);
+      for (auto i = 0; i < extractions_.size(); ++i) {
+        switch (extractions_[i].part) {
+          case UrlPart::kProtocol:
+            stringChild(i)->setNoCopy(
+                row, components.scheme.value_or(StringView()));
+            break;
+          case UrlPart::kHost:
+            stringChild(i)->setNoCopy(row, detail::extractHost(components));
+            break;
+          case UrlPart::kPort:
+            if (auto port = detail::extractPort(components)) {
+              children[i]->asFlatVector<int64_t>()->set(row, port.value());
+            } else {
+              children[i]->setNull(row, true);
+            }
+            break;
+          case UrlPart::kPath:
+            setUnescaped(*stringChild(i), row, components.path);
+            break;
+          case UrlPart::kQuery:
+            stringChild(i)->setNoCopy(
+                row, components.query.value_or(StringView()));
+            break;
+          case UrlPart::kFragment:
+            stringChild(i)->setNoCopy(
+                row, components.fragment.value_or(StringView()));
+            break;
+          case UrlPart::kParameter: {
+            std::optional<StringView> value;
+            if (components.query.has_value()) {
+              value = detail::findQueryParameter(
+                  components.query.value(),
+                  StringView(extractions_[i].parameter));
+            }
+            if (value.has_value()) {
+              setUnescaped(*stringChild(i), row, value.value());
+            } else {
+              children[i]->setNull(row, true);
+            }
+            break;
+          }
+        }
+      }
+    });
+
+    // The parts refer to the input strings.
+    for (auto i = 0; i < extractions_.size(); ++i) {
+      if (extractions_[i].part != UrlPart::kPort) {
+        stringChild(i)->acquireSharedStringBuffers(decodedUrls->base());
+      }
+    }
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(children));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // varchar, varchar... -> row(...)
+    // The result has one field per part. The signature cannot express that,
+    // so the result type comes from the rewritten expression.
+    return {exec::FunctionSignatureBuilder()
+                .returnType("row(varchar)")
+                .argumentType("varchar")
+                .argumentType("varchar")
+                .variableArity()
+                .build()};
+  }
+
+ private:
+  const std::vector<UrlExtraction> extractions_;
+};
+
+std::shared_ptr<exec::VectorFunction> makeUrlExtractMulti(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  std::vector<UrlExtraction> extractions;
+  extractions.reserve(inputArgs.size() - 1);
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto& part = inputArgs[i].constantValue;
+    VELOX_USER_CHECK(
+        part != nullptr && !part->isNullAt(0),
+        "{} requires constant non-null parts",
+        name);
+    const auto partName =
+        part->as<ConstantVector<StringView>>()->valueAt(0).str();
+    auto extraction = toUrlExtraction(partName);
+    VELOX_USER_CHECK(
+        extraction.has_value(), "{}: unknown URL part: {}", name, partName);
+    extractions.push_back(std::move(extraction.value()));
+  }
+  return std::make_shared<UrlExtractMultiFunction>(std::move(extractions));
+}
+
+// Returns the part 'call' extracts if it is a url_extract_* call that can be
+// fused, e.g. 'host' for url_extract_host(c0). Returns std::nullopt
+// otherwise.
+std::optional<std::string> urlPart(
+    const std::string& prefix,
+    const core::CallTypedExpr& call) {
+  const auto functionPrefix = prefix + "url_extract_";
+  const auto& name = call.name();
+  if (name.compare(0, functionPrefix.size(), functionPrefix) != 0) {
+    return std::nullopt;
+  }
+  auto part = name.substr(functionPrefix.size());
+  if (part == "parameter") {
+    if (call.inputs().size() != 2) {
+      return std::nullopt;
+    }
+    auto parameter = exec::constantString(call.inputs()[1]);
+    if (!parameter.has_value()) {
+      return std::nullopt;
+    }
+    return kParameterPrefix + parameter.value();
+  }
+  if (call.inputs().size() != 1 || !toUrlExtraction(part).has_value()) {
+    return std::nullopt;
+  }
+  return part;
+}
+
+} // namespace
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_url_extract_multi,
+    UrlExtractMultiFunction::signatures(),
+    makeUrlExtractMulti);
+
+std::vector<core::TypedExprPtr> rewriteUrlExtractCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  return exec::fuseCalls(
+      exprs,
+      [&](const core::CallTypedExpr& call) { return urlPart(prefix, call); },
+      [](const core::TypedExprPtr& input,
+         const std::vector<std::string>& parts) {
+        std::vector<core::TypedExprPtr> inputs{input};
+        std::vector<TypePtr> types;
+        for (const auto& part : parts) {
+          inputs.push_back(std::make_shared<core::ConstantTypedExpr>(
+              VARCHAR(), variant(part)));
+          types.push_back(part == "port" ? BIGINT() : VARCHAR());
+        }
+        auto names = parts;
+        return std::make_shared<core::CallTypedExpr>(
+            ROW(std::move(names), std::move(types)),
+            std::move(inputs),
+            "$internal$url_extract");
+      });
+}
+
+} // namespace facebook::velox::functions
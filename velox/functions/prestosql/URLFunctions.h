@@ -15,9 +15,10 @@
  */
 #pragma once
 
-#include <boost/regex.hpp>
+#include <folly/Conv.h>
 #include <cctype>
 #include <optional>
+#include "velox/core/ITypedExpr.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/lib/string/StringImpl.h"
 
@@ -25,72 +26,128 @@ namespace facebook::velox::functions {
 
 namespace detail {
 
-const auto kScheme = 2;
-const auto kAuthority = 3;
-const auto kPath = 5;
-const auto kQuery = 7;
-const auto kFragment = 9;
-const auto kHost = 3; // From the authority and path regex.
-const auto kPort = 4; // From the authority and path regex.
-
-FOLLY_ALWAYS_INLINE StringView submatch(const boost::cmatch& match, int idx) {
-  const auto& sub = match[idx];
-  return StringView(sub.first, sub.length());
-}
+/// The components of a URL as captured by the regex from RFC 3986, see
+/// https://www.rfc-editor.org/rfc/rfc3986#appendix-B:
+///
+///   ^(([^:/?#]+):)?(//([^/?#]*))?([^?#]*)(\?([^#]*))?(#(.*))?
+///
+/// For example, http://www.ics.uci.edu/pub/ietf/uri/?a=b#Related has the
+/// scheme 'http', the authority 'www.ics.uci.edu', the path '/pub/ietf/uri/',
+/// the query 'a=b' and the fragment 'Related'. Components the URL does not
+/// have are not set. The path is always set, possibly to an empty string.
+struct UrlComponents {
+  std::optional<StringView> scheme;
+  /// Without the leading "//".
+  std::optional<StringView> authority;
+  StringView path;
+  std::optional<StringView> query;
+  std::optional<StringView> fragment;
+};
 
-FOLLY_ALWAYS_INLINE bool
-parse(const char* rawUrlData, size_t rawUrlsize, boost::cmatch& match) {
-  /// This regex is taken from RFC - 3986.
-  /// See: https://www.rfc-editor.org/rfc/rfc3986#appendix-B
-  /// The basic groups are:
-  ///      scheme    = $2
-  ///      authority = $4
-  ///      path      = $5
-  ///      query     = $7
-  ///      fragment  = $9
-  /// For example a URI like below :
-  ///  http://www.ics.uci.edu/pub/ietf/uri/#Related
-  ///
-  ///   results in the following subexpression matches:
-  ///
-  ///      $1 = http:
-  ///      $2 = http
-  ///      $3 = //www.ics.uci.edu
-  ///      $4 = www.ics.uci.edu
-  ///      $5 = /pub/ietf/uri/
-  ///      $6 = <undefined>
-  ///      $7 = <undefined>
-  ///      $8 = #Related
-  ///      $9 = Related
-  static const boost::regex kUriRegex(
-      "^(([^:\\/?#]+):)?" // scheme:
-      "(\\/\\/([^\\/?#]*))?([^?#]*)" // authority and path
-      "(\\?([^#]*))?" // ?query
-      "(#(.*))?"); // #fragment
-
-  return boost::regex_match(
-      rawUrlData, rawUrlData + rawUrlsize, match, kUriRegex);
-}
+/// Splits 'url' into its components in a single pass. Every string matches
+/// the regex above, so this does not fail.
+FOLLY_ALWAYS_INLINE UrlComponents splitUrl(StringView url) {
+  const char* begin = url.data();
+  const char* end = begin + url.size();
+  UrlComponents components;
+
+  // The scheme is a non-empty prefix without ':', '/', '?' and '#' followed
+  // by ':'.
+  const char* p = begin;
+  while (p < end && *p != ':' && *p != '/' && *p != '?' && *p != '#') {
+    ++p;
+  }
+  if (p > begin && p < end && *p == ':') {
+    components.scheme = StringView(begin, p - begin);
+    begin = p + 1;
+  }
 
-/// Parses the url and returns the matching subgroup if the particular sub group
-/// is matched by the call to parse call above.
-FOLLY_ALWAYS_INLINE std::optional<StringView> parse(
-    StringView rawUrl,
-    int subGroup) {
-  boost::cmatch match;
-  if (!parse(rawUrl.data(), rawUrl.size(), match)) {
-    return std::nullopt;
+  if (end - begin >= 2 && begin[0] == '/' && begin[1] == '/') {
+    p = begin + 2;
+    while (p < end && *p != '/' && *p != '?' && *p != '#') {
+      ++p;
+    }
+    components.authority = StringView(begin + 2, p - begin - 2);
+    begin = p;
+  }
+
+  p = begin;
+  while (p < end && *p != '?' && *p != '#') {
+    ++p;
   }
+  components.path = StringView(begin, p - begin);
+  begin = p;
 
-  VELOX_CHECK_LT(subGroup, match.size());
+  if (begin < end && *begin == '?') {
+    p = begin + 1;
+    while (p < end && *p != '#') {
+      ++p;
+    }
+    components.query = StringView(begin + 1, p - begin - 1);
+    begin = p;
+  }
 
-  if (match[subGroup].matched) {
-    return submatch(match, subGroup);
+  if (begin < end && *begin == '#') {
+    components.fragment = StringView(begin + 1, end - begin - 1);
   }
+  return components;
+}
+
+/// The host and port of a URL authority.
+struct UrlHostAndPort {
+  StringView host;
+  /// Set if there is a ':' after the host. May be empty.
+  std::optional<StringView> port;
+};
 
-  return std::nullopt;
+/// Parses an authority without the leading "//" as
+///
+///   (?:([^@:]*)(?::([^@]*))?@)?(\[[^\]]*\]|[^\[:]*)(?::(\d*))?
+///
+/// i.e. optional user info, a host that is an IP-literal in brackets, a
+/// dotted IPv4 address or a name, and an optional port. Returns std::nullopt
+/// if the authority does not match.
+std::optional<UrlHostAndPort> parseAuthority(StringView authority);
+
+/// Returns the host of the URL with 'components' or an empty string if there
+/// is none.
+FOLLY_ALWAYS_INLINE StringView extractHost(const UrlComponents& components) {
+  if (components.authority.has_value()) {
+    if (auto hostAndPort = parseAuthority(components.authority.value())) {
+      return hostAndPort->host;
+    }
+  }
+  return StringView();
 }
 
+/// Returns the port of the URL with 'components' or std::nullopt if there is
+/// none or it is not a number.
+FOLLY_ALWAYS_INLINE std::optional<int64_t> extractPort(
+    const UrlComponents& components) {
+  if (!components.authority.has_value()) {
+    return std::nullopt;
+  }
+  auto hostAndPort = parseAuthority(components.authority.value());
+  if (!hostAndPort.has_value() || !hostAndPort->port.has_value() ||
+      hostAndPort->port->empty()) {
+    return std::nullopt;
+  }
+  auto port = folly::tryTo<int64_t>(
+      folly::StringPiece(hostAndPort->port->data(), hostAndPort->port->size()));
+  if (port.hasError()) {
+    return std::nullopt;
+  }
+  return port.value();
+}
+
+/// Returns the still escaped value of the first parameter called 'name' in
+/// 'query' or std::nullopt if there is none. Parameters are separated by '&'.
+/// A parameter without '=' has an empty value. Parameters with more than one
+/// '=' are skipped.
+std::optional<StringView> findQueryParameter(
+    StringView query,
+    StringView name);
+
 FOLLY_ALWAYS_INLINE unsigned char toHex(unsigned char c) {
   return c < 10 ? (c + '0') : (c + 'A' - 10);
 }
@@ -205,14 +262,6 @@ FOLLY_ALWAYS_INLINE void urlUnescape(
   output.resize(outputBuffer - output.data());
 }
 
-/// Matches the authority (i.e host[:port], ipaddress), and path from a string
-/// representing the authority and path. Returns true if the regex matches, and
-/// sets the appropriate groups matching authority in authorityMatch.
-std::optional<StringView> matchAuthorityAndPath(
-    StringView authorityAndPath,
-    boost::cmatch& authorityMatch,
-    int subGroup);
-
 } // namespace detail
 
 template <typename T>
@@ -232,7 +281,7 @@ struct UrlExtractProtocolFunction {
       return false;
     }
 
-    if (auto protocol = detail::parse(url, detail::kScheme)) {
+    if (auto protocol = detail::splitUrl(url).scheme) {
       result.setNoCopy(protocol.value());
     } else {
       result.setEmpty();
@@ -258,7 +307,7 @@ struct UrlExtractFragmentFunction {
       return false;
     }
 
-    if (auto fragment = detail::parse(url, detail::kFragment)) {
+    if (auto fragment = detail::splitUrl(url).fragment) {
       result.setNoCopy(fragment.value());
     } else {
       result.setEmpty();
@@ -284,19 +333,7 @@ struct UrlExtractHostFunction {
       return false;
     }
 
-    auto authAndPath = detail::parse(url, detail::kAuthority);
-    if (!authAndPath) {
-      result.setEmpty();
-      return true;
-    }
-    boost::cmatch authorityMatch;
-
-    if (auto host = detail::matchAuthorityAndPath(
-            authAndPath.value(), authorityMatch, detail::kHost)) {
-      result.setNoCopy(host.value());
-    } else {
-      result.setEmpty();
-    }
+    result.setNoCopy(detail::extractHost(detail::splitUrl(url)));
     return true;
   }
 };
@@ -310,21 +347,9 @@ struct UrlExtractPortFunction {
       return false;
     }
 
-    auto authAndPath = detail::parse(url, detail::kAuthority);
-    if (!authAndPath) {
-      return false;
-    }
-
-    boost::cmatch authorityMatch;
-    if (auto port = detail::matchAuthorityAndPath(
-            authAndPath.value(), authorityMatch, detail::kPort)) {
-      if (!port.value().empty()) {
-        try {
-          result = to<int64_t>(port.value());
-          return true;
-        } catch (folly::ConversionError const&) {
-        }
-      }
+    if (auto port = detail::extractPort(detail::splitUrl(url))) {
+      result = port.value();
+      return true;
     }
     return false;
   }
@@ -343,10 +368,7 @@ struct UrlExtractPathFunction {
       return false;
     }
 
-    auto path = detail::parse(url, detail::kPath);
-    VELOX_USER_CHECK(
-        path.has_value(), "Unable to determine path for URL: {}", url);
-    detail::urlUnescape(result, path.value());
+    detail::urlUnescape(result, detail::splitUrl(url).path);
 
     return true;
   }
@@ -369,7 +391,7 @@ struct UrlExtractQueryFunction {
       return false;
     }
 
-    if (auto query = detail::parse(url, detail::kQuery)) {
+    if (auto query = detail::splitUrl(url).query) {
       result.setNoCopy(query.value());
     } else {
       result.setEmpty();
@@ -397,39 +419,15 @@ struct UrlExtractParameterFunction {
       return false;
     }
 
-    auto query = detail::parse(url, detail::kQuery);
+    auto query = detail::splitUrl(url).query;
     if (!query) {
       return false;
     }
 
-    if (!query.value().empty()) {
-      // Parse query string.
-      static const boost::regex kQueryParamRegex(
-          "(^|&)" // start of query or start of parameter "&"
-          "([^=&]*)=?" // parameter name and "=" if value is expected
-          "([^=&]*)" // parameter value
-          "(?=(&|$))" // forward reference, next should be end of query or
-                      // start of next parameter
-      );
-
-      const boost::cregex_iterator begin(
-          query.value().data(),
-          query.value().data() + query.value().size(),
-          kQueryParamRegex);
-      boost::cregex_iterator end;
-
-      for (auto it = begin; it != end; ++it) {
-        if (it->length(2) != 0 && (*it)[2].matched) { // key shouldnt be empty.
-          auto key = detail::submatch((*it), 2);
-          if (param.compare(key) == 0) {
-            auto value = detail::submatch((*it), 3);
-            detail::urlUnescape(result, value);
-            return true;
-          }
-        }
-      }
+    if (auto value = detail::findQueryParameter(query.value(), param)) {
+      detail::urlUnescape(result, value.value());
+      return true;
     }
-
     return false;
   }
 };
@@ -456,4 +454,24 @@ struct UrlDecodeFunction {
   }
 };
 
+/// Fuses the url_extract_* calls on the same input into a single
+/// $internal$url_extract call that splits each URL once and returns a ROW
+/// with one field per extracted part. Each original call becomes a
+/// dereference of that ROW. Only url_extract_parameter calls with a constant
+/// parameter name are fused.
+///
+/// For example,
+///
+/// Rewrites
+///     url_extract_host(c0), url_extract_parameter(c0, 'q')
+/// into
+///     $internal$url_extract(c0, 'host', 'parameter:q')[host],
+///     $internal$url_extract(c0, 'host', 'parameter:q')[parameter:q]
+///
+/// Doesn't look into lambdas. Returns an empty vector if no input has more
+/// than one distinct part extracted.
+std::vector<core::TypedExprPtr> rewriteUrlExtractCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
 } // namespace facebook::velox::functions
@@ -54,6 +54,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(folly::Range<const T*> values) {
+    sketch_.insert(values);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -408,20 +412,20 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         checkWeight(weight);
         accumulator->append(value, weight);
       });
+    } else if (
+        decodedValue_.isIdentityMapping() && !decodedValue_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      accumulator->append(folly::Range(
+          decodedValue_.data<T>() + rows.begin(), rows.end() - rows.begin()));
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      // Collects the batch to insert it into the sketch in bulk.
+      values_.clear();
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          values_.push_back(decodedValue_.valueAt<T>(row));
+        }
+      });
+      accumulator->append(folly::Range(values_.data(), values_.size()));
     }
   }
 
@@ -645,6 +649,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Non-null values of the current batch of a global aggregation.
+  std::vector<T> values_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
@@ -109,9 +109,7 @@ class ArrayAggAggregate : public exec::Aggregate {
         clearNull(rawNulls, i);
 
         ValueListReader reader(values);
-        for (auto index = 0; index < arraySize; ++index) {
-          reader.next(*elements, offset + index);
-        }
+        reader.readAll(*elements, offset);
         vector->setOffsetAndSize(i, offset, arraySize);
         offset += arraySize;
       } else {
@@ -940,6 +940,7 @@ template <
     class TNumericN>
 exec::AggregateRegistrationResult registerMinMax(
     const std::string& name,
+    exec::SlidingFrameAggregate slidingFrameAggregate,
     bool withCompanionFunctions,
     bool overwrite) {
   std::vector<std::shared_ptr<exec::AggregateFunctionSignature>> signatures;
@@ -1061,7 +1062,7 @@ exec::AggregateRegistrationResult registerMinMax(
           }
         }
       },
-      {false /*orderSensitive*/},
+      {false /*orderSensitive*/, slidingFrameAggregate},
       withCompanionFunctions,
       overwrite);
 }
@@ -1073,9 +1074,15 @@ void registerMinMaxAggregates(
     bool withCompanionFunctions,
     bool overwrite) {
   registerMinMax<MinAggregate, NonNumericMinAggregate, MinNAggregate>(
-      prefix + kMin, withCompanionFunctions, overwrite);
+      prefix + kMin,
+      exec::SlidingFrameAggregate::kMin,
+      withCompanionFunctions,
+      overwrite);
   registerMinMax<MaxAggregate, NonNumericMaxAggregate, MaxNAggregate>(
-      prefix + kMax, withCompanionFunctions, overwrite);
+      prefix + kMax,
+      exec::SlidingFrameAggregate::kMax,
+      withCompanionFunctions,
+      overwrite);
 }
 
 } // namespace facebook::velox::aggregate::prestosql
@@ -1213,6 +1213,9 @@ exec::AggregateRegistrationResult registerMinMaxBy(
               resultType, argTypes[0], argTypes[1], errorMessage, true);
         }
       },
+      {true /*orderSensitive*/,
+       isMaxFunc ? exec::SlidingFrameAggregate::kMaxBy
+                 : exec::SlidingFrameAggregate::kMinBy},
       withCompanionFunctions,
       overwrite);
 }
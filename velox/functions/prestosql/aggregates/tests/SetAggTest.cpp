@@ -692,6 +692,34 @@ TEST_F(SetAggTest, inputOrder) {
   assertQuery(plan, expected);
 }
 
+TEST_F(SetAggTest, manyValues) {
+  // Verifies that values keep their input order when a set outgrows its
+  // inline storage and moves to a hash table.
+  std::vector<std::optional<int64_t>> values;
+  std::vector<std::optional<int64_t>> uniqueValues;
+  for (auto i = 0; i < 100; ++i) {
+    std::optional<int64_t> value;
+    if (i != 5) {
+      value = i % 3 == 0 ? i / 2 : 1'000 - i / 2;
+    }
+    values.push_back(value);
+    if (std::find(uniqueValues.begin(), uniqueValues.end(), value) ==
+        uniqueValues.end()) {
+      uniqueValues.push_back(value);
+    }
+  }
+
+  auto data = makeRowVector({makeNullableFlatVector<int64_t>(values)});
+  auto expected =
+      makeRowVector({makeNullableArrayVector<int64_t>({uniqueValues})});
+
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .singleAggregation({}, {"set_agg(c0)"})
+                  .planNode();
+  assertQuery(plan, expected);
+}
+
 TEST_F(SetAggTest, nans) {
   // Verify that NaNs with different binary representations are considered equal
   // and deduplicated.
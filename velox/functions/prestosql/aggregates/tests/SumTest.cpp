@@ -368,6 +368,32 @@ TEST_F(SumTest, boolKey) {
       vectors, {"c0"}, {"sum(c1)"}, "SELECT c0, sum(c1) FROM tmp GROUP BY 1");
 }
 
+TEST_F(SumTest, clusteredKeys) {
+  // Runs of rows of the same group are accumulated before the group is
+  // updated. Some runs continue across batches.
+  vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(
+             size, [&](auto row) { return (i * size + row) / 300; }),
+         makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+         makeFlatVector<double>(size, [](auto row) { return row * 0.5; })}));
+  }
+  createDuckDbTable(vectors);
+
+  testAggregations(
+      vectors,
+      {"c0"},
+      {"sum(c1)", "min(c1)", "max(c2)", "avg(c2)"},
+      "SELECT c0, sum(c1), min(c1), max(c2), avg(c2) FROM tmp GROUP BY 1");
+  testAggregations(
+      vectors,
+      {},
+      {"sum(c1)", "min(c1)", "max(c2)", "avg(c2)"},
+      "SELECT sum(c1), min(c1), max(c2), avg(c2) FROM tmp");
+}
+
 TEST_F(SumTest, emptyValues) {
   auto rowType = ROW({"c0", "c1"}, {INTEGER(), BIGINT()});
   auto vector = makeRowVector(
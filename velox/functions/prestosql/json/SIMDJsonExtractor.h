@@ -57,6 +57,11 @@ class SIMDJsonExtractor {
   /// the callers of simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns a new SIMDJsonExtractor for 'path' that is not shared with other
+  /// callers. Use this to compile a constant path once, e.g. in initialize().
+  /// Throws if 'path' is invalid.
+  static std::shared_ptr<SIMDJsonExtractor> compile(folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -147,12 +152,9 @@ simdjson::error_code SIMDJsonExtractor::extract(
  */
 template <typename TConsumer>
 simdjson::error_code simdJsonExtract(
-    const velox::StringView& json,
+    simdjson::ondemand::document& jsonDoc,
     SIMDJsonExtractor& extractor,
     TConsumer&& consumer) {
-  simdjson::padded_string paddedJson(json.data(), json.size());
-  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
     // document.  Note, we cannot convert this to a value as this is not
@@ -163,4 +165,16 @@ simdjson::error_code simdJsonExtract(
   return extractor.extract(value, std::forward<TConsumer>(consumer));
 }
 
+/// Same as above for a document that has not been parsed yet.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    const velox::StringView& json,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
+  simdjson::padded_string paddedJson(json.data(), json.size());
+  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  return simdJsonExtract(
+      jsonDoc, extractor, std::forward<TConsumer>(consumer));
+}
+
 } // namespace facebook::velox::functions
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 
@@ -71,6 +72,12 @@ void registerJsonFunctions(const std::string& prefix) {
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_format, prefix + "json_format");
 
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_parse, prefix + "json_parse");
+
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_json_extract_scalar_multi, "$internal$json_extract_scalar");
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalarCalls(prefix, exprs);
+  });
 }
 
 } // namespace facebook::velox::functions
@@ -164,6 +164,13 @@ void registerStringFunctions(const std::string& prefix) {
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerStatefulVectorFunction(
+      "$internal$like_any", matchAnySignatures(), makeLikeAny);
+  exec::registerStatefulVectorFunction(
+      "$internal$regexp_like_any", matchAnySignatures(), makeRe2SearchAny);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteMatchAnyCall(prefix, expr);
+  });
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
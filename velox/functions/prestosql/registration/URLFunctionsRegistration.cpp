@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/StringFunctions.h"
 #include "velox/functions/prestosql/URLFunctions.h"
@@ -39,5 +40,11 @@ void registerURLFunctions(const std::string& prefix) {
       {prefix + "url_encode"});
   registerFunction<UrlDecodeFunction, Varchar, Varchar>(
       {prefix + "url_decode"});
+
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_url_extract_multi, "$internal$url_extract");
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteUrlExtractCalls(prefix, exprs);
+  });
 }
 } // namespace facebook::velox::functions
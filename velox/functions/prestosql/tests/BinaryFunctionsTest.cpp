@@ -337,6 +337,13 @@ TEST_F(BinaryFunctionsTest, toHex) {
   EXPECT_EQ(
       "D763DAB175DA5814349354FCF23885",
       toHexFromBase64("12PasXXaWBQ0k1T88jiF"));
+
+  const auto toHexFromHex = [&](std::optional<std::string> value) {
+    return evaluateOnce<std::string>("to_hex(from_hex(c0))", value);
+  };
+  EXPECT_EQ(
+      "000102030405060708090A0B0C0D0E0F7F80FEFF",
+      toHexFromHex("000102030405060708090a0b0c0d0e0f7f80feff"));
 }
 
 TEST_F(BinaryFunctionsTest, fromHex) {
@@ -362,6 +369,12 @@ TEST_F(BinaryFunctionsTest, fromHex) {
   EXPECT_THROW(fromHex("f`"), VeloxUserError);
   EXPECT_THROW(fromHex("fg"), VeloxUserError);
   EXPECT_THROW(fromHex("fff"), VeloxUserError);
+  EXPECT_EQ(
+      "Hello World from Velox!",
+      fromHex("48656c6c6f20576f726c642066726f6d2056656c6f7821"));
+  VELOX_ASSERT_THROW(
+      fromHex("48656c6c6f20576f726c6420667g6f6d2056656c6f7821"),
+      "Invalid hex character: g");
 
   const auto fromHexToBase64 = [&](std::optional<std::string> value) {
     return evaluateOnce<std::string>("to_base64(from_hex(c0))", value);
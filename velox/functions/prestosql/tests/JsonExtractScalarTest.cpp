@@ -235,6 +235,54 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+// Extractions with constant paths from the same input are fused into one
+// call that parses each document once. Results must match separate calls.
+TEST_F(JsonExtractScalarTest, fusedPaths) {
+  auto data = makeRowVector({makeNullableFlatVector<StringView>(
+      {R"({"a": 1, "b": "x", "c": [true]})",
+       std::nullopt,
+       R"({"a": 2, "b": "x)",
+       R"({"b": {"c": 3}, "c": [false, 1]})",
+       R"([1, 2, 3])"},
+      JSON())});
+
+  const std::vector<std::string> expressions = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b')",
+      "json_extract_scalar(c0, '$.c[0]')",
+      "concat(json_extract_scalar(c0, '$.a'), json_extract_scalar(c0, '$[1]'))",
+  };
+  auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+  ASSERT_EQ(exprSet->exprs().size(), expressions.size());
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_scalar"),
+      std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(expressions.size());
+  exprSet->eval(rows, context, results);
+
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    velox::test::assertEqualVectors(
+        evaluate(expressions[i], data), results[i]);
+  }
+
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<StringView>(
+          {"1", std::nullopt, std::nullopt, std::nullopt, std::nullopt}),
+      results[0]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<StringView>(
+          {"x", std::nullopt, std::nullopt, std::nullopt, std::nullopt}),
+      results[1]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<StringView>(
+          {"true", std::nullopt, std::nullopt, "false", std::nullopt}),
+      results[2]);
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
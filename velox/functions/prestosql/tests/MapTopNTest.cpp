@@ -114,5 +114,35 @@ TEST_F(MapTopNTest, equalValues) {
   assertEqualVectors(expectedResults, result);
 }
 
+TEST_F(MapTopNTest, largeMaps) {
+  // Every value appears twice in each map, so ties are broken by key.
+  constexpr int32_t kMapSize = 100;
+  constexpr int32_t kNumRows = 10;
+  constexpr int32_t kN = 7;
+  auto valueAt = [](auto row, auto key) { return (key * 37 + row) % 50; };
+  auto data = makeRowVector({makeMapVector<int32_t, int64_t>(
+      kNumRows,
+      [](auto /*row*/) { return kMapSize; },
+      [](auto i) { return i % kMapSize; },
+      [&](auto i) { return valueAt(i / kMapSize, i % kMapSize); })});
+
+  std::vector<std::vector<std::pair<int32_t, std::optional<int64_t>>>>
+      expectedMaps;
+  for (auto row = 0; row < kNumRows; ++row) {
+    std::vector<std::pair<int64_t, int32_t>> entries;
+    for (auto key = 0; key < kMapSize; ++key) {
+      entries.push_back({valueAt(row, key), key});
+    }
+    std::sort(entries.rbegin(), entries.rend());
+    auto& expectedMap = expectedMaps.emplace_back();
+    for (auto i = 0; i < kN; ++i) {
+      expectedMap.push_back({entries[i].second, entries[i].first});
+    }
+  }
+
+  auto result = evaluate(fmt::format("map_top_n(c0, {})", kN), data);
+  assertEqualVectors(makeMapVector<int32_t, int64_t>(expectedMaps), result);
+}
+
 } // namespace
 } // namespace facebook::velox::functions
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <random>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/functions/Udf.h"
@@ -289,6 +290,50 @@ TEST_F(SplitTest, split) {
   }
 }
 
+/// Test the single byte delimiter path on strings longer than a SIMD register.
+TEST_F(SplitTest, longStrings) {
+  std::mt19937 rng(1);
+  std::vector<std::string> inputStrings;
+  for (auto i = 0; i < 200; ++i) {
+    std::string input;
+    const int32_t length = rng() % 300;
+    for (auto j = 0; j < length; ++j) {
+      input.push_back(rng() % 8 == 0 ? '|' : 'a' + rng() % 26);
+    }
+    inputStrings.push_back(std::move(input));
+  }
+  // Delimiters at the start, at the end and in runs.
+  inputStrings.push_back(std::string(70, '|'));
+  inputStrings.push_back("|" + std::string(63, 'x') + "|");
+
+  auto split = [&](const std::string& input, int32_t limit) {
+    std::vector<std::string> elements;
+    size_t start = 0;
+    for (auto end = input.find('|');
+         end != std::string::npos &&
+         elements.size() + 1 != static_cast<size_t>(limit);
+         end = input.find('|', start)) {
+      elements.push_back(input.substr(start, end - start));
+      start = end + 1;
+    }
+    elements.push_back(input.substr(start));
+    return elements;
+  };
+
+  for (const auto limit : {-1, 1, 2, 5}) {
+    std::vector<std::vector<std::string>> expectedArrays;
+    for (const auto& input : inputStrings) {
+      expectedArrays.push_back(split(input, limit));
+    }
+    auto actual = run(
+        inputStrings,
+        "|",
+        limit < 0 ? "split(C0, C1)" : "split(C0, C1, C2)",
+        limit);
+    assertEqualVectors(toArrayVector(expectedArrays), actual);
+  }
+}
+
 /// Test split vector function with errors.
 TEST_F(SplitTest, splitError) {
   const std::string delim = ",";
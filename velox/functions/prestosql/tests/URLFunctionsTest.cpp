@@ -210,5 +210,66 @@ TEST_F(URLFunctionsTest, urlDecode) {
   EXPECT_THROW(urlDecode("http%3A%2F%2H"), VeloxUserError);
 }
 
+// Extractions from the same URL are fused into one call that splits each URL
+// once. Results must match separate calls.
+TEST_F(URLFunctionsTest, fusedExtractions) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>({
+      "http://user:pw@example.com:8080/a%20b/c.php?k1=v1&k2=v%2B2#Ref1",
+      std::nullopt,
+      "https://[2001:db8::1]:x/path?k2&k1=",
+      "mailto:java-net@java.sun.com",
+      "BAD URL!",
+      "foo?k1=a=b&k1=c",
+      "http://www.yahoo.com",
+  })});
+
+  const std::vector<std::string> expressions = {
+      "url_extract_protocol(c0)",
+      "url_extract_host(c0)",
+      "url_extract_port(c0)",
+      "url_extract_path(c0)",
+      "url_extract_query(c0)",
+      "url_extract_fragment(c0)",
+      "url_extract_parameter(c0, 'k1')",
+      "concat(url_extract_host(c0), url_extract_parameter(c0, 'k2'))",
+  };
+  auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+  ASSERT_EQ(exprSet->exprs().size(), expressions.size());
+  ASSERT_NE(
+      exprSet->toString().find("$internal$url_extract"), std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(expressions.size());
+  exprSet->eval(rows, context, results);
+
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    velox::test::assertEqualVectors(
+        evaluate(expressions[i], data), results[i]);
+  }
+
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>(
+          {8080,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt}),
+      results[2]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {"v1",
+           std::nullopt,
+           "",
+           std::nullopt,
+           std::nullopt,
+           "c",
+           std::nullopt}),
+      results[6]);
+}
+
 } // namespace
 } // namespace facebook::velox
@@ -233,6 +233,75 @@ TEST_F(AggregateWindowTest, testDecimal) {
   testAggregate(DECIMAL(20, 5));
 }
 
+// Tests sliding frames over large partitions. These are aggregated using a
+// segment tree of intermediate results.
+TEST_F(AggregateWindowTest, slidingFramesLargePartition) {
+  const vector_size_t size = 5'000;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return (row * 7) % 101 - 50; },
+          [](auto row) { return row % 17 == 0; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 50 + 1; }),
+  });
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 70 preceding and 65 following",
+      "rows between c3 preceding and 200 following",
+      "rows between 1000 preceding and 1 preceding",
+      "rows between current row and unbounded following",
+  };
+  const std::vector<std::string> overClauses = {
+      "order by c1", "partition by c0 order by c1"};
+
+  for (const auto& function :
+       {"sum(c2)", "min(c2)", "max(c2)", "count(c2)", "avg(c2)", "sum(1)"}) {
+    WindowTestBase::testWindowFunction(
+        {input}, function, overClauses, frameClauses);
+  }
+}
+
+// Tests min, max, min_by and max_by over frames that slide over the
+// partition. These are computed incrementally using a monotonic deque, except
+// for frames with a varying offset that may move backwards.
+TEST_F(AggregateWindowTest, slidingMinMax) {
+  const vector_size_t size = 5'000;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return (row * 7) % 101 - 50; },
+          [](auto row) { return row % 17 == 0; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 50 + 1; }),
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return (row * 37) % size; },
+          [](auto row) { return row % 23 == 0; }),
+  });
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 3 preceding and 2 following",
+      "rows between 1000 preceding and 1 preceding",
+      "rows between 5 following and 50 following",
+      "rows between c3 preceding and 200 following",
+      "range between unbounded preceding and current row",
+      "range between current row and unbounded following",
+  };
+  const std::vector<std::string> overClauses = {
+      "order by c1", "partition by c0 order by c1"};
+
+  for (const auto& function :
+       {"min(c2)", "max(c2)", "min_by(c2, c4)", "max_by(c2, c4)"}) {
+    WindowTestBase::testWindowFunction(
+        {input}, function, overClauses, frameClauses);
+  }
+}
+
 TEST_F(AggregateWindowTest, integerOverflowRowsFrame) {
   auto c0 = makeFlatVector<int64_t>({-1, -1, -1, -1, -1, -1, 2, 2, 2, 2});
   auto c1 = makeFlatVector<double>({-1, -2, -3, -4, -5, -6, -7, -8, -9, -10});
@@ -77,12 +77,32 @@ class RemoteFunction : public exec::VectorFunction {
       const TypePtr& outputType,
       exec::EvalCtx& context,
       VectorPtr& result) const {
+    // Sends only the selected rows. When some rows are not selected, e.g.
+    // under a conditional, the arguments are wrapped in a dictionary over the
+    // selected rows and the result is scattered back with another one.
+    const auto numRows = rows.countSelected();
+    BufferPtr resultIndices;
+    if (numRows < rows.end()) {
+      auto argIndices = allocateIndices(numRows, context.pool());
+      resultIndices = allocateIndices(rows.end(), context.pool());
+      auto* rawArgIndices = argIndices->asMutable<vector_size_t>();
+      auto* rawResultIndices = resultIndices->asMutable<vector_size_t>();
+      vector_size_t i = 0;
+      rows.applyToSelected([&](vector_size_t row) {
+        rawArgIndices[i] = row;
+        rawResultIndices[row] = i++;
+      });
+      for (auto& arg : args) {
+        arg = BaseVector::wrapInDictionary(nullptr, argIndices, numRows, arg);
+      }
+    }
+
     // Create type and row vector for serialization.
     auto remoteRowVector = std::make_shared<RowVector>(
         context.pool(),
         remoteInputType_,
         BufferPtr{},
-        rows.end(),
+        numRows,
         std::move(args));
 
     // Send to remote server.
@@ -99,9 +119,8 @@ class RemoteFunction : public exec::VectorFunction {
     requestInputs->rowCount_ref() = remoteRowVector->size();
     requestInputs->pageFormat_ref() = serdeFormat_;
 
-    // TODO: serialize only active rows.
     requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
+        remoteRowVector, numRows, *context.pool(), serde_.get());
 
     try {
       thriftClient_->sync_invokeFunction(remoteResponse, request);
@@ -119,6 +138,10 @@ class RemoteFunction : public exec::VectorFunction {
         *context.pool(),
         serde_.get());
     result = outputRowVector->childAt(0);
+    if (resultIndices != nullptr) {
+      result = BaseVector::wrapInDictionary(
+          nullptr, resultIndices, rows.end(), result);
+    }
   }
 
   const std::string functionName_;
@@ -151,6 +151,16 @@ TEST_P(RemoteFunctionTest, string) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, someRowsSelected) {
+  // Only the rows where c0 is odd are sent to the server.
+  auto inputVector = makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6});
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "if(c0 % 2 = 1, remote_plus(c0, c0), c0)", makeRowVector({inputVector}));
+
+  auto expected = makeFlatVector<int64_t>({2, 2, 6, 4, 10, 6});
+  assertEqualVectors(expected, results);
+}
+
 TEST_P(RemoteFunctionTest, connectionError) {
   auto inputVector = makeFlatVector<int64_t>({1, 2, 3, 4, 5});
   auto func = [&]() {
@@ -265,6 +265,59 @@ class RowVectorHasher : public SparkVectorHasher<HashClass> {
   std::vector<std::shared_ptr<SparkVectorHasher<HashClass>>> hashers_;
 };
 
+template <typename HashClass, typename T, typename ReturnType>
+void hashFlatValues(
+    const T* values,
+    const SelectivityVector& rows,
+    ReturnType* rawResult) {
+  if (rows.isAllSelected()) {
+    // A loop without calls or branches which the compiler can vectorize.
+    for (auto row = rows.begin(); row < rows.end(); ++row) {
+      rawResult[row] = hashOne<HashClass>(values[row], rawResult[row]);
+    }
+    return;
+  }
+  rows.applyToSelected([&](auto row) {
+    rawResult[row] = hashOne<HashClass>(values[row], rawResult[row]);
+  });
+}
+
+// Folds the values of a flat column of a fixed-width type into the hashes in
+// 'rawResult' for all 'rows' at once, without the virtual call and the
+// decoding of SparkVectorHasher per row. Returns false if 'decoded' is not
+// such a column.
+template <typename HashClass, typename ReturnType>
+bool hashFlatColumn(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    ReturnType* rawResult) {
+  if (!decoded.isIdentityMapping()) {
+    return false;
+  }
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      hashFlatValues<HashClass>(decoded.data<int8_t>(), rows, rawResult);
+      return true;
+    case TypeKind::SMALLINT:
+      hashFlatValues<HashClass>(decoded.data<int16_t>(), rows, rawResult);
+      return true;
+    case TypeKind::INTEGER:
+      hashFlatValues<HashClass>(decoded.data<int32_t>(), rows, rawResult);
+      return true;
+    case TypeKind::BIGINT:
+      hashFlatValues<HashClass>(decoded.data<int64_t>(), rows, rawResult);
+      return true;
+    case TypeKind::REAL:
+      hashFlatValues<HashClass>(decoded.data<float>(), rows, rawResult);
+      return true;
+    case TypeKind::DOUBLE:
+      hashFlatValues<HashClass>(decoded.data<double>(), rows, rawResult);
+      return true;
+    default:
+      return false;
+  }
+}
+
 // ReturnType can be either int32_t or int64_t
 // HashClass contains the function like hashInt32
 template <
@@ -296,6 +349,10 @@ void applyWithType(
       selected = selectedMinusNulls.get();
     }
 
+    if (hashFlatColumn<HashClass>(
+            *decoded, *selected, result.mutableRawValues())) {
+      continue;
+    }
     auto hasher = createVectorHasher<HashClass>(*decoded);
     selected->applyToSelected([&](auto row) {
       result.set(row, hasher->hashNotNullAt(row, result.valueAt(row)));
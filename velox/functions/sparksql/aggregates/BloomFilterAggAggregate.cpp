@@ -52,7 +52,11 @@ struct BloomFilterAccumulator {
   }
 
   void insert(int64_t value) {
-    bloomFilter.insert(folly::hasher<int64_t>()(value));
+    bloomFilter.insert(hash(value));
+  }
+
+  static uint64_t hash(int64_t value) {
+    return folly::hasher<int64_t>()(value);
   }
 
   BloomFilter<StlAllocator<uint64_t>> bloomFilter;
@@ -140,12 +144,17 @@ class BloomFilterAggAggregate : public exec::Aggregate {
       return;
     }
     auto mayHaveNulls = decodedRaw_.mayHaveNulls();
+    // Hash the values first and insert them in batches.
+    hashes_.resize(rows.end());
+    int32_t numHashes = 0;
     rows.applyToSelected([&](vector_size_t row) {
       if (mayHaveNulls) {
         checkBloomFilterNotNull(decodedRaw_, row);
       }
-      accumulator->insert(decodedRaw_.valueAt<int64_t>(row));
+      hashes_[numHashes++] =
+          BloomFilterAccumulator::hash(decodedRaw_.valueAt<int64_t>(row));
     });
+    accumulator->bloomFilter.insert(hashes_.data(), numHashes);
   }
 
   void addSingleGroupIntermediateResults(
@@ -284,6 +293,8 @@ class BloomFilterAggAggregate : public exec::Aggregate {
   int64_t estimatedNumItems_ = kMissingArgument;
   int64_t numBits_ = kMissingArgument;
   int32_t capacity_ = kMissingArgument;
+  // Reusable buffer for the hashes of the input values.
+  std::vector<uint64_t> hashes_;
 };
 
 } // namespace
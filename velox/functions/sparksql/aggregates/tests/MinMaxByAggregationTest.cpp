@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/functions/lib/aggregates/tests/utils/AggregationTestBase.h"
 #include "velox/functions/sparksql/aggregates/Register.h"
@@ -214,5 +215,34 @@ TEST_F(MinMaxByAggregateTest, rowCompare) {
       {data}, {}, {"spark_min_by(c0, c1)", "spark_max_by(c0, c1)"}, {expected});
 }
 
+// Spark min_by and max_by return the last of the rows with the same
+// comparison value, also over sliding window frames.
+TEST_F(MinMaxByAggregateTest, slidingWindowTies) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>({10, 11, 12, 13, 14, 15}),
+      makeFlatVector<int32_t>({3, 3, 1, 3, 1, 1}),
+      makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5}),
+  });
+
+  auto plan =
+      exec::test::PlanBuilder()
+          .values({data})
+          .window(
+              {"spark_max_by(c0, c1) over (order by c2 "
+               "rows between 2 preceding and current row)",
+               "spark_min_by(c0, c1) over (order by c2 "
+               "rows between 2 preceding and current row)"})
+          .planNode();
+
+  auto expected = makeRowVector({
+      data->childAt(0),
+      data->childAt(1),
+      data->childAt(2),
+      makeFlatVector<int32_t>({10, 11, 11, 13, 13, 13}),
+      makeFlatVector<int32_t>({10, 11, 12, 12, 14, 15}),
+  });
+  exec::test::AssertQueryBuilder(plan).assertResults(expected);
+}
+
 } // namespace
 } // namespace facebook::velox::functions::aggregate::sparksql::test
@@ -134,6 +134,46 @@ TEST_F(HashTest, Float) {
   EXPECT_EQ(hash<float>(-limits::infinity()), 427440766);
 }
 
+TEST_F(HashTest, flatAndDictionaryColumns) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 7919; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row - 500; }, nullEvery(7)),
+      makeFlatVector<double>(size, [](auto row) { return row / 3.0; }),
+      makeFlatVector<int16_t>(
+          size, [](auto row) { return row; }, nullEvery(5)),
+      makeFlatVector<float>(size, [](auto row) { return row * 0.5f; }),
+  });
+  // Dictionary-encoded columns are hashed one row at a time, flat columns of
+  // fixed-width types one column at a time.
+  std::vector<VectorPtr> dictionaryColumns;
+  for (const auto& column : data->children()) {
+    dictionaryColumns.push_back(wrapInDictionary(
+        makeIndices(size, [](auto row) { return row; }), column));
+  }
+  auto dictionaryData = makeRowVector(dictionaryColumns);
+
+  for (const auto& expression :
+       {"hash(c0, c1, c2, c3, c4)", "xxhash64(c0, c1, c2, c3, c4)"}) {
+    SCOPED_TRACE(expression);
+    assertEqualVectors(
+        evaluate(expression, dictionaryData), evaluate(expression, data));
+
+    // Only some rows are selected.
+    SelectivityVector rows(size);
+    for (auto row = 0; row < size; row += 3) {
+      rows.setValid(row, false);
+    }
+    rows.updateBounds();
+    auto expected = evaluate(expression, dictionaryData);
+    auto actual = evaluate(expression, data, rows);
+    rows.applyToSelected([&](auto row) {
+      ASSERT_TRUE(expected->equalValueAt(actual.get(), row, row));
+    });
+  }
+}
+
 TEST_F(HashTest, array) {
   assertEqualVectors(
       makeFlatVector<int32_t>({2101165938, 42, 1045631400}),
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/row/CompactRow.h"
+
+#include <numeric>
+
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::row {
@@ -420,6 +423,143 @@ int32_t CompactRow::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+namespace {
+// Copies the values of 'decoded' at 'rows' to 'buffer + positions[i]'. The
+// size of a value is a constant, so that the copy is a single load and store.
+template <int32_t kBytes, bool kMayHaveNulls>
+void copyValues(
+    const DecodedVector& decoded,
+    const std::vector<vector_size_t>& rows,
+    const size_t* positions,
+    char* buffer) {
+  const auto* values = decoded.data<char>();
+  for (auto i = 0; i < rows.size(); ++i) {
+    if (kMayHaveNulls && decoded.isNullAt(rows[i])) {
+      continue;
+    }
+    memcpy(
+        buffer + positions[i],
+        values + decoded.index(rows[i]) * kBytes,
+        kBytes);
+  }
+}
+} // namespace
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  std::vector<vector_size_t> rows(size);
+  std::iota(rows.begin(), rows.end(), offset);
+  serialize(
+      folly::Range<const vector_size_t*>(rows.data(), size),
+      bufferOffsets,
+      buffer);
+}
+
+void CompactRow::serialize(
+    folly::Range<const vector_size_t*> rows,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  const auto numRows = rows.size();
+  std::vector<vector_size_t> childRows(numRows);
+  // The write position of the next field of each row. Fields after a
+  // variable-width field start at a different offset in each row.
+  std::vector<size_t> positions(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    childRows[i] = decoded_.index(rows[i]);
+    positions[i] = bufferOffsets[i] + rowNullBytes_;
+  }
+
+  for (auto column = 0; column < children_.size(); ++column) {
+    auto& child = children_[column];
+    if (childIsFixedWidth_[column]) {
+      child.serializeFixedWidthColumn(
+          column, childRows, bufferOffsets, positions.data(), buffer);
+      continue;
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      if (child.isNullAt(childRows[i])) {
+        bits::setBit(
+            reinterpret_cast<uint8_t*>(buffer + bufferOffsets[i]),
+            column,
+            true);
+      } else {
+        positions[i] += child.serializeVariableWidth(
+            childRows[i], buffer + positions[i]);
+      }
+    }
+  }
+}
+
+void CompactRow::serializeFixedWidthColumn(
+    int32_t column,
+    const std::vector<vector_size_t>& rows,
+    const size_t* bufferOffsets,
+    size_t* positions,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  const auto numRows = rows.size();
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  if (mayHaveNulls) {
+    for (auto i = 0; i < numRows; ++i) {
+      if (decoded_.isNullAt(rows[i])) {
+        bits::setBit(
+            reinterpret_cast<uint8_t*>(buffer + bufferOffsets[i]),
+            column,
+            true);
+      }
+    }
+  }
+
+  // BOOLEAN and TIMESTAMP values are converted. Other values are copied with
+  // a constant size. All values may be null if there is no data.
+  if (typeKind_ == TypeKind::BOOLEAN || typeKind_ == TypeKind::TIMESTAMP) {
+    for (auto i = 0; i < numRows; ++i) {
+      if (!mayHaveNulls || !decoded_.isNullAt(rows[i])) {
+        serializeFixedWidth(rows[i], buffer + positions[i]);
+      }
+    }
+  } else if (valueBytes_ > 0 && decoded_.data<char>() != nullptr) {
+    if (mayHaveNulls) {
+      copyFixedWidthColumn<true>(rows, positions, buffer);
+    } else {
+      copyFixedWidthColumn<false>(rows, positions, buffer);
+    }
+  }
+
+  for (auto i = 0; i < numRows; ++i) {
+    positions[i] += valueBytes_;
+  }
+}
+
+template <bool kMayHaveNulls>
+void CompactRow::copyFixedWidthColumn(
+    const std::vector<vector_size_t>& rows,
+    const size_t* positions,
+    char* buffer) {
+  switch (valueBytes_) {
+    case 1:
+      copyValues<1, kMayHaveNulls>(decoded_, rows, positions, buffer);
+      break;
+    case 2:
+      copyValues<2, kMayHaveNulls>(decoded_, rows, positions, buffer);
+      break;
+    case 4:
+      copyValues<4, kMayHaveNulls>(decoded_, rows, positions, buffer);
+      break;
+    case 8:
+      copyValues<8, kMayHaveNulls>(decoded_, rows, positions, buffer);
+      break;
+    case 16:
+      copyValues<16, kMayHaveNulls>(decoded_, rows, positions, buffer);
+      break;
+    default:
+      VELOX_UNREACHABLE("Unexpected value size: {}", valueBytes_);
+  }
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
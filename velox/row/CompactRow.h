@@ -36,6 +36,25 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Serializes rows in the range [offset, offset + size) into 'buffer'. Row
+  /// 'offset + i' is written at 'buffer + bufferOffsets[i]', which must have
+  /// room for the size given by 'fixedRowSize' or 'rowSize'. 'buffer' must be
+  /// set to all zeros. Produces the same bytes as serializing the rows one at
+  /// a time, but goes column by column, so that the type dispatch and null
+  /// checks of a column are done once for all rows.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
+  /// Same as above for the rows in 'rows'. Row 'rows[i]' is written at
+  /// 'buffer + bufferOffsets[i]'.
+  void serialize(
+      folly::Range<const vector_size_t*> rows,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -64,6 +83,24 @@ class CompactRow {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes the fixed-width values at 'rows' as field 'column' of serialized
+  /// rows. The row for 'rows[i]' starts at 'buffer + bufferOffsets[i]' and
+  /// the value goes to 'buffer + positions[i]'. Sets the null flags of null
+  /// values. Advances 'positions' past the values.
+  void serializeFixedWidthColumn(
+      int32_t column,
+      const std::vector<vector_size_t>& rows,
+      const size_t* bufferOffsets,
+      size_t* positions,
+      char* buffer);
+
+  /// Copies the non-null values at 'rows' to 'buffer + positions[i]'.
+  template <bool kMayHaveNulls>
+  void copyFixedWidthColumn(
+      const std::vector<vector_size_t>& rows,
+      const size_t* positions,
+      char* buffer);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
@@ -15,6 +15,8 @@
  */
 #include "velox/row/UnsafeRowFast.h"
 
+#include <numeric>
+
 namespace facebook::velox::row {
 
 namespace {
@@ -31,6 +33,28 @@ int32_t alignBytes(int32_t numBytes) {
 bool isFixedWidth(const TypePtr& type) {
   return type->isFixedWidth() && !type->isLongDecimal();
 }
+
+// Copies the values of 'decoded' at 'rows' to 'valueOffset' bytes after
+// 'buffer + bufferOffsets[i]'. The size of a value is a constant, so that the
+// copy is a single load and store.
+template <int32_t kBytes, bool kMayHaveNulls>
+void copyValues(
+    const DecodedVector& decoded,
+    int32_t valueOffset,
+    const std::vector<vector_size_t>& rows,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  const auto* values = decoded.data<char>();
+  for (auto i = 0; i < rows.size(); ++i) {
+    if (kMayHaveNulls && decoded.isNullAt(rows[i])) {
+      continue;
+    }
+    memcpy(
+        buffer + bufferOffsets[i] + valueOffset,
+        values + decoded.index(rows[i]) * kBytes,
+        kBytes);
+  }
+}
 } // namespace
 
 // static
@@ -155,6 +179,120 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  std::vector<vector_size_t> rows(size);
+  std::iota(rows.begin(), rows.end(), offset);
+  serialize(
+      folly::Range<const vector_size_t*>(rows.data(), size),
+      bufferOffsets,
+      buffer);
+}
+
+void UnsafeRowFast::serialize(
+    folly::Range<const vector_size_t*> rows,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  const auto numRows = rows.size();
+  std::vector<vector_size_t> childRows(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    childRows[i] = decoded_.index(rows[i]);
+  }
+
+  // The offset of the next variable-width value in each row.
+  std::vector<int64_t> variableWidthOffsets(
+      numRows, rowNullBytes_ + kFieldWidth * children_.size());
+  for (auto column = 0; column < children_.size(); ++column) {
+    auto& child = children_[column];
+    const int32_t fieldOffset = rowNullBytes_ + column * kFieldWidth;
+    if (childIsFixedWidth_[column]) {
+      child.serializeFixedWidthColumn(
+          column, fieldOffset, childRows, bufferOffsets, buffer);
+      continue;
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      auto* row = buffer + bufferOffsets[i];
+      if (child.isNullAt(childRows[i])) {
+        bits::setBit(row, column, true);
+        continue;
+      }
+      auto& variableWidthOffset = variableWidthOffsets[i];
+      auto size = child.serializeVariableWidth(
+          childRows[i], row + variableWidthOffset);
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | size;
+      reinterpret_cast<uint64_t*>(row + fieldOffset)[0] = sizeAndOffset;
+
+      variableWidthOffset += alignBytes(size);
+    }
+  }
+}
+
+void UnsafeRowFast::serializeFixedWidthColumn(
+    int32_t column,
+    int32_t valueOffset,
+    const std::vector<vector_size_t>& rows,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  const auto numRows = rows.size();
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  if (mayHaveNulls) {
+    for (auto i = 0; i < numRows; ++i) {
+      if (decoded_.isNullAt(rows[i])) {
+        bits::setBit(buffer + bufferOffsets[i], column, true);
+      }
+    }
+  }
+
+  // BOOLEAN and TIMESTAMP values are converted. Other values are copied with
+  // a constant size. All values may be null if there is no data.
+  if (typeKind_ == TypeKind::BOOLEAN || typeKind_ == TypeKind::TIMESTAMP) {
+    for (auto i = 0; i < numRows; ++i) {
+      if (!mayHaveNulls || !decoded_.isNullAt(rows[i])) {
+        serializeFixedWidth(rows[i], buffer + bufferOffsets[i] + valueOffset);
+      }
+    }
+  } else if (valueBytes_ > 0 && decoded_.data<char>() != nullptr) {
+    if (mayHaveNulls) {
+      copyFixedWidthColumn<true>(valueOffset, rows, bufferOffsets, buffer);
+    } else {
+      copyFixedWidthColumn<false>(valueOffset, rows, bufferOffsets, buffer);
+    }
+  }
+}
+
+template <bool kMayHaveNulls>
+void UnsafeRowFast::copyFixedWidthColumn(
+    int32_t valueOffset,
+    const std::vector<vector_size_t>& rows,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  switch (valueBytes_) {
+    case 1:
+      copyValues<1, kMayHaveNulls>(
+          decoded_, valueOffset, rows, bufferOffsets, buffer);
+      break;
+    case 2:
+      copyValues<2, kMayHaveNulls>(
+          decoded_, valueOffset, rows, bufferOffsets, buffer);
+      break;
+    case 4:
+      copyValues<4, kMayHaveNulls>(
+          decoded_, valueOffset, rows, bufferOffsets, buffer);
+      break;
+    case 8:
+      copyValues<8, kMayHaveNulls>(
+          decoded_, valueOffset, rows, bufferOffsets, buffer);
+      break;
+    default:
+      VELOX_UNREACHABLE("Unexpected value size: {}", valueBytes_);
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
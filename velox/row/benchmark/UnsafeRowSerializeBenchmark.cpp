@@ -40,6 +40,18 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    std::vector<size_t> offsets;
+    auto totalSize = computeOffsets(fast, rowType, data->size(), offsets);
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    fast.serialize(0, data->size(), offsets.data(), buffer->asMutable<char>());
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -65,6 +77,19 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    std::vector<size_t> offsets;
+    auto totalSize = computeOffsets(compact, rowType, data->size(), offsets);
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    compact.serialize(
+        0, data->size(), offsets.data(), buffer->asMutable<char>());
+  }
+
   void deserializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -134,6 +159,25 @@ class SerializeBenchmark {
     return totalSize;
   }
 
+  // Sets 'offsets' to the offsets of consecutive serialized rows and returns
+  // their total size.
+  template <typename Serializer>
+  size_t computeOffsets(
+      Serializer& serializer,
+      const RowTypePtr& rowType,
+      vector_size_t numRows,
+      std::vector<size_t>& offsets) {
+    offsets.resize(numRows);
+    size_t totalSize = 0;
+    const auto fixedRowSize = Serializer::fixedRowSize(rowType);
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize;
+      totalSize += fixedRowSize.has_value() ? fixedRowSize.value()
+                                            : serializer.rowSize(i);
+    }
+    return totalSize;
+  }
+
   std::vector<std::optional<std::string_view>> serialize(
       UnsafeRowFast& unsafeRow,
       vector_size_t numRows,
@@ -205,35 +249,45 @@ class SerializeBenchmark {
       memory::memoryManager()->addLeafPool()};
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)       \
+  BENCHMARK(unsafe_serialize_##name) {        \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafe(rowType);       \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_serialize_batch_##name) {  \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafeBatch(rowType);  \
+  }                                           \
+                                              \
+  BENCHMARK(compact_serialize_##name) {       \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompact(rowType);      \
+  }                                           \
+                                              \
+  BENCHMARK(compact_serialize_batch_##name) { \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompactBatch(rowType); \
+  }                                           \
+                                              \
+  BENCHMARK(container_serialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeContainer(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_deserialize_##name) {      \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeUnsafe(rowType);     \
+  }                                           \
+                                              \
+  BENCHMARK(compact_deserialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeCompact(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(container_deserialize_##name) {   \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeContainer(rowType);  \
   }
 
 SERDE_BENCHMARKS(
@@ -76,6 +76,18 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     VELOX_CHECK_EQ(offset, totalSize);
 
+    // Serializing all rows at once gives the same bytes.
+    std::vector<size_t> bufferOffsets(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      bufferOffsets[i] = serialized[i].data() - rawBuffer;
+    }
+    BufferPtr batchBuffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    row.serialize(
+        0, numRows, bufferOffsets.data(), batchBuffer->asMutable<char>());
+    ASSERT_EQ(
+        std::string_view(rawBuffer, totalSize),
+        std::string_view(batchBuffer->as<char>(), totalSize));
+
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
   }
@@ -179,5 +179,46 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, fastBatch) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      UNKNOWN(),
+      DECIMAL(20, 2),
+      DECIMAL(12, 4),
+      TIMESTAMP(),
+      DATE(),
+      ARRAY(BIGINT()),
+      ARRAY(VARCHAR()),
+      MAP(BIGINT(), DECIMAL(20, 2)),
+      ROW({BOOLEAN(), ROW({INTEGER(), TIMESTAMP()}), VARCHAR()}),
+  });
+
+  doTest(rowType, [&](const RowVectorPtr& data) {
+    // The buffers are consecutive, so that row 'i' goes to 'buffers_[i]'.
+    std::vector<size_t> bufferOffsets(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      bufferOffsets[i] = i * kBufferSize;
+    }
+    UnsafeRowFast fast(data);
+    fast.serialize(0, data->size(), bufferOffsets.data(), buffers_[0]);
+
+    std::vector<std::optional<std::string_view>> serialized;
+    serialized.reserve(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      const auto rowSize = fast.rowSize(i);
+      VELOX_CHECK_LE(rowSize, kBufferSize);
+      serialized.push_back(std::string_view(buffers_[i], rowSize));
+    }
+    return serialized;
+  });
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -17,10 +17,12 @@
 
 #include <optional>
 
+#include <folly/ScopeGuard.h>
 #include <folly/lang/Bits.h>
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/ByteStream.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
@@ -276,6 +278,18 @@ int32_t checkValuesSize(
   return bufferSize;
 }
 
+// Returns the positions of the non-null rows in [begin, end) of 'nulls'.
+// The result is thread local and valid until the next call.
+const raw_vector<int32_t>& nonNullRows(
+    const uint64_t* nulls,
+    vector_size_t begin,
+    vector_size_t end) {
+  thread_local raw_vector<int32_t> rows;
+  rows.resize(end - begin);
+  rows.resize(simd::indicesOfSetBits(nulls, begin, end, rows.data()));
+  return rows;
+}
+
 template <typename T>
 void readValues(
     ByteInputStream* source,
@@ -287,17 +301,26 @@ void readValues(
   if (nullCount) {
     auto bufferSize = checkValuesSize<T>(values, nulls, size, offset);
     auto rawValues = values->asMutable<T>();
-    int32_t toClear = offset;
-    bits::forEachSetBit(
-        nulls->as<uint64_t>(), offset, offset + size, [&](int32_t row) {
-          // Set the values between the last non-null and this to type default.
-          for (; toClear < row; ++toClear) {
-            VELOX_CHECK_LT(toClear, bufferSize);
-            rawValues[toClear] = T();
-          }
-          VELOX_CHECK_LT(row, bufferSize);
-          rawValues[row] = source->read<T>();
-          toClear = row + 1;
+    const auto& rows =
+        nonNullRows(nulls->as<uint64_t>(), offset, offset + size);
+    const auto numValues = rows.size();
+    if (numValues == 0) {
+      return;
+    }
+    const auto end = rows.back() + 1;
+    VELOX_CHECK_LE(end, bufferSize);
+    // The non-null values are contiguous on the wire. Read them in one go
+    // to the start of the range and scatter them to their rows from the
+    // back, so that no value is overwritten before it is moved.
+    source->readBytes(
+        reinterpret_cast<uint8_t*>(rawValues + offset), numValues * sizeof(T));
+    for (auto i = numValues; i-- > 0;) {
+      rawValues[rows[i]] = rawValues[offset + i];
+    }
+    // Set the nulls before the last non-null to type default.
+    bits::forEachUnsetBit(
+        nulls->as<uint64_t>(), offset, end, [&](int32_t row) {
+          rawValues[row] = T();
         });
   } else {
     source->readBytes(
@@ -315,22 +338,30 @@ void readValues<bool>(
     const BufferPtr& values) {
   auto rawValues = values->asMutable<uint64_t>();
   auto bufferSize = checkValuesSize<bool>(values, nulls, size, offset);
+  // Booleans are one byte each on the wire. Read the non-null ones in one
+  // go and then set the bits.
+  thread_local raw_vector<uint8_t> bytes;
   if (nullCount) {
-    int32_t toClear = offset;
-    bits::forEachSetBit(
-        nulls->as<uint64_t>(), offset, offset + size, [&](int32_t row) {
-          // Set the values between the last non-null and this to type default.
-          for (; toClear < row; ++toClear) {
-            VELOX_CHECK_LT(toClear, bufferSize);
-            bits::clearBit(rawValues, toClear);
-          }
-          VELOX_CHECK_LT(row, bufferSize);
-          bits::setBit(rawValues, row, (source->read<int8_t>() != 0));
-          toClear = row + 1;
-        });
+    const auto& rows =
+        nonNullRows(nulls->as<uint64_t>(), offset, offset + size);
+    if (rows.empty()) {
+      return;
+    }
+    const auto end = rows.back() + 1;
+    VELOX_CHECK_LE(end, bufferSize);
+    bytes.resize(rows.size());
+    source->readBytes(bytes.data(), bytes.size());
+    bits::fillBits(rawValues, offset, end, false);
+    for (auto i = 0; i < rows.size(); ++i) {
+      if (bytes[i] != 0) {
+        bits::setBit(rawValues, rows[i]);
+      }
+    }
   } else {
-    for (int32_t row = offset; row < offset + size; ++row) {
-      bits::setBit(rawValues, row, (source->read<int8_t>() != 0));
+    bytes.resize(size);
+    source->readBytes(bytes.data(), size);
+    for (int32_t i = 0; i < size; ++i) {
+      bits::setBit(rawValues, offset + i, bytes[i] != 0);
     }
   }
 }
@@ -3935,6 +3966,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       streams_[i] = std::make_unique<VectorStream>(
           types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
     }
+    if (opts_.preserveEncodings) {
+      runs_.resize(numTypes);
+    }
   }
 
   void append(
@@ -3947,7 +3981,7 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-      serializeColumn(vector->childAt(i), ranges, streams_[i].get(), scratch);
+      appendColumn(i, vector->childAt(i), ranges, numNewRows, scratch);
     }
   }
 
@@ -3961,14 +3995,18 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-      serializeColumn(vector->childAt(i), rows, streams_[i].get(), scratch);
+      appendColumn(i, vector->childAt(i), rows, numNewRows, scratch);
     }
   }
 
   size_t maxSerializedSize() const override {
     size_t dataSize = 4; // streams_.size()
-    for (auto& stream : streams_) {
-      dataSize += stream->serializedSize();
+    for (auto i = 0; i < streams_.size(); ++i) {
+      if (!runs_.empty() && runs_[i].numRows > 0) {
+        dataSize += encodedStream(runs_[i])->serializedSize();
+      } else {
+        dataSize += streams_[i]->serializedSize();
+      }
     }
 
     auto compressedSize = needCompression(*codec_)
@@ -3982,6 +4020,11 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   // checksum(8) | data
   void flush(OutputStream* out) override {
     constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
+    // Flushes the runs in place of their empty flat streams.
+    swapEncodedStreams();
+    SCOPE_EXIT {
+      swapEncodedStreams();
+    };
     if (!needCompression(*codec_)) {
       flushStreams(
           streams_,
@@ -3991,14 +4034,18 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
           opts_.minCompressionRatio,
           out);
     } else {
-      if (numCompressionToSkip_ > 0) {
+      if (numCompressionToSkip_ > 0 ||
+          (opts_.shouldCompress && !opts_.shouldCompress())) {
         const auto noCompressionCodec = common::compressionKindToCodec(
             common::CompressionKind::CompressionKind_NONE);
         auto [size, ignore] = flushStreams(
             streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
         stats_.compressionSkippedBytes += size;
-        --numCompressionToSkip_;
-        ++stats_.numCompressionSkipped;
+        // Only the skips after a compression missed the target back off.
+        if (numCompressionToSkip_ > 0) {
+          --numCompressionToSkip_;
+          ++stats_.numCompressionSkipped;
+        }
       } else {
         auto [size, compressedSize] = flushStreams(
             streams_,
@@ -4036,9 +4083,168 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     for (auto& stream : streams_) {
       stream->clear();
     }
+    for (auto& run : runs_) {
+      run = EncodedRun{};
+    }
   }
 
  private:
+  // Consecutive rows of a column that share a constant value or the values
+  // of a dictionary. Kept as references to the input and serialized with
+  // their encoding at flush instead of being flattened into the stream of
+  // the column. Only used with 'preserveEncodings'.
+  struct EncodedRun {
+    // CONSTANT or DICTIONARY.
+    VectorEncoding::Simple encoding;
+    // The constant vector or the dictionary values.
+    VectorPtr vector;
+    // Indices into the dictionary values.
+    raw_vector<vector_size_t> indices;
+    vector_size_t numRows{0};
+    // True if rows were serialized to the flat stream since the last clear.
+    // No run is started after that.
+    bool flattened{false};
+    // The run serialized with its encoding. Reset when the run grows.
+    std::unique_ptr<VectorStream> stream;
+  };
+
+  template <typename RowsOrRanges>
+  void appendColumn(
+      int32_t column,
+      const VectorPtr& vector,
+      const RowsOrRanges& rows,
+      vector_size_t numRows,
+      Scratch& scratch) {
+    if (runs_.empty()) {
+      serializeColumn(vector, rows, streams_[column].get(), scratch);
+      return;
+    }
+    auto& run = runs_[column];
+    if (appendToRun(run, vector, rows, numRows)) {
+      return;
+    }
+    if (run.numRows > 0) {
+      const IndexRange range{0, run.numRows};
+      serializeColumn(
+          runVector(run),
+          folly::Range(&range, 1),
+          streams_[column].get(),
+          scratch);
+    }
+    run = EncodedRun{};
+    run.flattened = true;
+    serializeColumn(vector, rows, streams_[column].get(), scratch);
+  }
+
+  // Adds 'rows' of 'vector' to 'run' if they start or continue it. Returns
+  // false if 'rows' must be serialized flat.
+  template <typename RowsOrRanges>
+  static bool appendToRun(
+      EncodedRun& run,
+      const VectorPtr& vector,
+      const RowsOrRanges& rows,
+      vector_size_t numRows) {
+    if (run.flattened) {
+      return false;
+    }
+    const auto encoding = vector->encoding();
+    if (run.numRows > 0 && run.encoding != encoding) {
+      return false;
+    }
+    switch (encoding) {
+      case VectorEncoding::Simple::CONSTANT:
+        if (run.numRows > 0 && !isSameConstant(*run.vector, *vector)) {
+          return false;
+        }
+        run.vector = vector;
+        break;
+      case VectorEncoding::Simple::DICTIONARY:
+        // Presto dictionaries cannot have nulls in the wrapper.
+        if (vector->rawNulls() != nullptr ||
+            (run.numRows > 0 && run.vector != vector->valueVector())) {
+          return false;
+        }
+        run.vector = vector->valueVector();
+        appendIndices(vector->wrapInfo()->as<vector_size_t>(), rows, run);
+        break;
+      default:
+        return false;
+    }
+    run.encoding = encoding;
+    run.numRows += numRows;
+    run.stream.reset();
+    return true;
+  }
+
+  static bool isSameConstant(const BaseVector& left, const BaseVector& right) {
+    if (left.isNullAt(0) || right.isNullAt(0)) {
+      return left.isNullAt(0) && right.isNullAt(0);
+    }
+    return left.equalValueAt(&right, 0, 0);
+  }
+
+  static void appendIndices(
+      const vector_size_t* indices,
+      const folly::Range<const IndexRange*>& ranges,
+      EncodedRun& run) {
+    for (const auto& range : ranges) {
+      for (auto i = 0; i < range.size; ++i) {
+        run.indices.push_back(indices[range.begin + i]);
+      }
+    }
+  }
+
+  static void appendIndices(
+      const vector_size_t* indices,
+      const folly::Range<const vector_size_t*>& rows,
+      EncodedRun& run) {
+    for (auto row : rows) {
+      run.indices.push_back(indices[row]);
+    }
+  }
+
+  VectorPtr runVector(const EncodedRun& run) const {
+    if (run.encoding == VectorEncoding::Simple::CONSTANT) {
+      return BaseVector::wrapInConstant(run.numRows, 0, run.vector);
+    }
+    auto indices = allocateIndices(run.numRows, streamArena_->pool());
+    memcpy(
+        indices->asMutable<vector_size_t>(),
+        run.indices.data(),
+        run.numRows * sizeof(vector_size_t));
+    return BaseVector::wrapInDictionary(
+        nullptr, std::move(indices), run.numRows, run.vector);
+  }
+
+  // Returns 'run' serialized with its encoding. The encoding is flattened if
+  // it does not pay off, e.g. for a dictionary without repeated values.
+  VectorStream* encodedStream(EncodedRun& run) const {
+    if (run.stream == nullptr) {
+      auto vector = runVector(run);
+      run.stream = std::make_unique<VectorStream>(
+          vector->type(),
+          std::nullopt,
+          vector,
+          streamArena_,
+          run.numRows,
+          opts_);
+      const IndexRange range{0, run.numRows};
+      Scratch scratch;
+      serializeColumn(
+          vector, folly::Range(&range, 1), run.stream.get(), scratch);
+    }
+    return run.stream.get();
+  }
+
+  void swapEncodedStreams() {
+    for (auto i = 0; i < runs_.size(); ++i) {
+      if (runs_[i].numRows > 0) {
+        encodedStream(runs_[i]);
+        std::swap(streams_[i], runs_[i].stream);
+      }
+    }
+  }
+
   struct CompressionStats {
     // Number of times compression was not attempted.
     int32_t numCompressionSkipped{0};
@@ -4060,6 +4266,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
 
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
+  // A run per column if 'preserveEncodings' is set. Serialized lazily by
+  // maxSerializedSize() or flush().
+  mutable std::vector<EncodedRun> runs_;
 
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <functional>
 #include <string_view>
 
 #include "velox/common/base/Crc.h"
@@ -72,6 +73,18 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// Serializes the constant and dictionary encoded columns appended to an
+    /// iterative serializer as RLE and DICTIONARY columns instead of
+    /// flattening them. Applies while the rows appended to a column since the
+    /// last flush share one constant value or one dictionary values vector.
+    /// The appended vectors are referenced, not copied, until the flush.
+    bool preserveEncodings{false};
+
+    /// If set, the iterative serializer compresses a page only if this
+    /// returns true at flush. Lets the caller spend the CPU for compression
+    /// only when it pays off, e.g. when the network is the bottleneck.
+    std::function<bool()> shouldCompress;
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
@@ -1137,6 +1137,70 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
   ASSERT_EQ(deserialized->childAt(9)->encoding(), VectorEncoding::Simple::FLAT);
 }
 
+TEST_P(PrestoSerializerTest, preserveEncodingsIterativeSerializer) {
+  auto base = makeFlatVector<std::string>(
+      {"aaaaaaaaaaaaaaaaaaaaaaaaaa", "bbbbbbbbbbbbbbbbbbbbbbbbbbbb", "c"});
+  auto makeBatch = [&](int64_t constant, int32_t offset) {
+    auto indices =
+        makeIndices(100, [&](auto row) { return (row + offset) % 3; });
+    return makeRowVector({
+        makeConstant<int64_t>(constant, 100),
+        BaseVector::wrapInDictionary(nullptr, indices, 100, base),
+        makeFlatVector<int32_t>(100, [](auto row) { return row; }),
+    });
+  };
+  const std::vector<RowVectorPtr> batches = {
+      makeBatch(7, 0), makeBatch(7, 1), makeBatch(8, 2)};
+
+  // Serializes 'numBatches' of 'batches' into one page and returns its size.
+  auto serializeBatches =
+      [&](int32_t numBatches, bool preserveEncodings, RowVectorPtr& result) {
+        serializer::presto::PrestoVectorSerde::PrestoOptions options;
+        options.compressionKind = GetParam();
+        options.preserveEncodings = preserveEncodings;
+        auto rowType = asRowType(batches[0]->type());
+        StreamArena arena(pool_.get());
+        auto serializer =
+            serde_->createIterativeSerializer(rowType, 100, &arena, &options);
+        for (auto i = 0; i < numBatches; ++i) {
+          serializer->append(batches[i]);
+        }
+        const auto size = serializer->maxSerializedSize();
+        std::ostringstream output;
+        OStreamOutputStream out(&output);
+        serializer->flush(&out);
+        const auto serialized = output.str();
+        EXPECT_GE(size, serialized.size());
+        auto input = toByteStream(serialized);
+        serde_->deserialize(&input, pool_.get(), rowType, &result, &options);
+        return serialized.size();
+      };
+
+  auto expected = BaseVector::create<RowVector>(batches[0]->type(), 0, pool());
+  RowVectorPtr result;
+  for (int32_t numBatches = 1; numBatches <= 3; ++numBatches) {
+    SCOPED_TRACE(fmt::format("numBatches {}", numBatches));
+    expected->append(batches[numBatches - 1].get());
+    const auto encodedSize = serializeBatches(numBatches, true, result);
+    assertEqualVectors(expected, result);
+    // The third batch has another constant, so the column is flattened.
+    ASSERT_EQ(
+        result->childAt(0)->encoding(),
+        numBatches < 3 ? VectorEncoding::Simple::CONSTANT
+                       : VectorEncoding::Simple::FLAT);
+    ASSERT_EQ(
+        result->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+    ASSERT_EQ(result->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+
+    const auto flatSize = serializeBatches(numBatches, false, result);
+    assertEqualVectors(expected, result);
+    ASSERT_EQ(result->childAt(1)->encoding(), VectorEncoding::Simple::FLAT);
+    if (GetParam() == common::CompressionKind::CompressionKind_NONE) {
+      ASSERT_LT(encodedSize, flatSize);
+    }
+  }
+}
+
 TEST_P(PrestoSerializerTest, emptyVectorBatchVectorSerializer) {
   // Serialize an empty RowVector.
   auto rowVector = makeEmptyTestVector();
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/substrait/SubstraitPlanCache.h"
+
+namespace facebook::velox::substrait {
+
+namespace {
+
+// Returns the input of 'rel' or nullptr if 'rel' has no input. Covers the
+// Rels SubstraitVeloxPlanConverter converts, which have at most one input.
+const ::substrait::Rel* inputOf(const ::substrait::Rel& rel) {
+  if (rel.has_aggregate()) {
+    return &rel.aggregate().input();
+  }
+  if (rel.has_project()) {
+    return &rel.project().input();
+  }
+  if (rel.has_filter()) {
+    return &rel.filter().input();
+  }
+  if (rel.has_fetch()) {
+    return &rel.fetch().input();
+  }
+  if (rel.has_sort()) {
+    return &rel.sort().input();
+  }
+  return nullptr;
+}
+
+::substrait::Rel* mutableInputOf(::substrait::Rel& rel) {
+  if (rel.has_aggregate()) {
+    return rel.mutable_aggregate()->mutable_input();
+  }
+  if (rel.has_project()) {
+    return rel.mutable_project()->mutable_input();
+  }
+  if (rel.has_filter()) {
+    return rel.mutable_filter()->mutable_input();
+  }
+  if (rel.has_fetch()) {
+    return rel.mutable_fetch()->mutable_input();
+  }
+  if (rel.has_sort()) {
+    return rel.mutable_sort()->mutable_input();
+  }
+  return nullptr;
+}
+
+// Returns the ReadRels of 'plan' in the order the converter converts them.
+std::vector<const ::substrait::ReadRel*> readRels(
+    const ::substrait::Plan& plan) {
+  std::vector<const ::substrait::ReadRel*> reads;
+  for (const auto& planRel : plan.relations()) {
+    const auto* rel =
+        planRel.has_root() ? &planRel.root().input() : &planRel.rel();
+    for (; rel != nullptr; rel = inputOf(*rel)) {
+      if (rel->has_read()) {
+        reads.push_back(&rel->read());
+      }
+    }
+  }
+  return reads;
+}
+
+// Returns the serialized 'plan' without the local files of its ReadRels.
+std::string planKey(const ::substrait::Plan& plan) {
+  ::substrait::Plan copy = plan;
+  for (auto& planRel : *copy.mutable_relations()) {
+    auto* rel = planRel.has_root() ? planRel.mutable_root()->mutable_input()
+                                   : planRel.mutable_rel();
+    for (; rel != nullptr; rel = mutableInputOf(*rel)) {
+      if (rel->has_read()) {
+        rel->mutable_read()->clear_local_files();
+      }
+    }
+  }
+  std::string key;
+  VELOX_CHECK(copy.SerializeToString(&key), "Failed to serialize plan");
+  return key;
+}
+
+} // namespace
+
+SubstraitPlanCache::ConvertedPlan SubstraitPlanCache::toVeloxPlan(
+    const ::substrait::Plan& substraitPlan) {
+  const auto key = planKey(substraitPlan);
+  std::shared_ptr<const Entry> entry;
+  {
+    auto cache = cache_.wlock();
+    auto it = cache->find(key);
+    if (it != cache->end()) {
+      entry = it->second;
+    }
+  }
+
+  if (entry == nullptr) {
+    SubstraitVeloxPlanConverter converter(pool_.get());
+    auto newEntry = std::make_shared<Entry>();
+    newEntry->planNode = converter.toVeloxPlan(substraitPlan);
+    for (const auto& [id, _] : converter.splitInfos()) {
+      newEntry->readNodeIds.push_back(id);
+    }
+    // The converter numbers the plan nodes in the order it converts the
+    // Rels.
+    std::sort(
+        newEntry->readNodeIds.begin(),
+        newEntry->readNodeIds.end(),
+        [](const auto& left, const auto& right) {
+          return std::stoll(left) < std::stoll(right);
+        });
+    entry = newEntry;
+    cache_.wlock()->set(key, entry);
+  }
+
+  // Rebind the split infos to the files of 'substraitPlan'.
+  const auto reads = readRels(substraitPlan);
+  VELOX_CHECK_EQ(reads.size(), entry->readNodeIds.size());
+  ConvertedPlan result{entry->planNode, {}};
+  for (auto i = 0; i < reads.size(); ++i) {
+    auto splitInfo = std::make_shared<SplitInfo>();
+    SubstraitVeloxPlanConverter::parseLocalFiles(*reads[i], *splitInfo);
+    result.splitInfos[entry->readNodeIds[i]] = std::move(splitInfo);
+  }
+  return result;
+}
+
+} // namespace facebook::velox::substrait
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/EvictingCacheMap.h>
+
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+
+namespace facebook::velox::substrait {
+
+/// An LRU cache of the Velox plans converted from Substrait plans. Engines
+/// like Spark send the same Substrait plan to each task of a stage, except
+/// for the files read by the ReadRels. The cache is keyed by the serialized
+/// Substrait plan without these files, so that the tasks of a stage share
+/// one converted PlanNode tree and only the split infos of their ReadRels
+/// are parsed for each task.
+class SubstraitPlanCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 1'000;
+
+  using SplitInfo = SubstraitVeloxPlanConverter::SplitInfo;
+
+  struct ConvertedPlan {
+    core::PlanNodePtr planNode;
+
+    /// Mapping from leaf plan node ID to splits, as returned by
+    /// SubstraitVeloxPlanConverter::splitInfos().
+    std::unordered_map<core::PlanNodeId, std::shared_ptr<SplitInfo>>
+        splitInfos;
+  };
+
+  /// 'pool' holds the vectors of the ValuesNodes of the cached plans and must
+  /// not be the pool of a single task.
+  explicit SubstraitPlanCache(
+      std::shared_ptr<memory::MemoryPool> pool,
+      size_t maxEntries = kDefaultMaxEntries)
+      : pool_(std::move(pool)), cache_(maxEntries) {}
+
+  /// Returns the Velox plan for 'substraitPlan' and the split infos of its
+  /// ReadRels. Converts the plan with SubstraitVeloxPlanConverter unless a
+  /// plan that differs only in the local files of its ReadRels was converted
+  /// before.
+  ConvertedPlan toVeloxPlan(const ::substrait::Plan& substraitPlan);
+
+  size_t size() const {
+    return cache_.rlock()->size();
+  }
+
+  void clear() {
+    cache_.wlock()->clear();
+  }
+
+ private:
+  struct Entry {
+    core::PlanNodePtr planNode;
+
+    // The IDs of the plan nodes of the ReadRels in the order the ReadRels
+    // appear in the Substrait plan.
+    std::vector<core::PlanNodeId> readNodeIds;
+  };
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  folly::Synchronized<
+      folly::EvictingCacheMap<std::string, std::shared_ptr<const Entry>>>
+      cache_;
+};
+
+} // namespace facebook::velox::substrait
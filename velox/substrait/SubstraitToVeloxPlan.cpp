@@ -352,6 +352,38 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   }
 }
 
+// static
+void SubstraitVeloxPlanConverter::parseLocalFiles(
+    const ::substrait::ReadRel& readRel,
+    SplitInfo& splitInfo) {
+  if (!readRel.has_local_files()) {
+    return;
+  }
+  using SubstraitFileFormatCase =
+      ::substrait::ReadRel_LocalFiles_FileOrFiles::FileFormatCase;
+  const auto& fileList = readRel.local_files().items();
+  splitInfo.paths.reserve(fileList.size());
+  splitInfo.starts.reserve(fileList.size());
+  splitInfo.lengths.reserve(fileList.size());
+  for (const auto& file : fileList) {
+    // Expect all files to share the same index.
+    splitInfo.partitionIndex = file.partition_index();
+    splitInfo.paths.emplace_back(file.uri_file());
+    splitInfo.starts.emplace_back(file.start());
+    splitInfo.lengths.emplace_back(file.length());
+    switch (file.file_format_case()) {
+      case SubstraitFileFormatCase::kOrc:
+        splitInfo.format = dwio::common::FileFormat::DWRF;
+        break;
+      case SubstraitFileFormatCase::kParquet:
+        splitInfo.format = dwio::common::FileFormat::PARQUET;
+        break;
+      default:
+        splitInfo.format = dwio::common::FileFormat::UNKNOWN;
+    }
+  }
+}
+
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::ReadRel& readRel,
     std::shared_ptr<SplitInfo>& splitInfo) {
@@ -374,32 +406,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     veloxTypeList = substraitParser_->parseNamedStruct(baseSchema);
   }
 
-  // Parse local files
-  if (readRel.has_local_files()) {
-    using SubstraitFileFormatCase =
-        ::substrait::ReadRel_LocalFiles_FileOrFiles::FileFormatCase;
-    const auto& fileList = readRel.local_files().items();
-    splitInfo->paths.reserve(fileList.size());
-    splitInfo->starts.reserve(fileList.size());
-    splitInfo->lengths.reserve(fileList.size());
-    for (const auto& file : fileList) {
-      // Expect all files to share the same index.
-      splitInfo->partitionIndex = file.partition_index();
-      splitInfo->paths.emplace_back(file.uri_file());
-      splitInfo->starts.emplace_back(file.start());
-      splitInfo->lengths.emplace_back(file.length());
-      switch (file.file_format_case()) {
-        case SubstraitFileFormatCase::kOrc:
-          splitInfo->format = dwio::common::FileFormat::DWRF;
-          break;
-        case SubstraitFileFormatCase::kParquet:
-          splitInfo->format = dwio::common::FileFormat::PARQUET;
-          break;
-        default:
-          splitInfo->format = dwio::common::FileFormat::UNKNOWN;
-      }
-    }
-  }
+  parseLocalFiles(readRel, *splitInfo);
 
   // Do not hard-code connector ID and allow for connectors other than Hive.
   static const std::string kHiveConnectorId = "test-hive";
@@ -63,6 +63,12 @@ class SubstraitVeloxPlanConverter {
       const ::substrait::ReadRel& readRel,
       std::shared_ptr<SplitInfo>& splitInfo);
 
+  /// Sets the paths, starts, lengths, format and partition index of
+  /// 'splitInfo' from the local files of 'readRel', if any.
+  static void parseLocalFiles(
+      const ::substrait::ReadRel& readRel,
+      SplitInfo& splitInfo);
+
   /// Convert Substrait FetchRel into Velox LimitNode or TopNNode according the
   /// different input of fetchRel.
   core::PlanNodePtr toVeloxPlan(const ::substrait::FetchRel& fetchRel);
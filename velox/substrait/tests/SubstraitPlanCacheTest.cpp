@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/substrait/tests/JsonToProtoConverter.h"
+
+#include "velox/dwio/common/tests/utils/DataFiles.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+
+#include "velox/substrait/SubstraitPlanCache.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::substrait;
+
+class SubstraitPlanCacheTest : public OperatorTestBase {
+ protected:
+  static ::substrait::Plan readPlan() {
+    ::substrait::Plan plan;
+    JsonToProtoConverter::readFromFile(
+        getDataFilePath(
+            "velox/substrait/tests", "data/substrait_virtualTable.json"),
+        plan);
+    return plan;
+  }
+
+  // Returns the plan of the virtual table test data, scanning 'path' instead
+  // of the virtual table.
+  static ::substrait::Plan scanPlan(const std::string& path) {
+    auto plan = readPlan();
+    auto* file = plan.mutable_relations(0)
+                     ->mutable_root()
+                     ->mutable_input()
+                     ->mutable_read()
+                     ->mutable_local_files()
+                     ->add_items();
+    file->set_uri_file(path);
+    file->set_start(0);
+    file->set_length(100);
+    file->mutable_parquet();
+    return plan;
+  }
+};
+
+TEST_F(SubstraitPlanCacheTest, sharedAcrossFiles) {
+  SubstraitPlanCache cache(rootPool_->addLeafChild("planCache"));
+
+  auto first = cache.toVeloxPlan(scanPlan("/first.parquet"));
+  auto second = cache.toVeloxPlan(scanPlan("/second.parquet"));
+  ASSERT_EQ(1, cache.size());
+  ASSERT_EQ(first.planNode, second.planNode);
+  ASSERT_EQ(1, second.splitInfos.size());
+
+  const auto& leafId = *second.planNode->leafPlanNodeIds().begin();
+  ASSERT_EQ(
+      std::vector<std::string>{"/first.parquet"},
+      first.splitInfos.at(leafId)->paths);
+  const auto& splitInfo = *second.splitInfos.at(leafId);
+  ASSERT_EQ(std::vector<std::string>{"/second.parquet"}, splitInfo.paths);
+  ASSERT_EQ(std::vector<uint64_t>{100}, splitInfo.lengths);
+  ASSERT_EQ(dwio::common::FileFormat::PARQUET, splitInfo.format);
+
+  // The same plan converted directly.
+  SubstraitVeloxPlanConverter converter(pool_.get());
+  auto expected = converter.toVeloxPlan(scanPlan("/first.parquet"));
+  ASSERT_EQ(
+      expected->toString(true, true), first.planNode->toString(true, true));
+
+  // A plan that differs in more than the files gets its own entry.
+  auto values = cache.toVeloxPlan(readPlan());
+  ASSERT_EQ(2, cache.size());
+  ASSERT_NE(first.planNode, values.planNode);
+  ASSERT_EQ(values.planNode, cache.toVeloxPlan(readPlan()).planNode);
+
+  cache.clear();
+  ASSERT_EQ(0, cache.size());
+  ASSERT_NE(
+      first.planNode, cache.toVeloxPlan(scanPlan("/first.parquet")).planNode);
+}
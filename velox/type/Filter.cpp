@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,12 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
+    case FilterKind::kBytesValuesUsingBloomFilter:
+      strKind = "BytesValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +138,10 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
+      {FilterKind::kBytesValuesUsingBloomFilter,
+       "kBytesValuesUsingBloomFilter"},
   };
 }
 
@@ -165,6 +176,27 @@ std::vector<int128_t> deserializeHugeintValues(const folly::dynamic& obj) {
   }
   return values;
 }
+
+std::string serializeBloomFilter(const BloomFilter<>& bloomFilter) {
+  std::string serialized(bloomFilter.serializedSize(), '\0');
+  bloomFilter.serialize(serialized.data());
+  return encoding::Base64::encode(serialized);
+}
+
+std::shared_ptr<const BloomFilter<>> deserializeBloomFilter(
+    const folly::dynamic& obj) {
+  auto serialized = encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(serialized.data());
+  return bloomFilter;
+}
+
+bool bloomFiltersEqual(const BloomFilter<>& left, const BloomFilter<>& right) {
+  if (&left == &right) {
+    return true;
+  }
+  return serializeBloomFilter(left) == serializeBloomFilter(right);
+}
 } // namespace
 
 void Filter::registerSerDe() {
@@ -190,11 +222,15 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
   registry.Register("NegatedBytesRange", NegatedBytesRange::create);
   registry.Register("BytesValues", BytesValues::create);
+  registry.Register(
+      "BytesValuesUsingBloomFilter", BytesValuesUsingBloomFilter::create);
   registry.Register("BigintMultiRange", BigintMultiRange::create);
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
@@ -389,6 +425,30 @@ bool BigintValuesUsingHashTable::testingEquals(const Filter& other) const {
   return true;
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  obj["bloomFilter"] = serializeBloomFilter(*bloomFilter_);
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, deserializeBloomFilter(obj), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  return otherBloomFilter != nullptr && Filter::testingBaseEquals(other) &&
+      min_ == otherBloomFilter->min_ && max_ == otherBloomFilter->max_ &&
+      bloomFiltersEqual(*bloomFilter_, *otherBloomFilter->bloomFilter_);
+}
+
 folly::dynamic BigintValuesUsingBitmask::serialize() const {
   auto obj = Filter::serializeBase("BigintValuesUsingBitmask");
   obj["min"] = min_;
@@ -687,6 +747,25 @@ bool BigintMultiRange::testingEquals(const Filter& other) const {
   return true;
 }
 
+folly::dynamic BytesValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BytesValuesUsingBloomFilter");
+  obj["bloomFilter"] = serializeBloomFilter(*bloomFilter_);
+  return obj;
+}
+
+FilterPtr BytesValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  return std::make_unique<BytesValuesUsingBloomFilter>(
+      deserializeBloomFilter(obj), nullAllowed);
+}
+
+bool BytesValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BytesValuesUsingBloomFilter*>(&other);
+  return otherBloomFilter != nullptr && Filter::testingBaseEquals(other) &&
+      bloomFiltersEqual(*bloomFilter_, *otherBloomFilter->bloomFilter_);
+}
+
 folly::dynamic NegatedBytesValues::serialize() const {
   auto obj = Filter::serializeBase("NegatedBytesValues");
   obj["nonNegated"] = nonNegated_->serialize();
@@ -849,6 +928,35 @@ BigintValuesUsingHashTable::BigintValuesUsingHashTable(
   std::sort(values_.begin(), values_.end());
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)) {
+  VELOX_CHECK_LE(min_, max_, "min must not be greater than max");
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "bloomFilter must be initialized");
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  return !(min > max_ || max < min_);
+}
+
 bool BigintValuesUsingHashTable::testInt64(int64_t value) const {
   if (containsEmptyMarker_ && value == kEmptyMarker) {
     return true;
@@ -1275,6 +1383,41 @@ bool BytesRange::testBytesRange(
   // clang-format on
 }
 
+void BytesValues::initializePrefilters() {
+  uint32_t maxLength = 0;
+  for (auto length : lengths_) {
+    maxLength = std::max(maxLength, length);
+  }
+  if (maxLength < kMaxLengthTableSize) {
+    lengthTable_.resize(maxLength + 2, 0);
+    for (auto length : lengths_) {
+      lengthTable_[length] = -1;
+    }
+  }
+
+  // About 16 bits per value keeps the false positives of the prefix test at
+  // a few percent.
+  const auto numBits =
+      std::max<uint64_t>(64, bits::nextPowerOfTwo(values_.size() * 16));
+  prefixBits_.resize(numBits / 64, 0);
+  prefixMask_ = numBits - 1;
+  for (const auto& value : values_) {
+    bits::setBit(prefixBits_.data(), prefixHash(value.data(), value.size()));
+  }
+}
+
+xsimd::batch_bool<int32_t> BytesValues::testLengths(
+    xsimd::batch<int32_t> lengths) const {
+  if (lengthTable_.empty()) {
+    return Filter::testLengths(lengths);
+  }
+  // Lengths past the longest value read the 0 entry at the end.
+  const auto indices = xsimd::min(
+      lengths, xsimd::broadcast<int32_t>(lengthTable_.size() - 1));
+  return simd::gather(lengthTable_.data(), indices) !=
+      xsimd::broadcast<int32_t>(0);
+}
+
 bool BytesValues::testBytesRange(
     std::optional<std::string_view> min,
     std::optional<std::string_view> max,
@@ -1360,6 +1503,30 @@ std::unique_ptr<Filter> NegatedBytesRange::toMultiRange() const {
   return std::make_unique<MultiRange>(std::move(accepted), nullAllowed_, false);
 }
 
+BytesValuesUsingBloomFilter::BytesValuesUsingBloomFilter(
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBytesValuesUsingBloomFilter),
+      bloomFilter_(std::move(bloomFilter)) {
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "bloomFilter must be initialized");
+}
+
+bool BytesValuesUsingBloomFilter::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return testBytes(min->data(), min->length());
+  }
+
+  return true;
+}
+
 bool NegatedBytesValues::testBytesRange(
     std::optional<std::string_view> min,
     std::optional<std::string_view> max,
@@ -1415,6 +1582,47 @@ bool BigintMultiRange::testInt64(int64_t value) const {
   return ranges_[place - 1]->testInt64(value);
 }
 
+namespace {
+// Returns the lanes of 'x' that pass at least one of 'ranges'.
+template <typename T>
+xsimd::batch_bool<T> testRangeList(
+    const std::vector<std::unique_ptr<BigintRange>>& ranges,
+    xsimd::batch<T> x) {
+  xsimd::batch_bool<T> result(false);
+  for (const auto& range : ranges) {
+    result = result | range->testValues(x);
+    if (simd::toBitMask(result) == simd::allSetBitMask<T>()) {
+      break;
+    }
+  }
+  return result;
+}
+} // namespace
+
+xsimd::batch_bool<int64_t> BigintMultiRange::testValues(
+    xsimd::batch<int64_t> x) const {
+  if (ranges_.size() > kMaxSimdRanges) {
+    return Filter::testValues(x);
+  }
+  return testRangeList(ranges_, x);
+}
+
+xsimd::batch_bool<int32_t> BigintMultiRange::testValues(
+    xsimd::batch<int32_t> x) const {
+  if (ranges_.size() > kMaxSimdRanges) {
+    return Filter::testValues(x);
+  }
+  return testRangeList(ranges_, x);
+}
+
+xsimd::batch_bool<int16_t> BigintMultiRange::testValues(
+    xsimd::batch<int16_t> x) const {
+  if (ranges_.size() > kMaxSimdRanges) {
+    return Filter::testValues(x);
+  }
+  return testRangeList(ranges_, x);
+}
+
 bool BigintMultiRange::testInt64Range(int64_t min, int64_t max, bool hasNull)
     const {
   if (hasNull && nullAllowed_) {
@@ -1470,6 +1678,36 @@ bool MultiRange::testFloat(float value) const {
   return false;
 }
 
+namespace {
+// Returns the lanes of 'x' that pass at least one of 'filters'. NaN lanes
+// pass if 'nanAllowed' and are not tested otherwise.
+template <typename T>
+xsimd::batch_bool<T> testFilterList(
+    const std::vector<std::unique_ptr<Filter>>& filters,
+    bool nanAllowed,
+    xsimd::batch<T> x) {
+  const auto nan = x != x;
+  auto result = nanAllowed ? nan : xsimd::batch_bool<T>(false);
+  const auto notNan = ~nan;
+  for (const auto& filter : filters) {
+    result = result | (filter->testValues(x) & notNan);
+    if (simd::toBitMask(result) == simd::allSetBitMask<T>()) {
+      break;
+    }
+  }
+  return result;
+}
+} // namespace
+
+xsimd::batch_bool<double> MultiRange::testValues(
+    xsimd::batch<double> x) const {
+  return testFilterList(filters_, nanAllowed_, x);
+}
+
+xsimd::batch_bool<float> MultiRange::testValues(xsimd::batch<float> x) const {
+  return testFilterList(filters_, nanAllowed_, x);
+}
+
 bool MultiRange::testBytes(const char* value, int32_t length) const {
   for (const auto& filter : filters_) {
     if (filter->testBytes(value, length)) {
@@ -1541,6 +1779,7 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBytesValuesUsingBloomFilter:
     case FilterKind::kNegatedBytesRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -1820,6 +2059,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintRange>(lower_, upper_, false);
@@ -1914,6 +2154,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2007,6 +2248,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingHashTable>(*this, false);
@@ -2098,6 +2340,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingBitmask>(*this, false);
@@ -2167,6 +2410,66 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    case FilterKind::kBigintRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      int64_t otherMin;
+      int64_t otherMax;
+      if (other->kind() == FilterKind::kBigintRange) {
+        auto otherRange = static_cast<const BigintRange*>(other);
+        otherMin = otherRange->lower();
+        otherMax = otherRange->upper();
+      } else {
+        auto otherBloomFilter =
+            static_cast<const BigintValuesUsingBloomFilter*>(other);
+        otherMin = otherBloomFilter->min();
+        otherMax = otherBloomFilter->max();
+      }
+
+      auto min = std::max(min_, otherMin);
+      auto max = std::min(max_, otherMax);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask: {
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      std::vector<int64_t> otherValues;
+      if (other->kind() == FilterKind::kBigintValuesUsingHashTable) {
+        otherValues =
+            static_cast<const BigintValuesUsingHashTable*>(other)->values();
+      } else {
+        otherValues =
+            static_cast<const BigintValuesUsingBitmask*>(other)->values();
+      }
+
+      std::vector<int64_t> valuesToKeep;
+      valuesToKeep.reserve(otherValues.size());
+      for (auto value : otherValues) {
+        if (testInt64(value)) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      return createBigintValues(valuesToKeep, bothNullAllowed);
+    }
+    default:
+      // Keep only the range check of 'this'.
+      return BigintRange(min_, max_, nullAllowed_).mergeWith(other);
+  }
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2181,6 +2484,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingHashTable>(*this, false);
@@ -2220,6 +2524,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingBitmask>(*this, false);
@@ -2255,6 +2560,7 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull: {
       std::vector<std::unique_ptr<BigintRange>> ranges;
@@ -2336,6 +2642,7 @@ std::unique_ptr<Filter> BytesRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2415,6 +2722,7 @@ std::unique_ptr<Filter> NegatedBytesRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBytesValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2437,6 +2745,7 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBytesValuesUsingBloomFilter:
     case FilterKind::kMultiRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -2543,12 +2852,46 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
   }
 } // namespace facebook::velox::common
 
+std::unique_ptr<Filter> BytesValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    case FilterKind::kBytesValues: {
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      auto otherBytesValues = static_cast<const BytesValues*>(other);
+
+      std::vector<std::string> valuesToKeep;
+      valuesToKeep.reserve(otherBytesValues->values().size());
+      for (const auto& value : otherBytesValues->values()) {
+        if (testBytes(value.data(), value.size())) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      if (valuesToKeep.empty()) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BytesValues>(valuesToKeep, bothNullAllowed);
+    }
+    case FilterKind::kBytesValuesUsingBloomFilter:
+      return this->clone(nullAllowed_ && other->testNull());
+    default:
+      // Keep only the other filter.
+      return other->clone(nullAllowed_ && other->testNull());
+  }
+}
+
 std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
     const Filter* other) const {
   switch (other->kind()) {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBytesValuesUsingBloomFilter:
     case FilterKind::kBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,8 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
+  kBytesValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -1034,6 +1038,92 @@ class HugeintValuesUsingHashTable final : public Filter {
   folly::F14FastSet<int128_t> values_;
 };
 
+/// Approximate IN-list filter for integral data types. Implemented as a range
+/// check followed by a Bloom filter probe. Values outside of [min, max] never
+/// pass, values inside pass if the Bloom filter may contain them. Used for
+/// dynamic filters on join keys which have too many distinct values for an
+/// exact IN-list. Only usable where false positives are acceptable.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter populated with hashValue() of the values
+  /// that pass the filter. Shared between the copies of this filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Returns the hash to insert into the Bloom filter for 'value'.
+  static uint64_t hashValue(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hashValue(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  /// Merging with another approximate filter or with a filter that is not a
+  /// range or an IN-list keeps only the range check of 'this'. The result may
+  /// let through more values than the exact conjunction, which is consistent
+  /// with the false positives of this filter.
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  const std::shared_ptr<const BloomFilter<>>& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 /// IN-list filter for integral data types. Implemented as a bitmask. Offers
 /// better performance than the hash table when the range of values is small.
 class BigintValuesUsingBitmask final : public Filter {
@@ -1871,6 +1961,7 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+    initializePrefilters();
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1878,7 +1969,10 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        lengthTable_(other.lengthTable_),
+        prefixBits_(other.prefixBits_),
+        prefixMask_(other.prefixMask_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1897,9 +1991,17 @@ class BytesValues final : public Filter {
     return lengths_.contains(length);
   }
 
+  /// Looks up the lengths in a table of the lengths of the values when the
+  /// values are shorter than kMaxLengthTableSize.
+  xsimd::batch_bool<int32_t> testLengths(
+      xsimd::batch<int32_t> lengths) const final;
+
+  /// Rejects most misses on the length and on a bitmap of the hashes of the
+  /// length and the first 8 bytes of the values before the hash set lookup.
   bool testBytes(const char* value, int32_t length) const final {
     return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+        bits::isBitSet(prefixBits_.data(), prefixHash(value, length)) &&
+        values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
@@ -1915,11 +2017,99 @@ class BytesValues final : public Filter {
 
   bool testingEquals(const Filter& other) const final;
 
+  static constexpr int32_t kMaxLengthTableSize = 1024;
+
  private:
+  // Fills 'lengthTable_' and 'prefixBits_' from 'values_'.
+  void initializePrefilters();
+
+  // Returns the bit of 'prefixBits_' for a value.
+  uint64_t prefixHash(const char* value, int32_t length) const {
+    uint64_t prefix = 0;
+    memcpy(&prefix, value, std::min<int32_t>(length, sizeof(prefix)));
+    return bits::hashMix(length, prefix) & prefixMask_;
+  }
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+  // -1 at the lengths of the values and 0 elsewhere, with a 0 entry past the
+  // longest value for the longer lengths. Empty if a value is at least
+  // kMaxLengthTableSize long.
+  std::vector<int32_t> lengthTable_;
+  // Bits set at prefixHash() of the values.
+  std::vector<uint64_t> prefixBits_;
+  uint64_t prefixMask_{0};
+};
+
+/// Approximate IN-list filter for string data type. Implemented as a Bloom
+/// filter probe. Used for dynamic filters on join keys which have too many
+/// distinct values for an exact IN-list. Only usable where false positives are
+/// acceptable.
+class BytesValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param bloomFilter Bloom filter populated with hashValue() of the values
+  /// that pass the filter. Shared between the copies of this filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BytesValuesUsingBloomFilter(
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed);
+
+  BytesValuesUsingBloomFilter(
+      const BytesValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBytesValuesUsingBloomFilter),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Returns the hash to insert into the Bloom filter for 'value'.
+  static uint64_t hashValue(std::string_view value) {
+    return folly::hasher<std::string_view>()(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BytesValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BytesValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return bloomFilter_->mayContain(
+        hashValue(std::string_view(value, length)));
+  }
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  /// Merging with a filter other than an IN-list returns the other filter. The
+  /// result may let through more values than the exact conjunction, which is
+  /// consistent with the false positives of this filter.
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const std::shared_ptr<const BloomFilter<>>& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BytesValuesUsingBloomFilter: {}",
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -1945,10 +2135,18 @@ class BigintMultiRange final : public Filter {
 
   bool testInt64(int64_t value) const final;
 
+  /// Tests the values against each range when there are at most
+  /// kMaxSimdRanges ranges and with a binary search per value otherwise.
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t>) const final;
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t>) const final;
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t>) const final;
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
 
+  static constexpr int32_t kMaxSimdRanges = 8;
+
   const std::vector<std::unique_ptr<BigintRange>>& ranges() const {
     return ranges_;
   }
@@ -2054,6 +2252,9 @@ class MultiRange final : public Filter {
 
   bool testFloat(float value) const final;
 
+  xsimd::batch_bool<double> testValues(xsimd::batch<double>) const final;
+  xsimd::batch_bool<float> testValues(xsimd::batch<float>) const final;
+
   bool testBytes(const char* value, int32_t length) const final;
 
   bool testTimestamp(Timestamp value) const final;
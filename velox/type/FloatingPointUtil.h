@@ -100,6 +100,69 @@ class HashSetNaNAware<double>
     : public folly::
           F14FastSet<double, NaNAwareHash<double>, NaNAwareEquals<double>> {};
 
+/// Set with the semantics of HashSetNaNAware for the small per row sets of
+/// array functions. Keeps up to 'kMaxLinearSize' values in an inline array
+/// that is scanned with a branch free loop, which the compiler vectorizes for
+/// primitive types, and moves to a HashSetNaNAware past that size. Clearing a
+/// set that stayed small is free.
+template <typename Key, int32_t kMaxLinearSize = 16>
+class AdaptiveSetNaNAware {
+ public:
+  /// Returns true if 'value' was added, false if it was in the set.
+  bool insert(const Key& value) {
+    if (!useHashSet_) {
+      if (containsLinear(value)) {
+        return false;
+      }
+      if (numLinear_ < kMaxLinearSize) {
+        linear_[numLinear_++] = value;
+        return true;
+      }
+      hashSet_.insert(linear_.begin(), linear_.end());
+      useHashSet_ = true;
+    }
+    return hashSet_.insert(value).second;
+  }
+
+  bool contains(const Key& value) const {
+    return useHashSet_ ? hashSet_.count(value) > 0 : containsLinear(value);
+  }
+
+  size_t size() const {
+    return useHashSet_ ? hashSet_.size() : numLinear_;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  void clear() {
+    if (useHashSet_) {
+      hashSet_.clear();
+      useHashSet_ = false;
+    }
+    numLinear_ = 0;
+  }
+
+ private:
+  bool containsLinear(const Key& value) const {
+    bool found = false;
+    for (auto i = 0; i < numLinear_; ++i) {
+      if constexpr (std::is_floating_point_v<Key>) {
+        found |= NaNAwareEquals<Key>{}(linear_[i], value);
+      } else {
+        found |= linear_[i] == value;
+      }
+    }
+    return found;
+  }
+
+  std::array<Key, kMaxLinearSize> linear_;
+  int32_t numLinear_{0};
+  bool useHashSet_{false};
+  HashSetNaNAware<Key> hashSet_;
+};
+
 template <
     typename Key,
     typename Mapped,
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -176,6 +177,22 @@ struct StringView {
     return (result != 0) ? result : size_ - other.size_;
   }
 
+  /// Returns the result of compare() if it is decided by the sizes, the
+  /// prefixes and the inlined bytes, std::nullopt if the out of line data
+  /// must be compared. Lets callers whose out of line data is costly to reach,
+  /// e.g. strings that may span several blocks of a HashStringAllocator,
+  /// skip it for short strings and strings that differ in the prefix.
+  std::optional<int32_t> compareInline(const StringView& other) const {
+    if (prefixAsInt() != other.prefixAsInt()) {
+      return memcmp(prefix_, other.prefix_, kPrefixSize);
+    }
+    if (std::min(size_, other.size_) <= kPrefixSize ||
+        (isInline() && other.isInline())) {
+      return compare(other);
+    }
+    return std::nullopt;
+  }
+
   bool operator<(const StringView& other) const {
     return compare(other) < 0;
   }
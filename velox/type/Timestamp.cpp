@@ -34,6 +34,35 @@ inline int64_t getPrestoTZOffsetInSeconds(int16_t tzID) {
   return ((tzID <= 840) ? (tzID - 841) : (tzID - 840)) * 60;
 }
 
+// The UTC offset of a time zone between two of its transitions.
+struct ZoneInterval {
+  const date::time_zone* zone{nullptr};
+  date::sys_seconds begin;
+  date::sys_seconds end;
+  std::chrono::seconds offset{0};
+};
+
+// Returns the interval of the last conversion on this thread. Timestamps
+// that are converted one after another are mostly close in time, so this
+// usually saves the search in the transitions of the time zone.
+ZoneInterval& lastZoneInterval() {
+  thread_local ZoneInterval interval;
+  return interval;
+}
+
+// Returns the interval of 'zone' that contains 'time'.
+const ZoneInterval& zoneInterval(
+    const date::time_zone& zone,
+    date::sys_seconds time) {
+  auto& interval = lastZoneInterval();
+  if (interval.zone != &zone || time < interval.begin ||
+      time >= interval.end) {
+    const auto info = zone.get_info(time);
+    interval = {&zone, info.begin, info.end, info.offset};
+  }
+  return interval;
+}
+
 } // namespace
 
 // static
@@ -58,6 +87,19 @@ void Timestamp::toGMT(const date::time_zone& zone) {
       kMaxSeconds,
       "Timestamp seconds out of range for time zone adjustment");
 
+  // A local time is unique if it maps to a time more than a day away from
+  // the transitions around it.
+  const auto& interval = lastZoneInterval();
+  if (interval.zone == &zone) {
+    const date::sys_seconds guess{
+        std::chrono::seconds(seconds_) - interval.offset};
+    if (guess >= interval.begin + date::days(1) &&
+        guess < interval.end - date::days(1)) {
+      seconds_ = guess.time_since_epoch().count();
+      return;
+    }
+  }
+
   date::local_time<std::chrono::seconds> localTime{
       std::chrono::seconds(seconds_)};
   std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
@@ -73,6 +115,7 @@ void Timestamp::toGMT(const date::time_zone& zone) {
     VELOX_USER_FAIL(error.what());
   }
   seconds_ = sysTime.time_since_epoch().count();
+  zoneInterval(zone, sysTime);
 }
 
 void Timestamp::toGMT(int16_t tzID) {
@@ -122,7 +165,9 @@ void Timestamp::toTimezone(const date::time_zone& zone, bool allowOverflow) {
   auto tp = toTimePoint(allowOverflow);
 
   try {
-    auto epoch = zone.to_local(tp).time_since_epoch();
+    const auto& interval =
+        zoneInterval(zone, std::chrono::floor<std::chrono::seconds>(tp));
+    auto epoch = tp.time_since_epoch() + interval.offset;
 
     // NOTE: Round down to get the seconds of the current time point.
     seconds_ = std::chrono::floor<std::chrono::seconds>(epoch).count();
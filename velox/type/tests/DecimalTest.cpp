@@ -15,6 +15,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <random>
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/type/DecimalUtil.h"
@@ -342,6 +343,62 @@ TEST(DecimalAggregateTest, adjustSumForOverflow) {
   EXPECT_FALSE(accumulator.adjustedSum().has_value());
 }
 
+TEST(DecimalAggregateTest, wideDecimalSum) {
+  auto expectSameSum = [](const std::vector<int128_t>& values) {
+    int128_t expectedSum = 0;
+    int64_t expectedOverflow = 0;
+    WideDecimalSum wideSum;
+    for (auto value : values) {
+      expectedOverflow +=
+          DecimalUtil::addWithOverflow(expectedSum, expectedSum, value);
+      wideSum.add(value);
+    }
+    int128_t sum = 0;
+    const auto overflow = wideSum.addTo(sum);
+    EXPECT_EQ(
+        DecimalUtil::adjustSumForOverflow(sum, overflow),
+        DecimalUtil::adjustSumForOverflow(expectedSum, expectedOverflow));
+  };
+
+  expectSameSum({});
+  expectSameSum({-5});
+  expectSameSum({1, -2, 3, -4});
+  expectSameSum({HugeInt::build(1, 0), -1, HugeInt::build(-1, 5)});
+  // Intermediate sums overflow but the total does not.
+  expectSameSum(
+      {DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMin});
+  expectSameSum(
+      {DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMax});
+  // The total overflows.
+  expectSameSum({DecimalUtil::kLongDecimalMax, DecimalUtil::kLongDecimalMax});
+  expectSameSum({DecimalUtil::kLongDecimalMin, DecimalUtil::kLongDecimalMin});
+
+  std::vector<int128_t> values;
+  std::mt19937 rng(1);
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(
+        HugeInt::build(static_cast<int32_t>(rng()), rng()) *
+        (i % 3 == 0 ? -1 : 1));
+  }
+  expectSameSum(values);
+
+  // Adds to a sum with an earlier overflow.
+  int128_t sum = 0;
+  int64_t overflow =
+      DecimalUtil::addWithOverflow(sum, DecimalUtil::kLongDecimalMax, 1);
+  overflow += DecimalUtil::addWithOverflow(
+      sum, sum, DecimalUtil::kLongDecimalMax);
+  WideDecimalSum wideSum;
+  wideSum.add(DecimalUtil::kLongDecimalMin);
+  wideSum.add(DecimalUtil::kLongDecimalMin);
+  overflow += wideSum.addTo(sum);
+  EXPECT_EQ(DecimalUtil::adjustSumForOverflow(sum, overflow), 1);
+}
+
 TEST(DecimalTest, rescaleDouble) {
   assertRescaleDouble(-3333.03, DECIMAL(10, 4), -33'330'300);
   assertRescaleDouble(-3333.03, DECIMAL(20, 1), -33'330);
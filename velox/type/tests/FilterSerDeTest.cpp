@@ -110,6 +110,21 @@ TEST_F(FilterSerDeTest, valuesFilters) {
   }
 }
 
+TEST_F(FilterSerDeTest, bloomFilters) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(i * 7));
+    bloomFilter->insert(
+        BytesValuesUsingBloomFilter::hashValue(std::to_string(i)));
+  }
+
+  for (auto nullAllowed : {false, true}) {
+    testSerde(BigintValuesUsingBloomFilter(0, 693, bloomFilter, nullAllowed));
+    testSerde(BytesValuesUsingBloomFilter(bloomFilter, nullAllowed));
+  }
+}
+
 TEST_F(FilterSerDeTest, rangeFilters) {
   FloatRange floatRange(1.0, true, true, 124.5, false, true, false);
   testSerde(floatRange);
@@ -454,6 +454,79 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(i * 10));
+  }
+  auto filter = std::make_unique<BigintValuesUsingBloomFilter>(
+      0, 9'990, bloomFilter, false);
+
+  // No false negatives.
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(filter->testInt64(i * 10));
+  }
+
+  // Few false positives.
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    numPassed += filter->testInt64(i * 10 + 1);
+  }
+  EXPECT_LT(numPassed, 100);
+
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(-10));
+  EXPECT_FALSE(filter->testInt64(10'000));
+
+  EXPECT_TRUE(filter->testInt64Range(5, 50, false));
+  EXPECT_TRUE(filter->testInt64Range(50, 50, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter->testInt64Range(10'000, 20'000, false));
+  EXPECT_FALSE(filter->testInt64Range(10'000, 20'000, true));
+
+  auto withNulls = filter->clone(true);
+  EXPECT_TRUE(withNulls->testNull());
+  EXPECT_TRUE(withNulls->testInt64(50));
+  EXPECT_TRUE(withNulls->testInt64Range(10'000, 20'000, true));
+  EXPECT_EQ(
+      bloomFilter,
+      static_cast<BigintValuesUsingBloomFilter*>(withNulls.get())
+          ->bloomFilter());
+
+  // Merging with a range narrows the range.
+  auto merged = filter->mergeWith(between(100, 200).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(100));
+  EXPECT_TRUE(merged->testInt64(200));
+  EXPECT_FALSE(merged->testInt64(90));
+  EXPECT_FALSE(merged->testInt64(210));
+  EXPECT_EQ(
+      merged->kind(), between(100, 200)->mergeWith(filter.get())->kind());
+
+  merged = filter->mergeWith(between(20'000, 30'000).get());
+  EXPECT_EQ(merged->kind(), FilterKind::kAlwaysFalse);
+
+  // Merging with an IN-list gives an IN-list.
+  merged = filter->mergeWith(in({10, 20, 30, -10}).get());
+  EXPECT_TRUE(merged->testInt64(10));
+  EXPECT_TRUE(merged->testInt64(20));
+  EXPECT_TRUE(merged->testInt64(30));
+  EXPECT_FALSE(merged->testInt64(-10));
+  EXPECT_FALSE(merged->testInt64(40));
+
+  merged = filter->mergeWith(notIn({10, 20}).get());
+  EXPECT_FALSE(merged->testInt64(10));
+  EXPECT_FALSE(merged->testInt64(-10));
+  EXPECT_TRUE(merged->testInt64(30));
+
+  merged = filter->mergeWith(isNotNull().get());
+  EXPECT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_FALSE(withNulls->mergeWith(isNotNull().get())->testNull());
+  EXPECT_EQ(
+      withNulls->mergeWith(isNull().get())->kind(), FilterKind::kIsNull);
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -592,6 +665,43 @@ TEST(FilterTest, bigintMultiRange) {
   EXPECT_FALSE(filter->testInt64Range(15, 45, true));
 }
 
+TEST(FilterTest, bigintMultiRangeSimd) {
+  // x between 1 and 10 or x = 100 or x between 1000 and 40000
+  auto filter = bigintOr(between(1, 10), equal(100), between(1000, 40000));
+  auto verify = [&](int64_t x) { return filter->testInt64(x); };
+  {
+    int64_t n4[] = {0, 10, 100, 40'001};
+    checkSimd(filter.get(), n4, verify);
+    int64_t n4b[] = {5, 1'000, 40'000, 101};
+    checkSimd(filter.get(), n4b, verify);
+  }
+  {
+    int32_t n8[] = {0, 1, 10, 11, 99, 100, 999, 40'000};
+    checkSimd(filter.get(), n8, verify);
+  }
+  {
+    int16_t n16[] = {
+        0, 1, 5, 10, 11, 99, 100, 101, 999, 1'000, 2'000, 32'767, -1, -32'768,
+        7, 3};
+    checkSimd(filter.get(), n16, verify);
+  }
+
+  // More ranges than kMaxSimdRanges use the binary search per value.
+  std::vector<std::unique_ptr<BigintRange>> ranges;
+  for (auto i = 0; i <= BigintMultiRange::kMaxSimdRanges; ++i) {
+    ranges.push_back(between(i * 10, i * 10 + 5));
+  }
+  filter = std::make_unique<BigintMultiRange>(std::move(ranges), false);
+  {
+    int64_t n4[] = {0, 6, 45, 1'000};
+    checkSimd(filter.get(), n4, verify);
+  }
+  {
+    int32_t n8[] = {-1, 5, 10, 16, 80, 85, 86, 90};
+    checkSimd(filter.get(), n8, verify);
+  }
+}
+
 TEST(FilterTest, boolValue) {
   auto boolValueTrue = boolEqual(true);
   EXPECT_TRUE(boolValueTrue->testBool(true));
@@ -950,6 +1060,97 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesPrefilters) {
+  // Values of many lengths, some sharing the first 8 bytes.
+  std::vector<std::string> values;
+  for (auto i = 0; i < 500; ++i) {
+    values.push_back(
+        i % 2 ? fmt::format("prefix::{}", i)
+              : std::string(i % 37, 'a' + i % 26));
+  }
+  auto filter = in(values);
+  folly::F14FastSet<std::string> expected(values.begin(), values.end());
+  for (const auto& value : values) {
+    EXPECT_TRUE(filter->testBytes(value.data(), value.size())) << value;
+  }
+  for (auto i = 0; i < 2'000; ++i) {
+    auto value = i % 3 ? fmt::format("prefix::{}", i)
+                       : std::string(i % 41, 'a' + i % 13);
+    EXPECT_EQ(
+        expected.contains(value),
+        filter->testBytes(value.data(), value.size()))
+        << value;
+  }
+
+  auto checkLengths = [&](const Filter& filter, const int32_t* lengths) {
+    auto bits = simd::toBitMask(
+        filter.testLengths(xsimd::load_unaligned(lengths)));
+    for (auto i = 0; i < xsimd::batch<int32_t>::size; ++i) {
+      EXPECT_EQ(bits::isBitSet(&bits, i), filter.testLength(lengths[i]))
+          << "Lane " << i;
+    }
+  };
+  int32_t lengths[] = {0, 1, 12, 36, 37, 40, 1'000, 1 << 20};
+  checkLengths(*filter, lengths);
+
+  // A value longer than the length table.
+  values.push_back(std::string(BytesValues::kMaxLengthTableSize, 'x'));
+  filter = in(values);
+  lengths[6] = BytesValues::kMaxLengthTableSize;
+  checkLengths(*filter, lengths);
+  EXPECT_TRUE(filter->testBytes(values.back().data(), values.back().size()));
+}
+
+TEST(FilterTest, bytesValuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(BytesValuesUsingBloomFilter::hashValue(
+        fmt::format("value-{}", i * 10)));
+  }
+  auto filter =
+      std::make_unique<BytesValuesUsingBloomFilter>(bloomFilter, false);
+
+  // No false negatives.
+  for (auto i = 0; i < 1'000; ++i) {
+    auto value = fmt::format("value-{}", i * 10);
+    EXPECT_TRUE(filter->testBytes(value.data(), value.size()));
+  }
+
+  // Few false positives.
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    auto value = fmt::format("value-{}", i * 10 + 1);
+    numPassed += filter->testBytes(value.data(), value.size());
+  }
+  EXPECT_LT(numPassed, 100);
+
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_TRUE(filter->testBytesRange("value-10", "value-10", false));
+  EXPECT_TRUE(filter->testBytesRange("a", "z", false));
+  EXPECT_TRUE(filter->testBytesRange(std::nullopt, "z", false));
+
+  // Merging with an IN-list gives an IN-list.
+  auto merged = filter->mergeWith(in({"value-10", "value-20", "x"}).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBytesValues);
+  EXPECT_TRUE(merged->testBytes("value-10", 8));
+  EXPECT_TRUE(merged->testBytes("value-20", 8));
+  EXPECT_FALSE(merged->testBytes("x", 1));
+  EXPECT_EQ(
+      in({"value-10"})->mergeWith(filter.get())->kind(),
+      FilterKind::kBytesValues);
+
+  EXPECT_EQ(
+      filter->mergeWith(in({"x", "y"}).get())->kind(),
+      FilterKind::kAlwaysFalse);
+
+  merged = filter->mergeWith(lessThan("value-5").get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBytesRange);
+  EXPECT_EQ(
+      lessThan("value-5")->mergeWith(filter.get())->kind(),
+      FilterKind::kBytesRange);
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -1101,6 +1302,26 @@ TEST(FilterTest, multiRangeWithNaNs) {
   EXPECT_TRUE(filter->testDouble(1.3));
 }
 
+TEST(FilterTest, multiRangeSimd) {
+  for (const bool nanAllowed : {false, true}) {
+    SCOPED_TRACE(fmt::format("nanAllowed: {}", nanAllowed));
+    // x NOT IN (1.2, 1.3)
+    auto filter = orFilter(
+        lessThanDouble(1.2), greaterThanDouble(1.3), false, nanAllowed);
+    auto verify = [&](double x) { return filter->testDouble(x); };
+    double n4[] = {1.1, 1.2, std::nan("nan"), 1.4};
+    checkSimd(filter.get(), n4, verify);
+    double n4b[] = {1.3, 1.25, -1e300, 1e300};
+    checkSimd(filter.get(), n4b, verify);
+
+    auto floatFilter = orFilter(
+        lessThanFloat(1.2), greaterThanFloat(1.3), false, nanAllowed);
+    auto verifyFloat = [&](float x) { return floatFilter->testFloat(x); };
+    float n8[] = {1.1, 1.2, std::nanf("nan"), 1.4, 1.3, 1.25, -1e30, 1e30};
+    checkSimd(floatFilter.get(), n8, verifyFloat);
+  }
+}
+
 TEST(FilterTest, createBigintValues) {
   // Small number of values from a very large range.
   {
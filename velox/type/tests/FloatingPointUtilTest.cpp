@@ -56,5 +56,36 @@ TEST(FloatingPointUtilTest, basic) {
   testFloatingPoint<float>();
   testFloatingPoint<double>();
 }
+
+TEST(FloatingPointUtilTest, adaptiveSet) {
+  using namespace util::floating_point;
+
+  static const double kNaN = std::numeric_limits<double>::quiet_NaN();
+  static const double kSNAN = std::numeric_limits<double>::signaling_NaN();
+
+  // Crosses from the linear scan to the hash set and back after clear().
+  AdaptiveSetNaNAware<double, 4> set;
+  for (auto round = 0; round < 2; ++round) {
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.insert(kNaN));
+    ASSERT_FALSE(set.insert(kSNAN));
+    for (auto i = 0; i < 10; ++i) {
+      ASSERT_TRUE(set.insert(i));
+      ASSERT_FALSE(set.insert(i));
+      ASSERT_EQ(set.size(), i + 2);
+    }
+    for (auto i = 0; i < 10; ++i) {
+      ASSERT_TRUE(set.contains(i));
+    }
+    ASSERT_TRUE(set.contains(kSNAN));
+    ASSERT_FALSE(set.contains(10));
+    set.clear();
+  }
+
+  AdaptiveSetNaNAware<int64_t> ints;
+  ASSERT_TRUE(ints.insert(1));
+  ASSERT_FALSE(ints.insert(1));
+  ASSERT_FALSE(ints.contains(2));
+}
 } // namespace
 } // namespace facebook::velox
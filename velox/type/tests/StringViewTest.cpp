@@ -58,6 +58,25 @@ TEST(StringView, comparison) {
       StringView("in hoc signo vinces, Constantinus"));
 }
 
+TEST(StringView, compareInline) {
+  const std::string longA = "in hoc signo vinces, Constantinus";
+  const std::string longB = "in hoc signo vinces, constantinus";
+  const std::string otherPrefix = "In hoc signo vinces, Constantinus";
+  // Decided by the prefix.
+  ASSERT_GT(*StringView(longA).compareInline(StringView(otherPrefix)), 0);
+  // Decided by the size of a string that ends within the prefix.
+  ASSERT_LT(*StringView("in h").compareInline(StringView(longA)), 0);
+  // Decided by the inlined bytes.
+  ASSERT_LT(
+      *StringView("in hoc signO").compareInline(StringView("in hoc signo")),
+      0);
+  ASSERT_EQ(*StringView("in hoc").compareInline(StringView("in hoc")), 0);
+  // Same prefix and out of line data.
+  ASSERT_FALSE(StringView(longA).compareInline(StringView(longB)).has_value());
+  ASSERT_FALSE(
+      StringView("in hoc signo").compareInline(StringView(longA)).has_value());
+}
+
 TEST(StringView, container) {
   std::vector<std::string> strings = {
       "May",
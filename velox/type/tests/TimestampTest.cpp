@@ -390,6 +390,33 @@ TEST(TimestampTest, outOfRange) {
       "Unable to convert timezone 'America/Los_Angeles' past");
 }
 
+TEST(TimestampTest, timezoneConversionAcrossTransitions) {
+  // Converts timestamps over 2 years in steps of about an hour, so that
+  // conversions reuse the interval between transitions of the previous one
+  // and also cross the daylight saving transitions.
+  const auto* zone = date::locate_zone("America/Los_Angeles");
+  const int64_t start = 1'640'995'200; // 2022-01-01
+  for (int64_t seconds = start; seconds < start + 2 * 365 * 86'400;
+       seconds += 3'599) {
+    Timestamp local(seconds, 0);
+    local.toTimezone(*zone);
+    const auto expectedLocal =
+        zone->to_local(date::sys_seconds{std::chrono::seconds(seconds)});
+    ASSERT_EQ(local.getSeconds(), expectedLocal.time_since_epoch().count());
+
+    Timestamp utc(seconds, 0);
+    const date::local_seconds localTime{std::chrono::seconds(seconds)};
+    const auto info = zone->get_info(localTime);
+    if (info.result == date::local_info::nonexistent) {
+      VELOX_ASSERT_THROW(utc.toGMT(*zone), "");
+    } else {
+      utc.toGMT(*zone);
+      const auto expectedUtc = zone->to_sys(localTime, date::choose::earliest);
+      ASSERT_EQ(utc.getSeconds(), expectedUtc.time_since_epoch().count());
+    }
+  }
+}
+
 // In debug mode, Timestamp constructor will throw exception if range check
 // fails.
 #ifdef NDEBUG
@@ -875,6 +875,49 @@ void BaseVector::flattenVector(VectorPtr& vector) {
   }
 }
 
+// static
+uint64_t BaseVector::compactStringBuffers(
+    BaseVector& vector,
+    int32_t minLivePct) {
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (vector.typeKind() == TypeKind::VARCHAR ||
+          vector.typeKind() == TypeKind::VARBINARY) {
+        return vector.asUnchecked<FlatVector<StringView>>()
+            ->compactStringBuffers(minLivePct);
+      }
+      return 0;
+    case VectorEncoding::Simple::ROW: {
+      uint64_t bytes = 0;
+      for (auto& child : vector.asUnchecked<RowVector>()->children()) {
+        if (child != nullptr) {
+          bytes += compactStringBuffers(*child, minLivePct);
+        }
+      }
+      return bytes;
+    }
+    case VectorEncoding::Simple::ARRAY:
+      return compactStringBuffers(
+          *vector.asUnchecked<ArrayVector>()->elements(), minLivePct);
+    case VectorEncoding::Simple::MAP: {
+      auto* mapVector = vector.asUnchecked<MapVector>();
+      return compactStringBuffers(*mapVector->mapKeys(), minLivePct) +
+          compactStringBuffers(*mapVector->mapValues(), minLivePct);
+    }
+    case VectorEncoding::Simple::DICTIONARY:
+      return compactStringBuffers(*vector.valueVector(), minLivePct);
+    case VectorEncoding::Simple::LAZY: {
+      auto* lazy = vector.asUnchecked<LazyVector>();
+      if (!lazy->isLoaded()) {
+        return 0;
+      }
+      return compactStringBuffers(*lazy->loadedVector(), minLivePct);
+    }
+    default:
+      return 0;
+  }
+}
+
 void BaseVector::prepareForReuse(VectorPtr& vector, vector_size_t size) {
   if (!vector.unique() || !isReusableEncoding(vector->encoding())) {
     vector = BaseVector::create(vector->type(), size, vector->pool());
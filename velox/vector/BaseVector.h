@@ -599,6 +599,12 @@ class BaseVector {
   /// Flattens the input vector and all of its children.
   static void flattenVector(VectorPtr& vector);
 
+  /// Calls FlatVector<StringView>::compactStringBuffers() on the string
+  /// vectors in 'vector' and its children, including the bases of
+  /// dictionaries. 'vector' must not be read by other threads while this runs.
+  /// Returns the number of bytes of string buffers no longer referenced.
+  static uint64_t compactStringBuffers(BaseVector& vector, int32_t minLivePct);
+
   template <typename T>
   static inline uint64_t byteSize(vector_size_t count) {
     return sizeof(T) * count;
@@ -16,6 +16,7 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/LazyVector.h"
 
@@ -214,6 +215,16 @@ void DecodedVector::applyDictionaryWrapper(
     indices_ = copiedIndices_.data();
   }
 
+  if (!nulls_ && !newNulls && (!rows || rows->isAllSelected())) {
+    // Without nulls at either level all indices are valid, so the layers are
+    // composed with SIMD gathers.
+    simd::transpose(
+        newIndices,
+        folly::Range<const vector_size_t*>(currentIndices, end(rows)),
+        copiedIndices_.data());
+    return;
+  }
+
   applyToRows(rows, [&](vector_size_t row) {
     if (!nulls_ || !bits::isBitNull(nulls_, row)) {
       auto wrappedIndex = currentIndices[row];
@@ -189,11 +189,28 @@ void FlatVector<T>::copyValuesAndNulls(
     } else {
       auto* sourceValues = flatSource->rawValues();
       if (toSourceRow) {
-        rows.applyToSelected([&](auto row) {
-          auto sourceRow = toSourceRow[row];
-          VELOX_DCHECK_GT(source->size(), sourceRow);
-          rawValues_[row] = sourceValues[sourceRow];
-        });
+        constexpr bool kCanGather = std::is_same_v<T, int32_t> ||
+            std::is_same_v<T, int64_t> || std::is_same_v<T, float> ||
+            std::is_same_v<T, double>;
+        bool copied = false;
+        if constexpr (kCanGather) {
+          if (rows.isAllSelected()) {
+            // Dense copy through a mapping, e.g. compacting the rows that
+            // passed a filter. Copies a SIMD batch per gather.
+            simd::transpose(
+                sourceValues,
+                folly::Range<const vector_size_t*>(toSourceRow, rows.end()),
+                rawValues_);
+            copied = true;
+          }
+        }
+        if (!copied) {
+          rows.applyToSelected([&](auto row) {
+            auto sourceRow = toSourceRow[row];
+            VELOX_DCHECK_GT(source->size(), sourceRow);
+            rawValues_[row] = sourceValues[sourceRow];
+          });
+        }
       } else {
         rows.applyToSelected(
             [&](auto row) { rawValues_[row] = sourceValues[row]; });
@@ -248,6 +248,56 @@ void FlatVector<StringView>::acquireSharedStringBuffersRecursive(
   }
 }
 
+template <>
+uint64_t FlatVector<StringView>::compactStringBuffers(int32_t minLivePct) {
+  if (stringBuffers_.empty() || values_ == nullptr) {
+    return 0;
+  }
+  uint64_t capacity = 0;
+  for (const auto& buffer : stringBuffers_) {
+    capacity += buffer->capacity();
+  }
+  uint64_t liveBytes = 0;
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (!BaseVector::isNullAt(i) && !rawValues_[i].isInline()) {
+      liveBytes += rawValues_[i].size();
+    }
+  }
+  if (liveBytes * 100 >= capacity * minLivePct) {
+    return 0;
+  }
+
+  if (!values_->isMutable()) {
+    values_ = AlignedBuffer::copy(BaseVector::pool_, values_);
+    rawValues_ = values_->asMutable<StringView>();
+  }
+  BufferPtr buffer;
+  char* rawBuffer = nullptr;
+  if (liveBytes > 0) {
+    buffer = AlignedBuffer::allocate<char>(liveBytes, BaseVector::pool_);
+    rawBuffer = buffer->asMutable<char>();
+  }
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (BaseVector::isNullAt(i)) {
+      // Null rows must not point into the dropped buffers.
+      rawValues_[i] = StringView();
+      continue;
+    }
+    const auto value = rawValues_[i];
+    if (!value.isInline()) {
+      memcpy(rawBuffer, value.data(), value.size());
+      rawValues_[i] = StringView(rawBuffer, value.size());
+      rawBuffer += value.size();
+    }
+  }
+  clearStringBuffers();
+  if (buffer != nullptr) {
+    addStringBuffer(buffer);
+    return capacity - buffer->capacity();
+  }
+  return capacity;
+}
+
 template <>
 void FlatVector<StringView>::copy(
     const BaseVector* source,
@@ -453,6 +453,19 @@ class FlatVector final : public SimpleVector<T> {
   /// lazy.
   void acquireSharedStringBuffersRecursive(const BaseVector* source);
 
+  /// This API is available only for string vectors (T = StringView).
+  ///
+  /// Copies the non-inlined strings into one new buffer and drops the
+  /// references to the other string buffers if less than 'minLivePct' percent
+  /// of the capacity of the string buffers is referenced by non-null rows.
+  /// Slicing, filtering and copying from many sources leave small vectors
+  /// holding large buffers. The vector must not be read by other threads while
+  /// this runs. Returns the number of bytes of string buffers no longer
+  /// referenced, 0 if nothing was compacted.
+  uint64_t compactStringBuffers(int32_t /*minLivePct*/) {
+    return 0;
+  }
+
   /// This API is available only for string vectors (T = StringView).
   /// Prefer getRawStringBufferWithSpace(bytes) API as it is easier to use
   /// safely.
@@ -614,6 +627,9 @@ char* FlatVector<StringView>::getRawStringBufferWithSpace(
 template <>
 void FlatVector<StringView>::prepareForReuse();
 
+template <>
+uint64_t FlatVector<StringView>::compactStringBuffers(int32_t minLivePct);
+
 template <typename T>
 using FlatVectorPtr = std::shared_ptr<FlatVector<T>>;
 
@@ -155,4 +155,32 @@ void VectorMap::addMultiple(
   }
 }
 
+VectorPtr dictionaryEncodeStrings(
+    const VectorPtr& vector,
+    int32_t maxDistinctPct,
+    memory::MemoryPool* pool) {
+  const auto kind = vector->typeKind();
+  if (vector->encoding() != VectorEncoding::Simple::FLAT ||
+      (kind != TypeKind::VARCHAR && kind != TypeKind::VARBINARY)) {
+    return vector;
+  }
+  const auto size = vector->size();
+  const int64_t maxDistinct = int64_t{size} * maxDistinctPct / 100;
+  if (maxDistinct == 0) {
+    return vector;
+  }
+  VectorMap map(vector->type(), pool);
+  auto indices = allocateIndices(size, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (vector_size_t i = 0; i < size; ++i) {
+    rawIndices[i] = map.addOne(*vector, i);
+    if (map.size() > maxDistinct) {
+      // Stops as soon as there are too many distinct values.
+      return vector;
+    }
+  }
+  return BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), size, map.alphabetOwned());
+}
+
 } // namespace facebook::velox
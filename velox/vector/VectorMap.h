@@ -127,4 +127,15 @@ class VectorMap {
   const int32_t fixedWidth_;
 };
 
+/// Returns 'vector' as a dictionary over a copy of its distinct values if it
+/// is a flat VARCHAR or VARBINARY vector with at most 'maxDistinctPct' percent
+/// of distinct values. Returns 'vector' otherwise. Used to keep one copy of
+/// each repeated string of vectors that are held in memory, e.g. the build
+/// side of a nested loop join. Consumers read the dictionary without
+/// decoding it.
+VectorPtr dictionaryEncodeStrings(
+    const VectorPtr& vector,
+    int32_t maxDistinctPct,
+    memory::MemoryPool* pool);
+
 } // namespace facebook::velox
@@ -148,6 +148,13 @@ VectorSerde* getNamedVectorSerde(std::string_view serdeName) {
   return it->second.get();
 }
 
+VectorSerde* getNamedOrDefaultVectorSerde(std::string_view serdeName) {
+  if (serdeName.empty()) {
+    return getVectorSerde();
+  }
+  return getNamedVectorSerde(serdeName);
+}
+
 void VectorStreamGroup::createStreamTree(
     RowTypePtr type,
     int32_t numRows,
@@ -201,8 +208,12 @@ void VectorStreamGroup::read(
     velox::memory::MemoryPool* pool,
     RowTypePtr type,
     RowVectorPtr* result,
-    const VectorSerde::Options* options) {
-  getVectorSerde()->deserialize(source, pool, type, result, options);
+    const VectorSerde::Options* options,
+    VectorSerde* serde) {
+  if (serde == nullptr) {
+    serde = getVectorSerde();
+  }
+  serde->deserialize(source, pool, type, result, options);
 }
 
 folly::IOBuf rowVectorToIOBuf(
@@ -259,13 +259,19 @@ bool isRegisteredNamedVectorSerde(std::string_view serdeName);
 /// Get the vector serde identified by `serdeName`. Throws if not found.
 VectorSerde* getNamedVectorSerde(std::string_view serdeName);
 
+/// Get the vector serde identified by `serdeName` or the "default" one if
+/// `serdeName` is empty. Throws if not found.
+VectorSerde* getNamedOrDefaultVectorSerde(std::string_view serdeName);
+
 class VectorStreamGroup : public StreamArena {
  public:
-  /// If `serde` is not specified, fallback to the default registered.
+  /// If `serde` is not specified, fallback to the default registered. See
+  /// StreamArena for 'recycler'.
   explicit VectorStreamGroup(
       memory::MemoryPool* pool,
-      VectorSerde* serde = nullptr)
-      : StreamArena(pool),
+      VectorSerde* serde = nullptr,
+      StreamArenaRecycler* recycler = nullptr)
+      : StreamArena(pool, recycler),
         serde_(serde != nullptr ? serde : getVectorSerde()) {}
 
   void createStreamTree(
@@ -316,13 +322,15 @@ class VectorStreamGroup : public StreamArena {
   // Writes the contents to 'stream' in wire format.
   void flush(OutputStream* stream);
 
-  // Reads data in wire format. Returns the RowVector in 'result'.
+  // Reads data in wire format. Returns the RowVector in 'result'. If 'serde'
+  // is not specified, uses the default registered.
   static void read(
       ByteInputStream* source,
       velox::memory::MemoryPool* pool,
       RowTypePtr type,
       RowVectorPtr* result,
-      const VectorSerde::Options* options = nullptr);
+      const VectorSerde::Options* options = nullptr,
+      VectorSerde* serde = nullptr);
 
   void clear() override {
     StreamArena::clear();
@@ -548,6 +548,91 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Imports an Arrow utf8_view or binary_view array. A view has the same 16
+// byte layout as a Velox StringView: a 4 byte size, then either up to 12
+// inlined bytes or a 4 byte prefix followed by a buffer index and an offset
+// into that buffer where Velox has a pointer. If all views are inlined, the
+// views buffer is wrapped as is. Otherwise the views are copied with the
+// buffer index and offset replaced by a pointer. The string data is never
+// copied: the variadic data buffers are wrapped as the string buffers of the
+// vector.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  static_assert(sizeof(StringView) == 16);
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto length = arrowArray.length;
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* views = static_cast<const char*>(arrowArray.buffers[1]);
+  const auto* dataSizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+
+  auto viewSize = [&](vector_size_t row) {
+    uint32_t size;
+    std::memcpy(&size, views + row * sizeof(StringView), sizeof(size));
+    return size;
+  };
+
+  bool allInline = true;
+  for (vector_size_t i = 0; i < length; ++i) {
+    if (viewSize(i) > StringView::kInlineSize) {
+      allInline = false;
+      break;
+    }
+  }
+
+  std::vector<BufferPtr> stringBuffers;
+  BufferPtr stringViews;
+  if (allInline) {
+    stringViews = wrapInBufferView(views, length * sizeof(StringView));
+  } else {
+    std::vector<const char*> data(numDataBuffers);
+    for (auto i = 0; i < numDataBuffers; ++i) {
+      data[i] = static_cast<const char*>(arrowArray.buffers[2 + i]);
+      stringBuffers.push_back(wrapInBufferView(data[i], dataSizes[i]));
+    }
+    stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+    auto* rawStringViews = stringViews->asMutable<StringView>();
+    const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+    for (vector_size_t i = 0; i < length; ++i) {
+      if (rawNulls && bits::isBitNull(rawNulls, i)) {
+        rawStringViews[i] = StringView();
+        continue;
+      }
+      const auto* view = views + i * sizeof(StringView);
+      const auto size = viewSize(i);
+      if (size <= StringView::kInlineSize) {
+        std::memcpy(&rawStringViews[i], view, sizeof(StringView));
+        continue;
+      }
+      int32_t bufferIndex;
+      int32_t offset;
+      std::memcpy(&bufferIndex, view + 8, sizeof(bufferIndex));
+      std::memcpy(&offset, view + 12, sizeof(offset));
+      VELOX_USER_CHECK_LT(
+          bufferIndex, numDataBuffers, "Invalid string view buffer index.");
+      rawStringViews[i] = StringView(data[bufferIndex] + offset, size);
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -1082,6 +1167,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // String and binary views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       if (format[1] == 's') {
         return TIMESTAMP();
@@ -1713,6 +1808,10 @@ VectorPtr importFromArrowImpl(
 
   // String data types (VARCHAR and VARBINARY).
   if (type->isVarchar() || type->isVarbinary()) {
+    if (arrowSchema.format[0] == 'v') {
+      return createStringViewFlatVector(
+          pool, type, nulls, arrowArray, wrapInBufferView);
+    }
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
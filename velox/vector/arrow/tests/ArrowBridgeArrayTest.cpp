@@ -1310,6 +1310,73 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
         });
   }
 
+  // Imports utf8_view and binary_view arrays with the long strings spread
+  // over two variadic data buffers.
+  void testImportStringView() {
+    const std::vector<std::optional<std::string>> inputValues = {
+        "hello",
+        "a string that is too long to be inlined",
+        std::nullopt,
+        "exactly12 ch",
+        "another string that is not inlined",
+        "",
+    };
+    const auto length = inputValues.size();
+    auto nulls = AlignedBuffer::allocate<uint64_t>(length, pool_.get());
+    auto views = AlignedBuffer::allocate<char>(length * 16, pool_.get());
+    auto* rawNulls = nulls->asMutable<uint64_t>();
+    auto* rawViews = views->asMutable<char>();
+    std::memset(rawViews, 0, length * 16);
+    std::vector<std::string> data(2);
+    for (auto i = 0; i < length; ++i) {
+      if (!inputValues[i].has_value()) {
+        bits::setNull(rawNulls, i);
+        continue;
+      }
+      bits::clearNull(rawNulls, i);
+      const auto& value = *inputValues[i];
+      const int32_t size = value.size();
+      auto* view = rawViews + i * 16;
+      std::memcpy(view, &size, 4);
+      if (size <= 12) {
+        std::memcpy(view + 4, value.data(), size);
+        continue;
+      }
+      const int32_t bufferIndex = i % 2;
+      const int32_t offset = data[bufferIndex].size();
+      std::memcpy(view + 4, value.data(), 4);
+      std::memcpy(view + 8, &bufferIndex, 4);
+      std::memcpy(view + 12, &offset, 4);
+      data[bufferIndex] += value;
+    }
+    const int64_t dataSizes[] = {
+        static_cast<int64_t>(data[0].size()),
+        static_cast<int64_t>(data[1].size())};
+    const void* buffers[] = {
+        rawNulls, rawViews, data[0].data(), data[1].data(), dataSizes};
+
+    for (const char* format : {"vu", "vz"}) {
+      auto arrowSchema = makeArrowSchema(format);
+      auto arrowArray = makeArrowArray(buffers, 5, length, 1);
+      auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+      assertVectorContent(inputValues, output, 1);
+      auto* flat = output->asFlatVector<StringView>();
+      ASSERT_EQ(flat->stringBuffers().size(), 2);
+      // The strings point into the Arrow data buffers.
+      ASSERT_EQ(flat->valueAt(1).data(), data[1].data());
+    }
+
+    // All strings are inlined. The views buffer is used as is.
+    const void* inlineBuffers[] = {rawNulls, rawViews, dataSizes};
+    auto arrowSchema = makeArrowSchema("vu");
+    auto arrowArray = makeArrowArray(inlineBuffers, 3, 1, 0);
+    auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    auto* flat = output->asFlatVector<StringView>();
+    ASSERT_EQ(flat->valueAt(0), StringView("hello"));
+    ASSERT_TRUE(flat->stringBuffers().empty());
+    ASSERT_EQ(flat->values()->as<char>(), rawViews);
+  }
+
  private:
   // Creates short decimals from int128 and asserts the content of actual vector
   // with the expected values.
@@ -1752,6 +1819,10 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, row) {
   testImportRow();
 }
@@ -1805,6 +1876,10 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, row) {
   testImportRow();
 }
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_int32(vector_size, 10'000, "Number of rows in each input vector");
+DEFINE_int64(fuzzer_seed, 1, "Seed for the input data");
+
+// Measures the vector primitives that operators are built from over the
+// cross product of types, encodings and null ratios. Each benchmark is named
+// <kernel>_<type>_<encoding>_nulls<pct>. Use --bm_regex to pick a subset and
+// --json to get the results in JSON for comparing runs.
+
+namespace facebook::velox {
+namespace {
+
+struct TypeCase {
+  std::string name;
+  TypePtr type;
+  size_t stringLength;
+};
+
+struct TestCase {
+  VectorPtr input;
+  BufferPtr indices;
+};
+
+// Copies the input in runs of 10 rows into every other run of the target.
+size_t runCopyRanges(const TestCase& testCase, memory::MemoryPool* pool) {
+  const auto& input = testCase.input;
+  const auto size = input->size();
+  std::vector<BaseVector::CopyRange> ranges;
+  VectorPtr target;
+  {
+    folly::BenchmarkSuspender suspender;
+    for (vector_size_t i = 0; i < size; i += 20) {
+      ranges.push_back({i, i, std::min<vector_size_t>(10, size - i)});
+    }
+    target = BaseVector::create(input->type(), size, pool);
+  }
+  target->copyRanges(input.get(), ranges);
+  return size / 2;
+}
+
+size_t runWrapInDictionary(const TestCase& testCase) {
+  const auto size = testCase.input->size();
+  auto wrapped = BaseVector::wrapInDictionary(
+      nullptr, testCase.indices, size, testCase.input);
+  DecodedVector decoded(*wrapped);
+  folly::doNotOptimizeAway(decoded.base());
+  return size;
+}
+
+size_t runDecode(const TestCase& testCase) {
+  DecodedVector decoded(*testCase.input);
+  folly::doNotOptimizeAway(decoded.base());
+  return testCase.input->size();
+}
+
+size_t runHash(const TestCase& testCase) {
+  const auto& input = testCase.input;
+  uint64_t hash = 0;
+  for (vector_size_t i = 0; i < input->size(); ++i) {
+    hash ^= input->hashValueAt(i);
+  }
+  folly::doNotOptimizeAway(hash);
+  return input->size();
+}
+
+size_t runCompare(const TestCase& testCase) {
+  const auto& input = testCase.input;
+  const auto size = input->size();
+  int64_t sum = 0;
+  for (vector_size_t i = 0; i < size; ++i) {
+    sum += input->compare(input.get(), i, (i + 1) % size);
+  }
+  folly::doNotOptimizeAway(sum);
+  return size;
+}
+
+size_t runFlatten(const TestCase& testCase) {
+  // Flattening replaces the pointer, so the shared input stays as is.
+  auto vector = testCase.input;
+  BaseVector::flattenVector(vector);
+  folly::doNotOptimizeAway(vector);
+  return testCase.input->size();
+}
+
+class VectorPrimitivesBenchmark {
+ public:
+  explicit VectorPrimitivesBenchmark(memory::MemoryPool* pool) : pool_(pool) {}
+
+  void addBenchmarks() {
+    const std::vector<TypeCase> types = {
+        {"bigint", BIGINT(), 0},
+        {"double", DOUBLE(), 0},
+        {"shortVarchar", VARCHAR(), 8},
+        {"longVarchar", VARCHAR(), 64},
+        {"arrayBigint", ARRAY(BIGINT()), 0},
+        {"row", ROW({BIGINT(), VARCHAR()}), 16},
+    };
+    const std::vector<std::string> encodings = {"flat", "dict", "const"};
+    const std::vector<double> nullRatios = {0, 0.1, 0.5};
+
+    for (const auto& typeCase : types) {
+      for (const auto& encoding : encodings) {
+        for (auto nullRatio : nullRatios) {
+          const auto suffix = fmt::format(
+              "{}_{}_nulls{}",
+              typeCase.name,
+              encoding,
+              static_cast<int32_t>(nullRatio * 100));
+          addCase(suffix, makeTestCase(typeCase, encoding, nullRatio));
+        }
+      }
+    }
+  }
+
+ private:
+  std::shared_ptr<TestCase> makeTestCase(
+      const TypeCase& typeCase,
+      const std::string& encoding,
+      double nullRatio) {
+    VectorFuzzer::Options opts;
+    opts.vectorSize = FLAGS_vector_size;
+    opts.nullRatio = nullRatio;
+    opts.stringLength = typeCase.stringLength;
+    opts.stringVariableLength = false;
+    VectorFuzzer fuzzer(opts, pool_, FLAGS_fuzzer_seed);
+
+    auto testCase = std::make_shared<TestCase>();
+    if (encoding == "flat") {
+      testCase->input = fuzzer.fuzzFlat(typeCase.type);
+    } else if (encoding == "dict") {
+      testCase->input = fuzzer.fuzzDictionary(fuzzer.fuzzFlat(typeCase.type));
+    } else {
+      testCase->input = fuzzer.fuzzConstant(typeCase.type);
+    }
+    const auto size = testCase->input->size();
+    testCase->indices = allocateIndices(size, pool_);
+    auto* rawIndices = testCase->indices->asMutable<vector_size_t>();
+    for (vector_size_t i = 0; i < size; ++i) {
+      rawIndices[i] = (i * 7919) % size;
+    }
+    return testCase;
+  }
+
+  void addCase(const std::string& suffix, std::shared_ptr<TestCase> testCase) {
+    folly::addBenchmark(__FILE__, "copyRanges_" + suffix, [testCase, this]() {
+      return runCopyRanges(*testCase, pool_);
+    });
+    folly::addBenchmark(__FILE__, "wrapInDictionary_" + suffix, [testCase]() {
+      return runWrapInDictionary(*testCase);
+    });
+    folly::addBenchmark(__FILE__, "decode_" + suffix, [testCase]() {
+      return runDecode(*testCase);
+    });
+    folly::addBenchmark(__FILE__, "hash_" + suffix, [testCase]() {
+      return runHash(*testCase);
+    });
+    folly::addBenchmark(__FILE__, "compare_" + suffix, [testCase]() {
+      return runCompare(*testCase);
+    });
+    folly::addBenchmark(__FILE__, "flatten_" + suffix, [testCase]() {
+      return runFlatten(*testCase);
+    });
+  }
+
+  memory::MemoryPool* const pool_;
+};
+} // namespace
+} // namespace facebook::velox
+
+using namespace facebook::velox;
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+
+  memory::MemoryManager::initialize({});
+  auto rootPool = memory::memoryManager()->addRootPool();
+  auto leafPool = rootPool->addLeafChild("leaf");
+
+  VectorPrimitivesBenchmark benchmark(leafPool.get());
+  benchmark.addBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -1404,6 +1404,39 @@ TEST_F(DecodedVectorTest, dictionaryWrapping) {
   }
 }
 
+TEST_F(DecodedVectorTest, nestedDictionariesWithoutNulls) {
+  // Three layers without nulls, composed with SIMD gathers when all rows are
+  // selected. The sizes are not multiples of the SIMD width.
+  constexpr vector_size_t kSize = 1'003;
+  auto base = makeFlatVector<int64_t>(kSize, [](auto row) { return row; });
+  auto dict = wrapInDictionary(
+      makeIndices(kSize, [](auto row) { return (row * 7) % kSize; }), base);
+  dict = wrapInDictionary(
+      makeIndices(kSize, [](auto row) { return kSize - 1 - row; }), dict);
+  dict = wrapInDictionary(
+      makeIndices(kSize, [](auto row) { return (row * 13) % kSize; }), dict);
+  auto expected = [&](vector_size_t row) {
+    return (kSize - 1 - (row * 13) % kSize) * 7 % kSize;
+  };
+
+  DecodedVector decoded(*dict);
+  ASSERT_EQ(decoded.base(), base.get());
+  for (auto i = 0; i < kSize; ++i) {
+    ASSERT_EQ(decoded.index(i), expected(i)) << "at " << i;
+    ASSERT_EQ(decoded.valueAt<int64_t>(i), expected(i)) << "at " << i;
+  }
+
+  SelectivityVector rows(kSize);
+  for (auto i = 0; i < kSize; i += 3) {
+    rows.setValid(i, false);
+  }
+  rows.updateBounds();
+  decoded.decode(*dict, rows);
+  rows.applyToSelected([&](auto row) {
+    ASSERT_EQ(decoded.valueAt<int64_t>(row), expected(row)) << "at " << row;
+  });
+}
+
 TEST_F(DecodedVectorTest, previousIndicesInReUsedDecodedVector) {
   // Verify that when DecodedVector is re-used with different set of valid rows,
   // then the unselected indices would still have valid values.
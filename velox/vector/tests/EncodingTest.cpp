@@ -195,3 +195,27 @@ TEST_F(EncodingTest, basic) {
   checkTypeEncoding<TypeKind::VARCHAR>(VARCHAR());
   checkTypeEncoding<TypeKind::TIMESTAMP>(TIMESTAMP());
 }
+
+TEST_F(EncodingTest, dictionaryEncodeStrings) {
+  auto vector = makeFlatVector<std::string>(
+      100,
+      [](auto row) {
+        return fmt::format("a string that is not inlined {}", row % 9);
+      },
+      nullEvery(7));
+
+  // 9 distinct strings and a null.
+  auto encoded = dictionaryEncodeStrings(vector, 10, pool());
+  ASSERT_EQ(encoded->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(encoded->valueVector()->size(), 10);
+  assertEqualVectors(vector, encoded);
+  ASSERT_LT(encoded->retainedSize(), vector->retainedSize());
+
+  // Too many distinct values.
+  ASSERT_EQ(dictionaryEncodeStrings(vector, 9, pool()), vector);
+
+  // Not a flat string vector.
+  auto ints = makeFlatVector<int64_t>(100, [](auto row) { return row % 3; });
+  ASSERT_EQ(dictionaryEncodeStrings(ints, 10, pool()), ints);
+  ASSERT_EQ(dictionaryEncodeStrings(encoded, 10, pool()), encoded);
+}
@@ -1184,6 +1184,76 @@ TEST_F(VectorTest, unknown) {
   }
 }
 
+TEST_F(VectorTest, copyAllRowsWithMapping) {
+  // All rows selected through a mapping take the SIMD gather path for 4 and
+  // 8 byte values. The size is not a multiple of the SIMD width.
+  const vector_size_t size = 1'000;
+  const vector_size_t numRows = 333;
+  std::vector<vector_size_t> toSourceRow(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    toSourceRow[i] = (i * 7) % size;
+  }
+  const SelectivityVector rows(numRows);
+  auto test = [&](const VectorPtr& source) {
+    auto target = BaseVector::create(source->type(), numRows, pool());
+    target->copy(source.get(), rows, toSourceRow.data());
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_TRUE(target->equalValueAt(source.get(), i, toSourceRow[i]))
+          << "at " << i;
+    }
+  };
+  test(makeFlatVector<int32_t>(size, folly::identity, nullEvery(5)));
+  test(makeFlatVector<int64_t>(size, folly::identity));
+  test(makeFlatVector<float>(size, [](auto row) { return row * 0.5; }));
+  test(makeFlatVector<double>(
+      size, [](auto row) { return row * 0.25; }, nullEvery(3)));
+  test(makeFlatVector<int16_t>(size, folly::identity));
+}
+
+TEST_F(VectorTest, compactStringBuffers) {
+  const vector_size_t size = 1'000;
+  auto strings = makeFlatVector<std::string>(
+      size,
+      [](auto row) { return std::string(20 + row % 7, 'a' + row % 26); },
+      nullEvery(11));
+  // A vector of 10 rows that references all the string buffers of 'strings'.
+  auto small =
+      BaseVector::create<FlatVector<StringView>>(VARCHAR(), 10, pool());
+  for (auto i = 0; i < 10; ++i) {
+    small->copy(strings.get(), i, i * 100, 1);
+  }
+  small->setNoCopy(3, StringView("inline"));
+  auto expected = BaseVector::copy(*small);
+  uint64_t stringBytes = 0;
+  for (const auto& buffer : small->stringBuffers()) {
+    stringBytes += buffer->capacity();
+  }
+
+  // 0 never compacts.
+  const auto numBuffers = small->stringBuffers().size();
+  ASSERT_EQ(small->compactStringBuffers(0), 0);
+  ASSERT_EQ(small->stringBuffers().size(), numBuffers);
+
+  ASSERT_GT(small->compactStringBuffers(50), 0);
+  ASSERT_EQ(small->stringBuffers().size(), 1);
+  ASSERT_LT(small->stringBuffers()[0]->capacity(), stringBytes);
+  test::assertEqualVectors(expected, small);
+
+  // Compacting again finds the single buffer fully used.
+  ASSERT_EQ(small->compactStringBuffers(50), 0);
+
+  // Strings in complex types are reached through the children.
+  auto row = makeRowVector({makeArrayVector(
+      {0}, BaseVector::wrapInDictionary(
+              nullptr,
+              makeIndices(10, [](auto row) { return row * 100; }),
+              10,
+              strings))});
+  expected = BaseVector::copy(*row);
+  ASSERT_GT(BaseVector::compactStringBuffers(*row, 50), 0);
+  test::assertEqualVectors(expected, row);
+}
+
 TEST_F(VectorTest, copyBoolAllNullFlatVector) {
   const vector_size_t size = 1'000;
   auto allNulls = makeAllNullFlatVector<bool>(size);